@@ -71,6 +71,18 @@ typedef struct trace_s {
 
 typedef int cmHandle_t;
 
+// a translation of a batch, see idCollisionModelManager::TranslationBatch
+typedef struct cmTraceRequest_s {
+	idVec3					start;
+	idVec3					end;
+	const idTraceModel *	trm;			// NULL for a point trace
+	idMat3					trmAxis;
+	int						contentMask;
+	cmHandle_t				model;
+	idVec3					modelOrigin;
+	idMat3					modelAxis;
+} cmTraceRequest_t;
+
 #define CM_CLIP_EPSILON		0.25f			// always stay this distance away from any model
 #define CM_BOX_EPSILON		1.0f			// should always be larger than clip epsilon
 #define CM_MAX_TRACE_DIST	4096.0f			// maximum distance a trace model may be traced, point traces are unlimited
@@ -104,10 +116,16 @@ public:
 	// Gets a polygon of a model.
 	virtual bool			GetModelPolygon( cmHandle_t model, int polygonNum, idFixedWinding &winding ) const = 0;
 
+	// The queries below keep their working state per call, they can run on several threads at once
+	// as long as no models are loaded or freed and SetupTrmModel isn't called meanwhile.
+
 	// Translates a trace model and reports the first collision if any.
 	virtual void			Translation( trace_t *results, const idVec3 &start, const idVec3 &end,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) = 0;
+	// Runs the translations of all the requests, results[i] is the result of requests[i]. The
+	// traces are spread over several threads, the models must not change until it returns.
+	virtual void			TranslationBatch( trace_t *results, const cmTraceRequest_t *requests, const int numRequests ) = 0;
 	// Rotates a trace model and reports the first collision if any.
 	virtual void			Rotation( trace_t *results, const idVec3 &start, const idRotation &rotation,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
@@ -52,10 +52,10 @@ bool idCollisionModelManagerLocal::TestTrmVertsInBrush( cm_traceWork_t *tw, cm_b
 	float d, bestd;
 	idVec3 *p;
 
-	if ( b->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( b->checkcount == tw->checkCount ) {
 		return false;
 	}
-	b->checkcount = idCollisionModelManagerLocal::checkCount;
+	b->checkcount = tw->checkCount;
 
 	if ( !(b->contents & tw->contents) ) {
 		return false;
@@ -110,13 +110,13 @@ bool idCollisionModelManagerLocal::TestTrmVertsInBrush( cm_traceWork_t *tw, cm_b
 CM_SetTrmEdgeSidedness
 ================
 */
-#define CM_SetTrmEdgeSidedness( edge, bpl, epl, bitNum ) {							\
-	if ( !(edge->sideSet & (1<<bitNum)) ) {											\
-		float fl;																	\
-		fl = (bpl).PermutedInnerProduct( epl );										\
-		edge->side = (edge->side & ~(1<<bitNum)) | (FLOATSIGNBITSET(fl) << bitNum);	\
-		edge->sideSet |= (1 << bitNum);												\
-	}																				\
+#define CM_SetTrmEdgeSidedness( tw, edgeSlot, bpl, epl, bitNum ) {												\
+	if ( !((tw)->polygonEdgeSideSet[edgeSlot] & (1<<bitNum)) ) {												\
+		float fl;																							\
+		fl = (bpl).PermutedInnerProduct( epl );																\
+		(tw)->polygonEdgeSide[edgeSlot] = ((tw)->polygonEdgeSide[edgeSlot] & ~(1<<bitNum)) | (FLOATSIGNBITSET(fl) << bitNum);	\
+		(tw)->polygonEdgeSideSet[edgeSlot] |= (1 << bitNum);													\
+	}																										\
 }
 
 /*
@@ -124,18 +124,18 @@ CM_SetTrmEdgeSidedness
 CM_SetTrmPolygonSidedness
 ================
 */
-#define CM_SetTrmPolygonSidedness( v, plane, bitNum ) {								\
-	if ( !((v)->sideSet & (1<<bitNum)) ) {											\
+#define CM_SetTrmPolygonSidedness( tw, vertexSlot, v, plane, bitNum ) {						\
+	if ( !((tw)->polygonVertexSideSet[vertexSlot] & (1<<bitNum)) ) {					\
 		float fl;																	\
 		fl = plane.Distance( (v)->p );												\
 		/* cannot use float sign bit because it is undetermined when fl == 0.0f */	\
 		if ( fl < 0.0f ) {															\
-			(v)->side |= (1 << bitNum);												\
+			(tw)->polygonVertexSide[vertexSlot] |= (1 << bitNum);						\
 		}																			\
 		else {																		\
-			(v)->side &= ~(1 << bitNum);											\
+			(tw)->polygonVertexSide[vertexSlot] &= ~(1 << bitNum);					\
 		}																			\
-		(v)->sideSet |= (1 << bitNum);												\
+		(tw)->polygonVertexSideSet[vertexSlot] |= (1 << bitNum);						\
 	}																				\
 }
 
@@ -147,7 +147,7 @@ idCollisionModelManagerLocal::TestTrmInPolygon
 ================
 */
 bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_polygon_t *p ) {
-	int i, j, k, edgeNum, flip, trmEdgeNum, bitNum, bestPlane;
+	int i, j, k, edgeNum, flip, trmEdgeNum, bitNum, bestPlane, slot1, slot2;
 	int sides[MAX_TRACEMODEL_VERTS];
 	float d, bestd;
 	cm_trmEdge_t *trmEdge;
@@ -155,10 +155,10 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 	cm_vertex_t *v, *v1, *v2;
 
 	// if already checked this polygon
-	if ( p->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( p->checkcount == tw->checkCount ) {
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	p->checkcount = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if ( !(p->contents & tw->contents) ) {
@@ -190,14 +190,14 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 			edgeNum = p->edges[i];
 			edge = tw->model->edges + abs(edgeNum);
 			// if this edge is already tested
-			if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+			if ( edge->checkcount == tw->checkCount ) {
 				continue;
 			}
 
 			for ( j = 0; j < 2; j++ ) {
 				v = &tw->model->vertices[edge->vertexNum[j]];
 				// if this vertex is already tested
-				if ( v->checkcount == idCollisionModelManagerLocal::checkCount ) {
+				if ( v->checkcount == tw->checkCount ) {
 					continue;
 				}
 
@@ -232,19 +232,14 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 	for ( i = 0; i < p->numEdges; i++ ) {
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
-		// reset sidedness cache if this is the first time we encounter this edge
-		if ( edge->checkcount != idCollisionModelManagerLocal::checkCount ) {
-			edge->sideSet = 0;
-		}
+		// reset the sidedness cache of this polygon edge and the vertex it starts at
+		tw->polygonEdgeSideSet[i] = 0;
+		tw->polygonVertexSideSet[i] = 0;
 		// pluecker coordinate for edge
 		tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[edge->vertexNum[0]].p,
 													tw->model->vertices[edge->vertexNum[1]].p );
 		v = &tw->model->vertices[edge->vertexNum[INTSIGNBITSET(edgeNum)]];
-		// reset sidedness cache if this is the first time we encounter this vertex
-		if ( v->checkcount != idCollisionModelManagerLocal::checkCount ) {
-			v->sideSet = 0;
-		}
-		v->checkcount = idCollisionModelManagerLocal::checkCount;
+		v->checkcount = tw->checkCount;
 	}
 
 	// get side of polygon for each trm vertex
@@ -266,8 +261,8 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 			edgeNum = p->edges[j];
 			edge = tw->model->edges + abs(edgeNum);
 #if 1
-			CM_SetTrmEdgeSidedness( edge, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i );
-			if ( INTSIGNBITSET(edgeNum) ^ ((edge->side >> i) & 1) ^ flip ) {
+			CM_SetTrmEdgeSidedness( tw, j, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i );
+			if ( INTSIGNBITSET(edgeNum) ^ ((tw->polygonEdgeSide[j] >> i) & 1) ^ flip ) {
 				break;
 			}
 #else
@@ -305,22 +300,26 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 	for ( i = 0; i < p->numEdges; i++ ) {
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
-		if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+		if ( edge->checkcount == tw->checkCount ) {
 			continue;
 		}
-		edge->checkcount = idCollisionModelManagerLocal::checkCount;
+		edge->checkcount = tw->checkCount;
+
+		// the edge goes from polygon vertex i to the start of the next edge
+		slot1 = INTSIGNBITSET(edgeNum) ? ( ( i + 1 < p->numEdges ) ? i + 1 : 0 ) : i;
+		slot2 = INTSIGNBITSET(edgeNum) ? i : ( ( i + 1 < p->numEdges ) ? i + 1 : 0 );
 
 		for ( j = 0; j < tw->numPolys; j++ ) {
 #if 1
 			v1 = tw->model->vertices + edge->vertexNum[0];
-			CM_SetTrmPolygonSidedness( v1, tw->polys[j].plane, j );
+			CM_SetTrmPolygonSidedness( tw, slot1, v1, tw->polys[j].plane, j );
 			v2 = tw->model->vertices + edge->vertexNum[1];
-			CM_SetTrmPolygonSidedness( v2, tw->polys[j].plane, j );
+			CM_SetTrmPolygonSidedness( tw, slot2, v2, tw->polys[j].plane, j );
 			// if the polygon edge does not cross the trm polygon plane
-			if ( !(((v1->side ^ v2->side) >> j) & 1) ) {
+			if ( !(((tw->polygonVertexSide[slot1] ^ tw->polygonVertexSide[slot2]) >> j) & 1) ) {
 				continue;
 			}
-			flip = (v1->side >> j) & 1;
+			flip = (tw->polygonVertexSide[slot1] >> j) & 1;
 #else
 			float d1, d2;
 
@@ -343,8 +342,8 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 				trmEdge = tw->edges + abs(trmEdgeNum);
 #if 1
 				bitNum = abs(trmEdgeNum);
-				CM_SetTrmEdgeSidedness( edge, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum );
-				if ( INTSIGNBITSET(trmEdgeNum) ^ ((edge->side >> bitNum) & 1) ^ flip ) {
+				CM_SetTrmEdgeSidedness( tw, i, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum );
+				if ( INTSIGNBITSET(trmEdgeNum) ^ ((tw->polygonEdgeSide[i] >> bitNum) & 1) ^ flip ) {
 					break;
 				}
 #else
@@ -490,7 +489,7 @@ int idCollisionModelManagerLocal::ContentsTrm( trace_t *results, const idVec3 &s
 		return results->c.contents;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
+	tw.checkCount = idCollisionModelManagerLocal::GetCheckCounts( 1 );
 
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -503,6 +502,7 @@ int idCollisionModelManagerLocal::ContentsTrm( trace_t *results, const idVec3 &s
 	tw.positionTest = true;
 	tw.pointTrace = false;
 	tw.quickExit = false;
+	tw.getContacts = false;
 	tw.numContacts = 0;
 	tw.model = idCollisionModelManagerLocal::models[model];
 	tw.start = start - modelOrigin;
@@ -86,6 +86,9 @@ idCVar cm_drawInternal(		"cm_drawInternal",		"1",		CVAR_GAME | CVAR_BOOL,	"draw
 idCVar cm_drawNormals(		"cm_drawNormals",		"0",		CVAR_GAME | CVAR_BOOL,	"draw polygon and edge normals" );
 idCVar cm_backFaceCull(		"cm_backFaceCull",		"0",		CVAR_GAME | CVAR_BOOL,	"cull back facing polygons" );
 idCVar cm_debugCollision(	"cm_debugCollision",	"0",		CVAR_GAME | CVAR_BOOL,	"debug the collision detection" );
+idCVar cm_parallelTraces(	"cm_parallelTraces",	"1",		CVAR_GAME | CVAR_BOOL,	"run the point traces of a trace batch on several threads" );
+idCVar cm_sahSplitter(		"cm_sahSplitter",		"0",		CVAR_GAME | CVAR_BOOL,	"place the node splitters of new collision model trees by surface area heuristic instead of as centered as possible" );
+idCVar cm_binaryCollisionModels(	"cm_binaryCollisionModels",	"1",	CVAR_GAME | CVAR_BOOL,	"load the map collision models from the binary .cmb next to the .cm, and write it when it is missing or out of date" );
 
 static idVec4 cm_color;
 
@@ -432,6 +435,7 @@ void idCollisionModelManagerLocal::DebugOutput( const idVec3 &origin ) {
 		sprintf( buf, "%4d", cm_testTimes.GetInteger() );
 	}
 	common->Printf("%s translations: %4d milliseconds, (min = %d, max = %d, av = %1.1f)\n", buf, t, min_translation, max_translation, (float) total_translation / num_translation );
+	perfSuite->AddResult( "collision", va( "%d translations msec", cm_testTimes.GetInteger() ), (float) total_translation / num_translation );
 
 	if ( cm_testRandomMany.GetBool() ) {
 		// if many traces in one random direction
@@ -474,6 +478,7 @@ void idCollisionModelManagerLocal::DebugOutput( const idVec3 &origin ) {
 			sprintf( buf, "%4d", cm_testTimes.GetInteger() );
 		}
 		common->Printf("%s rotation: %4d milliseconds, (min = %d, max = %d, av = %1.1f)\n", buf, t, min_rotation, max_rotation, (float) total_rotation / num_rotation );
+		perfSuite->AddResult( "collision", va( "%d rotations msec", cm_testTimes.GetInteger() ), (float) total_rotation / num_rotation );
 	}
 
 	Mem_Free( testend );
@@ -36,6 +36,10 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #define CM_FILEID			"CM"
 #define CM_FILEVERSION		"1.00"
 
+#define CM_BINARY_FILE_EXT		"cmb"
+#define CM_BINARY_FILEID		"CMB\0"
+#define CM_BINARY_FILEVERSION	1
+
 
 /*
 ===============================================================================
@@ -250,6 +254,10 @@ void idCollisionModelManagerLocal::WriteCollisionModelsToFile( const char *filen
 	}
 
 	fileSystem->CloseFile( fp );
+
+	if ( mapFileCRC && cm_binaryCollisionModels.GetBool() ) {
+		WriteBinaryCollisionModelsToFile( filename, firstModel, lastModel, mapFileCRC );
+	}
 }
 
 /*
@@ -297,6 +305,273 @@ bool idCollisionModelManagerLocal::WriteCollisionModelForMapEntity( const idMapE
 	return true;
 }
 
+/*
+===============================================================================
+
+Binary collision model file
+
+The collision models of a map are also written to a .cmb with the same data
+as the .cm in flat native arrays, validated against the map file CRC, so a map
+load only has to read the file and walk the arrays instead of tokenizing.
+
+===============================================================================
+*/
+
+typedef struct cmBinaryEdge_s {
+	int						vertexNum[2];
+	unsigned short			internal;
+	unsigned short			numUsers;
+} cmBinaryEdge_t;
+
+typedef struct cmBinaryNode_s {
+	int						planeType;
+	float					planeDist;
+} cmBinaryNode_t;
+
+typedef struct cmBinaryPolygon_s {
+	int						numEdges;
+	int						material;			// index into the material names
+	idPlane					plane;
+	idBounds				bounds;
+} cmBinaryPolygon_t;
+
+typedef struct cmBinaryBrush_s {
+	int						numPlanes;
+	int						contents;
+	idBounds				bounds;
+} cmBinaryBrush_t;
+
+// reads the native blobs straight from the file buffer
+class idCMBinaryReader {
+public:
+							idCMBinaryReader( const byte *data, int length ) { ptr = data; end = data + length; }
+
+	const void *			ReadBlob( int count, int size ) {
+								if ( count < 0 || (long long)count * size > end - ptr ) {
+									ptr = end + 1;		// fail all further reads
+									return NULL;
+								}
+								const void *blob = ptr;
+								ptr += count * size;
+								return blob;
+							}
+	int						ReadInt( void ) { const int *i = (const int *)ReadBlob( 1, sizeof( int ) ); return i ? *i : -1; }
+	const char *			ReadString( void ) { int length = ReadInt(); const char *s = (const char *)ReadBlob( length, 1 ); return s ? s : ""; }
+	bool					Failed( void ) const { return ptr > end; }
+	bool					AtEnd( void ) const { return ptr == end; }
+
+private:
+	const byte *			ptr;
+	const byte *			end;
+};
+
+/*
+================
+CM_WriteBinaryInt
+================
+*/
+static void CM_WriteBinaryInt( idFile *fp, int value ) {
+	fp->Write( &value, sizeof( value ) );
+}
+
+/*
+================
+CM_WriteBinaryString
+
+Written with the terminating zero so it can be used in place
+================
+*/
+static void CM_WriteBinaryString( idFile *fp, const char *string ) {
+	int length = idStr::Length( string ) + 1;
+	CM_WriteBinaryInt( fp, length );
+	fp->Write( string, length );
+}
+
+/*
+================
+idCollisionModelManagerLocal::WriteBinaryNodes
+================
+*/
+void idCollisionModelManagerLocal::WriteBinaryNodes( idList<cmBinaryNode_t> &nodes, cm_node_t *node ) {
+	cmBinaryNode_t &n = nodes.Alloc();
+	n.planeType = node->planeType;
+	n.planeDist = node->planeDist;
+	if ( node->planeType != -1 ) {
+		WriteBinaryNodes( nodes, node->children[0] );
+		WriteBinaryNodes( nodes, node->children[1] );
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::GetPolygons
+================
+*/
+void idCollisionModelManagerLocal::GetPolygons( idList<cm_polygon_t *> &polygons, cm_node_t *node ) {
+	cm_polygonRef_t *pref;
+
+	for ( pref = node->polygons; pref; pref = pref->next ) {
+		if ( pref->p->checkcount == checkCount ) {
+			continue;
+		}
+		pref->p->checkcount = checkCount;
+		polygons.Append( pref->p );
+	}
+	if ( node->planeType != -1 ) {
+		GetPolygons( polygons, node->children[0] );
+		GetPolygons( polygons, node->children[1] );
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::GetBrushes
+================
+*/
+void idCollisionModelManagerLocal::GetBrushes( idList<cm_brush_t *> &brushes, cm_node_t *node ) {
+	cm_brushRef_t *bref;
+
+	for ( bref = node->brushes; bref; bref = bref->next ) {
+		if ( bref->b->checkcount == checkCount ) {
+			continue;
+		}
+		bref->b->checkcount = checkCount;
+		brushes.Append( bref->b );
+	}
+	if ( node->planeType != -1 ) {
+		GetBrushes( brushes, node->children[0] );
+		GetBrushes( brushes, node->children[1] );
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::WriteBinaryCollisionModel
+================
+*/
+void idCollisionModelManagerLocal::WriteBinaryCollisionModel( idFile *fp, cm_model_t *model ) {
+	int i;
+	idList<cmBinaryNode_t> nodes;
+	idList<cm_polygon_t *> polygons;
+	idList<cm_brush_t *> brushes;
+	idStrList materials;
+	idHashIndex materialHash;
+
+	CM_WriteBinaryString( fp, model->name );
+
+	// vertices
+	CM_WriteBinaryInt( fp, model->numVertices );
+	for ( i = 0; i < model->numVertices; i++ ) {
+		fp->Write( &model->vertices[i].p, sizeof( idVec3 ) );
+	}
+
+	// edges
+	CM_WriteBinaryInt( fp, model->numEdges );
+	for ( i = 0; i < model->numEdges; i++ ) {
+		cmBinaryEdge_t e;
+		e.vertexNum[0] = model->edges[i].vertexNum[0];
+		e.vertexNum[1] = model->edges[i].vertexNum[1];
+		e.internal = model->edges[i].internal;
+		e.numUsers = model->edges[i].numUsers;
+		fp->Write( &e, sizeof( e ) );
+	}
+
+	// nodes
+	WriteBinaryNodes( nodes, model->node );
+	CM_WriteBinaryInt( fp, nodes.Num() );
+	fp->Write( nodes.Ptr(), nodes.Num() * sizeof( nodes[0] ) );
+
+	// polygons
+	checkCount++;
+	GetPolygons( polygons, model->node );
+
+	for ( i = 0; i < polygons.Num(); i++ ) {
+		const char *name = polygons[i]->material->GetName();
+		int hash = materialHash.GenerateKey( name, false );
+		int j;
+		for ( j = materialHash.First( hash ); j != -1; j = materialHash.Next( j ) ) {
+			if ( materials[j].Icmp( name ) == 0 ) {
+				break;
+			}
+		}
+		if ( j == -1 ) {
+			materialHash.Add( hash, materials.Append( name ) );
+		}
+	}
+
+	CM_WriteBinaryInt( fp, materials.Num() );
+	for ( i = 0; i < materials.Num(); i++ ) {
+		CM_WriteBinaryString( fp, materials[i] );
+	}
+
+	checkCount++;
+	CM_WriteBinaryInt( fp, CountPolygonMemory( model->node ) );
+	CM_WriteBinaryInt( fp, polygons.Num() );
+	for ( i = 0; i < polygons.Num(); i++ ) {
+		const cm_polygon_t *p = polygons[i];
+		const char *name = p->material->GetName();
+		cmBinaryPolygon_t bp;
+
+		bp.numEdges = p->numEdges;
+		for ( bp.material = materialHash.First( materialHash.GenerateKey( name, false ) ); bp.material != -1; bp.material = materialHash.Next( bp.material ) ) {
+			if ( materials[bp.material].Icmp( name ) == 0 ) {
+				break;
+			}
+		}
+		bp.plane = p->plane;
+		bp.bounds = p->bounds;
+		fp->Write( &bp, sizeof( bp ) );
+		fp->Write( p->edges, p->numEdges * sizeof( p->edges[0] ) );
+	}
+
+	// brushes
+	checkCount++;
+	GetBrushes( brushes, model->node );
+
+	checkCount++;
+	CM_WriteBinaryInt( fp, CountBrushMemory( model->node ) );
+	CM_WriteBinaryInt( fp, brushes.Num() );
+	for ( i = 0; i < brushes.Num(); i++ ) {
+		const cm_brush_t *b = brushes[i];
+		cmBinaryBrush_t bb;
+
+		bb.numPlanes = b->numPlanes;
+		bb.contents = b->contents;
+		bb.bounds = b->bounds;
+		fp->Write( &bb, sizeof( bb ) );
+		fp->Write( b->planes, b->numPlanes * sizeof( b->planes[0] ) );
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::WriteBinaryCollisionModelsToFile
+================
+*/
+void idCollisionModelManagerLocal::WriteBinaryCollisionModelsToFile( const char *filename, int firstModel, int lastModel, unsigned int mapFileCRC ) {
+	int i;
+	idStr name;
+
+	name = filename;
+	name.SetFileExtension( CM_BINARY_FILE_EXT );
+
+	idFile_Memory fp( name );
+	fp.SetGranularity( 1024 * 1024 );
+
+	// file id, version and the map file crc, all native so other byte orders are rejected
+	fp.Write( CM_BINARY_FILEID, 4 );
+	CM_WriteBinaryInt( &fp, CM_BINARY_FILEVERSION );
+	CM_WriteBinaryInt( &fp, (int)mapFileCRC );
+	CM_WriteBinaryInt( &fp, lastModel - firstModel );
+
+	for ( i = firstModel; i < lastModel; i++ ) {
+		WriteBinaryCollisionModel( &fp, models[ i ] );
+	}
+
+	common->Printf( "writing %s\n", name.c_str() );
+	fileSystem->WriteFile( name, fp.GetDataPtr(), fp.Length() );
+}
+
 
 /*
 ===============================================================================
@@ -320,8 +595,6 @@ void idCollisionModelManagerLocal::ParseVertices( idLexer *src, cm_model_t *mode
 	model->vertices = (cm_vertex_t *) Mem_Alloc( model->maxVertices * sizeof( cm_vertex_t ) );
 	for ( i = 0; i < model->numVertices; i++ ) {
 		src->Parse1DMatrix( 3, model->vertices[i].p.ToFloatPtr() );
-		model->vertices[i].side = 0;
-		model->vertices[i].sideSet = 0;
 		model->vertices[i].checkcount = 0;
 	}
 	src->ExpectTokenString( "}" );
@@ -344,8 +617,6 @@ void idCollisionModelManagerLocal::ParseEdges( idLexer *src, cm_model_t *model )
 		model->edges[i].vertexNum[0] = src->ParseInt();
 		model->edges[i].vertexNum[1] = src->ParseInt();
 		src->ExpectTokenString( ")" );
-		model->edges[i].side = 0;
-		model->edges[i].sideSet = 0;
 		model->edges[i].internal = src->ParseInt();
 		model->edges[i].numUsers = src->ParseInt();
 		model->edges[i].normal = vec3_origin;
@@ -520,6 +791,20 @@ bool idCollisionModelManagerLocal::ParseCollisionModel( idLexer *src ) {
 
 		src->Error( "ParseCollisionModel: bad token \"%s\"", token.c_str() );
 	}
+
+	FinishCollisionModel( model );
+
+	return true;
+}
+
+/*
+================
+idCollisionModelManagerLocal::FinishCollisionModel
+
+Derives the remaining data of a loaded model
+================
+*/
+void idCollisionModelManagerLocal::FinishCollisionModel( cm_model_t *model ) {
 	// calculate edge normals
 	checkCount++;
 	CalculateEdgeNormals( model, model->node );
@@ -535,6 +820,231 @@ bool idCollisionModelManagerLocal::ParseCollisionModel( idLexer *src ) {
 						model->numNodes * sizeof(cm_node_t) +
 						model->numPolygonRefs * sizeof(cm_polygonRef_t) +
 						model->numBrushRefs * sizeof(cm_brushRef_t);
+}
+
+/*
+================
+idCollisionModelManagerLocal::ReadBinaryNodes
+================
+*/
+cm_node_t *idCollisionModelManagerLocal::ReadBinaryNodes( const cmBinaryNode_t *nodes, int numNodes, cm_model_t *model, cm_node_t *parent ) {
+	cm_node_t *node;
+
+	if ( model->numNodes >= numNodes ) {
+		return NULL;
+	}
+
+	// the first call allocates one block for all nodes
+	node = AllocNode( model, numNodes );
+	node->brushes = NULL;
+	node->polygons = NULL;
+	node->parent = parent;
+	node->planeType = nodes[model->numNodes].planeType;
+	node->planeDist = nodes[model->numNodes].planeDist;
+	model->numNodes++;
+	if ( node->planeType != -1 ) {
+		node->children[0] = ReadBinaryNodes( nodes, numNodes, model, node );
+		node->children[1] = ReadBinaryNodes( nodes, numNodes, model, node );
+		if ( !node->children[0] || !node->children[1] ) {
+			return NULL;
+		}
+	}
+	return node;
+}
+
+/*
+================
+idCollisionModelManagerLocal::ReadBinaryCollisionModel
+================
+*/
+bool idCollisionModelManagerLocal::ReadBinaryCollisionModel( idCMBinaryReader &src ) {
+	cm_model_t *model;
+	int i, numNodes, numMaterials, memory, num;
+	idList<const idMaterial *> materials;
+
+	if ( numModels >= MAX_SUBMODELS ) {
+		common->Error( "LoadModel: no free slots" );
+		return false;
+	}
+	model = AllocModel();
+	models[numModels ] = model;
+	numModels++;
+
+	model->name = src.ReadString();
+
+	// vertices
+	model->numVertices = src.ReadInt();
+	const idVec3 *vertices = (const idVec3 *)src.ReadBlob( model->numVertices, sizeof( idVec3 ) );
+	if ( !vertices ) {
+		model->numVertices = 0;
+		return false;
+	}
+	model->maxVertices = model->numVertices;
+	model->vertices = (cm_vertex_t *) Mem_Alloc( model->maxVertices * sizeof( cm_vertex_t ) );
+	for ( i = 0; i < model->numVertices; i++ ) {
+		model->vertices[i].p = vertices[i];
+		model->vertices[i].checkcount = 0;
+	}
+
+	// edges
+	model->numEdges = src.ReadInt();
+	const cmBinaryEdge_t *edges = (const cmBinaryEdge_t *)src.ReadBlob( model->numEdges, sizeof( cmBinaryEdge_t ) );
+	if ( !edges ) {
+		model->numEdges = 0;
+		return false;
+	}
+	model->maxEdges = model->numEdges;
+	model->edges = (cm_edge_t *) Mem_Alloc( model->maxEdges * sizeof( cm_edge_t ) );
+	for ( i = 0; i < model->numEdges; i++ ) {
+		if ( edges[i].vertexNum[0] < 0 || edges[i].vertexNum[0] >= model->numVertices ||
+			edges[i].vertexNum[1] < 0 || edges[i].vertexNum[1] >= model->numVertices ) {
+			return false;
+		}
+		model->edges[i].vertexNum[0] = edges[i].vertexNum[0];
+		model->edges[i].vertexNum[1] = edges[i].vertexNum[1];
+		model->edges[i].internal = edges[i].internal;
+		model->edges[i].numUsers = edges[i].numUsers;
+		model->edges[i].normal = vec3_origin;
+		model->edges[i].checkcount = 0;
+		model->numInternalEdges += model->edges[i].internal;
+	}
+
+	// nodes
+	numNodes = src.ReadInt();
+	const cmBinaryNode_t *nodes = (const cmBinaryNode_t *)src.ReadBlob( numNodes, sizeof( cmBinaryNode_t ) );
+	if ( !nodes || numNodes < 1 ) {
+		return false;
+	}
+	model->node = ReadBinaryNodes( nodes, numNodes, model, NULL );
+	if ( !model->node ) {
+		return false;
+	}
+
+	// polygons
+	numMaterials = src.ReadInt();
+	if ( numMaterials < 0 ) {
+		return false;
+	}
+	materials.SetNum( numMaterials );
+	for ( i = 0; i < numMaterials; i++ ) {
+		materials[i] = declManager->FindMaterial( src.ReadString() );
+	}
+
+	memory = src.ReadInt();
+	num = src.ReadInt();
+	if ( src.Failed() || memory < 0 ) {
+		return false;
+	}
+	model->polygonBlock = (cm_polygonBlock_t *) Mem_Alloc( sizeof( cm_polygonBlock_t ) + memory );
+	model->polygonBlock->bytesRemaining = memory;
+	model->polygonBlock->next = ( (byte *) model->polygonBlock ) + sizeof( cm_polygonBlock_t );
+
+	for ( i = 0; i < num; i++ ) {
+		const cmBinaryPolygon_t *bp = (const cmBinaryPolygon_t *)src.ReadBlob( 1, sizeof( cmBinaryPolygon_t ) );
+		if ( !bp || bp->material < 0 || bp->material >= numMaterials ) {
+			return false;
+		}
+		const int *polygonEdges = (const int *)src.ReadBlob( bp->numEdges, sizeof( int ) );
+		if ( !polygonEdges ) {
+			return false;
+		}
+		cm_polygon_t *p = AllocPolygon( model, bp->numEdges );
+		p->numEdges = bp->numEdges;
+		memcpy( p->edges, polygonEdges, p->numEdges * sizeof( p->edges[0] ) );
+		p->plane = bp->plane;
+		p->bounds = bp->bounds;
+		p->material = materials[bp->material];
+		p->contents = p->material->GetContentFlags();
+		p->checkcount = 0;
+		// filter polygon into tree
+		R_FilterPolygonIntoTree( model, model->node, NULL, p );
+	}
+
+	// brushes
+	memory = src.ReadInt();
+	num = src.ReadInt();
+	if ( src.Failed() || memory < 0 ) {
+		return false;
+	}
+	model->brushBlock = (cm_brushBlock_t *) Mem_Alloc( sizeof( cm_brushBlock_t ) + memory );
+	model->brushBlock->bytesRemaining = memory;
+	model->brushBlock->next = ( (byte *) model->brushBlock ) + sizeof( cm_brushBlock_t );
+
+	for ( i = 0; i < num; i++ ) {
+		const cmBinaryBrush_t *bb = (const cmBinaryBrush_t *)src.ReadBlob( 1, sizeof( cmBinaryBrush_t ) );
+		if ( !bb ) {
+			return false;
+		}
+		const idPlane *planes = (const idPlane *)src.ReadBlob( bb->numPlanes, sizeof( idPlane ) );
+		if ( !planes ) {
+			return false;
+		}
+		cm_brush_t *b = AllocBrush( model, bb->numPlanes );
+		b->numPlanes = bb->numPlanes;
+		memcpy( b->planes, planes, b->numPlanes * sizeof( b->planes[0] ) );
+		b->bounds = bb->bounds;
+		b->contents = bb->contents;
+		b->checkcount = 0;
+		b->primitiveNum = 0;
+		// filter brush into tree
+		R_FilterBrushIntoTree( model, model->node, NULL, b );
+	}
+
+	FinishCollisionModel( model );
+
+	return true;
+}
+
+/*
+================
+idCollisionModelManagerLocal::LoadBinaryCollisionModelFile
+================
+*/
+bool idCollisionModelManagerLocal::LoadBinaryCollisionModelFile( const char *name, const unsigned int mapFileCRC ) {
+	idStr fileName;
+	const byte *buffer;
+	int length, i, num, firstModel;
+	bool ok;
+
+	fileName = name;
+	fileName.SetFileExtension( CM_BINARY_FILE_EXT );
+
+	length = fileSystem->ReadFileMapped( fileName, (const void **)&buffer, NULL );
+	if ( length < 0 || !buffer ) {
+		return false;
+	}
+
+	idCMBinaryReader src( buffer, length );
+
+	const char *id = (const char *)src.ReadBlob( 4, 1 );
+	int version = src.ReadInt();
+	unsigned int crc = (unsigned int)src.ReadInt();
+	num = src.ReadInt();
+
+	if ( !id || memcmp( id, CM_BINARY_FILEID, 4 ) || version != CM_BINARY_FILEVERSION || crc != mapFileCRC || num < 0 ) {
+		common->Printf( "%s is out of date\n", fileName.c_str() );
+		fileSystem->FreeFile( (void *)buffer );
+		return false;
+	}
+
+	firstModel = numModels;
+	ok = true;
+	for ( i = 0; i < num && ok; i++ ) {
+		ok = ReadBinaryCollisionModel( src ) && !src.Failed();
+	}
+	ok = ok && src.AtEnd();
+
+	fileSystem->FreeFile( (void *)buffer );
+
+	if ( !ok ) {
+		common->Warning( "%s is damaged", fileName.c_str() );
+		for ( i = firstModel; i < numModels; i++ ) {
+			FreeModel( models[i] );
+			models[i] = NULL;
+		}
+		numModels = firstModel;
+		return false;
+	}
 
 	return true;
 }
@@ -549,6 +1059,12 @@ bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char *name, con
 	idToken token;
 	idLexer *src;
 	unsigned int crc;
+	int firstModel;
+
+	// the map collision models have a binary version validated by the map file crc
+	if ( mapFileCRC && cm_binaryCollisionModels.GetBool() && LoadBinaryCollisionModelFile( name, mapFileCRC ) ) {
+		return true;
+	}
 
 	// load it
 	fileName = name;
@@ -586,6 +1102,7 @@ bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char *name, con
 	}
 
 	// parse the file
+	firstModel = numModels;
 	while ( 1 ) {
 		if ( !src->ReadToken( &token ) ) {
 			break;
@@ -604,5 +1121,9 @@ bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char *name, con
 
 	delete src;
 
+	if ( mapFileCRC && cm_binaryCollisionModels.GetBool() ) {
+		WriteBinaryCollisionModelsToFile( name, firstModel, numModels, mapFileCRC );
+	}
+
 	return true;
 }
@@ -181,10 +181,6 @@ void idCollisionModelManagerLocal::Clear( void ) {
 	trmMaterial = NULL;
 	numProcNodes = 0;
 	procNodes = NULL;
-	getContacts = false;
-	contacts = NULL;
-	maxContacts = 0;
-	numContacts = 0;
 }
 
 /*
@@ -811,7 +807,6 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 	trmVert = trm.verts;
 	for ( i = 0; i < trm.numVerts; i++, vertex++, trmVert++ ) {
 		vertex->p = *trmVert;
-		vertex->sideSet = 0;
 	}
 	// edges
 	model->numEdges = trm.numEdges;
@@ -822,7 +817,6 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 		edge->vertexNum[1] = trmEdge->v[1];
 		edge->normal = trmEdge->normal;
 		edge->internal = false;
-		edge->sideSet = 0;
 	}
 	// polygons
 	model->numPolygons = trm.numPolys;
@@ -1822,6 +1816,109 @@ Spatial subdivision
 ===============================================================================
 */
 
+/*
+================
+CM_SortFloat
+================
+*/
+static int CM_SortFloat( const float *a, const float *b ) {
+	return ( *a < *b ) ? -1 : ( ( *a > *b ) ? 1 : 0 );
+}
+
+/*
+================
+CM_FindSAHSplitter
+
+  Chooses among the same splitters as CM_FindSplitter, the bounds of the brushes and
+  polygons in the node and its parents, the one with the lowest surface area heuristic
+  cost: the surface of each child times the number of brushes and polygons that end up
+  in it. Detail brushwork is dense in some places and empty in others, a centered
+  splitter cuts through the middle of the clutter where this one separates it from
+  the empty space.
+================
+*/
+static int CM_FindSAHSplitter( const cm_node_t *node, const idBounds &bounds, bool forceSplit, int *planeType, float *planeDist ) {
+	int i, type, numBack, numFront, num;
+	float dist, length, e1, e2, area, cost, bestCost;
+	cm_brushRef_t *bref;
+	cm_polygonRef_t *pref;
+	const cm_node_t *n;
+	idList<const idBounds *> primBounds;
+	idList<float> mins, maxs, splits;
+
+	// everything that will be filtered into the children
+	for ( n = node; n; n = n->parent ) {
+		for ( bref = n->brushes; bref; bref = bref->next ) {
+			if ( bref->b->bounds.IntersectsBounds( bounds ) ) {
+				primBounds.Append( &bref->b->bounds );
+			}
+		}
+		for ( pref = n->polygons; pref; pref = pref->next ) {
+			if ( pref->p->bounds.IntersectsBounds( bounds ) ) {
+				primBounds.Append( &pref->p->bounds );
+			}
+		}
+	}
+	num = primBounds.Num();
+
+	bestCost = idMath::INFINITY;
+	for ( type = 0; type < 3; type++ ) {
+		length = bounds[1][type] - bounds[0][type];
+		// if the node is small anough in this axis direction
+		if ( !forceSplit && length < MIN_NODE_SIZE ) {
+			continue;
+		}
+		e1 = bounds[1][(type+1)%3] - bounds[0][(type+1)%3];
+		e2 = bounds[1][(type+2)%3] - bounds[0][(type+2)%3];
+		area = e1 * e2;
+
+		mins.SetNum( num, false );
+		maxs.SetNum( num, false );
+		for ( i = 0; i < num; i++ ) {
+			mins[i] = (*primBounds[i])[0][type];
+			maxs[i] = (*primBounds[i])[1][type];
+		}
+		mins.Sort( CM_SortFloat );
+		maxs.Sort( CM_SortFloat );
+		splits = mins;
+		splits.Append( maxs );
+		splits.Sort( CM_SortFloat );
+
+		// sweep the splitters in order, counting what starts before and ends after each
+		numBack = 0;
+		numFront = num;
+		int m = 0, x = 0;
+		for ( i = 0; i < splits.Num(); i++ ) {
+			dist = splits[i];
+			while ( m < num && mins[m] < dist ) {
+				m++;
+			}
+			while ( x < num && maxs[x] <= dist ) {
+				x++;
+			}
+			// if the splitter is already used or outside node bounds
+			if ( dist >= bounds[1][type] || dist <= bounds[0][type] ) {
+				continue;
+			}
+			// don't create splitters real close to the bounds
+			if ( !forceSplit && ( bounds[1][type] - dist <= (MIN_NODE_SIZE*0.5f) || dist - bounds[0][type] <= (MIN_NODE_SIZE*0.5f) ) ) {
+				continue;
+			}
+			numBack = m;
+			numFront = num - x;
+			// surface area of each child box, the face shared with the other child counted once
+			cost = ( ( dist - bounds[0][type] ) * ( e1 + e2 ) + area ) * numBack
+					+ ( ( bounds[1][type] - dist ) * ( e1 + e2 ) + area ) * numFront;
+			if ( cost < bestCost ) {
+				bestCost = cost;
+				*planeType = type;
+				*planeDist = dist;
+			}
+		}
+	}
+	return ( bestCost < idMath::INFINITY );
+}
+
 /*
 ================
 CM_FindSplitter
@@ -1861,6 +1958,9 @@ static int CM_FindSplitter( const cm_node_t *node, const idBounds &bounds, int *
 			forceSplit = true;
 		}
 	}
+	if ( cm_sahSplitter.GetBool() ) {
+		return CM_FindSAHSplitter( node, bounds, forceSplit, planeType, planeDist );
+	}
 	// find an axial aligned splitter
 	for ( i = 0; i < 3; i++ ) {
 		// start with the largest axis first
@@ -3361,6 +3461,7 @@ idCollisionModelManagerLocal::LoadMap
 ================
 */
 void idCollisionModelManagerLocal::LoadMap( const idMapFile *mapFile ) {
+	idScopedMemTag memTag( MEMTAG_COLLISION );
 
 	if ( mapFile == NULL ) {
 		common->Error( "idCollisionModelManagerLocal::LoadMap: NULL mapFile" );
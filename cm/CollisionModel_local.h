@@ -39,6 +39,14 @@
 #define VERTEX_HASH_SIZE					(VERTEX_HASH_BOXSIZE*VERTEX_HASH_BOXSIZE)
 #define EDGE_HASH_SIZE						(1<<14)
 
+#ifdef _WIN32
+	#include <intrin.h>
+	#pragma intrinsic( _InterlockedExchangeAdd )
+	#define CM_ATOMIC_ADD( x, v )			_InterlockedExchangeAdd( (volatile long *)(x), (v) )
+#else
+	#define CM_ATOMIC_ADD( x, v )			__sync_fetch_and_add( (x), (v) )
+#endif
+
 #define NODE_BLOCK_SIZE_SMALL				8
 #define NODE_BLOCK_SIZE_LARGE				256
 #define REFERENCE_BLOCK_SIZE_SMALL			8
@@ -72,16 +80,12 @@ Collision model
 typedef struct cm_vertex_s {
 	idVec3					p;					// vertex point
 	int						checkcount;			// for multi-check avoidance
-	unsigned long			side;				// each bit tells at which side this vertex passes one of the trace model edges
-	unsigned long			sideSet;			// each bit tells if sidedness for the trace model edge has been calculated yet
 } cm_vertex_t;
 
 typedef struct cm_edge_s {
 	int						checkcount;			// for multi-check avoidance
 	unsigned short			internal;			// a trace model can never collide with internal edges
 	unsigned short			numUsers;			// number of polygons using this edge
-	unsigned long			side;				// each bit tells at which side of this edge one of the trace model vertices passes
-	unsigned long			sideSet;			// each bit tells if sidedness for the trace model vertex has been calculated yet
 	int						vertexNum[2];		// start and end point of edge
 	idVec3					normal;				// edge normal
 } cm_edge_t;
@@ -225,6 +229,10 @@ typedef struct cm_trmPolygon_s {
 typedef struct cm_traceWork_s {
 	int numVerts;
 	cm_trmVertex_t vertices[MAX_TRACEMODEL_VERTS];	// trm vertices
+	int numUsedVerts;								// number of used trm vertices for translations
+	int usedVertexNums[MAX_TRACEMODEL_VERTS];		// indexes into vertices
+	idVec3 usedVertexPoints[MAX_TRACEMODEL_VERTS];	// start points packed for SIMDProcessor->Dot
+	float usedVertexDist[MAX_TRACEMODEL_VERTS];		// distances of the start points to the current polygon plane
 	int numEdges;
 	cm_trmEdge_t edges[MAX_TRACEMODEL_EDGES+1];		// trm edges
 	int numPolys;
@@ -246,6 +254,7 @@ typedef struct cm_traceWork_s {
 	bool axisIntersectsTrm;							// true if the rotation axis intersects the trace model
 	bool getContacts;								// true if retrieving contacts
 	bool quickExit;									// set to quickly stop the collision detection calculations
+	int checkCount;									// marks the polygons and edges this trace already checked
 
 	idVec3 origin;									// origin of rotation in model space
 	idVec3 axis;									// rotation axis in model space
@@ -266,8 +275,17 @@ typedef struct cm_traceWork_s {
 	idPluecker polygonEdgePlueckerCache[CM_MAX_POLYGON_EDGES];
 	idPluecker polygonVertexPlueckerCache[CM_MAX_POLYGON_EDGES];
 	idVec3 polygonRotationOriginCache[CM_MAX_POLYGON_EDGES];
+													// the sidedness is kept per trace instead of in the shared model edges and vertices
+	unsigned long polygonEdgeSide[CM_MAX_POLYGON_EDGES];	// each bit tells at which side of the polygon edge one of the trm vertices passes
+	unsigned long polygonEdgeSideSet[CM_MAX_POLYGON_EDGES];	// each bit tells if sidedness for the trm vertex has been calculated yet
+	unsigned long polygonVertexSide[CM_MAX_POLYGON_EDGES];	// each bit tells at which side the polygon vertex passes one of the trm edges or polygons
+	unsigned long polygonVertexSideSet[CM_MAX_POLYGON_EDGES];	// each bit tells if sidedness for the trm edge or polygon has been calculated yet
 } cm_traceWork_t;
 
+// the binary collision model file, CollisionModel_files.cpp
+typedef struct cmBinaryNode_s cmBinaryNode_t;
+class idCMBinaryReader;
+
 /*
 ===============================================================================
 
@@ -312,6 +330,8 @@ public:
 	void			Translation( trace_t *results, const idVec3 &start, const idVec3 &end,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
+	// translates a batch of trms, the point traces are run on several threads
+	void			TranslationBatch( trace_t *results, const cmTraceRequest_t *requests, const int numRequests );
 	// rotates a trm and reports the first collision if any
 	void			Rotation( trace_t *results, const idVec3 &start, const idRotation &rotation,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
@@ -337,14 +357,21 @@ public:
 	bool			WriteCollisionModelForMapEntity( const idMapEntity *mapEnt, const char *filename, const bool testTraceModel = true );
 
 private:			// CollisionMap_translate.cpp
+	int				GetCheckCounts( const int num );
 	int				TranslateEdgeThroughEdge( idVec3 &cross, idPluecker &l1, idPluecker &l2, float *fraction );
 	void			TranslateTrmEdgeThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *poly, cm_trmEdge_t *trmEdge );
-	void			TranslateTrmVertexThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *poly, cm_trmVertex_t *v, int bitNum );
+	void			TranslateTrmVertexThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *poly, cm_trmVertex_t *v, int bitNum, float f );
 	void			TranslatePointThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *poly, cm_trmVertex_t *v );
-	void			TranslateVertexThroughTrmPolygon( cm_traceWork_t *tw, cm_trmPolygon_t *trmpoly, cm_polygon_t *poly, cm_vertex_t *v, idVec3 &endp, idPluecker &pl );
+	void			TranslateVertexThroughTrmPolygon( cm_traceWork_t *tw, cm_trmPolygon_t *trmpoly, cm_polygon_t *poly, cm_vertex_t *v, int vertexSlot, idVec3 &endp, idPluecker &pl );
 	bool			TranslateTrmThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *p );
 	void			SetupTranslationHeartPlanes( cm_traceWork_t *tw );
+	void			TranslatePoint( cm_traceWork_t *tw, trace_t *results, const idVec3 &start, const idVec3 &end,
+								const idVec3 &modelOrigin, const idMat3 &modelAxis );
 	void			SetupTrm( cm_traceWork_t *tw, const idTraceModel *trm );
+	void			TranslationContacts( trace_t *results, const idVec3 &start, const idVec3 &end,
+								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+								contactInfo_t *contacts, const int maxContacts, int *numContacts );
 
 private:			// CollisionMap_rotate.cpp
 	int				CollisionBetweenEdgeBounds( cm_traceWork_t *tw, const idVec3 &va, const idVec3 &vb,
@@ -472,6 +499,11 @@ private:			// CollisionMap_files.cpp
 	void			WriteBrushes( idFile *fp, cm_node_t *node );
 	void			WriteCollisionModel( idFile *fp, cm_model_t *model );
 	void			WriteCollisionModelsToFile( const char *filename, int firstModel, int lastModel, unsigned int mapFileCRC );
+	void			WriteBinaryNodes( idList<cmBinaryNode_t> &nodes, cm_node_t *node );
+	void			GetPolygons( idList<cm_polygon_t *> &polygons, cm_node_t *node );
+	void			GetBrushes( idList<cm_brush_t *> &brushes, cm_node_t *node );
+	void			WriteBinaryCollisionModel( idFile *fp, cm_model_t *model );
+	void			WriteBinaryCollisionModelsToFile( const char *filename, int firstModel, int lastModel, unsigned int mapFileCRC );
 					// loading
 	cm_node_t *		ParseNodes( idLexer *src, cm_model_t *model, cm_node_t *parent );
 	void			ParseVertices( idLexer *src, cm_model_t *model );
@@ -479,7 +511,11 @@ private:			// CollisionMap_files.cpp
 	void			ParsePolygons( idLexer *src, cm_model_t *model );
 	void			ParseBrushes( idLexer *src, cm_model_t *model );
 	bool			ParseCollisionModel( idLexer *src );
+	void			FinishCollisionModel( cm_model_t *model );
 	bool			LoadCollisionModelFile( const char *name, const unsigned int mapFileCRC );
+	cm_node_t *		ReadBinaryNodes( const cmBinaryNode_t *nodes, int numNodes, cm_model_t *model, cm_node_t *parent );
+	bool			ReadBinaryCollisionModel( idCMBinaryReader &src );
+	bool			LoadBinaryCollisionModelFile( const char *name, const unsigned int mapFileCRC );
 	const idStr			GetSkinnedName	( const char *fileName, const idDeclSkin* skin ) const;		// #4232 SteveL
 	const idMaterial*	GetSkinnedShader( const idMaterial* shader, const idDeclSkin* skin ) const;	// #4232 SteveL
 
@@ -496,8 +532,8 @@ private:			// collision map data
 	idStr			mapName;
 	ID_TIME_T			mapFileTime;
 	int				loaded;
-					// for multi-check avoidance
-	int				checkCount;
+					// for multi-check avoidance, the traces take theirs with GetCheckCounts
+	volatile int	checkCount;
 					// models
 	int				maxModels;
 	int				numModels;
@@ -509,14 +545,12 @@ private:			// collision map data
 					// for data pruning
 	int				numProcNodes;
 	cm_procNode_t *	procNodes;
-					// for retrieving contact points
-	bool			getContacts;
-	contactInfo_t *	contacts;
-	int				maxContacts;
-	int				numContacts;
 };
 
 // for debugging
 extern idCVar cm_debugCollision;
+extern idCVar cm_parallelTraces;
+extern idCVar cm_binaryCollisionModels;
+extern idCVar cm_sahSplitter;
 
 
@@ -190,15 +190,15 @@ ID_INLINE void CM_AddContact( cm_traceWork_t *tw ) {
 ================
 CM_SetVertexSidedness
 
-  stores for the given model vertex at which side of one of the trm edges it passes
+  stores for the given vertex of the current polygon at which side of one of the trm edges it passes
 ================
 */
-ID_INLINE void CM_SetVertexSidedness( cm_vertex_t *v, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
-	if ( !(v->sideSet & (1<<bitNum)) ) {
+ID_INLINE void CM_SetVertexSidedness( cm_traceWork_t *tw, const int vertexSlot, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
+	if ( !(tw->polygonVertexSideSet[vertexSlot] & (1<<bitNum)) ) {
 		float fl;
 		fl = vpl.PermutedInnerProduct( epl );
-		v->side = (v->side & ~(1<<bitNum)) | (FLOATSIGNBITSET(fl) << bitNum);
-		v->sideSet |= (1 << bitNum);
+		tw->polygonVertexSide[vertexSlot] = (tw->polygonVertexSide[vertexSlot] & ~(1<<bitNum)) | (FLOATSIGNBITSET(fl) << bitNum);
+		tw->polygonVertexSideSet[vertexSlot] |= (1 << bitNum);
 	}
 }
 
@@ -206,15 +206,15 @@ ID_INLINE void CM_SetVertexSidedness( cm_vertex_t *v, const idPluecker &vpl, con
 ================
 CM_SetEdgeSidedness
 
-  stores for the given model edge at which side one of the trm vertices
+  stores for the given edge of the current polygon at which side one of the trm vertices passes
 ================
 */
-ID_INLINE void CM_SetEdgeSidedness( cm_edge_t *edge, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
-	if ( !(edge->sideSet & (1<<bitNum)) ) {
+ID_INLINE void CM_SetEdgeSidedness( cm_traceWork_t *tw, const int edgeSlot, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
+	if ( !(tw->polygonEdgeSideSet[edgeSlot] & (1<<bitNum)) ) {
 		float fl;
 		fl = vpl.PermutedInnerProduct( epl );
-		edge->side = (edge->side & ~(1<<bitNum)) | (FLOATSIGNBITSET(fl) << bitNum);
-		edge->sideSet |= (1 << bitNum);
+		tw->polygonEdgeSide[edgeSlot] = (tw->polygonEdgeSide[edgeSlot] & ~(1<<bitNum)) | (FLOATSIGNBITSET(fl) << bitNum);
+		tw->polygonEdgeSideSet[edgeSlot] |= (1 << bitNum);
 	}
 }
 
@@ -224,11 +224,10 @@ idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon
 ================
 */
 void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *poly, cm_trmEdge_t *trmEdge ) {
-	int i, edgeNum;
+	int i, next, edgeNum;
 	float f1, f2, dist, d1, d2;
 	idVec3 start, end, normal;
 	cm_edge_t *edge;
-	cm_vertex_t *v1, *v2;
 	idPluecker *pl, epsPl;
 
 	// check edges for a collision
@@ -236,7 +235,7 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 		edgeNum = poly->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
 		// if this edge is already checked
-		if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+		if ( edge->checkcount == tw->checkCount ) {
 			continue;
 		}
 		// can never collide with internal edges
@@ -245,19 +244,19 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 		}
 		pl = &tw->polygonEdgePlueckerCache[i];
 		// get the sides at which the trm edge vertices pass the polygon edge
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
+		CM_SetEdgeSidedness( tw, i, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
+		CM_SetEdgeSidedness( tw, i, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
 		// if the trm edge start and end vertex do not pass the polygon edge at different sides
-		if ( !(((edge->side >> trmEdge->vertexNum[0]) ^ (edge->side >> trmEdge->vertexNum[1])) & 1) ) {
+		if ( !(((tw->polygonEdgeSide[i] >> trmEdge->vertexNum[0]) ^ (tw->polygonEdgeSide[i] >> trmEdge->vertexNum[1])) & 1) ) {
 			continue;
 		}
-		// get the sides at which the polygon edge vertices pass the trm edge
-		v1 = tw->model->vertices + edge->vertexNum[INTSIGNBITSET(edgeNum)];
-		CM_SetVertexSidedness( v1, tw->polygonVertexPlueckerCache[i], trmEdge->pl, trmEdge->bitNum );
-		v2 = tw->model->vertices + edge->vertexNum[INTSIGNBITNOTSET(edgeNum)];
-		CM_SetVertexSidedness( v2, tw->polygonVertexPlueckerCache[i+1], trmEdge->pl, trmEdge->bitNum );
+		// get the sides at which the polygon edge vertices pass the trm edge, the edge
+		// starts at polygon vertex i and ends at the start of the next edge
+		next = ( i + 1 < poly->numEdges ) ? i + 1 : 0;
+		CM_SetVertexSidedness( tw, i, tw->polygonVertexPlueckerCache[i], trmEdge->pl, trmEdge->bitNum );
+		CM_SetVertexSidedness( tw, next, tw->polygonVertexPlueckerCache[i+1], trmEdge->pl, trmEdge->bitNum );
 		// if the polygon edge start and end vertex do not pass the trm edge at different sides
-		if ( !((v1->side ^ v2->side) & (1<<trmEdge->bitNum)) ) {
+		if ( !((tw->polygonVertexSide[i] ^ tw->polygonVertexSide[next]) & (1<<trmEdge->bitNum)) ) {
 			continue;
 		}
 		// if there is no possible collision between the trm edge and the polygon edge
@@ -386,24 +385,50 @@ float CM_TranslationPlaneFraction( idPlane &plane, idVec3 &start, idVec3 &end )
 
 #endif
 
+/*
+================
+CM_TranslationPlaneFraction
+
+  same as above from the start and end point distances to the plane
+================
+*/
+ID_INLINE float CM_TranslationPlaneFraction( float d1, float d2 ) {
+	float d2eps;
+
+	// if the end point is closer to the plane than an epsilon we still take it for a collision
+	d2eps = d2 - CM_CLIP_EPSILON;
+	if ( FLOATSIGNBITNOTSET(d2eps) ) {
+		return 1.0f;
+	}
+	// if completely behind the polygon
+	if ( FLOATSIGNBITSET(d1) ) {
+		return 1.0f;
+	}
+	// if going towards the front of the plane and
+	// the start and end point are not at equal distance from the plane
+	d2 = d1 - d2;
+	if ( d2 <= 0.0f ) {
+		return 1.0f;
+	}
+	return (d1-CM_CLIP_EPSILON) / d2;
+}
+
 /*
 ================
 idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon
+
+  f is the fraction at which the vertex crosses the polygon plane
 ================
 */
-void idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *poly, cm_trmVertex_t *v, int bitNum ) {
+void idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *poly, cm_trmVertex_t *v, int bitNum, float f ) {
 	int i, edgeNum;
-	float f;
-	cm_edge_t *edge;
 
-	f = CM_TranslationPlaneFraction( poly->plane, v->p, v->endp );
 	if ( f < tw->trace.fraction ) {
 
 		for ( i = 0; i < poly->numEdges; i++ ) {
 			edgeNum = poly->edges[i];
-			edge = tw->model->edges + abs(edgeNum);
-			CM_SetEdgeSidedness( edge, tw->polygonEdgePlueckerCache[i], v->pl, bitNum );
-			if ( INTSIGNBITSET(edgeNum) ^ ((edge->side >> bitNum) & 1) ) {
+			CM_SetEdgeSidedness( tw, i, tw->polygonEdgePlueckerCache[i], v->pl, bitNum );
+			if ( INTSIGNBITSET(edgeNum) ^ ((tw->polygonEdgeSide[i] >> bitNum) & 1) ) {
 				return;
 			}
 		}
@@ -444,19 +469,14 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t
 	if ( f < tw->trace.fraction ) {
 
 		for ( i = 0; i < poly->numEdges; i++ ) {
+			float fl;
 			edgeNum = poly->edges[i];
 			edge = tw->model->edges + abs(edgeNum);
-			// if we didn't yet calculate the sidedness for this edge
-			if ( edge->checkcount != idCollisionModelManagerLocal::checkCount ) {
-				float fl;
-				edge->checkcount = idCollisionModelManagerLocal::checkCount;
-				pl.FromLine(tw->model->vertices[edge->vertexNum[0]].p, tw->model->vertices[edge->vertexNum[1]].p);
-				fl = v->pl.PermutedInnerProduct( pl );
-				edge->side = FLOATSIGNBITSET(fl);
-			}
+			// the edges are shared with the traces on the other threads, so the sidedness isn't cached in them
+			pl.FromLine(tw->model->vertices[edge->vertexNum[0]].p, tw->model->vertices[edge->vertexNum[1]].p);
+			fl = v->pl.PermutedInnerProduct( pl );
 			// if the point passes the edge at the wrong side
-			//if ( (edgeNum > 0) == edge->side ) {
-			if ( INTSIGNBITSET(edgeNum) ^ edge->side ) {
+			if ( INTSIGNBITSET(edgeNum) ^ FLOATSIGNBITSET(fl) ) {
 				return;
 			}
 		}
@@ -487,7 +507,7 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t
 idCollisionModelManagerLocal::TranslateVertexThroughTrmPolygon
 ================
 */
-void idCollisionModelManagerLocal::TranslateVertexThroughTrmPolygon( cm_traceWork_t *tw, cm_trmPolygon_t *trmpoly, cm_polygon_t *poly, cm_vertex_t *v, idVec3 &endp, idPluecker &pl ) {
+void idCollisionModelManagerLocal::TranslateVertexThroughTrmPolygon( cm_traceWork_t *tw, cm_trmPolygon_t *trmpoly, cm_polygon_t *poly, cm_vertex_t *v, int vertexSlot, idVec3 &endp, idPluecker &pl ) {
 	int i, edgeNum;
 	float f;
 	cm_trmEdge_t *edge;
@@ -499,8 +519,8 @@ void idCollisionModelManagerLocal::TranslateVertexThroughTrmPolygon( cm_traceWor
 			edgeNum = trmpoly->edges[i];
 			edge = tw->edges + abs(edgeNum);
 
-			CM_SetVertexSidedness( v, pl, edge->pl, edge->bitNum );
-			if ( INTSIGNBITSET(edgeNum) ^ ((v->side >> edge->bitNum) & 1) ) {
+			CM_SetVertexSidedness( tw, vertexSlot, pl, edge->pl, edge->bitNum );
+			if ( INTSIGNBITSET(edgeNum) ^ ((tw->polygonVertexSide[vertexSlot] >> edge->bitNum) & 1) ) {
 				return;
 			}
 		}
@@ -543,10 +563,10 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 	cm_edge_t *e;
 
 	// if already checked this polygon
-	if ( p->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( p->checkcount == tw->checkCount ) {
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	p->checkcount = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if ( !(p->contents & tw->contents) ) {
@@ -599,30 +619,31 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 		for ( i = 0; i < p->numEdges; i++ ) {
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
-			// reset sidedness cache if this is the first time we encounter this edge during this trace
-			if ( e->checkcount != idCollisionModelManagerLocal::checkCount ) {
-				e->sideSet = 0;
-			}
+			// reset the sidedness cache of this polygon edge and the vertex it starts at
+			tw->polygonEdgeSideSet[i] = 0;
+			tw->polygonVertexSideSet[i] = 0;
 			// pluecker coordinate for edge
 			tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[e->vertexNum[0]].p,
 														tw->model->vertices[e->vertexNum[1]].p );
 
 			v = &tw->model->vertices[e->vertexNum[INTSIGNBITSET(edgeNum)]];
-			// reset sidedness cache if this is the first time we encounter this vertex during this trace
-			if ( v->checkcount != idCollisionModelManagerLocal::checkCount ) {
-				v->sideSet = 0;
-			}
 			// pluecker coordinate for vertex movement vector
 			tw->polygonVertexPlueckerCache[i].FromRay( v->p, -tw->dir );
 		}
 		// copy first to last so we can easily cycle through for the edges
 		tw->polygonVertexPlueckerCache[p->numEdges] = tw->polygonVertexPlueckerCache[0];
 
-		// trace trm vertices through polygon
-		for ( i = 0; i < tw->numVerts; i++ ) {
+		// trace trm vertices through polygon, the plane distances of all the start points in
+		// one go, the end points are all moved by the trace direction
+		SIMDProcessor->Dot( tw->usedVertexDist, p->plane, tw->usedVertexPoints, tw->numUsedVerts );
+		d = p->plane.Normal() * tw->dir;
+		for ( j = 0; j < tw->numUsedVerts; j++ ) {
+			i = tw->usedVertexNums[j];
 			bv = tw->vertices + i;
+			// a vertex stored as a contact is no longer used
 			if ( bv->used ) {
-				idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon( tw, p, bv, i );
+				idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon( tw, p, bv, i,
+					CM_TranslationPlaneFraction( tw->usedVertexDist[j], tw->usedVertexDist[j] + d ) );
 			}
 		}
 
@@ -639,11 +660,11 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
 
-			if ( e->checkcount == idCollisionModelManagerLocal::checkCount ) {
+			if ( e->checkcount == tw->checkCount ) {
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			e->checkcount = tw->checkCount;
 			// can never collide with internal edges
 			if ( e->internal ) {
 				continue;
@@ -653,11 +674,11 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 
 				v = tw->model->vertices + e->vertexNum[k ^ INTSIGNBITSET(edgeNum)];
 				// if this vertex is already checked
-				if ( v->checkcount == idCollisionModelManagerLocal::checkCount ) {
+				if ( v->checkcount == tw->checkCount ) {
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				v->checkcount = tw->checkCount;
 
 				// if the vertex is outside the trace bounds
 				if ( !tw->bounds.ContainsPoint( v->p ) ) {
@@ -672,7 +693,7 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 				for ( j = 0; j < tw->numPolys; j++ ) {
 					bp = tw->polys + j;
 					if ( bp->used ) {
-						idCollisionModelManagerLocal::TranslateVertexThroughTrmPolygon( tw, bp, p, v, endp, *pl );
+						idCollisionModelManagerLocal::TranslateVertexThroughTrmPolygon( tw, bp, p, v, ( i + k < p->numEdges ) ? i + k : 0, endp, *pl );
 					}
 				}
 			}
@@ -752,18 +773,176 @@ void idCollisionModelManagerLocal::SetupTranslationHeartPlanes( cm_traceWork_t *
 	tw->heartPlane2.FitThroughPoint( tw->start );
 }
 
+/*
+================
+CM_IsPointTrace
+================
+*/
+static ID_INLINE bool CM_IsPointTrace( const idTraceModel *trm ) {
+	return ( !trm || ( trm->bounds[1][0] - trm->bounds[0][0] <= 0.0f &&
+						trm->bounds[1][1] - trm->bounds[0][1] <= 0.0f &&
+						trm->bounds[1][2] - trm->bounds[0][2] <= 0.0f ) );
+}
+
+/*
+================
+idCollisionModelManagerLocal::TranslatePoint
+
+  the optimized point trace, the trace work must be set up up to the trace direction
+================
+*/
+void idCollisionModelManagerLocal::TranslatePoint( cm_traceWork_t *tw, trace_t *results, const idVec3 &start, const idVec3 &end,
+										const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+	int i;
+	bool model_rotated;
+
+	model_rotated = modelAxis.IsRotated();
+	if ( model_rotated ) {
+		// rotate trace instead of model
+		idMat3 invModelAxis = modelAxis.Transpose();
+		tw->start *= invModelAxis;
+		tw->end *= invModelAxis;
+		tw->dir *= invModelAxis;
+	}
+
+	// trace bounds
+	for ( i = 0; i < 3; i++ ) {
+		if ( tw->start[i] < tw->end[i] ) {
+			tw->bounds[0][i] = tw->start[i] - CM_BOX_EPSILON;
+			tw->bounds[1][i] = tw->end[i] + CM_BOX_EPSILON;
+		}
+		else {
+			tw->bounds[0][i] = tw->end[i] - CM_BOX_EPSILON;
+			tw->bounds[1][i] = tw->start[i] + CM_BOX_EPSILON;
+		}
+	}
+	tw->extents[0] = tw->extents[1] = tw->extents[2] = CM_BOX_EPSILON;
+	tw->size.Zero();
+
+	// setup trace heart planes
+	idCollisionModelManagerLocal::SetupTranslationHeartPlanes( tw );
+	tw->maxDistFromHeartPlane1 = CM_BOX_EPSILON;
+	tw->maxDistFromHeartPlane2 = CM_BOX_EPSILON;
+	// collision with single point
+	tw->numVerts = 1;
+	tw->vertices[0].p = tw->start;
+	tw->vertices[0].endp = tw->vertices[0].p + tw->dir;
+	tw->vertices[0].pl.FromRay( tw->vertices[0].p, tw->dir );
+	tw->numEdges = tw->numPolys = 0;
+	tw->pointTrace = true;
+	// trace through the model
+	idCollisionModelManagerLocal::TraceThroughModel( tw );
+	// store results
+	*results = tw->trace;
+	results->endpos = start + results->fraction * (end - start);
+	results->endAxis = mat3_identity;
+
+	if ( results->fraction < 1.0f ) {
+		// rotate trace plane normal if there was a collision with a rotated model
+		if ( model_rotated ) {
+			results->c.normal *= modelAxis;
+			results->c.point *= modelAxis;
+		}
+		results->c.point += modelOrigin;
+		results->c.dist += modelOrigin * results->c.normal;
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::GetCheckCounts
+
+  reserves num check counts and returns the first one, a trace marks the polygons, edges and
+  vertices it already checked with its own check count so traces can run on several threads
+================
+*/
+int idCollisionModelManagerLocal::GetCheckCounts( const int num ) {
+	return CM_ATOMIC_ADD( &checkCount, num ) + 1;
+}
+
+/*
+================
+idCollisionModelManagerLocal::TranslationBatch
+
+  The traces keep their working state on the stack and only read the shared model data,
+  so they are spread over the threads.
+================
+*/
+void idCollisionModelManagerLocal::TranslationBatch( trace_t *results, const cmTraceRequest_t *requests, const int numRequests ) {
+	int i;
+	const int firstCheckCount = idCollisionModelManagerLocal::GetCheckCounts( numRequests );
+
+#ifdef _OPENMP
+	#pragma omp parallel for if ( cm_parallelTraces.GetBool() && numRequests > 1 ) schedule( dynamic, 4 )
+#endif
+	for ( i = 0; i < numRequests; i++ ) {
+		const cmTraceRequest_t &request = requests[i];
+
+		if ( !CM_IsPointTrace( request.trm ) || request.start == request.end ) {
+			idCollisionModelManagerLocal::Translation( &results[i], request.start, request.end, request.trm, request.trmAxis,
+										request.contentMask, request.model, request.modelOrigin, request.modelAxis );
+			continue;
+		}
+
+		memset( &results[i], 0, sizeof( results[i] ) );
+
+		if ( request.model < 0 || request.model > MAX_SUBMODELS || request.model > idCollisionModelManagerLocal::maxModels ||
+				!idCollisionModelManagerLocal::models[request.model] ) {
+			continue;
+		}
+
+		ALIGN16( cm_traceWork_t tw );
+
+		tw.checkCount = firstCheckCount + i;
+		tw.trace.fraction = 1.0f;
+		tw.trace.c.contents = 0;
+		tw.trace.c.type = CONTACT_NONE;
+		tw.trace.c.id = 0;
+		tw.trace.c.material = NULL;
+		tw.contents = request.contentMask;
+		tw.isConvex = true;
+		tw.rotation = false;
+		tw.positionTest = false;
+		tw.quickExit = false;
+		tw.getContacts = false;
+		tw.contacts = NULL;
+		tw.maxContacts = 0;
+		tw.numContacts = 0;
+		tw.model = idCollisionModelManagerLocal::models[request.model];
+		tw.start = request.start - request.modelOrigin;
+		tw.end = request.end - request.modelOrigin;
+		tw.dir = request.end - request.start;
+
+		idCollisionModelManagerLocal::TranslatePoint( &tw, &results[i], request.start, request.end, request.modelOrigin, request.modelAxis );
+	}
+}
+
 /*
 ================
 idCollisionModelManagerLocal::Translation
 ================
 */
+void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &start, const idVec3 &end,
+										const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
+										cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+	idCollisionModelManagerLocal::TranslationContacts( results, start, end, trm, trmAxis, contentMask, model, modelOrigin, modelAxis, NULL, 0, NULL );
+}
+
+/*
+================
+idCollisionModelManagerLocal::TranslationContacts
+
+  stores all collisions as contacts instead of only the first one if contacts is set
+================
+*/
 #ifdef _DEBUG
 static int entered = 0;
 #endif
 
-void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &start, const idVec3 &end,
+void idCollisionModelManagerLocal::TranslationContacts( trace_t *results, const idVec3 &start, const idVec3 &end,
 										const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-										cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+										cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+										contactInfo_t *contacts, const int maxContacts, int *numContacts ) {
 
 	int i, j;
 	float dist;
@@ -773,7 +952,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	cm_trmPolygon_t *poly;
 	cm_trmEdge_t *edge;
 	cm_trmVertex_t *vert;
-	ALIGN16( static cm_traceWork_t tw );
+	ALIGN16( cm_traceWork_t tw );
 
 	assert( ((byte *)&start) < ((byte *)results) || ((byte *)&start) >= (((byte *)results) + sizeof( trace_t )) );
 	assert( ((byte *)&end) < ((byte *)results) || ((byte *)&end) >= (((byte *)results) + sizeof( trace_t )) );
@@ -800,7 +979,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	bool startsolid = false;
 	// test whether or not stuck to begin with
 	if ( cm_debugCollision.GetBool() ) {
-		if ( !entered && !idCollisionModelManagerLocal::getContacts ) {
+		if ( !entered && !contacts ) {
 			entered = 1;
 			// if already messed up to begin with
 			if ( idCollisionModelManagerLocal::Contents( start, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask ) {
@@ -811,7 +990,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	}
 #endif
 
-	idCollisionModelManagerLocal::checkCount++;
+	tw.checkCount = idCollisionModelManagerLocal::GetCheckCounts( 1 );
 
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -823,9 +1002,9 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	tw.rotation = false;
 	tw.positionTest = false;
 	tw.quickExit = false;
-	tw.getContacts = idCollisionModelManagerLocal::getContacts;
-	tw.contacts = idCollisionModelManagerLocal::contacts;
-	tw.maxContacts = idCollisionModelManagerLocal::maxContacts;
+	tw.getContacts = ( contacts != NULL );
+	tw.contacts = contacts;
+	tw.maxContacts = maxContacts;
 	tw.numContacts = 0;
 	tw.model = idCollisionModelManagerLocal::models[model];
 	tw.start = start - modelOrigin;
@@ -838,59 +1017,12 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	}
 
 	// if optimized point trace
-	if ( !trm || ( trm->bounds[1][0] - trm->bounds[0][0] <= 0.0f &&
-					trm->bounds[1][1] - trm->bounds[0][1] <= 0.0f &&
-					trm->bounds[1][2] - trm->bounds[0][2] <= 0.0f ) ) {
+	if ( CM_IsPointTrace( trm ) ) {
 
-		if ( model_rotated ) {
-			// rotate trace instead of model
-			tw.start *= invModelAxis;
-			tw.end *= invModelAxis;
-			tw.dir *= invModelAxis;
-		}
-
-		// trace bounds
-		for ( i = 0; i < 3; i++ ) {
-			if ( tw.start[i] < tw.end[i] ) {
-				tw.bounds[0][i] = tw.start[i] - CM_BOX_EPSILON;
-				tw.bounds[1][i] = tw.end[i] + CM_BOX_EPSILON;
-			}
-			else {
-				tw.bounds[0][i] = tw.end[i] - CM_BOX_EPSILON;
-				tw.bounds[1][i] = tw.start[i] + CM_BOX_EPSILON;
-			}
-		}
-		tw.extents[0] = tw.extents[1] = tw.extents[2] = CM_BOX_EPSILON;
-		tw.size.Zero();
-
-		// setup trace heart planes
-		idCollisionModelManagerLocal::SetupTranslationHeartPlanes( &tw );
-		tw.maxDistFromHeartPlane1 = CM_BOX_EPSILON;
-		tw.maxDistFromHeartPlane2 = CM_BOX_EPSILON;
-		// collision with single point
-		tw.numVerts = 1;
-		tw.vertices[0].p = tw.start;
-		tw.vertices[0].endp = tw.vertices[0].p + tw.dir;
-		tw.vertices[0].pl.FromRay( tw.vertices[0].p, tw.dir );
-		tw.numEdges = tw.numPolys = 0;
-		tw.pointTrace = true;
-		// trace through the model
-		idCollisionModelManagerLocal::TraceThroughModel( &tw );
-		// store results
-		*results = tw.trace;
-		results->endpos = start + results->fraction * (end - start);
-		results->endAxis = mat3_identity;
-
-		if ( results->fraction < 1.0f ) {
-			// rotate trace plane normal if there was a collision with a rotated model
-			if ( model_rotated ) {
-				results->c.normal *= modelAxis;
-				results->c.point *= modelAxis;
-			}
-			results->c.point += modelOrigin;
-			results->c.dist += modelOrigin * results->c.normal;
+		idCollisionModelManagerLocal::TranslatePoint( &tw, results, start, end, modelOrigin, modelAxis );
+		if ( numContacts ) {
+			*numContacts = tw.numContacts;
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
 		return;
 	}
 
@@ -984,6 +1116,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	}
 
 	// setup trm vertices
+	tw.numUsedVerts = 0;
 	for ( vert = tw.vertices, i = 0; i < tw.numVerts; i++, vert++ ) {
 		if ( !vert->used ) {
 			continue;
@@ -994,6 +1127,10 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 		vert->endp = vert->p + tw.dir;
 		// pluecker coordinate for vertex movement line
 		vert->pl.FromRay( vert->p, tw.dir );
+		// pack the used vertices for TranslateTrmThroughPolygon
+		tw.usedVertexNums[tw.numUsedVerts] = i;
+		tw.usedVertexPoints[tw.numUsedVerts] = vert->p;
+		tw.numUsedVerts++;
 	}
 
 	// setup trm edges
@@ -1077,7 +1214,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 				tw.contacts[i].dist += modelOrigin * tw.contacts[i].normal;
 			}
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		*numContacts = tw.numContacts;
 	} else {
 		// store results
 		*results = tw.trace;
@@ -1102,7 +1239,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 #ifdef _DEBUG
 	// test for missed collisions
 	if ( cm_debugCollision.GetBool() ) {
-		if ( !entered && !idCollisionModelManagerLocal::getContacts ) {
+		if ( !entered && !tw.getContacts ) {
 			entered = 1;
 			// if the trm is stuck in the model
 			if ( idCollisionModelManagerLocal::Contents( results->endpos, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask ) {
@@ -54,6 +54,7 @@ private:
 	idStr					descriptionString;		// description
 
 	idList<OnModifiedFunc>	modifiedCallbacks;		// functions to call when this CVAR is modified
+	int						handle;					// index in idCVarSystemLocal::handles, -1 if none was requested
 
 	virtual void			InternalSetString( const char *newValue );
 	virtual void			InternalServerSetString( const char *newValue );
@@ -94,6 +95,8 @@ idInternalCVar::idInternalCVar( const char *newName, const char *newValue, int n
 	valueMax = -1;
 	valueStrings = NULL;
 	valueCompletion = 0;
+	modificationCount = 0;
+	handle = -1;
 	UpdateValue();
 	UpdateCheat();
 	internalVar = this;
@@ -117,6 +120,8 @@ idInternalCVar::idInternalCVar( const idCVar *cvar ) {
 	valueMax = cvar->GetMaxValue();
 	valueStrings = CopyValueStrings( cvar->GetValueStrings() );
 	valueCompletion = cvar->GetValueCompletion();
+	modificationCount = 0;
+	handle = -1;
 	UpdateValue();
 	UpdateCheat();
 	internalVar = this;
@@ -200,6 +205,7 @@ void idInternalCVar::Update( const idCVar *cvar ) {
 		valueStrings = CopyValueStrings( cvar->GetValueStrings() );
 		valueCompletion = cvar->GetValueCompletion();
 		UpdateValue();
+		modificationCount++;
 		cvarSystem->SetModifiedFlags( cvar->GetFlags() );
 	}
 
@@ -350,6 +356,7 @@ void idInternalCVar::Set( const char *newValue, bool force, bool fromServer ) {
 	UpdateValue();
 
 	SetModified();
+	modificationCount++;
 	cvarSystem->SetModifiedFlags( flags );
 
 	NotifyModifiedCallbacks();
@@ -364,6 +371,7 @@ void idInternalCVar::Reset( void ) {
 	valueString = resetString;
 	value = valueString.c_str();
 	UpdateValue();
+	modificationCount++;
 }
 
 /*
@@ -454,6 +462,9 @@ public:
 
 	virtual idCVar *		Find( const char *name );
 
+	virtual int				GetCVarHandle( const char *name );
+	virtual idCVar *		GetCVarByHandle( int handle ) const;
+
 	virtual void			SetCVarString( const char *name, const char *value, int flags = 0 );
 	virtual void			SetCVarBool( const char *name, const bool value, int flags = 0 );
 	virtual void			SetCVarInteger( const char *name, const int value, int flags = 0 );
@@ -488,6 +499,7 @@ private:
 	bool					initialized;
 	idList<idInternalCVar*>	cvars;
 	idHashIndex				cvarHash;
+	idList<idInternalCVar*>	handles;				// only grows, cvar_restart leaves NULL for removed cvars
 	int						modifiedFlags;
 							// use a static dictionary to MoveCVarsToDict can be used from game
 	static idDict			moveCVarsToDict;
@@ -623,6 +635,7 @@ idCVarSystemLocal::Shutdown
 void idCVarSystemLocal::Shutdown( void ) {
 	cvars.DeleteContents( true );
 	cvarHash.Free();
+	handles.Clear();
 	moveCVarsToDict.Clear();
 	initialized = false;
 }
@@ -669,6 +682,35 @@ idCVar *idCVarSystemLocal::Find( const char *name ) {
 	return FindInternal( name );
 }
 
+/*
+============
+idCVarSystemLocal::GetCVarHandle
+============
+*/
+int idCVarSystemLocal::GetCVarHandle( const char *name ) {
+	idInternalCVar *internal = FindInternal( name );
+
+	if ( !internal ) {
+		return -1;
+	}
+	if ( internal->handle == -1 ) {
+		internal->handle = handles.Append( internal );
+	}
+	return internal->handle;
+}
+
+/*
+============
+idCVarSystemLocal::GetCVarByHandle
+============
+*/
+idCVar *idCVarSystemLocal::GetCVarByHandle( int handle ) const {
+	if ( handle < 0 || handle >= handles.Num() ) {
+		return NULL;
+	}
+	return handles[handle];
+}
+
 /*
 ============
 idCVarSystemLocal::SetCVarString
@@ -1276,6 +1318,9 @@ void idCVarSystemLocal::Restart_f( const idCmdArgs &args ) {
 		// throw out any variables the user created
 		if ( !( cvar->flags & CVAR_STATIC ) ) {
 			hash = localCVarSystem.cvarHash.GenerateKey( cvar->nameString, false );
+			if ( cvar->handle != -1 ) {
+				localCVarSystem.handles[cvar->handle] = NULL;
+			}
 			delete cvar;
 			localCVarSystem.cvars.RemoveIndex( i );
 			localCVarSystem.cvarHash.RemoveIndex( hash, i );
@@ -130,6 +130,9 @@ public:
 	bool					IsModified( void ) const { return ( internalVar->flags & CVAR_MODIFIED ) != 0; }
 	void					SetModified( void ) { internalVar->flags |= CVAR_MODIFIED; }
 	void					ClearModified( void ) { internalVar->flags &= ~CVAR_MODIFIED; }
+							// Incremented whenever the value changes. Unlike the modified flag this doesn't need
+							// clearing, so any number of users can remember the count and compare it later.
+	int						GetModificationCount( void ) const { return internalVar->modificationCount; }
 
 	const char *			GetString( void ) const { return internalVar->value; }
 	bool					GetBool( void ) const { return ( internalVar->integerValue != 0 ); }
@@ -165,6 +168,7 @@ protected:
 	argCompletion_t			valueCompletion;		// value auto-completion function
 	int						integerValue;			// atoi( string )
 	float					floatValue;				// atof( value )
+	int						modificationCount;		// incremented when the value changes
 	idCVar *				internalVar;			// internal cvar
 	idCVar *				next;					// next statically declared cvar
 
@@ -224,6 +228,14 @@ public:
 							// Returns NULL if there is no CVar with the given name.
 	virtual idCVar *		Find( const char *name ) = 0;
 
+							// Returns a handle for the CVar with the given name, or -1 if there is no such CVar.
+							// Code that reads a CVar by name often can resolve it once and use GetCVarByHandle.
+							// Handles stay valid until shutdown, also when cvar_restart removes user CVars.
+	virtual int				GetCVarHandle( const char *name ) = 0;
+
+							// Returns the CVar of a handle, or NULL if the handle is invalid or its CVar was removed.
+	virtual idCVar *		GetCVarByHandle( int handle ) const = 0;
+
 							// Sets the value of a CVar by name.
 	virtual void			SetCVarString( const char *name, const char *value, int flags = 0 ) = 0;
 	virtual void			SetCVarBool( const char *name, const bool value, int flags = 0 ) = 0;
@@ -292,6 +304,7 @@ ID_INLINE void idCVar::Init( const char *name, const char *value, int flags, con
 	this->valueCompletion = valueCompletion;
 	this->integerValue = 0;
 	this->floatValue = 0.0f;
+	this->modificationCount = 0;
 	this->internalVar = this;
 	if ( staticVars != (idCVar *)0xFFFFFFFF ) {
 		this->next = staticVars;
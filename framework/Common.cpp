@@ -26,6 +26,8 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #include "../renderer/Image.h"
 #include "Session_local.h"
 #include <iostream>
+#include <atomic>
+#include <thread>
 
 #define MAX_WARNING_LIST	256
 
@@ -102,6 +104,7 @@ idCVar com_updateLoadSize( "com_updateLoadSize", "0", CVAR_BOOL | CVAR_SYSTEM |
 idCVar com_videoRam( "com_videoRam", "128", CVAR_INTEGER | CVAR_SYSTEM | CVAR_NOCHEAT | CVAR_ARCHIVE, "holds the last amount of detected video ram" );
 
 idCVar com_product_lang_ext( "com_product_lang_ext", "1", CVAR_INTEGER | CVAR_SYSTEM | CVAR_ARCHIVE, "Extension to use when creating language files." );
+idCVar com_maxFPS( "com_maxFPS", "0", CVAR_INTEGER | CVAR_SYSTEM | CVAR_ARCHIVE | CVAR_NOCHEAT, "caps the frame rate by waiting before the input of a frame is read, for evenly paced frames with com_fixedTic, 0 = no cap", 0, 1000 );
 
 
 // com_speeds times
@@ -111,6 +114,7 @@ int				time_frontend;			// renderSystem frontend time
 int				time_backend;			// renderSystem backend time
 int				time_frontendLast;
 int				time_backendLast;
+int				time_frameWait;			// com_maxFPS wait
 
 int				com_frameTime;			// time for the current frame in milliseconds
 int				com_frameMsec;
@@ -159,6 +163,7 @@ public:
 	virtual void				DWarning( const char *fmt, ...) id_attribute((format(printf,2,3)));
 	virtual void				PrintWarnings( void );
 	virtual void				ClearWarnings( const char *reason );
+	virtual const idStrList &	GetWarnings( void ) const;
 	virtual void				PacifierUpdate( loadkey_t key, int count ); // grayman #3763
 	virtual void				Error( const char *fmt, ... ) id_attribute((format(printf,2,3)));
 	virtual void				FatalError( const char *fmt, ... ) id_attribute((format(printf,2,3)));
@@ -194,6 +199,8 @@ private:
 	bool						SafeMode( void );
 	void						CheckToolMode( void );
 	void						CloseLogFile( void );
+	void						PrintMessage( char *msg );
+	void						DrainPrintQueue( void );
 	void						WriteConfiguration( void );
 	void						DumpWarnings( void );
 	void						SingleAsyncTic( void );
@@ -324,12 +331,103 @@ bool FindEditor( void ) {
 
 #endif
 
+/*
+===============================================================================
+
+	Prints of other threads
+
+	Loaders, decoders and parallel loops can print, but the console buffer,
+	the log file and the warning list belong to the main thread. The other
+	threads push their messages on a lock-free list, which the main thread
+	takes as a whole and prints oldest first before its own prints and once
+	a frame. Taking the whole list keeps the pushes free of the ABA problem.
+
+===============================================================================
+*/
+
+typedef struct queuedPrint_s {
+	struct queuedPrint_s *	next;
+	bool					warning;		// add to the warning list, msg is without the WARNING: prefix
+	char					msg[1];			// allocated to fit
+} queuedPrint_t;
+
+static std::thread::id						com_mainThread;
+static std::atomic<queuedPrint_t *>		com_printQueue( NULL );
+
+/*
+==================
+Com_IsMainThread
+
+Everything is the main thread until idCommonLocal::Init has run
+==================
+*/
+static bool Com_IsMainThread( void ) {
+	return com_mainThread == std::thread::id() || std::this_thread::get_id() == com_mainThread;
+}
+
+/*
+==================
+Com_QueuePrint
+
+The worker threads can't use the engine heap
+==================
+*/
+static void Com_QueuePrint( const char *msg, bool warning ) {
+	const size_t length = strlen( msg );
+	queuedPrint_t *print = (queuedPrint_t *)malloc( sizeof( queuedPrint_t ) + length );
+	if ( !print ) {
+		return;
+	}
+	print->warning = warning;
+	memcpy( print->msg, msg, length + 1 );
+
+	print->next = com_printQueue.load( std::memory_order_relaxed );
+	while ( !com_printQueue.compare_exchange_weak( print->next, print, std::memory_order_release, std::memory_order_relaxed ) ) {
+	}
+}
+
+/*
+==================
+idCommonLocal::DrainPrintQueue
+
+Prints the messages the other threads queued, on the main thread
+==================
+*/
+void idCommonLocal::DrainPrintQueue( void ) {
+	queuedPrint_t *list = com_printQueue.exchange( NULL, std::memory_order_acquire );
+	if ( !list ) {
+		return;
+	}
+
+	// the list is newest first
+	queuedPrint_t *ordered = NULL;
+	while ( list ) {
+		queuedPrint_t *next = list->next;
+		list->next = ordered;
+		ordered = list;
+		list = next;
+	}
+
+	while ( ordered ) {
+		queuedPrint_t *next = ordered->next;
+		if ( ordered->warning ) {
+			Warning( "%s", ordered->msg );
+		} else {
+			PrintMessage( ordered->msg );
+		}
+		free( ordered );
+		ordered = next;
+	}
+}
+
 /*
 ==================
 idCommonLocal::CloseLogFile
 ==================
 */
 void idCommonLocal::CloseLogFile( void ) {
+	DrainPrintQueue();
+
 	if ( logFile ) {
 		com_logFile.SetBool( false ); // make sure no further VPrintf attempts to open the log file again
 		fileSystem->CloseFile( logFile );
@@ -356,7 +454,6 @@ A raw string should NEVER be passed as fmt, because of "%f" type crashes.
 void idCommonLocal::VPrintf( const char *fmt, va_list args ) {
 	char		msg[MAX_PRINT_MSG_SIZE];
 	int			timeLength;
-	static bool	logFileFailed = false;
 
 	// if the cvar system is not initialized
 	if ( !cvarSystem->IsInitialized() ) {
@@ -382,6 +479,28 @@ void idCommonLocal::VPrintf( const char *fmt, va_list args ) {
 		Sys_Printf( "idCommon::VPrintf: truncated to %d characters\n", strlen(msg)-1 );
 	}
 
+	if ( !Com_IsMainThread() ) {
+		Com_QueuePrint( msg, false );
+		return;
+	}
+
+	// the queued prints came first
+	DrainPrintQueue();
+
+	PrintMessage( msg );
+}
+
+/*
+==================
+idCommonLocal::PrintMessage
+
+Sends a formatted message to the console, the log file and the editors,
+on the main thread
+==================
+*/
+void idCommonLocal::PrintMessage( char *msg ) {
+	static bool	logFileFailed = false;
+
 	if ( rd_buffer ) {
 		if ( (int)( strlen( msg ) + strlen( rd_buffer ) ) > ( rd_buffersize - 1 ) ) {
 			rd_flush( rd_buffer );
@@ -562,6 +681,12 @@ void idCommonLocal::Warning( const char *fmt, ... ) {
 	va_end( argptr );
 	msg[sizeof(msg)-1] = '\0';
 
+	// the warning list is added to on the main thread
+	if ( !Com_IsMainThread() ) {
+		Com_QueuePrint( msg, true );
+		return;
+	}
+
 	Printf( S_COLOR_YELLOW "WARNING:" S_COLOR_RED "%s\n", msg );
 
 	if ( warningList.Num() < MAX_WARNING_LIST ) {
@@ -606,6 +731,15 @@ void idCommonLocal::ClearWarnings( const char *reason ) {
 	warningList.Clear();
 }
 
+/*
+==================
+idCommonLocal::GetWarnings
+==================
+*/
+const idStrList &idCommonLocal::GetWarnings( void ) const {
+	return warningList;
+}
+
 /*
 ==================
 idCommonLocal::PacifierUpdate
@@ -2313,14 +2447,16 @@ void idCommonLocal::InitCommands( void ) {
 	cmdSystem->AddCommand( "setMachineSpec", Com_SetMachineSpec_f, CMD_FL_SYSTEM, "detects system capabilities and sets com_machineSpec to appropriate value" );
 	cmdSystem->AddCommand( "execMachineSpec", Com_ExecMachineSpec_f, CMD_FL_SYSTEM, "execs the appropriate config files and sets cvars based on com_machineSpec" );
 
-#if !defined( ID_DEDICATED )
-	// compilers
+	// compilers, the map compilers don't need a renderer so a dedicated
+	// binary can run them headless, e.g. +dmapBatch maps.txt +quit
 	cmdSystem->AddCommand( "dmap", Dmap_f, CMD_FL_TOOL, "compiles a map", idCmdSystem::ArgCompletion_MapName );
-	cmdSystem->AddCommand( "renderbump", RenderBump_f, CMD_FL_TOOL, "renders a bump map", idCmdSystem::ArgCompletion_ModelName );
-	cmdSystem->AddCommand( "renderbumpFlat", RenderBumpFlat_f, CMD_FL_TOOL, "renders a flat bump map", idCmdSystem::ArgCompletion_ModelName );
+	cmdSystem->AddCommand( "dmapBatch", DmapBatch_f, CMD_FL_TOOL, "compiles all maps in a list file and writes a report" );
 	cmdSystem->AddCommand( "runAAS", RunAAS_f, CMD_FL_TOOL, "compiles an AAS file for a map", idCmdSystem::ArgCompletion_MapName );
 	cmdSystem->AddCommand( "runAASDir", RunAASDir_f, CMD_FL_TOOL, "compiles AAS files for all maps in a folder", idCmdSystem::ArgCompletion_MapName );
 	cmdSystem->AddCommand( "runReach", RunReach_f, CMD_FL_TOOL, "calculates reachability for an AAS file", idCmdSystem::ArgCompletion_MapName );
+#if !defined( ID_DEDICATED )
+	cmdSystem->AddCommand( "renderbump", RenderBump_f, CMD_FL_TOOL, "renders a bump map", idCmdSystem::ArgCompletion_ModelName );
+	cmdSystem->AddCommand( "renderbumpFlat", RenderBumpFlat_f, CMD_FL_TOOL, "renders a flat bump map", idCmdSystem::ArgCompletion_ModelName );
 	cmdSystem->AddCommand( "roq", RoQFileEncode_f, CMD_FL_TOOL, "encodes a roq file" );
 #endif
 
@@ -2344,11 +2480,14 @@ void idCommonLocal::InitCommands( void ) {
 	// idLib commands
 	cmdSystem->AddCommand( "memoryDump", Mem_Dump_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "creates a memory dump" );
 	cmdSystem->AddCommand( "memoryDumpCompressed", Mem_DumpCompressed_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "creates a compressed memory dump" );
+	cmdSystem->AddCommand( "memTags", Mem_Tags_f, CMD_FL_SYSTEM, "lists the memory allocated by each subsystem" );
 	cmdSystem->AddCommand( "showStringMemory", idStr::ShowMemoryUsage_f, CMD_FL_SYSTEM, "shows memory used by strings" );
 	cmdSystem->AddCommand( "showDictMemory", idDict::ShowMemoryUsage_f, CMD_FL_SYSTEM, "shows memory used by dictionaries" );
 	cmdSystem->AddCommand( "listDictKeys", idDict::ListKeys_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "lists all keys used by dictionaries" );
 	cmdSystem->AddCommand( "listDictValues", idDict::ListValues_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "lists all values used by dictionaries" );
 	cmdSystem->AddCommand( "testSIMD", idSIMD::Test_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "test SIMD code" );
+	cmdSystem->AddCommand( "testFlatHash", idFlatHash_Test_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "time the flat hash containers against idHashTable" );
+	cmdSystem->AddCommand( "benchSIMD", idSIMD::Bench_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "benchmark the SIMD kernels and write a report, usage: benchSIMD [processor] [report.csv]" );
 
 	// localization
 	cmdSystem->AddCommand( "localizeGuis", Com_LocalizeGuis_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "localize guis" );
@@ -2407,16 +2546,66 @@ void idCommonLocal::InitSIMD( void ) {
 	com_forceGenericSIMD.ClearModified();
 }
 
+/*
+=================
+Com_PaceFrame
+
+Waits out what is left of the com_maxFPS frame time. It runs before the
+events are pumped, so the input is as fresh as it can be when the frame is
+rendered. Sys_Sleep is too coarse to hit the frame time, so it only sleeps
+while more than two msec are left and spins on the clock for the rest.
+Returns the msec waited.
+=================
+*/
+static int Com_PaceFrame( void ) {
+	static double nextFrameTicks = 0.0;
+
+	const int maxFPS = com_maxFPS.GetInteger();
+	if ( maxFPS <= 0 ) {
+		nextFrameTicks = 0.0;
+		return 0;
+	}
+
+	const double ticksPerSecond = Sys_ClockTicksPerSecond();
+	const double frameTicks = ticksPerSecond / maxFPS;
+	const double startTicks = Sys_GetClockTicks();
+	double now = startTicks;
+
+	while ( nextFrameTicks - now > ticksPerSecond * 0.002 ) {
+		Sys_Sleep( 1 );
+		now = Sys_GetClockTicks();
+	}
+	while ( now < nextFrameTicks ) {
+		now = Sys_GetClockTicks();
+	}
+
+	// pace from the last deadline, so the frame rate doesn't drift, but
+	// don't rush the next frames to make up for a slow one
+	if ( now - nextFrameTicks > frameTicks ) {
+		nextFrameTicks = now;
+	}
+	nextFrameTicks += frameTicks;
+
+	return idMath::FtoiFast( ( now - startTicks ) * 1000.0 / ticksPerSecond );
+}
+
 /*
 =================
 idCommonLocal::Frame
 =================
 */
 void idCommonLocal::Frame( void ) {
+	// outside of the critical section, which would hold up the background game tic
+	time_frameWait = Com_PaceFrame();
+
 	// duzenko #4408 - forbid background game tic until back renderer
 	Sys_EnterCriticalSection(CRITICAL_SECTION_TWO);
 
 	try {
+		PROFILE_SCOPE( "Frame" );
+
+		// print what the other threads printed since the last frame
+		DrainPrintQueue();
 
 		// pump all the events
 		Sys_GenerateEvents();
@@ -2429,6 +2618,9 @@ void idCommonLocal::Frame( void ) {
 			InitSIMD();
 		}
 
+		// the next command of a running perfSuite, executed by the event loop
+		perfSuite->Frame();
+
 		eventLoop->RunEventLoop();
 
 		// duzenko #4409 - need frame time msec to pass to game tic
@@ -2458,7 +2650,7 @@ void idCommonLocal::Frame( void ) {
 
 		// report timing information
 		if ( com_speeds.GetBool() ) {
-			Printf("frame:%i all:%3i gfr:%3i fr:%3i(%d) br:%3i(%d)\n", com_frameNumber, com_frameMsec, time_gameFrame, time_frontend, time_frontendLast, time_backend, time_backendLast);
+			Printf("frame:%i all:%3i gfr:%3i fr:%3i(%d) br:%3i(%d) wait:%3i\n", com_frameNumber, com_frameMsec, time_gameFrame, time_frontend, time_frontendLast, time_backend, time_backendLast, time_frameWait);
 			time_gameFrame = 0;
 			time_gameDraw = 0;
 		}	
@@ -2479,6 +2671,9 @@ void idCommonLocal::Frame( void ) {
 		return;			// an ERP_DROP was thrown
 	}
 
+	// after the frame scope was closed
+	frameProfiler->EndFrame();
+
 	// duzenko #4408 - background game tic should be finished before this point
 	Sys_LeaveCriticalSection(CRITICAL_SECTION_TWO);
 }
@@ -2661,6 +2856,9 @@ void idCommonLocal::LoadGameDLL( void ) {
 	gameImport.declManager				= ::declManager;
 	gameImport.AASFileManager			= ::AASFileManager;
 	gameImport.collisionModelManager	= ::collisionModelManager;
+	gameImport.frameProfiler			= ::frameProfiler;
+	gameImport.perfSuite				= ::perfSuite;
+	gameImport.jobSystem				= ::jobSystem;
 
 	gameExport							= *GetGameAPI( &gameImport );
 
@@ -2758,11 +2956,15 @@ void idCommonLocal::Init( int argc, const char **argv, const char *cmdline )
 {
 	try
 	{
+		// the other threads queue their prints for this one
+		com_mainThread = std::this_thread::get_id();
+
 		// set interface pointers used by idLib
 		idLib::sys			= sys;
 		idLib::common		= common;
 		idLib::cvarSystem	= cvarSystem;
 		idLib::fileSystem	= fileSystem;
+		idLib::perfSuite	= perfSuite;
 
 		// initialize idLib
 		idLib::Init();
@@ -2822,6 +3024,12 @@ void idCommonLocal::Init( int argc, const char **argv, const char *cmdline )
 		// init commands
 		InitCommands();
 
+		frameProfiler->Init();
+
+		perfSuite->Init();
+
+		jobSystem->Init();
+
 #ifdef ID_WRITE_VERSION
 		config_compressor = idCompressor::AllocArithmetic();
 #endif
@@ -2874,6 +3082,12 @@ void idCommonLocal::Shutdown( void ) {
 	// game specific shut down
 	ShutdownGame(false);
 
+	jobSystem->Shutdown();
+
+	frameProfiler->Shutdown();
+
+	perfSuite->Shutdown();
+
 	// shut down non-portable system services
 	Sys_Shutdown();
 
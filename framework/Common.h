@@ -72,6 +72,7 @@ extern int			time_frontend;			// renderer frontend time
 extern int			time_frontendLast;		// renderer frontend time
 extern int			time_backend;			// renderer backend time
 extern int			time_backendLast;		// renderer backend time
+extern int			time_frameWait;			// com_maxFPS frame pacing wait
 
 extern int			com_frameTime;			// time for the current frame in milliseconds
 extern int			com_frameMsec;
@@ -203,6 +204,9 @@ public:
 								// Removes all queued warnings.
 	virtual void				ClearWarnings( const char *reason ) = 0;
 
+								// Returns the queued warnings.
+	virtual const idStrList &	GetWarnings( void ) const = 0;
+
 	virtual void				PacifierUpdate(loadkey_t key, int count) = 0; // grayman #3763
 
 								// Issues a C++ throw. Normal errors just abort to the game loop,
@@ -2479,6 +2479,312 @@ void idCompressor_LZW::DecompressBlock() {
 	blockSize = Min( writeByte, LZW_BLOCK_SIZE );
 }
 
+/*
+=================================================================================
+
+	idCompressor_LZ4
+
+	The stream is cut into blocks of LZ4_BLOCK_SIZE bytes which are compressed
+	independently with idLZ4. Each block is stored as its size and compressed
+	size as unsigned shorts followed by the compressed data, a compressed size
+	of zero means the block didn't compress and is stored as is. A block size
+	of zero ends the stream.
+
+	Written blocks are collected and compressed LZ4_BATCH_BLOCKS at a time on
+	the job system, so large streams like demos use all cores while small ones
+	like network messages compress on the calling thread.
+
+=================================================================================
+*/
+
+class idCompressor_LZ4 : public idCompressor_None {
+public:
+					idCompressor_LZ4( void );
+					~idCompressor_LZ4( void );
+
+	void			Init( idFile *f, bool compress, int wordLength );
+	void			FinishCompress( void );
+	float			GetCompressionRatio( void ) const;
+
+	int				Write( const void *inData, int inLength );
+	int				Read( void *outData, int outLength );
+
+protected:
+	static const int LZ4_BLOCK_SIZE = 32768;
+	static const int LZ4_BATCH_BLOCKS = 32;
+
+	typedef struct lz4Block_s {
+		byte *		data;				// LZ4_BLOCK_SIZE bytes
+		byte *		compressed;			// idLZ4::CompressBound( LZ4_BLOCK_SIZE ) bytes
+		int			size;
+		int			compressedSize;		// 0 if it is stored as is
+	} lz4Block_t;
+
+	void			AllocBlock( lz4Block_t &block );
+	void			CompressBlocks( void );
+	bool			DecompressBlock( void );
+
+	static void		CompressBlock( void *data );
+
+	lz4Block_t		blocks[LZ4_BATCH_BLOCKS];
+	int				numBlocks;			// blocks waiting to be compressed, the last one may not be full
+	int				readOffset;			// read position in the decompressed block
+	bool			endOfStream;
+	idJobList *		jobList;
+
+	int				unCompressedSize;
+	int				compressedSize;
+};
+
+/*
+================
+idCompressor_LZ4::idCompressor_LZ4
+================
+*/
+idCompressor_LZ4::idCompressor_LZ4( void ) {
+	memset( blocks, 0, sizeof( blocks ) );
+	numBlocks = 0;
+	readOffset = 0;
+	endOfStream = false;
+	jobList = NULL;
+	unCompressedSize = 0;
+	compressedSize = 0;
+}
+
+/*
+================
+idCompressor_LZ4::~idCompressor_LZ4
+================
+*/
+idCompressor_LZ4::~idCompressor_LZ4( void ) {
+	for ( int i = 0; i < LZ4_BATCH_BLOCKS; i++ ) {
+		Mem_Free( blocks[i].data );
+		Mem_Free( blocks[i].compressed );
+	}
+	if ( jobList ) {
+		jobSystem->FreeJobList( jobList );
+	}
+}
+
+/*
+================
+idCompressor_LZ4::Init
+================
+*/
+void idCompressor_LZ4::Init( idFile *f, bool compress, int wordLength ) {
+	idCompressor_None::Init( f, compress, wordLength );
+
+	for ( int i = 0; i < LZ4_BATCH_BLOCKS; i++ ) {
+		blocks[i].size = 0;
+		blocks[i].compressedSize = 0;
+	}
+	numBlocks = 0;
+	readOffset = 0;
+	endOfStream = false;
+	unCompressedSize = 0;
+	compressedSize = 0;
+}
+
+/*
+================
+idCompressor_LZ4::AllocBlock
+================
+*/
+void idCompressor_LZ4::AllocBlock( lz4Block_t &block ) {
+	if ( block.data == NULL ) {
+		block.data = (byte *) Mem_Alloc( LZ4_BLOCK_SIZE );
+		block.compressed = (byte *) Mem_Alloc( idLZ4::CompressBound( LZ4_BLOCK_SIZE ) );
+	}
+}
+
+/*
+================
+idCompressor_LZ4::CompressBlock
+
+  runs on the job workers, must not touch the heap
+================
+*/
+void idCompressor_LZ4::CompressBlock( void *data ) {
+	lz4Block_t *block = (lz4Block_t *) data;
+
+	block->compressedSize = idLZ4::Compress( block->data, block->size, block->compressed, idLZ4::CompressBound( LZ4_BLOCK_SIZE ) );
+	if ( block->compressedSize >= block->size ) {
+		block->compressedSize = 0;
+	}
+}
+
+/*
+================
+idCompressor_LZ4::CompressBlocks
+================
+*/
+void idCompressor_LZ4::CompressBlocks( void ) {
+	if ( numBlocks > 1 && jobSystem->GetNumWorkers() > 0 ) {
+		if ( jobList == NULL ) {
+			jobList = jobSystem->AllocJobList( "LZ4 compress" );
+		}
+		for ( int i = 0; i < numBlocks; i++ ) {
+			jobList->AddJob( CompressBlock, &blocks[i] );
+		}
+		jobList->Submit();
+		jobList->Wait();
+	} else {
+		for ( int i = 0; i < numBlocks; i++ ) {
+			CompressBlock( &blocks[i] );
+		}
+	}
+
+	for ( int i = 0; i < numBlocks; i++ ) {
+		lz4Block_t &block = blocks[i];
+
+		file->WriteUnsignedShort( block.size );
+		file->WriteUnsignedShort( block.compressedSize );
+		if ( block.compressedSize ) {
+			file->Write( block.compressed, block.compressedSize );
+			compressedSize += 4 + block.compressedSize;
+		} else {
+			file->Write( block.data, block.size );
+			compressedSize += 4 + block.size;
+		}
+		block.size = 0;
+	}
+	numBlocks = 0;
+}
+
+/*
+================
+idCompressor_LZ4::DecompressBlock
+================
+*/
+bool idCompressor_LZ4::DecompressBlock( void ) {
+	lz4Block_t &block = blocks[0];
+	unsigned short size, blockCompressedSize;
+
+	if ( endOfStream ) {
+		return false;
+	}
+
+	readOffset = 0;
+	block.size = 0;
+
+	if ( file->ReadUnsignedShort( size ) != sizeof( size ) || size == 0 || size > LZ4_BLOCK_SIZE ||
+			file->ReadUnsignedShort( blockCompressedSize ) != sizeof( blockCompressedSize ) ||
+			blockCompressedSize > idLZ4::CompressBound( LZ4_BLOCK_SIZE ) ) {
+		endOfStream = true;
+		return false;
+	}
+
+	AllocBlock( block );
+
+	if ( blockCompressedSize == 0 ) {
+		if ( file->Read( block.data, size ) != size ) {
+			endOfStream = true;
+			return false;
+		}
+		compressedSize += 4 + size;
+	} else {
+		if ( file->Read( block.compressed, blockCompressedSize ) != blockCompressedSize ||
+				idLZ4::Decompress( block.compressed, blockCompressedSize, block.data, size ) != size ) {
+			endOfStream = true;
+			return false;
+		}
+		compressedSize += 4 + blockCompressedSize;
+	}
+
+	block.size = size;
+	return true;
+}
+
+/*
+================
+idCompressor_LZ4::FinishCompress
+================
+*/
+void idCompressor_LZ4::FinishCompress( void ) {
+	if ( compress == false ) {
+		return;
+	}
+
+	CompressBlocks();
+	file->WriteUnsignedShort( 0 );
+	compressedSize += 2;
+}
+
+/*
+================
+idCompressor_LZ4::GetCompressionRatio
+================
+*/
+float idCompressor_LZ4::GetCompressionRatio( void ) const {
+	if ( unCompressedSize == 0 ) {
+		return 0.0f;
+	}
+	return ( unCompressedSize - compressedSize ) * 100.0f / unCompressedSize;
+}
+
+/*
+================
+idCompressor_LZ4::Write
+================
+*/
+int idCompressor_LZ4::Write( const void *inData, int inLength ) {
+	const byte *in = (const byte *) inData;
+
+	if ( compress == false || inLength <= 0 ) {
+		return 0;
+	}
+
+	for ( int left = inLength; left > 0; ) {
+		if ( numBlocks == 0 || blocks[numBlocks - 1].size == LZ4_BLOCK_SIZE ) {
+			if ( numBlocks == LZ4_BATCH_BLOCKS ) {
+				CompressBlocks();
+			}
+			AllocBlock( blocks[numBlocks] );
+			numBlocks++;
+		}
+
+		lz4Block_t &block = blocks[numBlocks - 1];
+		int n = Min( left, LZ4_BLOCK_SIZE - block.size );
+		memcpy( block.data + block.size, in, n );
+		block.size += n;
+		in += n;
+		left -= n;
+	}
+
+	unCompressedSize += inLength;
+	return inLength;
+}
+
+/*
+================
+idCompressor_LZ4::Read
+================
+*/
+int idCompressor_LZ4::Read( void *outData, int outLength ) {
+	byte *out = (byte *) outData;
+	int left;
+
+	if ( compress == true || outLength <= 0 ) {
+		return 0;
+	}
+
+	for ( left = outLength; left > 0; ) {
+		if ( readOffset >= blocks[0].size && !DecompressBlock() ) {
+			break;
+		}
+
+		int n = Min( left, blocks[0].size - readOffset );
+		memcpy( out, blocks[0].data + readOffset, n );
+		readOffset += n;
+		out += n;
+		left -= n;
+	}
+
+	unCompressedSize += outLength - left;
+	return outLength - left;
+}
+
+
 /*
 =================================================================================
 
@@ -2567,3 +2873,12 @@ idCompressor::AllocLZW
 idCompressor * idCompressor::AllocLZW( void ) {
 	return new idCompressor_LZW();
 }
+
+/*
+================
+idCompressor::AllocLZ4
+================
+*/
+idCompressor * idCompressor::AllocLZ4( void ) {
+	return new idCompressor_LZ4();
+}
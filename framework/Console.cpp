@@ -210,10 +210,16 @@ SCR_DrawMemoryUsage
 */
 int SCR_DrawMemoryUsage( int y ) {
 	memoryStats_t allocs, frees;
+	int cached;
 	
 	Mem_GetStats( allocs );
 	SCR_DrawTextRightAlign( y, "total allocated memory: %4d, %4dkB", allocs.num, allocs.totalSize>>10 );
 
+	// blocks freed on another thread than they were allocated on make these negative
+	for ( int i = 0; Mem_GetThreadStats( i, allocs, cached ); i++ ) {
+		SCR_DrawTextRightAlign( y, "thread %d: %4d, %4dkB  cached: %4dkB", i, allocs.num, allocs.totalSize>>10, cached>>10 );
+	}
+
 	Mem_GetFrameStats( allocs, frees );
 	SCR_DrawTextRightAlign( y, "frame alloc: %4d, %4dkB  frame free: %4d, %4dkB", allocs.num, allocs.totalSize>>10, frees.num, frees.totalSize>>10 );
 
@@ -300,14 +306,32 @@ int SCR_DrawSoundDecoders( int y ) {
 		} else {
 			percent = localTime * 100 / sampleTime;
 		}
-		SCR_DrawTextLeftAlign( y, "%3d: %3d%% (%1.2f) %s: %s (%dkB)", numActiveDecoders, percent, decoderInfo.lastVolume, 
-			decoderInfo.format.c_str(), decoderInfo.name.c_str(), decoderInfo.numBytes >> 10 );
+		SCR_DrawTextLeftAlign( y, "%3d: %3d%% (%1.2f) %s: %s (%dkB, %.2f msec)", numActiveDecoders, percent, decoderInfo.lastVolume, 
+			decoderInfo.format.c_str(), decoderInfo.name.c_str(), decoderInfo.numBytes >> 10, decoderInfo.decodeTime );
 		numActiveDecoders++;
 	}
 
 	return y;
 }
 
+/*
+==================
+SCR_DrawSoundPerf
+==================
+*/
+int SCR_DrawSoundPerf( int y ) {
+	soundPerfInfo_t perfInfo;
+
+	soundSystem->GetSoundPerfInfo( perfInfo );
+
+	SCR_DrawTextRightAlign( y, "snd mix %.2f (%.2f) decode %.2f (%.2f) msec", perfInfo.mixTime, perfInfo.peakMixTime, perfInfo.decodeTime, perfInfo.peakDecodeTime );
+	SCR_DrawTextRightAlign( y, "snd chan %d virtual %d streams %d", perfInfo.activeChannels, perfInfo.virtualChannels, perfInfo.activeStreams );
+	SCR_DrawTextRightAlign( y, "snd portals %.1f cached %.1f", perfInfo.occlusionSearches, perfInfo.occlusionWalks );
+	SCR_DrawTextRightAlign( y, "snd underruns %d streams %d", perfInfo.underruns, perfInfo.streamUnderruns );
+
+	return y;
+}
+
 //=========================================================================
 
 /*
@@ -1183,6 +1207,10 @@ void idConsoleLocal::Draw( bool forceFullScreen ) {
 	if ( com_showSoundDecoders.GetBool() ) {
 		y = SCR_DrawSoundDecoders( y );
 	}
+
+	if ( cvarSystem->GetCVarBool( "s_showPerf" ) ) {
+		y = SCR_DrawSoundPerf( y );
+	}
 	
 	if ( com_showAsyncStats.GetBool() ) {
 		y = SCR_DrawAsyncStats( y );
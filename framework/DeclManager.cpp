@@ -57,6 +57,10 @@ missing reload over a previously explicit definition
 #define USE_COMPRESSED_DECLS
 //#define GET_HUFFMAN_FREQUENCIES
 
+#define DECL_INDEX_FILE			"declindex.dat"
+#define DECL_INDEX_ID			"DIDX"
+#define DECL_INDEX_VERSION		1
+
 class idDeclType {
 public:
 	idStr						typeName;
@@ -122,10 +126,19 @@ protected:
 								// Set textSource possible with compression.
 	void						SetTextLocal( const char *text, const int length );
 
+								// Set textSource from the output of CompressText.
+	void						SetCompressedTextLocal( const byte *compressed, const int compressedLength, const int length, const int checksum );
+
+								// Compresses the text into a buffer of MaxCompressedTextLength() bytes. Only
+								// touches the buffer, so the text of several decls can be compressed at once.
+	static int					CompressText( const char *text, const int length, byte *compressed );
+	static int					MaxCompressedTextLength( const int length );
+
 private:
 	idDecl *					self;
 
 	idStr						name;					// name of the decl
+	idInternStr					internName;				// interned name, compared by the lookups in the hash tables
 	char *						textSource;				// decl text definition
 	int							textLength;				// length of textSource
 	int							compressedLength;		// compressed length
@@ -146,6 +159,61 @@ private:
 	idDeclLocal *				nextInFile;				// next decl in the decl file
 };
 
+// a decl found by idDeclFile::LoadAndParse, which still needs its text set
+typedef struct pendingDeclText_s {
+	idDeclLocal *				decl;
+	bool						reparse;				// in use, parse it again once the text is set
+	int							scratchOffset;			// of the compressed text
+	int							compressedLength;
+	int							checksum;
+} pendingDeclText_t;
+
+// the decls found in a decl file, so the file doesn't need to be scanned again while it is unchanged
+typedef struct declIndexDecl_s {
+	int							typeNum;				// in the type names of the index
+	idStr						name;
+	int							offset;
+	int							length;
+	int							line;
+} declIndexDecl_t;
+
+typedef struct declIndexFile_s {
+	idStr						fileName;
+	int							fileSize;
+	int							checksum;				// MD5 of the file text
+	int							numLines;
+	bool						used;					// found or added since the index was loaded
+	idList<declIndexDecl_t>		decls;
+} declIndexFile_t;
+
+class idDeclIndex {
+public:
+								idDeclIndex( void );
+								~idDeclIndex( void );
+
+	void						Clear( void );
+
+	void						Load( void );
+	void						Write( void );
+
+								// Returns the entry of the file, if it has the given size and checksum.
+	const declIndexFile_t *		FindFile( const char *fileName, int fileSize, int checksum );
+								// Returns an empty entry for the file.
+	declIndexFile_t *			AddFile( const char *fileName, int fileSize, int checksum );
+
+	int							TypeNum( const char *typeName );
+	int							GetNumTypes( void ) const { return typeNames.Num(); }
+	const char *				GetTypeName( int typeNum ) const { return typeNames[typeNum]; }
+
+private:
+	idStrList					typeNames;
+	idList<declIndexFile_t *>	files;
+	idHashIndex					fileHash;
+	bool						modified;
+
+	int							FindFileIndex( const char *fileName ) const;
+};
+
 class idDeclFile {
 public:
 								idDeclFile();
@@ -154,6 +222,10 @@ public:
 	void						Reload( bool force );
 	int							LoadAndParse();
 
+private:
+	bool						LoadFromIndex( idList<pendingDeclText_t> &pending );
+	void						AddDecl( declType_t type, const char *name, int offset, int size, int line, idList<pendingDeclText_t> &pending );
+
 public:
 	idStr						fileName;
 	declType_t					defaultType;
@@ -214,6 +286,8 @@ public:
 	idDeclType *				GetDeclType( int type ) const { return declTypes[type]; }
 	const idDeclFile *			GetImplicitDeclFile( void ) const { return &implicitDecls; }
 
+	idDeclIndex					declIndex;		// where the decls are in the decl files
+
 private:
 	idList<idDeclType *>		declTypes;
 	idList<idDeclFolder *>		declFolders;
@@ -237,6 +311,7 @@ private:
 };
 
 idCVar idDeclManagerLocal::decl_show( "decl_show", "0", CVAR_SYSTEM, "set to 1 to print parses, 2 to also print references", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
+idCVar decl_index( "decl_index", "1", CVAR_SYSTEM | CVAR_BOOL, "keep an index of the decls in each decl file in " DECL_INDEX_FILE ", so unchanged files are not scanned at startup" );
 
 idDeclManagerLocal	declManagerLocal;
 idDeclManager *		declManager = &declManagerLocal;
@@ -458,6 +533,7 @@ int HuffmanCompressText( const char *text, int textLength, byte *compressed, int
 	int i, j;
 	idBitMsg msg;
 
+	#pragma omp atomic
 	totalUncompressedLength += textLength;
 
 	msg.Init( compressed, maxCompressedSize );
@@ -472,6 +548,7 @@ int HuffmanCompressText( const char *text, int textLength, byte *compressed, int
 		}
 	}
 
+	#pragma omp atomic
 	totalCompressedLength += msg.GetSize();
 
 	return msg.GetSize();
@@ -531,6 +608,269 @@ void ListHuffmanFrequencies_f( const idCmdArgs &args ) {
 ====================================================================================
 */
 
+/*
+====================================================================================
+
+ idDeclIndex
+
+====================================================================================
+*/
+
+/*
+================
+idDeclIndex::idDeclIndex
+================
+*/
+idDeclIndex::idDeclIndex( void ) {
+	modified = false;
+}
+
+/*
+================
+idDeclIndex::~idDeclIndex
+================
+*/
+idDeclIndex::~idDeclIndex( void ) {
+	Clear();
+}
+
+/*
+================
+idDeclIndex::Clear
+================
+*/
+void idDeclIndex::Clear( void ) {
+	typeNames.Clear();
+	files.DeleteContents( true );
+	fileHash.Free();
+	modified = false;
+}
+
+/*
+================
+idDeclIndex::FindFileIndex
+================
+*/
+int idDeclIndex::FindFileIndex( const char *fileName ) const {
+	int key = fileHash.GenerateKey( fileName, false );
+	for ( int i = fileHash.First( key ); i != -1; i = fileHash.Next( i ) ) {
+		if ( files[i]->fileName.Icmp( fileName ) == 0 ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+idDeclIndex::FindFile
+================
+*/
+const declIndexFile_t *idDeclIndex::FindFile( const char *fileName, int fileSize, int checksum ) {
+	if ( !decl_index.GetBool() ) {
+		return NULL;
+	}
+
+	int i = FindFileIndex( fileName );
+	if ( i == -1 || files[i]->fileSize != fileSize || files[i]->checksum != checksum ) {
+		return NULL;
+	}
+
+	for ( int j = 0; j < files[i]->decls.Num(); j++ ) {
+		const declIndexDecl_t &decl = files[i]->decls[j];
+		if ( decl.offset < 0 || decl.length < 0 || decl.offset + decl.length > fileSize ) {
+			return NULL;
+		}
+	}
+
+	files[i]->used = true;
+	return files[i];
+}
+
+/*
+================
+idDeclIndex::AddFile
+================
+*/
+declIndexFile_t *idDeclIndex::AddFile( const char *fileName, int fileSize, int checksum ) {
+	declIndexFile_t *file;
+
+	int i = FindFileIndex( fileName );
+	if ( i != -1 ) {
+		file = files[i];
+		file->decls.Clear();
+	} else {
+		file = new declIndexFile_t;
+		file->fileName = fileName;
+		fileHash.Add( fileHash.GenerateKey( fileName, false ), files.Append( file ) );
+	}
+
+	file->fileSize = fileSize;
+	file->checksum = checksum;
+	file->numLines = 0;
+	file->used = true;
+
+	modified = true;
+	return file;
+}
+
+/*
+================
+idDeclIndex::TypeNum
+================
+*/
+int idDeclIndex::TypeNum( const char *typeName ) {
+	for ( int i = 0; i < typeNames.Num(); i++ ) {
+		if ( typeNames[i].Icmp( typeName ) == 0 ) {
+			return i;
+		}
+	}
+	return typeNames.Append( typeName );
+}
+
+/*
+================
+idDeclIndex::Load
+================
+*/
+void idDeclIndex::Load( void ) {
+	int i, j, num;
+	byte *buffer;
+	char id[4];
+
+	Clear();
+
+	if ( !decl_index.GetBool() ) {
+		return;
+	}
+
+	int length = fileSystem->ReadFile( DECL_INDEX_FILE, (void **)&buffer );
+	if ( length <= 0 ) {
+		return;
+	}
+
+	idFile_Memory f( DECL_INDEX_FILE, (const char *)buffer, length );
+	bool valid = false;
+
+	f.Read( id, 4 );
+	f.ReadInt( num );
+	if ( memcmp( id, DECL_INDEX_ID, 4 ) == 0 && num == DECL_INDEX_VERSION ) {
+		f.ReadInt( num );
+		valid = ( num >= 0 && num <= DECL_MAX_TYPES );
+		for ( i = 0; valid && i < num; i++ ) {
+			f.ReadString( typeNames.Alloc() );
+		}
+
+		f.ReadInt( num );
+		valid = valid && num >= 0;
+		for ( i = 0; valid && i < num; i++ ) {
+			declIndexFile_t *file = new declIndexFile_t;
+			int numDecls;
+
+			files.Append( file );
+
+			f.ReadString( file->fileName );
+			f.ReadInt( file->fileSize );
+			f.ReadInt( file->checksum );
+			f.ReadInt( file->numLines );
+			file->used = false;
+
+			f.ReadInt( numDecls );
+			if ( numDecls < 0 || numDecls > f.Length() - f.Tell() ) {
+				valid = false;
+				break;
+			}
+			file->decls.SetNum( numDecls );
+			for ( j = 0; j < numDecls; j++ ) {
+				declIndexDecl_t &decl = file->decls[j];
+				f.ReadInt( decl.typeNum );
+				f.ReadString( decl.name );
+				f.ReadInt( decl.offset );
+				f.ReadInt( decl.length );
+				f.ReadInt( decl.line );
+				if ( decl.typeNum < 0 || decl.typeNum >= typeNames.Num() ) {
+					valid = false;
+					break;
+				}
+			}
+		}
+		valid = valid && f.Tell() == f.Length();
+	}
+
+	fileSystem->FreeFile( buffer );
+
+	if ( !valid ) {
+		common->Printf( "%s is out of date or damaged, rebuilding it\n", DECL_INDEX_FILE );
+		Clear();
+		return;
+	}
+
+	// hashed after reading, as the names are only known then
+	fileHash.Free();
+	for ( i = 0; i < files.Num(); i++ ) {
+		fileHash.Add( fileHash.GenerateKey( files[i]->fileName, false ), i );
+	}
+}
+
+/*
+================
+idDeclIndex::Write
+
+  Writes the index if decl files were added or changed, without the ones which weren't loaded.
+================
+*/
+void idDeclIndex::Write( void ) {
+	int i, j, numFiles;
+
+	if ( !modified || !decl_index.GetBool() ) {
+		return;
+	}
+	modified = false;
+
+	idFile *f = fileSystem->OpenFileWrite( DECL_INDEX_FILE );
+	if ( f == NULL ) {
+		common->Warning( "Couldn't write %s", DECL_INDEX_FILE );
+		return;
+	}
+
+	f->Write( DECL_INDEX_ID, 4 );
+	f->WriteInt( DECL_INDEX_VERSION );
+	f->WriteInt( typeNames.Num() );
+	for ( i = 0; i < typeNames.Num(); i++ ) {
+		f->WriteString( typeNames[i] );
+	}
+
+	numFiles = 0;
+	for ( i = 0; i < files.Num(); i++ ) {
+		if ( files[i]->used ) {
+			numFiles++;
+		}
+	}
+
+	f->WriteInt( numFiles );
+	for ( i = 0; i < files.Num(); i++ ) {
+		const declIndexFile_t *file = files[i];
+		if ( !file->used ) {
+			continue;
+		}
+		f->WriteString( file->fileName );
+		f->WriteInt( file->fileSize );
+		f->WriteInt( file->checksum );
+		f->WriteInt( file->numLines );
+		f->WriteInt( file->decls.Num() );
+		for ( j = 0; j < file->decls.Num(); j++ ) {
+			const declIndexDecl_t &decl = file->decls[j];
+			f->WriteInt( decl.typeNum );
+			f->WriteString( decl.name );
+			f->WriteInt( decl.offset );
+			f->WriteInt( decl.length );
+			f->WriteInt( decl.line );
+		}
+	}
+
+	fileSystem->CloseFile( f );
+}
+
 /*
 ================
 idDeclFile::idDeclFile
@@ -601,8 +941,7 @@ int idDeclFile::LoadAndParse() {
 	int			length, size;
 	int			sourceLine;
 	idStr		name;
-	idDeclLocal *newDecl;
-	bool		reparse;
+	idList<pendingDeclText_t> pending;
 
 	// load the text
 	common->DPrintf( "...loading '%s'\n", fileName.c_str() );
@@ -612,152 +951,164 @@ int idDeclFile::LoadAndParse() {
 		return 0;
 	}
 
-	if ( !src.LoadMemory( buffer, length, fileName ) ) {
-		common->Error( "Couldn't parse %s", fileName.c_str() );
-		Mem_Free( buffer );
-		return 0;
-	}
-
 	// mark all the defs that were from the last reload of this file
 	for ( idDeclLocal *decl = decls; decl; decl = decl->nextInFile ) {
 		decl->redefinedInReload = false;
 	}
 
-	src.SetFlags( DECL_LEXER_FLAGS );
-
 	checksum = MD5_BlockChecksum( buffer, length );
 
 	fileSize = length;
 
-	// scan through, identifying each individual declaration
-	while( 1 ) {
-
-		startMarker = src.GetFileOffset();
-		sourceLine = src.GetLineNum();
+	// take the decl boundaries from the index while the file is unchanged
+	if ( !LoadFromIndex( pending ) ) {
 
-		// parse the decl type name
-		if ( !src.ReadToken( &token ) ) {
-			break;
+		if ( !src.LoadMemory( buffer, length, fileName ) ) {
+			common->Error( "Couldn't parse %s", fileName.c_str() );
+			Mem_Free( buffer );
+			return 0;
 		}
 
-		declType_t identifiedType = DECL_MAX_TYPES;
+		src.SetFlags( DECL_LEXER_FLAGS );
+
+		declIndexFile_t *indexFile = declManagerLocal.declIndex.AddFile( fileName, fileSize, checksum );
+
+		// scan through, identifying each individual declaration
+		while( 1 ) {
+
+			startMarker = src.GetFileOffset();
+			sourceLine = src.GetLineNum();
 
-		// get the decl type from the type name
-		numTypes = declManagerLocal.GetNumDeclTypes();
-		for ( i = 0; i < numTypes; i++ ) {
-			idDeclType *typeInfo = declManagerLocal.GetDeclType( i );
-			if ( typeInfo && typeInfo->typeName.Icmp( token ) == 0 ) {
-				identifiedType = (declType_t) typeInfo->type;
+			// parse the decl type name
+			if ( !src.ReadToken( &token ) ) {
 				break;
 			}
-		}
 
-		if ( i >= numTypes ) {
+			declType_t identifiedType = DECL_MAX_TYPES;
 
-			if ( token.Icmp( "{" ) == 0 ) {
+			// get the decl type from the type name
+			numTypes = declManagerLocal.GetNumDeclTypes();
+			for ( i = 0; i < numTypes; i++ ) {
+				idDeclType *typeInfo = declManagerLocal.GetDeclType( i );
+				if ( typeInfo && typeInfo->typeName.Icmp( token ) == 0 ) {
+					identifiedType = (declType_t) typeInfo->type;
+					break;
+				}
+			}
 
-				// if we ever see an open brace, we somehow missed the [type] <name> prefix
-				src.Warning( "Missing decl name" );
-				src.SkipBracedSection( false );
-				continue;
+			if ( i >= numTypes ) {
 
-			} else {
+				if ( token.Icmp( "{" ) == 0 ) {
 
-				if ( defaultType == DECL_MAX_TYPES ) {
-					src.Warning( "No type" );
+					// if we ever see an open brace, we somehow missed the [type] <name> prefix
+					src.Warning( "Missing decl name" );
+					src.SkipBracedSection( false );
 					continue;
+
+				} else {
+
+					if ( defaultType == DECL_MAX_TYPES ) {
+						src.Warning( "No type" );
+						continue;
+					}
+					src.UnreadToken( &token );
+					// use the default type
+					identifiedType = defaultType;
 				}
-				src.UnreadToken( &token );
-				// use the default type
-				identifiedType = defaultType;
 			}
-		}
 
-		// xdata needs to be allowed escape chars in string -- SteveL #4115
-		if ( identifiedType == DECL_XDATA )
-		{
-			src.SetFlags( DECL_LEXER_FLAGS & ~LEXFL_NOSTRINGESCAPECHARS );
-		} else {
-			src.SetFlags( DECL_LEXER_FLAGS );
-		}
+			// xdata needs to be allowed escape chars in string -- SteveL #4115
+			if ( identifiedType == DECL_XDATA )
+			{
+				src.SetFlags( DECL_LEXER_FLAGS & ~LEXFL_NOSTRINGESCAPECHARS );
+			} else {
+				src.SetFlags( DECL_LEXER_FLAGS );
+			}
 
-		// now parse the name
-		if ( !src.ReadToken( &token ) ) {
-			src.Warning( "Type without definition at end of file" );
-			break;
-		}
+			// now parse the name
+			if ( !src.ReadToken( &token ) ) {
+				src.Warning( "Type without definition at end of file" );
+				break;
+			}
 
-		if ( !token.Icmp( "{" ) ) {
-			// if we ever see an open brace, we somehow missed the [type] <name> prefix
-			src.Warning( "Missing decl name" );
-			src.SkipBracedSection( false );
-			continue;
-		}
+			if ( !token.Icmp( "{" ) ) {
+				// if we ever see an open brace, we somehow missed the [type] <name> prefix
+				src.Warning( "Missing decl name" );
+				src.SkipBracedSection( false );
+				continue;
+			}
 
-		// FIXME: export decls are only used by the model exporter, they are skipped here for now
-		if ( identifiedType == DECL_MODELEXPORT ) {
-			src.SkipBracedSection();
-			continue;
-		}
+			// FIXME: export decls are only used by the model exporter, they are skipped here for now
+			if ( identifiedType == DECL_MODELEXPORT ) {
+				src.SkipBracedSection();
+				continue;
+			}
 
-		name = token;
+			name = token;
 
-		// make sure there's a '{'
-		if ( !src.ReadToken( &token ) ) {
-			src.Warning( "Type without definition at end of file" );
-			break;
-		}
-		if ( token != "{" ) {
-			src.Warning( "Expecting '{' but found '%s'", token.c_str() );
-			continue;
-		}
-		src.UnreadToken( &token );
-
-		// now take everything until a matched closing brace
-		src.SkipBracedSection();
-		size = src.GetFileOffset() - startMarker;
-
-		// look it up, possibly getting a newly created default decl
-		reparse = false;
-		newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, false );
-		if ( newDecl ) {
-			// update the existing copy
-			if ( newDecl->sourceFile != this || newDecl->redefinedInReload ) {
-				src.Warning( "%s '%s' previously defined at %s:%i", declManagerLocal.GetDeclNameFromType( identifiedType ),
-								name.c_str(), newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
-				continue;
+			// make sure there's a '{'
+			if ( !src.ReadToken( &token ) ) {
+				src.Warning( "Type without definition at end of file" );
+				break;
 			}
-			if ( newDecl->declState != DS_UNPARSED ) {
-				reparse = true;
+			if ( token != "{" ) {
+				src.Warning( "Expecting '{' but found '%s'", token.c_str() );
+				continue;
 			}
-		} else {
-			// allow it to be created as a default, then add it to the per-file list
-			newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, true );
-			newDecl->nextInFile = this->decls;
-			this->decls = newDecl;
-		}
+			src.UnreadToken( &token );
 
-		newDecl->redefinedInReload = true;
+			// now take everything until a matched closing brace
+			src.SkipBracedSection();
+			size = src.GetFileOffset() - startMarker;
+
+			declIndexDecl_t &indexDecl = indexFile->decls.Alloc();
+			indexDecl.typeNum = declManagerLocal.declIndex.TypeNum( declManagerLocal.GetDeclNameFromType( identifiedType ) );
+			indexDecl.name = name;
+			indexDecl.offset = startMarker;
+			indexDecl.length = size;
+			indexDecl.line = sourceLine;
 
-		if ( newDecl->textSource ) {
-			Mem_Free( newDecl->textSource );
-			newDecl->textSource = NULL;
+			AddDecl( identifiedType, name, startMarker, size, sourceLine, pending );
 		}
 
-		newDecl->SetTextLocal( buffer + startMarker, size );
-		newDecl->sourceFile = this;
-		newDecl->sourceTextOffset = startMarker;
-		newDecl->sourceTextLength = size;
-		newDecl->sourceLine = sourceLine;
-		newDecl->declState = DS_UNPARSED;
+		numLines = src.GetLineNum();
+		indexFile->numLines = numLines;
+	}
 
-		// if it is currently in use, reparse it immedaitely
-		if ( reparse ) {
-			newDecl->ParseLocal();
-		}
+	// the checksums and compression only depend on the text, so they are done in parallel
+	// into one scratch buffer, which is then copied into the decls on this thread
+	const int numPending = pending.Num();
+	int scratchSize = 0;
+	for ( i = 0; i < numPending; i++ ) {
+		pending[i].scratchOffset = scratchSize;
+		scratchSize += idDeclLocal::MaxCompressedTextLength( pending[i].decl->sourceTextLength );
 	}
+	byte *scratch = (byte *)Mem_Alloc( Max( scratchSize, 1 ) );
 
-	numLines = src.GetLineNum();
+#ifndef GET_HUFFMAN_FREQUENCIES
+	#pragma omp parallel for if ( numPending > 16 ) schedule( dynamic, 16 )
+#endif
+	for ( int j = 0; j < numPending; j++ ) {
+		pendingDeclText_t &text = pending[j];
+		const char *declText = buffer + text.decl->sourceTextOffset;
+		const int declLength = text.decl->sourceTextLength;
+
+		text.checksum = MD5_BlockChecksum( declText, declLength );
+		text.compressedLength = idDeclLocal::CompressText( declText, declLength, scratch + text.scratchOffset );
+	}
+
+	for ( i = 0; i < numPending; i++ ) {
+		const pendingDeclText_t &text = pending[i];
+		text.decl->SetCompressedTextLocal( scratch + text.scratchOffset, text.compressedLength, text.decl->sourceTextLength, text.checksum );
+	}
+	Mem_Free( scratch );
+
+	// if it is currently in use, reparse it immediately
+	for ( i = 0; i < numPending; i++ ) {
+		if ( pending[i].reparse ) {
+			pending[i].decl->ParseLocal();
+		}
+	}
 
 	Mem_Free( buffer );
 
@@ -774,6 +1125,96 @@ int idDeclFile::LoadAndParse() {
 	return checksum;
 }
 
+/*
+================
+idDeclFile::LoadFromIndex
+
+Adds the decls the index holds for the file, if it has not changed since it was indexed
+================
+*/
+bool idDeclFile::LoadFromIndex( idList<pendingDeclText_t> &pending ) {
+	int i;
+	declType_t typeMap[DECL_MAX_TYPES];
+
+	const declIndexFile_t *indexFile = declManagerLocal.declIndex.FindFile( fileName, fileSize, checksum );
+	if ( indexFile == NULL ) {
+		return false;
+	}
+
+	const idDeclIndex &index = declManagerLocal.declIndex;
+
+	// the decl types are registered by name, the game may add them in another order
+	for ( i = 0; i < index.GetNumTypes(); i++ ) {
+		typeMap[i] = declManagerLocal.GetDeclTypeFromName( index.GetTypeName( i ) );
+	}
+
+	for ( i = 0; i < indexFile->decls.Num(); i++ ) {
+		const declIndexDecl_t &indexDecl = indexFile->decls[i];
+		if ( typeMap[indexDecl.typeNum] == DECL_MAX_TYPES ) {
+			// indexed while a type was registered that isn't now
+			return false;
+		}
+	}
+
+	for ( i = 0; i < indexFile->decls.Num(); i++ ) {
+		const declIndexDecl_t &indexDecl = indexFile->decls[i];
+		AddDecl( typeMap[indexDecl.typeNum], indexDecl.name, indexDecl.offset, indexDecl.length, indexDecl.line, pending );
+	}
+
+	numLines = indexFile->numLines;
+	return true;
+}
+
+/*
+================
+idDeclFile::AddDecl
+
+Finds or creates the decl at the given place in the file, its text is set from pending
+================
+*/
+void idDeclFile::AddDecl( declType_t type, const char *name, int offset, int size, int line, idList<pendingDeclText_t> &pending ) {
+	bool reparse;
+	idDeclLocal *newDecl;
+
+	// look it up, possibly getting a newly created default decl
+	reparse = false;
+	newDecl = declManagerLocal.FindTypeWithoutParsing( type, name, false );
+	if ( newDecl ) {
+		// update the existing copy
+		if ( newDecl->sourceFile != this || newDecl->redefinedInReload ) {
+			common->Warning( "file %s, line %d: %s '%s' previously defined at %s:%i", fileName.c_str(), line,
+							declManagerLocal.GetDeclNameFromType( type ), name, newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
+			return;
+		}
+		if ( newDecl->declState != DS_UNPARSED ) {
+			reparse = true;
+		}
+	} else {
+		// allow it to be created as a default, then add it to the per-file list
+		newDecl = declManagerLocal.FindTypeWithoutParsing( type, name, true );
+		newDecl->nextInFile = this->decls;
+		this->decls = newDecl;
+	}
+
+	newDecl->redefinedInReload = true;
+
+	if ( newDecl->textSource ) {
+		Mem_Free( newDecl->textSource );
+		newDecl->textSource = NULL;
+	}
+
+	newDecl->sourceFile = this;
+	newDecl->sourceTextOffset = offset;
+	newDecl->sourceTextLength = size;
+	newDecl->sourceLine = line;
+	newDecl->declState = DS_UNPARSED;
+
+	// the text is checksummed and compressed for all decls of the file at once
+	pendingDeclText_t &text = pending.Alloc();
+	text.decl = newDecl;
+	text.reparse = reparse;
+}
+
 /*
 ====================================================================================
 
@@ -815,6 +1256,8 @@ void idDeclManagerLocal::Init( void ) {
 	RegisterDeclType( "particle",			DECL_PARTICLE,		idDeclAllocator<idDeclParticle> );
 	RegisterDeclType( "articulatedFigure",	DECL_AF,			idDeclAllocator<idDeclAF> );
 
+	declIndex.Load();
+
 	RegisterDeclFolder( "materials",		".mtr",				DECL_MATERIAL );
 	RegisterDeclFolder( "skins",			".skin",			DECL_SKIN );
 	RegisterDeclFolder( "sound",			".sndshd",			DECL_SOUND );
@@ -859,6 +1302,9 @@ void idDeclManagerLocal::Shutdown( void ) {
 	int			i, j;
 	idDeclLocal *decl;
 
+	declIndex.Write();
+	declIndex.Clear();
+
 	// free decls
 	for ( i = 0; i < DECL_MAX_TYPES; i++ ) {
 		for ( j = 0; j < linearLists[i].Num(); j++ ) {
@@ -908,6 +1354,9 @@ idDeclManagerLocal::BeginLevelLoad
 void idDeclManagerLocal::BeginLevelLoad() {
 	insideLevelLoad = true;
 
+	// all decl folders have been registered by now
+	declIndex.Write();
+
 	// clear all the referencedThisLevel flags and purge all the data
 	// so the next reference will cause a reparse
 	for ( int i = 0; i < DECL_MAX_TYPES; i++ ) {
@@ -1339,9 +1788,10 @@ idDecl *idDeclManagerLocal::CreateNewDecl( declType_t type, const char *name, co
 	fileName.BackSlashesToSlashes();
 
 	// see if it already exists
+	idInternStr internName = idInternStr::Find( canonicalName );
 	hash = hashTables[typeIndex].GenerateKey( canonicalName, false );
-	for ( i = hashTables[typeIndex].First( hash ); i >= 0; i = hashTables[typeIndex].Next( i ) ) {
-		if ( linearLists[typeIndex][i]->name.Icmp( canonicalName ) == 0 ) {
+	for ( i = internName.IsValid() ? hashTables[typeIndex].First( hash ) : -1; i >= 0; i = hashTables[typeIndex].Next( i ) ) {
+		if ( linearLists[typeIndex][i]->internName == internName ) {
 			linearLists[typeIndex][i]->AllocateSelf();
 			return linearLists[typeIndex][i]->self;
 		}
@@ -1364,6 +1814,7 @@ idDecl *idDeclManagerLocal::CreateNewDecl( declType_t type, const char *name, co
 
 	idDeclLocal *decl = new idDeclLocal;
 	decl->name = canonicalName;
+	decl->internName.Set( canonicalName );
 	decl->type = type;
 	decl->declState = DS_UNPARSED;
 	decl->AllocateSelf();
@@ -1434,6 +1885,7 @@ bool idDeclManagerLocal::RenameDecl( declType_t type, const char* oldName, const
 
 	//Change the name
 	decl->name = canonicalNewName;
+	decl->internName.Set( canonicalNewName );
 
 
 	// add it to the hash table
@@ -1687,10 +2139,11 @@ idDeclLocal *idDeclManagerLocal::FindTypeWithoutParsing( declType_t type, const
 
 	MakeNameCanonical( name, canonicalName, sizeof( canonicalName ) );
 
-	// see if it already exists
+	// see if it already exists, names that were never interned have no decl
+	idInternStr internName = idInternStr::Find( canonicalName );
 	hash = hashTables[typeIndex].GenerateKey( canonicalName, false );
-	for ( i = hashTables[typeIndex].First( hash ); i >= 0; i = hashTables[typeIndex].Next( i ) ) {
-		if ( linearLists[typeIndex][i]->name.Icmp( canonicalName ) == 0 ) {
+	for ( i = internName.IsValid() ? hashTables[typeIndex].First( hash ) : -1; i >= 0; i = hashTables[typeIndex].Next( i ) ) {
+		if ( linearLists[typeIndex][i]->internName == internName ) {
 			// only print these when decl_show is set to 2, because it can be a lot of clutter
 			if ( decl_show.GetInteger() > 1 ) {
 				MediaPrint( "referencing %s %s\n", declTypes[ type ]->typeName.c_str(), name );
@@ -1706,6 +2159,7 @@ idDeclLocal *idDeclManagerLocal::FindTypeWithoutParsing( declType_t type, const
 	idDeclLocal *decl = new idDeclLocal;
 	decl->self = NULL;
 	decl->name = canonicalName;
+	decl->internName.Set( canonicalName );
 	decl->type = type;
 	decl->declState = DS_UNPARSED;
 	decl->textSource = NULL;
@@ -1894,30 +2348,65 @@ idDeclLocal::SetTextLocal
 =================
 */
 void idDeclLocal::SetTextLocal( const char *text, const int length ) {
+	byte *compressed = (byte *)_alloca( MaxCompressedTextLength( length ) );
+	int compressedLength = CompressText( text, length, compressed );
+
+	SetCompressedTextLocal( compressed, compressedLength, length, MD5_BlockChecksum( text, length ) );
+}
+
+/*
+=================
+idDeclLocal::SetCompressedTextLocal
+=================
+*/
+void idDeclLocal::SetCompressedTextLocal( const byte *compressed, const int compressedLength, const int length, const int checksum ) {
 
 	Mem_Free( textSource );
 
-	checksum = MD5_BlockChecksum( text, length );
+	this->checksum = checksum;
+
+	textSource = (char *)Mem_Alloc( compressedLength );
+	memcpy( textSource, compressed, compressedLength );
+	this->compressedLength = compressedLength;
+	textLength = length;
+}
 
+/*
+=================
+idDeclLocal::CompressText
+
+  Without compression the text is copied including the trailing zero.
+=================
+*/
+int idDeclLocal::CompressText( const char *text, const int length, byte *compressed ) {
 #ifdef GET_HUFFMAN_FREQUENCIES
 	for( int i = 0; i < length; i++ ) {
+		#pragma omp atomic
 		huffmanFrequencies[((const unsigned char *)text)[i]]++;
 	}
 #endif
 
+#ifdef USE_COMPRESSED_DECLS
+	return HuffmanCompressText( text, length, compressed, MaxCompressedTextLength( length ) );
+#else
+	memcpy( compressed, text, length );
+	compressed[length] = '\0';
+	return length + 1;
+#endif
+}
+
+/*
+=================
+idDeclLocal::MaxCompressedTextLength
+=================
+*/
+int idDeclLocal::MaxCompressedTextLength( const int length ) {
 #ifdef USE_COMPRESSED_DECLS
 	int maxBytesPerCode = ( maxHuffmanBits + 7 ) >> 3;
-	byte *compressed = (byte *)_alloca( length * maxBytesPerCode );
-	compressedLength = HuffmanCompressText( text, length, compressed, length * maxBytesPerCode );
-	textSource = (char *)Mem_Alloc( compressedLength );
-	memcpy( textSource, compressed, compressedLength );
+	return length * maxBytesPerCode;
 #else
-	compressedLength = length;
-	textSource = (char *) Mem_Alloc( length + 1 );
-	memcpy( textSource, text, length );
-	textSource[length] = '\0';
+	return length + 1;
 #endif
-	textLength = length;
 }
 
 /*
@@ -2147,6 +2636,8 @@ idDeclLocal::ParseLocal
 */
 void idDeclLocal::ParseLocal( void ) {
 	bool generatedDefaultText = false;
+	idLoadProfileScope profile( declManagerLocal.declTypes[type]->typeName.c_str(), name.c_str() );
+	idScopedMemTag memTag( MEMTAG_DECLS );
 
 	AllocateSelf();
 
@@ -169,6 +169,37 @@ typedef struct searchpath_s {
 	struct searchpath_s *next;
 } searchpath_t;
 
+// a file of the pack index, which finds the pack a file comes from with a single lookup
+typedef struct {
+	pack_t *			pack;
+	fileInPack_t *		file;
+	int					searchIndex;				// position of the pack in the search path
+} packIndexEntry_t;
+
+// the lookup misses are forgotten once there are this many
+#define MAX_LOOKUP_MISSES		16384
+
+// a read queued for the async read thread
+struct asyncRead_s {
+	struct asyncRead_s *next;
+	idFile *			f;
+	void *				buffer;
+	int					length;
+	ID_TIME_T			timestamp;
+	bool				ownsFile;		// opened and allocated by ReadFileAsync
+	bool				write;			// started by WriteAsync
+	volatile bool		completed;
+};
+
+// a buffer handed out by ReadFileMapped
+typedef struct {
+	const void *		data;
+	sysFileMapping_t	mapping;
+} mappedFile_t;
+
+// smaller files are copied, as mapping them costs more than the copy
+#define FS_MAP_MIN_SIZE			( 64 * 1024 )
+
 // search flags when opening a file
 #define FSFLAG_SEARCH_DIRS		( 1 << 0 )
 #define FSFLAG_SEARCH_PAKS		( 1 << 1 )
@@ -221,6 +252,12 @@ public:
 	virtual int				GetOSMask( void );
 	virtual int				ReadFile( const char *relativePath, void **buffer, ID_TIME_T *timestamp );
 	virtual void			FreeFile( void *buffer );
+	virtual int				ReadFileMapped( const char *relativePath, const void **buffer, ID_TIME_T *timestamp );
+	virtual asyncRead_t *	ReadFileAsync( const char *relativePath );
+	virtual asyncRead_t *	ReadAsync( idFile *f, void *buffer, int length );
+	virtual asyncRead_t *	WriteAsync( idFile *f, const void *buffer, int length );
+	virtual bool			IsReadFileAsyncDone( const asyncRead_t *read ) const;
+	virtual int				FinishReadFileAsync( asyncRead_t *read, void **buffer, ID_TIME_T *timestamp );
 	virtual int				WriteFile( const char *relativePath, const void *buffer, int size, const char *basePath = "fs_modSavePath", const char *gamedir = NULL );
 	virtual void			RemoveFile( const char *relativePath, const char *gamedir = NULL);
     virtual idFile *		OpenFileReadFlags( const char *relativePath, int searchFlags, pack_t **foundInPak = NULL, const char* gamedir = NULL );
@@ -257,11 +294,13 @@ public:
 
 private:
 	friend dword 			BackgroundDownloadThread( void *parms );
+	friend dword 			AsyncReadThread( void *parms );
 
 	searchpath_t *			searchPaths;
 	int						readCount;			// total bytes read
 	int						loadCount;			// total files read
 	int						loadStack;			// total files in memory
+	idList<mappedFile_t>	mappedFiles;		// buffers of ReadFileMapped which are mapped rather than allocated
 	idStr					gameFolder;			// this will be a single name without separators
 
 	searchpath_t			*addonPaks;			// not loaded up, but we saw them
@@ -273,6 +312,9 @@ private:
 	static idCVar			fs_savepath;
 	static idCVar			fs_devpath;
 	static idCVar			fs_caseSensitiveOS;
+	static idCVar			fs_mapFiles;
+	static idCVar			fs_lookupCache;
+	static idCVar			fs_asyncRead;
 	static idCVar			fs_searchAddons;
 
     // taaaki: fs_game and fs_game_base have been removed as TDM is no longer a mod and these fs cvars were causing
@@ -289,6 +331,11 @@ private:
 	backgroundDownload_t	defaultBackgroundDownload;
 	xthreadInfo				backgroundThread;
 
+	asyncRead_t *			asyncReads;			// queued for the async read thread, first in first out
+	asyncRead_t *			asyncReadsTail;
+	int						numAsyncReads;		// started and not finished yet
+	xthreadInfo				asyncReadThread;
+
 	idList<pack_t *>		serverPaks;
 	bool					loadedFileFromDir;		// set to true once a file was loaded from a directory
 	idList<int>				restartChecksums;		// used during a restart to set things in right order
@@ -303,9 +350,31 @@ private:
 	int						dir_cache_index;
 	int						dir_cache_count;
 
+	// all files of the packs on the search path, rebuilt when the search path changes
+	idList<packIndexEntry_t> packIndex;
+	idHashIndex				packIndexHash;
+	bool					packIndexValid;
+
+	// the files OpenFileReadFlags didn't find, with the search flags, cleared when files are written
+	idStrList				lookupMisses;
+	idList<int>				lookupMissFlags;
+	idHashIndex				lookupMissHash;
+
 private:
 	void					ReplaceSeparators( idStr &path, char sep = PATHSEPERATOR_CHAR );
 	long					HashFileName( const char *fname ) const;
+	static int				FileNameKey( const char *fname );
+	bool					IsBinaryPak( pack_t *pak );
+	fileInPack_t *			FindFileInPak( pack_t *pak, const char *relativePath, int searchFlags );
+	void					BuildPackIndex( void );
+	const packIndexEntry_t *FindInPackIndex( const char *relativePath, int searchFlags );
+	bool					IsLookupMiss( const char *relativePath, int searchFlags ) const;
+	void					AddLookupMiss( const char *relativePath, int searchFlags );
+	void					ClearLookupCache( void );
+	void					StartAsyncReadThread( void );
+	void					QueueAsyncRead( asyncRead_t *read );
+	static int				ReadAsyncData( asyncRead_t *read );
+	static int				WriteAsyncData( asyncRead_t *read );
 	int						ListOSFiles( const char *directory, const char *extension, idStrList &list );
 	FILE *					OpenOSFile( const char *name, const char *mode, idStr *caseSensitiveName = NULL );
 	FILE *					OpenOSFileCorrectName( idStr &path, const char *mode );
@@ -349,6 +418,9 @@ idCVar	idFileSystemLocal::fs_caseSensitiveOS( "fs_caseSensitiveOS", "0", CVAR_SY
 #else
 idCVar	idFileSystemLocal::fs_caseSensitiveOS( "fs_caseSensitiveOS", "1", CVAR_SYSTEM | CVAR_BOOL, "" );
 #endif
+idCVar	idFileSystemLocal::fs_mapFiles( "fs_mapFiles", "1", CVAR_SYSTEM | CVAR_BOOL, "map uncompressed files into memory instead of copying them, where the caller allows it" );
+idCVar	idFileSystemLocal::fs_lookupCache( "fs_lookupCache", "1", CVAR_SYSTEM | CVAR_BOOL, "find files in the pk4s with one global index and remember the files which don't exist, disable when creating files outside the game while it is running" );
+idCVar	idFileSystemLocal::fs_asyncRead( "fs_asyncRead", "1", CVAR_SYSTEM | CVAR_BOOL, "read the files of ReadFileAsync on the async read thread, 0 reads them right away" );
 idCVar	idFileSystemLocal::fs_searchAddons( "fs_searchAddons", "0", CVAR_SYSTEM | CVAR_BOOL, "search all addon pk4s ( disables addon functionality )" );
 
 // greebo: Custom savepath in darkmod/fms/
@@ -372,7 +444,12 @@ idFileSystemLocal::idFileSystemLocal( void ) {
 	loadedFileFromDir = false;
 	restartGamePakChecksum = 0;
 	memset( &backgroundThread, 0, sizeof( backgroundThread ) );
+	memset( &asyncReadThread, 0, sizeof( asyncReadThread ) );
+	asyncReads = NULL;
+	asyncReadsTail = NULL;
+	numAsyncReads = 0;
 	addonPaks = NULL;
+	packIndexValid = false;
 }
 
 /*
@@ -404,6 +481,180 @@ long idFileSystemLocal::HashFileName( const char *fname ) const {
 	return hash;
 }
 
+/*
+================
+idFileSystemLocal::FileNameKey
+
+hash key of the pack index and the lookup misses, unlike HashFileName
+it includes the extension, so probing the image formats of a name
+doesn't walk the same chain
+================
+*/
+int idFileSystemLocal::FileNameKey( const char *fname ) {
+	int key = 0;
+
+	for ( int i = 0; fname[i] != '\0'; i++ ) {
+		char letter = idStr::ToLower( fname[i] );
+		if ( letter == '\\' ) {
+			letter = '/';
+		}
+		key = key * 31 + letter;
+	}
+	return key & 0x7fffffff;
+}
+
+/*
+================
+idFileSystemLocal::IsBinaryPak
+================
+*/
+bool idFileSystemLocal::IsBinaryPak( pack_t *pak ) {
+	// make sure this pak is tagged as a binary file
+	if ( pak->binary == BINARY_UNKNOWN ) {
+		const int confHash = HashFileName( BINARY_CONFIG );
+		pak->binary = BINARY_NO;
+		for ( fileInPack_t *pakFile = pak->hashTable[confHash]; pakFile; pakFile = pakFile->next ) {
+			if ( !FilenameCompare( pakFile->name, BINARY_CONFIG ) ) {
+				pak->binary = BINARY_YES;
+				break;
+			}
+		}
+	}
+	return pak->binary == BINARY_YES;
+}
+
+/*
+================
+idFileSystemLocal::FindFileInPak
+================
+*/
+fileInPack_t *idFileSystemLocal::FindFileInPak( pack_t *pak, const char *relativePath, int searchFlags ) {
+	const long hash = HashFileName( relativePath );
+
+	if ( !pak->hashTable[hash] ) {
+		return NULL;
+	}
+
+	if ( ( searchFlags & FSFLAG_BINARY_ONLY ) && !IsBinaryPak( pak ) ) {
+		return NULL; // not a binary pak, skip
+	}
+
+	for ( fileInPack_t *pakFile = pak->hashTable[hash]; pakFile; pakFile = pakFile->next ) {
+		// case and separator insensitive comparisons
+		if ( !FilenameCompare( pakFile->name, relativePath ) ) {
+			return pakFile;
+		}
+	}
+	return NULL;
+}
+
+/*
+================
+idFileSystemLocal::BuildPackIndex
+================
+*/
+void idFileSystemLocal::BuildPackIndex( void ) {
+	searchpath_t *search;
+	int searchIndex, numFiles;
+
+	numFiles = 0;
+	for ( search = searchPaths; search; search = search->next ) {
+		if ( search->pack ) {
+			numFiles += search->pack->numfiles;
+		}
+	}
+
+	packIndex.Clear();
+	packIndex.Resize( numFiles );
+	packIndexHash.Clear( Max( 1024, idMath::CeilPowerOfTwo( numFiles / 4 ) ), Max( 1024, numFiles ) );
+
+	for ( search = searchPaths, searchIndex = 0; search; search = search->next, searchIndex++ ) {
+		pack_t *pak = search->pack;
+		if ( !pak ) {
+			continue;
+		}
+		for ( int i = 0; i < pak->numfiles; i++ ) {
+			packIndexEntry_t entry;
+			entry.pack = pak;
+			entry.file = &pak->buildBuffer[i];
+			entry.searchIndex = searchIndex;
+			packIndexHash.Add( FileNameKey( entry.file->name ), packIndex.Append( entry ) );
+		}
+	}
+
+	packIndexValid = true;
+}
+
+/*
+================
+idFileSystemLocal::FindInPackIndex
+
+returns the first pack on the search path with the file
+================
+*/
+const packIndexEntry_t *idFileSystemLocal::FindInPackIndex( const char *relativePath, int searchFlags ) {
+	const packIndexEntry_t *best = NULL;
+
+	if ( !packIndexValid ) {
+		BuildPackIndex();
+	}
+
+	for ( int i = packIndexHash.First( FileNameKey( relativePath ) ); i != -1; i = packIndexHash.Next( i ) ) {
+		const packIndexEntry_t &entry = packIndex[i];
+		if ( best && best->searchIndex <= entry.searchIndex ) {
+			continue;
+		}
+		if ( FilenameCompare( entry.file->name, relativePath ) ) {
+			continue;
+		}
+		if ( ( searchFlags & FSFLAG_BINARY_ONLY ) && !IsBinaryPak( entry.pack ) ) {
+			continue;
+		}
+		best = &entry;
+	}
+	return best;
+}
+
+/*
+================
+idFileSystemLocal::IsLookupMiss
+================
+*/
+bool idFileSystemLocal::IsLookupMiss( const char *relativePath, int searchFlags ) const {
+	for ( int i = lookupMissHash.First( FileNameKey( relativePath ) ); i != -1; i = lookupMissHash.Next( i ) ) {
+		if ( lookupMissFlags[i] == searchFlags && !FilenameCompare( lookupMisses[i], relativePath ) ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+================
+idFileSystemLocal::AddLookupMiss
+================
+*/
+void idFileSystemLocal::AddLookupMiss( const char *relativePath, int searchFlags ) {
+	if ( lookupMisses.Num() >= MAX_LOOKUP_MISSES ) {
+		lookupMisses.Clear();
+		lookupMissFlags.Clear();
+		lookupMissHash.Clear();
+	}
+	lookupMissFlags.Append( searchFlags );
+	lookupMissHash.Add( FileNameKey( relativePath ), lookupMisses.Append( relativePath ) );
+}
+
+/*
+================
+idFileSystemLocal::ClearLookupCache
+================
+*/
+void idFileSystemLocal::ClearLookupCache( void ) {
+	lookupMisses.Clear();
+	lookupMissFlags.Clear();
+	lookupMissHash.Free();
+}
+
 /*
 ===========
 idFileSystemLocal::FilenameCompare
@@ -582,6 +833,7 @@ void idFileSystemLocal::CopyFile( const char *fromOSPath, const char *toOSPath )
 	fclose( f );
 
 	CreateOSPath( toOSPath );
+	ClearLookupCache();
 	f = OpenOSFile( toOSPath, "wb" );
 	if ( !f ) {
 		common->Printf( "could not create destination file\n" );
@@ -615,6 +867,7 @@ void idFileSystemLocal::CopyFile( idFile *src, const char *toOSPath ) {
 	}
 
 	CreateOSPath( toOSPath );
+	ClearLookupCache();
 	f = OpenOSFile( toOSPath, "wb" );
 	if ( !f ) {
 		common->Printf( "could not create destination file\n" );
@@ -991,9 +1244,91 @@ void idFileSystemLocal::FreeFile( void *buffer ) {
 	}
 	loadStack--;
 
+	for ( int i = 0; i < mappedFiles.Num(); i++ ) {
+		if ( mappedFiles[i].data == buffer ) {
+			Sys_UnmapFileRegion( mappedFiles[i].mapping );
+			mappedFiles.RemoveIndex( i );
+			return;
+		}
+	}
+
 	Mem_Free( buffer );
 }
 
+/*
+============
+idFileSystemLocal::ReadFileMapped
+============
+*/
+int idFileSystemLocal::ReadFileMapped( const char *relativePath, const void **buffer, ID_TIME_T *timestamp ) {
+	if ( !searchPaths ) {
+		common->FatalError( "Filesystem call made without initialization\n" );
+	} else if ( !relativePath || !relativePath[0] ) {
+		common->FatalError( "idFileSystemLocal::ReadFileMapped: NULL 'relativePath' parameter passed\n" );
+	}
+
+	// journalled files are read from the journal
+	if ( !fs_mapFiles.GetBool() || !buffer || ( eventLoop && eventLoop->JournalLevel() != 0 ) ) {
+		return ReadFile( relativePath, (void **)buffer, timestamp );
+	}
+
+	*buffer = NULL;
+	if ( timestamp ) {
+		*timestamp = FILE_NOT_FOUND_TIMESTAMP;
+	}
+
+	idFile *f = OpenFileRead( relativePath );
+	if ( f == NULL ) {
+		return -1;
+	}
+
+	int len = f->Length();
+	FILE *fp = NULL;
+	int offset = 0;
+
+	if ( len >= FS_MAP_MIN_SIZE ) {
+		idFile_Permanent *permanent = dynamic_cast<idFile_Permanent *>( f );
+		idFile_InZip *inZip = dynamic_cast<idFile_InZip *>( f );
+
+		if ( permanent != NULL ) {
+			fp = permanent->o;
+		} else if ( inZip != NULL ) {
+			unz_s *zfi = (unz_s *)inZip->z;
+			file_in_zip_read_info_s *info = zfi->pfile_in_zip_read;
+
+			// only stored entries are the same on disk
+			if ( info != NULL && info->compression_method == 0 ) {
+				fp = zfi->file;
+				offset = info->pos_in_zipfile + info->byte_before_the_zipfile;
+			}
+		}
+	}
+
+	mappedFile_t mapped;
+	mapped.data = ( fp != NULL ) ? Sys_MapFileRegion( fp, offset, len, mapped.mapping ) : NULL;
+
+	if ( mapped.data == NULL ) {
+		CloseFile( f );
+		return ReadFile( relativePath, (void **)buffer, timestamp );
+	}
+
+	if ( timestamp ) {
+		*timestamp = f->Timestamp();
+	}
+
+	// the mapping stays valid after the file is closed
+	CloseFile( f );
+
+	mappedFiles.Append( mapped );
+	*buffer = mapped.data;
+
+	loadCount++;
+	loadStack++;
+	readCount += len;
+
+	return len;
+}
+
 /*
 ============
 idFileSystemLocal::WriteFile
@@ -1264,6 +1599,8 @@ int idFileSystemLocal::AddZipFile( const char *path ) {
 	}
 
 	last->next = search;
+	packIndexValid = false;
+	ClearLookupCache();
 	common->Printf( "Appended %s (checksum 0x%x)\n", pak->pakFilename.c_str(), pak->checksum );
 	return pak->checksum;
 }
@@ -2179,6 +2516,10 @@ void idFileSystemLocal::Startup( void ) {
 	cmdSystem->AddCommand( "touchFile", TouchFile_f, CMD_FL_SYSTEM, "touches a file" );
 	cmdSystem->AddCommand( "touchFileList", TouchFileList_f, CMD_FL_SYSTEM, "touches a list of files" );
 
+	// the search path is complete
+	packIndexValid = false;
+	ClearLookupCache();
+
 	// print the current search paths
 	Path_f( idCmdArgs() );
 
@@ -2389,6 +2730,9 @@ void idFileSystemLocal::Init( void ) {
 	// spawn a thread to handle background file reads
     StartBackgroundDownloadThread( );
 
+	// and one for ReadFileAsync
+	StartAsyncReadThread( );
+
 	// if we can't find default.cfg, assume that the paths are
 	// busted and error out now, rather than getting an unreadable
 	// graphics screen when the font fails to load
@@ -2427,6 +2771,10 @@ Frees all resources and closes all files
 void idFileSystemLocal::Shutdown( bool reloading ) {
 	searchpath_t *sp, *next, *loop;
 
+	if ( numAsyncReads ) {
+		common->Warning( "idFileSystemLocal::Shutdown: %d async reads weren't finished", numAsyncReads );
+	}
+
 	gameFolder.Clear();
 	serverPaks.Clear();
 
@@ -2466,6 +2814,10 @@ void idFileSystemLocal::Shutdown( bool reloading ) {
 	searchPaths = NULL;
 	addonPaks = NULL;
 
+	packIndex.Clear();
+	packIndexHash.Free();
+	packIndexValid = false;
+
 	cmdSystem->RemoveCommand( "path" );
 	cmdSystem->RemoveCommand( "dir" );
 	cmdSystem->RemoveCommand( "dirtree" );
@@ -2597,8 +2949,10 @@ idFile *idFileSystemLocal::OpenFileReadFlags( const char *relativePath, int sear
 	pack_t *		pak;
 	fileInPack_t *	pakFile;
 	directory_t *	dir;
-	long			hash;
 	FILE *			fp;
+	int				searchIndex;
+	const packIndexEntry_t *indexed;
+	bool			useLookupCache;
 	
 	if ( !searchPaths ) {
 		common->FatalError( "Filesystem call made without initialization\n" );
@@ -2623,10 +2977,24 @@ idFile *idFileSystemLocal::OpenFileReadFlags( const char *relativePath, int sear
 		return NULL;
 	}
 	
-	// search through the path, one element at a time
-	hash = HashFileName( relativePath );
+	// the lookups with a game dir only search some of the directories
+	useLookupCache = fs_lookupCache.GetBool() && !( gamedir && gamedir[0] );
 
-	for ( search = searchPaths; search; search = search->next ) {
+	if ( useLookupCache && IsLookupMiss( relativePath, searchFlags ) ) {
+		if ( fs_debug.GetInteger( ) ) {
+			common->Printf( "Can't find %s (cached)\n", relativePath );
+		}
+		return NULL;
+	}
+
+	// the pack index tells which pack on the search path has the file, so only the directories before it are searched
+	indexed = NULL;
+	if ( fs_lookupCache.GetBool() && ( searchFlags & FSFLAG_SEARCH_PAKS ) ) {
+		indexed = FindInPackIndex( relativePath, searchFlags );
+	}
+
+	// search through the path, one element at a time
+	for ( search = searchPaths, searchIndex = 0; search; search = search->next, searchIndex++ ) {
 		if ( search->dir && ( searchFlags & FSFLAG_SEARCH_DIRS ) ) {
 			// check a file in the directory tree
 
@@ -2664,58 +3032,45 @@ idFile *idFileSystemLocal::OpenFileReadFlags( const char *relativePath, int sear
 
 			return file;
 		} else if ( search->pack && ( searchFlags & FSFLAG_SEARCH_PAKS ) ) {
-
-			if ( !search->pack->hashTable[hash] ) {
-				continue;
-			}
-
-			// look through all the pak file elements
 			pak = search->pack;
 
-			if ( searchFlags & FSFLAG_BINARY_ONLY ) {
-				// make sure this pak is tagged as a binary file
-				if ( pak->binary == BINARY_UNKNOWN ) {
-					const int confHash = HashFileName( BINARY_CONFIG );
-					pak->binary = BINARY_NO;
-					for ( pakFile = search->pack->hashTable[confHash]; pakFile; pakFile = pakFile->next ) {
-						if ( !FilenameCompare( pakFile->name, BINARY_CONFIG ) ) {
-							pak->binary = BINARY_YES;
-							break;
-						}
-					}
+			if ( fs_lookupCache.GetBool() ) {
+				if ( !indexed || indexed->searchIndex != searchIndex ) {
+					continue;
 				}
-				if ( pak->binary == BINARY_NO ) {
-					continue; // not a binary pak, skip
+				pakFile = indexed->file;
+			} else {
+				// look through all the pak file elements
+				pakFile = FindFileInPak( pak, relativePath, searchFlags );
+				if ( !pakFile ) {
+					continue;
 				}
 			}
 
-			for ( pakFile = pak->hashTable[hash]; pakFile; pakFile = pakFile->next ) {
-				// case and separator insensitive comparisons
-				if ( !FilenameCompare( pakFile->name, relativePath ) ) {
-					idFile_InZip *file = ReadFileFromZip( pak, pakFile, relativePath );
-
-					if ( foundInPak ) {
-						*foundInPak = pak;
-					}
+			idFile_InZip *file = ReadFileFromZip( pak, pakFile, relativePath );
 
-					if ( !pak->referenced ) {
-						// mark this pak referenced
-						if ( fs_debug.GetInteger( ) ) {
-							common->Printf( "idFileSystem::OpenFileRead: %s -> adding %s to referenced paks\n", relativePath, pak->pakFilename.c_str() );
-						}
-						pak->referenced = true;
-					}
+			if ( foundInPak ) {
+				*foundInPak = pak;
+			}
 
-					if ( fs_debug.GetInteger( ) ) {
-						common->Printf( "idFileSystem::OpenFileRead: %s (found in '%s')\n", relativePath, pak->pakFilename.c_str() );
-					}
-					return file;
+			if ( !pak->referenced ) {
+				// mark this pak referenced
+				if ( fs_debug.GetInteger( ) ) {
+					common->Printf( "idFileSystem::OpenFileRead: %s -> adding %s to referenced paks\n", relativePath, pak->pakFilename.c_str() );
 				}
+				pak->referenced = true;
 			}
+
+			if ( fs_debug.GetInteger( ) ) {
+				common->Printf( "idFileSystem::OpenFileRead: %s (found in '%s')\n", relativePath, pak->pakFilename.c_str() );
+			}
+			return file;
 		}
 	}
 
 	if ( searchFlags & FSFLAG_SEARCH_ADDONS ) {
+		const long hash = HashFileName( relativePath );
+
 		search = addonPaks;
 		while ( search && search->pack ) {
 			pak = search->pack;
@@ -2736,6 +3091,10 @@ idFile *idFileSystemLocal::OpenFileReadFlags( const char *relativePath, int sear
 			search = search->next;
 		}
 	}
+
+	if ( useLookupCache ) {
+		AddLookupMiss( relativePath, searchFlags );
+	}
 	
 	if ( fs_debug.GetInteger( ) ) {
 		common->Printf( "Can't find %s\n", relativePath );
@@ -2851,6 +3210,7 @@ idFile *idFileSystemLocal::OpenExplicitFileWrite( const char *OSPath ) {
 
 	common->DPrintf( "writing to: %s\n", OSPath );
 	CreateOSPath( OSPath );
+	ClearLookupCache();
 
 	f = new idFile_Permanent();
 	f->o = OpenOSFile( OSPath, "wb" );
@@ -2888,6 +3248,7 @@ idFile *idFileSystemLocal::OpenFileAppend( const char *relativePath, bool sync,
 
 	OSpath = BuildOSPath( path, gamedir ? gamedir : gameFolder.c_str(), relativePath );
 	CreateOSPath( OSpath );
+	ClearLookupCache();
 
 	if ( fs_debug.GetInteger() ) {
 		common->Printf( "idFileSystem::OpenFileAppend: %s\n", OSpath.c_str() );
@@ -3151,6 +3512,271 @@ void idFileSystemLocal::BackgroundDownload( backgroundDownload_t *bgl ) {
 	}
 }
 
+/*
+===================
+AsyncReadThread
+
+Reads the files queued by ReadFileAsync and writes the ones queued by WriteAsync.
+The buffers and files are allocated
+and opened by the main thread, and the zip inflate allocates from the CRT heap,
+so nothing here touches the engine heap.
+===================
+*/
+dword AsyncReadThread( void *parms ) {
+	while( 1 ) {
+		Sys_EnterCriticalSection();
+		asyncRead_t *read = fileSystemLocal.asyncReads;
+		if ( !read ) {
+			Sys_LeaveCriticalSection();
+			Sys_WaitForEvent( TRIGGER_EVENT_ONE );
+			continue;
+		}
+		// remove this from the queue
+		fileSystemLocal.asyncReads = read->next;
+		if ( !fileSystemLocal.asyncReads ) {
+			fileSystemLocal.asyncReadsTail = NULL;
+		}
+		Sys_LeaveCriticalSection();
+
+		read->next = NULL;
+
+		int numRead = read->write ? idFileSystemLocal::WriteAsyncData( read ) : idFileSystemLocal::ReadAsyncData( read );
+		if ( !read->ownsFile ) {
+			// the caller of ReadAsync or WriteAsync handles partial reads and writes
+			read->length = Max( numRead, 0 );
+		} else if ( numRead != read->length ) {
+			Sys_Printf( "AsyncReadThread: short read of %s\n", read->f->GetName() );
+		}
+
+		read->completed = true;
+		Sys_TriggerEvent( TRIGGER_EVENT_TWO );
+	}
+	return 0;
+}
+
+/*
+=================
+idFileSystemLocal::ReadAsyncData
+
+called on the async read thread, the read count is updated by the main thread when the read is finished
+=================
+*/
+int idFileSystemLocal::ReadAsyncData( asyncRead_t *read ) {
+	idFile_InZip *inZip = dynamic_cast<idFile_InZip *>( read->f );
+	if ( inZip ) {
+		return unzReadCurrentFile( inZip->z, read->buffer, read->length );
+	}
+
+	// use the low level read function, because fread may allocate memory
+#ifdef WIN32
+	return _read( static_cast<idFile_Permanent*>(read->f)->GetFilePtr()->_file, read->buffer, read->length );
+#else
+	return fread( read->buffer, 1, read->length, static_cast<idFile_Permanent*>(read->f)->GetFilePtr() );
+#endif
+}
+
+/*
+=================
+idFileSystemLocal::WriteAsyncData
+
+called on the async read thread for the writes of WriteAsync
+=================
+*/
+int idFileSystemLocal::WriteAsyncData( asyncRead_t *read ) {
+#ifdef WIN32
+	return _write( static_cast<idFile_Permanent*>(read->f)->GetFilePtr()->_file, read->buffer, read->length );
+#else
+	return fwrite( read->buffer, 1, read->length, static_cast<idFile_Permanent*>(read->f)->GetFilePtr() );
+#endif
+}
+
+/*
+=================
+idFileSystemLocal::StartAsyncReadThread
+=================
+*/
+void idFileSystemLocal::StartAsyncReadThread( void ) {
+	if ( !asyncReadThread.threadHandle ) {
+		Sys_CreateThread( (xthread_t)AsyncReadThread, NULL, THREAD_NORMAL, asyncReadThread, "asyncRead", g_threads, &g_thread_count );
+		if ( !asyncReadThread.threadHandle ) {
+			common->Warning( "idFileSystemLocal::StartAsyncReadThread: failed" );
+		}
+	}
+}
+
+/*
+=================
+idFileSystemLocal::ReadFileAsync
+=================
+*/
+asyncRead_t *idFileSystemLocal::ReadFileAsync( const char *relativePath ) {
+	asyncRead_t *read = new asyncRead_t;
+	read->next = NULL;
+	read->f = NULL;
+	read->buffer = NULL;
+	read->length = -1;
+	read->timestamp = FILE_NOT_FOUND_TIMESTAMP;
+	read->ownsFile = true;
+	read->write = false;
+	read->completed = false;
+
+	numAsyncReads++;
+
+	// journalled files and reads without the thread go through ReadFile
+	if ( !fs_asyncRead.GetBool() || !asyncReadThread.threadHandle || ( eventLoop && eventLoop->JournalLevel() != 0 ) ) {
+		read->length = ReadFile( relativePath, &read->buffer, &read->timestamp );
+		read->completed = true;
+		return read;
+	}
+
+	read->f = OpenFileRead( relativePath );
+	if ( !read->f ) {
+		read->completed = true;
+		return read;
+	}
+
+	read->length = read->f->Length();
+	read->timestamp = read->f->Timestamp();
+
+	// the allocation is done here, the engine heap isn't thread safe
+	read->buffer = Mem_ClearedAlloc( read->length + 1 );
+	loadCount++;
+	loadStack++;
+
+	QueueAsyncRead( read );
+
+	return read;
+}
+
+/*
+=================
+idFileSystemLocal::ReadAsync
+=================
+*/
+asyncRead_t *idFileSystemLocal::ReadAsync( idFile *f, void *buffer, int length ) {
+	asyncRead_t *read = new asyncRead_t;
+	read->next = NULL;
+	read->f = f;
+	read->buffer = buffer;
+	read->length = length;
+	read->timestamp = f->Timestamp();
+	read->ownsFile = false;
+	read->write = false;
+	read->completed = false;
+
+	numAsyncReads++;
+
+	if ( !fs_asyncRead.GetBool() || !asyncReadThread.threadHandle || ( eventLoop && eventLoop->JournalLevel() != 0 ) ) {
+		read->length = Max( f->Read( buffer, length ), 0 );
+		read->f = NULL;		// counted by the read
+		read->completed = true;
+		return read;
+	}
+
+	QueueAsyncRead( read );
+
+	return read;
+}
+
+/*
+=================
+idFileSystemLocal::WriteAsync
+=================
+*/
+asyncRead_t *idFileSystemLocal::WriteAsync( idFile *f, const void *buffer, int length ) {
+	asyncRead_t *read = new asyncRead_t;
+	read->next = NULL;
+	read->f = f;
+	read->buffer = const_cast<void *>( buffer );
+	read->length = length;
+	read->timestamp = FILE_NOT_FOUND_TIMESTAMP;
+	read->ownsFile = false;
+	read->write = true;
+	read->completed = false;
+
+	numAsyncReads++;
+
+	if ( !fs_asyncRead.GetBool() || !asyncReadThread.threadHandle || !dynamic_cast<idFile_Permanent *>( f ) || ( eventLoop && eventLoop->JournalLevel() != 0 ) ) {
+		read->length = Max( f->Write( buffer, length ), 0 );
+		read->completed = true;
+		return read;
+	}
+
+	// the thread writes past the stdio buffer on windows
+	f->Flush();
+
+	QueueAsyncRead( read );
+
+	return read;
+}
+
+/*
+=================
+idFileSystemLocal::QueueAsyncRead
+=================
+*/
+void idFileSystemLocal::QueueAsyncRead( asyncRead_t *read ) {
+	Sys_EnterCriticalSection();
+	if ( asyncReadsTail ) {
+		asyncReadsTail->next = read;
+	} else {
+		asyncReads = read;
+	}
+	asyncReadsTail = read;
+	Sys_TriggerEvent( TRIGGER_EVENT_ONE );
+	Sys_LeaveCriticalSection();
+}
+
+/*
+=================
+idFileSystemLocal::IsReadFileAsyncDone
+=================
+*/
+bool idFileSystemLocal::IsReadFileAsyncDone( const asyncRead_t *read ) const {
+	return read->completed;
+}
+
+/*
+=================
+idFileSystemLocal::FinishReadFileAsync
+=================
+*/
+int idFileSystemLocal::FinishReadFileAsync( asyncRead_t *read, void **buffer, ID_TIME_T *timestamp ) {
+	// the event is raised after every read, a stale one just takes another turn
+	while ( !read->completed ) {
+		Sys_WaitForEvent( TRIGGER_EVENT_TWO );
+	}
+
+	if ( read->f && !read->write ) {
+		AddToReadCount( read->length );
+		if ( read->ownsFile ) {
+			CloseFile( read->f );
+		}
+	}
+
+	if ( !read->ownsFile ) {
+		int length = read->length;
+		delete read;
+		numAsyncReads--;
+		return length;
+	}
+
+	int length = read->length;
+	if ( timestamp ) {
+		*timestamp = read->timestamp;
+	}
+	if ( buffer ) {
+		*buffer = read->buffer;
+	} else if ( read->buffer ) {
+		FreeFile( read->buffer );
+	}
+
+	delete read;
+	numAsyncReads--;
+
+	return length;
+}
+
 /*
 =================
 idFileSystemLocal::FindPakForFileChecksum
@@ -3368,6 +3994,9 @@ void idFileSystemLocal::ClearDirCache( void ) {
 	for( int i = 0; i < MAX_CACHED_DIRS; i++ ) {
 		dir_cache[ i ].Clear();
 	}
+
+	// a file written to a directory may have been missing before
+	ClearLookupCache();
 }
 
 /*
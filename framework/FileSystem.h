@@ -101,6 +101,9 @@ typedef struct backgroundDownload_s {
 	volatile bool		completed;
 } backgroundDownload_t;
 
+// a read started with ReadFileAsync
+typedef struct asyncRead_s asyncRead_t;
+
 // file list for directory listings
 class idFileList {
 	friend class idFileSystemLocal;
@@ -178,8 +181,29 @@ public:
 							// A 0 byte will always be appended at the end, so string ops are safe.
 							// The buffer should be considered read-only, because it may be cached for other uses.
 	virtual int				ReadFile( const char *relativePath, void **buffer, ID_TIME_T *timestamp = NULL ) = 0;
-							// Frees the memory allocated by ReadFile.
+							// Frees the memory allocated by ReadFile or ReadFileMapped.
 	virtual void			FreeFile( void *buffer ) = 0;
+							// Like ReadFile, but files which are uncompressed on disk (loose files and stored pk4 entries)
+							// are mapped into memory instead of being copied. The buffer is read-only and, unlike the
+							// buffer of ReadFile, not zero terminated. It has to be freed with FreeFile.
+	virtual int				ReadFileMapped( const char *relativePath, const void **buffer, ID_TIME_T *timestamp = NULL ) = 0;
+							// Opens a file and reads it on the async read thread, so the caller can do other work meanwhile.
+							// Zipped files are inflated on the thread as well. Every read has to be finished with
+							// FinishReadFileAsync, from the thread which started it.
+	virtual asyncRead_t *	ReadFileAsync( const char *relativePath ) = 0;
+							// Reads the next length bytes of a file opened with OpenFileRead into the buffer on the async
+							// read thread. It has to be finished with FinishReadFileAsync as well, which returns the number
+							// of bytes read and leaves the file and the buffer to the caller. The file can't be used until then.
+	virtual asyncRead_t *	ReadAsync( idFile *f, void *buffer, int length ) = 0;
+							// Writes length bytes from the buffer to a file opened with OpenFileWrite on the async read thread.
+							// It has to be finished with FinishReadFileAsync, which returns the number of bytes written and
+							// leaves the file and the buffer to the caller. Neither can be used until then.
+	virtual asyncRead_t *	WriteAsync( idFile *f, const void *buffer, int length ) = 0;
+							// Returns true once the data of an async read is available.
+	virtual bool			IsReadFileAsyncDone( const asyncRead_t *read ) const = 0;
+							// Waits for an async read and releases it. Returns like ReadFile: the length of the file
+							// or -1 if it wasn't found, the zero terminated buffer has to be freed with FreeFile.
+	virtual int				FinishReadFileAsync( asyncRead_t *read, void **buffer, ID_TIME_T *timestamp = NULL ) = 0;
 							// Writes a complete file, will create any needed subdirectories.
 							// Returns the length of the file, or -1 on failure. 
 							// greebo: By default use the mod save path to write stuff
@@ -0,0 +1,282 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+#include "precompiled_engine.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include <mutex>
+
+#define PROFILE_MAX_THREADS			32
+#define PROFILE_MAX_DEPTH			64
+#define PROFILE_EVENTS_PER_THREAD	( 1 << 16 )		// the oldest events are overwritten
+
+typedef struct {
+	const char *			name;
+	double					start;			// clock ticks
+	double					end;
+	int						depth;
+} profileEvent_t;
+
+typedef struct {
+	char					name[32];
+	int						depth;
+	const char *			openNames[PROFILE_MAX_DEPTH];
+	double					openStarts[PROFILE_MAX_DEPTH];
+	int						numEvents;		// total written, the ring holds the last PROFILE_EVENTS_PER_THREAD
+	profileEvent_t *		events;
+} profileThread_t;
+
+class idFrameProfilerLocal : public idFrameProfiler {
+public:
+							idFrameProfilerLocal( void );
+
+	virtual void			Init( void );
+	virtual void			Shutdown( void );
+	virtual void			EndFrame( void );
+
+	virtual void			BeginScope( const char *name );
+	virtual void			EndScope( void );
+
+	void					StartCapture( int frames, const char *name );
+
+private:
+	profileThread_t *		threads[PROFILE_MAX_THREADS];
+	int						numThreads;
+	std::mutex				threadLock;
+
+	double					captureStart;
+	int						captureFrames;
+	idStr					captureName;
+
+	profileThread_t *		GetThread( void );
+	void					WriteTrace( void );
+
+	static void				ProfileCapture_f( const idCmdArgs &args );
+};
+
+static idFrameProfilerLocal	frameProfilerLocal;
+idFrameProfiler *			frameProfiler = &frameProfilerLocal;
+
+static ID_THREAD_LOCAL profileThread_t *currentProfileThread;
+
+/*
+================
+idFrameProfilerLocal::idFrameProfilerLocal
+================
+*/
+idFrameProfilerLocal::idFrameProfilerLocal( void ) {
+	recording = false;
+	numThreads = 0;
+	captureStart = 0.0;
+	captureFrames = 0;
+	memset( threads, 0, sizeof( threads ) );
+}
+
+/*
+================
+idFrameProfilerLocal::Init
+================
+*/
+void idFrameProfilerLocal::Init( void ) {
+	cmdSystem->AddCommand( "profileCapture", ProfileCapture_f, CMD_FL_SYSTEM, "records the profile markers of the next frames and writes them to profiles/<name>.json in the Chrome trace format, usage: profileCapture [frames] [name]" );
+}
+
+/*
+================
+idFrameProfilerLocal::Shutdown
+
+The thread buffers are kept, the threads still reference them after a reloadEngine
+================
+*/
+void idFrameProfilerLocal::Shutdown( void ) {
+	recording = false;
+}
+
+/*
+================
+idFrameProfilerLocal::GetThread
+
+Allocates the ring buffer of a thread the first time it records a scope. The worker threads
+can't use the engine heap.
+================
+*/
+profileThread_t *idFrameProfilerLocal::GetThread( void ) {
+	if ( currentProfileThread ) {
+		return currentProfileThread;
+	}
+
+	std::lock_guard<std::mutex> lock( threadLock );
+	if ( numThreads >= PROFILE_MAX_THREADS ) {
+		return NULL;
+	}
+	profileThread_t *thread = (profileThread_t *)calloc( 1, sizeof( profileThread_t ) );
+	// threads not created by Sys_CreateThread are all called main
+	int index;
+	const char *name = Sys_GetThreadName( &index );
+	if ( index < 0 && numThreads > 0 ) {
+		idStr::snPrintf( thread->name, sizeof( thread->name ), "worker %d", numThreads );
+	} else {
+		idStr::Copynz( thread->name, name, sizeof( thread->name ) );
+	}
+	thread->events = (profileEvent_t *)malloc( PROFILE_EVENTS_PER_THREAD * sizeof( profileEvent_t ) );
+	threads[numThreads++] = thread;
+
+	currentProfileThread = thread;
+	return thread;
+}
+
+/*
+================
+idFrameProfilerLocal::BeginScope
+================
+*/
+void idFrameProfilerLocal::BeginScope( const char *name ) {
+	profileThread_t *thread = GetThread();
+	if ( thread == NULL ) {
+		return;
+	}
+	if ( thread->depth < PROFILE_MAX_DEPTH ) {
+		thread->openNames[thread->depth] = name;
+		thread->openStarts[thread->depth] = Sys_GetClockTicks();
+	}
+	thread->depth++;
+}
+
+/*
+================
+idFrameProfilerLocal::EndScope
+================
+*/
+void idFrameProfilerLocal::EndScope( void ) {
+	profileThread_t *thread = currentProfileThread;
+	if ( thread == NULL || thread->depth <= 0 ) {
+		return;
+	}
+	thread->depth--;
+	if ( thread->depth >= PROFILE_MAX_DEPTH ) {
+		return;
+	}
+	profileEvent_t &event = thread->events[thread->numEvents & ( PROFILE_EVENTS_PER_THREAD - 1 )];
+	event.name = thread->openNames[thread->depth];
+	event.start = thread->openStarts[thread->depth];
+	event.end = Sys_GetClockTicks();
+	event.depth = thread->depth;
+	thread->numEvents++;
+}
+
+/*
+================
+idFrameProfilerLocal::StartCapture
+================
+*/
+void idFrameProfilerLocal::StartCapture( int frames, const char *name ) {
+	if ( recording ) {
+		common->Printf( "a profile capture is already running\n" );
+		return;
+	}
+	captureStart = Sys_GetClockTicks();
+	captureFrames = frames;
+	captureName = name;
+	captureName.StripFileExtension();
+	recording = true;
+	common->Printf( "capturing %d frames\n", frames );
+}
+
+/*
+================
+idFrameProfilerLocal::EndFrame
+
+Called at the end of idCommonLocal::Frame, writes the trace once the frames are captured
+================
+*/
+void idFrameProfilerLocal::EndFrame( void ) {
+	if ( !recording || --captureFrames > 0 ) {
+		return;
+	}
+	recording = false;
+	WriteTrace();
+}
+
+/*
+================
+idFrameProfilerLocal::WriteTrace
+
+Writes the events of the capture as complete events of the Chrome trace format. Scopes still open
+on other threads may not have been written yet, they are left out.
+================
+*/
+void idFrameProfilerLocal::WriteTrace( void ) {
+	idStr fileName = va( "profiles/%s.json", captureName.c_str() );
+	idFile *file = fileSystem->OpenFileWrite( fileName );
+	if ( file == NULL ) {
+		common->Warning( "couldn't write %s", fileName.c_str() );
+		return;
+	}
+
+	const double usecPerTick = 1000000.0 / Sys_ClockTicksPerSecond();
+	int numEvents = 0, numLost = 0;
+
+	file->Printf( "{\"traceEvents\":[\n" );
+	file->Printf( "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"%s\"}}", GAME_NAME );
+
+	std::lock_guard<std::mutex> lock( threadLock );
+	for ( int i = 0; i < numThreads; i++ ) {
+		const profileThread_t *thread = threads[i];
+		file->Printf( ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", i, thread->name );
+
+		const int total = thread->numEvents;
+		const int first = Max( 0, total - PROFILE_EVENTS_PER_THREAD );
+		for ( int j = first; j < total; j++ ) {
+			const profileEvent_t &event = thread->events[j & ( PROFILE_EVENTS_PER_THREAD - 1 )];
+			if ( event.start < captureStart ) {
+				continue;
+			}
+			if ( j == first && first > 0 ) {
+				numLost++;
+			}
+			file->Printf( ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+				event.name, i, ( event.start - captureStart ) * usecPerTick, ( event.end - event.start ) * usecPerTick );
+			numEvents++;
+		}
+	}
+	file->Printf( "\n]}\n" );
+	fileSystem->CloseFile( file );
+
+	common->Printf( "wrote %d events of %d threads to %s\n", numEvents, numThreads, fileName.c_str() );
+	if ( numLost ) {
+		common->Printf( "the ring buffers of %d threads overflowed, their oldest events are missing\n", numLost );
+	}
+}
+
+/*
+================
+idFrameProfilerLocal::ProfileCapture_f
+================
+*/
+void idFrameProfilerLocal::ProfileCapture_f( const idCmdArgs &args ) {
+	const int frames = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 60;
+	const char *name = ( args.Argc() > 2 ) ? args.Argv( 2 ) : "capture";
+	if ( frames < 1 ) {
+		common->Printf( "usage: profileCapture [frames] [name]\n" );
+		return;
+	}
+	frameProfilerLocal.StartCapture( frames, name );
+}
@@ -0,0 +1,96 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+
+#ifndef __FRAMEPROFILER_H__
+#define __FRAMEPROFILER_H__
+
+/*
+===============================================================================
+
+	Frame profiler
+
+	Scoped markers in the engine and the game record their begin and end times
+	into a ring buffer of the thread they run on, while a capture is running.
+	profileCapture records a number of frames and writes them to
+	profiles/<name>.json in the Chrome trace event format, which can be opened
+	in chrome://tracing, Perfetto or imported into Tracy.
+
+	The markers only test a flag while no capture is running. The names must
+	be string literals, they are referenced until the capture is written.
+
+===============================================================================
+*/
+
+class idFrameProfiler {
+public:
+	virtual					~idFrameProfiler( void ) {}
+
+	virtual void			Init( void ) = 0;
+	virtual void			Shutdown( void ) = 0;
+
+							// called at the end of every common frame, ends a capture
+	virtual void			EndFrame( void ) = 0;
+
+	bool					IsRecording( void ) const { return recording; }
+
+							// called by idProfileScope
+	virtual void			BeginScope( const char *name ) = 0;
+	virtual void			EndScope( void ) = 0;
+
+protected:
+	volatile bool			recording;
+};
+
+extern idFrameProfiler *	frameProfiler;
+
+/*
+================================================
+idProfileScope
+
+Records a scope of the calling thread while a capture is running.
+================================================
+*/
+class idProfileScope {
+public:
+	idProfileScope( const char *name ) {
+		active = frameProfiler != NULL && frameProfiler->IsRecording();
+		if ( active ) {
+			frameProfiler->BeginScope( name );
+		}
+	}
+	~idProfileScope( void ) {
+		End();
+	}
+
+	// ends the scope before it goes out of scope
+	void End( void ) {
+		if ( active ) {
+			frameProfiler->EndScope();
+			active = false;
+		}
+	}
+
+private:
+	bool					active;
+};
+
+#define PROFILE_SCOPE( name )	idProfileScope profileScope( name )
+
+#endif /* !__FRAMEPROFILER_H__ */
@@ -0,0 +1,141 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+
+#include "precompiled_engine.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+/*
+================
+idLevelResidency::idLevelResidency
+================
+*/
+idLevelResidency::idLevelResidency( void ) {
+	level = 0;
+	hits = 0;
+	residencyHits = 0;
+	loads = 0;
+	keepCount = 0;
+	keepBytes = 0;
+	evictCount = 0;
+	evictBytes = 0;
+}
+
+/*
+================
+idLevelResidency::BeginLevelLoad
+================
+*/
+void idLevelResidency::BeginLevelLoad( void ) {
+	level++;
+	candidates.Clear();
+	hits = 0;
+	residencyHits = 0;
+	loads = 0;
+	keepCount = 0;
+	keepBytes = 0;
+	evictCount = 0;
+	evictBytes = 0;
+}
+
+/*
+================
+idLevelResidency::AddHit
+================
+*/
+void idLevelResidency::AddHit( int lastLevel ) {
+	hits++;
+	if ( lastLevel < level - 1 ) {
+		residencyHits++;
+	}
+}
+
+/*
+================
+idLevelResidency::AddLoads
+================
+*/
+void idLevelResidency::AddLoads( int count ) {
+	loads += count;
+}
+
+/*
+================
+idLevelResidency::AddCandidate
+================
+*/
+void idLevelResidency::AddCandidate( int index, int bytes, int lastLevel ) {
+	residencyCandidate_t &candidate = candidates.Alloc();
+	candidate.index = index;
+	candidate.bytes = bytes;
+	candidate.lastLevel = lastLevel;
+}
+
+/*
+================
+idLevelResidency::SortByRecentUse
+
+Most recently used first, the smaller ones first within a level so more of them fit
+================
+*/
+int idLevelResidency::SortByRecentUse( const residencyCandidate_t *a, const residencyCandidate_t *b ) {
+	if ( a->lastLevel != b->lastLevel ) {
+		return b->lastLevel - a->lastLevel;
+	}
+	return a->bytes - b->bytes;
+}
+
+/*
+================
+idLevelResidency::SelectEvictions
+================
+*/
+void idLevelResidency::SelectEvictions( float budgetMegs, idList<int> &evictions ) {
+	const int budget = budgetMegs * 1024 * 1024;
+
+	evictions.Clear();
+	candidates.Sort( SortByRecentUse );
+
+	for ( int i = 0; i < candidates.Num(); i++ ) {
+		const residencyCandidate_t &candidate = candidates[i];
+
+		if ( keepBytes + candidate.bytes <= budget ) {
+			keepCount++;
+			keepBytes += candidate.bytes;
+		} else {
+			evictCount++;
+			evictBytes += candidate.bytes;
+			evictions.Append( candidate.index );
+		}
+	}
+
+	candidates.Clear();
+}
+
+/*
+================
+idLevelResidency::Print
+================
+*/
+void idLevelResidency::Print( const char *type ) const {
+	common->Printf( "%5i %s resident (%i kept from earlier levels), %i loaded, %i unused kept (%i kB), %i evicted (%i kB)\n",
+		hits, type, residencyHits, loads, keepCount, keepBytes >> 10, evictCount, evictBytes >> 10 );
+}
@@ -0,0 +1,86 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+
+#ifndef __LEVELRESIDENCY_H__
+#define __LEVELRESIDENCY_H__
+
+/*
+===============================================================================
+
+	Level residency
+
+	Keeps assets of earlier maps loaded across map loads, so a campaign that
+	returns to textures, models and sounds of a map before the last one does
+	not read them again. The image, model and sound managers each own one.
+
+	Every asset remembers the last level that referenced it. At the end of a
+	level load the assets the new level did not reference are offered as
+	candidates, the ones used most recently are kept as long as they fit into
+	the budget of the asset type and the rest are evicted.
+
+	The hits and loads of the level are counted as well, a hit is an asset
+	that was still resident when the level referenced it. Hits on assets the
+	previous level didn't use are the ones only the residency kept around.
+
+===============================================================================
+*/
+
+class idLevelResidency {
+public:
+							idLevelResidency( void );
+
+							// starts a new level, the level numbers of the assets referenced from now on
+	void					BeginLevelLoad( void );
+	int						GetLevel( void ) const { return level; }
+
+							// an asset referenced for the first time this level, lastLevel is the level that referenced it before
+	void					AddHit( int lastLevel );
+	void					AddLoads( int count );
+
+							// an asset this level didn't reference which is still loaded
+	void					AddCandidate( int index, int bytes, int lastLevel );
+							// keeps the most recently used candidates that fit into budgetMegs, the
+							// others are returned for eviction and the candidates are cleared
+	void					SelectEvictions( float budgetMegs, idList<int> &evictions );
+
+	void					Print( const char *type ) const;
+
+private:
+	typedef struct residencyCandidate_s {
+		int					index;
+		int					bytes;
+		int					lastLevel;
+	} residencyCandidate_t;
+
+	int						level;
+	idList<residencyCandidate_t> candidates;
+
+	int						hits;
+	int						residencyHits;		// hits on assets the previous level didn't reference
+	int						loads;
+	int						keepCount;
+	int						keepBytes;
+	int						evictCount;
+	int						evictBytes;
+
+	static int				SortByRecentUse( const residencyCandidate_t *a, const residencyCandidate_t *b );
+};
+
+#endif /* !__LEVELRESIDENCY_H__ */
@@ -0,0 +1,246 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+#include "precompiled_engine.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+idCVar com_loadProfile( "com_loadProfile", "0", CVAR_SYSTEM | CVAR_INTEGER | CVAR_NOCHEAT, "profile the decls, images, models and sounds loaded by a map load, prints the given number of most expensive ones and writes loadprofile/<mapname>.tsv", 0, 1000 );
+
+idLoadProfiler loadProfiler;
+
+/*
+================
+idLoadProfiler::idLoadProfiler
+================
+*/
+idLoadProfiler::idLoadProfiler( void ) {
+	active = false;
+	depth = 0;
+}
+
+/*
+================
+idLoadProfiler::Clear
+================
+*/
+void idLoadProfiler::Clear( void ) {
+	entries.Clear();
+	entryHash.Free();
+	depth = 0;
+}
+
+/*
+================
+idLoadProfiler::BeginLevelLoad
+================
+*/
+void idLoadProfiler::BeginLevelLoad( void ) {
+	Clear();
+	active = com_loadProfile.GetInteger() > 0;
+}
+
+/*
+================
+idLoadProfiler::EndLevelLoad
+================
+*/
+void idLoadProfiler::EndLevelLoad( const char *mapName ) {
+	if ( !active ) {
+		return;
+	}
+	active = false;
+
+	Print( mapName );
+	WriteReport( mapName );
+	Clear();
+}
+
+/*
+================
+idLoadProfiler::PushScope
+================
+*/
+void idLoadProfiler::PushScope( void ) {
+	if ( depth < LOAD_PROFILE_MAX_DEPTH ) {
+		childTime[depth] = 0.0;
+	}
+	depth++;
+}
+
+/*
+================
+idLoadProfiler::PopScope
+================
+*/
+void idLoadProfiler::PopScope( const char *type, const char *name, double msec, int bytes ) {
+	depth--;
+
+	double nested = ( depth < LOAD_PROFILE_MAX_DEPTH ) ? childTime[depth] : 0.0;
+	if ( depth > 0 && depth <= LOAD_PROFILE_MAX_DEPTH ) {
+		childTime[depth - 1] += msec;
+	}
+
+	loadProfileEntry_t &entry = entries[FindOrAddEntry( type, name )];
+	entry.count++;
+	entry.time += msec;
+	entry.selfTime += msec - nested;
+	entry.bytes += bytes;
+}
+
+/*
+================
+idLoadProfiler::FindOrAddEntry
+================
+*/
+int idLoadProfiler::FindOrAddEntry( const char *type, const char *name ) {
+	int key = entryHash.GenerateKey( name, false );
+
+	for ( int i = entryHash.First( key ); i != -1; i = entryHash.Next( i ) ) {
+		if ( entries[i].type.Cmp( type ) == 0 && entries[i].name.Icmp( name ) == 0 ) {
+			return i;
+		}
+	}
+
+	loadProfileEntry_t entry;
+	entry.type = type;
+	entry.name = name;
+	entry.count = 0;
+	entry.time = 0.0;
+	entry.selfTime = 0.0;
+	entry.bytes = 0;
+
+	int index = entries.Append( entry );
+	entryHash.Add( key, index );
+	return index;
+}
+
+/*
+================
+idLoadProfiler::SortBySelfTime
+================
+*/
+int idLoadProfiler::SortBySelfTime( const loadProfileEntry_t * const *a, const loadProfileEntry_t * const *b ) {
+	if ( (*a)->selfTime > (*b)->selfTime ) {
+		return -1;
+	}
+	if ( (*a)->selfTime < (*b)->selfTime ) {
+		return 1;
+	}
+	return 0;
+}
+
+/*
+================
+idLoadProfiler::SortByName
+================
+*/
+int idLoadProfiler::SortByName( const loadProfileEntry_t * const *a, const loadProfileEntry_t * const *b ) {
+	int c = (*a)->type.Cmp( (*b)->type );
+	if ( c != 0 ) {
+		return c;
+	}
+	return (*a)->name.Icmp( (*b)->name );
+}
+
+/*
+================
+idLoadProfiler::Print
+
+The totals per type also go to a running perfSuite
+================
+*/
+void idLoadProfiler::Print( const char *mapName ) const {
+	int i, j;
+	idList<const loadProfileEntry_t *> sorted;
+
+	sorted.SetNum( entries.Num() );
+	for ( i = 0; i < entries.Num(); i++ ) {
+		sorted[i] = &entries[i];
+	}
+	sorted.Sort( SortBySelfTime );
+
+	int numShown = Min( com_loadProfile.GetInteger(), sorted.Num() );
+
+	common->Printf( "------------ Load Profile ------------\n" );
+	common->Printf( "%9s %9s %6s %8s  %-10s %s\n", "self msec", "msec", "refs", "KB", "type", "name" );
+	for ( i = 0; i < numShown; i++ ) {
+		const loadProfileEntry_t &entry = *sorted[i];
+		common->Printf( "%9.1f %9.1f %6d %8d  %-10s %s\n", entry.selfTime, entry.time, entry.count, entry.bytes >> 10, entry.type.c_str(), entry.name.c_str() );
+	}
+
+	// totals per type, the self times add up to the time spent loading assets of the type
+	idStrList types;
+	for ( i = 0; i < entries.Num(); i++ ) {
+		types.AddUnique( entries[i].type );
+	}
+	types.Sort();
+
+	common->Printf( "%9s %6s %8s  %s\n", "self msec", "assets", "KB", "type" );
+	for ( i = 0; i < types.Num(); i++ ) {
+		double selfTime = 0.0;
+		int numAssets = 0;
+		int bytes = 0;
+
+		for ( j = 0; j < entries.Num(); j++ ) {
+			if ( entries[j].type == types[i] ) {
+				selfTime += entries[j].selfTime;
+				numAssets++;
+				bytes += entries[j].bytes;
+			}
+		}
+		common->Printf( "%9.1f %6d %8d  %s\n", selfTime, numAssets, bytes >> 10, types[i].c_str() );
+		perfSuite->AddResult( va( "load/%s", mapName ), va( "%s selfMsec", types[i].c_str() ), selfTime );
+	}
+}
+
+/*
+================
+idLoadProfiler::WriteReport
+================
+*/
+void idLoadProfiler::WriteReport( const char *mapName ) const {
+	idStr fileName = "loadprofile/";
+	fileName += mapName;
+	fileName.StripFileExtension();
+	fileName.SetFileExtension( "tsv" );
+
+	idFile *f = fileSystem->OpenFileWrite( fileName );
+	if ( !f ) {
+		common->Warning( "Couldn't write %s", fileName.c_str() );
+		return;
+	}
+
+	idList<const loadProfileEntry_t *> sorted;
+	sorted.SetNum( entries.Num() );
+	for ( int i = 0; i < entries.Num(); i++ ) {
+		sorted[i] = &entries[i];
+	}
+	sorted.Sort( SortByName );
+
+	f->Printf( "type\tname\trefs\tmsec\tself msec\tbytes\n" );
+	for ( int i = 0; i < sorted.Num(); i++ ) {
+		const loadProfileEntry_t &entry = *sorted[i];
+		f->Printf( "%s\t%s\t%d\t%.3f\t%.3f\t%d\n", entry.type.c_str(), entry.name.c_str(), entry.count, entry.time, entry.selfTime, entry.bytes );
+	}
+
+	fileSystem->CloseFile( f );
+	common->Printf( "wrote %s\n", fileName.c_str() );
+}
@@ -0,0 +1,120 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+#ifndef __LOADPROFILER_H__
+#define __LOADPROFILER_H__
+
+/*
+===============================================================================
+
+	Load profiler
+
+	With com_loadProfile set, records the wall time and the bytes read from the
+	file system for every decl parse, image, model and sound loaded during a map
+	load. At the end of the load the most expensive assets and the totals per
+	asset type are printed, and all entries are written sorted by type and name
+	to loadprofile/<mapname>.tsv, so the files of two runs can be diffed.
+
+	Assets loading other assets (a model parsing its materials, a material
+	loading its images) are counted in both, the self time excludes the
+	nested loads.
+
+===============================================================================
+*/
+
+#define LOAD_PROFILE_MAX_DEPTH		64
+
+class idLoadProfiler {
+public:
+							idLoadProfiler( void );
+
+	void					BeginLevelLoad( void );
+	void					EndLevelLoad( const char *mapName );
+
+	bool					IsActive( void ) const { return active; }
+
+							// called by idLoadProfileScope
+	void					PushScope( void );
+	void					PopScope( const char *type, const char *name, double msec, int bytes );
+
+private:
+	typedef struct loadProfileEntry_s {
+		idStr				type;
+		idStr				name;
+		int					count;			// references, including the ones already loaded
+		double				time;			// msecs, including nested loads
+		double				selfTime;		// msecs, excluding nested loads
+		int					bytes;			// read from the file system, including nested loads
+	} loadProfileEntry_t;
+
+	bool					active;
+	idList<loadProfileEntry_t> entries;
+	idHashIndex				entryHash;
+
+	// the time spent in nested scopes of each open scope
+	double					childTime[LOAD_PROFILE_MAX_DEPTH];
+	int						depth;
+
+	void					Clear( void );
+	int						FindOrAddEntry( const char *type, const char *name );
+	void					Print( const char *mapName ) const;
+	void					WriteReport( const char *mapName ) const;
+
+	static int				SortBySelfTime( const loadProfileEntry_t * const *a, const loadProfileEntry_t * const *b );
+	static int				SortByName( const loadProfileEntry_t * const *a, const loadProfileEntry_t * const *b );
+};
+
+extern idLoadProfiler		loadProfiler;
+
+/*
+================================================
+idLoadProfileScope
+
+Records the load of one asset while it is in scope, the strings must outlive it.
+A NULL name skips the asset, for loads which may run outside the main thread.
+================================================
+*/
+class idLoadProfileScope {
+public:
+	idLoadProfileScope( const char *type, const char *name ) {
+		active = name != NULL && loadProfiler.IsActive();
+		if ( active ) {
+			this->type = type;
+			this->name = name;
+			readCount = fileSystem->GetReadCount();
+			loadProfiler.PushScope();
+			timer.Start();
+		}
+	}
+	~idLoadProfileScope( void ) {
+		if ( active ) {
+			timer.Stop();
+			loadProfiler.PopScope( type, name, timer.Milliseconds(), fileSystem->GetReadCount() - readCount );
+		}
+	}
+
+private:
+	bool					active;
+	const char *			type;
+	const char *			name;
+	int						readCount;
+	idTimer					timer;
+};
+
+#endif /* !__LOADPROFILER_H__ */
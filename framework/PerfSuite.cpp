@@ -0,0 +1,449 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+
+#include "precompiled_engine.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "../renderer/tr_local.h"
+
+#define PERF_DEFAULT_THRESHOLD		5.0f		// percent
+#define PERF_BASELINE				"baseline"
+
+typedef struct {
+	idStr					benchmark;
+	idStr					metric;
+	double					value;
+} perfResult_t;
+
+class idPerfSuiteLocal : public idPerfSuite {
+public:
+							idPerfSuiteLocal( void );
+
+	virtual void			Init( void );
+	virtual void			Shutdown( void );
+	virtual void			Frame( void );
+
+	virtual void			BeginBenchmark( void );
+	virtual void			EndBenchmark( void );
+	virtual void			AddResult( const char *benchmark, const char *metric, double value );
+
+	void					Start( const char *suiteName, const char *reportName, bool quit );
+	void					Stop( void );
+
+private:
+	idStr					suite;
+	idStr					report;
+	bool					quitWhenDone;
+	idStrList				commands;
+	int						nextCommand;
+	int						waitFrames;
+	int						numBenchmarks;		// started and not finished yet
+	int						startTime;
+	idList<perfResult_t>	results;
+
+	void					WriteReport( void ) const;
+
+	static int				FindResult( const idList<perfResult_t> &list, const char *benchmark, const char *metric );
+	static bool				ReadReport( const char *reportName, idList<perfResult_t> &list );
+	static void				Compare( const char *reportName, const char *baselineName, float threshold );
+
+	static void				PerfSuite_f( const idCmdArgs &args );
+	static void				PerfCompare_f( const idCmdArgs &args );
+};
+
+static idPerfSuiteLocal		perfSuiteLocal;
+idPerfSuite *				perfSuite = &perfSuiteLocal;
+
+/*
+================
+idPerfSuiteLocal::idPerfSuiteLocal
+================
+*/
+idPerfSuiteLocal::idPerfSuiteLocal( void ) {
+	running = false;
+	quitWhenDone = false;
+	nextCommand = 0;
+	waitFrames = 0;
+	numBenchmarks = 0;
+	startTime = 0;
+}
+
+/*
+================
+idPerfSuiteLocal::Init
+================
+*/
+void idPerfSuiteLocal::Init( void ) {
+	cmdSystem->AddCommand( "perfSuite", PerfSuite_f, CMD_FL_SYSTEM, "runs the commands of perf/<suite>.suite and writes what their benchmarks measure to perf/<report>.json, usage: perfSuite <suite> [report] [quit] or perfSuite stop" );
+	cmdSystem->AddCommand( "perfCompare", PerfCompare_f, CMD_FL_SYSTEM, "lists the results of perf/<report>.json that differ from a baseline report by more than a threshold, usage: perfCompare <report> [baseline] [threshold percent]" );
+}
+
+/*
+================
+idPerfSuiteLocal::Shutdown
+================
+*/
+void idPerfSuiteLocal::Shutdown( void ) {
+	running = false;
+	commands.Clear();
+	results.Clear();
+}
+
+/*
+================
+idPerfSuiteLocal::Start
+================
+*/
+void idPerfSuiteLocal::Start( const char *suiteName, const char *reportName, bool quit ) {
+	if ( running ) {
+		common->Printf( "A perf suite is already running, use 'perfSuite stop' first.\n" );
+		return;
+	}
+
+	char *buffer = NULL;
+	idStr fileName = va( "perf/%s", suiteName );
+	fileName.DefaultFileExtension( ".suite" );
+	if ( fileSystem->ReadFile( fileName, (void **)&buffer ) < 0 || buffer == NULL ) {
+		common->Printf( "Couldn't read %s\n", fileName.c_str() );
+		return;
+	}
+
+	// one command per line, // starts a comment
+	commands.Clear();
+	idStr text = buffer;
+	fileSystem->FreeFile( buffer );
+	int lineStart = 0;
+	while ( lineStart < text.Length() ) {
+		int lineEnd = text.Find( '\n', lineStart );
+		if ( lineEnd < 0 ) {
+			lineEnd = text.Length();
+		}
+		idStr line = text.Mid( lineStart, lineEnd - lineStart );
+		lineStart = lineEnd + 1;
+
+		int comment = line.Find( "//" );
+		if ( comment >= 0 ) {
+			line.CapLength( comment );
+		}
+		line.StripLeading( ' ' );
+		line.StripLeading( '\t' );
+		line.StripTrailingWhitespace();
+		if ( line.Length() ) {
+			commands.Append( line );
+		}
+	}
+
+	suite = suiteName;
+	suite.StripFileExtension();
+	report = reportName;
+	report.StripFileExtension();
+	quitWhenDone = quit;
+	nextCommand = 0;
+	waitFrames = 0;
+	numBenchmarks = 0;
+	startTime = Sys_Milliseconds();
+	results.Clear();
+	running = true;
+
+	common->Printf( "perf suite %s: %d commands\n", suite.c_str(), commands.Num() );
+}
+
+/*
+================
+idPerfSuiteLocal::Stop
+
+Writes what has been measured so far
+================
+*/
+void idPerfSuiteLocal::Stop( void ) {
+	if ( !running ) {
+		return;
+	}
+	running = false;
+
+	WriteReport();
+
+	if ( report.Icmp( PERF_BASELINE ) != 0 && fileSystem->ReadFile( "perf/" PERF_BASELINE ".json", NULL, NULL ) > 0 ) {
+		Compare( report, PERF_BASELINE, PERF_DEFAULT_THRESHOLD );
+	}
+
+	commands.Clear();
+	results.Clear();
+
+	if ( quitWhenDone ) {
+		cmdSystem->BufferCommandText( CMD_EXEC_APPEND, "quit\n" );
+	}
+}
+
+/*
+================
+idPerfSuiteLocal::Frame
+
+Buffers the next command once the benchmarks of the previous ones have finished,
+"wait <frames>" is handled here so it doesn't hold up the suite's own checks
+================
+*/
+void idPerfSuiteLocal::Frame( void ) {
+	if ( !running || numBenchmarks > 0 ) {
+		return;
+	}
+	if ( waitFrames > 0 ) {
+		waitFrames--;
+		return;
+	}
+	if ( nextCommand >= commands.Num() ) {
+		Stop();
+		return;
+	}
+
+	const idStr &command = commands[nextCommand++];
+	idCmdArgs args( command, false );
+	if ( idStr::Icmp( args.Argv( 0 ), "wait" ) == 0 ) {
+		waitFrames = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 1;
+		return;
+	}
+
+	common->Printf( "perf suite %s (%d/%d): %s\n", suite.c_str(), nextCommand, commands.Num(), command.c_str() );
+	cmdSystem->BufferCommandText( CMD_EXEC_APPEND, va( "%s\n", command.c_str() ) );
+}
+
+/*
+================
+idPerfSuiteLocal::BeginBenchmark
+================
+*/
+void idPerfSuiteLocal::BeginBenchmark( void ) {
+	if ( running ) {
+		numBenchmarks++;
+	}
+}
+
+/*
+================
+idPerfSuiteLocal::EndBenchmark
+================
+*/
+void idPerfSuiteLocal::EndBenchmark( void ) {
+	if ( numBenchmarks > 0 ) {
+		numBenchmarks--;
+	}
+}
+
+/*
+================
+idPerfSuiteLocal::AddResult
+================
+*/
+void idPerfSuiteLocal::AddResult( const char *benchmark, const char *metric, double value ) {
+	if ( !running ) {
+		return;
+	}
+	int index = FindResult( results, benchmark, metric );
+	if ( index < 0 ) {
+		perfResult_t &result = results.Alloc();
+		result.benchmark = benchmark;
+		result.metric = metric;
+		index = results.Num() - 1;
+	}
+	results[index].value = value;
+}
+
+/*
+================
+idPerfSuiteLocal::FindResult
+================
+*/
+int idPerfSuiteLocal::FindResult( const idList<perfResult_t> &list, const char *benchmark, const char *metric ) {
+	for ( int i = 0; i < list.Num(); i++ ) {
+		if ( list[i].benchmark.Cmp( benchmark ) == 0 && list[i].metric.Cmp( metric ) == 0 ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+idPerfSuiteLocal::WriteReport
+================
+*/
+void idPerfSuiteLocal::WriteReport( void ) const {
+	idStr fileName = va( "perf/%s.json", report.c_str() );
+	idFile *f = fileSystem->OpenFileWrite( fileName );
+	if ( f == NULL ) {
+		common->Warning( "Couldn't write %s", fileName.c_str() );
+		return;
+	}
+
+	f->Printf( "{\n" );
+	f->Printf( "\t\"suite\": \"%s\",\n", suite.c_str() );
+	f->Printf( "\t\"build\": \"%s %s\",\n", BUILD_STRING, __DATE__ );
+	f->Printf( "\t\"cpu\": \"%s\",\n", Sys_GetProcessorString() );
+	f->Printf( "\t\"renderer\": \"%s\",\n", glConfig.renderer_string );
+	f->Printf( "\t\"width\": %d,\n\t\"height\": %d,\n", glConfig.vidWidth, glConfig.vidHeight );
+	f->Printf( "\t\"seconds\": %d,\n", ( Sys_Milliseconds() - startTime ) / 1000 );
+	f->Printf( "\t\"results\": [\n" );
+	for ( int i = 0; i < results.Num(); i++ ) {
+		const perfResult_t &result = results[i];
+		f->Printf( "\t\t{ \"benchmark\": \"%s\", \"metric\": \"%s\", \"value\": %.4f }%s\n",
+			result.benchmark.c_str(), result.metric.c_str(), result.value, ( i + 1 < results.Num() ) ? "," : "" );
+	}
+	f->Printf( "\t]\n" );
+	f->Printf( "}\n" );
+	fileSystem->CloseFile( f );
+
+	common->Printf( "perf suite %s: %d results in %d seconds, wrote %s\n", suite.c_str(), results.Num(), ( Sys_Milliseconds() - startTime ) / 1000, fileName.c_str() );
+}
+
+/*
+================
+idPerfSuiteLocal::ReadReport
+
+Reads the results of a report written by WriteReport, the other members are skipped
+================
+*/
+bool idPerfSuiteLocal::ReadReport( const char *reportName, idList<perfResult_t> &list ) {
+	idLexer src( LEXFL_NOFATALERRORS | LEXFL_NOSTRINGCONCAT | LEXFL_NOSTRINGESCAPECHARS );
+	if ( !src.LoadFile( va( "perf/%s.json", reportName ) ) ) {
+		common->Printf( "Couldn't read perf/%s.json\n", reportName );
+		return false;
+	}
+
+	list.Clear();
+
+	perfResult_t result;
+	int found = 0;
+	idToken token;
+	while ( src.ReadToken( &token ) ) {
+		if ( token == "{" ) {
+			found = 0;
+			continue;
+		}
+		if ( token == "}" ) {
+			if ( found == 7 ) {
+				list.Append( result );
+			}
+			found = 0;
+			continue;
+		}
+		if ( token.type != TT_STRING || !src.CheckTokenString( ":" ) ) {
+			continue;
+		}
+		if ( token == "benchmark" && src.ReadToken( &token ) ) {
+			result.benchmark = token;
+			found |= 1;
+		} else if ( token == "metric" && src.ReadToken( &token ) ) {
+			result.metric = token;
+			found |= 2;
+		} else if ( token == "value" ) {
+			result.value = src.ParseFloat();
+			found |= 4;
+		}
+	}
+	return true;
+}
+
+/*
+================
+idPerfSuiteLocal::Compare
+================
+*/
+void idPerfSuiteLocal::Compare( const char *reportName, const char *baselineName, float threshold ) {
+	idList<perfResult_t> current, baseline;
+	if ( !ReadReport( reportName, current ) || !ReadReport( baselineName, baseline ) ) {
+		return;
+	}
+
+	common->Printf( "perf/%s.json against perf/%s.json, changes over %.1f%%:\n", reportName, baselineName, threshold );
+	common->Printf( "%-32s %-40s %12s %12s %8s\n", "benchmark", "metric", "baseline", "current", "change" );
+
+	int compared = 0, worse = 0, better = 0, added = 0;
+	for ( int i = 0; i < current.Num(); i++ ) {
+		const perfResult_t &result = current[i];
+		int index = FindResult( baseline, result.benchmark, result.metric );
+		if ( index < 0 ) {
+			added++;
+			continue;
+		}
+		compared++;
+
+		const double base = baseline[index].value;
+		if ( base <= 0.0 ) {
+			continue;
+		}
+		const float change = (float)( 100.0 * ( result.value - base ) / base );
+		if ( idMath::Fabs( change ) <= threshold ) {
+			continue;
+		}
+		if ( change > 0.0f ) {
+			worse++;
+		} else {
+			better++;
+		}
+		common->Printf( "%-32s %-40s %12.3f %12.3f %s%+7.1f%%^0\n", result.benchmark.c_str(), result.metric.c_str(),
+			base, result.value, ( change > 0.0f ) ? S_COLOR_RED : S_COLOR_GREEN, change );
+	}
+
+	int missing = 0;
+	for ( int i = 0; i < baseline.Num(); i++ ) {
+		if ( FindResult( current, baseline[i].benchmark, baseline[i].metric ) < 0 ) {
+			missing++;
+		}
+	}
+
+	common->Printf( "%d results compared: %d worse, %d better, %d new, %d missing from the report\n", compared, worse, better, added, missing );
+}
+
+/*
+================
+idPerfSuiteLocal::PerfSuite_f
+================
+*/
+void idPerfSuiteLocal::PerfSuite_f( const idCmdArgs &args ) {
+	if ( args.Argc() < 2 ) {
+		common->Printf( "usage: perfSuite <suite> [report] [quit]\n" );
+		common->Printf( "       perfSuite stop\n" );
+		return;
+	}
+	if ( idStr::Icmp( args.Argv( 1 ), "stop" ) == 0 ) {
+		perfSuiteLocal.Stop();
+		return;
+	}
+	const char *reportName = ( args.Argc() > 2 ) ? args.Argv( 2 ) : args.Argv( 1 );
+	const bool quit = ( args.Argc() > 3 ) && !idStr::Icmp( args.Argv( 3 ), "quit" );
+	perfSuiteLocal.Start( args.Argv( 1 ), reportName, quit );
+}
+
+/*
+================
+idPerfSuiteLocal::PerfCompare_f
+================
+*/
+void idPerfSuiteLocal::PerfCompare_f( const idCmdArgs &args ) {
+	if ( args.Argc() < 2 ) {
+		common->Printf( "usage: perfCompare <report> [baseline] [threshold percent]\n" );
+		return;
+	}
+	const char *baselineName = ( args.Argc() > 2 ) ? args.Argv( 2 ) : PERF_BASELINE;
+	const float threshold = ( args.Argc() > 3 ) ? atof( args.Argv( 3 ) ) : PERF_DEFAULT_THRESHOLD;
+	Compare( args.Argv( 1 ), baselineName, threshold );
+}
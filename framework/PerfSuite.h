@@ -0,0 +1,70 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+
+#ifndef __PERFSUITE_H__
+#define __PERFSUITE_H__
+
+/*
+===============================================================================
+
+	Performance suite
+
+	perfSuite runs the console commands listed in perf/<suite>.suite one after
+	another. While it runs, the benchmarks report their measurements to it:
+	benchSIMD, the cm_testCollision traces, tdm_ai_benchmark, the map loads
+	(with the load profiler totals when com_loadProfile is set) and
+	benchmarkDemo. When the suite is done, they are written to
+	perf/<report>.json. A benchmark that runs over several frames holds the
+	suite until it has finished.
+
+	Lower is better for every result. perfCompare lists the results of a
+	report that differ from a stored baseline by more than a threshold. Copy a
+	report to perf/baseline.json and each finished suite is compared against
+	it.
+
+===============================================================================
+*/
+
+class idPerfSuite {
+public:
+	virtual					~idPerfSuite( void ) {}
+
+	virtual void			Init( void ) = 0;
+	virtual void			Shutdown( void ) = 0;
+
+							// called at the start of every common frame, before the command buffer runs
+	virtual void			Frame( void ) = 0;
+
+	bool					IsRunning( void ) const { return running; }
+
+							// a benchmark running over several frames started or finished
+	virtual void			BeginBenchmark( void ) = 0;
+	virtual void			EndBenchmark( void ) = 0;
+
+							// ignored unless a suite runs, replaces an earlier result of the same benchmark and metric
+	virtual void			AddResult( const char *benchmark, const char *metric, double value ) = 0;
+
+protected:
+	bool					running;
+};
+
+extern idPerfSuite *		perfSuite;
+
+#endif /* !__PERFSUITE_H__ */
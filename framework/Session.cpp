@@ -33,6 +33,7 @@ idCVar	idSessionLocal::com_minTics( "com_minTics", "1", CVAR_SYSTEM, "" );
 idCVar	idSessionLocal::com_showTics( "com_showTics", "0", CVAR_SYSTEM | CVAR_BOOL, "" );
 idCVar	idSessionLocal::com_fixedTic("com_fixedTic", "0", CVAR_SYSTEM | CVAR_ARCHIVE | CVAR_INTEGER, "", 0, 10);
 idCVar	idSessionLocal::com_asyncTic("com_asyncTic", "0", CVAR_SYSTEM | CVAR_ARCHIVE | CVAR_BOOL, "", 0, 10);
+idCVar	idSessionLocal::com_interpolateTics( "com_interpolateTics", "0", CVAR_SYSTEM | CVAR_ARCHIVE | CVAR_BOOL, "draw frames between the 60 Hz game tics, with the view and moving entities interpolated between the last two tics. Cap the frame rate with com_maxFPS or vsync" );
 idCVar	idSessionLocal::com_showDemo("com_showDemo", "0", CVAR_SYSTEM | CVAR_BOOL, "");
 idCVar	idSessionLocal::com_skipGameDraw( "com_skipGameDraw", "0", CVAR_SYSTEM | CVAR_BOOL, "" );
 idCVar	idSessionLocal::com_aviDemoSamples( "com_aviDemoSamples", "16", CVAR_SYSTEM, "" );
@@ -41,6 +42,7 @@ idCVar	idSessionLocal::com_aviDemoHeight( "com_aviDemoHeight", "256", CVAR_SYSTE
 idCVar	idSessionLocal::com_aviDemoTics( "com_aviDemoTics", "2", CVAR_SYSTEM | CVAR_INTEGER, "", 1, 60 );
 idCVar	idSessionLocal::com_wipeSeconds( "com_wipeSeconds", "1", CVAR_SYSTEM, "" );
 idCVar	idSessionLocal::com_guid( "com_guid", "", CVAR_SYSTEM | CVAR_ARCHIVE | CVAR_ROM, "" );
+idCVar	idSessionLocal::com_showLoadStages( "com_showLoadStages", "0", CVAR_SYSTEM | CVAR_BOOL, "print the time each stage of the map load takes" );
 
 //Obsttorte
 idCVar	idSessionLocal::saveGameName( "saveGameName", "", CVAR_GAME | CVAR_ROM, "");
@@ -48,6 +50,8 @@ idCVar	idSessionLocal::saveGameName( "saveGameName", "", CVAR_GAME | CVAR_ROM, "
 // SteveL #4161: Support > 1 quicksave
 idCVar	idSessionLocal::com_numQuickSaves( "com_numQuickSaves", "2", CVAR_GAME | CVAR_NOCHEAT | CVAR_INTEGER | CVAR_ARCHIVE, 
 	"How many quicksaves to retain. Reducing the number won't delete any that you already have.", 1.0f, 100000.0f );
+idCVar	idSessionLocal::com_asyncSaveGames( "com_asyncSaveGames", "1", CVAR_SYSTEM | CVAR_BOOL | CVAR_ARCHIVE, "save games into memory and write them to disk on the async read thread while the game goes on" );
+idCVar	idSessionLocal::com_benchmarkHitchMsec( "com_benchmarkHitchMsec", "50", CVAR_SYSTEM | CVAR_INTEGER, "frames of a benchmarkDemo that take longer than this are counted as hitches" );
 
 idSessionLocal		sessLocal;
 idSession			*session = &sessLocal;
@@ -281,6 +285,10 @@ void idSessionLocal::Clear() {
 	guiActive = NULL;
 	aviCaptureMode = false;
 	timeDemo = TD_NO;
+	benchmarkRuns = 0;
+	benchmarkRun = 0;
+	benchmarkQuit = false;
+	benchmarkFrameTicks = 0.0;
 	waitingOnBind = false;
 	lastPacifierTime = 0;
 	
@@ -310,6 +318,10 @@ idSessionLocal::idSessionLocal() {
 	guiInGame = guiMainMenu = guiRestartMenu = guiLoading = guiActive = guiTest = guiMsg = guiMsgRestore = NULL;	
 
 	menuSoundWorld = NULL;
+
+	saveGameWriteFile = NULL;
+	saveGameWriteBuffer = NULL;
+	saveGameWrite = NULL;
 	
 	Clear();
 }
@@ -360,6 +372,8 @@ idSessionLocal::Shutdown
 void idSessionLocal::Shutdown() {
 	int i;
 
+	FinishSaveGameWrite( true );
+
 	if ( aviCaptureMode ) {
 		EndAVICapture();
 	}
@@ -620,6 +634,22 @@ static void Session_TimeDemoQuit_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+================
+Session_BenchmarkDemo_f
+================
+*/
+static void Session_BenchmarkDemo_f( const idCmdArgs &args ) {
+	if ( args.Argc() < 2 ) {
+		common->Printf( "usage: benchmarkDemo <demo> [runs] [report name] [quit]\n" );
+		return;
+	}
+	const int runs = ( args.Argc() > 2 ) ? atoi( args.Argv( 2 ) ) : 3;
+	const char *report = ( args.Argc() > 3 ) ? args.Argv( 3 ) : args.Argv( 1 );
+	const bool quit = ( args.Argc() > 4 ) && !idStr::Icmp( args.Argv( 4 ), "quit" );
+	sessLocal.StartBenchmark( va( "demos/%s", args.Argv( 1 ) ), runs, report, quit );
+}
+
 /*
 ================
 Session_AVIDemo_f
@@ -799,7 +829,12 @@ void idSessionLocal::StopPlayingRenderDemo() {
 		idStr	message = va( "%i frames rendered in %3.1f seconds = %3.1f fps\n", numDemoFrames, demoSeconds, demoFPS );
 
 		common->Printf( message );
-		if ( timeDemo == TD_YES_THEN_QUIT ) {
+		if ( benchmarkRuns > 0 ) {
+			// the next run is started from Frame, the report is written after the last one
+			if ( ++benchmarkRun >= benchmarkRuns ) {
+				WriteBenchmarkReport();
+			}
+		} else if ( timeDemo == TD_YES_THEN_QUIT ) {
 			cmdSystem->BufferCommandText( CMD_EXEC_APPEND, "quit\n" );
 		} else {
 			soundSystem->SetMute( true );
@@ -918,6 +953,219 @@ void idSessionLocal::TimeRenderDemo( const char *demoName, bool twice ) {
 	timeDemo = TD_YES;
 }
 
+// GPU times of the benchmark, summed over the timed back end frames
+static int		benchmarkGpuFrameCount;
+static int		benchmarkGpuFrames;
+static float	benchmarkGpuMsec[NUM_GPU_TIMES];
+
+/*
+================
+idSessionLocal::StartBenchmark
+
+Times a demo several times in a row and writes the frame times of all runs to
+benchmarks/<reportName>.csv and a summary with percentiles to benchmarks/<reportName>.json
+================
+*/
+void idSessionLocal::StartBenchmark( const char *demoName, int runs, const char *reportName, bool quit ) {
+	if ( runs < 1 ) {
+		common->Printf( "idSessionLocal::StartBenchmark: needs at least one run\n" );
+		return;
+	}
+	benchmarkDemo = demoName;
+	benchmarkReport = reportName;
+	benchmarkReport.StripFileExtension();
+	benchmarkRuns = runs;
+	benchmarkRun = 0;
+	benchmarkQuit = quit;
+	benchmarkFrames.Clear();
+	benchmarkFrames.SetGranularity( 4096 );
+	benchmarkGpuFrameCount = 0;
+	benchmarkGpuFrames = 0;
+	memset( benchmarkGpuMsec, 0, sizeof( benchmarkGpuMsec ) );
+	gpuTimesRequested = true;
+	perfSuite->BeginBenchmark();
+}
+
+/*
+================
+idSessionLocal::RunBenchmark
+
+Starts the next run of a benchmark, the first one plays the demo once more before to precache everything
+================
+*/
+void idSessionLocal::RunBenchmark() {
+	common->Printf( "benchmark run %d of %d\n", benchmarkRun + 1, benchmarkRuns );
+	TimeRenderDemo( benchmarkDemo, benchmarkRun == 0 );
+	if ( !readDemo ) {
+		common->Printf( "benchmark of %s aborted\n", benchmarkDemo.c_str() );
+		benchmarkRuns = 0;
+		benchmarkFrames.Clear();
+		gpuTimesRequested = false;
+		perfSuite->EndBenchmark();
+		return;
+	}
+	benchmarkFrameTicks = Sys_GetClockTicks();
+}
+
+/*
+================
+idSessionLocal::RecordBenchmarkFrame
+
+Called at the end of UpdateScreen with the com_speeds times of the frame
+================
+*/
+void idSessionLocal::RecordBenchmarkFrame() {
+	const double ticks = Sys_GetClockTicks();
+
+	benchmarkFrame_t &frame = benchmarkFrames.Alloc();
+	frame.run = benchmarkRun;
+	frame.frameMsec = (float)( ( ticks - benchmarkFrameTicks ) * 1000.0 / Sys_ClockTicksPerSecond() );
+	frame.gameMsec = time_gameFrame;
+	frame.frontEndMsec = time_frontend;
+	frame.backEndMsec = time_backend;
+
+	// the GPU times trail the frames, each timed back end frame is counted once in the summary
+	const gpuTimes_t gpu = gpuTimes;
+	frame.gpuMsec = gpu.totalMsec;
+	if ( gpu.frameCount != benchmarkGpuFrameCount ) {
+		benchmarkGpuFrameCount = gpu.frameCount;
+		benchmarkGpuFrames++;
+		for ( int i = 0; i < NUM_GPU_TIMES; i++ ) {
+			benchmarkGpuMsec[i] += gpu.msec[i];
+		}
+	}
+
+	benchmarkFrameTicks = ticks;
+	if ( !com_speeds.GetBool() ) {
+		// com_speeds clears it in idCommonLocal::Frame
+		time_gameFrame = 0;
+	}
+}
+
+static int BenchmarkCompareFloat( const float *a, const float *b ) {
+	return ( *a < *b ) ? -1 : ( ( *a > *b ) ? 1 : 0 );
+}
+
+/*
+================
+BenchmarkPercentile
+
+nearest rank of a sorted list
+================
+*/
+static float BenchmarkPercentile( const idList<float> &sorted, float percent ) {
+	if ( sorted.Num() == 0 ) {
+		return 0.0f;
+	}
+	const int rank = idMath::Ftoi( ceil( percent * 0.01f * sorted.Num() ) ) - 1;
+	return sorted[ idMath::ClampInt( 0, sorted.Num() - 1, rank ) ];
+}
+
+/*
+================
+idSessionLocal::WriteBenchmarkReport
+================
+*/
+void idSessionLocal::WriteBenchmarkReport() {
+	const int hitchMsec = com_benchmarkHitchMsec.GetInteger();
+	const int numFrames = benchmarkFrames.Num();
+
+	idFile *csv = fileSystem->OpenFileWrite( va( "benchmarks/%s.csv", benchmarkReport.c_str() ) );
+	if ( csv ) {
+		csv->Printf( "run,frame,frameMsec,gameMsec,frontEndMsec,backEndMsec,gpuMsec\n" );
+		for ( int i = 0, frame = 0; i < numFrames; i++, frame++ ) {
+			const benchmarkFrame_t &f = benchmarkFrames[i];
+			if ( i > 0 && f.run != benchmarkFrames[i - 1].run ) {
+				frame = 0;
+			}
+			csv->Printf( "%d,%d,%.3f,%d,%d,%d,%.3f\n", f.run + 1, frame, f.frameMsec, f.gameMsec, f.frontEndMsec, f.backEndMsec, f.gpuMsec );
+		}
+		fileSystem->CloseFile( csv );
+	}
+
+	// the summary covers all runs, the fps is also given per run to show the spread between them
+	idList<float> sorted;
+	sorted.SetNum( numFrames );
+	float totalMsec = 0.0f;
+	int hitches = 0;
+	int gameMsec = 0, frontEndMsec = 0, backEndMsec = 0;
+	for ( int i = 0; i < numFrames; i++ ) {
+		const benchmarkFrame_t &f = benchmarkFrames[i];
+		sorted[i] = f.frameMsec;
+		totalMsec += f.frameMsec;
+		if ( f.frameMsec > hitchMsec ) {
+			hitches++;
+		}
+		gameMsec += f.gameMsec;
+		frontEndMsec += f.frontEndMsec;
+		backEndMsec += f.backEndMsec;
+	}
+	sorted.Sort( BenchmarkCompareFloat );
+	const float div = ( numFrames > 0 ) ? 1.0f / numFrames : 0.0f;
+	const float p50 = BenchmarkPercentile( sorted, 50.0f );
+	const float p95 = BenchmarkPercentile( sorted, 95.0f );
+	const float p99 = BenchmarkPercentile( sorted, 99.0f );
+	const float maxMsec = ( numFrames > 0 ) ? sorted[numFrames - 1] : 0.0f;
+
+	idFile *json = fileSystem->OpenFileWrite( va( "benchmarks/%s.json", benchmarkReport.c_str() ) );
+	if ( json ) {
+		json->Printf( "{\n" );
+		json->Printf( "\t\"demo\": \"%s\",\n", benchmarkDemo.c_str() );
+		json->Printf( "\t\"renderer\": \"%s\",\n", glConfig.renderer_string );
+		json->Printf( "\t\"width\": %d,\n\t\"height\": %d,\n", glConfig.vidWidth, glConfig.vidHeight );
+		json->Printf( "\t\"runs\": %d,\n\t\"frames\": %d,\n", benchmarkRuns, numFrames );
+		json->Printf( "\t\"fps\": %.2f,\n", ( totalMsec > 0.0f ) ? numFrames * 1000.0f / totalMsec : 0.0f );
+		json->Printf( "\t\"runFps\": [" );
+		for ( int run = 0; run < benchmarkRuns; run++ ) {
+			float runMsec = 0.0f;
+			int runFrames = 0;
+			for ( int i = 0; i < numFrames; i++ ) {
+				if ( benchmarkFrames[i].run == run ) {
+					runMsec += benchmarkFrames[i].frameMsec;
+					runFrames++;
+				}
+			}
+			json->Printf( "%s%.2f", run ? ", " : " ", ( runMsec > 0.0f ) ? runFrames * 1000.0f / runMsec : 0.0f );
+		}
+		json->Printf( " ],\n" );
+		json->Printf( "\t\"frameMsec\": { \"mean\": %.3f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f },\n", totalMsec * div, p50, p95, p99, maxMsec );
+		json->Printf( "\t\"meanGameMsec\": %.3f,\n\t\"meanFrontEndMsec\": %.3f,\n\t\"meanBackEndMsec\": %.3f,\n", gameMsec * div, frontEndMsec * div, backEndMsec * div );
+		// mean GPU msecs of the back end stages, empty without GL_ARB_timer_query
+		const float gpuDiv = ( benchmarkGpuFrames > 0 ) ? 1.0f / benchmarkGpuFrames : 0.0f;
+		json->Printf( "\t\"meanGpuMsec\": {" );
+		for ( int i = 0; i < NUM_GPU_TIMES && benchmarkGpuFrames > 0; i++ ) {
+			json->Printf( "%s\"%s\": %.3f", i ? ", " : " ", gpuTimeNames[i], benchmarkGpuMsec[i] * gpuDiv );
+		}
+		json->Printf( " },\n" );
+		json->Printf( "\t\"hitchMsec\": %d,\n\t\"hitches\": %d\n", hitchMsec, hitches );
+		json->Printf( "}\n" );
+		fileSystem->CloseFile( json );
+	}
+
+	common->Printf( "benchmark of %s: %d runs, %d frames, p50 %.2f p95 %.2f p99 %.2f max %.2f msec, %d hitches over %d msec\n",
+		benchmarkDemo.c_str(), benchmarkRuns, numFrames, p50, p95, p99, maxMsec, hitches, hitchMsec );
+	common->Printf( "wrote benchmarks/%s.csv and benchmarks/%s.json\n", benchmarkReport.c_str(), benchmarkReport.c_str() );
+
+	const char *perfName = va( "demo/%s", benchmarkReport.c_str() );
+	perfSuite->AddResult( perfName, "frameMsec mean", totalMsec * div );
+	perfSuite->AddResult( perfName, "frameMsec p50", p50 );
+	perfSuite->AddResult( perfName, "frameMsec p95", p95 );
+	perfSuite->AddResult( perfName, "frameMsec p99", p99 );
+	perfSuite->AddResult( perfName, "frameMsec max", maxMsec );
+	perfSuite->AddResult( perfName, "gameMsec mean", gameMsec * div );
+	perfSuite->AddResult( perfName, "frontEndMsec mean", frontEndMsec * div );
+	perfSuite->AddResult( perfName, "backEndMsec mean", backEndMsec * div );
+	perfSuite->AddResult( perfName, "hitches", hitches );
+	perfSuite->EndBenchmark();
+
+	benchmarkRuns = 0;
+	benchmarkFrames.Clear();
+	gpuTimesRequested = false;
+	if ( benchmarkQuit ) {
+		cmdSystem->BufferCommandText( CMD_EXEC_APPEND, "quit\n" );
+	}
+}
+
 
 /*
 ================
@@ -1413,6 +1661,21 @@ void idSessionLocal::SetBytesNeededForMapLoad( const char *mapName, int bytesNee
 	}
 }
 
+/*
+===============
+idSessionLocal::LoadStageDone
+
+Prints the time since stageStart with com_showLoadStages and starts the next stage
+===============
+*/
+void idSessionLocal::LoadStageDone( const char *stage, int &stageStart ) const {
+	int now = Sys_Milliseconds();
+	if ( com_showLoadStages.GetBool() ) {
+		common->Printf( "%6d msec %s\n", now - stageStart, stage );
+	}
+	stageStart = now;
+}
+
 /*
 ===============
 idSessionLocal::ExecuteMapChange
@@ -1475,6 +1738,8 @@ void idSessionLocal::ExecuteMapChange( bool noFadeWipe ) {
 		currentMapName = fullMapName;
 	}
 
+	loadProfiler.BeginLevelLoad();
+
 	// note which media we are going to need to load
 	if ( !reloadingSameMap ) {
 		declManager->BeginLevelLoad();
@@ -1521,6 +1786,7 @@ void idSessionLocal::ExecuteMapChange( bool noFadeWipe ) {
 	} 
 	
 	int start = Sys_Milliseconds();
+	int stageStart = start;
 
 	common->Printf( "--------- Map Initialization ---------\n" );
 	common->Printf( "Map: %s\n", mapString.c_str() );
@@ -1529,6 +1795,7 @@ void idSessionLocal::ExecuteMapChange( bool noFadeWipe ) {
 	if ( !rw->InitFromMap( fullMapName ) ) {
 		common->Error( "Couldn't load %s", fullMapName.c_str() );
 	}
+	LoadStageDone( "world geometry", stageStart );
 
 	// for the synchronous networking we needed to roll the angles over from
 	// level to level, but now we can just clear everything
@@ -1556,19 +1823,24 @@ void idSessionLocal::ExecuteMapChange( bool noFadeWipe ) {
 		game->SetServerInfo( mapSpawnData.serverInfo );
 		game->InitFromNewMap( fullMapName + ".map", rw, sw, idAsyncNetwork::server.IsActive(), idAsyncNetwork::client.IsActive(), Sys_Milliseconds() );
 	}
+	LoadStageDone( "game", stageStart );
 
 	if ( !idAsyncNetwork::IsActive() && !loadingSaveGame ) {
 		// spawn players
 		for ( i = 0; i < numClients; i++ ) {
 			game->SpawnPlayer( i );
 		}
+		LoadStageDone( "players", stageStart );
 	}
 
 	// actually purge/load the media
 	if ( !reloadingSameMap ) {
 		renderSystem->EndLevelLoad();
+		LoadStageDone( "images and models", stageStart );
 		soundSystem->EndLevelLoad( mapString.c_str() );
+		LoadStageDone( "sounds", stageStart );
 		declManager->EndLevelLoad();
+		LoadStageDone( "decls", stageStart );
 		SetBytesNeededForMapLoad( mapString.c_str(), fileSystem->GetReadCount() );
 	}
 	uiManager->EndLevelLoad();
@@ -1578,12 +1850,16 @@ void idSessionLocal::ExecuteMapChange( bool noFadeWipe ) {
 		for ( i = 0; i < 10; i++ ) {
 			game->RunFrame( mapSpawnData.mapSpawnUsercmd );
 		}
+		LoadStageDone( "settle frames", stageStart );
 	}
 
 	common->Printf ("-----------------------------------\n");
 
 	int	msec = Sys_Milliseconds() - start;
 	common->Printf( "%6d msec to load %s\n", msec, mapString.c_str() );
+	perfSuite->AddResult( va( "load/%s", mapString.c_str() ), "msec", msec );
+
+	loadProfiler.EndLevelLoad( mapString.c_str() );
 
 	// let the renderSystem generate interactions now that everything is spawned
 	rw->GenerateAllInteractions();
@@ -1838,6 +2114,9 @@ bool idSessionLocal::SaveGame( const char *saveName, bool autosave, bool skipChe
 
 	gameFile = saveName; // Obsttorte: moved upwards as needed earlier
 
+	// the previous save may still be on its way to the disk
+	FinishSaveGameWrite( true );
+
 	if ( !mapSpawned ) {
 		common->Printf( "Not playing a game.\n" );
 		return false;
@@ -1915,6 +2194,16 @@ bool idSessionLocal::SaveGame( const char *saveName, bool autosave, bool skipChe
 		return false;
 	}
 
+	// save into memory, the file is written on the async read thread while the game goes on
+	static int lastSaveLength = 0;
+	idFile *saveFile = fileOut;
+	idFile_Memory *saveBuffer = NULL;
+	if ( com_asyncSaveGames.GetBool() ) {
+		saveBuffer = new idFile_Memory( gameFile );
+		saveBuffer->SetGranularity( Max( lastSaveLength + lastSaveLength / 4, 1024 * 1024 ) );
+		saveFile = saveBuffer;
+	}
+
 	// Obsttorte increment the savegame counter
 	
 	game->incrementSaveCount();
@@ -1924,26 +2213,33 @@ bool idSessionLocal::SaveGame( const char *saveName, bool autosave, bool skipChe
 
 	// game
 	const char *gamename = GAME_NAME;
-	fileOut->WriteString( gamename );
+	saveFile->WriteString( gamename );
 
 	// version
-	fileOut->WriteInt( SAVEGAME_VERSION );
+	saveFile->WriteInt( SAVEGAME_VERSION );
 
 	// map
 	mapName = mapSpawnData.serverInfo.GetString( "si_map" );
-	fileOut->WriteString( mapName );
+	saveFile->WriteString( mapName );
 
 	// persistent player info
 	for ( i = 0; i < MAX_ASYNC_CLIENTS; i++ ) {
 		mapSpawnData.persistentPlayerInfo[i] = game->GetPersistentPlayerInfo( i );
-		mapSpawnData.persistentPlayerInfo[i].WriteToFileHandle( fileOut );
+		mapSpawnData.persistentPlayerInfo[i].WriteToFileHandle( saveFile );
 	}
 
 	// let the game save its state
-	game->SaveGame( fileOut );
+	game->SaveGame( saveFile );
 
 	// close the sava game file
-	fileSystem->CloseFile( fileOut );
+	if ( saveBuffer ) {
+		lastSaveLength = saveBuffer->Length();
+		saveGameWriteFile = fileOut;
+		saveGameWriteBuffer = saveBuffer;
+		saveGameWrite = fileSystem->WriteAsync( fileOut, saveBuffer->GetDataPtr(), saveBuffer->Length() );
+	} else {
+		fileSystem->CloseFile( fileOut );
+	}
 
 	// Write screenshot
 	if ( !autosave ) {
@@ -2000,6 +2296,33 @@ bool idSessionLocal::SaveGame( const char *saveName, bool autosave, bool skipChe
 #endif
 }
 
+/*
+===============
+idSessionLocal::FinishSaveGameWrite
+
+Closes the savegame written on the async read thread once it is on the disk,
+waits for it if wait is set
+===============
+*/
+void idSessionLocal::FinishSaveGameWrite( bool wait ) {
+	if ( !saveGameWrite ) {
+		return;
+	}
+	if ( !wait && !fileSystem->IsReadFileAsyncDone( saveGameWrite ) ) {
+		return;
+	}
+
+	if ( fileSystem->FinishReadFileAsync( saveGameWrite, NULL ) != saveGameWriteBuffer->Length() ) {
+		common->Warning( "Failed to write save file '%s'", saveGameWriteFile->GetName() );
+	}
+	fileSystem->CloseFile( saveGameWriteFile );
+	delete saveGameWriteBuffer;
+
+	saveGameWrite = NULL;
+	saveGameWriteFile = NULL;
+	saveGameWriteBuffer = NULL;
+}
+
 /*
 ===============
 idSessionLocal::LoadGame
@@ -2018,6 +2341,9 @@ bool idSessionLocal::LoadGame( const char *saveName ) {
 		return false;
 	}
 
+	// the save may still be on its way to the disk
+	FinishSaveGameWrite( true );
+
 	//Hide the dialog box if it is up.
 	StopBox();
 
@@ -2567,14 +2893,21 @@ void idSessionLocal::UpdateScreen( bool outOfSequence ) {
 	// draw everything
 	Draw();
 
+	const bool benchmarking = ( timeDemo != TD_NO && benchmarkRuns > 0 );
 	if (com_speeds.GetBool()) {
 		time_backendLast = backEnd.pc.msecLast;
 		time_frontendLast = tr.pc.frontEndMsecLast;
 		renderSystem->EndFrame(&time_frontend, &time_backend);
+	} else if ( benchmarking ) {
+		renderSystem->EndFrame( &time_frontend, &time_backend );
 	} else {
 		renderSystem->EndFrame( NULL, NULL );
 	}
 
+	if ( benchmarking ) {
+		RecordBenchmarkFrame();
+	}
+
 	insideUpdateScreen = false;
 }
 
@@ -2585,10 +2918,18 @@ idSessionLocal::Frame
 */
 void idSessionLocal::Frame() {
 
+	FinishSaveGameWrite( false );
+
+	if ( benchmarkRuns > 0 && benchmarkRun < benchmarkRuns && !readDemo ) {
+		RunBenchmark();
+	}
+
 	if ( com_asyncSound.GetInteger() == 0 ) {
 		soundSystem->AsyncUpdate( Sys_Milliseconds() );
 	}
 
+	soundSystem->UpdateStreams();
+
 	// Editors that completely take over the game
 	if ( com_editorActive && ( com_editors & ( EDITOR_RADIANT | EDITOR_GUI ) ) ) {
 		return;
@@ -2657,6 +2998,10 @@ void idSessionLocal::Frame() {
 	if (com_fixedTic.GetInteger()) {
 		minTic = latchedTicNumber;
 	}
+	// the game interpolates the frames drawn while no tic is due
+	if ( com_interpolateTics.GetBool() && mapSpawned && !readDemo && !writeDemo ) {
+		minTic = latchedTicNumber;
+	}
 
 	// FIXME: deserves a cleanup and abstraction
 #if defined( _WIN32 )
@@ -2948,6 +3293,7 @@ void idSessionLocal::Init() {
 	cmdSystem->AddCommand( "playDemo", Session_PlayDemo_f, CMD_FL_SYSTEM, "plays back a demo", idCmdSystem::ArgCompletion_DemoName );
 	cmdSystem->AddCommand( "timeDemo", Session_TimeDemo_f, CMD_FL_SYSTEM, "times a demo", idCmdSystem::ArgCompletion_DemoName );
 	cmdSystem->AddCommand( "timeDemoQuit", Session_TimeDemoQuit_f, CMD_FL_SYSTEM, "times a demo and quits", idCmdSystem::ArgCompletion_DemoName );
+	cmdSystem->AddCommand( "benchmarkDemo", Session_BenchmarkDemo_f, CMD_FL_SYSTEM, "times a demo several times and writes frame time percentiles to benchmarks/", idCmdSystem::ArgCompletion_DemoName );
 	cmdSystem->AddCommand( "aviDemo", Session_AVIDemo_f, CMD_FL_SYSTEM, "writes AVIs for a demo", idCmdSystem::ArgCompletion_DemoName );
 	cmdSystem->AddCommand( "compressDemo", Session_CompressDemo_f, CMD_FL_SYSTEM, "compresses a demo file", idCmdSystem::ArgCompletion_DemoName );
 #endif
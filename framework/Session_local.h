@@ -67,6 +67,16 @@ typedef enum {
 	TD_YES_THEN_QUIT
 } timeDemo_t;
 
+// one frame of a benchmarkDemo run
+typedef struct {
+	int					run;
+	float				frameMsec;			// wall clock time since the last frame
+	int					gameMsec;
+	int					frontEndMsec;
+	int					backEndMsec;		// includes waiting on the GPU with r_finish
+	float				gpuMsec;			// of the latest back end frame the GPU timestamps came back for
+} benchmarkFrame_t;
+
 const int USERCMD_PER_DEMO_FRAME	= 2;
 const int CONNECT_TRANSMIT_TIME		= 1000;
 const int MAX_LOGGED_USERCMDS		= 60*60*60;	// one hour of single player, 15 minutes of four player
@@ -135,6 +145,7 @@ public:
 
 	bool				LoadGame(const char *saveName);
 	bool				SaveGame(const char *saveName, bool autosave = false, bool skipCheck = false);
+	void				FinishSaveGameWrite( bool wait );
 
 	//=====================================
 
@@ -143,6 +154,7 @@ public:
 	static idCVar		com_minTics;
 	static idCVar		com_fixedTic;
 	static idCVar		com_asyncTic;
+	static idCVar		com_interpolateTics;
 	static idCVar		com_showDemo;
 	static idCVar		com_skipGameDraw;
 	static idCVar		com_aviDemoWidth;
@@ -151,6 +163,7 @@ public:
 	static idCVar		com_aviDemoTics;
 	static idCVar		com_wipeSeconds;
 	static idCVar		com_guid;
+	static idCVar		com_showLoadStages;
 
 	static idCVar		gui_configServerRate;
 
@@ -159,6 +172,8 @@ public:
 
 	// SteveL #4161: Support > 1 quicksave
 	static idCVar		com_numQuickSaves;
+	static idCVar		com_asyncSaveGames;
+	static idCVar		com_benchmarkHitchMsec;
 
 	int					timeHitch;
 
@@ -196,6 +211,9 @@ public:
 
 	bool				loadingSaveGame;	// currently loading map from a SaveGame
 	idFile *			savegameFile;		// this is the savegame file to load from
+	idFile *			saveGameWriteFile;	// savegame written by the async read thread
+	idFile_Memory *		saveGameWriteBuffer;
+	asyncRead_t *		saveGameWrite;
 	int					savegameVersion;
 
 	idFile *			cmdDemoFile;		// if non-zero, we are reading commands from a file
@@ -219,6 +237,14 @@ public:
 	// the next one will be read when 
 	// com_frameTime + demoTimeOffset > currentDemoRenderView.
 
+	idStr				benchmarkDemo;		// timed benchmarkRuns times, the next run is started from Frame
+	idStr				benchmarkReport;
+	int					benchmarkRuns;		// 0 when no benchmark is running
+	int					benchmarkRun;
+	bool				benchmarkQuit;
+	double				benchmarkFrameTicks;
+	idList<benchmarkFrame_t> benchmarkFrames;
+
 	// TODO: make this private (after sync networking removal and idnet tweaks)
 	idUserInterface *	guiActive;
 	HandleGuiCommand_t	guiHandle;
@@ -267,6 +293,10 @@ public:
 	void				StopPlayingRenderDemo();
 	void				CompressDemoFile( const char *scheme, const char *name );
 	void				TimeRenderDemo( const char *name, bool twice = false );
+	void				StartBenchmark( const char *demoName, int runs, const char *reportName, bool quit );
+	void				RunBenchmark();
+	void				RecordBenchmarkFrame();
+	void				WriteBenchmarkReport();
 	void				AVIRenderDemo( const char *name );
 	void				AVICmdDemo( const char *name );
 	void				AVIGame( const char *name );
@@ -287,6 +317,7 @@ public:
 	void				SetBytesNeededForMapLoad( const char *mapName, int bytesNeeded );
 
 	void				ExecuteMapChange( bool noFadeWipe = false );
+	void				LoadStageDone( const char *stage, int &stageStart ) const;
 	void				UnloadMap();
 
 	//------------------
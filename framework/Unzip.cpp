@@ -4459,14 +4459,15 @@ int inflateSyncPoint(z_streamp z)
   return inflate_blocks_sync_point(z->state->blocks);
 }
 
+/* the CRT heap is thread safe, so zipped files can be inflated on the async read thread */
 voidp zcalloc (voidp opaque, unsigned items, unsigned size)
 {
     if (opaque) items += size - size; /* make compiler happy */
-    return (voidp)Mem_ClearedAlloc(items*size);
+    return (voidp)calloc(items, size);
 }
 
 void  zcfree (voidp opaque, voidp ptr)
 {
-    Mem_Free(ptr);
+    free(ptr);
     if (opaque) return; /* make compiler happy */
 }
@@ -59,6 +59,7 @@ idCVar				idAsyncNetwork::serverReloadEngine( "net_serverReloadEngine", "0", CVA
 idCVar				idAsyncNetwork::serverAllowServerMod( "net_serverAllowServerMod", "0", CVAR_SYSTEM | CVAR_BOOL | CVAR_NOCHEAT, "allow server-side mods" );
 idCVar				idAsyncNetwork::idleServer( "si_idleServer", "0", CVAR_SYSTEM | CVAR_BOOL | CVAR_INIT | CVAR_SERVERINFO, "game clients are idle" );
 idCVar				idAsyncNetwork::clientDownload( "net_clientDownload", "1", CVAR_SYSTEM | CVAR_INTEGER | CVAR_ARCHIVE, "client pk4 downloads policy: 0 - never, 1 - ask, 2 - always (will still prompt for binary code)" );
+idCVar				idAsyncNetwork::channelCompressor( "net_channelCompressor", "0", CVAR_SYSTEM | CVAR_INTEGER | CVAR_NOCHEAT, "compression of the messages of new connections: 0 - run length, 1 - LZ4. The server and the clients must use the same", 0, 1, idCmdSystem::ArgCompletion_Integer<0,1> );
 
 int					idAsyncNetwork::realTime;
 master_t			idAsyncNetwork::masters[ MAX_MASTER_SERVERS ];
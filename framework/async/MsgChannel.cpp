@@ -253,7 +253,11 @@ void idMsgChannel::Init( const netadr_t adr, const int id ) {
 	this->remoteAddress = adr;
 	this->id = id;
 	this->maxRate = 50000;
-	this->compressor = idCompressor::AllocRunLength_ZeroBased();
+	if ( idAsyncNetwork::channelCompressor.GetInteger() == 1 ) {
+		this->compressor = idCompressor::AllocLZ4();
+	} else {
+		this->compressor = idCompressor::AllocRunLength_ZeroBased();
+	}
 
 	lastSendTime = 0;
 	lastDataBytes = 0;
@@ -773,6 +773,7 @@ idActor::idActor( void ) {
 
 	enemyNode.SetOwner( this );
 	enemyList.SetOwner( this );
+	actorNode.SetOwner( this );
 
 	INIT_TIMER_HANDLE(actorGetObstaclesTimer);
 	INIT_TIMER_HANDLE(actorGetPointOutsideObstaclesTimer);
@@ -801,6 +802,8 @@ idActor::~idActor( void ) {
 
 	StopSound( SND_CHANNEL_ANY, false );
 
+	actorNode.Remove();
+
 	delete combatModel;
 	combatModel = NULL;
 
@@ -836,6 +839,8 @@ void idActor::Spawn( void )
 	state		= NULL;
 	idealState	= NULL;
 
+	actorNode.AddToEnd( gameLocal.spawnedActors );
+
 	spawnArgs.GetFloat( "collision_damage_threshold_hard", "25", m_damage_thresh_hard ); // greebo: dealing 50+ hit points is considered "hard"
 	spawnArgs.GetFloat( "collision_damage_threshold_min", "5", m_damage_thresh_min ); // falling ~12 ft, g = 1066
 
@@ -2138,6 +2143,57 @@ bool idActor::CheckFOV( const idVec3 &pos ) const
 	return ( dot >= m_fovDotHoriz );
 }
 
+/*
+=====================
+idActor::GetSightTracePoints
+=====================
+*/
+bool idActor::GetSightTracePoints( idActor *actor, idVec3 points[4] ) const
+{
+	// grayman #3643 - shouldn't be able to see the actor if he's marked 'notarget'
+	// grayman #3857 - or if marked 'invisible'
+	if ((actor->fl.notarget) || (actor->fl.invisible))
+	{
+		return false;
+	}
+
+	// angua: use the eye position, the origin and the shoulders
+
+	// grayman #3992 - problem: if an AI has been KO'ed or killed,
+	// it's in ragdoll form, and GetViewPos() returns the angle the
+	// AI was facing before it became a ragdoll, which is useless here.
+
+	const idVec3& actorEyePos = actor->GetEyePosition();
+	const idVec3& actorOrigin = actor->GetPhysics()->GetOrigin();
+
+	idVec3 dir;
+	if ( actor->AI_DEAD || actor->IsKnockedOut() )
+	{
+		const idVec3 &gravityDir = GetPhysics()->GetGravityNormal();
+		idVec3 bodyAxis = actorEyePos - actorOrigin;
+		bodyAxis.NormalizeFast();
+		dir = bodyAxis.Cross(gravityDir);
+	}
+	else
+	{
+		idVec3 origin;
+		idMat3 viewaxis;
+		actor->GetViewPos(origin, viewaxis);
+
+		const idVec3 &gravityDir = GetPhysics()->GetGravityNormal();
+		dir = (viewaxis[0] - gravityDir * ( gravityDir * viewaxis[0] )).Cross(gravityDir);
+	}
+
+	float dist = 8;
+
+	points[0] = actorEyePos;
+	points[1] = actorOrigin;
+	points[2] = actorOrigin + (actorEyePos - actorOrigin)*0.7f + dir * dist;
+	points[3] = actorOrigin + (actorEyePos - actorOrigin)*0.7f - dir * dist;
+
+	return true;
+}
+
 /*
 =====================
 idActor::CanSee
@@ -2158,99 +2214,27 @@ bool idActor::CanSee( idEntity *ent, bool useFov ) const
 
 	if (ent->IsType(idActor::Type)) 
 	{
-		// grayman #3643 - shouldn't be able to see the actor if he's marked 'notarget'
-		// grayman #3857 - or if marked 'invisible'
-		if ((ent->fl.notarget) || (ent->fl.invisible))
-		{
-			return false;
-		}
-
-		bool fovEyeOK;
-		bool fovOriginOK;
-		bool fovShoulder1OK;
-		bool fovShoulder2OK;
-
 		idActor* actor = static_cast<idActor*>(ent);
+		idVec3 points[4];
 
-		// Check eyes
-
-		const idVec3& actorEyePos = actor->GetEyePosition();
-		fovEyeOK = useFov ? CheckFOV(actorEyePos) : true;
-		if ( fovEyeOK )
-		{
-			if ( !gameLocal.clip.TracePoint(result, eye, actorEyePos, MASK_OPAQUE, this) ||
-				gameLocal.GetTraceEntity(result) == actor )
-			{
-				// Eye to eye trace succeeded
-				// gameRenderWorld->DebugArrow(colorGreen,eye, actorEyePos, 1, 32);
-				return true;
-			}
-		}
-
-		// Check origin
-
-		const idVec3& actorOrigin = actor->GetPhysics()->GetOrigin();
-		fovOriginOK = useFov ? CheckFOV(actorOrigin) : true;
-
-		if ( fovOriginOK )
-		{
-			if ( !gameLocal.clip.TracePoint(result, eye, actorOrigin, MASK_OPAQUE, this) ||
-				gameLocal.GetTraceEntity(result) == actor )
-			{
-				// Eye to origin trace succeeded
-				// gameRenderWorld->DebugArrow(colorGreen,eye, actorOrigin, 1, 32);
-				return true;
-			}
-		}
-
-		// Check one shoulder
-
-		idVec3 dir;
-		if ( actor->AI_DEAD || actor->IsKnockedOut() )
-		{
-			const idVec3 &gravityDir = GetPhysics()->GetGravityNormal();
-			idVec3 bodyAxis = actorEyePos - actorOrigin;
-			bodyAxis.NormalizeFast();
-			dir = bodyAxis.Cross(gravityDir);
-		}
-		else
+		if ( !GetSightTracePoints(actor, points) )
 		{
-			idVec3 origin;
-			idMat3 viewaxis;
-			actor->GetViewPos(origin, viewaxis);
-
-			const idVec3 &gravityDir = GetPhysics()->GetGravityNormal();
-			dir = (viewaxis[0] - gravityDir * ( gravityDir * viewaxis[0] )).Cross(gravityDir);
+			return false;
 		}
 
-		float dist = 8;
-
-		const idVec3& shoulder1 = actorOrigin + (actorEyePos - actorOrigin)*0.7f + dir * dist;
-		fovShoulder1OK = useFov ? CheckFOV(shoulder1) : true;
-
-		if ( fovShoulder1OK )
+		// Check eyes, origin and both shoulders
+		for ( int i = 0 ; i < 4 ; i++ )
 		{
-			if ( !gameLocal.clip.TracePoint(result, eye, shoulder1, MASK_OPAQUE, this) ||
-				gameLocal.GetTraceEntity(result) == actor )
+			if ( useFov && !CheckFOV(points[i]) )
 			{
-				// Eye to shoulder1 trace succeeded
-				// gameRenderWorld->DebugArrow(colorGreen,eye, shoulder1, 1, 32);
-				return true;
+				continue;
 			}
-		}
 
-		// Check other shoulder
-
-		const idVec3& shoulder2 = actorOrigin + (actorEyePos - actorOrigin)*0.7f - dir * dist;
-		fovShoulder2OK = useFov ? CheckFOV(shoulder2) : true;
-
-		if ( fovShoulder2OK )
-		{
-			if ( !gameLocal.clip.TracePoint(result, eye, shoulder2, MASK_OPAQUE, this) ||
+			if ( !gameLocal.clip.TracePoint(result, eye, points[i], MASK_OPAQUE, this) ||
 				gameLocal.GetTraceEntity(result) == actor )
 			{
-				// Eye to shoulder2 trace succeeded
-				// gameRenderWorld->DebugArrow(colorGreen,eye, shoulder2, 1, 32);
+				// Trace succeeded
+				// gameRenderWorld->DebugArrow(colorGreen,eye, points[i], 1, 32);
 				return true;
 			}
 		}
@@ -270,6 +270,7 @@ public:
 
 	idLinkList<idActor>		enemyNode;			// node linked into an entity's enemy list for quick lookups of who is attacking him
 	idLinkList<idActor>		enemyList;			// list of characters that have targeted the player as their enemy
+	idLinkList<idActor>		actorNode;			// for being linked into gameLocal.spawnedActors
 
 	// The greeting state this actor is currently in (to coordinate greeting barks in between actors)
 	GreetingState			greetingState;
@@ -504,6 +505,11 @@ public:
 	 *         blocked, the entity is considered hidden and the method returns FALSE.
 	 */
 	virtual bool			CanSee( idEntity *ent, bool useFOV ) const;
+	/**
+	 * The points of the given actor CanSee traces to, in the order it tries them: eyes, origin
+	 * and both shoulders. Returns FALSE if the actor can't be seen at all (notarget, invisible).
+	 */
+	bool					GetSightTracePoints( idActor *actor, idVec3 points[4] ) const;
 	bool					PointVisible( const idVec3 &point ) const;
 	virtual void			GetAIAimTargets( const idVec3 &lastSightPos, idVec3 &headPos, idVec3 &chestPos );
 
@@ -131,6 +131,11 @@ void CBinaryFrobMover::AddObjectsToSaveGame(idSaveGame* savefile)
 	savefile->AddObject(m_Lock);
 }
 
+int CBinaryFrobMover::DefaultMaxThinkInterleave() const
+{
+	return 0;
+}
+
 void CBinaryFrobMover::Save(idSaveGame *savefile) const
 {
 	// The lock class is saved by the idSaveGame class on close, no need to handle it here
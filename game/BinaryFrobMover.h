@@ -65,6 +65,9 @@ public:
 	// Override idEntity to register the PickableLock class.
 	virtual void			AddObjectsToSaveGame(idSaveGame* savefile);
 
+	// Frob movers are used by the player and the AI, they think every frame
+	virtual int				DefaultMaxThinkInterleave() const;
+
 	/**
 	 * greebo: A set of convenience methods, which set the master bool to TRUE.
 	 * Don't use default argument initialisers on the virtual functions, 
@@ -46,6 +46,58 @@ const int SHARD_FADE_START	= 2000;
 
 static const char *brittleFracture_SnapshotName = "_BrittleFracture_Snapshot_";
 
+/*
+  Small dropped shards don't get a rigid body. They fly as particles with a point
+  trace per frame and come to rest on the first floor they slow down on. Their
+  state comes from a fixed pool shared by all fracture entities, when it runs out
+  the shards use their rigid body again.
+*/
+typedef struct shardParticle_s {
+	idVec3						velocity;
+	idVec3						angularVelocity;
+	bool						atRest;
+} shardParticle_t;
+
+static const int				MAX_SHARD_PARTICLES = 1024;
+static const float				SHARD_PARTICLE_REST_SPEED = 10.0f;
+
+static shardParticle_t			shardParticles[MAX_SHARD_PARTICLES];
+static int						freeShardParticles[MAX_SHARD_PARTICLES];
+static int						numFreeShardParticles = -1;		// the pool is filled on first use
+
+/*
+================
+AllocShardParticle
+================
+*/
+static int AllocShardParticle( void ) {
+	int i;
+
+	if ( numFreeShardParticles < 0 ) {
+		for ( i = 0; i < MAX_SHARD_PARTICLES; i++ ) {
+			freeShardParticles[i] = MAX_SHARD_PARTICLES - 1 - i;
+		}
+		numFreeShardParticles = MAX_SHARD_PARTICLES;
+	}
+
+	if ( !numFreeShardParticles ) {
+		return -1;
+	}
+
+	return freeShardParticles[--numFreeShardParticles];
+}
+
+/*
+================
+FreeShardParticle
+================
+*/
+static void FreeShardParticle( int index ) {
+	if ( index != -1 ) {
+		freeShardParticles[numFreeShardParticles++] = index;
+	}
+}
+
 /*
 ================
 idBrittleFracture::idBrittleFracture
@@ -65,6 +117,7 @@ idBrittleFracture::idBrittleFracture( void ) {
 	friction = 0.0f;
 	bouncyness = 0.0f;
 	fxFracture.Clear();
+	particleShardArea = 0.0f;
 
 	bounds.Clear();
 	disableFracture = false;
@@ -93,6 +146,7 @@ idBrittleFracture::~idBrittleFracture( void ) {
 
 	for ( i = 0; i < shards.Num(); i++ ) {
 		shards[i]->decals.DeleteContents( true );
+		FreeShardParticle( shards[i]->particle );
 		delete shards[i];
 	}
 
@@ -131,6 +185,7 @@ void idBrittleFracture::Save( idSaveGame *savefile ) const {
 	savefile->WriteFloat( friction );
 	savefile->WriteFloat( bouncyness );
 	savefile->WriteString( fxFracture );
+	savefile->WriteFloat( particleShardArea );
 
 	// state
 	savefile->WriteBounds( bounds );
@@ -166,6 +221,14 @@ void idBrittleFracture::Save( idSaveGame *savefile ) const {
 		savefile->WriteInt( shards[i]->islandNum );
 		savefile->WriteBool( shards[i]->atEdge );
 		savefile->WriteStaticObject( shards[i]->physicsObj );
+
+		savefile->WriteBool( shards[i]->particle != -1 );
+		if ( shards[i]->particle != -1 ) {
+			const shardParticle_t &particle = shardParticles[shards[i]->particle];
+			savefile->WriteVec3( particle.velocity );
+			savefile->WriteVec3( particle.angularVelocity );
+			savefile->WriteBool( particle.atRest );
+		}
 	}
 
 	savefile->WriteInt( m_AreaPortal );
@@ -207,6 +270,7 @@ void idBrittleFracture::Restore( idRestoreGame *savefile ) {
 	savefile->ReadFloat( friction );
 	savefile->ReadFloat( bouncyness );
 	savefile->ReadString( fxFracture );
+	savefile->ReadFloat( particleShardArea );
 
 	// state
 	savefile->ReadBounds(bounds);
@@ -222,6 +286,7 @@ void idBrittleFracture::Restore( idRestoreGame *savefile ) {
 	shards.SetNum( num );
 	for ( i = 0; i < num; i++ ) {
 		shards[i] = new shard_t;
+		shards[i]->particle = -1;
 	}
 
 	for ( i = 0; i < num; i++ ) {
@@ -258,6 +323,21 @@ void idBrittleFracture::Restore( idRestoreGame *savefile ) {
 		} else {
 			shards[i]->clipModel = shards[i]->physicsObj.GetClipModel();
 		}
+
+		bool isParticle;
+		savefile->ReadBool( isParticle );
+		if ( isParticle ) {
+			shardParticle_t particle;
+			savefile->ReadVec3( particle.velocity );
+			savefile->ReadVec3( particle.angularVelocity );
+			savefile->ReadBool( particle.atRest );
+
+			shards[i]->particle = AllocShardParticle();
+			if ( shards[i]->particle != -1 ) {
+				shardParticles[shards[i]->particle] = particle;
+				shards[i]->clipModel->SetPosition( shards[i]->clipModel->GetOrigin(), shards[i]->clipModel->GetAxis() );
+			}
+		}
 	}
 
 	savefile->ReadInt( m_AreaPortal );
@@ -288,6 +368,7 @@ void idBrittleFracture::Spawn( void ) {
 	fxFracture = spawnArgs.GetString( "fx" );
 	shardAliveTime = static_cast<int>( spawnArgs.GetFloat("shardAliveTime", "5.0") * 1000 );
 	shardFadeStart = static_cast<int>( spawnArgs.GetFloat("shardFadeStart", "2.0") * 1000 );
+	particleShardArea = spawnArgs.GetFloat( "particleShardArea", "100" );
 
 	// get rigid body properties
 	shardMass = spawnArgs.GetFloat( "shardMass", "20" );
@@ -340,6 +421,7 @@ void idBrittleFracture::AddShard( idClipModel *clipModel, idFixedWinding &w ) {
 	shard->edgeHasNeighbour.AssureSize( w.GetNumPoints(), false );
 	shard->neighbours.Clear();
 	shard->atEdge = false;
+	shard->particle = -1;
 	shards.Append( shard );
 }
 
@@ -353,6 +435,7 @@ void idBrittleFracture::RemoveShard( int index ) {
 	// this function. 
 	int i;
 
+	FreeShardParticle( shards[index]->particle );
 	delete shards[index];
 	shards.RemoveIndex( index );
 	physicsObj.RemoveIndex( index );
@@ -642,6 +725,13 @@ void idBrittleFracture::Think( void ) {
 				continue;
 			}
 
+			if ( shard->particle != -1 ) {
+				if ( RunShardParticle( shard, endTime - startTime ) ) {
+					atRest = false;
+				}
+				continue;
+			}
+
 			shard->physicsObj.Evaluate( endTime - startTime, endTime );
 
 			if ( !shard->physicsObj.IsAtRest() ) {
@@ -659,7 +749,14 @@ void idBrittleFracture::Think( void ) {
 	if ( !atRest || bounds.IsCleared() ) {
 		bounds.Clear();
 		for ( i = 0; i < shards.Num(); i++ ) {
-			bounds.AddBounds( shards[i]->clipModel->GetAbsBounds() );
+			if ( shards[i]->particle != -1 ) {
+				// not linked, so the absolute bounds are not up to date
+				idBounds shardBounds;
+				shardBounds.FromTransformedBounds( shards[i]->clipModel->GetBounds(), shards[i]->clipModel->GetOrigin(), shards[i]->clipModel->GetAxis() );
+				bounds.AddBounds( shardBounds );
+			} else {
+				bounds.AddBounds( shards[i]->clipModel->GetAbsBounds() );
+			}
 		}
 	}
 
@@ -684,7 +781,12 @@ void idBrittleFracture::ApplyImpulse( idEntity *ent, int id, const idVec3 &point
 		return;
 	}
 
-	if ( shards[id]->droppedTime != -1 ) {
+	if ( shards[id]->particle != -1 ) {
+		shardParticle_t &particle = shardParticles[shards[id]->particle];
+		particle.velocity += impulse * ( 1.0f / shardMass );
+		particle.atRest = false;
+		BecomeActive( TH_PHYSICS );
+	} else if ( shards[id]->droppedTime != -1 ) {
 		shards[id]->physicsObj.ApplyImpulse( 0, point, impulse );
 	} else if ( health <= 0 && !disableFracture ) {
 		Shatter( point, impulse, gameLocal.time );
@@ -703,7 +805,10 @@ void idBrittleFracture::AddForce( idEntity *ent, int id, const idVec3 &point, co
 	}
 
 	if ( shards[id]->droppedTime != -1 ) {
-		shards[id]->physicsObj.AddForce( 0, point, force );
+		// shard particles are not linked, so nothing pushes them
+		if ( shards[id]->particle == -1 ) {
+			shards[id]->physicsObj.AddForce( 0, point, force );
+		}
 	} else if ( health <= 0 && !disableFracture ) {
 		Shatter( point, force, gameLocal.time );
 	}
@@ -869,11 +974,84 @@ void idBrittleFracture::DropShard( shard_t *shard, const idVec3 &point, const id
 	shard->physicsObj.ApplyImpulse( 0, origin, impulse * linearVelocityScale * dir );
 	shard->physicsObj.SetAngularVelocity( dir.Cross( dir2 ) * ( f * angularVelocityScale ) );
 
+	// small shards fly as particles, the rigid body only keeps the clip model
+	if ( shard->winding.GetArea() < particleShardArea ) {
+		shard->particle = AllocShardParticle();
+		if ( shard->particle != -1 ) {
+			shardParticle_t &particle = shardParticles[shard->particle];
+			particle.velocity = shard->physicsObj.GetLinearVelocity();
+			particle.angularVelocity = shard->physicsObj.GetAngularVelocity();
+			particle.atRest = false;
+
+			shard->physicsObj.SetContents( 0 );
+			shard->clipModel->SetPosition( origin, axis );
+		}
+	}
+
 	shard->clipModel->SetId( clipModelId );
 
 	BecomeActive( TH_PHYSICS );
 }
 
+/*
+================
+idBrittleFracture::RunShardParticle
+
+Moves a shard particle, returns true if it is not at rest
+================
+*/
+bool idBrittleFracture::RunShardParticle( shard_t *shard, const int msec ) {
+	shardParticle_t &particle = shardParticles[shard->particle];
+	idVec3 origin, end, up, rotationVec;
+	idMat3 axis;
+	float timeStep, angle, speed;
+	trace_t trace;
+
+	if ( particle.atRest ) {
+		return false;
+	}
+
+	timeStep = MS2SEC( msec );
+	origin = shard->clipModel->GetOrigin();
+	axis = shard->clipModel->GetAxis();
+
+	particle.velocity += gameLocal.GetGravity() * timeStep;
+	end = origin + particle.velocity * timeStep;
+
+	if ( gameLocal.clip.TracePoint( trace, origin, end, MASK_SOLID | CONTENTS_MOVEABLECLIP, this ) ) {
+		// stuck, in solid or pressed against a surface
+		if ( trace.fraction <= 0.0f ) {
+			particle.atRest = true;
+			return false;
+		}
+
+		// bounce off and lose speed
+		end = trace.endpos;
+		speed = particle.velocity * trace.c.normal;
+		particle.velocity -= ( 1.0f + bouncyness ) * speed * trace.c.normal;
+		particle.velocity *= 1.0f - friction;
+		particle.angularVelocity *= 1.0f - friction;
+
+		up = -gameLocal.GetGravity();
+		up.Normalize();
+		if ( trace.c.normal * up > 0.7f && particle.velocity.LengthSqr() < Square( SHARD_PARTICLE_REST_SPEED ) ) {
+			particle.velocity.Zero();
+			particle.angularVelocity.Zero();
+			particle.atRest = true;
+		}
+	}
+
+	rotationVec = particle.angularVelocity;
+	angle = rotationVec.Normalize();
+	if ( angle > 0.0f ) {
+		axis *= idRotation( vec3_origin, rotationVec, RAD2DEG( angle * timeStep ) ).ToMat3();
+	}
+
+	shard->clipModel->SetPosition( end, axis );
+
+	return !particle.atRest;
+}
+
 /*
 ================
 idBrittleFracture::Shatter
@@ -43,6 +43,7 @@ typedef struct shard_s {
 	int							droppedTime;
 	bool						atEdge;
 	int							islandNum;
+	int							particle;		// index of the shard particle if the dropped shard doesn't use physicsObj, or -1
 } shard_t;
 
 
@@ -110,6 +111,7 @@ private:
 	idStr						fxFracture;
 	float						shardAliveTime;		// Replaced global constants with member 
 	float						shardFadeStart;		// vars so mappers can tweak -- SteveL #4176
+	float						particleShardArea;	// smaller shards fly as particles when dropped
 
 	// state
 	idPhysics_StaticMulti		physicsObj;
@@ -145,6 +147,7 @@ private:
 	void						AddShard( idClipModel *clipModel, idFixedWinding &w );
 	void						RemoveShard( int index );
 	void						DropShard( shard_t *shard, const idVec3 &point, const idVec3 &dir, const float impulse, const int time );
+	bool						RunShardParticle( shard_t *shard, const int msec );
 	void						Shatter( const idVec3 &point, const idVec3 &impulse, const int time );
 	void						DropFloatingIslands( const idVec3 &point, const idVec3 &impulse, const int time );
 	void						Break( void );
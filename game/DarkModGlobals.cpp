@@ -266,6 +266,20 @@ void CGlobal::Init()
 
 	// Map the surface types to strings
 	InitSurfaceHardness();
+
+	// From here on the log lines are written in the background. This is not done
+	// in the constructor, the DLL loader lock would block the new thread.
+	m_LogWriter.Start(m_LogFile);
+}
+
+void CGlobal::Shutdown()
+{
+	m_LogWriter.Stop();
+
+	if (m_LogFile != NULL)
+	{
+		fflush(m_LogFile);
+	}
 }
 
 void CGlobal::LogPlane(idStr const &Name, idPlane const &Plane)
@@ -294,30 +308,78 @@ void CGlobal::LogMat3(idStr const &Name, idMat3 const &Mat)
 }
 
 void CGlobal::LogString(const char *fmt, ...)
+{
+	va_list arg;
+	va_start(arg, fmt);
+
+	Log(m_LogClass, m_LogType, m_Filename, m_Linenumber, fmt, arg);
+
+	va_end(arg);
+}
+
+void CGlobal::Log(LC_LogClass lc, LT_LogType lt, const char* filename, int line, const char* fmt, va_list args)
 {
 	if(m_LogFile == NULL)
 		return;
 
-	LC_LogClass lc = m_LogClass;
-	LT_LogType lt = m_LogType;
-
 	if(m_ClassArray[lc] == false)
 		return;
 
 	if(m_LogArray[lt] == false)
 		return;
 
-	va_list arg;
-	va_start(arg, fmt);
+	if (m_LogWriter.IsRunning())
+	{
+		m_LogWriter.Push(lc, lt, filename, line, m_Frame, fmt, args);
+		return;
+	}
 
-	fprintf(m_LogFile, "[%s (%4u):%s (%s) FR: %4lu] ", m_Filename, m_Linenumber, LTString[lt], LCString[lc], m_Frame);
-	vfprintf(m_LogFile, fmt, arg);
+	CLogWriter::WritePrefix(m_LogFile, lc, lt, filename, line, m_Frame);
+	vfprintf(m_LogFile, fmt, args);
 	fprintf(m_LogFile, "\n");
 	fflush(m_LogFile);
+}
+
+void CLogWriter::WritePrefix(FILE* file, int logClass, int logType, const char* filename, int line, long frame)
+{
+	fprintf(file, "[%s (%4u):%s (%s) FR: %4lu] ", filename, line, LTString[logType], LCString[logClass], frame);
+}
+
+void CLogContext::LogString(const char *fmt, ...)
+{
+	va_list arg;
+	va_start(arg, fmt);
+
+	g_Global.Log(m_LogClass, m_LogType, m_Filename, m_Linenumber, fmt, arg);
 
 	va_end(arg);
 }
 
+void CLogContext::LogPlane(idStr const &Name, idPlane const &Plane)
+{
+	float a, b, c, d;
+
+	Plane.GetPlaneParams(a, b, c, d);
+	LogString("Plane %s:    a: %f   b: %f   c: %f   d: %f\r", Name.c_str(), a, b, c, d);
+}
+
+void CLogContext::LogVector(idStr const &Name, idVec3 const &Vector)
+{
+	LogString("Vector %s:    x: %f   y: %f   z: %f\r", Name.c_str(), Vector.x, Vector.y, Vector.z);
+}
+
+void CLogContext::LogMat3(idStr const &Name, idMat3 const &Mat)
+{
+	idVec3 a, b, c;
+
+	Mat.GetMat3Params(a, b, c);
+	LogString("Matrix %s:\r\t%f  %f  %f\r\t%f  %f  %f\r\t%f  %f  %f\r", Name.c_str(), 
+		a.x, a.y, a.z,
+		b.x, b.y, b.z,
+		c.x, c.y, c.z
+		);
+}
+
 void CGlobal::LoadINISettings(const IniFilePtr& iniFile)
 {
 	DM_LOG(LC_INIT, LT_INIT)LOGSTRING("Loading INI settings\r");
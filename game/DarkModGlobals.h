@@ -53,6 +53,7 @@ VersionCheckResult CompareVersion(int major, int minor, int toMajor, int toMinor
 Darkmod LAS
 */
 #include "darkModLAS.h"
+#include "LogWriter.h"
 #include <boost/filesystem.hpp>
 
 class IniFile;
@@ -136,11 +137,17 @@ public:
 
 	void Init();
 
+	// Stops the log writer thread, called on game shutdown
+	void Shutdown();
+
 	void LogPlane(idStr const &Name, idPlane const &Plane);
 	void LogVector(idStr const &Name, idVec3 const &Vector);
 	void LogMat3(idStr const &Name, idMat3 const &Matrix);
 	void LogString(const char *Format, ...);
 
+	// Writes a log line for the given context, via the log writer thread if it is running
+	void Log(LC_LogClass lc, LT_LogType lt, const char* filename, int line, const char* fmt, va_list args);
+
 	CLightMaterial *GetMaterial(idStr const &MaterialName);
 
 	/**
@@ -207,6 +214,9 @@ private:
 	// A list of hardness strings ("hard", "soft")
 	idStringList m_SurfaceHardness;
 
+	// Writes the log lines to m_LogFile in the background
+	CLogWriter m_LogWriter;
+
 public:
 	/**
 	 * LogFile is initialized to NULL if no Logfile is in use. Otherwise it
@@ -250,15 +260,54 @@ public:
 extern CGlobal g_Global;
 extern const char *g_LCString[];
 
+/**
+ * The source location and class of a single DM_LOG line. The macros create one
+ * per call instead of storing the context in g_Global, which is not safe when
+ * several threads log at the same time.
+ */
+class CLogContext
+{
+public:
+	CLogContext(LC_LogClass lc, LT_LogType lt, const char* filename, int line) :
+		m_LogClass(lc),
+		m_LogType(lt),
+		m_Filename(filename),
+		m_Linenumber(line)
+	{}
+
+	void LogString(const char *Format, ...);
+	void LogPlane(idStr const &Name, idPlane const &Plane);
+	void LogVector(idStr const &Name, idVec3 const &Vector);
+	void LogMat3(idStr const &Name, idMat3 const &Matrix);
+
+private:
+	LC_LogClass		m_LogClass;
+	LT_LogType		m_LogType;
+	const char		*m_Filename;
+	int				m_Linenumber;
+};
+
 #define LOGBUILD
 
+/**
+ * Bit mask of the log classes that are compiled in at all, bit n enables class n.
+ * Release builds can pass e.g. -DDM_LOG_COMPILED_CLASSES=0x3 (LC_INIT and LC_FORCE)
+ * and the remaining DM_LOG calls, their arguments included, are removed by the compiler.
+ */
+#ifndef DM_LOG_COMPILED_CLASSES
+#define DM_LOG_COMPILED_CLASSES		0xFFFFFFFF
+#endif
+
+#define DM_LOG_COMPILED(lc)			(((DM_LOG_COMPILED_CLASSES) >> (lc)) & 1)
+#define DM_LOG_ENABLED(lc, lt)		(DM_LOG_COMPILED(lc) && g_Global.m_ClassArray[lc] && g_Global.m_LogArray[lt])
+
 #ifdef LOGBUILD
-#define DM_LOG(lc, lt)				if(g_Global.m_ClassArray[lc] == true && g_Global.m_LogArray[lt] == true) g_Global.m_LogClass = lc, g_Global.m_LogType = lt, g_Global.m_Filename = __FILE__, g_Global.m_Linenumber = __LINE__, g_Global
+#define DM_LOG(lc, lt)				if(DM_LOG_ENABLED(lc, lt)) CLogContext(lc, lt, __FILE__, __LINE__)
 #define LOGSTRING					.LogString
 #define LOGVECTOR					.LogVector
-#define DM_LOGVECTOR3(lc, lt, s, v)	if(g_Global.m_ClassArray[lc] == true && g_Global.m_LogArray[lt] == true) g_Global.m_LogClass = lc, g_Global.m_LogType = lt, g_Global.m_Filename = __FILE__, g_Global.m_Linenumber = __LINE__, g_Global.LogVector(s, v)
-#define DM_LOGPLANE(lc, lt, s, p)	if(g_Global.m_ClassArray[lc] == true && g_Global.m_LogArray[lt] == true) g_Global.m_LogClass = lc, g_Global.m_LogType = lt, g_Global.m_Filename = __FILE__, g_Global.m_Linenumber = __LINE__, g_Global.LogPlane(s, p)
-#define DM_LOGMAT3(lc, lt, s, m)	if(g_Global.m_ClassArray[lc] == true && g_Global.m_LogArray[lt] == true) g_Global.m_LogClass = lc, g_Global.m_LogType = lt, g_Global.m_Filename = __FILE__, g_Global.m_Linenumber = __LINE__, g_Global.LogMat3(s, m)
+#define DM_LOGVECTOR3(lc, lt, s, v)	if(DM_LOG_ENABLED(lc, lt)) CLogContext(lc, lt, __FILE__, __LINE__).LogVector(s, v)
+#define DM_LOGPLANE(lc, lt, s, p)	if(DM_LOG_ENABLED(lc, lt)) CLogContext(lc, lt, __FILE__, __LINE__).LogPlane(s, p)
+#define DM_LOGMAT3(lc, lt, s, m)	if(DM_LOG_ENABLED(lc, lt)) CLogContext(lc, lt, __FILE__, __LINE__).LogMat3(s, m)
 #else
 #define DM_LOG(lc, lt)
 #define LOGSTRING 
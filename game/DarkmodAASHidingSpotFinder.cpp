@@ -73,7 +73,9 @@ CDarkmodAASHidingSpotFinder::CDarkmodAASHidingSpotFinder() :
 	currentGridSearchBounds(vec3_origin, vec3_origin),
 	currentGridSearchBoundMins(vec3_origin),
 	currentGridSearchBoundMaxes(vec3_origin),
-	currentGridSearchPoint(vec3_origin)
+	currentGridSearchPoint(vec3_origin),
+	currentCandidateNum(0),
+	currentCandidatesTested(0)
 {
 	// Start empty
 	h_hideFromPVS.i = -1;
@@ -122,6 +124,8 @@ CDarkmodAASHidingSpotFinder::CDarkmodAASHidingSpotFinder
 	hidingSpotTypesAllowed = in_hidingSpotTypesAllowed;
 	p_ignoreEntity = in_p_ignoreEntity;
 	lastProcessingFrameNumber = -1;
+	currentCandidateNum = 0;
+	currentCandidatesTested = 0;
 
 	// No hiding spot PVS areas identified yet
 	numPVSAreas = 0;
@@ -173,6 +177,8 @@ bool CDarkmodAASHidingSpotFinder::initialize
 	hidingSpotTypesAllowed = in_hidingSpotTypesAllowed;
 	p_ignoreEntity = in_p_ignoreEntity;
 	lastProcessingFrameNumber = -1;
+	currentCandidateNum = 0;
+	currentCandidatesTested = 0;
 
 	// No hiding spot PVS areas identified yet
 	numPVSAreas = 0;
@@ -256,6 +262,8 @@ void CDarkmodAASHidingSpotFinder::Save( idSaveGame *savefile ) const
 	savefile->WriteVec3(currentGridSearchBoundMins);
 	savefile->WriteVec3(currentGridSearchBoundMaxes);
 	savefile->WriteVec3(currentGridSearchPoint);
+	savefile->WriteInt(currentCandidateNum);
+	savefile->WriteInt(currentCandidatesTested);
 }
 
 void CDarkmodAASHidingSpotFinder::Restore( idRestoreGame *savefile )
@@ -320,6 +328,8 @@ void CDarkmodAASHidingSpotFinder::Restore( idRestoreGame *savefile )
 	savefile->ReadVec3(currentGridSearchBoundMins);
 	savefile->ReadVec3(currentGridSearchBoundMaxes);
 	savefile->ReadVec3(currentGridSearchPoint);
+	savefile->ReadInt(currentCandidateNum);
+	savefile->ReadInt(currentCandidatesTested);
 }
 
 //-------------------------------------------------------------------------------------------------------
@@ -603,6 +613,8 @@ bool CDarkmodAASHidingSpotFinder::testingAASAreas_InVisiblePVSArea
 				currentGridSearchPoint = currentGridSearchBoundMins;
 				currentGridSearchPoint.x += WALL_MARGIN_SIZE;
 				currentGridSearchPoint.y += WALL_MARGIN_SIZE; // grayman #4023 - also need to init this properly
+				currentCandidateNum = 0;
+				currentCandidatesTested = 0;
 				
 				// We are now searching for hiding spots inside a visible AAS area
 				searchState = ESubdivideVisibleAASArea;
@@ -648,11 +660,37 @@ bool CDarkmodAASHidingSpotFinder::testingInsideVisibleAASArea
 	int& inout_numPointsTestedThisPass
 )
 {
-	//idVec3 areaCenter = aas->AreaCenter (AASAreaNum);
+	bool moreToDo;
+
+	// Test the best precomputed candidates of the area if we have them
+	if (cv_ai_hiding_spot_index.GetBool() && LAS.hidingSpotCandidateIndex.isBuiltFor(LAS.getAASName()))
+	{
+		moreToDo = testingCandidatesInsideVisibleAASArea(inout_hidingSpots, numPointsToTestThisPass, inout_numPointsTestedThisPass);
+	}
+	else
+	{
+		moreToDo = testingGridInsideVisibleAASArea(inout_hidingSpots, numPointsToTestThisPass, inout_numPointsTestedThisPass);
+	}
+
+	// Test the points queued for the batch
+	if (!testPendingPoints(inout_hidingSpots))
+	{
+		return false;
+	}
 
-	// Get search area properties
-	idVec3 searchCenter = searchLimits.GetCenter();
-	float searchRadius = searchLimits.GetRadius();
+	return moreToDo;
+}
+
+//-------------------------------------------------------------------------------------------------------
+
+bool CDarkmodAASHidingSpotFinder::testingGridInsideVisibleAASArea
+(
+	CDarkmodHidingSpotTree& inout_hidingSpots,
+	int numPointsToTestThisPass,
+	int& inout_numPointsTestedThisPass
+)
+{
+	//idVec3 areaCenter = aas->AreaCenter (AASAreaNum);
 
 	// Iterate a gridding within these bounds
 	float hideSearchGridSpacing = HIDE_GRID_SPACING;
@@ -701,67 +739,9 @@ bool CDarkmodAASHidingSpotFinder::testingInsideVisibleAASArea
 			// For now, only consider top of floor
 			currentGridSearchPoint.z = currentGridSearchBoundMaxes.z + WALL_MARGIN_SIZE;
 
-			darkModHidingSpot hidingSpot;
-
-			// Test if it is inside the exclusion bounds
-			if ( searchIgnoreLimits.ContainsPoint(currentGridSearchPoint) )
+			if (!testPointInsideVisibleAASArea(inout_hidingSpots, currentGridSearchPoint, p_hidingAreaNode))
 			{
-				hidingSpot.quality = -1.0;
-				hidingSpot.hidingSpotTypes = NONE_HIDING_SPOT_TYPE;
-			}
-			else
-			{
-				// Not inside exclusion bounds, must test it
-				hidingSpot.hidingSpotTypes = TestHidingPoint
-					(
-					currentGridSearchPoint,
-					searchCenter,
-					searchRadius,
-					hidingHeight,
-					hidingSpotTypesAllowed,
-					p_ignoreEntity.GetEntity(),
-					hidingSpot.lightQuotient,
-					hidingSpot.qualityWithoutDistanceFactor,
-					hidingSpot.quality
-					);
-			}
-
-			// If there are any hiding qualities, insert a hiding spot
-			if ( hidingSpot.hidingSpotTypes != NONE_HIDING_SPOT_TYPE &&
-				hidingSpot.quality > 0.0 )
-			{
-				// Insert a hiding spot for this test point
-				hidingSpot.goal.areaNum = currentGridSearchAASAreaNum;
-				hidingSpot.goal.origin = currentGridSearchPoint;
-
-				// ensure area index is in hiding spot tree
-				if ( p_hidingAreaNode == NULL )
-				{
-					p_hidingAreaNode = inout_hidingSpots.getArea(currentGridSearchAASAreaNum);
-
-					if ( p_hidingAreaNode == NULL )
-					{
-						p_hidingAreaNode = inout_hidingSpots.insertArea(currentGridSearchAASAreaNum);
-						if ( p_hidingAreaNode == NULL )
-						{
-							return false;
-						}
-					}
-				}
-
-				// Add spot under this index in the hiding spot tree
-				inout_hidingSpots.insertHidingSpot
-					(
-					p_hidingAreaNode,
-					hidingSpot.goal,
-					hidingSpot.hidingSpotTypes,
-					hidingSpot.lightQuotient,
-					hidingSpot.qualityWithoutDistanceFactor,
-					hidingSpot.quality,
-					hidingSpotRedundancyDistance
-					);
-
-				//DM_LOG(LC_AI, LT_DEBUG)LOGSTRING("Found hiding spot within AAS area %d at (X:%f, Y:%f, Z:%f) with type bitflags %d, quality %f\r", currentGridSearchAASAreaNum, currentGridSearchPoint.x, currentGridSearchPoint.y, currentGridSearchPoint.z, hidingSpot.hidingSpotTypes, hidingSpot.quality);
+				return false;
 			}
 
 			// One more point tested
@@ -842,6 +822,248 @@ bool CDarkmodAASHidingSpotFinder::testingInsideVisibleAASArea
 	return true;
 }
 
+//-------------------------------------------------------------------------------------------------------
+
+bool CDarkmodAASHidingSpotFinder::testPointInsideVisibleAASArea
+(
+	CDarkmodHidingSpotTree& inout_hidingSpots,
+	const idVec3& testPoint,
+	TDarkmodHidingSpotAreaNode*& inout_p_hidingAreaNode
+)
+{
+	// Queue the point for the batched occlusion traces, points inside the exclusion
+	// bounds are never hiding spots
+	if (cv_ai_hiding_spot_batch.GetBool())
+	{
+		if (!searchIgnoreLimits.ContainsPoint(testPoint))
+		{
+			pendingPoints.Append(testPoint);
+		}
+
+		return true;
+	}
+
+	darkModHidingSpot hidingSpot;
+
+	// Test if it is inside the exclusion bounds
+	if ( searchIgnoreLimits.ContainsPoint(testPoint) )
+	{
+		hidingSpot.quality = -1.0;
+		hidingSpot.hidingSpotTypes = NONE_HIDING_SPOT_TYPE;
+	}
+	else
+	{
+		// Not inside exclusion bounds, must test it
+		hidingSpot.hidingSpotTypes = TestHidingPoint
+			(
+			testPoint,
+			searchCenter,
+			searchRadius,
+			hidingHeight,
+			hidingSpotTypesAllowed,
+			p_ignoreEntity.GetEntity(),
+			hidingSpot.lightQuotient,
+			hidingSpot.qualityWithoutDistanceFactor,
+			hidingSpot.quality
+			);
+	}
+
+	// If there are any hiding qualities, insert a hiding spot
+	if ( hidingSpot.hidingSpotTypes != NONE_HIDING_SPOT_TYPE &&
+		hidingSpot.quality > 0.0 )
+	{
+		// Insert a hiding spot for this test point
+		hidingSpot.goal.areaNum = currentGridSearchAASAreaNum;
+		hidingSpot.goal.origin = testPoint;
+
+		// ensure area index is in hiding spot tree
+		if ( inout_p_hidingAreaNode == NULL )
+		{
+			inout_p_hidingAreaNode = inout_hidingSpots.getArea(currentGridSearchAASAreaNum);
+
+			if ( inout_p_hidingAreaNode == NULL )
+			{
+				inout_p_hidingAreaNode = inout_hidingSpots.insertArea(currentGridSearchAASAreaNum);
+				if ( inout_p_hidingAreaNode == NULL )
+				{
+					return false;
+				}
+			}
+		}
+
+		// Add spot under this index in the hiding spot tree
+		inout_hidingSpots.insertHidingSpot
+			(
+			inout_p_hidingAreaNode,
+			hidingSpot.goal,
+			hidingSpot.hidingSpotTypes,
+			hidingSpot.lightQuotient,
+			hidingSpot.qualityWithoutDistanceFactor,
+			hidingSpot.quality,
+			hidingSpotRedundancyDistance
+			);
+
+		//DM_LOG(LC_AI, LT_DEBUG)LOGSTRING("Found hiding spot within AAS area %d at (X:%f, Y:%f, Z:%f) with type bitflags %d, quality %f\r", currentGridSearchAASAreaNum, testPoint.x, testPoint.y, testPoint.z, hidingSpot.hidingSpotTypes, hidingSpot.quality);
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------
+
+bool CDarkmodAASHidingSpotFinder::testingCandidatesInsideVisibleAASArea
+(
+	CDarkmodHidingSpotTree& inout_hidingSpots,
+	int numPointsToTestThisPass,
+	int& inout_numPointsTestedThisPass
+)
+{
+	const CHidingSpotCandidateIndex& index = LAS.hidingSpotCandidateIndex;
+
+	int numCandidates = index.getNumCandidates(currentGridSearchAASAreaNum);
+	int maxCandidatesToTest = cv_ai_hiding_spot_area_candidates.GetInteger();
+
+	// No hiding spot area node yet used
+	TDarkmodHidingSpotAreaNode* p_hidingAreaNode = NULL;
+
+	// The candidates are sorted by cover, so we test the best ones first and can
+	// stop after maxCandidatesToTest of them
+	while (currentCandidateNum < numCandidates &&
+		(maxCandidatesToTest <= 0 || currentCandidatesTested < maxCandidatesToTest))
+	{
+		// See if we have filled our point quota
+		if (inout_numPointsTestedThisPass >= numPointsToTestThisPass)
+		{
+			// Filled point quota, but we need to keep iterating this area next time
+			return true;
+		}
+
+		const HidingSpotCandidate& candidate = index.getCandidate(currentGridSearchAASAreaNum, currentCandidateNum);
+		currentCandidateNum++;
+
+		// The grid covers the whole area, skip the points outside the search limits
+		if (candidate.origin.x < currentGridSearchBoundMins.x || candidate.origin.x > currentGridSearchBoundMaxes.x ||
+			candidate.origin.y < currentGridSearchBoundMins.y || candidate.origin.y > currentGridSearchBoundMaxes.y)
+		{
+			continue;
+		}
+
+		if (!testPointInsideVisibleAASArea(inout_hidingSpots, candidate.origin, p_hidingAreaNode))
+		{
+			return false;
+		}
+
+		// One more point tested
+		inout_numPointsTestedThisPass++;
+		currentCandidatesTested++;
+	}
+
+	// One more AAS area searched
+	numAASAreaIndicesSearched ++;
+
+	// Increase the area investigation counter
+	areasTestedThisPass++;
+
+	// Go back to iterating the list of AAS areas in this visible PVS area
+	searchState = EIteratingVisibleAASAreas;
+
+	// There may be more searching to do
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------
+
+bool CDarkmodAASHidingSpotFinder::testPendingPoints(CDarkmodHidingSpotTree& inout_hidingSpots)
+{
+	int numPoints = pendingPoints.Num();
+	if (numPoints == 0)
+	{
+		return true;
+	}
+
+	bool testOcclusion = (hidingSpotTypesAllowed & VISUAL_OCCLUSION_HIDING_SPOT_TYPE) != 0;
+
+	// The occlusion traces of all points in one batch, these run on the worker threads
+	if (testOcclusion)
+	{
+		pendingTraceRequests.SetNum(numPoints, false);
+		pendingTraceResults.SetNum(numPoints, false);
+
+		for (int i = 0; i < numPoints; i++)
+		{
+			clipTraceRequest_t& request = pendingTraceRequests[i];
+			request.start = hideFromPosition;
+			request.end = pendingPoints[i];
+			request.bounds.Zero();
+			request.contentMask = MASK_SOLID;
+			request.passEntity = NULL;
+		}
+
+		gameLocal.clip.TranslationBatch(pendingTraceResults.Ptr(), pendingTraceRequests.Ptr(), numPoints);
+	}
+
+	// The lighting queries and the tree stay on the game thread
+	TDarkmodHidingSpotAreaNode* p_hidingAreaNode = NULL;
+
+	for (int i = 0; i < numPoints; i++)
+	{
+		darkModHidingSpot hidingSpot;
+
+		hidingSpot.hidingSpotTypes = TestHidingPoint
+			(
+			pendingPoints[i],
+			searchCenter,
+			searchRadius,
+			hidingHeight,
+			hidingSpotTypesAllowed,
+			p_ignoreEntity.GetEntity(),
+			hidingSpot.lightQuotient,
+			hidingSpot.qualityWithoutDistanceFactor,
+			hidingSpot.quality,
+			testOcclusion ? &pendingTraceResults[i] : NULL
+			);
+
+		if (hidingSpot.hidingSpotTypes == NONE_HIDING_SPOT_TYPE || hidingSpot.quality <= 0.0)
+		{
+			continue;
+		}
+
+		hidingSpot.goal.areaNum = currentGridSearchAASAreaNum;
+		hidingSpot.goal.origin = pendingPoints[i];
+
+		// ensure area index is in hiding spot tree
+		if (p_hidingAreaNode == NULL)
+		{
+			p_hidingAreaNode = inout_hidingSpots.getArea(currentGridSearchAASAreaNum);
+
+			if (p_hidingAreaNode == NULL)
+			{
+				p_hidingAreaNode = inout_hidingSpots.insertArea(currentGridSearchAASAreaNum);
+				if (p_hidingAreaNode == NULL)
+				{
+					pendingPoints.SetNum(0, false);
+					return false;
+				}
+			}
+		}
+
+		inout_hidingSpots.insertHidingSpot
+			(
+			p_hidingAreaNode,
+			hidingSpot.goal,
+			hidingSpot.hidingSpotTypes,
+			hidingSpot.lightQuotient,
+			hidingSpot.qualityWithoutDistanceFactor,
+			hidingSpot.quality,
+			hidingSpotRedundancyDistance
+			);
+	}
+
+	pendingPoints.SetNum(0, false);
+
+	return true;
+}
+
 //----------------------------------------------------------------------------
 
 // Internal helper
@@ -855,7 +1077,8 @@ int CDarkmodAASHidingSpotFinder::TestHidingPoint
 	idEntity* p_ignoreEntity,
 	float& out_lightQuotient,
 	float& out_qualityWithoutDistance,
-	float& out_quality
+	float& out_quality,
+	const trace_t* p_occlusionResult
 )
 {
 	int out_hidingSpotTypesThatApply = NONE_HIDING_SPOT_TYPE;
@@ -905,16 +1128,28 @@ int CDarkmodAASHidingSpotFinder::TestHidingPoint
 		occlusionTestPoint.z += hidingHeight;
 
 		trace_t rayResult;
-		//DM_LOG(LC_AI, LT_DEBUG)LOGSTRING("Testing hiding-spot occlusion at point %f,%f,%f\n", testPoint.x, testPoint.y, testPoint.z);
-		if (gameLocal.clip.TracePoint 
-		(
-			rayResult, 
-			hideFromPosition,
-			testPoint,
-			//MASK_SOLID | MASK_WATER | MASK_OPAQUE,
-			MASK_SOLID,
-			NULL
-		))
+		bool occluded;
+
+		if (p_occlusionResult != NULL)
+		{
+			// Already traced in a batch
+			occluded = (p_occlusionResult->fraction < 1.0f);
+		}
+		else
+		{
+			//DM_LOG(LC_AI, LT_DEBUG)LOGSTRING("Testing hiding-spot occlusion at point %f,%f,%f\n", testPoint.x, testPoint.y, testPoint.z);
+			occluded = gameLocal.clip.TracePoint 
+			(
+				rayResult, 
+				hideFromPosition,
+				testPoint,
+				//MASK_SOLID | MASK_WATER | MASK_OPAQUE,
+				MASK_SOLID,
+				NULL
+			);
+		}
+
+		if (occluded)
 		{
 			// Some sort of occlusion
 			//DM_LOG(LC_AI, LT_DEBUG)LOGSTRING("Found hiding-spot occlusion at point %f,%f,%f, fraction of %f\n", testPoint.x, testPoint.y, testPoint.z, rayResult.fraction);
@@ -1263,6 +1498,13 @@ bool CDarkmodAASHidingSpotFinder::continueSearchForHidingSpots
 	// The number of points this pass
 	int numPointsTestedThisPass = 0;
 
+	// With the occlusion traces batched on the worker threads a point costs
+	// the game thread less, so test more of them per frame
+	if (cv_ai_hiding_spot_batch.GetBool())
+	{
+		numPointsToTestThisPass *= Max(cv_ai_hiding_spot_batch_scale.GetInteger(), 1);
+	}
+
 	// Call the interior function
 	if (!findMoreHidingSpots(inout_hidingSpots,	numPointsToTestThisPass, numPointsTestedThisPass))
 	{
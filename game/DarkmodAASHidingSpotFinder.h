@@ -130,6 +130,18 @@ protected:
 	idVec3 currentGridSearchBoundMaxes;
 	idVec3 currentGridSearchPoint;
 
+	// These are for iterating the precomputed candidates of a visible AAS area instead
+	// of the grid, see CHidingSpotCandidateIndex
+	int currentCandidateNum;
+	int currentCandidatesTested;
+
+	// The points of the current AAS area waiting for their batched occlusion
+	// traces. They are always tested before testingInsideVisibleAASArea returns, so
+	// they don't need to be saved.
+	idList<idVec3> pendingPoints;
+	idList<clipTraceRequest_t> pendingTraceRequests;
+	idList<trace_t> pendingTraceResults;
+
 	/*
 	* This internal method is used for finding hiding spots within an area that
 	* is visible from the hideFromPosition.
@@ -171,6 +183,8 @@ protected:
 	* @param out_lightQuotient The quotient 
 	* @param out_qualityWithoutDistance The quality without distance factored in
 	* @param out_quality Returns the quality of any hiding spot found as a ratio from 0.0 to 1.0 where 1.0 is perfect.
+	* @param p_occlusionResult If not NULL, the result of the occlusion trace from the hide from
+	*	position, which was already run in a batch.
 	*
 	* @return An integer with the bit flags for the allowed hiding spot characteristics
 	*   that were found to be true
@@ -185,7 +199,8 @@ protected:
 		idEntity* p_ignoreEntity,
 		float& out_lightQuotient,
 		float& out_qualityWithoutDistance,
-		float& out_quality
+		float& out_quality,
+		const trace_t* p_occlusionResult = NULL
 	);
 
 	/*!
@@ -268,6 +283,48 @@ protected:
 		int& inout_numPointsTestedThisPass
 	);
 
+	/*
+	* Same as testingInsideVisibleAASArea, but tests the best candidates of the
+	* LAS hiding spot candidate index for the area instead of the full grid.
+	*/
+	bool testingCandidatesInsideVisibleAASArea
+	(
+		CDarkmodHidingSpotTree& inout_hidingSpots,
+		int numPointsToTestThisPass,
+		int& inout_numPointsTestedThisPass
+	);
+
+	/*
+	* Iterates the grid of the current AAS area, called by testingInsideVisibleAASArea
+	*/
+	bool testingGridInsideVisibleAASArea
+	(
+		CDarkmodHidingSpotTree& inout_hidingSpots,
+		int numPointsToTestThisPass,
+		int& inout_numPointsTestedThisPass
+	);
+
+	/*
+	* Runs the occlusion traces of pendingPoints as one batch on the worker
+	* threads, then scores the points and inserts the hiding spots.
+	*
+	* @return false if the area could not be inserted into the tree
+	*/
+	bool testPendingPoints(CDarkmodHidingSpotTree& inout_hidingSpots);
+
+	/*
+	* Tests a point of the current AAS area and inserts it into the tree if it is
+	* a hiding spot. p_hidingAreaNode is the node of the area, NULL if not yet looked up.
+	*
+	* @return false if the area could not be inserted into the tree
+	*/
+	bool testPointInsideVisibleAASArea
+	(
+		CDarkmodHidingSpotTree& inout_hidingSpots,
+		const idVec3& testPoint,
+		TDarkmodHidingSpotAreaNode*& inout_p_hidingAreaNode
+	);
+
 	/*!
 	* This method resumes the hiding spot test where it
 	* left off and tests up to numPointsToTestThisPass
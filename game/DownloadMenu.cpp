@@ -728,7 +728,14 @@ idStr CDownloadMenu::GetMissionDownloadProgressString(int modIndex)
 			totalFraction += 0.10f * l10nDownload->GetProgressFraction();
 		}
 
-		return va("%0.1f%s", totalFraction*100, "% ");
+		double speed = download->GetDownloadSpeed();
+
+		if (l10nDownload)
+		{
+			speed += l10nDownload->GetDownloadSpeed();
+		}
+
+		return va("%0.1f%s %0.0f kB/s", totalFraction*100, "% ", speed / 1024);
 	}
 	case CDownload::SUCCESS:
 		return "100% ";
@@ -294,6 +294,17 @@ void idFuncEmitter::Save( idSaveGame *savefile ) const {
 	}
 }
 
+/*
+================
+idFuncEmitter::DefaultMaxThinkInterleave
+
+The particles are animated by the renderer, thinking only does LOD
+================
+*/
+int idFuncEmitter::DefaultMaxThinkInterleave( void ) const {
+	return 8;
+}
+
 /*
 ================
 idFuncEmitter::Think
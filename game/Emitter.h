@@ -62,6 +62,8 @@ public:
 	virtual void		Think( void );
 	virtual void		Present( void );
 
+	virtual int			DefaultMaxThinkInterleave( void ) const;
+
 	// switch to a new model
 	virtual void		SetModel( const char *modelname );
 
@@ -940,11 +940,14 @@ idEntity::idEntity()
 
 	spawnNode.SetOwner( this );
 	activeNode.SetOwner( this );
+	m_FrobNode.SetOwner( this );
 
 	snapshotNode.SetOwner( this );
 	snapshotSequence = -1;
 	snapshotBits = 0;
 
+	interpolationIndex = -1;
+
 	thinkFlags		= 0;
 	dormantStart	= 0;
 	cinematic		= false;
@@ -1022,6 +1025,9 @@ idEntity::idEntity()
 	m_LODHandle = 0;
 	m_DistCheckTimeStamp = 0;
 
+	m_MaxThinkInterleave = 0;
+	m_ScheduledThinkFrame = 0;
+
 	// by default active
 	m_MinLODBias = 0.0f;
 	m_MaxLODBias = 10.0f;
@@ -1487,6 +1493,10 @@ void idEntity::Spawn( void )
 
 	fl.solidForTeam = spawnArgs.GetBool( "solidForTeam", "0" );
 	fl.neverDormant = spawnArgs.GetBool( "neverDormant", "0" );
+
+	if ( DefaultMaxThinkInterleave() > 0 ) {
+		m_MaxThinkInterleave = spawnArgs.GetInt( "max_think_interleave", va( "%d", DefaultMaxThinkInterleave() ) );
+	}
 	fl.hidden = spawnArgs.GetBool( "hide", "0" );
 	if ( fl.hidden ) {
 		// make sure we're hidden, since a spawn function might not set it up right
@@ -1928,6 +1938,7 @@ idEntity::~idEntity( void )
 		BecomeInactive( thinkFlags );
 	}
 	activeNode.Remove();
+	m_FrobNode.Remove();
 
 	Signal( SIG_REMOVED );
 
@@ -2185,6 +2196,8 @@ void idEntity::Save( idSaveGame *savefile ) const
 
 	savefile->WriteInt(m_LODHandle);
 	savefile->WriteInt(m_DistCheckTimeStamp);
+	savefile->WriteInt(m_MaxThinkInterleave);
+	savefile->WriteInt(m_ScheduledThinkFrame);
 	savefile->WriteInt(m_LODLevel);
 	savefile->WriteInt(m_ModelLODCur);
 	savefile->WriteInt(m_SkinLODCur);
@@ -2319,6 +2332,7 @@ void idEntity::Restore( idRestoreGame *savefile )
 	savefile->ReadInt(m_FrobDistance);
 	savefile->ReadFloat(m_FrobBias);
 	savefile->ReadClipModel(m_FrobBox);
+	UpdateFrobableLink();
 
 	savefile->ReadBool(m_bIsClimbableRope);
 
@@ -2491,6 +2505,8 @@ void idEntity::Restore( idRestoreGame *savefile )
 
 	savefile->ReadUnsignedInt(m_LODHandle);
 	savefile->ReadInt(m_DistCheckTimeStamp);
+	savefile->ReadInt(m_MaxThinkInterleave);
+	savefile->ReadInt(m_ScheduledThinkFrame);
 	savefile->ReadInt(m_LODLevel);
 	savefile->ReadInt(m_ModelLODCur);
 	savefile->ReadInt(m_SkinLODCur);
@@ -2955,6 +2971,54 @@ void idEntity::SwapLODModel( const char *modelname )
 }
 
 
+/*
+================
+idEntity::DefaultMaxThinkInterleave
+================
+*/
+int idEntity::DefaultMaxThinkInterleave( void ) const {
+	return 0;
+}
+
+/*
+================
+idEntity::LODCheckDue
+================
+*/
+bool idEntity::LODCheckDue( void ) const {
+	if ( !m_LODHandle || m_DistCheckTimeStamp <= NOLOD ) {
+		return false;
+	}
+	const lod_data_t *lod = gameLocal.m_ModelGenerator->GetLODDataPtr( m_LODHandle );
+	return lod && lod->DistCheckInterval > 0 && ( gameLocal.time - m_DistCheckTimeStamp ) > lod->DistCheckInterval;
+}
+
+/*
+================
+idEntity::ThinksOnlyForLOD
+================
+*/
+bool idEntity::ThinksOnlyForLOD( void ) const {
+	return false;
+}
+
+/*
+================
+idEntity::CanThinkInParallel
+================
+*/
+bool idEntity::CanThinkInParallel( void ) const {
+	return false;
+}
+
+/*
+================
+idEntity::ParallelThink
+================
+*/
+void idEntity::ParallelThink( void ) {
+}
+
 /*
 ================
 idEntity::Think
@@ -4236,6 +4300,9 @@ void idEntity::Present(void)
 	if ( modelDefHandle == -1 ) {
 		modelDefHandle = gameRenderWorld->AddEntityDef( &renderEntity );
 	} else {
+		if ( gameLocal.interpolateTics ) {
+			gameLocal.InterpolateEntity( this );
+		}
 		gameRenderWorld->UpdateEntityDef( modelDefHandle, &renderEntity );
 	}
 
@@ -5994,6 +6061,8 @@ bool idEntity::RunPhysics( void ) {
 	trace_t		results;
 	bool		moved;
 
+	ai::AIBenchmarkTiming benchmarkTiming( ai::AIBenchmark::COST_PHYSICS );
+
 	// don't run physics if not enabled
 	if ( !( thinkFlags & TH_PHYSICS ) ) {
 		// however do update any animation controllers
@@ -8802,7 +8871,8 @@ idAnimatedEntity::idAnimatedEntity
 ================
 */
 idAnimatedEntity::idAnimatedEntity() :
-	lastUpdateTime(-1)
+	lastUpdateTime(-1),
+	preparedAnimationFrame(-1)
 {
 	animator.SetEntity( this );
 	damageEffects = NULL;
@@ -8904,6 +8974,50 @@ void idAnimatedEntity::ClientPredictionThink( void ) {
 	Present();
 }
 
+/*
+================
+idAnimatedEntity::CanThinkInParallel
+================
+*/
+bool idAnimatedEntity::CanThinkInParallel( void ) const {
+	return CanPrepareAnimation();
+}
+
+/*
+================
+idAnimatedEntity::CanPrepareAnimation
+
+Only visible animations and those of actors, which query their joints while thinking,
+are worth creating ahead. The dormancy check of tdm_ai_opt_noanims and the debug
+output of g_debugAnim in CreateFrame are not thread safe.
+================
+*/
+bool idAnimatedEntity::CanPrepareAnimation( void ) const {
+	if ( !( thinkFlags & TH_ANIMATE ) || !animator.ModelHandle() || fl.hidden ) {
+		return false;
+	}
+
+	if ( cv_ai_opt_noanims.GetBool() || g_debugAnim.GetInteger() != -1 ) {
+		return false;
+	}
+
+	// articulated figures set their pose while thinking without forcing an update
+	if ( GetPhysics()->IsType( idPhysics_AF::Type ) ) {
+		return false;
+	}
+
+	return IsType( idActor::Type ) || gameLocal.InPlayerPVS( const_cast<idAnimatedEntity *>( this ) );
+}
+
+/*
+================
+idAnimatedEntity::ParallelThink
+================
+*/
+void idAnimatedEntity::ParallelThink( void ) {
+	animator.PrepareFrame( gameLocal.time );
+}
+
 /*
 ================
 idAnimatedEntity::Think
@@ -8969,6 +9083,12 @@ void idAnimatedEntity::UpdateAnimation( void ) {
 
 	// the animation is updated
 	animator.ClearForceUpdate();
+
+	// create the new frame with the others at the end of the game frame
+	if ( preparedAnimationFrame != gameLocal.framenum && cv_anim_parallel.GetBool() ) {
+		preparedAnimationFrame = gameLocal.framenum;
+		gameLocal.AddAnimationToPrepare( this );
+	}
 }
 
 /*
@@ -9943,6 +10063,8 @@ void idEntity::LoadTDMSettings(void)
 
 		if( m_bFrobable && m_FrobBox )
 			m_FrobBox->SetContents(CONTENTS_FROBABLE);
+
+		UpdateFrobableLink();
 	}
 
 	// update the max frobdistance if necessary
@@ -10351,6 +10473,7 @@ void idEntity::SetFrobable( const bool bVal )
 	if (m_bFrobable == bVal) return; 
 
 	m_bFrobable = bVal;
+	UpdateFrobableLink();
 
 	// If this entity is currently being hilighted, make sure to un-frob it
 	if( !bVal )
@@ -10382,6 +10505,42 @@ void idEntity::SetFrobable( const bool bVal )
 	}
 }
 
+void idEntity::UpdateFrobableLink()
+{
+	if (!m_bFrobable)
+	{
+		m_FrobNode.Remove();
+	}
+	else if (!m_FrobNode.InList())
+	{
+		m_FrobNode.AddToEnd(gameLocal.frobableEntities);
+	}
+}
+
+bool idEntity::FrobClipModelsTouchBounds( const idBounds &bounds ) const
+{
+	// same test as idClip::ClipModelsTouchingBounds with a content mask of -1
+	const idBounds expanded = bounds.Expand( CM_BOX_EPSILON );
+
+	if ( m_FrobBox && m_FrobBox->IsLinked() && m_FrobBox->GetContents() 
+		&& m_FrobBox->GetAbsBounds().IntersectsBounds( expanded ) )
+	{
+		return true;
+	}
+
+	const idPhysics *phys = GetPhysics();
+	for ( int i = 0; i < phys->GetNumClipModels(); i++ )
+	{
+		const idClipModel *cm = phys->GetClipModel( i );
+		if ( cm && cm->IsLinked() && cm->GetContents() && cm->GetAbsBounds().IntersectsBounds( expanded ) )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void idEntity::Event_StimAdd(int stimType, float radius)
 {
 	AddStim(static_cast<StimType>(stimType), radius);
@@ -11318,6 +11477,7 @@ void idEntity::CheckAfterDetach( idEntity *ent )
 	if (bSetFrob)
 	{
 		ent->m_bFrobable = true;
+		ent->UpdateFrobableLink();
 	}
 
 	// Check if we should extinguish the attachment, like torches or lanterns
@@ -12627,13 +12787,8 @@ void idEntity::Event_GetLightInPVS( const float lightFalloff, const float lightD
 	int areaNum = gameRenderWorld->PointInArea( origin );
 
 	// Find all light entities, then check if they are in the same area as the player:
-	for( idEntity* ent = gameLocal.spawnedEntities.Next(); ent != NULL; ent = ent->spawnNode.Next() )
+	for( idLight* light = gameLocal.spawnedLights.Next(); light != NULL; light = light->lightNode.Next() )
 	{
-		if ( !ent || !ent->IsType( idLight::Type ) ) {
-			continue;
-		}
-
-		idLight* light = static_cast<idLight*>( ent );
 
 		// this makes it add all lights in the PVS, which is not good, albeit it makes leaning a bit better
 		//if ( gameLocal.InPlayerPVS( light ) ) {
@@ -13402,10 +13557,13 @@ bool idEntity::IsFriend(const idEntity *other) const
 	else
 	{
 		// angua: look up entity specific relation
-		EntityRelationsMap::const_iterator found = m_EntityRelations.find(other);
-		if (found != m_EntityRelations.end())
+		if (!m_EntityRelations.empty())
 		{
-			return (found->second > 0);
+			EntityRelationsMap::const_iterator found = m_EntityRelations.find(other);
+			if (found != m_EntityRelations.end())
+			{
+				return (found->second > 0);
+			}
 		}
 
 		// angua: no specific relation found, fall back to standard team relations
@@ -13427,10 +13585,13 @@ bool idEntity::IsNeutral(const idEntity *other) const
 	}
 
 	// angua: look up entity specific relation
-	EntityRelationsMap::const_iterator found = m_EntityRelations.find(other);
-	if (found != m_EntityRelations.end())
+	if (!m_EntityRelations.empty())
 	{
-		return (found->second == 0);
+		EntityRelationsMap::const_iterator found = m_EntityRelations.find(other);
+		if (found != m_EntityRelations.end())
+		{
+			return (found->second == 0);
+		}
 	}
 
 	// angua: no specific relation found, fall back to standard team relations
@@ -13457,10 +13618,13 @@ bool idEntity::IsEnemy(const idEntity *other ) const
 	}
 
 	// angua: look up entity specific relation
-	EntityRelationsMap::const_iterator found = m_EntityRelations.find(other);
-	if (found != m_EntityRelations.end())
+	if (!m_EntityRelations.empty())
 	{
-		return (found->second < 0);
+		EntityRelationsMap::const_iterator found = m_EntityRelations.find(other);
+		if (found != m_EntityRelations.end())
+		{
+			return (found->second < 0);
+		}
 	}
 
 	// angua: no specific relation found, fall back to standard team relations
@@ -260,6 +260,8 @@ public:
 	int						snapshotSequence;		// last snapshot this entity was in
 	int						snapshotBits;			// number of bits this entity occupied in the last snapshot
 
+	int						interpolationIndex;		// into gameLocal.interpolatedEntities, -1 if the entity isn't interpolated
+
 	idStr					name;					// name of entity
 	idDict					spawnArgs;				// key/value pairs used to spawn and initialize entity
 	idScriptObject			scriptObject;			// contains all script defined data for this entity
@@ -358,6 +360,11 @@ public:
 	**/
 	bool					m_bFrobable;
 
+	/**
+	* For being linked into gameLocal.frobableEntities while m_bFrobable is set
+	**/
+	idLinkList<idEntity>	m_FrobNode;
+
 	/**
 	* Set to true if the entity is a "simple" frobable like a door, lever, button
 	* These items can still be frobbed while doing things like shouldering bodies
@@ -434,6 +441,16 @@ public:
 	**/
 	int						m_DistCheckTimeStamp;
 
+	/**
+	* The most frames between two thinks outside the player PVS, see CThinkScheduler.
+	* 0 or 1 thinks every frame. Set by the spawnarg "max_think_interleave", which
+	* defaults to DefaultMaxThinkInterleave().
+	**/
+	int						m_MaxThinkInterleave;
+
+	// The frame the think scheduler lets this entity think again
+	int						m_ScheduledThinkFrame;
+
 	/**
 	* Current LOD (0 - normal, 1,2,3,4,5 LOD, 6 hidden). For entities
 	* hidden by MinLODBias/MaxLODBias, is -1 to mark it as hidden.
@@ -539,6 +556,19 @@ public:
 	// thinking
 	virtual void			Think( void );
 
+	// The default of m_MaxThinkInterleave. Only classes that evaluate their physics
+	// and animations at the absolute game time may skip thinks, so this is 0 here.
+	virtual int				DefaultMaxThinkInterleave( void ) const;
+
+	// Opt-in for the parallel think phase, see idGameLocal::RunParallelThinks. True if the
+	// entity has work to do in ParallelThink this frame.
+	virtual bool			CanThinkInParallel( void ) const;
+
+	// Runs on a worker thread before the entities think. It may only touch the entity's
+	// own physics and animation state: no events, spawnArgs, scripts, sounds, world queries
+	// or other entities. Everything else belongs to Think, which runs on the game thread.
+	virtual void			ParallelThink( void );
+
 	// Tels: If LOD is enabled on this entity, compute new LOD level and new alpha value.
 	// We pass in a pointer to the data (so the LODE can use shared data) as well as the distance,
 	// so the lode can pre-compute the distance.
@@ -558,6 +588,13 @@ public:
 	// SteveL #3770: Params removed. They are now determined in SwitchLOD itself to avoid code repetition
 	// as multiple classes now use LOD.
 	virtual	bool			SwitchLOD();
+
+	// True if LOD is enabled and its next distance check is due, see SwitchLOD
+	bool					LODCheckDue( void ) const;
+
+	// True if the entity is active only to check its LOD. CThinkScheduler skips its
+	// thinks until LODCheckDue(), so large numbers of LOD statics cost next to nothing.
+	virtual bool			ThinksOnlyForLOD( void ) const;
 	
 	// SteveL #3770: Handle changes of model due to LOD in a separate virtual function so that 
 	// SwitchLOD() can be used by all, while applying different methods for different animated classes.
@@ -927,6 +964,18 @@ public:
 	**/
 	virtual void SetFrobable( const bool val );
 
+	/**
+	* Links or unlinks this entity in gameLocal.frobableEntities according to m_bFrobable.
+	* Must be called whenever m_bFrobable is changed without SetFrobable.
+	**/
+	void UpdateFrobableLink();
+
+	/**
+	* True if one of the clip models the frob radius test considers, the physics
+	* clip models and the frob box, touches the given bounds
+	**/
+	bool FrobClipModelsTouchBounds( const idBounds &bounds ) const;
+
 	/**
 	* Return whether the entity is currently frobbed.
 	* Should be false at the beginning of the frame
@@ -1854,6 +1903,13 @@ public:
 	virtual void			ClientPredictionThink( void );
 	virtual void			Think( void );
 
+	// creates the animation frame ahead of Think
+	virtual bool			CanThinkInParallel( void ) const;
+	virtual void			ParallelThink( void );
+
+	// true if the animation frame may be created ahead on a worker thread
+	bool					CanPrepareAnimation( void ) const;
+
 	void					UpdateAnimation( void );
 
 	virtual idAnimator *	GetAnimator( void );
@@ -1943,6 +1999,9 @@ protected:
 	// The game time UpdateAnimation() has been called the last time
 	int						lastUpdateTime;
 
+	// The frame UpdateAnimation() queued the animation for idGameLocal::PrepareAnimations
+	int						preparedAnimationFrame;
+
 private:
 	void					Event_GetJointHandle( const char *jointname );
 	void 					Event_ClearAllJoints( void );
@@ -0,0 +1,139 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+
+#include "precompiled_game.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "FrameArena.h"
+#include "Game_local.h"
+
+// keeps the allocations after the block header 16 byte aligned
+#define FRAME_ARENA_HEADER_SIZE		( ( sizeof( CFrameArena::Block ) + 15 ) & ~15 )
+
+CFrameArena::CFrameArena() :
+	_blocks(NULL),
+	_current(NULL),
+	_numBlocks(0)
+{}
+
+CFrameArena::~CFrameArena()
+{
+	Shutdown();
+}
+
+void CFrameArena::Shutdown()
+{
+	while (_blocks != NULL)
+	{
+		Block* next = _blocks->next;
+		Mem_Free16(_blocks);
+		_blocks = next;
+	}
+
+	_current = NULL;
+	_numBlocks = 0;
+}
+
+byte* CFrameArena::BlockBase(Block* block)
+{
+	return reinterpret_cast<byte*>(block) + FRAME_ARENA_HEADER_SIZE;
+}
+
+void* CFrameArena::Alloc(int bytes)
+{
+	bytes = (bytes + 15) & ~15;
+
+	if (_current != NULL && _current->size - _current->used >= bytes)
+	{
+		byte* buf = BlockBase(_current) + _current->used;
+		_current->used += bytes;
+		return buf;
+	}
+
+	// Advance to the next block, a new one goes in front of it if it is missing or too small
+	Block* next = (_current != NULL) ? _current->next : _blocks;
+
+	if (next == NULL || next->size < bytes)
+	{
+		int size = Max(static_cast<int>(BLOCK_SIZE), bytes);
+
+		Block* block = static_cast<Block*>(Mem_Alloc16(size + FRAME_ARENA_HEADER_SIZE));
+
+		if (block == NULL)
+		{
+			gameLocal.Error("CFrameArena::Alloc: Mem_Alloc16 of %d bytes failed", size);
+		}
+
+		block->size = size;
+		block->next = next;
+
+		if (_current != NULL)
+		{
+			_current->next = block;
+		}
+		else
+		{
+			_blocks = block;
+		}
+
+		next = block;
+		_numBlocks++;
+	}
+
+	_current = next;
+	_current->used = bytes;
+
+	return BlockBase(_current);
+}
+
+void CFrameArena::Reset()
+{
+	_current = _blocks;
+
+	if (_current != NULL)
+	{
+		_current->used = 0;
+	}
+}
+
+CFrameArena::Mark CFrameArena::GetMark() const
+{
+	Mark mark;
+
+	mark.block = _current;
+	mark.used = (_current != NULL) ? _current->used : 0;
+
+	return mark;
+}
+
+void CFrameArena::FreeToMark(const Mark& mark)
+{
+	if (mark.block == NULL)
+	{
+		// Nothing was allocated when the mark was taken
+		Reset();
+		return;
+	}
+
+	_current = mark.block;
+	_current->used = mark.used;
+}
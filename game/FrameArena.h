@@ -0,0 +1,102 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+
+#ifndef __FRAME_ARENA_H__
+#define __FRAME_ARENA_H__
+
+#include <new>		// placement new for CFrameArenaAllocator
+
+/**
+ * Linear allocator for the temporary data of one game frame, like the R_FrameAlloc
+ * blocks of the renderer. Allocations are only bumped off a chain of blocks which are
+ * kept from frame to frame, nothing is freed individually. CFrameArenaScope gives back
+ * everything allocated while it was in scope, the rest goes back at the start of the
+ * next game frame. Only for the main game thread.
+ */
+class CFrameArena
+{
+private:
+	struct Block;
+
+public:
+	struct Mark
+	{
+		Block*	block;
+		int		used;
+	};
+
+	CFrameArena();
+	~CFrameArena();
+
+	// Frees all blocks
+	void Shutdown();
+
+	// Returns 16 byte aligned memory which is not cleared
+	void* Alloc(int bytes);
+
+	// Gives back all allocations, called at the start of each game frame
+	void Reset();
+
+	Mark GetMark() const;
+
+	// Gives back everything allocated after the mark was taken
+	void FreeToMark(const Mark& mark);
+
+	int GetNumBlocks() const { return _numBlocks; }
+
+private:
+	struct Block
+	{
+		Block*	next;
+		int		size;
+		int		used;
+	};
+
+	static const int BLOCK_SIZE = 256 * 1024;
+
+	Block*	_blocks;		// chain of all blocks
+	Block*	_current;		// block allocations are made from
+	int		_numBlocks;
+
+	static byte* BlockBase(Block* block);
+};
+
+/**
+ * Takes a mark of the game frame arena and frees to it when going out of scope.
+ */
+class CFrameArenaScope
+{
+public:
+	CFrameArenaScope(CFrameArena& arena) :
+		_arena(arena),
+		_mark(arena.GetMark())
+	{}
+
+	~CFrameArenaScope()
+	{
+		_arena.FreeToMark(_mark);
+	}
+
+private:
+	CFrameArena&		_arena;
+	CFrameArena::Mark	_mark;
+};
+
+#endif /* __FRAME_ARENA_H__ */
@@ -110,6 +110,7 @@ void tdmFuncShooter::Spawn()
 	{
 		//DM_LOG(LC_STIM_RESPONSE, LT_INFO)LOGSTRING("tdmFuncShooter is requiring stim %d\r", _requiredStim);
 		GetPhysics()->SetContents( GetPhysics()->GetContents() | CONTENTS_RESPONSE );
+		gameLocal.m_StimResponseBroadphase.MarkDirty(this);
 	}
 }
 
@@ -65,6 +65,9 @@ public:
 	*/
 	virtual void		stimulate(StimType stimId);
 
+	// The stim this shooter is waiting for, ST_DEFAULT if none
+	StimType			GetRequiredStim() const { return _requiredStim; }
+
 private:
 	// Calculates the next time this shooter should fire
 	void				setupNextFireTime();
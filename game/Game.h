@@ -356,6 +356,9 @@ class idUserInterfaceManager;
 class idDeclManager;
 class idAASFileManager;
 class idCollisionModelManager;
+class idFrameProfiler;
+class idPerfSuite;
+class idJobSystem;
 
 typedef struct {
 
@@ -373,6 +376,9 @@ typedef struct {
 	idDeclManager *				declManager;			// declaration manager
 	idAASFileManager *			AASFileManager;			// AAS file manager
 	idCollisionModelManager *	collisionModelManager;	// collision model manager
+	idFrameProfiler *			frameProfiler;			// scoped profile markers
+	idPerfSuite *				perfSuite;				// collects benchmark results
+	idJobSystem *				jobSystem;				// worker threads
 
 } gameImport_t;
 
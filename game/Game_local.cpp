@@ -80,6 +80,9 @@ idUserInterfaceManager *	uiManager = NULL;
 idDeclManager *				declManager = NULL;
 idAASFileManager *			AASFileManager = NULL;
 idCollisionModelManager *	collisionModelManager = NULL;
+idFrameProfiler *			frameProfiler = NULL;
+idPerfSuite *				perfSuite = NULL;
+idJobSystem *				jobSystem = NULL;
 idCVar *					idCVar::staticVars = NULL;
 
 idCVar com_forceGenericSIMD( "com_forceGenericSIMD", "0", CVAR_BOOL|CVAR_SYSTEM, "force generic platform independent SIMD" );
@@ -163,6 +166,9 @@ extern "C" gameExport_t *GetGameAPI( gameImport_t *import ) {
 		declManager					= import->declManager;
 		AASFileManager				= import->AASFileManager;
 		collisionModelManager		= import->collisionModelManager;
+		frameProfiler				= import->frameProfiler;
+		perfSuite					= import->perfSuite;
+		jobSystem					= import->jobSystem;
 	}
 	else {
 		// Wrong game version, throw a meaningful error rather than leaving
@@ -180,6 +186,7 @@ extern "C" gameExport_t *GetGameAPI( gameImport_t *import ) {
 	idLib::common				= common;
 	idLib::cvarSystem			= cvarSystem;
 	idLib::fileSystem			= fileSystem;
+	idLib::perfSuite			= perfSuite;
 
 	// setup export interface
 	gameExport.version = GAME_API_VERSION;
@@ -262,6 +269,8 @@ void idGameLocal::Clear( void )
 	m_Timer.Clear();
 	m_StimEntity.Clear();
 	m_RespEntity.Clear();
+	m_StimResponseBroadphase.Clear();
+	m_StimResponseProfiler.Clear();
 
 	m_sndPropLoader = &g_SoundPropLoader;
 	m_sndProp = &g_SoundProp;
@@ -292,6 +301,15 @@ void idGameLocal::Clear( void )
 	m_guiError.Clear();
 
 	m_AreaManager.Clear();
+	m_VisualScanScheduler.Clear();
+	m_AIBenchmark.Clear();
+	idIK_Walk::ClearFootTraces();
+	idProjectile::ClearFlights();
+	m_ThinkScheduler.Clear();
+	m_PhysicsIslands.Clear();
+	m_ParallelThinkers.Clear();
+	m_AnimationsToPrepare.Clear();
+	m_PreparedAnimations.Clear();
 	m_ConversationSystem.reset();
 
 	if (m_ModelGenerator)
@@ -324,6 +342,13 @@ void idGameLocal::Clear( void )
 
 	m_uniqueMessageTag = 0; // grayman #3355
 
+	spawnModelMedia.Clear();
+	spawningMapEntities = false;
+
+	interpolateTics = false;
+	ticClockTicks = 0.0;
+	interpolatedViewFrame = -1;
+
 	m_spyglassOverlay = 0; // grayman #3807 - no need to save/restore
 
 	m_InterMissionTriggers.Clear();
@@ -342,6 +367,11 @@ void idGameLocal::Clear( void )
 	spawnedEntities.Clear();
 	activeEntities.Clear();
 	spawnedAI.Clear();
+	spawnedActors.Clear();
+	frobableEntities.Clear();
+	spawnedLights.Clear();
+	spawnedBinaryMovers.Clear();
+	interpolatedEntities.Clear();
 	numEntitiesToDeactivate = 0;
 	sortPushers = false;
 	sortTeamMasters = false;
@@ -362,6 +392,9 @@ void idGameLocal::Clear( void )
 	smokeParticles = NULL;
 	editEntities = NULL;
 	entityHash.Clear( 1024, MAX_GENTITIES );
+	for ( i = 0; i < MAX_GENTITIES; i++ ) {
+		entityNames[i].Clear();
+	}
 	inCinematic = false;
 	cinematicSkipTime = 0;
 	cinematicStopTime = 0;
@@ -403,6 +436,8 @@ void idGameLocal::Clear( void )
 	memset( clientEntityStates, 0, sizeof( clientEntityStates ) );
 	memset( clientPVS, 0, sizeof( clientPVS ) );
 	memset( clientSnapshots, 0, sizeof( clientSnapshots ) );
+	memset( clientEntityPriority, 0, sizeof( clientEntityPriority ) );
+	ClearSnapshotStats();
 
 	eventQueue.Init();
 	savedEventQueue.Init();
@@ -763,6 +798,7 @@ void idGameLocal::Shutdown( void ) {
 	// Clear http connection
 	m_HttpConnection.reset();
 	m_GuiMessages.Clear();
+	m_FrameArena.Shutdown();
 
 	aasList.DeleteContents( true );
 	aasNames.Clear();
@@ -803,6 +839,9 @@ void idGameLocal::Shutdown( void ) {
 	// shut down the animation manager
 	animationLib.Shutdown();
 
+	// write the pending log lines and end the log writer thread
+	g_Global.Shutdown();
+
 	Printf( "--------------------------------------\n" );
 
 #ifdef GAME_DLL
@@ -1478,6 +1517,21 @@ void idGameLocal::SetServerInfo( const idDict &_serverInfo ) {
 }
 
 
+/*
+===================
+idGameLocal::LoadStageDone
+
+Prints the time since stageStart with com_showLoadStages and starts the next stage
+===================
+*/
+void idGameLocal::LoadStageDone( const char *stage, int &stageStart ) const {
+	int now = Sys_Milliseconds();
+	if ( cvarSystem->GetCVarBool( "com_showLoadStages" ) ) {
+		Printf( "%6d msec   %s\n", now - stageStart, stage );
+	}
+	stageStart = now;
+}
+
 /*
 ===================
 idGameLocal::LoadMap
@@ -1536,8 +1590,11 @@ void idGameLocal::LoadMap( const char *mapName, int randseed ) {
 	}
 	mapFileName = mapFile->GetName();
 
+	int stageStart = Sys_Milliseconds();
+
 	// load the collision map
 	collisionModelManager->LoadMap( mapFile );
+	LoadStageDone( "collision models", stageStart );
 
 	numClients = 0;
 
@@ -1550,6 +1607,12 @@ void idGameLocal::LoadMap( const char *mapName, int randseed ) {
 	spawnedEntities.Clear();
 	activeEntities.Clear();
 	spawnedAI.Clear();
+	spawnedActors.Clear();
+	frobableEntities.Clear();
+	spawnedLights.Clear();
+	spawnedBinaryMovers.Clear();
+	interpolatedEntities.Clear();
+	interpolatedViewFrame = -1;
 	numEntitiesToDeactivate = 0;
 	sortTeamMasters = false;
 	sortPushers = false;
@@ -1615,16 +1678,38 @@ void idGameLocal::LoadMap( const char *mapName, int randseed ) {
 	playerPVS.i = -1;
 	playerConnectedAreas.i = -1;
 
+	stageStart = Sys_Milliseconds();
+
 	// load navigation system for all the different monster sizes
 	for( i = 0; i < aasNames.Num(); i++ ) {
 		aasList[ i ]->Init( idStr( mapFileName ).SetFileExtension( aasNames[ i ] ).c_str(), mapFile->GetGeometryCRC() );
 	}
+	LoadStageDone( "aas", stageStart );
+
+	// the routing caches of the sizes are independent of each other, they are set up
+	// concurrently after the files (which need the file system) have been loaded
+	const int numAAS = aasList.Num();
+	idList<int> numPrecomputed;
+	numPrecomputed.SetNum( numAAS );
+
+#pragma omp parallel for if ( numAAS > 1 ) schedule( dynamic, 1 )
+	for ( int j = 0; j < numAAS; j++ ) {
+		numPrecomputed[j] = aasList[j]->PrecomputeRoutingCache();
+	}
+
+	for ( i = 0; i < numAAS; i++ ) {
+		if ( numPrecomputed[i] > 0 ) {
+			Printf( "%s: precomputed %d portal routing caches\n", aasNames[i].c_str(), numPrecomputed[i] );
+		}
+	}
+	LoadStageDone( "aas routing caches", stageStart );
 
 	/*!
 	* The Dark Mod LAS: Init the Light Awareness System
 	* This must occur AFTER the AAS list is loaded
 	*/
 	LAS.initialize();
+	LoadStageDone( "light awareness system", stageStart );
 
 	// clear the smoke particle free list
 	smokeParticles->Init();
@@ -2120,6 +2205,16 @@ bool idGameLocal::InitFromSaveGame( const char *mapName, idRenderWorld *renderWo
 		assert( ent );
 		if ( ent ) {
 			ent->spawnNode.AddToEnd( spawnedEntities );
+
+			// spawnedActors, spawnedLights and spawnedBinaryMovers aren't saved,
+			// they are rebuilt from the spawned entities
+			if ( ent->IsType( idActor::Type ) ) {
+				static_cast<idActor *>( ent )->actorNode.AddToEnd( spawnedActors );
+			} else if ( ent->IsType( idLight::Type ) ) {
+				static_cast<idLight *>( ent )->lightNode.AddToEnd( spawnedLights );
+			} else if ( ent->IsType( idMover_Binary::Type ) ) {
+				static_cast<idMover_Binary *>( ent )->binaryMoverNode.AddToEnd( spawnedBinaryMovers );
+			}
 		}
 	}
 
@@ -2341,6 +2436,7 @@ bool idGameLocal::InitFromSaveGame( const char *mapName, idRenderWorld *renderWo
 	{
 		m_RespEntity[i].Restore(&savegame);
 	}
+	m_StimResponseBroadphase.Invalidate();
 
 	m_EscapePointManager->Restore(&savegame);
 
@@ -2420,14 +2516,17 @@ void idGameLocal::MapClear( bool clearClients ) {
 	}
 
 	entityHash.Clear( 1024, MAX_GENTITIES );
+	for ( i = clearClients ? 0 : MAX_CLIENTS; i < MAX_GENTITIES; i++ ) {
+		entityNames[ i ].Clear();
+	}
 
 	if ( !clearClients ) {
 		// add back the hashes of the clients
 		for ( i = 0; i < MAX_CLIENTS; i++ ) {
-			if ( !entities[ i ] ) {
+			if ( !entities[ i ] || !entityNames[ i ].IsValid() ) {
 				continue;
 			}
-			entityHash.Add( entityHash.GenerateKey( entities[ i ]->name.c_str(), true ), i );
+			entityHash.Add( entityHash.GenerateKey( entityNames[ i ].GetHash(), 0 ), i );
 		}
 	}
 
@@ -2457,6 +2556,10 @@ void idGameLocal::MapShutdown( void ) {
 	Printf( "--------- Game Map Shutdown ----------\n" );
 	gamestate = GAMESTATE_SHUTDOWN;
 
+	// in case an error aborted SpawnMapEntities
+	spawningMapEntities = false;
+	spawnModelMedia.Clear();
+
 	if ( gameRenderWorld ) {
 		// clear any debug lines, text, and polygons
 		gameRenderWorld->DebugClearLines( 0 );
@@ -2506,6 +2609,7 @@ void idGameLocal::MapShutdown( void ) {
 	}
 
 	m_DifficultyManager.Clear();
+	m_AIBenchmark.Clear();
 
 	if (m_ModelGenerator != NULL)
 	{
@@ -2693,6 +2797,14 @@ void idGameLocal::CacheDictionaryMedia( const idDict *dict ) {
 
 	kv = dict->MatchPrefix( "model" );
 	while( kv ) {
+		if ( spawningMapEntities && kv->GetValue().Length() ) {
+			bool *cached;
+			if ( spawnModelMedia.Get( kv->GetValue(), &cached ) ) {
+				kv = dict->MatchPrefix( "model", kv );
+				continue;
+			}
+			spawnModelMedia.Set( kv->GetValue(), true );
+		}
 		if ( kv->GetValue().Length() ) {
 			declManager->MediaPrint( "CacheDictionaryMedia - Precaching model %s\n", kv->GetValue().c_str() );
 			// precache model/animations
@@ -3138,6 +3250,178 @@ const idVec3 &idGameLocal::GetGravity( void ) const {
 	return gravity;
 }
 
+/*
+================
+idGameLocal::RunParallelThinks
+
+  Runs the ParallelThink of the active entities that opted in and think this frame
+  on the worker threads, spread by OpenMP like the parallel interaction creation
+  in the renderer.
+================
+*/
+void idGameLocal::RunParallelThinks( void ) {
+	idEntity *ent;
+
+	if ( !cv_think_parallel.GetBool() ) {
+		return;
+	}
+
+	m_ParallelThinkers.SetNum( 0, false );
+
+	for ( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+		if ( g_cinematic.GetBool() && inCinematic && !ent->cinematic ) {
+			continue;
+		}
+		if ( !m_ThinkScheduler.WillThink( ent ) || !ent->CanThinkInParallel() ) {
+			continue;
+		}
+		m_ParallelThinkers.Append( ent );
+	}
+
+	const int numThinkers = m_ParallelThinkers.Num();
+
+#pragma omp parallel for if ( numThinkers > 1 ) schedule( dynamic, 4 )
+	for ( int i = 0; i < numThinkers; i++ ) {
+		m_ParallelThinkers[i]->ParallelThink();
+	}
+}
+
+/*
+================
+idGameLocal::SolveArticulatedFigures
+
+  Solves the next physics step of the moving articulated figures that think this
+  frame on the worker threads. Each figure is solved with its own LCP and only touches
+  its own bodies and constraints. The contacts are found on the game thread first.
+  Figures whose bounds touch another figure would knock each other around while they
+  run their physics, so these islands are left to the serial thinks. The rest of the
+  step runs in idPhysics_AF::Evaluate when the entity thinks, which solves again if
+  anything changed the figure in between.
+================
+*/
+void idGameLocal::SolveArticulatedFigures( void ) {
+	idEntity *ent;
+	idList<idEntity *> candidates;
+	idList<idBounds> bounds;
+	idList<bool> touching;
+	int i, j;
+
+	m_SolvedAFEntities.SetNum( 0, false );
+	m_SolvedAFs.SetNum( 0, false );
+
+	if ( !af_parallel.GetBool() || ( g_cinematic.GetBool() && inCinematic ) ) {
+		return;
+	}
+
+	for ( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+		if ( !( ent->thinkFlags & TH_PHYSICS ) || !ent->GetPhysics()->IsType( idPhysics_AF::Type ) ) {
+			continue;
+		}
+		// RunPhysics evaluates the team master first
+		if ( ent->GetTeamMaster() && ent->GetTeamMaster() != ent ) {
+			continue;
+		}
+		if ( !m_ThinkScheduler.WillThink( ent ) || !static_cast<idPhysics_AF *>( ent->GetPhysics() )->CanPrepareStep() ) {
+			continue;
+		}
+		candidates.Append( ent );
+		bounds.Append( ent->GetPhysics()->GetAbsBounds().Expand( CM_BOX_EPSILON ) );
+		touching.Append( false );
+	}
+
+	// figures that touch another one are in the same island
+	for ( i = 0; i < candidates.Num(); i++ ) {
+		for ( j = i + 1; j < candidates.Num(); j++ ) {
+			if ( bounds[i].IntersectsBounds( bounds[j] ) ) {
+				touching[i] = touching[j] = true;
+			}
+		}
+	}
+
+	for ( i = 0; i < candidates.Num(); i++ ) {
+		if ( touching[i] ) {
+			continue;
+		}
+
+		ent = candidates[i];
+		idPhysics_AF *physics = static_cast<idPhysics_AF *>( ent->GetPhysics() );
+
+		// same time step as RunPhysics
+		int startTime = ent->IsType( idAI::Type ) ? static_cast<idAI *>( ent )->m_lastThinkTime : previousTime;
+
+		if ( physics->PrepareStep( time - startTime, time ) ) {
+			m_SolvedAFEntities.Alloc() = ent;
+			m_SolvedAFs.Append( physics );
+		}
+	}
+
+	const int numFigures = m_SolvedAFs.Num();
+
+#pragma omp parallel for if ( numFigures > 1 ) schedule( dynamic, 1 )
+	for ( i = 0; i < numFigures; i++ ) {
+		m_SolvedAFs[i]->SolvePreparedStep();
+	}
+}
+
+/*
+================
+idGameLocal::DiscardSolvedArticulatedFigures
+================
+*/
+void idGameLocal::DiscardSolvedArticulatedFigures( void ) {
+	for ( int i = 0; i < m_SolvedAFEntities.Num(); i++ ) {
+		idEntity *ent = m_SolvedAFEntities[i].GetEntity();
+
+		// removed during the thinks
+		if ( ent != NULL && ent->GetPhysics()->IsType( idPhysics_AF::Type ) ) {
+			static_cast<idPhysics_AF *>( ent->GetPhysics() )->DiscardPreparedStep();
+		}
+	}
+
+	m_SolvedAFEntities.SetNum( 0, false );
+	m_SolvedAFs.SetNum( 0, false );
+}
+
+/*
+================
+idGameLocal::AddAnimationToPrepare
+================
+*/
+void idGameLocal::AddAnimationToPrepare( idAnimatedEntity *ent ) {
+	m_AnimationsToPrepare.Alloc() = ent;
+}
+
+/*
+================
+idGameLocal::PrepareAnimations
+
+  Creates the animation frames of the entities whose animation changed during the
+  thinks and events of this frame on the worker threads, before the renderer and
+  the physics of the next frame read them. Each animator only blends its own joints.
+================
+*/
+void idGameLocal::PrepareAnimations( void ) {
+	m_PreparedAnimations.SetNum( 0, false );
+
+	for ( int i = 0; i < m_AnimationsToPrepare.Num(); i++ ) {
+		idAnimatedEntity *ent = m_AnimationsToPrepare[i].GetEntity();
+
+		// removed during the events, or not worth it
+		if ( ent != NULL && ent->CanPrepareAnimation() ) {
+			m_PreparedAnimations.Append( ent );
+		}
+	}
+
+	m_AnimationsToPrepare.SetNum( 0, false );
+
+	const int numAnimations = m_PreparedAnimations.Num();
+
+#pragma omp parallel for if ( numAnimations > 1 ) schedule( dynamic, 2 )
+	for ( int i = 0; i < numAnimations; i++ ) {
+		m_PreparedAnimations[i]->GetAnimator()->PrepareFrame( time );
+	}
+}
+
 /*
 ================
 idGameLocal::SortActiveEntityList
@@ -3211,6 +3495,8 @@ idGameLocal::RunFrame
 ================
 */
 gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
+	idScopedMemTag memTag( MEMTAG_GAME );
+	PROFILE_SCOPE( "idGameLocal::RunFrame" );
 	idEntity *	ent;
 	int			num(-1);
 	float		ms;
@@ -3224,6 +3510,9 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 	g_Global.m_Frame = curframe;
 	DM_LOG(LC_FRAME, LT_INFO)LOGSTRING("Frame start\r");
 
+	// Give back the temporary allocations of the last frame
+	m_FrameArena.Reset();
+
 #ifdef _DEBUG
 	if ( isMultiplayer ) {
 		assert( !isClient );
@@ -3284,6 +3573,13 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 			}
 			realClientTime = time;
 
+			// com_fixedTic already draws every game frame at its own time
+			interpolateTics = !com_fixedTic && !isMultiplayer && cvarSystem->GetCVarBool( "com_interpolateTics" );
+			ticClockTicks = sys->GetClockTicks();
+
+			// drive the scenario of a running tdm_ai_benchmark
+			m_AIBenchmark.BeginFrame();
+
 #ifdef GAME_DLL
 			// allow changing SIMD usage on the fly
 			if ( com_forceGenericSIMD.IsModified() ) {
@@ -3300,6 +3596,11 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 				view = player->GetRenderView();
 				if ( view ) {
 					gameRenderWorld->SetRenderView( view );
+
+					// the view of the previous tic, which Draw moves from
+					interpolatedViewOrigin = view->vieworg;
+					interpolatedViewAxis = view->viewaxis;
+					interpolatedViewFrame = framenum;
 				}
 			}
 
@@ -3322,7 +3623,10 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 			UpdateGravity();
 
 			// create a merged pvs for all players
-			SetupPlayerPVS();
+			{
+				PROFILE_SCOPE( "SetupPlayerPVS" );
+				SetupPlayerPVS();
+			}
 
 			idTimer lasTimer;
 			lasTimer.Clear();
@@ -3330,10 +3634,32 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 			// The Dark Mod
 			// 10/9/2005: SophisticatedZombie
 			// Update the Light Awareness System
-			LAS.updateLASState();
+			{
+				PROFILE_SCOPE( "LAS" );
+				LAS.updateLASState();
+			}
 			lasTimer.Stop();
 			DM_LOG(LC_LIGHT, LT_INFO)LOGSTRING("Time to update LAS: %lf\r", lasTimer.Milliseconds());
 
+			{
+				PROFILE_SCOPE( "AI queries" );
+
+				// Trace the AI visual scans queued last frame
+				{
+					ai::AIBenchmarkTiming benchmarkTiming( ai::AIBenchmark::COST_VISUAL_SCAN );
+					m_VisualScanScheduler.RunFrame();
+				}
+
+				// Trace the feet of the walking actors queued last frame
+				idIK_Walk::RunFootTraces();
+
+				// Set up the AI routes queued last frame
+				ai::AIBenchmarkTiming benchmarkTiming( ai::AIBenchmark::COST_PATHING );
+				for ( int i = 0; i < aasList.Num(); i++ ) {
+					aasList[i]->RunRouteQueries( cv_ai_route_queries.GetInteger() );
+				}
+			}
+
 			unsigned long ticks = static_cast<unsigned long>(sys->GetClockTicks());
 
 			// Tick the timers. Should be done before stim/response, just to be safe. :)
@@ -3351,6 +3677,21 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 			timer_think.Clear();
 			timer_think.Start();
 
+			m_ThinkScheduler.BeginFrame();
+
+			{
+				PROFILE_SCOPE( "RunParallelThinks" );
+				RunParallelThinks();
+			}
+
+			{
+				PROFILE_SCOPE( "SolveArticulatedFigures" );
+				ai::AIBenchmarkTiming benchmarkTiming( ai::AIBenchmark::COST_PHYSICS );
+				SolveArticulatedFigures();
+			}
+
+			idProfileScope thinkScope( "Think" );
+
 			// let entities think
 			if ( g_timeentities.GetFloat() ) {
 				num = 0;
@@ -3363,6 +3704,9 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 						}
 						continue;
 					}
+					if ( !m_ThinkScheduler.ShouldThink( ent ) ) {
+						continue;
+					}
 					timer_singlethink.Clear();
 					timer_singlethink.Start();
 					ent->Think();
@@ -3386,18 +3730,29 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 							}
 							continue;
 						}
+						if ( !m_ThinkScheduler.ShouldThink( ent ) ) {
+							continue;
+						}
 						ent->Think();
 						num++;
 					}
 				} else {
 					num = 0;
 					for( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+						if ( !m_ThinkScheduler.ShouldThink( ent ) ) {
+							continue;
+						}
 						ent->Think();
 						num++;
 					}
 				}
 			}
 
+			{
+				PROFILE_SCOPE( "Projectile flights" );
+				idProjectile::RunFlights();
+			}
+
 			// remove any entities that have stopped thinking
 			if ( numEntitiesToDeactivate ) {
 				idEntity *next_ent;
@@ -3413,7 +3768,14 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 				numEntitiesToDeactivate = 0;
 			}
 
+			// the figures that didn't run their physics keep their state for the savegames
+			DiscardSolvedArticulatedFigures();
+
+			// put the piles that have settled to rest
+			m_PhysicsIslands.Update();
+
 			timer_think.Stop();
+			thinkScope.End();
 		
 			//DM_LOG(LC_ENTITY, LT_INFO)LOGSTRING("Thinking timer: %lfms\r", timer_think.Milliseconds());
 
@@ -3421,7 +3783,10 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 			timer_events.Start();
 
 			// service any pending events
-			idEvent::ServiceEvents();
+			{
+				PROFILE_SCOPE( "ServiceEvents" );
+				idEvent::ServiceEvents();
+			}
 
 			timer_events.Stop();
 
@@ -3431,6 +3796,19 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 			// grayman #3857 - Process the active searches
 			m_searchManager->ProcessSearches();
 
+			// Propagate the suspicious sounds made this frame
+			{
+				ai::AIBenchmarkTiming benchmarkTiming( ai::AIBenchmark::COST_SOUND_PROP );
+				m_sndProp->ProcessQueue();
+			}
+
+			// Create the animation frames changed this frame, needs the player pvs
+			{
+				PROFILE_SCOPE( "PrepareAnimations" );
+				ai::AIBenchmarkTiming benchmarkTiming( ai::AIBenchmark::COST_ANIMATION );
+				PrepareAnimations();
+			}
+
 			// free the player pvs
 			FreePlayerPVS();
 
@@ -3457,6 +3835,9 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 					timer_think.Milliseconds(), timer_events.Milliseconds(), num );
 			}
 
+			// record the frame of a running tdm_ai_benchmark
+			m_AIBenchmark.EndFrame();
+
 			// build the return value
 			ret.consistencyHash = 0;
 			ret.sessionCommand[0] = 0;
@@ -3628,6 +4009,98 @@ void idGameLocal::CalcFov( float base_fov, float &fov_x, float &fov_y ) const {
 	}
 }
 
+// longer moves in a game tic are teleports and camera cuts, which are drawn
+// right away instead of being smeared across the tic
+static const float MAX_INTERPOLATED_MOVE = 128.0f;
+
+/*
+================
+idGameLocal::InterpolateEntity
+
+Called before the entity's render entity is updated, while the render world
+still has it where it was last drawn
+================
+*/
+void idGameLocal::InterpolateEntity( idEntity *ent ) {
+	const renderEntity_t *drawn = gameRenderWorld->GetRenderEntity( ent->GetModelDefHandle() );
+	const renderEntity_t *current = ent->GetRenderEntity();
+
+	if ( !drawn || ( drawn->origin == current->origin && drawn->axis == current->axis ) ) {
+		return;
+	}
+	if ( ( drawn->origin - current->origin ).LengthSqr() > Square( MAX_INTERPOLATED_MOVE ) ) {
+		return;
+	}
+
+	int index = ent->interpolationIndex;
+	if ( index < 0 || index >= interpolatedEntities.Num() || interpolatedEntities[index].ent.GetEntity() != ent ) {
+		index = interpolatedEntities.Num();
+		interpolatedEntities.Alloc().ent = ent;
+		ent->interpolationIndex = index;
+	}
+
+	interpolatedEntity_t &interp = interpolatedEntities[index];
+	interp.framenum = framenum;
+	interp.origin = drawn->origin;
+	interp.axis = drawn->axis.ToQuat();
+}
+
+/*
+================
+idGameLocal::GetInterpolationFraction
+
+How far the clock is into the current game tic
+================
+*/
+float idGameLocal::GetInterpolationFraction( void ) const {
+	const double ticTicks = sys->ClockTicksPerSecond() * msec / 1000.0;
+	return idMath::ClampFloat( 0.0f, 1.0f, ( sys->GetClockTicks() - ticClockTicks ) / ticTicks );
+}
+
+/*
+================
+idGameLocal::DrawInterpolatedEntities
+
+Moves the entities of the last game tic to where they are at the given
+fraction of the tic. Entities that didn't move since an earlier tic are put
+back where the game has them and leave the list.
+================
+*/
+void idGameLocal::DrawInterpolatedEntities( float fraction ) {
+	for ( int i = interpolatedEntities.Num() - 1 ; i >= 0 ; i-- ) {
+		const interpolatedEntity_t &interp = interpolatedEntities[i];
+		idEntity *ent = interp.ent.GetEntity();
+
+		if ( ent && ent->GetModelDefHandle() != -1 ) {
+			const renderEntity_t *current = ent->GetRenderEntity();
+
+			if ( interp.framenum == framenum && fraction < 1.0f ) {
+				renderEntity_t drawn = *current;
+				idQuat axis;
+
+				drawn.origin.Lerp( interp.origin, current->origin, fraction );
+				drawn.axis = axis.Slerp( interp.axis, current->axis.ToQuat(), fraction ).ToMat3();
+				gameRenderWorld->UpdateEntityDef( ent->GetModelDefHandle(), &drawn );
+				continue;
+			}
+
+			gameRenderWorld->UpdateEntityDef( ent->GetModelDefHandle(), current );
+		}
+		if ( ent ) {
+			ent->interpolationIndex = -1;
+		}
+
+		// the last record fills the gap
+		interpolatedEntities.RemoveIndex( i, false );
+		if ( i < interpolatedEntities.Num() ) {
+			idEntity *moved = interpolatedEntities[i].ent.GetEntity();
+			if ( moved ) {
+				moved->interpolationIndex = i;
+			}
+		}
+	}
+}
+
 /*
 ================
 idGameLocal::Draw
@@ -3647,6 +4120,31 @@ bool idGameLocal::Draw( int clientNum )
 		return false;
 	}
 
+	// com_interpolateTics draws the game between its last two tics, so frames
+	// drawn in between don't repeat the last one
+	renderView_t *view = player->GetRenderView();
+	idVec3 viewOrigin;
+	idMat3 viewAxis;
+	bool viewInterpolated = false;
+
+	if ( interpolateTics || interpolatedEntities.Num() ) {
+		const float fraction = interpolateTics ? GetInterpolationFraction() : 1.0f;
+
+		DrawInterpolatedEntities( fraction );
+
+		if ( interpolateTics && view && interpolatedViewFrame == framenum && fraction < 1.0f
+			&& ( view->vieworg - interpolatedViewOrigin ).LengthSqr() < Square( MAX_INTERPOLATED_MOVE )
+			&& view->viewaxis[0] * interpolatedViewAxis[0] > 0.5f ) {
+			idQuat axis;
+
+			viewOrigin = view->vieworg;
+			viewAxis = view->viewaxis;
+			view->vieworg.Lerp( interpolatedViewOrigin, viewOrigin, fraction );
+			view->viewaxis = axis.Slerp( interpolatedViewAxis.ToQuat(), viewAxis.ToQuat(), fraction ).ToMat3();
+			viewInterpolated = true;
+		}
+	}
+
 	// Make the rendershot appear on the hud
 	// duzenko #4408 - moved this half from game tic
 	if (cv_lg_hud.GetInteger() == 0)
@@ -3657,6 +4155,11 @@ bool idGameLocal::Draw( int clientNum )
 	// render the scene
 	player->playerView.RenderPlayerView(player->hud);
 
+	if ( viewInterpolated ) {
+		view->vieworg = viewOrigin;
+		view->viewaxis = viewAxis;
+	}
+
 	// Make the rendershot appear on the hud
 	if (cv_lg_hud.GetInteger() != 0)
 	{
@@ -5322,6 +5825,7 @@ returning false if not found
 ===================
 */
 bool idGameLocal::SpawnEntityDef( const idDict &args, idEntity **ent, bool setDefaults ) {
+	idScopedMemTag memTag( MEMTAG_GAME );
 	const char	*classname;
 	const char	*spawn;
 	idTypeInfo	*cls;
@@ -5497,6 +6001,19 @@ void idGameLocal::PrepareForMissionEnd()
 	}
 }
 
+typedef struct {
+	const char *	classname;
+	int				count;
+	double			mediaMsec;		// CacheDictionaryMedia
+	double			spawnMsec;		// SpawnEntityDef
+} spawnClassTiming_t;
+
+static int SpawnClassTimingCompare( const spawnClassTiming_t *a, const spawnClassTiming_t *b ) {
+	const double ta = a->mediaMsec + a->spawnMsec;
+	const double tb = b->mediaMsec + b->spawnMsec;
+	return ( ta < tb ) ? 1 : ( ( ta > tb ) ? -1 : 0 );
+}
+
 /*
 ==============
 idGameLocal::SpawnMapEntities
@@ -5512,6 +6029,12 @@ void idGameLocal::SpawnMapEntities( void )
 	idMapEntity	*mapEnt;
 	int			numEntities;
 	idDict		args;
+	idTimer		mediaTimer, spawnTimer;
+
+	// g_spawnTiming
+	idList<spawnClassTiming_t>			classTimings;
+	idFlatHashMap<idStr, int>			classTimingIndex;
+	const bool							timeSpawns = g_spawnTiming.GetBool();
 
 	if ( mapFile == NULL )
 	{
@@ -5549,6 +6072,9 @@ void idGameLocal::SpawnMapEntities( void )
 
 	common->PacifierUpdate(LOAD_KEY_SPAWN_ENTITIES_START,numEntities/LOAD_KEY_ENTITY_GRANULARITY); // grayman #3763
 
+	spawnModelMedia.Clear();
+	spawningMapEntities = true;
+
 	for ( i = 1 ; i < numEntities ; i++ )
 	{
 		mapEnt = mapFile->GetEntity( i );
@@ -5572,11 +6098,41 @@ void idGameLocal::SpawnMapEntities( void )
 
 		if (!InhibitEntitySpawn(args))
 		{
+			if ( timeSpawns ) {
+				mediaTimer.Clear();
+				spawnTimer.Clear();
+				mediaTimer.Start();
+			}
+
 			// precache any media specified in the map entity
 			CacheDictionaryMedia(&args);
 
+			if ( timeSpawns ) {
+				mediaTimer.Stop();
+				spawnTimer.Start();
+			}
+
 			SpawnEntityDef(args);
 			num++;
+
+			if ( timeSpawns ) {
+				spawnTimer.Stop();
+
+				const idStr classname = mapEnt->epairs.GetString( "classname" );
+				int *index;
+				if ( !classTimingIndex.Get( classname, &index ) ) {
+					spawnClassTiming_t &timing = classTimings.Alloc();
+					timing.classname = mapEnt->epairs.GetString( "classname" );
+					timing.count = 0;
+					timing.mediaMsec = 0.0;
+					timing.spawnMsec = 0.0;
+					index = &classTimingIndex.Set( classname, classTimings.Num() - 1 );
+				}
+				spawnClassTiming_t &timing = classTimings[*index];
+				timing.count++;
+				timing.mediaMsec += mediaTimer.Milliseconds();
+				timing.spawnMsec += spawnTimer.Milliseconds();
+			}
 		}
 		else
 		{
@@ -5590,8 +6146,29 @@ void idGameLocal::SpawnMapEntities( void )
 		}
 	}
 
+	spawningMapEntities = false;
+	spawnModelMedia.Clear();
+
 	m_lightGem.InitializeLightGemEntity();
 
+	if ( timeSpawns ) {
+		double mediaMsec = 0.0, spawnMsec = 0.0;
+
+		classTimings.Sort( SpawnClassTimingCompare );
+
+		Printf( "%6s %9s %9s %9s  %s\n", "count", "media ms", "spawn ms", "avg ms", "classname" );
+		for ( i = 0; i < classTimings.Num(); i++ ) {
+			const spawnClassTiming_t &timing = classTimings[i];
+			mediaMsec += timing.mediaMsec;
+			spawnMsec += timing.spawnMsec;
+			if ( i < g_spawnTiming.GetInteger() * 10 ) {
+				Printf( "%6i %9.2f %9.2f %9.3f  %s\n", timing.count, timing.mediaMsec, timing.spawnMsec,
+					( timing.mediaMsec + timing.spawnMsec ) / timing.count, timing.classname );
+			}
+		}
+		Printf( "%i classes, %.2f ms precaching media, %.2f ms spawning\n", classTimings.Num(), mediaMsec, spawnMsec );
+	}
+
 	Printf( "... %i entities spawned, %i inhibited\n\n", num, inhibit );
 	DM_LOG(LC_LIGHT, LT_DEBUG)LOGSTRING("... %i entities spawned, %i inhibited\r", num, inhibit);
 }
@@ -5605,7 +6182,9 @@ void idGameLocal::AddEntityToHash( const char *name, idEntity *ent ) {
 	if ( FindEntity( name ) ) {
 		Error( "Multiple entities named '%s'", name );
 	}
-	entityHash.Add( entityHash.GenerateKey( name, true ), ent->entityNumber );
+	idInternStr &entityName = entityNames[ ent->entityNumber ];
+	entityName.Set( name );
+	entityHash.Add( entityHash.GenerateKey( entityName.GetHash(), 0 ), ent->entityNumber );
 }
 
 /*
@@ -5620,6 +6199,7 @@ bool idGameLocal::RemoveEntityFromHash( const char *name, idEntity *ent ) {
 	for ( i = entityHash.First( hash ); i != -1; i = entityHash.Next( i ) ) {
 		if ( entities[i] && entities[i] == ent && entities[i]->name.Icmp( name ) == 0 ) {
 			entityHash.Remove( hash, i );
+			entityNames[i].Clear();
 			return true;
 		}
 	}
@@ -5812,11 +6392,28 @@ Returns the entity whose name matches the specified string.
 =============
 */
 idEntity *idGameLocal::FindEntity( const char *name ) const {
+	// names that were never interned can't belong to an entity
+	return FindEntity( idInternStr::Find( name ) );
+}
+
+/*
+=============
+idGameLocal::FindEntity
+
+Returns the entity whose name matches the specified string.
+The names are interned, so this is a pointer compare per hash collision.
+=============
+*/
+idEntity *idGameLocal::FindEntity( const idInternStr &name ) const {
 	int hash, i;
 
-	hash = entityHash.GenerateKey( name, true );
+	if ( !name.IsValid() ) {
+		return NULL;
+	}
+
+	hash = entityHash.GenerateKey( name.GetHash(), 0 );
 	for ( i = entityHash.First( hash ); i != -1; i = entityHash.Next( i ) ) {
-		if ( entities[i] && entities[i]->name.Icmp( name ) == 0 ) {
+		if ( entities[i] && entityNames[i] == name ) {
 			return entities[i];
 		}
 	}
@@ -7166,6 +7763,8 @@ bool idGameLocal::AddResponse(idEntity *e)
 		m_RespEntity.Append(entPtr);
 	}
 
+	m_StimResponseBroadphase.MarkDirty(e);
+
 	return rc;
 }
 
@@ -7178,6 +7777,8 @@ void idGameLocal::RemoveResponse(idEntity *e)
 	{
 		m_RespEntity.RemoveIndex(i);
 	}
+
+	m_StimResponseBroadphase.MarkDirty(e);
 }
 
 // grayman #1104 - DoesOpeningExist() looks for any opening along the axis of the
@@ -7638,6 +8239,8 @@ CStimResponsePtr idGameLocal::FindStimResponse(int uniqueId)
 
 void idGameLocal::ProcessStimResponse(unsigned long ticks)
 {
+	PROFILE_SCOPE("ProcessStimResponse");
+
 	if (cv_sr_disable.GetBool())
 	{
 		return; // S/R disabled, skip this
@@ -7647,6 +8250,13 @@ void idGameLocal::ProcessStimResponse(unsigned long ticks)
 	srTimer.Clear();
 	srTimer.Start();
 
+	bool profile = m_StimResponseProfiler.IsEnabled();
+
+	if (profile)
+	{
+		m_StimResponseProfiler.BeginFrame();
+	}
+
 	// Check the timed stims first.
 	for (int i = 0; i < m_StimTimer.Num(); i++)
 	{
@@ -7676,6 +8286,19 @@ void idGameLocal::ProcessStimResponse(unsigned long ticks)
 	int n;
 	idBounds bounds;
 
+	bool useBroadphase = cv_sr_broadphase.GetBool();
+
+	if (useBroadphase)
+	{
+		// Pick up changed responses and relink the responders that moved
+		m_StimResponseBroadphase.Update();
+	}
+	else
+	{
+		// Collect the responders again once it's switched back on
+		m_StimResponseBroadphase.Invalidate();
+	}
+
 	// Now check the rest of the stims.
 	for (int i = 0; i < m_StimEntity.Num(); i++)
 	{
@@ -7762,6 +8385,14 @@ void idGameLocal::ProcessStimResponse(unsigned long ticks)
 			{
 				int numResponses = 0;
 
+				idTimer stimTimer;
+				idTimer responseTimer;
+
+				if (profile)
+				{
+					stimTimer.Start();
+				}
+
 				// Check if we have fixed bounds to work with (sr_bounds_mins & maxs set)
 				if (stim->m_Bounds.GetVolume() > 0) {
 					bounds = idBounds(stim->m_Bounds[0] + origin, stim->m_Bounds[1] + origin);
@@ -7799,7 +8430,15 @@ void idGameLocal::ProcessStimResponse(unsigned long ticks)
 				else 
 				{
 					// Radius based stims
-					n = clip.EntitiesTouchingBounds(bounds, CONTENTS_RESPONSE, srEntities, MAX_GENTITIES);
+					if (useBroadphase)
+					{
+						// Only the entities that have a response to this stim type
+						n = m_StimResponseBroadphase.EntitiesTouchingBounds(stim->m_StimTypeId, bounds, srEntities, MAX_GENTITIES);
+					}
+					else
+					{
+						n = clip.EntitiesTouchingBounds(bounds, CONTENTS_RESPONSE, srEntities, MAX_GENTITIES);
+					}
 					//DM_LOG(LC_STIM_RESPONSE, LT_INFO)LOGSTRING("Entities touching bounds: %d\r", n);
 				}
 				
@@ -7814,18 +8453,40 @@ void idGameLocal::ProcessStimResponse(unsigned long ticks)
 						}
 					}
 
+					if (profile)
+					{
+						responseTimer.Start();
+					}
+
 					// Do responses for entities within the radius of the stim
 					numResponses = DoResponseAction(stim, n, entity, origin);
+
+					if (profile)
+					{
+						responseTimer.Stop();
+					}
 				}
 
 				// The stim has fired, let it do any post-firing activity it may have
 				stim->PostFired(numResponses);
+
+				if (profile)
+				{
+					stimTimer.Stop();
+					m_StimResponseProfiler.AddStim(entity, stim->m_StimTypeId, !stim->m_bCollisionBased, numResponses,
+						stimTimer.Milliseconds(), responseTimer.Milliseconds());
+				}
 			}
 		}
 	}
 
 	srTimer.Stop();
 	DM_LOG(LC_STIM_RESPONSE, LT_INFO)LOGSTRING("Processing S/R took %lf\r", srTimer.Milliseconds());
+
+	if (profile)
+	{
+		m_StimResponseProfiler.EndFrame(srTimer.Milliseconds());
+	}
 }
 
 /*
@@ -56,6 +56,7 @@
 #endif
 
 class idLight;			// J.C.Denton: Required for the declaration of FindMainAmbientLight
+class idMover_Binary;
 
 class idRenderWorld;
 extern idRenderWorld *				gameRenderWorld;
@@ -72,6 +73,7 @@ extern idSoundWorld *			gameSoundWorldBuf;
 
 // classes used by idGameLocal
 class idEntity;
+class idAnimatedEntity;
 class idActor;
 class idPlayer;
 class idCamera;
@@ -86,6 +88,7 @@ class idProgram;
 class idThread;
 class idEditEntities;
 class idLocationEntity;
+class idPhysics_AF;
 
 #define	MAX_CLIENTS				32
 // Tels: If you change this value, make sure that LUDICROUS_INDEX 
@@ -207,6 +210,12 @@ typedef struct snapshot_s {
 	struct snapshot_s *		next;
 } snapshot_t;
 
+// an entity in the PVS of a client that competes for the snapshot budget
+typedef struct snapshotCandidate_s {
+	idEntity *				ent;
+	float					priority;
+} snapshotCandidate_t;
+
 const int MAX_EVENT_PARAM_SIZE		= 128;
 
 typedef struct entityNetEvent_s {
@@ -411,6 +420,23 @@ private:
 // idEntityPtr Definition should be moved to lightgem.h. - J.C.Denton
 
 #include "LightGem.h"
+#include "ai/VisualScanScheduler.h" // must follow the definition of idEntityPtr
+#include "ai/AIBenchmark.h"
+#include "ThinkScheduler.h"
+#include "FrameArena.h"
+#include "PhysicsIslands.h"
+#include "StimResponse/StimResponseBroadphase.h" // must follow the definition of idEntityPtr
+#include "StimResponse/StimResponseProfiler.h"
+
+// an entity that moved in the last game tic, drawn between where it was
+// last drawn and where it is now when com_interpolateTics is set
+typedef struct {
+	idEntityPtr<idEntity>	ent;
+	int						framenum;		// game frame of the move
+	idVec3					origin;			// as last drawn
+	idQuat					axis;
+} interpolatedEntity_t;
+
 //============================================================================
 
 // grayman #3424 - These are the events that are considered suspicious, in that they raise
@@ -472,10 +498,16 @@ public:
 	int						firstFreeIndex;			// first free index in the entities array
 	int						num_entities;			// current number <= MAX_GENTITIES
 	idHashIndex				entityHash;				// hash table to quickly find entities by name
+	idInternStr				entityNames[MAX_GENTITIES];// interned names of the entities in entityHash
 	idWorldspawn *			world;					// world entity
 	idLinkList<idEntity>	spawnedEntities;		// all spawned entities
 	idLinkList<idEntity>	activeEntities;			// all thinking entities (idEntity::thinkFlags != 0)
 	idLinkList<idAI>		spawnedAI;				// greebo: all spawned AI
+	idLinkList<idActor>		spawnedActors;			// all spawned actors, AI and players, for the AI's enemy and friend searches
+	idLinkList<idEntity>	frobableEntities;		// all entities with m_bFrobable set, for the player's frob check
+	idLinkList<idLight>		spawnedLights;			// all spawned lights
+	idLinkList<idMover_Binary>	spawnedBinaryMovers;	// all spawned binary movers (doors, plats), for the team lookups
+	idList<interpolatedEntity_t> interpolatedEntities;	// entities moved in the last game tic, see InterpolateEntity
 	int						numEntitiesToDeactivate;// number of entities that became inactive in current frame
 	bool					sortPushers;			// true if active lists needs to be reordered to place pushers at the front
 	bool					sortTeamMasters;		// true if active lists needs to be reordered to place physics team masters before their slaves
@@ -547,6 +579,32 @@ public:
 	// The manager for handling AI => Area mappings (needed for AI to remember locked doors, for instance)
 	ai::AreaManager			m_AreaManager;
 
+	// Batches and time-slices the line of sight traces of the AI visual scans
+	ai::VisualScanScheduler	m_VisualScanScheduler;
+
+	// The AI stress benchmark of tdm_ai_benchmark
+	ai::AIBenchmark			m_AIBenchmark;
+
+	// Lets the entities far from the player think less often
+	CThinkScheduler			m_ThinkScheduler;
+
+	// Temporary allocations of the current game frame, see CFrameArenaAllocator
+	CFrameArena				m_FrameArena;
+
+	// Puts touching moveables and ragdolls to rest together
+	CPhysicsIslands			m_PhysicsIslands;
+
+	// The entities of the parallel think phase of this frame
+	idList<idEntity*>		m_ParallelThinkers;
+
+	// The animated entities whose animation changed this frame, see PrepareAnimations
+	idList< idEntityPtr<idAnimatedEntity> > m_AnimationsToPrepare;
+	idList<idAnimatedEntity*> m_PreparedAnimations;
+
+	// The articulated figures solved ahead this frame, see SolveArticulatedFigures
+	idList< idEntityPtr<idEntity> > m_SolvedAFEntities;
+	idList<idPhysics_AF*>	m_SolvedAFs;
+
 	// The manager class for all map conversations
 	ai::ConversationSystemPtr	m_ConversationSystem;
 
@@ -651,6 +709,8 @@ public:
 	idList<CStim *>			m_StimTimer;			// All stims that have a timer associated. 
 	idList< idEntityPtr<idEntity> >		m_StimEntity;			// all entities that currently have a stim regardless of it's state
 	idList< idEntityPtr<idEntity> >		m_RespEntity;			// all entities that currently have a response regardless of it's state
+	CStimResponseBroadphase	m_StimResponseBroadphase;	// finds the responders of the radius based stims
+	CStimResponseProfiler	m_StimResponseProfiler;		// costs per stim type and owner class, see tdm_sr_profile
 
 	int						cinematicSkipTime;		// don't allow skipping cinemetics until this time has passed so player doesn't skip out accidently from a firefight
 	int						cinematicStopTime;		// cinematics have several camera changes, so keep track of when we stop them so that we don't reset cinematicSkipTime unnecessarily
@@ -678,6 +738,8 @@ public:
 	idLinkList<idEntity>	snapshotEntities;		// entities from the last snapshot
 	int						realClientTime;			// real client time
 	bool					isNewFrame;				// true if this is a new game frame, not a rerun due to prediction
+	bool					interpolateTics;		// com_interpolateTics, cached for the frame
+	double					ticClockTicks;			// clock ticks at the start of the last game tic
 	float					clientSmoothing;		// smoothing of other clients in the view
 	int						entityDefBits;			// bits required to store an entity def number
 
@@ -802,10 +864,12 @@ public:
 
 							// Initializes all map variables common to both save games and spawned games
 	void					LoadMap( const char *mapName, int randseed );
+	void					LoadStageDone( const char *stage, int &stageStart ) const;
 
 	void					LocalMapRestart( void );
 	void					MapRestart( void );
 	static void				MapRestart_f( const idCmdArgs &args );
+	static void				SnapshotStats_f( const idCmdArgs &args );
 	bool					NextMap( void );	// returns whether serverinfo settings have been modified
 	static void				NextMap_f( const idCmdArgs &args );
 
@@ -850,6 +914,14 @@ public:
 	bool					RequirementMet( idEntity *activator, const idStr &requires, int removeItem );
 
 	bool					InPlayerPVS( idEntity *ent ) const;
+
+	// Remembers where the entity was last drawn before it presents a move, so
+	// Draw can move it there smoothly until the next game tic
+	void					InterpolateEntity( idEntity *ent );
+
+	// Queues the animation frame of the entity to be created in parallel with the
+	// others at the end of the game frame
+	void					AddAnimationToPrepare( idAnimatedEntity *ent );
 	bool					InPlayerConnectedArea( idEntity *ent ) const;
 
 	pvsHandle_t				GetPlayerPVS()			{ return playerPVS; };
@@ -871,6 +943,7 @@ public:
 	static void				ArgCompletion_EntityName( const idCmdArgs &args, void(*callback)( const char *s ) );
 	idEntity *				FindTraceEntity( idVec3 start, idVec3 end, const idTypeInfo &c, const idEntity *skip ) const;
 	idEntity *				FindEntity( const char *name ) const;
+	idEntity *				FindEntity( const idInternStr &name ) const;
 	idEntity *				FindEntityUsingDef( idEntity *from, const char *match ) const;
 	int						EntitiesWithinRadius( const idVec3 org, float radius, idEntity **entityList, int maxCount ) const;
 
@@ -1083,6 +1156,11 @@ private:
 	entityState_t *			clientEntityStates[MAX_CLIENTS][MAX_GENTITIES];
 	int						clientPVS[MAX_CLIENTS][ENTITY_PVS_SIZE];
 	snapshot_t *			clientSnapshots[MAX_CLIENTS];
+	float					clientEntityPriority[MAX_CLIENTS][MAX_GENTITIES];	// accumulated priority of the entity updates not sent yet
+	idList<snapshotCandidate_t>	snapshotCandidates;
+	idList<int>				snapshotTypeBits;		// bits sent per entity type, for net_snapshotStats
+	idList<int>				snapshotTypeUpdates;
+	int						snapshotDeferred;		// entity updates postponed by net_snapshotBudget
 	idBlockAlloc<entityState_t,256>entityStateAllocator;
 	idBlockAlloc<snapshot_t,64>snapshotAllocator;
 
@@ -1097,6 +1175,18 @@ private:
 
 	idStrList				shakeSounds;
 
+	// models CacheDictionaryMedia precached while the map entities spawn, so
+	// the entities sharing a model only look it up in the model managers once
+	idFlatHashMap<idStr, bool>	spawnModelMedia;
+	bool					spawningMapEntities;
+
+	idVec3					interpolatedViewOrigin;	// player view as last drawn
+	idMat3					interpolatedViewAxis;
+	int						interpolatedViewFrame;	// game frame interpolatedViewOrigin is the start of, -1 for none
+
+	float					GetInterpolationFraction( void ) const;
+	void					DrawInterpolatedEntities( float fraction );
+
 	byte					lagometer[ LAGO_IMG_HEIGHT ][ LAGO_IMG_WIDTH ][ 4 ];
 
 	bool					m_DoLightgem;		// Signal when the lightgem may be processed.
@@ -1143,6 +1233,10 @@ private:
 	void					FreePlayerPVS( void );
 	void					UpdateGravity( void );
 	void					SortActiveEntityList( void );
+	void					RunParallelThinks( void );
+	void					SolveArticulatedFigures( void );
+	void					DiscardSolvedArticulatedFigures( void );
+	void					PrepareAnimations( void );
 	void					ShowTargets( void );
 	void					RunDebugInfo( void );
 
@@ -1164,6 +1258,7 @@ private:
 	void					ServerProcessEntityNetworkEventQueue( void );
 	void					ClientProcessEntityNetworkEventQueue( void );
 	void					ClientShowSnapshot( int clientNum ) const;
+	void					ClearSnapshotStats( void );
 							// call after any change to serverInfo. Will update various quick-access flags
 	void					UpdateServerInfoFlags( void );
 	void					RandomizeInitialSpawns( void );
@@ -1199,6 +1294,48 @@ extern idAnimManager		animationLib;
 
 //============================================================================
 
+/**
+ * idList storage in the game frame arena, so the temporary lists of a frame don't churn
+ * the heap. The list has to be destroyed before the CFrameArenaScope it was filled in,
+ * so declare it after the scope, and must not outlive the game frame:
+ *
+ *	CFrameArenaScope arenaScope(gameLocal.m_FrameArena);
+ *	idList< idVec3, CFrameArenaAllocator<idVec3> > normals;
+ */
+template< class type >
+class CFrameArenaAllocator
+{
+public:
+	static type* Alloc(int num)
+	{
+		type* ptr = static_cast<type*>(gameLocal.m_FrameArena.Alloc(num * sizeof(type)));
+
+#ifdef ID_REDIRECT_NEWDELETE
+#undef new
+#endif
+		for (int i = 0; i < num; i++)
+		{
+			new (&ptr[i]) type;
+		}
+#ifdef ID_REDIRECT_NEWDELETE
+#define new ID_DEBUG_NEW
+#endif
+
+		return ptr;
+	}
+
+	static void Free(type* ptr, int num)
+	{
+		// The memory itself goes back with the arena scope
+		for (int i = 0; i < num; i++)
+		{
+			ptr[i].~type();
+		}
+	}
+};
+
+//============================================================================
+
 template< class type >
 ID_INLINE idEntityPtr<type>::idEntityPtr() {
 	spawnId = 0;
@@ -1367,6 +1504,7 @@ const int	CINEMATIC_SKIP_DELAY	= SEC2MS( 2.0f );
 #include "script/Script_Compiler.h"
 #include "script/Script_Interpreter.h"
 #include "script/Script_Thread.h"
+#include "script/Script_Profiler.h"
 
 const float	RB_VELOCITY_MAX				= 16000;
 const int	RB_VELOCITY_TOTAL_BITS		= 16;
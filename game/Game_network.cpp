@@ -46,6 +46,8 @@ idCVar net_clientSmoothing( "net_clientSmoothing", "0.8", CVAR_GAME | CVAR_FLOAT
 idCVar net_clientSelfSmoothing( "net_clientSelfSmoothing", "0.6", CVAR_GAME | CVAR_FLOAT, "smooth self position if network causes prediction error.", 0.0f, 0.95f );
 idCVar net_clientMaxPrediction( "net_clientMaxPrediction", "1000", CVAR_SYSTEM | CVAR_INTEGER | CVAR_NOCHEAT, "maximum number of milliseconds a client can predict ahead of server." );
 idCVar net_clientLagOMeter( "net_clientLagOMeter", "1", CVAR_GAME | CVAR_BOOL | CVAR_NOCHEAT | CVAR_ARCHIVE, "draw prediction graph" );
+idCVar net_snapshotBudget( "net_snapshotBudget", "0", CVAR_GAME | CVAR_INTEGER, "maximum number of bytes of entity updates per client snapshot, 0 = no limit. updates that don't fit are sent in a later snapshot, highest priority first", 0, MAX_GAME_MESSAGE_SIZE );
+idCVar net_snapshotPriorityRange( "net_snapshotPriorityRange", "1024", CVAR_GAME | CVAR_FLOAT, "entities closer than this to the client get a higher snapshot priority" );
 
 /*
 ================
@@ -64,6 +66,8 @@ void idGameLocal::InitAsyncNetwork( void ) {
 	memset( clientEntityStates, 0, sizeof( clientEntityStates ) );
 	memset( clientPVS, 0, sizeof( clientPVS ) );
 	memset( clientSnapshots, 0, sizeof( clientSnapshots ) );
+	memset( clientEntityPriority, 0, sizeof( clientEntityPriority ) );
+	ClearSnapshotStats();
 
 	eventQueue.Init();
 	savedEventQueue.Init();
@@ -88,6 +92,9 @@ void idGameLocal::ShutdownAsyncNetwork( void ) {
 	memset( clientEntityStates, 0, sizeof( clientEntityStates ) );
 	memset( clientPVS, 0, sizeof( clientPVS ) );
 	memset( clientSnapshots, 0, sizeof( clientSnapshots ) );
+	memset( clientEntityPriority, 0, sizeof( clientEntityPriority ) );
+	snapshotCandidates.Clear();
+	ClearSnapshotStats();
 }
 
 /*
@@ -348,6 +355,7 @@ void idGameLocal::ServerClientDisconnect( int clientNum ) {
 
 	// clear the client PVS
 	memset( clientPVS[ clientNum ], 0, sizeof( clientPVS[ clientNum ] ) );
+	memset( clientEntityPriority[ clientNum ], 0, sizeof( clientEntityPriority[ clientNum ] ) );
 
 	// delete the player entity
 	delete entities[ clientNum ];
@@ -528,11 +536,29 @@ void idGameLocal::ReadGameStateFromSnapshot( const idBitMsgDelta &msg ) {
 	mpGame.ReadFromSnapshot( msg );
 }
 
+/*
+================
+SnapshotCandidateCompare
+================
+*/
+static int SnapshotCandidateCompare( const snapshotCandidate_t *a, const snapshotCandidate_t *b ) {
+	if ( a->priority > b->priority ) {
+		return -1;
+	}
+	if ( a->priority < b->priority ) {
+		return 1;
+	}
+	return a->ent->entityNumber - b->ent->entityNumber;
+}
+
 /*
 ================
 idGameLocal::ServerWriteSnapshot
 
   Write a snapshot of the current game state for the given client.
+  With net_snapshotBudget set, the entity updates are sent by priority and the
+  ones that don't fit are postponed. The client keeps its last acknowledged state
+  of those, so they just arrive a few snapshots later.
 ================
 */
 void idGameLocal::ServerWriteSnapshot( int clientNum, int sequence, idBitMsg &msg, byte *clientInPVS, int numPVSClients ) {
@@ -589,7 +615,11 @@ void idGameLocal::ServerWriteSnapshot( int clientNum, int sequence, idBitMsg &ms
 	msg.WriteLong( tagRandom.GetSeed() );
 #endif
 
-	// create the snapshot
+	// gather the entities in the PVS, every snapshot they are not sent in raises their priority
+	const idVec3 &viewOrigin = spectated->GetPhysics()->GetOrigin();
+	const float priorityRange = net_snapshotPriorityRange.GetFloat();
+
+	snapshotCandidates.SetNum( 0, false );
 	for( ent = spawnedEntities.Next(); ent != NULL; ent = ent->spawnNode.Next() ) {
 
 		// if the entity is not in the player PVS
@@ -605,8 +635,45 @@ void idGameLocal::ServerWriteSnapshot( int clientNum, int sequence, idBitMsg &ms
 			continue;
 		}
 
+		float &priority = clientEntityPriority[clientNum][ent->entityNumber];
+		priority += 1.0f;
+		if ( priorityRange > 0.0f ) {
+			float dist = ( ent->GetPhysics()->GetOrigin() - viewOrigin ).LengthFast();
+			if ( dist < priorityRange ) {
+				priority += 3.0f * ( priorityRange - dist ) / priorityRange;
+			}
+		}
+
+		snapshotCandidate_t &candidate = snapshotCandidates.Alloc();
+		candidate.ent = ent;
+		candidate.priority = priority;
+
+		// the players and entities the client doesn't know yet always go first
+		if ( ent->entityNumber < MAX_CLIENTS || !clientEntityStates[clientNum][ent->entityNumber] ) {
+			candidate.priority += idMath::INFINITY;
+		}
+	}
+
+	const int budgetBits = net_snapshotBudget.GetInteger() << 3;
+	const int startBits = msg.GetNumBitsWritten();
+	bool writtenAny = false;
+
+	if ( budgetBits > 0 ) {
+		snapshotCandidates.Sort( SnapshotCandidateCompare );
+	}
+
+	if ( snapshotTypeBits.Num() < idClass::GetNumTypes() ) {
+		snapshotTypeBits.AssureSize( idClass::GetNumTypes(), 0 );
+		snapshotTypeUpdates.AssureSize( idClass::GetNumTypes(), 0 );
+	}
+
+	// create the snapshot
+	for ( i = 0; i < snapshotCandidates.Num(); i++ ) {
+		ent = snapshotCandidates[i].ent;
+
 		// save the write state to which we can revert when the entity didn't change at all
 		msg.SaveWriteState( msgSize, msgWriteBit );
+		const int entityStartBits = msg.GetNumBitsWritten();
 
 		// write the entity to the snapshot
 		msg.WriteBits( ent->entityNumber, GENTITYNUM_BITS );
@@ -632,14 +699,27 @@ void idGameLocal::ServerWriteSnapshot( int clientNum, int sequence, idBitMsg &ms
 		if ( !deltaMsg.HasChanged() ) {
 			msg.RestoreWriteState( msgSize, msgWriteBit );
 			entityStateAllocator.Free( newBase );
+		} else if ( budgetBits > 0 && writtenAny && msg.GetNumBitsWritten() - startBits > budgetBits ) {
+			// over budget, this and the remaining updates wait for one of the next snapshots
+			msg.RestoreWriteState( msgSize, msgWriteBit );
+			entityStateAllocator.Free( newBase );
+			snapshotDeferred += snapshotCandidates.Num() - i;
+			break;
 		} else {
 			newBase->next = snapshot->firstEntityState;
 			snapshot->firstEntityState = newBase;
+			writtenAny = true;
+
+			snapshotTypeBits[ ent->GetType()->typeNum ] += msg.GetNumBitsWritten() - entityStartBits;
+			snapshotTypeUpdates[ ent->GetType()->typeNum ]++;
 
 #if ASYNC_WRITE_TAGS
 			msg.WriteLong( tagRandom.RandomInt() );
 #endif
 		}
+
+		// the client is up to date with this entity
+		clientEntityPriority[clientNum][ent->entityNumber] = 0.0f;
 	}
 
 	msg.WriteBits( ENTITYNUM_NONE, GENTITYNUM_BITS );
@@ -686,6 +766,43 @@ void idGameLocal::ServerWriteSnapshot( int clientNum, int sequence, idBitMsg &ms
 	LittleRevBytes( clientInPVS, sizeof( int ), sizeof( clientInPVS ) / sizeof ( int ) );
 }
 
+/*
+================
+idGameLocal::ClearSnapshotStats
+================
+*/
+void idGameLocal::ClearSnapshotStats( void ) {
+	snapshotTypeBits.Clear();
+	snapshotTypeUpdates.Clear();
+	snapshotDeferred = 0;
+}
+
+/*
+================
+idGameLocal::SnapshotStats_f
+
+prints the snapshot bits sent per entity type, "net_snapshotStats clear" starts over
+================
+*/
+void idGameLocal::SnapshotStats_f( const idCmdArgs &args ) {
+	int i, totalBits = 0, totalUpdates = 0;
+
+	for ( i = 0; i < gameLocal.snapshotTypeBits.Num(); i++ ) {
+		if ( !gameLocal.snapshotTypeUpdates[i] ) {
+			continue;
+		}
+		common->Printf( "%8d bytes %6d updates %6d bits/update  %s\n", gameLocal.snapshotTypeBits[i] >> 3, gameLocal.snapshotTypeUpdates[i],
+			gameLocal.snapshotTypeBits[i] / gameLocal.snapshotTypeUpdates[i], idClass::GetType( i )->classname );
+		totalBits += gameLocal.snapshotTypeBits[i];
+		totalUpdates += gameLocal.snapshotTypeUpdates[i];
+	}
+	common->Printf( "%8d bytes %6d updates total, %d updates deferred by net_snapshotBudget\n", totalBits >> 3, totalUpdates, gameLocal.snapshotDeferred );
+
+	if ( args.Argc() > 1 && !idStr::Icmp( args.Argv( 1 ), "clear" ) ) {
+		gameLocal.ClearSnapshotStats();
+	}
+}
+
 /*
 ================
 idGameLocal::ServerApplySnapshot
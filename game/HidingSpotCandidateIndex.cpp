@@ -0,0 +1,373 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+#include "precompiled_game.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "HidingSpotCandidateIndex.h"
+#include "DarkModGlobals.h"
+
+// These must match the grid of CDarkmodAASHidingSpotFinder::testingInsideVisibleAASArea
+#define HSC_GRID_SPACING 40.0f
+#define HSC_WALL_MARGIN_SIZE 1.0f
+
+// The cover test traces this far in each of the HSC_COVER_DIRECTIONS directions,
+// at this height above the floor
+#define HSC_COVER_DISTANCE 48.0f
+#define HSC_COVER_HEIGHT 32.0f
+#define HSC_COVER_DIRECTIONS 8
+
+// The number of blocked directions for a candidate to count as HSC_COVER
+#define HSC_COVER_MIN_DIRECTIONS 2
+
+// The cache file
+#define HSC_FILE_EXTENSION "hsi"
+#define HSC_FILE_MAGIC (('H' << 24) | ('S' << 16) | ('C' << 8) | 'I')
+#define HSC_FILE_VERSION 1
+
+//----------------------------------------------------------------------------
+
+static int SortCandidatesByCover(const HidingSpotCandidate* a, const HidingSpotCandidate* b)
+{
+	if (a->cover > b->cover) return -1;
+	if (a->cover < b->cover) return 1;
+	return 0;
+}
+
+//----------------------------------------------------------------------------
+
+CHidingSpotCandidateIndex::CHidingSpotCandidateIndex(void)
+{
+	aasName.Empty();
+}
+
+//----------------------------------------------------------------------------
+
+void CHidingSpotCandidateIndex::clear()
+{
+	areas.Clear();
+	candidates.Clear();
+	aasName.Empty();
+}
+
+//----------------------------------------------------------------------------
+
+bool CHidingSpotCandidateIndex::isBuiltFor(const idStr& in_aasName) const
+{
+	return (aasName.Length() > 0) && (aasName == in_aasName);
+}
+
+//----------------------------------------------------------------------------
+
+int CHidingSpotCandidateIndex::getNumCandidates(int aasAreaIndex) const
+{
+	if (aasAreaIndex < 0 || aasAreaIndex >= areas.Num())
+	{
+		return 0;
+	}
+
+	return areas[aasAreaIndex].numCandidates;
+}
+
+//----------------------------------------------------------------------------
+
+const HidingSpotCandidate& CHidingSpotCandidateIndex::getCandidate(int aasAreaIndex, int candidateNum) const
+{
+	return candidates[areas[aasAreaIndex].firstCandidate + candidateNum];
+}
+
+//----------------------------------------------------------------------------
+
+bool CHidingSpotCandidateIndex::build(const idStr& in_aasName)
+{
+	// If we already index this one, we are done
+	if (isBuiltFor(in_aasName))
+	{
+		return true;
+	}
+
+	clear();
+
+	idAAS* p_aas = gameLocal.GetAAS(in_aasName);
+	if (p_aas == NULL)
+	{
+		DM_LOG(LC_AI, LT_ERROR)LOGSTRING("No aas with name '%s' exists for this map, no hiding spot candidates indexed\r", in_aasName.c_str());
+		return false;
+	}
+
+	idStr fileName = gameLocal.GetMapName();
+	fileName.SetFileExtension(HSC_FILE_EXTENSION);
+
+	unsigned int checksum = computeChecksum(p_aas);
+
+	if (load(fileName, checksum) && areas.Num() == p_aas->GetNumAreas())
+	{
+		DM_LOG(LC_AI, LT_INFO)LOGSTRING("Loaded %d hiding spot candidates from %s\r", candidates.Num(), fileName.c_str());
+	}
+	else
+	{
+		idTimer timer;
+		timer.Start();
+
+		buildCandidates(p_aas);
+
+		timer.Stop();
+		DM_LOG(LC_AI, LT_INFO)LOGSTRING("Indexed %d hiding spot candidates in %d AAS areas, took %lf msec\r", candidates.Num(), areas.Num(), timer.Milliseconds());
+
+		write(fileName, checksum);
+	}
+
+	// Remember the aas
+	aasName = in_aasName;
+
+	return true;
+}
+
+//----------------------------------------------------------------------------
+
+void CHidingSpotCandidateIndex::buildCandidates(idAAS* p_aas)
+{
+	int numAASAreas = p_aas->GetNumAreas();
+
+	areas.SetNum(numAASAreas);
+	candidates.Clear();
+
+	idList<HidingSpotCandidate> areaCandidates;
+
+	for (int aasAreaIndex = 0; aasAreaIndex < numAASAreas; aasAreaIndex++)
+	{
+		areas[aasAreaIndex].firstCandidate = candidates.Num();
+		areas[aasAreaIndex].numCandidates = 0;
+
+		if ((p_aas->AreaFlags(aasAreaIndex) & AREA_REACHABLE_WALK) == 0)
+		{
+			continue;
+		}
+
+		idBounds bounds = p_aas->GetAreaBounds(aasAreaIndex);
+		float maxX = bounds[1].x - HSC_WALL_MARGIN_SIZE;
+		float maxY = bounds[1].y - HSC_WALL_MARGIN_SIZE;
+
+		areaCandidates.SetNum(0, false);
+
+		// Iterate the same grid as the hiding spot finder, which always searches along
+		// the bounds, as they might be a wall or other cover-providing surface
+		idVec3 point(bounds[0].x + HSC_WALL_MARGIN_SIZE, bounds[0].y + HSC_WALL_MARGIN_SIZE, bounds[1].z + HSC_WALL_MARGIN_SIZE);
+
+		// grayman #4023 - too narrow for a grid line in the x direction
+		if (point.x > maxX && maxX > bounds[0].x)
+		{
+			point.x = maxX;
+		}
+
+		while (point.x <= maxX + 0.1f)
+		{
+			while (point.y <= maxY + 0.1f)
+			{
+				HidingSpotCandidate candidate;
+				candidate.origin = point;
+				computeCover(candidate);
+				areaCandidates.Append(candidate);
+
+				if (idMath::Fabs(point.y - maxY) < VECTOR_EPSILON)
+				{
+					break;
+				}
+
+				point.y = (point.y < maxY && point.y + HSC_GRID_SPACING > maxY) ? maxY : point.y + HSC_GRID_SPACING;
+			}
+
+			if (idMath::Fabs(point.x - maxX) < VECTOR_EPSILON)
+			{
+				break;
+			}
+
+			point.x = (point.x < maxX && point.x + HSC_GRID_SPACING > maxX) ? maxX : point.x + HSC_GRID_SPACING;
+			point.y = bounds[0].y + HSC_WALL_MARGIN_SIZE;
+		}
+
+		areaCandidates.Sort(SortCandidatesByCover);
+
+		candidates.Append(areaCandidates);
+		areas[aasAreaIndex].numCandidates = areaCandidates.Num();
+	}
+}
+
+//----------------------------------------------------------------------------
+
+void CHidingSpotCandidateIndex::computeCover(HidingSpotCandidate& candidate)
+{
+	idVec3 start = candidate.origin;
+	start.z += HSC_COVER_HEIGHT;
+
+	bool blocked[HSC_COVER_DIRECTIONS];
+	int numBlocked = 0;
+
+	for (int i = 0; i < HSC_COVER_DIRECTIONS; i++)
+	{
+		float angle = i * idMath::TWO_PI / HSC_COVER_DIRECTIONS;
+		idVec3 end = start + idVec3(idMath::Cos(angle), idMath::Sin(angle), 0) * HSC_COVER_DISTANCE;
+
+		// No entities are spawned yet when the LAS is initialized, so this only hits the world
+		trace_t result;
+		blocked[i] = gameLocal.clip.TracePoint(result, start, end, MASK_SOLID, NULL);
+
+		if (blocked[i])
+		{
+			numBlocked++;
+		}
+	}
+
+	candidate.cover = static_cast<float>(numBlocked) / HSC_COVER_DIRECTIONS;
+	candidate.flags = HSC_NONE;
+
+	if (numBlocked >= HSC_COVER_MIN_DIRECTIONS)
+	{
+		candidate.flags |= HSC_COVER;
+	}
+
+	// Two blocked directions a quarter turn apart
+	for (int i = 0; i < HSC_COVER_DIRECTIONS; i++)
+	{
+		if (blocked[i] && blocked[(i + HSC_COVER_DIRECTIONS / 4) % HSC_COVER_DIRECTIONS])
+		{
+			candidate.flags |= HSC_CORNER;
+			break;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------
+
+unsigned int CHidingSpotCandidateIndex::computeChecksum(idAAS* p_aas)
+{
+	unsigned long crc;
+	CRC32_InitChecksum(crc);
+
+	idMapFile* mapFile = gameLocal.GetLevelMap();
+	unsigned int geometryCRC = (mapFile != NULL) ? mapFile->GetGeometryCRC() : 0;
+	CRC32_UpdateChecksum(crc, &geometryCRC, sizeof(geometryCRC));
+
+	int numAASAreas = p_aas->GetNumAreas();
+	CRC32_UpdateChecksum(crc, &numAASAreas, sizeof(numAASAreas));
+
+	for (int i = 0; i < numAASAreas; i++)
+	{
+		idBounds bounds = p_aas->GetAreaBounds(i);
+		CRC32_UpdateChecksum(crc, &bounds, sizeof(bounds));
+	}
+
+	CRC32_FinishChecksum(crc);
+
+	return static_cast<unsigned int>(crc);
+}
+
+//----------------------------------------------------------------------------
+
+bool CHidingSpotCandidateIndex::load(const char* fileName, unsigned int checksum)
+{
+	idFile* file = fileSystem->OpenFileRead(fileName);
+	if (file == NULL)
+	{
+		return false;
+	}
+
+	int magic, version, numAreas, numCandidates;
+	unsigned int fileChecksum;
+
+	file->ReadInt(magic);
+	file->ReadInt(version);
+	file->ReadUnsignedInt(fileChecksum);
+	file->ReadInt(numAreas);
+	file->ReadInt(numCandidates);
+
+	if (magic != HSC_FILE_MAGIC || version != HSC_FILE_VERSION || fileChecksum != checksum ||
+		numAreas < 0 || numCandidates < 0)
+	{
+		DM_LOG(LC_AI, LT_INFO)LOGSTRING("Hiding spot candidate file %s is out of date\r", fileName);
+		fileSystem->CloseFile(file);
+		return false;
+	}
+
+	areas.SetNum(numAreas);
+	for (int i = 0; i < numAreas; i++)
+	{
+		file->ReadInt(areas[i].firstCandidate);
+		file->ReadInt(areas[i].numCandidates);
+	}
+
+	candidates.SetNum(numCandidates);
+	for (int i = 0; i < numCandidates; i++)
+	{
+		file->ReadVec3(candidates[i].origin);
+		file->ReadFloat(candidates[i].cover);
+		file->ReadInt(candidates[i].flags);
+	}
+
+	fileSystem->CloseFile(file);
+
+	// Reject truncated files
+	for (int i = 0; i < numAreas; i++)
+	{
+		if (areas[i].firstCandidate < 0 || areas[i].numCandidates < 0 ||
+			areas[i].firstCandidate + areas[i].numCandidates > numCandidates)
+		{
+			areas.Clear();
+			candidates.Clear();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//----------------------------------------------------------------------------
+
+void CHidingSpotCandidateIndex::write(const char* fileName, unsigned int checksum) const
+{
+	idFile* file = fileSystem->OpenFileWrite(fileName);
+	if (file == NULL)
+	{
+		DM_LOG(LC_AI, LT_WARNING)LOGSTRING("Couldn't write hiding spot candidate file %s\r", fileName);
+		return;
+	}
+
+	file->WriteInt(HSC_FILE_MAGIC);
+	file->WriteInt(HSC_FILE_VERSION);
+	file->WriteUnsignedInt(checksum);
+	file->WriteInt(areas.Num());
+	file->WriteInt(candidates.Num());
+
+	for (int i = 0; i < areas.Num(); i++)
+	{
+		file->WriteInt(areas[i].firstCandidate);
+		file->WriteInt(areas[i].numCandidates);
+	}
+
+	for (int i = 0; i < candidates.Num(); i++)
+	{
+		file->WriteVec3(candidates[i].origin);
+		file->WriteFloat(candidates[i].cover);
+		file->WriteInt(candidates[i].flags);
+	}
+
+	fileSystem->CloseFile(file);
+}
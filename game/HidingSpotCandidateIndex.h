@@ -0,0 +1,121 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+#pragma once
+
+//------------------------------------------------------
+
+/*!
+* This defines the static characteristics of a hiding spot candidate as bit flags
+*/
+enum EHidingSpotCandidateFlags
+{
+	HSC_NONE		= 0x00,
+	HSC_COVER		= 0x01,		// next to world geometry in at least HSC_COVER_MIN_DIRECTIONS directions
+	HSC_CORNER		= 0x02,		// blocked in two adjacent directions (along a wall into a corner)
+};
+
+typedef struct tagHidingSpotCandidate
+{
+	idVec3 origin;		// the test point on top of the floor
+	float cover;		// the fraction of horizontal directions blocked by world geometry nearby
+	int flags;			// EHidingSpotCandidateFlags
+} HidingSpotCandidate;
+
+//------------------------------------------------------
+
+/*!
+* The candidate points of the hiding spot search per AAS area, with their static
+* cover quality. The points are on the grid CDarkmodAASHidingSpotFinder iterates
+* in visible AAS areas, sorted by cover from best to worst, so a search only needs
+* to re-score the best candidates of an area with the current lighting and the
+* occlusion from the searcher's position.
+*
+* The index only depends on the world geometry. It is built when the LAS is
+* initialized and cached in maps/<mapname>.hsi, which is validated against the
+* map geometry CRC and the AAS.
+*/
+class CHidingSpotCandidateIndex
+{
+protected:
+
+	typedef struct tagAreaCandidates
+	{
+		int firstCandidate;
+		int numCandidates;
+	} AreaCandidates;
+
+	// Which aas size name the index was built for
+	idStr aasName;
+
+	// Indexed by AAS area number
+	idList<AreaCandidates> areas;
+
+	// The candidates of all areas
+	idList<HidingSpotCandidate> candidates;
+
+	/*!
+	* Builds the candidates of all walkable AAS areas, traces against the world
+	*/
+	void buildCandidates(idAAS* p_aas);
+
+	/*!
+	* Computes the cover value and flags of a point
+	*/
+	static void computeCover(HidingSpotCandidate& candidate);
+
+	// Checksum of the map geometry and AAS the index depends on
+	static unsigned int computeChecksum(idAAS* p_aas);
+
+	bool load(const char* fileName, unsigned int checksum);
+	void write(const char* fileName, unsigned int checksum) const;
+
+public:
+	CHidingSpotCandidateIndex(void);
+
+	/*!
+	* This method clears the index
+	*/
+	void clear();
+
+	/*!
+	* Loads the index from the .hsi file of the map, builds and writes it if the
+	* file is missing or out of date.
+	*
+	* @param in_aasName: The name of the aas system to use.
+	*
+	* @return true on success
+	*/
+	bool build(const idStr& in_aasName);
+
+	/*!
+	* True if the index was built for the given AAS
+	*/
+	bool isBuiltFor(const idStr& in_aasName) const;
+
+	/*!
+	* The number of candidates in the given AAS area
+	*/
+	int getNumCandidates(int aasAreaIndex) const;
+
+	/*!
+	* The candidates of an AAS area, sorted by cover from best to worst
+	*/
+	const HidingSpotCandidate& getCandidate(int aasAreaIndex, int candidateNum) const;
+};
@@ -41,7 +41,15 @@ CHttpRequest::CHttpRequest(CHttpConnection& conn, const std::string& url) :
 	_handle(NULL),
 	_status(NOT_PERFORMED_YET),
 	_cancelFlag(false),
-	_progress(0)
+	_progress(0),
+	_rangeFirst(0),
+	_rangeLast(RANGE_END),
+	_rangeRejected(false),
+	_headOnly(false),
+	_contentLength(0),
+	_acceptsRanges(false),
+	_downloadedBytes(0),
+	_downloadSpeed(0)
 {}
 
 CHttpRequest::CHttpRequest(CHttpConnection& conn, const std::string& url, const std::string& destFilename) :
@@ -51,7 +59,15 @@ CHttpRequest::CHttpRequest(CHttpConnection& conn, const std::string& url, const
 	_status(NOT_PERFORMED_YET),
 	_destFilename(destFilename),
 	_cancelFlag(false),
-	_progress(0)
+	_progress(0),
+	_rangeFirst(0),
+	_rangeLast(RANGE_END),
+	_rangeRejected(false),
+	_headOnly(false),
+	_contentLength(0),
+	_acceptsRanges(false),
+	_downloadedBytes(0),
+	_downloadSpeed(0)
 {}
 
 // Agent Jones #3766
@@ -87,6 +103,29 @@ void CHttpRequest::InitRequest()
 	// We pass ourselves as user data pointer to the callback function
 	curl_easy_setopt(_handle, CURLOPT_WRITEDATA, this);
 
+	if (_headOnly)
+	{
+		curl_easy_setopt(_handle, CURLOPT_NOBODY, 1L);
+		curl_easy_setopt(_handle, CURLOPT_HEADERFUNCTION, CHttpRequest::HeaderCallback);
+		curl_easy_setopt(_handle, CURLOPT_HEADERDATA, this);
+	}
+
+	if (_rangeFirst > 0 || _rangeLast != RANGE_END)
+	{
+		char range[64];
+
+		if (_rangeLast != RANGE_END)
+		{
+			idStr::snPrintf(range, sizeof(range), "%lu-%lu", static_cast<unsigned long>(_rangeFirst), static_cast<unsigned long>(_rangeLast));
+		}
+		else
+		{
+			idStr::snPrintf(range, sizeof(range), "%lu-", static_cast<unsigned long>(_rangeFirst));
+		}
+
+		curl_easy_setopt(_handle, CURLOPT_RANGE, range);
+	}
+
 	// Set agent
 	idStr agent = "The Dark Mod Agent/";
 	agent += va("%d.%02d", TDM_VERSION_MAJOR, TDM_VERSION_MINOR);
@@ -149,12 +188,19 @@ void CHttpRequest::Perform()
 	InitRequest();
 
 	_progress = 0;
+	_downloadedBytes = 0;
+	_downloadSpeed = 0;
+	_rangeRejected = false;
 	_status = IN_PROGRESS;
 
-	// Check target file
+	// Check target file, ranged requests continue an existing one
 	if (!_destFilename.empty())
 	{
-		_destStream.open(_destFilename.c_str(), std::ofstream::out|std::ofstream::binary);
+		bool append = _rangeFirst > 0 || _rangeLast != RANGE_END;
+
+		_destStream.open(_destFilename.c_str(), append ? 
+			std::ofstream::out|std::ofstream::binary|std::ofstream::app : 
+			std::ofstream::out|std::ofstream::binary);
 	}
 
 	CURLcode result = curl_easy_perform(_handle);
@@ -174,6 +220,16 @@ void CHttpRequest::Perform()
 		switch (result)
 		{
 		case CURLE_OK:
+			if (_headOnly)
+			{
+				double length = 0;
+
+				if (curl_easy_getinfo(_handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD, &length) == CURLE_OK && length > 0)
+				{
+					_contentLength = static_cast<std::size_t>(length);
+				}
+			}
+
 			_status = OK;
 			_progress = 1.0;
 			break;
@@ -204,6 +260,42 @@ double CHttpRequest::GetProgressFraction()
 	return _progress;
 }
 
+std::size_t CHttpRequest::GetDownloadedBytes()
+{
+	return _downloadedBytes;
+}
+
+double CHttpRequest::GetDownloadSpeed()
+{
+	return _downloadSpeed;
+}
+
+void CHttpRequest::SetRange(std::size_t first, std::size_t last)
+{
+	_rangeFirst = first;
+	_rangeLast = last;
+}
+
+bool CHttpRequest::RangeRejected()
+{
+	return _rangeRejected;
+}
+
+void CHttpRequest::SetHeadOnly(bool headOnly)
+{
+	_headOnly = headOnly;
+}
+
+std::size_t CHttpRequest::GetContentLength()
+{
+	return _contentLength;
+}
+
+bool CHttpRequest::AcceptsRanges()
+{
+	return _acceptsRanges;
+}
+
 std::string CHttpRequest::GetResultString()
 {
 	return _buffer.empty() ? "" : std::string(&_buffer.front());
@@ -244,6 +336,13 @@ void CHttpRequest::UpdateProgress()
 	{
 		_progress = 1.0;
 	}
+
+	_downloadedBytes = static_cast<std::size_t>(downloaded);
+
+	if (curl_easy_getinfo(_handle, CURLINFO_SPEED_DOWNLOAD, &_downloadSpeed) != CURLE_OK)
+	{
+		_downloadSpeed = 0;
+	}
 }
 
 size_t CHttpRequest::WriteMemoryCallback(void* ptr, size_t size, size_t nmemb, CHttpRequest* self)
@@ -284,6 +383,18 @@ size_t CHttpRequest::WriteFileCallback(void* ptr, size_t size, size_t nmemb, CHt
 		return 0; // cancel the process
 	}
 
+	if (self->_rangeFirst > 0 || self->_rangeLast != RANGE_END)
+	{
+		// A server answering 200 instead of 206 ignored the range and sends the whole file
+		long responseCode = 0;
+
+		if (curl_easy_getinfo(self->_handle, CURLINFO_RESPONSE_CODE, &responseCode) == CURLE_OK && responseCode == 200)
+		{
+			self->_rangeRejected = true;
+			return 0; // cancel the process
+		}
+	}
+
 	// Needed size
 	std::size_t bytesToCopy = size * nmemb;
 
@@ -294,4 +405,19 @@ size_t CHttpRequest::WriteFileCallback(void* ptr, size_t size, size_t nmemb, CHt
 	return static_cast<size_t>(bytesToCopy);
 }
 
+size_t CHttpRequest::HeaderCallback(char* ptr, size_t size, size_t nmemb, CHttpRequest* self)
+{
+	std::size_t length = size * nmemb;
+
+	// The header lines are not terminated
+	std::string line(ptr, length);
+
+	if (idStr::Icmpn(line.c_str(), "Accept-Ranges:", 14) == 0 && idStr::FindText(line.c_str(), "bytes", false) != -1)
+	{
+		self->_acceptsRanges = true;
+	}
+
+	return length;
+}
+
 
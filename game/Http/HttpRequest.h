@@ -74,7 +74,25 @@ private:
 
 	double _progress;
 
+	// The requested byte range, see SetRange()
+	std::size_t _rangeFirst;
+	std::size_t _rangeLast;
+
+	// True if the server sent the whole file instead of the requested range
+	bool _rangeRejected;
+
+	// HEAD request results, see SetHeadOnly()
+	bool _headOnly;
+	std::size_t _contentLength;
+	bool _acceptsRanges;
+
+	std::size_t _downloadedBytes;
+	double _downloadSpeed;
+
 public:
+	// Open end for SetRange()
+	static const std::size_t RANGE_END = static_cast<std::size_t>(-1);
+
 	CHttpRequest(CHttpConnection& conn, const std::string& url);
 
 	CHttpRequest(CHttpConnection& conn, const std::string& url, const std::string& destFilename);
@@ -82,6 +100,7 @@ public:
 	// Callbacks for CURL
 	static size_t WriteMemoryCallback(void* ptr, size_t size, size_t nmemb, CHttpRequest* self);
 	static size_t WriteFileCallback(void* ptr, size_t size, size_t nmemb, CHttpRequest* self);
+	static size_t HeaderCallback(char* ptr, size_t size, size_t nmemb, CHttpRequest* self);
 
 	static int CHttpRequest::TDMHttpProgressFunc(void *clientp, double dltotal, double dlnow, double ultotal, double ulnow);
 
@@ -95,6 +114,31 @@ public:
 	// Between 0.0 and 1.0
 	double GetProgressFraction();
 
+	// Bytes received by this request so far
+	std::size_t GetDownloadedBytes();
+
+	// The average speed of this request in bytes/sec
+	double GetDownloadSpeed();
+
+	/**
+	 * Requests only the bytes first..last (inclusive) of the file. The data is
+	 * appended to the destination file, which allows to resume a partial 
+	 * download by passing its current size as first byte.
+	 */
+	void SetRange(std::size_t first, std::size_t last = RANGE_END);
+
+	// True if the request failed because the server doesn't serve byte ranges
+	bool RangeRejected();
+
+	// Only request the headers, the file size and range support can be queried afterwards
+	void SetHeadOnly(bool headOnly);
+
+	// The size of the file according to the server, 0 if unknown. Valid after a HEAD request.
+	std::size_t GetContentLength();
+
+	// True if the server announced support for byte ranges. Valid after a HEAD request.
+	bool AcceptsRanges();
+
 	// Returns the result string
 	std::string GetResultString();
 
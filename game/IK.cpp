@@ -223,6 +223,10 @@ float idIK::GetBoneAxis( const idVec3 &startPos, const idVec3 &endPos, const idV
 ===============================================================================
 */
 
+idList<idIK_Walk::footTrace_t>	idIK_Walk::footTraces;
+idList<clipTraceRequest_t>		idIK_Walk::footTraceRequests;
+idList<trace_t>					idIK_Walk::footTraceResults;
+
 /*
 ================
 idIK_Walk::idIK_Walk
@@ -269,6 +273,8 @@ idIK_Walk::idIK_Walk() {
 	oldHeightsValid = false;
 	oldWaistHeight = 0.0f;
 	waistOffset.Zero();
+
+	ResetFootTraces();
 }
 
 /*
@@ -277,9 +283,18 @@ idIK_Walk::~idIK_Walk
 ================
 */
 idIK_Walk::~idIK_Walk() {
+	int i;
+
 	if ( footModel ) {
 		delete footModel;
 	}
+
+	for ( i = footTraces.Num() - 1; i >= 0; i-- ) {
+		if ( footTraces[i].ik == this ) {
+			footTraces.RemoveIndex( i );
+			footTraceRequests.RemoveIndex( i );
+		}
+	}
 }
 
 /*
@@ -406,6 +421,8 @@ void idIK_Walk::Restore( idRestoreGame *savefile ) {
 		savefile->ReadFloat( oldAnkleHeights[i] );
 	}
 	savefile->ReadVec3( waistOffset );
+
+	ResetFootTraces();
 }
 
 /*
@@ -611,6 +628,17 @@ void idIK_Walk::Evaluate( void ) {
 		jointOrigins[pivotFoot] = pivotPos;
 	}
 
+	// walkers out of the player's PVS or far away keep the floor heights they had
+	bool batchTraces = ik_batchFootTraces.GetBool();
+	bool skipTraces = false;
+	if ( batchTraces && floorOffsetsValid ) {
+		idPlayer *player = gameLocal.GetLocalPlayer();
+		if ( !player || !gameLocal.InPlayerPVS( self ) ||
+				( player->GetPhysics()->GetOrigin() - modelOrigin ).LengthSqr() > Square( ik_footTraceDist.GetFloat() ) ) {
+			skipTraces = true;
+		}
+	}
+
 	// get the floor heights for the feet
 	for ( i = 0; i < numLegs; i++ ) {
 
@@ -618,10 +646,43 @@ void idIK_Walk::Evaluate( void ) {
 			continue;
 		}
 
+		if ( skipTraces ) {
+			floorHeights[i] = modelHeight + floorOffsets[i];
+			continue;
+		}
+
 		start = jointOrigins[i] + normal * footUpTrace;
 		end = jointOrigins[i] - normal * footDownTrace;
-		gameLocal.clip.Translation( results, start, end, footModel, mat3_identity, CONTENTS_SOLID|CONTENTS_IKCLIP, self );
+
+		// use the trace queued last frame if the foot didn't move much since
+		if ( batchTraces && footTraceFrames[i] == gameLocal.framenum &&
+				( start - footTraceStarts[i] ).LengthSqr() < Square( MAX_FOOT_TRACE_MOVE ) ) {
+			results.endpos = footTraceEnds[i];
+			results.endAxis = mat3_identity;
+		} else {
+			gameLocal.clip.Translation( results, start, end, footModel, mat3_identity, CONTENTS_SOLID|CONTENTS_IKCLIP, self );
+		}
 		floorHeights[i] = results.endpos * normal;
+		floorOffsets[i] = floorHeights[i] - modelHeight;
+
+		if ( batchTraces ) {
+			footTrace_t &footTrace = footTraces.Alloc();
+			footTrace.ik = this;
+			footTrace.leg = i;
+
+			clipTraceRequest_t &request = footTraceRequests.Alloc();
+			request.start = start;
+			request.end = end;
+			if ( footModel ) {
+				// the foot polygon as a thin box with its bottom at the trace origin
+				request.bounds = footModel->GetBounds();
+				request.bounds[1][2] = request.bounds[0][2] + 1.0f;
+			} else {
+				request.bounds.Zero();
+			}
+			request.contentMask = CONTENTS_SOLID|CONTENTS_IKCLIP;
+			request.passEntity = self;
+		}
 
 		if ( ik_debug.GetBool() && footModel ) {
 			idFixedWinding w;
@@ -631,6 +692,7 @@ void idIK_Walk::Evaluate( void ) {
 			gameRenderWorld->DebugWinding( colorRed, w, results.endpos, results.endAxis );
 		}
 	}
+	floorOffsetsValid = true;
 
 	const idPhysics *phys = self->GetPhysics();
 
@@ -826,6 +888,64 @@ void idIK_Walk::DisableLeg( int num ) {
 	enabledLegs &= ~( 1 << num );
 }
 
+/*
+================
+idIK_Walk::ResetFootTraces
+================
+*/
+void idIK_Walk::ResetFootTraces( void ) {
+	int i;
+
+	for ( i = 0; i < MAX_LEGS; i++ ) {
+		footTraceFrames[i] = -1;
+		footTraceStarts[i].Zero();
+		footTraceEnds[i].Zero();
+		floorOffsets[i] = 0.0f;
+	}
+	floorOffsetsValid = false;
+}
+
+/*
+================
+idIK_Walk::RunFootTraces
+
+The floor traces the walkers queued in Evaluate last frame, in one batch
+================
+*/
+void idIK_Walk::RunFootTraces( void ) {
+	int i;
+
+	if ( !footTraces.Num() ) {
+		return;
+	}
+
+	footTraceResults.SetNum( footTraceRequests.Num(), false );
+	gameLocal.clip.TranslationBatch( footTraceResults.Ptr(), footTraceRequests.Ptr(), footTraceRequests.Num() );
+
+	for ( i = 0; i < footTraces.Num(); i++ ) {
+		idIK_Walk *ik = footTraces[i].ik;
+		int leg = footTraces[i].leg;
+
+		ik->footTraceFrames[leg] = gameLocal.framenum;
+		ik->footTraceStarts[leg] = footTraceRequests[i].start;
+		ik->footTraceEnds[leg] = footTraceResults[i].endpos;
+	}
+
+	footTraces.SetNum( 0, false );
+	footTraceRequests.SetNum( 0, false );
+}
+
+/*
+================
+idIK_Walk::ClearFootTraces
+================
+*/
+void idIK_Walk::ClearFootTraces( void ) {
+	footTraces.Clear();
+	footTraceRequests.Clear();
+	footTraceResults.Clear();
+}
+
 
 /*
 ===============================================================================
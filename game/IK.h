@@ -83,8 +83,13 @@ public:
 	void					EnableLeg( int num );
 	void					DisableLeg( int num );
 
+							// traces the feet queued last frame, call once per frame before the entities think
+	static void				RunFootTraces( void );
+	static void				ClearFootTraces( void );
+
 private:
 	static const int		MAX_LEGS		= 8;
+	static const int		MAX_FOOT_TRACE_MOVE	= 8;	// a batched trace is used while the foot moved less than this
 
 	idClipModel *			footModel;
 
@@ -125,6 +130,24 @@ private:
 	float					oldWaistHeight;
 	float					oldAnkleHeights[MAX_LEGS];
 	idVec3					waistOffset;
+
+	// batched foot traces, not saved
+	int						footTraceFrames[MAX_LEGS];	// the frame footTraceEnds were traced in
+	idVec3					footTraceStarts[MAX_LEGS];
+	idVec3					footTraceEnds[MAX_LEGS];
+	bool					floorOffsetsValid;
+	float					floorOffsets[MAX_LEGS];		// floor heights relative to the model, kept while traces are skipped
+
+	typedef struct {
+		idIK_Walk *			ik;
+		int					leg;
+	} footTrace_t;
+
+	static idList<footTrace_t>			footTraces;			// queued for the next frame
+	static idList<clipTraceRequest_t>	footTraceRequests;
+	static idList<trace_t>				footTraceResults;
+
+	void					ResetFootTraces( void );
 };
 
 
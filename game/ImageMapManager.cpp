@@ -85,6 +85,9 @@ void ImageMapManager::Restore( idRestoreGame *savefile ) {
 	for (int i = 0; i < num; i++)
 	{
 		m_imageMaps[i].img = NULL;
+		m_imageMaps[i].data = NULL;
+		m_imageMaps[i].width = 0;
+		m_imageMaps[i].height = 0;
 
 		savefile->ReadString( m_imageMaps[i].name );
 		savefile->ReadFloat( m_imageMaps[i].density );
@@ -125,6 +128,7 @@ void ImageMapManager::Clear( void ) {
 			m_imageMaps[i].img->Unload();
 			delete m_imageMaps[i].img;
 			m_imageMaps[i].img = NULL;
+			m_imageMaps[i].data = NULL;
 			m_imageMaps[i].users = 0;
 		}
 	}
@@ -151,6 +155,9 @@ int ImageMapManager::GetImageMap( idStr name ) {
 	imagemap_t map;
 	// stgatilov: initialize if you don't wont to get 0xCCCCCCCC pointer=)
 	map.img = NULL;
+	map.data = NULL;
+	map.width = 0;
+	map.height = 0;
 
 	// convert for example "spots" into "textures/seed/spots.png"
 
@@ -243,11 +250,11 @@ int ImageMapManager::GetImageMap( idStr name ) {
 */
 const unsigned char* ImageMapManager::GetMapData( const unsigned int id )
 {
-	Image*	img = GetImage( id );
+	imagemap_t* map = GetLoadedMap( id );
 
-	if (img)
+	if (map)
 	{
-		return img->GetImageData();
+		return map->data;
 	}
 
 	// some error happened
@@ -259,11 +266,11 @@ const unsigned char* ImageMapManager::GetMapData( const unsigned int id )
 */
 unsigned int ImageMapManager::GetMapWidth( const unsigned int id )
 {
-	Image*	img = GetImage( id );
+	imagemap_t* map = GetLoadedMap( id );
 
-	if (img)
+	if (map)
 	{
-		return img->m_Width;
+		return map->width;
 	}
 
 	// some error happened
@@ -274,11 +281,11 @@ unsigned int ImageMapManager::GetMapWidth( const unsigned int id )
 * Returns the width in pixels of the image map.
 */
 unsigned int ImageMapManager::GetMapHeight( const unsigned int id ) {
-	Image*	img = GetImage( id );
+	imagemap_t* map = GetLoadedMap( id );
 
-	if (img)
+	if (map)
 	{
-		return img->m_Height;
+		return map->height;
 	}
 
 	// some error happened
@@ -331,33 +338,82 @@ float ImageMapManager::GetMapDensity( const unsigned int id ) {
 }
 
 
+/**
+* Returns the average density of the image map as seen through the given scale and
+* offset. Which texel a column or row maps to only depends on that column or row, so
+* the wrapped coordinates are computed once per column and row instead of per texel.
+*/
+float ImageMapManager::GetMapDensity( const unsigned int id, const float ofs_x, const float ofs_y, const float scale_x, const float scale_y ) {
+	imagemap_t* map = GetLoadedMap(id);
+
+	// error?
+	if (!map)
+	{
+		return 0.0f;
+	}
+
+	const int w = map->width;
+	const int h = map->height;
+	const double wd = (double)w;
+	const double hd = (double)h;
+	const double xo = w * ofs_x;
+	const double yo = h * ofs_y;
+
+	int *columns = (int *)_alloca16( w * sizeof( int ) );
+	for (int x = 0; x < w; x++)
+	{
+		// first fmod => -w .. +w => +w => 0 .. 2 * w => fmod => 0 .. w
+		columns[x] = fmod( fmod( x * (double)scale_x + xo, wd ) + wd, wd );
+	}
+
+	double sum = 0.0;
+	for (int y = 0; y < h; y++)
+	{
+		const int y1 = fmod( fmod( y * (double)scale_y + yo, hd ) + hd, hd );
+		const unsigned char *row = map->data + w * y1;
+
+		unsigned int rowSum = 0;
+		for (int x = 0; x < w; x++)
+		{
+			rowSum += row[ columns[x] ];	// 0 .. 255
+		}
+		sum += rowSum;
+	}
+
+	// divide the sum by W and H and 256 so we arrive at 0 .. 1.0
+	return (float)( sum / ( wd * hd * 256.0 ) );
+}
+
 /**
 * Given the id of a formerly loaded map, returns a value between 0 and 255 for the
 * position on the map. xr and yr run from 0 .. 1.0.
 */
 unsigned int ImageMapManager::GetMapDataAt( const unsigned int id, const float xr, const float yr) {
-	Image*	img = GetImage( id );
-	if (!img)
+	imagemap_t* map = GetLoadedMap( id );
+	if (!map)
 	{
 		return 0;
 	}
 
-	int x = img->m_Width * xr;
-	int y = img->m_Height * yr;
-	if (x < 0 || y < 0 || x > img->m_Width || y > img->m_Height)
+	int x = map->width * xr;
+	int y = map->height * yr;
+	if (x < 0 || y < 0 || x > map->width || y > map->height)
 	{
 		m_lastError = "X or Y out of range.";
 		return 0;
 	}
-    const unsigned char *imgData = img->GetImageData();
 
-	if (imgData)
+	// xr or yr == 1.0 is the far edge of the last texel
+	if (x == map->width)
+	{
+		x--;
+	}
+	if (y == map->height)
 	{
-		return imgData[ x + y * img->m_Width ];
+		y--;
 	}
 
-	m_lastError = "Can't access image data.";
-	return 0;
+	return map->data[ x + y * map->width ];
 }
 	
 /**
@@ -399,6 +455,7 @@ void ImageMapManager::FreeUnusedMaps( void ) {
 			m_imageMaps[i].img->Unload();
 			delete m_imageMaps[i].img;
 			m_imageMaps[i].img = NULL;
+			m_imageMaps[i].data = NULL;
 		}
 	}
 	return;
@@ -449,6 +506,10 @@ bool ImageMapManager::LoadImage( imagemap_t* map ) {
 		return false;
 	}
 
+	map->data = imgData;
+	map->width = map->img->m_Width;
+	map->height = map->img->m_Height;
+
 	// Compute an average density for the image map, so the SEED can use it
 	double fImgDensity = 0.0f;
 
@@ -502,3 +563,22 @@ Image*	ImageMapManager::GetImage( unsigned int handle )
 	return NULL;
 }
 
+/**
+* Checks that the given map handle is valid and its image data is loaded.
+* Returns ptr to imagemap_t or NULL.
+*/
+imagemap_t*	ImageMapManager::GetLoadedMap( unsigned int handle )
+{
+	imagemap_t* map = GetMap( handle );
+
+	if (map && !map->data)
+	{
+		LoadImage( map );
+	}
+	if (map && map->data)
+	{
+		return map;
+	}
+
+	return NULL;
+}
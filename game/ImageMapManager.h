@@ -40,6 +40,9 @@
 typedef struct {
 	idStr				name;		//!< the filename from where the image was loaded
 	Image*				img;		//!< The Image object that loads and contains the actual data
+	const unsigned char*data;		//!< img's pixel data, kept so lookups don't have to go through DevIL
+	int					width;		//!< img's width, only valid while data != NULL
+	int					height;		//!< img's height, only valid while data != NULL
 	float				density;	//!< average density (0..1.0)
 	unsigned int		users;		//!< How many objects currently use this image? Data can only be freed if users == 0.
 } imagemap_t;
@@ -99,6 +102,13 @@ public:
 	*/
 	float				GetMapDensity( const unsigned int id );
 
+	/**
+	* Returns the average density (0..1.0) of the image map as seen through the given
+	* scale and offset, which wrap around the image like the SEED map_scale and map_ofs.
+	* ofs_x and ofs_y are in fractions of the image size.
+	*/
+	float				GetMapDensity( const unsigned int id, const float ofs_x, const float ofs_y, const float scale_x, const float scale_y );
+
 	/**
 	* Given the id of a formerly loaded map, returns a value between 0 and 255 for the
 	* position on the map. xr and yr run from 0 .. 1.0f;
@@ -138,6 +148,11 @@ private:
 	*/
 	Image*				GetImage( unsigned int handle );
 
+	/**
+	* Like GetMap(), but also makes sure the image data is loaded. Returns NULL on errors.
+	*/
+	imagemap_t*			GetLoadedMap( unsigned int handle );
+
 	/** List of loaded image maps */
 	idList< imagemap_t >	m_imageMaps;
 
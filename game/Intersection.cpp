@@ -685,12 +685,36 @@ EIntersection IntersectLineLightCone(const idVec3 rkLine[LSG_COUNT],
 								 idVec3 rkCone[ELC_COUNT],
 								 idVec3 Intersect[2],
 								 bool inside[2])
+{
+	idPlane frustum[6];
+
+	GetLightConeFrustum(rkCone, frustum);
+
+	return IntersectLineLightFrustum(rkLine, frustum, Intersect, inside);
+}
+
+void GetLightConeFrustum(idVec3 rkCone[ELC_COUNT], idPlane frustum[6])
+{
+	idPlane lightProject[4];
+
+	R_SetLightProject(lightProject,
+					   rkCone[ELC_ORIGIN],
+					   rkCone[ELA_TARGET],
+					   rkCone[ELA_RIGHT],
+					   rkCone[ELA_UP],
+					   rkCone[ELA_START],
+					   rkCone[ELA_END]);
+	R_SetLightFrustum(lightProject, frustum);
+}
+
+EIntersection IntersectLineLightFrustum(const idVec3 rkLine[LSG_COUNT],
+								 const idPlane frustum[6],
+								 idVec3 Intersect[2],
+								 bool inside[2])
 {
 	EIntersection rc = INTERSECT_COUNT;
 	int i, n, intersectionCount, x;
 	float t;
-	idPlane lightProject[4];
-	idPlane frustum[6];
 	int sides[6][2] = { {0,0},
 						{0,0},
 						{0,0},
@@ -705,15 +729,6 @@ EIntersection IntersectLineLightCone(const idVec3 rkLine[LSG_COUNT],
 	DM_LOG(LC_LIGHT, LT_DEBUG)LOGSTRING("  rkLine[LSG_DIRECTION] = [%s]\r", rkLine[LSG_DIRECTION].ToString());
 	DM_LOG(LC_LIGHT, LT_DEBUG)LOGSTRING("  EndPoint = [%s]\r", EndPoint.ToString());
 
-	R_SetLightProject(lightProject,
-					   rkCone[ELC_ORIGIN],
-					   rkCone[ELA_TARGET],
-					   rkCone[ELA_RIGHT],
-					   rkCone[ELA_UP],
-					   rkCone[ELA_START],
-					   rkCone[ELA_END]);
-	R_SetLightFrustum(lightProject, frustum);
-
 /*
 	DM_LOGPLANE(LC_MATH, LT_DEBUG, "Light[0]", lightProject[0]);
 	DM_LOGPLANE(LC_MATH, LT_DEBUG, "Light[1]", lightProject[1]);
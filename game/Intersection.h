@@ -88,6 +88,14 @@ EIntersection IntersectLinesegmentLightEllipsoid(const idVec3 LineSegment[LSG_CO
 
 EIntersection IntersectLineCone(const idVec3 rkLine[LSG_COUNT], idVec3 rkCone[ELC_COUNT], idVec3 akPoint[2], bool Stump);
 EIntersection IntersectLineLightCone(const idVec3 rkLine[LSG_COUNT], idVec3 rkCone[ELC_COUNT], idVec3 akPoint[2], bool inside[2]); // grayman #3584
+
+/**
+ * IntersectLineLightCone() split in two, so the frustum of a light cone can be
+ * computed once and reused for many lines as long as the light doesn't change.
+ * GetLightConeFrustum() may modify the right and up vectors of the cone.
+ */
+void GetLightConeFrustum(idVec3 rkCone[ELC_COUNT], idPlane frustum[6]);
+EIntersection IntersectLineLightFrustum(const idVec3 rkLine[LSG_COUNT], const idPlane frustum[6], idVec3 akPoint[2], bool inside[2]);
 bool LineSegTriangleIntersect(const idVec3 Seg[LSG_COUNT], idVec3 Triangle[3], idVec3 &Intersect, float &t);
 
 void R_SetLightFrustum(const idPlane lightProject[4], idPlane frustum[6]);
@@ -31,7 +31,12 @@ static bool versioned = RegisterVersionedFile("$Id$");
 // Constructor
 CInventoryCategory::CInventoryCategory(CInventory* inventory, const idStr& name) :
 	m_Inventory(inventory),
-	m_Name(name)
+	m_Name(name),
+	m_ItemIndexChangeCount(-1),
+	m_LootChangeCount(-1),
+	m_Gold(0),
+	m_Jewelry(0),
+	m_Goods(0)
 {
 	m_Owner = (inventory != NULL) ? inventory->GetOwner() : NULL;
 }
@@ -92,6 +97,7 @@ void CInventoryCategory::Restore(idRestoreGame *savefile)
 		{
 			item->Restore(savefile);
 			m_Item.Append(item);
+			ItemsChanged();
 
 			// Set the pointers of the item class directly
 			item->SetCategory(this);
@@ -128,6 +134,35 @@ void CInventoryCategory::PutItem(const CInventoryItemPtr& item, bool insertAtFro
 		// Add to end of list
 		m_Item.Append(item);
 	}
+
+	ItemsChanged();
+}
+
+void CInventoryCategory::ItemsChanged()
+{
+	m_ItemIndexChangeCount = -1;
+	m_LootChangeCount = -1;
+}
+
+void CInventoryCategory::UpdateItemIndex()
+{
+	if (m_ItemIndexChangeCount == CInventoryItem::GetNameChangeCount())
+	{
+		return;
+	}
+
+	m_ItemNameHash.Clear();
+	m_ItemIdHash.Clear();
+
+	// Add back to front, so the hash chains start with the lowest index and
+	// the first item of a given name is found, like with a linear search
+	for (int i = m_Item.Num() - 1; i >= 0; i--)
+	{
+		m_ItemNameHash.Add(idStr::Hash(m_Item[i]->GetName()), i);
+		m_ItemIdHash.Add(idStr::Hash(m_Item[i]->GetItemId()), i);
+	}
+
+	m_ItemIndexChangeCount = CInventoryItem::GetNameChangeCount();
 }
 
 bool CInventoryCategory::SwapItemPosition(const CInventoryItemPtr& item1, const CInventoryItemPtr& item2)
@@ -144,6 +179,8 @@ bool CInventoryCategory::SwapItemPosition(const CInventoryItemPtr& item1, const
 		m_Item[idx2] = m_Item[idx1];
 		m_Item[idx1] = temp;
 
+		ItemsChanged();
+
 		return true; // success
 	}
 
@@ -160,24 +197,18 @@ CInventoryItemPtr CInventoryCategory::GetItem(const idStr& itemName)
 {
 	if (itemName.IsEmpty()) return CInventoryItemPtr();
 
-	for (int i = 0; i < m_Item.Num(); i++)
-	{
-		const CInventoryItemPtr& item = m_Item[i];
+	int index = GetItemIndex(itemName);
 
-		if (itemName == item->GetName())
-		{
-			return item;
-		}
-	}
-
-	return CInventoryItemPtr();
+	return (index != -1) ? m_Item[index] : CInventoryItemPtr();
 }
 
 CInventoryItemPtr CInventoryCategory::GetItemById(const idStr& id)
 {
 	if (id.IsEmpty()) return CInventoryItemPtr();
 
-	for (int i = 0; i < m_Item.Num(); i++)
+	UpdateItemIndex();
+
+	for (int i = m_ItemIdHash.First(idStr::Hash(id)); i != -1; i = m_ItemIdHash.Next(i))
 	{
 		const CInventoryItemPtr& item = m_Item[i];
 
@@ -207,7 +238,9 @@ CInventoryItemPtr CInventoryCategory::GetItemByType(CInventoryItem::ItemType typ
 
 int CInventoryCategory::GetItemIndex(const idStr& itemName)
 {
-	for (int i = 0; i < m_Item.Num(); i++)
+	UpdateItemIndex();
+
+	for (int i = m_ItemNameHash.First(idStr::Hash(itemName)); i != -1; i = m_ItemNameHash.Next(i))
 	{
 		if (itemName == m_Item[i]->GetName())
 		{
@@ -225,34 +258,50 @@ int CInventoryCategory::GetItemIndex(const CInventoryItemPtr& item)
 
 int CInventoryCategory::GetLoot(int& gold, int& jewelry, int& goods)
 {
-	for (int i = 0; i < m_Item.Num(); i++)
+	if (m_LootChangeCount != CInventoryItem::GetLootChangeCount())
 	{
-		const CInventoryItemPtr& item = m_Item[i];
+		m_Gold = 0;
+		m_Jewelry = 0;
+		m_Goods = 0;
 
-		switch (item->GetLootType())
+		for (int i = 0; i < m_Item.Num(); i++)
 		{
-			case LOOT_JEWELS:
-				jewelry += item->GetValue();
-			break;
-
-			case LOOT_GOLD:
-				gold += item->GetValue();
-			break;
-
-			case LOOT_GOODS:
-				goods += item->GetValue();
-			break;
-			
-			default: break;
+			const CInventoryItemPtr& item = m_Item[i];
+
+			switch (item->GetLootType())
+			{
+				case LOOT_JEWELS:
+					m_Jewelry += item->GetValue();
+				break;
+
+				case LOOT_GOLD:
+					m_Gold += item->GetValue();
+				break;
+
+				case LOOT_GOODS:
+					m_Goods += item->GetValue();
+				break;
+				
+				default: break;
+			}
 		}
+
+		m_LootChangeCount = CInventoryItem::GetLootChangeCount();
 	}
 
+	gold += m_Gold;
+	jewelry += m_Jewelry;
+	goods += m_Goods;
+
 	return gold + jewelry + goods;
 }
 
 void CInventoryCategory::RemoveItem(const CInventoryItemPtr& item)
 {
-	m_Item.Remove(item);
+	if (m_Item.Remove(item))
+	{
+		ItemsChanged();
+	}
 }
 
 int CInventoryCategory::GetNumItems() const
@@ -52,7 +52,8 @@ public:
 	int						GetItemIndex(const idStr& itemName);
 	int						GetItemIndex(const CInventoryItemPtr& item);
 
-	// Returns the sum of all gold, loot and jewelry of this category plus the gold, loot, jewelry sums on their own.
+	// Adds the gold, jewelry and goods sums of this category to the given ones, returns the sum of all three.
+	// The sums are cached until an item is added or removed or any loot value changes.
 	int						GetLoot(int& gold, int& jewelry, int& goods);
 
 	/**
@@ -96,6 +97,12 @@ public:
 private:
 	void					PutItem(const CInventoryItemPtr& item, bool insertAtFront);
 
+	// Invalidates the name indexes and the loot sums after m_Item changed
+	void					ItemsChanged();
+
+	// Rebuilds the name and id indexes if they are out of date
+	void					UpdateItemIndex();
+
 private:
 	CInventory*				m_Inventory;			// The inventory this group belongs to.
 	idEntityPtr<idEntity>	m_Owner;
@@ -105,6 +112,18 @@ private:
 
 	// A list of contained items (are deleted on destruction of this object).
 	idList<CInventoryItemPtr>	m_Item;
+
+	// Indexes into m_Item by name and id hash, valid while m_ItemIndexChangeCount
+	// equals CInventoryItem::GetNameChangeCount()
+	idHashIndex				m_ItemNameHash;
+	idHashIndex				m_ItemIdHash;
+	int						m_ItemIndexChangeCount;
+
+	// Cached loot sums, valid while m_LootChangeCount equals CInventoryItem::GetLootChangeCount()
+	int						m_LootChangeCount;
+	int						m_Gold;
+	int						m_Jewelry;
+	int						m_Goods;
 };
 typedef boost::shared_ptr<CInventoryCategory> CInventoryCategoryPtr;
 
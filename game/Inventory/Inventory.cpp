@@ -42,6 +42,7 @@ static idStr sLootTypeName[LOOT_COUNT] =
 
 CInventory::CInventory() :
 	m_HighestCursorId(0),
+	m_CategoryHashValid(false),
 	m_LootItemCount(0),
 	m_Gold(0),
 	m_Jewelry(0),
@@ -61,6 +62,7 @@ void CInventory::Clear()
 {
 	m_Owner = NULL;
 	m_Category.Clear();
+	m_CategoryHashValid = false;
 	m_Cursor.Clear();
 }
 
@@ -398,6 +400,7 @@ CInventoryCategoryPtr CInventory::CreateCategory(const idStr& categoryName, int*
 	
 	// Add the new Category to our list
 	int i = m_Category.AddUnique(rc);
+	m_CategoryHashValid = false;
 
 	// Should we return an index?
 	if (index != NULL)
@@ -416,8 +419,10 @@ CInventoryCategoryPtr CInventory::GetCategory(const idStr& categoryName, int* in
 		return GetCategory(TDM_INVENTORY_DEFAULT_GROUP);
 	}
 
-	// Traverse the categories and find the one matching <CategoryName>
-	for (int i = 0; i < m_Category.Num(); i++)
+	UpdateCategoryIndex();
+
+	// Look up the category matching <CategoryName>
+	for (int i = m_CategoryHash.First(idStr::Hash(categoryName)); i != -1; i = m_CategoryHash.Next(i))
 	{
 		if (m_Category[i]->GetName() == categoryName)
 		{
@@ -433,6 +438,24 @@ CInventoryCategoryPtr CInventory::GetCategory(const idStr& categoryName, int* in
 	return CInventoryCategoryPtr(); // not found
 }
 
+void CInventory::UpdateCategoryIndex()
+{
+	if (m_CategoryHashValid)
+	{
+		return;
+	}
+
+	m_CategoryHash.Clear();
+
+	// Add back to front, so the first category of a name is found first
+	for (int i = m_Category.Num() - 1; i >= 0; i--)
+	{
+		m_CategoryHash.Add(idStr::Hash(m_Category[i]->GetName()), i);
+	}
+
+	m_CategoryHashValid = true;
+}
+
 CInventoryCategoryPtr CInventory::GetCategory(int index) const
 {
 	// return NULL for invalid indices
@@ -975,6 +998,7 @@ void CInventory::Restore(idRestoreGame *savefile)
 		category->Restore(savefile);
 		m_Category.Append(category);
 	}
+	m_CategoryHashValid = false;
 
 	savefile->ReadInt(m_LootItemCount);
 	savefile->ReadInt(m_Gold);
@@ -994,6 +1018,7 @@ void CInventory::Restore(idRestoreGame *savefile)
 void CInventory::RemoveCategory(const CInventoryCategoryPtr& category)
 {
 	m_Category.Remove(category);
+	m_CategoryHashValid = false;
 }
 
 CInventoryItemPtr CInventory::ValidateAmmo(idEntity* ent, const bool gotFromShop) // grayman (#2376)
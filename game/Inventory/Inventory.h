@@ -247,6 +247,9 @@ private:
 	 */
 	CInventoryItemPtr		ValidateWeapon(idEntity* ent, const bool gotFromShop); // grayman (#2376)
 
+	// Rebuilds m_CategoryHash if categories have been added or removed
+	void					UpdateCategoryIndex();
+
 private:
 	idEntityPtr<idEntity>				m_Owner;
 
@@ -258,6 +261,10 @@ private:
 	 */
 	idList<CInventoryCategoryPtr>		m_Category;
 
+	// Index into m_Category by name hash, category names don't change after creation
+	idHashIndex							m_CategoryHash;
+	bool								m_CategoryHashValid;
+
 	/**
 	 * Here we keep the lootcount for the items, that don't need to actually 
 	 * be stored in the inventory, because they can't get displayed anyway.
@@ -28,6 +28,9 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #include "Inventory.h"
 #include <algorithm>
 
+int CInventoryItem::m_NameChangeCount = 0;
+int CInventoryItem::m_LootChangeCount = 0;
+
 CInventoryItem::CInventoryItem(idEntity *owner)
 {
 	m_Owner = owner;
@@ -241,6 +244,8 @@ void CInventoryItem::SetLootType(LootType t)
 		m_LootType = LOOT_NONE;
 	}
 
+	m_LootChangeCount++;
+
 	NotifyItemChanged();
 }
 
@@ -250,11 +255,24 @@ void CInventoryItem::SetValue(int n)
 	if (n >= 0)
 	{
 		m_Value = n;
+		m_LootChangeCount++;
 
 		NotifyItemChanged();
 	}
 }
 
+void CInventoryItem::SetName(const idStr &n)
+{
+	m_Name = n;
+	m_NameChangeCount++;
+}
+
+void CInventoryItem::SetItemId(const idStr &id)
+{
+	m_ItemId = id;
+	m_NameChangeCount++;
+}
+
 void CInventoryItem::SaveItemEntityDict()
 {
 	idEntity* ent = GetItemEntity();
@@ -89,7 +89,7 @@ public:
 	void					SetValue(int n);
 	int						GetValue() { return m_Value; };
 
-	void					SetName(const idStr &n) { m_Name = n; };
+	void					SetName(const idStr &n);
 	const idStr&			GetName() { return m_Name; };
 
 	void					SetItem(idEntity *item) { m_Item = item; };
@@ -104,11 +104,19 @@ public:
 	const idStr&			GetIcon() { return m_Icon; };
 	void					SetIcon(const idStr& newIcon);
 
-	void					SetItemId(const idStr &id) { m_ItemId = id; };
+	void					SetItemId(const idStr &id);
 	const idStr&			GetItemId() { return m_ItemId; };
 
 	static LootType			GetLootTypeFromSpawnargs(const idDict& spawnargs);
 
+	/**
+	 * Incremented whenever the name or id (resp. the loot type or value) of any item
+	 * changes. Items can be shared between inventories, so the categories compare these
+	 * to tell whether their name indexes and loot sums are still valid.
+	 */
+	static int				GetNameChangeCount() { return m_NameChangeCount; }
+	static int				GetLootChangeCount() { return m_LootChangeCount; }
+
 	/**
 	 * greebo: This returns the number of persistent items contained in this InventoryItem.
 	 *         For ordinary persistent items, this is always 1, for non-persistent items this is 0.
@@ -214,6 +222,9 @@ protected:
 	* Except for pitch, which is the same as its original pitch
 	**/
 	idMat3					m_DropOrientation;
+
+	static int				m_NameChangeCount;
+	static int				m_LootChangeCount;
 };
 typedef boost::shared_ptr<CInventoryItem> CInventoryItemPtr;
 
@@ -180,6 +180,7 @@ void idGameEdit::ParseSpawnArgsToRenderLight( const idDict *args, renderLight_t
 	args->GetBool( "parallel", "0", renderLight->parallel );
 
 	args->GetBool( "noFogBoundary", "0", renderLight->noFogBoundary ); // Stops fogs drawing and fogging their bounding boxes -- SteveL #3664
+	args->GetBool( "shadowmap", "0", renderLight->shadowMap );
 
 	args->GetString( "texture", "lights/squarelight1", &texture );
 	// allow this to be NULL
@@ -229,6 +230,7 @@ idLight::idLight()
 	lightDefHandle		= -1;
 	levels				= 0;
 	currentLevel		= 0;
+	LASStateRevision	= 0;
 	baseColor			= vec3_zero;
 	breakOnTrigger		= false;
 	count				= 0;
@@ -257,6 +259,8 @@ idLight::idLight()
 	Darkmod LAS
 	*/
 	LASAreaIndex = -1;
+
+	lightNode.SetOwner( this );
 }
 
 /*
@@ -266,6 +270,8 @@ idLight::~idLight
 */
 idLight::~idLight()
 {
+	lightNode.Remove();
+
 	if ( lightDefHandle != -1 ) {
 		gameRenderWorld->FreeLightDef( lightDefHandle );
 	}
@@ -459,6 +465,8 @@ void idLight::Spawn( void )
 {
 	const char *demonic_shader;
 
+	lightNode.AddToEnd( gameLocal.spawnedLights );
+
 	// do the parsing the same way dmap and the editor do
 	gameEdit->ParseSpawnArgsToRenderLight( &spawnArgs, &renderLight );
 
@@ -1059,6 +1067,9 @@ DM_LOG(LC_FUNCTION, LT_DEBUG)LOGSTRING("this: %08lX [%s] Radius ( %0.3f / %0.3f
 		renderLight.lightRadius[1],		// y
 		renderLight.lightRadius[2]);	// z
 */
+	// the LAS has to pick up any change in radius, shape or shader
+	LASStateRevision++;
+
 	// let the renderer apply it to the world
 	if ( ( lightDefHandle != -1 ) ) {
 		gameRenderWorld->UpdateLightDef( lightDefHandle, &renderLight );
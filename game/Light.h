@@ -377,6 +377,15 @@ public:
 	* The area the light is in, assigned by The Dark Mod Lighting Awareness System (LAS)
 	*/
 	int LASAreaIndex;
+
+	idLinkList<idLight>		lightNode;			// for being linked into gameLocal.spawnedLights
+
+	/*!
+	* Darkmod LAS
+	* Incremented whenever the renderLight is presented to the renderer, so the LAS
+	* knows when the light volume it has cached for this light is out of date.
+	*/
+	int LASStateRevision;
 };
 
 #endif /* !__GAME_LIGHT_H__ */
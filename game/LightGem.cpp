@@ -24,6 +24,7 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 #include "LightGem.h"
 #include "Grabber.h"
+#include "DarkModGlobals.h"
 
 // Temporary profiling related macros
 
@@ -94,6 +95,7 @@ void LightGem::Clear()
 	m_LightgemShotSpot = 0;
 
 	memset(m_LightgemShotValue, 0, sizeof(m_LightgemShotValue));
+	memset(m_LightgemShotQueued, 0, sizeof(m_LightgemShotQueued));
 }
 
 void LightGem::SpawnLightGemEntity( idMapFile *	a_mapFile )
@@ -173,6 +175,8 @@ void LightGem::Restore( idRestoreGame & a_savedGame )
 	for (int i = 0; i < DARKMOD_LG_MAX_RENDERPASSES; i++) {
 		a_savedGame.ReadFloat(m_LightgemShotValue[i]);
 	}
+	// whatever the renderer still holds was rendered before the load
+	memset(m_LightgemShotQueued, 0, sizeof(m_LightgemShotQueued));
 
 	m_LightgemSurface.GetEntity()->GetRenderEntity()->allowSurfaceInViewID = DARKMOD_LG_VIEWID;
 	m_LightgemSurface.GetEntity()->GetRenderEntity()->suppressShadowInViewID = 0;
@@ -198,6 +202,10 @@ float LightGem::Calculate(idPlayer *player)
 	if ( player->GetModelDefHandle() == -1 ) {
 		return 0.0f;
 	}
+
+	if ( cv_lg_analytic.GetBool() ) {
+		return CalculateAnalytic( player );
+	}
 	
 	{ // Get position for lg
 		idEntity* lg = m_LightgemSurface.GetEntity();
@@ -284,6 +292,7 @@ float LightGem::Calculate(idPlayer *player)
 	float fRetVal = 0.0f;
 	const int k = cv_lg_hud.GetInteger() - 1;
 	static const int nRenderPasses = cv_lg_renderpasses.GetInteger();
+	const bool async = cv_lg_async.GetBool();
 
 	renderSystem->CropRenderSize(DARKMOD_LG_RENDER_WIDTH, DARKMOD_LG_RENDER_WIDTH, true, true);
 
@@ -295,8 +304,6 @@ float LightGem::Calculate(idPlayer *player)
 			continue;
 		}
 
-		m_LightgemShotValue[i] = 0.0f;
-
 		// Render up and down alternately 
 		m_Lightgem_rv.viewaxis.TransposeSelf();
 		
@@ -318,9 +325,21 @@ float LightGem::Calculate(idPlayer *player)
 			PROFILE_BLOCK_START	( LightGem_Calculate_ForLoop_CaptureRenderToBuffer );
 			DM_LOG(LC_LIGHT, LT_DEBUG)LOGSTRING("Rendering to lightgem render buffer\n");
 
-			renderSystem->CaptureRenderToBuffer(m_LightgemImgBuffer);
+			// Asynchronously the buffer gets the render of this pass queued on its previous turn,
+			// which is discarded if it was queued before a map (re)start or without tdm_lg_async.
+			bool captured = renderSystem->CaptureRenderToBuffer(m_LightgemImgBuffer, async ? i : -1);
+			if ( async && !m_LightgemShotQueued[i] ) {
+				captured = false;
+			}
+			m_LightgemShotQueued[i] = async;
 			PROFILE_BLOCK_END	( LightGem_Calculate_ForLoop_CaptureRenderToBuffer );
 
+			// keep the last value of the pass until there is a new one
+			if ( !captured ) {
+				continue;
+			}
+			m_LightgemShotValue[i] = 0.0f;
+
 #if 0
 			{ // Save render if we have a path specified (for debugging)
 				const char* dp = cv_lg_path.GetString();
@@ -348,6 +367,8 @@ float LightGem::Calculate(idPlayer *player)
 			}
 
 			PROFILE_BLOCK_END	( LightGem_Calculate_ForLoop_Cleanup );
+		} else {
+			m_LightgemShotValue[i] = 0.0f;
 		}
 	}
 
@@ -391,6 +412,33 @@ float LightGem::Calculate(idPlayer *player)
 	return fRetVal;
 }
 
+float LightGem::CalculateAnalytic( idPlayer *player )
+{
+	PROFILE_BLOCK( LightGem_CalculateAnalytic );
+
+	// The same line from the feet up to the eyes that the AI test other actors with,
+	// so the lightgem shows exactly what the AI will see. The light falloff and
+	// projection images are sampled by the LAS, and its traces include shadows.
+	idVec3 bottom = player->GetPhysics()->GetOrigin();
+	idVec3 top = player->GetEyePosition();
+
+	// just above the floor, like idEntity::GetLightQuotient()
+	bottom.z += 0.25f;
+
+	// Currently grabbed entities should not cast a shadow on the lightgem, same as in the renders.
+	// The LAS can only ignore one entity, so the player's own body isn't excluded while holding something.
+	idEntity *ignore = gameLocal.m_Grabber->GetSelected();
+	if ( ignore == NULL ) {
+		ignore = player;
+	}
+
+	float fRetVal = LAS.queryLightingAlongLine( bottom, top, ignore, true );
+
+	DM_LOG(LC_LIGHT, LT_DEBUG)LOGSTRING("Analytic lightgem value: %f\r", fRetVal);
+
+	return idMath::ClampFloat( 0.0f, 1.0f, fRetVal );
+}
+
 void LightGem::AnalyzeRenderImage()
 {
 	const unsigned char *buffer = m_LightgemImgBuffer;
@@ -58,6 +58,8 @@ class LightGem
 private:
 	int						m_LightgemShotSpot;
 	float					m_LightgemShotValue[DARKMOD_LG_MAX_RENDERPASSES];
+	// An asynchronous read back of the pass is waiting in the renderer (tdm_lg_async)
+	bool					m_LightgemShotQueued[DARKMOD_LG_MAX_RENDERPASSES];
 	idEntityPtr<idEntity>	m_LightgemSurface;
 
 	unsigned char*			m_LightgemImgBuffer;
@@ -98,6 +100,8 @@ public:
 	float	Calculate		( idPlayer *	a_pPlayer );
 
 private:
+	// tdm_lg_analytic: the light at the player from the Light Awareness System, without any rendering
+	float CalculateAnalytic	( idPlayer *	a_pPlayer );
 	void AnalyzeRenderImage	( );
 };
 
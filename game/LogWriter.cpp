@@ -0,0 +1,184 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+
+#include "precompiled_game.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "LogWriter.h"
+
+CLogWriter::CLogWriter() :
+	_records(NULL),
+	_writePosition(0),
+	_readPosition(0),
+	_file(NULL),
+	_stop(false),
+	_thread(NULL)
+{}
+
+CLogWriter::~CLogWriter()
+{
+	// Stop() must have been called before, joining in a DLL destructor can deadlock
+	delete[] _records;
+}
+
+void CLogWriter::Start(FILE* file)
+{
+	if (_file != NULL || file == NULL)
+	{
+		return;
+	}
+
+	if (_records == NULL)
+	{
+		_records = new Record[NUM_RECORDS];
+	}
+
+	for (unsigned int i = 0; i < NUM_RECORDS; ++i)
+	{
+		_records[i].sequence.store(i, boost::memory_order_relaxed);
+	}
+
+	_writePosition.store(0, boost::memory_order_relaxed);
+	_readPosition.store(0, boost::memory_order_relaxed);
+	_stop = false;
+	_file = file;
+
+	_thread = new boost::thread(boost::bind(&CLogWriter::Run, this));
+}
+
+void CLogWriter::Stop()
+{
+	if (_file == NULL)
+	{
+		return;
+	}
+
+	_stop = true;
+	_thread->join();
+
+	delete _thread;
+	_thread = NULL;
+	_file = NULL;
+}
+
+void CLogWriter::Push(int logClass, int logType, const char* filename, int line, long frame, const char* fmt, va_list args)
+{
+	unsigned int position = _writePosition.load(boost::memory_order_relaxed);
+	Record* record;
+
+	while (true)
+	{
+		record = &_records[position & (NUM_RECORDS - 1)];
+		const int diff = static_cast<int>(record->sequence.load(boost::memory_order_acquire) - position);
+
+		if (diff == 0)
+		{
+			// The slot is free, try to claim it
+			if (_writePosition.compare_exchange_weak(position, position + 1, boost::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			// The ring is full, wait for the writer
+			boost::this_thread::yield();
+			position = _writePosition.load(boost::memory_order_relaxed);
+		}
+		else
+		{
+			// Another thread claimed it first
+			position = _writePosition.load(boost::memory_order_relaxed);
+		}
+	}
+
+	record->logClass = logClass;
+	record->logType = logType;
+	record->filename = filename;
+	record->line = line;
+	record->frame = frame;
+	idStr::vsnPrintf(record->text, RECORD_TEXT_LENGTH, fmt, args);
+
+	// Hand the record to the writer
+	record->sequence.store(position + 1, boost::memory_order_release);
+}
+
+void CLogWriter::Flush()
+{
+	if (_file == NULL)
+	{
+		return;
+	}
+
+	const unsigned int position = _writePosition.load(boost::memory_order_acquire);
+
+	while (static_cast<int>(_readPosition.load(boost::memory_order_acquire) - position) < 0)
+	{
+		boost::this_thread::yield();
+	}
+}
+
+bool CLogWriter::WriteRecords()
+{
+	unsigned int position = _readPosition.load(boost::memory_order_relaxed);
+	bool written = false;
+
+	while (true)
+	{
+		Record& record = _records[position & (NUM_RECORDS - 1)];
+
+		if (record.sequence.load(boost::memory_order_acquire) != position + 1)
+		{
+			break; // not ready yet
+		}
+
+		WritePrefix(_file, record.logClass, record.logType, record.filename, record.line, record.frame);
+		fputs(record.text, _file);
+		fputc('\n', _file);
+
+		// Free the slot for the next round of the ring
+		record.sequence.store(position + NUM_RECORDS, boost::memory_order_release);
+		_readPosition.store(++position, boost::memory_order_release);
+		written = true;
+	}
+
+	if (written)
+	{
+		fflush(_file);
+	}
+
+	return written;
+}
+
+void CLogWriter::Run()
+{
+	while (!_stop)
+	{
+		if (!WriteRecords())
+		{
+			boost::this_thread::sleep(boost::posix_time::milliseconds(2));
+		}
+	}
+
+	// Write what was queued before the stop
+	WriteRecords();
+}
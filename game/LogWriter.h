@@ -0,0 +1,97 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+
+#ifndef TDM_LOG_WRITER_H
+#define TDM_LOG_WRITER_H
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <boost/atomic.hpp>
+#include <boost/thread/thread.hpp>
+
+/**
+ * The writer behind DM_LOG. The calling threads format their message
+ * into a record of a fixed size ring buffer and go on, the writer thread adds
+ * the file/line/class prefix and writes the records to the log file, flushing
+ * once per batch instead of once per line.
+ *
+ * Slots are claimed with a compare-and-swap on the write position, so any thread
+ * (the parallel thinks included) can log without taking a lock. When the ring is
+ * full the callers wait for the writer rather than lose lines.
+ */
+class CLogWriter
+{
+public:
+	enum
+	{
+		RECORD_TEXT_LENGTH = 1024,		// longer messages are truncated
+		NUM_RECORDS = 2048,				// must be a power of two
+	};
+
+	CLogWriter();
+	~CLogWriter();
+
+	// Starts the writer thread on the given file, which stays owned by the caller
+	void Start(FILE* file);
+
+	// Writes the pending records and ends the writer thread
+	void Stop();
+
+	bool IsRunning() const
+	{
+		return _file != NULL;
+	}
+
+	// Queues a log line, the message is formatted right away
+	void Push(int logClass, int logType, const char* filename, int line, long frame, const char* fmt, va_list args);
+
+	// Waits until the records queued so far are written
+	void Flush();
+
+	// The prefix of a log line, shared with the synchronous path in CGlobal
+	static void WritePrefix(FILE* file, int logClass, int logType, const char* filename, int line, long frame);
+
+private:
+	struct Record
+	{
+		boost::atomic<unsigned int> sequence;	// == position + 1 when the record is ready to be written
+		int logClass;
+		int logType;
+		const char* filename;
+		int line;
+		long frame;
+		char text[RECORD_TEXT_LENGTH];
+	};
+
+	void Run();
+
+	// Writes the ready records, returns false if there were none
+	bool WriteRecords();
+
+	Record* _records;
+	boost::atomic<unsigned int> _writePosition;
+	boost::atomic<unsigned int> _readPosition;	// only advanced by the writer thread
+
+	FILE* _file;
+	volatile bool _stop;
+	boost::thread* _thread;
+};
+
+#endif /* TDM_LOG_WRITER_H */
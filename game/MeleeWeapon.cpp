@@ -33,6 +33,10 @@ END_CLASS
 const int CONTENTS_MELEE_WORLDCOLLIDE = MASK_SHOT_RENDERMODEL | CONTENTS_MELEEWEAP | CONTENTS_CORPSE;
 const int CONTENTS_MELEE_ACTCOLLIDE = CONTENTS_MELEEWEAP | CONTENTS_BODY; // parries/held items, AI
 
+// AI within this distance of the CM swap bounds are candidates until the next refresh
+const int MELEE_SWAP_CANDIDATES_INTERVAL = 250;
+const float MELEE_SWAP_CANDIDATES_MARGIN = 128.0f;
+
 CMeleeWeapon::CMeleeWeapon( void ) 
 {
 	m_Owner = NULL;
@@ -54,6 +58,7 @@ CMeleeWeapon::CMeleeWeapon( void )
 
 	m_bModAICMs = false;
 	m_AIWithModCMs.Clear();
+	m_SwapCandidatesTime = -1;
 
 	m_OldOrigin = vec3_zero;
 	m_OldAxis = mat3_identity;
@@ -126,6 +131,8 @@ void CMeleeWeapon::Restore( idRestoreGame *savefile )
 
 	savefile->ReadBool( m_bModAICMs );
 	m_AIWithModCMs.Clear();
+	m_SwapCandidates.Clear();
+	m_SwapCandidatesTime = -1;
 	int num;
 	savefile->ReadInt( num );
 	m_AIWithModCMs.SetNum( num );
@@ -176,6 +183,7 @@ void CMeleeWeapon::ActivateAttack( idActor *ActOwner, const char *AttName )
 	m_StopMass = spawnArgs.GetFloat("stop_mass");
 	m_ParticlesMade = 0;
 	m_bModAICMs = spawnArgs.GetBool("use_larger_ai_head_CMs");
+	m_SwapCandidatesTime = -1;
 
 	m_WeapClip = NULL;
 	pClip = GetPhysics()->GetClipModel();
@@ -333,6 +341,7 @@ void CMeleeWeapon::DeactivateAttack( void )
 			}
 		}
 		m_AIWithModCMs.Clear();
+		m_SwapCandidates.Clear();
 	}
 }
 
@@ -623,6 +632,14 @@ void CMeleeWeapon::CheckAttack( idVec3 OldOrigin, idMat3 OldAxis )
 	if( cv_melee_debug.GetBool() )
 		collisionModelManager->DrawModel( pClip->Handle(), NewOrigin, NewAxis, gameLocal.GetLocalPlayer()->GetEyePosition(), idMath::INFINITY );
 
+	// in a brawl most swings don't come near anything for most of their frames
+	if( cv_melee_sweep_cull.GetBool() && !SweepMayHit( OldOrigin, NewOrigin, pClip, ClipMask ) )
+	{
+		GetPhysics()->SetContents( contentsEnt );
+		m_Owner.GetEntity()->GetPhysics()->SetContents( contentsOwner );
+		return;
+	}
+
 	gameLocal.clip.Motion
 	(
 		tr, OldOrigin, NewOrigin, 
@@ -1463,16 +1480,29 @@ void CMeleeWeapon::CheckAICMSwaps( )
 	b.ExpandSelf(50.0f);
 	b.TranslateSelf( GetPhysics()->GetOrigin() + m_ClipOffset );
 
-	idEntity *ents[MAX_GENTITIES];
-	int numEnts;
-	numEnts = gameLocal.clip.EntitiesTouchingBounds( b, CONTENTS_BODY, ents, MAX_GENTITIES );
+	// walk the few AI that were near at the last refresh instead of the clip sectors
+	if( m_SwapCandidatesTime < 0 || gameLocal.time - m_SwapCandidatesTime >= MELEE_SWAP_CANDIDATES_INTERVAL )
+	{
+		idBounds reach = b.Expand( MELEE_SWAP_CANDIDATES_MARGIN );
+
+		m_SwapCandidates.Clear();
+		for( idAI *ai = gameLocal.spawnedAI.Next(); ai != NULL; ai = ai->aiNode.Next() )
+		{
+			if( reach.IntersectsBounds( ai->GetPhysics()->GetAbsBounds() ) )
+			{
+				idEntityPtr<idAI> &candidate = m_SwapCandidates.Alloc();
+				candidate = ai;
+			}
+		}
+		m_SwapCandidatesTime = gameLocal.time;
+	}
 
-	for( int i = 0; i < numEnts; i++ )
+	for( int i = 0; i < m_SwapCandidates.Num(); i++ )
 	{
-		idEntity *pEnt = ents[i];
-		if( !pEnt->IsType(idAI::Type) )
+		idAI *pAI = m_SwapCandidates[i].GetEntity();
+		if( pAI == NULL || !( pAI->GetPhysics()->GetContents() & CONTENTS_BODY )
+			|| !b.IntersectsBounds( pAI->GetPhysics()->GetAbsBounds() ) )
 			continue;
-		idAI *pAI = static_cast<idAI *>(pEnt);
 		if( pAI->IsKnockedOut() || pAI->health < 0 || ( pAI->AI_AlertIndex >= ai::ECombat ) )
 			continue;
 		
@@ -1488,3 +1518,28 @@ void CMeleeWeapon::CheckAICMSwaps( )
 			pAI->SwapHeadAFCM( true );
 	}
 }
+
+bool CMeleeWeapon::SweepMayHit( const idVec3 &OldOrigin, const idVec3 &NewOrigin, const idClipModel *pClip, int ClipMask ) const
+{
+	// the world is traced as a whole, it can only be skipped if it has none of the contents
+	int worldContents;
+	if( !collisionModelManager->GetModelContents( 0, worldContents ) || ( worldContents & ClipMask ) )
+		return true;
+
+	idBounds hull( OldOrigin );
+	hull.AddPoint( NewOrigin );
+	hull.ExpandSelf( pClip->GetBounds().GetRadius() );
+
+	idClipModel *clipModels[ MAX_GENTITIES ];
+	int num = gameLocal.clip.ClipModelsTouchingBounds( hull, ClipMask, clipModels, MAX_GENTITIES );
+
+	// the owner is the pass entity of the swept trace
+	const idEntity *owner = m_Owner.GetEntity();
+	for( int i = 0; i < num; i++ )
+	{
+		if( clipModels[i] != pClip && clipModels[i]->GetEntity() != owner && clipModels[i]->GetOwner() != owner )
+			return true;
+	}
+
+	return false;
+}
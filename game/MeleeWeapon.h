@@ -118,6 +118,13 @@ protected:
 	**/
 	void CheckAICMSwaps( void );
 
+	/**
+	* Broad phase for CheckAttack: returns false if nothing the attack clips against
+	* is touching the volume the clipmodel can sweep moving from OldOrigin to NewOrigin,
+	* turning any way about its origin. The world counts only if it has any of the contents.
+	**/
+	bool SweepMayHit( const idVec3 &OldOrigin, const idVec3 &NewOrigin, const idClipModel *pClip, int ClipMask ) const;
+
 	/**
 	* Handle valid collision, called when trace hit something valid
 	* in either StarAttack or CheckAttack
@@ -259,6 +266,14 @@ protected:
 	**/
 	idList< idEntityPtr<idAI> >	m_AIWithModCMs;
 
+	/**
+	* AI near the weapon that CheckAICMSwaps looks at, gathered from
+	* gameLocal.spawnedAI at the start of the attack and every
+	* MELEE_SWAP_CANDIDATES_INTERVAL ms. Not saved, -1 time means stale.
+	**/
+	idList< idEntityPtr<idAI> >	m_SwapCandidates;
+	int						m_SwapCandidatesTime;
+
 };
 
 #endif /* !__MELEEWEAPON_H__ */
@@ -1813,6 +1813,19 @@ void idStaticEntity::Think( void )
 	}
 }
 
+/*
+================
+idStaticEntity::ThinksOnlyForLOD
+
+Nothing but the LOD distance checks to do: no gui, fade, pending
+visual update or decals, and physics that don't move
+================
+*/
+bool idStaticEntity::ThinksOnlyForLOD( void ) const {
+	return m_LODHandle != 0 && thinkFlags == TH_THINK && !runGui && fadeEnd == 0 && !needsDecalRestore
+		&& GetPhysics()->IsAtRest();
+}
+
 /*
 ================
 idStaticEntity::Fade
@@ -354,6 +354,7 @@ public:
 	virtual void		Think( void );
 
 	virtual void		ReapplyDecals(); // #3817
+	virtual bool		ThinksOnlyForLOD( void ) const;
 
 	virtual void		WriteToSnapshot( idBitMsgDelta &msg ) const;
 	virtual void		ReadFromSnapshot( const idBitMsgDelta &msg );
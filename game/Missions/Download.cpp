@@ -28,13 +28,26 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #include "MissionManager.h"
 
 #include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+
+namespace
+{
+	// Files smaller than two segments of this size are not split
+	const std::size_t MIN_SEGMENT_SIZE = 1024*1024;
+
+	std::size_t GetPartSize(const std::string& filename)
+	{
+		return fs::exists(filename) ? static_cast<std::size_t>(fs::file_size(filename)) : 0;
+	}
+}
 
 CDownload::CDownload(const idStr& url, const idStr& destFilename, bool enablePK4check) :
 	_curUrl(0),
 	_destFilename(destFilename),
 	_status(NOT_STARTED_YET),
 	_pk4CheckEnabled(enablePK4check),
-	_relatedDownload(-1)
+	_relatedDownload(-1),
+	_segmentedFilesize(0)
 {
 	_urls.Append(url);
 }
@@ -45,7 +58,8 @@ CDownload::CDownload(const idStringList& urls, const idStr& destFilename, bool e
 	_destFilename(destFilename),
 	_status(NOT_STARTED_YET),
 	_pk4CheckEnabled(enablePK4check),
-	_relatedDownload(-1)
+	_relatedDownload(-1),
+	_segmentedFilesize(0)
 {}
 
 CDownload::~CDownload()
@@ -86,8 +100,20 @@ void CDownload::Stop(bool canceled)
 		// the worker thread from proceeding to the next URL
 		_curUrl = _urls.Num();
 
-		// Cancel the request
-		_request->Cancel();
+		// Cancel the requests
+		{
+			boost::mutex::scoped_lock lock(_requestMutex);
+
+			_request->Cancel();
+
+			for (std::size_t i = 0; i < _segments.size(); ++i)
+			{
+				if (_segments[i].request != NULL)
+				{
+					_segments[i].request->Cancel();
+				}
+			}
+		}
 
 		// Wait for the thread to finish
 		_thread->join();
@@ -106,14 +132,67 @@ void CDownload::Stop(bool canceled)
 
 		// Remove temporary file
 		CMissionManager::DoRemoveFile(_tempFilename.c_str());
+		RemoveSegments();
 	}
 }
 
 double CDownload::GetProgressFraction()
 {
+	boost::mutex::scoped_lock lock(_requestMutex);
+
+	if (!_segments.empty() && _segmentedFilesize > 0)
+	{
+		std::size_t downloaded = 0;
+
+		for (std::size_t i = 0; i < _segments.size(); ++i)
+		{
+			const Segment& segment = _segments[i];
+
+			if (segment.done)
+			{
+				downloaded += segment.last - segment.first + 1;
+			}
+			else if (segment.request != NULL)
+			{
+				downloaded += segment.resumedBytes + segment.request->GetDownloadedBytes();
+			}
+		}
+
+		return static_cast<double>(downloaded) / _segmentedFilesize;
+	}
+
 	return _request != NULL ? _request->GetProgressFraction() : 0.0;
 }
 
+double CDownload::GetDownloadSpeed()
+{
+	boost::mutex::scoped_lock lock(_requestMutex);
+
+	if (!_segments.empty())
+	{
+		double speed = 0;
+
+		for (std::size_t i = 0; i < _segments.size(); ++i)
+		{
+			if (!_segments[i].done && _segments[i].request != NULL)
+			{
+				speed += _segments[i].request->GetDownloadSpeed();
+			}
+		}
+
+		return speed;
+	}
+
+	return _request != NULL ? _request->GetDownloadSpeed() : 0.0;
+}
+
+void CDownload::SetRequest(const CHttpRequestPtr& request)
+{
+	boost::mutex::scoped_lock lock(_requestMutex);
+
+	_request = request;
+}
+
 void CDownload::EnableValidPK4Check(bool enable)
 {
 	_pk4CheckEnabled = enable;
@@ -131,20 +210,65 @@ void CDownload::SetRelatedDownloadId(int relatedDownloadId)
 
 void CDownload::Perform()
 {
+	// Once a segmented download turned out broken, stick to single requests
+	bool trySegments = cv_tdm_download_segments.GetInteger() > 1;
+
+	// True if the temporary file holds the beginning of the file from a broken off request
+	bool resume = false;
+
 	while (_curUrl < _urls.Num())
 	{
 		// Remove any previous temporary file
-		CMissionManager::DoRemoveFile(_tempFilename.c_str());
+		if (!resume)
+		{
+			CMissionManager::DoRemoveFile(_tempFilename.c_str());
+		}
 
 		const idStr& url = _urls[_curUrl];
 
-		// Create a new request
-		_request = gameLocal.m_HttpConnection->CreateRequest(url.c_str(), _tempFilename.c_str());
+		bool succeeded = false;
+		SegmentedResult segmented = trySegments && !resume ? PerformSegmented() : SEGMENTS_NOT_APPLICABLE;
+
+		if (segmented == SEGMENTS_NOT_APPLICABLE)
+		{
+			// Create a new request
+			CHttpRequestPtr request = gameLocal.m_HttpConnection->CreateRequest(url.c_str(), _tempFilename.c_str());
+
+			std::size_t resumeOffset = resume ? GetPartSize(_tempFilename.c_str()) : 0;
+
+			if (resumeOffset > 0)
+			{
+				DM_LOG(LC_MAINMENU, LT_INFO)LOGSTRING("Resuming download at byte %lu from '%s'.", static_cast<unsigned long>(resumeOffset), url.c_str());
+				request->SetRange(resumeOffset);
+			}
+
+			SetRequest(request);
 	
-		// Start the download, blocks until finished or aborted
-		_request->Perform();
+			// Start the download, blocks until finished or aborted
+			request->Perform();
 
-		if (_request->GetStatus() == CHttpRequest::OK)
+			succeeded = request->GetStatus() == CHttpRequest::OK;
+
+			if (request->RangeRejected())
+			{
+				// This server can't resume, try it again from the start
+				DM_LOG(LC_MAINMENU, LT_DEBUG)LOGSTRING("Server '%s' doesn't support resuming, restarting download.", url.c_str());
+				resume = false;
+				continue;
+			}
+		}
+		else if (segmented == SEGMENTS_FAILED)
+		{
+			// Every segment had its go at all mirrors
+			_curUrl = _urls.Num();
+			break;
+		}
+		else
+		{
+			succeeded = true;
+		}
+
+		if (succeeded)
 		{
 			// Check the downloaded file
 			if (_pk4CheckEnabled)
@@ -153,6 +277,8 @@ void CDownload::Perform()
 
 				if (!valid)
 				{
+					trySegments = false;
+					resume = false;
 					_curUrl++;
 					continue;
 				}
@@ -190,11 +316,14 @@ void CDownload::Perform()
 				DM_LOG(LC_MAINMENU, LT_DEBUG)LOGSTRING("Connection Error (status = %i) for URL '%s'.", _request->GetStatus(), url.c_str());
 			}
 
-			// Proceed to the next URL
+			// Proceed to the next URL, continuing with what we got so far
+			resume = true;
 			_curUrl++;
 		}
 	} // while
 
+	RemoveSegments();
+
 	// Have we run out of URLs
 	if (_curUrl >= _urls.Num())
 	{
@@ -203,6 +332,159 @@ void CDownload::Perform()
 	}
 }
 
+CDownload::SegmentedResult CDownload::PerformSegmented()
+{
+	const idStr& url = _urls[_curUrl];
+
+	// Ask the server for the file size and whether it serves byte ranges
+	CHttpRequestPtr head = gameLocal.m_HttpConnection->CreateRequest(url.c_str());
+	head->SetHeadOnly(true);
+
+	SetRequest(head);
+	head->Perform();
+
+	std::size_t filesize = head->GetContentLength();
+
+	if (head->GetStatus() != CHttpRequest::OK || !head->AcceptsRanges() || filesize < 2 * MIN_SEGMENT_SIZE)
+	{
+		return SEGMENTS_NOT_APPLICABLE;
+	}
+
+	std::size_t numSegments = static_cast<std::size_t>(cv_tdm_download_segments.GetInteger());
+
+	if (numSegments > filesize / MIN_SEGMENT_SIZE)
+	{
+		numSegments = filesize / MIN_SEGMENT_SIZE;
+	}
+
+	DM_LOG(LC_MAINMENU, LT_INFO)LOGSTRING("Downloading %lu bytes from '%s' in %lu segments.", 
+		static_cast<unsigned long>(filesize), url.c_str(), static_cast<unsigned long>(numSegments));
+
+	{
+		boost::mutex::scoped_lock lock(_requestMutex);
+
+		_segmentedFilesize = filesize;
+		_segments.resize(numSegments);
+
+		std::size_t segmentSize = filesize / numSegments;
+
+		for (std::size_t i = 0; i < numSegments; ++i)
+		{
+			Segment& segment = _segments[i];
+
+			segment.first = i * segmentSize;
+			segment.last = (i == numSegments - 1) ? filesize - 1 : (i + 1) * segmentSize - 1;
+			segment.partFilename = std::string(_tempFilename.c_str()) + ".part" + boost::lexical_cast<std::string>(i);
+			segment.resumedBytes = 0;
+			segment.request.reset();
+			segment.done = false;
+
+			CMissionManager::DoRemoveFile(segment.partFilename);
+		}
+	}
+
+	// One thread per segment, each starting at another mirror
+	std::vector<boost::shared_ptr<boost::thread> > threads;
+
+	for (std::size_t i = 0; i < numSegments; ++i)
+	{
+		threads.push_back(ThreadPtr(new boost::thread(boost::bind(&CDownload::PerformSegment, this, i, _curUrl))));
+	}
+
+	for (std::size_t i = 0; i < threads.size(); ++i)
+	{
+		threads[i]->join();
+	}
+
+	for (std::size_t i = 0; i < numSegments; ++i)
+	{
+		if (!_segments[i].done)
+		{
+			return SEGMENTS_FAILED;
+		}
+	}
+
+	// Glue the parts together
+	std::ofstream dest(_tempFilename.c_str(), std::ofstream::out|std::ofstream::binary);
+
+	for (std::size_t i = 0; i < numSegments; ++i)
+	{
+		std::ifstream part(_segments[i].partFilename.c_str(), std::ifstream::in|std::ifstream::binary);
+
+		dest << part.rdbuf();
+	}
+
+	dest.close();
+
+	RemoveSegments();
+
+	return dest.fail() ? SEGMENTS_FAILED : SEGMENTS_OK;
+}
+
+void CDownload::PerformSegment(std::size_t index, int firstUrl)
+{
+	Segment& segment = _segments[index];
+
+	std::size_t segmentSize = segment.last - segment.first + 1;
+
+	// A failing mirror hands the rest of the segment over to the next one
+	for (int attempt = 0; attempt < _urls.Num() && _curUrl < _urls.Num(); ++attempt)
+	{
+		const idStr& url = _urls[(firstUrl + static_cast<int>(index) + attempt) % _urls.Num()];
+
+		std::size_t partSize = GetPartSize(segment.partFilename);
+
+		if (partSize >= segmentSize)
+		{
+			break;
+		}
+
+		CHttpRequestPtr request = gameLocal.m_HttpConnection->CreateRequest(url.c_str(), segment.partFilename);
+		request->SetRange(segment.first + partSize, segment.last);
+
+		{
+			boost::mutex::scoped_lock lock(_requestMutex);
+
+			segment.request = request;
+			segment.resumedBytes = partSize;
+
+			if (_curUrl >= _urls.Num())
+			{
+				return; // stopped while we were setting up
+			}
+		}
+
+		request->Perform();
+
+		if (request->GetStatus() == CHttpRequest::ABORTED && !request->RangeRejected())
+		{
+			return; // cancelled
+		}
+
+		if (request->GetStatus() != CHttpRequest::OK)
+		{
+			DM_LOG(LC_MAINMENU, LT_DEBUG)LOGSTRING("Segment %lu failed on '%s', trying the next mirror.", static_cast<unsigned long>(index), url.c_str());
+		}
+	}
+
+	boost::mutex::scoped_lock lock(_requestMutex);
+
+	segment.done = GetPartSize(segment.partFilename) == segmentSize;
+}
+
+void CDownload::RemoveSegments()
+{
+	boost::mutex::scoped_lock lock(_requestMutex);
+
+	for (std::size_t i = 0; i < _segments.size(); ++i)
+	{
+		CMissionManager::DoRemoveFile(_segments[i].partFilename);
+	}
+
+	_segments.clear();
+	_segmentedFilesize = 0;
+}
+
 bool CDownload::CheckValidPK4(const idStr& path)
 {
 	CZipFilePtr zipFile = CZipLoader::Instance().OpenFile(path);
@@ -21,8 +21,10 @@
 #define _DOWNLOAD_H_
 
 #include "../Http/HttpRequest.h"
+#include <vector>
 #include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
+#include <boost/thread/mutex.hpp>
 
 /**
  * An object representing a single download.
@@ -42,6 +44,11 @@
  * in the temporary file. The temporary file is named the same
  * as the destination filename, but with a prefixed underscore character:
  * e.g. target/directory/_download.pk4
+ *
+ * Large files are fetched in several segments at once (tdm_download_segments)
+ * if the server supports byte ranges. The segments are spread over the given
+ * URLs, a segment whose mirror fails continues from the next one where it broke
+ * off. A single-stream download resumes its partial data on the next mirror too.
  */
 class CDownload
 {
@@ -98,6 +105,22 @@ private:
 	// The ID of the related download (mission + l10n)
 	int	_relatedDownload;
 
+	// One part of a segmented download, fetched by its own thread and request
+	struct Segment
+	{
+		std::size_t first;			// first byte of the segment in the file
+		std::size_t last;			// last byte, inclusive
+		std::string partFilename;	// the segment data goes here first
+		std::size_t resumedBytes;	// the size of the part file when the current request started
+		CHttpRequestPtr request;
+		bool done;
+	};
+	std::vector<Segment> _segments;
+	std::size_t _segmentedFilesize;
+
+	// Guards the requests against the progress queries of the main thread
+	boost::mutex _requestMutex;
+
 public:
 	/** 
 	 * greebo: Construct a new Download using the given URL.
@@ -130,6 +153,9 @@ public:
 
 	double GetProgressFraction();
 
+	// The current download speed in bytes/sec, summed over all segments
+	double GetDownloadSpeed();
+
 	// Get the ID if the related download (e.g. a mission might have a l10n pack as related download)
 	int GetRelatedDownloadId();
 
@@ -145,6 +171,24 @@ public:
 private:
 	// Thread entry point
 	void Perform();
+
+	enum SegmentedResult
+	{
+		SEGMENTS_NOT_APPLICABLE,	// small file or no byte ranges, use a single request
+		SEGMENTS_OK,				// the temporary file is complete
+		SEGMENTS_FAILED,			// a segment failed on all mirrors
+	};
+
+	// Downloads the file in parallel segments into the temporary file
+	SegmentedResult PerformSegmented();
+
+	// Thread entry point of a single segment
+	void PerformSegment(std::size_t index, int firstUrl);
+
+	// Removes the part files of a segmented download
+	void RemoveSegments();
+
+	void SetRequest(const CHttpRequestPtr& request);
 };
 typedef boost::shared_ptr<CDownload> CDownloadPtr;
 
@@ -82,39 +82,56 @@ void CDownloadManager::ProcessDownloads()
 		return; // nothing to do
 	}
 
-	if (DownloadInProgress())
+	int numInProgress = 0;
+
+	for (Downloads::const_iterator i = _downloads.begin(); i != _downloads.end(); ++i)
 	{
-		return; // download still in progress
+		if (i->second->GetStatus() == CDownload::IN_PROGRESS)
+		{
+			numInProgress++;
+		}
 	}
 
-	// No download in progress, pick a new from the queue
+	bool pending = false;
+
+	// Pick new ones from the queue until tdm_download_concurrency are running
 	for (Downloads::const_iterator i = _downloads.begin(); i != _downloads.end(); ++i)
 	{
-		if (i->second->GetStatus() == CDownload::NOT_STARTED_YET)
+		if (i->second->GetStatus() != CDownload::NOT_STARTED_YET)
 		{
-			DM_LOG(LC_MAINMENU, LT_INFO)LOGSTRING("Starting download: %i", i->first);
+			continue;
+		}
 
-			i->second->Start();
+		if (numInProgress >= cv_tdm_download_concurrency.GetInteger())
+		{
+			pending = true;
+			break; // download slots still in use
+		}
 
-			// Check if this download has a related one, if yes, launch both at once
-			int relatedId = i->second->GetRelatedDownloadId();
+		DM_LOG(LC_MAINMENU, LT_INFO)LOGSTRING("Starting download: %i", i->first);
 
-			if (relatedId != -1)
-			{
-				CDownloadPtr related = GetDownload(relatedId);
+		i->second->Start();
+		numInProgress++;
 
-				if (related)
-				{
-					DM_LOG(LC_MAINMENU, LT_INFO)LOGSTRING("Starting related download: %i", relatedId);
+		// Check if this download has a related one, if yes, launch both at once
+		int relatedId = i->second->GetRelatedDownloadId();
 
-					related->Start();
-				}
-			}
+		if (relatedId != -1)
+		{
+			CDownloadPtr related = GetDownload(relatedId);
+
+			if (related && related->GetStatus() == CDownload::NOT_STARTED_YET)
+			{
+				DM_LOG(LC_MAINMENU, LT_INFO)LOGSTRING("Starting related download: %i", relatedId);
 
-			return;
+				related->Start();
+			}
 		}
 	}
 
-	// No download left to handle
-	_allDownloadsDone = true;
+	if (!pending && numInProgress == 0)
+	{
+		// No download left to handle
+		_allDownloadsDone = true;
+	}
 }
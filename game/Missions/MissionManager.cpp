@@ -521,18 +521,42 @@ void CMissionManager::GenerateModList()
 
 			DM_LOG(LC_MAINMENU, LT_DEBUG)LOGSTRING("Found PK4 file %s.\r", pk4path.string().c_str());
 
+			// Skip the PK4s we already know to have nothing for us
+			Pk4Stamp stamp;
+			try
+			{
+				stamp = Pk4Stamp(fs::file_size(pk4path), fs::last_write_time(pk4path));
+			}
+			catch (fs::filesystem_error& e)
+			{
+				DM_LOG(LC_MAINMENU, LT_DEBUG)LOGSTRING("Exception while reading the size of PK4: %s\r", e.what());
+				continue;
+			}
+
+			Pk4StampMap::const_iterator known = _pk4sWithoutDesc.find(pk4path.string());
+
+			if (known != _pk4sWithoutDesc.end() && known->second == stamp)
+			{
+				continue;
+			}
+
 			CZipFilePtr pk4file = CZipLoader::Instance().OpenFile(pk4path.string().c_str());
 
 			if (pk4file == NULL)
 			{
 				DM_LOG(LC_MAINMENU, LT_DEBUG)LOGSTRING("Could not open PK4: %s\r", pk4path.string().c_str());
+				_pk4sWithoutDesc[pk4path.string()] = stamp;
 				continue; // failed to open zip file
 			}
 
 			// Check if this is a localisation pack, don't extract files from those
 			bool isL10nPack = boost::algorithm::iends_with(pk4path.stem().string(), "_l10n");
 
-			if (!isL10nPack && pk4file->ContainsFile(cv_tdm_fm_desc_file.GetString()))
+			if (isL10nPack || !pk4file->ContainsFile(cv_tdm_fm_desc_file.GetString()))
+			{
+				_pk4sWithoutDesc[pk4path.string()] = stamp;
+			}
+			else
 			{
 				// Hurrah, we've found the darkmod.txt file, extract the contents
 				// and attempt to save to folder
@@ -568,61 +592,54 @@ void CMissionManager::GenerateModList()
 // grayman #3110 - rewritten due to freed memory crashes
 
 // Compare functor to sort missions by title
-int CMissionManager::ModSortCompare(const int* a, const int* b)
+int CMissionManager::ModSortCompare(const ModSortEntry* a, const ModSortEntry* b)
 {
-	// Get the mission titles (fs_currentfm stuff)
-	CModInfoPtr aInfo = gameLocal.m_MissionManager->GetModInfo(*a);
-	CModInfoPtr bInfo = gameLocal.m_MissionManager->GetModInfo(*b);
-
-	if ( ( aInfo == NULL ) || ( bInfo == NULL) )
-	{
-		return 0;
-	}
-
-	idStr aName = common->Translate( aInfo->displayName );
-	idStr prefix = "";
-	idStr suffix = "";
-	common->GetI18N()->MoveArticlesToBack( aName, prefix, suffix );
-	if ( !suffix.IsEmpty() )
-	{
-		// found, remove prefix and append suffix
-		aName.StripLeadingOnce( prefix.c_str() );
-		aName += suffix;
-	}
-
-	idStr bName = common->Translate( bInfo->displayName );
-	prefix = "";
-	suffix = "";
-	common->GetI18N()->MoveArticlesToBack( bName, prefix, suffix );
-	if ( !suffix.IsEmpty() )
-	{
-		// found, remove prefix and append suffix
-		bName.StripLeadingOnce( prefix.c_str() );
-		bName += suffix;
-	}
-
-	return aName.Icmp(bName);
+	return a->key.Icmp(b->key);
 }
 
 void CMissionManager::SortModList()
 {
 	// greebo: idStrList has a specialised algorithm, preventing me
 	// from using a custom sort algorithm, hence this ugly thing here
-	idList<int> indexList;
 
-	indexList.SetNum(_availableMods.Num());
+	// The titles are translated and get their articles moved to the
+	// back once per mod, not on each of the n log n comparisons
+	idList<ModSortEntry> sortList;
+
+	sortList.SetNum(_availableMods.Num());
 	for (int i = 0; i < _availableMods.Num(); ++i)
 	{
-		indexList[i] = i;
+		sortList[i].index = i;
+
+		// Get the mission title (fs_currentfm stuff)
+		CModInfoPtr info = GetModInfo(_availableMods[i]);
+
+		if (info == NULL)
+		{
+			continue;
+		}
+
+		idStr name = common->Translate( info->displayName );
+		idStr prefix = "";
+		idStr suffix = "";
+		common->GetI18N()->MoveArticlesToBack( name, prefix, suffix );
+		if ( !suffix.IsEmpty() )
+		{
+			// found, remove prefix and append suffix
+			name.StripLeadingOnce( prefix.c_str() );
+			name += suffix;
+		}
+
+		sortList[i].key = name;
 	}
 
-	indexList.Sort( CMissionManager::ModSortCompare );
+	sortList.Sort( CMissionManager::ModSortCompare );
 
 	idStrList temp = _availableMods;
 
-	for (int i = 0; i < indexList.Num(); ++i)
+	for (int i = 0; i < sortList.Num(); ++i)
 	{
-		_availableMods[i] = temp[indexList[i]];
+		_availableMods[i] = temp[sortList[i].index];
 	}
 }
 
@@ -21,6 +21,7 @@
 #define _MISSION_MANAGER_H_
 
 #include "ModInfo.h"
+#include <map>
 #include <boost/shared_ptr.hpp>
 #include <boost/filesystem.hpp>
 
@@ -205,6 +206,15 @@ private:
 	// The list of new mods
 	idStringList _newFoundMods;
 
+	// Size and modification time of a PK4 when it was last opened
+	typedef std::pair<boost::uintmax_t, std::time_t> Pk4Stamp;
+
+	// PK4s in the mod folders which turned out to have no description file to
+	// extract (l10n packs, broken archives), so GenerateModList doesn't open
+	// them again on every reload while they stay the same
+	typedef std::map<std::string, Pk4Stamp> Pk4StampMap;
+	Pk4StampMap _pk4sWithoutDesc;
+
 	// The map file which should be loaded next (e.g. "patently_dangerous")
 	idStr _curStartingMap;
 
@@ -398,8 +408,15 @@ private:
 	// Sorts all mods by display name
 	void SortModList();
 
+	// A mod with the name it is sorted by
+	struct ModSortEntry
+	{
+		idStr key;
+		int index;
+	};
+
 	// Compare functor to sort mods by display name
-	static int ModSortCompare(const int* a, const int* b);
+	static int ModSortCompare(const ModSortEntry* a, const ModSortEntry* b);
 
 	// Loads the mod list from the given XML
 	void LoadModListFromXml(const XmlDocumentPtr& doc);
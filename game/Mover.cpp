@@ -440,6 +440,17 @@ void idMover::Show( void ) {
 	SetPhysics( &physicsObj );
 }
 
+/*
+============
+idMover::DefaultMaxThinkInterleave
+
+The parametric physics are evaluated at the absolute game time
+============
+*/
+int idMover::DefaultMaxThinkInterleave( void ) const {
+	return 4;
+}
+
 /*
 ============
 idMover::Killed
@@ -1806,6 +1817,7 @@ idMover_Binary::idMover_Binary()
 	blocked = false;
 	fl.networkSync = true;
 	m_FrobActionScript = "frob_binary_mover";
+	binaryMoverNode.SetOwner( this );
 }
 
 /*
@@ -1817,6 +1829,8 @@ idMover_Binary::~idMover_Binary()
 {
 	idMover_Binary *mover;
 
+	binaryMoverNode.Remove();
+
 	// if this is the mover master
 	if ( this == moveMaster ) {
 		// make the next mover in the chain the move master
@@ -1975,6 +1989,8 @@ void idMover_Binary::Spawn( void )
 
 	activateChain = NULL;
 
+	binaryMoverNode.AddToEnd( gameLocal.spawnedBinaryMovers );
+
 	spawnArgs.GetFloat( "wait", "0", wait );
 
 	spawnArgs.GetInt( "updateStatus", "0", updateStatus );
@@ -1992,8 +2008,8 @@ void idMover_Binary::Spawn( void )
 		ent = this;
 	} else {
 		// find the first entity spawned on this team (which could be us)
-		for( ent = gameLocal.spawnedEntities.Next(); ent != NULL; ent = ent->spawnNode.Next() ) {
-			if ( ent->IsType( idMover_Binary::Type ) && !idStr::Icmp( static_cast<idMover_Binary *>(ent)->team.c_str(), temp ) ) {
+		for( ent = gameLocal.spawnedBinaryMovers.Next(); ent != NULL; ent = static_cast<idMover_Binary *>(ent)->binaryMoverNode.Next() ) {
+			if ( !idStr::Icmp( static_cast<idMover_Binary *>(ent)->team.c_str(), temp ) ) {
 				break;
 			}
 		}
@@ -3063,6 +3079,15 @@ void idMover_Periodic::Restore( idRestoreGame *savefile ) {
 	RestorePhysics( &physicsObj );
 }
 
+/*
+================
+idMover_Periodic::DefaultMaxThinkInterleave
+================
+*/
+int idMover_Periodic::DefaultMaxThinkInterleave( void ) const {
+	return 8;
+}
+
 /*
 ================
 idMover_Periodic::Think
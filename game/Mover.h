@@ -52,6 +52,8 @@ public:
 	virtual void			Hide( void );
 	virtual void			Show( void );
 
+	virtual int				DefaultMaxThinkInterleave( void ) const;
+
 	void					SetPortalState( bool open );
 
 	bool					IsBlocked( void );
@@ -290,6 +292,8 @@ public:
 
 	void					SetPortalState( bool open );
 
+	idLinkList<idMover_Binary>	binaryMoverNode;	// for being linked into gameLocal.spawnedBinaryMovers
+
 protected:
 	idVec3					pos1;
 	idVec3					pos2;
@@ -393,6 +397,8 @@ public:
 
 	virtual void			Think( void );
 
+	virtual int				DefaultMaxThinkInterleave( void ) const;
+
 	virtual void			WriteToSnapshot( idBitMsgDelta &msg ) const;
 	virtual void			ReadFromSnapshot( const idBitMsgDelta &msg );
 
@@ -224,6 +224,11 @@ CMultiStateMoverButton* CMultiStateMover::GetButton(
 	return NULL;
 }
 
+int CMultiStateMover::DefaultMaxThinkInterleave() const
+{
+	return 0;
+}
+
 void CMultiStateMover::Save(idSaveGame *savefile) const
 {
 	savefile->WriteInt(positionInfo.Num());
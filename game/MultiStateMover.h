@@ -62,6 +62,9 @@ public:
 
 	void	Activate(idEntity* activator);
 
+	// Elevators carry the AI, they think every frame
+	virtual int DefaultMaxThinkInterleave() const;
+
 	// Returns the list of position infos, populates the list if none are assigned yet.
 	const idList<MoverPositionInfo>& GetPositionInfoList();
 
@@ -101,6 +101,7 @@ void CMissionData::Clear( void )
 	m_bObjsNeedUpdate = false;
 	m_Objectives.Clear();
 	m_ClockedComponents.Clear();
+	m_NextClockedTime = 0;
 
 	// Clear all the stats 
 	m_Stats.Clear();
@@ -155,6 +156,7 @@ void CMissionData::Restore(idRestoreGame* savefile)
 
 	// Rebuild list of clocked components now that we've loaded objectives
 	m_ClockedComponents.Clear();
+	m_NextClockedTime = 0;
 	for (int ind = 0; ind < m_Objectives.Num(); ind++)
 	{
 		for (int ind2 = 0; ind2 < m_Objectives[ind].m_Components.Num(); ind2++)
@@ -525,7 +527,14 @@ void CMissionData::UpdateObjectives( void )
 
 // =============== Begin Handling of Clocked Objective Components ===============
 
-	for( int k=0; k < m_ClockedComponents.Num(); k++ )
+	// Nothing is due before m_NextClockedTime, so most frames skip the components entirely
+	const bool bClockTick = ( gameLocal.time >= m_NextClockedTime );
+	if( bClockTick )
+	{
+		m_NextClockedTime = INT_MAX;
+	}
+
+	for( int k=0; bClockTick && k < m_ClockedComponents.Num(); k++ )
 	{
 		CObjectiveComponent *pComp = m_ClockedComponents[k];
 
@@ -533,20 +542,28 @@ void CMissionData::UpdateObjectives( void )
 		if( !pComp  )
 			continue;
 
-		// if parent objective is invalid or the timer hasn't fired or it's latched, don't do anything
+		// if parent objective is invalid or it's latched, don't do anything
 		// greebo: Beware the the m_Index is 1-based, not 0-based
 		if( m_Objectives[ pComp->m_Index[0] - 1 ].m_state == STATE_INVALID
-			|| (gameLocal.time - pComp->m_TimeStamp < pComp->m_ClockInterval)
 			|| pComp->m_bLatched )
 		{
 			continue;
 		}
 
-// COMP_DISTANCE - Do a distance check
-		else if( pComp->m_Type == COMP_DISTANCE )
+		// if the timer hasn't fired, remember when it will
+		if( gameLocal.time - pComp->m_TimeStamp < pComp->m_ClockInterval )
 		{
-			pComp->m_TimeStamp = gameLocal.time;
+			m_NextClockedTime = Min( m_NextClockedTime, pComp->m_TimeStamp + pComp->m_ClockInterval );
+			continue;
+		}
 
+		// all clocked components, info_location ones included, wait one interval until the next check
+		pComp->m_TimeStamp = gameLocal.time;
+		m_NextClockedTime = Min( m_NextClockedTime, gameLocal.time + pComp->m_ClockInterval );
+
+// COMP_DISTANCE - Do a distance check
+		if( pComp->m_Type == COMP_DISTANCE )
+		{
 			if( pComp->m_Args.Num() < 3 )
 				continue;
 
@@ -597,8 +614,6 @@ void CMissionData::UpdateObjectives( void )
 // COMP_CUSTOM_CLOCKED - Run a clocked script
 		else if( pComp->m_Type == COMP_CUSTOM_CLOCKED )
 		{
-			pComp->m_TimeStamp = gameLocal.time;
-
 			function_t *pScriptFun = gameLocal.program.FindFunction( pComp->m_Args[0].c_str() );
 
 			if(pScriptFun)
@@ -1238,6 +1253,9 @@ void CMissionData::SetCompletionState( int ObjIndex, int State, bool fireEvents
 
 	obj.m_state = static_cast<EObjCompletionState>(State);
 
+	// an objective coming back from STATE_INVALID may have clocked components that are due
+	m_NextClockedTime = 0;
+
 	if (fireEvents)
 	{
 		if( State == STATE_COMPLETE )
@@ -1312,6 +1330,7 @@ void CMissionData::UnlatchObjectiveComp(int ObjIndex, int CompIndex )
 	}
 
 	m_Objectives[ObjIndex].m_Components[CompIndex].m_bLatched = false;
+	m_NextClockedTime = 0;
 }
 
 void CMissionData::SetObjectiveVisibility(int objIndex, bool visible, bool fireEvents)
@@ -1572,6 +1591,7 @@ int CMissionData::AddObjsFromDict(const idDict& dict)
 	}
 
 	// Process the objectives and add clocked components to clocked components list
+	m_NextClockedTime = 0;
 	for( int ind = 0; ind < m_Objectives.Num(); ind++ )
 	{
 		for( int ind2 = 0; ind2 < m_Objectives[ind].m_Components.Num(); ind2++ )
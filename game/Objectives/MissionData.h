@@ -545,6 +545,13 @@ protected:
 	**/
 	idList<CObjectiveComponent *> m_ClockedComponents;
 
+	/**
+	* Game time at which the next clocked component is due, so frames between clock
+	* ticks don't walk m_ClockedComponents. Reset to 0 whenever a component may have
+	* become due earlier (list rebuilt, objective state changed, unlatching). Not saved.
+	**/
+	int m_NextClockedTime;
+
 	/**
 	* Object holding all mission stats relating to AI, damage to player and AI
 	* Loot stats are maintained by the inventory
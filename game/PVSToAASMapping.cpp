@@ -35,7 +35,6 @@ PVSToAASMapping::PVSToAASMapping(void)
 	// No allocated mapping
 	aasName.Empty();
 	numPVSAreas = 0;
-	m_p_AASAreaIndicesPerPVSArea = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -46,45 +45,12 @@ PVSToAASMapping::~PVSToAASMapping(void)
 }
 
 
-//----------------------------------------------------------------------------
-
-void PVSToAASMapping::clearMappingList (PVSToAASMappingNode* p_header)
-{
-	if (p_header == NULL)
-	{
-		return;
-	}
-
-	// Ride the list and delete each node
-	PVSToAASMappingNode* p_cursor = p_header;
-	PVSToAASMappingNode* p_temp = NULL;
-	while (p_cursor != NULL)
-	{
-		p_temp = p_cursor->p_next;
-		delete p_cursor;
-		p_cursor = p_temp;
-	}
-	
-}
-
 //----------------------------------------------------------------------------
 
 void PVSToAASMapping::clear()
 {
-	if (m_p_AASAreaIndicesPerPVSArea != NULL)
-	{
-		// Clear each mapping list
-		for (int i = 0; i < numPVSAreas; i ++)
-		{
-			clearMappingList (m_p_AASAreaIndicesPerPVSArea[i]);
-		}
-
-		// Done with mapping list header pointers
-		delete[] m_p_AASAreaIndicesPerPVSArea;
-
-		// Mapping list header pointers unallocated
-		m_p_AASAreaIndicesPerPVSArea = NULL;
-	}
+	m_firstAASAreaIndex.Clear();
+	m_AASAreaIndices.Clear();
 
 	numPVSAreas = 0;
 	aasName.Empty();
@@ -113,27 +79,19 @@ bool PVSToAASMapping::buildMappings(idStr in_aasName)
 
 	// Get number of PVS areas
 	numPVSAreas = gameRenderWorld->NumAreas();
-	if (numPVSAreas > 0)
-	{
-		// Allocate areas
-		m_p_AASAreaIndicesPerPVSArea = new PVSToAASMappingNode*[numPVSAreas];
-		if (m_p_AASAreaIndicesPerPVSArea == NULL)
-		{
-			numPVSAreas = 0;
-			DM_LOG (LC_AI, LT_ERROR)LOGSTRING("Failed to alloate mapping table header pointers\r");
-			return false;
-		}
-	}
-
-	// All start empty
-	for (int i = 0; i < numPVSAreas; i ++)
+	if (numPVSAreas < 0)
 	{
-		m_p_AASAreaIndicesPerPVSArea[i] = NULL;
+		numPVSAreas = 0;
 	}
 
-	// Iterate AAS areas and add each one to the appropriate PVS area
-//	bool b_worked = true;
+	// Find the PVS area of each AAS area
 	int numAASAreas = p_aas->GetNumAreas();
+	idList<int> pvsAreaOfAASArea;
+	pvsAreaOfAASArea.SetNum(numAASAreas);
+
+	m_firstAASAreaIndex.SetNum(numPVSAreas + 1);
+	memset(m_firstAASAreaIndex.Ptr(), 0, m_firstAASAreaIndex.MemoryUsed());
+
 	for (int aasAreaIndex = 0; aasAreaIndex  < numAASAreas; aasAreaIndex ++)
 	{
 		// Get AAS area center
@@ -141,11 +99,58 @@ bool PVSToAASMapping::buildMappings(idStr in_aasName)
 
 		// What PVS area does it go in?
 		int pvsAreaIndex = gameLocal.pvs.GetPVSArea (aasAreaCenter);
-		if (!insertAASAreaIntoPVSAreaMapping (aasAreaIndex, pvsAreaIndex))
+		pvsAreaOfAASArea[aasAreaIndex] = pvsAreaIndex;
+
+		if (pvsAreaIndex >= numPVSAreas)
 		{
+			// Log error
+			DM_LOG(LC_AI, LT_ERROR)LOGSTRING 
+			(
+				"AAS area %d falls in PVS area %d which is beyond supposed PVS area count of %d\r", 
+				aasAreaIndex, 
+				pvsAreaIndex,
+				numPVSAreas
+			);
 			clear();
 			return false;
 		}
+		else if (pvsAreaIndex < 0)
+		{
+			DM_LOG(LC_AI, LT_WARNING)LOGSTRING 
+			(
+				"AAS area %d falls in no PVS area, left out of mapping\r", 
+				aasAreaIndex
+			);
+		}
+		else
+		{
+			m_firstAASAreaIndex[pvsAreaIndex + 1]++;
+		}
+	}
+
+	// Turn the counts into offsets
+	for (int i = 0; i < numPVSAreas; i ++)
+	{
+		m_firstAASAreaIndex[i + 1] += m_firstAASAreaIndex[i];
+	}
+
+	// Fill each PVS area's block from the back, so the AAS areas come out
+	// in descending order like the linked lists this replaced
+	idList<int> fillIndex;
+	fillIndex.SetNum(numPVSAreas);
+	for (int i = 0; i < numPVSAreas; i ++)
+	{
+		fillIndex[i] = m_firstAASAreaIndex[i + 1];
+	}
+
+	m_AASAreaIndices.SetNum(m_firstAASAreaIndex[numPVSAreas]);
+	for (int aasAreaIndex = 0; aasAreaIndex  < numAASAreas; aasAreaIndex ++)
+	{
+		int pvsAreaIndex = pvsAreaOfAASArea[aasAreaIndex];
+		if (pvsAreaIndex >= 0)
+		{
+			m_AASAreaIndices[--fillIndex[pvsAreaIndex]] = aasAreaIndex;
+		}
 	}
 
 	// Remember file
@@ -170,96 +175,34 @@ idStr PVSToAASMapping::getAASName()
 	return aasName;
 }
 
-//---------------------------------------------------------------------------
-
-bool PVSToAASMapping::insertAASAreaIntoPVSAreaMapping (int aasAreaIndex, int pvsAreaIndex)
-{
-
-	if (pvsAreaIndex >= numPVSAreas)
-	{
-		// Log error
-		DM_LOG(LC_AI, LT_ERROR)LOGSTRING 
-		(
-			"AAS area %d falls in PVS area %d which is beyond supposed PVS area count of %d\r", 
-			aasAreaIndex, 
-			pvsAreaIndex,
-			numPVSAreas
-		);
-		return false;
-	}
-	else if (pvsAreaIndex < 0)
-	{
-		DM_LOG(LC_AI, LT_WARNING)LOGSTRING 
-		(
-			"AAS area %d falls in no PVS area, left out of mapping\r", 
-			aasAreaIndex
-		);
-	}
-	else 
-	{
-		// Allocate node
-		PVSToAASMappingNode* p_node = new PVSToAASMappingNode;
-		if (p_node == NULL)
-		{
-			DM_LOG(LC_AI, LT_ERROR)LOGSTRING 
-			(
-				"Failed to allocate mapping node\r"
-			);
-			return false;
-		}
-		else
-		{
-			p_node->AASAreaIndex = aasAreaIndex;
-		}
-
-		// Add to front
-		if (m_p_AASAreaIndicesPerPVSArea[pvsAreaIndex] == NULL)
-		{
-			p_node->p_next = NULL;
-			m_p_AASAreaIndicesPerPVSArea[pvsAreaIndex] = p_node;
-		}
-		else
-		{
-			p_node->p_next = m_p_AASAreaIndicesPerPVSArea[pvsAreaIndex];
-			m_p_AASAreaIndicesPerPVSArea[pvsAreaIndex] = p_node;
-		}
-
-	}
-
-	// Success
-	return true;
-
-}
-
 //----------------------------------------------------------------------------
 
-PVSToAASMappingNode* PVSToAASMapping::getAASAreasForPVSArea (int pvsAreaIndex)
+const int* PVSToAASMapping::getAASAreasForPVSArea (int pvsAreaIndex, int& out_numAASAreas) const
 {
 	if ((pvsAreaIndex < 0) || (pvsAreaIndex >= numPVSAreas))
 	{
+		out_numAASAreas = 0;
 		return NULL;
 	}
-	else
-	{
-		return m_p_AASAreaIndicesPerPVSArea[pvsAreaIndex];
-	}
+
+	out_numAASAreas = m_firstAASAreaIndex[pvsAreaIndex + 1] - m_firstAASAreaIndex[pvsAreaIndex];
+
+	return (out_numAASAreas > 0) ? &m_AASAreaIndices[m_firstAASAreaIndex[pvsAreaIndex]] : NULL;
 }
 
 //----------------------------------------------------------------------------
 
 void PVSToAASMapping::getAASAreasForPVSArea(int pvsAreaIndex, idList<int>& out_aasAreaIndices)
 {
-	out_aasAreaIndices.Clear();
+	int numAASAreas;
+	const int* aasAreaIndices = getAASAreasForPVSArea (pvsAreaIndex, numAASAreas);
 
-	PVSToAASMappingNode* p_node = getAASAreasForPVSArea (pvsAreaIndex);
-
-	while (p_node != NULL)
+	// Every AAS area is in one PVS area only, so there are no duplicates
+	out_aasAreaIndices.SetNum (numAASAreas);
+	for (int i = 0; i < numAASAreas; i ++)
 	{
-		out_aasAreaIndices.AddUnique (p_node->AASAreaIndex);
-		p_node = p_node->p_next;
+		out_aasAreaIndices[i] = aasAreaIndices[i];
 	}
-
-	// Done
 }
 
 void PVSToAASMapping::DebugShowMappings(int lifetime)
@@ -277,11 +220,9 @@ void PVSToAASMapping::DebugShowMappings(int lifetime)
 
 	for (int i = 0; i < numPVSAreas; i++)
 	{
-		PVSToAASMappingNode* node = m_p_AASAreaIndicesPerPVSArea[i];
-
-		while (node != NULL)
+		for (int j = m_firstAASAreaIndex[i]; j < m_firstAASAreaIndex[i + 1]; j++)
 		{
-			int aasArea = node->AASAreaIndex;
+			int aasArea = m_AASAreaIndices[j];
 			idBounds areaBounds = aas->GetAreaBounds(aasArea);
 			idVec3 areaCenter = aas->AreaCenter(aasArea);
 			// angua: only draw areas near the player, no need to see them at the other end of the map
@@ -290,8 +231,6 @@ void PVSToAASMapping::DebugShowMappings(int lifetime)
 				gameRenderWorld->DrawText(va("%d", aasArea), areaCenter, 0.2f, color, playerViewMatrix, 1, lifetime);
 				gameRenderWorld->DebugBox(color, idBox(areaBounds), lifetime);
 			}
-
-			node = node->p_next;
 		}
 
 		color.x = gameLocal.random.RandomFloat() + 0.1f;
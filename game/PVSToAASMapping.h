@@ -23,42 +23,22 @@
 
 //------------------------------------------------------
 
-typedef struct tagPVSToAASMappingNode
-{
-	tagPVSToAASMappingNode* p_next;
-
-	int AASAreaIndex;
-
-} PVSToAASMappingNode;
-
-//------------------------------------------------------
-
 class PVSToAASMapping
 {
 protected:
 
 	// The map of PVS areas to AAS areas (one to many)
-	// This is an array of linked lists, the offset into the array is
-	// the PVS area number.  The list contains the indices of all the AAS
-	// areas in that PVS area.
+	// The AAS area indices of PVS area i are stored in
+	// m_AASAreaIndices[m_firstAASAreaIndex[i]] up to, but not including,
+	// m_AASAreaIndices[m_firstAASAreaIndex[i + 1]], so every query
+	// reads one contiguous block.
 	int numPVSAreas;
-	PVSToAASMappingNode** m_p_AASAreaIndicesPerPVSArea;
+	idList<int> m_firstAASAreaIndex;
+	idList<int> m_AASAreaIndices;
 
 	// Which aas size name are we currently using
 	idStr aasName;
 
-	/*!
-	* This method clears one mapping list
-	*/
-	void clearMappingList (PVSToAASMappingNode* p_header);
-
-	/*!
-	* Inserts an aas area index into the list for a pvs area
-	* @return true on success
-	* @return false on failure
-	*/
-	bool insertAASAreaIntoPVSAreaMapping (int aasAreaIndex, int pvsAreaIndex);
-
 public:
 	PVSToAASMapping(void);
 	virtual ~PVSToAASMapping(void);
@@ -86,15 +66,15 @@ public:
 	idStr getAASName();
 
 	/*!
-	* This method gets the aas area index list for a particular pvs area
+	* This method gets the aas area indices of a particular pvs area
 	*
 	* @param pvsAreaIndex The index of the PVS area being querried
+	* @param out_numAASAreas Receives the number of aas area indices
 	* 
-	* @return Pointer to the first node in the list of aas area indices for this pvs area
+	* @return Pointer to the first of the aas area indices for this pvs area
 	* @return NULL If the requested mapping is empty or the pvs area requested is out of bounds
-
 	*/
-	PVSToAASMappingNode* getAASAreasForPVSArea (int pvsAreaIndex);
+	const int* getAASAreasForPVSArea (int pvsAreaIndex, int& out_numAASAreas) const;
 
    /*!
    * Given a PVS area index, this retrieves a list of AAS area indices of AAS areas that it
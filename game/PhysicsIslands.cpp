@@ -0,0 +1,345 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+
+#include "precompiled_game.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "PhysicsIslands.h"
+#include "Game_local.h"
+#include "Grabber.h"
+
+CPhysicsIslands::CPhysicsIslands()
+{
+	Clear();
+}
+
+void CPhysicsIslands::Clear()
+{
+	_nodes.Clear();
+	_nodeHash.Clear();
+	_sleeping.Clear();
+
+	_quietSince.SetNum(MAX_GENTITIES);
+	_quietFrame.SetNum(MAX_GENTITIES);
+
+	for (int i = 0; i < MAX_GENTITIES; i++)
+	{
+		_quietSince[i] = -1;
+		_quietFrame[i] = -1;
+	}
+
+	_numAwake = 0;
+	_numIslands = 0;
+	_numPutToRest = 0;
+	_numWoken = 0;
+}
+
+bool CPhysicsIslands::IsIslandPhysics(const idPhysics* physics)
+{
+	return physics->IsType(idPhysics_RigidBody::Type) || physics->IsType(idPhysics_AF::Type);
+}
+
+void CPhysicsIslands::Update()
+{
+	_numAwake = 0;
+	_numIslands = 0;
+
+	if (!cv_physics_islands.GetBool())
+	{
+		_sleeping.Clear();
+		return;
+	}
+
+	WakeIslands();
+
+	_nodes.SetNum(0, false);
+	_nodeHash.Clear();
+
+	// The awake bodies, bound ones are moved by their master
+	for (idEntity* ent = gameLocal.activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next())
+	{
+		idPhysics* physics = ent->GetPhysics();
+
+		if (!(ent->thinkFlags & TH_PHYSICS) || !IsIslandPhysics(physics) || physics->IsAtRest() || ent->GetBindMaster() != NULL)
+		{
+			continue;
+		}
+
+		_nodes[AddNode(ent)].awake = true;
+	}
+
+	_numAwake = _nodes.Num();
+
+	if (_numAwake == 0)
+	{
+		return;
+	}
+
+	idEntity* grabbed = (gameLocal.m_Grabber != NULL) ? gameLocal.m_Grabber->GetSelected() : NULL;
+	int sleepTime = cv_physics_islands_sleeptime.GetInteger();
+
+	// Join them with what they touch, the nodes added here are at rest
+	for (int i = 0; i < _numAwake; i++)
+	{
+		idEntity* ent = _nodes[i].ent;
+		idPhysics_Base* physics = static_cast<idPhysics_Base*>(ent->GetPhysics());
+		int entityNum = ent->entityNumber;
+
+		if (IsQuiet(ent))
+		{
+			// restart the quiet time if the body wasn't awake and quiet last frame
+			if (_quietSince[entityNum] < 0 || _quietFrame[entityNum] != gameLocal.framenum - 1)
+			{
+				_quietSince[entityNum] = gameLocal.time;
+			}
+		}
+		else
+		{
+			_quietSince[entityNum] = -1;
+		}
+		_quietFrame[entityNum] = gameLocal.framenum;
+
+		if (_quietSince[entityNum] < 0 || gameLocal.time - _quietSince[entityNum] < sleepTime)
+		{
+			_nodes[i].restless = true;
+		}
+
+		if (ent == grabbed)
+		{
+			_nodes[i].blocked = true;
+		}
+
+		for (int j = 0; j < physics->GetNumContacts(); j++)
+		{
+			AddContact(i, gameLocal.entities[physics->GetContact(j).entityNum]);
+		}
+
+		for (int j = 0; j < physics->GetNumContactEntities(); j++)
+		{
+			AddContact(i, physics->GetContactEntity(j));
+		}
+	}
+
+	// Collect the flags on the islands
+	for (int i = 0; i < _nodes.Num(); i++)
+	{
+		int root = FindRoot(i);
+
+		_nodes[root].blocked |= _nodes[i].blocked;
+		_nodes[root].restless |= _nodes[i].restless;
+	}
+
+	// Put the islands whose awake bodies are all quiet to rest
+	for (int i = 0; i < _nodes.Num(); i++)
+	{
+		if (FindRoot(i) != i)
+		{
+			continue;
+		}
+
+		_numIslands++;
+
+		if (_nodes[i].blocked || _nodes[i].restless)
+		{
+			continue;
+		}
+
+		SleepingIsland& island = _sleeping.Alloc();
+		island.members.SetNum(0, false);
+
+		for (int j = 0; j < _nodes.Num(); j++)
+		{
+			if (FindRoot(j) != i)
+			{
+				continue;
+			}
+
+			idEntity* ent = _nodes[j].ent;
+
+			if (_nodes[j].awake)
+			{
+				ent->GetPhysics()->PutToRest();
+				_quietSince[ent->entityNumber] = -1;
+				_numPutToRest++;
+			}
+
+			island.members.Alloc() = ent;
+		}
+	}
+}
+
+void CPhysicsIslands::WakeIslands()
+{
+	for (int i = _sleeping.Num() - 1; i >= 0; i--)
+	{
+		SleepingIsland& island = _sleeping[i];
+		idEntity* woken = NULL;
+		bool removed = false;
+
+		for (int j = 0; j < island.members.Num(); j++)
+		{
+			idEntity* ent = island.members[j].GetEntity();
+
+			if (ent == NULL)
+			{
+				removed = true;
+			}
+			else if (!ent->GetPhysics()->IsAtRest())
+			{
+				woken = ent;
+			}
+		}
+
+		// a removed member may have been holding up the others
+		if (woken == NULL && !removed)
+		{
+			continue;
+		}
+
+		for (int j = 0; j < island.members.Num(); j++)
+		{
+			idEntity* ent = island.members[j].GetEntity();
+
+			if (ent != NULL && ent->GetPhysics()->IsAtRest())
+			{
+				ent->ActivatePhysics(woken);
+				_numWoken++;
+			}
+		}
+
+		_sleeping.RemoveIndex(i);
+	}
+}
+
+int CPhysicsIslands::AddNode(idEntity* ent)
+{
+	for (int i = _nodeHash.First(ent->entityNumber); i != -1; i = _nodeHash.Next(i))
+	{
+		if (_nodes[i].ent == ent)
+		{
+			return i;
+		}
+	}
+
+	int index = _nodes.Num();
+	Node& node = _nodes.Alloc();
+
+	node.ent = ent;
+	node.parent = index;
+	node.awake = false;
+	node.blocked = false;
+	node.restless = false;
+
+	_nodeHash.Add(ent->entityNumber, index);
+
+	return index;
+}
+
+int CPhysicsIslands::FindRoot(int node)
+{
+	while (_nodes[node].parent != node)
+	{
+		_nodes[node].parent = _nodes[_nodes[node].parent].parent;
+		node = _nodes[node].parent;
+	}
+
+	return node;
+}
+
+void CPhysicsIslands::Join(int a, int b)
+{
+	a = FindRoot(a);
+	b = FindRoot(b);
+
+	if (a != b)
+	{
+		_nodes[b].parent = a;
+	}
+}
+
+void CPhysicsIslands::AddContact(int node, idEntity* other)
+{
+	if (other == NULL || other == gameLocal.world || other == _nodes[node].ent)
+	{
+		return;
+	}
+
+	idPhysics* physics = other->GetPhysics();
+
+	if (IsIslandPhysics(physics) && other->GetBindMaster() == NULL)
+	{
+		Join(node, AddNode(other));
+	}
+	else if (other->IsType(idActor::Type) || !physics->IsAtRest())
+	{
+		// actors and moving movers move the island on their own
+		_nodes[node].blocked = true;
+	}
+}
+
+bool CPhysicsIslands::IsQuiet(idEntity* ent) const
+{
+	const idPhysics* physics = ent->GetPhysics();
+
+	// falling bodies are not quiet at the top of their flight
+	if (physics->GetNumContacts() == 0)
+	{
+		return false;
+	}
+
+	float maxLinear = cv_physics_islands_sleepvelocity.GetFloat();
+	float maxAngular = cv_physics_islands_sleepangularvelocity.GetFloat();
+
+	for (int i = 0; i < physics->GetNumClipModels(); i++)
+	{
+		if (physics->GetLinearVelocity(i).LengthSqr() > Square(maxLinear) ||
+			physics->GetAngularVelocity(i).LengthSqr() > Square(maxAngular))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void CPhysicsIslands::DrawHUD() const
+{
+	int numResting = 0;
+
+	for (idEntity* ent = gameLocal.spawnedEntities.Next(); ent != NULL; ent = ent->spawnNode.Next())
+	{
+		if (IsIslandPhysics(ent->GetPhysics()) && ent->GetPhysics()->IsAtRest())
+		{
+			numResting++;
+		}
+	}
+
+	const idMaterial* charSet = declManager->FindMaterial("textures/bigchars");
+	int y = 320;	// below the stim/response profile
+
+	renderSystem->DrawSmallStringExt(1, y, va("Physics islands: %d awake bodies in %d islands, %d at rest",
+		_numAwake, _numIslands, numResting), colorWhite, false, charSet);
+	y += 12;
+
+	renderSystem->DrawSmallStringExt(1, y, va("%d sleeping islands, %d bodies put to rest, %d woken",
+		_sleeping.Num(), _numPutToRest, _numWoken), colorWhite, false, charSet);
+}
@@ -0,0 +1,100 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+
+#ifndef __PHYSICS_ISLANDS_H__
+#define __PHYSICS_ISLANDS_H__
+
+class idEntity;
+class idPhysics;
+
+/**
+ * Puts islands of touching rigid bodies and articulated figures to rest together.
+ *
+ * A body on its own comes to rest when its own rest test passes, but in a stack or
+ * a pile the bodies that are still moving keep activating the ones they touch
+ * (idPhysics_Base::ActivateContactEntities), so the pile never settles. Once per frame
+ * the awake bodies are joined with the bodies they touch into islands. When every awake
+ * body of an island has been barely moving for tdm_physics_islands_sleeptime, the whole
+ * island is put to rest at once. Islands touching an actor, a mover or the grabbed
+ * entity don't sleep.
+ *
+ * Since nothing in a sleeping island moves, only something outside can wake one of its
+ * bodies. The rest of the island is then woken along with it.
+ */
+class CPhysicsIslands
+{
+private:
+	struct Node
+	{
+		idEntity*	ent;
+		int			parent;		// union-find parent, the root is the island
+		bool		awake;
+		bool		blocked;	// on the root: the island touches something that moves on its own
+		bool		restless;	// on the root: an awake body wasn't quiet for long enough
+	};
+
+	struct SleepingIsland
+	{
+		idList< idEntityPtr<idEntity> > members;
+	};
+
+	idList<Node>			_nodes;
+	idHashIndex				_nodeHash;			// entity number -> node
+
+	idList<int>				_quietSince;		// per entity number, game time since the awake body is quiet, -1 if not
+	idList<int>				_quietFrame;		// per entity number, frame the quiet time was last updated
+
+	idList<SleepingIsland>	_sleeping;
+
+	int						_numAwake;			// awake bodies in the last update
+	int						_numIslands;		// islands with awake bodies in the last update
+	int						_numPutToRest;		// bodies put to rest by the islands since the map start
+	int						_numWoken;			// bodies woken along with their island since the map start
+
+public:
+	CPhysicsIslands();
+
+	void Clear();
+
+	// Call once per frame after the entities think
+	void Update();
+
+	// Draws the counts of awake and resting bodies and islands (tdm_physics_islands_show)
+	void DrawHUD() const;
+
+	// True for the physics types that take part: rigid bodies and articulated figures
+	static bool IsIslandPhysics(const idPhysics* physics);
+
+private:
+	int AddNode(idEntity* ent);
+	int FindRoot(int node);
+	void Join(int a, int b);
+
+	// Adds the entity the awake body touches to its island, or blocks the island
+	void AddContact(int node, idEntity* other);
+
+	// True if all bodies of the awake body have been moving slower than the sleep velocity
+	bool IsQuiet(idEntity* ent) const;
+
+	// Wakes the sleeping islands one of whose members was woken
+	void WakeIslands();
+};
+
+#endif /* __PHYSICS_ISLANDS_H__ */
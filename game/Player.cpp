@@ -672,6 +672,7 @@ idPlayer::idPlayer() :
 	m_fColVal				= 0;
 	m_fBlendColVal			= 0;	
 	m_LightgemInterleave	= 0;
+	m_LightgemLastUpdate	= 0;
 	ignoreWeaponAttack		= false; // grayman #597
 	displayAASAreas			= false; // grayman #3032 - no need to save/restore
 	timeEvidenceIntruders	= 0;	 // grayman #3424
@@ -2248,6 +2249,7 @@ void idPlayer::Save( idSaveGame *savefile ) const {
 	savefile->WriteInt(m_LightgemValue);
 	savefile->WriteFloat(m_fColVal);
 	savefile->WriteInt(m_LightgemInterleave);
+	savefile->WriteInt(m_LightgemLastUpdate);
 	savefile->WriteBool(ignoreWeaponAttack);   // grayman #597
 	savefile->WriteInt(timeEvidenceIntruders); // grayman #3424
 	savefile->WriteInt(savePermissions);
@@ -2598,6 +2600,7 @@ void idPlayer::Restore( idRestoreGame *savefile ) {
 	savefile->ReadInt(m_LightgemValue);
 	savefile->ReadFloat(m_fColVal);
 	savefile->ReadInt(m_LightgemInterleave);
+	savefile->ReadInt(m_LightgemLastUpdate);
 	savefile->ReadBool(ignoreWeaponAttack);   // grayman #597
 	savefile->ReadInt(timeEvidenceIntruders); // grayman #3424
 	savefile->ReadInt(savePermissions);
@@ -3180,6 +3183,16 @@ void idPlayer::DrawHUD(idUserInterface *_hud)
 	/*renderSystem->DrawSmallStringExt(1, 30, 
 		va("Player velocity: %f", physicsObj.GetLinearVelocity().Length()), idVec4( 1, 1, 1, 1 ), false, declManager->FindMaterial( "textures/bigchars" ));*/
 
+	if (cv_sr_profile.GetInteger() > 1)
+	{
+		gameLocal.m_StimResponseProfiler.DrawHUD();
+	}
+
+	if (cv_physics_islands_show.GetBool())
+	{
+		gameLocal.m_PhysicsIslands.DrawHUD();
+	}
+
 	const char *name;
 	if((name = cv_dm_distance.GetString()) != NULL) //~SteveL FIX THIS, it's never false. Empty string is not NULL
 	{
@@ -9844,9 +9857,10 @@ int idPlayer::ProcessLightgem(bool processing)
 	{
 		m_LightgemInterleave++;
 
-		if (m_LightgemInterleave >= n)
+		if (m_LightgemInterleave >= n && gameLocal.time - m_LightgemLastUpdate >= cv_lg_interval.GetInteger())
 		{
 			m_LightgemInterleave = 0;
+			m_LightgemLastUpdate = gameLocal.time;
 
 			fValue = gameLocal.CalcLightgem(this);
 
@@ -11078,24 +11092,20 @@ void idPlayer::PerformFrobCheck()
 		gameRenderWorld->DebugBounds( colorBlue, frobBounds );
 	}
 
-	static idEntity* frobRangeEnts[MAX_GENTITIES];
-
-	int numFrobEnt = gameLocal.clip.EntitiesTouchingBounds(frobBounds, -1, frobRangeEnts, MAX_GENTITIES);
-
 	idVec3 vecForward = viewAngles.ToForward();
 	float bestDot = 0;
 	idEntity* bestEnt = NULL;
 
-	for ( int i = 0 ; i < numFrobEnt ; i++ )
+	// Only frobable entities can win, so walk their list instead of querying
+	// the clip sectors for everything around the frob bounds
+	for ( idEntity* ent = gameLocal.frobableEntities.Next(); ent != NULL; ent = ent->m_FrobNode.Next() )
 	{
-		idEntity *ent = frobRangeEnts[i];
-
-		if (ent == NULL)
+		if (!ent->m_FrobDistance || ent->IsHidden() || !ent->m_bFrobable)
 		{
 			continue;
 		}
 
-		if (!ent->m_FrobDistance || ent->IsHidden() || !ent->m_bFrobable)
+		if (!ent->FrobClipModelsTouchBounds(frobBounds))
 		{
 			continue;
 		}
@@ -1152,6 +1152,9 @@ private:
 
 	// An integer keeping track of the lightgem interleaving
 	int							m_LightgemInterleave;
+
+	// game time of the last lightgem update, for tdm_lg_interval
+	int							m_LightgemLastUpdate;
 	
 	// nbohr1more #4369 Dynamic Lightgem Interleave
 	int							m_LightgemInterleaveMin;
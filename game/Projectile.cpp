@@ -42,6 +42,21 @@ static bool versioned = RegisterVersionedFile("$Id$");
 static const float BOUNCE_SOUND_MIN_VELOCITY	= 200.0f;
 static const float BOUNCE_SOUND_MAX_VELOCITY	= 400.0f;
 
+// how far a projectile may stray from the path traced for it in idProjectile::RunFlights
+static const float PROJECTILE_FLIGHT_TOLERANCE	= 1.0f;
+
+idList< idEntityPtr<idProjectile> >	idProjectile::flights;
+idList<idVec3>						idProjectile::flightStarts;
+idList<idVec3>						idProjectile::flightVelocities;
+idList<idVec3>						idProjectile::flightGravities;
+idList<idVec3>						idProjectile::flightEnds;
+idList<float>						idProjectile::flightSizes;
+idList<idBounds>					idProjectile::flightSweeps;
+idList<int>							idProjectile::flightTraced;
+idList<clipTraceRequest_t>			idProjectile::flightTraceRequests;
+idList<trace_t>						idProjectile::flightTraceResults;
+idList<bool>						idProjectile::flightClear;
+
 const idEventDef EV_Explode( "<explode>", EventArgs(), EV_RETURNS_VOID, "internal" );
 const idEventDef EV_Fizzle( "<fizzle>", EventArgs(), EV_RETURNS_VOID, "internal" );
 const idEventDef EV_RadiusDamage( "<radiusdmg>", EventArgs('e', "", ""), EV_RETURNS_VOID, "internal" );
@@ -658,6 +673,32 @@ void idProjectile::Think( void ) {
 
 	gameRenderWorld->DrawText(stateStr, physicsObj.GetOrigin(), 0.2f, colorRed, gameLocal.GetLocalPlayer()->viewAxis);*/
 
+	// a projectile in flight moves with the others after the entities thought
+	if ( g_batchProjectiles.GetBool() && CanPutOffFlight() ) {
+		flights.Alloc() = this;
+		return;
+	}
+
+	RunFlight();
+}
+
+/*
+================
+idProjectile::CanPutOffFlight
+
+Free flying projectiles only, bind teams move together while thinking
+================
+*/
+bool idProjectile::CanPutOffFlight( void ) const {
+	return state == LAUNCHED && GetPhysics() == &physicsObj && !physicsObj.IsAtRest() && GetTeamMaster() == NULL;
+}
+
+/*
+================
+idProjectile::RunFlight
+================
+*/
+void idProjectile::RunFlight( void ) {
 	// run physics
 	RunPhysics();
 
@@ -1490,6 +1531,163 @@ idVec3 idProjectile::GetGravity( const idDict *projectile ) {
 	return idVec3( 0, 0, -gravity );
 }
 
+/*
+================
+idProjectile::RunFlights
+
+  The projectiles put off by their thinks move here in one pass. Their paths until the next
+  frame are integrated ballistically and traced in one batch, with a box covering the clip
+  model in any orientation grown by the tolerance and the contact epsilon. The projectiles
+  with a clear path whose box doesn't overlap that of another such projectile move first,
+  their physics skips the collision and contact queries while it stays within the tolerance
+  of the traced path. Once one of them doesn't, the rest run their queries as usual. The
+  others move after them, they can't get in the way of a path traced clear.
+================
+*/
+void idProjectile::RunFlights( void ) {
+	int i, j, num;
+	float timeStep;
+	idProjectile *proj;
+
+	num = flights.Num();
+	if ( !num ) {
+		return;
+	}
+
+	flightStarts.SetNum( num, false );
+	flightVelocities.SetNum( num, false );
+	flightGravities.SetNum( num, false );
+	flightEnds.SetNum( num, false );
+	flightSizes.SetNum( num, false );
+	flightSweeps.SetNum( num, false );
+	flightClear.SetNum( num, false );
+	flightTraced.SetNum( 0, false );
+
+	for ( i = 0; i < num; i++ ) {
+		proj = flights[i].GetEntity();
+		flightClear[i] = false;
+		if ( !proj ) {
+			flightSizes[i] = -1.0f;
+			continue;
+		}
+
+		const idBounds &bounds = proj->physicsObj.GetBounds();
+
+		flightStarts[i] = proj->physicsObj.GetOrigin();
+		flightVelocities[i] = proj->physicsObj.GetLinearVelocity();
+		flightGravities[i] = proj->physicsObj.GetGravity();
+
+		// the thruster force is not part of the integration below
+		if ( bounds.IsCleared() || ( proj->thrust && gameLocal.time < proj->thrust_end ) ) {
+			flightSizes[i] = -1.0f;
+		} else {
+			flightSizes[i] = bounds.GetRadius() + PROJECTILE_FLIGHT_TOLERANCE + CONTACT_EPSILON;
+		}
+	}
+
+	timeStep = MS2SEC( gameLocal.time - gameLocal.previousTime );
+
+	for ( i = 0; i < num; i++ ) {
+		flightEnds[i] = flightStarts[i] + flightVelocities[i] * timeStep + flightGravities[i] * ( 0.5f * timeStep * timeStep );
+	}
+
+	for ( i = 0; i < num; i++ ) {
+		if ( flightSizes[i] < 0.0f ) {
+			continue;
+		}
+
+		const idVec3 size( flightSizes[i], flightSizes[i], flightSizes[i] );
+
+		flightSweeps[i].Clear();
+		flightSweeps[i].AddPoint( flightStarts[i] );
+		flightSweeps[i].AddPoint( flightEnds[i] );
+		flightSweeps[i].ExpandSelf( flightSizes[i] );
+
+		proj = flights[i].GetEntity();
+
+		clipTraceRequest_t &request = flightTraceRequests.Alloc();
+		request.start = flightStarts[i];
+		request.end = flightEnds[i];
+		request.bounds[0] = -size;
+		request.bounds[1] = size;
+		request.contentMask = proj->physicsObj.GetClipMask();
+#ifdef MOD_WATERPHYSICS
+		request.contentMask |= MASK_WATER;
+#endif
+		request.passEntity = proj;
+
+		flightTraced.Append( i );
+	}
+
+	flightTraceResults.SetNum( flightTraceRequests.Num(), false );
+	gameLocal.clip.TranslationBatch( flightTraceResults.Ptr(), flightTraceRequests.Ptr(), flightTraceRequests.Num() );
+
+	for ( i = 0; i < flightTraced.Num(); i++ ) {
+		flightClear[flightTraced[i]] = ( flightTraceResults[i].fraction >= 1.0f );
+	}
+
+	for ( i = 0; i < flightTraced.Num(); i++ ) {
+		for ( j = i + 1; j < flightTraced.Num(); j++ ) {
+			if ( flightSweeps[flightTraced[i]].IntersectsBounds( flightSweeps[flightTraced[j]] ) ) {
+				flightClear[flightTraced[i]] = false;
+				flightClear[flightTraced[j]] = false;
+			}
+		}
+	}
+
+	flightTraceRequests.SetNum( 0, false );
+
+	// the clear paths first
+	bool useClearPaths = true;
+	for ( i = 0; i < num; i++ ) {
+		if ( !flightClear[i] ) {
+			continue;
+		}
+		proj = flights[i].GetEntity();
+		if ( !proj ) {
+			continue;
+		}
+		if ( useClearPaths ) {
+			proj->physicsObj.SetClearPath( flightStarts[i], flightEnds[i], PROJECTILE_FLIGHT_TOLERANCE );
+		}
+		proj->RunFlight();
+		if ( !proj->physicsObj.UsedClearPath() ) {
+			useClearPaths = false;
+		}
+	}
+
+	for ( i = 0; i < num; i++ ) {
+		if ( flightClear[i] ) {
+			continue;
+		}
+		proj = flights[i].GetEntity();
+		if ( proj ) {
+			proj->RunFlight();
+		}
+	}
+
+	flights.SetNum( 0, false );
+}
+
+/*
+================
+idProjectile::ClearFlights
+================
+*/
+void idProjectile::ClearFlights( void ) {
+	flights.Clear();
+	flightStarts.Clear();
+	flightVelocities.Clear();
+	flightGravities.Clear();
+	flightEnds.Clear();
+	flightSizes.Clear();
+	flightSweeps.Clear();
+	flightTraced.Clear();
+	flightTraceRequests.Clear();
+	flightTraceResults.Clear();
+	flightClear.Clear();
+}
+
 /*
 ================
 idProjectile::Event_Launch
@@ -118,6 +118,10 @@ public :
 	static idVec3			GetVelocity( const idDict *projectile );
 	static idVec3			GetGravity( const idDict *projectile );
 
+							// moves the projectiles whose flight was put off by their thinks, call once after the entities thought
+	static void				RunFlights( void );
+	static void				ClearFlights( void );
+
 	enum {
 		EVENT_DAMAGE_EFFECT = idEntity::EVENT_MAXEVENTS,
 		EVENT_MAXEVENTS
@@ -201,6 +205,23 @@ private:
 	bool					IsLocked(); // grayman #2478
 	void					Event_ClearPlayerImmobilization(idEntity* player); // grayman #2478
 
+	bool					CanPutOffFlight( void ) const;
+	void					RunFlight( void );
+
+	static idList< idEntityPtr<idProjectile> >	flights;	// the projectiles RunFlights moves this frame
+
+	// the flights as arrays of their properties, see RunFlights
+	static idList<idVec3>				flightStarts;
+	static idList<idVec3>				flightVelocities;
+	static idList<idVec3>				flightGravities;
+	static idList<idVec3>				flightEnds;
+	static idList<float>				flightSizes;		// half size of the traced box, negative if not traced
+	static idList<idBounds>				flightSweeps;
+	static idList<int>					flightTraced;
+	static idList<clipTraceRequest_t>	flightTraceRequests;
+	static idList<trace_t>				flightTraceResults;
+	static idList<bool>					flightClear;
+
 	void					Event_Explode( void );
 	void					Event_Fizzle( void );
 	void					Event_RadiusDamage( idEntity *ignore );
@@ -26,6 +26,10 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 #define MAX_BOUNDS_AREAS	16
 
+#define PVS_CACHE_EXT		"pvs"
+#define PVS_CACHE_ID		( ( 'P' << 24 ) | ( 'V' << 16 ) | ( 'S' << 8 ) | 'C' )
+#define PVS_CACHE_VERSION	1
+
 
 typedef struct pvsPassage_s {
 	byte *				canSee;		// bit set for all portals that can be seen through this passage
@@ -781,6 +785,104 @@ int idPVS::AreaPVSFromPortalPVS( void ) const {
 	return totalVisibleAreas;
 }
 
+/*
+================
+idPVS::PortalChecksum
+
+Checksum of everything the PVS is calculated from, the areas
+connected by each portal and the portal windings
+================
+*/
+unsigned long idPVS::PortalChecksum( void ) const {
+	unsigned long crc;
+	int i, j, k, numAreaPortals;
+
+	CRC32_InitChecksum( crc );
+	CRC32_UpdateChecksum( crc, &numAreas, sizeof( numAreas ) );
+	CRC32_UpdateChecksum( crc, &numPortals, sizeof( numPortals ) );
+
+	for ( i = 0; i < numAreas; i++ ) {
+		numAreaPortals = gameRenderWorld->NumPortalsInArea( i );
+		for ( j = 0; j < numAreaPortals; j++ ) {
+			exitPortal_t portal = gameRenderWorld->GetPortal( i, j );
+			CRC32_UpdateChecksum( crc, portal.areas, sizeof( portal.areas ) );
+			for ( k = 0; k < portal.w->GetNumPoints(); k++ ) {
+				CRC32_UpdateChecksum( crc, (*portal.w)[k].ToFloatPtr(), 3 * sizeof( float ) );
+			}
+		}
+	}
+
+	CRC32_FinishChecksum( crc );
+	return crc;
+}
+
+/*
+================
+idPVS::LoadPVSCache
+
+Reads the area PVS written by WritePVSCache, returns false if
+the file is missing or was written for different portals
+================
+*/
+bool idPVS::LoadPVSCache( const char *fileName, unsigned long portalChecksum, int &totalVisibleAreas ) {
+	idFile *f;
+	int id, version, fileAreas, filePortals, fileVisBytes;
+	unsigned int fileChecksum;
+	bool ok;
+
+	f = fileSystem->OpenFileRead( fileName );
+	if ( !f ) {
+		return false;
+	}
+
+	f->ReadInt( id );
+	f->ReadInt( version );
+	f->ReadInt( fileAreas );
+	f->ReadInt( filePortals );
+	f->ReadUnsignedInt( fileChecksum );
+	f->ReadInt( fileVisBytes );
+	f->ReadInt( totalVisibleAreas );
+
+	ok = ( id == PVS_CACHE_ID && version == PVS_CACHE_VERSION && fileAreas == numAreas && filePortals == numPortals
+			&& fileChecksum == (unsigned int)portalChecksum && fileVisBytes == areaVisBytes );
+
+	// the rows are read straight into areaPVS
+	if ( ok && f->Read( areaPVS, numAreas * areaVisBytes ) != numAreas * areaVisBytes ) {
+		gameLocal.Warning( "PVS cache %s is truncated", fileName );
+		memset( areaPVS, 0xFF, numAreas * areaVisBytes );
+		ok = false;
+	}
+
+	fileSystem->CloseFile( f );
+	return ok;
+}
+
+/*
+================
+idPVS::WritePVSCache
+================
+*/
+void idPVS::WritePVSCache( const char *fileName, unsigned long portalChecksum, int totalVisibleAreas ) const {
+	idFile *f;
+
+	f = fileSystem->OpenFileWrite( fileName );
+	if ( !f ) {
+		gameLocal.Warning( "Couldn't write PVS cache %s", fileName );
+		return;
+	}
+
+	f->WriteInt( PVS_CACHE_ID );
+	f->WriteInt( PVS_CACHE_VERSION );
+	f->WriteInt( numAreas );
+	f->WriteInt( numPortals );
+	f->WriteUnsignedInt( (unsigned int)portalChecksum );
+	f->WriteInt( areaVisBytes );
+	f->WriteInt( totalVisibleAreas );
+	f->Write( areaPVS, numAreas * areaVisBytes );
+
+	fileSystem->CloseFile( f );
+}
+
 /*
 ================
 idPVS::Init
@@ -799,7 +901,8 @@ void idPVS::Init( void ) {
 	connectedAreas = new bool[numAreas];
 	areaQueue = new int[numAreas];
 
-	areaVisBytes = ( ((numAreas+31)&~31) >> 3);
+	// rows are padded to whole longs, the word loops don't handle a tail
+	areaVisBytes = ( ((numAreas+63)&~63) >> 3);
 	areaVisLongs = areaVisBytes/sizeof(long);
 
 	areaPVS = new byte[numAreas * areaVisBytes];
@@ -807,7 +910,7 @@ void idPVS::Init( void ) {
 
 	numPortals = GetPortalCount();
 
-	portalVisBytes = ( ((numPortals+31)&~31) >> 3);
+	portalVisBytes = ( ((numPortals+63)&~63) >> 3);
 	portalVisLongs = portalVisBytes/sizeof(long);
 
 	for ( int i = 0; i < MAX_CURRENT_PVS; i++ ) {
@@ -820,21 +923,33 @@ void idPVS::Init( void ) {
 	idTimer timer;
 	timer.Start();
 
-	CreatePVSData();
+	idStr cacheName = gameLocal.GetMapName();
+	cacheName.SetFileExtension( PVS_CACHE_EXT );
+	const unsigned long portalChecksum = PortalChecksum();
+	const bool useCache = g_pvsCache.GetBool() && cacheName.Length() > 0;
+	bool loaded = useCache && LoadPVSCache( cacheName, portalChecksum, totalVisibleAreas );
+
+	if ( !loaded ) {
+		CreatePVSData();
 
-	FrontPortalPVS();
+		FrontPortalPVS();
 
-	CopyPortalPVSToMightSee();
+		CopyPortalPVSToMightSee();
 
-	PassagePVS();
+		PassagePVS();
 
-	totalVisibleAreas = AreaPVSFromPortalPVS();
+		totalVisibleAreas = AreaPVSFromPortalPVS();
 
-	DestroyPVSData();
+		DestroyPVSData();
+
+		if ( useCache ) {
+			WritePVSCache( cacheName, portalChecksum, totalVisibleAreas );
+		}
+	}
 
 	timer.Stop();
 
-	gameLocal.Printf( "%5.0f msec to calculate PVS\n", timer.Milliseconds() );
+	gameLocal.Printf( "%5.0f msec to %s PVS\n", timer.Milliseconds(), loaded ? "load" : "calculate" );
 	gameLocal.Printf( "%5d areas\n", numAreas );
 	gameLocal.Printf( "%5d portals\n", numPortals );
 	gameLocal.Printf( "%5d areas visible on average\n", totalVisibleAreas / numAreas );
@@ -1454,10 +1569,17 @@ bool idPVS::CheckAreasForPortalSky( const pvsHandle_t handle, const idVec3 &orig
 		return false;
 	}
 
+	const byte *pvs = currentPVS[handle.i].pvs;
 	for ( j = 0 ; j < numAreas ; j++ )
 	{
+		// skip eight invisible areas at once
+		if ( !pvs[j>>3] )
+		{
+			j |= 7;
+			continue;
+		}
 
-		if ( !( currentPVS[handle.i].pvs[j>>3] & (1 << (j&7)) ) )
+		if ( !( pvs[j>>3] & (1 << (j&7)) ) )
 		{
 			continue;
 		}
@@ -115,6 +115,9 @@ private:
 	void				CreatePassages( void ) const;
 	void				DestroyPassages( void ) const;
 	int				AreaPVSFromPortalPVS( void ) const;
+	unsigned long			PortalChecksum( void ) const;
+	bool				LoadPVSCache( const char *fileName, unsigned long portalChecksum, int &totalVisibleAreas );
+	void				WritePVSCache( const char *fileName, unsigned long portalChecksum, int totalVisibleAreas ) const;
 	void				GetConnectedAreas( int srcArea, bool *connectedAreas ) const;
 	pvsHandle_t			AllocCurrentPVS( unsigned int h ) const;
 };
@@ -50,7 +50,8 @@ static const int s_DefaultSameTeamRel = 5;
 CLASS_DECLARATION( idClass, CRelations )
 END_CLASS
 
-CRelations::CRelations()
+CRelations::CRelations() :
+	m_RelTableDim(0)
 {}
 
 CRelations::~CRelations()
@@ -61,6 +62,21 @@ CRelations::~CRelations()
 void CRelations::Clear()
 {
 	m_RelMat.Clear();
+	RebuildRelTable();
+}
+
+void CRelations::RebuildRelTable()
+{
+	m_RelTableDim = m_RelMat.Dim();
+	m_RelTable.SetNum(m_RelTableDim * m_RelTableDim, false);
+
+	for (int i = 0; i < m_RelTableDim; ++i)
+	{
+		for (int j = 0; j < m_RelTableDim; ++j)
+		{
+			m_RelTable[i * m_RelTableDim + j] = m_RelMat.Get(i, j);
+		}
+	}
 }
 
 bool CRelations::IsCleared()
@@ -81,12 +97,12 @@ int CRelations::GetRelNum(int i, int j)
 	
 	// return the default and don't attempt to check the matrix 
 	// if indices are out of bounds
-	if (i >= m_RelMat.Dim() || j >= m_RelMat.Dim())
+	if (i >= m_RelTableDim || j >= m_RelTableDim)
 	{
 		return (i == j) ? s_DefaultSameTeamRel : s_DefaultRelation;
 	}
 	
-	return m_RelMat.Get(static_cast<std::size_t>(i), static_cast<std::size_t>(j));
+	return m_RelTable[i * m_RelTableDim + j];
 }
 
 int CRelations::GetRelType(int i, int j)
@@ -122,6 +138,15 @@ void CRelations::SetRel(int i, int j, int rel)
 	}
 
 	m_RelMat.Set(i, j, rel);
+
+	if (m_RelTableDim == m_RelMat.Dim())
+	{
+		m_RelTable[i * m_RelTableDim + j] = rel;
+	}
+	else
+	{
+		RebuildRelTable();
+	}
 }
 
 void CRelations::ExtendRelationsMatrixToDim(int newDim)
@@ -344,6 +369,7 @@ void CRelations::Restore(idRestoreGame* save)
 	DM_LOG(LC_AI, LT_DEBUG)LOGSTRING("Loading Relationship Matrix data from save\r");
 
 	m_RelMat.Restore(save);
+	RebuildRelTable();
 }
 
 void CRelations::DebugPrintMat()
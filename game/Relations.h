@@ -166,6 +166,12 @@ private:
 	 */
 	void ExtendRelationsMatrixToDim(int newDim);
 
+	/**
+	 * Copies m_RelMat into m_RelTable, call after the matrix changed
+	 * size or was reloaded.
+	 */
+	void RebuildRelTable();
+
 protected:
 
 	/**
@@ -182,6 +188,13 @@ protected:
 	* The relationship matrix uses class CMatrixSq to store a square matrix
 	**/
 	CMatrixSq<int>		m_RelMat;
+
+	/**
+	* Dense row-major copy of m_RelMat for GetRelNum, which the AI call for
+	* every actor they consider. Not saved, rebuilt from m_RelMat.
+	**/
+	idList<int>			m_RelTable;
+	int					m_RelTableDim;
 };
 typedef boost::shared_ptr<CRelations> CRelationsPtr;
 
@@ -52,11 +52,6 @@ TODO: add a "entity" field (int) to the offsets list, so we avoid having to
 	  construct a sortOffsets list first, then truncated and rebuild the offsets
 	  list from that. (But benchmark if that isn't actually faster as the sortedOffsets
 	  list contans only one int and a ptr)
-TODO: Sort all the generated entities into multiple lists, keyed on a hash-key that
-	  contains all the relevant info for combining entities, so only entities that
-	  could be combined have the same hash key. F.i. "skin-name,model-name,class-name,etc".
-	  Then only look at entities from one list when combining, this will reduce the
-	  O(N*N) to something like O( (N/X)*(N/X) ) where X is the set of combinable entities.
 TODO: We currently determine the material by doing a point-trace, then when the material
 	  is suitable, we do a trace with the bounds/box downwards. This has two implications:
 	  * It is slower to do two traces if we actually need both
@@ -102,6 +97,10 @@ static bool versioned = RegisterVersionedFile("$Id$");
 // if the number of entities is higher than this, we no longer spawn entities
 #define SPAWN_LIMIT (MAX_GENTITIES - 100)
 
+// smallest cell size and most cells per axis of the distance check grid
+#define SEED_CELL_SIZE		512.0f
+#define SEED_MAX_CELLS		32
+
 // what we consider solid when flooring entities
 #define CONTENTS_SOLIDFLOOR 	CONTENTS_SOLID | CONTENTS_BODY | CONTENTS_CORPSE | CONTENTS_RENDERMODEL | CONTENTS_OPAQUE | CONTENTS_MOVEABLECLIP
 
@@ -165,6 +164,10 @@ Seed::Seed( void ) {
 	m_bDistCheckXYOnly = false;
 
 	m_iNumEntitiesInGame = 0;
+
+	m_bCellsDirty = true;
+	m_bCellsXYOnly = false;
+	m_iNumExamined = 0;
 }
 
 /*
@@ -495,6 +498,7 @@ void Seed::Restore( idRestoreGame *savefile ) {
 	savefile->ReadInt( m_iNumStaticMulties );
 	// do the SetLODData() once in Think()
 	m_bRestoreLOD = true;
+	m_bCellsDirty = true;
 
 	// Restore the entity list
     savefile->ReadInt( num );
@@ -1410,25 +1414,8 @@ void Seed::AddClassFromEntity( idEntity *ent, const bool watch, const bool getSp
 		}
 		else
 		{
-			double wd = (double)w;
-			double hd = (double)h;
-			double xo = w * SeedClass.map_ofs_x;
-			double yo = h * SeedClass.map_ofs_y;
-			double xs = SeedClass.map_scale_x;
-			double ys = SeedClass.map_scale_y;
-			for (unsigned int x = 0; x < w; x++)
-			{
-				for (unsigned int y = 0; y < h; y++)
-				{
-					// compute X and Y based on scaling/offset
-					// first fmod => -w .. +w => +w => 0 .. 2 * w => fmod => 0 .. w
-					int x1 = fmod( fmod( x * xs + xo, wd ) + wd, wd);
-					int y1 = fmod( fmod( y * ys + yo, hd ) + hd, hd);
-					fImgDensity += (float)imgData[ w * y1 + x1 ];	// 0 .. 255
-				}
-			}
-			// divide the sum by W and H and 256 so we arrive at 0 .. 1.0
-			fImgDensity /= (float)(w * h * 256.0f);
+			fImgDensity = gameLocal.m_ImageMapManager->GetMapDensity( SeedClass.imgmap,
+					SeedClass.map_ofs_x, SeedClass.map_ofs_y, SeedClass.map_scale_x, SeedClass.map_scale_y );
 		}
 
 		// if the map is inverted, use 1 - x:
@@ -2253,6 +2240,8 @@ void Seed::PrepareEntities( void )
 	timer_prepare.Clear();
 	timer_prepare.Start();
 
+	m_bCellsDirty = true;
+
 	idVec3 size = renderEntity.bounds.GetSize();
 	// rotating the func-static in DR rotates the brush, but does not change the axis or
 	// add a spawnarg, so this will not work properly unless the mapper sets an "angle" spawnarg:
@@ -3295,6 +3284,37 @@ void Seed::CombineEntities( void )
 	idRenderModel* tempModel = NULL;
 
 	int n = m_Entities.Num();
+
+	// link each entity to the next one with the same class and skin, only these can be
+	// combined, so the search below doesn't have to look at all the other entities
+	idList< int >				nextSame;			//!< next entity with the same class and skin, or -1
+	idList< int >				firstSame;			//!< per class and skin the lowest entity index so far
+	idHashIndex					sameHash;
+	nextSame.SetNum( n );
+	for (int i = n - 1; i >= 0; i--)
+	{
+		const int key = m_Entities[i].classIdx * 31 + m_Entities[i].skinIdx;
+		int h;
+		for (h = sameHash.First( key ); h != -1; h = sameHash.Next( h ))
+		{
+			const seed_entity_t *first = &m_Entities[ firstSame[h] ];
+			if (first->classIdx == m_Entities[i].classIdx && first->skinIdx == m_Entities[i].skinIdx)
+			{
+				break;
+			}
+		}
+		if (h == -1)
+		{
+			nextSame[i] = -1;
+			sameHash.Add( key, firstSame.Append( i ) );
+		}
+		else
+		{
+			nextSame[i] = firstSame[h];
+			firstSame[h] = i;
+		}
+	}
+
 	// we mark all entities that we combine with another entity with "-1" in the classIdx
 	for (int i = 0; i < n - 1; i++)
 	{
@@ -3342,7 +3362,9 @@ void Seed::CombineEntities( void )
 			ThinkAboutLOD( class_LOD, GetLODDistance( class_LOD, playerPos, m_Entities[i].origin, entityClass->size, m_fLODBias ) );
 		}
 		// 0 => default model, 1 => first stage etc
-		ofs.lod	   = m_LODLevel + 1;
+		// the combined entities get the same, it depends only on the distance to this one
+		const int baseLOD = m_LODLevel + 1;
+		ofs.lod	   = baseLOD;
 //		gameLocal.Warning("SEED %s: Using LOD model %i for base entity.", GetName(), ofs.lod );
 		// TODO: pack in the correct alpha value
 		ofs.color  = m_Entities[i].color;
@@ -3362,33 +3384,17 @@ void Seed::CombineEntities( void )
 			gameLocal.Printf("SEED %s: Combining at most %u models for entity %i.\n", GetName(), maxModelCount, i );
 		}
 
-		// try to combine as much entities into this one
-		// O(N*N) performance, but only if we don't combine any entities, otherwise
-		// every combine step reduces the number of entities to look at next:
-		for (int j = i + 1; j < n; j++)
+		// try to combine as much entities into this one, only looking at the ones with
+		// the same class and skin
+		// O(N*N) performance for each class and skin, but only if we don't combine any
+		// entities, otherwise every combine step reduces the number of entities to look at next:
+		for (int j = nextSame[i]; j != -1; j = nextSame[j])
 		{
 			if ((m_Entities[j].flags & SEED_ENTITY_COMBINED) != 0)
 			{
 				// already combined, skip
 #ifdef M_DEBUG_COMBINE
 				gameLocal.Printf("SEED %s: Entity %i already combined into another entity, skipping it.\n", GetName(), j);
-#endif
-				continue;
-			}
-			if (m_Entities[j].classIdx != m_Entities[i].classIdx)
-			{
-				// have different classes
-#ifdef M_DEBUG_COMBINE
-				gameLocal.Printf("SEED %s: Entity classes from %i (%i) and %i (%i) differ, skipping it.\n", GetName(), i, m_Entities[i].classIdx, j, m_Entities[j].classIdx);
-#endif
-				continue;
-			}
-			if (m_Entities[j].skinIdx != m_Entities[i].skinIdx)
-			{
-				// have different skins
-#ifdef M_DEBUG_COMBINE
-				gameLocal.Printf("SEED %s: Entity skins from %i (%s) and %i (%s) differ, skipping it.\n",
-						GetName(), i, m_Skins[ m_Entities[i].skinIdx ].c_str(), j, m_Skins[ m_Entities[j].skinIdx ].c_str() );
 #endif
 				continue;
 			}
@@ -3414,22 +3420,13 @@ void Seed::CombineEntities( void )
 			ofs.offset = dist;
 			ofs.angles = m_Entities[j].angles;
 
-			// compute the alpha value and the LOD level
-			m_LODLevel = 0;
-			if (entityClass->m_LODHandle)
-			{
-				const lod_data_t *class_LOD = gameLocal.m_ModelGenerator->GetLODDataPtr( entityClass->m_LODHandle );
-				ThinkAboutLOD( class_LOD, GetLODDistance( class_LOD, playerPos, m_Entities[i].origin, entityClass->size, m_fLODBias ) );
-			}
 			// 0 => default model, 1 => level 0 etc.
-			ofs.lod		= m_LODLevel + 1;
+			ofs.lod		= baseLOD;
 //			gameLocal.Warning("SEED %s: Using LOD model %i for combined entity %i.", GetName(), ofs.lod, j );
 			// TODO: pack in the new alpha value
 			ofs.color  = m_Entities[j].color;
 			ofs.scale  = m_Entities[j].scale;
 			ofs.flags  = 0;
-			// restore our value (it is not used, anyway)
-			m_LODLevel = 0;
 
 			sortOfs.ofs = ofs; sortOfs.entity = j; sortedOffsets.Append (sortOfs);
 
@@ -3846,6 +3843,11 @@ bool Seed::SpawnEntity( const int idx, const bool managed )
 			// preserve PSEUDO and WATCHED flag
 			ent->flags = SEED_ENTITY_WAS_SPAWNED + SEED_ENTITY_EXISTS + (ent->flags & SEED_ENTITY_PSEUDO) + (ent->flags & SEED_ENTITY_WATCHED);
 
+			if (!m_bCellsDirty && idx < m_EntityCell.Num())
+			{
+				m_Cells[ m_EntityCell[idx] ].numExisting ++;
+			}
+
 			return true;
 		}
 	}
@@ -3903,10 +3905,18 @@ bool Seed::CullEntity( const int idx )
 		m_iNumExisting --;
 		m_iNumVisible --;
 		// add visible, reset exists, but keep the others (esp. ENTITY_WAS_SPAWNED and ENTITY_WATCHED)
-		ent->flags += SEED_ENTITY_HIDDEN;
-		ent->flags &= (! SEED_ENTITY_EXISTS);
+		ent->flags |= SEED_ENTITY_HIDDEN;
+		ent->flags &= ~SEED_ENTITY_EXISTS;
 		ent->entity = 0;
 
+		if (!m_bCellsDirty && idx < m_EntityCell.Num())
+		{
+			// the entity might have moved out of its cell
+			seed_cell_t *cell = &m_Cells[ m_EntityCell[idx] ];
+			cell->numExisting --;
+			cell->bounds.AddPoint( ent->origin );
+		}
+
 		// TODO: Do we need to use SafeRemove?
 		ent2->PostEventMS( &EV_Remove, 0 );
 
@@ -3916,6 +3926,170 @@ bool Seed::CullEntity( const int idx )
 	return false;
 }
 
+/*
+================
+Seed::BuildCells - sort the entities into a grid over their origins
+================
+*/
+void Seed::BuildCells( void )
+{
+	int numEntities = m_Entities.Num();
+
+	m_Cells.Clear();
+	m_CellEntities.SetNum( numEntities );
+	m_EntityCell.SetNum( numEntities );
+	m_bCellsDirty = false;
+	m_bCellsXYOnly = false;
+
+	if (numEntities == 0)
+	{
+		return;
+	}
+
+	idBounds bounds;
+	bounds.Clear();
+	for (int i = 0; i < numEntities; i++)
+	{
+		bounds.AddPoint( m_Entities[i].origin );
+	}
+
+	// a 2D grid, SEEDs are spread out over the ground
+	idVec3 size = bounds.GetSize();
+	float cellSize = Max( SEED_CELL_SIZE, Max( size.x, size.y ) / SEED_MAX_CELLS );
+	int cellsX = idMath::FtoiFast( size.x / cellSize ) + 1;
+	int cellsY = idMath::FtoiFast( size.y / cellSize ) + 1;
+
+	// map grid positions to the cells that are in use
+	idList<int> gridCell;
+	gridCell.SetNum( cellsX * cellsY );
+	for (int i = 0; i < gridCell.Num(); i++)
+	{
+		gridCell[i] = -1;
+	}
+
+	for (int i = 0; i < numEntities; i++)
+	{
+		const seed_entity_t *ent = &m_Entities[i];
+		const seed_class_t *lclass = &m_Classes[ ent->classIdx ];
+
+		int x = idMath::ClampInt( 0, cellsX - 1, idMath::FtoiFast( (ent->origin.x - bounds[0].x) / cellSize ) );
+		int y = idMath::ClampInt( 0, cellsY - 1, idMath::FtoiFast( (ent->origin.y - bounds[0].y) / cellSize ) );
+		int c = gridCell[ y * cellsX + x ];
+		if (c == -1)
+		{
+			seed_cell_t cell;
+			cell.bounds.Clear();
+			cell.firstEntity = 0;
+			cell.numEntities = 0;
+			cell.numExisting = 0;
+			cell.maxSpawnDist = 0;
+			cell.minCullDist = 0;
+			c = gridCell[ y * cellsX + x ] = m_Cells.Append( cell );
+		}
+
+		seed_cell_t *cell = &m_Cells[c];
+		cell->bounds.AddPoint( ent->origin );
+		cell->numEntities ++;
+		if ( (ent->flags & SEED_ENTITY_EXISTS) != 0 )
+		{
+			cell->numExisting ++;
+		}
+		if (lclass->spawnDist == 0)
+		{
+			cell->maxSpawnDist = -1;
+		}
+		else if (cell->maxSpawnDist >= 0)
+		{
+			cell->maxSpawnDist = Max( cell->maxSpawnDist, lclass->spawnDist );
+		}
+		if (lclass->cullDist > 0)
+		{
+			cell->minCullDist = cell->minCullDist > 0 ? Min( cell->minCullDist, lclass->cullDist ) : lclass->cullDist;
+		}
+		if (lclass->m_LODHandle)
+		{
+			const lod_data_t* lod = gameLocal.m_ModelGenerator->GetLODDataPtr( lclass->m_LODHandle );
+			if (lod && lod->bDistCheckXYOnly)
+			{
+				m_bCellsXYOnly = true;
+			}
+		}
+		m_EntityCell[i] = c;
+	}
+
+	// group the entity indices by cell
+	int first = 0;
+	for (int c = 0; c < m_Cells.Num(); c++)
+	{
+		m_Cells[c].firstEntity = first;
+		first += m_Cells[c].numEntities;
+		m_Cells[c].numEntities = 0;
+	}
+	for (int i = 0; i < numEntities; i++)
+	{
+		seed_cell_t *cell = &m_Cells[ m_EntityCell[i] ];
+		m_CellEntities[ cell->firstEntity + cell->numEntities ] = i;
+		cell->numEntities ++;
+	}
+
+	if (m_iDebug)
+	{
+		gameLocal.Printf( "SEED %s: Sorted %i entities into %i cells.\n", GetName(), numEntities, m_Cells.Num() );
+	}
+}
+
+/*
+================
+Seed::CellNeedsCheck - return true if the cell can hold entities to spawn or cull
+
+Works on the same virtual distance as GetLODDistance(), with some slack
+so rounding can't skip an entity the full check would spawn or cull.
+================
+*/
+bool Seed::CellNeedsCheck( const seed_cell_t &cell, const idVec3 &playerPos, const float invBiasSq, const bool xyOnly ) const
+{
+	const int numAxes = xyOnly ? 2 : 3;
+
+	// entities that don't exist and might be inside their spawn distance
+	if (cell.numExisting < cell.numEntities)
+	{
+		if (cell.maxSpawnDist < 0)
+		{
+			return true;
+		}
+		float minDistSq = 0;
+		for (int j = 0; j < numAxes; j++)
+		{
+			float d = Max( cell.bounds[0][j] - playerPos[j], playerPos[j] - cell.bounds[1][j] );
+			if (d > 0)
+			{
+				minDistSq += d * d;
+			}
+		}
+		if (minDistSq * invBiasSq * 0.99f < cell.maxSpawnDist + 1.0f)
+		{
+			return true;
+		}
+	}
+
+	// existing entities that might be outside their cull distance
+	if (cell.numExisting > 0 && cell.minCullDist > 0)
+	{
+		float maxDistSq = 0;
+		for (int j = 0; j < 3; j++)
+		{
+			float d = Max( idMath::Fabs( cell.bounds[0][j] - playerPos[j] ), idMath::Fabs( playerPos[j] - cell.bounds[1][j] ) );
+			maxDistSq += d * d;
+		}
+		if (maxDistSq * invBiasSq * 1.01f + 1.0f > cell.minCullDist)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /*
 ================
 Seed::Think
@@ -4047,67 +4221,113 @@ void Seed::Think( void )
 			}
 		}
 
-		// for each of our "entities", do the distance check
-		int numEntities = m_Entities.Num();
-		for (int i = 0; i < numEntities; i++)
+		if (m_bCellsDirty || m_EntityCell.Num() != m_Entities.Num())
 		{
-			ent = &m_Entities[i];
-			lclass = &(m_Classes[ ent->classIdx ]);
-		   	float deltaSq = 0;
-			if (lclass->m_LODHandle)
-			{
-				const lod_data_t* lod = gameLocal.m_ModelGenerator->GetLODDataPtr( lclass->m_LODHandle );
-		    	deltaSq = GetLODDistance( lod, playerPos, ent->origin, lclass->size, lodBias );
-			}
-			else
+			BuildCells();
+		}
+
+		// the grid only bounds the distance orthogonal to gravity if that is along z
+		const idVec3 &gravityNormal = GetPhysics()->GetGravityNormal();
+		const bool xyOnly = m_bCellsXYOnly && idMath::Fabs( gravityNormal.z ) > 0.999f;
+		const float invBiasSq = lodBias > 1.0f ? 1.0f / (lodBias * lodBias) : 1.0f;
+		const int maxChanges = cv_seed_max_changes.GetInteger();
+		bool capped = false;
+		int numCheckedCells = 0;
+		m_iNumExamined = 0;
+
+		// for each of our "entities" in cells near the spawn or cull distance, do the distance check
+		int numCells = m_Cells.Num();
+		for (int c = 0; c < numCells && !capped; c++)
+		{
+			const seed_cell_t *cell = &m_Cells[c];
+			// with tilted gravity the cells can't bound the distance, so check them all
+			if ( ( !m_bCellsXYOnly || xyOnly ) && !CellNeedsCheck( *cell, playerPos, invBiasSq, xyOnly ) )
 			{
-		    	deltaSq = GetLODDistance( NULL, playerPos, ent->origin, lclass->size, lodBias );
+				continue;
 			}
+			numCheckedCells ++;
 
-//			gameLocal.Printf( "SEED %s: In LOD check: Flags for entity %i: 0x%08x, spawndist %i, deltaSq %i.\n", GetName(), i, ent->flags, (int)lclass->spawnDist, (int)deltaSq );
-
-			// normal distance checks now
-			if ( (ent->flags & SEED_ENTITY_EXISTS) == 0 && (lclass->spawnDist == 0 || deltaSq < lclass->spawnDist))
+			for (int k = 0; k < cell->numEntities; k++)
 			{
-				// Spawn and manage LOD, except for CStaticMulti entities with a megamodel,
-				// these need to do their own LOD thinking:
-				if (SpawnEntity( i, lclass->pseudo ? false : true ))
+				int i = m_CellEntities[ cell->firstEntity + k ];
+				m_iNumExamined ++;
+				ent = &m_Entities[i];
+				lclass = &(m_Classes[ ent->classIdx ]);
+			   	float deltaSq = 0;
+				if (lclass->m_LODHandle)
 				{
-					spawned ++;
+					const lod_data_t* lod = gameLocal.m_ModelGenerator->GetLODDataPtr( lclass->m_LODHandle );
+			    	deltaSq = GetLODDistance( lod, playerPos, ent->origin, lclass->size, lodBias );
 				}
-			}	
-			else
-			{
-				// cull entities that are outside "hide_distance + fade_out_distance + cullRange
-				if ( (ent->flags & SEED_ENTITY_EXISTS) != 0 && lclass->cullDist > 0 && deltaSq > lclass->cullDist)
+				else
 				{
-					// TODO: Limit number of entities to cull per frame
-					// TODO: Only cull invisible entities?
-					if (CullEntity( i ))
-					{
-						culled ++;
-					}
-
+			    	deltaSq = GetLODDistance( NULL, playerPos, ent->origin, lclass->size, lodBias );
 				}
 
-/*				// TODO: Normal LOD code here (replicate from entity)
-				// todo: int oldLODLevel = ent->lod;
-				float fAlpha = ThinkAboutLOD( lclass->m_LOD, deltaSq );
-				if (fAlpha == 0.0f)
+//				gameLocal.Printf( "SEED %s: In LOD check: Flags for entity %i: 0x%08x, spawndist %i, deltaSq %i.\n", GetName(), i, ent->flags, (int)lclass->spawnDist, (int)deltaSq );
+
+				// normal distance checks now
+				if ( (ent->flags & SEED_ENTITY_EXISTS) == 0 && (lclass->spawnDist == 0 || deltaSq < lclass->spawnDist))
 				{
-					// hide the entity
-				}
+					// Spawn and manage LOD, except for CStaticMulti entities with a megamodel,
+					// these need to do their own LOD thinking:
+					if (SpawnEntity( i, lclass->pseudo ? false : true ))
+					{
+						spawned ++;
+					}
+				}	
 				else
 				{
-					// if hidden, show the entity
+					// cull entities that are outside "hide_distance + fade_out_distance + cullRange
+					if ( (ent->flags & SEED_ENTITY_EXISTS) != 0 && lclass->cullDist > 0 && deltaSq > lclass->cullDist)
+					{
+						// TODO: Only cull invisible entities?
+						if (CullEntity( i ))
+						{
+							culled ++;
+						}
 
-					// if not combined entity
-					// setAlpha
-					// switchModel/switchSkin/noshadows
+					}
+
+	/*				// TODO: Normal LOD code here (replicate from entity)
+					// todo: int oldLODLevel = ent->lod;
+					float fAlpha = ThinkAboutLOD( lclass->m_LOD, deltaSq );
+					if (fAlpha == 0.0f)
+					{
+						// hide the entity
+					}
+					else
+					{
+						// if hidden, show the entity
+
+						// if not combined entity
+						// setAlpha
+						// switchModel/switchSkin/noshadows
+					}
+	*/
+				}
+
+				if (maxChanges > 0 && spawned + culled >= maxChanges)
+				{
+					// leave the rest for the next frames
+					capped = true;
+					break;
 				}
-*/
 			}
 		}
+
+		if (capped)
+		{
+			// check again in the next frame
+			m_DistCheckTimeStamp = gameLocal.time - m_DistCheckInterval - 1;
+		}
+
+		if (m_iDebug > 1)
+		{
+			gameLocal.Printf( "SEED %s: examined %i of %i entities in %i of %i cells, spawned %i, culled %i.\n",
+				GetName(), m_iNumExamined, m_Entities.Num(), numCheckedCells, m_Cells.Num(), spawned, culled );
+		}
+
 		if (spawned > 0 || culled > 0)
 		{
 			// the overall number seems to be the maximum number of entities that ever existed, so
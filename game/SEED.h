@@ -224,6 +224,18 @@ struct seed_entity_t {
 	int						classIdx;		//!< index into m_Classes
 };
 
+/**
+* A cell of the grid the entities are sorted into for the distance checks.
+*/
+struct seed_cell_t {
+	idBounds				bounds;			//!< bounds of the entity origins in this cell
+	int						firstEntity;	//!< index into m_CellEntities
+	int						numEntities;
+	int						numExisting;	//!< entities with SEED_ENTITY_EXISTS
+	float					maxSpawnDist;	//!< largest spawnDist, -1 if a class has none (always spawns)
+	float					minCullDist;	//!< smallest cullDist > 0, 0 if no entity gets culled
+};
+
 extern const idEventDef EV_Disable;
 extern const idEventDef EV_Enable;
 extern const idEventDef EV_Deactivate;
@@ -320,6 +332,17 @@ private:
 	*/
 	bool				CullEntity( const int idx );
 
+	/**
+	* Sort the entities into the cells of a grid over their origins.
+	*/
+	void				BuildCells( void );
+
+	/**
+	* Return true if the cell can hold an entity that needs to be spawned or
+	* culled at the current player distance.
+	*/
+	bool				CellNeedsCheck( const seed_cell_t &cell, const idVec3 &playerPos, const float invBiasSq, const bool xyOnly ) const;
+
 	/**
 	* Parse the falloff spawnarg and return an integer representing it.
 	*/
@@ -435,6 +458,22 @@ private:
 	**/
 	idList<seed_entity_t>		m_Entities;
 
+	/**
+	* The entities sorted into grid cells, so the distance checks only look at
+	* cells that can hold entities to spawn or cull. Not saved, BuildCells()
+	* recreates them when m_bCellsDirty is set or m_Entities changed size.
+	**/
+	idList<seed_cell_t>			m_Cells;
+	idList<int>					m_CellEntities;		// entity indices, grouped by cell
+	idList<int>					m_EntityCell;		// cell of each entity
+	bool						m_bCellsDirty;
+	bool						m_bCellsXYOnly;		// an entity class checks distance orthogonal to gravity
+
+	/**
+	* Number of entities examined in the last distance check.
+	**/
+	int							m_iNumExamined;
+
 	/**
 	* Info about each entitiy that we watch (e.g. that already existed and
 	* that we just cloned).
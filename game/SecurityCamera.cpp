@@ -76,6 +76,9 @@ void idSecurityCamera::Save( idSaveGame *savefile ) const {
 	savefile->WriteInt( alertMode );
 	savefile->WriteFloat( stopSweeping );
 	savefile->WriteFloat( scanFovCos );
+	savefile->WriteInt( scanInterval );
+	savefile->WriteInt( nextScanTime );
+	savefile->WriteBool( lastCanSee );
 
 	savefile->WriteVec3( viewOffset );
 							
@@ -104,6 +107,9 @@ void idSecurityCamera::Restore( idRestoreGame *savefile ) {
 	savefile->ReadInt( alertMode );
 	savefile->ReadFloat( stopSweeping );
 	savefile->ReadFloat( scanFovCos );
+	savefile->ReadInt( scanInterval );
+	savefile->ReadInt( nextScanTime );
+	savefile->ReadBool( lastCanSee );
 
 	savefile->ReadVec3( viewOffset );
 							
@@ -142,6 +148,11 @@ void idSecurityCamera::Spawn( void ) {
 
 	scanFovCos = cos( scanFov * idMath::PI / 360.0f );
 
+	// cameras look for the player a few times per second, spread over the frames
+	scanInterval = SEC2MS( spawnArgs.GetFloat( "scanInterval", "0.1" ) );
+	nextScanTime = gameLocal.time + gameLocal.random.RandomInt( scanInterval + 1 );
+	lastCanSee = false;
+
 	angle = GetPhysics()->GetAxis().ToAngles().yaw;
 	StartSweep();
 	SetAlertMode( SCANNING );
@@ -291,10 +302,16 @@ bool idSecurityCamera::CanSeePlayer( void ) {
 	trace_t tr;
 	idVec3 dir;
 	pvsHandle_t handle;
+	bool pvsSetup = false;
 
-	handle = gameLocal.pvs.SetupCurrentPVS( pvsArea );
+	// between scans keep the last result
+	if ( gameLocal.time < nextScanTime ) {
+		return lastCanSee;
+	}
+	nextScanTime = gameLocal.time + scanInterval;
+	lastCanSee = false;
 
-	for ( i = 0; i < gameLocal.numClients; i++ ) {
+	for ( i = 0; i < gameLocal.numClients && !lastCanSee; i++ ) {
 		ent = static_cast<idPlayer*>(gameLocal.entities[ i ]);
 
 		if ( !ent || ent->fl.notarget || ent->fl.invisible ) // grayman #3857 - added 'invisible'
@@ -302,11 +319,7 @@ bool idSecurityCamera::CanSeePlayer( void ) {
 			continue;
 		}
 
-		// if there is no way we can see this player
-		if ( !gameLocal.pvs.InCurrentPVS( handle, ent->GetPVSAreas(), ent->GetNumPVSAreas() ) ) {
-			continue;
-		}
-
+		// distance and fov first, they are much cheaper than the PVS
 		dir = ent->GetPhysics()->GetOrigin() - GetPhysics()->GetOrigin();
 		dist = dir.Normalize();
 
@@ -318,20 +331,30 @@ bool idSecurityCamera::CanSeePlayer( void ) {
 			continue;
 		}
 
+		// if there is no way we can see this player
+		if ( !pvsSetup ) {
+			handle = gameLocal.pvs.SetupCurrentPVS( pvsArea );
+			pvsSetup = true;
+		}
+		if ( !gameLocal.pvs.InCurrentPVS( handle, ent->GetPVSAreas(), ent->GetNumPVSAreas() ) ) {
+			continue;
+		}
+
 		idVec3 eye;
 
 		eye = ent->EyeOffset();
 
 		gameLocal.clip.TracePoint( tr, GetPhysics()->GetOrigin(), ent->GetPhysics()->GetOrigin() + eye, MASK_OPAQUE, this );
 		if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == ent ) ) {
-			gameLocal.pvs.FreeCurrentPVS( handle );
-			return true;
+			lastCanSee = true;
 		}
 	}
 
-	gameLocal.pvs.FreeCurrentPVS( handle );
+	if ( pvsSetup ) {
+		gameLocal.pvs.FreeCurrentPVS( handle );
+	}
 
-	return false;
+	return lastCanSee;
 }
 
 /*
@@ -64,6 +64,9 @@ private:
 	int						alertMode;
 	float					stopSweeping;
 	float					scanFovCos;
+	int						scanInterval;	// msec between two sight checks
+	int						nextScanTime;
+	bool					lastCanSee;		// result of the last sight check
 
 	idVec3					viewOffset;
 							
@@ -140,8 +140,9 @@ void idSmokeParticles::FreeSmokes( void ) {
 			last = smoke;
 		}
 
-		if ( !active->smokes ) {
-			// remove this from the activeStages list
+		if ( !active->smokes && !active->tri ) {
+			// remove this from the activeStages list, stages with a
+			// surface stay idle until the surfaces are rebuilt
 			activeStages.RemoveIndex( activeStageNum );
 			activeStageNum--;
 		}
@@ -244,6 +245,9 @@ bool idSmokeParticles::EmitSmoke( const idDeclParticle *smoke, const int systemS
 
 			newActive.smokes = NULL;
 			newActive.stage = stage;
+			newActive.tri = NULL;
+			newActive.maxQuads = 0;
+			newActive.numQuads = 0;
 			i = activeStages.Append( newActive );
 			active = &activeStages[i];
 		}
@@ -273,19 +277,91 @@ bool idSmokeParticles::EmitSmoke( const idDeclParticle *smoke, const int systemS
 	return continues;
 }
 
+/*
+================
+idSmokeParticles::RebuildSurfaces
+
+Reallocates the model surfaces when a stage is new or has outgrown its
+surface. Idle stages are dropped, the others get room for half again as
+many quads, so a building smoke doesn't rebuild them every frame.
+================
+*/
+void idSmokeParticles::RebuildSurfaces( idRenderModel *model ) {
+	// frees the surfaces of all stages
+	model->InitEmpty( smokeParticle_SnapshotName );
+
+	for ( int activeStageNum = 0; activeStageNum < activeStages.Num(); activeStageNum++ ) {
+		activeSmokeStage_t *active = &activeStages[activeStageNum];
+
+		active->tri = NULL;
+		active->maxQuads = 0;
+
+		if ( !active->smokes ) {
+			activeStages.RemoveIndex( activeStageNum );
+			activeStageNum--;
+			continue;
+		}
+
+		active->maxQuads = Max( active->numQuads + active->numQuads / 2, 16 );
+
+		srfTriangles_t *tri = model->AllocSurfaceTriangles( active->maxQuads * 4, active->maxQuads * 6 );
+		tri->numVerts = 0;
+		tri->numIndexes = 0;
+
+		// just always draw the particles
+		tri->bounds[0][0] =
+		tri->bounds[0][1] =
+		tri->bounds[0][2] = -99999;
+		tri->bounds[1][0] =
+		tri->bounds[1][1] =
+		tri->bounds[1][2] = 99999;
+
+		// the quad indexes never change, the drawn particles use the first ones
+		glIndex_t *indexes = tri->indexes;
+		for ( int i = 0 ; i < active->maxQuads * 4 ; i += 4 ) {
+			indexes[0] = i;
+			indexes[1] = i+2;
+			indexes[2] = i+3;
+			indexes[3] = i;
+			indexes[4] = i+3;
+			indexes[5] = i+1;
+			indexes += 6;
+		}
+
+		modelSurface_t	surf;
+		surf.geometry = tri;
+		surf.shader = active->stage->material;
+		surf.id = 0;
+
+		model->AddSurface( surf );
+
+		active->tri = tri;
+	}
+}
+
 /*
 ================
 idSmokeParticles::UpdateRenderEntity
+
+The stage surfaces are kept from frame to frame, only their vertexes
+are rewritten. Dead particles are retired first, after that every stage
+writes to its own surface, so the stages are generated in parallel.
 ================
 */
 bool idSmokeParticles::UpdateRenderEntity( renderEntity_s *renderEntity, const renderView_t *renderView ) {
-
-	// FIXME: re-use model surfaces
-	renderEntity->hModel->InitEmpty( smokeParticle_SnapshotName );
+	int activeStageNum;
 
 	// this may be triggered by a model trace or other non-view related source,
 	// to which we should look like an empty model
 	if ( !renderView ) {
+		for ( activeStageNum = 0; activeStageNum < activeStages.Num(); activeStageNum++ ) {
+			srfTriangles_t *tri = activeStages[activeStageNum].tri;
+			if ( tri ) {
+				tri->numVerts = 0;
+				tri->numIndexes = 0;
+			}
+		}
+		currentParticleTime = -1;
 		return false;
 	}
 
@@ -295,57 +371,46 @@ bool idSmokeParticles::UpdateRenderEntity( renderEntity_s *renderEntity, const r
 	}
 	currentParticleTime = renderView->time;
 
-	particleGen_t g;
-
-	g.renderEnt = renderEntity;
-	g.renderView = renderView;
-
-	for ( int activeStageNum = 0; activeStageNum < activeStages.Num(); activeStageNum++ ) {
-		singleSmoke_t *smoke, *next, *last;
+	FreeSmokes();
 
+	// see if the surfaces can hold all the particles
+	bool rebuild = false;
+	for ( activeStageNum = 0; activeStageNum < activeStages.Num(); activeStageNum++ ) {
 		activeSmokeStage_t *active = &activeStages[activeStageNum];
-		const idParticleStage *stage = active->stage;
 
-		if ( !stage->material ) {
-			continue;
-		}
-
-		// allocate a srfTriangles that can hold all the particles
 		int count = 0;
-		for ( smoke = active->smokes; smoke; smoke = smoke->next ) {
+		for ( singleSmoke_t *smoke = active->smokes; smoke; smoke = smoke->next ) {
 			count++;
 		}
-		int	quads = count * stage->NumQuadsPerParticle();
-		srfTriangles_t *tri = renderEntity->hModel->AllocSurfaceTriangles( quads * 4, quads * 6 );
-		tri->numIndexes = quads * 6;
-		tri->numVerts = quads * 4;
+		active->numQuads = count * active->stage->NumQuadsPerParticle();
 
-		// just always draw the particles
-		tri->bounds[0][0] =
-		tri->bounds[0][1] =
-		tri->bounds[0][2] = -99999;
-		tri->bounds[1][0] =
-		tri->bounds[1][1] =
-		tri->bounds[1][2] = 99999;
+		if ( !active->tri || active->numQuads > active->maxQuads ) {
+			rebuild = true;
+		}
+	}
 
-		tri->numVerts = 0;
-		for ( last = NULL, smoke = active->smokes; smoke; smoke = next ) {
-			next = smoke->next;
+	if ( rebuild ) {
+		RebuildSurfaces( renderEntity->hModel );
+	} else {
+		// the vertexes change in place
+		renderEntity->hModel->FreeVertexCache();
+	}
+
+	const int numStages = activeStages.Num();
+
+#pragma omp parallel for if ( numStages > 1 ) schedule( dynamic, 1 )
+	for ( activeStageNum = 0; activeStageNum < numStages; activeStageNum++ ) {
+		activeSmokeStage_t *active = &activeStages[activeStageNum];
+		const idParticleStage *stage = active->stage;
+		srfTriangles_t *tri = active->tri;
+		particleGen_t g;
 
+		g.renderEnt = renderEntity;
+		g.renderView = renderView;
+
+		tri->numVerts = 0;
+		for ( singleSmoke_t *smoke = active->smokes; smoke; smoke = smoke->next ) {
 			g.frac = (float)( gameLocal.time - smoke->privateStartTime ) / ( stage->particleLife * 1000 );
-			if ( g.frac >= 1.0f ) {
-				// remove the particle from the stage list
-				if ( last != NULL ) {
-					last->next = smoke->next;
-				} else {
-					active->smokes = smoke->next;
-				}
-				// put the particle on the free list
-				smoke->next = freeSmokes;
-				freeSmokes = smoke;
-				numActiveSmokes--;
-				continue;
-			}
 
 			g.index = smoke->index;
 			g.random = smoke->random;
@@ -357,45 +422,16 @@ bool idSmokeParticles::UpdateRenderEntity( renderEntity_s *renderEntity, const r
 			g.age = g.frac * stage->particleLife;
 
 			tri->numVerts += stage->CreateParticle( &g, tri->verts + tri->numVerts );
-
-			last = smoke;
 		}
-		if ( tri->numVerts > quads * 4 ) {
-			gameLocal.Error( "idSmokeParticles::UpdateRenderEntity: miscounted verts" );
-		}
-
-		if ( tri->numVerts == 0 ) {
-
-			// they were all removed
-			renderEntity->hModel->FreeSurfaceTriangles( tri );
-
-			if ( !active->smokes ) {
-				// remove this from the activeStages list
-				activeStages.RemoveIndex( activeStageNum );
-				activeStageNum--;
-			}
-		} else {
-			// build the index list
-			int	indexes = 0;
-			for ( int i = 0 ; i < tri->numVerts ; i += 4 ) {
-				tri->indexes[indexes+0] = i;
-				tri->indexes[indexes+1] = i+2;
-				tri->indexes[indexes+2] = i+3;
-				tri->indexes[indexes+3] = i;
-				tri->indexes[indexes+4] = i+3;
-				tri->indexes[indexes+5] = i+1;
-				indexes += 6;
-			}
-			tri->numIndexes = indexes;
-
-			modelSurface_t	surf;
-			surf.geometry = tri;
-			surf.shader = stage->material;
-			surf.id = 0;
+		tri->numIndexes = ( tri->numVerts / 4 ) * 6;
+	}
 
-			renderEntity->hModel->AddSurface( surf );
+	for ( activeStageNum = 0; activeStageNum < numStages; activeStageNum++ ) {
+		if ( activeStages[activeStageNum].tri->numVerts > activeStages[activeStageNum].numQuads * 4 ) {
+			gameLocal.Error( "idSmokeParticles::UpdateRenderEntity: miscounted verts" );
 		}
 	}
+
 	return true;
 }
 
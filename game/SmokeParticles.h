@@ -55,7 +55,10 @@ class idParticleStage;
 
 typedef struct {
 	const idParticleStage *		stage;
-	singleSmoke_t *				smokes;
+	singleSmoke_t *				smokes;				// NULL while the stage is idle, it keeps its surface until the next rebuild
+	srfTriangles_t *			tri;				// model surface, reused every frame while it is big enough
+	int							maxQuads;			// quads tri has room for, the indexes are built for all of them
+	int							numQuads;			// quads needed for the current smokes
 } activeSmokeStage_t;
 
 
@@ -88,6 +91,7 @@ private:
 	int							numActiveSmokes;
 	int							currentParticleTime;	// don't need to recalculate if == view time
 
+	void						RebuildSurfaces( idRenderModel *model );
 	bool						UpdateRenderEntity( renderEntity_s *renderEntity, const renderView_t *renderView );
 	static bool					ModelCallback( renderEntity_s *renderEntity, const renderView_t *renderView );
 };
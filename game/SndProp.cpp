@@ -111,6 +111,8 @@ CsndProp::CsndProp ( void )
 
 	m_TimeStampProp = 0;
 	m_TimeStampPortLoss = 0;
+
+	m_MinLossMult = 0;
 }
 
 void CsndProp::Clear( void )
@@ -121,6 +123,9 @@ void CsndProp::Clear( void )
 
 	m_AreaPropsG.Clear();
 
+	m_Sources.Clear();
+	m_PropQueue.Clear();
+
 	m_bLoadSuccess = false;
 	m_bDefaultSpherical = false;
 
@@ -267,10 +272,15 @@ void CsndProp::Restore(idRestoreGame *savefile)
 
 			// Restore the ThisPort pointer, it's just pointing at m_sndAreas
 			m_EventAreas[i].PortalDat[portal].ThisPort = &m_sndAreas[i].portals[portal];
+			m_EventAreas[i].PortalDat[portal].Source = 0;
 
 			// greebo: TODO: How to restore PrevPort?
 		}
 	}
+
+	// The area distance table isn't saved, it's loaded from the .sprd file again
+	SetupAreaDists();
+	UpdateMinLossMult();
 }
 
 void CsndProp::SetupFromLoader( const CsndPropLoader *in )
@@ -373,6 +383,9 @@ void CsndProp::SetupFromLoader( const CsndPropLoader *in )
 
 	m_bDefaultSpherical = in->m_bDefaultSpherical;
 	m_AreaPropsG = in->m_AreaPropsG;
+	m_AreaDists = in->m_AreaDists;
+
+	UpdateMinLossMult();
 
 	// initialize Event Areas
 	if ( (m_EventAreas = new SEventArea[m_numAreas]) == NULL )
@@ -433,48 +446,126 @@ void CsndProp::Propagate
 	 int msgTag ) // grayman #3355
 
 {
-	bool bValidTeam(false),
-		 bExpandFinished(false);
-	int			mteam;
-	float		range;
-	
-	UTeamMask	tmask, compMask;
-	
-	idBounds	envBounds(origin);
-	idAI				*testAI;
-	idList<idEntity *>	validTypeEnts, validEnts;
-	SPopArea			*pPopArea;
+	if ( cv_spr_coalesce.GetBool() )
+	{
+		SPropRequest &request = m_PropQueue.Alloc();
+
+		request.volMod = volMod;
+		request.durMod = durMod;
+		request.sndName = sndName;
+		request.origin = origin;
+		request.maker = maker;
+		request.bAddFlags = ( addFlags != NULL );
+		request.addFlags.m_field = ( addFlags != NULL ) ? addFlags->m_field : 0;
+		request.msgTag = msgTag;
+		return;
+	}
 
-	idTimer timer_Prop;
-	if ( cv_spr_debug.GetBool() ) // grayman - only time things if the debug cvar is set
+	ai::AIBenchmarkTiming benchmarkTiming( ai::AIBenchmark::COST_SOUND_PROP );
+
+	m_Sources.SetNum( 1, false );
+
+	if ( SetupSource( volMod, durMod, sndName, origin, maker, addFlags, msgTag, m_Sources[0] ) )
 	{
-		timer_Prop.Clear();
-		timer_Prop.Start();
+		PropagateSources();
 	}
 
-	m_TimeStampProp = gameLocal.time;
+	m_Sources.SetNum( 0, false );
+}
 
-	// clear the old populated areas list
-	m_PopAreasInd.Clear();
-	
-	// grayman #2907 - Initialize the timestamp in Populated Areas. This
-	// becomes important if more than one sound propagates in the same frame.
+void CsndProp::ProcessQueue( void )
+{
+	if ( m_PropQueue.Num() == 0 )
+	{
+		return;
+	}
 
-	for ( int k = 0 ; k < m_numAreas ; k++ )
+	// AI reacting to the sounds may make new ones, those are propagated next frame
+	idList<SPropRequest> queue;
+	queue.Swap( m_PropQueue );
+
+	idList<SPropSource> sources;
+	sources.SetNum( queue.Num() );
+
+	int numSources = 0;
+
+	for ( int i = 0 ; i < queue.Num() ; i++ )
 	{
-		m_PopAreas[k].addedTime = 0;
+		SPropRequest &request = queue[i];
+		idEntity *maker = request.maker.GetEntity();
+
+		// the maker might have been removed in the meantime
+		if ( maker == NULL )
+		{
+			continue;
+		}
+
+		if ( SetupSource( request.volMod, request.durMod, request.sndName, request.origin, maker,
+						  request.bAddFlags ? &request.addFlags : NULL, request.msgTag, sources[numSources] ) )
+		{
+			numSources++;
+		}
 	}
 
-	// initialize the comparison team mask
-	compMask.m_field = 0;
-	
+	// Propagate each group of sources with the same area, sound and maker team together
+	idList<bool> done;
+	done.SetNum( numSources );
+
+	for ( int i = 0 ; i < numSources ; i++ )
+	{
+		done[i] = false;
+	}
+
+	for ( int i = 0 ; i < numSources ; i++ )
+	{
+		if ( done[i] )
+		{
+			continue;
+		}
+
+		const SPropSource &first = sources[i];
+
+		m_Sources.SetNum( 0, false );
+
+		for ( int j = i ; j < numSources ; j++ )
+		{
+			const SPropSource &other = sources[j];
+
+			if ( done[j] || other.area != first.area || other.team != first.team ||
+				 other.tmask.m_field != first.tmask.m_field || other.parms.flags.m_field != first.parms.flags.m_field ||
+				 other.parms.name != first.parms.name )
+			{
+				continue;
+			}
+
+			m_Sources.Append( other );
+			done[j] = true;
+		}
+
+		if ( m_Sources.Num() > 1 )
+		{
+			DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Propagating %d sounds %s from area %d in one expansion\r", m_Sources.Num(), first.parms.name.c_str(), first.area );
+		}
+
+		PropagateSources();
+	}
+
+	m_Sources.SetNum( 0, false );
+}
+
+bool CsndProp::SetupSource
+	( float volMod, float durMod, const idStr& sndName,
+	 idVec3 origin, idEntity *maker,
+	 USprFlags *addFlags,
+	 int msgTag, SPropSource& source )
+{
 	// find the dict def for the specific sound
 	const idDict* parms = gameLocal.FindEntityDefDict( va("sprGS_%s", sndName.c_str() ), false );
 
 	// redundancy, this is already checked in CheckSound()
 	if (!parms)
 	{
-		return;
+		return false;
 	}
 
 	float vol0 = parms->GetFloat("vol","0") + volMod;
@@ -498,13 +589,13 @@ void CsndProp::Propagate
 		gameRenderWorld->DrawText( va("PropVol: %f", vol0), maker->GetPhysics()->GetOrigin(), 0.25f, colorGreen, gameLocal.GetLocalPlayer()->viewAngles.ToMat3(), 1, 100 * gameLocal.msec );
 	}
 
-	SSprParms propParms;
+	SSprParms &propParms = source.parms;
 	propParms.name = sndName;
 	propParms.alertFactor = parms->GetFloat("alert_factor","1");
 	propParms.alertMax = parms->GetFloat("alert_max","30");
 
 	// set team alert and propagation flags from the parms
-	SetupParms( parms, &propParms, addFlags, &tmask );
+	SetupParms( parms, &propParms, addFlags, &source.tmask );
 
 	propParms.duration *= durMod;
 	DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Found modified duration %f\r", propParms.duration);
@@ -514,7 +605,7 @@ void CsndProp::Propagate
 	propParms.messageTag = msgTag; // grayman #3355
 
 	// For objects (non-actors) the team will be set to -1
-	mteam = (maker->IsType(idActor::Type)) ? static_cast<idActor*>(maker)->team : -1;
+	source.team = (maker->IsType(idActor::Type)) ? static_cast<idActor*>(maker)->team : -1;
 
 	// Calculate the range, assuming perceived loudness of a sound doubles every 7 dB
 	// (we want to overestimate a bit.  With the current settings, cutoff for a footstep
@@ -523,21 +614,73 @@ void CsndProp::Propagate
 	// keep in mind that due to FOV compression, visual distances in FPS look shorter
 	// than they actually are.
 
-	range = pow(2.0f, ((vol0 - m_SndGlobals.MaxRangeCalVol) / 7.0f) ) * m_SndGlobals.MaxRange * s_METERS_TO_DOOM;
+	source.range = pow(2.0f, ((vol0 - m_SndGlobals.MaxRangeCalVol) / 7.0f) ) * m_SndGlobals.MaxRange * s_METERS_TO_DOOM;
 
 	if ( cv_spr_debug.GetBool() )
 	{
-		gameLocal.Printf("Propagation volume: %0.02f Range: %0.02f units (%0.02f m)\n", vol0, range, range / s_METERS_TO_DOOM);
+		gameLocal.Printf("Propagation volume: %0.02f Range: %0.02f units (%0.02f m)\n", vol0, source.range, source.range / s_METERS_TO_DOOM);
 	}
 
 	// Debug drawing of the range
 	if (cv_spr_radius_show.GetBool()) 
 	{
-		gameRenderWorld->DebugCircle(colorWhite, origin, idVec3(0,0,1), range, 100, 1000);
+		gameRenderWorld->DebugCircle(colorWhite, origin, idVec3(0,0,1), source.range, 100, 1000);
+	}
+
+	source.origin = origin;
+	source.area = areaNum;
+	source.vol = vol0;
+
+	if ( areaNum == -1 )
+	{
+		DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Sound origin is outside the map, aborting propagation.\r" );
+
+		// grayman #3140 - clear messages from the issuing AI's message list that 
+		// have a message tag that matches this sound's msgTag
+		if ( propParms.makerAI )
+		{
+			propParms.makerAI->ClearMessages(propParms.messageTag); // grayman #3355
+		}
+
+		return false;
 	}
 
-	idBounds bounds(origin);
-	bounds.ExpandSelf(range);
+	return true;
+}
+
+void CsndProp::PropagateSources( void )
+{
+	bool bValidTeam(false),
+		 bExpandFinished(false);
+	
+	UTeamMask	compMask;
+	
+	idAI				*testAI;
+	idList<idEntity *>	validTypeEnts, validEnts;
+	SPopArea			*pPopArea;
+
+	idTimer timer_Prop;
+	if ( cv_spr_debug.GetBool() ) // grayman - only time things if the debug cvar is set
+	{
+		timer_Prop.Clear();
+		timer_Prop.Start();
+	}
+
+	m_TimeStampProp = gameLocal.time;
+
+	// clear the old populated areas list
+	m_PopAreasInd.Clear();
+	
+	// grayman #2907 - Initialize the timestamp in Populated Areas. This
+	// becomes important if more than one sound propagates in the same frame.
+
+	for ( int k = 0 ; k < m_numAreas ; k++ )
+	{
+		m_PopAreas[k].addedTime = 0;
+	}
+
+	// initialize the comparison team mask
+	compMask.m_field = 0;
 
 	// get a list of all ents with type idAI's or Listeners
 	
@@ -580,63 +723,70 @@ void CsndProp::Propagate
 		}
 
 		DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("AI %s might hear this sound\r", testAI->name.c_str());
-						
-		// grayman #3660 - the volume to test is a sphere, so let's change the bounds test to a distance test
 
-		float AIDist2Origin = (testAI->GetEyePosition() - origin).LengthFast();
-		if ( AIDist2Origin >= range )
-		//if ( !bounds.ContainsPoint( testAI->GetEyePosition() ) ) 
+		// the AI is a target if it can hear any of the sources
+		for ( int s = 0 ; s < m_Sources.Num() && !bValidTeam ; s++ )
 		{
-			if ( cv_spr_debug.GetBool() )
+			const SPropSource &source = m_Sources[s];
+			idEntity *maker = source.parms.maker;
+						
+			// grayman #3660 - the volume to test is a sphere, so let's change the bounds test to a distance test
+
+			float AIDist2Origin = (testAI->GetEyePosition() - source.origin).LengthFast();
+			if ( AIDist2Origin >= source.range )
+			//if ( !bounds.ContainsPoint( testAI->GetEyePosition() ) ) 
 			{
-				DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("AI %s is %f from origin, not within propagation cutoff range %f\r", testAI->name.c_str(), AIDist2Origin, range );
-				gameLocal.Printf("AI %s is %f from origin, not within propagation cutoff range %f\n", testAI->name.c_str(), AIDist2Origin, range );
+				if ( cv_spr_debug.GetBool() )
+				{
+					DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("AI %s is %f from origin, not within propagation cutoff range %f\r", testAI->name.c_str(), AIDist2Origin, source.range );
+					gameLocal.Printf("AI %s is %f from origin, not within propagation cutoff range %f\n", testAI->name.c_str(), AIDist2Origin, source.range );
+				}
+				continue;
 			}
-			continue;
-		}
-
-		if ( cv_spr_debug.GetBool() )
-		{
-			DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("AI %s is %f from origin, within propagation cutoff range %f\r", testAI->name.c_str(), AIDist2Origin, range );
-			gameLocal.Printf("AI %s is %f from origin, within propagation cutoff range %f\n", testAI->name.c_str(), AIDist2Origin, range );
-		}
-
-		// Check team membership. Some teams will not respond to sounds made by other teams.
 
-		if ( mteam == -1 )
-		{
-			// for now, inanimate objects alert everyone
-			bValidTeam = true;
 			if ( cv_spr_debug.GetBool() )
 			{
-				DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Sound was propagated from an inanimate object: Alerts all teams\r");
-				gameLocal.Printf("Sound was propagated from an inanimate object: Alerts all teams\n");
+				DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("AI %s is %f from origin, within propagation cutoff range %f\r", testAI->name.c_str(), AIDist2Origin, source.range );
+				gameLocal.Printf("AI %s is %f from origin, within propagation cutoff range %f\n", testAI->name.c_str(), AIDist2Origin, source.range );
 			}
-		}
-		else if ( testAI == maker ) // grayman #3140 - makers don't ping themselves
-		{
-			// do nothing, bValidTeam is false at this point
-		}
-		else
-		{
-			// grayman - tmask holds flags that describe which team
-			// relationships should receive the propagated sound.
-			// When one or more of the flags matches the relationship
-			// flags between the maker and the listener (testAI), then
-			// the listener should respond to the sound.
-			compMask.m_bits.same = ( testAI->team == mteam );
-			compMask.m_bits.friendly = testAI->IsFriend(maker);
-			compMask.m_bits.neutral = testAI->IsNeutral(maker);
-			compMask.m_bits.enemy = testAI->IsEnemy(maker);
-
-			// do the comparison
-			if ( tmask.m_field & compMask.m_field )
+
+			// Check team membership. Some teams will not respond to sounds made by other teams.
+
+			if ( source.team == -1 )
 			{
+				// for now, inanimate objects alert everyone
 				bValidTeam = true;
 				if ( cv_spr_debug.GetBool() )
 				{
-					DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("AI %s has a valid team for soundprop\r", testAI->name.c_str());
-					gameLocal.Printf("AI %s has a valid team for soundprop\n", testAI->name.c_str());
+					DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Sound was propagated from an inanimate object: Alerts all teams\r");
+					gameLocal.Printf("Sound was propagated from an inanimate object: Alerts all teams\n");
+				}
+			}
+			else if ( testAI == maker ) // grayman #3140 - makers don't ping themselves
+			{
+				// do nothing, bValidTeam is false at this point
+			}
+			else
+			{
+				// grayman - tmask holds flags that describe which team
+				// relationships should receive the propagated sound.
+				// When one or more of the flags matches the relationship
+				// flags between the maker and the listener (testAI), then
+				// the listener should respond to the sound.
+				compMask.m_bits.same = ( testAI->team == source.team );
+				compMask.m_bits.friendly = testAI->IsFriend(maker);
+				compMask.m_bits.neutral = testAI->IsNeutral(maker);
+				compMask.m_bits.enemy = testAI->IsEnemy(maker);
+
+				// do the comparison
+				if ( source.tmask.m_field & compMask.m_field )
+				{
+					bValidTeam = true;
+					if ( cv_spr_debug.GetBool() )
+					{
+						DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("AI %s has a valid team for soundprop\r", testAI->name.c_str());
+						gameLocal.Printf("AI %s has a valid team for soundprop\n", testAI->name.c_str());
+					}
 				}
 			}
 		}
@@ -697,9 +847,12 @@ void CsndProp::Propagate
 	{
 		// grayman #3140 - clear messages from the issuing AI's message list that 
 		// have a message tag that matches this sound's msgTag
-		if ( propParms.makerAI )
+		for ( int s = 0 ; s < m_Sources.Num() ; s++ )
 		{
-			propParms.makerAI->ClearMessages(propParms.messageTag); // grayman #3355
+			if ( m_Sources[s].parms.makerAI )
+			{
+				m_Sources[s].parms.makerAI->ClearMessages(m_Sources[s].parms.messageTag); // grayman #3355
+			}
 		}
 
 		return;
@@ -766,7 +919,7 @@ void CsndProp::Propagate
 		timer_Prop.Start();
 	}
 
-	bExpandFinished = ExpandWave( vol0, origin, minAudThresh ); // grayman #3660
+	bExpandFinished = ExpandWave( minAudThresh ); // grayman #3660
 
 	if ( cv_spr_debug.GetBool() ) // grayman - only time things if the debug cvar is set
 	{
@@ -784,7 +937,7 @@ void CsndProp::Propagate
 
 	DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Expansion done, processing AI\r" );
 
-	ProcessPopulated( vol0, origin, &propParms );
+	ProcessPopulated();
 
 	if ( cv_spr_debug.GetBool() ) // grayman - only time things if the debug cvar is set
 	{
@@ -871,7 +1024,65 @@ Quit:
 	return returnval;
 }
 
-bool CsndProp::ExpandWave(float volInit, idVec3 origin, float minAudThresh) // grayman #3660
+void CsndProp::UpdateMinLossMult( void )
+{
+	m_MinLossMult = idMath::INFINITY;
+
+	for ( int i = 0 ; i < m_AreaPropsG.Num() ; i++ )
+	{
+		m_MinLossMult = Min( m_MinLossMult, m_AreaPropsG[i].LossMult );
+	}
+
+	// negative multipliers would let the attenuation shrink along a path
+	if ( m_AreaPropsG.Num() == 0 || m_MinLossMult < 0 )
+	{
+		m_MinLossMult = 0;
+	}
+}
+
+bool CsndProp::SetupGoalDists( void )
+{
+	if ( !cv_spr_prune.GetBool() || m_AreaDists.Num() == 0 )
+	{
+		return false;
+	}
+
+	m_AreaGoalDists.SetNum( m_numAreas, false );
+
+	for ( int area = 0 ; area < m_numAreas ; area++ )
+	{
+		float goalDist = idMath::INFINITY;
+
+		for ( int i = 0 ; i < m_PopAreasInd.Num() && goalDist > 0 ; i++ )
+		{
+			goalDist = Min( goalDist, AreaDistLowerBound( area, m_PopAreasInd[i] ) );
+		}
+
+		m_AreaGoalDists[area] = goalDist;
+	}
+
+	return true;
+}
+
+bool CsndProp::CannotReachPopulated( int area, float dist, float att, float volInit, float minAudThresh ) const
+{
+	float goalDist = m_AreaGoalDists[area];
+
+	if ( goalDist >= idMath::INFINITY )
+	{
+		// no populated area behind this portal
+		return true;
+	}
+
+	// Portal losses are never negative, so the loss at the first portal of the nearest
+	// populated area is at least the loss over the remaining distance at m_MinLossMult
+	float totalDist = dist + goalDist;
+	float minLoss = m_SndGlobals.Falloff_Ind * s_invLog10*idMath::Log16(totalDist) + att + m_MinLossMult * goalDist + 8;
+
+	return ( volInit - minLoss ) < minAudThresh;
+}
+
+bool CsndProp::ExpandWave(float minAudThresh) // grayman #3660
 {
 	bool				returnval;
 	int					//popIndex(-1),
@@ -886,25 +1097,32 @@ bool CsndProp::ExpandWave(float volInit, idVec3 origin, float minAudThresh) // g
 	DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Starting wavefront expansion\r" );
 
 	// clear the visited settings on m_EventAreas from previous propagations
+	// (the sources of the portal losses must be valid indices into m_Sources)
 	for ( int i = 0 ; i < m_numAreas ; i++ )
 	{
 		m_EventAreas[i].bVisited = false;
+
+		for ( int j = 0 ; j < m_sndAreas[i].numPortals ; j++ )
+		{
+			m_EventAreas[i].PortalDat[j].Source = 0;
+		}
 	}
 
 	NextAreas.Clear();
 	AddedAreas.Clear();
+
+	// Lower bounds for goal directed pruning: portals that can't carry an audible
+	// sound into a populated area are treated like portals below the threshold
+	bool bPrune = SetupGoalDists();
+	int pruned = 0;
 	
 	// ======================== Handle the initial area =========================
 
 	DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Processing initial area\r" );
 
-	int initArea = gameRenderWorld->PointInArea( origin );
+	// all sources are in the same area
+	int initArea = m_Sources[0].area;
 	DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Sound origin is in portal area: %d\r", initArea );
-	if ( initArea == -1 )
-	{
-		DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Sound origin is outside the map, aborting propagation.\r" );
-		return false;
-	}
 
 	m_EventAreas[ initArea ].bVisited = true;
 
@@ -919,43 +1137,64 @@ bool CsndProp::ExpandWave(float volInit, idVec3 origin, float minAudThresh) // g
 	// calculate initial portal losses from the sound origin point
 	for ( int i2 = 0 ; i2 < pSndAreas->numPortals ; i2++ )
 	{
-		// grayman #3660 - using the portal center can throw the loss
-		// results way off when a mission uses large portals. Instead of
-		// using the center, use an orthogonal projection of the origin onto the plane
-		// of the portal, then pull the projection onto the portal if it's not already there.
 		const idWinding *wind = pSndAreas->portals[i2].winding;
 		idPlane WPlane;
 		wind->GetPlane(WPlane);
-		float scale;
-		WPlane.RayIntersection( origin, WPlane.Normal(), scale );
-		idVec3 portalCoord = origin + scale*WPlane.Normal();
-		if ( !wind->PointInside( WPlane.Normal(), portalCoord, 0.1f ))
+
+		// the portal carries the loss of the source that's loudest at it
+		int source = 0;
+		float bestLevel = -idMath::INFINITY;
+
+		for ( int s = 0 ; s < m_Sources.Num() ; s++ )
 		{
-			// Not inside winding, so pull the point to the portal.
-			if (scale < 0.0f)
-			{
-				portalCoord -= 0.1f*WPlane.Normal();
-			}
-			else
+			const idVec3 &origin = m_Sources[s].origin;
+
+			// grayman #3660 - using the portal center can throw the loss
+			// results way off when a mission uses large portals. Instead of
+			// using the center, use an orthogonal projection of the origin onto the plane
+			// of the portal, then pull the projection onto the portal if it's not already there.
+			float scale;
+			WPlane.RayIntersection( origin, WPlane.Normal(), scale );
+			idVec3 portalCoord = origin + scale*WPlane.Normal();
+			if ( !wind->PointInside( WPlane.Normal(), portalCoord, 0.1f ))
 			{
-				portalCoord += 0.1f*WPlane.Normal();
+				// Not inside winding, so pull the point to the portal.
+				if (scale < 0.0f)
+				{
+					portalCoord -= 0.1f*WPlane.Normal();
+				}
+				else
+				{
+					portalCoord += 0.1f*WPlane.Normal();
+				}
+				portalCoord = SurfPoint( origin, portalCoord, &(pSndAreas->portals[i2]));
 			}
-			portalCoord = SurfPoint( origin, portalCoord, &(pSndAreas->portals[i2]));
-		}
 
-		// old way
-		//idVec3 portalCoord = pSndAreas->portals[i2].center;
+			// old way
+			//idVec3 portalCoord = pSndAreas->portals[i2].center;
 
-		tempDist = (origin - portalCoord).LengthFast() * s_DOOM_TO_METERS;
+			float dist = (origin - portalCoord).LengthFast() * s_DOOM_TO_METERS;
 
-		// calculate and set initial portal losses
-		tempAtt = m_AreaPropsG[ initArea ].LossMult * tempDist;
-		
-		// add the portal loss
-		tempAtt += m_PortData[ pSndAreas->portals[i2].handle - 1 ].lossAI;
+			// calculate and set initial portal losses
+			float att = m_AreaPropsG[ initArea ].LossMult * dist;
+			
+			// add the portal loss
+			att += m_PortData[ pSndAreas->portals[i2].handle - 1 ].lossAI;
 
-		// get the current loss
-		tempLoss = m_SndGlobals.Falloff_Ind * s_invLog10*idMath::Log16(tempDist) + tempAtt + 8;
+			// get the current loss
+			float loss = m_SndGlobals.Falloff_Ind * s_invLog10*idMath::Log16(dist) + att + 8;
+
+			if ( m_Sources[s].vol - loss > bestLevel )
+			{
+				bestLevel = m_Sources[s].vol - loss;
+				source = s;
+				tempDist = dist;
+				tempAtt = att;
+				tempLoss = loss;
+			}
+		}
+
+		float volInit = m_Sources[source].vol;
 
 		pPortEv = &pEventAreas->PortalDat[i2];
 		pPortEv->Loss = tempLoss;
@@ -963,6 +1202,7 @@ bool CsndProp::ExpandWave(float volInit, idVec3 origin, float minAudThresh) // g
 		pPortEv->Att = tempAtt;
 		pPortEv->Floods = 1;
 		pPortEv->PrevPort = NULL;
+		pPortEv->Source = source;
 
 		DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Loss tempLoss at portal %d is %f [dB]\r", i2, tempLoss);
 		DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Dist tempDist at portal %d is %f [m], %f [D3]\r", i2, tempDist, tempDist/s_DOOM_TO_METERS);
@@ -970,7 +1210,12 @@ bool CsndProp::ExpandWave(float volInit, idVec3 origin, float minAudThresh) // g
 		// add the portal destination to flooding queue if the sound has
 		// not dropped below threshold at the portal
 		// grayman #3660 - use the recorded minimum audio threshold for the AI being checked
-		if ( (volInit - tempLoss) > minAudThresh )
+		if ( bPrune && CannotReachPopulated( pSndAreas->portals[i2].to, tempDist, tempAtt, volInit, minAudThresh ) )
+		{
+			pruned++;
+			DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("No populated area can be reached through portal %d\r", i2);
+		}
+		else if ( (volInit - tempLoss) > minAudThresh )
 		//if ( (volInit - tempLoss) > s_MIN_AUD_THRESH )
 		{
 			tempQEntry.area = pSndAreas->portals[i2].to;
@@ -979,6 +1224,7 @@ bool CsndProp::ExpandWave(float volInit, idVec3 origin, float minAudThresh) // g
 			tempQEntry.curLoss = tempLoss;
 			tempQEntry.portalH = pSndAreas->portals[i2].handle;
 			tempQEntry.PrevPort = NULL;
+			tempQEntry.source = source;
 
 			NextAreas.Append( tempQEntry );
 			DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Wavefront intensity still above threshold at portal %d\r", i2);
@@ -1037,6 +1283,9 @@ bool CsndProp::ExpandWave(float volInit, idVec3 origin, float minAudThresh) // g
 			pPortEv->Loss = NextAreas[j].curLoss;
 			pPortEv->Floods = floods - 1;
 			pPortEv->PrevPort = NextAreas[j].PrevPort;
+			pPortEv->Source = NextAreas[j].source;
+
+			float volInit = m_Sources[ NextAreas[j].source ].vol;
 
 			// Updated the Populated Areas to show that it's been visited
 			// Only do this for populated areas that matter (ie, they've been updated
@@ -1078,8 +1327,8 @@ bool CsndProp::ExpandWave(float volInit, idVec3 origin, float minAudThresh) // g
 				tempLoss = m_SndGlobals.Falloff_Ind * s_invLog10*idMath::Log16(tempDist) + tempAtt + 8;
 
 				// check if we've visited the area, and do not add destination area 
-				//	if loss is greater this time
-				if ( pEventAreas->bVisited && ( tempLoss >= pPortEv->Loss ) )
+				//	if loss is greater this time (relative to the volumes of the sources)
+				if ( pEventAreas->bVisited && ( volInit - tempLoss <= m_Sources[ pPortEv->Source ].vol - pPortEv->Loss ) )
 				{
 					DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Cancelling flood thru portal %d in previously visited area %d\r", i, area);
 					continue;
@@ -1095,6 +1344,13 @@ bool CsndProp::ExpandWave(float volInit, idVec3 origin, float minAudThresh) // g
 
 				DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Wavefront intensity still above abs min audibility at portal %d in area %d\r", i, area);
 
+				if ( bPrune && CannotReachPopulated( pSndAreas->portals[i].to, tempDist, tempAtt, volInit, minAudThresh ) )
+				{
+					pruned++;
+					DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("No populated area can be reached through portal %d in area %d\r", i, area);
+					continue;
+				}
+
 				// path has been determined to be minimal loss, above cutoff intensity
 				// store the loss value
 
@@ -1105,6 +1361,7 @@ bool CsndProp::ExpandWave(float volInit, idVec3 origin, float minAudThresh) // g
 				pPortEv->Att = tempAtt;
 				pPortEv->Floods = floods;
 				pPortEv->PrevPort = &pEventAreas->PortalDat[ LocalPort ];
+				pPortEv->Source = NextAreas[j].source;
 
 				// add the portal destination to flooding queue
 				tempQEntry.area = pSndAreas->portals[i].to;
@@ -1113,6 +1370,7 @@ bool CsndProp::ExpandWave(float volInit, idVec3 origin, float minAudThresh) // g
 				tempQEntry.curLoss = tempLoss;
 				tempQEntry.portalH = pSndAreas->portals[i].handle;
 				tempQEntry.PrevPort = pPortEv->PrevPort;
+				tempQEntry.source = NextAreas[j].source;
 
 				AddedAreas.Append( tempQEntry );
 			
@@ -1126,13 +1384,15 @@ bool CsndProp::ExpandWave(float volInit, idVec3 origin, float minAudThresh) // g
 
 	} // end main loop
 
+	DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Expansion flooded %d nodes, %d portals pruned\r", nodes, pruned );
+
 	// return true if the expansion died out naturally rather than being stopped
 	returnval = ( !NextAreas.Num() );
 
 	return returnval;
 } // end function
 
-void CsndProp::ProcessPopulated( float volInit, idVec3 origin, SSprParms *propParms )
+void CsndProp::ProcessPopulated( void )
 {
 	float LeastLoss, TestLoss, tempDist, tempAtt, tempLoss;
 	int LoudPort(0), portNum;
@@ -1140,8 +1400,10 @@ void CsndProp::ProcessPopulated( float volInit, idVec3 origin, SSprParms *propPa
 	SPortEvent *pPortEv;
 	SPopArea *pPopArea;
 	idList<idVec3> showPoints;
+	SSprParms *propParms;
 	
-	int initArea = gameRenderWorld->PointInArea( origin );
+	// all sources are in the same area
+	int initArea = m_Sources[0].area;
 
 	for ( int i = 0; i < m_PopAreasInd.Num() ; i++ )
 	{
@@ -1156,9 +1418,6 @@ void CsndProp::ProcessPopulated( float volInit, idVec3 origin, SSprParms *propPa
 		{
 			DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("AI are in the initial area %d\r", area);
 
-			propParms->bSameArea = true;
-			propParms->direction = origin;
-
 			for ( int j = 0 ; j < pPopArea->AIContents.Num() ; j++ )
 			{
 				idAI* ai = pPopArea->AIContents[j].GetEntity();
@@ -1168,20 +1427,43 @@ void CsndProp::ProcessPopulated( float volInit, idVec3 origin, SSprParms *propPa
 					continue;
 				}
 
-				// grayman #3424 - Don't react if you made the propagated sound.
-				// This only needs to be checked when the sound origin and the
-				// AI are in the same area.
+				// The AI processes the loudest of the sources
+				int source = -1;
+				float propVol = -idMath::INFINITY;
 
-				if (ai == propParms->maker)
+				for ( int s = 0 ; s < m_Sources.Num() ; s++ )
+				{
+					// grayman #3424 - Don't react if you made the propagated sound.
+					// This only needs to be checked when the sound origin and the
+					// AI are in the same area.
+
+					if (ai == m_Sources[s].parms.maker)
+					{
+						continue;
+					}
+
+					tempDist = (m_Sources[s].origin - ai->GetEyePosition()).LengthFast() * s_DOOM_TO_METERS;
+					tempAtt = tempDist * m_AreaPropsG[ area ].LossMult;
+					tempLoss = m_SndGlobals.Falloff_Ind * s_invLog10*idMath::Log16(tempDist) + tempAtt + 8;
+
+					if ( m_Sources[s].vol - tempLoss > propVol )
+					{
+						propVol = m_Sources[s].vol - tempLoss;
+						source = s;
+					}
+				}
+
+				if ( source == -1 )
 				{
 					continue;
 				}
 
-				tempDist = (origin - ai->GetEyePosition()).LengthFast() * s_DOOM_TO_METERS;
-				tempAtt = tempDist * m_AreaPropsG[ area ].LossMult;
-				tempLoss = m_SndGlobals.Falloff_Ind * s_invLog10*idMath::Log16(tempDist) + tempAtt + 8;
+				const idVec3 &origin = m_Sources[source].origin;
+				propParms = &m_Sources[source].parms;
 
-				propParms->propVol = volInit - tempLoss;
+				propParms->bSameArea = true;
+				propParms->direction = origin;
+				propParms->propVol = propVol;
 
 				DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Processing AI %s in initial area %d\r", ai->name.c_str(), area);
 				DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Dist to AI: %f [m], %f [D3], Propagated volume %f [dB]\r", tempDist, tempDist/s_DOOM_TO_METERS, propParms->propVol);
@@ -1202,7 +1484,6 @@ void CsndProp::ProcessPopulated( float volInit, idVec3 origin, SSprParms *propPa
 		else if ( pPopArea->bVisited == true )
 		{
 			DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Area %d was visited by the wave, so process its %d AI\r", area, pPopArea->AIContents.Num());
-			propParms->bSameArea = false;
 
 			// figure out the least loss portal
 			// May be different for each AI (esp. in large rooms)
@@ -1222,6 +1503,7 @@ void CsndProp::ProcessPopulated( float volInit, idVec3 origin, SSprParms *propPa
 				DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Calculating least loss for AI %s in area %d\r", ai->name.c_str(), area);
 
 				LeastLoss = idMath::INFINITY;
+				float LoudestLevel = -idMath::INFINITY;
 
 				// grayman #3660 - Determine which of the portals in the
 				// receiving AI's area represents the least volume loss for the sound wave.
@@ -1233,6 +1515,8 @@ void CsndProp::ProcessPopulated( float volInit, idVec3 origin, SSprParms *propPa
 					portNum = pPopArea->VisitedPorts[ k ];
 					pPortEv = &m_EventAreas[area].PortalDat[ portNum ];
 
+					const idVec3 &origin = m_Sources[ pPortEv->Source ].origin;
+
 					DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Calculating loss from portal %d, k = %d, portsnum = %d\r", portNum, k, m_PopAreas[i].VisitedPorts.Num());
 
 					// grayman #3660 - using the portal center can throw the loss
@@ -1279,8 +1563,10 @@ void CsndProp::ProcessPopulated( float volInit, idVec3 origin, SSprParms *propPa
 					TestLoss = m_SndGlobals.Falloff_Ind * s_invLog10*idMath::Log16(tempDist) + tempAtt + 8;
 					DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Portal %d has total Loss = %f [dB]\r", portNum, TestLoss);
 
-					if ( TestLoss < LeastLoss )
+					// the portals may carry the losses of different sources
+					if ( m_Sources[ pPortEv->Source ].vol - TestLoss > LoudestLevel )
 					{
+						LoudestLevel = m_Sources[ pPortEv->Source ].vol - TestLoss;
 						LeastLoss = TestLoss;
 						LoudPort = portNum;
 					}
@@ -1289,6 +1575,19 @@ void CsndProp::ProcessPopulated( float volInit, idVec3 origin, SSprParms *propPa
 				DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Portal %d has least loss %f [dB] for AI %s. This is used if path minimization isn't available\r", LoudPort, LeastLoss, ai->name.c_str());
 
 				pPortEv = &m_EventAreas[area].PortalDat[ LoudPort ];
+
+				const SPropSource &source = m_Sources[ pPortEv->Source ];
+
+				if ( ai == source.parms.maker )
+				{
+					continue;
+				}
+
+				float volInit = source.vol;
+				const idVec3 &origin = source.origin;
+				propParms = &m_Sources[ pPortEv->Source ].parms;
+
+				propParms->bSameArea = false;
 				propParms->floods = pPortEv->Floods;
 
 				// Detailed Path Minimization: 
@@ -1345,11 +1644,14 @@ void CsndProp::ProcessPopulated( float volInit, idVec3 origin, SSprParms *propPa
 
 	// greebo: We're done propagating, clear the message list of the issuing AI, if appropriate
 	// grayman #3355 - clear messages from the issuing AI's message list that match this sound's msgTag
-	if ( propParms->makerAI != NULL )
+	for ( int s = 0 ; s < m_Sources.Num() ; s++ )
 	{
-		// grayman #3140 - clear messages from the issuing AI's message list that 
-		// have a message tag that matches this sound's msgTag
-		propParms->makerAI->ClearMessages(propParms->messageTag);
+		if ( m_Sources[s].parms.makerAI != NULL )
+		{
+			// grayman #3140 - clear messages from the issuing AI's message list that 
+			// have a message tag that matches this sound's msgTag
+			m_Sources[s].parms.makerAI->ClearMessages(m_Sources[s].parms.messageTag);
+		}
 	}
 }
 
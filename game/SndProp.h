@@ -98,6 +98,8 @@ typedef struct SPortEvent_s
 
 	SPortEvent_s *PrevPort; // the portal visited immediately before each portal
 
+	int		Source; // index of the sound source in CsndProp::m_Sources the loss is from
+
 } SPortEvent;
 
 /**
@@ -128,8 +130,56 @@ typedef struct SExpQue_s
 
 	SPortEvent *PrevPort; // previous portal flooded through along path
 
+	int			source; // index of the sound source in CsndProp::m_Sources
+
 } SExpQue;
 
+/**
+* A sound source of a wavefront expansion. Sounds of the same kind made
+* in the same area in the same frame are expanded together, each portal
+* keeps the loss of the source that is loudest there.
+**/
+typedef struct SPropSource_s
+{
+	idVec3		origin;
+
+	int			area; // portal area of the origin
+
+	float		vol; // initial volume [dB]
+
+	float		range; // cutoff range [doom units]
+
+	int			team; // team of the maker, -1 for objects
+
+	UTeamMask	tmask; // team relationships that respond to the sound
+
+	SSprParms	parms;
+
+} SPropSource;
+
+/**
+* A sound waiting in the propagation queue, see CsndProp::ProcessQueue
+**/
+typedef struct SPropRequest_s
+{
+	float					volMod;
+
+	float					durMod;
+
+	idStr					sndName;
+
+	idVec3					origin;
+
+	idEntityPtr<idEntity>	maker;
+
+	bool					bAddFlags; // addFlags was passed
+
+	USprFlags				addFlags;
+
+	int						msgTag;
+
+} SPropRequest;
+
 
 
 
@@ -144,9 +194,20 @@ public:
 	void	Save(idSaveGame *savefile) const;
 	void	Restore(idRestoreGame *savefile);
 
+	/**
+	* Propagates a suspicious sound to the AI. If tdm_spr_coalesce is set, the
+	* sound is queued and propagated by ProcessQueue at the end of the frame.
+	**/
 	void Propagate( float volMod, float durMod, const idStr& soundName,
 		idVec3 origin, idEntity *maker, USprFlags *addFlags = NULL, int msgTag = 0 ); // grayman #3355
 
+	/**
+	* Propagates the queued sounds, called once per frame. Sounds of the same
+	* name and maker team that originate in the same area are expanded in one
+	* wavefront, and every AI processes only the loudest of them.
+	**/
+	void ProcessQueue( void );
+
 	/**
 	* Get the appropriate vars from the sndPropLoader after
 	* it has loaded data for the map.
@@ -186,7 +247,39 @@ protected:
 	* Returns true if the expansion died out naturally rather than being stopped
 	*	by a computation limit.
 	**/
-	bool ExpandWave(float volInit, idVec3 origin, float minAudThresh);
+	bool ExpandWave(float minAudThresh);
+
+	/**
+	* Fills in the source from the sound def, returns false if the sound
+	* doesn't exist or its origin is outside the map.
+	**/
+	bool SetupSource( float volMod, float durMod, const idStr& sndName,
+					  idVec3 origin, idEntity *maker, USprFlags *addFlags,
+					  int msgTag, SPropSource& source );
+
+	/**
+	* Propagates the sounds in m_Sources, which all originate in the same area
+	**/
+	void PropagateSources( void );
+
+	/**
+	* Fills m_AreaGoalDists with the lower bound of the distance from each area
+	* to the nearest area in m_PopAreasInd. Returns false if there's no area
+	* distance table or pruning is disabled.
+	**/
+	bool SetupGoalDists( void );
+
+	/**
+	* True if a wavefront entering area with the given distance and attenuation
+	* can't be heard in any of the populated areas anymore, even along the
+	* shortest portal path.
+	**/
+	bool CannotReachPopulated( int area, float dist, float att, float volInit, float minAudThresh ) const;
+
+	/**
+	* Computes m_MinLossMult from m_AreaPropsG
+	**/
+	void UpdateMinLossMult( void );
 
 	/**
 	* Faster and less accurate wavefront expansion algorithm.
@@ -205,7 +298,7 @@ protected:
 	/**
 	* Process the populated areas after a sound propagation event.
 	**/
-	void ProcessPopulated( float volInit, idVec3 origin, SSprParms *propParms );
+	void ProcessPopulated( void );
 
 	/**
 	* Process individual AI.  Messages the individual AI, and will later calculate
@@ -295,6 +388,27 @@ protected:
 	* come from close to the same spot, for optimization.
 	**/
 	SEventArea		*m_EventAreas;
+
+	/**
+	* Per area lower bound of the distance [m] to the nearest populated area
+	* of the current expansion, see SetupGoalDists.
+	**/
+	idList<float>	m_AreaGoalDists;
+
+	/**
+	* The sound sources of the current expansion
+	**/
+	idList<SPropSource>		m_Sources;
+
+	/**
+	* Sounds waiting for ProcessQueue
+	**/
+	idList<SPropRequest>	m_PropQueue;
+
+	/**
+	* The smallest loss multiplier of all areas, the attenuation lower bound per meter
+	**/
+	float			m_MinLossMult;
 };
 
 #endif
@@ -43,6 +43,9 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #include "MatrixSq.h"
 #include "Misc.h"
 
+#include <queue>
+#include <vector>
+
 class idLocationEntity;
 
 // TODO: Write the mapfile timestamp to the .spr file and compare them
@@ -53,6 +56,13 @@ const float s_METERS_TO_DOOM = (1.0f/DOOM_TO_METERS);	// meters to doom
 
 const float s_DBM_TO_M = 1.0/(10*log10( idMath::E )); // convert between dB/m and 1/m
 
+// Area distance table file (.sprd, next to the .map file)
+const char *s_AREADIST_EXT = "sprd";
+const int s_AREADIST_MAGIC = ('S' << 24) | ('P' << 16) | ('R' << 8) | 'D';
+const int s_AREADIST_VERSION = 1;
+const int s_AREADIST_MAX_AREAS = 4096; // 16 MB table
+const unsigned short s_AREADIST_UNREACHABLE = 0xFFFF;
+
 void SsndPGlobals::Save(idSaveGame *savefile) const
 {
 	savefile->WriteString(AreaPropName);
@@ -816,9 +826,258 @@ void CsndPropBase::DestroyAreasData( void )
 		m_numPortals = 0;
 	}
 
+	m_AreaDists.Clear();
+
 	DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Destroy Areas data finished.\r");
 }
 
+float CsndPropBase::AreaDistLowerBound( int area1, int area2 ) const
+{
+	if ( area1 == area2 )
+	{
+		return 0.0f;
+	}
+
+	if ( m_AreaDists.Num() == 0 )
+	{
+		return idMath::INFINITY;
+	}
+
+	if ( area1 > area2 )
+	{
+		idSwap( area1, area2 );
+	}
+
+	unsigned short dist = m_AreaDists[ area1 * ( 2 * m_numAreas - area1 - 1 ) / 2 + area2 - area1 - 1 ];
+
+	return ( dist == s_AREADIST_UNREACHABLE ) ? idMath::INFINITY : dist * 0.1f;
+}
+
+void CsndPropBase::SetupAreaDists( void )
+{
+	m_AreaDists.Clear();
+
+	if ( m_sndAreas == NULL || m_PortData == NULL || m_numAreas < 2 )
+	{
+		return;
+	}
+
+	if ( m_numAreas > s_AREADIST_MAX_AREAS )
+	{
+		DM_LOG(LC_SOUND, LT_WARNING)LOGSTRING("%d areas exceed the area distance table limit of %d, propagation won't be pruned\r", m_numAreas, s_AREADIST_MAX_AREAS);
+		return;
+	}
+
+	idStr fileName = gameLocal.GetMapName();
+	fileName.SetFileExtension( s_AREADIST_EXT );
+
+	unsigned long checksum = AreaDistsChecksum();
+
+	if ( LoadAreaDists( fileName, checksum ) )
+	{
+		DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Loaded area distance table from %s\r", fileName.c_str());
+		return;
+	}
+
+	idTimer timer;
+	timer.Start();
+
+	BuildAreaDists();
+
+	timer.Stop();
+	DM_LOG(LC_SOUND, LT_INFO)LOGSTRING("Built area distance table for %d areas in %lf [ms]\r", m_numAreas, timer.Milliseconds());
+
+	WriteAreaDists( fileName, checksum );
+}
+
+void CsndPropBase::BuildAreaDists( void )
+{
+	typedef std::pair<float, int> QueueEntry; // distance [m], portal handle - 1
+	std::priority_queue< QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > queue;
+
+	idList<float> portDists;
+	portDists.SetNum( m_numPortals );
+
+	idList<float> areaDists;
+	areaDists.SetNum( m_numAreas );
+
+	m_AreaDists.SetNum( m_numAreas * ( m_numAreas - 1 ) / 2 );
+
+	int index = 0;
+
+	for ( int source = 0; source < m_numAreas; source++ )
+	{
+		for ( int i = 0; i < m_numPortals; i++ )
+		{
+			portDists[i] = idMath::INFINITY;
+		}
+
+		for ( int i = 0; i < m_numAreas; i++ )
+		{
+			areaDists[i] = idMath::INFINITY;
+		}
+
+		// all portals of the source area are at distance 0
+		for ( int i = 0; i < m_sndAreas[source].numPortals; i++ )
+		{
+			int port = m_sndAreas[source].portals[i].handle - 1;
+			portDists[port] = 0.0f;
+			queue.push( QueueEntry( 0.0f, port ) );
+		}
+
+		while ( !queue.empty() )
+		{
+			QueueEntry entry = queue.top();
+			queue.pop();
+
+			int port = entry.second;
+
+			if ( entry.first > portDists[port] )
+			{
+				continue; // stale entry
+			}
+
+			// relax the edges to the other portals of both areas of this portal
+			for ( int side = 0; side < 2; side++ )
+			{
+				int area = m_PortData[port].Areas[side];
+
+				if ( area < 0 )
+				{
+					continue;
+				}
+
+				areaDists[area] = Min( areaDists[area], entry.first );
+
+				const SsndArea& sndArea = m_sndAreas[area];
+
+				if ( sndArea.numPortals < 2 )
+				{
+					continue;
+				}
+
+				int local = m_PortData[port].LocalIndex[side];
+
+				for ( int i = 0; i < sndArea.numPortals; i++ )
+				{
+					if ( i == local )
+					{
+						continue;
+					}
+
+					int other = sndArea.portals[i].handle - 1;
+					float dist = entry.first + sndArea.portalDists->GetRev( local, i );
+
+					if ( dist < portDists[other] )
+					{
+						portDists[other] = dist;
+						queue.push( QueueEntry( dist, other ) );
+					}
+				}
+			}
+		}
+
+		for ( int target = source + 1; target < m_numAreas; target++, index++ )
+		{
+			float dist = areaDists[target];
+
+			// round down to decimeters so the table stays a lower bound
+			m_AreaDists[index] = ( dist >= idMath::INFINITY ) ? s_AREADIST_UNREACHABLE :
+				static_cast<unsigned short>( Min( idMath::Floor( dist * 10.0f ), s_AREADIST_UNREACHABLE - 1.0f ) );
+		}
+	}
+}
+
+unsigned long CsndPropBase::AreaDistsChecksum( void ) const
+{
+	unsigned long crc;
+	CRC32_InitChecksum( crc );
+
+	CRC32_UpdateChecksum( crc, &m_numAreas, sizeof( m_numAreas ) );
+	CRC32_UpdateChecksum( crc, &m_numPortals, sizeof( m_numPortals ) );
+
+	for ( int area = 0; area < m_numAreas; area++ )
+	{
+		const SsndArea& sndArea = m_sndAreas[area];
+
+		CRC32_UpdateChecksum( crc, &sndArea.numPortals, sizeof( sndArea.numPortals ) );
+
+		for ( int i = 0; i < sndArea.numPortals; i++ )
+		{
+			CRC32_UpdateChecksum( crc, &sndArea.portals[i].handle, sizeof( sndArea.portals[i].handle ) );
+			CRC32_UpdateChecksum( crc, &sndArea.portals[i].center, sizeof( sndArea.portals[i].center ) );
+		}
+	}
+
+	CRC32_FinishChecksum( crc );
+
+	return crc;
+}
+
+bool CsndPropBase::LoadAreaDists( const char *fileName, unsigned long checksum )
+{
+	idFile *file = fileSystem->OpenFileRead( fileName );
+
+	if ( file == NULL )
+	{
+		return false;
+	}
+
+	int magic, version, numAreas, numPortals;
+	unsigned int fileChecksum;
+
+	file->ReadInt( magic );
+	file->ReadInt( version );
+	file->ReadInt( numAreas );
+	file->ReadInt( numPortals );
+	file->ReadUnsignedInt( fileChecksum );
+
+	int count = m_numAreas * ( m_numAreas - 1 ) / 2;
+
+	if ( magic != s_AREADIST_MAGIC || version != s_AREADIST_VERSION || numAreas != m_numAreas || numPortals != m_numPortals
+		|| fileChecksum != static_cast<unsigned int>( checksum ) || file->Length() - file->Tell() != count * 2 )
+	{
+		DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Area distance table %s is out of date\r", fileName);
+		fileSystem->CloseFile( file );
+		return false;
+	}
+
+	m_AreaDists.SetNum( count );
+
+	for ( int i = 0; i < count; i++ )
+	{
+		file->ReadUnsignedShort( m_AreaDists[i] );
+	}
+
+	fileSystem->CloseFile( file );
+
+	return true;
+}
+
+void CsndPropBase::WriteAreaDists( const char *fileName, unsigned long checksum ) const
+{
+	idFile *file = fileSystem->OpenFileWrite( fileName );
+
+	if ( file == NULL )
+	{
+		DM_LOG(LC_SOUND, LT_WARNING)LOGSTRING("Couldn't write area distance table %s\r", fileName);
+		return;
+	}
+
+	file->WriteInt( s_AREADIST_MAGIC );
+	file->WriteInt( s_AREADIST_VERSION );
+	file->WriteInt( m_numAreas );
+	file->WriteInt( m_numPortals );
+	file->WriteUnsignedInt( static_cast<unsigned int>( checksum ) );
+
+	for ( int i = 0; i < m_AreaDists.Num(); i++ )
+	{
+		file->WriteUnsignedShort( m_AreaDists[i] );
+	}
+
+	fileSystem->CloseFile( file );
+}
+
 void CsndPropBase::SetPortalAILoss( int handle, float value )
 {
 	// make sure the handle is valid
@@ -909,6 +1168,8 @@ void CsndPropLoader::CompileMap( idMapFile *MapFile  )
 
 	CreateAreasData();
 
+	SetupAreaDists();
+
 	DM_LOG(LC_SOUND, LT_DEBUG)LOGSTRING("Sound propagation system finished loading.\r");
 
 	m_bLoadSuccess = true;
@@ -272,6 +272,14 @@ public:
 	float GetPortalAILoss( int handle );
 	float GetPortalPlayerLoss( int handle );
 
+	/**
+	* Lower bound of the acoustical distance [m] between two areas, that is
+	* the shortest distance over the portal graph from any portal of area1
+	* to any portal of area2. 0 for the same area, idMath::INFINITY if area2
+	* can't be reached from area1 or if the table is not available.
+	**/
+	float AreaDistLowerBound( int area1, int area2 ) const;
+
 protected:
 
 	/**
@@ -291,6 +299,26 @@ protected:
 	**/
 	void DestroyAreasData( void );
 
+	/**
+	* Loads the area distance table from the .sprd file of the current map,
+	* or builds it from the portal graph and writes the file if that is
+	* missing or out of date. Requires m_sndAreas and m_PortData.
+	**/
+	void SetupAreaDists( void );
+
+	/**
+	* Builds m_AreaDists with one Dijkstra search per area over the portal graph
+	**/
+	void BuildAreaDists( void );
+
+	bool LoadAreaDists( const char *fileName, unsigned long checksum );
+	void WriteAreaDists( const char *fileName, unsigned long checksum ) const;
+
+	/**
+	* Checksum of the portal graph the area distance table was built from
+	**/
+	unsigned long AreaDistsChecksum( void ) const;
+
 protected:
 
 	/**
@@ -340,6 +368,13 @@ protected:
 	* Also stores the current attenuation value of the portal
 	**/
 	SPortData			*m_PortData;
+
+	/**
+	* Area distance lower bounds in decimeters (rounded down), the upper
+	* triangle of the area x area matrix without the diagonal, see
+	* AreaDistLowerBound. Empty if not built. 0xFFFF means unreachable.
+	**/
+	idList<unsigned short>	m_AreaDists;
 };
 
 
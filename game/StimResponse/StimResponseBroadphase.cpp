@@ -0,0 +1,535 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+#include "precompiled_game.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "StimResponseBroadphase.h"
+#include "StimResponseCollection.h"
+#include "../Func_Shooter.h"
+
+// The edge length of the grid cells
+static const float SR_CELL_SIZE = 256.0f;
+
+// Responders spanning more cells are not linked into the grid but tested by every stim of their type
+static const int SR_MAX_RESPONDER_CELLS = 64;
+
+// Stims covering more cells walk the responders of their type instead of the cells
+static const int SR_MAX_QUERY_CELLS = 64;
+
+// Floating point, the range of a huge stim can overflow an int
+static float CountCells(const int cells[2][3])
+{
+	return static_cast<float>(cells[1][0] - cells[0][0] + 1) *
+		static_cast<float>(cells[1][1] - cells[0][1] + 1) *
+		static_cast<float>(cells[1][2] - cells[0][2] + 1);
+}
+
+CStimResponseBroadphase::CStimResponseBroadphase() :
+	m_QueryCount(0),
+	m_NeedsRebuild(true)
+{}
+
+void CStimResponseBroadphase::Clear()
+{
+	m_Responders.Clear();
+	m_Active.Clear();
+	m_Dirty.Clear();
+	m_Links.Clear();
+	m_FreeLinks.Clear();
+	m_CellHash.Free();
+	m_Types.Clear();
+	m_TypeHash.Free();
+	m_QueryCount = 0;
+	m_NeedsRebuild = true;
+}
+
+void CStimResponseBroadphase::Invalidate()
+{
+	m_NeedsRebuild = true;
+}
+
+void CStimResponseBroadphase::MarkDirty(idEntity* ent)
+{
+	// Everything is collected again anyway
+	if (m_NeedsRebuild || ent == NULL) return;
+
+	Responder& responder = m_Responders[ent->entityNumber];
+
+	if (!responder.dirty)
+	{
+		responder.dirty = true;
+		m_Dirty.Append(ent->entityNumber);
+	}
+}
+
+void CStimResponseBroadphase::Update()
+{
+	if (m_NeedsRebuild)
+	{
+		Rebuild();
+	}
+
+	for (int i = 0; i < m_Dirty.Num(); i++)
+	{
+		RefreshTypes(m_Dirty[i]);
+	}
+
+	m_Dirty.Clear();
+
+	// Relink the responders that moved into other cells. Walk backwards, removed
+	// entities drop out of m_Active.
+	for (int i = m_Active.Num() - 1; i >= 0; i--)
+	{
+		int entityNum = m_Active[i];
+		Responder& responder = m_Responders[entityNum];
+		idEntity* ent = responder.entity.GetEntity();
+
+		if (ent == NULL)
+		{
+			// The entity has been removed
+			RefreshTypes(entityNum);
+			continue;
+		}
+
+		int cells[2][3];
+		GetResponderCells(ent, cells);
+
+		if (memcmp(cells, responder.cells, sizeof(cells)) != 0)
+		{
+			Unlink(entityNum);
+			Link(entityNum, cells);
+		}
+	}
+}
+
+int CStimResponseBroadphase::EntitiesTouchingBounds(StimType type, const idBounds& bounds, idEntity** entityList, int maxCount)
+{
+	if (m_NeedsRebuild)
+	{
+		Update();
+	}
+
+	TypeIndex* typeIndex = FindType(type);
+
+	if (typeIndex == NULL)
+	{
+		return 0; // nobody responds to this type
+	}
+
+	// Same tolerance as idClip::ClipModelsTouchingBounds
+	idBounds expanded(bounds);
+	expanded.ExpandSelf(CM_BOX_EPSILON);
+
+	m_QueryCount++;
+
+	int count = 0;
+	int cells[2][3];
+	GetCellRange(expanded, cells);
+
+	float numCells = CountCells(cells);
+
+	if (numCells > SR_MAX_QUERY_CELLS)
+	{
+		// Large stim, cheaper to test all responders of this type
+		for (int i = 0; i < typeIndex->responders.Num(); i++)
+		{
+			if (!AddCandidate(typeIndex->responders[i], expanded, entityList, count, maxCount))
+			{
+				return count;
+			}
+		}
+
+		return count;
+	}
+
+	for (int i = 0; i < typeIndex->oversized.Num(); i++)
+	{
+		if (!AddCandidate(typeIndex->oversized[i], expanded, entityList, count, maxCount))
+		{
+			return count;
+		}
+	}
+
+	for (int x = cells[0][0]; x <= cells[1][0]; x++)
+	{
+		for (int y = cells[0][1]; y <= cells[1][1]; y++)
+		{
+			for (int z = cells[0][2]; z <= cells[1][2]; z++)
+			{
+				int key = CellHashKey(type, x, y, z);
+
+				for (int l = m_CellHash.First(key); l != -1; l = m_CellHash.Next(l))
+				{
+					const CellLink& link = m_Links[l];
+
+					// Different cell or type with the same hash key
+					if (link.type != type || link.cell[0] != x || link.cell[1] != y || link.cell[2] != z)
+					{
+						continue;
+					}
+
+					if (!AddCandidate(link.responder, expanded, entityList, count, maxCount))
+					{
+						return count;
+					}
+				}
+			}
+		}
+	}
+
+	return count;
+}
+
+void CStimResponseBroadphase::Rebuild()
+{
+	Clear();
+
+	m_NeedsRebuild = false;
+	m_Responders.SetNum(MAX_GENTITIES);
+
+	for (int i = 0; i < gameLocal.m_RespEntity.Num(); i++)
+	{
+		MarkDirty(gameLocal.m_RespEntity[i].GetEntity());
+	}
+
+	// Shooters react to their required stim without having a response
+	for (idEntity* ent = gameLocal.spawnedEntities.Next(); ent != NULL; ent = ent->spawnNode.Next())
+	{
+		if (ent->IsType(tdmFuncShooter::Type))
+		{
+			MarkDirty(ent);
+		}
+	}
+}
+
+void CStimResponseBroadphase::RefreshTypes(int entityNum)
+{
+	Responder& responder = m_Responders[entityNum];
+
+	responder.dirty = false;
+
+	Unlink(entityNum);
+
+	for (int i = 0; i < responder.types.Num(); i++)
+	{
+		TypeIndex* typeIndex = FindType(responder.types[i]);
+		assert(typeIndex != NULL);
+
+		typeIndex->responders.Remove(entityNum);
+	}
+
+	responder.types.Clear();
+
+	idEntity* ent = gameLocal.entities[entityNum];
+
+	if (ent != NULL)
+	{
+		CStimResponseCollection* srColl = ent->GetStimResponseCollection();
+
+		for (int i = 0; i < srColl->GetNumResponses(); i++)
+		{
+			responder.types.AddUnique(srColl->GetResponse(i)->m_StimTypeId);
+		}
+
+		if (ent->IsType(tdmFuncShooter::Type))
+		{
+			StimType requiredStim = static_cast<tdmFuncShooter*>(ent)->GetRequiredStim();
+
+			if (requiredStim != ST_DEFAULT)
+			{
+				responder.types.AddUnique(requiredStim);
+			}
+		}
+	}
+
+	if (responder.types.Num() == 0)
+	{
+		// Nothing to respond with (anymore)
+		responder.entity = NULL;
+
+		if (responder.active)
+		{
+			m_Active.Remove(entityNum);
+			responder.active = false;
+		}
+
+		return;
+	}
+
+	responder.entity = ent;
+
+	if (!responder.active)
+	{
+		m_Active.Append(entityNum);
+		responder.active = true;
+	}
+
+	for (int i = 0; i < responder.types.Num(); i++)
+	{
+		FindOrAddType(responder.types[i]).responders.Append(entityNum);
+	}
+
+	int cells[2][3];
+	GetResponderCells(ent, cells);
+
+	Link(entityNum, cells);
+}
+
+void CStimResponseBroadphase::Link(int entityNum, const int cells[2][3])
+{
+	Responder& responder = m_Responders[entityNum];
+
+	assert(!responder.linked);
+
+	memcpy(responder.cells, cells, sizeof(responder.cells));
+
+	if (cells[0][0] > cells[1][0])
+	{
+		return; // no CONTENTS_RESPONSE clip model linked
+	}
+
+	responder.linked = true;
+
+	float numCells = CountCells(cells);
+
+	responder.oversized = (numCells > SR_MAX_RESPONDER_CELLS);
+
+	for (int i = 0; i < responder.types.Num(); i++)
+	{
+		int type = responder.types[i];
+
+		if (responder.oversized)
+		{
+			FindOrAddType(type).oversized.Append(entityNum);
+			continue;
+		}
+
+		for (int x = cells[0][0]; x <= cells[1][0]; x++)
+		{
+			for (int y = cells[0][1]; y <= cells[1][1]; y++)
+			{
+				for (int z = cells[0][2]; z <= cells[1][2]; z++)
+				{
+					int index;
+
+					if (m_FreeLinks.Num() > 0)
+					{
+						index = m_FreeLinks[m_FreeLinks.Num() - 1];
+						m_FreeLinks.RemoveIndex(m_FreeLinks.Num() - 1);
+					}
+					else
+					{
+						index = m_Links.Append(CellLink());
+					}
+
+					CellLink& link = m_Links[index];
+
+					link.responder = entityNum;
+					link.type = type;
+					link.cell[0] = x;
+					link.cell[1] = y;
+					link.cell[2] = z;
+					link.hashKey = CellHashKey(type, x, y, z);
+
+					m_CellHash.Add(link.hashKey, index);
+					responder.links.Append(index);
+				}
+			}
+		}
+	}
+}
+
+void CStimResponseBroadphase::Unlink(int entityNum)
+{
+	Responder& responder = m_Responders[entityNum];
+
+	if (!responder.linked)
+	{
+		return;
+	}
+
+	for (int i = 0; i < responder.links.Num(); i++)
+	{
+		int index = responder.links[i];
+
+		m_CellHash.Remove(m_Links[index].hashKey, index);
+		m_FreeLinks.Append(index);
+	}
+
+	responder.links.Clear();
+
+	if (responder.oversized)
+	{
+		for (int i = 0; i < responder.types.Num(); i++)
+		{
+			TypeIndex* typeIndex = FindType(responder.types[i]);
+			assert(typeIndex != NULL);
+
+			typeIndex->oversized.Remove(entityNum);
+		}
+
+		responder.oversized = false;
+	}
+
+	responder.linked = false;
+}
+
+bool CStimResponseBroadphase::AddCandidate(int entityNum, const idBounds& bounds, idEntity** entityList, int& count, int maxCount)
+{
+	Responder& responder = m_Responders[entityNum];
+
+	if (responder.queryCount == m_QueryCount)
+	{
+		return true; // already tested in this query
+	}
+
+	responder.queryCount = m_QueryCount;
+
+	idEntity* ent = responder.entity.GetEntity();
+
+	if (ent == NULL || !TouchesBounds(ent, bounds))
+	{
+		return true;
+	}
+
+	if (count >= maxCount)
+	{
+		gameLocal.Warning("CStimResponseBroadphase::EntitiesTouchingBounds: max count (%i) reached.", maxCount);
+		return false;
+	}
+
+	entityList[count++] = ent;
+
+	return true;
+}
+
+CStimResponseBroadphase::TypeIndex* CStimResponseBroadphase::FindType(int type)
+{
+	for (int i = m_TypeHash.First(type); i != -1; i = m_TypeHash.Next(i))
+	{
+		if (m_Types[i].type == type)
+		{
+			return &m_Types[i];
+		}
+	}
+
+	return NULL;
+}
+
+CStimResponseBroadphase::TypeIndex& CStimResponseBroadphase::FindOrAddType(int type)
+{
+	TypeIndex* typeIndex = FindType(type);
+
+	if (typeIndex != NULL)
+	{
+		return *typeIndex;
+	}
+
+	int index = m_Types.Append(TypeIndex());
+	m_Types[index].type = type;
+	m_TypeHash.Add(type, index);
+
+	return m_Types[index];
+}
+
+int CStimResponseBroadphase::CellHashKey(int type, int x, int y, int z)
+{
+	return static_cast<int>(static_cast<unsigned int>(type) * 2654435761u ^
+		static_cast<unsigned int>(x) * 73856093u ^
+		static_cast<unsigned int>(y) * 19349663u ^
+		static_cast<unsigned int>(z) * 83492791u);
+}
+
+void CStimResponseBroadphase::GetCellRange(const idBounds& bounds, int cells[2][3])
+{
+	for (int i = 0; i < 3; i++)
+	{
+		cells[0][i] = static_cast<int>(idMath::Floor(bounds[0][i] / SR_CELL_SIZE));
+		cells[1][i] = static_cast<int>(idMath::Floor(bounds[1][i] / SR_CELL_SIZE));
+	}
+}
+
+// The clip models idClip::EntitiesTouchingBounds(..., CONTENTS_RESPONSE, ...) would find this entity by
+static bool IsResponseClipModel(const idClipModel* clipModel, const idEntity* ent)
+{
+	return clipModel != NULL && clipModel->IsLinked() && clipModel->IsEnabled() &&
+		(clipModel->GetContents() & CONTENTS_RESPONSE) && clipModel->GetEntity() == ent;
+}
+
+// Heads get their CONTENTS_RESPONSE on the combat model
+static idClipModel* GetResponseCombatModel(idEntity* ent)
+{
+	return ent->IsType(idAFAttachment::Type) ? static_cast<idAFAttachment*>(ent)->GetCombatModel() : NULL;
+}
+
+void CStimResponseBroadphase::GetResponderCells(idEntity* ent, int cells[2][3])
+{
+	idBounds bounds;
+	bounds.Clear();
+
+	idPhysics* physics = ent->GetPhysics();
+
+	for (int i = 0; i < physics->GetNumClipModels(); i++)
+	{
+		idClipModel* clipModel = physics->GetClipModel(i);
+
+		if (IsResponseClipModel(clipModel, ent))
+		{
+			bounds.AddBounds(clipModel->GetAbsBounds());
+		}
+	}
+
+	idClipModel* combatModel = GetResponseCombatModel(ent);
+
+	if (IsResponseClipModel(combatModel, ent))
+	{
+		bounds.AddBounds(combatModel->GetAbsBounds());
+	}
+
+	if (bounds.IsCleared())
+	{
+		// Empty range
+		cells[0][0] = cells[0][1] = cells[0][2] = 0;
+		cells[1][0] = cells[1][1] = cells[1][2] = -1;
+		return;
+	}
+
+	GetCellRange(bounds, cells);
+}
+
+bool CStimResponseBroadphase::TouchesBounds(idEntity* ent, const idBounds& bounds)
+{
+	idPhysics* physics = ent->GetPhysics();
+
+	for (int i = 0; i < physics->GetNumClipModels(); i++)
+	{
+		idClipModel* clipModel = physics->GetClipModel(i);
+
+		if (IsResponseClipModel(clipModel, ent) && clipModel->GetAbsBounds().IntersectsBounds(bounds))
+		{
+			return true;
+		}
+	}
+
+	idClipModel* combatModel = GetResponseCombatModel(ent);
+
+	return IsResponseClipModel(combatModel, ent) && combatModel->GetAbsBounds().IntersectsBounds(bounds);
+}
@@ -0,0 +1,146 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+#ifndef SR_STIMRESPONSEBROADPHASE__H
+#define SR_STIMRESPONSEBROADPHASE__H
+
+#include "StimType.h"
+
+class idEntity;
+
+/**
+ * The broadphase of the radius based stims (idGameLocal::ProcessStimResponse).
+ *
+ * Every entity that can respond (it has a CResponse or is a tdmFuncShooter waiting
+ * for a stim) is linked into a hashed uniform grid once per stim type it responds to,
+ * using the bounds of its CONTENTS_RESPONSE clip models. A stim only looks at the cells
+ * of its own type, so entities without a matching response are never tested. The grid
+ * is updated incrementally: a responder is relinked only if it moved into other cells.
+ *
+ * EntitiesTouchingBounds() returns the same entities as
+ * idClip::EntitiesTouchingBounds(bounds, CONTENTS_RESPONSE, ...) minus those that
+ * can't respond to the given type anyway.
+ */
+class CStimResponseBroadphase
+{
+private:
+	struct Responder
+	{
+		idEntityPtr<idEntity>	entity;
+		idList<int>				types;		// the stim types this entity responds to
+		idList<int>				links;		// indices into m_Links
+		int						cells[2][3];// the cell range it is linked into
+		bool					linked;
+		bool					oversized;	// too large for the grid, always tested
+		bool					dirty;		// the types need to be refreshed
+		int						queryCount;	// avoids duplicates in a query
+		bool					active;		// listed in m_Active
+
+		Responder() :
+			linked(false),
+			oversized(false),
+			dirty(false),
+			queryCount(0),
+			active(false)
+		{}
+	};
+
+	// indexed by entity number
+	idList<Responder>		m_Responders;
+
+	// the entity numbers of all responders
+	idList<int>				m_Active;
+
+	// the entity numbers of responders whose types changed
+	idList<int>				m_Dirty;
+
+	struct CellLink
+	{
+		int		responder;
+		int		type;
+		int		cell[3];
+		int		hashKey;
+	};
+
+	idList<CellLink>		m_Links;
+	idList<int>				m_FreeLinks;
+	idHashIndex				m_CellHash;
+
+	struct TypeIndex
+	{
+		int				type;
+		idList<int>		responders;	// all responders of this type
+		idList<int>		oversized;	// the responders of this type not in the grid
+	};
+
+	idList<TypeIndex>		m_Types;
+	idHashIndex				m_TypeHash;
+
+	int						m_QueryCount;
+
+	// the responders are collected again on the next Update()
+	bool					m_NeedsRebuild;
+
+public:
+	CStimResponseBroadphase();
+
+	void Clear();
+
+	/**
+	 * Forgets all responders, they are collected again from gameLocal.m_RespEntity
+	 * on the next Update().
+	 */
+	void Invalidate();
+
+	/**
+	 * Tells the broadphase that the responses of the given entity changed (or that it
+	 * is about to be removed).
+	 */
+	void MarkDirty(idEntity* ent);
+
+	/**
+	 * Refreshes the responders marked dirty and relinks those that moved, call once per
+	 * frame before the stims are processed.
+	 */
+	void Update();
+
+	/**
+	 * The entities with a response to the given stim type (or a tdmFuncShooter waiting
+	 * for it) that have a CONTENTS_RESPONSE clip model touching the bounds.
+	 */
+	int EntitiesTouchingBounds(StimType type, const idBounds& bounds, idEntity** entityList, int maxCount);
+
+private:
+	void Rebuild();
+	void RefreshTypes(int entityNum);
+
+	void Link(int entityNum, const int cells[2][3]);
+	void Unlink(int entityNum);
+
+	bool AddCandidate(int entityNum, const idBounds& bounds, idEntity** entityList, int& count, int maxCount);
+
+	TypeIndex* FindType(int type);
+	TypeIndex& FindOrAddType(int type);
+
+	static int CellHashKey(int type, int x, int y, int z);
+	static void GetCellRange(const idBounds& bounds, int cells[2][3]);
+	static void GetResponderCells(idEntity* ent, int cells[2][3]);
+	static bool TouchesBounds(idEntity* ent, const idBounds& bounds);
+};
+
+#endif /* SR_STIMRESPONSEBROADPHASE__H */
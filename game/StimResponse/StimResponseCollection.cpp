@@ -31,6 +31,8 @@ CStimResponseCollection::~CStimResponseCollection()
 
 void CStimResponseCollection::Save(idSaveGame *savefile) const
 {
+	idSaveGameProfileScope profile(savefile, "CStimResponseCollection");
+
 	savefile->WriteInt(m_Stims.Num());
 	for (int i = 0; i < m_Stims.Num(); i++)
 	{
@@ -48,6 +50,8 @@ void CStimResponseCollection::Save(idSaveGame *savefile) const
 
 void CStimResponseCollection::Restore(idRestoreGame *savefile)
 {
+	idSaveGameProfileScope profile(savefile, "CStimResponseCollection");
+
 	int num;
 
 	savefile->ReadInt(num);
@@ -281,6 +285,11 @@ int CStimResponseCollection::RemoveResponse(StimType type)
 		}
 	}
 
+	if (owner != NULL)
+	{
+		gameLocal.m_StimResponseBroadphase.MarkDirty(owner);
+	}
+
 	// Remove the CONTENTS_RESPONSE flag if no more responses
 	if (m_Responses.Num() <= 0 && owner != NULL)
 	{
@@ -0,0 +1,258 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+#include "precompiled_game.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "StimResponseProfiler.h"
+#include "StimResponse.h"
+
+// The number of entries drawn in the HUD
+static const int SR_PROFILE_HUD_ENTRIES = 16;
+
+void CStimResponseProfiler::Counters::Clear()
+{
+	stims = 0;
+	queries = 0;
+	responses = 0;
+	time = 0;
+	responseTime = 0;
+}
+
+void CStimResponseProfiler::Counters::Add(const Counters& other)
+{
+	stims += other.stims;
+	queries += other.queries;
+	responses += other.responses;
+	time += other.time;
+	responseTime += other.responseTime;
+}
+
+void CStimResponseProfiler::Counters::Subtract(const Counters& other)
+{
+	stims -= other.stims;
+	queries -= other.queries;
+	responses -= other.responses;
+	time -= other.time;
+	responseTime -= other.responseTime;
+}
+
+CStimResponseProfiler::CStimResponseProfiler()
+{
+	Clear();
+}
+
+void CStimResponseProfiler::Clear()
+{
+	m_Entries.Clear();
+	m_EntryHash.Free();
+
+	for (int i = 0; i < SR_PROFILE_FRAMES; i++)
+	{
+		m_Samples[i].Clear();
+		m_FrameTime[i] = 0;
+	}
+
+	m_Frame = 0;
+	m_NumFrames = 0;
+	m_TotalTime = 0;
+}
+
+bool CStimResponseProfiler::IsEnabled() const
+{
+	return cv_sr_profile.GetInteger() > 0;
+}
+
+void CStimResponseProfiler::BeginFrame()
+{
+	m_Frame++;
+
+	int slot = m_Frame % SR_PROFILE_FRAMES;
+
+	// Drop the oldest frame out of the window
+	idList<Sample>& samples = m_Samples[slot];
+
+	for (int i = 0; i < samples.Num(); i++)
+	{
+		m_Entries[samples[i].entry].total.Subtract(samples[i].counters);
+	}
+
+	samples.SetNum(0, false);
+
+	m_TotalTime -= m_FrameTime[slot];
+	m_FrameTime[slot] = 0;
+
+	if (m_NumFrames < SR_PROFILE_FRAMES)
+	{
+		m_NumFrames++;
+	}
+}
+
+void CStimResponseProfiler::AddStim(idEntity* owner, StimType type, bool queried, int numResponses, double time, double responseTime)
+{
+	int slot = m_Frame % SR_PROFILE_FRAMES;
+	int entryIndex = FindOrAddEntry(type, owner->GetEntityDefName());
+	Entry& entry = m_Entries[entryIndex];
+
+	// One sample per entry and frame
+	if (entry.sampleFrame != m_Frame)
+	{
+		Sample sample;
+		sample.entry = entryIndex;
+		sample.counters.Clear();
+
+		entry.sampleFrame = m_Frame;
+		entry.sampleIndex = m_Samples[slot].Append(sample);
+	}
+
+	Counters counters;
+	counters.stims = 1;
+	counters.queries = queried ? 1 : 0;
+	counters.responses = numResponses;
+	counters.time = time;
+	counters.responseTime = responseTime;
+
+	m_Samples[slot][entry.sampleIndex].counters.Add(counters);
+	entry.total.Add(counters);
+}
+
+void CStimResponseProfiler::EndFrame(double time)
+{
+	m_FrameTime[m_Frame % SR_PROFILE_FRAMES] = time;
+	m_TotalTime += time;
+}
+
+void CStimResponseProfiler::Print() const
+{
+	idList<const Entry*> entries;
+	GetSortedEntries(entries);
+
+	gameLocal.Printf("Stim/response costs over the last %d frames, ProcessStimResponse took %.3f msec (%.3f msec per frame)\n",
+		m_NumFrames, m_TotalTime, m_NumFrames > 0 ? m_TotalTime / m_NumFrames : 0.0);
+	gameLocal.Printf("%-20s %-40s %7s %7s %9s %10s %10s\n", "Stim", "Owner class", "Stims", "Queries", "Responses", "Time", "Resp. time");
+
+	Counters sum;
+	sum.Clear();
+
+	for (int i = 0; i < entries.Num(); i++)
+	{
+		const Entry& entry = *entries[i];
+
+		if (entry.total.stims == 0)
+		{
+			continue; // dropped out of the window
+		}
+
+		gameLocal.Printf("%-20s %-40s %7d %7d %9d %10.3f %10.3f\n", GetTypeName(entry.type), entry.className.c_str(),
+			entry.total.stims, entry.total.queries, entry.total.responses, entry.total.time, entry.total.responseTime);
+
+		sum.Add(entry.total);
+	}
+
+	gameLocal.Printf("%-20s %-40s %7d %7d %9d %10.3f %10.3f\n", "Total", "",
+		sum.stims, sum.queries, sum.responses, sum.time, sum.responseTime);
+}
+
+void CStimResponseProfiler::DrawHUD() const
+{
+	idList<const Entry*> entries;
+	GetSortedEntries(entries);
+
+	const idMaterial* charSet = declManager->FindMaterial("textures/bigchars");
+	int y = 100;
+
+	renderSystem->DrawSmallStringExt(1, y, va("S/R: %.3f msec per frame (%d frames)",
+		m_NumFrames > 0 ? m_TotalTime / m_NumFrames : 0.0, m_NumFrames), colorWhite, false, charSet);
+	y += 12;
+
+	for (int i = 0, drawn = 0; i < entries.Num() && drawn < SR_PROFILE_HUD_ENTRIES; i++)
+	{
+		const Entry& entry = *entries[i];
+
+		if (entry.total.stims == 0)
+		{
+			continue;
+		}
+
+		renderSystem->DrawSmallStringExt(1, y, va("%s %s: %d stims %d queries %d resp %.3f ms (%.3f resp)",
+			GetTypeName(entry.type), entry.className.c_str(), entry.total.stims, entry.total.queries,
+			entry.total.responses, entry.total.time, entry.total.responseTime), colorWhite, false, charSet);
+		y += 12;
+		drawn++;
+	}
+}
+
+int CStimResponseProfiler::FindOrAddEntry(int type, const char* className)
+{
+	int key = m_EntryHash.GenerateKey(className, false) ^ type;
+
+	for (int i = m_EntryHash.First(key); i != -1; i = m_EntryHash.Next(i))
+	{
+		if (m_Entries[i].type == type && m_Entries[i].className == className)
+		{
+			return i;
+		}
+	}
+
+	Entry entry;
+	entry.type = type;
+	entry.className = className;
+	entry.total.Clear();
+	entry.sampleFrame = -1;
+	entry.sampleIndex = -1;
+
+	int index = m_Entries.Append(entry);
+	m_EntryHash.Add(key, index);
+
+	return index;
+}
+
+void CStimResponseProfiler::GetSortedEntries(idList<const Entry*>& entries) const
+{
+	entries.SetNum(m_Entries.Num());
+
+	for (int i = 0; i < m_Entries.Num(); i++)
+	{
+		entries[i] = &m_Entries[i];
+	}
+
+	entries.Sort(SortByTime);
+}
+
+const char* CStimResponseProfiler::GetTypeName(int type)
+{
+	for (int i = 0; cStimType[i] != NULL; i++)
+	{
+		if (i == type)
+		{
+			return cStimType[i];
+		}
+	}
+
+	return va("%d", type); // user defined
+}
+
+int CStimResponseProfiler::SortByTime(const Entry* const* a, const Entry* const* b)
+{
+	if ((*a)->total.time > (*b)->total.time) return -1;
+	if ((*a)->total.time < (*b)->total.time) return 1;
+
+	return 0;
+}
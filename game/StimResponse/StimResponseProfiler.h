@@ -0,0 +1,110 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+#ifndef SR_STIMRESPONSEPROFILER__H
+#define SR_STIMRESPONSEPROFILER__H
+
+#include "StimType.h"
+
+class idEntity;
+
+// The number of game frames the profiler sums up
+#define SR_PROFILE_FRAMES	60
+
+/**
+ * Collects what idGameLocal::ProcessStimResponse spends per stim type and class of the
+ * stim owner (its entityDef) over the last SR_PROFILE_FRAMES game frames. Enabled by
+ * tdm_sr_profile, printed by tdm_sr_profile_print and drawn in the HUD at
+ * tdm_sr_profile 2.
+ */
+class CStimResponseProfiler
+{
+public:
+	struct Counters
+	{
+		int		stims;			// stims evaluated
+		int		queries;		// bounds queries issued
+		int		responses;		// responses fired
+		double	time;			// msecs spent on the stims, including DoResponseAction
+		double	responseTime;	// msecs spent in DoResponseAction
+
+		void Clear();
+		void Add(const Counters& other);
+		void Subtract(const Counters& other);
+	};
+
+private:
+	struct Entry
+	{
+		int			type;
+		idStr		className;
+		Counters	total;			// over the window
+		int			sampleFrame;	// the frame of the last sample
+		int			sampleIndex;	// its index in m_Samples[]
+	};
+
+	idList<Entry>			m_Entries;
+	idHashIndex				m_EntryHash;
+
+	struct Sample
+	{
+		int			entry;
+		Counters	counters;
+	};
+
+	// The samples of each frame in the window
+	idList<Sample>			m_Samples[SR_PROFILE_FRAMES];
+	double					m_FrameTime[SR_PROFILE_FRAMES];
+
+	int						m_Frame;		// counts up, m_Frame % SR_PROFILE_FRAMES is the current slot
+	int						m_NumFrames;	// the number of frames in the window so far
+	double					m_TotalTime;	// msecs spent in ProcessStimResponse over the window
+
+public:
+	CStimResponseProfiler();
+
+	void Clear();
+
+	bool IsEnabled() const;
+
+	// Starts a new frame, dropping the oldest one out of the window
+	void BeginFrame();
+
+	// Records one evaluated stim
+	void AddStim(idEntity* owner, StimType type, bool queried, int numResponses, double time, double responseTime);
+
+	// Records the time of the whole ProcessStimResponse call
+	void EndFrame(double time);
+
+	// Prints the entries sorted by time to the console
+	void Print() const;
+
+	// Draws the most expensive entries on screen
+	void DrawHUD() const;
+
+private:
+	int FindOrAddEntry(int type, const char* className);
+
+	// The entries sorted by time, most expensive first
+	void GetSortedEntries(idList<const Entry*>& entries) const;
+
+	static const char* GetTypeName(int type);
+	static int SortByTime(const Entry* const* a, const Entry* const* b);
+};
+
+#endif /* SR_STIMRESPONSEPROFILER__H */
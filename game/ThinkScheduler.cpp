@@ -0,0 +1,242 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+#include "precompiled_game.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "ThinkScheduler.h"
+#include "Game_local.h"
+
+CThinkScheduler::CThinkScheduler()
+{
+	Clear();
+}
+
+void CThinkScheduler::Clear()
+{
+	_numThinks = 0;
+	_numSkipped = 0;
+	_numLODWaits = 0;
+
+	memset(_aiThinks, 0, sizeof(_aiThinks));
+	_aiFrame = 0;
+	_aiThinkTicks = 0;
+	_aiThinkMsec = 0.0f;
+	_aiIntervalScale = 1.0f;
+}
+
+void CThinkScheduler::BeginFrame()
+{
+	_aiThinkMsec = static_cast<float>(_aiThinkTicks * 1000.0 / sys->ClockTicksPerSecond());
+	_aiThinkTicks = 0;
+
+	// Stretch the AI intervals in small steps while the AI are over budget,
+	// and go back once they are well below it
+	float budget = cv_think_ai_budget.GetFloat();
+
+	if (budget <= 0)
+	{
+		_aiIntervalScale = 1.0f;
+	}
+	else if (_aiThinkMsec > budget)
+	{
+		_aiIntervalScale = Min(_aiIntervalScale * 1.1f, 2.0f);
+	}
+	else if (_aiThinkMsec < budget * 0.75f)
+	{
+		_aiIntervalScale = Max(_aiIntervalScale / 1.1f, 1.0f);
+	}
+
+	AdvanceAIFrames();
+
+	if (cv_think_scheduler_show.GetBool() && (_numThinks > 0 || _numSkipped > 0))
+	{
+		gameLocal.Printf("Think scheduler: %d entities thought, %d skipped (%d waiting for their LOD check), AI %.2f ms, AI interval x%.2f\n", 
+			_numThinks, _numSkipped, _numLODWaits, _aiThinkMsec, _aiIntervalScale);
+	}
+
+	_numThinks = 0;
+	_numSkipped = 0;
+	_numLODWaits = 0;
+}
+
+void CThinkScheduler::AdvanceAIFrames()
+{
+	int passed = gameLocal.framenum - _aiFrame;
+
+	if (passed < 0 || passed >= AI_THINK_FRAMES)
+	{
+		memset(_aiThinks, 0, sizeof(_aiThinks));
+	}
+	else
+	{
+		for (int frame = _aiFrame; frame < gameLocal.framenum; frame++)
+		{
+			_aiThinks[frame & (AI_THINK_FRAMES - 1)] = 0;
+		}
+	}
+
+	_aiFrame = gameLocal.framenum;
+}
+
+int CThinkScheduler::ScheduleAIThink(idAI* ai, int thinkDelta)
+{
+	int frameNum = gameLocal.framenum;
+
+	AdvanceAIFrames();
+
+	// The AI is moved from the frame it was going to think in, AI in the PVS think before it
+	int pending = ai->m_nextThinkFrame - frameNum;
+	int& pendingThinks = _aiThinks[ai->m_nextThinkFrame & (AI_THINK_FRAMES - 1)];
+
+	if (pending > 0 && pending < AI_THINK_FRAMES && pendingThinks > 0)
+	{
+		pendingThinks--;
+	}
+
+	// Alerted AI and those the player might see never think later than they asked for
+	bool priority = (thinkDelta > 1) && ((ai->AI_AlertIndex >= ai::ESuspicious) || gameLocal.InPlayerPVS(ai));
+	int delta = thinkDelta;
+
+	if (!priority && delta > 1)
+	{
+		delta = static_cast<int>(delta * _aiIntervalScale + 0.5f);
+	}
+
+	delta = idMath::ClampInt(1, AI_THINK_FRAMES - 1, delta);
+
+	if (cv_think_ai_balance.GetBool() && delta > 1)
+	{
+		// Look for the least busy frame within a quarter of the interval,
+		// the closest one to the interval if several are equally busy
+		int first = Max(delta - delta / 4, 1);
+		int last = priority ? delta : Min(delta + delta / 4, AI_THINK_FRAMES - 1);
+		int best = delta;
+		int bestThinks = _aiThinks[(frameNum + delta) & (AI_THINK_FRAMES - 1)];
+
+		for (int d = first; d <= last; d++)
+		{
+			int thinks = _aiThinks[(frameNum + d) & (AI_THINK_FRAMES - 1)];
+
+			if (thinks < bestThinks || (thinks == bestThinks && abs(d - delta) < abs(best - delta)))
+			{
+				best = d;
+				bestThinks = thinks;
+			}
+		}
+
+		delta = best;
+	}
+
+	_aiThinks[(frameNum + delta) & (AI_THINK_FRAMES - 1)]++;
+
+	return frameNum + delta;
+}
+
+bool CThinkScheduler::ShouldThink(idEntity* ent)
+{
+	if (cv_think_scheduler.GetBool() && ent->ThinksOnlyForLOD() && !ent->LODCheckDue())
+	{
+		_numSkipped++;
+		_numLODWaits++;
+		return false;
+	}
+
+	if (!cv_think_scheduler.GetBool() || ent->m_MaxThinkInterleave <= 1)
+	{
+		_numThinks++;
+		return true;
+	}
+
+	if (gameLocal.framenum < ent->m_ScheduledThinkFrame)
+	{
+		// Everything the player might see thinks every frame
+		if (!gameLocal.InPlayerPVS(ent))
+		{
+			_numSkipped++;
+			return false;
+		}
+	}
+
+	ent->m_ScheduledThinkFrame = gameLocal.framenum + GetThinkInterleave(ent);
+
+	_numThinks++;
+	return true;
+}
+
+bool CThinkScheduler::WillThink(idEntity* ent) const
+{
+	if (cv_think_scheduler.GetBool() && ent->ThinksOnlyForLOD() && !ent->LODCheckDue())
+	{
+		return false;
+	}
+
+	if (!cv_think_scheduler.GetBool() || ent->m_MaxThinkInterleave <= 1)
+	{
+		return true;
+	}
+
+	return gameLocal.framenum >= ent->m_ScheduledThinkFrame || gameLocal.InPlayerPVS(ent);
+}
+
+int CThinkScheduler::GetThinkInterleave(idEntity* ent) const
+{
+	idPlayer* player = gameLocal.GetLocalPlayer();
+	if (player == NULL)
+	{
+		return 1;
+	}
+
+	float minDist = cv_think_interleave_mindist.GetFloat();
+	float maxDist = cv_think_interleave_maxdist.GetFloat();
+	int maxFrames = ent->m_MaxThinkInterleave;
+
+	if (maxDist <= minDist)
+	{
+		return maxFrames;
+	}
+
+	float playerDist = (ent->GetPhysics()->GetOrigin() - player->GetPhysics()->GetOrigin()).LengthFast();
+
+	if (playerDist < minDist)
+	{
+		return 1;
+	}
+	else if (playerDist > maxDist)
+	{
+		return maxFrames;
+	}
+
+	// The frames between thinks increase linearly between min and max dist
+	float fraction = (playerDist - minDist) / (maxDist - minDist);
+
+	return 1 + static_cast<int>(fraction * (maxFrames - 1));
+}
+
+CAIThinkTiming::CAIThinkTiming()
+{
+	_start = sys->GetClockTicks();
+}
+
+CAIThinkTiming::~CAIThinkTiming()
+{
+	gameLocal.m_ThinkScheduler.AddAIThinkTime(sys->GetClockTicks() - _start);
+}
@@ -0,0 +1,103 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+#ifndef __THINK_SCHEDULER_H__
+#define __THINK_SCHEDULER_H__
+
+class idEntity;
+class idAI;
+
+/**
+ * Decides which of the active entities think in a frame. Entities of the classes that
+ * allow it (idEntity::DefaultMaxThinkInterleave) think only once every few frames when they are
+ * outside the player PVS, more rarely the farther they are from the player, like the
+ * interleaved thinking of the AI (idAI::GetThinkInterleave). Their physics and animations
+ * are evaluated at the absolute game time, so a think after a pause catches up.
+ * Entities that are only active to check their LOD (idEntity::ThinksOnlyForLOD) don't
+ * think at all until their next distance check is due.
+ *
+ * The AI schedule their own interleaved thinking (idAI::SetNextThinkFrame), but take the
+ * frame of their next think from here: it is moved to the least busy frame close to the
+ * one they asked for, so the AI don't pile up in the same frames. When the AI together take
+ * longer than tdm_think_ai_budget to think in a frame, the AI that are not alerted and not
+ * in the player PVS get longer intervals until the time is back below the budget.
+ */
+class CThinkScheduler
+{
+private:
+	int		_numThinks;		// entities that thought this frame
+	int		_numSkipped;	// entities that were skipped this frame
+	int		_numLODWaits;	// entities that were skipped until their LOD check is due
+
+	enum { AI_THINK_FRAMES = 32 };	// power of two, longer AI intervals are clamped
+
+	int		_aiThinks[AI_THINK_FRAMES];	// AI scheduled for each of the next frames, by framenum & (AI_THINK_FRAMES-1)
+	int		_aiFrame;					// the frame _aiThinks was last cleaned up for
+	double	_aiThinkTicks;				// clock ticks the AI spent thinking this frame
+	float	_aiThinkMsec;				// time the AI spent thinking last frame
+	float	_aiIntervalScale;			// scale of the interleave of the AI without priority
+
+public:
+	CThinkScheduler();
+
+	void Clear();
+
+	// Call once per frame before the entities think
+	void BeginFrame();
+
+	// True if the entity should think in this frame, schedules its next think if so
+	bool ShouldThink(idEntity* ent);
+
+	// Same as ShouldThink, but doesn't schedule anything
+	bool WillThink(idEntity* ent) const;
+
+	/**
+	 * Returns the frame in which the AI should think next, close to thinkDelta frames
+	 * from now. Alerted AI and those in the player PVS never think later than that.
+	 */
+	int ScheduleAIThink(idAI* ai, int thinkDelta);
+
+	// Adds the clock ticks of an AI think to this frame's AI time
+	void AddAIThinkTime(double ticks) { _aiThinkTicks += ticks; }
+
+	int GetNumThinks() const { return _numThinks; }
+	int GetNumSkipped() const { return _numSkipped; }
+
+private:
+	// The number of frames until the entity should think again
+	int GetThinkInterleave(idEntity* ent) const;
+
+	// Drops the AI counts of the frames that have passed
+	void AdvanceAIFrames();
+};
+
+/**
+ * Measures the think of an AI for tdm_think_ai_budget, put it at the top of the think.
+ */
+class CAIThinkTiming
+{
+private:
+	double	_start;
+
+public:
+	CAIThinkTiming();
+	~CAIThinkTiming();
+};
+
+#endif /* __THINK_SCHEDULER_H__ */
@@ -51,6 +51,9 @@ idAASLocal::idAASLocal( void )
 {
 	elevatorSystem = new eas::tdmEAS(this);
 	file = NULL;
+	nextRouteQueryNum = 0;
+	routingCacheGeneration = 0;
+	ClearPortalRoutes();
 }
 
 /*
@@ -79,6 +82,7 @@ bool idAASLocal::Init( const idStr &mapName, const unsigned int mapFileCRC ) {
 	if ( file && mapName.Icmp( file->GetName() ) == 0 && mapFileCRC == file->GetCRC() ) {
 		common->Printf( "Keeping %s\n", file->GetName() );
 		RemoveAllObstacles();
+		ClearRouteQueries();
 	}
 	else {
 		Shutdown();
@@ -64,6 +64,14 @@ typedef struct aasGoal_s {
 } aasGoal_t;
 
 
+// result of a queued route query, see idAAS::QueueRouteQuery
+typedef struct aasRouteResult_s {
+	bool						found;			// true if there is a route
+	int							travelTime;		// travel time towards the goal area
+	idReachability *			reach;			// first reachability towards the goal area
+} aasRouteResult_t;
+
+
 typedef struct aasObstacle_s {
 	idBounds					absBounds;		// absolute bounds of obstacle
 	idBounds					expAbsBounds;	// expanded absolute bounds of obstacle
@@ -89,6 +97,9 @@ public:
 	virtual						~idAAS( void ) = 0;
 								// Initialize for the given map.
 	virtual bool				Init( const idStr &mapName, const unsigned int mapFileCRC ) = 0;
+								// Sets up the portal routing caches of walking AI after Init, returns the number of
+								// caches set up. Only touches this AAS, so all sizes can be set up concurrently.
+	virtual int					PrecomputeRoutingCache( void ) = 0;
 								// Print AAS stats.
 	virtual void				Stats( void ) const = 0;
 								// Test from the given origin.
@@ -171,6 +182,23 @@ public:
 	// Get the travel time and first reachability to be used towards the goal, returns true if there is a path.
 	virtual bool				RouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int &travelTime, idReachability **reach, CFrobDoor** firstDoor, idActor* actor ) const = 0;
 
+	/**
+	 * Queues a RouteToGoalArea, RunRouteQueries works the queue off within the next frames so
+	 * the routing caches of many new goals aren't all set up in the same frame.
+	 *
+	 * @returns the number of the query to poll for the result.
+	 */
+	virtual int					QueueRouteQuery( int areaNum, const idVec3 &origin, int goalAreaNum, int travelFlags, idActor* actor ) = 0;
+
+	// Returns TRUE and the result once the query is done, the query number is invalid afterwards.
+	virtual bool				PollRouteQuery( int queryNum, aasRouteResult_t &result ) = 0;
+
+	// Drops a query which is no longer needed.
+	virtual void				CancelRouteQuery( int queryNum ) = 0;
+
+	// Works off up to maxQueries of the queued route queries, oldest first. Call once per frame.
+	virtual void				RunRouteQueries( int maxQueries ) = 0;
+
 	/**
 	 * greebo: Tries to set up a walk path from areaNum/origin to goalAreaNum/goalOrigin for the given travel flags.
 	 *
@@ -91,6 +91,7 @@ public:
 	virtual bool				Init( const idStr &mapName, const unsigned int mapFileCRC );
 	virtual void				Shutdown( void );
 
+	virtual int					PrecomputeRoutingCache( void );
 	virtual void				Stats( void ) const;
 	virtual void				Test( const idVec3 &origin );
 	virtual const idAASSettings *GetSettings( void ) const;
@@ -113,6 +114,10 @@ public:
 	virtual void				RemoveAllObstacles( void );
 	virtual int					TravelTimeToGoalArea( int areaNum, const idVec3 &origin, int goalAreaNum, int travelFlags, idActor* actor ) const;
 	virtual bool				RouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int &travelTime, idReachability **reach, CFrobDoor** firstDoor, idActor* actor ) const;
+	virtual int					QueueRouteQuery( int areaNum, const idVec3 &origin, int goalAreaNum, int travelFlags, idActor* actor );
+	virtual bool				PollRouteQuery( int queryNum, aasRouteResult_t &result );
+	virtual void				CancelRouteQuery( int queryNum );
+	virtual void				RunRouteQueries( int maxQueries );
 	virtual bool				WalkPathToGoal( aasPath_t &path, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags, int &travelTime, idActor* actor ); // grayman #3548
 	virtual bool				WalkPathValid( int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags, idVec3 &endPos, int &endAreaNum, idActor* actor) const;
 	virtual bool				FlyPathToGoal( aasPath_t &path, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags, idActor* actor ) const; // grayman #4412
@@ -187,6 +192,10 @@ public:
 	void Save(idSaveGame* savefile) const;
 	void Restore(idRestoreGame* savefile);
 
+	// Prints the routing cache hits, misses and evictions per cluster
+	void						PrintRoutingCacheStats( void ) const;
+	void						ResetRoutingCacheStats( void );
+
 private:
 	idAASFile *					file;
 	idStr						name;
@@ -215,6 +224,56 @@ private:	// routing data
 
 	idList<idVec4>				aasColors;				// grayman #3032 - colors of AAS areas for debugging - no need to save/restore
 
+	typedef struct aasCacheStats_s {
+		int						hits;
+		int						misses;
+		int						evictions;
+	} aasCacheStats_t;
+
+	mutable idList<aasCacheStats_t>	clusterCacheStats;	// routing cache use per cluster, see aas_routingCacheStats
+
+	typedef struct routeQuery_s {
+		int						queryNum;
+		int						areaNum;
+		idVec3					origin;
+		int						goalAreaNum;
+		int						travelFlags;
+		idEntityPtr<idActor>	actor;
+		bool					hasActor;
+		int						doneTime;				// game time the query was done, -1 while queued
+		aasRouteResult_t		result;
+	} routeQuery_t;
+
+	idList<routeQuery_t>		routeQueries;			// queued and done route queries, not saved
+	int							nextRouteQueryNum;
+
+	// The portals of a cluster leading towards a goal area, shared by all routes from
+	// that cluster to the goal so AI heading to the same goal only look up their local part
+	typedef struct portalRouteStep_s {
+		int						portalNum;
+		int						portalAreaNum;
+		unsigned short			goalTravelTime;			// from the portal to the goal, including the time through the portal area
+		bool					leadsBack;				// the reachability from the portal towards the goal leads back into the cluster
+		idRoutingCache *		areaCache;				// travel times from the cluster areas to the portal area
+	} portalRouteStep_t;
+
+	typedef struct portalRoute_s {
+		int						clusterNum;				// -1 if unused
+		int						goalAreaNum;
+		int						travelFlags;
+		int						cacheGeneration;		// routingCacheGeneration the steps were set up with
+		idList<portalRouteStep_t> steps;
+	} portalRoute_t;
+
+	static const int			MAX_PORTAL_ROUTES = 64;
+
+	mutable portalRoute_t		portalRoutes[MAX_PORTAL_ROUTES];	// reused round robin, not saved
+	mutable idHashIndex			portalRouteHash;
+	mutable int					nextPortalRoute;
+	mutable int					routingCacheGeneration;	// increased whenever routing caches are deleted
+	mutable int					portalRouteHits;
+	mutable int					portalRouteMisses;
+
 private:	// routing
 	bool						SetupRouting( void );
 	void						ShutdownRouting( void );
@@ -222,6 +281,11 @@ private:	// routing
 	void						CalculateAreaTravelTimes( void );
 	void						DeleteAreaTravelTimes( void );
 	void						SetupRoutingCache( void );
+	int							PrecomputePortalRoutingCache( int travelFlags );
+	int							RoutingCacheMemory( void ) const;
+	void						ClearRouteQueries( void );
+	void						ClearPortalRoutes( void );
+	const portalRoute_t *		GetPortalRoute( int clusterNum, int goalAreaNum, int travelFlags, idRoutingCache *portalCache ) const;
 	void						DeleteClusterCache( int clusterNum );
 	void						DeletePortalCache( void );
 	void						ShutdownRoutingCache( void );
@@ -33,8 +33,6 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #define CACHETYPE_AREA				1
 #define CACHETYPE_PORTAL			2
 
-#define MAX_ROUTING_CACHE_MEMORY	(2*1024*1024)
-
 #define LEDGE_TRAVELTIME_PENALTY	250
 
 /*
@@ -252,6 +250,9 @@ void idAASLocal::SetupRoutingCache( void ) {
 
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
+
+	ClearPortalRoutes();
+	ResetRoutingCacheStats();
 }
 
 /*
@@ -263,6 +264,8 @@ void idAASLocal::DeleteClusterCache( int clusterNum ) {
 	int i;
 	idRoutingCache *cache;
 
+	routingCacheGeneration++;
+
 	for ( i = 0; i < file->GetCluster( clusterNum ).numReachableAreas; i++ ) {
 		for ( cache = areaCacheIndex[clusterNum][i]; cache; cache = areaCacheIndex[clusterNum][i] ) {
 			areaCacheIndex[clusterNum][i] = cache->next;
@@ -281,6 +284,8 @@ void idAASLocal::DeletePortalCache( void ) {
 	int i;
 	idRoutingCache *cache;
 
+	routingCacheGeneration++;
+
 	for ( i = 0; i < file->GetNumAreas(); i++ ) {
 		for ( cache = portalCacheIndex[i]; cache; cache = portalCacheIndex[i] ) {
 			portalCacheIndex[i] = cache->next;
@@ -319,6 +324,8 @@ void idAASLocal::ShutdownRoutingCache( void ) {
 
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
+
+	clusterCacheStats.Clear();
 }
 
 /*
@@ -332,12 +339,111 @@ bool idAASLocal::SetupRouting( void ) {
 	return true;
 }
 
+/*
+============
+idAASLocal::PrecomputeRoutingCache
+============
+*/
+int idAASLocal::PrecomputeRoutingCache( void ) {
+	if ( !file || !aas_precomputePortalCache.GetBool() ) {
+		return 0;
+	}
+	// the travel flags of walking AI, see idAI::Spawn
+	return PrecomputePortalRoutingCache( TFL_WALK|TFL_AIR|TFL_DOOR );
+}
+
+/*
+============
+idAASLocal::PrecomputePortalRoutingCache
+
+  sets up the portal caches towards all portal areas, as long as they take up no more than half of the budget.
+  The caches are allocated with new rather than Mem_Alloc, so this may run for several AAS at once.
+============
+*/
+int idAASLocal::PrecomputePortalRoutingCache( int travelFlags ) {
+	int i, numCaches;
+
+	numCaches = 0;
+	for ( i = 1; i < file->GetNumPortals(); i++ ) {
+		const aasPortal_t &portal = file->GetPortal( i );
+
+		if ( totalCacheMemory > RoutingCacheMemory() / 2 ) {
+			break;
+		}
+		if ( portal.clusters[0] <= 0 ) {
+			continue;
+		}
+		GetPortalRoutingCache( portal.clusters[0], portal.areaNum, travelFlags );
+		numCaches++;
+	}
+	return numCaches;
+}
+
+/*
+============
+idAASLocal::RoutingCacheMemory
+============
+*/
+int idAASLocal::RoutingCacheMemory( void ) const {
+	return aas_routingCacheMemory.GetInteger() << 10;
+}
+
+/*
+============
+idAASLocal::ResetRoutingCacheStats
+============
+*/
+void idAASLocal::ResetRoutingCacheStats( void ) {
+	aasCacheStats_t empty;
+
+	empty.hits = empty.misses = empty.evictions = 0;
+
+	portalRouteHits = portalRouteMisses = 0;
+
+	clusterCacheStats.SetNum( 0, false );
+	if ( file ) {
+		clusterCacheStats.AssureSize( file->GetNumClusters(), empty );
+	}
+}
+
+/*
+============
+idAASLocal::PrintRoutingCacheStats
+============
+*/
+void idAASLocal::PrintRoutingCacheStats( void ) const {
+	int i, hits, misses, evictions;
+
+	if ( !file ) {
+		return;
+	}
+
+	gameLocal.Printf( "[%s] routing cache %d KB of %d KB\n", file->GetName(), totalCacheMemory >> 10, RoutingCacheMemory() >> 10 );
+	gameLocal.Printf( "cluster     hits   misses  evicted\n" );
+
+	hits = misses = evictions = 0;
+	for ( i = 0; i < clusterCacheStats.Num(); i++ ) {
+		const aasCacheStats_t &stats = clusterCacheStats[i];
+
+		if ( stats.hits == 0 && stats.misses == 0 && stats.evictions == 0 ) {
+			continue;
+		}
+		gameLocal.Printf( "%7d %8d %8d %8d\n", i, stats.hits, stats.misses, stats.evictions );
+		hits += stats.hits;
+		misses += stats.misses;
+		evictions += stats.evictions;
+	}
+	gameLocal.Printf( "  total %8d %8d %8d (%.1f%% hits)\n", hits, misses, evictions, ( hits + misses ) ? 100.0f * hits / ( hits + misses ) : 0.0f );
+	gameLocal.Printf( "portal routes %d hits, %d set up\n", portalRouteHits, portalRouteMisses );
+}
+
 /*
 ============
 idAASLocal::ShutdownRouting
 ============
 */
 void idAASLocal::ShutdownRouting( void ) {
+	ClearRouteQueries();
 	DeleteAreaTravelTimes();
 	ShutdownRoutingCache();
 }
@@ -704,6 +810,13 @@ void idAASLocal::DeleteOldestCache( void ) const {
 	cache = cacheListStart;
 	UnlinkCache( cache );
 
+	// the portal routes might point to it
+	routingCacheGeneration++;
+
+	if ( cache->cluster >= 0 && cache->cluster < clusterCacheStats.Num() ) {
+		clusterCacheStats[cache->cluster].evictions++;
+	}
+
 	// unlink the oldest cache from the area or portal cache index
 	if ( cache->next ) {
 		cache->next->prev = cache->prev;
@@ -895,6 +1008,7 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 	}
 	// if no cache found
 	if ( !cache ) {
+		clusterCacheStats[clusterNum].misses++;
 		cache = new idRoutingCache( file->GetCluster( clusterNum ).numReachableAreas );
 		cache->type = CACHETYPE_AREA;
 		cache->cluster = clusterNum;
@@ -908,6 +1022,8 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 		}
 		areaCacheIndex[clusterNum][clusterAreaNum] = cache;
 		UpdateAreaRoutingCache( cache );
+	} else {
+		clusterCacheStats[clusterNum].hits++;
 	}
 	LinkCache( cache );
 	return cache;
@@ -1034,6 +1150,7 @@ idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 	}
 	// if no cache found
 	if ( !cache ) {
+		clusterCacheStats[clusterNum].misses++;
 		cache = new idRoutingCache( file->GetNumPortals() );
 		cache->type = CACHETYPE_PORTAL;
 		cache->cluster = clusterNum;
@@ -1047,6 +1164,8 @@ idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 		}
 		portalCacheIndex[areaNum] = cache;
 		UpdatePortalRoutingCache( cache );
+	} else {
+		clusterCacheStats[clusterNum].hits++;
 	}
 	LinkCache( cache );
 	return cache;
@@ -1096,7 +1215,7 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		return false;
 	}
 
-	while( totalCacheMemory > MAX_ROUTING_CACHE_MEMORY ) {
+	while( totalCacheMemory > RoutingCacheMemory() ) {
 		DeleteOldestCache();
 	}
 
@@ -1172,20 +1291,14 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 	}
 
 	int bestPortalAreaNum = 0;
-	// find the portal of the source area cluster leading towards the goal area
+	// find the portal of the source area cluster leading towards the goal area,
+	// the portals the goal can be reached from are shared by all routes from this cluster
+	const portalRoute_t* portalRoute = GetPortalRoute( clusterNum, goalAreaNum, travelFlags, portalCache );
 
-	for ( int i = 0 ; i < cluster->numPortals ; i++ )
+	for ( int i = 0 ; i < portalRoute->steps.Num() ; i++ )
 	{
-		int portalNum = file->GetPortalIndex( cluster->firstPortal + i );
-
-		// if the goal area isn't reachable from the portal
-		if ( !portalCache->travelTimes[portalNum] )
-		{
-			continue;
-		}
-
-		portal = &file->GetPortal( portalNum );
-		int portalAreaNum = portal->areaNum;
+		const portalRouteStep_t& step = portalRoute->steps[i];
+		int portalAreaNum = step.portalAreaNum;
 
 		// angua: area is forbidden (e.g. locked door)
 		if (actor != NULL && gameLocal.m_AreaManager.AreaIsForbidden(portalAreaNum, static_cast<idAI*>(actor)))
@@ -1229,7 +1342,8 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		}
 
 		// get the cache of the portal area
-		idRoutingCache* areaCache = GetAreaRoutingCache( clusterNum, portal->areaNum, travelFlags );
+		idRoutingCache* areaCache = step.areaCache;
+		LinkCache( areaCache );
 		// if the portal is not reachable from this area
 		if ( !areaCache->travelTimes[clusterAreaNum] ) {
 			continue;
@@ -1237,23 +1351,14 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 
 		idReachability* r = GetAreaReachability( areaNum, areaCache->reachabilities[clusterAreaNum] );
 
-		if ( clusterCache ) {
-			// if the next reachability from the portal leads back into the cluster
-			idReachability* nextr = GetAreaReachability( portal->areaNum, portalCache->reachabilities[portalNum] );
-			if ( file->GetArea( nextr->toAreaNum ).cluster < 0 || file->GetArea( nextr->toAreaNum ).cluster == clusterNum ) {
-				continue;
-			}
+		// if the next reachability from the portal leads back into the cluster
+		if ( clusterCache && step.leadsBack ) {
+			continue;
 		}
 
 		// the total travel time is the travel time from the portal area to the goal area
 		// plus the travel time from the source area towards the portal area
-		unsigned short int t = portalCache->travelTimes[portalNum] + areaCache->travelTimes[clusterAreaNum];
-
-		// NOTE:	Should add the exact travel time through the portal area.
-		//			However, we add the largest travel time through the portal area.
-		//			We cannot directly calculate the exact travel time through the portal area
-		//			because the reachability used to travel into the portal area is not known.
-		t += portal->maxAreaTravelTime;
+		unsigned short int t = step.goalTravelTime + areaCache->travelTimes[clusterAreaNum];
 
 		// if the time is better than the one already found
 		if ( !bestTime || t < bestTime ) {
@@ -1288,6 +1393,223 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 	return true;
 }
 
+/*
+============
+idAASLocal::ClearPortalRoutes
+============
+*/
+void idAASLocal::ClearPortalRoutes( void ) {
+	for ( int i = 0 ; i < MAX_PORTAL_ROUTES ; i++ ) {
+		portalRoutes[i].clusterNum = -1;
+		portalRoutes[i].steps.Clear();
+	}
+	portalRouteHash.Clear();
+	nextPortalRoute = 0;
+}
+
+/*
+============
+idAASLocal::GetPortalRoute
+
+  Returns the portals of the cluster the goal area can be reached from.
+  The steps point into the routing caches, so a route is set up again
+  once any routing cache has been deleted.
+============
+*/
+const idAASLocal::portalRoute_t *idAASLocal::GetPortalRoute( int clusterNum, int goalAreaNum, int travelFlags, idRoutingCache *portalCache ) const {
+	int key = clusterNum * 1031 + goalAreaNum * 31 + travelFlags;
+
+	for ( int i = portalRouteHash.First( key ) ; i != -1 ; i = portalRouteHash.Next( i ) ) {
+		const portalRoute_t &route = portalRoutes[i];
+		if ( route.clusterNum == clusterNum && route.goalAreaNum == goalAreaNum && route.travelFlags == travelFlags ) {
+			if ( route.cacheGeneration == routingCacheGeneration ) {
+				portalRouteHits++;
+				return &route;
+			}
+			// the routing caches changed, set up the steps again
+			portalRouteHash.Remove( key, i );
+			portalRoutes[i].clusterNum = -1;
+			break;
+		}
+	}
+
+	portalRouteMisses++;
+
+	// reuse the oldest route
+	int index = nextPortalRoute;
+	nextPortalRoute = ( nextPortalRoute + 1 ) % MAX_PORTAL_ROUTES;
+
+	portalRoute_t &route = portalRoutes[index];
+	if ( route.clusterNum >= 0 ) {
+		portalRouteHash.Remove( route.clusterNum * 1031 + route.goalAreaNum * 31 + route.travelFlags, index );
+	}
+
+	route.clusterNum = clusterNum;
+	route.goalAreaNum = goalAreaNum;
+	route.travelFlags = travelFlags;
+	route.steps.SetNum( 0, false );
+
+	const aasCluster_t &cluster = file->GetCluster( clusterNum );
+
+	for ( int i = 0 ; i < cluster.numPortals ; i++ ) {
+		int portalNum = file->GetPortalIndex( cluster.firstPortal + i );
+
+		// if the goal area isn't reachable from the portal
+		if ( !portalCache->travelTimes[portalNum] ) {
+			continue;
+		}
+
+		const aasPortal_t &portal = file->GetPortal( portalNum );
+		idReachability *nextr = GetAreaReachability( portal.areaNum, portalCache->reachabilities[portalNum] );
+		int nextCluster = file->GetArea( nextr->toAreaNum ).cluster;
+
+		portalRouteStep_t &step = route.steps.Alloc();
+		step.portalNum = portalNum;
+		step.portalAreaNum = portal.areaNum;
+
+		// NOTE:	Should add the exact travel time through the portal area.
+		//			However, we add the largest travel time through the portal area.
+		//			We cannot directly calculate the exact travel time through the portal area
+		//			because the reachability used to travel into the portal area is not known.
+		step.goalTravelTime = portalCache->travelTimes[portalNum] + portal.maxAreaTravelTime;
+		step.leadsBack = ( nextCluster < 0 || nextCluster == clusterNum );
+		step.areaCache = GetAreaRoutingCache( clusterNum, portal.areaNum, travelFlags );
+	}
+
+	// set the generation last, setting up the area caches doesn't delete any
+	route.cacheGeneration = routingCacheGeneration;
+	portalRouteHash.Add( key, index );
+
+	return &route;
+}
+
+/*
+============
+idAASLocal::QueueRouteQuery
+============
+*/
+int idAASLocal::QueueRouteQuery( int areaNum, const idVec3 &origin, int goalAreaNum, int travelFlags, idActor* actor )
+{
+	routeQuery_t& query = routeQueries.Alloc();
+
+	query.queryNum = nextRouteQueryNum++;
+	query.areaNum = areaNum;
+	query.origin = origin;
+	query.goalAreaNum = goalAreaNum;
+	query.travelFlags = travelFlags;
+	query.actor = actor;
+	query.hasActor = (actor != NULL);
+	query.doneTime = -1;
+	query.result.found = false;
+	query.result.travelTime = 0;
+	query.result.reach = NULL;
+
+	return query.queryNum;
+}
+
+/*
+============
+idAASLocal::PollRouteQuery
+============
+*/
+bool idAASLocal::PollRouteQuery( int queryNum, aasRouteResult_t &result )
+{
+	for ( int i = 0 ; i < routeQueries.Num() ; i++ )
+	{
+		if ( routeQueries[i].queryNum != queryNum )
+		{
+			continue;
+		}
+
+		if ( routeQueries[i].doneTime < 0 )
+		{
+			return false;
+		}
+
+		result = routeQueries[i].result;
+		routeQueries.RemoveIndex( i );
+		return true;
+	}
+
+	// unknown (dropped) queries count as done without a route
+	result.found = false;
+	result.travelTime = 0;
+	result.reach = NULL;
+	return true;
+}
+
+/*
+============
+idAASLocal::CancelRouteQuery
+============
+*/
+void idAASLocal::CancelRouteQuery( int queryNum )
+{
+	for ( int i = 0 ; i < routeQueries.Num() ; i++ )
+	{
+		if ( routeQueries[i].queryNum == queryNum )
+		{
+			routeQueries.RemoveIndex( i );
+			return;
+		}
+	}
+}
+
+/*
+============
+idAASLocal::RunRouteQueries
+============
+*/
+void idAASLocal::RunRouteQueries( int maxQueries )
+{
+	int numQueries = 0;
+
+	for ( int i = 0 ; i < routeQueries.Num() ; i++ )
+	{
+		routeQuery_t& query = routeQueries[i];
+
+		if ( query.doneTime >= 0 )
+		{
+			// nobody asked for the result for a while
+			if ( gameLocal.time - query.doneTime > 5000 )
+			{
+				routeQueries.RemoveIndex( i-- );
+			}
+			continue;
+		}
+
+		if ( numQueries >= maxQueries )
+		{
+			continue;
+		}
+
+		idActor* actor = query.actor.GetEntity();
+
+		if ( query.hasActor && actor == NULL )
+		{
+			// the actor is gone
+			query.doneTime = gameLocal.time;
+			continue;
+		}
+
+		// this sets up the routing caches towards the goal, which is the expensive part
+		query.result.found = RouteToGoalArea( query.areaNum, query.origin, query.goalAreaNum, query.travelFlags,
+			query.result.travelTime, &query.result.reach, NULL, actor );
+		query.doneTime = gameLocal.time;
+		numQueries++;
+	}
+}
+
+/*
+============
+idAASLocal::ClearRouteQueries
+============
+*/
+void idAASLocal::ClearRouteQueries( void )
+{
+	routeQueries.Clear();
+}
+
 /*
 ============
 idAASLocal::TravelTimeToGoalArea
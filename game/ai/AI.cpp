@@ -2344,6 +2344,9 @@ idAI::Think
 void idAI::Think( void ) 
 {
 	START_SCOPED_TIMING(aiThinkTimer, scopedThinkTimer);
+	PROFILE_SCOPE( "idAI::Think" );
+	CAIThinkTiming thinkTiming;
+	ai::AIBenchmarkTiming benchmarkTiming( ai::AIBenchmark::COST_THINK );
 	if (cv_ai_opt_nothink.GetBool()) 
 	{
 		return; // Thinking is disabled.
@@ -2673,6 +2676,7 @@ void idAI::Think( void )
 	if (!cv_ai_opt_noanims.GetBool())
 	{
 		START_SCOPED_TIMING(aiAnimationTimer, scopedAnimationTimer)
+		ai::AIBenchmarkTiming benchmarkTiming( ai::AIBenchmark::COST_ANIMATION );
 		UpdateAnimation();
 	}
 	UpdateParticles();
@@ -2759,7 +2763,6 @@ idAI::SetNextThinkFrame
 */
 void idAI::SetNextThinkFrame()
 {
-	int frameNum = gameLocal.framenum;
 	int thinkFrame = GetThinkInterleave();
 	int thinkDelta = 1;
 
@@ -2824,7 +2827,8 @@ void idAI::SetNextThinkFrame()
 		}
 	}
 
-	m_nextThinkFrame = frameNum + thinkDelta;
+	// The scheduler spreads the AI over the frames
+	m_nextThinkFrame = gameLocal.m_ThinkScheduler.ScheduleAIThink(this, thinkDelta);
 }
 
 /*
@@ -3247,6 +3251,7 @@ bool idAI::PathToGoal( aasPath_t &path, int areaNum, const idVec3 &origin, int g
 	}
 
 	START_SCOPED_TIMING(aiPathToGoalTimer, scopedPathToGoalTimer);
+	ai::AIBenchmarkTiming benchmarkTiming( ai::AIBenchmark::COST_PATHING );
 
 	idVec3 org = origin;
 	aas->PushPointIntoAreaNum(areaNum, org);
@@ -3466,6 +3471,15 @@ void idAI::StopMove( moveStatus_t status )
 	// Note: you might be tempted to set AI_RUN to false here,
 	// but AI_RUN needs to persist when stopping at a point
 	// where the AI is just going to start moving again.
+	if (move.routeQuery != -1)
+	{
+		if (aas != NULL)
+		{
+			aas->CancelRouteQuery(move.routeQuery);
+		}
+		move.routeQuery = -1;
+	}
+
 	AI_MOVE_DONE		= true;
 	AI_FORWARD			= false;
 	m_pathRank			= 1000; // grayman #2345
@@ -4424,7 +4438,7 @@ idAI::MoveToPosition
 =====================
 */
 
-bool idAI::MoveToPosition( const idVec3 &pos, float accuracy )
+bool idAI::MoveToPosition( const idVec3 &pos, float accuracy, bool queueRoute )
 {
 	move.accuracy = accuracy; // grayman #3882
 
@@ -4449,6 +4463,10 @@ bool idAI::MoveToPosition( const idVec3 &pos, float accuracy )
 		return true;
 	}
 
+	// A queued route query of the last MoveToPosition
+	const bool routePending = (move.routeQuery != -1 && move.moveCommand == MOVE_TO_POSITION && move.moveStatus == MOVE_STATUS_WAITING);
+	const int pendingAreaNum = move.toAreaNum;
+
 	idVec3 org = pos;
 	move.toAreaNum = 0;
 	aasPath_t path;
@@ -4459,6 +4477,34 @@ bool idAI::MoveToPosition( const idVec3 &pos, float accuracy )
 
 		int areaNum	= PointReachableAreaNum( physicsObj.GetOrigin() );
 
+		// Let the AAS work the route out within the next frames, GetMovePos goes on from there
+		if (queueRoute && cv_ai_route_queries.GetInteger() > 0 && move.toAreaNum != 0 && areaNum != move.toAreaNum)
+		{
+			// Keep a pending query towards the same area
+			if (!routePending || pendingAreaNum != move.toAreaNum)
+			{
+				if (move.routeQuery != -1)
+				{
+					aas->CancelRouteQuery(move.routeQuery);
+				}
+				move.routeQuery = aas->QueueRouteQuery(areaNum, physicsObj.GetOrigin(), move.toAreaNum, travelFlags, this);
+			}
+
+			SetStartTime(org);
+			move.moveDest		= org;
+			move.goalEntity		= NULL;
+			move.moveCommand	= MOVE_TO_POSITION;
+			move.moveStatus		= MOVE_STATUS_WAITING;
+			move.speed			= fly_speed;
+			move.accuracy		= accuracy;
+			AI_MOVE_DONE		= false;
+			AI_DEST_UNREACHABLE = false;
+			AI_FORWARD			= false;
+			m_pathRank			= rank;
+
+			return true;
+		}
+
 		if (!PathToGoal(path, areaNum, physicsObj.GetOrigin(), move.toAreaNum, org, this))
 		{
 			StopMove(MOVE_STATUS_DEST_UNREACHABLE);
@@ -4929,6 +4975,26 @@ bool idAI::GetMovePos(idVec3 &seekPos)
 	const idVec3& org = physicsObj.GetOrigin();
 	seekPos = org;
 
+	// MoveToPosition is waiting for its route query
+	if (move.moveCommand == MOVE_TO_POSITION && move.moveStatus == MOVE_STATUS_WAITING)
+	{
+		aasRouteResult_t route;
+
+		if (aas != NULL && move.routeQuery != -1 && !aas->PollRouteQuery(move.routeQuery, route))
+		{
+			return false; // stand still until it's done
+		}
+
+		// The routing caches are set up now, go on with the move as usual
+		move.routeQuery = -1;
+
+		if (!MoveToPosition(move.moveDest, move.accuracy, false) || move.moveCommand != MOVE_TO_POSITION)
+		{
+			seekPos = org;
+			return false;
+		}
+	}
+
 	switch( move.moveCommand ) {
 	case MOVE_NONE :
 		seekPos = move.moveDest;
@@ -10465,6 +10531,8 @@ idEntity *idAI::GetTactEnt( void )
 
 void idAI::PerformVisualScan(float timecheck)
 {
+	ai::AIBenchmarkTiming benchmarkTiming( ai::AIBenchmark::COST_VISUAL_SCAN );
+
 	// Only perform enemy checks if we are in the player's PVS
 	if ( ( GetAcuity("vis") <= 0 ) || !gameLocal.InPlayerPVS(this) )
 	{
@@ -10493,7 +10561,8 @@ void idAI::PerformVisualScan(float timecheck)
 	}
 
 	// angua: does not take lighting and FOV into account
-	if (!CanSeeExt(player, false, false))
+	// The trace is batched with those of the other AI, see ai::VisualScanScheduler
+	if (!gameLocal.m_VisualScanScheduler.CanSee(this, player))
 	{
 		return;
 	}
@@ -10658,7 +10727,8 @@ void idAI::PerformVisualScan(float timecheck)
 	}
 
 	// angua: does not take lighting and FOV into account
-	if (!CanSeeExt(player, false, false))
+	// The trace is batched with those of the other AI, see ai::VisualScanScheduler
+	if (!gameLocal.m_VisualScanScheduler.CanSee(this, player))
 	{
 		return;
 	}
@@ -11231,14 +11301,14 @@ idActor* idAI::FindEnemyAI(bool useFOV)
 	float bestDist = idMath::INFINITY;
 	idActor* bestEnemy = NULL;
 
-	for (idEntity* ent = gameLocal.activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() )
+	// only thinking actors, as when this walked the active entities
+	for (idActor* actor = gameLocal.spawnedActors.Next(); actor != NULL; actor = actor->actorNode.Next() )
 	{
-		if ( ent->fl.hidden || ent->fl.isDormant || ent->fl.notarget || ent->fl.invisible || !ent->IsType( idActor::Type ) ) // grayman #3857 - also use 'invisible'
+		if ( actor->fl.hidden || actor->fl.isDormant || actor->fl.notarget || actor->fl.invisible || !actor->IsActive() ) // grayman #3857 - also use 'invisible'
 		{
 			continue;
 		}
 
-		idActor* actor = static_cast<idActor *>( ent );
 		if ( ( actor->health <= 0 ) || !( ReactionTo( actor ) & ATTACK_ON_SIGHT ) ) {
 			continue;
 		}
@@ -11269,13 +11339,12 @@ idActor* idAI::FindFriendlyAI(int requiredTeam)
 	// Setup the PVS areas of this entity using the PVSAreas set, this returns a handle
 	pvsHandle_t pvs(gameLocal.pvs.SetupCurrentPVS( GetPVSAreas(), GetNumPVSAreas()));
 
-	// Iterate through all active entities and find an AI with the given team.
-	for (idEntity* ent = gameLocal.activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
-		if ( ent == this || ent->fl.hidden || ent->fl.isDormant || !ent->IsType( idActor::Type ) ) {
+	// Iterate through all active actors and find an AI with the given team.
+	for (idActor* actor = gameLocal.spawnedActors.Next(); actor != NULL; actor = actor->actorNode.Next() ) {
+		if ( actor == this || actor->fl.hidden || actor->fl.isDormant || !actor->IsActive() ) {
 			continue;
 		}
 
-		idActor* actor = static_cast<idActor *>(ent);
 		if (actor->health <= 0) {
 			continue;
 		}
@@ -11472,7 +11541,6 @@ bool idAI::IsEntityHiddenByDarkness(idEntity* p_entity, const float sightThresho
 
 idActor *idAI::FindNearestEnemy( bool useFOV )
 {
-	idEntity	*ent;
 	idActor		*actor, *playerEnemy;
 	idActor		*bestEnemy;
 	float		bestDist;
@@ -11485,13 +11553,13 @@ idActor *idAI::FindNearestEnemy( bool useFOV )
 	bestDist = idMath::INFINITY;
 	bestEnemy = NULL;
 
-	for ( ent = gameLocal.activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
-		if ( ent->fl.hidden || ent->fl.isDormant || !ent->IsType( idActor::Type ) )
+	// only thinking actors, as when this walked the active entities
+	for ( actor = gameLocal.spawnedActors.Next(); actor != NULL; actor = actor->actorNode.Next() ) {
+		if ( actor->fl.hidden || actor->fl.isDormant || !actor->IsActive() )
 		{
 			continue;
 		}
 
-		actor = static_cast<idActor *>( ent );
 		if ( ( actor->health <= 0 ) || !( ReactionTo( actor ) & ATTACK_ON_SIGHT ) )
 		{
 			continue;
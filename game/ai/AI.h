@@ -1705,7 +1705,11 @@ public: // greebo: Made these public for now, I didn't want to write an accessor
 	 * @returns: TRUE, if the position is reachable and the AI is moving (AI_MOVE_DONE == false) 
 	 *                 OR the position is already reached (AI_MOVE_DONE == true).
 	 */
-	bool					MoveToPosition( const idVec3 &pos, float accuracy = -1 );
+	/**
+	 * With tdm_ai_route_queries > 0 and queueRoute set the route is queued and the move waits
+	 * (MOVE_STATUS_WAITING) until the AAS has worked it out, see idAAS::QueueRouteQuery.
+	 */
+	bool					MoveToPosition( const idVec3 &pos, float accuracy = -1, bool queueRoute = true );
 
 	/**
 	 * angua: This looks for a suitable position for taking cover
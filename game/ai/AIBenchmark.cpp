@@ -0,0 +1,471 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+#include "precompiled_game.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "AIBenchmark.h"
+#include "../Game_local.h"
+#include "../SndProp.h"
+
+namespace ai
+{
+
+// The frames the AI get to land and settle before the scenarios are measured
+static const int BENCHMARK_WARMUP_FRAMES = 60;
+
+// Every patrolling AI gets a new goal this often, the AI are spread over the interval
+static const int BENCHMARK_PATROL_GOAL_FRAMES = 240;
+
+// A suspicious sound is made at a random AI this often in the search scenario
+static const int BENCHMARK_SEARCH_SOUND_FRAMES = 30;
+
+AIBenchmark::AIBenchmark() :
+	_phase(PHASE_NONE)
+{
+	Clear();
+}
+
+void AIBenchmark::Clear()
+{
+	if (IsRunning())
+	{
+		perfSuite->EndBenchmark();
+	}
+
+	_phase = PHASE_NONE;
+	_phaseFrame = 0;
+	_framesPerPhase = 0;
+	_seed = 0;
+	_className.Clear();
+
+	_aas = NULL;
+	_areas.Clear();
+	_ais.Clear();
+
+	_playerGodMode = false;
+
+	_frameStart = 0;
+
+	for (int i = 0; i < NUM_COSTS; i++)
+	{
+		_frameCosts[i] = 0;
+	}
+
+	for (int i = 0; i < NUM_PHASES; i++)
+	{
+		_stats[i].frameTimes.Clear();
+
+		for (int j = 0; j < NUM_COSTS; j++)
+		{
+			_stats[i].costs[j] = 0;
+		}
+	}
+}
+
+bool AIBenchmark::Start(const char* className, int count, int framesPerPhase, int seed)
+{
+	if (IsRunning())
+	{
+		gameLocal.Printf("An AI benchmark is already running, use 'tdm_ai_benchmark stop' first.\n");
+		return false;
+	}
+
+	idPlayer* player = gameLocal.GetLocalPlayer();
+
+	if (player == NULL || gameLocal.isMultiplayer)
+	{
+		gameLocal.Printf("The AI benchmark needs a single player map.\n");
+		return false;
+	}
+
+	const idDict* def = gameLocal.FindEntityDefDict(className, false);
+
+	if (def == NULL)
+	{
+		gameLocal.Printf("Unknown entityDef '%s'.\n", className);
+		return false;
+	}
+
+	idAAS* aas = gameLocal.GetAAS(def->GetString("use_aas"));
+
+	if (aas == NULL)
+	{
+		gameLocal.Printf("The map has no AAS '%s' for %s.\n", def->GetString("use_aas"), className);
+		return false;
+	}
+
+	Clear();
+
+	_className = className;
+	_framesPerPhase = framesPerPhase;
+	_seed = seed;
+	_aas = aas;
+
+	FindSpawnAreas();
+
+	if (_areas.Num() == 0)
+	{
+		gameLocal.Printf("The AAS '%s' has no walkable areas.\n", def->GetString("use_aas"));
+		Clear();
+		return false;
+	}
+
+	// the AI draw from gameLocal.random as well
+	_random.SetSeed(seed);
+	gameLocal.random.SetSeed(seed);
+
+	SpawnAI(count);
+
+	if (_ais.Num() == 0)
+	{
+		Clear();
+		return false;
+	}
+
+	if (gameLocal.FindEntityDefDict(va("sprGS_%s", cv_ai_benchmark_sound.GetString()), false) == NULL)
+	{
+		gameLocal.Printf("WARNING: no sound propagation def for '%s', the search scenario will be silent.\n",
+			cv_ai_benchmark_sound.GetString());
+	}
+
+	_playerGodMode = player->godmode;
+
+	gameLocal.Printf("AI benchmark: %d x %s on %d areas, %d frames per scenario, seed %d\n",
+		_ais.Num(), _className.c_str(), _areas.Num(), _framesPerPhase, _seed);
+
+	EnterPhase(PHASE_WARMUP);
+
+	// a running perf suite waits for the scenarios
+	perfSuite->BeginBenchmark();
+
+	return true;
+}
+
+void AIBenchmark::Stop()
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	Print();
+
+	RemoveAI();
+
+	idPlayer* player = gameLocal.GetLocalPlayer();
+
+	if (player != NULL)
+	{
+		player->godmode = _playerGodMode;
+	}
+
+	Clear();
+}
+
+void AIBenchmark::BeginFrame()
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	_frameStart = sys->GetClockTicks();
+
+	for (int i = 0; i < NUM_COSTS; i++)
+	{
+		_frameCosts[i] = 0;
+	}
+
+	switch (_phase)
+	{
+	case PHASE_PATROL:
+		RunPatrol();
+		break;
+	case PHASE_SEARCH:
+		RunSearch();
+		break;
+	default:
+		break;
+	}
+}
+
+void AIBenchmark::EndFrame()
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	if (_phase != PHASE_WARMUP)
+	{
+		double msecPerTick = 1000.0 / sys->ClockTicksPerSecond();
+		PhaseStats& stats = _stats[_phase];
+
+		stats.frameTimes.Append(static_cast<float>((sys->GetClockTicks() - _frameStart) * msecPerTick));
+
+		for (int i = 0; i < NUM_COSTS; i++)
+		{
+			stats.costs[i] += _frameCosts[i] * msecPerTick;
+		}
+	}
+
+	_phaseFrame++;
+
+	int phaseFrames = (_phase == PHASE_WARMUP) ? BENCHMARK_WARMUP_FRAMES : _framesPerPhase;
+
+	if (_phaseFrame < phaseFrames)
+	{
+		return;
+	}
+
+	if (_phase == PHASE_COMBAT)
+	{
+		Stop();
+	}
+	else
+	{
+		EnterPhase(static_cast<Phase>(_phase + 1));
+	}
+}
+
+void AIBenchmark::AddCost(Cost cost, double ticks)
+{
+	#pragma omp atomic
+	_frameCosts[cost] += ticks;
+}
+
+void AIBenchmark::Print() const
+{
+	gameLocal.Printf("AI benchmark results: %d x %s, seed %d (msecs per game frame)\n",
+		_ais.Num(), _className.c_str(), _seed);
+	gameLocal.Printf("%-8s %6s %7s %7s %7s %7s %7s | %7s %7s %7s %7s %7s %7s\n",
+		"scenario", "frames", "avg", "p50", "p90", "p99", "max",
+		"think", "visscan", "pathing", "anim", "physics", "sndprop");
+
+	for (int i = PHASE_PATROL; i < NUM_PHASES; i++)
+	{
+		const PhaseStats& stats = _stats[i];
+		int numFrames = stats.frameTimes.Num();
+
+		if (numFrames == 0)
+		{
+			continue;
+		}
+
+		idList<float> sorted = stats.frameTimes;
+		sorted.Sort(SortFloat);
+
+		float sum = 0;
+
+		for (int j = 0; j < numFrames; j++)
+		{
+			sum += sorted[j];
+		}
+
+		gameLocal.Printf("%-8s %6d %7.3f %7.3f %7.3f %7.3f %7.3f | %7.3f %7.3f %7.3f %7.3f %7.3f %7.3f\n",
+			GetPhaseName(i), numFrames, sum / numFrames,
+			sorted[(numFrames - 1) * 50 / 100], sorted[(numFrames - 1) * 90 / 100],
+			sorted[(numFrames - 1) * 99 / 100], sorted[numFrames - 1],
+			stats.costs[COST_THINK] / numFrames, stats.costs[COST_VISUAL_SCAN] / numFrames,
+			stats.costs[COST_PATHING] / numFrames, stats.costs[COST_ANIMATION] / numFrames,
+			stats.costs[COST_PHYSICS] / numFrames, stats.costs[COST_SOUND_PROP] / numFrames);
+
+		idStr perfName = va("ai/%s", _className.c_str());
+		const char* phaseName = GetPhaseName(i);
+		perfSuite->AddResult(perfName, va("%s frameMsec mean", phaseName), sum / numFrames);
+		perfSuite->AddResult(perfName, va("%s frameMsec p50", phaseName), sorted[(numFrames - 1) * 50 / 100]);
+		perfSuite->AddResult(perfName, va("%s frameMsec p99", phaseName), sorted[(numFrames - 1) * 99 / 100]);
+		perfSuite->AddResult(perfName, va("%s frameMsec max", phaseName), sorted[numFrames - 1]);
+		perfSuite->AddResult(perfName, va("%s thinkMsec mean", phaseName), stats.costs[COST_THINK] / numFrames);
+	}
+}
+
+void AIBenchmark::FindSpawnAreas()
+{
+	const int badFlags = AREA_LIQUID | AREA_CROUCH | AREA_LEDGE | AREA_LADDER;
+
+	for (int i = 1; i < _aas->GetNumAreas(); i++)
+	{
+		int flags = _aas->AreaFlags(i);
+
+		if ((flags & AREA_FLOOR) && (flags & AREA_REACHABLE_WALK) && !(flags & badFlags))
+		{
+			_areas.Append(i);
+		}
+	}
+}
+
+void AIBenchmark::SpawnAI(int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		idDict args;
+		args.Set("classname", _className);
+		args.Set("name", va("ai_benchmark_%d", i));
+		args.SetVector("origin", RandomAreaPoint());
+		args.SetFloat("angle", _random.RandomFloat() * 360);
+
+		idEntity* ent = NULL;
+
+		if (!gameLocal.SpawnEntityDef(args, &ent) || ent == NULL)
+		{
+			gameLocal.Printf("Failed to spawn %s.\n", _className.c_str());
+			break;
+		}
+
+		if (!ent->IsType(idAI::Type))
+		{
+			gameLocal.Printf("%s is not an AI.\n", _className.c_str());
+			ent->PostEventMS(&EV_Remove, 0);
+			break;
+		}
+
+		idEntityPtr<idAI> ai;
+		ai = static_cast<idAI*>(ent);
+		_ais.Append(ai);
+	}
+}
+
+void AIBenchmark::RemoveAI()
+{
+	for (int i = 0; i < _ais.Num(); i++)
+	{
+		idAI* ai = _ais[i].GetEntity();
+
+		if (ai != NULL)
+		{
+			ai->PostEventMS(&EV_Remove, 0);
+		}
+	}
+
+	_ais.Clear();
+}
+
+void AIBenchmark::EnterPhase(Phase phase)
+{
+	_phase = phase;
+	_phaseFrame = 0;
+
+	if (phase != PHASE_COMBAT)
+	{
+		return;
+	}
+
+	idPlayer* player = gameLocal.GetLocalPlayer();
+	player->godmode = true;
+
+	for (int i = 0; i < _ais.Num(); i++)
+	{
+		idAI* ai = _ais[i].GetEntity();
+
+		if (ai != NULL && ai->health > 0)
+		{
+			ai->SetEnemy(player);
+		}
+	}
+}
+
+void AIBenchmark::RunPatrol()
+{
+	for (int i = 0; i < _ais.Num(); i++)
+	{
+		if ((_phaseFrame + i) % BENCHMARK_PATROL_GOAL_FRAMES != 0)
+		{
+			continue;
+		}
+
+		idAI* ai = _ais[i].GetEntity();
+
+		if (ai != NULL && ai->health > 0)
+		{
+			ai->MoveToPosition(RandomAreaPoint());
+		}
+	}
+}
+
+void AIBenchmark::RunSearch()
+{
+	if (_phaseFrame % BENCHMARK_SEARCH_SOUND_FRAMES != 0)
+	{
+		return;
+	}
+
+	idAI* ai = _ais[_random.RandomInt(_ais.Num())].GetEntity();
+
+	if (ai == NULL || ai->health <= 0)
+	{
+		return;
+	}
+
+	// somewhere behind the AI, so it has to turn and look
+	idVec3 origin = ai->GetEyePosition() - ai->viewAxis[0] * 128.0f;
+
+	gameLocal.m_sndProp->Propagate(0.0f, 1.0f, cv_ai_benchmark_sound.GetString(), origin, gameLocal.GetLocalPlayer());
+}
+
+idVec3 AIBenchmark::RandomAreaPoint()
+{
+	return _aas->AreaCenter(_areas[_random.RandomInt(_areas.Num())]);
+}
+
+const char* AIBenchmark::GetPhaseName(int phase)
+{
+	switch (phase)
+	{
+	case PHASE_WARMUP:	return "warmup";
+	case PHASE_PATROL:	return "patrol";
+	case PHASE_SEARCH:	return "search";
+	case PHASE_COMBAT:	return "combat";
+	default:			return "none";
+	}
+}
+
+int AIBenchmark::SortFloat(const float* a, const float* b)
+{
+	if (*a < *b)
+	{
+		return -1;
+	}
+
+	return (*a > *b) ? 1 : 0;
+}
+
+AIBenchmarkTiming::AIBenchmarkTiming(AIBenchmark::Cost cost) :
+	_cost(cost),
+	_start(0),
+	_running(gameLocal.m_AIBenchmark.IsRunning())
+{
+	if (_running)
+	{
+		_start = sys->GetClockTicks();
+	}
+}
+
+AIBenchmarkTiming::~AIBenchmarkTiming()
+{
+	if (_running)
+	{
+		gameLocal.m_AIBenchmark.AddCost(_cost, sys->GetClockTicks() - _start);
+	}
+}
+
+} // namespace ai
@@ -0,0 +1,154 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+#ifndef __AI_BENCHMARK_H__
+#define __AI_BENCHMARK_H__
+
+class idAI;
+class idAAS;
+
+namespace ai
+{
+
+/**
+ * The AI stress benchmark of tdm_ai_benchmark. Spawns a number of AI of one entityDef at
+ * random places of their AAS and runs them through a patrol, a search and a combat
+ * scenario, each for a fixed number of game frames after a short warmup. The places, the
+ * goals and the sounds are drawn from a fixed seed, which also seeds gameLocal.random, so
+ * two runs on the same map with the same arguments can be compared.
+ *
+ * Prints the game frame times (average and percentiles) and what the frames spent per
+ * AI subsystem in each scenario, then removes the AI again.
+ */
+class AIBenchmark
+{
+public:
+	enum Cost
+	{
+		COST_THINK,			// idAI::Think, includes most of the others
+		COST_VISUAL_SCAN,	// idAI::PerformVisualScan and the batched traces
+		COST_PATHING,		// idAI::PathToGoal and the queued route queries
+		COST_ANIMATION,		// idAI animation updates and idGameLocal::PrepareAnimations
+		COST_PHYSICS,		// idEntity::RunPhysics of all entities and the articulated figures
+		COST_SOUND_PROP,	// suspicious sound propagation
+		NUM_COSTS
+	};
+
+private:
+	enum Phase
+	{
+		PHASE_NONE,
+		PHASE_WARMUP,		// the AI land and settle, not measured
+		PHASE_PATROL,		// walking to random goals
+		PHASE_SEARCH,		// suspicious sounds near random AI
+		PHASE_COMBAT,		// all AI fight the player, who is invulnerable meanwhile
+		NUM_PHASES
+	};
+
+	struct PhaseStats
+	{
+		idList<float>	frameTimes;		// msecs of each game frame
+		double			costs[NUM_COSTS];	// msecs summed over the frames
+	};
+
+	Phase				_phase;
+	int					_phaseFrame;		// the frames run in the current phase
+	int					_framesPerPhase;
+	int					_seed;
+	idStr				_className;
+
+	idRandom			_random;
+	idAAS*				_aas;
+	idList<int>			_areas;				// the AAS areas the AI are spawned in and sent to
+	idList< idEntityPtr<idAI> > _ais;
+
+	bool				_playerGodMode;		// restored at the end
+
+	double				_frameStart;		// clock ticks
+	double				_frameCosts[NUM_COSTS];	// clock ticks of the current frame
+
+	PhaseStats			_stats[NUM_PHASES];
+
+public:
+	AIBenchmark();
+
+	// Drops a running benchmark without touching the entities, call when the map is cleared
+	void Clear();
+
+	/**
+	 * Spawns the AI and starts the warmup, returns false and prints why if it can't.
+	 */
+	bool Start(const char* className, int count, int framesPerPhase, int seed);
+
+	// Removes the AI and prints what has been measured so far
+	void Stop();
+
+	bool IsRunning() const { return _phase != PHASE_NONE; }
+
+	/**
+	 * Call at the start of each game frame, drives the current scenario.
+	 */
+	void BeginFrame();
+
+	/**
+	 * Call at the end of each game frame, records the frame and moves on to the next
+	 * scenario when this one is done.
+	 */
+	void EndFrame();
+
+	// Adds clock ticks to the current frame, may be called from the parallel thinks
+	void AddCost(Cost cost, double ticks);
+
+	// Prints the results of the finished scenarios
+	void Print() const;
+
+private:
+	void FindSpawnAreas();
+	void SpawnAI(int count);
+	void RemoveAI();
+
+	void EnterPhase(Phase phase);
+
+	void RunPatrol();
+	void RunSearch();
+
+	idVec3 RandomAreaPoint();
+
+	static const char* GetPhaseName(int phase);
+	static int SortFloat(const float* a, const float* b);
+};
+
+/**
+ * Adds the time of its scope to an AIBenchmark cost while the benchmark runs.
+ */
+class AIBenchmarkTiming
+{
+private:
+	AIBenchmark::Cost	_cost;
+	double				_start;
+	bool				_running;
+
+public:
+	AIBenchmarkTiming(AIBenchmark::Cost cost);
+	~AIBenchmarkTiming();
+};
+
+} // namespace ai
+
+#endif /* __AI_BENCHMARK_H__ */
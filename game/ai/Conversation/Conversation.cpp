@@ -340,6 +340,14 @@ idAI* Conversation::GetActor(int index)
 		return NULL; // index out of bounds
 	}
 
+	// Use the cached entity as long as it still carries the actor's name
+	idAI* cached = _actorEntities[index].GetEntity();
+
+	if (cached != NULL && cached->name == _actors[index])
+	{
+		return cached;
+	}
+
 	// Resolve the entity name and get the pointer
 	idEntity* ent = gameLocal.FindEntity(_actors[index]);
 
@@ -350,6 +358,8 @@ idAI* Conversation::GetActor(int index)
 		return NULL; 
 	}
 
+	_actorEntities[index] = static_cast<idAI*>(ent);
+
 	return static_cast<idAI*>(ent);
 }
 
@@ -417,6 +427,9 @@ void Conversation::Restore(idRestoreGame* savefile)
 		savefile->ReadString(_actors[i]);
 	}
 
+	// The entity cache is not saved, it is filled again on first use
+	_actorEntities.SetNum(num);
+
 	savefile->ReadInt(num);
 	_commands.SetNum(num);
 	for (int i = 0; i < num; i++)
@@ -459,6 +472,8 @@ void Conversation::InitFromSpawnArgs(const idDict& dict, int index)
 
 	DM_LOG(LC_CONVERSATION, LT_DEBUG)LOGSTRING("Conversation %s has %d actors.\r", _name.c_str(), _actors.Num());
 
+	_actorEntities.SetNum(_actors.Num());
+
 	if (_actors.Num() == 0)
 	{
 		_isValid = false; // no actors, no conversation
@@ -44,6 +44,10 @@ class Conversation
 	// All actors participating in this conversation
 	idStringList _actors;
 
+	// The resolved actor entities, parallel to _actors. Filled on first use
+	// and looked up again by name once the entity is gone or renamed.
+	idList< idEntityPtr<idAI> > _actorEntities;
+
 	// The list of commands this conversation consists of (this is the actual "script")
 	idList<ConversationCommandPtr> _commands;
 
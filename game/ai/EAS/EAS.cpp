@@ -28,6 +28,11 @@ static bool versioned = RegisterVersionedFile("$Id$");
 									// testing with the Outpost FM required bumping it to 21 so as not to wreck
 									// how the AI patrolled there.
 
+// The routing cache file
+#define EAS_FILE_EXTENSION "eas"
+#define EAS_FILE_MAGIC (('E' << 24) | ('A' << 16) | ('S' << 8) | 'C')
+#define EAS_FILE_VERSION 1
+
 namespace eas {
 
 tdmEAS::tdmEAS(idAASLocal* aas) :
@@ -86,15 +91,323 @@ void tdmEAS::Compile()
 	// First, allocate the memory for the cluster info structures
 	SetupClusterInfoStructures();
 
+	// The routing tables only change with the map, the AAS and the elevators,
+	// use the ones of the last compile if they match
+	idStr fileName = gameLocal.GetMapName();
+	fileName.SetFileExtension(va("%s." EAS_FILE_EXTENSION, _aas->name.c_str()));
+
+	unsigned int checksum = ComputeCacheChecksum();
+
+	if (LoadCache(fileName, checksum))
+	{
+		gameLocal.Printf("[%s]: Loaded %d elevator stations and the routing tables from %s.\n", _aas->name.c_str(), _elevatorStations.size(), fileName.c_str());
+		common->PacifierUpdate(LOAD_KEY_ROUTING_INTERIM, static_cast<int>(_clusterInfo.size()));
+		return;
+	}
+
 	// Then, traverse the registered elevators and assign their "stations" or floors to the clusters
 	AssignElevatorsToClusters();
 
 	// Now setup the connection information between clusters
 	SetupClusterRouting();
 
+	WriteCache(fileName, checksum);
+
 //	PrintClusterInfo(); // grayman - for debugging cluster data
 }
 
+unsigned int tdmEAS::ComputeCacheChecksum()
+{
+	unsigned long crc;
+	CRC32_InitChecksum(crc);
+
+	idMapFile* mapFile = gameLocal.GetLevelMap();
+	unsigned int geometryCRC = (mapFile != NULL) ? mapFile->GetGeometryCRC() : 0;
+	CRC32_UpdateChecksum(crc, &geometryCRC, sizeof(geometryCRC));
+
+	unsigned int aasCRC = _aas->file->GetCRC();
+	int numAreas = _aas->file->GetNumAreas();
+	int numClusters = _aas->file->GetNumClusters();
+	CRC32_UpdateChecksum(crc, &aasCRC, sizeof(aasCRC));
+	CRC32_UpdateChecksum(crc, &numAreas, sizeof(numAreas));
+	CRC32_UpdateChecksum(crc, &numClusters, sizeof(numClusters));
+
+	// The stations are found by the position origins, the elevator travel times depend on the speed
+	for (int i = 0; i < _elevators.Num(); i++)
+	{
+		CMultiStateMover* elevator = _elevators[i].GetEntity();
+
+		float moveSpeed = elevator->GetMoveSpeed();
+		CRC32_UpdateChecksum(crc, elevator->name.c_str(), elevator->name.Length() + 1);
+		CRC32_UpdateChecksum(crc, &moveSpeed, sizeof(moveSpeed));
+
+		const idList<MoverPositionInfo>& positionList = elevator->GetPositionInfoList();
+
+		for (int positionIdx = 0; positionIdx < positionList.Num(); positionIdx++)
+		{
+			CMultiStateMoverPosition* positionEnt = positionList[positionIdx].positionEnt.GetEntity();
+
+			idVec3 origin = positionEnt->GetPhysics()->GetOrigin();
+			CRC32_UpdateChecksum(crc, positionEnt->name.c_str(), positionEnt->name.Length() + 1);
+			CRC32_UpdateChecksum(crc, &origin, sizeof(origin));
+		}
+	}
+
+	CRC32_FinishChecksum(crc);
+
+	return static_cast<unsigned int>(crc);
+}
+
+bool tdmEAS::LoadCache(const char* fileName, unsigned int checksum)
+{
+	idFile* file = fileSystem->OpenFileRead(fileName);
+	if (file == NULL)
+	{
+		return false;
+	}
+
+	int magic, version, numClusters, numStations;
+	unsigned int fileChecksum;
+
+	file->ReadInt(magic);
+	file->ReadInt(version);
+	file->ReadUnsignedInt(fileChecksum);
+	file->ReadInt(numClusters);
+	file->ReadInt(numStations);
+
+	if (magic != EAS_FILE_MAGIC || version != EAS_FILE_VERSION || fileChecksum != checksum ||
+		numClusters != static_cast<int>(_clusterInfo.size()) || numStations < 0)
+	{
+		DM_LOG(LC_AI, LT_INFO)LOGSTRING("Elevator routing file %s is out of date\r", fileName);
+		fileSystem->CloseFile(file);
+		return false;
+	}
+
+	int numAreas = _aas->file->GetNumAreas();
+	bool valid = true;
+
+	// The stations are stored by elevator and position index
+	_elevatorStations.clear();
+	for (int i = 0; i < numStations && valid; i++)
+	{
+		int positionIdx;
+		ElevatorStationInfoPtr station(new ElevatorStationInfo);
+
+		file->ReadInt(station->elevatorNum);
+		file->ReadInt(positionIdx);
+		file->ReadInt(station->areaNum);
+		file->ReadInt(station->clusterNum);
+
+		if (station->elevatorNum < 0 || station->elevatorNum >= _elevators.Num() ||
+			station->areaNum <= 0 || station->areaNum >= numAreas ||
+			station->clusterNum < 0 || station->clusterNum >= numClusters)
+		{
+			valid = false;
+			break;
+		}
+
+		CMultiStateMover* elevator = _elevators[station->elevatorNum].GetEntity();
+		const idList<MoverPositionInfo>& positionList = elevator->GetPositionInfoList();
+
+		if (positionIdx < 0 || positionIdx >= positionList.Num())
+		{
+			valid = false;
+			break;
+		}
+
+		station->elevator = elevator;
+		station->elevatorPosition = positionList[positionIdx].positionEnt.GetEntity();
+
+		_elevatorStations.push_back(station);
+	}
+
+	for (int cluster = 0; cluster < numClusters && valid; cluster++)
+	{
+		ClusterInfo& info = *_clusterInfo[cluster];
+
+		int numElevatorStations, numReachable;
+		file->ReadInt(numElevatorStations);
+		file->ReadInt(numReachable);
+
+		info.numElevatorStations = static_cast<unsigned short>(numElevatorStations);
+
+		for (int i = 0; i < numReachable; i++)
+		{
+			int stationIdx;
+			file->ReadInt(stationIdx);
+
+			if (stationIdx < 0 || stationIdx >= numStations)
+			{
+				valid = false;
+				break;
+			}
+
+			info.reachableElevatorStations.push_back(_elevatorStations[stationIdx]);
+		}
+
+		for (int goalCluster = 0; goalCluster < numClusters && valid; goalCluster++)
+		{
+			int numRoutes;
+			file->ReadInt(numRoutes);
+
+			for (int i = 0; i < numRoutes && valid; i++)
+			{
+				int routeType, numNodes;
+				RouteInfoPtr route(new RouteInfo);
+
+				file->ReadInt(routeType);
+				file->ReadInt(route->target);
+				file->ReadInt(route->routeTravelTime);
+				file->ReadInt(numNodes);
+
+				route->routeType = static_cast<RouteType>(routeType);
+
+				if (routeType < 0 || routeType >= NUM_ROUTE_TYPES || numNodes < 0)
+				{
+					valid = false;
+					break;
+				}
+
+				for (int j = 0; j < numNodes; j++)
+				{
+					int actionType;
+					RouteNodePtr node(new RouteNode);
+
+					file->ReadInt(actionType);
+					file->ReadInt(node->toArea);
+					file->ReadInt(node->toCluster);
+					file->ReadInt(node->elevator);
+					file->ReadInt(node->elevatorStation);
+					file->ReadInt(node->nodeTravelTime);
+
+					node->type = static_cast<ActionType>(actionType);
+
+					if (actionType < 0 || actionType >= NUM_ACTIONS ||
+						node->toArea < 0 || node->toArea >= numAreas ||
+						node->toCluster < 0 || node->toCluster >= numClusters ||
+						node->elevator < -1 || node->elevator >= _elevators.Num() ||
+						node->elevatorStation < -1 || node->elevatorStation >= numStations)
+					{
+						valid = false;
+						break;
+					}
+
+					route->routeNodes.push_back(node);
+				}
+
+				info.routeToCluster[goalCluster].push_back(route);
+			}
+		}
+	}
+
+	// A truncated file reads zeros, check that the end marker made it
+	if (valid)
+	{
+		file->ReadInt(magic);
+		valid = (magic == EAS_FILE_MAGIC);
+	}
+
+	fileSystem->CloseFile(file);
+
+	if (!valid)
+	{
+		DM_LOG(LC_AI, LT_WARNING)LOGSTRING("Elevator routing file %s is damaged\r", fileName);
+
+		// Start over with empty structures
+		_elevatorStations.clear();
+		SetupClusterInfoStructures();
+		return false;
+	}
+
+	return true;
+}
+
+void tdmEAS::WriteCache(const char* fileName, unsigned int checksum) const
+{
+	idFile* file = fileSystem->OpenFileWrite(fileName);
+	if (file == NULL)
+	{
+		DM_LOG(LC_AI, LT_WARNING)LOGSTRING("Couldn't write elevator routing file %s\r", fileName);
+		return;
+	}
+
+	file->WriteInt(EAS_FILE_MAGIC);
+	file->WriteInt(EAS_FILE_VERSION);
+	file->WriteUnsignedInt(checksum);
+	file->WriteInt(static_cast<int>(_clusterInfo.size()));
+	file->WriteInt(static_cast<int>(_elevatorStations.size()));
+
+	for (std::size_t i = 0; i < _elevatorStations.size(); i++)
+	{
+		const ElevatorStationInfo& station = *_elevatorStations[i];
+		const idList<MoverPositionInfo>& positionList = station.elevator.GetEntity()->GetPositionInfoList();
+
+		int positionIdx = 0;
+		while (positionIdx < positionList.Num() && positionList[positionIdx].positionEnt.GetEntity() != station.elevatorPosition.GetEntity())
+		{
+			positionIdx++;
+		}
+
+		file->WriteInt(station.elevatorNum);
+		file->WriteInt(positionIdx);
+		file->WriteInt(station.areaNum);
+		file->WriteInt(station.clusterNum);
+	}
+
+	for (std::size_t cluster = 0; cluster < _clusterInfo.size(); cluster++)
+	{
+		const ClusterInfo& info = *_clusterInfo[cluster];
+
+		file->WriteInt(static_cast<int>(info.numElevatorStations));
+		file->WriteInt(static_cast<int>(info.reachableElevatorStations.size()));
+
+		for (ElevatorStationInfoList::const_iterator i = info.reachableElevatorStations.begin();
+			 i != info.reachableElevatorStations.end(); ++i)
+		{
+			int stationIdx = 0;
+			while (_elevatorStations[stationIdx] != *i)
+			{
+				stationIdx++;
+			}
+
+			file->WriteInt(stationIdx);
+		}
+
+		for (std::size_t goalCluster = 0; goalCluster < info.routeToCluster.size(); goalCluster++)
+		{
+			const RouteInfoList& routes = info.routeToCluster[goalCluster];
+
+			file->WriteInt(static_cast<int>(routes.size()));
+
+			for (RouteInfoList::const_iterator r = routes.begin(); r != routes.end(); ++r)
+			{
+				const RouteInfo& route = **r;
+
+				file->WriteInt(static_cast<int>(route.routeType));
+				file->WriteInt(route.target);
+				file->WriteInt(route.routeTravelTime);
+				file->WriteInt(static_cast<int>(route.routeNodes.size()));
+
+				for (RouteNodeList::const_iterator n = route.routeNodes.begin(); n != route.routeNodes.end(); ++n)
+				{
+					const RouteNode& node = **n;
+
+					file->WriteInt(static_cast<int>(node.type));
+					file->WriteInt(node.toArea);
+					file->WriteInt(node.toCluster);
+					file->WriteInt(node.elevator);
+					file->WriteInt(node.elevatorStation);
+					file->WriteInt(node.nodeTravelTime);
+				}
+			}
+		}
+	}
+
+	file->WriteInt(EAS_FILE_MAGIC);
+
+	fileSystem->CloseFile(file);
+}
+
 void tdmEAS::SetupClusterInfoStructures() 
 {
 	// Clear the vector and allocate a new one (one structure ptr for each cluster)
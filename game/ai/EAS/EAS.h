@@ -109,6 +109,12 @@ public:
 //	void PrintClusterInfo();
 
 private:
+	// The routing tables are cached in <map>.<aas>.eas, keyed by this checksum
+	// of the map geometry, the AAS and the elevators
+	unsigned int ComputeCacheChecksum();
+	bool LoadCache(const char* fileName, unsigned int checksum);
+	void WriteCache(const char* fileName, unsigned int checksum) const;
+
 	void SetupClusterInfoStructures();
 	void AssignElevatorsToClusters();
 
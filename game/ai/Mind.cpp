@@ -104,7 +104,8 @@ void Mind::Think()
 		state->Think(owner);
 	}
 
-	// Try to perform the subsystem tasks, skipping inactive subsystems
+	// Try to perform the subsystem tasks, skipping inactive subsystems and
+	// tasks that aren't due yet (Task::GetUpdateInterval).
 	// Maximum number of tries is SubsystemCount.
 	for ( int i = 0 ; i < static_cast<int>(SubsystemCount) ; i++ )
 	{
@@ -389,6 +390,8 @@ bool Mind::PerformCombatCheck()
 
 void Mind::Save(idSaveGame* savefile) const 
 {
+	idSaveGameProfileScope profile(savefile, "ai::Mind");
+
 	_owner.Save(savefile);
 	_stateQueue.Save(savefile);
 	_memory.Save(savefile);
@@ -396,6 +399,8 @@ void Mind::Save(idSaveGame* savefile) const
 
 void Mind::Restore(idRestoreGame* savefile) 
 {
+	idSaveGameProfileScope profile(savefile, "ai::Mind");
+
 	_owner.Restore(savefile);
 	_stateQueue.Restore(savefile);
 	_memory.Restore(savefile);
@@ -49,6 +49,7 @@ idMoveState::idMoveState() {
 	lastMoveTime		= 0;
 	anim				= 0;
 	accuracy			= -1;
+	routeQuery			= -1;
 }
 
 /*
@@ -107,4 +108,7 @@ void idMoveState::Restore( idRestoreGame *savefile ) {
 	savefile->ReadInt( anim );
 	savefile->ReadFloat( accuracy );
 
+	// the route queries aren't saved, GetMovePos sets the route up right away
+	routeQuery = -1;
+
 }
@@ -107,6 +107,8 @@ public:
 	// angua: the distance at which the AI will see a position as reached
 	// if < 0, the AI will use their bounding box for this check as before
 	float					accuracy;
+	// the queued AAS route query of a MoveToPosition waiting for its route, -1 if none (not saved)
+	int						routeQuery;
 };
 
 #endif /* __AI_MOVESTATE_H__ */
@@ -124,6 +124,21 @@ const int VIS_STIM_DELAY_MAX = 1000; // grayman #2924 - max amount of time delay
 // The following defines a key that should be non-0 if the device should be closed
 #define AIUSE_SHOULDBECLOSED_KEY		"shouldBeClosed"
 
+//----------------------------------------------------------------------------------------
+// Spawnargs read for every visual stim, hashed once
+static const idDictKey key_AIUse("AIUse");
+static const idDictKey key_chanceNoticeLight("chanceNoticeLight");
+static const idDictKey key_chanceNoticePerson("chanceNoticePerson");
+static const idDictKey key_chanceNoticeWeapon("chanceNoticeWeapon");
+static const idDictKey key_chanceNoticeDoor("chanceNoticeDoor");
+static const idDictKey key_chanceNoticeSuspiciousItem("chanceNoticeSuspiciousItem");
+static const idDictKey key_chanceNoticeRope("chanceNoticeRope");
+static const idDictKey key_chanceNoticeBlood("chanceNoticeBlood");
+static const idDictKey key_chanceNoticeMissingItem("chanceNoticeMissingItem");
+static const idDictKey key_chanceNoticeMonster("chanceNoticeMonster");
+static const idDictKey key_chanceNoticeUndead("chanceNoticeUndead");
+static const idDictKey key_chanceNoticeBrokenItem("chanceNoticeBrokenItem");
+
 //----------------------------------------------------------------------------------------
 
 void State::Init(idAI* owner)
@@ -594,7 +609,7 @@ void State::OnVisualStim(idEntity* stimSource)
 	}
 
 	// Get AI use of the stim
-	idStr aiUse = stimSource->spawnArgs.GetString("AIUse");
+	idStr aiUse = stimSource->spawnArgs.GetString(key_AIUse);
 
 	// grayman #2603
 
@@ -615,57 +630,57 @@ void State::OnVisualStim(idEntity* stimSource)
 	if (aiUse == AIUSE_LIGHTSOURCE)
 	{
 		aiUseType = EAIuse_Lightsource;
-		chanceToNotice = owner->spawnArgs.GetFloat("chanceNoticeLight");
+		chanceToNotice = owner->spawnArgs.GetFloat(key_chanceNoticeLight);
 	}
 	else if (aiUse == AIUSE_PERSON)
 	{
 		aiUseType = EAIuse_Person;
-		chanceToNotice = owner->spawnArgs.GetFloat("chanceNoticePerson");
+		chanceToNotice = owner->spawnArgs.GetFloat(key_chanceNoticePerson);
 	}
 	else if (aiUse == AIUSE_WEAPON)
 	{
 		aiUseType = EAIuse_Weapon;
-		chanceToNotice = owner->spawnArgs.GetFloat("chanceNoticeWeapon");
+		chanceToNotice = owner->spawnArgs.GetFloat(key_chanceNoticeWeapon);
 	}
 	else if (aiUse == AIUSE_DOOR)
 	{
 		aiUseType = EAIuse_Door;
-		chanceToNotice = owner->spawnArgs.GetFloat("chanceNoticeDoor");
+		chanceToNotice = owner->spawnArgs.GetFloat(key_chanceNoticeDoor);
 	}
 	else if (aiUse == AIUSE_SUSPICIOUS) // grayman #1327
 	{
 		aiUseType = EAIuse_Suspicious;
-		chanceToNotice = owner->spawnArgs.GetFloat("chanceNoticeSuspiciousItem");
+		chanceToNotice = owner->spawnArgs.GetFloat(key_chanceNoticeSuspiciousItem);
 	}
 	else if (aiUse == AIUSE_ROPE) // grayman #2872
 	{
 		aiUseType = EAIuse_Rope;
-		chanceToNotice = owner->spawnArgs.GetFloat("chanceNoticeRope","0.0");
+		chanceToNotice = owner->spawnArgs.GetFloat(key_chanceNoticeRope, "0.0");
 	}
 	else if (aiUse == AIUSE_BLOOD_EVIDENCE)
 	{
 		aiUseType = EAIuse_Blood_Evidence;
-		chanceToNotice = owner->spawnArgs.GetFloat("chanceNoticeBlood");
+		chanceToNotice = owner->spawnArgs.GetFloat(key_chanceNoticeBlood);
 	}
 	else if (aiUse == AIUSE_MISSING_ITEM_MARKER)
 	{
 		aiUseType = EAIuse_Missing_Item_Marker;
-		chanceToNotice = owner->spawnArgs.GetFloat("chanceNoticeMissingItem");
+		chanceToNotice = owner->spawnArgs.GetFloat(key_chanceNoticeMissingItem);
 	}
 	else if (aiUse == AIUSE_MONSTER) // grayman #3331
 	{
 		aiUseType = EAIuse_Monster;
-		chanceToNotice = owner->spawnArgs.GetFloat("chanceNoticeMonster");
+		chanceToNotice = owner->spawnArgs.GetFloat(key_chanceNoticeMonster);
 	}
 	else if (aiUse == AIUSE_UNDEAD) // grayman #3343
 	{
 		aiUseType = EAIuse_Undead;
-		chanceToNotice = owner->spawnArgs.GetFloat("chanceNoticeUndead");
+		chanceToNotice = owner->spawnArgs.GetFloat(key_chanceNoticeUndead);
 	}
 	else if (aiUse == AIUSE_BROKEN_ITEM)
 	{
 		aiUseType = EAIuse_Broken_Item;
-		chanceToNotice = owner->spawnArgs.GetFloat("chanceNoticeBrokenItem");
+		chanceToNotice = owner->spawnArgs.GetFloat(key_chanceNoticeBrokenItem);
 	}
 	else // grayman #2885 - no AIUse spawnarg, so we don't know what it is
 	{
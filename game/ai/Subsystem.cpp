@@ -29,10 +29,21 @@ static bool versioned = RegisterVersionedFile("$Id$");
 namespace ai
 {
 
+struct TaskStats
+{
+	idStr	name;
+	int		performs;
+	double	ticks;
+};
+
+// The tdm_ai_task_stats counters, by task name
+static idHashTable<TaskStats> taskStats;
+
 Subsystem::Subsystem(SubsystemId subsystemId, idAI* owner) :
 	_id(subsystemId),
 	_initTask(false),
-	_enabled(false)
+	_enabled(false),
+	_nextPerformTime(0)
 {
 	assert(owner != NULL);
 	_owner = owner;
@@ -85,8 +96,15 @@ bool Subsystem::PerformTask()
 		return false;
 	}
 
-	// Pick the foremost task from the queue
-	const TaskPtr& task = _taskQueue.front();
+	// The current task doesn't need to be performed yet, let the next subsystem have the turn
+	if (!_initTask && gameLocal.time < _nextPerformTime)
+	{
+		return false;
+	}
+
+	// Pick the foremost task from the queue, keep a reference in case the
+	// task gets switched while it is performing
+	TaskPtr task = _taskQueue.front();
 
 	// No NULL pointers allowed
 	assert(task != NULL);
@@ -95,6 +113,7 @@ bool Subsystem::PerformTask()
 	{
 		// New task, let's initialise it
 		_initTask = false;
+		_nextPerformTime = 0;
 
 		// Initialise the newcomer
 		task->Init(_owner.GetEntity(), *this);
@@ -107,8 +126,44 @@ bool Subsystem::PerformTask()
 		}
 	}
 
+	int interval = task->GetUpdateInterval();
+
+	if (interval > 0)
+	{
+		_nextPerformTime = gameLocal.time + interval;
+	}
+
+	bool finished;
+
+	if (cv_ai_task_stats.GetBool())
+	{
+		double start = sys->GetClockTicks();
+
+		finished = task->Perform(*this);
+
+		TaskStats* stats;
+
+		if (!taskStats.Get(task->GetName(), &stats))
+		{
+			TaskStats newStats;
+			newStats.name = task->GetName();
+			newStats.performs = 0;
+			newStats.ticks = 0;
+
+			taskStats.Set(task->GetName(), newStats);
+			taskStats.Get(task->GetName(), &stats);
+		}
+
+		stats->performs++;
+		stats->ticks += sys->GetClockTicks() - start;
+	}
+	else
+	{
+		finished = task->Perform(*this);
+	}
+
 	// greebo: If the task returns TRUE, it will be removed next round.
-	if (task->Perform(*this))
+	if (finished)
 	{
 		FinishTask();
 	}
@@ -340,6 +395,7 @@ void Subsystem::Save(idSaveGame* savefile) const
 
 	savefile->WriteBool(_enabled);
 	savefile->WriteBool(_initTask);
+	savefile->WriteInt(_nextPerformTime);
 
 	_taskQueue.Save(savefile);
 
@@ -357,9 +413,43 @@ void Subsystem::Restore(idRestoreGame* savefile)
 
 	savefile->ReadBool(_enabled);
 	savefile->ReadBool(_initTask);
+	savefile->ReadInt(_nextPerformTime);
 
 	_taskQueue.Restore(savefile);
 	_recycleBin.Restore(savefile);
 }
 
+void Subsystem::ListTaskStats(bool clear)
+{
+	if (taskStats.Num() == 0)
+	{
+		gameLocal.Printf("No task stats, set tdm_ai_task_stats to collect them.\n");
+		return;
+	}
+
+	double ticksPerMsec = sys->ClockTicksPerSecond() / 1000.0;
+	int totalPerforms = 0;
+	double totalTicks = 0;
+
+	gameLocal.Printf("performs   total ms   us/perform  task\n");
+
+	for (int i = 0; i < taskStats.Num(); i++)
+	{
+		const TaskStats* stats = taskStats.GetIndex(i);
+
+		gameLocal.Printf("%8d %10.2f %12.2f  %s\n", stats->performs, stats->ticks / ticksPerMsec, 
+			stats->ticks * 1000.0 / ticksPerMsec / Max(stats->performs, 1), stats->name.c_str());
+
+		totalPerforms += stats->performs;
+		totalTicks += stats->ticks;
+	}
+
+	gameLocal.Printf("%8d %10.2f               total\n", totalPerforms, totalTicks / ticksPerMsec);
+
+	if (clear)
+	{
+		taskStats.Clear();
+	}
+}
+
 } // namespace ai
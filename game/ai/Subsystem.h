@@ -58,6 +58,9 @@ protected:
 	// TRUE if this subsystem is performing, default is ON
 	bool _enabled;
 
+	// The current task is not performed before this time (Task::GetUpdateInterval)
+	int _nextPerformTime;
+
 public:
 	Subsystem(SubsystemId subsystemId, idAI* owner);
 
@@ -124,6 +127,9 @@ public:
 
 	// Returns some debug text for console or renderworld display
 	virtual idStr GetDebugInfo();
+
+	// Prints the number of performs and the time spent per task, collected while tdm_ai_task_stats is set
+	static void ListTaskStats(bool clear);
 };
 typedef boost::shared_ptr<Subsystem> SubsystemPtr;
 
@@ -47,6 +47,12 @@ const idStr& IdleAnimationTask::GetName() const
 	return _name;
 }
 
+// The idle animations are seconds apart
+int IdleAnimationTask::GetUpdateInterval() const
+{
+	return 100;
+}
+
 void IdleAnimationTask::Init(idAI* owner, Subsystem& subsystem)
 {
 	// Just init the base class
@@ -51,6 +51,9 @@ public:
 	// Get the name of this task
 	virtual const idStr& GetName() const;
 
+	// Mostly waits for the next idle animation
+	virtual int GetUpdateInterval() const;
+
 	// Override the base Init method
 	virtual void Init(idAI* owner, Subsystem& subsystem);
 
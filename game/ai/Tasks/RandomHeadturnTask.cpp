@@ -36,6 +36,12 @@ const idStr& RandomHeadturnTask::GetName() const
 	return _name;
 }
 
+// The head turns and the pauses between them last seconds
+int RandomHeadturnTask::GetUpdateInterval() const
+{
+	return 100;
+}
+
 void RandomHeadturnTask::Init(idAI* owner, Subsystem& subsystem)
 {
 	// Just init the base class
@@ -38,6 +38,9 @@ public:
 	// Get the name of this task
 	virtual const idStr& GetName() const;
 
+	// Checks a timer, doesn't need to run every think
+	virtual int GetUpdateInterval() const;
+
 	// Override the base Init method
 	virtual void Init(idAI* owner, Subsystem& subsystem);
 
@@ -52,6 +52,12 @@ const idStr& RepeatedBarkTask::GetName() const
 	return _name;
 }
 
+// The barks are seconds apart, there's no need to check the time every think
+int RepeatedBarkTask::GetUpdateInterval() const
+{
+	return 200;
+}
+
 void RepeatedBarkTask::Init(idAI* owner, Subsystem& subsystem)
 {
 	// Init the base class
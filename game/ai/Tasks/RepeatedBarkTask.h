@@ -61,6 +61,9 @@ public:
 	// Get the name of this task
 	virtual const idStr& GetName() const;
 
+	// Waits for the next bark time, a few checks per second are enough
+	virtual int GetUpdateInterval() const;
+
 	// Override the base Init method
 	virtual void Init(idAI* owner, Subsystem& subsystem);
 
@@ -69,6 +69,14 @@ public:
 	// Returns TRUE if the task is finished, FALSE if it should continue.
 	virtual bool Perform(Subsystem& subsystem) = 0;
 
+	// The milliseconds between two Perform() calls the task needs, 0 means every
+	// time its subsystem gets its turn. A task that isn't due yet gives the turn
+	// to the next subsystem, see Mind::Think().
+	virtual int GetUpdateInterval() const
+	{
+		return 0;
+	}
+
 	// Let the task perform some initialisation. This is called
 	// right after the task is installed into the subsystem.
 	virtual void Init(idAI* owner, Subsystem& subsystem)
@@ -0,0 +1,177 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+#include "precompiled_game.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "VisualScanScheduler.h"
+#include "../Game_local.h"
+
+namespace ai
+{
+
+void VisualScanScheduler::Clear()
+{
+	_results.Clear();
+	_requests.Clear();
+	_sights.Clear();
+	_traceRequests.Clear();
+	_traces.Clear();
+}
+
+void VisualScanScheduler::Trace(idAI* observer, idActor* target, Result& result)
+{
+	result.observer = observer;
+	result.target = target;
+	result.time = gameLocal.time;
+	result.canSee = observer->CanSeeExt(target, false, false);
+}
+
+int VisualScanScheduler::SortByPriority(const Request* a, const Request* b)
+{
+	if (a->priority > b->priority)
+	{
+		return -1;
+	}
+
+	return (a->priority < b->priority) ? 1 : 0;
+}
+
+void VisualScanScheduler::RunFrame()
+{
+	const int budget = cv_ai_visscan_budget.GetInteger();
+	const int maxAge = cv_ai_visscan_maxage.GetInteger();
+
+	// more alert AI first, then the oldest results
+	for (int i = 0; i < _requests.Num(); i++)
+	{
+		const Result& result = _results[_requests[i].observerNum];
+		idAI* observer = result.observer.GetEntity();
+
+		_requests[i].priority = (observer != NULL) ? observer->AI_AlertIndex * 1000000.0f + (gameLocal.time - result.time) : -1.0f;
+	}
+
+	_requests.Sort(SortByPriority);
+
+	_sights.SetNum(0, false);
+
+	for (int i = 0; i < _requests.Num(); i++)
+	{
+		Result& result = _results[_requests[i].observerNum];
+		idAI* observer = result.observer.GetEntity();
+		idActor* target = result.target.GetEntity();
+
+		if (observer == NULL || target == NULL)
+		{
+			continue;
+		}
+
+		// Alerted AI always get a fresh result, the others as far as the budget goes
+		if (_sights.Num() < budget || observer->AI_AlertIndex >= ESuspicious || gameLocal.time - result.time >= maxAge)
+		{
+			result.time = gameLocal.time;
+			result.canSee = false;
+
+			Sight& sight = _sights.Alloc();
+			sight.observerNum = _requests[i].observerNum;
+
+			if (!observer->GetSightTracePoints(target, sight.points))
+			{
+				_sights.RemoveIndex(_sights.Num() - 1);
+			}
+		}
+	}
+
+	_requests.SetNum(0, false);
+
+	// Same traces as idActor::CanSee, the first point for all observers in one batch,
+	// then the next point for those that didn't see their target yet
+	for (int point = 0; point < 4 && _sights.Num() > 0; point++)
+	{
+		_traceRequests.SetNum(_sights.Num(), false);
+		_traces.SetNum(_sights.Num(), false);
+
+		for (int i = 0; i < _sights.Num(); i++)
+		{
+			idAI* observer = _results[_sights[i].observerNum].observer.GetEntity();
+			clipTraceRequest_t& request = _traceRequests[i];
+
+			request.start = observer->GetEyePosition();
+			request.end = _sights[i].points[point];
+			request.bounds.Zero();
+			request.contentMask = MASK_OPAQUE;
+			request.passEntity = observer;
+		}
+
+		gameLocal.clip.TranslationBatch(_traces.Ptr(), _traceRequests.Ptr(), _traceRequests.Num());
+
+		for (int i = _sights.Num() - 1; i >= 0; i--)
+		{
+			Result& result = _results[_sights[i].observerNum];
+
+			if (_traces[i].fraction >= 1.0f || gameLocal.GetTraceEntity(_traces[i]) == result.target.GetEntity())
+			{
+				result.canSee = true;
+				_sights.RemoveIndex(i);
+			}
+		}
+	}
+}
+
+bool VisualScanScheduler::CanSee(idAI* observer, idActor* target)
+{
+	if (cv_ai_visscan_budget.GetInteger() <= 0)
+	{
+		return observer->CanSeeExt(target, false, false);
+	}
+
+	if (_results.Num() == 0)
+	{
+		Result empty;
+		empty.time = 0;
+		empty.canSee = false;
+		empty.requestFrame = -1;
+		_results.AssureSize(MAX_GENTITIES, empty);
+	}
+
+	Result& result = _results[observer->entityNumber];
+
+	// Nothing usable from the batch, trace right away
+	if (result.observer.GetEntity() != observer || result.target.GetEntity() != target
+		|| gameLocal.time - result.time > cv_ai_visscan_maxage.GetInteger())
+	{
+		Trace(observer, target, result);
+	}
+
+	// queue the next trace for the batch, once per frame
+	if (result.requestFrame != gameLocal.framenum)
+	{
+		result.requestFrame = gameLocal.framenum;
+
+		Request& request = _requests.Alloc();
+		request.observerNum = observer->entityNumber;
+		request.priority = 0;
+	}
+
+	return result.canSee;
+}
+
+} // namespace ai
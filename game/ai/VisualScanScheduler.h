@@ -0,0 +1,94 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+#ifndef __VISUAL_SCAN_SCHEDULER_H__
+#define __VISUAL_SCAN_SCHEDULER_H__
+
+class idAI;
+class idActor;
+
+namespace ai
+{
+
+/**
+ * The line of sight traces of the AI visual scans (idAI::PerformVisualScan). The AI that
+ * asked during a frame are traced in one batch at the start of the next, at most
+ * tdm_ai_visscan_budget of them, more alert AI and older results first. The others get
+ * their last result, which is never older than tdm_ai_visscan_maxage.
+ */
+class VisualScanScheduler
+{
+private:
+	struct Result
+	{
+		idEntityPtr<idAI>		observer;
+		idEntityPtr<idActor>	target;
+		int						time;			// game time of the trace
+		bool					canSee;
+		int						requestFrame;	// the frame the observer last asked in
+	};
+
+	// indexed by the observer's entity number
+	idList<Result> _results;
+
+	struct Request
+	{
+		int		observerNum;
+		float	priority;
+	};
+
+	// the observers that asked since the last batch
+	idList<Request> _requests;
+
+	struct Sight
+	{
+		int		observerNum;
+		idVec3	points[4];	// see idActor::GetSightTracePoints
+	};
+
+	// the observers traced in this batch that didn't see their target yet
+	idList<Sight> _sights;
+
+	idList<clipTraceRequest_t> _traceRequests;
+	idList<trace_t> _traces;
+
+public:
+	void Clear();
+
+	/**
+	 * Runs the traces for the observers that asked last frame, call once per frame before the
+	 * entities think.
+	 */
+	void RunFrame();
+
+	/**
+	 * Same as observer->CanSeeExt(target, false, false), occlusion only, but may return the
+	 * result of an earlier frame.
+	 */
+	bool CanSee(idAI* observer, idActor* target);
+
+private:
+	void Trace(idAI* observer, idActor* target, Result& result);
+
+	static int SortByPriority(const Request* a, const Request* b);
+};
+
+} // namespace ai
+
+#endif /* __VISUAL_SCAN_SCHEDULER_H__ */
@@ -44,6 +44,7 @@ idMD5Anim::idMD5Anim() {
 	numJoints	= 0;
 	frameRate	= 24;
 	animLength	= 0;
+	componentBits = 0;
 	totaldelta.Zero();
 }
 
@@ -73,6 +74,11 @@ void idMD5Anim::Free( void ) {
 	jointInfo.Clear();
 	bounds.Clear();
 	componentFrames.Clear();
+	componentBits = 0;
+	byteFrames.Clear();
+	shortFrames.Clear();
+	componentBias.Clear();
+	componentScale.Clear();
 }
 
 /*
@@ -141,9 +147,115 @@ idMD5Anim::Allocated
 */
 size_t idMD5Anim::Allocated( void ) const {
 	size_t	size = bounds.Allocated() + jointInfo.Allocated() + componentFrames.Allocated() + name.Allocated();
+	size += byteFrames.Allocated() + shortFrames.Allocated() + componentBias.Allocated() + componentScale.Allocated();
 	return size;
 }
 
+/*
+====================
+idMD5Anim::CompressionSavings
+
+Bytes saved by quantizing the frames
+====================
+*/
+size_t idMD5Anim::CompressionSavings( void ) const {
+	if ( !componentBits ) {
+		return 0;
+	}
+	size_t floatSize = numFrames * numAnimatedComponents * sizeof( float );
+	size_t compressedSize = byteFrames.Allocated() + shortFrames.Allocated() + componentBias.Allocated() + componentScale.Allocated();
+	return ( floatSize > compressedSize ) ? floatSize - compressedSize : 0;
+}
+
+/*
+====================
+idMD5Anim::CompressFrames
+
+Quantizes every animated component to the given number of bits over its range in the
+anim. The float frames are freed, GetFrameComponents decodes the quantized ones.
+====================
+*/
+void idMD5Anim::CompressFrames( int bits ) {
+	int i, j;
+
+	if ( bits <= 0 || !numAnimatedComponents || componentBits ) {
+		return;
+	}
+	bits = Min( bits, 16 );
+
+	const int maxQuant = ( 1 << bits ) - 1;
+
+	componentBias.SetGranularity( 1 );
+	componentBias.SetNum( numAnimatedComponents );
+	componentScale.SetGranularity( 1 );
+	componentScale.SetNum( numAnimatedComponents );
+
+	for ( i = 0; i < numAnimatedComponents; i++ ) {
+		float min, max;
+		min = max = componentFrames[ i ];
+		for ( j = 1; j < numFrames; j++ ) {
+			const float v = componentFrames[ j * numAnimatedComponents + i ];
+			if ( v < min ) {
+				min = v;
+			} else if ( v > max ) {
+				max = v;
+			}
+		}
+		componentBias[ i ] = min;
+		componentScale[ i ] = ( max - min ) / maxQuant;
+	}
+
+	if ( bits <= 8 ) {
+		byteFrames.SetGranularity( 1 );
+		byteFrames.SetNum( componentFrames.Num() );
+	} else {
+		shortFrames.SetGranularity( 1 );
+		shortFrames.SetNum( componentFrames.Num() );
+	}
+
+	for ( j = 0; j < numFrames; j++ ) {
+		for ( i = 0; i < numAnimatedComponents; i++ ) {
+			const int index = j * numAnimatedComponents + i;
+			int q = 0;
+			if ( componentScale[ i ] > 0.0f ) {
+				q = idMath::Ftoi( ( componentFrames[ index ] - componentBias[ i ] ) / componentScale[ i ] + 0.5f );
+				q = idMath::ClampInt( 0, maxQuant, q );
+			}
+			if ( bits <= 8 ) {
+				byteFrames[ index ] = q;
+			} else {
+				shortFrames[ index ] = q;
+			}
+		}
+	}
+
+	componentFrames.Clear();
+	componentBits = bits;
+}
+
+/*
+====================
+idMD5Anim::GetFrameComponents
+
+Returns count animated components of a frame starting at the component first. Compressed
+frames are decoded into buffer, which must hold count floats.
+====================
+*/
+const float *idMD5Anim::GetFrameComponents( int framenum, int first, int count, float *buffer ) const {
+	const int offset = framenum * numAnimatedComponents + first;
+
+	if ( !componentBits ) {
+		return &componentFrames[ offset ];
+	}
+
+	if ( componentBits <= 8 ) {
+		SIMDProcessor->Dequantize( buffer, byteFrames.Ptr() + offset, componentBias.Ptr() + first, componentScale.Ptr() + first, count );
+	} else {
+		SIMDProcessor->Dequantize( buffer, shortFrames.Ptr() + offset, componentBias.Ptr() + first, componentScale.Ptr() + first, count );
+	}
+	return buffer;
+}
+
 /*
 ====================
 idMD5Anim::LoadAnim
@@ -155,6 +267,22 @@ bool idMD5Anim::LoadAnim( const char *filename ) {
 	idToken	token;
 	int		i, j;
 	int		num;
+	ID_TIME_T	textTimeStamp;
+	int		textLength;
+	idStr	binaryName;
+
+	// the binary version is valid as long as the text file keeps its length and timestamp
+	textLength = fileSystem->ReadFile( filename, NULL, &textTimeStamp );
+	if ( textLength < 0 ) {
+		return false;
+	}
+	binaryName = filename;
+	binaryName += MD5_BINARY_SUFFIX;
+	if ( cv_anim_binary.GetBool() && LoadBinaryAnim( binaryName, textLength, textTimeStamp ) ) {
+		name = filename;
+		CompressFrames( cv_anim_compress.GetInteger() );
+		return true;
+	}
 
 	if ( !parser.LoadFile( filename ) ) {
 		return false;
@@ -317,10 +445,176 @@ bool idMD5Anim::LoadAnim( const char *filename ) {
 	// we don't count last frame because it would cause a 1 frame pause at the end
 	animLength = ( ( numFrames - 1 ) * 1000 + frameRate - 1 ) / frameRate;
 
+	if ( cv_anim_binary.GetBool() ) {
+		WriteBinaryAnim( binaryName, textLength, textTimeStamp );
+	}
+
+	CompressFrames( cv_anim_compress.GetInteger() );
+
 	// done
 	return true;
 }
 
+/*
+====================
+MD5Anim_WriteBinaryList
+====================
+*/
+template< class type >
+static void MD5Anim_WriteBinaryList( idFile *f, const idList<type> &list ) {
+	f->WriteInt( list.Num() );
+	f->Write( list.Ptr(), list.Num() * sizeof( type ) );
+}
+
+/*
+====================
+MD5Anim_ReadBinaryList
+====================
+*/
+template< class type >
+static bool MD5Anim_ReadBinaryList( idFile *f, idList<type> &list, int expectedNum ) {
+	int num;
+	f->ReadInt( num );
+	if ( num != expectedNum || (long long)num * sizeof( type ) > f->Length() - f->Tell() ) {
+		return false;
+	}
+	list.SetGranularity( 1 );
+	list.SetNum( num );
+	f->Read( list.Ptr(), num * sizeof( type ) );
+	return true;
+}
+
+/*
+====================
+MD5Anim_ReadBinaryString
+====================
+*/
+static bool MD5Anim_ReadBinaryString( idFile *f, idStr &string ) {
+	int length;
+	f->ReadInt( length );
+	if ( length < 0 || length > f->Length() - f->Tell() ) {
+		return false;
+	}
+	string.Fill( ' ', length );
+	f->Read( &string[0], length );
+	return true;
+}
+
+/*
+====================
+idMD5Anim::WriteBinaryAnim
+
+Stores the anim as it is after LoadAnim, with the move delta already taken out of
+the root joint, so loading it is a few block reads.
+====================
+*/
+void idMD5Anim::WriteBinaryAnim( const char *filename, int textLength, ID_TIME_T textTimeStamp ) const {
+	int i;
+	idFile_Memory f( filename );
+
+	f.SetGranularity( 256 * 1024 );
+
+	// header, all native so a build with a different layout rejects it
+	f.Write( MD5_ANIM_BINARY_ID, 4 );
+	f.WriteInt( MD5_BINARY_VERSION );
+	f.WriteInt( MD5_VERSION );
+	f.WriteInt( sizeof( idJointQuat ) );
+	f.WriteInt( textLength );
+	f.Write( &textTimeStamp, sizeof( textTimeStamp ) );
+
+	f.WriteInt( numFrames );
+	f.WriteInt( frameRate );
+	f.WriteInt( animLength );
+	f.WriteInt( numJoints );
+	f.WriteInt( numAnimatedComponents );
+	f.WriteVec3( totaldelta );
+
+	// the joint names are indexes into the animation manager, so store the names
+	for ( i = 0; i < numJoints; i++ ) {
+		f.WriteString( animationLib.JointName( jointInfo[ i ].nameIndex ) );
+		f.WriteInt( jointInfo[ i ].parentNum );
+		f.WriteInt( jointInfo[ i ].animBits );
+		f.WriteInt( jointInfo[ i ].firstComponent );
+	}
+
+	MD5Anim_WriteBinaryList( &f, bounds );
+	MD5Anim_WriteBinaryList( &f, baseFrame );
+	MD5Anim_WriteBinaryList( &f, componentFrames );
+
+	fileSystem->WriteFile( filename, f.GetDataPtr(), f.Length() );
+}
+
+/*
+====================
+idMD5Anim::LoadBinaryAnim
+
+Returns false if the binary file is missing, out of date or damaged, the anim
+must be loaded from the text file then.
+====================
+*/
+bool idMD5Anim::LoadBinaryAnim( const char *filename, int textLength, ID_TIME_T textTimeStamp ) {
+	const char *buffer;
+	int i, length, version, md5Version, jointQuatSize, fileTextLength;
+	ID_TIME_T fileTimeStamp;
+	char id[4];
+	idStr jointName;
+
+	length = fileSystem->ReadFileMapped( filename, (const void **)&buffer, NULL );
+	if ( length < 0 || !buffer ) {
+		return false;
+	}
+
+	idFile_Memory f( filename, buffer, length );
+
+	f.Read( id, sizeof( id ) );
+	f.ReadInt( version );
+	f.ReadInt( md5Version );
+	f.ReadInt( jointQuatSize );
+	f.ReadInt( fileTextLength );
+	f.Read( &fileTimeStamp, sizeof( fileTimeStamp ) );
+	if ( memcmp( id, MD5_ANIM_BINARY_ID, sizeof( id ) ) || version != MD5_BINARY_VERSION || md5Version != MD5_VERSION ||
+		jointQuatSize != sizeof( idJointQuat ) || fileTextLength != textLength || fileTimeStamp != textTimeStamp ) {
+		fileSystem->FreeFile( (void *)buffer );
+		return false;
+	}
+
+	Free();
+
+	f.ReadInt( numFrames );
+	f.ReadInt( frameRate );
+	f.ReadInt( animLength );
+	f.ReadInt( numJoints );
+	f.ReadInt( numAnimatedComponents );
+	f.ReadVec3( totaldelta );
+
+	bool ok = ( numFrames > 0 && frameRate > 0 && numJoints > 0 && numAnimatedComponents >= 0 && numAnimatedComponents <= numJoints * 6 &&
+				numJoints * 16 <= f.Length() - f.Tell() );
+	if ( ok ) {
+		jointInfo.SetGranularity( 1 );
+		jointInfo.SetNum( numJoints );
+		for ( i = 0; i < numJoints && ok; i++ ) {
+			ok = MD5Anim_ReadBinaryString( &f, jointName );
+			jointInfo[ i ].nameIndex = animationLib.JointIndex( jointName );
+			f.ReadInt( jointInfo[ i ].parentNum );
+			f.ReadInt( jointInfo[ i ].animBits );
+			f.ReadInt( jointInfo[ i ].firstComponent );
+		}
+
+		ok = ok && MD5Anim_ReadBinaryList( &f, bounds, numFrames ) &&
+			MD5Anim_ReadBinaryList( &f, baseFrame, numJoints ) &&
+			MD5Anim_ReadBinaryList( &f, componentFrames, numAnimatedComponents * numFrames );
+	}
+
+	fileSystem->FreeFile( (void *)buffer );
+
+	if ( !ok ) {
+		gameLocal.Warning( "%s is damaged, loading the text anim", filename );
+		Free();
+		return false;
+	}
+	return true;
+}
+
 /*
 ====================
 idMD5Anim::IncreaseRefs
@@ -436,8 +730,10 @@ void idMD5Anim::GetOrigin( idVec3 &offset, int time, int cyclecount ) const {
 
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	float buffer1[ 3 ], buffer2[ 3 ];
+	const int count = Min( 3, numAnimatedComponents - jointInfo[ 0 ].firstComponent );
+	const float *componentPtr1 = GetFrameComponents( frame.frame1, jointInfo[ 0 ].firstComponent, count, buffer1 );
+	const float *componentPtr2 = GetFrameComponents( frame.frame2, jointInfo[ 0 ].firstComponent, count, buffer2 );
 
 	if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
 		offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
@@ -478,8 +774,10 @@ void idMD5Anim::GetOriginRotation( idQuat &rotation, int time, int cyclecount )
 
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float	*jointframe1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float	*jointframe2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	float buffer1[ 6 ], buffer2[ 6 ];
+	const int count = Min( 6, numAnimatedComponents - jointInfo[ 0 ].firstComponent );
+	const float	*jointframe1 = GetFrameComponents( frame.frame1, jointInfo[ 0 ].firstComponent, count, buffer1 );
+	const float	*jointframe2 = GetFrameComponents( frame.frame2, jointInfo[ 0 ].firstComponent, count, buffer2 );
 
 	if ( animBits & ANIM_TX ) {
 		jointframe1++;
@@ -592,8 +890,10 @@ void idMD5Anim::GetBounds( idBounds &bnds, int time, int cyclecount ) const {
 	// origin position
 	offset = baseFrame[ 0 ].t;
 	if ( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) ) {
-		const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-		const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+		float buffer1[ 3 ], buffer2[ 3 ];
+		const int count = Min( 3, numAnimatedComponents - jointInfo[ 0 ].firstComponent );
+		const float *componentPtr1 = GetFrameComponents( frame.frame1, jointInfo[ 0 ].firstComponent, count, buffer1 );
+		const float *componentPtr2 = GetFrameComponents( frame.frame2, jointInfo[ 0 ].firstComponent, count, buffer2 );
 
 		if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
 			offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
@@ -642,12 +942,22 @@ void idMD5Anim::GetInterpolatedFrame( frameBlend_t &frame, idJointQuat *joints,
 		return;
 	}
 
+	if ( cv_anim_posecache.GetBool() ) {
+		GetCachedInterpolatedFrame( frame, joints, index, numIndexes );
+		return;
+	}
+
 	blendJoints = (idJointQuat *)_alloca16( baseFrame.Num() * sizeof( blendPtr[ 0 ] ) );
 	lerpIndex = (int *)_alloca16( baseFrame.Num() * sizeof( lerpIndex[ 0 ] ) );
 	numLerpJoints = 0;
 
-	frame1 = &componentFrames[ frame.frame1 * numAnimatedComponents ];
-	frame2 = &componentFrames[ frame.frame2 * numAnimatedComponents ];
+	float *buffer1 = NULL, *buffer2 = NULL;
+	if ( componentBits ) {
+		buffer1 = (float *)_alloca16( numAnimatedComponents * sizeof( float ) );
+		buffer2 = (float *)_alloca16( numAnimatedComponents * sizeof( float ) );
+	}
+	frame1 = GetFrameComponents( frame.frame1, 0, numAnimatedComponents, buffer1 );
+	frame2 = GetFrameComponents( frame.frame2, 0, numAnimatedComponents, buffer2 );
 
 	for ( i = 0; i < numIndexes; i++ ) {
 		int j = index[i];
@@ -806,12 +1116,62 @@ void idMD5Anim::GetInterpolatedFrame( frameBlend_t &frame, idJointQuat *joints,
 	}
 }
 
+/*
+====================
+idMD5Anim::GetCachedInterpolatedFrame
+
+Same as GetInterpolatedFrame, but takes the two key frames from the pose cache.
+====================
+*/
+void idMD5Anim::GetCachedInterpolatedFrame( frameBlend_t &frame, idJointQuat *joints, const int *index, int numIndexes ) const {
+	int						i, numLerpJoints;
+	idJointQuat				*blendJoints;
+	int						*lerpIndex;
+
+	blendJoints = (idJointQuat *)_alloca16( baseFrame.Num() * sizeof( blendJoints[ 0 ] ) );
+	lerpIndex = (int *)_alloca16( baseFrame.Num() * sizeof( lerpIndex[ 0 ] ) );
+	numLerpJoints = 0;
+
+	animationLib.GetPoseCache().GetFrame( this, frame.frame1, joints, index, numIndexes );
+	animationLib.GetPoseCache().GetFrame( this, frame.frame2, blendJoints, index, numIndexes );
+
+	// the joints without animated components are the base frame in both
+	for ( i = 0; i < numIndexes; i++ ) {
+		if ( jointInfo[ index[ i ] ].animBits ) {
+			lerpIndex[ numLerpJoints++ ] = index[ i ];
+		}
+	}
+
+	SIMDProcessor->BlendJoints( joints, blendJoints, frame.backlerp, lerpIndex, numLerpJoints );
+
+	if ( frame.cycleCount ) {
+		joints[ 0 ].t += totaldelta * ( float )frame.cycleCount;
+	}
+}
+
 /*
 ====================
 idMD5Anim::GetSingleFrame
 ====================
 */
 void idMD5Anim::GetSingleFrame( int framenum, idJointQuat *joints, const int *index, int numIndexes ) const {
+	if ( ( framenum == 0 ) || !numAnimatedComponents ) {
+		// just use the base frame
+		SIMDProcessor->Memcpy( joints, baseFrame.Ptr(), baseFrame.Num() * sizeof( baseFrame[ 0 ] ) );
+		return;
+	}
+
+	DecodeFrame( framenum, joints, index, numIndexes );
+}
+
+/*
+====================
+idMD5Anim::DecodeFrame
+
+Decodes the components of the given joints of a frame, the other joints are left at the base frame
+====================
+*/
+void idMD5Anim::DecodeFrame( int framenum, idJointQuat *joints, const int *index, int numIndexes ) const {
 	int						i;
 	const float				*frame;
 	const float				*jointframe;
@@ -822,12 +1182,15 @@ void idMD5Anim::GetSingleFrame( int framenum, idJointQuat *joints, const int *in
 	// copy the baseframe
 	SIMDProcessor->Memcpy( joints, baseFrame.Ptr(), baseFrame.Num() * sizeof( baseFrame[ 0 ] ) );
 
-	if ( ( framenum == 0 ) || !numAnimatedComponents ) {
-		// just use the base frame
+	if ( !numAnimatedComponents ) {
 		return;
 	}
 
-	frame = &componentFrames[ framenum * numAnimatedComponents ];
+	float *buffer = NULL;
+	if ( componentBits ) {
+		buffer = (float *)_alloca16( numAnimatedComponents * sizeof( float ) );
+	}
+	frame = GetFrameComponents( framenum, 0, numAnimatedComponents, buffer );
 
 	for ( i = 0; i < numIndexes; i++ ) {
 		int j = index[i];
@@ -921,6 +1284,115 @@ void idMD5Anim::SetFrameRate( int frRate )
 	return;
 }
 
+/***********************************************************************
+
+	idAnimPoseCache
+
+***********************************************************************/
+
+/*
+====================
+idAnimPoseCache::idAnimPoseCache
+====================
+*/
+idAnimPoseCache::idAnimPoseCache() {
+	Clear();
+}
+
+/*
+====================
+idAnimPoseCache::Clear
+====================
+*/
+void idAnimPoseCache::Clear( void ) {
+	for( int i = 0; i < ANIM_POSE_CACHE_SLOTS; i++ ) {
+		frames[ i ].anim = NULL;
+		frames[ i ].framenum = -1;
+		frames[ i ].index.Clear();
+		frames[ i ].joints.Clear();
+	}
+
+	ResetStats();
+}
+
+/*
+====================
+idAnimPoseCache::GetFrame
+
+The frames stay valid until their anim is freed or reloaded, so a slot is only
+replaced by another frame hashing to it.
+====================
+*/
+void idAnimPoseCache::GetFrame( const idMD5Anim *anim, int framenum, idJointQuat *joints, const int *index, int numIndexes ) {
+	int		numJoints = anim->NumJoints();
+	int		slot = ( ( int )( ( intptr_t )anim >> 4 ) ^ ( int )( ( intptr_t )index >> 2 ) ^ ( framenum * 7919 ) ) & ( ANIM_POSE_CACHE_SLOTS - 1 );
+	bool	hit = false;
+
+	// the animators create their frames in parallel
+	#pragma omp critical( animPoseCache )
+	{
+		cachedFrame_t &cached = frames[ slot ];
+
+		if ( cached.anim == anim && cached.framenum == framenum && cached.index.Num() == numIndexes &&
+			memcmp( cached.index.Ptr(), index, numIndexes * sizeof( index[ 0 ] ) ) == 0 ) {
+			SIMDProcessor->Memcpy( joints, cached.joints.Ptr(), numJoints * sizeof( joints[ 0 ] ) );
+			hits++;
+			hit = true;
+		} else {
+			misses++;
+		}
+	}
+
+	if ( hit ) {
+		return;
+	}
+
+	anim->DecodeFrame( framenum, joints, index, numIndexes );
+
+	#pragma omp critical( animPoseCache )
+	{
+		cachedFrame_t &cached = frames[ slot ];
+
+		cached.anim = anim;
+		cached.framenum = framenum;
+		cached.index.SetNum( numIndexes, false );
+		memcpy( cached.index.Ptr(), index, numIndexes * sizeof( index[ 0 ] ) );
+		cached.joints.SetNum( numJoints, false );
+		SIMDProcessor->Memcpy( cached.joints.Ptr(), joints, numJoints * sizeof( joints[ 0 ] ) );
+	}
+}
+
+/*
+====================
+idAnimPoseCache::PrintStats
+====================
+*/
+void idAnimPoseCache::PrintStats( void ) const {
+	int		used = 0;
+	size_t	size = 0;
+	int		lookups = hits + misses;
+
+	for( int i = 0; i < ANIM_POSE_CACHE_SLOTS; i++ ) {
+		if ( frames[ i ].anim != NULL ) {
+			used++;
+		}
+		size += frames[ i ].index.Allocated() + frames[ i ].joints.Allocated();
+	}
+
+	gameLocal.Printf( "%d hits, %d misses (%.1f%% hit rate)\n", hits, misses, ( lookups > 0 ) ? 100.0f * hits / lookups : 0.0f );
+	gameLocal.Printf( "%d of %d slots used, %d bytes\n", used, ANIM_POSE_CACHE_SLOTS, ( int )size );
+}
+
+/*
+====================
+idAnimPoseCache::ResetStats
+====================
+*/
+void idAnimPoseCache::ResetStats( void ) {
+	hits = 0;
+	misses = 0;
+}
+
 /***********************************************************************
 
 	idAnimManager
@@ -950,6 +1422,7 @@ idAnimManager::Shutdown
 ====================
 */
 void idAnimManager::Shutdown( void ) {
+	poseCache.Clear();
 	animations.DeleteContents();
 	jointnames.Clear();
 	jointnamesHash.Free();
@@ -998,6 +1471,8 @@ void idAnimManager::ReloadAnims( void ) {
 	int			i;
 	idMD5Anim	**animptr;
 
+	poseCache.Clear();
+
 	for( i = 0; i < animations.Num(); i++ ) {
 		animptr = animations.GetIndex( i );
 		if ( animptr && *animptr ) {
@@ -1047,10 +1522,14 @@ void idAnimManager::ListAnims( void ) const {
 	size_t		size;
 	size_t		s;
 	size_t		namesize;
+	size_t		saved;
 	int			num;
+	int			numCompressed;
 
 	num = 0;
+	numCompressed = 0;
 	size = 0;
+	saved = 0;
 	for( i = 0; i < animations.Num(); i++ ) {
 		animptr = animations.GetIndex( i );
 		if ( animptr && *animptr ) {
@@ -1059,6 +1538,10 @@ void idAnimManager::ListAnims( void ) const {
 			gameLocal.Printf( "%8d bytes : %2d refs : %s\n", s, anim->NumRefs(), anim->Name() );
 			size += s;
 			num++;
+			if ( anim->CompressionSavings() ) {
+				saved += anim->CompressionSavings();
+				numCompressed++;
+			}
 		}
 	}
 
@@ -1068,6 +1551,7 @@ void idAnimManager::ListAnims( void ) const {
 	}
 
 	gameLocal.Printf( "\n%d memory used in %d anims\n", size, num );
+	gameLocal.Printf( "%d memory saved by compressing the frames of %d anims\n", saved, numCompressed );
 	gameLocal.Printf( "%d memory used in %d joint names\n", namesize, jointnames.Num() );
 }
 
@@ -1090,6 +1574,10 @@ void idAnimManager::FlushUnusedAnims( void ) {
 		}
 	}
 
+	if ( removeAnims.Num() ) {
+		poseCache.Clear();
+	}
+
 	for( i = 0; i < removeAnims.Num(); i++ ) {
 		animations.Remove( removeAnims[ i ]->Name() );
 		delete removeAnims[ i ];
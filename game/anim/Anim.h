@@ -282,10 +282,21 @@ private:
 	idList<jointAnimInfo_t>	jointInfo;
 	idList<idJointQuat>		baseFrame;
 	idList<float>			componentFrames;
+	int						componentBits;			// if non-zero the frames are quantized to this many bits per component
+	idList<byte>			byteFrames;				// quantized frames with up to 8 bits
+	idList<unsigned short>	shortFrames;			// quantized frames with up to 16 bits
+	idList<float>			componentBias;			// value of each component at quantization 0
+	idList<float>			componentScale;			// value of a quantization step of each component
 	idStr					name;
 	idVec3					totaldelta;
 	mutable int				ref_count;
 
+	void					GetCachedInterpolatedFrame( frameBlend_t &frame, idJointQuat *joints, const int *index, int numIndexes ) const;
+	bool					LoadBinaryAnim( const char *filename, int textLength, ID_TIME_T textTimeStamp );
+	void					WriteBinaryAnim( const char *filename, int textLength, ID_TIME_T textTimeStamp ) const;
+	void					CompressFrames( int bits );
+	const float *			GetFrameComponents( int framenum, int first, int count, float *buffer ) const;
+
 public:
 							idMD5Anim();
 							~idMD5Anim();
@@ -294,6 +305,7 @@ public:
 	bool					Reload( void );
 	size_t					Allocated( void ) const;
 	size_t					Size( void ) const { return sizeof( *this ) + Allocated(); };
+	size_t					CompressionSavings( void ) const;
 	bool					LoadAnim( const char *filename );
 
 	void					IncreaseRefs( void ) const;
@@ -303,6 +315,7 @@ public:
 	void					CheckModelHierarchy( const idRenderModel *model ) const;
 	void					GetInterpolatedFrame( frameBlend_t &frame, idJointQuat *joints, const int *index, int numIndexes ) const;
 	void					GetSingleFrame( int framenum, idJointQuat *joints, const int *index, int numIndexes ) const;
+	void					DecodeFrame( int framenum, idJointQuat *joints, const int *index, int numIndexes ) const;
 	int						Length( void ) const;
 	int						NumFrames( void ) const;
 	int						NumJoints( void ) const;
@@ -322,6 +335,45 @@ public:
 	void					SetFrameRate( int frRate );
 };
 
+/*
+==============================================================================================
+
+	idAnimPoseCache
+
+	Keeps the decoded key frames of the md5 anims, keyed by anim, frame number and the
+	joints of the channel they were decoded for. Animators playing the same anim at
+	similar times share the decoding and only blend between the cached frames.
+
+==============================================================================================
+*/
+
+#define ANIM_POSE_CACHE_SLOTS	512		// must be a power of two
+
+class idAnimPoseCache {
+public:
+							idAnimPoseCache();
+
+	void					Clear( void );
+
+	// copies the decoded frame into joints, decodes and stores it on a miss
+	void					GetFrame( const idMD5Anim *anim, int framenum, idJointQuat *joints, const int *index, int numIndexes );
+
+	void					PrintStats( void ) const;
+	void					ResetStats( void );
+
+private:
+	struct cachedFrame_t {
+		const idMD5Anim *	anim;
+		int					framenum;
+		idList<int>			index;			// the decoded joints
+		idList<idJointQuat>	joints;
+	};
+
+	cachedFrame_t			frames[ ANIM_POSE_CACHE_SLOTS ];
+	int						hits;
+	int						misses;
+};
+
 /*
 ==============================================================================================
 
@@ -600,6 +652,8 @@ public:
 	void						ForceUpdate( void );
 	void						ClearForceUpdate( void );
 	bool						CreateFrame( int animtime, bool force );
+								// creates the frame ahead of its first use, safe to call from a worker thread
+	void						PrepareFrame( int animtime );
 	bool						FrameHasChanged( int animtime ) const;
 	void						GetDelta( int fromtime, int totime, idVec3 &delta ) const;
 	bool						GetDeltaRotation( int fromtime, int totime, idMat3 &delta ) const;
@@ -659,6 +713,7 @@ private:
 
 	mutable int					lastTransformTime;		// mutable because the value is updated in CreateFrame
 	mutable bool				stoppedAnimatingUpdate;
+	bool						framePrepared;			// the frame of lastTransformTime was created by PrepareFrame and not used yet
 	bool						removeOriginOffset;
 	bool						forceUpdate;
 
@@ -697,7 +752,10 @@ public:
 	void						ClearAnimsInUse( void );
 	void						FlushUnusedAnims( void );
 
+	idAnimPoseCache &			GetPoseCache( void ) { return poseCache; }
+
 private:
+	idAnimPoseCache				poseCache;
 	idHashTable<idMD5Anim *>	animations;
 	idStrList					jointnames;
 	idHashIndex					jointnamesHash;
@@ -3963,6 +3963,7 @@ idAnimator::idAnimator() {
 	joints					= NULL;
 	lastTransformTime		= -1;
 	stoppedAnimatingUpdate	= false;
+	framePrepared			= false;
 	removeOriginOffset		= false;
 	forceUpdate				= false;
 
@@ -4011,6 +4012,7 @@ archives object for save game file
 =====================
 */
 void idAnimator::Save( idSaveGame *savefile ) const {
+	idSaveGameProfileScope profile( savefile, "idAnimator" );
 	int i;
 	int j;
 
@@ -4082,6 +4084,7 @@ unarchives object from save game file
 =====================
 */
 void idAnimator::Restore( idRestoreGame *savefile ) {
+	idSaveGameProfileScope profile( savefile, "idAnimator" );
 	int i;
 	int j;
 	int num;
@@ -5216,6 +5219,11 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 
 	if ( !force && !r_showSkel.GetInteger() ) {
 		if ( lastTransformTime == currentTime ) {
+			// report a prepared frame to its first user as if it had just been created
+			if ( framePrepared ) {
+				framePrepared = false;
+				return true;
+			}
 			return false;
 		}
 		if ( lastTransformTime != -1 && !stoppedAnimatingUpdate && !IsAnimating( currentTime ) ) {
@@ -5228,6 +5236,7 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 
 	lastTransformTime = currentTime;
 	stoppedAnimatingUpdate = false;
+	framePrepared = false;
 
 	if ( entity && ( ( g_debugAnim.GetInteger() == entity->entityNumber ) || ( g_debugAnim.GetInteger() == -2 ) ) ) {
 		debugInfo = true;
@@ -5434,6 +5443,21 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 	return true;
 }
 
+/*
+=====================
+idAnimator::PrepareFrame
+
+Creates the frame of currentTime ahead of its first use. The next CreateFrame at the
+same time returns true without creating it again. Only touches the animator and the
+shared anims, so animators of different entities can be prepared in parallel.
+=====================
+*/
+void idAnimator::PrepareFrame( int currentTime ) {
+	if ( CreateFrame( currentTime, false ) ) {
+		framePrepared = true;
+	}
+}
+
 /*
 =====================
 idAnimator::ForceUpdate
@@ -134,6 +134,7 @@ void darkModLAS::Restore(idRestoreGame *savefile)
 			savefile->ReadInt(p_record->areaIndex);
 			savefile->ReadVec3(p_record->lastWorldPos);
 			savefile->ReadUnsignedInt(p_record->lastFrameUpdated);
+			p_record->cacheRevision = -1;
 
 			if (m_pp_areaLightLists[i] != NULL)
 			{
@@ -317,6 +318,56 @@ bool darkModLAS::traceLightPath( idVec3 from, idVec3 to, idEntity* ignore, idLig
 
 //----------------------------------------------------------------------------
 
+bool darkModLAS::updateLightCache(darkModLightRecord_t* p_LASLight)
+{
+	idLight* light = p_LASLight->p_idLight;
+	const idVec3& physicsOrigin = light->GetPhysics()->GetOrigin();
+
+	if ( ( p_LASLight->cacheRevision == light->LASStateRevision ) && ( p_LASLight->cachePhysicsOrigin == physicsOrigin ) )
+	{
+		return false;
+	}
+
+	p_LASLight->cacheRevision = light->LASStateRevision;
+	p_LASLight->cachePhysicsOrigin = physicsOrigin;
+	p_LASLight->cachePointLight = light->IsPointlight();
+
+	idVec3* cone = p_LASLight->cacheCone;
+
+	if ( p_LASLight->cachePointLight )
+	{
+		light->GetLightCone(cone[ELL_ORIGIN], cone[ELA_AXIS], cone[ELA_CENTER]);
+
+		// If this is a centerlight we have to move the origin from the original origin to where the
+		// center of the light is supposed to be, see accumulateEffectOfLightsInArea().
+		p_LASLight->cacheLightOrigin = cone[ELL_ORIGIN] + cone[ELA_CENTER];
+
+		// IntersectLinesegmentLightEllipsoid() takes the radii along the world axes
+		const idVec3 radius( idMath::Fabs(cone[ELA_AXIS].x), idMath::Fabs(cone[ELA_AXIS].y), idMath::Fabs(cone[ELA_AXIS].z) );
+		p_LASLight->cacheBounds = idBounds( p_LASLight->cacheLightOrigin - radius, p_LASLight->cacheLightOrigin + radius );
+	}
+	else // projected light
+	{
+		light->GetLightCone(cone[ELC_ORIGIN], cone[ELA_TARGET], cone[ELA_RIGHT], cone[ELA_UP], cone[ELA_START], cone[ELA_END]);
+		p_LASLight->cacheLightOrigin = cone[ELC_ORIGIN]; // grayman #3524
+
+		// GetLightConeFrustum() clobbers some of the cone, which is still needed for the illumination
+		idVec3 frustumCone[ELC_COUNT];
+		for ( int i = 0 ; i < ELC_COUNT ; i++ )
+		{
+			frustumCone[i] = cone[i];
+		}
+		GetLightConeFrustum(frustumCone, p_LASLight->cacheFrustum);
+
+		// the frustum test rejects lines just as quickly
+		p_LASLight->cacheBounds.Clear();
+	}
+
+	return true;
+}
+
+//----------------------------------------------------------------------------
+
 void darkModLAS::accumulateEffectOfLightsInArea 
 ( 
 	float& inout_totalIllumination,
@@ -399,7 +450,6 @@ void darkModLAS::accumulateEffectOfLightsInArea
 		// code, given the number of things that needed to be fixed.
 		*/
 
-		idVec3 vLightCone[ELC_COUNT]; // Holds data on the light shape (point ellipsoid or projected cone).
 		idVec3 vLight; // The real origin of the light (origin + offset).
 		EIntersection inter;
 		idVec3 vResult[2]; // If there's an intersection, [0] holds one point, [1] holds a second
@@ -408,41 +458,29 @@ void darkModLAS::accumulateEffectOfLightsInArea
 		idVec3 p1, p2, p3; // test points for testing visibility to light source
 		idVec3 p_illumination; // point where we determine illumination
 
-		if ( light->IsPointlight() )
-		{
-			light->GetLightCone
-			(
-				vLightCone[ELL_ORIGIN], 
-				vLightCone[ELA_AXIS], 
-				vLightCone[ELA_CENTER]
-			);
-
-			// If this is a centerlight we have to move the origin from the original origin to where the
-			// center of the light is supposed to be.
-			// Centerlight means that the center of the ellipsoid is not the same as the origin. It has to
-			// be adjusted because if it casts shadows we have to trace to it, and in this case the light
-			// might be inside geometry and would be reported as not being visible even though it casts
-			// a visible light outside the geometry it is embedded in. If it is not a centerlight and has
-			// cast shadows enabled, it wouldn't cast any light at all in such a case because it would
-			// be blocked by the geometry.
-
-			vLight = vLightCone[ELL_ORIGIN] + vLightCone[ELA_CENTER];
+		// The light volume is only recomputed when the light has changed
+		updateLightCache(p_LASLight);
+		vLight = p_LASLight->cacheLightOrigin;
 
+		if ( !p_LASLight->cacheBounds.IsCleared() && !p_LASLight->cacheBounds.LineIntersection(testPoint1, testPoint2) )
+		{
+			// the line doesn't get anywhere near the light volume
+			inter = INTERSECT_OUTSIDE;
+		}
+		else if ( p_LASLight->cachePointLight )
+		{
 			// grayman #3584 - IntersectLineEllipsoid() provides no information on whether
 			// the line segment ends are inside or outside the ellipsoid. Let's use
 			// IntersectLinesegmentLightEllipsoid() to get that information.
 
-			inter = IntersectLinesegmentLightEllipsoid(	vTargetSeg, vLightCone, vResult, inside	);
-			//inter = IntersectLineEllipsoid(	vTargetSeg, vLightCone, vResult	);
+			inter = IntersectLinesegmentLightEllipsoid(	vTargetSeg, p_LASLight->cacheCone, vResult, inside	);
 
 			DM_LOG(LC_LIGHT, LT_DEBUG)LOGSTRING("IntersectLinesegmentLightEllipsoid() returned %u\r", inter);
 		}
 		else // projected light
 		{
-			light->GetLightCone(vLightCone[ELC_ORIGIN], vLightCone[ELA_TARGET], vLightCone[ELA_RIGHT], vLightCone[ELA_UP], vLightCone[ELA_START], vLightCone[ELA_END]);
-			inter = IntersectLineLightCone(vTargetSeg, vLightCone, vResult, inside);
-			vLight = vLightCone[ELC_ORIGIN]; // grayman #3524
-			DM_LOG(LC_LIGHT, LT_DEBUG)LOGSTRING("IntersectLineLightCone returned %u\r", inter);
+			inter = IntersectLineLightFrustum(vTargetSeg, p_LASLight->cacheFrustum, vResult, inside);
+			DM_LOG(LC_LIGHT, LT_DEBUG)LOGSTRING("IntersectLineLightFrustum returned %u\r", inter);
 		}
 
 		// The line intersection returns one of four states. Either the line is entirely inside
@@ -662,9 +700,7 @@ void darkModLAS::accumulateEffectOfLightsInArea
 				// and apply the same rotation to p_illumination so it stays
 				// relative.
 
-				// Re-get the light cone parameters, some of which were clobbered in IntersectLineLightCone().
-				light->GetLightCone(vLightCone[ELC_ORIGIN], vLightCone[ELA_TARGET], vLightCone[ELA_RIGHT], vLightCone[ELA_UP], vLightCone[ELA_START], vLightCone[ELA_END]);
-				idVec3 target = vLightCone[ELA_TARGET]; // direction of light cone, already relative to vLight
+				idVec3 target = p_LASLight->cacheCone[ELA_TARGET]; // direction of light cone, already relative to vLight
 
 				// TODO: need to map p_illumination[x,y] to p_illumination[right,up]
 				// then right is the new x and up is the new y
@@ -834,7 +870,6 @@ void darkModLAS::accumulateEffectOfLightsInArea2
 		// grayman #3584 - Though by this point, it probably no longer looks like that
 		// code, given the number of things that needed to be fixed.
 
-		idVec3 vLightCone[ELC_COUNT]; // Holds data on the light shape (point ellipsoid or projected cone).
 		idVec3 vLight; // The real origin of the light (origin + offset).
 		EIntersection inter;
 		idVec3 vResult[2]; // If there's an intersection, [0] holds one point, [1] holds a second
@@ -843,21 +878,9 @@ void darkModLAS::accumulateEffectOfLightsInArea2
 		idVec3 p1, p2, p3; // test points for testing visibility to light source
 		idVec3 p_illumination; // point where we determine illumination
 
-		if ( light->IsPointlight() )
-		{
-			light->GetLightCone
-			(
-				vLightCone[ELL_ORIGIN], 
-				vLightCone[ELA_AXIS], 
-				vLightCone[ELA_CENTER]
-			);
-			vLight = vLightCone[ELL_ORIGIN] + vLightCone[ELA_CENTER];
-		}
-		else // projected light
-		{
-			light->GetLightCone(vLightCone[ELC_ORIGIN], vLightCone[ELA_TARGET], vLightCone[ELA_RIGHT], vLightCone[ELA_UP], vLightCone[ELA_START], vLightCone[ELA_END]);
-			vLight = vLightCone[ELC_ORIGIN]; // grayman #3524
-		}
+		// The light volume is only recomputed when the light has changed
+		updateLightCache(p_LASLight);
+		vLight = p_LASLight->cacheLightOrigin;
 
 		// Set up target segment: Origin and Delta
 		idVec3 vTargetSeg[LSG_COUNT];
@@ -904,29 +927,25 @@ void darkModLAS::accumulateEffectOfLightsInArea2
 			gameRenderWorld->DebugArrow(colorBlue, testPoint1, testPoint2, 2, 1000);
 		}
 
-		if ( light->IsPointlight() )
+		if ( !p_LASLight->cacheBounds.IsCleared() && !p_LASLight->cacheBounds.LineIntersection(testPoint1, testPoint2) )
+		{
+			// the line doesn't get anywhere near the light volume
+			inter = INTERSECT_OUTSIDE;
+		}
+		else if ( p_LASLight->cachePointLight )
 		{
-			// If this is a centerlight we have to move the origin from the original origin to where the
-			// center of the light is supposed to be.
-			// Centerlight means that the center of the ellipsoid is not the same as the origin. It has to
-			// be adjusted because if it casts shadows we have to trace to it, and in this case the light
-			// might be inside geometry and would be reported as not being visible even though it casts
-			// a visible light outside the geometry it is embedded in. If it is not a centerlight and has
-			// cast shadows enabled, it wouldn't cast any light at all in such a case because it would
-			// be blocked by the geometry.
-
 			// grayman #3584 - IntersectLineEllipsoid() provides no information on whether
 			// the line segment ends are inside or outside the ellipsoid. Let's use
 			// IntersectLinesegmentLightEllipsoid() to get that information.
 
-			inter = IntersectLinesegmentLightEllipsoid(	vTargetSeg, vLightCone, vResult, inside	);
+			inter = IntersectLinesegmentLightEllipsoid(	vTargetSeg, p_LASLight->cacheCone, vResult, inside	);
 
 			DM_LOG(LC_LIGHT, LT_DEBUG)LOGSTRING("IntersectLinesegmentLightEllipsoid() returned %u\r", inter);
 		}
 		else // projected light
 		{
-			inter = IntersectLineLightCone(vTargetSeg, vLightCone, vResult, inside);
-			DM_LOG(LC_LIGHT, LT_DEBUG)LOGSTRING("IntersectLineLightCone returned %u\r", inter);
+			inter = IntersectLineLightFrustum(vTargetSeg, p_LASLight->cacheFrustum, vResult, inside);
+			DM_LOG(LC_LIGHT, LT_DEBUG)LOGSTRING("IntersectLineLightFrustum returned %u\r", inter);
 		}
 
 		// The line intersection returns one of four states. Either the line is entirely inside
@@ -1112,9 +1131,7 @@ void darkModLAS::accumulateEffectOfLightsInArea2
 				// and apply the same rotation to p_illumination so it stays
 				// relative.
 
-				// Re-get the light cone parameters, some of which were clobbered in IntersectLineLightCone().
-				light->GetLightCone(vLightCone[ELC_ORIGIN], vLightCone[ELA_TARGET], vLightCone[ELA_RIGHT], vLightCone[ELA_UP], vLightCone[ELA_START], vLightCone[ELA_END]);
-				idVec3 target = vLightCone[ELA_TARGET]; // direction of light cone, already relative to vLight
+				idVec3 target = p_LASLight->cacheCone[ELA_TARGET]; // direction of light cone, already relative to vLight
 
 				// TODO: need to map p_illumination[x,y] to p_illumination[right,up]
 				// then right is the new x and up is the new y
@@ -1249,6 +1266,12 @@ void darkModLAS::initialize()
 		DM_LOG(LC_LIGHT, LT_DEBUG)LOGSTRING("PVS to aas32 mapping table initialized.\r");
 	}
 
+	// Index the hiding spot candidates of the same AAS
+	hidingSpotCandidateIndex.clear();
+	if (cv_ai_hiding_spot_index.GetBool() && pvsToAASMappingTable.getAASName().Length() > 0)
+	{
+		hidingSpotCandidateIndex.build(pvsToAASMappingTable.getAASName());
+	}
 }
 
 //-------------------------------------------------------------------------
@@ -1288,6 +1311,7 @@ void darkModLAS::addLight (idLight* p_idLight)
 	p_record->lastWorldPos = lightPos;
 	p_record->p_idLight = p_idLight;
 	p_record->areaIndex = containingAreaIndex;
+	p_record->cacheRevision = -1;
 
 	if (m_pp_areaLightLists[containingAreaIndex] != NULL)
 	{
@@ -1469,6 +1493,8 @@ void darkModLAS::shutDown()
 	pvsToAASMappingTable.clear();
 	DM_LOG(LC_LIGHT, LT_DEBUG)LOGSTRING("PVS to AAS(0) mapping table cleared\r");
 
+	hidingSpotCandidateIndex.clear();
+
 
 }
 
@@ -1500,41 +1526,45 @@ void darkModLAS::updateLASState()
 			if (p_LASLight->lastFrameUpdated != m_updateFrameIndex)
 			{
 
-				// grayman #3843 - apply the light_center value
-				// Get the light position
-				//idVec3 lightPos(p_LASLight->p_idLight->GetPhysics()->GetOrigin());
-				idVec3 lightPos;
-				idVec3 lightAxis;
-				idVec3 lightCenter;
+				// Only a light that changed since its volume was cached can have moved
+				if ( updateLightCache(p_LASLight) )
+				{
+					// grayman #3843 - apply the light_center value
+					// Get the light position
+					//idVec3 lightPos(p_LASLight->p_idLight->GetPhysics()->GetOrigin());
+					idVec3 lightPos;
+					idVec3 lightAxis;
+					idVec3 lightCenter;
 
-				// fill in the light data
-				p_LASLight->p_idLight->GetLightCone(lightPos, lightAxis, lightCenter);
+					// fill in the light data
+					p_LASLight->p_idLight->GetLightCone(lightPos, lightAxis, lightCenter);
 
-				lightPos += lightCenter; // true origin of light
+					lightPos += lightCenter; // true origin of light
 	
-				// Check to see if it has moved
-				if (p_LASLight->lastWorldPos != lightPos)
-				{
-					// Update its world pos
-					p_LASLight->lastWorldPos = lightPos;
-
-					// This light may have moved between areas
-					int newAreaIndex = gameRenderWorld->PointInArea (p_LASLight->lastWorldPos);
-					if (newAreaIndex == -1)
+					// Check to see if it has moved
+					if (p_LASLight->lastWorldPos != lightPos)
 					{
-						// Light is now in the void
-						// add to the end of the list
-						newAreaIndex = m_numAreas;
-					}
+						// Update its world pos
+						p_LASLight->lastWorldPos = lightPos;
 
-					if (newAreaIndex != p_LASLight->areaIndex)
-					{
-						// Move between areas
-						moveLightBetweenAreas(p_LASLight, p_LASLight->areaIndex, newAreaIndex);
-					
-					}  // Light changed areas
+						// This light may have moved between areas
+						int newAreaIndex = gameRenderWorld->PointInArea (p_LASLight->lastWorldPos);
+						if (newAreaIndex == -1)
+						{
+							// Light is now in the void
+							// add to the end of the list
+							newAreaIndex = m_numAreas;
+						}
+
+						if (newAreaIndex != p_LASLight->areaIndex)
+						{
+							// Move between areas
+							moveLightBetweenAreas(p_LASLight, p_LASLight->areaIndex, newAreaIndex);
+
+						}  // Light changed areas
 				
-				} // Light moved
+					} // Light moved
+				}
 			
 				// Mark light as updated this LAS frame
 				p_LASLight->lastFrameUpdated = m_updateFrameIndex;
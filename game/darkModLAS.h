@@ -29,6 +29,10 @@
 
 // The PVS to AAS mapping table
 #include "PVSToAASMapping.h"
+#include "HidingSpotCandidateIndex.h"
+
+// The light cone layout
+#include "Intersection.h"
 
 
 /*!
@@ -57,6 +61,18 @@ typedef struct darkModLightRecord_s
 	* A flag used to track if this light has been updated yet this frame
 	*/
     unsigned int lastFrameUpdated;
+
+	/*!
+	* The light volume, as needed by every query that tests the light. It is cached
+	* until the light is presented to the renderer again or moves, see darkModLAS::updateLightCache
+	*/
+	int cacheRevision;			// idLight::LASStateRevision the cache was built for, -1 for none
+	idVec3 cachePhysicsOrigin;	// the light's physics origin the cache was built for
+	bool cachePointLight;
+	idVec3 cacheCone[ELC_COUNT];	// idLight::GetLightCone() results, laid out as ELL_* or ELC_*
+	idVec3 cacheLightOrigin;		// the real origin of the light (origin + light_center)
+	idPlane cacheFrustum[6];		// projected lights: the planes of the light cone
+	idBounds cacheBounds;		// point lights: the bounds of the light ellipsoid
         
 } darkModLightRecord_t;
 
@@ -94,6 +110,13 @@ protected:
 
    bool traceLightPath( idVec3 to, idVec3 from, idEntity* ignore, idLight* light); // grayman #2853 // grayman #3584
 
+   /*!
+   * Brings the cached light volume of the record up to date, which is only
+   * recomputed if the light has changed since the last call.
+   * @return true if the light had changed
+   */
+   bool updateLightCache (darkModLightRecord_t* p_LASLight);
+
    /*!
    * This method is used to add up all the light intensities contributed from
    * a specific region apon the line between the two test points.
@@ -147,6 +170,12 @@ public:
    */
    PVSToAASMapping pvsToAASMappingTable;
 
+   /*!
+   * The static hiding spot candidates of the AAS used by pvsToAASMappingTable
+   * It is built in darkModLAS::initialize and cleared in darkModLAS::shutdown
+   */
+   CHidingSpotCandidateIndex hidingSpotCandidateIndex;
+
 	/*!
 	* Constructor
 	*/
@@ -69,6 +69,7 @@ idTypeInfo::idTypeInfo( const char *classname, const char *superclass, idEventFu
 	this->superclass		= superclass;
 	this->eventCallbacks	= eventCallbacks;
 	this->eventMap			= NULL;
+	this->eventStubMap		= NULL;
 	this->Spawn				= Spawn;
 	this->Save				= Save;
 	this->Restore			= Restore;
@@ -152,6 +153,7 @@ void idTypeInfo::Init( void ) {
 	// if we're not adding any new event callbacks, we can just use our superclass's table
 	if ( ( !eventCallbacks || !eventCallbacks->event ) && super ) {
 		eventMap = super->eventMap;
+		eventStubMap = super->eventStubMap;
 		return;
 	}
 
@@ -164,7 +166,9 @@ void idTypeInfo::Init( void ) {
 	num = idEventDef::NumEventCommands();
 	eventMap = new eventCallback_t[ num ];
 	memset( eventMap, 0, sizeof( eventCallback_t ) * num );
-	eventCallbackMemory += sizeof( eventCallback_t ) * num;
+	eventStubMap = new eventStub_t[ num ];
+	memset( eventStubMap, 0, sizeof( eventStub_t ) * num );
+	eventCallbackMemory += ( sizeof( eventCallback_t ) + sizeof( eventStub_t ) ) * num;
 
 	// allocate temporary memory for flags so that the subclass's event callbacks
 	// override the superclass's event callback
@@ -189,6 +193,7 @@ void idTypeInfo::Init( void ) {
 			}
 			set[ ev ] = true;
 			eventMap[ ev ] = def[ i ].function;
+			eventStubMap[ ev ] = def[ i ].stub;
 		}
 	}
 
@@ -209,8 +214,10 @@ void idTypeInfo::Shutdown() {
 	if ( eventMap ) {
 		if ( freeEventMap ) {
 			delete[] eventMap;
+			delete[] eventStubMap;
 		}
 		eventMap = NULL;
+		eventStubMap = NULL;
 	}
 	typeNum = 0;
 	lastChild = 0;
@@ -930,6 +937,15 @@ bool idClass::ProcessEvent( const idEventDef *ev, idEventArg arg1, idEventArg ar
 	return ProcessEventArgs( ev, 8, &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7, &arg8 );
 }
 
+/*
+================
+idEventStub0
+================
+*/
+void idEventStub0( idClass *obj, eventCallback_t callback, const int *data ) {
+	( obj->*callback )();
+}
+
 /*
 ================
 idClass::ProcessEventArgPtr
@@ -957,83 +973,8 @@ bool idClass::ProcessEventArgPtr( const idEventDef *ev, int *data ) {
 
 	callback = c->eventMap[ num ];
 
-#if !CPU_EASYARGS
-
-/*
-on ppc architecture, floats are passed in a seperate set of registers
-the function prototypes must have matching float declaration
-
-http://developer.apple.com/documentation/DeveloperTools/Conceptual/MachORuntime/2rt_powerpc_abi/chapter_9_section_5.html
-*/
-
-	switch( ev->GetFormatspecIndex() ) {
-	case 1 << D_EVENT_MAXARGS :
-		( this->*callback )();
-		break;
-
-// generated file - see CREATE_EVENT_CODE
-#include "Callbacks.cpp"
-
-	default:
-		gameLocal.Warning( "Invalid formatspec on event '%s'", ev->GetName() );
-		break;
-	}
-
-#else
-
-	assert( D_EVENT_MAXARGS == 8 );
-
-	switch( ev->GetNumArgs() ) {
-	case 0 :
-		( this->*callback )();
-		break;
-
-	case 1 :
-		typedef void ( idClass::*eventCallback_1_t )( const int );
-		( this->*( eventCallback_1_t )callback )( data[ 0 ] );
-		break;
-
-	case 2 :
-		typedef void ( idClass::*eventCallback_2_t )( const int, const int );
-		( this->*( eventCallback_2_t )callback )( data[ 0 ], data[ 1 ] );
-		break;
-
-	case 3 :
-		typedef void ( idClass::*eventCallback_3_t )( const int, const int, const int );
-		( this->*( eventCallback_3_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ] );
-		break;
-
-	case 4 :
-		typedef void ( idClass::*eventCallback_4_t )( const int, const int, const int, const int );
-		( this->*( eventCallback_4_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ] );
-		break;
-
-	case 5 :
-		typedef void ( idClass::*eventCallback_5_t )( const int, const int, const int, const int, const int );
-		( this->*( eventCallback_5_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ], data[ 4 ] );
-		break;
-
-	case 6 :
-		typedef void ( idClass::*eventCallback_6_t )( const int, const int, const int, const int, const int, const int );
-		( this->*( eventCallback_6_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ], data[ 4 ], data[ 5 ] );
-		break;
-
-	case 7 :
-		typedef void ( idClass::*eventCallback_7_t )( const int, const int, const int, const int, const int, const int, const int );
-		( this->*( eventCallback_7_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ], data[ 4 ], data[ 5 ], data[ 6 ] );
-		break;
-
-	case 8 :
-		typedef void ( idClass::*eventCallback_8_t )( const int, const int, const int, const int, const int, const int, const int, const int );
-		( this->*( eventCallback_8_t )callback )( data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ], data[ 4 ], data[ 5 ], data[ 6 ], data[ 7 ] );
-		break;
-
-	default:
-		gameLocal.Warning( "Invalid formatspec on event '%s'", ev->GetName() );
-		break;
-	}
-
-#endif
+	// the stub converts the argument slots to the parameter types of the callback
+	c->eventStubMap[ num ]( this, callback, data );
 
 	return true;
 }
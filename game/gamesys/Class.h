@@ -41,14 +41,166 @@ extern const idEventDef EV_SafeRemove;
 
 typedef void ( idClass::*eventCallback_t )( void );
 
+/*
+================
+Event stubs
+
+An event stub calls an event callback with the argument slots filled in by
+idClass::ProcessEventArgPtr, converted to the parameter types of the callback:
+floats are passed as floats, pointers and references are read from their slots.
+EVENT picks the stub from the signature of the Event_ function at compile time,
+so there is one stub per distinct signature and no format string is parsed
+when the event is called.
+================
+*/
+typedef void ( *eventStub_t )( idClass *obj, eventCallback_t callback, const int *data );
+
+template< class Type >
+struct idEventArgCast {
+	static Type				Get( const int &data ) { return ( Type )data; }
+};
+
+template<>
+struct idEventArgCast< float > {
+	static float			Get( const int &data ) { return *reinterpret_cast< const float * >( &data ); }
+};
+
+template< class Type >
+struct idEventArgCast< Type * > {
+	static Type *			Get( const int &data ) { return *reinterpret_cast< Type * const * >( &data ); }
+};
+
+template< class Type >
+struct idEventArgCast< Type & > {
+	static Type &			Get( const int &data ) { return **reinterpret_cast< Type * const * >( &data ); }
+};
+
+// strings and vectors passed by value or as idStr are copied from the slot pointer
+template<>
+struct idEventArgCast< idStr > {
+	static idStr			Get( const int &data ) { return idStr( *reinterpret_cast< const char * const * >( &data ) ); }
+};
+
+template<>
+struct idEventArgCast< const idStr & > {
+	static idStr			Get( const int &data ) { return idStr( *reinterpret_cast< const char * const * >( &data ) ); }
+};
+
+template<>
+struct idEventArgCast< idVec3 > {
+	static idVec3			Get( const int &data ) { return **reinterpret_cast< const idVec3 * const * >( &data ); }
+};
+
+template<>
+struct idEventArgCast< idAngles > {
+	static idAngles			Get( const int &data ) { const idVec3 &v = **reinterpret_cast< const idVec3 * const * >( &data ); return idAngles( v.x, v.y, v.z ); }
+};
+
+void idEventStub0( idClass *obj, eventCallback_t callback, const int *data );
+
+template< class A1 >
+void idEventStub1( idClass *obj, eventCallback_t callback, const int *data ) {
+	typedef void ( idClass::*stubCallback_t )( A1 );
+	( obj->*reinterpret_cast< stubCallback_t >( callback ) )( idEventArgCast< A1 >::Get( data[ 0 ] ) );
+}
+
+template< class A1, class A2 >
+void idEventStub2( idClass *obj, eventCallback_t callback, const int *data ) {
+	typedef void ( idClass::*stubCallback_t )( A1, A2 );
+	( obj->*reinterpret_cast< stubCallback_t >( callback ) )( idEventArgCast< A1 >::Get( data[ 0 ] ), idEventArgCast< A2 >::Get( data[ 1 ] ) );
+}
+
+template< class A1, class A2, class A3 >
+void idEventStub3( idClass *obj, eventCallback_t callback, const int *data ) {
+	typedef void ( idClass::*stubCallback_t )( A1, A2, A3 );
+	( obj->*reinterpret_cast< stubCallback_t >( callback ) )( idEventArgCast< A1 >::Get( data[ 0 ] ), idEventArgCast< A2 >::Get( data[ 1 ] ),
+		idEventArgCast< A3 >::Get( data[ 2 ] ) );
+}
+
+template< class A1, class A2, class A3, class A4 >
+void idEventStub4( idClass *obj, eventCallback_t callback, const int *data ) {
+	typedef void ( idClass::*stubCallback_t )( A1, A2, A3, A4 );
+	( obj->*reinterpret_cast< stubCallback_t >( callback ) )( idEventArgCast< A1 >::Get( data[ 0 ] ), idEventArgCast< A2 >::Get( data[ 1 ] ),
+		idEventArgCast< A3 >::Get( data[ 2 ] ), idEventArgCast< A4 >::Get( data[ 3 ] ) );
+}
+
+template< class A1, class A2, class A3, class A4, class A5 >
+void idEventStub5( idClass *obj, eventCallback_t callback, const int *data ) {
+	typedef void ( idClass::*stubCallback_t )( A1, A2, A3, A4, A5 );
+	( obj->*reinterpret_cast< stubCallback_t >( callback ) )( idEventArgCast< A1 >::Get( data[ 0 ] ), idEventArgCast< A2 >::Get( data[ 1 ] ),
+		idEventArgCast< A3 >::Get( data[ 2 ] ), idEventArgCast< A4 >::Get( data[ 3 ] ), idEventArgCast< A5 >::Get( data[ 4 ] ) );
+}
+
+template< class A1, class A2, class A3, class A4, class A5, class A6 >
+void idEventStub6( idClass *obj, eventCallback_t callback, const int *data ) {
+	typedef void ( idClass::*stubCallback_t )( A1, A2, A3, A4, A5, A6 );
+	( obj->*reinterpret_cast< stubCallback_t >( callback ) )( idEventArgCast< A1 >::Get( data[ 0 ] ), idEventArgCast< A2 >::Get( data[ 1 ] ),
+		idEventArgCast< A3 >::Get( data[ 2 ] ), idEventArgCast< A4 >::Get( data[ 3 ] ), idEventArgCast< A5 >::Get( data[ 4 ] ),
+		idEventArgCast< A6 >::Get( data[ 5 ] ) );
+}
+
+template< class A1, class A2, class A3, class A4, class A5, class A6, class A7 >
+void idEventStub7( idClass *obj, eventCallback_t callback, const int *data ) {
+	typedef void ( idClass::*stubCallback_t )( A1, A2, A3, A4, A5, A6, A7 );
+	( obj->*reinterpret_cast< stubCallback_t >( callback ) )( idEventArgCast< A1 >::Get( data[ 0 ] ), idEventArgCast< A2 >::Get( data[ 1 ] ),
+		idEventArgCast< A3 >::Get( data[ 2 ] ), idEventArgCast< A4 >::Get( data[ 3 ] ), idEventArgCast< A5 >::Get( data[ 4 ] ),
+		idEventArgCast< A6 >::Get( data[ 5 ] ), idEventArgCast< A7 >::Get( data[ 6 ] ) );
+}
+
+template< class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8 >
+void idEventStub8( idClass *obj, eventCallback_t callback, const int *data ) {
+	typedef void ( idClass::*stubCallback_t )( A1, A2, A3, A4, A5, A6, A7, A8 );
+	( obj->*reinterpret_cast< stubCallback_t >( callback ) )( idEventArgCast< A1 >::Get( data[ 0 ] ), idEventArgCast< A2 >::Get( data[ 1 ] ),
+		idEventArgCast< A3 >::Get( data[ 2 ] ), idEventArgCast< A4 >::Get( data[ 3 ] ), idEventArgCast< A5 >::Get( data[ 4 ] ),
+		idEventArgCast< A6 >::Get( data[ 5 ] ), idEventArgCast< A7 >::Get( data[ 6 ] ), idEventArgCast< A8 >::Get( data[ 7 ] ) );
+}
+
+template< class R, class C >
+eventStub_t idEventStubFor( R ( C::* )( void ) ) { return &idEventStub0; }
+template< class R, class C, class A1 >
+eventStub_t idEventStubFor( R ( C::* )( A1 ) ) { return &idEventStub1< A1 >; }
+template< class R, class C, class A1, class A2 >
+eventStub_t idEventStubFor( R ( C::* )( A1, A2 ) ) { return &idEventStub2< A1, A2 >; }
+template< class R, class C, class A1, class A2, class A3 >
+eventStub_t idEventStubFor( R ( C::* )( A1, A2, A3 ) ) { return &idEventStub3< A1, A2, A3 >; }
+template< class R, class C, class A1, class A2, class A3, class A4 >
+eventStub_t idEventStubFor( R ( C::* )( A1, A2, A3, A4 ) ) { return &idEventStub4< A1, A2, A3, A4 >; }
+template< class R, class C, class A1, class A2, class A3, class A4, class A5 >
+eventStub_t idEventStubFor( R ( C::* )( A1, A2, A3, A4, A5 ) ) { return &idEventStub5< A1, A2, A3, A4, A5 >; }
+template< class R, class C, class A1, class A2, class A3, class A4, class A5, class A6 >
+eventStub_t idEventStubFor( R ( C::* )( A1, A2, A3, A4, A5, A6 ) ) { return &idEventStub6< A1, A2, A3, A4, A5, A6 >; }
+template< class R, class C, class A1, class A2, class A3, class A4, class A5, class A6, class A7 >
+eventStub_t idEventStubFor( R ( C::* )( A1, A2, A3, A4, A5, A6, A7 ) ) { return &idEventStub7< A1, A2, A3, A4, A5, A6, A7 >; }
+template< class R, class C, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8 >
+eventStub_t idEventStubFor( R ( C::* )( A1, A2, A3, A4, A5, A6, A7, A8 ) ) { return &idEventStub8< A1, A2, A3, A4, A5, A6, A7, A8 >; }
+template< class R, class C >
+eventStub_t idEventStubFor( R ( C::* )( void ) const ) { return &idEventStub0; }
+template< class R, class C, class A1 >
+eventStub_t idEventStubFor( R ( C::* )( A1 ) const ) { return &idEventStub1< A1 >; }
+template< class R, class C, class A1, class A2 >
+eventStub_t idEventStubFor( R ( C::* )( A1, A2 ) const ) { return &idEventStub2< A1, A2 >; }
+template< class R, class C, class A1, class A2, class A3 >
+eventStub_t idEventStubFor( R ( C::* )( A1, A2, A3 ) const ) { return &idEventStub3< A1, A2, A3 >; }
+template< class R, class C, class A1, class A2, class A3, class A4 >
+eventStub_t idEventStubFor( R ( C::* )( A1, A2, A3, A4 ) const ) { return &idEventStub4< A1, A2, A3, A4 >; }
+template< class R, class C, class A1, class A2, class A3, class A4, class A5 >
+eventStub_t idEventStubFor( R ( C::* )( A1, A2, A3, A4, A5 ) const ) { return &idEventStub5< A1, A2, A3, A4, A5 >; }
+template< class R, class C, class A1, class A2, class A3, class A4, class A5, class A6 >
+eventStub_t idEventStubFor( R ( C::* )( A1, A2, A3, A4, A5, A6 ) const ) { return &idEventStub6< A1, A2, A3, A4, A5, A6 >; }
+template< class R, class C, class A1, class A2, class A3, class A4, class A5, class A6, class A7 >
+eventStub_t idEventStubFor( R ( C::* )( A1, A2, A3, A4, A5, A6, A7 ) const ) { return &idEventStub7< A1, A2, A3, A4, A5, A6, A7 >; }
+template< class R, class C, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8 >
+eventStub_t idEventStubFor( R ( C::* )( A1, A2, A3, A4, A5, A6, A7, A8 ) const ) { return &idEventStub8< A1, A2, A3, A4, A5, A6, A7, A8 >; }
+
 template< class Type >
 struct idEventFunc {
 	const idEventDef	*event;
 	eventCallback_t		function;
+	eventStub_t			stub;
 };
 
 // added & so gcc could compile this
-#define EVENT( event, function )	{ &( event ), ( void ( idClass::* )( void ) )( &function ) },
+#define EVENT( event, function )	{ &( event ), ( void ( idClass::* )( void ) )( &function ), idEventStubFor( &function ) },
 #define END_CLASS					{ NULL, NULL } };
 
 
@@ -277,6 +429,7 @@ public:
 
 	idEventFunc<idClass> *		eventCallbacks;
 	eventCallback_t *			eventMap;
+	eventStub_t *				eventStubMap;		// the stubs of the eventMap callbacks
 	idTypeInfo *				super;
 	idTypeInfo *				next;
 	bool						freeEventMap;
@@ -35,7 +35,6 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #include "../Game_local.h"
 
 #define MAX_EVENTSPERFRAME			8192
-//#define CREATE_EVENT_CODE
 
 /***********************************************************************
 
@@ -240,13 +239,175 @@ const idEventDef *idEventDef::FindEvent( const char *name ) {
 
 ***********************************************************************/
 
+/*
+The scheduled events are kept in a timer wheel of EVENT_BUCKETS lists, each holding the
+events due within EVENT_BUCKET_MSEC sorted by time, so scheduling an event only scans
+the events due at about the same time.  The events beyond the span of the wheel wait in
+a sorted far list and move onto the wheel as it turns.  Events due at the same time are
+serviced in the order they were scheduled.
+*/
+#define EVENT_BUCKET_SHIFT			4
+#define EVENT_BUCKET_MSEC			( 1 << EVENT_BUCKET_SHIFT )
+#define EVENT_BUCKETS				256
+#define EVENT_WHEEL_MSEC			( EVENT_BUCKETS * EVENT_BUCKET_MSEC )
+#define EVENT_FAR_BUCKET			EVENT_BUCKETS		// index of the far list
+#define EVENT_NO_BUCKET				-1
+
 static idLinkList<idEvent> FreeEvents;
-static idLinkList<idEvent> EventQueue;
+static idLinkList<idEvent> EventBuckets[ EVENT_BUCKETS + 1 ];
 static idEvent EventPool[ MAX_EVENTS ];
 
+static int EventWheelTime;			// start time of the current bucket
+static int EventWheelBucket;		// the bucket of EventWheelTime
+static int NumWheelEvents;			// scheduled events on the wheel
+static int NumScheduledEvents;		// scheduled events on the wheel and in the far list
+
+/*
+The argument data is stored in fixed size slabs, in size classes from 16 to 2048 bytes,
+larger argument sets are allocated from the heap.
+*/
+#define EVENT_ARG_MIN_SHIFT			4
+#define EVENT_ARG_CLASSES			8
+#define EVENT_ARG_BLOCK_SIZE		( 16 * 1024 )
+
+class idEventArgAllocator {
+public:
+	void					Init( void );
+	void					Shutdown( void );
+
+	byte *					Alloc( size_t size );
+	void					Free( byte *data, size_t size );
+
+	int						GetAllocCount( void ) const { return numAllocs; }
+	int						GetBlockCount( void ) const { return blocks.Num(); }
+
+private:
+	byte *					freeSlabs[ EVENT_ARG_CLASSES ];
+	idList<byte *>			blocks;
+	int						numAllocs;
+
+	static int				SizeClass( size_t size );
+};
+
+static idEventArgAllocator EventArgAllocator;
+
+/*
+================
+idEventArgAllocator::Init
+================
+*/
+void idEventArgAllocator::Init( void ) {
+	memset( freeSlabs, 0, sizeof( freeSlabs ) );
+	blocks.Clear();
+	numAllocs = 0;
+}
+
+/*
+================
+idEventArgAllocator::Shutdown
+================
+*/
+void idEventArgAllocator::Shutdown( void ) {
+	for ( int i = 0; i < blocks.Num(); i++ ) {
+		Mem_Free16( blocks[i] );
+	}
+	Init();
+}
+
+/*
+================
+idEventArgAllocator::SizeClass
+
+Returns -1 for the sizes allocated from the heap
+================
+*/
+int idEventArgAllocator::SizeClass( size_t size ) {
+	for ( int i = 0; i < EVENT_ARG_CLASSES; i++ ) {
+		if ( size <= ( 1 << ( i + EVENT_ARG_MIN_SHIFT ) ) ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+idEventArgAllocator::Alloc
+================
+*/
+byte *idEventArgAllocator::Alloc( size_t size ) {
+	int sizeClass = SizeClass( size );
+
+	numAllocs++;
+
+	if ( sizeClass < 0 ) {
+		return static_cast<byte *>( Mem_Alloc16( size ) );
+	}
+
+	if ( freeSlabs[ sizeClass ] == NULL ) {
+		// carve a new block into slabs
+		int slabSize = 1 << ( sizeClass + EVENT_ARG_MIN_SHIFT );
+		int numSlabs = Max( 1, EVENT_ARG_BLOCK_SIZE / slabSize );
+		byte *block = static_cast<byte *>( Mem_Alloc16( slabSize * numSlabs ) );
+
+		blocks.Append( block );
+		for ( int i = numSlabs - 1; i >= 0; i-- ) {
+			byte *slab = block + i * slabSize;
+			*reinterpret_cast<byte **>( slab ) = freeSlabs[ sizeClass ];
+			freeSlabs[ sizeClass ] = slab;
+		}
+	}
+
+	byte *slab = freeSlabs[ sizeClass ];
+	freeSlabs[ sizeClass ] = *reinterpret_cast<byte **>( slab );
+
+	return slab;
+}
+
+/*
+================
+idEventArgAllocator::Free
+================
+*/
+void idEventArgAllocator::Free( byte *data, size_t size ) {
+	int sizeClass = SizeClass( size );
+
+	numAllocs--;
+
+	if ( sizeClass < 0 ) {
+		Mem_Free16( data );
+		return;
+	}
+
+	*reinterpret_cast<byte **>( data ) = freeSlabs[ sizeClass ];
+	freeSlabs[ sizeClass ] = data;
+}
+
+// the number of times each event was posted, serviced and cancelled, for the eventStats command
+typedef struct eventStats_s {
+	int						posted;
+	int						serviced;
+	int						cancelled;
+} eventStats_t;
+
+static eventStats_t EventStats[ MAX_EVENTS ];
+static int MaxScheduledEvents;
+
 bool idEvent::initialized = false;
 
-idDynamicBlockAlloc<byte, 16 * 1024, 256>	idEvent::eventDataAllocator;
+/*
+================
+idEvent::idEvent()
+================
+*/
+idEvent::idEvent() {
+	eventdef	= NULL;
+	data		= NULL;
+	time		= 0;
+	object		= NULL;
+	typeinfo	= NULL;
+	bucket		= EVENT_NO_BUCKET;
+}
 
 /*
 ================
@@ -286,7 +447,7 @@ idEvent *idEvent::Alloc( const idEventDef *evdef, int numargs, va_list args ) {
 
 	size = evdef->GetArgSize();
 	if ( size ) {
-		ev->data = eventDataAllocator.Alloc( size );
+		ev->data = EventArgAllocator.Alloc( size );
 		memset( ev->data, 0, size );
 	} else {
 		ev->data = NULL;
@@ -387,8 +548,10 @@ idEvent::Free
 ================
 */
 void idEvent::Free( void ) {
+	Unlink();
+
 	if ( data ) {
-		eventDataAllocator.Free( data );
+		EventArgAllocator.Free( data, eventdef->GetArgSize() );
 		data = NULL;
 	}
 
@@ -420,18 +583,137 @@ void idEvent::Schedule( idClass *obj, const idTypeInfo *type, int time ) {
 	// wraps after 24 days...like I care. ;)
 	this->time = gameLocal.time + time;
 
-	eventNode.Remove();
+	Unlink();
+
+	// start the wheel at the current time
+	if ( NumScheduledEvents == 0 ) {
+		EventWheelTime = gameLocal.time & ~( EVENT_BUCKET_MSEC - 1 );
+		EventWheelBucket = ( EventWheelTime >> EVENT_BUCKET_SHIFT ) & ( EVENT_BUCKETS - 1 );
+	}
+
+	Link();
 
-	event = EventQueue.Next();
-	while( ( event != NULL ) && ( this->time >= event->time ) ) {
-		event = event->eventNode.Next();
+	EventStats[ eventdef->GetEventNum() ].posted++;
+	if ( NumScheduledEvents > MaxScheduledEvents ) {
+		MaxScheduledEvents = NumScheduledEvents;
+	}
+}
+
+/*
+================
+idEvent::Link
+
+Inserts the event into the bucket of its time, after the events due at the same time
+================
+*/
+void idEvent::Link( void ) {
+	idEvent *event;
+
+	assert( bucket == EVENT_NO_BUCKET );
+
+	if ( time >= EventWheelTime + EVENT_WHEEL_MSEC ) {
+		bucket = EVENT_FAR_BUCKET;
+	} else if ( time < EventWheelTime ) {
+		// overdue, serviced before the other events of the current bucket
+		bucket = EventWheelBucket;
+	} else {
+		bucket = ( time >> EVENT_BUCKET_SHIFT ) & ( EVENT_BUCKETS - 1 );
+	}
+
+	idLinkList<idEvent> &list = EventBuckets[ bucket ];
+
+	// most events are scheduled after the ones already in the bucket
+	for ( event = list.Prev(); ( event != NULL ) && ( event->time > time ); event = event->eventNode.Prev() ) {
 	}
 
 	if ( event ) {
-		eventNode.InsertBefore( event->eventNode );
+		eventNode.InsertAfter( event->eventNode );
 	} else {
-		eventNode.AddToEnd( EventQueue );
+		eventNode.AddToFront( list );
+	}
+
+	if ( bucket != EVENT_FAR_BUCKET ) {
+		NumWheelEvents++;
+	}
+	NumScheduledEvents++;
+}
+
+/*
+================
+idEvent::Unlink
+
+Removes the event from its bucket if it is scheduled
+================
+*/
+void idEvent::Unlink( void ) {
+	if ( bucket == EVENT_NO_BUCKET ) {
+		return;
 	}
+
+	eventNode.Remove();
+
+	if ( bucket != EVENT_FAR_BUCKET ) {
+		NumWheelEvents--;
+	}
+	NumScheduledEvents--;
+
+	bucket = EVENT_NO_BUCKET;
+}
+
+/*
+================
+idEvent::AdvanceWheel
+
+Moves the wheel to the next bucket, or straight to the current time or the first
+far event when the wheel is empty, and moves the far events coming into its span
+================
+*/
+void idEvent::AdvanceWheel( void ) {
+	idEvent *event;
+
+	int wheelTime = EventWheelTime + EVENT_BUCKET_MSEC;
+	if ( NumWheelEvents == 0 ) {
+		int target = gameLocal.time;
+		event = EventBuckets[ EVENT_FAR_BUCKET ].Next();
+		if ( ( event != NULL ) && ( event->time < target ) ) {
+			target = event->time;
+		}
+		wheelTime = Max( wheelTime, target & ~( EVENT_BUCKET_MSEC - 1 ) );
+	}
+
+	EventWheelTime = wheelTime;
+	EventWheelBucket = ( EventWheelTime >> EVENT_BUCKET_SHIFT ) & ( EVENT_BUCKETS - 1 );
+
+	// the far list is sorted, and the buckets the events move to were beyond the wheel so far
+	while ( ( ( event = EventBuckets[ EVENT_FAR_BUCKET ].Next() ) != NULL ) && ( event->time < EventWheelTime + EVENT_WHEEL_MSEC ) ) {
+		event->Unlink();
+		event->Link();
+	}
+}
+
+/*
+================
+idEvent::FirstEvent
+
+Returns the first scheduled event if it could be due at the current time
+================
+*/
+idEvent *idEvent::FirstEvent( void ) {
+	while ( NumScheduledEvents > 0 ) {
+		idEvent *event = EventBuckets[ EventWheelBucket ].Next();
+		if ( event != NULL ) {
+			return event;
+		}
+
+		// the later buckets aren't due yet
+		if ( EventWheelTime + EVENT_BUCKET_MSEC > gameLocal.time ) {
+			break;
+		}
+
+		AdvanceWheel();
+	}
+
+	return NULL;
 }
 
 /*
@@ -447,11 +729,14 @@ void idEvent::CancelEvents( const idClass *obj, const idEventDef *evdef ) {
 		return;
 	}
 
-	for( event = EventQueue.Next(); event != NULL; event = next ) {
-		next = event->eventNode.Next();
-		if ( event->object == obj ) {
-			if ( !evdef || ( evdef == event->eventdef ) ) {
-				event->Free();
+	for ( int i = 0; ( i <= EVENT_FAR_BUCKET ) && ( NumScheduledEvents > 0 ); i++ ) {
+		for( event = EventBuckets[ i ].Next(); event != NULL; event = next ) {
+			next = event->eventNode.Next();
+			if ( event->object == obj ) {
+				if ( !evdef || ( evdef == event->eventdef ) ) {
+					EventStats[ event->eventdef->GetEventNum() ].cancelled++;
+					event->Free();
+				}
 			}
 		}
 	}
@@ -469,12 +754,20 @@ void idEvent::ClearEventList( void ) {
 	// initialize lists
 	//
 	FreeEvents.Clear();
-	EventQueue.Clear();
+	for( i = 0; i <= EVENT_FAR_BUCKET; i++ ) {
+		EventBuckets[ i ].Clear();
+	}
+
+	EventWheelTime = 0;
+	EventWheelBucket = 0;
+	NumWheelEvents = 0;
+	NumScheduledEvents = 0;
    
 	// 
 	// add the events to the free list
 	//
 	for( i = 0; i < MAX_EVENTS; i++ ) {
+		EventPool[ i ].bucket = EVENT_NO_BUCKET;
 		EventPool[ i ].Free();
 	}
 }
@@ -498,10 +791,7 @@ void idEvent::ServiceEvents( void ) {
 	const char  *materialName;
 
 	num = 0;
-	while( !EventQueue.IsListEmpty() ) {
-		event = EventQueue.Next();
-		assert( event );
-
+	while( ( event = FirstEvent() ) != NULL ) {
 		if ( event->time > gameLocal.time ) {
 			break;
 		}
@@ -554,8 +844,9 @@ void idEvent::ServiceEvents( void ) {
 
 		// the event is removed from its list so that if then object
 		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		event->Unlink();
 		assert( event->object );
+		EventStats[ ev->GetEventNum() ].serviced++;
 		event->object->ProcessEventArgPtr( ev, args );
 
 #if 0
@@ -578,6 +869,60 @@ void idEvent::ServiceEvents( void ) {
 	}
 }
 
+/*
+================
+idEvent::ClearStats
+================
+*/
+void idEvent::ClearStats( void ) {
+	memset( EventStats, 0, sizeof( EventStats ) );
+	MaxScheduledEvents = NumScheduledEvents;
+}
+
+/*
+================
+idEvent::SortStatsByPosted
+================
+*/
+int idEvent::SortStatsByPosted( const int *a, const int *b ) {
+	return EventStats[ *b ].posted - EventStats[ *a ].posted;
+}
+
+/*
+================
+idEvent::PrintStats
+================
+*/
+void idEvent::PrintStats( void ) {
+	idList<int> eventNums;
+	eventStats_t total;
+	int i;
+
+	memset( &total, 0, sizeof( total ) );
+
+	for ( i = 0; i < idEventDef::NumEventCommands(); i++ ) {
+		const eventStats_t &stats = EventStats[ i ];
+		if ( stats.posted || stats.serviced || stats.cancelled ) {
+			eventNums.Append( i );
+			total.posted += stats.posted;
+			total.serviced += stats.serviced;
+			total.cancelled += stats.cancelled;
+		}
+	}
+	eventNums.Sort( SortStatsByPosted );
+
+	gameLocal.Printf( "%8s %8s %9s  %s\n", "posted", "serviced", "cancelled", "event" );
+	for ( i = 0; i < eventNums.Num(); i++ ) {
+		const eventStats_t &stats = EventStats[ eventNums[i] ];
+		gameLocal.Printf( "%8d %8d %9d  %s\n", stats.posted, stats.serviced, stats.cancelled, idEventDef::GetEventCommand( eventNums[i] )->GetName() );
+	}
+	gameLocal.Printf( "%8d %8d %9d  total of %d events\n", total.posted, total.serviced, total.cancelled, eventNums.Num() );
+
+	gameLocal.Printf( "%d events scheduled, %d on the wheel, %d in the far list, at most %d of %d\n",
+		NumScheduledEvents, NumWheelEvents, NumScheduledEvents - NumWheelEvents, MaxScheduledEvents, MAX_EVENTS );
+	gameLocal.Printf( "%d argument sets allocated, %d slab blocks\n", EventArgAllocator.GetAllocCount(), EventArgAllocator.GetBlockCount() );
+}
+
 /*
 ================
 idEvent::Init
@@ -590,21 +935,17 @@ void idEvent::Init( void ) {
 		gameLocal.Error( "%s", eventErrorMsg );
 	}
 
-#ifdef CREATE_EVENT_CODE
-	void CreateEventCallbackHandler();
-	CreateEventCallbackHandler();
-	gameLocal.Error( "Wrote event callback handler" );
-#endif
-
 	if ( initialized ) {
 		gameLocal.Printf( "...already initialized\n" );
 		ClearEventList();
+		ClearStats();
 		return;
 	}
 
 	ClearEventList();
 
-	eventDataAllocator.Init();
+	EventArgAllocator.Init();
+	ClearStats();
 
 	gameLocal.Printf( "...%i event definitions\n", idEventDef::NumEventCommands() );
 
@@ -627,7 +968,7 @@ void idEvent::Shutdown( void ) {
 
 	ClearEventList();
 	
-	eventDataAllocator.Shutdown();
+	EventArgAllocator.Shutdown();
 
 	// say it is now shut down
 	initialized = false;
@@ -647,59 +988,64 @@ void idEvent::Save( idSaveGame *savefile ) {
 	bool validTrace;
 	const char	*format;
 
-	savefile->WriteInt( EventQueue.Num() );
-
-	event = EventQueue.Next();
-	while( event != NULL ) {
-		savefile->WriteInt( event->time );
-		savefile->WriteString( event->eventdef->GetName() );
-		savefile->WriteString( event->typeinfo->classname );
-		savefile->WriteObject( event->object );
-		savefile->WriteInt( event->eventdef->GetArgSize() );
-		format = event->eventdef->GetArgFormat();
-		for ( i = 0, size = 0; i < event->eventdef->GetNumArgs(); ++i) {
-			dataPtr = &event->data[ event->eventdef->GetArgOffset( i ) ];
-			switch( format[ i ] ) {
-				case D_EVENT_FLOAT :
-					savefile->WriteFloat( *reinterpret_cast<float *>( dataPtr ) );
-					size += sizeof( float );
-					break;
-				case D_EVENT_INTEGER :
-				case D_EVENT_ENTITY :
-				case D_EVENT_ENTITY_NULL :
-					savefile->WriteInt( *reinterpret_cast<int *>( dataPtr ) );
-					size += sizeof( int );
-					break;
-				case D_EVENT_VECTOR :
-					savefile->WriteVec3( *reinterpret_cast<idVec3 *>( dataPtr ) );
-					size += sizeof( idVec3 );
-					break;
-				case D_EVENT_TRACE :
-					validTrace = *reinterpret_cast<bool *>( dataPtr );
-					savefile->WriteBool( validTrace );
-					size += sizeof( bool );
-					if ( validTrace ) {
-						size += sizeof( trace_t );
-						const trace_t &t = *reinterpret_cast<trace_t *>( dataPtr + sizeof( bool ) );
-						SaveTrace( savefile, t );
-						if ( t.c.material ) {
-							size += MAX_STRING_LEN;
-							str = reinterpret_cast<char *>( dataPtr + sizeof( bool ) + sizeof( trace_t ) );
-							savefile->Write( str, MAX_STRING_LEN );
+	savefile->WriteInt( NumScheduledEvents );
+
+	// the buckets from the current one on and the far list, in the order the events are due
+	for ( int n = 0; n <= EVENT_BUCKETS; n++ ) {
+		int bucket = ( n < EVENT_BUCKETS ) ? ( ( EventWheelBucket + n ) & ( EVENT_BUCKETS - 1 ) ) : EVENT_FAR_BUCKET;
+
+		event = EventBuckets[ bucket ].Next();
+		while( event != NULL ) {
+			savefile->WriteInt( event->time );
+			savefile->WriteString( event->eventdef->GetName() );
+			savefile->WriteString( event->typeinfo->classname );
+			savefile->WriteObject( event->object );
+			savefile->WriteInt( event->eventdef->GetArgSize() );
+			format = event->eventdef->GetArgFormat();
+			for ( i = 0, size = 0; i < event->eventdef->GetNumArgs(); ++i) {
+				dataPtr = &event->data[ event->eventdef->GetArgOffset( i ) ];
+				switch( format[ i ] ) {
+					case D_EVENT_FLOAT :
+						savefile->WriteFloat( *reinterpret_cast<float *>( dataPtr ) );
+						size += sizeof( float );
+						break;
+					case D_EVENT_INTEGER :
+					case D_EVENT_ENTITY :
+					case D_EVENT_ENTITY_NULL :
+						savefile->WriteInt( *reinterpret_cast<int *>( dataPtr ) );
+						size += sizeof( int );
+						break;
+					case D_EVENT_VECTOR :
+						savefile->WriteVec3( *reinterpret_cast<idVec3 *>( dataPtr ) );
+						size += sizeof( idVec3 );
+						break;
+					case D_EVENT_TRACE :
+						validTrace = *reinterpret_cast<bool *>( dataPtr );
+						savefile->WriteBool( validTrace );
+						size += sizeof( bool );
+						if ( validTrace ) {
+							size += sizeof( trace_t );
+							const trace_t &t = *reinterpret_cast<trace_t *>( dataPtr + sizeof( bool ) );
+							SaveTrace( savefile, t );
+							if ( t.c.material ) {
+								size += MAX_STRING_LEN;
+								str = reinterpret_cast<char *>( dataPtr + sizeof( bool ) + sizeof( trace_t ) );
+								savefile->Write( str, MAX_STRING_LEN );
+							}
 						}
-					}
-					break;
-				case D_EVENT_STRING : // grayman #3649 - wasn't being handled
-					size += MAX_STRING_LEN;
-					str = reinterpret_cast<char *>( dataPtr );
-					savefile->Write( str, MAX_STRING_LEN );
-					break;
-				default:
-					break;
+						break;
+					case D_EVENT_STRING : // grayman #3649 - wasn't being handled
+						size += MAX_STRING_LEN;
+						str = reinterpret_cast<char *>( dataPtr );
+						savefile->Write( str, MAX_STRING_LEN );
+						break;
+					default:
+						break;
+				}
 			}
+			assert( size == event->eventdef->GetArgSize() );
+			event = event->eventNode.Next();
 		}
-		assert( size == event->eventdef->GetArgSize() );
-		event = event->eventNode.Next();
 	}
 }
 
@@ -725,7 +1071,6 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 
 		event = FreeEvents.Next();
 		event->eventNode.Remove();
-		event->eventNode.AddToEnd( EventQueue );
 
 		savefile->ReadInt( event->time );
 
@@ -751,7 +1096,7 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 			savefile->Error( "idEvent::Restore: arg size (%d) doesn't match saved arg size(%d) on event '%s'", event->eventdef->GetArgSize(), argsize, event->eventdef->GetName() );
 		}
 		if ( argsize ) {
-			event->data = eventDataAllocator.Alloc( argsize );
+			event->data = EventArgAllocator.Alloc( argsize );
 			format = event->eventdef->GetArgFormat();
 			assert( format );
 			for ( j = 0, size = 0; j < event->eventdef->GetNumArgs(); ++j) {
@@ -798,6 +1143,13 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 		} else {
 			event->data = NULL;
 		}
+
+		// the events were saved in the order they are due
+		if ( NumScheduledEvents == 0 ) {
+			EventWheelTime = gameLocal.time & ~( EVENT_BUCKET_MSEC - 1 );
+			EventWheelBucket = ( EventWheelTime >> EVENT_BUCKET_SHIFT ) & ( EVENT_BUCKETS - 1 );
+		}
+		event->Link();
 	}
 }
 
@@ -848,63 +1200,3 @@ void idEvent::SaveTrace( idSaveGame *savefile, const trace_t &trace ) {
 	savefile->WriteInt( trace.c.trmFeature );
 	savefile->WriteInt( trace.c.id );
 }
-
-
-
-#ifdef CREATE_EVENT_CODE
-/*
-================
-CreateEventCallbackHandler
-================
-*/
-void CreateEventCallbackHandler( void ) {
-	int num;
-	int count;
-	int i, j, k;
-	char argString[ D_EVENT_MAXARGS + 1 ];
-	idStr string1;
-	idStr string2;
-	idFile *file;
-
-	file = fileSystem->OpenFileWrite( "Callbacks.cpp" );
-
-	file->Printf( "// generated file - see CREATE_EVENT_CODE\n\n" );
-
-	for( i = 1; i <= D_EVENT_MAXARGS; i++ ) {
-
-		file->Printf( "\t/*******************************************************\n\n\t\t%d args\n\n\t*******************************************************/\n\n", i );
-
-		for ( j = 0; j < ( 1 << i ); j++ ) {
-			for ( k = 0; k < i; k++ ) {
-				argString[ k ] = j & ( 1 << k ) ? 'f' : 'i';
-			}
-			argString[ i ] = '\0';
-			
-			string1.Empty();
-			string2.Empty();
-
-			for( k = 0; k < i; k++ ) {
-				if ( j & ( 1 << k ) ) {
-					string1 += "const float";
-					string2 += va( "*( float * )&data[ %d ]", k );
-				} else {
-					string1 += "const int";
-					string2 += va( "data[ %d ]", k );
-				}
-
-				if ( k < i - 1 ) {
-					string1 += ", ";
-					string2 += ", ";
-				}
-			}
-
-			file->Printf( "\tcase %d :\n\t\ttypedef void ( idClass::*eventCallback_%s_t )( %s );\n", ( 1 << ( i + D_EVENT_MAXARGS ) ) + j, argString, string1.c_str() );
-			file->Printf( "\t\t( this->*( eventCallback_%s_t )callback )( %s );\n\t\tbreak;\n\n", argString, string2.c_str() );
-
-		}
-	}
-
-	fileSystem->CloseFile( file );
-}
-
-#endif
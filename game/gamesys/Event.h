@@ -35,8 +35,7 @@ Event are used for scheduling tasks and for linking script commands.
 #include <cstring>
 #include "EventArgs.h"
 
-#define D_EVENT_MAXARGS				8			// if changed, enable the CREATE_EVENT_CODE define in Event.cpp to generate switch statement for idClass::ProcessEventArgPtr.
-												// running the game will then generate c:\doom\base\events.txt, the contents of which should be copied into the switch statement.
+#define D_EVENT_MAXARGS				8			// if changed, add the event stubs for the new argument counts in Class.h
 
 #define D_EVENT_VOID				( ( char )0 )
 #define D_EVENT_INTEGER				'd'
@@ -116,13 +115,19 @@ private:
 	const idTypeInfo			*typeinfo;
 
 	idLinkList<idEvent>			eventNode;
+	int							bucket;			// of the timer wheel, the far list or -1 if not scheduled
 
-	static idDynamicBlockAlloc<byte, 16 * 1024, 256> eventDataAllocator;
+	void						Link( void );
+	void						Unlink( void );
 
+	static void					AdvanceWheel( void );
+	static idEvent *			FirstEvent( void );
+	static int					SortStatsByPosted( const int *a, const int *b );
 
 public:
 	static bool					initialized;
 
+								idEvent();
 								~idEvent();
 
 	static idEvent				*Alloc( const idEventDef *evdef, int numargs, va_list args );
@@ -138,6 +143,10 @@ public:
 	static void					Init( void );
 	static void					Shutdown( void );
 
+	// counters per event definition for the eventStats command
+	static void					ClearStats( void );
+	static void					PrintStats( void );
+
 	// save games
 	static void					Save( idSaveGame *savefile );					// archives object for save game file
 	static void					Restore( idRestoreGame *savefile );				// unarchives object from save game file
@@ -102,7 +102,9 @@ void idSaveGame::Close( void ) {
 	idClipModel::SaveTraceModels( this );
 
 	for( i = 1; i < objects.Num(); i++ ) {
+		BeginProfile( objects[ i ]->GetClassname() );
 		CallSave_r( objects[ i ]->GetType(), objects[ i ] );
+		EndProfile();
 	}
 
 	objects.Clear();
@@ -115,33 +117,81 @@ void idSaveGame::Close( void ) {
 }
 
 void idSaveGame::FinalizeCache( void ) {
+	if ( profiler.IsEnabled() ) {
+		profiler.Report( "savegame", Position() );
+	}
+
 	if (!isCompressed) return;
 		
 	int offset = sizeof(int);
 
-	//resize destination buffer
-	CRawVector zipped;
-	int zipsize = compressBound(cache.size());
-	zipped.resize(zipsize);
+	//the cache is compressed in independent chunks, so they can be compressed and decompressed in parallel
+	const int numChunks = Max(1, (cache.size() + SAVEGAME_CACHE_CHUNK_SIZE - 1) / SAVEGAME_CACHE_CHUNK_SIZE);
+	const bool lz4 = cv_savegame_compress_lz4.GetBool();
+	const int chunkBound = lz4 ? idLZ4::CompressBound(SAVEGAME_CACHE_CHUNK_SIZE) : compressBound(SAVEGAME_CACHE_CHUNK_SIZE);
+	const int level = cv_savegame_compress_level.GetInteger();
 
-	//compress the cache
-	int err = compress((Bytef *)&zipped[0], (uLongf*)&zipsize,
-		(const Bytef *)&cache[0], cache.size());
-	if (err != Z_OK)
-		gameLocal.Error("idSaveGame::FinalizeCache: compress failed with code %d", err);
-	zipped.resize(zipsize);
+	//resize destination buffer, each chunk gets its own part
+	CRawVector zipped;
+	zipped.resize(numChunks * chunkBound);
+	idList<int> zipSizes, errors;
+	zipSizes.SetNum(numChunks);
+	errors.SetNum(numChunks);
+
+	//compress the cache, the fast levels save most of the time of the default one
+#pragma omp parallel for if ( numChunks > 1 ) schedule( dynamic, 1 )
+	for (int i = 0; i < numChunks; i++) {
+		const int start = i * SAVEGAME_CACHE_CHUNK_SIZE;
+		const int size = Min(SAVEGAME_CACHE_CHUNK_SIZE, cache.size() - start);
+		if (lz4) {
+			zipSizes[i] = idLZ4::Compress((const byte *)&cache[0] + start, size, (byte *)&zipped[i * chunkBound], chunkBound);
+			errors[i] = zipSizes[i] > 0 ? Z_OK : Z_BUF_ERROR;
+			continue;
+		}
+		uLongf zipSize = chunkBound;
+		errors[i] = compress2((Bytef *)&zipped[i * chunkBound], &zipSize,
+			(const Bytef *)&cache[0] + start, size, level);
+		zipSizes[i] = zipSize;
+	}
+	for (int i = 0; i < numChunks; i++) {
+		if (errors[i] != Z_OK)
+			gameLocal.Error("idSaveGame::FinalizeCache: compress failed with code %d", errors[i]);
+	}
 
-	//write compressed size and uncompressed size
-	file->WriteInt(zipped.size());				offset += sizeof(int);
+	//write the number of chunks as a negative compressed size, the uncompressed size and the chunk sizes
+	//the uncompressed chunk size is negative for LZ4 chunks
+	file->WriteInt(-numChunks);					offset += sizeof(int);
 	file->WriteInt(cache.size());				offset += sizeof(int);
+	file->WriteInt(lz4 ? -SAVEGAME_CACHE_CHUNK_SIZE : SAVEGAME_CACHE_CHUNK_SIZE);	offset += sizeof(int);
+	for (int i = 0; i < numChunks; i++) {
+		file->WriteInt(zipSizes[i]);			offset += sizeof(int);
+	}
 	//write compressed data
-	file->Write(&zipped[0], zipped.size());		offset += zipped.size();
+	for (int i = 0; i < numChunks; i++) {
+		file->Write(&zipped[i * chunkBound], zipSizes[i]);	offset += zipSizes[i];
+	}
 	//write offset from EOF to cache start
 	file->WriteInt(-offset);
 
 	cache.clear();
 }
 
+int idSaveGame::Position( void ) {
+	return isCompressed ? cache.size() : file->Tell();
+}
+
+void idSaveGame::BeginProfile( const char *name ) {
+	if ( profiler.IsEnabled() ) {
+		profiler.Begin( name, Position() );
+	}
+}
+
+void idSaveGame::EndProfile( void ) {
+	if ( profiler.IsEnabled() ) {
+		profiler.End( Position() );
+	}
+}
+
 void idSaveGame::WriteObjectList( void ) {
 	int i;
 
@@ -233,7 +283,9 @@ void idSaveGame::WriteObject( const idClass *obj ) {
 }
 
 void idSaveGame::WriteStaticObject( const idClass &obj ) {
+	BeginProfile( obj.GetClassname() );
 	CallSave_r( obj.GetType(), &obj );
+	EndProfile();
 }
 
 void idSaveGame::WriteDict( const idDict *dict ) {
@@ -555,6 +607,91 @@ void idSaveGame::WriteHeader()
 	file->WriteBool(isCompressed);
 }
 
+/***********************************************************************
+
+	idSaveGameProfiler
+	
+***********************************************************************/
+
+idSaveGameProfiler::idSaveGameProfiler( void ) {
+	enabled = cv_savegame_profile.GetBool();
+	startTicks = sys->GetClockTicks();
+}
+
+void idSaveGameProfiler::Begin( const char *name, int position ) {
+	double ticks = sys->GetClockTicks();
+
+	// the scope around this one stops counting until this one ends
+	if ( stack.Num() ) {
+		profileScope_t &outer = stack[ stack.Num() - 1 ];
+		entries[ outer.entry ].bytes += position - outer.position;
+		entries[ outer.entry ].ticks += ticks - outer.ticks;
+	}
+
+	int hash = entryHash.GenerateKey( name, true );
+	int i;
+	for ( i = entryHash.First( hash ); i != -1; i = entryHash.Next( i ) ) {
+		if ( entries[ i ].name.Cmp( name ) == 0 ) {
+			break;
+		}
+	}
+	if ( i == -1 ) {
+		profileEntry_t entry;
+		entry.name = name;
+		entry.count = 0;
+		entry.bytes = 0;
+		entry.ticks = 0.0;
+		i = entries.Append( entry );
+		entryHash.Add( hash, i );
+	}
+	entries[ i ].count++;
+
+	profileScope_t &scope = stack.Alloc();
+	scope.entry = i;
+	scope.position = position;
+	scope.ticks = ticks;
+}
+
+void idSaveGameProfiler::End( int position ) {
+	double ticks = sys->GetClockTicks();
+
+	profileScope_t &scope = stack[ stack.Num() - 1 ];
+	entries[ scope.entry ].bytes += position - scope.position;
+	entries[ scope.entry ].ticks += ticks - scope.ticks;
+	stack.SetNum( stack.Num() - 1, false );
+
+	if ( stack.Num() ) {
+		profileScope_t &outer = stack[ stack.Num() - 1 ];
+		outer.position = position;
+		outer.ticks = ticks;
+	}
+}
+
+int idSaveGameProfiler::SortBySize( const profileEntry_t *a, const profileEntry_t *b ) {
+	return b->bytes - a->bytes;
+}
+
+void idSaveGameProfiler::Report( const char *title, int totalBytes ) const {
+	idList<profileEntry_t> sorted = entries;
+	int profiledBytes = 0;
+	double profiledTicks = 0.0;
+	const double msec = 1000.0 / sys->ClockTicksPerSecond();
+	int i;
+
+	sorted.Sort( SortBySize );
+
+	gameLocal.Printf( "%s: %d bytes in %.1f ms\n", title, totalBytes, ( sys->GetClockTicks() - startTicks ) * msec );
+	gameLocal.Printf( "  count       bytes      %%       ms  class\n" );
+	for ( i = 0; i < sorted.Num(); i++ ) {
+		const profileEntry_t &entry = sorted[ i ];
+		gameLocal.Printf( "%7d  %10d  %5.1f  %7.2f  %s\n", entry.count, entry.bytes, totalBytes ? 100.0f * entry.bytes / totalBytes : 0.0f, entry.ticks * msec, entry.name.c_str() );
+		profiledBytes += entry.bytes;
+		profiledTicks += entry.ticks;
+	}
+	gameLocal.Printf( "         %10d  %5.1f  %7.2f  outside of the objects\n", totalBytes - profiledBytes, totalBytes ? 100.0f * ( totalBytes - profiledBytes ) / totalBytes : 0.0f, 0.0 );
+	gameLocal.Printf( "%d bytes and %.2f ms in %d profiled classes\n", profiledBytes, profiledTicks * msec, sorted.Num() );
+}
+
 /***********************************************************************
 
 	idRestoreGame
@@ -584,10 +721,10 @@ void idRestoreGame::InitializeCache() {
 		Error( "idRestoreGame::InitializeCache: bad cache offset (%d)", offset);
 	file->Seek(offset, FS_SEEK_CUR);
 
-	//read compressed cache size
-	int zipSize = -1;
+	//read compressed cache size, or the negative number of chunks
+	int zipSize = 0;
 	file->ReadInt(zipSize);
-	if (zipSize <= 0)
+	if (zipSize == 0)
 		Error("idRestoreGame::InitializeCache: bad compressed cache size (%d)", zipSize);
 
 	//read decompressed cache size
@@ -596,6 +733,12 @@ void idRestoreGame::InitializeCache() {
 	if (cacheSize <= 0)
 		Error("idRestoreGame::InitializeCache: bad uncompressed cache size (%d)", cacheSize);
 
+	if (zipSize < 0) {
+		InitializeChunkedCache(-zipSize, cacheSize);
+		file->Seek(position, FS_SEEK_SET);
+		return;
+	}
+
 	//read compressed data
 	CRawVector zipped;
 	zipped.resize(zipSize);
@@ -617,6 +760,66 @@ void idRestoreGame::InitializeCache() {
 	file->Seek(position, FS_SEEK_SET);
 }
 
+/*
+================
+idRestoreGame::InitializeChunkedCache
+
+Decompresses the chunks of the cache in parallel, the file is at the chunk sizes
+================
+*/
+void idRestoreGame::InitializeChunkedCache( int numChunks, int cacheSize ) {
+	int chunkSize = 0;
+	file->ReadInt(chunkSize);
+	const bool lz4 = chunkSize < 0;
+	if (lz4)
+		chunkSize = -chunkSize;
+	if (chunkSize <= 0 || (long long)numChunks * chunkSize < cacheSize || (long long)(numChunks - 1) * chunkSize >= cacheSize)
+		Error("idRestoreGame::InitializeCache: bad cache chunks (%d of %d bytes for %d bytes)", numChunks, chunkSize, cacheSize);
+
+	idList<int> zipOffsets, errors;
+	zipOffsets.SetNum(numChunks + 1);
+	errors.SetNum(numChunks);
+	zipOffsets[0] = 0;
+	for (int i = 0; i < numChunks; i++) {
+		int zipSize = -1;
+		file->ReadInt(zipSize);
+		if (zipSize <= 0)
+			Error("idRestoreGame::InitializeCache: bad compressed chunk size (%d)", zipSize);
+		zipOffsets[i + 1] = zipOffsets[i] + zipSize;
+	}
+
+	//read compressed data
+	CRawVector zipped;
+	zipped.resize(zipOffsets[numChunks]);
+	cache.resize(cacheSize);
+	file->Read(&zipped[0], zipped.size());
+
+	//decompress the chunks
+#pragma omp parallel for if ( numChunks > 1 ) schedule( dynamic, 1 )
+	for (int i = 0; i < numChunks; i++) {
+		const int start = i * chunkSize;
+		const uLongf expected = Min(chunkSize, cacheSize - start);
+		if (lz4) {
+			const int size = idLZ4::Decompress((const byte *)&zipped[0] + zipOffsets[i], zipOffsets[i + 1] - zipOffsets[i],
+				(byte *)&cache[0] + start, expected);
+			errors[i] = size == (int)expected ? Z_OK : Z_DATA_ERROR;
+			continue;
+		}
+		uLongf size = expected;
+		errors[i] = uncompress((Bytef *)&cache[0] + start, &size,
+			(const Bytef *)&zipped[0] + zipOffsets[i], zipOffsets[i + 1] - zipOffsets[i]);
+		if (errors[i] == Z_OK && size != expected)
+			errors[i] = Z_DATA_ERROR;
+	}
+	for (int i = 0; i < numChunks; i++) {
+		if (errors[i] != Z_OK)
+			Error("idRestoreGame::InitializeCache: uncompress of chunk %d failed with code %d", i, errors[i]);
+	}
+
+	//set cache pointer
+	cachePointer = 0;
+}
+
 void idRestoreGame::CreateObjects( void ) {
 	int i, num;
 	idStr classname;
@@ -652,7 +855,13 @@ void idRestoreGame::RestoreObjects( void ) {
 
 	// restore all the objects
 	for( i = 1; i < objects.Num(); i++ ) {
+		BeginProfile( objects[ i ]->GetClassname() );
 		CallRestore_r( objects[ i ]->GetType(), objects[ i ] );
+		EndProfile();
+	}
+
+	if ( profiler.IsEnabled() ) {
+		profiler.Report( "restore", Position() );
 	}
 
 	// regenerate render entities and render lights because are not saved
@@ -694,6 +903,22 @@ void idRestoreGame::Error( const char *fmt, ... ) {
 	gameLocal.Error( "%s", text );
 }
 
+int idRestoreGame::Position( void ) {
+	return isCompressed ? cachePointer : file->Tell();
+}
+
+void idRestoreGame::BeginProfile( const char *name ) {
+	if ( profiler.IsEnabled() ) {
+		profiler.Begin( name, Position() );
+	}
+}
+
+void idRestoreGame::EndProfile( void ) {
+	if ( profiler.IsEnabled() ) {
+		profiler.End( Position() );
+	}
+}
+
 void idRestoreGame::CallRestore_r( const idTypeInfo *cls, idClass *obj ) {
 	if ( cls->super ) {
 		CallRestore_r( cls->super, obj );
@@ -776,7 +1001,9 @@ void idRestoreGame::ReadObject( idClass *&obj ) {
 }
 
 void idRestoreGame::ReadStaticObject( idClass &obj ) {
+	BeginProfile( obj.GetClassname() );
 	CallRestore_r( obj.GetType(), &obj );
+	EndProfile();
 }
 
 void idRestoreGame::ReadDict( idDict *dict ) {
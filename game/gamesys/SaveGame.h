@@ -34,6 +34,9 @@ Save game related helper classes.
 
 const int INITIAL_RELEASE_BUILD_NUMBER = 1262;
 
+// the compressed cache of a savegame is split into chunks of this size, which are compressed in parallel
+const int SAVEGAME_CACHE_CHUNK_SIZE = 1024 * 1024;
+
 class idDeclSkin;
 class idDeclParticle;
 class idDeclFX;
@@ -49,6 +52,44 @@ typedef struct trace_s trace_t;
 class idTraceModel;
 class idClipModel;
 
+/*
+	With tdm_savegame_profile set, idSaveGame and idRestoreGame record the bytes and the time of
+	every object by class, static objects like the physics included, and of the sub-objects which
+	open an idSaveGameProfileScope. A nested scope isn't counted for the scopes around it. The
+	report is sorted by size and printed when the objects are saved or restored.
+*/
+class idSaveGameProfiler {
+public:
+							idSaveGameProfiler( void );
+
+	bool					IsEnabled( void ) const { return enabled; }
+	void					Begin( const char *name, int position );
+	void					End( int position );
+	void					Report( const char *title, int totalBytes ) const;
+
+private:
+	typedef struct {
+		idStr				name;
+		int					count;
+		int					bytes;
+		double				ticks;
+	} profileEntry_t;
+
+	typedef struct {
+		int					entry;
+		int					position;		// bytes and ticks from here on are counted for the entry
+		double				ticks;
+	} profileScope_t;
+
+	bool					enabled;
+	idList<profileEntry_t>	entries;
+	idHashIndex				entryHash;
+	idList<profileScope_t>	stack;
+	double					startTicks;
+
+	static int				SortBySize( const profileEntry_t *a, const profileEntry_t *b );
+};
+
 class idSaveGame {
 public:
 							idSaveGame( idFile *savefile );
@@ -114,6 +155,10 @@ public:
 	// Dump the contents of cache buffer to file
 	void					FinalizeCache();
 
+	// Profile the saving of a sub-object, use idSaveGameProfileScope
+	void					BeginProfile( const char *name );
+	void					EndProfile( void );
+
 private:
 	idFile *				file;
 
@@ -122,6 +167,10 @@ private:
 	bool					isCompressed;
 	CRawVector				cache;
 
+	idSaveGameProfiler		profiler;
+
+	int						Position( void );
+
 	void					CallSave_r( const idTypeInfo *cls, const idClass *obj );
 };
 
@@ -194,6 +243,10 @@ public:
 	inline int				GetBuildNumber() { return buildNumber; }
 	inline int				GetCodeRevision() { return codeRevision; }
 
+	// Profile the restoring of a sub-object, use idSaveGameProfileScope
+	void					BeginProfile( const char *name );
+	void					EndProfile( void );
+
 private:
 	idFile *				file;
 
@@ -206,7 +259,23 @@ private:
 	CRawVector				cache;
 	int						cachePointer;
 
+	idSaveGameProfiler		profiler;
+
+	int						Position( void );
+	void					InitializeChunkedCache( int numChunks, int cacheSize );
 	void					CallRestore_r( const idTypeInfo *cls, idClass *obj );
 };
 
+// Profiles the saving or restoring of a sub-object until it goes out of scope
+class idSaveGameProfileScope {
+public:
+							idSaveGameProfileScope( idSaveGame *savefile, const char *name ) : save( savefile ), restore( NULL ) { save->BeginProfile( name ); }
+							idSaveGameProfileScope( idRestoreGame *savefile, const char *name ) : save( NULL ), restore( savefile ) { restore->BeginProfile( name ); }
+							~idSaveGameProfileScope( void ) { if ( save ) { save->EndProfile(); } else { restore->EndProfile(); } }
+
+private:
+	idSaveGame *			save;
+	idRestoreGame *			restore;
+};
+
 #endif /* !__SAVEGAME_H__*/
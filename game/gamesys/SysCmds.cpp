@@ -32,6 +32,7 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #include "../Inventory/InventoryItem.h"
 #include "../TimerManager.h"
 #include "../ai/Conversation/ConversationSystem.h"
+#include "../ai/Subsystem.h"
 #include "../Missions/MissionManager.h"
 #include "../Missions/ModInfo.h"
 
@@ -1858,6 +1859,19 @@ static void Cmd_ReloadAnims_f( const idCmdArgs &args ) {
 	animationLib.ReloadAnims();
 }
 
+/*
+==================
+Cmd_AnimPoseCacheStats_f
+==================
+*/
+static void Cmd_AnimPoseCacheStats_f( const idCmdArgs &args ) {
+	animationLib.GetPoseCache().PrintStats();
+
+	if ( args.Argc() > 1 && idStr::Icmp( args.Argv( 1 ), "reset" ) == 0 ) {
+		animationLib.GetPoseCache().ResetStats();
+	}
+}
+
 /*
 ==================
 Cmd_ListAnims_f
@@ -2755,6 +2769,127 @@ void Cmd_ShowAASStats_f(const idCmdArgs& args)
 	}
 }
 
+void Cmd_AASRoutingCacheStats_f(const idCmdArgs& args)
+{
+	bool reset = (args.Argc() > 1 && idStr::Icmp(args.Argv(1), "reset") == 0);
+
+	for (int i = 0; i < gameLocal.NumAAS(); i++)
+	{
+		idAASLocal* aas = dynamic_cast<idAASLocal*>(gameLocal.GetAAS(i));
+		if (aas != NULL)
+		{
+			aas->PrintRoutingCacheStats();
+
+			if (reset)
+			{
+				aas->ResetRoutingCacheStats();
+			}
+		}
+	}
+}
+
+/*
+==================
+Cmd_EventStats_f
+==================
+*/
+static void Cmd_EventStats_f( const idCmdArgs &args ) {
+	if ( args.Argc() > 1 ) {
+		if ( idStr::Icmp( args.Argv( 1 ), "reset" ) == 0 ) {
+			idEvent::ClearStats();
+			gameLocal.Printf( "event stats cleared\n" );
+		} else {
+			gameLocal.Printf( "usage: eventStats [reset]\n" );
+		}
+		return;
+	}
+
+	idEvent::PrintStats();
+}
+
+/*
+==================
+Cmd_ScriptProfile_f
+==================
+*/
+static void Cmd_ScriptProfile_f( const idCmdArgs &args ) {
+	scriptProfileSort_t sortBy = SCRIPT_PROFILE_SORT_SELF;
+	int numShown = 30;
+
+	for ( int i = 1; i < args.Argc(); i++ ) {
+		const char *arg = args.Argv( i );
+
+		if ( idStr::Icmp( arg, "reset" ) == 0 ) {
+			scriptProfiler.Clear();
+			gameLocal.Printf( "script profile cleared\n" );
+			return;
+		} else if ( idStr::Icmp( arg, "self" ) == 0 ) {
+			sortBy = SCRIPT_PROFILE_SORT_SELF;
+		} else if ( idStr::Icmp( arg, "inclusive" ) == 0 ) {
+			sortBy = SCRIPT_PROFILE_SORT_INCLUSIVE;
+		} else if ( idStr::Icmp( arg, "calls" ) == 0 ) {
+			sortBy = SCRIPT_PROFILE_SORT_CALLS;
+		} else if ( idStr::Icmp( arg, "instructions" ) == 0 ) {
+			sortBy = SCRIPT_PROFILE_SORT_INSTRUCTIONS;
+		} else if ( idStr::IsNumeric( arg ) ) {
+			numShown = atoi( arg );
+		} else {
+			gameLocal.Printf( "usage: scriptProfile [self|inclusive|calls|instructions] [count] or scriptProfile reset\n" );
+			return;
+		}
+	}
+
+	if ( !g_scriptProfile.GetBool() ) {
+		gameLocal.Printf( "g_scriptProfile is off, showing the costs collected while it was set\n" );
+	}
+
+	scriptProfiler.Print( sortBy, numShown );
+}
+
+void Cmd_AIBenchmark_f(const idCmdArgs& args)
+{
+	if (args.Argc() > 1 && idStr::Icmp(args.Argv(1), "stop") == 0)
+	{
+		gameLocal.m_AIBenchmark.Stop();
+		return;
+	}
+
+	if (args.Argc() < 3)
+	{
+		gameLocal.Printf("usage: tdm_ai_benchmark <entityDef> <count> [frames per scenario] [seed]\n");
+		gameLocal.Printf("       tdm_ai_benchmark stop\n");
+		return;
+	}
+
+	int count = atoi(args.Argv(2));
+	int frames = (args.Argc() > 3) ? atoi(args.Argv(3)) : 600;
+	int seed = (args.Argc() > 4) ? atoi(args.Argv(4)) : 0;
+
+	if (count <= 0 || frames <= 0)
+	{
+		gameLocal.Printf("The AI count and the frames must be positive.\n");
+		return;
+	}
+
+	gameLocal.m_AIBenchmark.Start(args.Argv(1), count, frames, seed);
+}
+
+void Cmd_PrintStimResponseProfile_f(const idCmdArgs& args)
+{
+	if (!gameLocal.m_StimResponseProfiler.IsEnabled())
+	{
+		gameLocal.Printf("Stim/response profiling is off, set tdm_sr_profile to 1 first.\n");
+		return;
+	}
+
+	gameLocal.m_StimResponseProfiler.Print();
+
+	if (args.Argc() > 1 && idStr::Icmp(args.Argv(1), "reset") == 0)
+	{
+		gameLocal.m_StimResponseProfiler.Clear();
+	}
+}
+
 void Cmd_ShowEASRoute_f(const idCmdArgs& args)
 {
 	if (args.Argc() != 2)
@@ -3688,6 +3823,16 @@ void Cmd_LODBiasChanged_f( const idCmdArgs& args )
 	}
 }
 
+/*
+==================
+Cmd_ListAITaskStats_f
+==================
+*/
+void Cmd_ListAITaskStats_f( const idCmdArgs& args )
+{
+	ai::Subsystem::ListTaskStats( idStr::Icmp( args.Argv( 1 ), "clear" ) == 0 );
+}
+
 #ifdef TIMING_BUILD
 void Cmd_ListTimers_f(const idCmdArgs& args) 
 {
@@ -3733,6 +3878,9 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "game_memory",			idClass::DisplayInfo_f,		CMD_FL_GAME,				"displays game class info" );
 	cmdSystem->AddCommand( "listClasses",			idClass::ListClasses_f,		CMD_FL_GAME,				"lists game classes" );
 	cmdSystem->AddCommand( "listThreads",			idThread::ListThreads_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"lists script threads" );
+	cmdSystem->AddCommand( "gameMemTags",			Mem_Tags_f,					CMD_FL_GAME,				"lists the memory allocated by each subsystem of the game module" );
+	cmdSystem->AddCommand( "eventStats",			Cmd_EventStats_f,			CMD_FL_GAME,				"prints how often each event was posted, serviced and cancelled, 'reset' clears the counters" );
+	cmdSystem->AddCommand( "scriptProfile",			Cmd_ScriptProfile_f,		CMD_FL_GAME,				"prints the script functions and events by self, inclusive time, calls or instructions (needs g_scriptProfile), 'reset' clears them" );
 	cmdSystem->AddCommand( "listEntities",			Cmd_EntityList_f,			CMD_FL_GAME | CMD_FL_CHEAT, "lists game entities" );
 	cmdSystem->AddCommand( "countEntities",			Cmd_EntityCount_f,			CMD_FL_GAME | CMD_FL_CHEAT, "counts game entities by class" ); // #3924
 	cmdSystem->AddCommand( "listActiveEntities",	Cmd_ActiveEntityList_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"lists active game entities" );
@@ -3796,6 +3944,7 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "reexportmodels",		Cmd_ReexportModels_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"reexports models", ArgCompletion_DefFile );
 	cmdSystem->AddCommand( "reloadanims",			Cmd_ReloadAnims_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"reloads animations" );
 	cmdSystem->AddCommand( "listAnims",				Cmd_ListAnims_f,			CMD_FL_GAME,				"lists all animations" );
+	cmdSystem->AddCommand( "tdm_anim_posecache_stats",	Cmd_AnimPoseCacheStats_f,	CMD_FL_GAME,			"Shows the hit rate of the anim pose cache (tdm_anim_posecache). 'reset' clears the counters afterwards." );
 	cmdSystem->AddCommand( "aasStats",				Cmd_AASStats_f,				CMD_FL_GAME,				"shows AAS stats" );
 	cmdSystem->AddCommand( "testDamage",			Cmd_TestDamage_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"tests a damage def", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF> );
 	cmdSystem->AddCommand( "weaponSplat",			Cmd_WeaponSplat_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"projects a blood splat on the player weapon" );
@@ -3826,6 +3975,9 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "aas_showWalkPath",		Cmd_ShowWalkPath_f,			CMD_FL_GAME,				"Shows the walk path from the player to the given area number (AAS32)." );
 	cmdSystem->AddCommand( "aas_showReachabilities",Cmd_ShowReachabilities_f,			CMD_FL_GAME,				"Shows the reachabilities for the given area number (AAS32)." );
 	cmdSystem->AddCommand( "aas_showStats",			Cmd_ShowAASStats_f,			CMD_FL_GAME,				"Shows the AAS statistics." );
+	cmdSystem->AddCommand( "aas_routingCacheStats",	Cmd_AASRoutingCacheStats_f,	CMD_FL_GAME,				"Shows the routing cache hits, misses and evictions per AAS cluster. 'reset' clears the counters afterwards." );
+	cmdSystem->AddCommand( "tdm_ai_benchmark",		Cmd_AIBenchmark_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"Spawns AI of an entityDef on the map's AAS and measures the game frames in a patrol, a search and a combat scenario. 'stop' ends it early.", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF> );
+	cmdSystem->AddCommand( "tdm_sr_profile_print",	Cmd_PrintStimResponseProfile_f,	CMD_FL_GAME,			"Shows the stim/response costs per stim type and owner class over the last frames (needs tdm_sr_profile). 'reset' clears them afterwards." );
 	cmdSystem->AddCommand( "eas_showRoute",			Cmd_ShowEASRoute_f,			CMD_FL_GAME,				"Shows the EAS route to the goal area." );
 
 	cmdSystem->AddCommand( "tdm_start_conversation",	Cmd_StartConversation_f,	CMD_FL_GAME,			"Starts the conversation with the given name." );
@@ -3862,6 +4014,7 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "serverMapRestart",		idGameLocal::MapRestart_f,	CMD_FL_GAME,				"restart the current game" );
 	cmdSystem->AddCommand( "serverForceReady",	idMultiplayerGame::ForceReady_f,CMD_FL_GAME,				"force all players ready" );
 	cmdSystem->AddCommand( "serverNextMap",			idGameLocal::NextMap_f,		CMD_FL_GAME,				"change to the next map" );
+	cmdSystem->AddCommand( "net_snapshotStats",		idGameLocal::SnapshotStats_f,	CMD_FL_GAME,			"print the snapshot bytes sent per entity type, 'net_snapshotStats clear' resets them" );
 
 	// greebo: Added commands to alter the clipmask/contents of entities.
 	cmdSystem->AddCommand( "setClipMask",			Cmd_SetClipMask,			CMD_FL_GAME,				"Set the clipmask of the target entity, usage: 'setClipMask crate01 1313'", idGameLocal::ArgCompletion_EntityName);
@@ -3870,6 +4023,7 @@ void idGameLocal::InitConsoleCommands( void ) {
 	// localization help commands
 	cmdSystem->AddCommand( "nextGUI",				Cmd_NextGUI_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"teleport the player to the next func_static with a gui" );
 	cmdSystem->AddCommand( "testid",				Cmd_TestId_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"output the string for the specified id." );
+	cmdSystem->AddCommand( "listAITaskStats",		Cmd_ListAITaskStats_f,		CMD_FL_GAME,				"Prints the performs and time of each AI task counted while tdm_ai_task_stats is set, 'listAITaskStats clear' also resets them." );
 #ifdef TIMING_BUILD
 	cmdSystem->AddCommand( "listTimers",			Cmd_ListTimers_f,			CMD_FL_GAME,				"Shows total run time and max time of timers (TIMING_BUILD only)." );
 	cmdSystem->AddCommand( "writeTimerCSV",			Cmd_WriteTimerCSV_f,		CMD_FL_GAME,				"Writes the timer data to a csv file (usage: writeTimerCSV <separator> <commaChar>). The default separator is ';', the default comma is '.'");
@@ -58,6 +58,10 @@ idCVar cv_ai_sight_prob(			"tdm_ai_sight_prob",		"0.7",			CVAR_GAME | CVAR_ARCHI
 idCVar cv_ai_sight_mag(				"tdm_ai_sight_mag",			"1.0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_FLOAT, "Modifies the amount of visual alert that gets added on when the sight probability check succeeds and the AI do see you (default 1.0)." );
 idCVar cv_ai_sightmaxdist(			"tdm_ai_sightmax",			"40.0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_FLOAT, "The distance (in meters) above which an AI will not see you even with a fullbright lightgem.  Defaults to 40m.  Affects visibility in a complicated way." ); // grayman #3063 - drop from 60m to 40m
 idCVar cv_ai_sightmindist(			"tdm_ai_sightmin",			"15.0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_FLOAT, "The distance (in meters) below which an AI has a 100% chance of seeing you with a fullbright lightgem.  Defaults to 15m.  Affects visibility in a complicated way." );
+idCVar cv_ai_route_queries(		"tdm_ai_route_queries",			"4",		CVAR_GAME | CVAR_ARCHIVE | CVAR_INTEGER, "The number of queued AI route queries each AAS works off per frame. 0 sets the routes of MoveToPosition up immediately.", 0, 64 );
+idCVar cv_ai_visscan_budget(		"tdm_ai_visscan_budget",		"16",		CVAR_GAME | CVAR_ARCHIVE | CVAR_INTEGER, "The number of AI visual scan traces per frame, alerted AI are always traced. 0 traces every scan immediately.", 0, 256 );
+idCVar cv_ai_visscan_maxage(		"tdm_ai_visscan_maxage",		"200",		CVAR_GAME | CVAR_ARCHIVE | CVAR_INTEGER, "The maximum age (in ms) of a batched AI visual scan result.", 0, 2000 );
+idCVar cv_ai_benchmark_sound(		"tdm_ai_benchmark_sound",		"noisemaker",	CVAR_GAME, "The suspicious sound (a sound propagation def name without the sprGS_ prefix) made near the AI in the search scenario of tdm_ai_benchmark." );
 idCVar cv_ai_sight_combat_cutoff(	"tdm_ai_sight_combat_cutoff",	"20.0",		CVAR_GAME | CVAR_ARCHIVE | CVAR_FLOAT, "The distance (in meters) below which an AI can accumulate enough alerts to see the player as the enemy.  Defaults to 20m." ); // grayman #3063
 idCVar cv_ai_tactalert(				"tdm_ai_tact",				"20.0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_FLOAT, "The default tactile alert if an AI bumps an enemy or an enemy bumps an AI.  Default value is 20 alert units (pretty much full alert)." );
 idCVar cv_ai_bumpobject_impulse(	"tdm_ai_bumpobject_impulse", "250",			CVAR_GAME | CVAR_ARCHIVE | CVAR_FLOAT, "Impulse applied when an AI bumps into an object with its AF when animating.  Different from the kick force it applies to an object blocking its path." ); // grayman #2568? - 1500->250
@@ -66,6 +70,7 @@ idCVar cv_ai_fov_show (				"tdm_ai_showfov",			"0",			CVAR_GAME | CVAR_ARCHIVE |
 idCVar cv_ai_ko_show (				"tdm_ai_showko",			"0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "If set to true, a debug graphic showing the knockout region of the AI will be drawn.  The green cone shows the vertical admittance angle, the red cone shows the horizontal angle.");
 idCVar cv_ai_animstate_show (		"tdm_ai_showanimstate",		"0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "If set to true, debug text showing the name of the AI's current animation state will be shown.");
 idCVar cv_ai_task_show (			"tdm_ai_showtasks",			"0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "If set to true, debug text showing the name of the AI's current tasks will be shown.");
+idCVar cv_ai_task_stats (			"tdm_ai_task_stats",		"0",			CVAR_GAME | CVAR_BOOL, "If set, the number of performs and the time spent in each AI task are counted, listAITaskStats prints them.");
 idCVar cv_ai_alertlevel_show (		"tdm_ai_showalert",			"0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "If set to true, debug text showing the AI's current total alert units is shown (Note: This is not the alert state, use tdm_ai_showtasks for that).");
 idCVar cv_ai_dest_show (			"tdm_ai_showdest",			"0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "If set to true, an arrow is drawn from every AI to its intended pathing destination.");
 idCVar cv_ai_goalpos_show (			"tdm_ai_showgoalpos",		"0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "If set to true, the current goalpos (seekpos) is drawn in the world (!= move destination).");
@@ -87,6 +92,8 @@ idCVar cv_ai_acuity_susp(			"tdm_ai_acuity_susp",		"1.2",			CVAR_GAME | CVAR_ARC
 idCVar cv_sndprop_disable(			"tdm_sndprop_disable",		"0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL,  "If set to true, sound propagation will not be calculated." );
 idCVar cv_spr_debug(				"tdm_spr_debug",			"0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL,  "If set to true, sound propagation debugging information will be sent to the console, and the log information will become more detailed." );
 idCVar cv_spr_show(					"tdm_showsprop",			"0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL,  "If set to true, sound propagation paths to nearby AI will be shown as lines. The volume of the sound heard by the AI and the alert increase will be displayed." );
+idCVar cv_spr_prune(				"tdm_spr_prune",			"1",			CVAR_GAME | CVAR_BOOL,  "If set to true, the sound propagation stops expanding through portals that can't carry an audible sound to any AI, using the precomputed area distances of the .sprd file." );
+idCVar cv_spr_coalesce(			"tdm_spr_coalesce",			"1",			CVAR_GAME | CVAR_BOOL,  "If set to true, suspicious sounds are propagated at the end of the frame. Sounds of the same kind made in the same area in that frame share one wavefront expansion, and each AI processes only the loudest of them." );
 idCVar cv_spr_radius_show(			"tdm_showsprop_radius",		"0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL,  "If set to true, sound ranges are drawn." );
 
 idCVar cv_ko_show(					"tdm_showko",				"0",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL,  "If set to true, knockout zones will be shown for debugging." );
@@ -103,6 +110,22 @@ idCVar cv_ai_opt_interleavethinkmindist (		"tdm_ai_opt_interleavethinkmindist",
 idCVar cv_ai_opt_interleavethinkmaxdist (		"tdm_ai_opt_interleavethinkmaxdist",		"0",	CVAR_GAME | CVAR_ARCHIVE | CVAR_FLOAT, "If true (nonzero), this is the distance where interleave frame will reach its maximum value." );
 idCVar cv_ai_opt_interleavethinkskippvscheck (	"tdm_ai_opt_interleavethinkskipPVS",		"0",	CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "If true (nonzero), the player PVS check for interleaved thinking will be skipped, so that the AI can also do interleaved thinking while in view." );
 idCVar cv_ai_opt_interleavethinkframes (		"tdm_ai_opt_interleavethinkframes",			"0",	CVAR_GAME | CVAR_ARCHIVE | CVAR_INTEGER, "If true (nonzero), this is the maximum interleaved thinking frame number." );
+idCVar cv_think_scheduler (					"tdm_think_scheduler",						"1",	CVAR_GAME | CVAR_BOOL, "If set, movers and emitters outside the player PVS only think once every few frames, depending on their distance to the player." );
+idCVar cv_think_scheduler_show (				"tdm_think_scheduler_show",					"0",	CVAR_GAME | CVAR_BOOL, "Prints the number of entities that thought and were skipped by the think scheduler each frame." );
+idCVar cv_think_ai_balance (					"tdm_think_ai_balance",						"1",	CVAR_GAME | CVAR_BOOL, "If set, the think scheduler moves the next think of AI doing interleaved thinking to the least busy frame close to it, so they don't all think in the same frames." );
+idCVar cv_think_ai_budget (					"tdm_think_ai_budget",						"4",	CVAR_GAME | CVAR_FLOAT, "Milliseconds per frame the AI may spend thinking. Above it, AI that are not alerted and not in the player PVS think less often, up to twice their interleave. 0 disables." );
+idCVar cv_think_parallel (					"tdm_think_parallel",						"1",	CVAR_GAME | CVAR_BOOL, "If set, the parallel safe part of the entity thinks (idEntity::ParallelThink) runs on worker threads before the entities think." );
+idCVar cv_anim_parallel (					"tdm_anim_parallel",						"1",	CVAR_GAME | CVAR_BOOL, "If set, the animation frames changed during a game frame are created in parallel at its end." );
+idCVar cv_anim_binary (					"tdm_anim_binary",							"1",	CVAR_GAME | CVAR_BOOL, "If set, md5anims are loaded from the binary md5animb next to the text file, which is written when it is missing or out of date." );
+idCVar cv_anim_compress (					"tdm_anim_compress",						"16",	CVAR_GAME | CVAR_INTEGER, "Bits per animated component of the md5anim frames kept in memory, 0 keeps floats. 16 bits are exact to 1/65535th of the range of a component, 8 bits save more but can make joints shake. Applies to anims loaded afterwards, listAnims shows the memory saved.", 0, 16 );
+idCVar cv_anim_posecache (					"tdm_anim_posecache",						"1",	CVAR_GAME | CVAR_BOOL, "If set, the decoded md5anim key frames are cached and shared by all animators playing the same anim. tdm_anim_posecache_stats shows the hit rate." );
+idCVar cv_physics_islands (					"tdm_physics_islands",						"1",	CVAR_GAME | CVAR_BOOL, "If set, touching moveables and ragdolls are put to rest together once all of them have been barely moving for tdm_physics_islands_sleeptime." );
+idCVar cv_physics_islands_sleeptime (			"tdm_physics_islands_sleeptime",			"1000",	CVAR_GAME | CVAR_INTEGER, "Milliseconds all awake bodies of an island must be barely moving before the island is put to rest." );
+idCVar cv_physics_islands_sleepvelocity (		"tdm_physics_islands_sleepvelocity",		"3",	CVAR_GAME | CVAR_FLOAT, "Linear velocity in units per second below which a body of an island counts as barely moving." );
+idCVar cv_physics_islands_sleepangularvelocity ("tdm_physics_islands_sleepangularvelocity",	"0.2",	CVAR_GAME | CVAR_FLOAT, "Angular velocity in radians per second below which a body of an island counts as barely moving." );
+idCVar cv_physics_islands_show (				"tdm_physics_islands_show",					"0",	CVAR_GAME | CVAR_BOOL, "Draws the number of awake and resting moveables and ragdolls and of the islands they form." );
+idCVar cv_think_interleave_mindist (			"tdm_think_interleave_mindist",				"1000",	CVAR_GAME | CVAR_ARCHIVE | CVAR_FLOAT, "Below this distance to the player, entities think every frame." );
+idCVar cv_think_interleave_maxdist (			"tdm_think_interleave_maxdist",				"3000",	CVAR_GAME | CVAR_ARCHIVE | CVAR_FLOAT, "Beyond this distance to the player, entities think once in their max_think_interleave frames." );
 idCVar cv_ai_opt_update_enemypos_interleave (	"tdm_ai_opt_update_enemypos_interleave",	"48",	CVAR_GAME | CVAR_ARCHIVE | CVAR_INTEGER, "Time to pass between enemy position updates. Set this to 0 for updates each frame." );
 
 idCVar cv_ai_opt_nomind (						"tdm_ai_opt_nomind",				"0",			CVAR_GAME | CVAR_BOOL, "If true (nonzero), AI has its Mind thinking routines disabled." );
@@ -111,6 +134,10 @@ idCVar cv_ai_opt_nolipsync (					"tdm_ai_opt_nolipsync",				"0",			CVAR_GAME | C
 idCVar cv_ai_opt_nopresent (					"tdm_ai_opt_nopresent",				"0",			CVAR_GAME | CVAR_BOOL, "If true (nonzero), AI will not be presented." );
 idCVar cv_ai_opt_noobstacleavoidance (			"tdm_ai_opt_noobstacleavoidance",	"0",			CVAR_GAME | CVAR_BOOL, "If true (nonzero), AI will not check for obstacles." );
 idCVar cv_ai_hiding_spot_max_light_quotient(	"tdm_ai_hiding_spot_max_light_quotient",	"2.0",	CVAR_GAME | CVAR_FLOAT, "Hiding spot search light quotient." );
+idCVar cv_ai_hiding_spot_index(				"tdm_ai_hiding_spot_index",				"1",	CVAR_GAME | CVAR_BOOL, "If set, hiding spot searches test the precomputed candidates of an AAS area, best cover first, instead of its full grid. Takes effect on map load." );
+idCVar cv_ai_hiding_spot_area_candidates(		"tdm_ai_hiding_spot_area_candidates",		"24",	CVAR_GAME | CVAR_INTEGER, "The number of precomputed candidates tested per AAS area when tdm_ai_hiding_spot_index is set, 0 tests all of them." );
+idCVar cv_ai_hiding_spot_batch(				"tdm_ai_hiding_spot_batch",				"1",	CVAR_GAME | CVAR_BOOL, "If set, the occlusion traces of the hiding spot points of an AAS area run as one batch on the worker threads." );
+idCVar cv_ai_hiding_spot_batch_scale(			"tdm_ai_hiding_spot_batch_scale",			"2",	CVAR_GAME | CVAR_INTEGER, "The hiding spot point tests per AI frame are multiplied by this when tdm_ai_hiding_spot_batch is set." );
 idCVar cv_ai_max_hiding_spot_tests_per_frame(	"tdm_ai_max_hiding_spot_tests_per_frame",	"10",	CVAR_GAME | CVAR_INTEGER, "This is the maximum number of hiding spot point tests to do in a single AI frame." );
 idCVar cv_ai_debug_transition_barks(			"tdm_ai_debug_transition_barks",			"0",	CVAR_GAME | CVAR_BOOL | CVAR_ARCHIVE, "If set to 1, prints to the console the AI barks during alert level transitions, and events that would cause the AI to use Alert Idle");
 idCVar cv_ai_debug_greetings(					"tdm_ai_debug_greetings",			"0",			CVAR_GAME | CVAR_BOOL | CVAR_ARCHIVE, "If set to 1, prints to the console the AI greeting and response barks");
@@ -151,6 +178,8 @@ idCVar cv_tdm_mission_list_urls("tdm_mission_list_urls",	"http://missions.thedar
 idCVar cv_tdm_mission_details_url("tdm_mission_details_url", "http://missions.thedarkmod.com/get_mission_details.php?id=%d", CVAR_GAME, "The URLs to check for the mission details XML." );
 idCVar cv_tdm_mission_screenshot_url("tdm_mission_screenshot_url", "http://missions.thedarkmod.com/%s", CVAR_GAME, "The URL template to download the mission screenshots." );
 idCVar cv_tdm_version_check_url("tdm_version_check_url", "http://update.thedarkmod.com/tdm_version.xml", CVAR_GAME, "The URL to check for the current TDM version." );
+idCVar cv_tdm_download_segments("tdm_download_segments", "4", CVAR_GAME | CVAR_INTEGER | CVAR_ARCHIVE, "Large mission packages are downloaded in up to this many parallel segments, spread over the available mirrors. 1 = single connection.", 1, 16 );
+idCVar cv_tdm_download_concurrency("tdm_download_concurrency", "2", CVAR_GAME | CVAR_INTEGER | CVAR_ARCHIVE, "The number of missions downloaded at the same time.", 1, 8 );
 
 /**
 * DarkMod DEBUG related CVARs
@@ -167,12 +196,17 @@ idCVar cv_tdm_difficulty(			"tdm_difficulty",	"-1",					CVAR_GAME | CVAR_INTEGER
 
 idCVar cv_sr_disable (				"tdm_sr_disable",           "0",           CVAR_GAME | CVAR_BOOL, "Set to 1 to disable all stim/response processing." );
 idCVar cv_sr_show(					"tdm_show_stimresponse",    "0",           CVAR_GAME | CVAR_INTEGER, "Set to 1 to show all successful stims, set to 2 to show all including failed ones." );
+idCVar cv_sr_profile(				"tdm_sr_profile",           "0",           CVAR_GAME | CVAR_INTEGER, "Set to 1 to collect the stim/response costs per stim type and owner class (see tdm_sr_profile_print), set to 2 to also show them in the HUD.", 0, 2 );
+idCVar cv_sr_broadphase(			"tdm_sr_broadphase",        "1",           CVAR_GAME | CVAR_BOOL, "Set to 0 to find the responders of radius based stims through the clip sectors instead of the per stim type grid." );
 
 idCVar cv_debug_mainmenu(			"tdm_debug_mainmenu",      "0",            CVAR_BOOL, "Set to 1 to enable main menu GUI debugging in the console." );
 idCVar cv_mainmenu_confirmquit(		"tdm_mainmenu_confirmquit",      "1", CVAR_ARCHIVE | CVAR_BOOL, "Set to 0 to disable the 'Quit Game' confirmation dialog when exiting the game." );
 
 idCVar cv_force_savegame_load(		"tdm_force_savegame_load", "0",   CVAR_BOOL|CVAR_ARCHIVE, "Set to 1 to skip code revision check on savegame load." );
 idCVar cv_savegame_compress(		"tdm_savegame_compress", "1",   CVAR_BOOL|CVAR_ARCHIVE, "Set to 0 to disable savegame file compression." );
+idCVar cv_savegame_profile(		"tdm_savegame_profile", "0",   CVAR_BOOL, "Print the bytes and time of every class and sub-object after saving and restoring a game." );
+idCVar cv_savegame_compress_level(	"tdm_savegame_compress_level", "1",   CVAR_INTEGER|CVAR_ARCHIVE, "zlib level of the savegame compression, 1 is the fastest, 9 the smallest.", 1, 9 );
+idCVar cv_savegame_compress_lz4(	"tdm_savegame_compress_lz4", "0",   CVAR_BOOL|CVAR_ARCHIVE, "Compress savegames with LZ4 instead of zlib, which is much faster but makes larger files." );
 
 /**
 * Dark Mod player movement
@@ -287,6 +321,7 @@ idCVar cv_melee_invert_parry(			"tdm_melee_invert_parry", "0", CVAR_GAME | CVAR_
 idCVar cv_melee_auto_parry(				"tdm_melee_auto_parry", "1", CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "If set to 1, melee parries are chosen automatically to match the enemy's attack (manual parry mode is much harder)." );
 idCVar cv_melee_forbid_auto_parry(		"tdm_melee_forbid_auto_parry", "0", CVAR_GAME | CVAR_BOOL | CVAR_ARCHIVE, "If set to 1, auto parry is forced to be off.  Only manual allowed.  Works in conjunction with the main menu, do not adjust by hand." );
 idCVar cv_melee_max_particles(			"tdm_melee_max_particles", "10", CVAR_GAME | CVAR_ARCHIVE | CVAR_INTEGER, "Max number of particles a single melee swing can generate (eye candy setting)." );
+idCVar cv_melee_sweep_cull(				"tdm_melee_sweep_cull", "1", CVAR_GAME | CVAR_BOOL, "If set to 1, the swept trace of a melee attack is skipped on frames when no clip model it could hit is near the swing." );
 idCVar cv_melee_difficulty(				"tdm_melee_difficulty", "normal", CVAR_GAME | CVAR_ARCHIVE, "Melee difficulty as set by the menu (Do not adjust ingame, cheater!!)" );
 
 // grayman #3492 - AI Vision
@@ -386,6 +421,9 @@ idCVar cv_lg_debug("tdm_lg_debug",		"0",		CVAR_GAME | CVAR_BOOL,	"switch on debu
 idCVar cv_lg_model("tdm_lg_model",		"models/darkmod/misc/system/lightgem.lwo",	CVAR_GAME | CVAR_ARCHIVE,	"Set the lightgem model file. Map has to be restarted to take effect." );
 idCVar cv_lg_adjust("tdm_lg_adjust",		"0",		CVAR_GAME | CVAR_FLOAT,	"Adds a constant value to the lightgem." );
 idCVar cv_lg_split("tdm_lg_split",		"1",		CVAR_GAME | CVAR_BOOL | CVAR_ARCHIVE,	"Lightgem calculation is split in half between frames. (Upper geometry vs Lower geometry)" );
+idCVar cv_lg_analytic("tdm_lg_analytic",	"0",		CVAR_GAME | CVAR_BOOL | CVAR_ARCHIVE,	"Compute the lightgem from the Light Awareness System the AI use instead of rendering it. No render passes are needed and the lightgem matches what the AI see, but light textures are only sampled at a single point." );
+idCVar cv_lg_async("tdm_lg_async",		"1",		CVAR_GAME | CVAR_BOOL | CVAR_ARCHIVE,	"Read the lightgem renders back asynchronously. The value lags one update behind, but the GPU pipeline doesn't stall." );
+idCVar cv_lg_interval("tdm_lg_interval",	"0",		CVAR_GAME | CVAR_INTEGER | CVAR_ARCHIVE,	"Minimum time in milliseconds between lightgem updates, on top of tdm_lg_interleave. 0 (default) updates every processed frame." );
 idCVar cv_lg_path("tdm_lg_path",		"",	CVAR_GAME,	"Dump the rendersnapshot to the filepath specified here." );
 idCVar cv_lg_crouch_modifier("tdm_lg_crouch_modifier",	"-2",	CVAR_GAME | CVAR_INTEGER,	"The value the lightgem is adjusted by when the player is crouching." );
 idCVar cv_lg_velocity_mod_min_velocity("tdm_lg_velocity_mod_min_velocity", "0", CVAR_GAME | CVAR_FLOAT, "The minimum velocity the player must be at to make the lightgem level increase.");
@@ -435,6 +473,7 @@ idCVar cv_moveable_collision("tdm_show_moveable_collision",  "0", CVAR_GAME | CV
 * DarkMod LOD system
 **/
 idCVar cv_lod_bias("tdm_lod_bias",	"1.0",	CVAR_GAME | CVAR_FLOAT | CVAR_ARCHIVE, "A factor to multiply the LOD (level of detail) distance with. Default is 1.0 (meaning no change). Values < 1.0 make the distances smaller, reducing detail and increasing framerate, values > 1 increase the distance and thus detail at the expense of framerate." );
+idCVar cv_seed_max_changes("tdm_seed_max_changes",	"0",	CVAR_GAME | CVAR_INTEGER, "The maximum number of entities a SEED spawns or culls in one frame, the rest follow in the next frames. 0 means no limit." );
 
 /**
 * End DarkMod cvars
@@ -485,6 +524,7 @@ idCVar g_cinematicMaxSkipTime(		"g_cinematicMaxSkipTime",	"600",			CVAR_GAME | C
 
 idCVar g_muzzleFlash(				"g_muzzleFlash",			"1",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "show muzzle flashes" );
 idCVar g_projectileLights(			"g_projectileLights",		"1",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "show dynamic lights on projectiles" );
+idCVar g_batchProjectiles(			"g_batchProjectiles",		"1",			CVAR_GAME | CVAR_BOOL, "move the projectiles in flight together after the entities thought, with their paths traced in one batch" );
 idCVar g_bloodEffects(				"g_bloodEffects",			"1",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "show blood splats, sprays and gibs" );
 idCVar g_doubleVision(				"g_doubleVision",			"1",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "show double vision when taking damage" );
 idCVar g_monsters(					"g_monsters",				"1",			CVAR_GAME | CVAR_BOOL, "" );
@@ -501,6 +541,10 @@ idCVar g_debugMove(					"g_debugMove",				"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugDamage(				"g_debugDamage",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugWeapon(				"g_debugWeapon",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugScript(				"g_debugScript",			"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar g_scriptCache(				"g_scriptCache",			"1",			CVAR_GAME | CVAR_BOOL, "load the program compiled from the default script from script/<name>.cache when none of the scripts changed, and write the cache after compiling them" );
+idCVar g_fuseScript(				"g_fuseScript",				"1",			CVAR_GAME | CVAR_BOOL, "fuse common statement pairs of the scripts into superinstructions when compiling them, takes effect at the next map load" );
+idCVar g_scriptProfile(				"g_scriptProfile",			"0",			CVAR_GAME | CVAR_BOOL, "charge the time and instructions of the script threads to the script functions and events running, see scriptProfile and listThreads" );
+idCVar g_spawnTiming(				"g_spawnTiming",			"0",			CVAR_GAME | CVAR_INTEGER, "time the map entities as they spawn and print the classes that took longest, N lists the 10 * N slowest ones", 0, 100 );
 idCVar g_debugMover(				"g_debugMover",				"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugTriggers(				"g_debugTriggers",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugCinematic(			"g_debugCinematic",			"0",			CVAR_GAME | CVAR_BOOL, "" );
@@ -514,6 +558,8 @@ idCVar g_showTriggers(				"g_showTriggers",			"0",			CVAR_GAME | CVAR_BOOL, "dra
 idCVar g_showCollisionWorld(		"g_showCollisionWorld",		"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showCollisionModels(		"g_showCollisionModels",	"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showCollisionTraces(		"g_showCollisionTraces",	"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar g_clipContentsCache(			"g_clipContentsCache",		"1",			CVAR_GAME | CVAR_BOOL, "keep the results of contents tests for repeated tests of the same position during a frame" );
+idCVar g_clipQueryRegion(			"g_clipQueryRegion",		"1",			CVAR_GAME | CVAR_BOOL, "gather the clip models around the player once per move for all the ground, water, climb, duck and lean checks" );
 idCVar g_maxShowDistance(			"g_maxShowDistance",		"128",			CVAR_GAME | CVAR_FLOAT, "" );
 idCVar g_showEntityInfo(			"g_showEntityInfo",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showviewpos(				"g_showviewpos",			"0",			CVAR_GAME | CVAR_BOOL, "" );
@@ -574,6 +620,8 @@ idCVar g_vehicleTireFriction(		"g_vehicleTireFriction",	"0.8",			CVAR_GAME | CVA
 
 idCVar ik_enable(					"ik_enable",				"1",			CVAR_GAME | CVAR_BOOL, "enable IK" );
 idCVar ik_debug(					"ik_debug",					"0",			CVAR_GAME | CVAR_BOOL, "show IK debug lines" );
+idCVar ik_batchFootTraces(		"ik_batchFootTraces",		"1",			CVAR_GAME | CVAR_BOOL, "trace the feet of the walking actors in one batch at the start of the next frame, and not at all for actors out of the player's PVS or beyond ik_footTraceDist" );
+idCVar ik_footTraceDist(			"ik_footTraceDist",			"1024",			CVAR_GAME | CVAR_FLOAT, "actors farther away from the player keep their foot IK floor heights, see ik_batchFootTraces", 0.0f, 65536.0f );
 
 idCVar af_useLinearTime(			"af_useLinearTime",			"1",			CVAR_GAME | CVAR_BOOL, "use linear time algorithm for tree-like structures" );
 idCVar af_useImpulseFriction(		"af_useImpulseFriction",	"0",			CVAR_GAME | CVAR_BOOL, "use impulse based contact friction" );
@@ -612,6 +660,7 @@ idCVar af_showTotalMass(			"af_showTotalMass",			"0",			CVAR_GAME | CVAR_BOOL, "
 idCVar af_showInertia(				"af_showInertia",			"0",			CVAR_GAME | CVAR_BOOL, "show the inertia tensor of each body" );
 idCVar af_showVelocity(				"af_showVelocity",			"0",			CVAR_GAME | CVAR_BOOL, "show the velocity of each body" );
 idCVar af_showActive(				"af_showActive",			"0",			CVAR_GAME | CVAR_BOOL, "show tree-like structures of articulated figures not at rest" );
+idCVar af_parallel(					"af_parallel",				"1",			CVAR_GAME | CVAR_BOOL, "solve the articulated figures that don't touch another one on worker threads before the entities think" );
 idCVar af_testSolid(				"af_testSolid",				"1",			CVAR_GAME | CVAR_BOOL, "test for bodies initially stuck in solid" );
 
 idCVar rb_showTimings(				"rb_showTimings",			"0",			CVAR_GAME | CVAR_BOOL, "show rigid body cpu usage" );
@@ -712,6 +761,8 @@ idCVar aas_pullPlayer(				"aas_pullPlayer",			"0",			CVAR_GAME | CVAR_INTEGER, "
 idCVar aas_randomPullPlayer(		"aas_randomPullPlayer",		"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar aas_goalArea(				"aas_goalArea",				"0",			CVAR_GAME | CVAR_INTEGER, "" );
 idCVar aas_showPushIntoArea(		"aas_showPushIntoArea",		"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar aas_routingCacheMemory(		"aas_routingCacheMemory",	"2048",			CVAR_GAME | CVAR_ARCHIVE | CVAR_INTEGER, "The memory (in KB) each AAS may use for its routing caches before the oldest are deleted.", 256, 262144 );
+idCVar aas_precomputePortalCache(	"aas_precomputePortalCache",	"0",		CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "Set up the portal routing caches towards all portal areas when the AAS is loaded, within half of aas_routingCacheMemory." );
 
 idCVar g_password(					"g_password",				"",				CVAR_GAME | CVAR_ARCHIVE, "game password" );
 idCVar password(					"password",					"",				CVAR_GAME | CVAR_NOCHEAT, "client password used when connecting" );
@@ -733,6 +784,7 @@ idCVar g_voteFlags(					"g_voteFlags",				"0",			CVAR_GAME | CVAR_NETWORKSYNC |
 																					"bit 6 (+64)  spectators\n"
 																					"bit 7 (+128) next map" );
 idCVar g_mapCycle(					"g_mapCycle",				"mapcycle",		CVAR_GAME | CVAR_ARCHIVE, "map cycling script for multiplayer games - see mapcycle.scriptcfg" );
+idCVar g_pvsCache(					"g_pvsCache",				"1",			CVAR_GAME | CVAR_BOOL, "load the PVS from maps/<map>.pvs when the portals didn't change, and write it there after calculating it" );
 
 idCVar mod_validSkins(				"mod_validSkins",			"skins/characters/player/marine_mp;skins/characters/player/marine_mp_green;skins/characters/player/marine_mp_blue;skins/characters/player/marine_mp_red;skins/characters/player/marine_mp_yellow",		CVAR_GAME | CVAR_ARCHIVE, "valid skins for the game" );
 idCVar net_serverDownload(			"net_serverDownload",		"0",			CVAR_GAME | CVAR_INTEGER | CVAR_ARCHIVE, "enable server download redirects. 0: off 1: redirect to si_serverURL 2: use builtin download. see net_serverDl cvars for configuration" );
@@ -40,9 +40,14 @@ extern idCVar cv_ai_sight_prob;
 extern idCVar cv_ai_sight_mag;
 extern idCVar cv_ai_sightmaxdist;
 extern idCVar cv_ai_sightmindist;
+extern idCVar cv_ai_route_queries;
+extern idCVar cv_ai_visscan_budget;
+extern idCVar cv_ai_visscan_maxage;
+extern idCVar cv_ai_benchmark_sound;
 extern idCVar cv_ai_sight_combat_cutoff; // grayman #3063
 extern idCVar cv_ai_tactalert;
 extern idCVar cv_ai_task_show;
+extern idCVar cv_ai_task_stats;
 extern idCVar cv_ai_alertlevel_show;
 extern idCVar cv_ai_dest_show;
 extern idCVar cv_ai_goalpos_show;
@@ -70,12 +75,32 @@ extern idCVar cv_ai_opt_interleavethinkmaxdist;
 extern idCVar cv_ai_opt_interleavethinkskippvscheck;
 extern idCVar cv_ai_opt_interleavethinkframes;
 extern idCVar cv_ai_opt_update_enemypos_interleave;
+extern idCVar cv_think_scheduler;
+extern idCVar cv_think_scheduler_show;
+extern idCVar cv_think_ai_balance;
+extern idCVar cv_think_ai_budget;
+extern idCVar cv_think_parallel;
+extern idCVar cv_anim_parallel;
+extern idCVar cv_anim_binary;
+extern idCVar cv_anim_compress;
+extern idCVar cv_anim_posecache;
+extern idCVar cv_physics_islands;
+extern idCVar cv_physics_islands_sleeptime;
+extern idCVar cv_physics_islands_sleepvelocity;
+extern idCVar cv_physics_islands_sleepangularvelocity;
+extern idCVar cv_physics_islands_show;
+extern idCVar cv_think_interleave_mindist;
+extern idCVar cv_think_interleave_maxdist;
 extern idCVar cv_ai_opt_nomind;
 extern idCVar cv_ai_opt_novisualstim;
 extern idCVar cv_ai_opt_nolipsync;
 extern idCVar cv_ai_opt_nopresent;
 extern idCVar cv_ai_opt_noobstacleavoidance;
 extern idCVar cv_ai_hiding_spot_max_light_quotient;
+extern idCVar cv_ai_hiding_spot_index;
+extern idCVar cv_ai_hiding_spot_area_candidates;
+extern idCVar cv_ai_hiding_spot_batch;
+extern idCVar cv_ai_hiding_spot_batch_scale;
 extern idCVar cv_ai_max_hiding_spot_tests_per_frame;
 extern idCVar cv_ai_debug_anims;
 
@@ -107,6 +132,8 @@ extern idCVar cv_tdm_mission_list_urls;
 extern idCVar cv_tdm_mission_details_url;
 extern idCVar cv_tdm_mission_screenshot_url;
 extern idCVar cv_tdm_version_check_url;
+extern idCVar cv_tdm_download_segments;
+extern idCVar cv_tdm_download_concurrency;
 extern idCVar cv_tdm_http_base_url;
 
 extern idCVar cv_debug_aastype;
@@ -118,10 +145,14 @@ extern idCVar cv_tdm_difficulty;
 
 extern idCVar cv_sr_disable;
 extern idCVar cv_sr_show;
+extern idCVar cv_sr_broadphase;
+extern idCVar cv_sr_profile;
 
 extern idCVar cv_sndprop_disable;
 extern idCVar cv_spr_debug;
 extern idCVar cv_spr_show;
+extern idCVar cv_spr_prune;
+extern idCVar cv_spr_coalesce;
 extern idCVar cv_spr_radius_show;
 extern idCVar cv_ko_show;
 extern idCVar cv_ai_animstate_show;
@@ -190,6 +221,9 @@ extern idCVar cv_ai_search_type; // grayman #4220 - control type of search
 
 extern idCVar cv_force_savegame_load;
 extern idCVar cv_savegame_compress;
+extern idCVar cv_savegame_compress_level;
+extern idCVar cv_savegame_compress_lz4;
+extern idCVar cv_savegame_profile;
 
 // angua: TDM toggle crouch
 extern idCVar cv_tdm_crouch_toggle;
@@ -251,6 +285,7 @@ extern idCVar cv_melee_invert_parry;
 extern idCVar cv_melee_auto_parry;
 extern idCVar cv_melee_forbid_auto_parry;
 extern idCVar cv_melee_max_particles;
+extern idCVar cv_melee_sweep_cull;
 extern idCVar cv_phys_show_momentum;
 
 extern idCVar cv_throw_min;
@@ -311,6 +346,9 @@ extern idCVar cv_lg_debug;
 extern idCVar cv_lg_model;
 extern idCVar cv_lg_adjust;
 extern idCVar cv_lg_split;
+extern idCVar cv_lg_analytic;
+extern idCVar cv_lg_async;
+extern idCVar cv_lg_interval;
 extern idCVar cv_lg_path;
 extern idCVar cv_lg_crouch_modifier;
 extern idCVar cv_lg_image_width;
@@ -373,6 +411,7 @@ extern idCVar cv_moveable_collision;
 
 // Tels: LOD system: multiplier for the LOD distance to be used
 extern idCVar cv_lod_bias;
+extern idCVar cv_seed_max_changes;
 
 // grayman: for debugging 'evidence' barks and greetings
 extern idCVar cv_ai_debug_transition_barks;
@@ -417,6 +456,7 @@ extern idCVar	g_skipFX;
 extern idCVar	g_skipParticles;
 extern idCVar	g_bloodEffects;
 extern idCVar	g_projectileLights;
+extern idCVar	g_batchProjectiles;
 extern idCVar	g_doubleVision;
 extern idCVar	g_muzzleFlash;
 
@@ -427,6 +467,10 @@ extern idCVar	g_debugMove;
 extern idCVar	g_debugDamage;
 extern idCVar	g_debugWeapon;
 extern idCVar	g_debugScript;
+extern idCVar	g_scriptProfile;
+extern idCVar	g_spawnTiming;
+extern idCVar	g_fuseScript;
+extern idCVar	g_scriptCache;
 extern idCVar	g_debugMover;
 extern idCVar	g_debugTriggers;
 extern idCVar	g_debugCinematic;
@@ -439,6 +483,8 @@ extern idCVar	g_showTriggers;
 extern idCVar	g_showCollisionWorld;
 extern idCVar	g_showCollisionModels;
 extern idCVar	g_showCollisionTraces;
+extern idCVar	g_clipContentsCache;
+extern idCVar	g_clipQueryRegion;
 extern idCVar	g_maxShowDistance;
 extern idCVar	g_showEntityInfo;
 extern idCVar	g_showviewpos;
@@ -491,6 +537,8 @@ extern idCVar	g_enablePortalSky;
 
 extern idCVar	ik_enable;
 extern idCVar	ik_debug;
+extern idCVar	ik_batchFootTraces;
+extern idCVar	ik_footTraceDist;
 
 extern idCVar	af_useLinearTime;
 extern idCVar	af_useImpulseFriction;
@@ -521,6 +569,7 @@ extern idCVar	af_showTotalMass;
 extern idCVar	af_showInertia;
 extern idCVar	af_showVelocity;
 extern idCVar	af_showActive;
+extern idCVar	af_parallel;
 extern idCVar	af_testSolid;
 
 extern idCVar	rb_showTimings;
@@ -608,11 +657,14 @@ extern idCVar	aas_pullPlayer;
 extern idCVar	aas_randomPullPlayer;
 extern idCVar	aas_goalArea;
 extern idCVar	aas_showPushIntoArea;
+extern idCVar	aas_routingCacheMemory;
+extern idCVar	aas_precomputePortalCache;
 
 extern idCVar	net_clientPredictGUI;
 
 extern idCVar	g_voteFlags;
 extern idCVar	g_mapCycle;
+extern idCVar	g_pvsCache;
 extern idCVar	g_balanceTDM;
 
 extern idCVar	si_timeLimit;
@@ -54,6 +54,10 @@ idVec3 vec3_boxEpsilon( CM_BOX_EPSILON, CM_BOX_EPSILON, CM_BOX_EPSILON );
 
 idBlockAlloc<clipLink_t, 1024>	clipLinkAllocator;
 
+int idClipModel::changeCount = 0;
+
+const int MAX_CONTENTS_CACHE = 1024;
+
 
 /*
 ===============================================================
@@ -233,6 +237,7 @@ bool idClipModel::LoadModel( const char *name, const idDeclSkin* skin )
 	if ( collisionModelHandle ) {
 		collisionModelManager->GetModelBounds( collisionModelHandle, bounds );
 		collisionModelManager->GetModelContents( collisionModelHandle, contents );
+		changeCount++;
 		return true;
 	} else {
 		bounds.Zero();
@@ -253,6 +258,10 @@ void idClipModel::LoadModel( const idTraceModel &trm ) {
 	}
 	traceModelIndex = AllocTraceModel( trm );
 	bounds = trm.bounds;
+	// the temporary clip model is loaded for every bounds trace but never linked
+	if ( clipLinks ) {
+		changeCount++;
+	}
 }
 
 /*
@@ -518,6 +527,10 @@ idClipModel::Unlink
 void idClipModel::Unlink( void ) {
 	clipLink_t *link;
 
+	if ( clipLinks ) {
+		changeCount++;
+	}
+
 	for ( link = clipLinks; link; link = clipLinks ) {
 		clipLinks = link->nextLink;
 		if ( link->prevInSector ) {
@@ -600,6 +613,7 @@ void idClipModel::Link( idClip &clp ) {
 	absBounds[1] += vec3_boxEpsilon;
 
 	Link_r( clp.clipSectors );
+	changeCount++;
 }
 
 /*
@@ -652,6 +666,11 @@ idClip::idClip( void ) {
 	clipSectors = NULL;
 	worldBounds.Zero();
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	numContentsCacheHits = 0;
+	contentsCacheFrame = -1;
+	contentsCacheChangeCount = 0;
+	queryRegionActive = false;
+	queryRegionChangeCount = 0;
 }
 
 /*
@@ -733,6 +752,9 @@ void idClip::Init( void ) {
 
 	// set counters to zero
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	numContentsCacheHits = 0;
+
+	ClearContentsCache();
 }
 
 /*
@@ -744,6 +766,19 @@ void idClip::Shutdown( void ) {
 	delete[] clipSectors;
 	clipSectors = NULL;
 
+	batchRequests.Clear();
+	batchResults.Clear();
+	batchTouches.Clear();
+	batchClipModels.Clear();
+	batchTraces.Clear();
+	batchFirstClipModel.Clear();
+
+	contentsCache.Clear();
+	contentsCacheHash.Free();
+
+	queryRegionActive = false;
+	queryRegionModels.Clear();
+
 	// free the trace model used for the temporaryClipModel
 	if ( temporaryClipModel.traceModelIndex != -1 ) {
 		idClipModel::FreeTraceModel( temporaryClipModel.traceModelIndex );
@@ -847,12 +882,65 @@ int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, i
 	parms.count = 0;
 	parms.maxCount = maxCount;
 
+	// take them from the query region if it holds all the clip models these bounds can touch
+	if ( queryRegionActive && queryRegionChangeCount == idClipModel::changeCount && queryRegionBounds.ContainsPoint( parms.bounds[0] ) && queryRegionBounds.ContainsPoint( parms.bounds[1] ) ) {
+		for ( int i = 0; i < queryRegionModels.Num(); i++ ) {
+			idClipModel *check = queryRegionModels[i];
+
+			if ( !( check->contents & parms.contentMask ) ) {
+				continue;
+			}
+			if ( !check->absBounds.IntersectsBounds( parms.bounds ) ) {
+				continue;
+			}
+			if ( parms.count >= parms.maxCount ) {
+				gameLocal.Warning( "idClip::ClipModelsTouchingBounds: max count (%i) reached", parms.maxCount );
+				break;
+			}
+			parms.list[parms.count++] = check;
+		}
+		return parms.count;
+	}
+
 	touchCount++;
 	ClipModelsTouchingBounds_r( clipSectors, parms );
 
 	return parms.count;
 }
 
+/*
+================
+idClip::BeginQueryRegion
+================
+*/
+void idClip::BeginQueryRegion( const idBounds &bounds ) {
+	idClipModel *clipModelList[MAX_GENTITIES];
+	int num;
+
+	queryRegionActive = false;
+	num = ClipModelsTouchingBounds( bounds, -1, clipModelList, MAX_GENTITIES );
+
+	queryRegionModels.SetNum( num, false );
+	for ( int i = 0; i < num; i++ ) {
+		queryRegionModels[i] = clipModelList[i];
+	}
+	// the same expansion ClipModelsTouchingBounds gave the bounds it gathered with
+	queryRegionBounds[0] = bounds[0] - vec3_boxEpsilon;
+	queryRegionBounds[1] = bounds[1] + vec3_boxEpsilon;
+	queryRegionChangeCount = idClipModel::changeCount;
+	queryRegionActive = true;
+}
+
+/*
+================
+idClip::EndQueryRegion
+================
+*/
+void idClip::EndQueryRegion( void ) {
+	queryRegionActive = false;
+	queryRegionModels.SetNum( 0, false );
+}
+
 /*
 ================
 idClip::EntitiesTouchingBounds
@@ -1145,6 +1233,138 @@ bool idClip::Translation( trace_t &results, const idVec3 &start, const idVec3 &e
 	return ( results.fraction < 1.0f );
 }
 
+/*
+============
+idClip::TranslationBatch
+
+Same as a Translation for every request. The world is traced first for all the
+point traces, then the clip models touching what is left of each trace. The
+collision model manager spreads the traces of both passes over its threads.
+============
+*/
+void idClip::TranslationBatch( trace_t *results, const clipTraceRequest_t *requests, const int numRequests ) {
+	int i, j, num;
+	idClipModel *touch, *clipModelList[MAX_GENTITIES];
+	idBounds traceBounds;
+
+	batchRequests.SetNum( 0, false );
+	batchTouches.SetNum( 0, false );
+
+	// the world
+	for ( i = 0; i < numRequests; i++ ) {
+		const clipTraceRequest_t &request = requests[i];
+
+		if ( !request.bounds[0].Compare( vec3_origin ) || !request.bounds[1].Compare( vec3_origin ) ) {
+			TraceBounds( results[i], request.start, request.end, request.bounds, request.contentMask, request.passEntity );
+			continue;
+		}
+
+		if ( !request.passEntity || request.passEntity->entityNumber != ENTITYNUM_WORLD ) {
+			cmTraceRequest_t &cmRequest = batchRequests.Alloc();
+			cmRequest.start = request.start;
+			cmRequest.end = request.end;
+			cmRequest.trm = NULL;
+			cmRequest.trmAxis = mat3_identity;
+			cmRequest.contentMask = request.contentMask;
+			cmRequest.model = 0;
+			cmRequest.modelOrigin = vec3_origin;
+			cmRequest.modelAxis = mat3_default;
+			batchTouches.Append( i );
+		} else {
+			memset( &results[i], 0, sizeof( results[i] ) );
+			results[i].fraction = 1.0f;
+			results[i].endpos = request.end;
+			results[i].endAxis = mat3_identity;
+		}
+	}
+
+	idClip::numTranslations += batchRequests.Num();
+	batchResults.SetNum( batchRequests.Num(), false );
+	collisionModelManager->TranslationBatch( batchResults.Ptr(), batchRequests.Ptr(), batchRequests.Num() );
+
+	for ( i = 0; i < batchTouches.Num(); i++ ) {
+		trace_t &result = results[batchTouches[i]];
+		result = batchResults[i];
+		result.c.entityNum = result.fraction != 1.0f ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
+	}
+
+	// the clip models along the remaining traces, gathered here since the touch count is shared
+	batchRequests.SetNum( 0, false );
+	batchTouches.SetNum( 0, false );
+	batchClipModels.SetNum( 0, false );
+	batchFirstClipModel.SetNum( numRequests + 1, false );
+
+	for ( i = 0; i < numRequests; i++ ) {
+		const clipTraceRequest_t &request = requests[i];
+
+		batchFirstClipModel[i] = batchClipModels.Num();
+
+		if ( !request.bounds[0].Compare( vec3_origin ) || !request.bounds[1].Compare( vec3_origin ) || results[i].fraction == 0.0f ) {
+			continue;
+		}
+
+		traceBounds.FromPointTranslation( request.start, results[i].endpos - request.start );
+		num = GetTraceClipModels( traceBounds, request.contentMask, request.passEntity, clipModelList );
+
+		for ( j = 0; j < num; j++ ) {
+			touch = clipModelList[j];
+
+			if ( !touch ) {
+				continue;
+			}
+
+			if ( touch->renderModelHandle == -1 ) {
+				cmTraceRequest_t &cmRequest = batchRequests.Alloc();
+				cmRequest.start = request.start;
+				cmRequest.end = request.end;
+				cmRequest.trm = NULL;
+				cmRequest.trmAxis = mat3_identity;
+				cmRequest.contentMask = request.contentMask;
+				cmRequest.model = touch->Handle();
+				cmRequest.modelOrigin = touch->origin;
+				cmRequest.modelAxis = touch->axis;
+				batchTouches.Append( batchClipModels.Num() );
+			}
+			batchClipModels.Append( touch );
+		}
+	}
+	batchFirstClipModel[numRequests] = batchClipModels.Num();
+
+	idClip::numTranslations += batchRequests.Num();
+	batchResults.SetNum( batchRequests.Num(), false );
+	collisionModelManager->TranslationBatch( batchResults.Ptr(), batchRequests.Ptr(), batchRequests.Num() );
+
+	batchTraces.SetNum( batchClipModels.Num(), false );
+	for ( i = 0; i < batchTouches.Num(); i++ ) {
+		batchTraces[batchTouches[i]] = batchResults[i];
+	}
+
+	// keep the closest hit in the order Translation would have found it
+	for ( i = 0; i < numRequests; i++ ) {
+		const clipTraceRequest_t &request = requests[i];
+		trace_t &result = results[i];
+
+		for ( j = batchFirstClipModel[i]; j < batchFirstClipModel[i+1]; j++ ) {
+			touch = batchClipModels[j];
+			trace_t &trace = batchTraces[j];
+
+			if ( touch->renderModelHandle != -1 ) {
+				idClip::numRenderModelTraces++;
+				TraceRenderModel( trace, request.start, request.end, 0.0f, mat3_identity, touch );
+			}
+
+			if ( trace.fraction < result.fraction ) {
+				result = trace;
+				result.c.entityNum = touch->entity->entityNumber;
+				result.c.id = touch->id;
+				if ( result.fraction == 0.0f ) {
+					break;
+				}
+			}
+		}
+	}
+}
+
 /*
 ============
 idClip::Rotation
@@ -1444,19 +1664,52 @@ int idClip::Contacts( contactInfo_t *contacts, const int maxContacts, const idVe
 	return numContacts;
 }
 
+/*
+============
+idClip::ClearContentsCache
+============
+*/
+void idClip::ClearContentsCache( void ) {
+	contentsCache.SetNum( 0, false );
+	contentsCacheHash.Clear();
+	contentsCacheFrame = gameLocal.framenum;
+	contentsCacheChangeCount = idClipModel::changeCount;
+}
+
 /*
 ============
 idClip::Contents
+
+  The same tests are often repeated during a frame, for instance the water level of an actor.
+  The results are kept until the next frame or until a clip model is linked, unlinked or changed.
+  The position is only quantized for the hash key, a cached result is used for the exact same
+  position, trace model, axis, content mask and pass entity.
 ============
 */
 int idClip::Contents( const idVec3 &start, const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity ) {
-	int i, num, contents;
+	int i, num, contents, hashKey;
 	idClipModel *touch, *clipModelList[MAX_GENTITIES];
 	idBounds traceBounds;
 	const idTraceModel *trm;
 
 	trm = TraceModelForClipModel( mdl );
 
+	hashKey = 0;
+	if ( g_clipContentsCache.GetBool() ) {
+		if ( contentsCacheFrame != gameLocal.framenum || contentsCacheChangeCount != idClipModel::changeCount || contentsCache.Num() >= MAX_CONTENTS_CACHE ) {
+			ClearContentsCache();
+		}
+		hashKey = contentsCacheHash.GenerateKey( start ) ^ contentMask;
+		for ( i = contentsCacheHash.First( hashKey ); i != -1; i = contentsCacheHash.Next( i ) ) {
+			const clipContentsCache_t &entry = contentsCache[i];
+			if ( entry.trm == trm && entry.contentMask == contentMask && entry.passEntity == passEntity &&
+					entry.start == start && ( !trm || entry.trmAxis == trmAxis ) ) {
+				idClip::numContentsCacheHits++;
+				return entry.contents;
+			}
+		}
+	}
+
 	if ( !passEntity || passEntity->entityNumber != ENTITYNUM_WORLD ) {
 		// test world
 		idClip::numContents++;
@@ -1505,6 +1758,17 @@ int idClip::Contents( const idVec3 &start, const idClipModel *mdl, const idMat3
 		}
 	}
 
+	if ( g_clipContentsCache.GetBool() ) {
+		clipContentsCache_t &entry = contentsCache.Alloc();
+		entry.start = start;
+		entry.trmAxis = trmAxis;
+		entry.trm = trm;
+		entry.contentMask = contentMask;
+		entry.passEntity = passEntity;
+		entry.contents = contents;
+		contentsCacheHash.Add( hashKey, contentsCache.Num() - 1 );
+	}
+
 	return contents;
 }
 
@@ -1628,9 +1892,10 @@ idClip::PrintStatistics
 ============
 */
 void idClip::PrintStatistics( void ) {
-	gameLocal.Printf( "t = %-3d, r = %-3d, m = %-3d, render = %-3d, contents = %-3d, contacts = %-3d\n",
-					numTranslations, numRotations, numMotions, numRenderModelTraces, numContents, numContacts );
+	gameLocal.Printf( "t = %-3d, r = %-3d, m = %-3d, render = %-3d, contents = %-3d, cached contents = %-3d, contacts = %-3d\n",
+					numTranslations, numRotations, numMotions, numRenderModelTraces, numContents, numContentsCacheHits, numContacts );
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	numContentsCacheHits = 0;
 }
 
 /*
@@ -111,6 +111,9 @@ public:
 	static void				SaveTraceModels( idSaveGame *savefile );
 	static void				RestoreTraceModels( idRestoreGame *savefile );
 
+							// incremented whenever a clip model is linked, unlinked or changed, see idClip::Contents
+	static int				changeCount;
+
 private:
 	bool					enabled;				// true if this clip model is used for clipping
 	idEntity *				entity;					// entity using this clip model
@@ -164,10 +167,12 @@ ID_INLINE void idClipModel::Scale( const idVec3 &scale ) {
 
 ID_INLINE void idClipModel::Enable( void ) {
 	enabled = true;
+	changeCount++;
 }
 
 ID_INLINE void idClipModel::Disable( void ) {
 	enabled = false;
+	changeCount++;
 }
 
 ID_INLINE void idClipModel::SetMaterial( const idMaterial *m ) {
@@ -180,6 +185,7 @@ ID_INLINE const idMaterial * idClipModel::GetMaterial( void ) const {
 
 ID_INLINE void idClipModel::SetContents( int newContents ) {
 	contents = newContents;
+	changeCount++;
 }
 
 ID_INLINE int idClipModel::GetContents( void ) const {
@@ -204,6 +210,7 @@ ID_INLINE int idClipModel::GetId( void ) const {
 
 ID_INLINE void idClipModel::SetOwner( idEntity *newOwner ) {
 	owner = newOwner;
+	changeCount++;
 }
 
 ID_INLINE idEntity *idClipModel::GetOwner( void ) const {
@@ -260,6 +267,25 @@ ID_INLINE const idTraceModel *idClipModel::GetTraceModel( void ) const {
 //
 //===============================================================
 
+// a trace of a batch, see idClip::TranslationBatch
+typedef struct clipTraceRequest_s {
+	idVec3					start;
+	idVec3					end;
+	idBounds				bounds;			// zero for a point trace
+	int						contentMask;
+	const idEntity *		passEntity;
+} clipTraceRequest_t;
+
+// a result of idClip::Contents kept for the rest of the frame
+typedef struct clipContentsCache_s {
+	idVec3					start;
+	idMat3					trmAxis;
+	const idTraceModel *	trm;
+	int						contentMask;
+	const idEntity *		passEntity;
+	int						contents;
+} clipContentsCache_t;
+
 class idClip {
 
 	friend class idClipModel;
@@ -282,6 +308,10 @@ public:
 	int						Contents( const idVec3 &start,
 								const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity );
 
+	// runs the traces of all the requests, results[i] is the result of requests[i]
+	// the point traces run on several threads, the bounds traces one at a time
+	void					TranslationBatch( trace_t *results, const clipTraceRequest_t *requests, const int numRequests );
+
 	// special case translations versus the rest of the world
 	bool					TracePoint( trace_t &results, const idVec3 &start, const idVec3 &end,
 								int contentMask, const idEntity *passEntity );
@@ -313,6 +343,12 @@ public:
 	int						EntitiesTouchingBounds( const idBounds &bounds, int contentMask, idEntity **entityList, int maxCount ) const;
 	int						ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const;
 
+	// gathers the clip models touching the bounds once, queries within the bounds take their
+	// clip models from that list instead of the clip sectors until EndQueryRegion is called
+	// or a clip model is linked, unlinked or changed
+	void					BeginQueryRegion( const idBounds &bounds );
+	void					EndQueryRegion( void );
+
 	const idBounds &		GetWorldBounds( void ) const;
 	idClipModel *			DefaultClipModel( void );
 
@@ -335,12 +371,31 @@ private:
 	int						numRenderModelTraces;
 	int						numContents;
 	int						numContacts;
+	int						numContentsCacheHits;
+							// Contents results of this frame, dropped when a clip model changes
+	idList<clipContentsCache_t> contentsCache;
+	idHashIndex				contentsCacheHash;
+	int						contentsCacheFrame;
+	int						contentsCacheChangeCount;
+							// clip models of the query region, the list is only used while the change count matches
+	bool					queryRegionActive;
+	idBounds				queryRegionBounds;
+	int						queryRegionChangeCount;
+	idList<idClipModel *>	queryRegionModels;
+							// scratch lists of TranslationBatch
+	idList<cmTraceRequest_t> batchRequests;
+	idList<trace_t>			batchResults;
+	idList<int>				batchTouches;
+	idList<idClipModel *>	batchClipModels;
+	idList<trace_t>			batchTraces;
+	idList<int>				batchFirstClipModel;
 
 private:
 	struct clipSector_s *	CreateClipSectors_r( const int depth, const idBounds &bounds, idVec3 &maxSector );
 	void					ClipModelsTouchingBounds_r( const struct clipSector_s *node, struct listParms_s &parms ) const;
 	const idTraceModel *	TraceModelForClipModel( const idClipModel *mdl ) const;
 	int						GetTraceClipModels( const idBounds &bounds, int contentMask, const idEntity *passEntity, idClipModel **clipModelList ) const;
+	void					ClearContentsCache( void );
 	void					TraceRenderModel( trace_t &trace, const idVec3 &start, const idVec3 &end, const float radius, const idMat3 &axis, idClipModel *touch ) const;
 };
 
@@ -5006,9 +5006,10 @@ void idPhysics_AF::EvaluateConstraints( float timeStep ) {
 		auxiliaryConstraints[i]->Evaluate( invTimeStep );
 	}
 
-	// add contact constraints to the list with frame constraints
+	// add contact constraints to the list with frame constraints,
+	// AddFrameConstraint would discard a step solved ahead
 	for ( i = 0; i < contactConstraints.Num(); i++ ) {
-		AddFrameConstraint( contactConstraints[i] );
+		frameConstraints.Append( contactConstraints[i] );
 	}
 
 	// setup body primary constraint matrix
@@ -5371,7 +5372,9 @@ void idPhysics_AF::AuxiliaryForces( float timeStep ) {
 	}
 
 #ifdef AF_TIMINGS
-	timer_lcp.Start();
+	if ( af_showTimings.GetBool() ) {
+		timer_lcp.Start();
+	}
 #endif
 
 	// calculate lagrange multipliers for auxiliary constraints
@@ -5380,7 +5383,9 @@ void idPhysics_AF::AuxiliaryForces( float timeStep ) {
 	}
 
 #ifdef AF_TIMINGS
-	timer_lcp.Stop();
+	if ( af_showTimings.GetBool() ) {
+		timer_lcp.Stop();
+	}
 #endif
 
 	// calculate auxiliary constraint forces
@@ -6302,6 +6307,8 @@ idPhysics_AF::Rest
 void idPhysics_AF::Rest( void ) {
 	int i;
 
+	DiscardPreparedStep();
+
 	current.atRest = gameLocal.time;
 
 	for ( i = 0; i < bodies.Num(); i++ ) {
@@ -6549,11 +6556,13 @@ const idBounds &idPhysics_AF::GetAbsBounds( int id ) const {
 
 /*
 ================
-idPhysics_AF::Evaluate
+idPhysics_AF::BeginStep
+
+  Sets up the time step and returns false if the simulation is suspended.
+  Moves the af velocity into the frame of a pusher until the end of the step.
 ================
 */
-bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) 
-{
+bool idPhysics_AF::BeginStep( int timeStepMSec, int endTimeMSec ) {
 	float timeStep;
 
 	if ( timeScaleRampStart < MS2SEC( endTimeMSec ) && timeScaleRampEnd > MS2SEC( endTimeMSec ) ) {
@@ -6587,18 +6596,24 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec )
 
 	// if the simulation is suspended because the figure is at rest
 	if ( current.atRest >= 0 || timeStep <= 0.0f ) {
-		DebugDraw();
 		return false;
 	}
 
 	// move the af velocity into the frame of a pusher
 	AddPushVelocity( -current.pushVelocity );
 
-	// TDM: Enable the clipmodels of all team members for collisions
-	idEntity *part = NULL;
-	
-	idList<bool> InitClipStates;
-	bool PartClipState = false;
+	return true;
+}
+
+/*
+================
+idPhysics_AF::EnableTeamClip
+
+  TDM: Enable the clipmodels of all team members for collisions
+================
+*/
+void idPhysics_AF::EnableTeamClip( idList<bool> &clipStates ) const {
+	idEntity *part;
 
 	if( ((idAFEntity_Base *) self )->CollidesWithTeam() )
 	{
@@ -6606,32 +6621,49 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec )
 		{
 			if ( part != self && part->GetPhysics() ) 
 			{
-				PartClipState = part->GetPhysics()->GetClipModel()->IsEnabled();
-				InitClipStates.Append( PartClipState );
+				clipStates.Append( part->GetPhysics()->GetClipModel()->IsEnabled() );
 
 				part->GetPhysics()->EnableClip();
 			}
 		}
 	}
+}
 
-#ifdef AF_TIMINGS
-	timer_total.Start();
-#endif
+/*
+================
+idPhysics_AF::RestoreTeamClip
 
-#ifdef AF_TIMINGS
-	timer_collision.Start();
-#endif
+  TDM: Disable the clipmodels that EnableTeamClip enabled
+================
+*/
+void idPhysics_AF::RestoreTeamClip( const idList<bool> &clipStates ) const {
+	idEntity *part;
+	int count = 0;
 
-	// evaluate contacts
-	EvaluateContacts();
+	if( ((idAFEntity_Base *) self )->CollidesWithTeam() )
+	{
+		for ( part = self->GetTeamMaster(); part != NULL; part = part->GetNextTeamEntity() )  
+		{
+			if ( part != self && part->GetPhysics() ) 
+			{
+				if( !clipStates[count] )
+					part->GetPhysics()->DisableClip();
 
-	// setup contact constraints
-	SetupContactConstraints();
+				count++;
+			}
+		}
+	}
+}
 
-#ifdef AF_TIMINGS
-	timer_collision.Stop();
-#endif
+/*
+================
+idPhysics_AF::SolveStep
 
+  Calculates the next state from the current state, the contacts and the constraints.
+  Only touches the bodies and constraints of this articulated figure.
+================
+*/
+void idPhysics_AF::SolveStep( float timeStep, int endTimeMSec ) {
 	// evaluate constraint equations
 	EvaluateConstraints( timeStep );
 
@@ -6642,14 +6674,9 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec )
 	AddFrameConstraints();
 
 #ifdef AF_TIMINGS
-	int i, numPrimary = 0, numAuxiliary = 0;
-	for ( i = 0; i < primaryConstraints.Num(); i++ ) {
-		numPrimary += primaryConstraints[i]->J1.GetNumRows();
+	if ( af_showTimings.GetBool() ) {
+		timer_pc.Start();
 	}
-	for ( i = 0; i < auxiliaryConstraints.Num(); i++ ) {
-		numAuxiliary += auxiliaryConstraints[i]->J1.GetNumRows();
-	}
-	timer_pc.Start();
 #endif
 
 	// factor matrices for primary constraints
@@ -6659,19 +6686,191 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec )
 	PrimaryForces( timeStep );
 
 #ifdef AF_TIMINGS
-	timer_pc.Stop();
-	timer_ac.Start();
+	if ( af_showTimings.GetBool() ) {
+		timer_pc.Stop();
+		timer_ac.Start();
+	}
 #endif
 
 	// calculate and apply auxiliary constraint forces
 	AuxiliaryForces( timeStep );
 
 #ifdef AF_TIMINGS
-	timer_ac.Stop();
+	if ( af_showTimings.GetBool() ) {
+		timer_ac.Stop();
+	}
 #endif
 
 	// evolve current state to next state
 	Evolve( timeStep );
+}
+
+/*
+================
+idPhysics_AF::CanPrepareStep
+
+  True if the next step can be solved ahead on a worker thread.
+================
+*/
+bool idPhysics_AF::CanPrepareStep( void ) const {
+	int i;
+
+	if ( current.atRest >= 0 || masterBody || preparedStepTime >= 0 ) {
+		return false;
+	}
+
+	// the velocities of pushed figures are changed for the step, pushers save and restore them
+	if ( current.pushVelocity != vec6_origin ) {
+		return false;
+	}
+
+	// frame constraints of other entities are added for the step they think in
+	if ( frameConstraints.Num() ) {
+		return false;
+	}
+
+	// impulse friction changes the current velocities, the timers are shared
+	if ( af_useImpulseFriction.GetBool() || af_useJointImpulseFriction.GetBool() || af_showTimings.GetBool() ) {
+		return false;
+	}
+
+	// suspensions trace the world while they are evaluated
+	for ( i = 0; i < constraints.Num(); i++ ) {
+		if ( constraints[i]->GetType() == CONSTRAINT_SUSPENSION ) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+================
+idPhysics_AF::PrepareStep
+
+  Runs the part of Evaluate before the solver on the game thread: the contacts are
+  found with the world as it is now. Returns true if SolvePreparedStep has to be called.
+================
+*/
+bool idPhysics_AF::PrepareStep( int timeStepMSec, int endTimeMSec ) {
+	idList<bool> initClipStates;
+
+	if ( !BeginStep( timeStepMSec, endTimeMSec ) ) {
+		return false;
+	}
+
+	EnableTeamClip( initClipStates );
+
+	// evaluate contacts
+	EvaluateContacts();
+
+	// setup contact constraints
+	SetupContactConstraints();
+
+	// self collision enabled the clip models of the bodies
+	if ( selfCollision && !af_skipSelfCollision.GetBool() ) {
+		DisableClip();
+	}
+
+	RestoreTeamClip( initClipStates );
+
+	preparedStepTime = endTimeMSec;
+	preparedStepMSec = timeStepMSec;
+
+	return true;
+}
+
+/*
+================
+idPhysics_AF::SolvePreparedStep
+
+  Safe to call from a worker thread for different articulated figures.
+================
+*/
+void idPhysics_AF::SolvePreparedStep( void ) {
+	SolveStep( current.lastTimeStep, preparedStepTime );
+}
+
+/*
+================
+idPhysics_AF::DiscardPreparedStep
+
+  Called before anything changes the state the prepared step was solved from.
+  Evaluate then runs the whole step again.
+================
+*/
+void idPhysics_AF::DiscardPreparedStep( void ) {
+	if ( preparedStepTime < 0 ) {
+		return;
+	}
+
+	preparedStepTime = -1;
+
+	// PrepareStep left the current state alone, the contacts and the next state are evaluated again
+	RemoveFrameConstraints();
+}
+
+/*
+================
+idPhysics_AF::Evaluate
+================
+*/
+bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) 
+{
+	float timeStep;
+	idList<bool> InitClipStates;
+
+	// use the step solved ahead if it is the one to take
+	if ( preparedStepTime == endTimeMSec && preparedStepMSec == timeStepMSec && !changedAF ) {
+		preparedStepTime = -1;
+		timeStep = current.lastTimeStep;
+
+		EnableTeamClip( InitClipStates );
+
+#ifdef AF_TIMINGS
+		timer_total.Start();
+#endif
+	} else {
+		DiscardPreparedStep();
+
+		if ( !BeginStep( timeStepMSec, endTimeMSec ) ) {
+			DebugDraw();
+			return false;
+		}
+		timeStep = current.lastTimeStep;
+
+		EnableTeamClip( InitClipStates );
+
+#ifdef AF_TIMINGS
+		timer_total.Start();
+#endif
+
+#ifdef AF_TIMINGS
+		timer_collision.Start();
+#endif
+
+		// evaluate contacts
+		EvaluateContacts();
+
+		// setup contact constraints
+		SetupContactConstraints();
+
+#ifdef AF_TIMINGS
+		timer_collision.Stop();
+#endif
+
+		SolveStep( timeStep, endTimeMSec );
+	}
+
+#ifdef AF_TIMINGS
+	int i, numPrimary = 0, numAuxiliary = 0;
+	for ( i = 0; i < primaryConstraints.Num(); i++ ) {
+		numPrimary += primaryConstraints[i]->J1.GetNumRows();
+	}
+	for ( i = 0; i < auxiliaryConstraints.Num(); i++ ) {
+		numAuxiliary += auxiliaryConstraints[i]->J1.GetNumRows();
+	}
+#endif
 
 	// debug graphics
 	DebugDraw();
@@ -6765,22 +6964,7 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec )
 #endif
 
 
-	// TDM: Disable the clipmodels that we enabled above
-	int count = 0;
-
-	if( ((idAFEntity_Base *) self )->CollidesWithTeam() )
-	{
-		for ( part = self->GetTeamMaster(); part != NULL; part = part->GetNextTeamEntity() )  
-		{
-			if ( part != self && part->GetPhysics() ) 
-			{
-				if( !InitClipStates[count] )
-					part->GetPhysics()->DisableClip();
-
-				count++;
-			}
-		}
-	}
+	RestoreTeamClip( InitClipStates );
 
 	return true;
 }
@@ -6985,6 +7169,9 @@ idPhysics_AF::idPhysics_AF( void ) {
 
 	lcp = idLCP::AllocSymmetric();
 
+	preparedStepTime = -1;
+	preparedStepMSec = 0;
+
 	memset( &current, 0, sizeof( current ) );
 	current.atRest = -1;
 	current.lastTimeStep = USERCMD_MSEC;
@@ -7209,6 +7396,8 @@ void idPhysics_AF::Restore( idRestoreGame *saveFile ) {
 
 	// the articulated figure structure should have already been restored
 
+	preparedStepTime = -1;
+
 	idPhysics_AF_RestorePState( saveFile, current );
 	idPhysics_AF_RestorePState( saveFile, saved );
 
@@ -7526,6 +7715,7 @@ idPhysics_AF::AddFrameConstraint
 ================
 */
 void idPhysics_AF::AddFrameConstraint( idAFConstraint *constraint ) {
+	DiscardPreparedStep();
 	frameConstraints.Append( constraint );
 	constraint->physics = this;
 }
@@ -7873,6 +8063,7 @@ void idPhysics_AF::ApplyImpulse( const int id, const idVec3 &point, const idVec3
 	if ( noImpact || impulse.LengthSqr() < Square( impulseThreshold ) ) {
 		return;
 	}
+	DiscardPreparedStep();
 	idMat3 invWorldInertiaTensor = bodies[id]->current->worldAxis.Transpose() * bodies[id]->inverseInertiaTensor * bodies[id]->current->worldAxis;
 #ifdef MOD_WATERPHYSICS
 	if( this->water != NULL )
@@ -7898,6 +8089,7 @@ void idPhysics_AF::AddForce( const int id, const idVec3 &point, const idVec3 &fo
 	if ( id < 0 || id >= bodies.Num() ) {
 		return;
 	}
+	DiscardPreparedStep();
 	bodies[id]->current->externalForce.SubVec3( 0 ) += force;
 	bodies[id]->current->externalForce.SubVec3( 1 ) += (point - bodies[id]->current->worldOrigin).Cross( force );
 	Activate();
@@ -7953,6 +8145,8 @@ idPhysics_AF::RestoreState
 void idPhysics_AF::RestoreState( void ) {
 	int i;
 
+	DiscardPreparedStep();
+
 	current = saved;
 
 	for ( i = 0; i < bodies.Num(); i++ ) {
@@ -8004,6 +8198,8 @@ void idPhysics_AF::Translate( const idVec3 &translation, int id ) {
 	int i;
 	idAFBody *body;
 
+	DiscardPreparedStep();
+
 	if ( !worldConstraintsLocked ) {
 		// translate constraints attached to the world
 		for ( i = 0; i < constraints.Num(); i++ ) {
@@ -8032,6 +8228,8 @@ void idPhysics_AF::Rotate( const idRotation &rotation, int id ) {
 	int i;
 	idAFBody *body;
 
+	DiscardPreparedStep();
+
 	// ishtvan: Stop the stretching error due to too many
 	// mat3 to rotation to mat3 conversions
 	idRotation rotationC = rotation;
@@ -8093,6 +8291,7 @@ void idPhysics_AF::SetLinearVelocity( const idVec3 &newLinearVelocity, int id )
 	if ( id < 0 || id >= bodies.Num() ) {
 		return;
 	}
+	DiscardPreparedStep();
 	bodies[id]->current->spatialVelocity.SubVec3( 0 ) = newLinearVelocity;
 	Activate();
 }
@@ -8106,6 +8305,7 @@ void idPhysics_AF::SetAngularVelocity( const idVec3 &newAngularVelocity, int id
 	if ( id < 0 || id >= bodies.Num() ) {
 		return;
 	}
+	DiscardPreparedStep();
 	bodies[id]->current->spatialVelocity.SubVec3( 1 ) = newAngularVelocity;
 	Activate();
 }
@@ -8297,6 +8497,8 @@ void idPhysics_AF::SetPushed( int deltaTime ) {
 	idAFBody *body;
 	idRotation rotation;
 
+	DiscardPreparedStep();
+
 	if ( bodies.Num() ) {
 		body = bodies[0];
 		rotation = ( body->saved.worldAxis.Transpose() * body->current->worldAxis ).ToRotation();
@@ -8338,6 +8540,8 @@ void idPhysics_AF::SetMaster( idEntity *master, const bool orientated ) {
 	idMat3 masterAxis;
 	idRotation rotation;
 
+	DiscardPreparedStep();
+
 	if ( master ) {
 		self->GetMasterPosition( masterOrigin, masterAxis );
 		if ( !masterBody ) {
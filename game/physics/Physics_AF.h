@@ -1000,6 +1000,12 @@ public:	// common physics interface
 	**/
 	void					BuildTrees( void );
 
+							// solve the next step ahead on a worker thread, see idGameLocal::SolveArticulatedFigures
+	bool					CanPrepareStep( void ) const;
+	bool					PrepareStep( int timeStepMSec, int endTimeMSec );
+	void					SolvePreparedStep( void );
+	void					DiscardPreparedStep( void );
+
 	/**
 	* Get/Set the number of original bodies or constraints
 	* These are constraints that are added by this entity's AF only, not ones that are attached later
@@ -1088,6 +1094,9 @@ private:
 	idAFBody *				masterBody;						// master body
 	idLCP *					lcp;							// linear complementarity problem solver
 
+	int						preparedStepTime;				// end time of the step solved ahead, -1 if none
+	int						preparedStepMSec;				// length of the step solved ahead
+
 private:
 	bool					IsClosedLoop( const idAFBody *body1, const idAFBody *body2 ) const;
 	void					PrimaryFactor( void );
@@ -1102,6 +1111,10 @@ private:
 	void					SetupContactConstraints( void );
 	void					ApplyContactForces( void );
 	void					Evolve( float timeStep );
+	bool					BeginStep( int timeStepMSec, int endTimeMSec );
+	void					SolveStep( float timeStep, int endTimeMSec );
+	void					EnableTeamClip( idList<bool> &clipStates ) const;
+	void					RestoreTeamClip( const idList<bool> &clipStates ) const;
 	idEntity *				SetupCollisionForBody( idAFBody *body ) const;
 	bool					CollisionImpulse( float timeStep, idAFBody *body, trace_t &collision );
 	bool					ApplyCollisions( float timeStep );
@@ -117,6 +117,8 @@ public:	// common physics interface
 	const contactInfo_t &	GetContact( int num ) const;
 	void					ClearContacts( void );
 	void					AddContactEntity( idEntity *e );
+	int						GetNumContactEntities( void ) const { return contactEntities.Num(); }
+	idEntity *				GetContactEntity( int num ) const { return contactEntities[num].GetEntity(); }
 	void					RemoveContactEntity( idEntity *e );
 
 	bool					HasGroundContacts( void ) const;
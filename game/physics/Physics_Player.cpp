@@ -71,6 +71,10 @@ const float MIN_WALK_NORMAL		  = 0.7f;  // can't walk on very steep slopes (run
 const float MIN_WALK_SLICK_NORMAL = 0.89f; // grayman #2409 - higher value for slippery slopes (run = 1, rise = 0.5)
 const float OVERCLIP			  = 1.001f;
 
+// the ground, water, climb, duck and lean checks of a move only test space this close to the
+// player, the clip models around the player are gathered once for all of them
+const float PM_QUERY_REGION		  = 48.0f;
+
 // TODO (ishtvan): Move the following to INI file or player def file:
 
 /**
@@ -2444,6 +2448,7 @@ idPhysics_Player::MovePlayer
 ================
 */
 void idPhysics_Player::MovePlayer( int msec ) {
+	PROFILE_SCOPE( "idPhysics_Player::MovePlayer" );
 
 	// this counter lets us debug movement problems with a journal
 	// by setting a conditional breakpoint for the previous frame
@@ -2515,36 +2520,45 @@ void idPhysics_Player::MovePlayer( int msec ) {
 		command.upmove = 0;
 	}
 
-	// set watertype and waterlevel
-	idPhysics_Player::SetWaterLevel(true); // greebo: Update the previousWaterLevel here
+	if ( g_clipQueryRegion.GetBool() ) {
+		gameLocal.clip.BeginQueryRegion( clipModel->GetBounds().Translate( current.origin ).Expand( PM_QUERY_REGION ) );
+	}
 
-	// check for ground
-	idPhysics_Player::CheckGround();
+	{
+		PROFILE_SCOPE( "PlayerChecks" );
 
-	// check if a ladder or a rope is straight ahead
-	idPhysics_Player::CheckClimbable();
+		// set watertype and waterlevel
+		idPhysics_Player::SetWaterLevel(true); // greebo: Update the previousWaterLevel here
 
-	// set clip model size
-	idPhysics_Player::CheckDuck();
+		// check for ground
+		idPhysics_Player::CheckGround();
 
-	// handle timers
-	idPhysics_Player::DropTimers();
+		// check if a ladder or a rope is straight ahead
+		idPhysics_Player::CheckClimbable();
 
-	// Mantle Mod: SophisticatdZombie (DH)
-	idPhysics_Player::UpdateMantleTimers();
+		// set clip model size
+		idPhysics_Player::CheckDuck();
 
-	// Lean Mod: Zaccheus and SophisticatedZombie (DH)
-	idPhysics_Player::LeanMove();
+		// handle timers
+		idPhysics_Player::DropTimers();
 
-	// Check if holding down jump
-	if (CheckJumpHeldDown())
-	{
-		PerformMantle();
+		// Mantle Mod: SophisticatdZombie (DH)
+		idPhysics_Player::UpdateMantleTimers();
+
+		// Lean Mod: Zaccheus and SophisticatedZombie (DH)
+		idPhysics_Player::LeanMove();
+
+		// Check if holding down jump
+		if (CheckJumpHeldDown())
+		{
+			PerformMantle();
+		}
 	}
 
 	// move
 	if ( current.movementType == PM_DEAD ) {
 		// dead
+		PROFILE_SCOPE( "DeadMove" );
 		DeadMove();
 	}
 	// continue moving on the rope if still attached
@@ -2566,6 +2580,7 @@ void idPhysics_Player::MovePlayer( int msec ) {
 			}
 		}
 
+		PROFILE_SCOPE( "RopeMove" );
 		RopeMove();
 	}
 	// Mantle MOD
@@ -2573,10 +2588,13 @@ void idPhysics_Player::MovePlayer( int msec ) {
 	// greebo: Do the MantleMove before checking the rope contacts
 	else if ( !(m_mantlePhase == notMantling_DarkModMantlePhase || m_mantlePhase == fixClipping_DarkModMantlePhase) ) 
 	{
+		PROFILE_SCOPE( "MantleMove" );
 		MantleMove();
 	}
 	else if ( m_bRopeContact ) 
 	{
+		PROFILE_SCOPE( "RopeMove" );
+
 		// toggle m_bOnRope
 		m_bOnRope = true;
 
@@ -2588,19 +2606,23 @@ void idPhysics_Player::MovePlayer( int msec ) {
 	else if ( m_bOnClimb ) 
 	{
 		// going up or down a ladder
+		PROFILE_SCOPE( "LadderMove" );
 		LadderMove();
 	}
 	else if ( waterLevel > WATERLEVEL_FEET )
 	{
 		// swimming
+		PROFILE_SCOPE( "WaterMove" );
 		WaterMove();
 	}
 	else if ( walking ) {
 		// walking on ground
+		PROFILE_SCOPE( "WalkMove" );
 		WalkMove();
 	}
 	else {
 		// airborne
+		PROFILE_SCOPE( "AirMove" );
 		AirMove();
 	}
 
@@ -2611,8 +2633,13 @@ void idPhysics_Player::MovePlayer( int msec ) {
 	}
 
 	// set watertype, waterlevel and groundentity
-	SetWaterLevel(false); // greebo: Don't update the previousWaterLevel this time
-	CheckGround();
+	{
+		PROFILE_SCOPE( "PlayerChecks" );
+		SetWaterLevel(false); // greebo: Don't update the previousWaterLevel this time
+		CheckGround();
+	}
+
+	gameLocal.clip.EndQueryRegion();
 
 	// move the player velocity back into the world frame
 	current.velocity += current.pushVelocity;
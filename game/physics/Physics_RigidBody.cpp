@@ -311,8 +311,9 @@ bool idPhysics_RigidBody::PropagateImpulse(const int id, const idVec3& point, co
 	//DM_LOG(LC_ENTITY, LT_INFO)LOGSTRING("Linear Momentum after friction: [%s]", current.i.linearMomentum.ToString());
 	//DM_LOG(LC_ENTITY, LT_INFO)LOGSTRING("Angular Momentum after friction: [%s]", current.i.angularMomentum.ToString());
 
-	// The list of all the touching entities
-	idList<contactInfo_t> touching;
+	// The list of all the touching entities, temporary for this frame
+	CFrameArenaScope arenaScope(gameLocal.m_FrameArena);
+	idList< contactInfo_t, CFrameArenaAllocator<contactInfo_t> > touching;
 
 	// greebo: FIXME: A possible optimisation would be to store the contact indices instead of copying the entire struct
 	
@@ -586,6 +587,16 @@ bool idPhysics_RigidBody::CheckForCollisions( const float deltaTime, rigidBodyPS
 	}
 #endif
 
+	// nothing to hit along a path traced clear this frame
+	clearPathUsed = false;
+	if ( clearPathTime == gameLocal.time ) {
+		clearPathTime = -1;
+		if ( current.i.position == clearPathStart && ( next.i.position - clearPathEnd ).LengthSqr() <= Square( clearPathTolerance ) ) {
+			clearPathUsed = true;
+			return false;
+		}
+	}
+
 	TransposeMultiply( current.i.orientation, next.i.orientation, axis );
 	rotation = axis.ToRotation();
 	rotation.SetOrigin( current.i.position );
@@ -723,17 +734,19 @@ void idPhysics_RigidBody::ContactFriction( float deltaTime )
 
 	// Keep lists of contact point normals and calculated momentums. Average the
 	// momentums across all points that have the same normal.
+	// The lists only live for this call, so they are kept in the frame arena.
+	CFrameArenaScope arenaScope(gameLocal.m_FrameArena);
 
-	idList<idVec3> normals; // list of different contact point normals
+	idList< idVec3, CFrameArenaAllocator<idVec3> > normals; // list of different contact point normals
 	normals.Clear();
 
-	idList<idVec3> lm; // list of summed linear momentum for each set of normals
+	idList< idVec3, CFrameArenaAllocator<idVec3> > lm; // list of summed linear momentum for each set of normals
 	lm.Clear();
 
-	idList<idVec3> am; // list of summed angular momentum for each set of normals
+	idList< idVec3, CFrameArenaAllocator<idVec3> > am; // list of summed angular momentum for each set of normals
 	am.Clear();
 
-	idList<int> normalCount; // list of the number of contributing points for each normal set
+	idList< int, CFrameArenaAllocator<int> > normalCount; // list of the number of contributing points for each normal set
 	normalCount.Clear();
 
 	for ( int i = 0 ; i < contacts.Num() ; i++ )
@@ -1186,6 +1199,12 @@ idPhysics_RigidBody::idPhysics_RigidBody( void ) {
 
 	memset(&collisionTrace, 0, sizeof(collisionTrace));
 
+	clearPathTime = -1;
+	clearPathUsed = false;
+	clearPathStart.Zero();
+	clearPathEnd.Zero();
+	clearPathTolerance = 0.0f;
+
 	// tels
 	maxForce.Zero();
 	maxTorque.Zero();
@@ -1770,8 +1789,15 @@ bool idPhysics_RigidBody::Evaluate( int timeStepMSec, int endTimeMSec ) {
 #ifdef RB_TIMINGS
 		timer_collision.Start();
 #endif
-		// get contacts
-		EvaluateContacts();
+		// get contacts, there are none within the tolerance of a clear path
+		if ( clearPathUsed )
+		{
+			ClearContacts();
+		}
+		else
+		{
+			EvaluateContacts();
+		}
 
 #ifdef RB_TIMINGS
 		timer_collision.Stop();
@@ -2357,6 +2383,28 @@ bool idPhysics_RigidBody::EvaluateContacts( void ) {
 	return ( contacts.Num() != 0 );
 }
 
+/*
+================
+idPhysics_RigidBody::SetClearPath
+================
+*/
+void idPhysics_RigidBody::SetClearPath( const idVec3 &start, const idVec3 &end, const float tolerance ) {
+	clearPathTime = gameLocal.time;
+	clearPathUsed = false;
+	clearPathStart = start;
+	clearPathEnd = end;
+	clearPathTolerance = tolerance;
+}
+
+/*
+================
+idPhysics_RigidBody::UsedClearPath
+================
+*/
+bool idPhysics_RigidBody::UsedClearPath( void ) const {
+	return clearPathUsed;
+}
+
 /*
 ================
 idPhysics_RigidBody::SetPushed
@@ -151,6 +151,11 @@ public:	// common physics interface
 
 	bool					EvaluateContacts( void );
 
+							// the path from start to end was traced clear with a box covering the clip model grown by
+							// tolerance, the next Evaluate skips its collision and contact queries if it stays that close
+	void					SetClearPath( const idVec3 &start, const idVec3 &end, const float tolerance );
+	bool					UsedClearPath( void ) const;
+
 	void					SetPushed( int deltaTime );
 	const idVec3 &			GetPushedLinearVelocity( const int id = 0 ) const;
 	const idVec3 &			GetPushedAngularVelocity( const int id = 0 ) const;
@@ -210,6 +215,13 @@ private:
 
 	bool					propagateImpulseLock;
 
+	// see SetClearPath, not saved
+	int						clearPathTime;
+	bool					clearPathUsed;
+	idVec3					clearPathStart;
+	idVec3					clearPathEnd;
+	float					clearPathTolerance;
+
 #ifdef MOD_WATERPHYSICS
 	// buoyancy
 	int					noMoveTime;	// MOD_WATERPHYSICS suspend simulation if hardly any movement for this many seconds
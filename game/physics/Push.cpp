@@ -1095,6 +1095,42 @@ int idPush::DiscardEntities( idEntity *entityList[], int numEntities, int flags,
 	return num;
 }
 
+/*
+============
+idPush::FinishPushedEntities
+
+  Lets the pushed entities find out they may have been pushed off the ground
+  and wakes them up. The pusher is linked in its new position once for all of
+  them, instead of once per entity, which adds up with a lift full of objects.
+============
+*/
+void idPush::FinishPushedEntities( idClipModel *clipModel, idEntity *entityList[], int numEntities,
+									const idVec3 &newOrigin, const idMat3 &newAxis, const idVec3 &impulseDir ) {
+	int i;
+
+	if ( !numEntities ) {
+		return;
+	}
+
+	const idVec3 oldOrigin = clipModel->GetOrigin();
+	const idMat3 oldAxis = clipModel->GetAxis();
+
+	// set the pusher in the new position
+	clipModel->Link( gameLocal.clip, clipModel->GetEntity(), clipModel->GetId(), newOrigin, newAxis );
+	// the entities might be pushed off the ground
+	for ( i = 0; i < numEntities; i++ ) {
+		entityList[i]->GetPhysics()->EvaluateContacts();
+	}
+	// put pusher back in old position
+	clipModel->Link( gameLocal.clip, clipModel->GetEntity(), clipModel->GetId(), oldOrigin, oldAxis );
+
+	// wake up the objects
+	for ( i = 0; i < numEntities; i++ ) {
+		idEntity *ent = entityList[i];
+		ent->ApplyImpulse( clipModel->GetEntity(), clipModel->GetId(), clipModel->GetOrigin(), ent->GetPhysics()->GetMass() * impulseDir );
+	}
+}
+
 /*
 ============
 idPush::ClipTranslationalPush
@@ -1106,10 +1142,10 @@ float idPush::ClipTranslationalPush( trace_t &results, idEntity *pusher, const i
 										const idVec3 &newOrigin, const idVec3 &translation, 
 										float ImpulseMod ) 
 {
-	int			i, listedEntities, res;
+	int			i, listedEntities, numMoved, res;
 	idEntity	*check, *entityList[ MAX_GENTITIES ];
 	idBounds	bounds, pushBounds;
-	idVec3		clipMove, clipOrigin, oldOrigin, dir, impulse;
+	idVec3		clipMove, clipOrigin, dir;
 	trace_t		pushResults;
 	bool		wasEnabled;
 	float		totalMass;
@@ -1152,6 +1188,16 @@ float idPush::ClipTranslationalPush( trace_t &results, idEntity *pusher, const i
 	// discard entities we cannot or should not push
 	listedEntities = DiscardEntities( entityList, listedEntities, flags, pusher );
 
+	// nothing to push and nothing to clip against
+	if ( listedEntities == 0 && !( flags & PUSHFL_CLIP ) )
+	{
+		if ( wasEnabled )
+		{
+			clipModel->Enable();
+		}
+		return totalMass;
+	}
+
 	if ( flags & PUSHFL_CLIP ) 
 	{
 		// can only clip movement of a trace model
@@ -1194,10 +1240,17 @@ float idPush::ClipTranslationalPush( trace_t &results, idEntity *pusher, const i
 	// we have to enable the clip model because we use it during pushing
 	clipModel->Enable();
 
-	// save pusher old position
-	oldOrigin = clipModel->GetOrigin();
+	// wake up the pushed objects
+	if ( flags & PUSHFL_APPLYIMPULSE ) 
+	{
+		dir *= ImpulseMod;
+	} else 
+	{
+		dir.Zero();
+	}
 
-	// try to push the entities
+	// try to push the entities, the pushed ones are moved to the front of the list
+	numMoved = 0;
 	for ( i = 0; i < listedEntities; i++ ) 
 	{
 
@@ -1215,22 +1268,7 @@ float idPush::ClipTranslationalPush( trace_t &results, idEntity *pusher, const i
 		// if the entity is pushed
 		if ( res == PUSH_OK ) 
 		{
-			// set the pusher in the translated position
-			clipModel->Link( gameLocal.clip, clipModel->GetEntity(), clipModel->GetId(), newOrigin, clipModel->GetAxis() );
-			// the entity might be pushed off the ground
-			physics->EvaluateContacts();
-			// put pusher back in old position
-			clipModel->Link( gameLocal.clip, clipModel->GetEntity(), clipModel->GetId(), oldOrigin, clipModel->GetAxis() );
-
-			// wake up this object
-			if ( flags & PUSHFL_APPLYIMPULSE ) 
-			{
-				impulse = ImpulseMod * physics->GetMass() * dir;
-			} else 
-			{
-				impulse.Zero();
-			}
-			check->ApplyImpulse( clipModel->GetEntity(), clipModel->GetId(), clipModel->GetOrigin(), impulse );
+			entityList[ numMoved++ ] = check;
 
 			// add mass of pushed entity
 			totalMass += physics->GetMass();
@@ -1286,6 +1324,8 @@ float idPush::ClipTranslationalPush( trace_t &results, idEntity *pusher, const i
 		results.c.entityNum = check->entityNumber;
 		results.c.id = 0;
 
+		FinishPushedEntities( clipModel, entityList, numMoved, newOrigin, clipModel->GetAxis(), dir );
+
 		if ( !wasEnabled ) 
 		{
 			clipModel->Disable();
@@ -1294,6 +1334,8 @@ float idPush::ClipTranslationalPush( trace_t &results, idEntity *pusher, const i
 		return totalMass;
 	}
 
+	FinishPushedEntities( clipModel, entityList, numMoved, newOrigin, clipModel->GetAxis(), dir );
+
 	if ( !wasEnabled ) 
 	{
 		clipModel->Disable();
@@ -1311,12 +1353,12 @@ idPush::ClipRotationalPush
 */
 float idPush::ClipRotationalPush( trace_t &results, idEntity *pusher, const int flags,
 									const idMat3 &newAxis, const idRotation &rotation ) {
-	int			i, listedEntities, res;
+	int			i, listedEntities, numMoved, res;
 	idEntity	*check;
 	static idEntity* entityList[ MAX_GENTITIES ];
 	idBounds	bounds, pushBounds;
 	idRotation	clipRotation;
-	idMat3		clipAxis, oldAxis;
+	idMat3		clipAxis;
 	trace_t		pushResults;
 	bool		wasEnabled;
 	float		totalMass;
@@ -1352,6 +1394,14 @@ float idPush::ClipRotationalPush( trace_t &results, idEntity *pusher, const int
 	// discard entities we cannot or should not push
 	listedEntities = DiscardEntities( entityList, listedEntities, flags, pusher );
 
+	// nothing to push and nothing to clip against
+	if ( listedEntities == 0 && !( flags & PUSHFL_CLIP ) ) {
+		if ( wasEnabled ) {
+			clipModel->Enable();
+		}
+		return totalMass;
+	}
+
 	if ( flags & PUSHFL_CLIP ) {
 
 		// can only clip movement of a trace model
@@ -1388,10 +1438,8 @@ float idPush::ClipRotationalPush( trace_t &results, idEntity *pusher, const int
 	// we have to enable the clip model because we use it during pushing
 	clipModel->Enable();
 
-	// save pusher old position
-	oldAxis = clipModel->GetAxis();
-
-	// try to push all the entities
+	// try to push all the entities, the pushed ones are moved to the front of the list
+	numMoved = 0;
 	for ( i = 0; i < listedEntities; i++ ) {
 
 		check = entityList[ i ];
@@ -1408,15 +1456,7 @@ float idPush::ClipRotationalPush( trace_t &results, idEntity *pusher, const int
 
 		// if the entity is pushed
 		if ( res == PUSH_OK ) {
-			// set the pusher in the rotated position
-			clipModel->Link( gameLocal.clip, clipModel->GetEntity(), clipModel->GetId(), clipModel->GetOrigin(), newAxis );
-			// the entity might be pushed off the ground
-			physics->EvaluateContacts();
-			// put pusher back in old position
-			clipModel->Link( gameLocal.clip, clipModel->GetEntity(), clipModel->GetId(), clipModel->GetOrigin(), oldAxis );
-
-			// wake up this object
-			check->ApplyImpulse( clipModel->GetEntity(), clipModel->GetId(), clipModel->GetOrigin(), vec3_origin );
+			entityList[ numMoved++ ] = check;
 
 			// add mass of pushed entity
 			totalMass += physics->GetMass();
@@ -1461,6 +1501,8 @@ float idPush::ClipRotationalPush( trace_t &results, idEntity *pusher, const int
 		results.c.entityNum = check->entityNumber;
 		results.c.id = 0;
 
+		FinishPushedEntities( clipModel, entityList, numMoved, clipModel->GetOrigin(), newAxis, vec3_origin );
+
 		if ( !wasEnabled ) {
 			clipModel->Disable();
 		}
@@ -1468,6 +1510,8 @@ float idPush::ClipRotationalPush( trace_t &results, idEntity *pusher, const int
 		return totalMass;
 	}
 
+	FinishPushedEntities( clipModel, entityList, numMoved, clipModel->GetOrigin(), newAxis, vec3_origin );
+
 	if ( !wasEnabled ) {
 		clipModel->Disable();
 	}
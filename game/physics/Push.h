@@ -99,6 +99,8 @@ private:
 	int				TryRotatePushEntity( trace_t &results, idEntity *check, idClipModel *clipModel, const int flags,
 												const idMat3 &newAxis, const idRotation &rotation );
 	int				DiscardEntities( idEntity *entityList[], int numEntities, int flags, idEntity *pusher );
+	void			FinishPushedEntities( idClipModel *clipModel, idEntity *entityList[], int numEntities,
+											const idVec3 &newOrigin, const idMat3 &newAxis, const idVec3 &impulseDir );
 #endif
 };
 
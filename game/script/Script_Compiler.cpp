@@ -191,6 +191,17 @@ opcode_t idCompiler::opcodes[] = {
 	{ "<BREAK>", "BREAK", -1, false, &def_float, &def_void, &def_void },
 	{ "<CONTINUE>", "CONTINUE", -1, false, &def_float, &def_void, &def_void },
 
+	{ "<FUSED>", "EQ_F_IFNOT", -1, false, &def_float, &def_float, &def_float },
+	{ "<FUSED>", "NE_F_IFNOT", -1, false, &def_float, &def_float, &def_float },
+	{ "<FUSED>", "LE_IFNOT", -1, false, &def_float, &def_float, &def_float },
+	{ "<FUSED>", "GE_IFNOT", -1, false, &def_float, &def_float, &def_float },
+	{ "<FUSED>", "LT_IFNOT", -1, false, &def_float, &def_float, &def_float },
+	{ "<FUSED>", "GT_IFNOT", -1, false, &def_float, &def_float, &def_float },
+	{ "<FUSED>", "PUSH_F_PUSH_F", -1, false, &def_float, &def_float, &def_void },
+	{ "<FUSED>", "PUSH_F_EVENTCALL", -1, false, &def_float, &def_float, &def_void },
+	{ "<FUSED>", "PUSH_ENT_EVENTCALL", -1, false, &def_entity, &def_entity, &def_void },
+	{ "<FUSED>", "PUSH_F_SYSCALL", -1, false, &def_float, &def_float, &def_void },
+
 	{ NULL }
 };
 
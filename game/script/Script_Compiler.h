@@ -185,6 +185,19 @@ enum {
 	OP_BREAK,			// placeholder op.  not used in final code
 	OP_CONTINUE,		// placeholder op.  not used in final code
 
+	// superinstructions, set by idProgram::FuseStatements.  they execute their statement
+	// and the one after it, which is left as it is for the jumps to it
+	OP_EQ_F_IFNOT,
+	OP_NE_F_IFNOT,
+	OP_LE_IFNOT,
+	OP_GE_IFNOT,
+	OP_LT_IFNOT,
+	OP_GT_IFNOT,
+	OP_PUSH_F_PUSH_F,
+	OP_PUSH_F_EVENTCALL,
+	OP_PUSH_ENT_EVENTCALL,
+	OP_PUSH_F_SYSCALL,
+
 	NUM_OPCODES
 };
 
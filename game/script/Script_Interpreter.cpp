@@ -33,6 +33,14 @@ idInterpreter::idInterpreter() {
 	localstackUsed = 0;
 	terminateOnExit = true;
 	debug = 0;
+	profiling = false;
+	profileTicks = 0.0;
+	profileInstructions = 0;
+	profileTime = 0.0;
+	numInstructions = 0;
+	for ( int i = 0; i < MAX_STACK_DEPTH; i++ ) {
+		profileEnterTime[i] = -1.0;
+	}
 	memset( localstack, 0, sizeof( localstack ) );
 	memset( callStack, 0, sizeof( callStack ) );
 	Reset();
@@ -116,6 +124,9 @@ void idInterpreter::Restore( idRestoreGame *savefile ) {
 		}
 
 		savefile->ReadInt( callStack[i].stackbase );
+
+		// the functions entered before the save aren't profiled
+		profileEnterTime[i] = -1.0;
 	}
 	savefile->ReadInt( maxStackDepth );
 
@@ -362,6 +373,81 @@ idThread *idInterpreter::GetThread( void ) const {
 }
 
 
+/*
+================
+idInterpreter::GetProfileTime
+================
+*/
+double idInterpreter::GetProfileTime( void ) const {
+	return idScriptProfiler::TicksToMsec( profileTime );
+}
+
+/*
+================
+idInterpreter::GetNumInstructions
+================
+*/
+int idInterpreter::GetNumInstructions( void ) const {
+	return numInstructions;
+}
+
+/*
+================
+idInterpreter::ProfileCharge
+
+Charges the time and instructions since the last charge to the current function
+================
+*/
+void idInterpreter::ProfileCharge( void ) {
+	if ( !profiling ) {
+		return;
+	}
+
+	double ticks = idLib::sys->GetClockTicks();
+	double elapsed = ticks - profileTicks;
+
+	profileTicks = ticks;
+	profileTime += elapsed;
+	if ( currentFunction ) {
+		scriptProfiler.AddSelfTime( currentFunction, elapsed, numInstructions - profileInstructions );
+	}
+	profileInstructions = numInstructions;
+}
+
+/*
+================
+idInterpreter::ProfileEvent
+
+Charges the time since the last charge to the event called
+================
+*/
+void idInterpreter::ProfileEvent( const function_t *func ) {
+	if ( !profiling ) {
+		return;
+	}
+
+	double ticks = idLib::sys->GetClockTicks();
+	double elapsed = ticks - profileTicks;
+
+	profileTicks = ticks;
+	profileTime += elapsed;
+	scriptProfiler.AddEventTime( func, elapsed );
+}
+
+/*
+================
+idInterpreter::ProfileSkip
+
+Doesn't charge the time since the last charge, for threads started by this one
+which charge their own time
+================
+*/
+void idInterpreter::ProfileSkip( void ) {
+	if ( profiling ) {
+		profileTicks = idLib::sys->GetClockTicks();
+	}
+}
+
 /*
 ================
 idInterpreter::SetThread
@@ -608,6 +694,15 @@ void idInterpreter::EnterFunction( const function_t *func, bool clearStack ) {
 		Error( "NULL function" );
 	}
 
+	// the caller is charged up to the call, functions entered before the thread executes are profiled too
+	if ( scriptProfiler.IsActive() ) {
+		ProfileCharge();
+		profileEnterTime[ callStackDepth - 1 ] = profileTime;
+		scriptProfiler.AddCall( func );
+	} else {
+		profileEnterTime[ callStackDepth - 1 ] = -1.0;
+	}
+
 	if ( debug ) {
 		if ( currentFunction ) {
 			gameLocal.Printf( "%d: call '%s' from '%s'(line %d)%s\n", gameLocal.time, func->Name(), currentFunction->Name(), 
@@ -686,6 +781,11 @@ void idInterpreter::LeaveFunction( idVarDef *returnDef ) {
 		}
 	}
 
+	ProfileCharge();
+	if ( profileEnterTime[ callStackDepth - 1 ] >= 0.0 ) {
+		scriptProfiler.AddInclusiveTime( currentFunction, profileTime - profileEnterTime[ callStackDepth - 1 ] );
+	}
+
 	// up stack
 	callStackDepth--;
 	stack = &callStack[ callStackDepth ]; 
@@ -817,7 +917,9 @@ void idInterpreter::CallEvent( const function_t *func, int argsize ) {
 	}
 
 	popParms = argsize;
+	ProfileCharge();
 	eventEntity->ProcessEventArgPtr( evdef, data );
+	ProfileEvent( func );
 
 	if ( !multiFrameEvent ) {
 		if ( popParms ) {
@@ -947,7 +1049,9 @@ void idInterpreter::CallSysEvent( const function_t *func, int argsize ) {
 	}
 
 	popParms = argsize;
+	ProfileCharge();
 	thread->ProcessEventArgPtr( evdef, data );
+	ProfileEvent( func );
 	if ( popParms ) {
 		PopParms( popParms );
 	}
@@ -992,9 +1096,16 @@ bool idInterpreter::Execute( void ) {
 
 	runaway = 5000000;
 
+	profiling = scriptProfiler.IsActive();
+	if ( profiling ) {
+		profileTicks = idLib::sys->GetClockTicks();
+		profileInstructions = numInstructions;
+	}
+
 	doneProcessing = false;
 	while( !doneProcessing && !threadDying ) {
 		instructionPointer++;
+		numInstructions++;
 
 		if ( !--runaway ) {
 			Error( "runaway loop error" );
@@ -1034,7 +1145,9 @@ bool idInterpreter::Execute( void ) {
 
 		case OP_THREAD:
 			newThread = new idThread( this, st->a->value.functionPtr, st->b->value.argSize );
+			ProfileCharge();
 			newThread->Start();
+			ProfileSkip();
 
 			// return the thread number to the script
 			gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
@@ -1048,7 +1161,9 @@ bool idInterpreter::Execute( void ) {
 				func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
 				assert( st->c->value.argSize == func->parmTotal );
 				newThread = new idThread( this, GetEntity( *var_a.entityNumberPtr ), func, func->parmTotal );
+				ProfileCharge();
 				newThread->Start();
+				ProfileSkip();
 
 				// return the thread number to the script
 				gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
@@ -1932,6 +2047,85 @@ bool idInterpreter::Execute( void ) {
 			Push( *var_a.entityNumberPtr );
 			break;
 
+		// superinstructions, see idProgram::FuseStatements
+		case OP_EQ_F_IFNOT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
+			goto fused_ifnot;
+
+		case OP_NE_F_IFNOT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
+			goto fused_ifnot;
+
+		case OP_LE_IFNOT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
+			goto fused_ifnot;
+
+		case OP_GE_IFNOT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
+			goto fused_ifnot;
+
+		case OP_LT_IFNOT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
+			goto fused_ifnot;
+
+		case OP_GT_IFNOT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
+fused_ifnot:
+			// the IFNOT testing the result, its jump offset is relative to itself
+			st = NextFusedStatement();
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + st->b->value.jumpOffset );
+			}
+			break;
+
+		case OP_PUSH_F_PUSH_F:
+			var_a = GetVariable( st->a );
+			Push( *var_a.intPtr );
+			st = NextFusedStatement();
+			var_a = GetVariable( st->a );
+			Push( *var_a.intPtr );
+			break;
+
+		case OP_PUSH_F_EVENTCALL:
+			var_a = GetVariable( st->a );
+			Push( *var_a.intPtr );
+			// a multi frame event repeats the EVENTCALL statement only
+			st = NextFusedStatement();
+			CallEvent( st->a->value.functionPtr, st->b->value.argSize );
+			break;
+
+		case OP_PUSH_ENT_EVENTCALL:
+			var_a = GetVariable( st->a );
+			Push( *var_a.entityNumberPtr );
+			st = NextFusedStatement();
+			CallEvent( st->a->value.functionPtr, st->b->value.argSize );
+			break;
+
+		case OP_PUSH_F_SYSCALL:
+			var_a = GetVariable( st->a );
+			Push( *var_a.intPtr );
+			st = NextFusedStatement();
+			CallSysEvent( st->a->value.functionPtr, st->b->value.argSize );
+			break;
+
 		case OP_BREAK:
 		case OP_CONTINUE:
 		default:
@@ -1946,6 +2140,9 @@ bool idInterpreter::Execute( void ) {
 	}
 #endif
 
+	ProfileCharge();
+	profiling = false;
+
 	return threadDying;
 }
 
@@ -53,6 +53,14 @@ private:
 
 	idThread			*thread;
 
+	// g_scriptProfile, see idScriptProfiler
+	bool				profiling;				// set while Execute runs with the profiler active
+	double				profileTicks;			// the clock ticks charged up to
+	int					profileInstructions;	// the instructions charged up to
+	double				profileTime;			// the clock ticks charged since the thread started
+	double				profileEnterTime[ MAX_STACK_DEPTH ];	// profileTime when the functions on the call stack were entered, -1 if not profiled
+	int					numInstructions;		// executed since the thread started
+
 #ifdef PROFILE_SCRIPT
 	typedef std::stack<idTimer> TimerStack;
 	TimerStack			functionTimers;
@@ -69,11 +77,16 @@ private:
 	idEntity			*GetEntity( int entnum ) const;
 	idScriptObject		*GetScriptObject( int entnum ) const;
 	void				NextInstruction( int position );
+	statement_t			*NextFusedStatement( void );
 
 	void				LeaveFunction( idVarDef *returnDef );
 	void				CallEvent( const function_t *func, int argsize );
 	void				CallSysEvent( const function_t *func, int argsize );
 
+	void				ProfileCharge( void );
+	void				ProfileEvent( const function_t *func );
+	void				ProfileSkip( void );
+
 public:
 	bool				doneProcessing;
 	bool				threadDying;
@@ -127,6 +140,9 @@ public:
 	const function_t	*GetCurrentFunction( void ) const;
 	idThread			*GetThread( void ) const;
 
+	double				GetProfileTime( void ) const;		// msecs charged by g_scriptProfile
+	int					GetNumInstructions( void ) const;
+
 };
 
 /*
@@ -281,4 +297,16 @@ ID_INLINE void idInterpreter::NextInstruction( int position ) {
 	instructionPointer = position - 1;
 }
 
+/*
+====================
+idInterpreter::NextFusedStatement
+
+Moves to the second statement of a superinstruction
+====================
+*/
+ID_INLINE statement_t *idInterpreter::NextFusedStatement( void ) {
+	numInstructions++;
+	return &gameLocal.program.GetStatement( ++instructionPointer );
+}
+
 #endif /* !__SCRIPT_INTERPRETER_H__ */
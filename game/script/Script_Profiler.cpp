@@ -0,0 +1,228 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+
+#include "precompiled_game.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "Script_Profiler.h"
+
+idScriptProfiler scriptProfiler;
+
+/*
+================
+idScriptProfiler::idScriptProfiler
+================
+*/
+idScriptProfiler::idScriptProfiler( void ) {
+	firstFrame = -1;
+}
+
+/*
+================
+idScriptProfiler::Clear
+================
+*/
+void idScriptProfiler::Clear( void ) {
+	entries.Clear();
+	firstFrame = -1;
+}
+
+/*
+================
+idScriptProfiler::IsActive
+================
+*/
+bool idScriptProfiler::IsActive( void ) const {
+	return g_scriptProfile.GetBool();
+}
+
+/*
+================
+idScriptProfiler::TicksToMsec
+================
+*/
+double idScriptProfiler::TicksToMsec( double ticks ) {
+	return ticks / ( idLib::sys->ClockTicksPerSecond() * 0.001 );
+}
+
+/*
+================
+idScriptProfiler::GetEntry
+================
+*/
+idScriptProfiler::scriptProfileEntry_t &idScriptProfiler::GetEntry( const function_t *func ) {
+	int index = gameLocal.program.GetFunctionIndex( func );
+
+	if ( index >= entries.Num() ) {
+		scriptProfileEntry_t empty;
+		memset( &empty, 0, sizeof( empty ) );
+		entries.AssureSize( index + 1, empty );
+	}
+
+	scriptProfileEntry_t &entry = entries[index];
+	entry.func = func;
+	return entry;
+}
+
+/*
+================
+idScriptProfiler::AddCall
+================
+*/
+void idScriptProfiler::AddCall( const function_t *func ) {
+	if ( firstFrame < 0 ) {
+		firstFrame = gameLocal.framenum;
+	}
+	GetEntry( func ).calls++;
+}
+
+/*
+================
+idScriptProfiler::AddSelfTime
+================
+*/
+void idScriptProfiler::AddSelfTime( const function_t *func, double ticks, int instructions ) {
+	scriptProfileEntry_t &entry = GetEntry( func );
+	entry.selfTicks += ticks;
+	entry.instructions += instructions;
+}
+
+/*
+================
+idScriptProfiler::AddInclusiveTime
+================
+*/
+void idScriptProfiler::AddInclusiveTime( const function_t *func, double ticks ) {
+	GetEntry( func ).inclusiveTicks += ticks;
+}
+
+/*
+================
+idScriptProfiler::AddEventTime
+================
+*/
+void idScriptProfiler::AddEventTime( const function_t *func, double ticks ) {
+	if ( firstFrame < 0 ) {
+		firstFrame = gameLocal.framenum;
+	}
+
+	scriptProfileEntry_t &entry = GetEntry( func );
+	entry.calls++;
+	entry.selfTicks += ticks;
+	entry.inclusiveTicks += ticks;
+}
+
+/*
+================
+idScriptProfiler::SortBySelfTime
+================
+*/
+int idScriptProfiler::SortBySelfTime( const scriptProfileEntry_t * const *a, const scriptProfileEntry_t * const *b ) {
+	if ( (*a)->selfTicks > (*b)->selfTicks ) {
+		return -1;
+	}
+	if ( (*a)->selfTicks < (*b)->selfTicks ) {
+		return 1;
+	}
+	return 0;
+}
+
+/*
+================
+idScriptProfiler::SortByInclusiveTime
+================
+*/
+int idScriptProfiler::SortByInclusiveTime( const scriptProfileEntry_t * const *a, const scriptProfileEntry_t * const *b ) {
+	if ( (*a)->inclusiveTicks > (*b)->inclusiveTicks ) {
+		return -1;
+	}
+	if ( (*a)->inclusiveTicks < (*b)->inclusiveTicks ) {
+		return 1;
+	}
+	return 0;
+}
+
+/*
+================
+idScriptProfiler::SortByCalls
+================
+*/
+int idScriptProfiler::SortByCalls( const scriptProfileEntry_t * const *a, const scriptProfileEntry_t * const *b ) {
+	return (*b)->calls - (*a)->calls;
+}
+
+/*
+================
+idScriptProfiler::SortByInstructions
+================
+*/
+int idScriptProfiler::SortByInstructions( const scriptProfileEntry_t * const *a, const scriptProfileEntry_t * const *b ) {
+	return (*b)->instructions - (*a)->instructions;
+}
+
+/*
+================
+idScriptProfiler::Print
+================
+*/
+void idScriptProfiler::Print( scriptProfileSort_t sortBy, int numShown ) const {
+	int i;
+	idList<const scriptProfileEntry_t *> sorted;
+	double selfTicks = 0.0;
+	double eventTicks = 0.0;
+	int instructions = 0;
+
+	for ( i = 0; i < entries.Num(); i++ ) {
+		if ( entries[i].func == NULL ) {
+			continue;
+		}
+		sorted.Append( &entries[i] );
+
+		if ( entries[i].func->eventdef ) {
+			eventTicks += entries[i].selfTicks;
+		} else {
+			selfTicks += entries[i].selfTicks;
+			instructions += entries[i].instructions;
+		}
+	}
+
+	switch( sortBy ) {
+		case SCRIPT_PROFILE_SORT_INCLUSIVE:		sorted.Sort( SortByInclusiveTime ); break;
+		case SCRIPT_PROFILE_SORT_CALLS:			sorted.Sort( SortByCalls ); break;
+		case SCRIPT_PROFILE_SORT_INSTRUCTIONS:	sorted.Sort( SortByInstructions ); break;
+		default:								sorted.Sort( SortBySelfTime ); break;
+	}
+
+	int numFrames = ( firstFrame >= 0 ) ? Max( gameLocal.framenum - firstFrame, 1 ) : 1;
+
+	gameLocal.Printf( "------------ Script Profile ------------\n" );
+	gameLocal.Printf( "%8s %10s %9s %9s %9s  %-5s %s\n", "calls", "instr", "self msec", "msec", "self/frm", "type", "name" );
+	for ( i = 0; i < sorted.Num() && i < numShown; i++ ) {
+		const scriptProfileEntry_t &entry = *sorted[i];
+		const function_t *func = entry.func;
+
+		gameLocal.Printf( "%8d %10d %9.2f %9.2f %9.4f  %-5s %s\n", entry.calls, entry.instructions, TicksToMsec( entry.selfTicks ),
+			TicksToMsec( entry.inclusiveTicks ), TicksToMsec( entry.selfTicks ) / numFrames, func->eventdef ? "event" : "func", func->Name() );
+	}
+	gameLocal.Printf( "%d frames: %.2f msec in script functions (%.4f per frame, %d instructions), %.2f msec in script events (%.4f per frame)\n",
+		numFrames, TicksToMsec( selfTicks ), TicksToMsec( selfTicks ) / numFrames, instructions, TicksToMsec( eventTicks ), TicksToMsec( eventTicks ) / numFrames );
+}
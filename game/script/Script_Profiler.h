@@ -0,0 +1,88 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+
+#ifndef __SCRIPT_PROFILER_H__
+#define __SCRIPT_PROFILER_H__
+
+/*
+===============================================================================
+
+	Script profiler
+
+	With g_scriptProfile set, the interpreters charge the wall time and the
+	instructions they execute to the script function running them, and the
+	time spent in the engine to the script event called. The time of a
+	function excluding the functions and events it calls is its self time,
+	the time including them its inclusive time, which counts a recursive
+	function once per call on the stack. Threads waiting aren't charged.
+
+	scriptProfile prints the functions and events sorted by self time and
+	listThreads the time each running thread has been charged.
+
+===============================================================================
+*/
+
+typedef enum {
+	SCRIPT_PROFILE_SORT_SELF,
+	SCRIPT_PROFILE_SORT_INCLUSIVE,
+	SCRIPT_PROFILE_SORT_CALLS,
+	SCRIPT_PROFILE_SORT_INSTRUCTIONS
+} scriptProfileSort_t;
+
+class idScriptProfiler {
+public:
+							idScriptProfiler( void );
+
+	void					Clear( void );
+	bool					IsActive( void ) const;
+
+							// called by idInterpreter, the times are in clock ticks
+	void					AddCall( const function_t *func );
+	void					AddSelfTime( const function_t *func, double ticks, int instructions );
+	void					AddInclusiveTime( const function_t *func, double ticks );
+	void					AddEventTime( const function_t *func, double ticks );
+
+	void					Print( scriptProfileSort_t sortBy, int numShown ) const;
+
+	static double			TicksToMsec( double ticks );
+
+private:
+	typedef struct scriptProfileEntry_s {
+		const function_t *	func;				// NULL if the function wasn't called
+		int					calls;
+		int					instructions;
+		double				selfTicks;
+		double				inclusiveTicks;
+	} scriptProfileEntry_t;
+
+	idList<scriptProfileEntry_t> entries;		// indexed by function number
+	int						firstFrame;			// the game frame of the first call, -1 before
+
+	scriptProfileEntry_t &	GetEntry( const function_t *func );
+
+	static int				SortBySelfTime( const scriptProfileEntry_t * const *a, const scriptProfileEntry_t * const *b );
+	static int				SortByInclusiveTime( const scriptProfileEntry_t * const *a, const scriptProfileEntry_t * const *b );
+	static int				SortByCalls( const scriptProfileEntry_t * const *a, const scriptProfileEntry_t * const *b );
+	static int				SortByInstructions( const scriptProfileEntry_t * const *a, const scriptProfileEntry_t * const *b );
+};
+
+extern idScriptProfiler		scriptProfiler;
+
+#endif /* !__SCRIPT_PROFILER_H__ */
@@ -1749,7 +1749,14 @@ void idProgram::CompileStats( void ) {
 
 	gameLocal.Printf( "\nMemory usage:\n" );
 	gameLocal.Printf( "     Strings: %d, %d bytes\n", fileList.Num(), stringspace );
-	gameLocal.Printf( "  Statements: %d, %d bytes\n", statements.Num(), statements.MemoryUsed() );
+	int numFused = 0;
+	for( i = 0; i < statements.Num(); i++ ) {
+		if ( statements[ i ].op != UnfusedOpcode( statements[ i ].op ) ) {
+			numFused++;
+		}
+	}
+
+	gameLocal.Printf( "  Statements: %d, %d bytes, %d fused\n", statements.Num(), statements.MemoryUsed(), numFused );
 	gameLocal.Printf( "   Functions: %d, %d bytes\n", functions.Num(), funcMem );
 	gameLocal.Printf( "   Variables: %d bytes\n", numVariables );
 	gameLocal.Printf( "    Mem used: %d bytes\n", memused );
@@ -1758,12 +1765,103 @@ void idProgram::CompileStats( void ) {
 	gameLocal.Printf( " Thread size: %d bytes\n\n", sizeof( idThread ) );
 }
 
+/*
+================
+idProgram::FuseStatements
+
+Replaces the opcode of common statement pairs with a superinstruction executing both
+statements in one dispatch: comparisons followed by the IFNOT of a condition, and the
+pushes of event arguments.  The second statement of a pair is left as it is, so jumps
+to it and multi frame events repeating it still work.
+================
+*/
+void idProgram::FuseStatements( int firstStatement ) {
+	int i;
+
+	if ( !g_fuseScript.GetBool() ) {
+		return;
+	}
+
+	for( i = firstStatement; i < statements.Num() - 1; i++ ) {
+		statement_t &st = statements[ i ];
+		const statement_t &next = statements[ i + 1 ];
+		int fused = -1;
+
+		switch( st.op ) {
+		case OP_EQ_F:
+		case OP_NE_F:
+		case OP_LE:
+		case OP_GE:
+		case OP_LT:
+		case OP_GT:
+			// only when the IFNOT tests the result of the comparison
+			if ( next.op == OP_IFNOT && next.a == st.c ) {
+				switch( st.op ) {
+				case OP_EQ_F:	fused = OP_EQ_F_IFNOT; break;
+				case OP_NE_F:	fused = OP_NE_F_IFNOT; break;
+				case OP_LE:		fused = OP_LE_IFNOT; break;
+				case OP_GE:		fused = OP_GE_IFNOT; break;
+				case OP_LT:		fused = OP_LT_IFNOT; break;
+				default:		fused = OP_GT_IFNOT; break;
+				}
+			}
+			break;
+
+		case OP_PUSH_F:
+			if ( next.op == OP_PUSH_F ) {
+				fused = OP_PUSH_F_PUSH_F;
+			} else if ( next.op == OP_EVENTCALL ) {
+				fused = OP_PUSH_F_EVENTCALL;
+			} else if ( next.op == OP_SYSCALL ) {
+				fused = OP_PUSH_F_SYSCALL;
+			}
+			break;
+
+		case OP_PUSH_ENT:
+			if ( next.op == OP_EVENTCALL ) {
+				fused = OP_PUSH_ENT_EVENTCALL;
+			}
+			break;
+		}
+
+		if ( fused >= 0 ) {
+			st.op = fused;
+			// the next statement is executed by this one
+			i++;
+		}
+	}
+}
+
+/*
+================
+idProgram::UnfusedOpcode
+
+The opcode of the first statement of a superinstruction
+================
+*/
+int idProgram::UnfusedOpcode( int op ) {
+	switch( op ) {
+	case OP_EQ_F_IFNOT:			return OP_EQ_F;
+	case OP_NE_F_IFNOT:			return OP_NE_F;
+	case OP_LE_IFNOT:			return OP_LE;
+	case OP_GE_IFNOT:			return OP_GE;
+	case OP_LT_IFNOT:			return OP_LT;
+	case OP_GT_IFNOT:			return OP_GT;
+	case OP_PUSH_F_PUSH_F:
+	case OP_PUSH_F_EVENTCALL:
+	case OP_PUSH_F_SYSCALL:		return OP_PUSH_F;
+	case OP_PUSH_ENT_EVENTCALL:	return OP_PUSH_ENT;
+	default:					return op;
+	}
+}
+
 /*
 ================
 idProgram::CompileText
 ================
 */
 bool idProgram::CompileText( const char *source, const char *text, bool console ) {
+	idScopedMemTag memTag( MEMTAG_SCRIPT );
 	idCompiler	compiler;
 	int			i;
 	idVarDef	*def;
@@ -1773,6 +1871,8 @@ bool idProgram::CompileText( const char *source, const char *text, bool console
 	ospath = fileSystem->RelativePathToOSPath( source, "fs_savepath", "" );
 	filenum = GetFilenum( ospath );
 
+	int firstStatement = statements.Num();
+
 	try {
 		compiler.CompileFile( text, filename, console );
 
@@ -1796,6 +1896,9 @@ bool idProgram::CompileText( const char *source, const char *text, bool console
 		}
 	};
 
+	// the jump offsets of the new statements are all set now
+	FuseStatements( firstStatement );
+
 	if ( !console ) {
 		CompileStats();
 	}
@@ -1858,6 +1961,8 @@ idProgram::FreeData
 void idProgram::FreeData( void ) {
 	int i;
 
+	scriptProfiler.Clear();
+
 	// free the defs
 	varDefs.DeleteContents( true );
 	varDefNames.DeleteContents( true );
@@ -1954,6 +2059,734 @@ void idProgram::RegisterScriptEvents()
 	}
 }
 
+/***********************************************************************
+
+  Program cache
+
+  The program compiled from the default script is written to
+  script/<name>.cache, so the next startup and every reloadScript with
+  unchanged scripts can load it instead of compiling the scripts again.
+  The pointers between the types, defs, functions and statements are
+  stored as indices, the constants as offsets into the global variables.
+
+  The cache is validated against the CRCs of all files in the script
+  folder and the compiled files outside of it, the registered script
+  events and the compiler settings changing the statements.
+
+***********************************************************************/
+
+#define SCRIPT_CACHE_EXTENSION		"cache"
+#define SCRIPT_CACHE_MAGIC			( ( 'S' << 24 ) | ( 'C' << 16 ) | ( 'R' << 8 ) | 'C' )
+#define SCRIPT_CACHE_VERSION		1
+
+// how the value of a def is stored
+typedef enum {
+	SCRIPT_CACHE_VALUE_INT,				// offset, jump, argument size or virtual function number
+	SCRIPT_CACHE_VALUE_VARIABLE,		// pointer into the global variables
+	SCRIPT_CACHE_VALUE_FUNCTION			// function pointer
+} scriptCacheValue_t;
+
+// the builtin types and defs are referenced as -2 - their index in these tables
+static idTypeDef * const scriptCacheTypes[] = {
+	&type_void, &type_scriptevent, &type_namespace, &type_string, &type_float, &type_vector, &type_entity, &type_field,
+	&type_function, &type_virtualfunction, &type_pointer, &type_object, &type_jumpoffset, &type_argsize, &type_boolean
+};
+static idVarDef * const scriptCacheDefs[] = {
+	&def_void, &def_scriptevent, &def_namespace, &def_string, &def_float, &def_vector, &def_entity, &def_field,
+	&def_function, &def_virtualfunction, &def_pointer, &def_object, &def_jumpoffset, &def_argsize, &def_boolean
+};
+static const int NUM_SCRIPT_CACHE_BUILTINS = sizeof( scriptCacheTypes ) / sizeof( scriptCacheTypes[0] );
+
+/*
+================
+ScriptCachePointerKey
+================
+*/
+static int ScriptCachePointerKey( const void *ptr ) {
+	return static_cast<int>( reinterpret_cast<intptr_t>( ptr ) >> 3 );
+}
+
+/*
+================
+idProgram::CacheChecksum
+
+The checksum of everything besides the script files the compiled program depends on
+================
+*/
+unsigned int idProgram::CacheChecksum( void ) {
+	unsigned long crc;
+	int i, value;
+
+	CRC32_InitChecksum( crc );
+
+	value = sizeof( void * );
+	CRC32_UpdateChecksum( crc, &value, sizeof( value ) );
+	value = NUM_OPCODES;
+	CRC32_UpdateChecksum( crc, &value, sizeof( value ) );
+	value = g_fuseScript.GetBool() ? 1 : 0;
+	CRC32_UpdateChecksum( crc, &value, sizeof( value ) );
+
+	// the script events registered by RegisterScriptEvents
+	int numEvents = idEventDef::NumEventCommands();
+	CRC32_UpdateChecksum( crc, &numEvents, sizeof( numEvents ) );
+	for ( i = 0; i < numEvents; i++ ) {
+		const idEventDef *eventDef = idEventDef::GetEventCommand( i );
+		const char *name = eventDef->GetName();
+		const char *format = eventDef->GetArgFormat();
+		char returnType = eventDef->GetReturnType();
+
+		CRC32_UpdateChecksum( crc, name, strlen( name ) + 1 );
+		CRC32_UpdateChecksum( crc, format, strlen( format ) + 1 );
+		CRC32_UpdateChecksum( crc, &returnType, sizeof( returnType ) );
+	}
+
+	CRC32_FinishChecksum( crc );
+
+	return static_cast<unsigned int>( crc );
+}
+
+/*
+================
+idProgram::CacheFileChecksum
+
+Returns false if the file can't be read
+================
+*/
+bool idProgram::CacheFileChecksum( const char *filename, unsigned int &checksum ) {
+	void *buffer;
+
+	int length = fileSystem->ReadFile( filename, &buffer, NULL );
+	if ( length < 0 ) {
+		return false;
+	}
+
+	checksum = static_cast<unsigned int>( CRC32_BlockChecksum( buffer, length ) );
+	fileSystem->FreeFile( buffer );
+
+	return true;
+}
+
+/*
+================
+idProgram::WriteCache
+================
+*/
+void idProgram::WriteCache( const char *defaultScript ) const {
+	int i, j;
+	idStr cacheName;
+	idStrList dependencies;
+	idHashIndex typeHash;
+
+	// the script folder includes the files only containing defines, which are never added to fileList
+	idFileList *scriptFiles = fileSystem->ListFilesTree( "script", ".script", true );
+	dependencies = scriptFiles->GetList();
+	fileSystem->FreeFileList( scriptFiles );
+	for ( i = 0; i < fileList.Num(); i++ ) {
+		dependencies.AddUnique( fileList[i] );
+	}
+
+	for ( i = 0; i < types.Num(); i++ ) {
+		typeHash.Add( ScriptCachePointerKey( types[i] ), i );
+	}
+
+	idFile_Memory file( "scriptcache" );
+	bool valid = true;
+
+	// type and def references
+	#define WRITE_TYPE( t )		file.WriteInt( CacheTypeRef( t, typeHash, valid ) )
+	#define WRITE_DEF( d )		file.WriteInt( CacheDefRef( d, valid ) )
+
+	file.WriteInt( SCRIPT_CACHE_MAGIC );
+	file.WriteInt( SCRIPT_CACHE_VERSION );
+	file.WriteUnsignedInt( CacheChecksum() );
+	file.WriteString( defaultScript );
+
+	file.WriteInt( dependencies.Num() );
+	for ( i = 0; i < dependencies.Num(); i++ ) {
+		unsigned int checksum;
+		if ( !CacheFileChecksum( dependencies[i], checksum ) ) {
+			gameLocal.Warning( "Couldn't read %s for the script cache", dependencies[i].c_str() );
+			return;
+		}
+		file.WriteString( dependencies[i] );
+		file.WriteUnsignedInt( checksum );
+	}
+
+	file.WriteInt( fileList.Num() );
+	for ( i = 0; i < fileList.Num(); i++ ) {
+		file.WriteString( fileList[i] );
+	}
+
+	file.WriteInt( numVariables );
+	file.Write( variables, numVariables );
+
+	file.WriteInt( types.Num() );
+	file.WriteInt( varDefs.Num() );
+	file.WriteInt( functions.Num() );
+
+	for ( i = 0; i < types.Num(); i++ ) {
+		const idTypeDef *type = types[i];
+
+		file.WriteInt( type->type );
+		file.WriteString( type->name );
+		file.WriteInt( type->size );
+		WRITE_TYPE( type->auxType );
+		WRITE_DEF( type->def );
+
+		file.WriteInt( type->parmTypes.Num() );
+		for ( j = 0; j < type->parmTypes.Num(); j++ ) {
+			WRITE_TYPE( type->parmTypes[j] );
+			file.WriteString( type->parmNames[j] );
+		}
+
+		file.WriteInt( type->functions.Num() );
+		for ( j = 0; j < type->functions.Num(); j++ ) {
+			file.WriteInt( CacheFunctionRef( type->functions[j], valid ) );
+		}
+	}
+
+	for ( i = 0; i < varDefs.Num(); i++ ) {
+		const idVarDef *def = varDefs[i];
+
+		WRITE_TYPE( def->TypeDef() );
+		WRITE_DEF( def->scope );
+		file.WriteInt( def->numUsers );
+		file.WriteInt( def->initialized );
+
+		int kind = CacheValueKind( def );
+		file.WriteInt( kind );
+
+		switch( kind ) {
+		case SCRIPT_CACHE_VALUE_VARIABLE:
+			if ( def->value.bytePtr == NULL ) {
+				file.WriteInt( -1 );
+			} else if ( def->value.bytePtr >= variables && def->value.bytePtr <= variables + numVariables ) {
+				file.WriteInt( def->value.bytePtr - variables );
+			} else {
+				valid = false;
+			}
+			break;
+
+		case SCRIPT_CACHE_VALUE_FUNCTION:
+			file.WriteInt( CacheFunctionRef( def->value.functionPtr, valid ) );
+			break;
+
+		default:
+			file.WriteInt( def->value.ptrOffset );
+			break;
+		}
+	}
+
+	// the defs with the same name, from the last one defined to the first
+	file.WriteInt( varDefNames.Num() );
+	for ( i = 0; i < varDefNames.Num(); i++ ) {
+		const idVarDef *def;
+		int numDefs = 0;
+
+		for ( def = varDefNames[i]->GetDefs(); def != NULL; def = def->Next() ) {
+			numDefs++;
+		}
+
+		file.WriteString( varDefNames[i]->Name() );
+		file.WriteInt( numDefs );
+		for ( def = varDefNames[i]->GetDefs(); def != NULL; def = def->Next() ) {
+			WRITE_DEF( def );
+		}
+	}
+
+	for ( i = 0; i < functions.Num(); i++ ) {
+		const function_t &func = functions[i];
+
+		file.WriteString( func.Name() );
+		file.WriteString( func.eventdef ? func.eventdef->GetName() : "" );
+		WRITE_DEF( func.def );
+		WRITE_TYPE( func.type );
+		file.WriteInt( func.firstStatement );
+		file.WriteInt( func.numStatements );
+		file.WriteInt( func.parmTotal );
+		file.WriteInt( func.locals );
+		file.WriteInt( func.filenum );
+
+		file.WriteInt( func.parmSize.Num() );
+		for ( j = 0; j < func.parmSize.Num(); j++ ) {
+			file.WriteInt( func.parmSize[j] );
+		}
+	}
+
+	file.WriteInt( statements.Num() );
+	for ( i = 0; i < statements.Num(); i++ ) {
+		const statement_t &statement = statements[i];
+
+		file.WriteUnsignedShort( statement.op );
+		WRITE_DEF( statement.a );
+		WRITE_DEF( statement.b );
+		WRITE_DEF( statement.c );
+		file.WriteUnsignedShort( statement.linenumber );
+		file.WriteUnsignedShort( statement.file );
+	}
+
+	WRITE_DEF( sysDef );
+	WRITE_DEF( returnDef );
+	WRITE_DEF( returnStringDef );
+
+	file.WriteInt( SCRIPT_CACHE_MAGIC );
+
+	#undef WRITE_TYPE
+	#undef WRITE_DEF
+
+	if ( !valid ) {
+		gameLocal.Warning( "The compiled script program can't be cached" );
+		return;
+	}
+
+	cacheName = defaultScript;
+	cacheName.SetFileExtension( SCRIPT_CACHE_EXTENSION );
+
+	idFile *cacheFile = fileSystem->OpenFileWrite( cacheName );
+	if ( cacheFile == NULL ) {
+		gameLocal.Warning( "Couldn't write %s", cacheName.c_str() );
+		return;
+	}
+	cacheFile->Write( file.GetDataPtr(), file.Length() );
+	fileSystem->CloseFile( cacheFile );
+}
+
+/*
+================
+idProgram::ReadCache
+
+Replaces the program with the cached program of the default script,
+returns false and leaves the program empty if the cache is missing or out of date.
+================
+*/
+bool idProgram::ReadCache( const char *defaultScript ) {
+	idStr cacheName;
+	void *buffer;
+
+	cacheName = defaultScript;
+	cacheName.SetFileExtension( SCRIPT_CACHE_EXTENSION );
+
+	int length = fileSystem->ReadFile( cacheName, &buffer, NULL );
+	if ( length < 0 ) {
+		return false;
+	}
+
+	idTimer timer;
+	timer.Start();
+
+	FreeData();
+
+	idFile_Memory file( cacheName, static_cast<const char *>( buffer ), length );
+	bool valid = ReadCacheData( file, defaultScript );
+
+	fileSystem->FreeFile( buffer );
+
+	if ( !valid ) {
+		FreeData();
+		gameLocal.Printf( "%s is out of date\n", cacheName.c_str() );
+		return false;
+	}
+
+	timer.Stop();
+	gameLocal.Printf( "Loaded %d functions and %d statements from %s in %.1f msec\n", functions.Num(), statements.Num(), cacheName.c_str(), timer.Milliseconds() );
+
+	return true;
+}
+
+/*
+================
+idProgram::ReadCacheData
+
+All references are checked, so a truncated or damaged cache can't crash the game
+================
+*/
+bool idProgram::ReadCacheData( idFile &file, const char *defaultScript ) {
+	int i, j, num, value;
+	int numTypes, numDefs, numFunctions;
+	unsigned int checksum;
+	idStr str;
+
+	#define READ_INT( v )			if ( file.ReadInt( v ) != sizeof( int ) ) { return false; }
+	#define READ_COUNT( v, max )	READ_INT( v ); if ( v < 0 || v > ( max ) ) { return false; }
+	#define READ_TYPE( t )			READ_INT( value ); if ( !CacheTypeFromRef( value, t ) ) { return false; }
+	#define READ_DEF( d )			READ_INT( value ); if ( !CacheDefFromRef( value, d ) ) { return false; }
+	#define READ_FUNCTION( f )		READ_INT( value ); if ( value < -1 || value >= numFunctions ) { return false; } f = ( value >= 0 ) ? &functions[ value ] : NULL
+
+	READ_INT( value );
+	if ( value != SCRIPT_CACHE_MAGIC ) {
+		return false;
+	}
+	READ_INT( value );
+	if ( value != SCRIPT_CACHE_VERSION ) {
+		return false;
+	}
+	file.ReadUnsignedInt( checksum );
+	if ( checksum != CacheChecksum() ) {
+		return false;
+	}
+	file.ReadString( str );
+	if ( str.Icmp( defaultScript ) != 0 ) {
+		return false;
+	}
+
+	READ_COUNT( num, file.Length() );
+	for ( i = 0; i < num; i++ ) {
+		unsigned int fileChecksum;
+
+		file.ReadString( str );
+		file.ReadUnsignedInt( checksum );
+		if ( !CacheFileChecksum( str, fileChecksum ) || fileChecksum != checksum ) {
+			return false;
+		}
+	}
+
+	READ_COUNT( num, file.Length() );
+	for ( i = 0; i < num; i++ ) {
+		file.ReadString( str );
+		fileList.Append( str );
+	}
+
+	READ_COUNT( num, MAX_GLOBALS );
+	numVariables = num;
+	if ( file.Read( variables, num ) != num ) {
+		return false;
+	}
+
+	// allocate everything first, the types, defs and functions reference each other
+	READ_COUNT( numTypes, file.Length() );
+	READ_COUNT( numDefs, file.Length() );
+	READ_COUNT( numFunctions, MAX_FUNCS );
+
+	types.SetNum( numTypes );
+	for ( i = 0; i < numTypes; i++ ) {
+		types[i] = new idTypeDef( ev_void, NULL, "", 0, NULL );
+	}
+
+	varDefs.SetNum( numDefs );
+	for ( i = 0; i < numDefs; i++ ) {
+		varDefs[i] = new idVarDef();
+		varDefs[i]->num = i;
+	}
+
+	functions.SetNum( numFunctions );
+	for ( i = 0; i < numFunctions; i++ ) {
+		functions[i].Clear();
+	}
+
+	for ( i = 0; i < numTypes; i++ ) {
+		idTypeDef *type = types[i];
+		idTypeDef *parmType;
+		const function_t *func;
+
+		READ_INT( value );
+		type->type = static_cast<etype_t>( value );
+		file.ReadString( type->name );
+		READ_INT( type->size );
+		READ_TYPE( type->auxType );
+		READ_DEF( type->def );
+
+		READ_COUNT( num, file.Length() );
+		type->parmTypes.SetNum( num );
+		type->parmNames.SetNum( num );
+		for ( j = 0; j < num; j++ ) {
+			READ_TYPE( parmType );
+			type->parmTypes[j] = parmType;
+			file.ReadString( type->parmNames[j] );
+		}
+
+		READ_COUNT( num, numFunctions );
+		type->functions.SetNum( num );
+		for ( j = 0; j < num; j++ ) {
+			READ_FUNCTION( func );
+			type->functions[j] = func;
+		}
+	}
+
+	for ( i = 0; i < numDefs; i++ ) {
+		idVarDef *def = varDefs[i];
+		idTypeDef *type;
+
+		READ_TYPE( type );
+		def->SetTypeDef( type );
+		READ_DEF( def->scope );
+		READ_INT( def->numUsers );
+		READ_INT( value );
+		def->initialized = static_cast<idVarDef::initialized_t>( value );
+
+		READ_INT( value );
+		switch( value ) {
+		case SCRIPT_CACHE_VALUE_VARIABLE:
+			READ_INT( value );
+			if ( value < -1 || value > static_cast<int>( numVariables ) ) {
+				return false;
+			}
+			def->value.bytePtr = ( value >= 0 ) ? &variables[ value ] : NULL;
+			break;
+
+		case SCRIPT_CACHE_VALUE_FUNCTION:
+			READ_FUNCTION( def->value.functionPtr );
+			break;
+
+		case SCRIPT_CACHE_VALUE_INT:
+			READ_INT( def->value.ptrOffset );
+			break;
+
+		default:
+			return false;
+		}
+	}
+
+	// every def has to end up in exactly one name list, the destructor removes it from there
+	idList<bool> named;
+	idList<idVarDef *> defs;
+	int numNamed = 0;
+
+	named.AssureSize( numDefs, false );
+
+	READ_COUNT( num, file.Length() );
+	for ( i = 0; i < num; i++ ) {
+		int numNameDefs;
+
+		file.ReadString( str );
+		READ_COUNT( numNameDefs, numDefs - numNamed );
+		defs.SetNum( numNameDefs, false );
+		for ( j = 0; j < numNameDefs; j++ ) {
+			READ_DEF( defs[j] );
+			if ( defs[j] == NULL || defs[j]->num < 0 || defs[j]->num >= numDefs || varDefs[ defs[j]->num ] != defs[j] || named[ defs[j]->num ] ) {
+				return false;
+			}
+			named[ defs[j]->num ] = true;
+		}
+		numNamed += numNameDefs;
+
+		idVarDefName *name = new idVarDefName( str );
+		varDefNameHash.Add( varDefNameHash.GenerateKey( str, true ), varDefNames.Append( name ) );
+
+		// AddDef puts the def in front of the list
+		for ( j = numNameDefs - 1; j >= 0; j-- ) {
+			name->AddDef( defs[j] );
+		}
+	}
+
+	if ( numNamed != numDefs ) {
+		return false;
+	}
+
+	for ( i = 0; i < numFunctions; i++ ) {
+		function_t &func = functions[i];
+		idTypeDef *type;
+
+		file.ReadString( str );
+		func.SetName( str );
+		file.ReadString( str );
+		if ( str.Length() ) {
+			func.eventdef = idEventDef::FindEvent( str );
+			if ( func.eventdef == NULL ) {
+				return false;
+			}
+		}
+		READ_DEF( func.def );
+		READ_TYPE( type );
+		func.type = type;
+		READ_INT( func.firstStatement );
+		READ_INT( func.numStatements );
+		READ_INT( func.parmTotal );
+		READ_INT( func.locals );
+		READ_INT( func.filenum );
+
+		READ_COUNT( num, file.Length() );
+		func.parmSize.SetGranularity( 1 );
+		func.parmSize.SetNum( num );
+		for ( j = 0; j < num; j++ ) {
+			READ_INT( func.parmSize[j] );
+		}
+	}
+
+	READ_COUNT( num, MAX_STATEMENTS );
+	statements.SetNum( num );
+	for ( i = 0; i < num; i++ ) {
+		statement_t &statement = statements[i];
+
+		file.ReadUnsignedShort( statement.op );
+		READ_DEF( statement.a );
+		READ_DEF( statement.b );
+		READ_DEF( statement.c );
+		file.ReadUnsignedShort( statement.linenumber );
+		file.ReadUnsignedShort( statement.file );
+
+		if ( statement.op >= NUM_OPCODES || statement.file >= fileList.Num() ) {
+			return false;
+		}
+	}
+
+	for ( i = 0; i < numFunctions; i++ ) {
+		const function_t &func = functions[i];
+		if ( func.firstStatement < 0 || func.numStatements < 0 || func.firstStatement + func.numStatements > statements.Num() ) {
+			return false;
+		}
+	}
+
+	READ_DEF( sysDef );
+	READ_DEF( returnDef );
+	READ_DEF( returnStringDef );
+
+	READ_INT( value );
+
+	#undef READ_INT
+	#undef READ_COUNT
+	#undef READ_TYPE
+	#undef READ_DEF
+	#undef READ_FUNCTION
+
+	return ( value == SCRIPT_CACHE_MAGIC );
+}
+
+/*
+================
+idProgram::CacheValueKind
+================
+*/
+int idProgram::CacheValueKind( const idVarDef *def ) {
+	if ( def->initialized == idVarDef::stackVariable ) {
+		return SCRIPT_CACHE_VALUE_INT;
+	}
+
+	switch( def->Type() ) {
+	case ev_function :
+		return SCRIPT_CACHE_VALUE_FUNCTION;
+
+	case ev_virtualfunction :
+	case ev_jumpoffset :
+	case ev_argsize :
+		return SCRIPT_CACHE_VALUE_INT;
+
+	default :
+		break;
+	}
+
+	// object variables are offsets into the object
+	if ( def->scope != NULL && def->scope->TypeDef()->Inherits( &type_object ) ) {
+		return SCRIPT_CACHE_VALUE_INT;
+	}
+
+	return SCRIPT_CACHE_VALUE_VARIABLE;
+}
+
+/*
+================
+idProgram::CacheTypeRef
+================
+*/
+int idProgram::CacheTypeRef( const idTypeDef *type, const idHashIndex &typeHash, bool &valid ) const {
+	int i;
+
+	if ( type == NULL ) {
+		return -1;
+	}
+
+	for ( i = 0; i < NUM_SCRIPT_CACHE_BUILTINS; i++ ) {
+		if ( type == scriptCacheTypes[i] ) {
+			return -2 - i;
+		}
+	}
+
+	for ( i = typeHash.First( ScriptCachePointerKey( type ) ); i != -1; i = typeHash.Next( i ) ) {
+		if ( types[i] == type ) {
+			return i;
+		}
+	}
+
+	valid = false;
+	return -1;
+}
+
+/*
+================
+idProgram::CacheDefRef
+================
+*/
+int idProgram::CacheDefRef( const idVarDef *def, bool &valid ) const {
+	if ( def == NULL ) {
+		return -1;
+	}
+
+	for ( int i = 0; i < NUM_SCRIPT_CACHE_BUILTINS; i++ ) {
+		if ( def == scriptCacheDefs[i] ) {
+			return -2 - i;
+		}
+	}
+
+	if ( def->num < 0 || def->num >= varDefs.Num() || varDefs[ def->num ] != def ) {
+		valid = false;
+		return -1;
+	}
+
+	return def->num;
+}
+
+/*
+================
+idProgram::CacheFunctionRef
+================
+*/
+int idProgram::CacheFunctionRef( const function_t *func, bool &valid ) const {
+	if ( func == NULL ) {
+		return -1;
+	}
+
+	int index = func - &functions[0];
+	if ( index < 0 || index >= functions.Num() || func != &functions[ index ] ) {
+		valid = false;
+		return -1;
+	}
+
+	return index;
+}
+
+/*
+================
+idProgram::CacheTypeFromRef
+================
+*/
+bool idProgram::CacheTypeFromRef( int ref, idTypeDef *&type ) const {
+	if ( ref == -1 ) {
+		type = NULL;
+	} else if ( ref < -1 ) {
+		if ( -2 - ref >= NUM_SCRIPT_CACHE_BUILTINS ) {
+			return false;
+		}
+		type = scriptCacheTypes[ -2 - ref ];
+	} else {
+		if ( ref >= types.Num() ) {
+			return false;
+		}
+		type = types[ ref ];
+	}
+	return true;
+}
+
+/*
+================
+idProgram::CacheDefFromRef
+================
+*/
+bool idProgram::CacheDefFromRef( int ref, idVarDef *&def ) const {
+	if ( ref == -1 ) {
+		def = NULL;
+	} else if ( ref < -1 ) {
+		if ( -2 - ref >= NUM_SCRIPT_CACHE_BUILTINS ) {
+			return false;
+		}
+		def = scriptCacheDefs[ -2 - ref ];
+	} else {
+		if ( ref >= varDefs.Num() ) {
+			return false;
+		}
+		def = varDefs[ ref ];
+	}
+	return true;
+}
+
 /*
 ================
 idProgram::Startup
@@ -1966,15 +2799,28 @@ void idProgram::Startup( const char *defaultScript )
 	// make sure all data is freed up
 	idThread::Restart();
 
-	// get ready for loading scripts
-	BeginCompilation();
+	bool useCache = defaultScript && *defaultScript && g_scriptCache.GetBool();
 
-	// Register all known script events
-	RegisterScriptEvents();
+	// load the program compiled from the default script, if its scripts didn't change
+	if ( useCache && ReadCache( defaultScript ) ) {
+		if ( g_disasm.GetBool() ) {
+			Disassemble();
+		}
+	} else {
+		// get ready for loading scripts
+		BeginCompilation();
+
+		// Register all known script events
+		RegisterScriptEvents();
+
+		// load the default script
+		if ( defaultScript && *defaultScript ) {
+			CompileFile( defaultScript );
 
-	// load the default script
-	if ( defaultScript && *defaultScript ) {
-		CompileFile( defaultScript );
+			if ( useCache ) {
+				WriteCache( defaultScript );
+			}
+		}
 	}
 
 	FinishCompilation();
@@ -2074,8 +2920,9 @@ int idProgram::CalculateChecksum( void ) const {
 	memset( statementList, 0, ( sizeof(statementBlock_t) * statements.Num() ) );
 
 	// Copy info into new list, using the variable numbers instead of a pointer to the variable
+	// and the original opcodes, so savegames don't depend on g_fuseScript
 	for( i = 0; i < statements.Num(); i++ ) {
-		statementList[i].op = statements[i].op;
+		statementList[i].op = UnfusedOpcode( statements[i].op );
 
 		if ( statements[i].a ) {
 			statementList[i].a = statements[i].a->num;
@@ -2115,6 +2962,7 @@ void idProgram::Restart( void ) {
 	int i;
 
 	idThread::Restart();
+	scriptProfiler.Clear();
 
 	//
 	// since there may have been a script loaded by the map or the user may
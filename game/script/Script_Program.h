@@ -80,6 +80,8 @@ Contains type information for variables and functions.
 ***********************************************************************/
 
 class idTypeDef {
+	friend class idProgram;		// reads and writes the program cache
+
 private:
 	etype_t						type;
 	idStr 						name;
@@ -448,6 +450,21 @@ private:
 
 	void										CompileStats( void );
 
+	// program cache
+	void										WriteCache( const char *defaultScript ) const;
+	bool										ReadCache( const char *defaultScript );
+	bool										ReadCacheData( idFile &file, const char *defaultScript );
+	static unsigned int							CacheChecksum( void );
+	static bool									CacheFileChecksum( const char *filename, unsigned int &checksum );
+	static int									CacheValueKind( const idVarDef *def );
+	int											CacheTypeRef( const idTypeDef *type, const idHashIndex &typeHash, bool &valid ) const;
+	int											CacheDefRef( const idVarDef *def, bool &valid ) const;
+	int											CacheFunctionRef( const function_t *func, bool &valid ) const;
+	bool										CacheTypeFromRef( int ref, idTypeDef *&type ) const;
+	bool										CacheDefFromRef( int ref, idVarDef *&def ) const;
+	void										FuseStatements( int firstStatement );
+	static int									UnfusedOpcode( int op );
+
 public:
 	idVarDef									*returnDef;
 	idVarDef									*returnStringDef;
@@ -58,6 +58,12 @@ const idEventDef EV_Thread_Assert( "assert", EventArgs('f', "condition", ""), EV
 const idEventDef EV_Thread_Trigger( "trigger", EventArgs('e', "entityToTrigger", ""), EV_RETURNS_VOID, "Triggers the given entity.");
 const idEventDef EV_Thread_SetCvar( "setcvar", EventArgs('s', "name", "", 's', "value", ""), EV_RETURNS_VOID, "Sets a cvar.");
 const idEventDef EV_Thread_GetCvar( "getcvar", EventArgs('s', "name", ""), 's', "Returns the string for a cvar.");
+const idEventDef EV_Thread_GetCvarHandle( "getcvarhandle", EventArgs('s', "name", ""), 'f', "Returns a handle for a cvar, or -1 if it doesn't exist.\n" \
+	"Reading a cvar through its handle skips the lookup by name, for scripts that read it often.");
+const idEventDef EV_Thread_GetCvarByHandle( "getcvarbyhandle", EventArgs('f', "handle", ""), 's', "Returns the string for the cvar of a handle from getcvarhandle.");
+const idEventDef EV_Thread_GetCvarFloatByHandle( "getcvarfloatbyhandle", EventArgs('f', "handle", ""), 'f', "Returns the value of the cvar of a handle from getcvarhandle as a float.");
+const idEventDef EV_Thread_GetCvarModCount( "getcvarmodcount", EventArgs('f', "handle", ""), 'f', "Returns a number that increases whenever the cvar of a handle from getcvarhandle changes.\n" \
+	"Scripts can remember it to tell whether the cvar changed since they last read it.");
 const idEventDef EV_Thread_Random( "random", EventArgs('f', "range", ""), 'f', "Returns a random value X where 0 <= X < range.");
 const idEventDef EV_Thread_GetTime( "getTime", EventArgs(), 'f', "Returns the current game time in seconds." );
 const idEventDef EV_Thread_KillThread( "killthread", EventArgs('s', "threadName", ""), EV_RETURNS_VOID, "Kills all threads with the specified name");
@@ -293,6 +299,10 @@ CLASS_DECLARATION( idClass, idThread )
 	EVENT( EV_Thread_Trigger,				idThread::Event_Trigger )
 	EVENT( EV_Thread_SetCvar,				idThread::Event_SetCvar )
 	EVENT( EV_Thread_GetCvar,				idThread::Event_GetCvar )
+	EVENT( EV_Thread_GetCvarHandle,			idThread::Event_GetCvarHandle )
+	EVENT( EV_Thread_GetCvarByHandle,		idThread::Event_GetCvarByHandle )
+	EVENT( EV_Thread_GetCvarFloatByHandle,	idThread::Event_GetCvarFloatByHandle )
+	EVENT( EV_Thread_GetCvarModCount,		idThread::Event_GetCvarModCount )
 	EVENT( EV_Thread_Random,				idThread::Event_Random )
 	EVENT( EV_Thread_GetTime,				idThread::Event_GetTime )
 	EVENT( EV_Thread_KillThread,			idThread::Event_KillThread )
@@ -407,6 +417,9 @@ CLASS_DECLARATION( idClass, idThread )
 idThread			*idThread::currentThread = NULL;
 int					idThread::threadIndex = 0;
 idList<idThread *>	idThread::threadList;
+idHashIndex			idThread::threadHash;
+idList<idThread *>	idThread::threadSlots;
+idList<int>			idThread::freeThreadSlots;
 trace_t				idThread::trace;
 
 #define VINE_TRACE_CONTENTS 1281 // grayman #2787 - CONTENTS_CORPSE|CONTENTS_BODY|CONTENTS_SOLID
@@ -537,21 +550,28 @@ idThread::~idThread
 ================
 */
 idThread::~idThread() {
-	idThread	*thread;
 	int			i;
-	int			n;
 
 	if ( g_debugScript.GetBool() ) {
 		gameLocal.Printf( "%d: end thread (%d) '%s'\n", gameLocal.time, threadNum, threadName.c_str() );
 	}
 	threadList.Remove( this );
-	n = threadList.Num();
-	for( i = 0; i < n; i++ ) {
-		thread = threadList[ i ];
-		if ( thread->WaitingOnThread() == this ) {
-			thread->ThreadCallback( this );
-		}
+	UnlinkThreadNum();
+	ClearWaitFor();
+
+	// wake the threads waiting for this one in the order they were created,
+	// ThreadCallback removes them from waitingThreads
+	idList<idThread *> waiting = waitingThreads;
+	waiting.Sort( SortByThreadNum );
+	for( i = 0; i < waiting.Num(); i++ ) {
+		waiting[ i ]->ThreadCallback( this );
+	}
+
+	// the dying threads don't clear their wait
+	for( i = 0; i < waitingThreads.Num(); i++ ) {
+		waitingThreads[ i ]->waitingForThread = NULL;
 	}
+	waitingThreads.Clear();
 
 	if ( currentThread == this ) {
 		currentThread = NULL;
@@ -599,9 +619,16 @@ idThread::Restore
 ================
 */
 void idThread::Restore( idRestoreGame *savefile ) {
-	savefile->ReadInt( threadNum );
+	int num;
 
+	savefile->ReadInt( num );
+	SetThreadNum( num );
+
+	ClearWaitFor();
 	savefile->ReadObject( reinterpret_cast<idClass *&>( waitingForThread ) );
+	if ( waitingForThread ) {
+		waitingForThread->waitingThreads.Append( this );
+	}
 	savefile->ReadInt( waitingFor );
 	savefile->ReadInt( waitingUntil );
 
@@ -632,11 +659,13 @@ void idThread::Init( void ) {
 
 	threadNum = threadIndex;
 	threadList.Append( this );
+	LinkThreadNum();
 	
 	creationTime = gameLocal.time;
 	lastExecuteTime = 0;
 	manualControl = false;
 
+	waitingForThread = NULL;
 	ClearWaitFor();
 
 	interpreter.SetThread( this );
@@ -648,21 +677,57 @@ idThread::GetThread
 ================
 */
 idThread *idThread::GetThread( int num ) {
-	int			i;
-	int			n;
-	idThread	*thread;
-
-	n = threadList.Num();
-	for( i = 0; i < n; i++ ) {
-		thread = threadList[ i ];
-		if ( thread->GetThreadNum() == num ) {
-			return thread;
+	for( int i = threadHash.First( num ); i != -1; i = threadHash.Next( i ) ) {
+		if ( threadSlots[ i ]->GetThreadNum() == num ) {
+			return threadSlots[ i ];
 		}
 	}
 
 	return NULL;
 }
 
+/*
+================
+idThread::LinkThreadNum
+================
+*/
+void idThread::LinkThreadNum( void ) {
+	if ( freeThreadSlots.Num() ) {
+		threadSlot = freeThreadSlots[ freeThreadSlots.Num() - 1 ];
+		freeThreadSlots.RemoveIndex( freeThreadSlots.Num() - 1 );
+	} else {
+		threadSlot = threadSlots.Append( NULL );
+	}
+
+	threadSlots[ threadSlot ] = this;
+	threadHash.Add( threadNum, threadSlot );
+}
+
+/*
+================
+idThread::UnlinkThreadNum
+================
+*/
+void idThread::UnlinkThreadNum( void ) {
+	if ( threadSlot < 0 ) {
+		return;
+	}
+
+	threadHash.Remove( threadNum, threadSlot );
+	threadSlots[ threadSlot ] = NULL;
+	freeThreadSlots.Append( threadSlot );
+	threadSlot = -1;
+}
+
+/*
+================
+idThread::SortByThreadNum
+================
+*/
+int idThread::SortByThreadNum( idThread * const *a, idThread * const *b ) {
+	return ( *a )->threadNum - ( *b )->threadNum;
+}
+
 /*
 ================
 idThread::DisplayInfo
@@ -714,7 +779,14 @@ void idThread::ListThreads_f( const idCmdArgs &args ) {
 	n = threadList.Num();
 	for( i = 0; i < n; i++ ) {
 		//threadList[ i ]->DisplayInfo();
-		gameLocal.Printf( "%3i: %-20s : %s(%d)\n", threadList[ i ]->threadNum, threadList[ i ]->threadName.c_str(), threadList[ i ]->interpreter.CurrentFile(), threadList[ i ]->interpreter.CurrentLine() );
+		const idInterpreter &interpreter = threadList[ i ]->interpreter;
+		if ( g_scriptProfile.GetBool() ) {
+			// the time charged while g_scriptProfile was set
+			gameLocal.Printf( "%3i: %-20s : %9.2f msec %10d instr : %s(%d)\n", threadList[ i ]->threadNum, threadList[ i ]->threadName.c_str(),
+				interpreter.GetProfileTime(), interpreter.GetNumInstructions(), interpreter.CurrentFile(), interpreter.CurrentLine() );
+		} else {
+			gameLocal.Printf( "%3i: %-20s : %s(%d)\n", threadList[ i ]->threadNum, threadList[ i ]->threadName.c_str(), interpreter.CurrentFile(), interpreter.CurrentLine() );
+		}
 	}
 	gameLocal.Printf( "%d active threads\n\n", n );
 }
@@ -737,6 +809,9 @@ void idThread::Restart( void ) {
 		delete threadList[ i ];
 	}
 	threadList.Clear();
+	threadHash.Clear();
+	threadSlots.Clear();
+	freeThreadSlots.Clear();
 
 	memset( &trace, 0, sizeof( trace ) );
 	trace.c.entityNum = ENTITYNUM_NONE;
@@ -939,6 +1014,10 @@ idThread::ClearWaitFor
 ================
 */
 void idThread::ClearWaitFor( void ) {
+	if ( waitingForThread ) {
+		waitingForThread->waitingThreads.Remove( this );
+	}
+
 	waitingFor			= ENTITYNUM_NONE;
 	waitingForThread	= NULL;
 	waitingUntil		= 0;
@@ -1201,7 +1280,9 @@ void idThread::Event_WaitForThread( int num ) {
 		}
 	} else {
 		Pause();
+		ClearWaitFor();
 		waitingForThread = thread;
+		thread->waitingThreads.Append( this );
 	}
 }
 
@@ -1289,6 +1370,45 @@ void idThread::Event_GetCvar( const char *name ) const {
 	ReturnString( cvarSystem->GetCVarString( name ) );
 }
 
+/*
+================
+idThread::Event_GetCvarHandle
+================
+*/
+void idThread::Event_GetCvarHandle( const char *name ) const {
+	ReturnFloat( cvarSystem->GetCVarHandle( name ) );
+}
+
+/*
+================
+idThread::Event_GetCvarByHandle
+================
+*/
+void idThread::Event_GetCvarByHandle( float handle ) const {
+	const idCVar *cvar = cvarSystem->GetCVarByHandle( idMath::FtoiFast( handle ) );
+	ReturnString( cvar ? cvar->GetString() : "" );
+}
+
+/*
+================
+idThread::Event_GetCvarFloatByHandle
+================
+*/
+void idThread::Event_GetCvarFloatByHandle( float handle ) const {
+	const idCVar *cvar = cvarSystem->GetCVarByHandle( idMath::FtoiFast( handle ) );
+	ReturnFloat( cvar ? cvar->GetFloat() : 0.0f );
+}
+
+/*
+================
+idThread::Event_GetCvarModCount
+================
+*/
+void idThread::Event_GetCvarModCount( float handle ) const {
+	const idCVar *cvar = cvarSystem->GetCVarByHandle( idMath::FtoiFast( handle ) );
+	ReturnFloat( cvar ? cvar->GetModificationCount() : -1 );
+}
+
 /*
 ================
 idThread::Event_Random
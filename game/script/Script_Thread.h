@@ -48,10 +48,21 @@ private:
 	static int					threadIndex;
 	static idList<idThread *>	threadList;
 
+	// GetThread looks the thread numbers up in threadHash, which indexes threadSlots
+	static idHashIndex			threadHash;
+	static idList<idThread *>	threadSlots;				// NULL for the free slots
+	static idList<int>			freeThreadSlots;
+	int							threadSlot;
+
+	idList<idThread *>			waitingThreads;				// the threads waiting for this one to end
+
 	static trace_t				trace;
 
 	void						Init( void );
 	void						Pause( void );
+	void						LinkThreadNum( void );
+	void						UnlinkThreadNum( void );
+	static int					SortByThreadNum( idThread * const *a, idThread * const *b );
 
 	void						Event_Execute( void );
 	void						Event_SetThreadName( const char *name );
@@ -73,6 +84,10 @@ private:
 	void						Event_Trigger( idEntity *ent );
 	void						Event_SetCvar( const char *name, const char *value ) const;
 	void						Event_GetCvar( const char *name ) const;
+	void						Event_GetCvarHandle( const char *name ) const;
+	void						Event_GetCvarByHandle( float handle ) const;
+	void						Event_GetCvarFloatByHandle( float handle ) const;
+	void						Event_GetCvarModCount( float handle ) const;
 	void						Event_Random( float range ) const;
 	void						Event_GetTime( void );
 	void						Event_KillThread( const char *name );
@@ -308,7 +323,9 @@ idThread::SetThreadNum
 ================
 */
 ID_INLINE void idThread::SetThreadNum( int num ) {
+	UnlinkThreadNum();
 	threadNum = num;
+	LinkThreadNum();
 }
 
 /*
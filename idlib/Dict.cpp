@@ -25,6 +25,7 @@
 
 idStrPool		idDict::globalKeys;
 idStrPool		idDict::globalValues;
+idStrPool		idInternStr::pool;
 
 /*
 ================
@@ -312,12 +313,13 @@ idDict::GetFloat
 ================
 */
 bool idDict::GetFloat( const char *key, const char *defaultString, float &out ) const {
-	const char	*s;
-	bool		found;
-
-	found = GetString( key, defaultString, &s );
-	out = atof( s );
-	return found;
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		out = kv->value->GetFloatValue();
+		return true;
+	}
+	out = atof( defaultString );
+	return false;
 }
 
 /*
@@ -326,12 +328,13 @@ idDict::GetInt
 ================
 */
 bool idDict::GetInt( const char *key, const char *defaultString, int &out ) const {
-	const char	*s;
-	bool		found;
-
-	found = GetString( key, defaultString, &s );
-	out = atoi( s );
-	return found;
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		out = kv->value->GetIntValue();
+		return true;
+	}
+	out = atoi( defaultString );
+	return false;
 }
 
 /*
@@ -340,12 +343,13 @@ idDict::GetBool
 ================
 */
 bool idDict::GetBool( const char *key, const char *defaultString, bool &out ) const {
-	const char	*s;
-	bool		found;
-
-	found = GetString( key, defaultString, &s );
-	out = ( atoi( s ) != 0 );
-	return found;
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		out = ( kv->value->GetIntValue() != 0 );
+		return true;
+	}
+	out = ( atoi( defaultString ) != 0 );
+	return false;
 }
 
 /*
@@ -354,17 +358,20 @@ idDict::GetAngles
 ================
 */
 bool idDict::GetAngles( const char *key, const char *defaultString, idAngles &out ) const {
-	bool		found;
-	const char	*s;
-	
 	if ( !defaultString ) {
 		defaultString = "0 0 0";
 	}
 
-	found = GetString( key, defaultString, &s );
-	out.Zero();	
-	sscanf( s, "%f %f %f", &out.pitch, &out.yaw, &out.roll );
-	return found;
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		const idVec3 &v = kv->value->GetVectorValue();
+		out.Set( v.x, v.y, v.z );
+		return true;
+	}
+
+	out.Zero();
+	sscanf( defaultString, "%f %f %f", &out.pitch, &out.yaw, &out.roll );
+	return false;
 }
 
 /*
@@ -373,17 +380,19 @@ idDict::GetVector
 ================
 */
 bool idDict::GetVector( const char *key, const char *defaultString, idVec3 &out ) const {
-	bool		found;
-	const char	*s;
-	
 	if ( !defaultString ) {
 		defaultString = "0 0 0";
 	}
 
-	found = GetString( key, defaultString, &s );
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		out = kv->value->GetVectorValue();
+		return true;
+	}
+
 	out.Zero();
-	sscanf( s, "%f %f %f", &out.x, &out.y, &out.z );
-	return found;
+	sscanf( defaultString, "%f %f %f", &out.x, &out.y, &out.z );
+	return false;
 }
 
 /*
@@ -479,6 +488,23 @@ const idKeyValue *idDict::FindKey( const char *key ) const {
 	return NULL;
 }
 
+/*
+================
+idDict::FindKey
+================
+*/
+const idKeyValue *idDict::FindKey( const idDictKey &key ) const {
+	// the same hash key as GenerateKey( key.GetName(), false )
+	const int hash = argHash.GenerateKey( key.GetHash(), 0 );
+	for ( int i = argHash.First( hash ); i != -1; i = argHash.Next( i ) ) {
+		if ( args[i].GetKey().Icmp( key.GetName() ) == 0 ) {
+			return &args[i];
+		}
+	}
+
+	return NULL;
+}
+
 /*
 ================
 idDict::FindKeyIndex
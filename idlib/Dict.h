@@ -55,6 +55,30 @@ private:
 	const idPoolStr *	value;
 };
 
+/*
+================
+idDictKey
+
+A key with its hash computed once, for keys looked up often:
+
+	static const idDictKey key_origin( "origin" );
+	dict.GetVector( key_origin );
+
+The name must outlive the key.
+================
+*/
+class idDictKey {
+public:
+	explicit			idDictKey( const char *name ) { this->name = name; hash = idStr::IHash( name ); }
+
+	const char *		GetName( void ) const { return name; }
+	int					GetHash( void ) const { return hash; }
+
+private:
+	const char *		name;
+	int					hash;
+};
+
 class idDict {
 public:
 						idDict( void );
@@ -71,6 +95,8 @@ public:
 	void				Copy( const idDict &other );
 						// clear existing key/value pairs and transfer key/value pairs from other
 	void				TransferKeyValues( idDict &other );
+						// swap the key/value pairs with other, both dicts must use the pools of the same module
+	void				Swap( idDict &other );
 						// parse dict from parser
 	bool				Parse( idParser &parser );
 						// copy key/value pairs from other dict not present in this dict
@@ -106,6 +132,13 @@ public:
 	idAngles			GetAngles( const char *key, const char *defaultString = NULL ) const;
 	idMat3				GetMatrix( const char *key, const char *defaultString = NULL ) const;
 
+						// same with a pre-hashed key
+	const char *		GetString( const idDictKey &key, const char *defaultString = "" ) const;
+	float				GetFloat( const idDictKey &key, const char *defaultString = "0" ) const;
+	int					GetInt( const idDictKey &key, const char *defaultString = "0" ) const;
+	bool				GetBool( const idDictKey &key, const char *defaultString = "0" ) const;
+	idVec3				GetVector( const idDictKey &key, const char *defaultString = NULL ) const;
+
 	bool				GetString( const char *key, const char *defaultString, const char **out ) const;
 	bool				GetString( const char *key, const char *defaultString, idStr &out ) const;
 	bool				GetFloat( const char *key, const char *defaultString, float &out ) const;
@@ -122,6 +155,7 @@ public:
 						// returns the key/value pair with the given key
 						// returns NULL if the key/value pair does not exist
 	const idKeyValue *	FindKey( const char *key ) const;
+	const idKeyValue *	FindKey( const idDictKey &key ) const;
 						// returns the index to the key/value pair with the given key
 						// returns -1 if the key/value pair does not exist
 	int					FindKeyIndex( const char *key ) const;
@@ -170,6 +204,11 @@ ID_INLINE idDict::~idDict( void ) {
 	Clear();
 }
 
+ID_INLINE void idDict::Swap( idDict &other ) {
+	args.Swap( other.args );
+	argHash.Swap( other.argHash );
+}
+
 ID_INLINE void idDict::SetGranularity( int granularity ) {
 	args.SetGranularity( granularity );
 	argHash.SetGranularity( granularity );
@@ -242,15 +281,27 @@ ID_INLINE const char *idDict::GetString( const char *key, const char *defaultStr
 }
 
 ID_INLINE float idDict::GetFloat( const char *key, const char *defaultString ) const {
-	return atof( GetString( key, defaultString ) );
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return kv->value->GetFloatValue();
+	}
+	return atof( defaultString );
 }
 
 ID_INLINE int idDict::GetInt( const char *key, const char *defaultString ) const {
-	return atoi( GetString( key, defaultString ) );
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return kv->value->GetIntValue();
+	}
+	return atoi( defaultString );
 }
 
 ID_INLINE bool idDict::GetBool( const char *key, const char *defaultString ) const {
-	return ( atoi( GetString( key, defaultString ) ) != 0 );
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return ( kv->value->GetIntValue() != 0 );
+	}
+	return ( atoi( defaultString ) != 0 );
 }
 
 ID_INLINE idVec3 idDict::GetVector( const char *key, const char *defaultString ) const {
@@ -283,6 +334,51 @@ ID_INLINE idMat3 idDict::GetMatrix( const char *key, const char *defaultString )
 	return out;
 }
 
+ID_INLINE const char *idDict::GetString( const idDictKey &key, const char *defaultString ) const {
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return kv->GetValue();
+	}
+	return defaultString;
+}
+
+ID_INLINE float idDict::GetFloat( const idDictKey &key, const char *defaultString ) const {
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return kv->value->GetFloatValue();
+	}
+	return atof( defaultString );
+}
+
+ID_INLINE int idDict::GetInt( const idDictKey &key, const char *defaultString ) const {
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return kv->value->GetIntValue();
+	}
+	return atoi( defaultString );
+}
+
+ID_INLINE bool idDict::GetBool( const idDictKey &key, const char *defaultString ) const {
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return ( kv->value->GetIntValue() != 0 );
+	}
+	return ( atoi( defaultString ) != 0 );
+}
+
+ID_INLINE idVec3 idDict::GetVector( const idDictKey &key, const char *defaultString ) const {
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return kv->value->GetVectorValue();
+	}
+	idVec3 out;
+	out.Zero();
+	if ( defaultString ) {
+		sscanf( defaultString, "%f %f %f", &out.x, &out.y, &out.z );
+	}
+	return out;
+}
+
 ID_INLINE int idDict::GetNumKeyVals( void ) const {
 	return args.Num();
 }
@@ -294,4 +390,18 @@ ID_INLINE const idKeyValue *idDict::GetKeyVal( int index ) const {
 	return NULL;
 }
 
+/*
+================
+idListRelocate<idDict>
+
+Lists of dicts hand over the key/value pairs when they grow.
+================
+*/
+template<>
+class idListRelocate< idDict > {
+public:
+	enum { memcpyRelocate = 0 };
+	static void		Move( idDict &dst, idDict &src ) { dst.Swap( src ); }
+};
+
 #endif /* !__DICT_H__ */
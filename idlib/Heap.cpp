@@ -26,10 +26,89 @@
 	#define USE_LIBC_MALLOC		0
 #endif
 
+// USE_THREAD_HEAP gives every thread its own cache of small and medium blocks
+// in front of the shared heap, so Mem_Alloc and Mem_Free can be called from any thread
+#ifndef USE_THREAD_HEAP
+	#define USE_THREAD_HEAP		0
+#endif
+
+// the memory debugging heap keeps its call stack bookkeeping single threaded
+#if defined( ID_DEBUG_MEMORY ) || USE_LIBC_MALLOC
+	#undef USE_THREAD_HEAP
+	#define USE_THREAD_HEAP		0
+#endif
+
+// USE_MEM_TAGS puts a small header in front of every Mem_Alloc block with the
+// tag of the allocating subsystem, so the memTags command can account for it
+#ifndef USE_MEM_TAGS
+	#define USE_MEM_TAGS		0
+#endif
+
+#ifdef ID_DEBUG_MEMORY
+	#undef USE_MEM_TAGS
+	#define USE_MEM_TAGS		0
+#endif
+
 #ifndef CRASH_ON_STATIC_ALLOCATION
 //	#define CRASH_ON_STATIC_ALLOCATION
 #endif
 
+#if USE_THREAD_HEAP
+
+#ifdef _WIN32
+	#include <intrin.h>
+	#pragma intrinsic( _InterlockedExchange )
+	#define HEAP_LOCK_ACQUIRE( x )		_InterlockedExchange( (x), 1 )
+	#define HEAP_LOCK_RELEASE( x )		_InterlockedExchange( (x), 0 )
+#else
+	#define HEAP_LOCK_ACQUIRE( x )		__sync_lock_test_and_set( (x), 1 )
+	#define HEAP_LOCK_RELEASE( x )		__sync_lock_release( (x) )
+#endif
+
+/*
+================
+idHeapLock
+
+  spin lock around the shared heap, which is only entered to refill or trim a
+  thread cache and for large allocations
+================
+*/
+class idHeapLock {
+public:
+					idHeapLock( void ) { locked = 0; }
+	void			Lock( void ) {
+						while ( HEAP_LOCK_ACQUIRE( &locked ) ) {
+							while ( locked ) {
+							}
+						}
+					}
+	void			Unlock( void ) { HEAP_LOCK_RELEASE( &locked ); }
+
+private:
+	volatile long	locked;
+};
+
+#define HEAP_SMALL_BINS			( 256 / 8 + 1 )		// one for each small block size
+#define HEAP_MEDIUM_BINS		24					// medium sizes growing by a quarter from 256 bytes
+#define HEAP_SMALL_BATCH		16					// small blocks taken from the shared heap at once
+#define HEAP_SMALL_CACHED		64					// small blocks of a size kept by a thread
+#define HEAP_MEDIUM_CACHED		( 16 * 1024 )		// bytes of medium blocks of a size kept by a thread
+
+typedef struct heapThreadCache_s {
+	void *				smallFree[HEAP_SMALL_BINS];		// cached blocks, linked through their first bytes
+	int					smallCount[HEAP_SMALL_BINS];
+	void *				mediumFree[HEAP_MEDIUM_BINS];
+	int					mediumCount[HEAP_MEDIUM_BINS];
+	int					cachedBytes;
+	int					threadNum;
+	memoryStats_t		totalAllocs;		// allocated minus freed by this thread
+	memoryStats_t		frameAllocs;
+	memoryStats_t		frameFrees;
+	struct heapThreadCache_s *next;
+} heapThreadCache_t;
+
+#endif
+
 //===============================================================
 //
 //	idHeap
@@ -60,6 +139,13 @@ public:
 
 	void 			AllocDefragBlock( void );		// hack for huge renderbumps
 
+#if USE_THREAD_HEAP
+	void *			ThreadAllocate( const dword bytes );	// allocate from the cache of the calling thread
+	void			ThreadFree( void *p );					// free to the cache of the calling thread
+	heapThreadCache_t *	ThreadCache( void );				// cache of the calling thread
+	heapThreadCache_t *	FirstThreadCache( void ) const { return threadCaches; }
+#endif
+
 private:
 
 	enum {
@@ -133,8 +219,26 @@ private:
 
 	void			ReleaseSwappedPages( void );
 	void			FreePageReal( idHeap::page_s *p );
+
+#if USE_THREAD_HEAP
+	idHeapLock		lock;							// taken by the threads around the shared heap
+	heapThreadCache_t *threadCaches;				// all caches, never freed as their threads may still use them
+	int				numThreadCaches;
+	dword			mediumBinSize[HEAP_MEDIUM_BINS];// smallest size served from each medium bin
+	int				numMediumBins;
+
+	static ID_THREAD_LOCAL heapThreadCache_t *threadCache;
+
+	int				MediumBin( dword bytes ) const;	// smallest bin holding blocks of at least bytes
+	void			TrimSmallBin( heapThreadCache_t *cache, int bin );
+	void			TrimMediumBin( heapThreadCache_t *cache, int bin );
+#endif
 };
 
+#if USE_THREAD_HEAP
+ID_THREAD_LOCAL heapThreadCache_t *idHeap::threadCache = NULL;
+#endif
+
 
 /*
 ================
@@ -163,6 +267,19 @@ void idHeap::Init () {
 	mediumFirstUsedPage	= NULL;
 
 	c_heapAllocRunningCount = 0;
+
+#if USE_THREAD_HEAP
+	threadCaches		= NULL;
+	numThreadCaches		= 0;
+
+	// medium bins grow by a quarter, the last one covers everything up to the large allocations
+	dword size = 256;
+	for ( numMediumBins = 0; numMediumBins < HEAP_MEDIUM_BINS - 1 && size < 32768; numMediumBins++ ) {
+		mediumBinSize[numMediumBins] = size;
+		size = ALIGN_SIZE( size + size / 4 );
+	}
+	mediumBinSize[numMediumBins++] = 32767;
+#endif
 }
 
 /*
@@ -971,6 +1088,222 @@ void idHeap::LargeFree( void *ptr) {
 	FreePage(pg);
 }
 
+#if USE_THREAD_HEAP
+
+//===============================================================
+//
+//	thread caches
+//
+//	Each thread keeps free small blocks of every size and medium blocks
+//	in size bins. Blocks freed on one thread are cached by that thread,
+//	all blocks belong to the shared heap, so they don't need to go back
+//	to the thread that allocated them. The shared heap is only locked to
+//	refill an empty bin, to trim a full one and for large allocations.
+//
+//===============================================================
+
+/*
+================
+idHeap::ThreadCache
+================
+*/
+heapThreadCache_t *idHeap::ThreadCache( void ) {
+	if ( !threadCache ) {
+		heapThreadCache_t *cache = (heapThreadCache_t *)calloc( 1, sizeof( heapThreadCache_t ) );
+		if ( !cache ) {
+			idLib::common->FatalError( "idHeap::ThreadCache: malloc failure" );
+		}
+		cache->totalAllocs.minSize = cache->frameAllocs.minSize = cache->frameFrees.minSize = 0x0fffffff;
+		cache->totalAllocs.maxSize = cache->frameAllocs.maxSize = cache->frameFrees.maxSize = -1;
+
+		lock.Lock();
+		cache->threadNum = numThreadCaches++;
+		cache->next = threadCaches;
+		threadCaches = cache;
+		lock.Unlock();
+
+		threadCache = cache;
+	}
+	return threadCache;
+}
+
+/*
+================
+idHeap::MediumBin
+================
+*/
+int idHeap::MediumBin( dword bytes ) const {
+	int i;
+	for ( i = 0; i < numMediumBins - 1; i++ ) {
+		if ( mediumBinSize[i] >= bytes ) {
+			break;
+		}
+	}
+	return i;
+}
+
+/*
+================
+idHeap::ThreadAllocate
+================
+*/
+void *idHeap::ThreadAllocate( const dword bytes ) {
+	heapThreadCache_t *cache = ThreadCache();
+	byte *block;
+
+	if ( !(bytes & ~255) ) {
+		// the free list link needs a pointer
+		const dword size = SMALL_ALIGN( Max( bytes, (dword)sizeof( void * ) ) );
+		const int bin = size / ALIGN;
+
+		if ( !cache->smallFree[bin] ) {
+			lock.Lock();
+			for ( int i = 0; i < HEAP_SMALL_BATCH; i++ ) {
+				block = (byte *)SmallAllocate( size );
+				if ( !block ) {
+					break;
+				}
+				block[-1] = INVALID_ALLOC;
+				*(void **)block = cache->smallFree[bin];
+				cache->smallFree[bin] = block;
+				cache->smallCount[bin]++;
+				cache->cachedBytes += size;
+			}
+			lock.Unlock();
+
+			if ( !cache->smallFree[bin] ) {
+				return NULL;
+			}
+		}
+
+		block = (byte *)cache->smallFree[bin];
+		cache->smallFree[bin] = *(void **)block;
+		cache->smallCount[bin]--;
+		cache->cachedBytes -= size;
+		block[-1] = SMALL_ALLOC;
+		return block;
+	}
+
+	if ( !(bytes & ~32767) ) {
+		const int bin = MediumBin( bytes );
+
+		if ( !cache->mediumFree[bin] ) {
+			lock.Lock();
+			block = (byte *)MediumAllocate( mediumBinSize[bin] );
+			lock.Unlock();
+			return block;
+		}
+
+		block = (byte *)cache->mediumFree[bin];
+		cache->mediumFree[bin] = *(void **)block;
+		cache->mediumCount[bin]--;
+		block[-1] = MEDIUM_ALLOC;
+		cache->cachedBytes -= Msize( block );
+		return block;
+	}
+
+	lock.Lock();
+	block = (byte *)LargeAllocate( bytes );
+	lock.Unlock();
+	return block;
+}
+
+/*
+================
+idHeap::TrimSmallBin
+
+  gives half the cached blocks of a bin back to the shared heap
+================
+*/
+void idHeap::TrimSmallBin( heapThreadCache_t *cache, int bin ) {
+	lock.Lock();
+	while ( cache->smallCount[bin] > HEAP_SMALL_CACHED / 2 ) {
+		byte *block = (byte *)cache->smallFree[bin];
+		cache->smallFree[bin] = *(void **)block;
+		cache->smallCount[bin]--;
+		cache->cachedBytes -= bin * ALIGN;
+		SmallFree( block );
+	}
+	lock.Unlock();
+}
+
+/*
+================
+idHeap::TrimMediumBin
+
+  gives half the cached blocks of a bin back to the shared heap
+================
+*/
+void idHeap::TrimMediumBin( heapThreadCache_t *cache, int bin ) {
+	const int keep = Max( 1, (int)( HEAP_MEDIUM_CACHED / mediumBinSize[bin] ) ) / 2;
+
+	lock.Lock();
+	while ( cache->mediumCount[bin] > keep ) {
+		byte *block = (byte *)cache->mediumFree[bin];
+		cache->mediumFree[bin] = *(void **)block;
+		cache->mediumCount[bin]--;
+		block[-1] = MEDIUM_ALLOC;
+		cache->cachedBytes -= Msize( block );
+		MediumFree( block );
+	}
+	lock.Unlock();
+}
+
+/*
+================
+idHeap::ThreadFree
+================
+*/
+void idHeap::ThreadFree( void *p ) {
+	heapThreadCache_t *cache = ThreadCache();
+	byte *block = (byte *)p;
+
+	switch( block[-1] ) {
+		case SMALL_ALLOC: {
+			const int bin = block[-SMALL_HEADER_SIZE];
+			if ( bin > 256 / ALIGN ) {
+				idLib::common->FatalError( "idHeap::ThreadFree: invalid memory block" );
+			}
+			block[-1] = INVALID_ALLOC;
+			*(void **)block = cache->smallFree[bin];
+			cache->smallFree[bin] = block;
+			cache->cachedBytes += bin * ALIGN;
+			if ( ++cache->smallCount[bin] > HEAP_SMALL_CACHED ) {
+				TrimSmallBin( cache, bin );
+			}
+			break;
+		}
+		case MEDIUM_ALLOC: {
+			// the largest bin the block is big enough for
+			const dword size = Msize( block );
+			int bin = MediumBin( size );
+			if ( mediumBinSize[bin] > size && bin > 0 ) {
+				bin--;
+			}
+			block[-1] = INVALID_ALLOC;
+			*(void **)block = cache->mediumFree[bin];
+			cache->mediumFree[bin] = block;
+			cache->cachedBytes += size;
+			if ( ++cache->mediumCount[bin] * mediumBinSize[bin] > HEAP_MEDIUM_CACHED && cache->mediumCount[bin] > 1 ) {
+				TrimMediumBin( cache, bin );
+			}
+			break;
+		}
+		case LARGE_ALLOC: {
+			lock.Lock();
+			LargeFree( block );
+			lock.Unlock();
+			break;
+		}
+		default: {
+			idLib::common->FatalError( "idHeap::ThreadFree: invalid memory block (%s)", idLib::sys->GetCallStackCurStr( 4 ) );
+			break;
+		}
+	}
+}
+
+#endif /* USE_THREAD_HEAP */
+
 //===============================================================
 //
 //	memory allocation all in one place
@@ -994,7 +1327,32 @@ void Mem_ClearFrameStats( void ) {
 	mem_frame_allocs.minSize = mem_frame_frees.minSize = 0x0fffffff;
 	mem_frame_allocs.maxSize = mem_frame_frees.maxSize = -1;
 	mem_frame_allocs.totalSize = mem_frame_frees.totalSize = 0;
+
+#if USE_THREAD_HEAP
+	if ( mem_heap ) {
+		for ( heapThreadCache_t *cache = mem_heap->FirstThreadCache(); cache; cache = cache->next ) {
+			cache->frameAllocs.num = cache->frameFrees.num = 0;
+			cache->frameAllocs.minSize = cache->frameFrees.minSize = 0x0fffffff;
+			cache->frameAllocs.maxSize = cache->frameFrees.maxSize = -1;
+			cache->frameAllocs.totalSize = cache->frameFrees.totalSize = 0;
+		}
+	}
+#endif
+}
+
+#if USE_THREAD_HEAP
+/*
+==================
+Mem_AddStats
+==================
+*/
+static void Mem_AddStats( memoryStats_t &stats, const memoryStats_t &add ) {
+	stats.num += add.num;
+	stats.minSize = Min( stats.minSize, add.minSize );
+	stats.maxSize = Max( stats.maxSize, add.maxSize );
+	stats.totalSize += add.totalSize;
 }
+#endif
 
 /*
 ==================
@@ -1004,6 +1362,15 @@ Mem_GetFrameStats
 void Mem_GetFrameStats( memoryStats_t &allocs, memoryStats_t &frees ) {
 	allocs = mem_frame_allocs;
 	frees = mem_frame_frees;
+
+#if USE_THREAD_HEAP
+	if ( mem_heap ) {
+		for ( heapThreadCache_t *cache = mem_heap->FirstThreadCache(); cache; cache = cache->next ) {
+			Mem_AddStats( allocs, cache->frameAllocs );
+			Mem_AddStats( frees, cache->frameFrees );
+		}
+	}
+#endif
 }
 
 /*
@@ -1013,6 +1380,48 @@ Mem_GetStats
 */
 void Mem_GetStats( memoryStats_t &stats ) {
 	stats = mem_total_allocs;
+
+#if USE_THREAD_HEAP
+	if ( mem_heap ) {
+		for ( heapThreadCache_t *cache = mem_heap->FirstThreadCache(); cache; cache = cache->next ) {
+			Mem_AddStats( stats, cache->totalAllocs );
+		}
+	}
+#endif
+}
+
+/*
+==================
+Mem_GetThreadStats
+
+  the allocations made minus the ones freed by a thread and the bytes its
+  cache holds, returns false if there is no such thread
+==================
+*/
+bool Mem_GetThreadStats( int threadNum, memoryStats_t &stats, int &cachedBytes ) {
+#if USE_THREAD_HEAP
+	if ( mem_heap ) {
+		for ( heapThreadCache_t *cache = mem_heap->FirstThreadCache(); cache; cache = cache->next ) {
+			if ( cache->threadNum == threadNum ) {
+				stats = cache->totalAllocs;
+				cachedBytes = cache->cachedBytes;
+				return true;
+			}
+		}
+	}
+#endif
+	return false;
+}
+
+/*
+==================
+Mem_ThreadSafe
+
+  true if Mem_Alloc and Mem_Free may be called from several threads at once
+==================
+*/
+bool Mem_ThreadSafe( void ) {
+	return USE_THREAD_HEAP != 0;
 }
 
 /*
@@ -1037,6 +1446,14 @@ Mem_UpdateAllocStats
 ==================
 */
 void Mem_UpdateAllocStats( int size ) {
+#if USE_THREAD_HEAP
+	if ( mem_heap ) {
+		heapThreadCache_t *cache = mem_heap->ThreadCache();
+		Mem_UpdateStats( cache->frameAllocs, size );
+		Mem_UpdateStats( cache->totalAllocs, size );
+		return;
+	}
+#endif
 	Mem_UpdateStats( mem_frame_allocs, size );
 	Mem_UpdateStats( mem_total_allocs, size );
 }
@@ -1047,11 +1464,170 @@ Mem_UpdateFreeStats
 ==================
 */
 void Mem_UpdateFreeStats( int size ) {
+#if USE_THREAD_HEAP
+	if ( mem_heap ) {
+		heapThreadCache_t *cache = mem_heap->ThreadCache();
+		Mem_UpdateStats( cache->frameFrees, size );
+		cache->totalAllocs.num--;
+		cache->totalAllocs.totalSize -= size;
+		return;
+	}
+#endif
 	Mem_UpdateStats( mem_frame_frees, size );
 	mem_total_allocs.num--;
 	mem_total_allocs.totalSize -= size;
 }
 
+//===============================================================
+//
+//	memory tags
+//
+//===============================================================
+
+static const char *mem_tag_names[MEMTAG_MAX] = {
+	"misc",
+	"renderer",
+	"images",
+	"models",
+	"collision",
+	"aas",
+	"sound",
+	"script",
+	"decls",
+	"game",
+	"gui"
+};
+
+static ID_THREAD_LOCAL int mem_tag;		// memTag_t of the calling thread
+
+/*
+==================
+Mem_SetTag
+==================
+*/
+memTag_t Mem_SetTag( memTag_t tag ) {
+	assert( tag >= 0 && tag < MEMTAG_MAX );
+	memTag_t previous = (memTag_t)mem_tag;
+	mem_tag = tag;
+	return previous;
+}
+
+#if USE_MEM_TAGS
+
+#ifdef _WIN32
+	#include <intrin.h>
+	#pragma intrinsic( _InterlockedExchangeAdd )
+	#define MEM_ATOMIC_ADD( x, v )		_InterlockedExchangeAdd( (volatile long *)(x), (v) )
+#else
+	#define MEM_ATOMIC_ADD( x, v )		__sync_fetch_and_add( (x), (v) )
+#endif
+
+#define MEM_TAG_HEADER_SIZE		8		// keeps Mem_Alloc blocks 8 byte aligned
+#define MEM_TAG_HEADER_SIZE16	16		// keeps Mem_Alloc16 blocks 16 byte aligned
+
+typedef struct {
+	int				tag;
+	int				size;			// requested size
+} memTagHeader_t;					// right in front of the returned block
+
+typedef struct {
+	volatile int	num;
+	volatile int	bytes;
+	int				peakBytes;
+	volatile int	reportAllocs;	// allocations since the last report
+	volatile int	reportBytes;
+} memTagStats_t;
+
+static memTagStats_t	mem_tag_stats[MEMTAG_MAX];
+static int				mem_tag_reportFrame;
+
+/*
+==================
+Mem_TagBlock
+
+  fills in the header of a new block and returns the memory after it
+==================
+*/
+static void *Mem_TagBlock( void *mem, const int size, const int headerSize ) {
+	if ( !mem ) {
+		return NULL;
+	}
+	memTagHeader_t *header = (memTagHeader_t *)( (byte *)mem + headerSize - sizeof( memTagHeader_t ) );
+	memTagStats_t &stats = mem_tag_stats[mem_tag];
+
+	header->tag = mem_tag;
+	header->size = size;
+
+	MEM_ATOMIC_ADD( &stats.num, 1 );
+	const int bytes = MEM_ATOMIC_ADD( &stats.bytes, size ) + size;
+	if ( bytes > stats.peakBytes ) {
+		stats.peakBytes = bytes;		// may miss a concurrent peak
+	}
+	MEM_ATOMIC_ADD( &stats.reportAllocs, 1 );
+	MEM_ATOMIC_ADD( &stats.reportBytes, size );
+
+	return (byte *)mem + headerSize;
+}
+
+/*
+==================
+Mem_UntagBlock
+
+  returns the start of a block allocated by Mem_TagBlock
+==================
+*/
+static void *Mem_UntagBlock( void *ptr, const int headerSize ) {
+	memTagHeader_t *header = (memTagHeader_t *)( (byte *)ptr - sizeof( memTagHeader_t ) );
+
+	if ( header->tag < 0 || header->tag >= MEMTAG_MAX ) {
+		idLib::common->FatalError( "Mem_Free: invalid memory tag (%s)", idLib::sys->GetCallStackCurStr( 4 ) );
+	}
+	memTagStats_t &stats = mem_tag_stats[header->tag];
+	MEM_ATOMIC_ADD( &stats.num, -1 );
+	MEM_ATOMIC_ADD( &stats.bytes, -header->size );
+	header->tag = -1;
+
+	return (byte *)ptr - headerSize;
+}
+
+#else
+
+#define MEM_TAG_HEADER_SIZE		0
+#define MEM_TAG_HEADER_SIZE16	0
+
+#define Mem_TagBlock( mem, size, headerSize )	( mem )
+#define Mem_UntagBlock( ptr, headerSize )		( ptr )
+
+#endif /* USE_MEM_TAGS */
+
+/*
+==================
+Mem_Tags_f
+==================
+*/
+void Mem_Tags_f( const idCmdArgs &args ) {
+#if USE_MEM_TAGS
+	const int frames = Max( 1, idLib::frameNumber - mem_tag_reportFrame );
+	int totalNum = 0, totalBytes = 0;
+
+	idLib::common->Printf( "tag        blocks  current kB   peak kB  allocs/frame  kB/frame\n" );
+	for ( int i = 0; i < MEMTAG_MAX; i++ ) {
+		memTagStats_t &stats = mem_tag_stats[i];
+		idLib::common->Printf( "%-10s %6d %11d %9d %13.1f %9.1f\n", mem_tag_names[i], stats.num, stats.bytes >> 10, stats.peakBytes >> 10,
+								(float)stats.reportAllocs / frames, (float)stats.reportBytes / ( frames * 1024.0f ) );
+		totalNum += stats.num;
+		totalBytes += stats.bytes;
+		stats.reportAllocs = 0;
+		stats.reportBytes = 0;
+	}
+	idLib::common->Printf( "%-10s %6d %11d\n", "total", totalNum, totalBytes >> 10 );
+	idLib::common->Printf( "rates averaged over %d frames\n", frames );
+	mem_tag_reportFrame = idLib::frameNumber;
+#else
+	idLib::common->Printf( "memory tags are not compiled in, build with USE_MEM_TAGS\n" );
+#endif
+}
+
 
 #ifndef ID_DEBUG_MEMORY
 
@@ -1068,11 +1644,15 @@ void *Mem_Alloc( const int size ) {
 #ifdef CRASH_ON_STATIC_ALLOCATION
 		*((int*)0x0) = 1;
 #endif
-		return malloc( size );
+		return Mem_TagBlock( malloc( size + MEM_TAG_HEADER_SIZE ), size, MEM_TAG_HEADER_SIZE );
 	}
-	void *mem = mem_heap->Allocate( size );
+#if USE_THREAD_HEAP
+	void *mem = mem_heap->ThreadAllocate( size + MEM_TAG_HEADER_SIZE );
+#else
+	void *mem = mem_heap->Allocate( size + MEM_TAG_HEADER_SIZE );
+#endif
 	Mem_UpdateAllocStats( mem_heap->Msize( mem ) );
-	return mem;
+	return Mem_TagBlock( mem, size, MEM_TAG_HEADER_SIZE );
 }
 
 /*
@@ -1084,6 +1664,7 @@ void Mem_Free( void *ptr ) {
 	if ( !ptr ) {
 		return;
 	}
+	ptr = Mem_UntagBlock( ptr, MEM_TAG_HEADER_SIZE );
 	if ( !mem_heap ) {
 #ifdef CRASH_ON_STATIC_ALLOCATION
 		*((int*)0x0) = 1;
@@ -1092,7 +1673,11 @@ void Mem_Free( void *ptr ) {
 		return;
 	}
 	Mem_UpdateFreeStats( mem_heap->Msize( ptr ) );
+#if USE_THREAD_HEAP
+	mem_heap->ThreadFree( ptr );
+#else
  	mem_heap->Free( ptr );
+#endif
 }
 
 /*
@@ -1108,12 +1693,12 @@ void *Mem_Alloc16( const int size ) {
 #ifdef CRASH_ON_STATIC_ALLOCATION
 		*((int*)0x0) = 1;
 #endif
-		return malloc( size );
+		return Mem_TagBlock( malloc( size + MEM_TAG_HEADER_SIZE16 ), size, MEM_TAG_HEADER_SIZE16 );
 	}
-	void *mem = mem_heap->Allocate16( size );
+	void *mem = mem_heap->Allocate16( size + MEM_TAG_HEADER_SIZE16 );
 	// make sure the memory is 16 byte aligned
 	assert( ( ((int)mem) & 15) == 0 );
-	return mem;
+	return Mem_TagBlock( mem, size, MEM_TAG_HEADER_SIZE16 );
 }
 
 /*
@@ -1125,6 +1710,7 @@ void Mem_Free16( void *ptr ) {
 	if ( !ptr ) {
 		return;
 	}
+	ptr = Mem_UntagBlock( ptr, MEM_TAG_HEADER_SIZE16 );
 	if ( !mem_heap ) {
 #ifdef CRASH_ON_STATIC_ALLOCATION
 		*((int*)0x0) = 1;
@@ -45,6 +45,22 @@ typedef struct {
 	int		totalSize;
 } memoryStats_t;
 
+// subsystems charged with the allocations made while their tag is set
+typedef enum {
+	MEMTAG_MISC,
+	MEMTAG_RENDERER,
+	MEMTAG_IMAGES,
+	MEMTAG_MODELS,
+	MEMTAG_COLLISION,
+	MEMTAG_AAS,
+	MEMTAG_SOUND,
+	MEMTAG_SCRIPT,
+	MEMTAG_DECLS,
+	MEMTAG_GAME,
+	MEMTAG_GUI,
+	MEMTAG_MAX
+} memTag_t;
+
 
 void		Mem_Init( void );
 void		Mem_Shutdown( void );
@@ -52,9 +68,13 @@ void		Mem_EnableLeakTest( const char *name );
 void		Mem_ClearFrameStats( void );
 void		Mem_GetFrameStats( memoryStats_t &allocs, memoryStats_t &frees );
 void		Mem_GetStats( memoryStats_t &stats );
+bool		Mem_GetThreadStats( int threadNum, memoryStats_t &stats, int &cachedBytes );	// only with USE_THREAD_HEAP
+bool		Mem_ThreadSafe( void );
 void		Mem_Dump_f( const class idCmdArgs &args );
 void		Mem_DumpCompressed_f( const class idCmdArgs &args );
 void		Mem_AllocDefragBlock( void );
+memTag_t	Mem_SetTag( memTag_t tag );			// sets the tag of the calling thread and returns the previous one
+void		Mem_Tags_f( const class idCmdArgs &args );
 
 
 #ifndef ID_DEBUG_MEMORY
@@ -134,6 +154,16 @@ __inline void operator delete[]( void *p ) {
 
 #endif /* ID_DEBUG_MEMORY */
 
+// tags the allocations of the calling thread while in scope
+class idScopedMemTag {
+public:
+					idScopedMemTag( memTag_t tag ) { previous = Mem_SetTag( tag ); }
+					~idScopedMemTag( void ) { Mem_SetTag( previous ); }
+
+private:
+	memTag_t		previous;
+};
+
 
 /*
 ===============================================================================
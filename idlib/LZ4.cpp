@@ -0,0 +1,265 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+
+#include "precompiled.h"
+#pragma hdrstop
+
+/*
+	A block is a sequence of sequences. Each starts with a token byte, the
+	high nibble is the literal count and the low nibble the match length
+	minus LZ4_MIN_MATCH. A nibble of 15 continues in the following bytes,
+	each adding up to 255. The literals follow, then the match offset as a
+	little endian short. The last sequence only has literals.
+*/
+
+const int LZ4_MIN_MATCH			= 4;
+const int LZ4_LAST_LITERALS		= 5;		// the block always ends in at least this many literals
+const int LZ4_MATCH_LIMIT		= 12;		// the last match starts at least this far from the end
+const int LZ4_MAX_OFFSET		= 65535;
+const int LZ4_HASH_BITS			= 12;
+const int LZ4_SKIP_SHIFT		= 6;		// step up the search in incompressible data
+
+/*
+============
+LZ4_Read32
+============
+*/
+static ID_INLINE unsigned int LZ4_Read32( const byte *p ) {
+	unsigned int v;
+	memcpy( &v, p, sizeof( v ) );
+	return v;
+}
+
+/*
+============
+LZ4_Hash
+============
+*/
+static ID_INLINE int LZ4_Hash( unsigned int sequence ) {
+	return ( sequence * 2654435761U ) >> ( 32 - LZ4_HASH_BITS );
+}
+
+/*
+============
+LZ4_WriteLength
+
+  writes the part of a length that didn't fit into its nibble
+============
+*/
+static ID_INLINE byte *LZ4_WriteLength( byte *op, int length ) {
+	for ( length -= 15; length >= 255; length -= 255 ) {
+		*op++ = 255;
+	}
+	*op++ = (byte)length;
+	return op;
+}
+
+/*
+============
+LZ4_ReadLength
+
+  returns -1 when the length runs past the end of the block or gets larger than limit
+============
+*/
+static ID_INLINE int LZ4_ReadLength( const byte *&ip, const byte *iend, int length, int limit ) {
+	int s;
+	do {
+		if ( ip >= iend ) {
+			return -1;
+		}
+		s = *ip++;
+		length += s;
+		if ( length > limit ) {
+			return -1;
+		}
+	} while ( s == 255 );
+	return length;
+}
+
+/*
+============
+idLZ4::Compress
+============
+*/
+int idLZ4::Compress( const byte *src, int srcSize, byte *dst, int dstSize ) {
+	int hashTable[1 << LZ4_HASH_BITS];
+	const byte *ip = src;
+	const byte *anchor = src;
+	const byte *iend = src + srcSize;
+	const byte *mflimit = iend - LZ4_MATCH_LIMIT;
+	const byte *matchlimit = iend - LZ4_LAST_LITERALS;
+	byte *op = dst;
+	byte *oend = dst + dstSize;
+
+	if ( srcSize < 0 ) {
+		return 0;
+	}
+
+	if ( srcSize > LZ4_MATCH_LIMIT ) {
+		memset( hashTable, 0, sizeof( hashTable ) );
+
+		while ( ip < mflimit ) {
+			unsigned int sequence = LZ4_Read32( ip );
+			int h = LZ4_Hash( sequence );
+			const byte *ref = src + hashTable[h];
+			hashTable[h] = ip - src;
+
+			if ( ref >= ip || ip - ref > LZ4_MAX_OFFSET || LZ4_Read32( ref ) != sequence ) {
+				ip += 1 + ( ( ip - anchor ) >> LZ4_SKIP_SHIFT );
+				continue;
+			}
+
+			// the match may start earlier
+			while ( ip > anchor && ref > src && ip[-1] == ref[-1] ) {
+				ip--;
+				ref--;
+			}
+
+			const byte *matchEnd = ip + LZ4_MIN_MATCH;
+			const byte *refEnd = ref + LZ4_MIN_MATCH;
+			while ( matchEnd < matchlimit && *matchEnd == *refEnd ) {
+				matchEnd++;
+				refEnd++;
+			}
+
+			int literals = ip - anchor;
+			int matchLength = matchEnd - ip - LZ4_MIN_MATCH;
+
+			if ( op + 1 + literals + literals / 255 + 1 + 2 + matchLength / 255 + 1 > oend ) {
+				return 0;
+			}
+
+			byte *token = op++;
+			if ( literals >= 15 ) {
+				*token = 15 << 4;
+				op = LZ4_WriteLength( op, literals );
+			} else {
+				*token = literals << 4;
+			}
+			memcpy( op, anchor, literals );
+			op += literals;
+
+			int offset = ip - ref;
+			*op++ = offset & 255;
+			*op++ = offset >> 8;
+
+			if ( matchLength >= 15 ) {
+				*token |= 15;
+				op = LZ4_WriteLength( op, matchLength );
+			} else {
+				*token |= matchLength;
+			}
+
+			ip = anchor = matchEnd;
+
+			// the bytes right before the next search are likely to be matched later on
+			if ( ip < mflimit ) {
+				hashTable[LZ4_Hash( LZ4_Read32( ip - 2 ) )] = ip - 2 - src;
+			}
+		}
+	}
+
+	// the rest are literals
+	int literals = iend - anchor;
+	if ( op + 1 + literals + literals / 255 + 1 > oend ) {
+		return 0;
+	}
+	if ( literals >= 15 ) {
+		*op++ = 15 << 4;
+		op = LZ4_WriteLength( op, literals );
+	} else {
+		*op++ = literals << 4;
+	}
+	memcpy( op, anchor, literals );
+	op += literals;
+
+	return op - dst;
+}
+
+/*
+============
+idLZ4::Decompress
+============
+*/
+int idLZ4::Decompress( const byte *src, int srcSize, byte *dst, int dstSize ) {
+	const byte *ip = src;
+	const byte *iend = src + srcSize;
+	byte *op = dst;
+	byte *oend = dst + dstSize;
+
+	while ( 1 ) {
+		if ( ip >= iend ) {
+			return -1;
+		}
+		int token = *ip++;
+
+		int literals = token >> 4;
+		if ( literals == 15 ) {
+			literals = LZ4_ReadLength( ip, iend, literals, dstSize );
+			if ( literals < 0 ) {
+				return -1;
+			}
+		}
+		if ( literals > oend - op || literals > iend - ip ) {
+			return -1;
+		}
+		memcpy( op, ip, literals );
+		op += literals;
+		ip += literals;
+
+		if ( ip == iend ) {
+			break;
+		}
+
+		if ( iend - ip < 2 ) {
+			return -1;
+		}
+		int offset = ip[0] | ( ip[1] << 8 );
+		ip += 2;
+		if ( offset == 0 || offset > op - dst ) {
+			return -1;
+		}
+
+		int matchLength = token & 15;
+		if ( matchLength == 15 ) {
+			matchLength = LZ4_ReadLength( ip, iend, matchLength, dstSize );
+			if ( matchLength < 0 ) {
+				return -1;
+			}
+		}
+		matchLength += LZ4_MIN_MATCH;
+		if ( matchLength > oend - op ) {
+			return -1;
+		}
+
+		// the match may overlap the bytes it writes, which repeats them
+		const byte *ref = op - offset;
+		if ( offset >= matchLength ) {
+			memcpy( op, ref, matchLength );
+			op += matchLength;
+		} else {
+			for ( int i = 0; i < matchLength; i++ ) {
+				*op++ = *ref++;
+			}
+		}
+	}
+
+	return op - dst;
+}
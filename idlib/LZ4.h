@@ -0,0 +1,56 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+
+#ifndef __LZ4_H__
+#define __LZ4_H__
+
+/*
+===============================================================================
+
+	LZ4 block compression
+
+	Compresses a buffer into a single block of the LZ4 block format: byte
+	aligned literal runs and matches into a 64 kB window, without entropy
+	coding. Much faster to compress and decompress than the idCompressor
+	codecs or zlib, at a somewhat larger size.
+
+	The functions only use the stack and may be called from any thread.
+	Streams of blocks are built on top, see idCompressor::AllocLZ4.
+
+===============================================================================
+*/
+
+class idLZ4 {
+public:
+							// worst case compressed size of size bytes
+	static int				CompressBound( int size );
+
+							// returns the compressed size, or 0 if it doesn't fit into dstSize
+	static int				Compress( const byte *src, int srcSize, byte *dst, int dstSize );
+
+							// returns the decompressed size, or -1 if the block is corrupt or doesn't fit into dstSize
+	static int				Decompress( const byte *src, int srcSize, byte *dst, int dstSize );
+};
+
+ID_INLINE int idLZ4::CompressBound( int size ) {
+	return size + size / 255 + 16;
+}
+
+#endif /* !__LZ4_H__ */
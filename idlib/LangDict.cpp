@@ -32,6 +32,7 @@ idLangDict::idLangDict( void ) {
 	args.SetGranularity( 256 );
 	hash.SetGranularity( 256 );
 	hash.Clear( 4096, 8192 );
+	idIndex.SetGranularity( 4096 );
 	baseID = 0;
 }
 
@@ -52,6 +53,7 @@ idLangDict::Clear
 void idLangDict::Clear( void ) {
 	args.Clear();
 	hash.Clear();
+	idIndex.Clear();
 }
 
 /*
@@ -99,7 +101,9 @@ bool idLangDict::Load( const char *fileName, const bool clear /* _D3XP */, const
 				kv.value.Remap( remapcount, remap );
 			}
 			assert( kv.key.Cmpn( STRTABLE_ID, STRTABLE_ID_LENGTH ) == 0 );
-			hash.Add( GetHashKey( kv.key ), args.Append( kv ) );
+			int index = args.Append( kv );
+			hash.Add( GetHashKey( kv.key ), index );
+			AddIndex( index );
 		}
 	}
 	idLib::common->Printf( "I18N: %i strings read from %s\n", args.Num(), fileName );
@@ -155,6 +159,15 @@ const char *idLangDict::GetString( const char *str, const bool dowarn ) const {
 		return str;
 	}
 
+	// keys like "#str_2000" and "#str_02000" share a number, so the indexed one is compared as well
+	int id = GetKeyId( str );
+	if ( id >= 0 && id < idIndex.Num() ) {
+		int i = idIndex[id];
+		if ( i != -1 && args[i].key.Cmp( str ) == 0 ) {
+			return args[i].value;
+		}
+	}
+
 	int hashKey = GetHashKey( str );
 	for ( int i = hash.First( hashKey ); i != -1; i = hash.Next( i ) ) {
 		if ( args[i].key.Cmp( str ) == 0 ) {
@@ -196,6 +209,7 @@ const char *idLangDict::AddString( const char *str ) {
 	c = args.Append( kv );
 	assert( kv.key.Cmpn( STRTABLE_ID, STRTABLE_ID_LENGTH ) == 0 );
 	hash.Add( GetHashKey( kv.key ), c );
+	AddIndex( c );
 	return args[c].key;
 }
 
@@ -227,7 +241,53 @@ void idLangDict::AddKeyVal( const char *key, const char *val ) {
 	kv.key = key;
 	kv.value = val;
 	assert( kv.key.Cmpn( STRTABLE_ID, STRTABLE_ID_LENGTH ) == 0 );
-	hash.Add( GetHashKey( kv.key ), args.Append( kv ) );
+	int index = args.Append( kv );
+	hash.Add( GetHashKey( kv.key ), index );
+	AddIndex( index );
+}
+
+/*
+============
+idLangDict::AddIndex
+
+The latest key with a number wins, like the head of its hash chain does
+============
+*/
+void idLangDict::AddIndex( int index ) {
+	int id = GetKeyId( args[index].key );
+	if ( id < 0 || id >= LANGDICT_MAX_INDEXED_ID ) {
+		return;
+	}
+	idIndex.AssureSize( id + 1, -1 );
+	idIndex[id] = index;
+}
+
+/*
+============
+idLangDict::GetKeyId
+
+Returns the number of a "#str_xxxxx" key, or -1 if it isn't one or the number is too large to index
+============
+*/
+int idLangDict::GetKeyId( const char *str ) const {
+	if ( idStr::Cmpn( str, STRTABLE_ID, STRTABLE_ID_LENGTH ) != 0 ) {
+		return -1;
+	}
+	str += STRTABLE_ID_LENGTH;
+	if ( str[0] == '\0' ) {
+		return -1;
+	}
+	int id = 0;
+	for ( ; str[0] != '\0'; str++ ) {
+		if ( str[0] < '0' || str[0] > '9' ) {
+			return -1;
+		}
+		id = id * 10 + str[0] - '0';
+		if ( id >= LANGDICT_MAX_INDEXED_ID ) {
+			return -1;
+		}
+	}
+	return id;
 }
 
 /*
@@ -318,6 +378,6 @@ idLangDict::Print
 */
 void idLangDict::Print( void ) const {
 	int c = args.Num();
-	idLib::common->Printf("idLangDict: %li KB in %i entries.\n", static_cast<long>(args.Size() + hash.Size()) >> 10l, c);
+	idLib::common->Printf("idLangDict: %li KB in %i entries.\n", static_cast<long>(args.Size() + hash.Size() + idIndex.Size()) >> 10l, c);
 	//hash.Print();
 }
@@ -26,9 +26,15 @@
 
 	Simple dictionary specifically for the localized string tables.
 
+	The keys are "#str_" followed by a number. Keys with a number below
+	LANGDICT_MAX_INDEXED_ID are looked up in a table indexed by the number,
+	the others through the hash.
+
 ===============================================================================
 */
 
+const int LANGDICT_MAX_INDEXED_ID = 1 << 18;
+
 class idLangKeyValue {
 public:
 	idStr					key;
@@ -64,6 +70,10 @@ public:
 private:
 	idList<idLangKeyValue>	args;
 	idHashIndex				hash;
+	idList<int>				idIndex;			// index into args by the number of the key, -1 for unused numbers
+
+	void					AddIndex( int index );
+	int						GetKeyId( const char *str ) const;
 
 	bool					ExcludeString( const char *str ) const;
 	int						GetNextId( void ) const;
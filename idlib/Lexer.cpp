@@ -1215,6 +1215,113 @@ const char*	idLexer::ReadRestOfLine(idStr& out) {
 }
 
 
+/*
+================
+idLexer::ReadPlainNumber
+
+Fast path of the number parsing for the text formats which are mostly numbers.
+Reads a decimal number, with a minus sign directly in front of it, straight from
+the script without filling in a token. The value is computed the same way as
+idToken::NumberValue does. Returns 0 without reading anything if the next token
+is not such a number, then the number has to be read with ReadToken.
+================
+*/
+int idLexer::ReadPlainNumber( bool integer, double &floatValue, int &intValue ) {
+	const char *start_p, *p;
+	int startLine, dot, exponent;
+	bool negative;
+	char c;
+
+	if ( !loaded || tokenavailable || ( idLexer::flags & LEXFL_ONLYSTRINGS ) ) {
+		return 0;
+	}
+
+	start_p = idLexer::script_p;
+	startLine = idLexer::line;
+	if ( !ReadWhiteSpace() ) {
+		idLexer::script_p = start_p;
+		idLexer::line = startLine;
+		return 0;
+	}
+
+	p = idLexer::script_p;
+	negative = ( *p == '-' );
+	if ( negative ) {
+		p++;
+	}
+
+	// leading zeros are octal, hexadecimal or binary numbers
+	if ( *p < '0' || *p > '9' || ( *p == '0' && p[1] >= '0' && p[1] <= '9' ) ) {
+		idLexer::script_p = start_p;
+		idLexer::line = startLine;
+		return 0;
+	}
+
+	unsigned long intvalue = 0;
+	double floatvalue = 0.0;
+	for ( c = *p; c >= '0' && c <= '9'; c = *++p ) {
+		intvalue = intvalue * 10 + ( c - '0' );
+		floatvalue = floatvalue * 10.0 + (double) ( c - '0' );
+	}
+
+	dot = 0;
+	exponent = 0;
+	if ( !integer ) {
+		if ( c == '.' ) {
+			dot = 1;
+			double m = 0.1;
+			for ( c = *++p; c >= '0' && c <= '9'; c = *++p ) {
+				floatvalue = floatvalue + (double) ( c - '0' ) * m;
+				m *= 0.1;
+			}
+		}
+		if ( c == 'e' ) {
+			bool div = false;
+			int pow = 0;
+			c = *++p;
+			if ( c == '-' ) {
+				div = true;
+				c = *++p;
+			} else if ( c == '+' ) {
+				c = *++p;
+			}
+			for ( ; c >= '0' && c <= '9'; c = *++p ) {
+				pow = pow * 10 + ( c - '0' );
+			}
+			double m = 1.0;
+			for ( int i = 0; i < pow; i++ ) {
+				m *= 10.0;
+			}
+			if ( div ) {
+				floatvalue /= m;
+			} else {
+				floatvalue *= m;
+			}
+			exponent = 1;
+		}
+	}
+
+	// anything glued to the number, like a second dot, a suffix or 1.#INF, goes the slow way
+	if ( c > ' ' && c != ')' && c != '(' && c != '}' && c != '{' && c != ']' && c != '[' && c != ',' && c != ';' ) {
+		idLexer::script_p = start_p;
+		idLexer::line = startLine;
+		return 0;
+	}
+
+	if ( !dot && !exponent ) {
+		floatvalue = intvalue;
+	}
+	floatValue = negative ? -floatvalue : floatvalue;
+	intValue = negative ? -( (signed int) intvalue ) : (int) intvalue;
+
+	idLexer::lastScript_p = start_p;
+	idLexer::lastline = startLine;
+	idLexer::whiteSpaceStart_p = start_p;
+	idLexer::whiteSpaceEnd_p = idLexer::script_p;
+	idLexer::script_p = p;
+	return 1;
+}
+
 /*
 ================
 idLexer::ParseInt
@@ -1222,6 +1329,12 @@ idLexer::ParseInt
 */
 int idLexer::ParseInt( void ) {
 	idToken token;
+	double floatValue;
+	int intValue;
+
+	if ( ReadPlainNumber( true, floatValue, intValue ) ) {
+		return intValue;
+	}
 
 	if ( !idLexer::ReadToken( &token ) ) {
 		idLexer::Error( "couldn't read expected integer" );
@@ -1259,11 +1372,17 @@ idLexer::ParseFloat
 */
 float idLexer::ParseFloat( bool *errorFlag ) {
 	idToken token;
+	double floatValue;
+	int intValue;
 
 	if ( errorFlag ) {
 		*errorFlag = false;
 	}
 
+	if ( ReadPlainNumber( false, floatValue, intValue ) ) {
+		return (float) floatValue;
+	}
+
 	if ( !idLexer::ReadToken( &token ) ) {
 		if ( errorFlag ) {
 			idLexer::Warning( "couldn't read expected floating point number" );
@@ -340,6 +340,7 @@ private:
 	int				ReadString( idToken *token, int quote );
 	int				ReadName( idToken *token );
 	int				ReadNumber( idToken *token );
+	int				ReadPlainNumber( bool integer, double &floatValue, int &intValue );
 	int				ReadPunctuation( idToken *token );
 	int				ReadPrimitive( idToken *token );
 	int				CheckString( const char *str ) const;
@@ -40,6 +40,7 @@ idSys *			idLib::sys			= NULL;
 idCommon *		idLib::common		= NULL;
 idCVarSystem *	idLib::cvarSystem	= NULL;
 idFileSystem *	idLib::fileSystem	= NULL;
+idPerfSuite *	idLib::perfSuite	= NULL;
 int				idLib::frameNumber	= 0;
 
 /*
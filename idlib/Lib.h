@@ -30,7 +30,8 @@
 
 	The interface pointers idSys, idCommon, idCVarSystem and idFileSystem
 	should be set before using idLib. The pointers stored here should not
-	be used by any part of the engine except for idLib.
+	be used by any part of the engine except for idLib. The idPerfSuite,
+	which the idLib benchmarks report to, may be left NULL.
 
 	The frameNumber should be continuously set to the number of the current
 	frame if frame base memory logging is required.
@@ -44,6 +45,7 @@ public:
 	static class idCommon *		common;
 	static class idCVarSystem *	cvarSystem;
 	static class idFileSystem *	fileSystem;
+	static class idPerfSuite *	perfSuite;
 	static int					frameNumber;
 
 	static void					Init( void );
@@ -216,6 +218,7 @@ public:
 #include "Lexer.h"
 #include "Parser.h"
 #include "Base64.h"
+#include "LZ4.h"
 #include "CmdArgs.h"
 
 // containers
@@ -223,6 +226,7 @@ public:
 #include "containers/BinSearch.h"
 #include "containers/HashIndex.h"
 #include "containers/HashTable.h"
+#include "containers/FlatHash.h"
 #include "containers/StaticList.h"
 #include "containers/LinkList.h"
 #include "containers/Hierarchy.h"
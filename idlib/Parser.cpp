@@ -996,6 +996,7 @@ int idParser::Directive_include( void ) {
 	script->SetFlags( idParser::flags );
 	script->SetPunctuations( idParser::punctuations );
 	idParser::PushScript( script );
+	includedFiles.AddUnique( script->GetFileName() );
 	return true;
 }
 
@@ -2765,6 +2766,16 @@ idParser::ParseInt
 */
 int idParser::ParseInt( void ) {
 	idToken token;
+	double floatValue;
+	int intValue;
+
+	// numbers are never directives or defines, read them directly while nothing needs preprocessing
+	if ( !idParser::tokens && !idParser::skip && idParser::scriptstack && idParser::scriptstack->ReadPlainNumber( true, floatValue, intValue ) ) {
+		if ( !marker_p ) {
+			marker_p = idParser::scriptstack->whiteSpaceEnd_p;
+		}
+		return intValue;
+	}
 
 	if ( !idParser::ReadToken( &token ) ) {
 		idParser::Error( "couldn't read expected integer" );
@@ -2802,6 +2813,16 @@ idParser::ParseFloat
 */
 float idParser::ParseFloat( void ) {
 	idToken token;
+	double floatValue;
+	int intValue;
+
+	// numbers are never directives or defines, read them directly while nothing needs preprocessing
+	if ( !idParser::tokens && !idParser::skip && idParser::scriptstack && idParser::scriptstack->ReadPlainNumber( false, floatValue, intValue ) ) {
+		if ( !marker_p ) {
+			marker_p = idParser::scriptstack->whiteSpaceEnd_p;
+		}
+		return (float) floatValue;
+	}
 
 	if ( !idParser::ReadToken( &token ) ) {
 		idParser::Error( "couldn't read expected floating point number" );
@@ -3113,6 +3134,7 @@ void idParser::FreeSource( bool keepDefines ) {
 			definehash = NULL;
 		}
 	}
+	includedFiles.Clear();
 	loaded = false;
 }
 
@@ -149,6 +149,8 @@ public:
 	int				GetFlags( void ) const;
 					// returns the current filename
 	const char *	GetFileName( void ) const;
+					// returns the files pulled in with #include since the source was loaded
+	const idList<idStr> &GetIncludedFiles( void ) const { return includedFiles; }
 					// get current offset in current script
 	const int		GetFileOffset( void ) const;
 					// get file time for current script
@@ -183,6 +185,7 @@ private:
 	indent_t *		indentstack;				// stack with indents
 	int				skip;						// > 0 if skipping conditional code
 	const char*		marker_p;
+	idList<idStr>	includedFiles;				// files included by the source
 
 	static define_t *globaldefines;				// list with global defines added to every source loaded
 
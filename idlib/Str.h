@@ -151,6 +151,7 @@ public:
 	void				Empty( void );
 	bool				IsEmpty( void ) const;
 	void				Clear( void );
+	void				Swap( idStr &other );								// swap contents, allocated buffers change owner without copying
 	void				Append( const char a );
 	void				Append( const idStr &text );
 	void				Append( const char *text );
@@ -703,6 +704,37 @@ ID_INLINE void idStr::Clear( void ) {
 	Init();
 }
 
+ID_INLINE void idStr::Swap( idStr &other ) {
+	if ( data != baseBuffer && other.data != other.baseBuffer ) {
+		idSwap( data, other.data );
+		idSwap( alloced, other.alloced );
+		idSwap( len, other.len );
+		return;
+	}
+	if ( data != baseBuffer ) {
+		other.Swap( *this );
+		return;
+	}
+
+	// this one uses the base buffer, copy its text into the base buffer of other
+	char	text[ STR_ALLOC_BASE ];
+	int		textLen = len;
+	memcpy( text, baseBuffer, textLen + 1 );
+
+	if ( other.data != other.baseBuffer ) {
+		data = other.data;
+		alloced = other.alloced;
+		len = other.len;
+	} else {
+		memcpy( baseBuffer, other.baseBuffer, other.len + 1 );
+		len = other.len;
+	}
+	other.data = other.baseBuffer;
+	other.alloced = STR_ALLOC_BASE;
+	memcpy( other.baseBuffer, text, textLen + 1 );
+	other.len = textLen;
+}
+
 ID_INLINE void idStr::Append( const char a ) {
 	EnsureAlloced( len + 2 );
 	data[ len ] = a;
@@ -1025,4 +1057,18 @@ ID_INLINE int idStr::DynamicMemoryUsed() const {
 	return ( data == baseBuffer ) ? 0 : alloced;
 }
 
+/*
+================
+idListRelocate<idStr>
+
+Lists of strings hand over the allocated buffers when they grow.
+================
+*/
+template<>
+class idListRelocate< idStr > {
+public:
+	enum { memcpyRelocate = 0 };
+	static void		Move( idStr &dst, idStr &src ) { dst.Swap( src ); }
+};
+
 #endif /* !__STR_H__ */
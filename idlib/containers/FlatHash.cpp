@@ -0,0 +1,187 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+/*
+================
+FlatHash_TestTime
+================
+*/
+static void FlatHash_TestTime( const char *name, const idTimer &timer, int count ) {
+	idLib::common->Printf( "%-28s %8.2f ms %8.1f ns/op\n", name, timer.Milliseconds(), timer.Milliseconds() * 1000000.0 / count );
+}
+
+/*
+================
+idFlatHash_Test_f
+
+Times idFlatHashMap and idFlatSet against idHashTable and idHashIndex.
+================
+*/
+void idFlatHash_Test_f( const idCmdArgs &args ) {
+	int num = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 16384;
+	if ( num <= 0 ) {
+		num = 16384;
+	}
+
+	idStrList keys;
+	keys.SetNum( num );
+	for ( int i = 0; i < num; i++ ) {
+		sprintf( keys[i], "key_%d_%x", i, i * 2654435761u );
+	}
+
+	idTimer timer;
+	int found;
+
+	idLib::common->SetRefreshOnPrint( true );
+	idLib::common->Printf( "%d keys\n", num );
+
+	// string keys
+	idHashTable<int> table;
+	timer.Clear();
+	timer.Start();
+	for ( int i = 0; i < num; i++ ) {
+		table.Set( keys[i], i );
+	}
+	timer.Stop();
+	FlatHash_TestTime( "idHashTable insert", timer, num );
+
+	idFlatHashMap<idStr, int> map;
+	timer.Clear();
+	timer.Start();
+	for ( int i = 0; i < num; i++ ) {
+		map.Set( keys[i], i );
+	}
+	timer.Stop();
+	FlatHash_TestTime( "idFlatHashMap insert", timer, num );
+
+	found = 0;
+	timer.Clear();
+	timer.Start();
+	for ( int i = 0; i < num; i++ ) {
+		int *value;
+		if ( table.Get( keys[i], &value ) && *value == i ) {
+			found++;
+		}
+	}
+	timer.Stop();
+	FlatHash_TestTime( "idHashTable find", timer, num );
+	if ( found != num ) {
+		idLib::common->Printf( "idHashTable found %d of %d keys\n", found, num );
+	}
+
+	found = 0;
+	timer.Clear();
+	timer.Start();
+	for ( int i = 0; i < num; i++ ) {
+		const int *value = map.Find( keys[i] );
+		if ( value && *value == i ) {
+			found++;
+		}
+	}
+	timer.Stop();
+	FlatHash_TestTime( "idFlatHashMap find", timer, num );
+	if ( found != num ) {
+		idLib::common->Printf( "idFlatHashMap found %d of %d keys\n", found, num );
+	}
+
+	timer.Clear();
+	timer.Start();
+	for ( int i = 0; i < num; i += 2 ) {
+		table.Remove( keys[i] );
+	}
+	timer.Stop();
+	FlatHash_TestTime( "idHashTable remove", timer, num / 2 );
+
+	timer.Clear();
+	timer.Start();
+	for ( int i = 0; i < num; i += 2 ) {
+		map.Remove( keys[i] );
+	}
+	timer.Stop();
+	FlatHash_TestTime( "idFlatHashMap remove", timer, num / 2 );
+
+	// the odd keys must be left, in insertion order
+	int expected = 1;
+	for ( int i = map.First(); i != -1; i = map.Next( i ), expected += 2 ) {
+		if ( map.GetValue( i ) != expected || map.Find( keys[expected] ) == NULL ) {
+			idLib::common->Printf( "idFlatHashMap iteration failed at %d\n", expected );
+			break;
+		}
+	}
+	if ( map.Num() != table.Num() ) {
+		idLib::common->Printf( "idFlatHashMap has %d keys, idHashTable %d\n", map.Num(), table.Num() );
+	}
+
+	idLib::common->Printf( "idHashTable %d kB, idFlatHashMap %d kB\n", (int)( table.Allocated() >> 10 ), (int)( map.Allocated() >> 10 ) );
+
+	// integer keys
+	idHashIndex index;
+	idList<int> values;
+	timer.Clear();
+	timer.Start();
+	for ( int i = 0; i < num; i++ ) {
+		const int key = i * 7919;
+		index.Add( idFlatHashMix( key ), values.Append( key ) );
+	}
+	timer.Stop();
+	FlatHash_TestTime( "idHashIndex insert", timer, num );
+
+	idFlatSet<int> set;
+	timer.Clear();
+	timer.Start();
+	for ( int i = 0; i < num; i++ ) {
+		set.Add( i * 7919 );
+	}
+	timer.Stop();
+	FlatHash_TestTime( "idFlatSet insert", timer, num );
+
+	found = 0;
+	timer.Clear();
+	timer.Start();
+	for ( int i = 0; i < num; i++ ) {
+		const int key = i * 7919;
+		for ( int j = index.First( idFlatHashMix( key ) ); j != -1; j = index.Next( j ) ) {
+			if ( values[j] == key ) {
+				found++;
+				break;
+			}
+		}
+	}
+	timer.Stop();
+	FlatHash_TestTime( "idHashIndex find", timer, num );
+
+	found = 0;
+	timer.Clear();
+	timer.Start();
+	for ( int i = 0; i < num; i++ ) {
+		if ( set.Has( i * 7919 ) ) {
+			found++;
+		}
+	}
+	timer.Stop();
+	FlatHash_TestTime( "idFlatSet find", timer, num );
+	if ( found != num ) {
+		idLib::common->Printf( "idFlatSet found %d of %d keys\n", found, num );
+	}
+
+	idLib::common->SetRefreshOnPrint( false );
+}
@@ -0,0 +1,489 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+
+#ifndef __FLATHASH_H__
+#define __FLATHASH_H__
+
+/*
+===============================================================================
+
+	Open addressing hash map and set.
+
+	The entries are stored in one array in insertion order and a power of two
+	table of entry indexes is probed linearly, so lookups touch little memory
+	and nothing is allocated per entry. Removed entries leave a hole in the
+	entry array which is compacted away later, iteration with First / Next
+	skips the holes and visits the entries in the order they were added.
+
+	Entry indexes stay valid until an entry is added or removed.
+
+===============================================================================
+*/
+
+/*
+================
+idFlatHashTraits<type>
+
+Hash and compare for the key types, other keys need a specialization.
+================
+*/
+ID_INLINE int idFlatHashMix( unsigned int h ) {
+	h ^= h >> 16;
+	h *= 0x85ebca6b;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35;
+	h ^= h >> 16;
+	return (int)( h & 0x7fffffff );
+}
+
+template< class type >
+class idFlatHashTraits {
+public:
+	static int		Hash( const type &key ) { return idFlatHashMix( (unsigned int)key ); }
+	static bool		Compare( const type &a, const type &b ) { return a == b; }
+};
+
+template< class type >
+class idFlatHashTraits< type * > {
+public:
+	static int		Hash( type * const &key ) { return idFlatHashMix( (unsigned int)( (size_t)key ^ ( (size_t)key >> 31 >> 1 ) ) ); }
+	static bool		Compare( type * const &a, type * const &b ) { return a == b; }
+};
+
+template<>
+class idFlatHashTraits< idStr > {
+public:
+	static int		Hash( const idStr &key ) { return idFlatHashMix( idStr::Hash( key.c_str() ) ); }
+	static bool		Compare( const idStr &a, const idStr &b ) { return a.Cmp( b ) == 0; }
+};
+
+/*
+===============================================================================
+
+	idFlatHashCore
+
+	Shared implementation, the entries have a key and a hash member.
+
+===============================================================================
+*/
+
+template< class Key, class Entry, class Traits >
+class idFlatHashCore {
+public:
+	int				Num( void ) const { return numEntries - numRemoved; }
+
+					// iteration in insertion order, -1 at the end
+	int				First( void ) const { return Next( -1 ); }
+	int				Next( int index ) const;
+
+					// makes room for the given number of entries without reallocating
+	void			Reserve( int num );
+	void			Clear( void );
+
+	size_t			Allocated( void ) const { return maxEntries * sizeof( Entry ) + numSlots * sizeof( int ); }
+
+protected:
+					idFlatHashCore( void );
+					idFlatHashCore( const idFlatHashCore &other );
+					~idFlatHashCore( void );
+
+	void			operator=( const idFlatHashCore &other );
+
+	int				FindEntry( const Key &key ) const;
+	int				FindOrAddEntry( const Key &key, bool &added );
+	bool			RemoveEntry( const Key &key );
+	void			SwapCore( idFlatHashCore &other );
+
+	Entry *			entries;
+	int				numEntries;			// including the removed ones
+	int				maxEntries;
+	int				numRemoved;
+
+private:
+	int *			slots;				// entry indexes, -1 for empty slots
+	int				numSlots;			// power of two, at least twice maxEntries
+
+	void			Resize( int newMaxEntries );
+	void			LinkEntry( int index );
+};
+
+template< class Key, class Entry, class Traits >
+ID_INLINE idFlatHashCore<Key,Entry,Traits>::idFlatHashCore( void ) {
+	entries = NULL;
+	numEntries = maxEntries = numRemoved = 0;
+	slots = NULL;
+	numSlots = 0;
+}
+
+template< class Key, class Entry, class Traits >
+ID_INLINE idFlatHashCore<Key,Entry,Traits>::idFlatHashCore( const idFlatHashCore &other ) {
+	entries = NULL;
+	numEntries = maxEntries = numRemoved = 0;
+	slots = NULL;
+	numSlots = 0;
+	*this = other;
+}
+
+template< class Key, class Entry, class Traits >
+ID_INLINE idFlatHashCore<Key,Entry,Traits>::~idFlatHashCore( void ) {
+	Clear();
+}
+
+template< class Key, class Entry, class Traits >
+ID_INLINE void idFlatHashCore<Key,Entry,Traits>::operator=( const idFlatHashCore &other ) {
+	if ( &other == this ) {
+		return;
+	}
+	Clear();
+	Reserve( other.Num() );
+	for ( int i = other.First(); i != -1; i = other.Next( i ) ) {
+		entries[numEntries] = other.entries[i];
+		LinkEntry( numEntries++ );
+	}
+}
+
+/*
+================
+idFlatHashCore::Next
+================
+*/
+template< class Key, class Entry, class Traits >
+ID_INLINE int idFlatHashCore<Key,Entry,Traits>::Next( int index ) const {
+	for ( index++; index < numEntries; index++ ) {
+		if ( entries[index].hash >= 0 ) {
+			return index;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+idFlatHashCore::Reserve
+================
+*/
+template< class Key, class Entry, class Traits >
+ID_INLINE void idFlatHashCore<Key,Entry,Traits>::Reserve( int num ) {
+	if ( num > maxEntries ) {
+		Resize( num );
+	}
+}
+
+/*
+================
+idFlatHashCore::Clear
+================
+*/
+template< class Key, class Entry, class Traits >
+ID_INLINE void idFlatHashCore<Key,Entry,Traits>::Clear( void ) {
+	delete[] entries;
+	delete[] slots;
+	entries = NULL;
+	numEntries = maxEntries = numRemoved = 0;
+	slots = NULL;
+	numSlots = 0;
+}
+
+/*
+================
+idFlatHashCore::FindEntry
+================
+*/
+template< class Key, class Entry, class Traits >
+ID_INLINE int idFlatHashCore<Key,Entry,Traits>::FindEntry( const Key &key ) const {
+	if ( !numSlots ) {
+		return -1;
+	}
+	const int hash = Traits::Hash( key );
+	const int mask = numSlots - 1;
+	for ( int s = hash & mask; slots[s] != -1; s = ( s + 1 ) & mask ) {
+		const Entry &entry = entries[slots[s]];
+		if ( entry.hash == hash && Traits::Compare( entry.key, key ) ) {
+			return slots[s];
+		}
+	}
+	return -1;
+}
+
+/*
+================
+idFlatHashCore::FindOrAddEntry
+================
+*/
+template< class Key, class Entry, class Traits >
+ID_INLINE int idFlatHashCore<Key,Entry,Traits>::FindOrAddEntry( const Key &key, bool &added ) {
+	int index = FindEntry( key );
+	if ( index != -1 ) {
+		added = false;
+		return index;
+	}
+
+	if ( numEntries == maxEntries ) {
+		// compact if enough was removed, grow otherwise
+		Resize( numRemoved > maxEntries / 4 ? maxEntries : ( maxEntries ? maxEntries * 2 : 16 ) );
+	}
+
+	index = numEntries++;
+	entries[index].key = key;
+	entries[index].hash = Traits::Hash( key );
+	LinkEntry( index );
+
+	added = true;
+	return index;
+}
+
+/*
+================
+idFlatHashCore::RemoveEntry
+================
+*/
+template< class Key, class Entry, class Traits >
+ID_INLINE bool idFlatHashCore<Key,Entry,Traits>::RemoveEntry( const Key &key ) {
+	if ( !numSlots ) {
+		return false;
+	}
+	const int hash = Traits::Hash( key );
+	const int mask = numSlots - 1;
+	int s;
+	for ( s = hash & mask; slots[s] != -1; s = ( s + 1 ) & mask ) {
+		const Entry &entry = entries[slots[s]];
+		if ( entry.hash == hash && Traits::Compare( entry.key, key ) ) {
+			break;
+		}
+	}
+	if ( slots[s] == -1 ) {
+		return false;
+	}
+
+	// release whatever the entry holds and leave a hole
+	const int index = slots[s];
+	entries[index] = Entry();
+	entries[index].hash = -1;
+	if ( index == numEntries - 1 ) {
+		numEntries--;
+	} else {
+		numRemoved++;
+	}
+
+	// shift back the following entries of the probe sequence which may no longer be reachable
+	for ( int next = ( s + 1 ) & mask; slots[next] != -1; next = ( next + 1 ) & mask ) {
+		const int home = entries[slots[next]].hash & mask;
+		if ( ( ( next - home ) & mask ) >= ( ( next - s ) & mask ) ) {
+			slots[s] = slots[next];
+			s = next;
+		}
+	}
+	slots[s] = -1;
+
+	return true;
+}
+
+/*
+================
+idFlatHashCore::SwapCore
+================
+*/
+template< class Key, class Entry, class Traits >
+ID_INLINE void idFlatHashCore<Key,Entry,Traits>::SwapCore( idFlatHashCore &other ) {
+	idSwap( entries, other.entries );
+	idSwap( numEntries, other.numEntries );
+	idSwap( maxEntries, other.maxEntries );
+	idSwap( numRemoved, other.numRemoved );
+	idSwap( slots, other.slots );
+	idSwap( numSlots, other.numSlots );
+}
+
+/*
+================
+idFlatHashCore::Resize
+
+Reallocates the entries without the holes and rebuilds the slots.
+================
+*/
+template< class Key, class Entry, class Traits >
+ID_INLINE void idFlatHashCore<Key,Entry,Traits>::Resize( int newMaxEntries ) {
+	Entry *oldEntries = entries;
+	const int oldNumEntries = numEntries;
+
+	maxEntries = newMaxEntries;
+	entries = new Entry[maxEntries];
+	numEntries = 0;
+	for ( int i = 0; i < oldNumEntries; i++ ) {
+		if ( oldEntries[i].hash >= 0 ) {
+			entries[numEntries++] = oldEntries[i];
+		}
+	}
+	numRemoved = 0;
+	delete[] oldEntries;
+
+	const int newNumSlots = idMath::CeilPowerOfTwo( maxEntries * 2 );
+	if ( newNumSlots != numSlots ) {
+		delete[] slots;
+		numSlots = newNumSlots;
+		slots = new int[numSlots];
+	}
+	memset( slots, -1, numSlots * sizeof( int ) );
+	for ( int i = 0; i < numEntries; i++ ) {
+		LinkEntry( i );
+	}
+}
+
+/*
+================
+idFlatHashCore::LinkEntry
+================
+*/
+template< class Key, class Entry, class Traits >
+ID_INLINE void idFlatHashCore<Key,Entry,Traits>::LinkEntry( int index ) {
+	const int mask = numSlots - 1;
+	int s;
+	for ( s = entries[index].hash & mask; slots[s] != -1; s = ( s + 1 ) & mask ) {
+	}
+	slots[s] = index;
+}
+
+/*
+===============================================================================
+
+	idFlatHashMap
+
+===============================================================================
+*/
+
+template< class Key, class Value >
+struct idFlatHashMapEntry {
+	Key				key;
+	Value			value;
+	int				hash;				// -1 for removed entries
+
+					idFlatHashMapEntry( void ) : key(), value(), hash( -1 ) {}
+};
+
+template< class Key, class Value, class Traits = idFlatHashTraits<Key> >
+class idFlatHashMap : public idFlatHashCore< Key, idFlatHashMapEntry<Key, Value>, Traits > {
+public:
+					// adds the key or replaces its value
+	Value &			Set( const Key &key, const Value &value );
+					// returns the value of the key, adds a default constructed one if the key is missing
+	Value &			operator[]( const Key &key );
+					// returns NULL if the key is missing
+	Value *			Find( const Key &key );
+	const Value *	Find( const Key &key ) const;
+	bool			Get( const Key &key, Value **value = NULL );
+	bool			Remove( const Key &key );
+
+	void			DeleteContents( void );		// deletes the values, for maps of pointers
+	void			Swap( idFlatHashMap &other ) { this->SwapCore( other ); }
+
+					// the entry at an index from First / Next
+	const Key &		GetKey( int index ) const { return this->entries[index].key; }
+	Value &			GetValue( int index ) { return this->entries[index].value; }
+	const Value &	GetValue( int index ) const { return this->entries[index].value; }
+};
+
+template< class Key, class Value, class Traits >
+ID_INLINE Value &idFlatHashMap<Key,Value,Traits>::Set( const Key &key, const Value &value ) {
+	bool added;
+	const int index = this->FindOrAddEntry( key, added );	// may reallocate the entries
+	this->entries[index].value = value;
+	return this->entries[index].value;
+}
+
+template< class Key, class Value, class Traits >
+ID_INLINE Value &idFlatHashMap<Key,Value,Traits>::operator[]( const Key &key ) {
+	bool added;
+	const int index = this->FindOrAddEntry( key, added );
+	return this->entries[index].value;
+}
+
+template< class Key, class Value, class Traits >
+ID_INLINE Value *idFlatHashMap<Key,Value,Traits>::Find( const Key &key ) {
+	const int index = this->FindEntry( key );
+	return ( index != -1 ) ? &this->entries[index].value : NULL;
+}
+
+template< class Key, class Value, class Traits >
+ID_INLINE const Value *idFlatHashMap<Key,Value,Traits>::Find( const Key &key ) const {
+	const int index = this->FindEntry( key );
+	return ( index != -1 ) ? &this->entries[index].value : NULL;
+}
+
+template< class Key, class Value, class Traits >
+ID_INLINE bool idFlatHashMap<Key,Value,Traits>::Get( const Key &key, Value **value ) {
+	Value *v = Find( key );
+	if ( value ) {
+		*value = v;
+	}
+	return ( v != NULL );
+}
+
+template< class Key, class Value, class Traits >
+ID_INLINE bool idFlatHashMap<Key,Value,Traits>::Remove( const Key &key ) {
+	return this->RemoveEntry( key );
+}
+
+template< class Key, class Value, class Traits >
+ID_INLINE void idFlatHashMap<Key,Value,Traits>::DeleteContents( void ) {
+	for ( int i = this->First(); i != -1; i = this->Next( i ) ) {
+		delete this->entries[i].value;
+	}
+	this->Clear();
+}
+
+/*
+===============================================================================
+
+	idFlatSet
+
+===============================================================================
+*/
+
+template< class Key >
+struct idFlatSetEntry {
+	Key				key;
+	int				hash;				// -1 for removed entries
+
+					idFlatSetEntry( void ) : key(), hash( -1 ) {}
+};
+
+template< class Key, class Traits = idFlatHashTraits<Key> >
+class idFlatSet : public idFlatHashCore< Key, idFlatSetEntry<Key>, Traits > {
+public:
+					// returns true if the key was not in the set yet
+	bool			Add( const Key &key );
+	bool			Has( const Key &key ) const { return this->FindEntry( key ) != -1; }
+	bool			Remove( const Key &key ) { return this->RemoveEntry( key ); }
+
+	void			Swap( idFlatSet &other ) { this->SwapCore( other ); }
+
+					// the key at an index from First / Next
+	const Key &		GetKey( int index ) const { return this->entries[index].key; }
+};
+
+template< class Key, class Traits >
+ID_INLINE bool idFlatSet<Key,Traits>::Add( const Key &key ) {
+	bool added;
+	this->FindOrAddEntry( key, added );
+	return added;
+}
+
+void	idFlatHash_Test_f( const class idCmdArgs &args );
+
+#endif /* !__FLATHASH_H__ */
@@ -44,6 +44,8 @@ public:
 	size_t			Size( void ) const;
 
 	idHashIndex &	operator=( const idHashIndex &other );
+					// swap the contents of the hash indexes
+	void			Swap( idHashIndex &other );
 					// add an index to the hash, assumes the index has not yet been added to the hash
 	void			Add( const int key, const int index );
 					// remove an index from the hash
@@ -176,6 +178,21 @@ ID_INLINE idHashIndex &idHashIndex::operator=( const idHashIndex &other ) {
 	return *this;
 }
 
+/*
+================
+idHashIndex::Swap
+================
+*/
+ID_INLINE void idHashIndex::Swap( idHashIndex &other ) {
+	idSwap( hashSize, other.hashSize );
+	idSwap( hash, other.hash );
+	idSwap( indexSize, other.indexSize );
+	idSwap( indexChain, other.indexChain );
+	idSwap( granularity, other.granularity );
+	idSwap( hashMask, other.hashMask );
+	idSwap( lookupMask, other.lookupMask );
+}
+
 /*
 ================
 idHashIndex::Add
@@ -76,7 +76,82 @@ ID_INLINE void idSwap( type &a, type &b ) {
 	b = c;
 }
 
+/*
+================
+idListRelocate<type>
+
+Moves the elements when the list is reallocated or elements are shifted, the
+source element is left valid but with unspecified contents. Types owning memory
+specialize Move to hand it over instead of copying it, plain data types are
+declared with ID_LIST_MEMCPY_RELOCATE so that whole ranges are moved with memcpy.
+================
+*/
+template< class type >
+class idListRelocate {
+public:
+	enum { memcpyRelocate = 0 };
+	static void		Move( type &dst, type &src ) { dst = src; }
+};
+
 template< class type >
+class idListRelocate< type * > {
+public:
+	enum { memcpyRelocate = 1 };
+	static void		Move( type *&dst, type *&src ) { dst = src; }
+};
+
+#define ID_LIST_MEMCPY_RELOCATE( type )											\
+	template<> class idListRelocate< type > {									\
+	public:																		\
+		enum { memcpyRelocate = 1 };											\
+		static void		Move( type &dst, type &src ) { dst = src; }				\
+	};
+
+ID_LIST_MEMCPY_RELOCATE( bool )
+ID_LIST_MEMCPY_RELOCATE( char )
+ID_LIST_MEMCPY_RELOCATE( unsigned char )
+ID_LIST_MEMCPY_RELOCATE( short )
+ID_LIST_MEMCPY_RELOCATE( unsigned short )
+ID_LIST_MEMCPY_RELOCATE( int )
+ID_LIST_MEMCPY_RELOCATE( unsigned int )
+ID_LIST_MEMCPY_RELOCATE( float )
+ID_LIST_MEMCPY_RELOCATE( double )
+
+/*
+================
+idListMoveElements<type>
+
+Moves num elements to the non overlapping range dst.
+================
+*/
+template< class type >
+ID_INLINE void idListMoveElements( type *dst, type *src, int num ) {
+	if ( idListRelocate<type>::memcpyRelocate ) {
+		memcpy( dst, src, num * sizeof( type ) );
+		return;
+	}
+	for ( int i = 0; i < num; i++ ) {
+		idListRelocate<type>::Move( dst[i], src[i] );
+	}
+}
+
+/*
+================
+idListNewAllocator<type>
+
+Default storage of idList. Other allocators provide the same static functions,
+Free gets the number of elements passed to Alloc.
+================
+*/
+template< class type >
+class idListNewAllocator {
+public:
+	static type *	Alloc( int num ) { return new type[ num ]; }
+	static void		Free( type *ptr, int num ) { delete[] ptr; }
+};
+
+// the storage defaults to idListNewAllocator<type> in the forward declaration in sys_public.h
+template< class type, class storage >
 class idList {
 public:
 
@@ -84,8 +159,8 @@ public:
 	typedef type	new_t( void );
 
 					idList( int newgranularity = 16 );
-					idList( const idList<type> &other );
-					~idList<type>( void );
+					idList( const idList &other );
+					~idList( void );
 
 	void			Clear( void );										// clear the list
 	int				Num( void ) const;									// returns number of elements in list
@@ -97,7 +172,7 @@ public:
 	size_t			Size( void ) const;									// returns total size of allocated memory including size of list type
 	size_t			MemoryUsed( void ) const;							// returns size of the used elements in the list
 
-	idList<type> &	operator=( const idList<type> &other );
+	idList &		operator=( const idList &other );
 	const type &	operator[]( int index ) const;
 	type &			operator[]( int index );
 
@@ -113,9 +188,11 @@ public:
 	const type *	Ptr( void ) const;									// returns a pointer to the list
 	type &			Alloc( void );										// returns reference to a new data element at the end of the list
 	int				Append( const type & obj );							// append element
-	int				Append( const idList<type> &other );				// append list
+	int				AppendMove( type & obj );							// append element by moving it into the list, obj is left with unspecified contents
+	int				Append( const idList &other );						// append list
 	int				AddUnique( const type & obj );						// add unique element
 	int				Insert( const type & obj, int index = 0 );			// insert the element at the given index
+	int				InsertMove( type & obj, int index = 0 );			// insert the element by moving it into the list, obj is left with unspecified contents
 	int				FindIndex( const type & obj ) const;				// find the index for the given element
 	type *			Find( type const & obj ) const;						// find pointer to the given element
 	int				FindNull( void ) const;								// find the index for the first NULL pointer in the list
@@ -125,7 +202,7 @@ public:
 	bool			Remove( const type & obj );							// remove the element
 	void			Sort( cmp_t *compare = ( cmp_t * )&idListSortCompare<type> );
 	void			SortSubSection( int startIndex, int endIndex, cmp_t *compare = ( cmp_t * )&idListSortCompare<type> );
-	void			Swap( idList<type> &other );						// swap the contents of the lists
+	void			Swap( idList &other );								// swap the contents of the lists
 	void			DeleteContents( bool clear );						// delete the contents of the list
 
 private:
@@ -135,13 +212,27 @@ private:
 	type *			list;
 };
 
+/*
+================
+idListRelocate<idList>
+
+Lists of lists hand over their element arrays.
+================
+*/
+template< class type, class storage >
+class idListRelocate< idList<type, storage> > {
+public:
+	enum { memcpyRelocate = 0 };
+	static void		Move( idList<type, storage> &dst, idList<type, storage> &src ) { dst.Swap( src ); }
+};
+
 /*
 ================
 idList<type>::idList( int )
 ================
 */
-template< class type >
-ID_INLINE idList<type>::idList( int newgranularity ) {
+template< class type, class storage >
+ID_INLINE idList<type,storage>::idList( int newgranularity ) {
 	assert( newgranularity > 0 );
 
 	list		= NULL;
@@ -154,8 +245,8 @@ ID_INLINE idList<type>::idList( int newgranularity ) {
 idList<type>::idList( const idList<type> &other )
 ================
 */
-template< class type >
-ID_INLINE idList<type>::idList( const idList<type> &other ) {
+template< class type, class storage >
+ID_INLINE idList<type,storage>::idList( const idList<type,storage> &other ) {
 	list = NULL;
 	*this = other;
 }
@@ -165,8 +256,8 @@ ID_INLINE idList<type>::idList( const idList<type> &other ) {
 idList<type>::~idList<type>
 ================
 */
-template< class type >
-ID_INLINE idList<type>::~idList( void ) {
+template< class type, class storage >
+ID_INLINE idList<type,storage>::~idList( void ) {
 	Clear();
 }
 
@@ -177,10 +268,10 @@ idList<type>::Clear
 Frees up the memory allocated by the list.  Assumes that type automatically handles freeing up memory.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Clear( void ) {
+template< class type, class storage >
+ID_INLINE void idList<type,storage>::Clear( void ) {
 	if ( list ) {
-		delete[] list;
+		storage::Free( list, size );
 	}
 
 	list	= NULL;
@@ -200,8 +291,8 @@ the pointers are still valid when this function is called.  Function will set al
 list to NULL.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::DeleteContents( bool clear ) {
+template< class type, class storage >
+ID_INLINE void idList<type,storage>::DeleteContents( bool clear ) {
 	int i;
 
 	for( i = 0; i < num; i++ ) {
@@ -223,8 +314,8 @@ idList<type>::Allocated
 return total memory allocated for the list in bytes, but doesn't take into account additional memory allocated by type
 ================
 */
-template< class type >
-ID_INLINE size_t idList<type>::Allocated( void ) const {
+template< class type, class storage >
+ID_INLINE size_t idList<type,storage>::Allocated( void ) const {
 	return size * sizeof( type );
 }
 
@@ -235,9 +326,9 @@ idList<type>::Size
 return total size of list in bytes, but doesn't take into account additional memory allocated by type
 ================
 */
-template< class type >
-ID_INLINE size_t idList<type>::Size( void ) const {
-	return sizeof( idList<type> ) + Allocated();
+template< class type, class storage >
+ID_INLINE size_t idList<type,storage>::Size( void ) const {
+	return sizeof( idList<type,storage> ) + Allocated();
 }
 
 /*
@@ -245,8 +336,8 @@ ID_INLINE size_t idList<type>::Size( void ) const {
 idList<type>::MemoryUsed
 ================
 */
-template< class type >
-ID_INLINE size_t idList<type>::MemoryUsed( void ) const {
+template< class type, class storage >
+ID_INLINE size_t idList<type,storage>::MemoryUsed( void ) const {
 	return num * sizeof( *list );
 }
 
@@ -258,8 +349,8 @@ Returns the number of elements currently contained in the list.
 Note that this is NOT an indication of the memory allocated.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Num( void ) const {
+template< class type, class storage >
+ID_INLINE int idList<type,storage>::Num( void ) const {
 	return num;
 }
 
@@ -270,8 +361,8 @@ idList<type>::NumAllocated
 Returns the number of elements currently allocated for.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::NumAllocated( void ) const {
+template< class type, class storage >
+ID_INLINE int idList<type,storage>::NumAllocated( void ) const {
 	return size;
 }
 
@@ -282,8 +373,8 @@ idList<type>::SetNum
 Resize to the exact size specified irregardless of granularity
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::SetNum( int newnum, bool resize ) {
+template< class type, class storage >
+ID_INLINE void idList<type,storage>::SetNum( int newnum, bool resize ) {
 	assert( newnum >= 0 );
 	if ( resize || newnum > size ) {
 		Resize( newnum );
@@ -298,8 +389,8 @@ idList<type>::SetGranularity
 Sets the base size of the array and resizes the array to match.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::SetGranularity( int newgranularity ) {
+template< class type, class storage >
+ID_INLINE void idList<type,storage>::SetGranularity( int newgranularity ) {
 	int newsize;
 
 	assert( newgranularity > 0 );
@@ -322,8 +413,8 @@ idList<type>::GetGranularity
 Get the current granularity.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::GetGranularity( void ) const {
+template< class type, class storage >
+ID_INLINE int idList<type,storage>::GetGranularity( void ) const {
 	return granularity;
 }
 
@@ -334,8 +425,8 @@ idList<type>::Condense
 Resizes the array to exactly the number of elements it contains or frees up memory if empty.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Condense( void ) {
+template< class type, class storage >
+ID_INLINE void idList<type,storage>::Condense( void ) {
 	if ( list ) {
 		if ( num ) {
 			Resize( num );
@@ -350,13 +441,13 @@ ID_INLINE void idList<type>::Condense( void ) {
 idList<type>::Resize
 
 Allocates memory for the amount of elements requested while keeping the contents intact.
-Contents are copied using their = operator so that data is correnctly instantiated.
+Contents are moved with idListRelocate so that data is correnctly instantiated.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Resize( int newsize ) {
+template< class type, class storage >
+ID_INLINE void idList<type,storage>::Resize( int newsize ) {
 	type	*temp;
-	int		i;
+	int		oldSize;
 
 	assert( newsize >= 0 );
 
@@ -372,20 +463,21 @@ ID_INLINE void idList<type>::Resize( int newsize ) {
 	}
 
 	temp	= list;
+	oldSize	= size;
 	size	= newsize;
 	if ( size < num ) {
 		num = size;
 	}
 
-	// copy the old list into our new one
-	list = new type[ size ];
-	for( i = 0; i < num; i++ ) {
-		list[ i ] = temp[ i ];
+	// move the old list into our new one
+	list = storage::Alloc( size );
+	if ( temp ) {
+		idListMoveElements( list, temp, num );
 	}
 
 	// delete the old list if it exists
 	if ( temp ) {
-		delete[] temp;
+		storage::Free( temp, oldSize );
 	}
 }
 
@@ -394,13 +486,13 @@ ID_INLINE void idList<type>::Resize( int newsize ) {
 idList<type>::Resize
 
 Allocates memory for the amount of elements requested while keeping the contents intact.
-Contents are copied using their = operator so that data is correnctly instantiated.
+Contents are moved with idListRelocate so that data is correnctly instantiated.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Resize( int newsize, int newgranularity ) {
+template< class type, class storage >
+ID_INLINE void idList<type,storage>::Resize( int newsize, int newgranularity ) {
 	type	*temp;
-	int		i;
+	int		oldSize;
 
 	assert( newsize >= 0 );
 
@@ -414,20 +506,21 @@ ID_INLINE void idList<type>::Resize( int newsize, int newgranularity ) {
 	}
 
 	temp	= list;
+	oldSize	= size;
 	size	= newsize;
 	if ( size < num ) {
 		num = size;
 	}
 
-	// copy the old list into our new one
-	list = new type[ size ];
-	for( i = 0; i < num; i++ ) {
-		list[ i ] = temp[ i ];
+	// move the old list into our new one
+	list = storage::Alloc( size );
+	if ( temp ) {
+		idListMoveElements( list, temp, num );
 	}
 
 	// delete the old list if it exists
 	if ( temp ) {
-		delete[] temp;
+		storage::Free( temp, oldSize );
 	}
 }
 
@@ -438,8 +531,8 @@ idList<type>::AssureSize
 Makes sure the list has at least the given number of elements.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::AssureSize( int newSize ) {
+template< class type, class storage >
+ID_INLINE void idList<type,storage>::AssureSize( int newSize ) {
 	int newNum = newSize;
 
 	if ( newSize > size ) {
@@ -463,8 +556,8 @@ idList<type>::AssureSize
 Makes sure the list has at least the given number of elements and initialize any elements not yet initialized.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::AssureSize( int newSize, const type &initValue ) {
+template< class type, class storage >
+ID_INLINE void idList<type,storage>::AssureSize( int newSize, const type &initValue ) {
 	int newNum = newSize;
 
 	if ( newSize > size ) {
@@ -496,8 +589,8 @@ NOTE: This function can only be called on lists containing pointers. Calling it
 on non-pointer lists will cause a compiler error.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::AssureSizeAlloc( int newSize, new_t *allocator ) {
+template< class type, class storage >
+ID_INLINE void idList<type,storage>::AssureSizeAlloc( int newSize, new_t *allocator ) {
 	int newNum = newSize;
 
 	if ( newSize > size ) {
@@ -526,8 +619,8 @@ idList<type>::operator=
 Copies the contents and size attributes of another list.
 ================
 */
-template< class type >
-ID_INLINE idList<type> &idList<type>::operator=( const idList<type> &other ) {
+template< class type, class storage >
+ID_INLINE idList<type,storage> &idList<type,storage>::operator=( const idList<type,storage> &other ) {
 	int	i;
 
 	Clear();
@@ -537,7 +630,7 @@ ID_INLINE idList<type> &idList<type>::operator=( const idList<type> &other ) {
 	granularity	= other.granularity;
 
 	if ( size ) {
-		list = new type[ size ];
+		list = storage::Alloc( size );
 		for( i = 0; i < num; i++ ) {
 			list[ i ] = other.list[ i ];
 		}
@@ -554,8 +647,8 @@ Access operator.  Index must be within range or an assert will be issued in debu
 Release builds do no range checking.
 ================
 */
-template< class type >
-ID_INLINE const type &idList<type>::operator[]( int index ) const {
+template< class type, class storage >
+ID_INLINE const type &idList<type,storage>::operator[]( int index ) const {
 	assert( index >= 0 );
 	assert( index < num );
 
@@ -570,8 +663,8 @@ Access operator.  Index must be within range or an assert will be issued in debu
 Release builds do no range checking.
 ================
 */
-template< class type >
-ID_INLINE type &idList<type>::operator[]( int index ) {
+template< class type, class storage >
+ID_INLINE type &idList<type,storage>::operator[]( int index ) {
 	assert( index >= 0 );
 	assert( index < num );
 
@@ -589,8 +682,8 @@ Note: may return NULL if the list is empty.
 FIXME: Create an iterator template for this kind of thing.
 ================
 */
-template< class type >
-ID_INLINE type *idList<type>::Ptr( void ) {
+template< class type, class storage >
+ID_INLINE type *idList<type,storage>::Ptr( void ) {
 	return list;
 }
 
@@ -605,8 +698,8 @@ Note: may return NULL if the list is empty.
 FIXME: Create an iterator template for this kind of thing.
 ================
 */
-template< class type >
-const ID_INLINE type *idList<type>::Ptr( void ) const {
+template< class type, class storage >
+const ID_INLINE type *idList<type,storage>::Ptr( void ) const {
 	return list;
 }
 
@@ -615,10 +708,12 @@ const ID_INLINE type *idList<type>::Ptr( void ) const {
 idList<type>::Alloc
 
 Returns a reference to a new data element at the end of the list.
+Fill it in place instead of building a temporary for Append, the element
+may still hold the contents of a previously removed one.
 ================
 */
-template< class type >
-ID_INLINE type &idList<type>::Alloc( void ) {
+template< class type, class storage >
+ID_INLINE type &idList<type,storage>::Alloc( void ) {
 	if ( !list ) {
 		Resize( granularity );
 	}
@@ -646,8 +741,8 @@ possible Resize() call, which will relocate the entire list. The reference
 to the "old" memory location will be invalid and crashes are ahead.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Append( type const & obj ) {
+template< class type, class storage >
+ID_INLINE int idList<type,storage>::Append( type const & obj ) {
 	if ( !list ) {
 		Resize( granularity );
 	}
@@ -679,8 +774,8 @@ and inserts the supplied data into it.
 Returns the index of the new element.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Insert( type const & obj, int index ) {
+template< class type, class storage >
+ID_INLINE int idList<type,storage>::Insert( type const & obj, int index ) {
 	if ( !list ) {
 		Resize( granularity );
 	}
@@ -702,13 +797,66 @@ ID_INLINE int idList<type>::Insert( type const & obj, int index ) {
 		index = num;
 	}
 	for ( int i = num; i > index; --i ) {
-		list[i] = list[i-1];
+		idListRelocate<type>::Move( list[i], list[i-1] );
 	}
 	num++;
 	list[index] = obj;
 	return index;
 }
 
+/*
+================
+idList<type>::AppendMove
+
+Like Append, but moves obj into the list with idListRelocate instead of copying it.
+obj is left with unspecified contents.
+================
+*/
+template< class type, class storage >
+ID_INLINE int idList<type,storage>::AppendMove( type & obj ) {
+	type &dst = Alloc();
+	idListRelocate<type>::Move( dst, obj );
+	return num - 1;
+}
+
+/*
+================
+idList<type>::InsertMove
+
+Like Insert, but moves obj into the list with idListRelocate instead of copying it.
+obj is left with unspecified contents.
+================
+*/
+template< class type, class storage >
+ID_INLINE int idList<type,storage>::InsertMove( type & obj, int index ) {
+	if ( !list ) {
+		Resize( granularity );
+	}
+
+	if ( num == size ) {
+		int newsize;
+
+		if ( granularity == 0 ) {	// this is a hack to fix our memset classes
+			granularity = 16;
+		}
+		newsize = size + granularity;
+		Resize( newsize - newsize % granularity );
+	}
+
+	if ( index < 0 ) {
+		index = 0;
+	}
+	else if ( index > num ) {
+		index = num;
+	}
+	for ( int i = num; i > index; --i ) {
+		idListRelocate<type>::Move( list[i], list[i-1] );
+	}
+	num++;
+	idListRelocate<type>::Move( list[index], obj );
+	return index;
+}
+
 /*
 ================
 idList<type>::Append
@@ -718,8 +866,8 @@ adds the other list to this one
 Returns the size of the new combined list
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Append( const idList<type> &other ) {
+template< class type, class storage >
+ID_INLINE int idList<type,storage>::Append( const idList<type,storage> &other ) {
 
 	// Tels: Old code, with quadratic (O(N*N) performance, it would call Resize
 	// 	 every so often, which is a O(N) copy operation.
@@ -761,8 +909,8 @@ idList<type>::AddUnique
 Adds the data to the list if it doesn't already exist.  Returns the index of the data in the list.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::AddUnique( type const & obj ) {
+template< class type, class storage >
+ID_INLINE int idList<type,storage>::AddUnique( type const & obj ) {
 	int index;
 
 	index = FindIndex( obj );
@@ -780,8 +928,8 @@ idList<type>::FindIndex
 Searches for the specified data in the list and returns it's index.  Returns -1 if the data is not found.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::FindIndex( type const & obj ) const {
+template< class type, class storage >
+ID_INLINE int idList<type,storage>::FindIndex( type const & obj ) const {
 	int i;
 
 	for( i = 0; i < num; i++ ) {
@@ -801,8 +949,8 @@ idList<type>::Find
 Searches for the specified data in the list and returns it's address. Returns NULL if the data is not found.
 ================
 */
-template< class type >
-ID_INLINE type *idList<type>::Find( type const & obj ) const {
+template< class type, class storage >
+ID_INLINE type *idList<type,storage>::Find( type const & obj ) const {
 	int i;
 
 	i = FindIndex( obj );
@@ -823,8 +971,8 @@ NOTE: This function can only be called on lists containing pointers. Calling it
 on non-pointer lists will cause a compiler error.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::FindNull( void ) const {
+template< class type, class storage >
+ID_INLINE int idList<type,storage>::FindNull( void ) const {
 	int i;
 
 	for( i = 0; i < num; i++ ) {
@@ -847,8 +995,8 @@ Function will assert in debug builds if pointer is outside the bounds of the lis
 but remains silent in release builds.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::IndexOf( type const *objptr ) const {
+template< class type, class storage >
+ID_INLINE int idList<type,storage>::IndexOf( type const *objptr ) const {
 	int index;
 
 	index = objptr - list;
@@ -868,8 +1016,8 @@ The number of elements in the list is reduced by one.  Returns false if the inde
 Note that the element is not destroyed, so any memory used by it may not be freed until the destruction of the list.
 ================
 */
-template< class type >
-ID_INLINE bool idList<type>::RemoveIndex( int index ) {
+template< class type, class storage >
+ID_INLINE bool idList<type,storage>::RemoveIndex( int index ) {
 	int i;
 
 	assert( list != NULL );
@@ -882,7 +1030,7 @@ ID_INLINE bool idList<type>::RemoveIndex( int index ) {
 
 	num--;
 	for( i = index; i < num; i++ ) {
-		list[ i ] = list[ i + 1 ];
+		idListRelocate<type>::Move( list[ i ], list[ i + 1 ] );
 	}
 
 	return true;
@@ -898,8 +1046,8 @@ The number of elements in the list is reduced by one.  Returns false if the inde
 Note that the element is not destroyed, so any memory used by it may not be freed until the destruction of the list.
 ================
 */
-template< class type >
-ID_INLINE bool idList<type>::RemoveIndex( const int index, const bool keepSorted ) {
+template< class type, class storage >
+ID_INLINE bool idList<type,storage>::RemoveIndex( const int index, const bool keepSorted ) {
 
 	assert( list != NULL );
 	assert( index >= 0 );
@@ -914,7 +1062,7 @@ ID_INLINE bool idList<type>::RemoveIndex( const int index, const bool keepSorted
 	{
 		//gameLocal.Printf("Moving %i list entries (index = %i)\n", num - index, index );
 		for( int i = index; i < num; i++ ) {
-			list[ i ] = list[ i + 1 ];
+			idListRelocate<type>::Move( list[ i ], list[ i + 1 ] );
 		}
 	}
 	else
@@ -923,7 +1071,7 @@ ID_INLINE bool idList<type>::RemoveIndex( const int index, const bool keepSorted
 		// if index == num, we removed the last element, so nothing to do
 		if ( index < num )
 		{
-			list[ index ] = list[ num ];
+			idListRelocate<type>::Move( list[ index ], list[ num ] );
 		}
 	}
 
@@ -939,8 +1087,8 @@ The number of elements in the list is reduced by one.  Returns false if the data
 the element is not destroyed, so any memory used by it may not be freed until the destruction of the list.
 ================
 */
-template< class type >
-ID_INLINE bool idList<type>::Remove( type const & obj ) {
+template< class type, class storage >
+ID_INLINE bool idList<type,storage>::Remove( type const & obj ) {
 	int index;
 
 	index = FindIndex( obj );
@@ -959,8 +1107,8 @@ Performs a qsort on the list using the supplied comparison function.  Note that
 list, so any pointers to data within the list may no longer be valid.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Sort( cmp_t *compare ) {
+template< class type, class storage >
+ID_INLINE void idList<type,storage>::Sort( cmp_t *compare ) {
 	if ( !list ) {
 		return;
 	}
@@ -977,8 +1125,8 @@ idList<type>::SortSubSection
 Sorts a subsection of the list.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::SortSubSection( int startIndex, int endIndex, cmp_t *compare ) {
+template< class type, class storage >
+ID_INLINE void idList<type,storage>::SortSubSection( int startIndex, int endIndex, cmp_t *compare ) {
 	if ( !list ) {
 		return;
 	}
@@ -1004,8 +1152,8 @@ idList<type>::Swap
 Swaps the contents of two lists
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Swap( idList<type> &other ) {
+template< class type, class storage >
+ID_INLINE void idList<type,storage>::Swap( idList<type,storage> &other ) {
 	idSwap( num, other.num );
 	idSwap( size, other.size );
 	idSwap( granularity, other.granularity );
@@ -34,7 +34,7 @@ class idPoolStr : public idStr {
 	friend class idStrPool;
 
 public:
-						idPoolStr() { numUsers = 0; }
+						idPoolStr() { numUsers = 0; hash = 0; parsed = 0; }
 						~idPoolStr() { assert( numUsers == 0 ); }
 
 						// returns total size of allocated memory
@@ -43,12 +43,71 @@ public:
 	size_t				Size( void ) const { return sizeof( *this ) + Allocated(); }
 						// returns a pointer to the pool this string was allocated from
 	const idStrPool *	GetPool( void ) const { return pool; }
+						// idStr::Hash or idStr::IHash of the string depending on the case sensitivity of the pool
+	int					GetHash( void ) const { return hash; }
+
+						// the string parsed with atof, atoi and "%f %f %f", pool strings never
+						// change so the results are kept with the string
+	float				GetFloatValue( void ) const;
+	int					GetIntValue( void ) const;
+	const idVec3 &		GetVectorValue( void ) const;
 
 private:
+	enum {
+		PARSED_FLOAT	= BIT( 0 ),
+		PARSED_INT		= BIT( 1 ),
+		PARSED_VECTOR	= BIT( 2 )
+	};
+
 	idStrPool *			pool;
 	mutable int			numUsers;
+	int					hash;
+	mutable int			parsed;				// PARSED_* of the values below
+	mutable float		floatValue;
+	mutable int			intValue;
+	mutable idVec3		vectorValue;
 };
 
+/*
+================
+idPoolStr::GetFloatValue
+================
+*/
+ID_INLINE float idPoolStr::GetFloatValue( void ) const {
+	if ( !( parsed & PARSED_FLOAT ) ) {
+		floatValue = atof( c_str() );
+		parsed |= PARSED_FLOAT;
+	}
+	return floatValue;
+}
+
+/*
+================
+idPoolStr::GetIntValue
+================
+*/
+ID_INLINE int idPoolStr::GetIntValue( void ) const {
+	if ( !( parsed & PARSED_INT ) ) {
+		intValue = atoi( c_str() );
+		parsed |= PARSED_INT;
+	}
+	return intValue;
+}
+
+/*
+================
+idPoolStr::GetVectorValue
+================
+*/
+ID_INLINE const idVec3 &idPoolStr::GetVectorValue( void ) const {
+	if ( !( parsed & PARSED_VECTOR ) ) {
+		vectorValue.Zero();
+		sscanf( c_str(), "%f %f %f", &vectorValue.x, &vectorValue.y, &vectorValue.z );
+		parsed |= PARSED_VECTOR;
+	}
+	return vectorValue;
+}
+
 class idStrPool {
 public:
 						idStrPool() { caseSensitive = true; }
@@ -62,6 +121,8 @@ public:
 	const idPoolStr *	operator[]( int index ) const { return pool[index]; }
 
 	const idPoolStr *	AllocString( const char *string );
+						// returns the pool string without adding a user, NULL if the string is not in the pool
+	const idPoolStr *	FindString( const char *string ) const;
 	void				FreeString( const idPoolStr *poolStr );
 	const idPoolStr *	CopyString( const idPoolStr *poolStr );
 	void				Clear( void );
@@ -87,10 +148,11 @@ idStrPool::AllocString
 ================
 */
 ID_INLINE const idPoolStr *idStrPool::AllocString( const char *string ) {
-	int i, hash;
+	int i, hash, fullHash;
 	idPoolStr *poolStr;
 
-	hash = poolHash.GenerateKey( string, caseSensitive );
+	fullHash = caseSensitive ? idStr::Hash( string ) : idStr::IHash( string );
+	hash = poolHash.GenerateKey( fullHash, 0 );
 	if ( caseSensitive ) {
 		for ( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) ) {
 			if ( pool[i]->Cmp( string ) == 0 ) {
@@ -111,10 +173,37 @@ ID_INLINE const idPoolStr *idStrPool::AllocString( const char *string ) {
 	*static_cast<idStr *>(poolStr) = string;
 	poolStr->pool = this;
 	poolStr->numUsers = 1;
+	poolStr->hash = fullHash;
 	poolHash.Add( hash, pool.Append( poolStr ) );
 	return poolStr;
 }
 
+/*
+================
+idStrPool::FindString
+================
+*/
+ID_INLINE const idPoolStr *idStrPool::FindString( const char *string ) const {
+	int i, hash;
+
+	if ( caseSensitive ) {
+		hash = poolHash.GenerateKey( idStr::Hash( string ), 0 );
+		for ( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) ) {
+			if ( pool[i]->Cmp( string ) == 0 ) {
+				return pool[i];
+			}
+		}
+	} else {
+		hash = poolHash.GenerateKey( idStr::IHash( string ), 0 );
+		for ( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) ) {
+			if ( pool[i]->Icmp( string ) == 0 ) {
+				return pool[i];
+			}
+		}
+	}
+	return NULL;
+}
+
 /*
 ================
 idStrPool::FreeString
@@ -128,18 +217,10 @@ ID_INLINE void idStrPool::FreeString( const idPoolStr *poolStr ) {
 
 	poolStr->numUsers--;
 	if ( poolStr->numUsers <= 0 ) {
-		hash = poolHash.GenerateKey( poolStr->c_str(), caseSensitive );
-		if ( caseSensitive ) { 
-			for ( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) ) {
-				if ( pool[i]->Cmp( poolStr->c_str() ) == 0 ) {
-					break;
-				}
-			}
-		} else {
-			for ( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) ) {
-				if ( pool[i]->Icmp( poolStr->c_str() ) == 0 ) {
-					break;
-				}
+		hash = poolHash.GenerateKey( poolStr->hash, 0 );
+		for ( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) ) {
+			if ( pool[i] == poolStr ) {
+				break;
 			}
 		}
 		assert( i != -1 );
@@ -216,4 +297,97 @@ ID_INLINE size_t idStrPool::Size( void ) const {
 	return size;
 }
 
+/*
+===============================================================================
+
+	idInternStr
+
+	Handle to a string interned in a case sensitive pool shared by the module.
+	Handles of equal strings point to the same pool string, so they compare
+	with a pointer compare and the hash of the string is computed only once.
+
+	Handles must be released before the module shuts down.
+
+===============================================================================
+*/
+
+class idInternStr {
+public:
+						idInternStr( void ) { str = NULL; }
+	explicit			idInternStr( const char *text ) { str = NULL; Set( text ); }
+						idInternStr( const idInternStr &other ) { str = other.str ? pool.CopyString( other.str ) : NULL; }
+						~idInternStr( void ) { Clear(); }
+
+	idInternStr &		operator=( const idInternStr &other );
+	bool				operator==( const idInternStr &other ) const { return str == other.str; }
+	bool				operator!=( const idInternStr &other ) const { return str != other.str; }
+
+	void				Set( const char *text );
+	void				Clear( void );
+
+	bool				IsValid( void ) const { return str != NULL; }
+	const char *		c_str( void ) const { return str ? str->c_str() : ""; }
+						// idStr::Hash of the string
+	int					GetHash( void ) const { return str ? str->GetHash() : 0; }
+
+						// returns the handle of an interned string or an invalid handle, doesn't add the string
+	static idInternStr	Find( const char *text );
+	static int			NumInterned( void ) { return pool.Num(); }
+
+private:
+	const idPoolStr *	str;
+
+	static idStrPool	pool;
+};
+
+/*
+================
+idInternStr::operator=
+================
+*/
+ID_INLINE idInternStr &idInternStr::operator=( const idInternStr &other ) {
+	if ( str != other.str ) {
+		Clear();
+		str = other.str ? pool.CopyString( other.str ) : NULL;
+	}
+	return *this;
+}
+
+/*
+================
+idInternStr::Set
+================
+*/
+ID_INLINE void idInternStr::Set( const char *text ) {
+	const idPoolStr *newStr = ( text && text[0] ) ? pool.AllocString( text ) : NULL;
+	Clear();
+	str = newStr;
+}
+
+/*
+================
+idInternStr::Clear
+================
+*/
+ID_INLINE void idInternStr::Clear( void ) {
+	if ( str ) {
+		pool.FreeString( str );
+		str = NULL;
+	}
+}
+
+/*
+================
+idInternStr::Find
+================
+*/
+ID_INLINE idInternStr idInternStr::Find( const char *text ) {
+	idInternStr handle;
+	const idPoolStr *found = pool.FindString( text );
+	if ( found ) {
+		handle.str = pool.CopyString( found );
+	}
+	return handle;
+}
+
 #endif /* !__STRPOOL_H__ */
@@ -105,5 +105,7 @@ ID_INLINE void idDrawVert::ScaleToUnitNormal( void ) {
 	tangents[1] *= invNormLen;
 }
 
+ID_LIST_MEMCPY_RELOCATE( idDrawVert )
+
 
 #endif /* !__DRAWVERT_H__ */
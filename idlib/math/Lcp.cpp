@@ -255,9 +255,7 @@ void idLCP_Square::RemoveClamped( int r ) {
 		beta1 = z1[i] * diagonal[i];
 
 		clamped[i][r] += p0;
-		for ( j = i+1; j < numClamped; j++ ) {
-			z1[j] -= beta1 * clamped[i][j];
-		}
+		SIMDProcessor->MulSub( z1 + i + 1, beta1, clamped[i] + i + 1, numClamped - i - 1 );
 		for ( j = i+1; j < numClamped; j++ ) {
 			y0[j] -= p0 * clamped[j][i];
 		}
@@ -294,31 +292,9 @@ void idLCP_Square::RemoveClamped( int r ) {
 		clamped[i][i] = diag;
 		diagonal[i] = d;
 
-		for ( j = i+1; j < numClamped; j++ ) {
-
-			d = clamped[i][j];
-
-			d += p0 * z0[j];
-			z0[j] -= beta0 * d;
-
-			d += q0 * z1[j];
-			z1[j] -= beta1 * d;
-
-			clamped[i][j] = d;
-		}
-
-		for ( j = i+1; j < numClamped; j++ ) {
-
-			d = clamped[j][i];
-
-			y0[j] -= p0 * d;
-			d += beta0 * y0[j];
-
-			y1[j] -= q0 * d;
-			d += beta1 * y1[j];
-
-			clamped[j][i] = d;
-		}
+		// update row right of and column below diagonal (i,i)
+		SIMDProcessor->MatX_RankTwoUpdateRow( clamped[i] + i + 1, z0 + i + 1, z1 + i + 1, p0, beta0, q0, beta1, numClamped - i - 1 );
+		SIMDProcessor->MatX_RankTwoUpdateColumn( clamped[i+1] + i, clamped.GetNumColumns(), y0 + i + 1, y1 + i + 1, p0, beta0, q0, beta1, numClamped - i - 1 );
 	}
 	return;
 }
@@ -946,7 +922,7 @@ idLCP_Symmetric::RemoveClamped
 ============
 */
 void idLCP_Symmetric::RemoveClamped( int r ) {
-	int i, j, n;
+	int i, n;
 	float *addSub, *original, *v, *ptr, *v1, *v2, dot;
 	double sum, diag, newDiag, invNewDiag, p1, p2, alpha1, alpha2, beta1, beta2;
 
@@ -1024,11 +1000,8 @@ void idLCP_Symmetric::RemoveClamped( int r ) {
 			} else {
 				sum = clamped[r][r] * clamped[i][r];
 			}
-			ptr = clamped[i];
-			for ( j = 0; j < r; j++ ) {
-				sum += ptr[j] * v[j];
-			}
-			addSub[i] = rowPtrs[r][i] - sum;
+			SIMDProcessor->Dot( dot, clamped[i], v, r );
+			addSub[i] = rowPtrs[r][i] - ( sum + dot );
 		}
 	}
 
@@ -1081,41 +1054,8 @@ void idLCP_Symmetric::RemoveClamped( int r ) {
 		alpha2 *= diag;
 
 		// update column below diagonal (i,i)
-		ptr = clamped.ToFloatPtr() + i;
-
-		for ( j = i+1; j < numClamped - 1; j += 2 ) {
-
-			float sum0 = ptr[(j+0)*n];
-			float sum1 = ptr[(j+1)*n];
-
-			v1[j+0] -= p1 * sum0;
-			v1[j+1] -= p1 * sum1;
-
-			sum0 += beta1 * v1[j+0];
-			sum1 += beta1 * v1[j+1];
-
-			v2[j+0] -= p2 * sum0;
-			v2[j+1] -= p2 * sum1;
-
-			sum0 += beta2 * v2[j+0];
-			sum1 += beta2 * v2[j+1];
-
-			ptr[(j+0)*n] = sum0;
-			ptr[(j+1)*n] = sum1;
-		}
-
-		for ( ; j < numClamped; j++ ) {
-
-			sum = ptr[j*n];
-
-			v1[j] -= p1 * sum;
-			sum += beta1 * v1[j];
-
-			v2[j] -= p2 * sum;
-			sum += beta2 * v2[j];
-
-			ptr[j*n] = sum;
-		}
+		ptr = clamped.ToFloatPtr() + ( i + 1 ) * n + i;
+		SIMDProcessor->MatX_RankTwoUpdateColumn( ptr, n, v1 + i + 1, v2 + i + 1, p1, beta1, p2, beta2, numClamped - i - 1 );
 	}
 }
 
@@ -2030,9 +2030,10 @@ private:
 	int				alloced;				// floats allocated, if -1 then mat points to data set with SetData
 	float *			mat;					// memory the matrix is stored
 
-	static float	temp[MATX_MAX_TEMP+4];	// used to store intermediate results
-	static float *	tempPtr;				// pointer to 16 byte aligned temporary memory
-	static int		tempIndex;				// index into memory pool, wraps around
+	// the temporary memory is per thread, so that temporaries can be used on worker threads
+	static ID_THREAD_LOCAL float	temp[MATX_MAX_TEMP+4];	// used to store intermediate results
+	static ID_THREAD_LOCAL float *	tempPtr;	// pointer to 16 byte aligned temporary memory, set on first use
+	static ID_THREAD_LOCAL int		tempIndex;	// index into memory pool, wraps around
 
 private:
 	void			SetTempSize( int rows, int columns );
@@ -2322,6 +2323,9 @@ ID_INLINE void idMatX::SetTempSize( int rows, int columns ) {
 
 	newSize = ( rows * columns + 3 ) & ~3;
 	assert( newSize < MATX_MAX_TEMP );
+	if ( !idMatX::tempPtr ) {
+		idMatX::tempPtr = (float *) ( ( (int) idMatX::temp + 15 ) & ~15 );
+	}
 	if ( idMatX::tempIndex + newSize > MATX_MAX_TEMP ) {
 		idMatX::tempIndex = 0;
 	}
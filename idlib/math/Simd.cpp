@@ -29,6 +29,7 @@
 #include "Simd_SSE.h"
 #include "Simd_SSE2.h"
 #include "Simd_SSE3.h"
+#include "Simd_AVX.h"
 #include "Simd_AltiVec.h"
 
 idSIMDProcessor	*	processor = NULL;			// pointer to SIMD processor
@@ -139,13 +140,49 @@ void idSIMD::InitProcessor( const char *module, bool forceGeneric ) {
 	{
 		result += CPUID_SSE3;
 	}
+	// AVX needs the OS to save the YMM state (OSXSAVE and XCR0 bits 1 and 2)
+	if ( ((c >> 28) & 0x1) && ((c >> 27) & 0x1) )
+	{
+		dword xcr0;
+		__asm__ __volatile__ (
+			"	xorl	%%ecx, %%ecx;"		// XCR0
+			"	.byte	0x0f, 0x01, 0xd0;"	// XGETBV, returns data into edx:eax
+			: "=a" (xcr0)				// EAX => xcr0
+			:							// no inputs
+			: "%ecx", "%edx" );			// clobbers ECX and EDX
+
+		if ( ( xcr0 & 6 ) == 6 )
+		{
+			result += CPUID_AVX;
+			if ((c >> 12) & 0x1)
+			{
+				result += CPUID_FMA;
+			}
+
+			dword b7;
+			__asm__ __volatile__ (
+				"	pushl	%%ebx;"				// Save ebx (needed for PIC (position independend code)
+				"	movl	$7, %%eax;"			// CPUID with EAX = 7
+				"	xorl	%%ecx, %%ecx;"		// and sub-leaf ECX = 0
+				"	cpuid;"						// Returns data into eax, ebx, ecx, edx
+				"	movl	%%ebx, %%eax;"		// Put EBX value into EAX (so we can return it)
+				"	popl	%%ebx;"				// Restore ebx
+				: "=a" (b7)					// EAX => b7
+				:							// no inputs
+				: "%ecx", "%edx" );			// clobbers ECX and EDX
+			if ((b7 >> 5) & 0x1)
+			{
+				result += CPUID_AVX2;
+			}
+		}
+	}
 
 	//idLib::common->Printf( "cpuid result is %i (c = %i d = %i)\n", result, c, d);
 	cpuid = (cpuid_t)result;
 #endif
 
 	// Print what we found to console
-	idLib::common->Printf( "Found %s CPU%s, features:%s%s%s%s%s%s\n",
+	idLib::common->Printf( "Found %s CPU%s, features:%s%s%s%s%s%s%s%s%s\n",
 			// Vendor
 			cpuid & CPUID_AMD ? "AMD" : 
 			cpuid & CPUID_INTEL ? "Intel" : 
@@ -163,6 +200,9 @@ void idSIMD::InitProcessor( const char *module, bool forceGeneric ) {
 			cpuid & CPUID_SSE ? " SSE" : "",
 			cpuid & CPUID_SSE2 ? " SSE2" : "",
 			cpuid & CPUID_SSE3 ? " SSE3" : "",
+			cpuid & CPUID_AVX ? " AVX" : "",
+			cpuid & CPUID_AVX2 ? " AVX2" : "",
+			cpuid & CPUID_FMA ? " FMA" : "",
 			cpuid & CPUID_3DNOW ? " 3DNow!" : "",
 			cpuid & CPUID_CMOV ? " CMOV" : "" );
 
@@ -175,6 +215,9 @@ void idSIMD::InitProcessor( const char *module, bool forceGeneric ) {
 		if ( !processor ) {
 			if ( ( cpuid & CPUID_ALTIVEC ) ) {
 				processor = new idSIMD_AltiVec;
+			} else if ( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) && ( cpuid & CPUID_SSE2 ) && ( cpuid & CPUID_SSE3 ) &&
+						( cpuid & CPUID_AVX ) && ( cpuid & CPUID_AVX2 ) && ( cpuid & CPUID_FMA ) ) {
+				processor = new idSIMD_AVX;
 			} else if ( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) && ( cpuid & CPUID_SSE2 ) && ( cpuid & CPUID_SSE3 ) ) {
 				processor = new idSIMD_SSE3;
 			} else if ( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) && ( cpuid & CPUID_SSE2 ) ) {
@@ -2382,6 +2425,85 @@ void TestMatXLDLTFactor( void ) {
 	}
 }
 
+/*
+============
+TestMatXRankTwoUpdate
+============
+*/
+void TestMatXRankTwoUpdate( void ) {
+	int i, j;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	const char *result;
+	idMatX original, mat1, mat2;
+	idVecX origV1, origV2, v1, v2, w1, w2;
+
+	idLib::common->Printf("====================================\n" );
+
+	original.Random( MATX_LDLT_FACTOR_SOLVE_SIZE, MATX_LDLT_FACTOR_SOLVE_SIZE, 0, -1.0f, 1.0f );
+	origV1.Random( MATX_LDLT_FACTOR_SOLVE_SIZE, 1, -1.0f, 1.0f );
+	origV2.Random( MATX_LDLT_FACTOR_SOLVE_SIZE, 2, -1.0f, 1.0f );
+
+	for ( i = 1; i < MATX_LDLT_FACTOR_SOLVE_SIZE; i++ ) {
+
+		bestClocksGeneric = 0;
+		for ( j = 0; j < NUMTESTS; j++ ) {
+			mat1 = original;
+			v1 = origV1;
+			v2 = origV2;
+			StartRecordTime( start );
+			p_generic->MatX_RankTwoUpdateColumn( mat1[0], mat1.GetNumColumns(), v1.ToFloatPtr(), v2.ToFloatPtr(), 0.5f, 0.25f, -0.5f, 0.75f, i );
+			StopRecordTime( end );
+			GetBest( start, end, bestClocksGeneric );
+		}
+
+		PrintClocks( va( "generic->MatX_RankTwoUpdateColumn %d", i ), 1, bestClocksGeneric );
+
+		bestClocksSIMD = 0;
+		for ( j = 0; j < NUMTESTS; j++ ) {
+			mat2 = original;
+			w1 = origV1;
+			w2 = origV2;
+			StartRecordTime( start );
+			p_simd->MatX_RankTwoUpdateColumn( mat2[0], mat2.GetNumColumns(), w1.ToFloatPtr(), w2.ToFloatPtr(), 0.5f, 0.25f, -0.5f, 0.75f, i );
+			StopRecordTime( end );
+			GetBest( start, end, bestClocksSIMD );
+		}
+
+		result = mat1.Compare( mat2, MATX_LDLT_SIMD_EPSILON ) && v1.Compare( w1, MATX_LDLT_SIMD_EPSILON ) && v2.Compare( w2, MATX_LDLT_SIMD_EPSILON ) ? "ok" : S_COLOR_RED"X";
+		PrintClocks( va( "   simd->MatX_RankTwoUpdateColumn %d %s", i, result ), 1, bestClocksSIMD, bestClocksGeneric );
+	}
+
+	for ( i = 1; i < MATX_LDLT_FACTOR_SOLVE_SIZE; i++ ) {
+
+		bestClocksGeneric = 0;
+		for ( j = 0; j < NUMTESTS; j++ ) {
+			mat1 = original;
+			v1 = origV1;
+			v2 = origV2;
+			StartRecordTime( start );
+			p_generic->MatX_RankTwoUpdateRow( mat1[0], v1.ToFloatPtr(), v2.ToFloatPtr(), 0.5f, 0.25f, -0.5f, 0.75f, i );
+			StopRecordTime( end );
+			GetBest( start, end, bestClocksGeneric );
+		}
+
+		PrintClocks( va( "generic->MatX_RankTwoUpdateRow %d", i ), 1, bestClocksGeneric );
+
+		bestClocksSIMD = 0;
+		for ( j = 0; j < NUMTESTS; j++ ) {
+			mat2 = original;
+			w1 = origV1;
+			w2 = origV2;
+			StartRecordTime( start );
+			p_simd->MatX_RankTwoUpdateRow( mat2[0], w1.ToFloatPtr(), w2.ToFloatPtr(), 0.5f, 0.25f, -0.5f, 0.75f, i );
+			StopRecordTime( end );
+			GetBest( start, end, bestClocksSIMD );
+		}
+
+		result = mat1.Compare( mat2, MATX_LDLT_SIMD_EPSILON ) && v1.Compare( w1, MATX_LDLT_SIMD_EPSILON ) && v2.Compare( w2, MATX_LDLT_SIMD_EPSILON ) ? "ok" : S_COLOR_RED"X";
+		PrintClocks( va( "   simd->MatX_RankTwoUpdateRow %d %s", i, result ), 1, bestClocksSIMD, bestClocksGeneric );
+	}
+}
+
 /*
 ============
 TestBlendJoints
@@ -3734,6 +3856,308 @@ void TestSoundMixing( void ) {
 	PrintClocks( va( "   simd->MixedSoundToSamples() %s", result ), MIXBUFFER_SAMPLES, bestClocksSIMD, bestClocksGeneric );
 }
 
+/*
+============
+TestSoundFiltering
+============
+*/
+#define SOUND_FILTER_EPSILON		0.1f
+
+void TestSoundFiltering( void ) {
+	int i, j;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	ALIGN16( float origSamples[MIXBUFFER_SAMPLES*2] );
+	ALIGN16( float samples1[MIXBUFFER_SAMPLES*2] );
+	ALIGN16( float samples2[MIXBUFFER_SAMPLES*2] );
+	float coefs[5], history1[4], history2[4];
+	const char *result;
+
+	idRandom srnd( RANDOM_SEED );
+
+	for ( i = 0; i < MIXBUFFER_SAMPLES*2; i++ ) {
+		origSamples[i] = srnd.RandomInt( (1<<16) ) - (1<<15);
+	}
+
+	// the lowpass of the enviro suit
+	float c = 1.0f / idMath::Tan( idMath::PI * 2000.0f / 44100.0f );
+	coefs[0] = 1.0f / ( 1.0f + 2.0f * c + c * c );
+	coefs[1] = 2.0f * coefs[0];
+	coefs[2] = coefs[0];
+	coefs[3] = 2.0f * ( 1.0f - c * c ) * coefs[0];
+	coefs[4] = ( 1.0f - 2.0f * c + c * c ) * coefs[0];
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		for ( j = 0; j < MIXBUFFER_SAMPLES*2; j++ ) {
+			samples1[j] = origSamples[j];
+		}
+		history1[0] = history1[1] = history1[2] = history1[3] = 0.0f;
+		StartRecordTime( start );
+		p_generic->SoundBiquadFilter( samples1, MIXBUFFER_SAMPLES, 2, coefs, history1 );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->SoundBiquadFilter()", MIXBUFFER_SAMPLES, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		for ( j = 0; j < MIXBUFFER_SAMPLES*2; j++ ) {
+			samples2[j] = origSamples[j];
+		}
+		history2[0] = history2[1] = history2[2] = history2[3] = 0.0f;
+		StartRecordTime( start );
+		p_simd->SoundBiquadFilter( samples2, MIXBUFFER_SAMPLES, 2, coefs, history2 );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < MIXBUFFER_SAMPLES*2; i++ ) {
+		if ( idMath::Fabs( samples1[i] - samples2[i] ) > SOUND_FILTER_EPSILON ) {
+			break;
+		}
+	}
+	for ( j = 0; j < 4; j++ ) {
+		if ( idMath::Fabs( history1[j] - history2[j] ) > SOUND_FILTER_EPSILON ) {
+			break;
+		}
+	}
+	result = ( i >= MIXBUFFER_SAMPLES*2 && j >= 4 ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->SoundBiquadFilter() %s", result ), MIXBUFFER_SAMPLES, bestClocksSIMD, bestClocksGeneric );
+}
+
+/*
+============
+TestCullBoxes
+============
+*/
+void TestCullBoxes( void ) {
+	int i;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	ALIGN16( float centers[COUNT*3] );
+	ALIGN16( float extents[COUNT*3] );
+	ALIGN16( byte culled1[COUNT] );
+	ALIGN16( byte culled2[COUNT] );
+	idPlane planes[5];
+	const char *result;
+
+	idRandom srnd( RANDOM_SEED );
+
+	for ( i = 0; i < COUNT*3; i++ ) {
+		centers[i] = srnd.CRandomFloat() * 100.0f;
+		extents[i] = srnd.RandomFloat() * 10.0f;
+	}
+	for ( i = 0; i < 5; i++ ) {
+		planes[i].SetNormal( idVec3( srnd.CRandomFloat(), srnd.CRandomFloat(), srnd.CRandomFloat() ) );
+		planes[i].Normalize();
+		planes[i][3] = srnd.CRandomFloat() * 20.0f;
+	}
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_generic->CullBoxes( culled1, centers, extents, COUNT, planes, 5 );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->CullBoxes()", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_simd->CullBoxes( culled2, centers, extents, COUNT, planes, 5 );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < COUNT; i++ ) {
+		if ( culled1[i] != culled2[i] ) {
+			break;
+		}
+	}
+	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->CullBoxes() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+}
+
+/*
+============
+TestDequantize
+============
+*/
+void TestDequantize( void ) {
+	int i;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	ALIGN16( float bias[COUNT] );
+	ALIGN16( float scale[COUNT] );
+	ALIGN16( float dst1[COUNT] );
+	ALIGN16( float dst2[COUNT] );
+	ALIGN16( unsigned short src16[COUNT] );
+	ALIGN16( byte src8[COUNT] );
+	const char *result;
+
+	idRandom srnd( RANDOM_SEED );
+
+	for ( i = 0; i < COUNT; i++ ) {
+		bias[i] = srnd.CRandomFloat() * 10.0f;
+		scale[i] = srnd.RandomFloat() * 0.01f;
+		src16[i] = srnd.RandomInt( 1 << 16 );
+		src8[i] = srnd.RandomInt( 1 << 8 );
+	}
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_generic->Dequantize( dst1, src16, bias, scale, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->Dequantize( short )", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_simd->Dequantize( dst2, src16, bias, scale, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < COUNT; i++ ) {
+		if ( idMath::Fabs( dst1[i] - dst2[i] ) > 1e-4f ) {
+			break;
+		}
+	}
+	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->Dequantize( short ) %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_generic->Dequantize( dst1, src8, bias, scale, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->Dequantize( byte )", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_simd->Dequantize( dst2, src8, bias, scale, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < COUNT; i++ ) {
+		if ( idMath::Fabs( dst1[i] - dst2[i] ) > 1e-4f ) {
+			break;
+		}
+	}
+	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->Dequantize( byte ) %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+}
+
+/*
+============
+TestImageProcessing
+============
+*/
+#define IMAGE_TEST_SIZE		64
+
+void TestImageProcessing( void ) {
+	int i;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	ALIGN16( byte image[IMAGE_TEST_SIZE*IMAGE_TEST_SIZE*4] );
+	ALIGN16( byte mip1[IMAGE_TEST_SIZE*IMAGE_TEST_SIZE] );
+	ALIGN16( byte mip2[IMAGE_TEST_SIZE*IMAGE_TEST_SIZE] );
+	unsigned int offsets0[IMAGE_TEST_SIZE];
+	unsigned int offsets1[IMAGE_TEST_SIZE];
+	const char *result;
+
+	idRandom srnd( RANDOM_SEED );
+
+	for ( i = 0; i < IMAGE_TEST_SIZE*IMAGE_TEST_SIZE*4; i++ ) {
+		image[i] = srnd.RandomInt( 256 );
+	}
+	for ( i = 0; i < IMAGE_TEST_SIZE; i++ ) {
+		offsets0[i] = srnd.RandomInt( IMAGE_TEST_SIZE ) * 4;
+		offsets1[i] = srnd.RandomInt( IMAGE_TEST_SIZE ) * 4;
+	}
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_generic->MipMapRGBA( mip1, image, IMAGE_TEST_SIZE, IMAGE_TEST_SIZE );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->MipMapRGBA()", IMAGE_TEST_SIZE*IMAGE_TEST_SIZE/4, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_simd->MipMapRGBA( mip2, image, IMAGE_TEST_SIZE, IMAGE_TEST_SIZE );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < IMAGE_TEST_SIZE*IMAGE_TEST_SIZE; i++ ) {
+		if ( mip1[i] != mip2[i] ) {
+			break;
+		}
+	}
+	result = ( i >= IMAGE_TEST_SIZE*IMAGE_TEST_SIZE ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->MipMapRGBA() %s", result ), IMAGE_TEST_SIZE*IMAGE_TEST_SIZE/4, bestClocksSIMD, bestClocksGeneric );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_generic->MipMapNormalRGBA( mip1, image, IMAGE_TEST_SIZE, IMAGE_TEST_SIZE );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->MipMapNormalRGBA()", IMAGE_TEST_SIZE*IMAGE_TEST_SIZE/4, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_simd->MipMapNormalRGBA( mip2, image, IMAGE_TEST_SIZE, IMAGE_TEST_SIZE );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	// the float rounding may differ by one
+	for ( i = 0; i < IMAGE_TEST_SIZE*IMAGE_TEST_SIZE; i++ ) {
+		if ( abs( mip1[i] - mip2[i] ) > 1 ) {
+			break;
+		}
+	}
+	result = ( i >= IMAGE_TEST_SIZE*IMAGE_TEST_SIZE ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->MipMapNormalRGBA() %s", result ), IMAGE_TEST_SIZE*IMAGE_TEST_SIZE/4, bestClocksSIMD, bestClocksGeneric );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_generic->ResampleRGBARow( mip1, image, image + IMAGE_TEST_SIZE*4, offsets0, offsets1, IMAGE_TEST_SIZE );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->ResampleRGBARow()", IMAGE_TEST_SIZE, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_simd->ResampleRGBARow( mip2, image, image + IMAGE_TEST_SIZE*4, offsets0, offsets1, IMAGE_TEST_SIZE );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < IMAGE_TEST_SIZE*4; i++ ) {
+		if ( mip1[i] != mip2[i] ) {
+			break;
+		}
+	}
+	result = ( i >= IMAGE_TEST_SIZE*4 ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->ResampleRGBARow() %s", result ), IMAGE_TEST_SIZE, bestClocksSIMD, bestClocksGeneric );
+}
+
 /*
 ============
 TestMath
@@ -4194,6 +4618,65 @@ void TestNegate( void ) {
 }
 
 
+/*
+============
+SIMD_CreateProcessor
+
+  returns NULL if the CPU does not support the named processor
+============
+*/
+static idSIMDProcessor *SIMD_CreateProcessor( const char *name ) {
+	cpuid_t cpuid = idLib::sys->GetProcessorId();
+
+	if ( idStr::Icmp( name, "MMX" ) == 0 ) {
+		if ( !( cpuid & CPUID_MMX ) ) {
+			common->Printf( "CPU does not support MMX\n" );
+			return NULL;
+		}
+		return new idSIMD_MMX;
+	} else if ( idStr::Icmp( name, "3DNow" ) == 0 ) {
+		if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_3DNOW ) ) {
+			common->Printf( "CPU does not support MMX & 3DNow\n" );
+			return NULL;
+		}
+		return new idSIMD_3DNow;
+	} else if ( idStr::Icmp( name, "SSE" ) == 0 ) {
+		if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) ) {
+			common->Printf( "CPU does not support MMX & SSE\n" );
+			return NULL;
+		}
+		return new idSIMD_SSE;
+	} else if ( idStr::Icmp( name, "SSE2" ) == 0 ) {
+		if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) || !( cpuid & CPUID_SSE2 ) ) {
+			common->Printf( "CPU does not support MMX & SSE & SSE2\n" );
+			return NULL;
+		}
+		return new idSIMD_SSE2;
+	} else if ( idStr::Icmp( name, "SSE3" ) == 0 ) {
+		if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) || !( cpuid & CPUID_SSE2 ) || !( cpuid & CPUID_SSE3 ) ) {
+			common->Printf( "CPU does not support MMX & SSE & SSE2 & SSE3\n" );
+			return NULL;
+		}
+		return new idSIMD_SSE3();
+	} else if ( idStr::Icmp( name, "AVX" ) == 0 ) {
+		if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) || !( cpuid & CPUID_SSE2 ) || !( cpuid & CPUID_SSE3 ) ||
+				!( cpuid & CPUID_AVX ) || !( cpuid & CPUID_AVX2 ) || !( cpuid & CPUID_FMA ) ) {
+			common->Printf( "CPU does not support MMX & SSE & SSE2 & SSE3 & AVX2 & FMA\n" );
+			return NULL;
+		}
+		return new idSIMD_AVX();
+	} else if ( idStr::Icmp( name, "AltiVec" ) == 0 ) {
+		if ( !( cpuid & CPUID_ALTIVEC ) ) {
+			common->Printf( "CPU does not support AltiVec\n" );
+			return NULL;
+		}
+		return new idSIMD_AltiVec();
+	} else {
+		common->Printf( "invalid argument, use: MMX, 3DNow, SSE, SSE2, SSE3, AVX, AltiVec\n" );
+		return NULL;
+	}
+}
+
 /*
 ============
 idSIMD::Test_f
@@ -4209,49 +4692,12 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 	p_generic = generic;
 
 	if ( idStr::Length( args.Argv( 1 ) ) != 0 ) {
-		cpuid_t cpuid = idLib::sys->GetProcessorId();
 		idStr argString = args.Args();
 
 		argString.Remove( ' ' );
 
-		if ( idStr::Icmp( argString, "MMX" ) == 0 ) {
-			if ( !( cpuid & CPUID_MMX ) ) {
-				common->Printf( "CPU does not support MMX\n" );
-				return;
-			}
-			p_simd = new idSIMD_MMX;
-		} else if ( idStr::Icmp( argString, "3DNow" ) == 0 ) {
-			if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_3DNOW ) ) {
-				common->Printf( "CPU does not support MMX & 3DNow\n" );
-				return;
-			}
-			p_simd = new idSIMD_3DNow;
-		} else if ( idStr::Icmp( argString, "SSE" ) == 0 ) {
-			if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) ) {
-				common->Printf( "CPU does not support MMX & SSE\n" );
-				return;
-			}
-			p_simd = new idSIMD_SSE;
-		} else if ( idStr::Icmp( argString, "SSE2" ) == 0 ) {
-			if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) || !( cpuid & CPUID_SSE2 ) ) {
-				common->Printf( "CPU does not support MMX & SSE & SSE2\n" );
-				return;
-			}
-			p_simd = new idSIMD_SSE2;
-		} else if ( idStr::Icmp( argString, "SSE3" ) == 0 ) {
-			if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) || !( cpuid & CPUID_SSE2 ) || !( cpuid & CPUID_SSE3 ) ) {
-				common->Printf( "CPU does not support MMX & SSE & SSE2 & SSE3\n" );
-				return;
-			}
-			p_simd = new idSIMD_SSE3();
-		} else if ( idStr::Icmp( argString, "AltiVec" ) == 0 ) {
-			if ( !( cpuid & CPUID_ALTIVEC ) ) {
-				common->Printf( "CPU does not support AltiVec\n" );
-				return;
-			}
-			p_simd = new idSIMD_AltiVec();
-		} else {
-			common->Printf( "invalid argument, use: MMX, 3DNow, SSE, SSE2, SSE3, AltiVec\n" );
+		p_simd = SIMD_CreateProcessor( argString );
+		if ( !p_simd ) {
 			return;
 		}
 	}
@@ -4286,6 +4732,7 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 	TestMatXLowerTriangularSolve();
 	TestMatXLowerTriangularSolveTranspose();
 	TestMatXLDLTFactor();
+	TestMatXRankTwoUpdate();
 
 	idLib::common->Printf("====================================\n" );
 
@@ -4310,6 +4757,19 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 
 	TestSoundUpSampling();
 	TestSoundMixing();
+	TestSoundFiltering();
+
+	idLib::common->Printf("====================================\n" );
+
+	TestDequantize();
+
+	idLib::common->Printf("====================================\n" );
+
+	TestCullBoxes();
+
+	idLib::common->Printf("====================================\n" );
+
+	TestImageProcessing();
 
 	idLib::common->SetRefreshOnPrint( false );
 
@@ -4323,3 +4783,732 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 	SetThreadPriority( GetCurrentThread(), THREAD_PRIORITY_NORMAL );
 #endif /* _WIN32 */
 }
+
+
+/*
+===============================================================================
+
+	SIMD benchmark
+
+	Times every idSIMDProcessor kernel of the generic and the tested processor
+	over data of the sizes the engine uses them with. Every kernel is timed in
+	BENCH_SAMPLES samples of a calibrated number of calls with the system clock
+	ticks, and the minimum, median, mean and standard deviation of the time per
+	call are reported on the console and in a comma separated report file.
+
+===============================================================================
+*/
+
+#define BENCH_FLOATS			4096						// floats of the vertex and sample buffers
+#define BENCH_VERTS				2048						// vertices of a detailed md5 mesh surface
+#define BENCH_INDEXES			( BENCH_VERTS * 6 )			// shadow volume and tangent indexes of that surface
+#define BENCH_WEIGHTS			( BENCH_VERTS * 2 )			// two joint weights per vertex
+#define BENCH_JOINTS			96							// joints of an AI skeleton
+#define BENCH_MATX				36							// constraint rows of an articulated figure
+#define BENCH_IMAGE				256							// width and height of a texture
+#define BENCH_SAMPLES			31							// timed samples per kernel
+#define BENCH_SAMPLE_SECONDS	0.0002						// minimum duration of a sample
+#define BENCH_MAX_CALLS			( 1 << 16 )					// maximum calls per sample
+
+typedef struct simdBenchData_s {
+	float *					fsrc0;
+	float *					fsrc1;
+	float *					fdst;
+	byte *					bdst;
+	idVec2 *				v2src;
+	idVec3 *				v3src0;
+	idVec3 *				v3src1;
+	idPlane *				planes;
+	idDrawVert *			verts;
+	idDrawVert *			dstVerts;
+	int *					indexes;
+	int *					vertRemap;
+	int *					origVertRemap;
+	idVec4 *				vertexCache;
+	idVec3 *				texCoords;
+	idVec2 *				overlayCoords;
+	idPlane *				triPlanes;
+	dominantTri_s *			dominantTris;
+	idJointQuat *			jointQuats;
+	idJointQuat *			blendQuats;
+	idJointQuat *			dstQuats;
+	idJointMat *			jointMats;
+	idJointMat *			dstMats;
+	int *					jointIndex;
+	int *					parents;
+	idVec4 *				weights;
+	int *					weightIndex;
+	short *					pcm;
+	float *					ogg[2];
+	float *					sndSamples;
+	float *					sndDst;
+	float *					mixBuffer;
+	short *					outSamples;
+	float					speakerLastV[6];
+	float					speakerCurrentV[6];
+	float					biquadCoefs[5];
+	float					biquadHistory[4];
+	unsigned short *		quantized16;
+	byte *					quantized8;
+	byte *					image;
+	byte *					mip;
+	unsigned int *			offsets0;
+	unsigned int *			offsets1;
+	idPlane					cullPlanes[4];
+	idPlane					planeConstant;
+	idVec3					vecConstant;
+	idVec3					lightOrigin;
+	idVec3					viewOrigin;
+	idMatX					mat0;
+	idMatX					mat1;
+	idMatX					matDst;
+	idMatX					spd;
+	idMatX					factor;
+	idMatX					lower;
+	idVecX					vecSrc;
+	idVecX					vecDst;
+	idVecX					invDiag;
+	idVecX					v1;
+	idVecX					v2;
+	idList<void *>			allocations;
+} simdBenchData_t;
+
+typedef void (*simdBenchFunc_t)( idSIMDProcessor *p, simdBenchData_t &b );
+
+typedef struct {
+	const char *			name;
+	int						count;
+	simdBenchFunc_t			run;
+	simdBenchFunc_t			reset;				// restores the input outside the timing for kernels that change it
+} simdBenchKernel_t;
+
+typedef struct {
+	double					min;
+	double					median;
+	double					mean;
+	double					stdDev;
+} simdBenchStats_t;
+
+#define BENCH_KERNEL( name, call )		static void Bench_##name( idSIMDProcessor *p, simdBenchData_t &b ) { call; }
+
+BENCH_KERNEL( AddConstant,			p->Add( b.fdst, 4.0f, b.fsrc0, BENCH_FLOATS ) )
+BENCH_KERNEL( Add,					p->Add( b.fdst, b.fsrc0, b.fsrc1, BENCH_FLOATS ) )
+BENCH_KERNEL( SubConstant,			p->Sub( b.fdst, 4.0f, b.fsrc0, BENCH_FLOATS ) )
+BENCH_KERNEL( Sub,					p->Sub( b.fdst, b.fsrc0, b.fsrc1, BENCH_FLOATS ) )
+BENCH_KERNEL( MulConstant,			p->Mul( b.fdst, 4.0f, b.fsrc0, BENCH_FLOATS ) )
+BENCH_KERNEL( Mul,					p->Mul( b.fdst, b.fsrc0, b.fsrc1, BENCH_FLOATS ) )
+BENCH_KERNEL( DivConstant,			p->Div( b.fdst, 4.0f, b.fsrc1, BENCH_FLOATS ) )
+BENCH_KERNEL( Div,					p->Div( b.fdst, b.fsrc0, b.fsrc1, BENCH_FLOATS ) )
+BENCH_KERNEL( MulAddConstant,		p->MulAdd( b.fdst, 0.123f, b.fsrc0, BENCH_FLOATS ) )
+BENCH_KERNEL( MulAdd,				p->MulAdd( b.fdst, b.fsrc0, b.fsrc1, BENCH_FLOATS ) )
+BENCH_KERNEL( MulSubConstant,		p->MulSub( b.fdst, 0.123f, b.fsrc0, BENCH_FLOATS ) )
+BENCH_KERNEL( MulSub,				p->MulSub( b.fdst, b.fsrc0, b.fsrc1, BENCH_FLOATS ) )
+BENCH_KERNEL( DotVec3Vec3,			p->Dot( b.fdst, b.vecConstant, b.v3src0, BENCH_VERTS ) )
+BENCH_KERNEL( DotVec3Plane,			p->Dot( b.fdst, b.vecConstant, b.planes, BENCH_VERTS ) )
+BENCH_KERNEL( DotVec3DrawVert,		p->Dot( b.fdst, b.vecConstant, b.verts, BENCH_VERTS ) )
+BENCH_KERNEL( DotPlaneVec3,			p->Dot( b.fdst, b.planeConstant, b.v3src0, BENCH_VERTS ) )
+BENCH_KERNEL( DotPlanePlane,		p->Dot( b.fdst, b.planeConstant, b.planes, BENCH_VERTS ) )
+BENCH_KERNEL( DotPlaneDrawVert,		p->Dot( b.fdst, b.planeConstant, b.verts, BENCH_VERTS ) )
+BENCH_KERNEL( DotVec3s,				p->Dot( b.fdst, b.v3src0, b.v3src1, BENCH_VERTS ) )
+BENCH_KERNEL( DotFloats,			p->Dot( b.fdst[0], b.fsrc0, b.fsrc1, BENCH_FLOATS ) )
+BENCH_KERNEL( CmpGT,				p->CmpGT( b.bdst, b.fsrc0, 0.0f, BENCH_FLOATS ) )
+BENCH_KERNEL( CmpGTBit,				p->CmpGT( b.bdst, 2, b.fsrc0, 0.0f, BENCH_FLOATS ) )
+BENCH_KERNEL( CmpGE,				p->CmpGE( b.bdst, b.fsrc0, 0.0f, BENCH_FLOATS ) )
+BENCH_KERNEL( CmpGEBit,				p->CmpGE( b.bdst, 2, b.fsrc0, 0.0f, BENCH_FLOATS ) )
+BENCH_KERNEL( CmpLT,				p->CmpLT( b.bdst, b.fsrc0, 0.0f, BENCH_FLOATS ) )
+BENCH_KERNEL( CmpLTBit,				p->CmpLT( b.bdst, 2, b.fsrc0, 0.0f, BENCH_FLOATS ) )
+BENCH_KERNEL( CmpLE,				p->CmpLE( b.bdst, b.fsrc0, 0.0f, BENCH_FLOATS ) )
+BENCH_KERNEL( CmpLEBit,				p->CmpLE( b.bdst, 2, b.fsrc0, 0.0f, BENCH_FLOATS ) )
+BENCH_KERNEL( MinMaxFloats,			float min; float max; p->MinMax( min, max, b.fsrc0, BENCH_FLOATS ) )
+BENCH_KERNEL( MinMaxVec2,			idVec2 min; idVec2 max; p->MinMax( min, max, b.v2src, BENCH_VERTS ) )
+BENCH_KERNEL( MinMaxVec3,			idVec3 min; idVec3 max; p->MinMax( min, max, b.v3src0, BENCH_VERTS ) )
+BENCH_KERNEL( MinMaxDrawVert,		idVec3 min; idVec3 max; p->MinMax( min, max, b.verts, BENCH_VERTS ) )
+BENCH_KERNEL( MinMaxIndexed,		idVec3 min; idVec3 max; p->MinMax( min, max, b.verts, b.indexes, BENCH_INDEXES ) )
+BENCH_KERNEL( Clamp,				p->Clamp( b.fdst, b.fsrc0, -1.0f, 1.0f, BENCH_FLOATS ) )
+BENCH_KERNEL( ClampMin,				p->ClampMin( b.fdst, b.fsrc0, -1.0f, BENCH_FLOATS ) )
+BENCH_KERNEL( ClampMax,				p->ClampMax( b.fdst, b.fsrc0, 1.0f, BENCH_FLOATS ) )
+BENCH_KERNEL( Memcpy,				p->Memcpy( b.fdst, b.fsrc0, BENCH_FLOATS * sizeof( float ) ) )
+BENCH_KERNEL( Memset,				p->Memset( b.fdst, 0, BENCH_FLOATS * sizeof( float ) ) )
+BENCH_KERNEL( Zero16,				p->Zero16( b.fdst, BENCH_FLOATS ) )
+BENCH_KERNEL( Negate16,				p->Negate16( b.fdst, BENCH_FLOATS ) )
+BENCH_KERNEL( Copy16,				p->Copy16( b.fdst, b.fsrc0, BENCH_FLOATS ) )
+BENCH_KERNEL( Add16,				p->Add16( b.fdst, b.fsrc0, b.fsrc1, BENCH_FLOATS ) )
+BENCH_KERNEL( Sub16,				p->Sub16( b.fdst, b.fsrc0, b.fsrc1, BENCH_FLOATS ) )
+BENCH_KERNEL( Mul16,				p->Mul16( b.fdst, b.fsrc0, 0.5f, BENCH_FLOATS ) )
+BENCH_KERNEL( AddAssign16,			p->AddAssign16( b.fdst, b.fsrc0, BENCH_FLOATS ) )
+BENCH_KERNEL( SubAssign16,			p->SubAssign16( b.fdst, b.fsrc0, BENCH_FLOATS ) )
+BENCH_KERNEL( MulAssign16,			p->MulAssign16( b.fdst, 0.5f, BENCH_FLOATS ) )
+BENCH_KERNEL( MatXMultiplyVecX,				p->MatX_MultiplyVecX( b.vecDst, b.mat0, b.vecSrc ) )
+BENCH_KERNEL( MatXMultiplyAddVecX,			p->MatX_MultiplyAddVecX( b.vecDst, b.mat0, b.vecSrc ) )
+BENCH_KERNEL( MatXMultiplySubVecX,			p->MatX_MultiplySubVecX( b.vecDst, b.mat0, b.vecSrc ) )
+BENCH_KERNEL( MatXTransposeMultiplyVecX,	p->MatX_TransposeMultiplyVecX( b.vecDst, b.mat0, b.vecSrc ) )
+BENCH_KERNEL( MatXTransposeMultiplyAddVecX,	p->MatX_TransposeMultiplyAddVecX( b.vecDst, b.mat0, b.vecSrc ) )
+BENCH_KERNEL( MatXTransposeMultiplySubVecX,	p->MatX_TransposeMultiplySubVecX( b.vecDst, b.mat0, b.vecSrc ) )
+BENCH_KERNEL( MatXMultiplyMatX,				p->MatX_MultiplyMatX( b.matDst, b.mat0, b.mat1 ) )
+BENCH_KERNEL( MatXTransposeMultiplyMatX,	p->MatX_TransposeMultiplyMatX( b.matDst, b.mat0, b.mat1 ) )
+BENCH_KERNEL( MatXLowerTriangularSolve,		p->MatX_LowerTriangularSolve( b.lower, b.vecDst.ToFloatPtr(), b.vecSrc.ToFloatPtr(), BENCH_MATX ) )
+BENCH_KERNEL( MatXLowerTriangularSolveTranspose,	p->MatX_LowerTriangularSolveTranspose( b.lower, b.vecDst.ToFloatPtr(), b.vecSrc.ToFloatPtr(), BENCH_MATX ) )
+BENCH_KERNEL( MatXLDLTFactor,				p->MatX_LDLTFactor( b.factor, b.invDiag, BENCH_MATX ) )
+BENCH_KERNEL( MatXRankTwoUpdateColumn,		p->MatX_RankTwoUpdateColumn( b.factor[0], b.factor.GetNumColumns(), b.v1.ToFloatPtr(), b.v2.ToFloatPtr(), 0.5f, 0.25f, -0.5f, 0.75f, BENCH_MATX ) )
+BENCH_KERNEL( MatXRankTwoUpdateRow,			p->MatX_RankTwoUpdateRow( b.factor[0], b.v1.ToFloatPtr(), b.v2.ToFloatPtr(), 0.5f, 0.25f, -0.5f, 0.75f, BENCH_MATX ) )
+BENCH_KERNEL( BlendJoints,			p->BlendJoints( b.dstQuats, b.blendQuats, 0.3f, b.jointIndex, BENCH_JOINTS ) )
+BENCH_KERNEL( ConvertJointQuatsToJointMats,	p->ConvertJointQuatsToJointMats( b.dstMats, b.jointQuats, BENCH_JOINTS ) )
+BENCH_KERNEL( ConvertJointMatsToJointQuats,	p->ConvertJointMatsToJointQuats( b.dstQuats, b.jointMats, BENCH_JOINTS ) )
+BENCH_KERNEL( TransformJoints,		p->TransformJoints( b.dstMats, b.parents, 1, BENCH_JOINTS - 1 ) )
+BENCH_KERNEL( UntransformJoints,	p->UntransformJoints( b.dstMats, b.parents, 1, BENCH_JOINTS - 1 ) )
+BENCH_KERNEL( TransformVerts,		p->TransformVerts( b.dstVerts, BENCH_VERTS, b.jointMats, b.weights, b.weightIndex, BENCH_WEIGHTS ) )
+BENCH_KERNEL( TracePointCull,		byte totalOr; p->TracePointCull( b.bdst, totalOr, 0.0f, b.cullPlanes, b.verts, BENCH_VERTS ) )
+BENCH_KERNEL( DecalPointCull,		p->DecalPointCull( b.bdst, b.cullPlanes, b.verts, BENCH_VERTS ) )
+BENCH_KERNEL( OverlayPointCull,		p->OverlayPointCull( b.bdst, b.overlayCoords, b.cullPlanes, b.verts, BENCH_VERTS ) )
+BENCH_KERNEL( DeriveTriPlanes,		p->DeriveTriPlanes( b.triPlanes, b.verts, BENCH_VERTS, b.indexes, BENCH_INDEXES ) )
+BENCH_KERNEL( DeriveTangents,		p->DeriveTangents( b.triPlanes, b.dstVerts, BENCH_VERTS, b.indexes, BENCH_INDEXES ) )
+BENCH_KERNEL( DeriveUnsmoothedTangents,	p->DeriveUnsmoothedTangents( b.dstVerts, b.dominantTris, BENCH_VERTS ) )
+BENCH_KERNEL( NormalizeTangents,	p->NormalizeTangents( b.dstVerts, BENCH_VERTS ) )
+BENCH_KERNEL( CreateTextureSpaceLightVectors,	p->CreateTextureSpaceLightVectors( b.texCoords, b.lightOrigin, b.verts, BENCH_VERTS, b.indexes, BENCH_INDEXES ) )
+BENCH_KERNEL( CreateSpecularTextureCoords,		p->CreateSpecularTextureCoords( b.texCoords, b.lightOrigin, b.viewOrigin, b.verts, BENCH_VERTS, b.indexes, BENCH_INDEXES ) )
+BENCH_KERNEL( CreateShadowCache,	p->CreateShadowCache( b.vertexCache, b.vertRemap, b.lightOrigin, b.verts, BENCH_VERTS ) )
+BENCH_KERNEL( CreateVertexProgramShadowCache,	p->CreateVertexProgramShadowCache( b.vertexCache, b.verts, BENCH_VERTS ) )
+BENCH_KERNEL( UpSamplePCMTo44kHz,	p->UpSamplePCMTo44kHz( b.sndDst, b.pcm, MIXBUFFER_SAMPLES / 2, 22050, 1 ) )
+BENCH_KERNEL( UpSampleOGGTo44kHz,	p->UpSampleOGGTo44kHz( b.sndDst, b.ogg, MIXBUFFER_SAMPLES * 2, 44100, 2 ) )
+BENCH_KERNEL( MixSoundTwoSpeakerMono,	p->MixSoundTwoSpeakerMono( b.mixBuffer, b.sndSamples, MIXBUFFER_SAMPLES, b.speakerLastV, b.speakerCurrentV ) )
+BENCH_KERNEL( MixSoundTwoSpeakerStereo,	p->MixSoundTwoSpeakerStereo( b.mixBuffer, b.sndSamples, MIXBUFFER_SAMPLES, b.speakerLastV, b.speakerCurrentV ) )
+BENCH_KERNEL( MixSoundSixSpeakerMono,	p->MixSoundSixSpeakerMono( b.mixBuffer, b.sndSamples, MIXBUFFER_SAMPLES, b.speakerLastV, b.speakerCurrentV ) )
+BENCH_KERNEL( MixSoundSixSpeakerStereo,	p->MixSoundSixSpeakerStereo( b.mixBuffer, b.sndSamples, MIXBUFFER_SAMPLES, b.speakerLastV, b.speakerCurrentV ) )
+BENCH_KERNEL( MixedSoundToSamples,	p->MixedSoundToSamples( b.outSamples, b.mixBuffer, MIXBUFFER_SAMPLES * 6 ) )
+BENCH_KERNEL( SoundBiquadFilter,	p->SoundBiquadFilter( b.sndDst, MIXBUFFER_SAMPLES, 2, b.biquadCoefs, b.biquadHistory ) )
+BENCH_KERNEL( DequantizeShort,		p->Dequantize( b.fdst, b.quantized16, b.fsrc0, b.fsrc1, BENCH_FLOATS ) )
+BENCH_KERNEL( DequantizeByte,		p->Dequantize( b.fdst, b.quantized8, b.fsrc0, b.fsrc1, BENCH_FLOATS ) )
+BENCH_KERNEL( CullBoxes,			p->CullBoxes( b.bdst, b.fsrc0, b.fsrc1, BENCH_FLOATS / 3, b.cullPlanes, 4 ) )
+BENCH_KERNEL( MipMapRGBA,			p->MipMapRGBA( b.mip, b.image, BENCH_IMAGE, BENCH_IMAGE ) )
+BENCH_KERNEL( MipMapNormalRGBA,		p->MipMapNormalRGBA( b.mip, b.image, BENCH_IMAGE, BENCH_IMAGE ) )
+BENCH_KERNEL( ResampleRGBARow,		p->ResampleRGBARow( b.mip, b.image, b.image + BENCH_IMAGE * 4, b.offsets0, b.offsets1, BENCH_IMAGE ) )
+
+/*
+============
+Bench_ResetFactor
+============
+*/
+static void Bench_ResetFactor( idSIMDProcessor *p, simdBenchData_t &b ) {
+	memcpy( b.factor.ToFloatPtr(), b.spd.ToFloatPtr(), b.spd.GetNumRows() * b.spd.GetNumColumns() * sizeof( float ) );
+	b.v1.Random( BENCH_MATX, 1, -1.0f, 1.0f );
+	b.v2.Random( BENCH_MATX, 2, -1.0f, 1.0f );
+}
+
+/*
+============
+Bench_ResetVertRemap
+============
+*/
+static void Bench_ResetVertRemap( idSIMDProcessor *p, simdBenchData_t &b ) {
+	memcpy( b.vertRemap, b.origVertRemap, BENCH_VERTS * sizeof( int ) );
+}
+
+/*
+============
+Bench_ResetJoints
+============
+*/
+static void Bench_ResetJoints( idSIMDProcessor *p, simdBenchData_t &b ) {
+	memcpy( b.dstMats, b.jointMats, BENCH_JOINTS * sizeof( idJointMat ) );
+	memcpy( b.dstQuats, b.jointQuats, BENCH_JOINTS * sizeof( idJointQuat ) );
+}
+
+static const simdBenchKernel_t simdBenchKernels[] = {
+	{ "Add( float *, float, float *, int )",				BENCH_FLOATS,		Bench_AddConstant,				NULL },
+	{ "Add( float *, float *, float *, int )",				BENCH_FLOATS,		Bench_Add,						NULL },
+	{ "Sub( float *, float, float *, int )",				BENCH_FLOATS,		Bench_SubConstant,				NULL },
+	{ "Sub( float *, float *, float *, int )",				BENCH_FLOATS,		Bench_Sub,						NULL },
+	{ "Mul( float *, float, float *, int )",				BENCH_FLOATS,		Bench_MulConstant,				NULL },
+	{ "Mul( float *, float *, float *, int )",				BENCH_FLOATS,		Bench_Mul,						NULL },
+	{ "Div( float *, float, float *, int )",				BENCH_FLOATS,		Bench_DivConstant,				NULL },
+	{ "Div( float *, float *, float *, int )",				BENCH_FLOATS,		Bench_Div,						NULL },
+	{ "MulAdd( float *, float, float *, int )",				BENCH_FLOATS,		Bench_MulAddConstant,			NULL },
+	{ "MulAdd( float *, float *, float *, int )",			BENCH_FLOATS,		Bench_MulAdd,					NULL },
+	{ "MulSub( float *, float, float *, int )",				BENCH_FLOATS,		Bench_MulSubConstant,			NULL },
+	{ "MulSub( float *, float *, float *, int )",			BENCH_FLOATS,		Bench_MulSub,					NULL },
+	{ "Dot( float *, idVec3, idVec3 *, int )",				BENCH_VERTS,		Bench_DotVec3Vec3,				NULL },
+	{ "Dot( float *, idVec3, idPlane *, int )",				BENCH_VERTS,		Bench_DotVec3Plane,				NULL },
+	{ "Dot( float *, idVec3, idDrawVert *, int )",			BENCH_VERTS,		Bench_DotVec3DrawVert,			NULL },
+	{ "Dot( float *, idPlane, idVec3 *, int )",				BENCH_VERTS,		Bench_DotPlaneVec3,				NULL },
+	{ "Dot( float *, idPlane, idPlane *, int )",			BENCH_VERTS,		Bench_DotPlanePlane,			NULL },
+	{ "Dot( float *, idPlane, idDrawVert *, int )",			BENCH_VERTS,		Bench_DotPlaneDrawVert,			NULL },
+	{ "Dot( float *, idVec3 *, idVec3 *, int )",			BENCH_VERTS,		Bench_DotVec3s,					NULL },
+	{ "Dot( float &, float *, float *, int )",				BENCH_FLOATS,		Bench_DotFloats,				NULL },
+	{ "CmpGT( byte *, float *, float, int )",				BENCH_FLOATS,		Bench_CmpGT,					NULL },
+	{ "CmpGT( byte *, byte, float *, float, int )",			BENCH_FLOATS,		Bench_CmpGTBit,					NULL },
+	{ "CmpGE( byte *, float *, float, int )",				BENCH_FLOATS,		Bench_CmpGE,					NULL },
+	{ "CmpGE( byte *, byte, float *, float, int )",			BENCH_FLOATS,		Bench_CmpGEBit,					NULL },
+	{ "CmpLT( byte *, float *, float, int )",				BENCH_FLOATS,		Bench_CmpLT,					NULL },
+	{ "CmpLT( byte *, byte, float *, float, int )",			BENCH_FLOATS,		Bench_CmpLTBit,					NULL },
+	{ "CmpLE( byte *, float *, float, int )",				BENCH_FLOATS,		Bench_CmpLE,					NULL },
+	{ "CmpLE( byte *, byte, float *, float, int )",			BENCH_FLOATS,		Bench_CmpLEBit,					NULL },
+	{ "MinMax( float *, int )",								BENCH_FLOATS,		Bench_MinMaxFloats,				NULL },
+	{ "MinMax( idVec2 *, int )",							BENCH_VERTS,		Bench_MinMaxVec2,				NULL },
+	{ "MinMax( idVec3 *, int )",							BENCH_VERTS,		Bench_MinMaxVec3,				NULL },
+	{ "MinMax( idDrawVert *, int )",						BENCH_VERTS,		Bench_MinMaxDrawVert,			NULL },
+	{ "MinMax( idDrawVert *, int *, int )",					BENCH_INDEXES,		Bench_MinMaxIndexed,			NULL },
+	{ "Clamp",												BENCH_FLOATS,		Bench_Clamp,					NULL },
+	{ "ClampMin",											BENCH_FLOATS,		Bench_ClampMin,					NULL },
+	{ "ClampMax",											BENCH_FLOATS,		Bench_ClampMax,					NULL },
+	{ "Memcpy",												BENCH_FLOATS * 4,	Bench_Memcpy,					NULL },
+	{ "Memset",												BENCH_FLOATS * 4,	Bench_Memset,					NULL },
+	{ "Zero16",												BENCH_FLOATS,		Bench_Zero16,					NULL },
+	{ "Negate16",											BENCH_FLOATS,		Bench_Negate16,					NULL },
+	{ "Copy16",												BENCH_FLOATS,		Bench_Copy16,					NULL },
+	{ "Add16",												BENCH_FLOATS,		Bench_Add16,					NULL },
+	{ "Sub16",												BENCH_FLOATS,		Bench_Sub16,					NULL },
+	{ "Mul16",												BENCH_FLOATS,		Bench_Mul16,					NULL },
+	{ "AddAssign16",										BENCH_FLOATS,		Bench_AddAssign16,				NULL },
+	{ "SubAssign16",										BENCH_FLOATS,		Bench_SubAssign16,				NULL },
+	{ "MulAssign16",										BENCH_FLOATS,		Bench_MulAssign16,				NULL },
+	{ "MatX_MultiplyVecX",									BENCH_MATX,			Bench_MatXMultiplyVecX,			NULL },
+	{ "MatX_MultiplyAddVecX",								BENCH_MATX,			Bench_MatXMultiplyAddVecX,		NULL },
+	{ "MatX_MultiplySubVecX",								BENCH_MATX,			Bench_MatXMultiplySubVecX,		NULL },
+	{ "MatX_TransposeMultiplyVecX",							BENCH_MATX,			Bench_MatXTransposeMultiplyVecX,	NULL },
+	{ "MatX_TransposeMultiplyAddVecX",						BENCH_MATX,			Bench_MatXTransposeMultiplyAddVecX,	NULL },
+	{ "MatX_TransposeMultiplySubVecX",						BENCH_MATX,			Bench_MatXTransposeMultiplySubVecX,	NULL },
+	{ "MatX_MultiplyMatX",									BENCH_MATX,			Bench_MatXMultiplyMatX,			NULL },
+	{ "MatX_TransposeMultiplyMatX",							BENCH_MATX,			Bench_MatXTransposeMultiplyMatX,	NULL },
+	{ "MatX_LowerTriangularSolve",							BENCH_MATX,			Bench_MatXLowerTriangularSolve,	NULL },
+	{ "MatX_LowerTriangularSolveTranspose",					BENCH_MATX,			Bench_MatXLowerTriangularSolveTranspose,	NULL },
+	{ "MatX_LDLTFactor",									BENCH_MATX,			Bench_MatXLDLTFactor,			Bench_ResetFactor },
+	{ "MatX_RankTwoUpdateColumn",							BENCH_MATX,			Bench_MatXRankTwoUpdateColumn,	Bench_ResetFactor },
+	{ "MatX_RankTwoUpdateRow",								BENCH_MATX,			Bench_MatXRankTwoUpdateRow,		Bench_ResetFactor },
+	{ "BlendJoints",										BENCH_JOINTS,		Bench_BlendJoints,				Bench_ResetJoints },
+	{ "ConvertJointQuatsToJointMats",						BENCH_JOINTS,		Bench_ConvertJointQuatsToJointMats,	NULL },
+	{ "ConvertJointMatsToJointQuats",						BENCH_JOINTS,		Bench_ConvertJointMatsToJointQuats,	NULL },
+	{ "TransformJoints",									BENCH_JOINTS,		Bench_TransformJoints,			Bench_ResetJoints },
+	{ "UntransformJoints",									BENCH_JOINTS,		Bench_UntransformJoints,		Bench_ResetJoints },
+	{ "TransformVerts",										BENCH_VERTS,		Bench_TransformVerts,			NULL },
+	{ "TracePointCull",										BENCH_VERTS,		Bench_TracePointCull,			NULL },
+	{ "DecalPointCull",										BENCH_VERTS,		Bench_DecalPointCull,			NULL },
+	{ "OverlayPointCull",									BENCH_VERTS,		Bench_OverlayPointCull,			NULL },
+	{ "DeriveTriPlanes",									BENCH_INDEXES,		Bench_DeriveTriPlanes,			NULL },
+	{ "DeriveTangents",										BENCH_INDEXES,		Bench_DeriveTangents,			NULL },
+	{ "DeriveUnsmoothedTangents",							BENCH_VERTS,		Bench_DeriveUnsmoothedTangents,	NULL },
+	{ "NormalizeTangents",									BENCH_VERTS,		Bench_NormalizeTangents,		NULL },
+	{ "CreateTextureSpaceLightVectors",						BENCH_INDEXES,		Bench_CreateTextureSpaceLightVectors,	NULL },
+	{ "CreateSpecularTextureCoords",						BENCH_INDEXES,		Bench_CreateSpecularTextureCoords,	NULL },
+	{ "CreateShadowCache",									BENCH_VERTS,		Bench_CreateShadowCache,		Bench_ResetVertRemap },
+	{ "CreateVertexProgramShadowCache",						BENCH_VERTS,		Bench_CreateVertexProgramShadowCache,	NULL },
+	{ "UpSamplePCMTo44kHz( 22kHz mono )",					MIXBUFFER_SAMPLES,	Bench_UpSamplePCMTo44kHz,		NULL },
+	{ "UpSampleOGGTo44kHz( 44kHz stereo )",					MIXBUFFER_SAMPLES,	Bench_UpSampleOGGTo44kHz,		NULL },
+	{ "MixSoundTwoSpeakerMono",								MIXBUFFER_SAMPLES,	Bench_MixSoundTwoSpeakerMono,	NULL },
+	{ "MixSoundTwoSpeakerStereo",							MIXBUFFER_SAMPLES,	Bench_MixSoundTwoSpeakerStereo,	NULL },
+	{ "MixSoundSixSpeakerMono",								MIXBUFFER_SAMPLES,	Bench_MixSoundSixSpeakerMono,	NULL },
+	{ "MixSoundSixSpeakerStereo",							MIXBUFFER_SAMPLES,	Bench_MixSoundSixSpeakerStereo,	NULL },
+	{ "MixedSoundToSamples",								MIXBUFFER_SAMPLES * 6,	Bench_MixedSoundToSamples,	NULL },
+	{ "SoundBiquadFilter",									MIXBUFFER_SAMPLES,	Bench_SoundBiquadFilter,		NULL },
+	{ "Dequantize( short )",								BENCH_FLOATS,		Bench_DequantizeShort,			NULL },
+	{ "Dequantize( byte )",									BENCH_FLOATS,		Bench_DequantizeByte,			NULL },
+	{ "CullBoxes",											BENCH_FLOATS / 3,	Bench_CullBoxes,				NULL },
+	{ "MipMapRGBA",											BENCH_IMAGE * BENCH_IMAGE,	Bench_MipMapRGBA,		NULL },
+	{ "MipMapNormalRGBA",									BENCH_IMAGE * BENCH_IMAGE,	Bench_MipMapNormalRGBA,	NULL },
+	{ "ResampleRGBARow",									BENCH_IMAGE,		Bench_ResampleRGBARow,			NULL },
+	{ NULL,													0,					NULL,							NULL }
+};
+
+/*
+============
+Bench_Alloc
+============
+*/
+static void *Bench_Alloc( simdBenchData_t &b, const int size ) {
+	void *ptr = Mem_Alloc16( size );
+	memset( ptr, 0, size );
+	b.allocations.Append( ptr );
+	return ptr;
+}
+
+/*
+============
+Bench_InitData
+============
+*/
+static void Bench_InitData( simdBenchData_t &b ) {
+	int i, j;
+
+	idRandom srnd( RANDOM_SEED );
+
+	b.fsrc0 = (float *) Bench_Alloc( b, BENCH_FLOATS * sizeof( float ) );
+	b.fsrc1 = (float *) Bench_Alloc( b, BENCH_FLOATS * sizeof( float ) );
+	b.fdst = (float *) Bench_Alloc( b, BENCH_FLOATS * sizeof( float ) );
+	b.bdst = (byte *) Bench_Alloc( b, BENCH_FLOATS * sizeof( byte ) );
+	for ( i = 0; i < BENCH_FLOATS; i++ ) {
+		b.fsrc0[i] = srnd.CRandomFloat() * 10.0f;
+		b.fsrc1[i] = srnd.RandomFloat() * 10.0f + 1.0f;
+	}
+
+	b.v2src = (idVec2 *) Bench_Alloc( b, BENCH_VERTS * sizeof( idVec2 ) );
+	b.v3src0 = (idVec3 *) Bench_Alloc( b, BENCH_VERTS * sizeof( idVec3 ) );
+	b.v3src1 = (idVec3 *) Bench_Alloc( b, BENCH_VERTS * sizeof( idVec3 ) );
+	b.planes = (idPlane *) Bench_Alloc( b, BENCH_VERTS * sizeof( idPlane ) );
+	b.verts = (idDrawVert *) Bench_Alloc( b, BENCH_VERTS * sizeof( idDrawVert ) );
+	b.dstVerts = (idDrawVert *) Bench_Alloc( b, BENCH_VERTS * sizeof( idDrawVert ) );
+	b.vertRemap = (int *) Bench_Alloc( b, BENCH_VERTS * sizeof( int ) );
+	b.origVertRemap = (int *) Bench_Alloc( b, BENCH_VERTS * sizeof( int ) );
+	b.vertexCache = (idVec4 *) Bench_Alloc( b, BENCH_VERTS * 2 * sizeof( idVec4 ) );
+	b.texCoords = (idVec3 *) Bench_Alloc( b, BENCH_VERTS * sizeof( idVec3 ) );
+	b.overlayCoords = (idVec2 *) Bench_Alloc( b, BENCH_VERTS * sizeof( idVec2 ) );
+	b.dominantTris = (dominantTri_s *) Bench_Alloc( b, BENCH_VERTS * sizeof( dominantTri_s ) );
+	for ( i = 0; i < BENCH_VERTS; i++ ) {
+		for ( j = 0; j < 3; j++ ) {
+			b.v3src0[i][j] = srnd.CRandomFloat() * 10.0f;
+			b.v3src1[i][j] = srnd.CRandomFloat() * 10.0f;
+			b.verts[i].xyz[j] = srnd.CRandomFloat() * 100.0f;
+			b.verts[i].normal[j] = srnd.CRandomFloat();
+			b.verts[i].tangents[0][j] = srnd.CRandomFloat();
+			b.verts[i].tangents[1][j] = srnd.CRandomFloat();
+		}
+		b.verts[i].st[0] = srnd.RandomFloat();
+		b.verts[i].st[1] = srnd.RandomFloat();
+		b.v2src[i][0] = srnd.CRandomFloat() * 10.0f;
+		b.v2src[i][1] = srnd.CRandomFloat() * 10.0f;
+		b.planes[i].SetNormal( b.v3src1[i] );
+		b.planes[i][3] = srnd.CRandomFloat() * 10.0f;
+		b.origVertRemap[i] = ( srnd.CRandomFloat() > 0.0f ) ? -1 : 0;
+		b.dominantTris[i].v2 = ( i + 1 + srnd.RandomInt( 8 ) ) % BENCH_VERTS;
+		b.dominantTris[i].v3 = ( i + 9 + srnd.RandomInt( 8 ) ) % BENCH_VERTS;
+		b.dominantTris[i].normalizationScale[0] = srnd.CRandomFloat();
+		b.dominantTris[i].normalizationScale[1] = srnd.CRandomFloat();
+		b.dominantTris[i].normalizationScale[2] = srnd.CRandomFloat();
+	}
+	memcpy( b.dstVerts, b.verts, BENCH_VERTS * sizeof( idDrawVert ) );
+	memcpy( b.vertRemap, b.origVertRemap, BENCH_VERTS * sizeof( int ) );
+
+	// triangles of neighbouring vertices like the ones of a real mesh
+	b.indexes = (int *) Bench_Alloc( b, BENCH_INDEXES * sizeof( int ) );
+	b.triPlanes = (idPlane *) Bench_Alloc( b, ( BENCH_INDEXES / 3 ) * sizeof( idPlane ) );
+	for ( i = 0; i < BENCH_INDEXES / 3; i++ ) {
+		j = ( i >> 1 ) + srnd.RandomInt( 4 );
+		b.indexes[i*3+0] = j % BENCH_VERTS;
+		b.indexes[i*3+1] = ( j + 1 ) % BENCH_VERTS;
+		b.indexes[i*3+2] = ( j + 2 + ( i & 1 ) ) % BENCH_VERTS;
+	}
+
+	b.cullPlanes[0].SetNormal( idVec3(  1,  0, 0 ) );
+	b.cullPlanes[1].SetNormal( idVec3( -1,  0, 0 ) );
+	b.cullPlanes[2].SetNormal( idVec3(  0,  1, 0 ) );
+	b.cullPlanes[3].SetNormal( idVec3(  0, -1, 0 ) );
+	b.cullPlanes[0][3] = -53.0f;
+	b.cullPlanes[1][3] = 53.0f;
+	b.cullPlanes[2][3] = -34.0f;
+	b.cullPlanes[3][3] = 34.0f;
+	b.planeConstant.SetNormal( idVec3( srnd.CRandomFloat(), srnd.CRandomFloat(), srnd.CRandomFloat() ) );
+	b.planeConstant[3] = srnd.CRandomFloat() * 10.0f;
+	b.vecConstant.Set( srnd.CRandomFloat(), srnd.CRandomFloat(), srnd.CRandomFloat() );
+	b.lightOrigin.Set( srnd.CRandomFloat() * 100.0f, srnd.CRandomFloat() * 100.0f, srnd.CRandomFloat() * 100.0f );
+	b.viewOrigin.Set( srnd.CRandomFloat() * 100.0f, srnd.CRandomFloat() * 100.0f, srnd.CRandomFloat() * 100.0f );
+
+	b.jointQuats = (idJointQuat *) Bench_Alloc( b, BENCH_JOINTS * sizeof( idJointQuat ) );
+	b.blendQuats = (idJointQuat *) Bench_Alloc( b, BENCH_JOINTS * sizeof( idJointQuat ) );
+	b.dstQuats = (idJointQuat *) Bench_Alloc( b, BENCH_JOINTS * sizeof( idJointQuat ) );
+	b.jointMats = (idJointMat *) Bench_Alloc( b, BENCH_JOINTS * sizeof( idJointMat ) );
+	b.dstMats = (idJointMat *) Bench_Alloc( b, BENCH_JOINTS * sizeof( idJointMat ) );
+	b.jointIndex = (int *) Bench_Alloc( b, BENCH_JOINTS * sizeof( int ) );
+	b.parents = (int *) Bench_Alloc( b, BENCH_JOINTS * sizeof( int ) );
+	for ( i = 0; i < BENCH_JOINTS; i++ ) {
+		idAngles angles;
+		angles[0] = srnd.CRandomFloat() * 180.0f;
+		angles[1] = srnd.CRandomFloat() * 180.0f;
+		angles[2] = srnd.CRandomFloat() * 180.0f;
+		b.jointQuats[i].q = angles.ToQuat();
+		b.jointQuats[i].t.Set( srnd.CRandomFloat() * 10.0f, srnd.CRandomFloat() * 10.0f, srnd.CRandomFloat() * 10.0f );
+		angles[0] = srnd.CRandomFloat() * 180.0f;
+		angles[1] = srnd.CRandomFloat() * 180.0f;
+		angles[2] = srnd.CRandomFloat() * 180.0f;
+		b.blendQuats[i].q = angles.ToQuat();
+		b.blendQuats[i].t.Set( srnd.CRandomFloat() * 10.0f, srnd.CRandomFloat() * 10.0f, srnd.CRandomFloat() * 10.0f );
+		b.jointMats[i].SetRotation( b.jointQuats[i].q.ToMat3() );
+		b.jointMats[i].SetTranslation( b.jointQuats[i].t );
+		b.jointIndex[i] = i;
+		// a skeleton branches into limbs of a few joints
+		b.parents[i] = ( i & 7 ) ? i - 1 : ( i >> 1 ) - 1;
+	}
+	memcpy( b.dstMats, b.jointMats, BENCH_JOINTS * sizeof( idJointMat ) );
+	memcpy( b.dstQuats, b.jointQuats, BENCH_JOINTS * sizeof( idJointQuat ) );
+
+	b.weights = (idVec4 *) Bench_Alloc( b, BENCH_WEIGHTS * sizeof( idVec4 ) );
+	b.weightIndex = (int *) Bench_Alloc( b, BENCH_WEIGHTS * 2 * sizeof( int ) );
+	for ( i = 0; i < BENCH_WEIGHTS; i++ ) {
+		b.weights[i][0] = srnd.CRandomFloat() * 2.0f;
+		b.weights[i][1] = srnd.CRandomFloat() * 2.0f;
+		b.weights[i][2] = srnd.CRandomFloat() * 2.0f;
+		b.weights[i][3] = srnd.RandomFloat();
+		b.weightIndex[i*2+0] = ( i * BENCH_JOINTS / BENCH_WEIGHTS ) * sizeof( idJointMat );
+		b.weightIndex[i*2+1] = i & 1;
+	}
+
+	b.pcm = (short *) Bench_Alloc( b, MIXBUFFER_SAMPLES * 2 * sizeof( short ) );
+	b.ogg[0] = (float *) Bench_Alloc( b, MIXBUFFER_SAMPLES * 2 * sizeof( float ) );
+	b.ogg[1] = (float *) Bench_Alloc( b, MIXBUFFER_SAMPLES * 2 * sizeof( float ) );
+	b.sndSamples = (float *) Bench_Alloc( b, MIXBUFFER_SAMPLES * 2 * sizeof( float ) );
+	b.sndDst = (float *) Bench_Alloc( b, MIXBUFFER_SAMPLES * 2 * sizeof( float ) );
+	b.mixBuffer = (float *) Bench_Alloc( b, MIXBUFFER_SAMPLES * 6 * sizeof( float ) );
+	b.outSamples = (short *) Bench_Alloc( b, MIXBUFFER_SAMPLES * 6 * sizeof( short ) );
+	for ( i = 0; i < MIXBUFFER_SAMPLES * 2; i++ ) {
+		b.pcm[i] = srnd.RandomInt( (1<<16) ) - (1<<15);
+		b.ogg[0][i] = srnd.CRandomFloat();
+		b.ogg[1][i] = srnd.CRandomFloat();
+		b.sndSamples[i] = srnd.RandomInt( (1<<16) ) - (1<<15);
+		b.sndDst[i] = b.sndSamples[i];
+	}
+	for ( i = 0; i < MIXBUFFER_SAMPLES * 6; i++ ) {
+		b.mixBuffer[i] = srnd.CRandomFloat();
+	}
+	for ( i = 0; i < 6; i++ ) {
+		b.speakerLastV[i] = srnd.RandomFloat();
+		b.speakerCurrentV[i] = srnd.RandomFloat();
+	}
+	// the lowpass of the enviro suit
+	float c = 1.0f / idMath::Tan( idMath::PI * 2000.0f / 44100.0f );
+	b.biquadCoefs[0] = 1.0f / ( 1.0f + 2.0f * c + c * c );
+	b.biquadCoefs[1] = 2.0f * b.biquadCoefs[0];
+	b.biquadCoefs[2] = b.biquadCoefs[0];
+	b.biquadCoefs[3] = 2.0f * ( 1.0f - c * c ) * b.biquadCoefs[0];
+	b.biquadCoefs[4] = ( 1.0f - 2.0f * c + c * c ) * b.biquadCoefs[0];
+	b.biquadHistory[0] = b.biquadHistory[1] = b.biquadHistory[2] = b.biquadHistory[3] = 0.0f;
+
+	b.quantized16 = (unsigned short *) Bench_Alloc( b, BENCH_FLOATS * sizeof( unsigned short ) );
+	b.quantized8 = (byte *) Bench_Alloc( b, BENCH_FLOATS * sizeof( byte ) );
+	for ( i = 0; i < BENCH_FLOATS; i++ ) {
+		b.quantized16[i] = srnd.RandomInt( 1 << 16 );
+		b.quantized8[i] = srnd.RandomInt( 1 << 8 );
+	}
+
+	b.image = (byte *) Bench_Alloc( b, BENCH_IMAGE * BENCH_IMAGE * 4 );
+	b.mip = (byte *) Bench_Alloc( b, BENCH_IMAGE * BENCH_IMAGE * 4 );
+	b.offsets0 = (unsigned int *) Bench_Alloc( b, BENCH_IMAGE * sizeof( unsigned int ) );
+	b.offsets1 = (unsigned int *) Bench_Alloc( b, BENCH_IMAGE * sizeof( unsigned int ) );
+	for ( i = 0; i < BENCH_IMAGE * BENCH_IMAGE * 4; i++ ) {
+		b.image[i] = srnd.RandomInt( 256 );
+	}
+	for ( i = 0; i < BENCH_IMAGE; i++ ) {
+		b.offsets0[i] = srnd.RandomInt( BENCH_IMAGE ) * 4;
+		b.offsets1[i] = srnd.RandomInt( BENCH_IMAGE ) * 4;
+	}
+
+	b.mat0.Random( BENCH_MATX, BENCH_MATX, 0, -1.0f, 1.0f );
+	b.mat1.Random( BENCH_MATX, BENCH_MATX, 1, -1.0f, 1.0f );
+	b.matDst.SetSize( BENCH_MATX, BENCH_MATX );
+	b.spd.SetSize( BENCH_MATX, BENCH_MATX );
+	b.mat0.TransposeMultiply( b.spd, b.mat0 );
+	b.factor = b.spd;
+	b.vecSrc.Random( BENCH_MATX, 2, -1.0f, 1.0f );
+	b.vecDst.Zero( BENCH_MATX );
+	b.invDiag.Zero( BENCH_MATX );
+	b.lower = b.spd;
+	generic->MatX_LDLTFactor( b.lower, b.invDiag, BENCH_MATX );
+	b.v1.Random( BENCH_MATX, 1, -1.0f, 1.0f );
+	b.v2.Random( BENCH_MATX, 2, -1.0f, 1.0f );
+}
+
+/*
+============
+Bench_FreeData
+============
+*/
+static void Bench_FreeData( simdBenchData_t &b ) {
+	for ( int i = 0; i < b.allocations.Num(); i++ ) {
+		Mem_Free16( b.allocations[i] );
+	}
+	b.allocations.Clear();
+}
+
+/*
+============
+Bench_CompareTicks
+============
+*/
+static int Bench_CompareTicks( const void *a, const void *b ) {
+	const double da = *(const double *)a;
+	const double db = *(const double *)b;
+	return ( da < db ) ? -1 : ( ( da > db ) ? 1 : 0 );
+}
+
+/*
+============
+Bench_TimeCalls
+
+  returns the clock ticks per call of a sample of the given number of calls
+============
+*/
+static double Bench_TimeCalls( idSIMDProcessor *p, const simdBenchKernel_t &kernel, simdBenchData_t &b, const int numCalls, const double timerTicks ) {
+	double start, end, total;
+	int i;
+
+	if ( !kernel.reset ) {
+		start = idLib::sys->GetClockTicks();
+		for ( i = 0; i < numCalls; i++ ) {
+			kernel.run( p, b );
+		}
+		end = idLib::sys->GetClockTicks();
+		return ( end - start - timerTicks ) / numCalls;
+	}
+
+	total = 0.0;
+	for ( i = 0; i < numCalls; i++ ) {
+		kernel.reset( p, b );
+		start = idLib::sys->GetClockTicks();
+		kernel.run( p, b );
+		end = idLib::sys->GetClockTicks();
+		total += end - start - timerTicks;
+	}
+	return total / numCalls;
+}
+
+/*
+============
+Bench_Kernel
+============
+*/
+static void Bench_Kernel( idSIMDProcessor *p, const simdBenchKernel_t &kernel, simdBenchData_t &b, const double timerTicks, simdBenchStats_t &stats ) {
+	double samples[BENCH_SAMPLES];
+	double minTicks, sum, sumSqr;
+	int i, numCalls;
+
+	// warm up the caches and find the number of calls that takes long enough for the clock
+	minTicks = BENCH_SAMPLE_SECONDS * idLib::sys->ClockTicksPerSecond();
+	Bench_TimeCalls( p, kernel, b, 1, timerTicks );
+	for ( numCalls = 1; numCalls < BENCH_MAX_CALLS; numCalls <<= 1 ) {
+		if ( Bench_TimeCalls( p, kernel, b, numCalls, timerTicks ) * numCalls >= minTicks ) {
+			break;
+		}
+	}
+
+	sum = 0.0;
+	for ( i = 0; i < BENCH_SAMPLES; i++ ) {
+		samples[i] = Max( Bench_TimeCalls( p, kernel, b, numCalls, timerTicks ), 0.0 );
+		sum += samples[i];
+	}
+
+	qsort( samples, BENCH_SAMPLES, sizeof( samples[0] ), Bench_CompareTicks );
+
+	stats.min = samples[0];
+	stats.median = samples[BENCH_SAMPLES / 2];
+	stats.mean = sum / BENCH_SAMPLES;
+	sumSqr = 0.0;
+	for ( i = 0; i < BENCH_SAMPLES; i++ ) {
+		sumSqr += ( samples[i] - stats.mean ) * ( samples[i] - stats.mean );
+	}
+	stats.stdDev = sqrt( sumSqr / ( BENCH_SAMPLES - 1 ) );
+}
+
+/*
+============
+Bench_CompilerName
+============
+*/
+static const char *Bench_CompilerName( void ) {
+#if defined( _MSC_VER )
+	return va( "MSVC %d", _MSC_VER );
+#elif defined( __GNUC__ )
+	return va( "GCC %d.%d.%d", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__ );
+#else
+	return "unknown";
+#endif
+}
+
+/*
+============
+idSIMD::Bench_f
+
+  benchSIMD [processor] [report.csv]
+============
+*/
+void idSIMD::Bench_f( const idCmdArgs &args ) {
+	idSIMDProcessor *p_bench;
+	simdBenchData_t *b;
+	simdBenchStats_t genericStats, simdStats;
+	idStr reportName = "benchSIMD.csv";
+	idFile *report;
+	double timerTicks, start, end, toNanoseconds;
+	int i;
+
+	p_bench = processor;
+	for ( i = 1; i < args.Argc(); i++ ) {
+		idStr arg = args.Argv( i );
+		if ( arg.CheckExtension( ".csv" ) ) {
+			reportName = arg;
+		} else {
+			p_bench = SIMD_CreateProcessor( arg );
+			if ( !p_bench ) {
+				return;
+			}
+		}
+	}
+
+	report = idLib::fileSystem->OpenFileWrite( reportName );
+	if ( !report ) {
+		idLib::common->Warning( "couldn't open %s", reportName.c_str() );
+		if ( p_bench != processor ) {
+			delete p_bench;
+		}
+		return;
+	}
+
+#ifdef _WIN32
+	SetThreadPriority( GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL );
+#endif /* _WIN32 */
+
+	b = new simdBenchData_t;
+	Bench_InitData( *b );
+
+	// the clock overhead is subtracted from every timing
+	timerTicks = idMath::INFINITY;
+	for ( i = 0; i < 1024; i++ ) {
+		start = idLib::sys->GetClockTicks();
+		end = idLib::sys->GetClockTicks();
+		timerTicks = Min( timerTicks, end - start );
+	}
+	toNanoseconds = 1e9 / idLib::sys->ClockTicksPerSecond();
+
+	idLib::common->SetRefreshOnPrint( true );
+	idLib::common->Printf( "benchmarking %s against %s, %d samples per kernel, times in nanoseconds per call\n", p_bench->GetName(), generic->GetName(), BENCH_SAMPLES );
+	idLib::common->Printf( "%-40s %8s %10s %10s %7s %6s\n", "kernel", "count", "generic", "simd", "stddev", "speed" );
+
+	report->Printf( "# processor,%s\n", p_bench->GetName() );
+	report->Printf( "# compiler,%s\n", Bench_CompilerName() );
+	report->Printf( "# build,%s %s\n", BUILD_STRING, __DATE__ );
+	report->Printf( "# samples,%d\n", BENCH_SAMPLES );
+	report->Printf( "kernel,count,generic_min_ns,generic_median_ns,generic_mean_ns,generic_stddev_ns,simd_min_ns,simd_median_ns,simd_mean_ns,simd_stddev_ns,speedup\n" );
+
+	for ( i = 0; simdBenchKernels[i].name != NULL; i++ ) {
+		const simdBenchKernel_t &kernel = simdBenchKernels[i];
+
+		Bench_Kernel( generic, kernel, *b, timerTicks, genericStats );
+		Bench_Kernel( p_bench, kernel, *b, timerTicks, simdStats );
+
+		const float speedup = ( simdStats.median > 0.0 ) ? (float)( genericStats.median / simdStats.median ) : 0.0f;
+		const float relStdDev = ( simdStats.mean > 0.0 ) ? (float)( 100.0 * simdStats.stdDev / simdStats.mean ) : 0.0f;
+
+		idLib::common->Printf( "%-40s %8d %10.0f %10.0f %6.1f%% %5.2fx\n", kernel.name, kernel.count,
+									genericStats.median * toNanoseconds, simdStats.median * toNanoseconds, relStdDev, speedup );
+
+		report->Printf( "\"%s\",%d,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.3f\n", kernel.name, kernel.count,
+							genericStats.min * toNanoseconds, genericStats.median * toNanoseconds, genericStats.mean * toNanoseconds, genericStats.stdDev * toNanoseconds,
+							simdStats.min * toNanoseconds, simdStats.median * toNanoseconds, simdStats.mean * toNanoseconds, simdStats.stdDev * toNanoseconds,
+							speedup );
+
+		if ( idLib::perfSuite != NULL ) {
+			idLib::perfSuite->AddResult( va( "simd/%s", generic->GetName() ), va( "%s medianNs", kernel.name ), genericStats.median * toNanoseconds );
+			idLib::perfSuite->AddResult( va( "simd/%s", p_bench->GetName() ), va( "%s medianNs", kernel.name ), simdStats.median * toNanoseconds );
+		}
+	}
+
+	idLib::common->Printf( "wrote %s\n", reportName.c_str() );
+	idLib::common->SetRefreshOnPrint( false );
+
+	idLib::fileSystem->CloseFile( report );
+
+	Bench_FreeData( *b );
+	delete b;
+
+	if ( p_bench != processor ) {
+		delete p_bench;
+	}
+
+#ifdef _WIN32
+	SetThreadPriority( GetCurrentThread(), THREAD_PRIORITY_NORMAL );
+#endif /* _WIN32 */
+}
@@ -37,6 +37,7 @@ public:
 	static void			InitProcessor( const char *module, bool forceGeneric );
 	static void			Shutdown( void );
 	static void			Test_f( const class idCmdArgs &args );
+	static void			Bench_f( const class idCmdArgs &args );
 };
 
 
@@ -159,6 +160,9 @@ public:
 	virtual void VPCALL MatX_LowerTriangularSolve( const idMatX &L, float *x, const float *b, const int n, int skip = 0 ) = 0;
 	virtual void VPCALL MatX_LowerTriangularSolveTranspose( const idMatX &L, float *x, const float *b, const int n ) = 0;
 	virtual bool VPCALL MatX_LDLTFactor( idMatX &mat, idVecX &invDiag, const int n ) = 0;
+	// the inner loops of the simultaneous update/downdate of a factored matrix in the LCP solvers
+	virtual void VPCALL MatX_RankTwoUpdateColumn( float *col, const int stride, float *v1, float *v2, const float p1, const float beta1, const float p2, const float beta2, const int n ) = 0;
+	virtual void VPCALL MatX_RankTwoUpdateRow( float *row, float *z0, float *z1, const float p0, const float beta0, const float q0, const float beta1, const int n ) = 0;
 
 	// rendering
 	virtual void VPCALL BlendJoints( idJointQuat *joints, const idJointQuat *blendJoints, const float lerp, const int *index, const int numJoints ) = 0;
@@ -187,6 +191,20 @@ public:
 	virtual void VPCALL MixSoundSixSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) = 0;
 	virtual void VPCALL MixSoundSixSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) = 0;
 	virtual void VPCALL MixedSoundToSamples( short *samples, const float *mixBuffer, const int numSamples ) = 0;
+	virtual void VPCALL SoundBiquadFilter( float *samples, const int numSamples, const int stride, const float coefs[5], float history[4] ) = 0;
+
+	// quantized data, dst[i] = bias[i] + src[i] * scale[i]
+	virtual void VPCALL Dequantize( float *dst, const unsigned short *src, const float *bias, const float *scale, const int count ) = 0;
+	virtual void VPCALL Dequantize( float *dst, const byte *src, const float *bias, const float *scale, const int count ) = 0;
+
+	// bounding boxes in SoA layout, centers and extents hold the x of all boxes, then the y, then the z,
+	// culled[i] is 1 if box i is completely on the front side of one of the planes, else 0
+	virtual void VPCALL CullBoxes( byte *culled, const float *centers, const float *extents, const int numBoxes, const idPlane *planes, const int numPlanes ) = 0;
+
+	// image processing, all images are RGBA bytes, the mip maps quarter an image of at least 2x2 texels
+	virtual void VPCALL MipMapRGBA( byte *dst, const byte *src, const int width, const int height ) = 0;
+	virtual void VPCALL MipMapNormalRGBA( byte *dst, const byte *src, const int width, const int height ) = 0;
+	virtual void VPCALL ResampleRGBARow( byte *dst, const byte *row0, const byte *row1, const unsigned int *offsets0, const unsigned int *offsets1, const int count ) = 0;
 };
 
 // pointer to SIMD processor
@@ -0,0 +1,803 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "Simd_Generic.h"
+#include "Simd_MMX.h"
+#include "Simd_SSE.h"
+#include "Simd_SSE2.h"
+#include "Simd_SSE3.h"
+#include "Simd_AVX.h"
+
+
+//===============================================================
+//
+//	AVX2 & FMA implementation of idSIMDProcessor
+//
+//===============================================================
+
+#if defined(_WIN32)
+
+/*
+
+	This file is compiled with /arch:AVX2 and the processor is only used when
+	CPUID reports AVX, AVX2 and FMA with OS support for the YMM state.
+
+	The kernels only use raw float pointers and intrinsics. Inline functions
+	of the math classes must not be called from here because the linker may
+	keep the AVX2 compiled copy of such a function for the whole program.
+
+	Every function ends with _mm256_zeroupper() to avoid the AVX to SSE
+	transition penalty in the SSE code that runs afterwards.
+
+*/
+
+#include <immintrin.h>
+
+// sizes and offsets in floats
+#define DRAWVERT_FLOATS				15
+#define DRAWVERT_XYZ_OFFSET			0
+#define DRAWVERT_ST_OFFSET			3
+#define DRAWVERT_NORMAL_OFFSET		5
+#define JOINTQUAT_FLOATS			7
+#define JOINTMAT_FLOATS				12
+
+/*
+============
+AVX_Transpose8x8
+============
+*/
+static ID_FORCE_INLINE void AVX_Transpose8x8( __m256 &r0, __m256 &r1, __m256 &r2, __m256 &r3, __m256 &r4, __m256 &r5, __m256 &r6, __m256 &r7 ) {
+	__m256 t0 = _mm256_unpacklo_ps( r0, r1 );
+	__m256 t1 = _mm256_unpackhi_ps( r0, r1 );
+	__m256 t2 = _mm256_unpacklo_ps( r2, r3 );
+	__m256 t3 = _mm256_unpackhi_ps( r2, r3 );
+	__m256 t4 = _mm256_unpacklo_ps( r4, r5 );
+	__m256 t5 = _mm256_unpackhi_ps( r4, r5 );
+	__m256 t6 = _mm256_unpacklo_ps( r6, r7 );
+	__m256 t7 = _mm256_unpackhi_ps( r6, r7 );
+	__m256 s0 = _mm256_shuffle_ps( t0, t2, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+	__m256 s1 = _mm256_shuffle_ps( t0, t2, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+	__m256 s2 = _mm256_shuffle_ps( t1, t3, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+	__m256 s3 = _mm256_shuffle_ps( t1, t3, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+	__m256 s4 = _mm256_shuffle_ps( t4, t6, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+	__m256 s5 = _mm256_shuffle_ps( t4, t6, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+	__m256 s6 = _mm256_shuffle_ps( t5, t7, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+	__m256 s7 = _mm256_shuffle_ps( t5, t7, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+	r0 = _mm256_permute2f128_ps( s0, s4, 0x20 );
+	r1 = _mm256_permute2f128_ps( s1, s5, 0x20 );
+	r2 = _mm256_permute2f128_ps( s2, s6, 0x20 );
+	r3 = _mm256_permute2f128_ps( s3, s7, 0x20 );
+	r4 = _mm256_permute2f128_ps( s0, s4, 0x31 );
+	r5 = _mm256_permute2f128_ps( s1, s5, 0x31 );
+	r6 = _mm256_permute2f128_ps( s2, s6, 0x31 );
+	r7 = _mm256_permute2f128_ps( s3, s7, 0x31 );
+}
+
+/*
+============
+AVX_StorePlanes8
+
+  stores eight planes from structure of arrays layout
+============
+*/
+static ID_FORCE_INLINE void AVX_StorePlanes8( float *dst, const __m256 &nx, const __m256 &ny, const __m256 &nz, const __m256 &d ) {
+	__m256 t0 = _mm256_unpacklo_ps( nx, ny );
+	__m256 t1 = _mm256_unpackhi_ps( nx, ny );
+	__m256 t2 = _mm256_unpacklo_ps( nz, d );
+	__m256 t3 = _mm256_unpackhi_ps( nz, d );
+	__m256 p0 = _mm256_shuffle_ps( t0, t2, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+	__m256 p1 = _mm256_shuffle_ps( t0, t2, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+	__m256 p2 = _mm256_shuffle_ps( t1, t3, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+	__m256 p3 = _mm256_shuffle_ps( t1, t3, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+	_mm256_storeu_ps( dst +  0, _mm256_permute2f128_ps( p0, p1, 0x20 ) );
+	_mm256_storeu_ps( dst +  8, _mm256_permute2f128_ps( p2, p3, 0x20 ) );
+	_mm256_storeu_ps( dst + 16, _mm256_permute2f128_ps( p0, p1, 0x31 ) );
+	_mm256_storeu_ps( dst + 24, _mm256_permute2f128_ps( p2, p3, 0x31 ) );
+}
+
+/*
+============
+AVX_RSqrt
+
+  reciprocal square root with one Newton-Raphson iteration, the input is clamped
+  to a tiny positive value such that degenerate vectors are scaled to zero
+============
+*/
+static ID_FORCE_INLINE __m256 AVX_RSqrt( __m256 x ) {
+	x = _mm256_max_ps( x, _mm256_set1_ps( 1e-30f ) );
+	__m256 r = _mm256_rsqrt_ps( x );
+	__m256 h = _mm256_mul_ps( _mm256_mul_ps( x, _mm256_set1_ps( 0.5f ) ), r );
+	return _mm256_mul_ps( r, _mm256_fnmadd_ps( h, r, _mm256_set1_ps( 1.5f ) ) );
+}
+
+/*
+============
+AVX_Sin16
+
+  same polynomial as idMath::Sin16 without range reduction, the angles must be in [0, PI/2]
+============
+*/
+static ID_FORCE_INLINE __m256 AVX_Sin16( const __m256 &a ) {
+	__m256 s = _mm256_mul_ps( a, a );
+	__m256 p = _mm256_fmadd_ps( _mm256_set1_ps( -2.39e-08f ), s, _mm256_set1_ps( 2.7526e-06f ) );
+	p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( -1.98409e-04f ) );
+	p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( 8.3333315e-03f ) );
+	p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( -1.666666664e-01f ) );
+	p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( 1.0f ) );
+	return _mm256_mul_ps( a, p );
+}
+
+/*
+============
+AVX_ATan16
+
+  same polynomial as idMath::ATan16( y, x ), both y and x must be positive
+============
+*/
+static ID_FORCE_INLINE __m256 AVX_ATan16( const __m256 &y, const __m256 &x ) {
+	__m256 swap = _mm256_cmp_ps( y, x, _CMP_GT_OQ );
+	__m256 a = _mm256_div_ps( _mm256_min_ps( x, y ), _mm256_max_ps( x, y ) );
+	__m256 s = _mm256_mul_ps( a, a );
+	__m256 p = _mm256_fmadd_ps( _mm256_set1_ps( 0.0028662257f ), s, _mm256_set1_ps( -0.0161657367f ) );
+	p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( 0.0429096138f ) );
+	p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( -0.0752896400f ) );
+	p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( 0.1065626393f ) );
+	p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( -0.1420889944f ) );
+	p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( 0.1999355085f ) );
+	p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( -0.3333314528f ) );
+	p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( 1.0f ) );
+	p = _mm256_mul_ps( p, a );
+	return _mm256_blendv_ps( p, _mm256_sub_ps( _mm256_set1_ps( 1.57079632679489661923f ), p ), swap );
+}
+
+/*
+============
+idSIMD_AVX::GetName
+============
+*/
+const char * idSIMD_AVX::GetName( void ) const {
+	return "MMX & SSE & SSE2 & SSE3 & AVX2 & FMA";
+}
+
+/*
+============
+AVX_StoreMinMax
+============
+*/
+static ID_FORCE_INLINE void AVX_StoreMinMax( idVec3 &min, idVec3 &max, const __m128 &vmin, const __m128 &vmax ) {
+	ALIGN16( float m[8] );
+	_mm_store_ps( m + 0, vmin );
+	_mm_store_ps( m + 4, vmax );
+	min.x = m[0];
+	min.y = m[1];
+	min.z = m[2];
+	max.x = m[4];
+	max.y = m[5];
+	max.z = m[6];
+}
+
+/*
+============
+AVX_LoadVec3
+============
+*/
+static ID_FORCE_INLINE __m128 AVX_LoadVec3( const float *p ) {
+	return _mm_movelh_ps( _mm_castpd_ps( _mm_load_sd( (const double *) p ) ), _mm_load_ss( p + 2 ) );
+}
+
+/*
+============
+idSIMD_AVX::MinMax
+============
+*/
+void VPCALL idSIMD_AVX::MinMax( idVec3 &min, idVec3 &max, const idVec3 *src, const int count ) {
+	const float *p = (const float *) src;
+	__m256 vmin = _mm256_set1_ps( idMath::INFINITY );
+	__m256 vmax = _mm256_set1_ps( -idMath::INFINITY );
+	int i;
+
+	// two vectors per register, the 16 byte loads read one float past the second vector
+	for ( i = 0; i + 2 < count; i += 2 ) {
+		__m256 v = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( p + i * 3 ) ), _mm_loadu_ps( p + i * 3 + 3 ), 1 );
+		vmin = _mm256_min_ps( vmin, v );
+		vmax = _mm256_max_ps( vmax, v );
+	}
+	__m128 min4 = _mm_min_ps( _mm256_castps256_ps128( vmin ), _mm256_extractf128_ps( vmin, 1 ) );
+	__m128 max4 = _mm_max_ps( _mm256_castps256_ps128( vmax ), _mm256_extractf128_ps( vmax, 1 ) );
+	for ( ; i < count; i++ ) {
+		__m128 v = AVX_LoadVec3( p + i * 3 );
+		min4 = _mm_min_ps( min4, v );
+		max4 = _mm_max_ps( max4, v );
+	}
+	AVX_StoreMinMax( min, max, min4, max4 );
+	_mm256_zeroupper();
+}
+
+/*
+============
+idSIMD_AVX::MinMax
+============
+*/
+void VPCALL idSIMD_AVX::MinMax( idVec3 &min, idVec3 &max, const idDrawVert *src, const int count ) {
+	const float *p = (const float *) src + DRAWVERT_XYZ_OFFSET;
+	__m256 vmin = _mm256_set1_ps( idMath::INFINITY );
+	__m256 vmax = _mm256_set1_ps( -idMath::INFINITY );
+	int i;
+
+	// the 16 byte loads read the first texture coordinate which is ignored
+	for ( i = 0; i + 1 < count; i += 2 ) {
+		__m256 v = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( p + i * DRAWVERT_FLOATS ) ), _mm_loadu_ps( p + ( i + 1 ) * DRAWVERT_FLOATS ), 1 );
+		vmin = _mm256_min_ps( vmin, v );
+		vmax = _mm256_max_ps( vmax, v );
+	}
+	__m128 min4 = _mm_min_ps( _mm256_castps256_ps128( vmin ), _mm256_extractf128_ps( vmin, 1 ) );
+	__m128 max4 = _mm_max_ps( _mm256_castps256_ps128( vmax ), _mm256_extractf128_ps( vmax, 1 ) );
+	if ( i < count ) {
+		__m128 v = _mm_loadu_ps( p + i * DRAWVERT_FLOATS );
+		min4 = _mm_min_ps( min4, v );
+		max4 = _mm_max_ps( max4, v );
+	}
+	AVX_StoreMinMax( min, max, min4, max4 );
+	_mm256_zeroupper();
+}
+
+/*
+============
+idSIMD_AVX::MinMax
+============
+*/
+void VPCALL idSIMD_AVX::MinMax( idVec3 &min, idVec3 &max, const idDrawVert *src, const int *indexes, const int count ) {
+	const float *p = (const float *) src + DRAWVERT_XYZ_OFFSET;
+	__m256 vmin = _mm256_set1_ps( idMath::INFINITY );
+	__m256 vmax = _mm256_set1_ps( -idMath::INFINITY );
+	int i;
+
+	for ( i = 0; i + 1 < count; i += 2 ) {
+		__m256 v = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( p + indexes[i+0] * DRAWVERT_FLOATS ) ), _mm_loadu_ps( p + indexes[i+1] * DRAWVERT_FLOATS ), 1 );
+		vmin = _mm256_min_ps( vmin, v );
+		vmax = _mm256_max_ps( vmax, v );
+	}
+	__m128 min4 = _mm_min_ps( _mm256_castps256_ps128( vmin ), _mm256_extractf128_ps( vmin, 1 ) );
+	__m128 max4 = _mm_max_ps( _mm256_castps256_ps128( vmax ), _mm256_extractf128_ps( vmax, 1 ) );
+	if ( i < count ) {
+		__m128 v = _mm_loadu_ps( p + indexes[i] * DRAWVERT_FLOATS );
+		min4 = _mm_min_ps( min4, v );
+		max4 = _mm_max_ps( max4, v );
+	}
+	AVX_StoreMinMax( min, max, min4, max4 );
+	_mm256_zeroupper();
+}
+
+/*
+============
+idSIMD_AVX::BlendJoints
+
+  blends eight joints at a time in structure of arrays layout
+============
+*/
+void VPCALL idSIMD_AVX::BlendJoints( idJointQuat *joints, const idJointQuat *blendJoints, const float lerp, const int *index, const int numJoints ) {
+	int i;
+
+	if ( lerp <= 0.0f ) {
+		return;
+	} else if ( lerp >= 1.0f ) {
+		for ( i = 0; i < numJoints; i++ ) {
+			int j = index[i];
+			memcpy( &joints[j], &blendJoints[j], sizeof( idJointQuat ) );
+		}
+		return;
+	}
+
+	float *jointsPtr = (float *) joints;
+	const float *blendPtr = (const float *) blendJoints;
+	const __m256i mask7 = _mm256_setr_epi32( -1, -1, -1, -1, -1, -1, -1, 0 );
+	const __m256 signBit = _mm256_set1_ps( -0.0f );
+	const __m256 one = _mm256_set1_ps( 1.0f );
+	const __m256 vlerp = _mm256_set1_ps( lerp );
+	const __m256 vlerp0 = _mm256_set1_ps( 1.0f - lerp );
+
+	for ( i = 0; i + 8 <= numJoints; i += 8 ) {
+		float *jp[8];
+		const float *bp[8];
+		for ( int k = 0; k < 8; k++ ) {
+			jp[k] = jointsPtr + index[i+k] * JOINTQUAT_FLOATS;
+			bp[k] = blendPtr + index[i+k] * JOINTQUAT_FLOATS;
+		}
+
+		__m256 fx = _mm256_maskload_ps( jp[0], mask7 );
+		__m256 fy = _mm256_maskload_ps( jp[1], mask7 );
+		__m256 fz = _mm256_maskload_ps( jp[2], mask7 );
+		__m256 fw = _mm256_maskload_ps( jp[3], mask7 );
+		__m256 ftx = _mm256_maskload_ps( jp[4], mask7 );
+		__m256 fty = _mm256_maskload_ps( jp[5], mask7 );
+		__m256 ftz = _mm256_maskload_ps( jp[6], mask7 );
+		__m256 fpad = _mm256_maskload_ps( jp[7], mask7 );
+		AVX_Transpose8x8( fx, fy, fz, fw, ftx, fty, ftz, fpad );
+
+		__m256 bx = _mm256_maskload_ps( bp[0], mask7 );
+		__m256 by = _mm256_maskload_ps( bp[1], mask7 );
+		__m256 bz = _mm256_maskload_ps( bp[2], mask7 );
+		__m256 bw = _mm256_maskload_ps( bp[3], mask7 );
+		__m256 btx = _mm256_maskload_ps( bp[4], mask7 );
+		__m256 bty = _mm256_maskload_ps( bp[5], mask7 );
+		__m256 btz = _mm256_maskload_ps( bp[6], mask7 );
+		__m256 bpad = _mm256_maskload_ps( bp[7], mask7 );
+		AVX_Transpose8x8( bx, by, bz, bw, btx, bty, btz, bpad );
+
+		// take the shortest path
+		__m256 cosom = _mm256_mul_ps( fx, bx );
+		cosom = _mm256_fmadd_ps( fy, by, cosom );
+		cosom = _mm256_fmadd_ps( fz, bz, cosom );
+		cosom = _mm256_fmadd_ps( fw, bw, cosom );
+		__m256 sign = _mm256_and_ps( cosom, signBit );
+		cosom = _mm256_xor_ps( cosom, sign );
+		bx = _mm256_xor_ps( bx, sign );
+		by = _mm256_xor_ps( by, sign );
+		bz = _mm256_xor_ps( bz, sign );
+		bw = _mm256_xor_ps( bw, sign );
+
+		__m256 scale0 = _mm256_fnmadd_ps( cosom, cosom, one );
+		__m256 sinom = AVX_RSqrt( scale0 );
+		__m256 omega = AVX_ATan16( _mm256_mul_ps( scale0, sinom ), cosom );
+		__m256 s0 = _mm256_mul_ps( AVX_Sin16( _mm256_mul_ps( vlerp0, omega ) ), sinom );
+		__m256 s1 = _mm256_mul_ps( AVX_Sin16( _mm256_mul_ps( vlerp, omega ) ), sinom );
+
+		// fall back to a linear blend when the quaternions are nearly the same
+		__m256 useSlerp = _mm256_cmp_ps( _mm256_sub_ps( one, cosom ), _mm256_set1_ps( 1e-6f ), _CMP_GT_OQ );
+		s0 = _mm256_blendv_ps( vlerp0, s0, useSlerp );
+		s1 = _mm256_blendv_ps( vlerp, s1, useSlerp );
+
+		fx = _mm256_fmadd_ps( s0, fx, _mm256_mul_ps( s1, bx ) );
+		fy = _mm256_fmadd_ps( s0, fy, _mm256_mul_ps( s1, by ) );
+		fz = _mm256_fmadd_ps( s0, fz, _mm256_mul_ps( s1, bz ) );
+		fw = _mm256_fmadd_ps( s0, fw, _mm256_mul_ps( s1, bw ) );
+
+		ftx = _mm256_fmadd_ps( vlerp, _mm256_sub_ps( btx, ftx ), ftx );
+		fty = _mm256_fmadd_ps( vlerp, _mm256_sub_ps( bty, fty ), fty );
+		ftz = _mm256_fmadd_ps( vlerp, _mm256_sub_ps( btz, ftz ), ftz );
+
+		AVX_Transpose8x8( fx, fy, fz, fw, ftx, fty, ftz, fpad );
+		_mm256_maskstore_ps( jp[0], mask7, fx );
+		_mm256_maskstore_ps( jp[1], mask7, fy );
+		_mm256_maskstore_ps( jp[2], mask7, fz );
+		_mm256_maskstore_ps( jp[3], mask7, fw );
+		_mm256_maskstore_ps( jp[4], mask7, ftx );
+		_mm256_maskstore_ps( jp[5], mask7, fty );
+		_mm256_maskstore_ps( jp[6], mask7, ftz );
+		_mm256_maskstore_ps( jp[7], mask7, fpad );
+	}
+	_mm256_zeroupper();
+
+	if ( i < numJoints ) {
+		idSIMD_SSE3::BlendJoints( joints, blendJoints, lerp, index + i, numJoints - i );
+	}
+}
+
+/*
+============
+idSIMD_AVX::ConvertJointQuatsToJointMats
+
+  converts eight joints at a time in structure of arrays layout
+============
+*/
+void VPCALL idSIMD_AVX::ConvertJointQuatsToJointMats( idJointMat *jointMats, const idJointQuat *jointQuats, const int numJoints ) {
+	const float *q = (const float *) jointQuats;
+	float *m = (float *) jointMats;
+	const __m256i mask7 = _mm256_setr_epi32( -1, -1, -1, -1, -1, -1, -1, 0 );
+	const __m256 one = _mm256_set1_ps( 1.0f );
+	int i;
+
+	for ( i = 0; i + 8 <= numJoints; i += 8 ) {
+		// the eighth load must not read past the last joint
+		__m256 x = _mm256_loadu_ps( q + 0 * JOINTQUAT_FLOATS );
+		__m256 y = _mm256_loadu_ps( q + 1 * JOINTQUAT_FLOATS );
+		__m256 z = _mm256_loadu_ps( q + 2 * JOINTQUAT_FLOATS );
+		__m256 w = _mm256_loadu_ps( q + 3 * JOINTQUAT_FLOATS );
+		__m256 tx = _mm256_loadu_ps( q + 4 * JOINTQUAT_FLOATS );
+		__m256 ty = _mm256_loadu_ps( q + 5 * JOINTQUAT_FLOATS );
+		__m256 tz = _mm256_loadu_ps( q + 6 * JOINTQUAT_FLOATS );
+		__m256 pad = _mm256_maskload_ps( q + 7 * JOINTQUAT_FLOATS, mask7 );
+		AVX_Transpose8x8( x, y, z, w, tx, ty, tz, pad );
+
+		__m256 x2 = _mm256_add_ps( x, x );
+		__m256 y2 = _mm256_add_ps( y, y );
+		__m256 z2 = _mm256_add_ps( z, z );
+
+		__m256 xx = _mm256_mul_ps( x, x2 );
+		__m256 xy = _mm256_mul_ps( x, y2 );
+		__m256 xz = _mm256_mul_ps( x, z2 );
+		__m256 yy = _mm256_mul_ps( y, y2 );
+		__m256 yz = _mm256_mul_ps( y, z2 );
+		__m256 zz = _mm256_mul_ps( z, z2 );
+		__m256 wx = _mm256_mul_ps( w, x2 );
+		__m256 wy = _mm256_mul_ps( w, y2 );
+		__m256 wz = _mm256_mul_ps( w, z2 );
+
+		__m256 m00 = _mm256_sub_ps( one, _mm256_add_ps( yy, zz ) );
+		__m256 m01 = _mm256_add_ps( xy, wz );
+		__m256 m02 = _mm256_sub_ps( xz, wy );
+		__m256 m10 = _mm256_sub_ps( xy, wz );
+		__m256 m11 = _mm256_sub_ps( one, _mm256_add_ps( xx, zz ) );
+		__m256 m12 = _mm256_add_ps( yz, wx );
+		__m256 m20 = _mm256_add_ps( xz, wy );
+		__m256 m21 = _mm256_sub_ps( yz, wx );
+		__m256 m22 = _mm256_sub_ps( one, _mm256_add_ps( xx, yy ) );
+
+		// the first two rows of each joint
+		AVX_Transpose8x8( m00, m01, m02, tx, m10, m11, m12, ty );
+		_mm256_storeu_ps( m + 0 * JOINTMAT_FLOATS, m00 );
+		_mm256_storeu_ps( m + 1 * JOINTMAT_FLOATS, m01 );
+		_mm256_storeu_ps( m + 2 * JOINTMAT_FLOATS, m02 );
+		_mm256_storeu_ps( m + 3 * JOINTMAT_FLOATS, tx );
+		_mm256_storeu_ps( m + 4 * JOINTMAT_FLOATS, m10 );
+		_mm256_storeu_ps( m + 5 * JOINTMAT_FLOATS, m11 );
+		_mm256_storeu_ps( m + 6 * JOINTMAT_FLOATS, m12 );
+		_mm256_storeu_ps( m + 7 * JOINTMAT_FLOATS, ty );
+
+		// the third row of each joint
+		__m256 t0 = _mm256_unpacklo_ps( m20, m21 );
+		__m256 t1 = _mm256_unpackhi_ps( m20, m21 );
+		__m256 t2 = _mm256_unpacklo_ps( m22, tz );
+		__m256 t3 = _mm256_unpackhi_ps( m22, tz );
+		__m256 r0 = _mm256_shuffle_ps( t0, t2, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+		__m256 r1 = _mm256_shuffle_ps( t0, t2, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+		__m256 r2 = _mm256_shuffle_ps( t1, t3, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+		__m256 r3 = _mm256_shuffle_ps( t1, t3, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+		_mm_storeu_ps( m + 0 * JOINTMAT_FLOATS + 8, _mm256_castps256_ps128( r0 ) );
+		_mm_storeu_ps( m + 1 * JOINTMAT_FLOATS + 8, _mm256_castps256_ps128( r1 ) );
+		_mm_storeu_ps( m + 2 * JOINTMAT_FLOATS + 8, _mm256_castps256_ps128( r2 ) );
+		_mm_storeu_ps( m + 3 * JOINTMAT_FLOATS + 8, _mm256_castps256_ps128( r3 ) );
+		_mm_storeu_ps( m + 4 * JOINTMAT_FLOATS + 8, _mm256_extractf128_ps( r0, 1 ) );
+		_mm_storeu_ps( m + 5 * JOINTMAT_FLOATS + 8, _mm256_extractf128_ps( r1, 1 ) );
+		_mm_storeu_ps( m + 6 * JOINTMAT_FLOATS + 8, _mm256_extractf128_ps( r2, 1 ) );
+		_mm_storeu_ps( m + 7 * JOINTMAT_FLOATS + 8, _mm256_extractf128_ps( r3, 1 ) );
+
+		q += 8 * JOINTQUAT_FLOATS;
+		m += 8 * JOINTMAT_FLOATS;
+	}
+	_mm256_zeroupper();
+
+	if ( i < numJoints ) {
+		idSIMD_SSE3::ConvertJointQuatsToJointMats( jointMats + i, jointQuats + i, numJoints - i );
+	}
+}
+
+/*
+============
+idSIMD_AVX::TransformJoints
+============
+*/
+void VPCALL idSIMD_AVX::TransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint ) {
+	float *mats = (float *) jointMats;
+	const __m256 zero = _mm256_setzero_ps();
+
+	for ( int i = firstJoint; i <= lastJoint; i++ ) {
+		assert( parents[i] < i );
+		float *c = mats + i * JOINTMAT_FLOATS;
+		const float *p = mats + parents[i] * JOINTMAT_FLOATS;
+
+		__m256 row0 = _mm256_broadcast_ps( (const __m128 *) ( c + 0 ) );
+		__m256 row1 = _mm256_broadcast_ps( (const __m128 *) ( c + 4 ) );
+		__m256 row2 = _mm256_broadcast_ps( (const __m128 *) ( c + 8 ) );
+
+		// the first two rows of the result
+		__m256 p01 = _mm256_loadu_ps( p );
+		__m256 r01 = _mm256_blend_ps( zero, p01, 0x88 );
+		r01 = _mm256_fmadd_ps( _mm256_permute_ps( p01, _MM_SHUFFLE( 0, 0, 0, 0 ) ), row0, r01 );
+		r01 = _mm256_fmadd_ps( _mm256_permute_ps( p01, _MM_SHUFFLE( 1, 1, 1, 1 ) ), row1, r01 );
+		r01 = _mm256_fmadd_ps( _mm256_permute_ps( p01, _MM_SHUFFLE( 2, 2, 2, 2 ) ), row2, r01 );
+
+		// the third row of the result
+		__m128 p2 = _mm_loadu_ps( p + 8 );
+		__m128 r2 = _mm_blend_ps( _mm_setzero_ps(), p2, 0x08 );
+		r2 = _mm_fmadd_ps( _mm_permute_ps( p2, _MM_SHUFFLE( 0, 0, 0, 0 ) ), _mm256_castps256_ps128( row0 ), r2 );
+		r2 = _mm_fmadd_ps( _mm_permute_ps( p2, _MM_SHUFFLE( 1, 1, 1, 1 ) ), _mm256_castps256_ps128( row1 ), r2 );
+		r2 = _mm_fmadd_ps( _mm_permute_ps( p2, _MM_SHUFFLE( 2, 2, 2, 2 ) ), _mm256_castps256_ps128( row2 ), r2 );
+
+		_mm256_storeu_ps( c, r01 );
+		_mm_storeu_ps( c + 8, r2 );
+	}
+	_mm256_zeroupper();
+}
+
+/*
+============
+idSIMD_AVX::TransformVerts
+============
+*/
+void VPCALL idSIMD_AVX::TransformVerts( idDrawVert *verts, const int numVerts, const idJointMat *joints, const idVec4 *weights, const int *index, const int numWeights ) {
+	const byte *jointsPtr = (const byte *) joints;
+	const float *weightsPtr = (const float *) weights;
+	float *vertsPtr = (float *) verts + DRAWVERT_XYZ_OFFSET;
+	int i, j;
+
+	for ( j = i = 0; i < numVerts; i++ ) {
+		__m256 acc01 = _mm256_setzero_ps();
+		__m128 acc2 = _mm_setzero_ps();
+
+		for ( ; ; j++ ) {
+			const float *mat = (const float *) ( jointsPtr + index[j*2+0] );
+			__m256 w = _mm256_broadcast_ps( (const __m128 *) ( weightsPtr + j * 4 ) );
+			acc01 = _mm256_fmadd_ps( _mm256_loadu_ps( mat ), w, acc01 );
+			acc2 = _mm_fmadd_ps( _mm_loadu_ps( mat + 8 ), _mm256_castps256_ps128( w ), acc2 );
+			if ( index[j*2+1] != 0 ) {
+				j++;
+				break;
+			}
+		}
+
+		// horizontal sums of the three rows
+		__m128 r01 = _mm_hadd_ps( _mm256_castps256_ps128( acc01 ), _mm256_extractf128_ps( acc01, 1 ) );
+		__m128 r22 = _mm_hadd_ps( acc2, acc2 );
+		__m128 xyz = _mm_hadd_ps( r01, r22 );
+
+		float *v = vertsPtr + i * DRAWVERT_FLOATS;
+		_mm_storel_pi( (__m64 *) v, xyz );
+		_mm_store_ss( v + 2, _mm_movehl_ps( xyz, xyz ) );
+	}
+	_mm256_zeroupper();
+}
+
+/*
+============
+AVX_LoadTriangles8
+
+  loads the first vertex and the edge vectors of eight triangles in structure of arrays layout
+============
+*/
+static ID_FORCE_INLINE void AVX_LoadTriangles8( const float *v, const int *indexes,
+						__m256 &ax, __m256 &ay, __m256 &az, __m256 &d0x, __m256 &d0y, __m256 &d0z, __m256 &d1x, __m256 &d1y, __m256 &d1z,
+						__m256i &ia, __m256i &ib, __m256i &ic ) {
+	const __m256i stride = _mm256_setr_epi32( 0, 3, 6, 9, 12, 15, 18, 21 );
+	const __m256i vertFloats = _mm256_set1_epi32( DRAWVERT_FLOATS );
+
+	ia = _mm256_mullo_epi32( _mm256_i32gather_epi32( indexes + 0, stride, 4 ), vertFloats );
+	ib = _mm256_mullo_epi32( _mm256_i32gather_epi32( indexes + 1, stride, 4 ), vertFloats );
+	ic = _mm256_mullo_epi32( _mm256_i32gather_epi32( indexes + 2, stride, 4 ), vertFloats );
+
+	ax = _mm256_i32gather_ps( v + DRAWVERT_XYZ_OFFSET + 0, ia, 4 );
+	ay = _mm256_i32gather_ps( v + DRAWVERT_XYZ_OFFSET + 1, ia, 4 );
+	az = _mm256_i32gather_ps( v + DRAWVERT_XYZ_OFFSET + 2, ia, 4 );
+
+	d0x = _mm256_sub_ps( _mm256_i32gather_ps( v + DRAWVERT_XYZ_OFFSET + 0, ib, 4 ), ax );
+	d0y = _mm256_sub_ps( _mm256_i32gather_ps( v + DRAWVERT_XYZ_OFFSET + 1, ib, 4 ), ay );
+	d0z = _mm256_sub_ps( _mm256_i32gather_ps( v + DRAWVERT_XYZ_OFFSET + 2, ib, 4 ), az );
+
+	d1x = _mm256_sub_ps( _mm256_i32gather_ps( v + DRAWVERT_XYZ_OFFSET + 0, ic, 4 ), ax );
+	d1y = _mm256_sub_ps( _mm256_i32gather_ps( v + DRAWVERT_XYZ_OFFSET + 1, ic, 4 ), ay );
+	d1z = _mm256_sub_ps( _mm256_i32gather_ps( v + DRAWVERT_XYZ_OFFSET + 2, ic, 4 ), az );
+}
+
+/*
+============
+AVX_TrianglePlanes8
+
+  derives the planes of eight triangles in structure of arrays layout
+============
+*/
+static ID_FORCE_INLINE void AVX_TrianglePlanes8( const __m256 &ax, const __m256 &ay, const __m256 &az,
+						const __m256 &d0x, const __m256 &d0y, const __m256 &d0z, const __m256 &d1x, const __m256 &d1y, const __m256 &d1z,
+						__m256 &nx, __m256 &ny, __m256 &nz, __m256 &nd ) {
+	nx = _mm256_fmsub_ps( d1y, d0z, _mm256_mul_ps( d1z, d0y ) );
+	ny = _mm256_fmsub_ps( d1z, d0x, _mm256_mul_ps( d1x, d0z ) );
+	nz = _mm256_fmsub_ps( d1x, d0y, _mm256_mul_ps( d1y, d0x ) );
+
+	__m256 f = AVX_RSqrt( _mm256_fmadd_ps( nz, nz, _mm256_fmadd_ps( ny, ny, _mm256_mul_ps( nx, nx ) ) ) );
+	nx = _mm256_mul_ps( nx, f );
+	ny = _mm256_mul_ps( ny, f );
+	nz = _mm256_mul_ps( nz, f );
+
+	nd = _mm256_fmadd_ps( nz, az, _mm256_fmadd_ps( ny, ay, _mm256_mul_ps( nx, ax ) ) );
+	nd = _mm256_xor_ps( nd, _mm256_set1_ps( -0.0f ) );
+}
+
+/*
+============
+idSIMD_AVX::DeriveTriPlanes
+
+  derives the planes of eight triangles at a time
+============
+*/
+void VPCALL idSIMD_AVX::DeriveTriPlanes( idPlane *planes, const idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+	const float *v = (const float *) verts;
+	float *p = (float *) planes;
+	const int numTris = numIndexes / 3;
+
+	for ( int i = 0; i < numTris; i += 8 ) {
+		const int count = ( numTris - i < 8 ) ? numTris - i : 8;
+		const int *tri = indexes + i * 3;
+		ALIGN16( int padded[8*3] );
+		ALIGN16( float tmp[8*4] );
+
+		// the last triangles are padded with the first vertex
+		if ( count < 8 ) {
+			memset( padded, 0, sizeof( padded ) );
+			memcpy( padded, tri, count * 3 * sizeof( int ) );
+			tri = padded;
+		}
+
+		__m256 ax, ay, az, d0x, d0y, d0z, d1x, d1y, d1z;
+		__m256i ia, ib, ic;
+		AVX_LoadTriangles8( v, tri, ax, ay, az, d0x, d0y, d0z, d1x, d1y, d1z, ia, ib, ic );
+
+		__m256 nx, ny, nz, nd;
+		AVX_TrianglePlanes8( ax, ay, az, d0x, d0y, d0z, d1x, d1y, d1z, nx, ny, nz, nd );
+
+		if ( count == 8 ) {
+			AVX_StorePlanes8( p + i * 4, nx, ny, nz, nd );
+		} else {
+			AVX_StorePlanes8( tmp, nx, ny, nz, nd );
+			memcpy( p + i * 4, tmp, count * 4 * sizeof( float ) );
+		}
+	}
+	_mm256_zeroupper();
+}
+
+/*
+============
+idSIMD_AVX::DeriveTangents
+
+  Derives the normal and orthogonal tangent vectors for the triangle vertices.
+  The vectors of eight triangles are derived at a time and then added to the
+  vertices in triangle order such that the result does not depend on the
+  vertex sharing between the triangles.
+============
+*/
+void VPCALL idSIMD_AVX::DeriveTangents( idPlane *planes, idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+	float *v = (float *) verts;
+	float *p = (float *) planes;
+	const int numTris = numIndexes / 3;
+	const __m256 signMask = _mm256_set1_ps( -0.0f );
+
+	bool *used = (bool *)_alloca16( numVerts * sizeof( used[0] ) );
+	memset( used, 0, numVerts * sizeof( used[0] ) );
+
+	for ( int i = 0; i < numTris; i += 8 ) {
+		const int count = ( numTris - i < 8 ) ? numTris - i : 8;
+		const int *tri = indexes + i * 3;
+		ALIGN16( int padded[8*3] );
+		ALIGN16( float tmp[8*4] );
+		ALIGN16( float t1z[8] );
+
+		if ( count < 8 ) {
+			memset( padded, 0, sizeof( padded ) );
+			memcpy( padded, tri, count * 3 * sizeof( int ) );
+			tri = padded;
+		}
+
+		__m256 ax, ay, az, d0x, d0y, d0z, d1x, d1y, d1z;
+		__m256i ia, ib, ic;
+		AVX_LoadTriangles8( v, tri, ax, ay, az, d0x, d0y, d0z, d1x, d1y, d1z, ia, ib, ic );
+
+		__m256 as = _mm256_i32gather_ps( v + DRAWVERT_ST_OFFSET + 0, ia, 4 );
+		__m256 at = _mm256_i32gather_ps( v + DRAWVERT_ST_OFFSET + 1, ia, 4 );
+		__m256 d0s = _mm256_sub_ps( _mm256_i32gather_ps( v + DRAWVERT_ST_OFFSET + 0, ib, 4 ), as );
+		__m256 d0t = _mm256_sub_ps( _mm256_i32gather_ps( v + DRAWVERT_ST_OFFSET + 1, ib, 4 ), at );
+		__m256 d1s = _mm256_sub_ps( _mm256_i32gather_ps( v + DRAWVERT_ST_OFFSET + 0, ic, 4 ), as );
+		__m256 d1t = _mm256_sub_ps( _mm256_i32gather_ps( v + DRAWVERT_ST_OFFSET + 1, ic, 4 ), at );
+
+		// normal and plane
+		__m256 nx, ny, nz, nd;
+		AVX_TrianglePlanes8( ax, ay, az, d0x, d0y, d0z, d1x, d1y, d1z, nx, ny, nz, nd );
+
+		if ( count == 8 ) {
+			AVX_StorePlanes8( p + i * 4, nx, ny, nz, nd );
+		} else {
+			AVX_StorePlanes8( tmp, nx, ny, nz, nd );
+			memcpy( p + i * 4, tmp, count * 4 * sizeof( float ) );
+		}
+
+		// area sign bit
+		__m256 signBit = _mm256_and_ps( _mm256_fmsub_ps( d0s, d1t, _mm256_mul_ps( d0t, d1s ) ), signMask );
+
+		// first tangent
+		__m256 t0x = _mm256_fmsub_ps( d0x, d1t, _mm256_mul_ps( d0t, d1x ) );
+		__m256 t0y = _mm256_fmsub_ps( d0y, d1t, _mm256_mul_ps( d0t, d1y ) );
+		__m256 t0z = _mm256_fmsub_ps( d0z, d1t, _mm256_mul_ps( d0t, d1z ) );
+		__m256 f = AVX_RSqrt( _mm256_fmadd_ps( t0z, t0z, _mm256_fmadd_ps( t0y, t0y, _mm256_mul_ps( t0x, t0x ) ) ) );
+		f = _mm256_xor_ps( f, signBit );
+		t0x = _mm256_mul_ps( t0x, f );
+		t0y = _mm256_mul_ps( t0y, f );
+		t0z = _mm256_mul_ps( t0z, f );
+
+		// second tangent
+		__m256 t1x = _mm256_fmsub_ps( d0s, d1x, _mm256_mul_ps( d0x, d1s ) );
+		__m256 t1y = _mm256_fmsub_ps( d0s, d1y, _mm256_mul_ps( d0y, d1s ) );
+		__m256 t1zv = _mm256_fmsub_ps( d0s, d1z, _mm256_mul_ps( d0z, d1s ) );
+		f = AVX_RSqrt( _mm256_fmadd_ps( t1zv, t1zv, _mm256_fmadd_ps( t1y, t1y, _mm256_mul_ps( t1x, t1x ) ) ) );
+		f = _mm256_xor_ps( f, signBit );
+		t1x = _mm256_mul_ps( t1x, f );
+		t1y = _mm256_mul_ps( t1y, f );
+		_mm256_store_ps( t1z, _mm256_mul_ps( t1zv, f ) );
+
+		// one register per triangle with the normal, the first tangent and two components of the second tangent
+		AVX_Transpose8x8( nx, ny, nz, t0x, t0y, t0z, t1x, t1y );
+		const __m256 tri8[8] = { nx, ny, nz, t0x, t0y, t0z, t1x, t1y };
+
+		for ( int k = 0; k < count; k++ ) {
+			for ( int l = 0; l < 3; l++ ) {
+				const int vi = tri[k*3+l];
+				float *n = v + vi * DRAWVERT_FLOATS + DRAWVERT_NORMAL_OFFSET;
+				if ( used[vi] ) {
+					_mm256_storeu_ps( n, _mm256_add_ps( _mm256_loadu_ps( n ), tri8[k] ) );
+					n[8] += t1z[k];
+				} else {
+					_mm256_storeu_ps( n, tri8[k] );
+					n[8] = t1z[k];
+					used[vi] = true;
+				}
+			}
+		}
+	}
+	_mm256_zeroupper();
+}
+
+/*
+============
+idSIMD_AVX::CreateShadowCache
+============
+*/
+int VPCALL idSIMD_AVX::CreateShadowCache( idVec4 *vertexCache, int *vertRemap, const idVec3 &lightOrigin, const idDrawVert *verts, const int numVerts ) {
+	const float *v = (const float *) verts + DRAWVERT_XYZ_OFFSET;
+	float *cache = (float *) vertexCache;
+	const __m128 light = _mm_setr_ps( lightOrigin.x, lightOrigin.y, lightOrigin.z, 0.0f );
+	const __m128 oneW = _mm_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f );
+	const __m128 zero = _mm_setzero_ps();
+	int outVerts = 0;
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		if ( vertRemap[i] ) {
+			continue;
+		}
+		// the 16 byte load reads the first texture coordinate which is replaced
+		__m128 xyz = _mm_loadu_ps( v + i * DRAWVERT_FLOATS );
+		__m128 capVert = _mm_blend_ps( xyz, oneW, 0x08 );
+		__m128 extrudedVert = _mm_blend_ps( _mm_sub_ps( xyz, light ), zero, 0x08 );
+		_mm256_storeu_ps( cache + outVerts * 4, _mm256_insertf128_ps( _mm256_castps128_ps256( capVert ), extrudedVert, 1 ) );
+		vertRemap[i] = outVerts;
+		outVerts += 2;
+	}
+	_mm256_zeroupper();
+	return outVerts;
+}
+
+/*
+============
+idSIMD_AVX::CreateVertexProgramShadowCache
+============
+*/
+int VPCALL idSIMD_AVX::CreateVertexProgramShadowCache( idVec4 *vertexCache, const idDrawVert *verts, const int numVerts ) {
+	const float *v = (const float *) verts + DRAWVERT_XYZ_OFFSET;
+	float *cache = (float *) vertexCache;
+	const __m256 w10 = _mm256_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f );
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		__m128 xyz = _mm_loadu_ps( v + i * DRAWVERT_FLOATS );
+		__m256 xyz2 = _mm256_insertf128_ps( _mm256_castps128_ps256( xyz ), xyz, 1 );
+		_mm256_storeu_ps( cache + i * 8, _mm256_blend_ps( xyz2, w10, 0x88 ) );
+	}
+	_mm256_zeroupper();
+	return numVerts * 2;
+}
+
+#endif /* _WIN32 */
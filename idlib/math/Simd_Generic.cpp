@@ -2229,6 +2229,83 @@ bool VPCALL idSIMD_Generic::MatX_LDLTFactor( idMatX &mat, idVecX &invDiag, const
 #endif
 }
 
+/*
+============
+idSIMD_Generic::MatX_RankTwoUpdateColumn
+
+  updates n elements of a matrix column with the given stride together with v1 and v2:
+    v1[j] -= p1 * col[j*stride];
+    col[j*stride] += beta1 * v1[j];
+    v2[j] -= p2 * col[j*stride];
+    col[j*stride] += beta2 * v2[j];
+============
+*/
+void VPCALL idSIMD_Generic::MatX_RankTwoUpdateColumn( float *col, const int stride, float *v1, float *v2, const float p1, const float beta1, const float p2, const float beta2, const int n ) {
+	int j;
+
+	for ( j = 0; j < n - 1; j += 2 ) {
+
+		float sum0 = col[(j+0)*stride];
+		float sum1 = col[(j+1)*stride];
+
+		v1[j+0] -= p1 * sum0;
+		v1[j+1] -= p1 * sum1;
+
+		sum0 += beta1 * v1[j+0];
+		sum1 += beta1 * v1[j+1];
+
+		v2[j+0] -= p2 * sum0;
+		v2[j+1] -= p2 * sum1;
+
+		sum0 += beta2 * v2[j+0];
+		sum1 += beta2 * v2[j+1];
+
+		col[(j+0)*stride] = sum0;
+		col[(j+1)*stride] = sum1;
+	}
+
+	for ( ; j < n; j++ ) {
+
+		float sum = col[j*stride];
+
+		v1[j] -= p1 * sum;
+		sum += beta1 * v1[j];
+
+		v2[j] -= p2 * sum;
+		sum += beta2 * v2[j];
+
+		col[j*stride] = sum;
+	}
+}
+
+/*
+============
+idSIMD_Generic::MatX_RankTwoUpdateRow
+
+  updates n elements of a matrix row together with z0 and z1:
+    row[j] += p0 * z0[j];
+    z0[j] -= beta0 * row[j];
+    row[j] += q0 * z1[j];
+    z1[j] -= beta1 * row[j];
+============
+*/
+void VPCALL idSIMD_Generic::MatX_RankTwoUpdateRow( float *row, float *z0, float *z1, const float p0, const float beta0, const float q0, const float beta1, const int n ) {
+	int j;
+
+	for ( j = 0; j < n; j++ ) {
+
+		float d = row[j];
+
+		d += p0 * z0[j];
+		z0[j] -= beta0 * d;
+
+		d += q0 * z1[j];
+		z1[j] -= beta1 * d;
+
+		row[j] = d;
+	}
+}
+
 /*
 ============
 idSIMD_Generic::BlendJoints
@@ -3048,3 +3125,166 @@ void VPCALL idSIMD_Generic::MixedSoundToSamples( short *samples, const float *mi
 		}
 	}
 }
+
+/*
+============
+idSIMD_Generic::SoundBiquadFilter
+
+  filters every stride'th sample in place with
+  y[n] = c0 * x[n] + c1 * x[n-1] + c2 * x[n-2] - c3 * y[n-1] - c4 * y[n-2]
+  history holds x[-1], x[-2], y[-1] and y[-2] and is updated for the next call
+============
+*/
+void VPCALL idSIMD_Generic::SoundBiquadFilter( float *samples, const int numSamples, const int stride, const float coefs[5], float history[4] ) {
+	float x1 = history[0];
+	float x2 = history[1];
+	float y1 = history[2];
+	float y2 = history[3];
+
+	for ( int i = 0; i < numSamples; i++ ) {
+		const float x = samples[i * stride];
+		const float y = coefs[0] * x + coefs[1] * x1 + coefs[2] * x2 - coefs[3] * y1 - coefs[4] * y2;
+		x2 = x1;
+		x1 = x;
+		y2 = y1;
+		y1 = y;
+		samples[i * stride] = y;
+	}
+
+	history[0] = x1;
+	history[1] = x2;
+	history[2] = y1;
+	history[3] = y2;
+}
+
+/*
+============
+idSIMD_Generic::Dequantize
+
+  dst[i] = bias[i] + src[i] * scale[i];
+============
+*/
+void VPCALL idSIMD_Generic::Dequantize( float *dst, const unsigned short *src, const float *bias, const float *scale, const int count ) {
+	for ( int i = 0; i < count; i++ ) {
+		dst[i] = bias[i] + src[i] * scale[i];
+	}
+}
+
+/*
+============
+idSIMD_Generic::Dequantize
+
+  dst[i] = bias[i] + src[i] * scale[i];
+============
+*/
+void VPCALL idSIMD_Generic::Dequantize( float *dst, const byte *src, const float *bias, const float *scale, const int count ) {
+	for ( int i = 0; i < count; i++ ) {
+		dst[i] = bias[i] + src[i] * scale[i];
+	}
+}
+
+/*
+============
+idSIMD_Generic::CullBoxes
+
+  a box is culled if its center is farther in front of a plane than the
+  extents reach along the plane normal
+============
+*/
+void VPCALL idSIMD_Generic::CullBoxes( byte *culled, const float *centers, const float *extents, const int numBoxes, const idPlane *planes, const int numPlanes ) {
+	const float *centerX = centers, *centerY = centers + numBoxes, *centerZ = centers + numBoxes * 2;
+	const float *extentX = extents, *extentY = extents + numBoxes, *extentZ = extents + numBoxes * 2;
+
+	for ( int i = 0; i < numBoxes; i++ ) {
+		culled[i] = 0;
+		for ( int j = 0; j < numPlanes; j++ ) {
+			const idPlane &p = planes[j];
+			float d = p[0] * centerX[i] + p[1] * centerY[i] + p[2] * centerZ[i] + p[3];
+			float r = idMath::Fabs( p[0] ) * extentX[i] + idMath::Fabs( p[1] ) * extentY[i] + idMath::Fabs( p[2] ) * extentZ[i];
+			if ( d - r > 0.0f ) {
+				culled[i] = 1;
+				break;
+			}
+		}
+	}
+}
+
+/*
+============
+idSIMD_Generic::MipMapRGBA
+
+  box filters each 2x2 block of texels into one, width and height are the size of src
+============
+*/
+void VPCALL idSIMD_Generic::MipMapRGBA( byte *dst, const byte *src, const int width, const int height ) {
+	const int row = width * 4;
+	const int newWidth = width >> 1;
+	const int newHeight = height >> 1;
+
+	for ( int i = 0; i < newHeight; i++ ) {
+		const byte *in = src + i * 2 * row;
+		for ( int j = 0; j < newWidth; j++, in += 8, dst += 4 ) {
+			dst[0] = ( in[0] + in[4] + in[row+0] + in[row+4] ) >> 2;
+			dst[1] = ( in[1] + in[5] + in[row+1] + in[row+5] ) >> 2;
+			dst[2] = ( in[2] + in[6] + in[row+2] + in[row+6] ) >> 2;
+			dst[3] = ( in[3] + in[7] + in[row+3] + in[row+7] ) >> 2;
+		}
+	}
+}
+
+/*
+============
+idSIMD_Generic::MipMapNormalRGBA
+
+  like MipMapRGBA, but renormalizes the average of the normals encoded in RGB
+============
+*/
+void VPCALL idSIMD_Generic::MipMapNormalRGBA( byte *dst, const byte *src, const int width, const int height ) {
+	const int row = width * 4;
+	const int newWidth = width >> 1;
+	const int newHeight = height >> 1;
+
+	for ( int i = 0; i < newHeight; i++ ) {
+		const byte *in = src + i * 2 * row;
+		for ( int j = 0; j < newWidth; j++, in += 8, dst += 4 ) {
+			// the sum of the four normals, scaled by 255
+			float x = (float)( ( in[0] + in[4] + in[row+0] + in[row+4] ) * 2 - 4 * 255 );
+			float y = (float)( ( in[1] + in[5] + in[row+1] + in[row+5] ) * 2 - 4 * 255 );
+			float z = (float)( ( in[2] + in[6] + in[row+2] + in[row+6] ) * 2 - 4 * 255 );
+			float lengthSqr = x * x + y * y + z * z;
+
+			if ( lengthSqr == 0.0f ) {
+				// opposite normals cancelled out
+				dst[0] = 128;
+				dst[1] = 128;
+				dst[2] = 255;
+			} else {
+				float scale = 127.5f / sqrtf( lengthSqr );
+				dst[0] = (byte)( x * scale + 128.0f );
+				dst[1] = (byte)( y * scale + 128.0f );
+				dst[2] = (byte)( z * scale + 128.0f );
+			}
+			dst[3] = ( in[3] + in[7] + in[row+3] + in[row+7] ) >> 2;
+		}
+	}
+}
+
+/*
+============
+idSIMD_Generic::ResampleRGBARow
+
+  averages the texels at the byte offsets0 and offsets1 of two source rows
+============
+*/
+void VPCALL idSIMD_Generic::ResampleRGBARow( byte *dst, const byte *row0, const byte *row1, const unsigned int *offsets0, const unsigned int *offsets1, const int count ) {
+	for ( int i = 0; i < count; i++, dst += 4 ) {
+		const byte *pix1 = row0 + offsets0[i];
+		const byte *pix2 = row0 + offsets1[i];
+		const byte *pix3 = row1 + offsets0[i];
+		const byte *pix4 = row1 + offsets1[i];
+		dst[0] = ( pix1[0] + pix2[0] + pix3[0] + pix4[0] ) >> 2;
+		dst[1] = ( pix1[1] + pix2[1] + pix3[1] + pix4[1] ) >> 2;
+		dst[2] = ( pix1[2] + pix2[2] + pix3[2] + pix4[2] ) >> 2;
+		dst[3] = ( pix1[3] + pix2[3] + pix3[3] + pix4[3] ) >> 2;
+	}
+}
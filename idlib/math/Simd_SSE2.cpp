@@ -238,6 +238,7 @@ void VPCALL idSIMD_SSE2::CmpLT( byte *dst, const byte bitNum, const float *src0,
 #elif defined(_WIN32)
 
 #include <xmmintrin.h>
+#include <emmintrin.h>
 
 #define SHUFFLEPS( x, y, z, w )		(( (x) & 3 ) << 6 | ( (y) & 3 ) << 4 | ( (z) & 3 ) << 2 | ( (w) & 3 ))
 #define R_SHUFFLEPS( x, y, z, w )	(( (w) & 3 ) << 6 | ( (z) & 3 ) << 4 | ( (y) & 3 ) << 2 | ( (x) & 3 ))
@@ -270,6 +271,10 @@ ALIGN4_INIT1( float SIMD_SP_twoPI, idMath::TWO_PI );
 ALIGN4_INIT1( float SIMD_SP_oneOverTwoPI, 1.0f / idMath::TWO_PI );
 ALIGN4_INIT1( float SIMD_SP_infinity, idMath::INFINITY );
 
+ALIGN4_INIT4( unsigned long SIMD_DW_maskXYZ, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0 );
+ALIGN4_INIT4( unsigned long SIMD_DW_maskW, 0, 0, 0, 0xFFFFFFFF );
+ALIGN4_INIT4( unsigned long SIMD_DW_normalUp, 128, 128, 255, 0 );
+
 
 /*
 ============
@@ -817,6 +822,81 @@ void VPCALL idSIMD_SSE2::MatX_LowerTriangularSolveTranspose( const idMatX &L, fl
 
 #endif
 
+/*
+============
+idSIMD_SSE2::MatX_RankTwoUpdateColumn
+
+  updates four rows per iteration, the column elements are gathered
+  into a register and scattered back, v1 and v2 are contiguous
+============
+*/
+void VPCALL idSIMD_SSE2::MatX_RankTwoUpdateColumn( float *col, const int stride, float *v1, float *v2, const float p1, const float beta1, const float p2, const float beta2, const int n ) {
+	const __m128 xp1 = _mm_set1_ps( p1 );
+	const __m128 xbeta1 = _mm_set1_ps( beta1 );
+	const __m128 xp2 = _mm_set1_ps( p2 );
+	const __m128 xbeta2 = _mm_set1_ps( beta2 );
+	int j;
+
+	for ( j = 0; j + 4 <= n; j += 4 ) {
+		float *c = col + j * stride;
+
+		__m128 sum = _mm_setr_ps( c[0], c[stride], c[2*stride], c[3*stride] );
+		__m128 a = _mm_loadu_ps( v1 + j );
+		__m128 b = _mm_loadu_ps( v2 + j );
+
+		a = _mm_sub_ps( a, _mm_mul_ps( xp1, sum ) );
+		sum = _mm_add_ps( sum, _mm_mul_ps( xbeta1, a ) );
+		b = _mm_sub_ps( b, _mm_mul_ps( xp2, sum ) );
+		sum = _mm_add_ps( sum, _mm_mul_ps( xbeta2, b ) );
+
+		_mm_storeu_ps( v1 + j, a );
+		_mm_storeu_ps( v2 + j, b );
+
+		_mm_store_ss( c, sum );
+		_mm_store_ss( c + stride, _mm_shuffle_ps( sum, sum, R_SHUFFLEPS( 1, 1, 1, 1 ) ) );
+		_mm_store_ss( c + 2*stride, _mm_shuffle_ps( sum, sum, R_SHUFFLEPS( 2, 2, 2, 2 ) ) );
+		_mm_store_ss( c + 3*stride, _mm_shuffle_ps( sum, sum, R_SHUFFLEPS( 3, 3, 3, 3 ) ) );
+	}
+
+	if ( j < n ) {
+		idSIMD_Generic::MatX_RankTwoUpdateColumn( col + j * stride, stride, v1 + j, v2 + j, p1, beta1, p2, beta2, n - j );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MatX_RankTwoUpdateRow
+
+  updates four elements per iteration
+============
+*/
+void VPCALL idSIMD_SSE2::MatX_RankTwoUpdateRow( float *row, float *z0, float *z1, const float p0, const float beta0, const float q0, const float beta1, const int n ) {
+	const __m128 xp0 = _mm_set1_ps( p0 );
+	const __m128 xbeta0 = _mm_set1_ps( beta0 );
+	const __m128 xq0 = _mm_set1_ps( q0 );
+	const __m128 xbeta1 = _mm_set1_ps( beta1 );
+	int j;
+
+	for ( j = 0; j + 4 <= n; j += 4 ) {
+		__m128 d = _mm_loadu_ps( row + j );
+		__m128 a = _mm_loadu_ps( z0 + j );
+		__m128 b = _mm_loadu_ps( z1 + j );
+
+		d = _mm_add_ps( d, _mm_mul_ps( xp0, a ) );
+		a = _mm_sub_ps( a, _mm_mul_ps( xbeta0, d ) );
+		d = _mm_add_ps( d, _mm_mul_ps( xq0, b ) );
+		b = _mm_sub_ps( b, _mm_mul_ps( xbeta1, d ) );
+
+		_mm_storeu_ps( row + j, d );
+		_mm_storeu_ps( z0 + j, a );
+		_mm_storeu_ps( z1 + j, b );
+	}
+
+	if ( j < n ) {
+		idSIMD_Generic::MatX_RankTwoUpdateRow( row + j, z0 + j, z1 + j, p0, beta0, q0, beta1, n - j );
+	}
+}
+
 /*
 ============
 idSIMD_SSE2::MixedSoundToSamples
@@ -865,4 +945,337 @@ void VPCALL idSIMD_SSE2::MixedSoundToSamples( short *samples, const float *mixBu
 	}
 }
 
+/*
+============
+idSIMD_SSE2::SoundBiquadFilter
+
+  computes four outputs per iteration as the sum of the filter responses to the
+  four inputs and the four history values, which are precomputed with the
+  generic filter, the rounding differs slightly from the generic version
+============
+*/
+void VPCALL idSIMD_SSE2::SoundBiquadFilter( float *samples, const int numSamples, const int stride, const float coefs[5], float history[4] ) {
+	ALIGN16( float response[8][4] );
+	int i;
+
+	for ( i = 0; i < 8; i++ ) {
+		float impulse[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float state[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		if ( i < 4 ) {
+			impulse[i] = 1.0f;
+		} else {
+			state[i-4] = 1.0f;
+		}
+		idSIMD_Generic::SoundBiquadFilter( impulse, 4, 1, coefs, state );
+		response[i][0] = impulse[0];
+		response[i][1] = impulse[1];
+		response[i][2] = impulse[2];
+		response[i][3] = impulse[3];
+	}
+
+	const __m128 r0 = _mm_load_ps( response[0] );
+	const __m128 r1 = _mm_load_ps( response[1] );
+	const __m128 r2 = _mm_load_ps( response[2] );
+	const __m128 r3 = _mm_load_ps( response[3] );
+	const __m128 rx1 = _mm_load_ps( response[4] );
+	const __m128 rx2 = _mm_load_ps( response[5] );
+	const __m128 ry1 = _mm_load_ps( response[6] );
+	const __m128 ry2 = _mm_load_ps( response[7] );
+
+	__m128 x1 = _mm_set1_ps( history[0] );
+	__m128 x2 = _mm_set1_ps( history[1] );
+	__m128 y1 = _mm_set1_ps( history[2] );
+	__m128 y2 = _mm_set1_ps( history[3] );
+
+	for ( i = 0; i + 4 <= numSamples; i += 4 ) {
+		float *s = samples + i * stride;
+		const __m128 in0 = _mm_set1_ps( s[0] );
+		const __m128 in1 = _mm_set1_ps( s[stride] );
+		const __m128 in2 = _mm_set1_ps( s[2*stride] );
+		const __m128 in3 = _mm_set1_ps( s[3*stride] );
+
+		__m128 y = _mm_add_ps( _mm_add_ps( _mm_mul_ps( in0, r0 ), _mm_mul_ps( in1, r1 ) ), _mm_add_ps( _mm_mul_ps( in2, r2 ), _mm_mul_ps( in3, r3 ) ) );
+		y = _mm_add_ps( y, _mm_add_ps( _mm_add_ps( _mm_mul_ps( x1, rx1 ), _mm_mul_ps( x2, rx2 ) ), _mm_add_ps( _mm_mul_ps( y1, ry1 ), _mm_mul_ps( y2, ry2 ) ) ) );
+
+		x1 = in3;
+		x2 = in2;
+		y1 = _mm_shuffle_ps( y, y, R_SHUFFLEPS( 3, 3, 3, 3 ) );
+		y2 = _mm_shuffle_ps( y, y, R_SHUFFLEPS( 2, 2, 2, 2 ) );
+
+		if ( stride == 1 ) {
+			_mm_storeu_ps( s, y );
+		} else {
+			_mm_store_ss( s, y );
+			_mm_store_ss( s + stride, _mm_shuffle_ps( y, y, R_SHUFFLEPS( 1, 1, 1, 1 ) ) );
+			_mm_store_ss( s + 2*stride, y2 );
+			_mm_store_ss( s + 3*stride, y1 );
+		}
+	}
+
+	_mm_store_ss( &history[0], x1 );
+	_mm_store_ss( &history[1], x2 );
+	_mm_store_ss( &history[2], y1 );
+	_mm_store_ss( &history[3], y2 );
+
+	if ( i < numSamples ) {
+		idSIMD_Generic::SoundBiquadFilter( samples + i * stride, numSamples - i, stride, coefs, history );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::Dequantize
+
+  dst[i] = bias[i] + src[i] * scale[i];
+  widens eight values per iteration, none of the arrays have to be aligned
+============
+*/
+void VPCALL idSIMD_SSE2::Dequantize( float *dst, const unsigned short *src, const float *bias, const float *scale, const int count ) {
+	const __m128i zero = _mm_setzero_si128();
+	int i;
+
+	for ( i = 0; i + 8 <= count; i += 8 ) {
+		const __m128i q = _mm_loadu_si128( (const __m128i *)( src + i ) );
+		const __m128 lo = _mm_cvtepi32_ps( _mm_unpacklo_epi16( q, zero ) );
+		const __m128 hi = _mm_cvtepi32_ps( _mm_unpackhi_epi16( q, zero ) );
+		_mm_storeu_ps( dst + i + 0, _mm_add_ps( _mm_loadu_ps( bias + i + 0 ), _mm_mul_ps( lo, _mm_loadu_ps( scale + i + 0 ) ) ) );
+		_mm_storeu_ps( dst + i + 4, _mm_add_ps( _mm_loadu_ps( bias + i + 4 ), _mm_mul_ps( hi, _mm_loadu_ps( scale + i + 4 ) ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = bias[i] + src[i] * scale[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE2::Dequantize
+
+  dst[i] = bias[i] + src[i] * scale[i];
+  widens eight values per iteration, none of the arrays have to be aligned
+============
+*/
+void VPCALL idSIMD_SSE2::Dequantize( float *dst, const byte *src, const float *bias, const float *scale, const int count ) {
+	const __m128i zero = _mm_setzero_si128();
+	int i;
+
+	for ( i = 0; i + 8 <= count; i += 8 ) {
+		const __m128i q = _mm_unpacklo_epi8( _mm_loadl_epi64( (const __m128i *)( src + i ) ), zero );
+		const __m128 lo = _mm_cvtepi32_ps( _mm_unpacklo_epi16( q, zero ) );
+		const __m128 hi = _mm_cvtepi32_ps( _mm_unpackhi_epi16( q, zero ) );
+		_mm_storeu_ps( dst + i + 0, _mm_add_ps( _mm_loadu_ps( bias + i + 0 ), _mm_mul_ps( lo, _mm_loadu_ps( scale + i + 0 ) ) ) );
+		_mm_storeu_ps( dst + i + 4, _mm_add_ps( _mm_loadu_ps( bias + i + 4 ), _mm_mul_ps( hi, _mm_loadu_ps( scale + i + 4 ) ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = bias[i] + src[i] * scale[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE2::CullBoxes
+
+  tests four boxes against a plane per iteration, none of the arrays have to be aligned
+============
+*/
+void VPCALL idSIMD_SSE2::CullBoxes( byte *culled, const float *centers, const float *extents, const int numBoxes, const idPlane *planes, const int numPlanes ) {
+	const float *centerX = centers, *centerY = centers + numBoxes, *centerZ = centers + numBoxes * 2;
+	const float *extentX = extents, *extentY = extents + numBoxes, *extentZ = extents + numBoxes * 2;
+	const __m128 zero = _mm_setzero_ps();
+	int i, j;
+
+	for ( i = 0; i + 4 <= numBoxes; i += 4 ) {
+		const __m128 cx = _mm_loadu_ps( centerX + i );
+		const __m128 cy = _mm_loadu_ps( centerY + i );
+		const __m128 cz = _mm_loadu_ps( centerZ + i );
+		const __m128 ex = _mm_loadu_ps( extentX + i );
+		const __m128 ey = _mm_loadu_ps( extentY + i );
+		const __m128 ez = _mm_loadu_ps( extentZ + i );
+		__m128 out = zero;
+
+		for ( j = 0; j < numPlanes; j++ ) {
+			const idPlane &p = planes[j];
+			__m128 d = _mm_add_ps( _mm_add_ps( _mm_mul_ps( _mm_set1_ps( p[0] ), cx ), _mm_mul_ps( _mm_set1_ps( p[1] ), cy ) ),
+									_mm_add_ps( _mm_mul_ps( _mm_set1_ps( p[2] ), cz ), _mm_set1_ps( p[3] ) ) );
+			__m128 r = _mm_add_ps( _mm_add_ps( _mm_mul_ps( _mm_set1_ps( idMath::Fabs( p[0] ) ), ex ), _mm_mul_ps( _mm_set1_ps( idMath::Fabs( p[1] ) ), ey ) ),
+									_mm_mul_ps( _mm_set1_ps( idMath::Fabs( p[2] ) ), ez ) );
+			out = _mm_or_ps( out, _mm_cmpgt_ps( _mm_sub_ps( d, r ), zero ) );
+		}
+
+		const int mask = _mm_movemask_ps( out );
+		culled[i + 0] = ( mask >> 0 ) & 1;
+		culled[i + 1] = ( mask >> 1 ) & 1;
+		culled[i + 2] = ( mask >> 2 ) & 1;
+		culled[i + 3] = ( mask >> 3 ) & 1;
+	}
+
+	for ( ; i < numBoxes; i++ ) {
+		culled[i] = 0;
+		for ( j = 0; j < numPlanes; j++ ) {
+			const idPlane &p = planes[j];
+			float d = p[0] * centerX[i] + p[1] * centerY[i] + p[2] * centerZ[i] + p[3];
+			float r = idMath::Fabs( p[0] ) * extentX[i] + idMath::Fabs( p[1] ) * extentY[i] + idMath::Fabs( p[2] ) * extentZ[i];
+			if ( d - r > 0.0f ) {
+				culled[i] = 1;
+				break;
+			}
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MipMapRGBA
+
+  box filters four texels of two source rows per iteration, the sums of the
+  four texels are done in 16 bits
+============
+*/
+void VPCALL idSIMD_SSE2::MipMapRGBA( byte *dst, const byte *src, const int width, const int height ) {
+	const int row = width * 4;
+	const int newWidth = width >> 1;
+	const int newHeight = height >> 1;
+	const int numSIMD = newWidth & ~3;
+	const __m128i zero = _mm_setzero_si128();
+
+	for ( int i = 0; i < newHeight; i++ ) {
+		const byte *in0 = src + i * 2 * row;
+		const byte *in1 = in0 + row;
+		byte *out = dst + i * newWidth * 4;
+		int j;
+
+		for ( j = 0; j < numSIMD; j += 4 ) {
+			const __m128i a0 = _mm_loadu_si128( (const __m128i *)( in0 + j * 8 + 0 ) );
+			const __m128i a1 = _mm_loadu_si128( (const __m128i *)( in0 + j * 8 + 16 ) );
+			const __m128i b0 = _mm_loadu_si128( (const __m128i *)( in1 + j * 8 + 0 ) );
+			const __m128i b1 = _mm_loadu_si128( (const __m128i *)( in1 + j * 8 + 16 ) );
+
+			// two texels per register, vertical sums
+			const __m128i s0 = _mm_add_epi16( _mm_unpacklo_epi8( a0, zero ), _mm_unpacklo_epi8( b0, zero ) );
+			const __m128i s1 = _mm_add_epi16( _mm_unpackhi_epi8( a0, zero ), _mm_unpackhi_epi8( b0, zero ) );
+			const __m128i s2 = _mm_add_epi16( _mm_unpacklo_epi8( a1, zero ), _mm_unpacklo_epi8( b1, zero ) );
+			const __m128i s3 = _mm_add_epi16( _mm_unpackhi_epi8( a1, zero ), _mm_unpackhi_epi8( b1, zero ) );
+
+			// the horizontal neighbours are in the low and high halves
+			const __m128i h0 = _mm_add_epi16( _mm_unpacklo_epi64( s0, s1 ), _mm_unpackhi_epi64( s0, s1 ) );
+			const __m128i h1 = _mm_add_epi16( _mm_unpacklo_epi64( s2, s3 ), _mm_unpackhi_epi64( s2, s3 ) );
+
+			_mm_storeu_si128( (__m128i *)( out + j * 4 ), _mm_packus_epi16( _mm_srli_epi16( h0, 2 ), _mm_srli_epi16( h1, 2 ) ) );
+		}
+
+		for ( ; j < newWidth; j++ ) {
+			const byte *in = in0 + j * 8;
+			out[j*4+0] = ( in[0] + in[4] + in[row+0] + in[row+4] ) >> 2;
+			out[j*4+1] = ( in[1] + in[5] + in[row+1] + in[row+5] ) >> 2;
+			out[j*4+2] = ( in[2] + in[6] + in[row+2] + in[row+6] ) >> 2;
+			out[j*4+3] = ( in[3] + in[7] + in[row+3] + in[row+7] ) >> 2;
+		}
+	}
+}
+
+/*
+============
+MipMapNormalTexel
+
+  renormalizes the sum of four RGBA texels holding normals, averages the alpha
+============
+*/
+static ID_INLINE __m128i MipMapNormalTexel( const __m128i sum ) {
+	const __m128i maskXYZ = _mm_load_si128( (const __m128i *)SIMD_DW_maskXYZ );
+	const __m128i maskW = _mm_load_si128( (const __m128i *)SIMD_DW_maskW );
+
+	// the sum of the four normals, scaled by 255
+	const __m128 v = _mm_sub_ps( _mm_cvtepi32_ps( _mm_add_epi32( sum, sum ) ), _mm_set1_ps( 4.0f * 255.0f ) );
+	const __m128 sqr = _mm_and_ps( _mm_mul_ps( v, v ), _mm_castsi128_ps( maskXYZ ) );
+	__m128 lengthSqr = _mm_add_ps( sqr, _mm_shuffle_ps( sqr, sqr, R_SHUFFLEPS( 1, 0, 3, 2 ) ) );
+	lengthSqr = _mm_add_ps( lengthSqr, _mm_shuffle_ps( lengthSqr, lengthSqr, R_SHUFFLEPS( 2, 3, 0, 1 ) ) );
+
+	const __m128 scale = _mm_div_ps( _mm_set1_ps( 127.5f ), _mm_sqrt_ps( lengthSqr ) );
+	__m128i n = _mm_cvttps_epi32( _mm_add_ps( _mm_mul_ps( v, scale ), _mm_set1_ps( 128.0f ) ) );
+
+	// opposite normals cancelled out
+	const __m128i zeroLength = _mm_castps_si128( _mm_cmpeq_ps( lengthSqr, _mm_setzero_ps() ) );
+	n = _mm_or_si128( _mm_andnot_si128( zeroLength, n ), _mm_and_si128( zeroLength, _mm_load_si128( (const __m128i *)SIMD_DW_normalUp ) ) );
+
+	return _mm_or_si128( _mm_and_si128( n, maskXYZ ), _mm_and_si128( _mm_srli_epi32( sum, 2 ), maskW ) );
+}
+
+/*
+============
+idSIMD_SSE2::MipMapNormalRGBA
+============
+*/
+void VPCALL idSIMD_SSE2::MipMapNormalRGBA( byte *dst, const byte *src, const int width, const int height ) {
+	const int row = width * 4;
+	const int newWidth = width >> 1;
+	const int newHeight = height >> 1;
+	const int numSIMD = newWidth & ~3;
+	const __m128i zero = _mm_setzero_si128();
+
+	for ( int i = 0; i < newHeight; i++ ) {
+		const byte *in0 = src + i * 2 * row;
+		const byte *in1 = in0 + row;
+		byte *out = dst + i * newWidth * 4;
+		int j;
+
+		for ( j = 0; j < numSIMD; j += 4 ) {
+			const __m128i a0 = _mm_loadu_si128( (const __m128i *)( in0 + j * 8 + 0 ) );
+			const __m128i a1 = _mm_loadu_si128( (const __m128i *)( in0 + j * 8 + 16 ) );
+			const __m128i b0 = _mm_loadu_si128( (const __m128i *)( in1 + j * 8 + 0 ) );
+			const __m128i b1 = _mm_loadu_si128( (const __m128i *)( in1 + j * 8 + 16 ) );
+
+			const __m128i s0 = _mm_add_epi16( _mm_unpacklo_epi8( a0, zero ), _mm_unpacklo_epi8( b0, zero ) );
+			const __m128i s1 = _mm_add_epi16( _mm_unpackhi_epi8( a0, zero ), _mm_unpackhi_epi8( b0, zero ) );
+			const __m128i s2 = _mm_add_epi16( _mm_unpacklo_epi8( a1, zero ), _mm_unpacklo_epi8( b1, zero ) );
+			const __m128i s3 = _mm_add_epi16( _mm_unpackhi_epi8( a1, zero ), _mm_unpackhi_epi8( b1, zero ) );
+
+			const __m128i h0 = _mm_add_epi16( _mm_unpacklo_epi64( s0, s1 ), _mm_unpackhi_epi64( s0, s1 ) );
+			const __m128i h1 = _mm_add_epi16( _mm_unpacklo_epi64( s2, s3 ), _mm_unpackhi_epi64( s2, s3 ) );
+
+			const __m128i n0 = MipMapNormalTexel( _mm_unpacklo_epi16( h0, zero ) );
+			const __m128i n1 = MipMapNormalTexel( _mm_unpackhi_epi16( h0, zero ) );
+			const __m128i n2 = MipMapNormalTexel( _mm_unpacklo_epi16( h1, zero ) );
+			const __m128i n3 = MipMapNormalTexel( _mm_unpackhi_epi16( h1, zero ) );
+
+			_mm_storeu_si128( (__m128i *)( out + j * 4 ), _mm_packus_epi16( _mm_packs_epi32( n0, n1 ), _mm_packs_epi32( n2, n3 ) ) );
+		}
+
+		for ( ; j < newWidth; j++ ) {
+			const byte *in = in0 + j * 8;
+			const __m128i sum = _mm_set_epi32( in[3] + in[7] + in[row+3] + in[row+7], in[2] + in[6] + in[row+2] + in[row+6],
+												in[1] + in[5] + in[row+1] + in[row+5], in[0] + in[4] + in[row+0] + in[row+4] );
+			const __m128i n = MipMapNormalTexel( sum );
+			*(int *)( out + j * 4 ) = _mm_cvtsi128_si32( _mm_packus_epi16( _mm_packs_epi32( n, zero ), zero ) );
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE2::ResampleRGBARow
+
+  gathers two texels of each row per iteration
+============
+*/
+void VPCALL idSIMD_SSE2::ResampleRGBARow( byte *dst, const byte *row0, const byte *row1, const unsigned int *offsets0, const unsigned int *offsets1, const int count ) {
+	const __m128i zero = _mm_setzero_si128();
+	int i;
+
+	for ( i = 0; i + 2 <= count; i += 2 ) {
+		const __m128i p1 = _mm_unpacklo_epi32( _mm_cvtsi32_si128( *(const int *)( row0 + offsets0[i] ) ), _mm_cvtsi32_si128( *(const int *)( row0 + offsets0[i+1] ) ) );
+		const __m128i p2 = _mm_unpacklo_epi32( _mm_cvtsi32_si128( *(const int *)( row0 + offsets1[i] ) ), _mm_cvtsi32_si128( *(const int *)( row0 + offsets1[i+1] ) ) );
+		const __m128i p3 = _mm_unpacklo_epi32( _mm_cvtsi32_si128( *(const int *)( row1 + offsets0[i] ) ), _mm_cvtsi32_si128( *(const int *)( row1 + offsets0[i+1] ) ) );
+		const __m128i p4 = _mm_unpacklo_epi32( _mm_cvtsi32_si128( *(const int *)( row1 + offsets1[i] ) ), _mm_cvtsi32_si128( *(const int *)( row1 + offsets1[i+1] ) ) );
+
+		__m128i sum = _mm_add_epi16( _mm_add_epi16( _mm_unpacklo_epi8( p1, zero ), _mm_unpacklo_epi8( p2, zero ) ),
+									 _mm_add_epi16( _mm_unpacklo_epi8( p3, zero ), _mm_unpacklo_epi8( p4, zero ) ) );
+		sum = _mm_srli_epi16( sum, 2 );
+
+		_mm_storel_epi64( (__m128i *)( dst + i * 4 ), _mm_packus_epi16( sum, zero ) );
+	}
+
+	if ( i < count ) {
+		idSIMD_Generic::ResampleRGBARow( dst + i * 4, row0, row1, offsets0 + i, offsets1 + i, count - i );
+	}
+}
+
 #endif /* _WIN32 */
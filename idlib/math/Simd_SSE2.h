@@ -39,8 +39,20 @@ public:
 
 	//virtual void VPCALL MatX_LowerTriangularSolve( const idMatX &L, float *x, const float *b, const int n, int skip = 0 );
 	//virtual void VPCALL MatX_LowerTriangularSolveTranspose( const idMatX &L, float *x, const float *b, const int n );
+	virtual void VPCALL MatX_RankTwoUpdateColumn( float *col, const int stride, float *v1, float *v2, const float p1, const float beta1, const float p2, const float beta2, const int n );
+	virtual void VPCALL MatX_RankTwoUpdateRow( float *row, float *z0, float *z1, const float p0, const float beta0, const float q0, const float beta1, const int n );
 
 	virtual void VPCALL MixedSoundToSamples( short *samples, const float *mixBuffer, const int numSamples );
+	virtual void VPCALL SoundBiquadFilter( float *samples, const int numSamples, const int stride, const float coefs[5], float history[4] );
+
+	virtual void VPCALL Dequantize( float *dst, const unsigned short *src, const float *bias, const float *scale, const int count );
+	virtual void VPCALL Dequantize( float *dst, const byte *src, const float *bias, const float *scale, const int count );
+
+	virtual void VPCALL CullBoxes( byte *culled, const float *centers, const float *extents, const int numBoxes, const idPlane *planes, const int numPlanes );
+
+	virtual void VPCALL MipMapRGBA( byte *dst, const byte *src, const int width, const int height );
+	virtual void VPCALL MipMapNormalRGBA( byte *dst, const byte *src, const int width, const int height );
+	virtual void VPCALL ResampleRGBARow( byte *dst, const byte *row0, const byte *row1, const unsigned int *offsets0, const unsigned int *offsets1, const int count );
 
 #endif
 };
@@ -374,9 +374,9 @@ const char *idVec6::ToString( int precision ) const {
 //
 //===============================================================
 
-float	idVecX::temp[VECX_MAX_TEMP+4];
-float *	idVecX::tempPtr = (float *) ( ( (int) idVecX::temp + 15 ) & ~15 );
-int		idVecX::tempIndex = 0;
+ID_THREAD_LOCAL float	idVecX::temp[VECX_MAX_TEMP+4];
+ID_THREAD_LOCAL float *	idVecX::tempPtr = NULL;
+ID_THREAD_LOCAL int		idVecX::tempIndex = 0;
 
 /*
 =============
@@ -816,6 +816,8 @@ ID_INLINE bool idVec3::ProjectAlongPlane( const idVec3 &normal, const float epsi
 	return true;
 }
 
+ID_LIST_MEMCPY_RELOCATE( idVec3 )
+
 
 //===============================================================
 //
@@ -1512,9 +1514,10 @@ private:
 	int				alloced;				// if -1 p points to data set with SetData
 	float *			p;						// memory the vector is stored
 
-	static float	temp[VECX_MAX_TEMP+4];	// used to store intermediate results
-	static float *	tempPtr;				// pointer to 16 byte aligned temporary memory
-	static int		tempIndex;				// index into memory pool, wraps around
+	// the temporary memory is per thread, so that temporaries can be used on worker threads
+	static ID_THREAD_LOCAL float	temp[VECX_MAX_TEMP+4];	// used to store intermediate results
+	static ID_THREAD_LOCAL float *	tempPtr;	// pointer to 16 byte aligned temporary memory, set on first use
+	static ID_THREAD_LOCAL int		tempIndex;	// index into memory pool, wraps around
 
 private:
 	void			SetTempSize( int size );
@@ -1763,6 +1766,9 @@ ID_INLINE void idVecX::SetTempSize( int newSize ) {
 	size = newSize;
 	alloced = ( newSize + 3 ) & ~3;
 	assert( alloced < VECX_MAX_TEMP );
+	if ( !idVecX::tempPtr ) {
+		idVecX::tempPtr = (float *) ( ( (int) idVecX::temp + 15 ) & ~15 );
+	}
 	if ( idVecX::tempIndex + alloced > VECX_MAX_TEMP ) {
 		idVecX::tempIndex = 0;
 	}
@@ -111,6 +111,8 @@
 #include "../framework/CmdSystem.h"
 #include "../framework/CVarSystem.h"
 #include "../framework/Common.h"
+#include "../framework/FrameProfiler.h"
+#include "../framework/PerfSuite.h"
 #include "../framework/I18N.h"
 #include "../framework/File.h"
 #include "../framework/FileSystem.h"
@@ -182,6 +184,8 @@ const int MAX_EXPRESSION_REGISTERS = 4096;
 #include "../framework/Console.h"
 #include "../framework/DemoFile.h"
 #include "../framework/Session.h"
+#include "../framework/LoadProfiler.h"
+#include "../framework/LevelResidency.h"
 
 // asynchronous networking
 #include "../framework/async/AsyncNetwork.h"
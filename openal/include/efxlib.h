@@ -45,12 +45,23 @@ public:
 	~idEFXFile();
 
 	bool FindEffect( idStr &name, idSoundEffect **effect, int *index );
+	// the effect named after the area number, else the one named after the
+	// location, else "default", returns -1 if there is none
+	int FindListenerEffect( int area, const char *areaName ) const;
 	bool ReadEffect( idLexer &lexer, idSoundEffect *effect );
 	bool LoadFile( const char *filename, bool OSPath = false );
 	void UnloadFile( void );
 	void Clear( void );
 
 	idList<idSoundEffect *>effects;
+
+private:
+	void BuildLookups( void );
+	int FindEffectIndex( const char *name ) const;
+
+	idList<int> areaEffects;		// effect index by area number, -1 for none
+	idHashIndex effectHash;			// effects by name, the first of equally named ones comes first
+	int defaultEffect;
 };
 ///////////////////////////////////////////////////////////
 
@@ -29,6 +29,10 @@ extern "C" {
 
 #include "tr_local.h"
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
 #define CIN_system	1
 #define CIN_loop	2
 #define	CIN_hold	4
@@ -85,6 +89,23 @@ private:
 	bool					smootheddouble;
 	bool					inMemory;
 
+	// decode ahead, frames[shownFrame] is the copy of the last returned frame, the
+	// other one is filled with the next frame on the decode thread
+	byte *					frames[2];
+	int						shownFrame;			// -1 if the next frame has to be decoded right away
+	long					shownQuad;
+	bool					decodedAhead;		// frames[shownFrame^1] holds frame shownQuad+1
+	bool					decodeQueued;		// guarded by cinQueueLock
+	idCinematicLocal *		nextQueued;
+	int						lastDrawTime;
+
+	cinData_t				DecodeForTime( int thisTime );
+	cinData_t				FrameData( const byte *frame ) const;
+	void					QueueDecodeAhead( void );
+	void					WaitForDecodeAhead( void );
+	void					DecodeAhead( void );
+	static void				DecodeAheadThread( void );
+
 	void					RoQ_init( void );
 	void					blitVQQuad32fs( byte **status, unsigned char *data );
 	void					RoQShutdown( void );
@@ -134,6 +155,20 @@ static unsigned short *	vq2 = NULL;
 static unsigned short *	vq4 = NULL;
 static unsigned short *	vq8 = NULL;
 
+// the decode thread works through the queued cinematics one at a time, any decoding
+// holds cinDecodeLock because of the shared buffers above
+static std::mutex				cinDecodeLock;
+static std::mutex				cinQueueLock;
+static std::condition_variable	cinQueueWake;
+static std::condition_variable	cinQueueDone;
+static idCinematicLocal *		cinQueue = NULL;
+static idCinematicLocal *		cinQueueTail = NULL;
+static std::thread *			cinThread = NULL;
+static bool						cinThreadQuit = false;
+
+// a cinematic that wasn't drawn for this long is paused instead of catching up
+const int CIN_HIDDEN_TIME		= 250;
+
 
 
 //===========================================
@@ -174,6 +209,18 @@ idCinematicLocal::ShutdownCinematic
 ==============
 */
 void idCinematic::ShutdownCinematic( void ) {
+	if ( cinThread ) {
+		{
+			std::lock_guard<std::mutex> lock( cinQueueLock );
+			cinThreadQuit = true;
+		}
+		cinQueueWake.notify_all();
+		cinThread->join();
+		delete cinThread;
+		cinThread = NULL;
+		cinThreadQuit = false;
+	}
+
 	Mem_Free( file );
 	file = NULL;
 	Mem_Free( vq2 );
@@ -260,6 +307,14 @@ idCinematicLocal::idCinematicLocal() {
 	buf = NULL;
 	iFile = NULL;
 
+	frames[0] = frames[1] = NULL;
+	shownFrame = -1;
+	shownQuad = 0;
+	decodedAhead = false;
+	decodeQueued = false;
+	nextQueued = NULL;
+	lastDrawTime = -1;
+
 	qStatus[0] = (byte **)Mem_Alloc( 32768 * sizeof( byte *) );
 	qStatus[1] = (byte **)Mem_Alloc( 32768 * sizeof( byte *) );
 }
@@ -288,6 +343,8 @@ bool idCinematicLocal::InitFromFile( const char *qpath, bool amilooping ) {
 
 	Close();
 
+	std::lock_guard<std::mutex> decode( cinDecodeLock );
+
 	inMemory = 0;
 	animationLength = 100000;
 
@@ -325,7 +382,7 @@ bool idCinematicLocal::InitFromFile( const char *qpath, bool amilooping ) {
 	if ( RoQID == ROQ_FILE ) {
 		RoQ_init();
 		status = FMV_PLAY;
-		ImageForTime( 0 );
+		DecodeForTime( 0 );
 		status = ( looping ) ? FMV_PLAY : FMV_IDLE;
 		return true;
 	}
@@ -340,6 +397,14 @@ idCinematicLocal::Close
 ==============
 */
 void idCinematicLocal::Close() {
+	WaitForDecodeAhead();
+
+	Mem_Free( frames[0] );
+	frames[0] = frames[1] = NULL;
+	shownFrame = -1;
+	decodedAhead = false;
+	lastDrawTime = -1;
+
 	if ( image ) {
 		Mem_Free( (void *)image );
 		image = NULL;
@@ -364,6 +429,9 @@ idCinematicLocal::ResetTime
 ==============
 */
 void idCinematicLocal::ResetTime(int time) {
+	WaitForDecodeAhead();
+	shownFrame = -1;
+	lastDrawTime = -1;
 	startTime = ( backEnd.viewDef ) ? 1000 * backEnd.viewDef->floatTime : -1;
 	status = FMV_PLAY;
 }
@@ -371,6 +439,9 @@ void idCinematicLocal::ResetTime(int time) {
 /*
 ==============
 idCinematicLocal::ImageForTime
+
+The frame after the returned one is decoded on the decode thread, so the next
+call usually only has to swap the frames
 ==============
 */
 cinData_t idCinematicLocal::ImageForTime( int thisTime ) {
@@ -380,6 +451,177 @@ cinData_t idCinematicLocal::ImageForTime( int thisTime ) {
 		thisTime = 0;
 	}
 
+	WaitForDecodeAhead();
+
+	if ( r_cinematicPauseHidden.GetBool() && lastDrawTime != -1 && startTime != -1 && buf != NULL && thisTime - lastDrawTime > CIN_HIDDEN_TIME ) {
+		// continue where it was when it went out of view
+		startTime += thisTime - lastDrawTime;
+	}
+	lastDrawTime = thisTime;
+
+	if ( !r_cinematicDecodeAhead.GetBool() ) {
+		shownFrame = -1;
+		std::lock_guard<std::mutex> decode( cinDecodeLock );
+		return DecodeForTime( thisTime );
+	}
+
+	if ( shownFrame != -1 && startTime != -1 && !r_skipROQ.GetBool() ) {
+		long wanted = ( ( thisTime - startTime ) * frameRate ) / 1000;
+		if ( wanted < 0 ) {
+			wanted = 0;
+		}
+		if ( wanted == shownQuad ) {
+			return FrameData( frames[shownFrame] );
+		}
+		if ( wanted == shownQuad + 1 && decodedAhead && status == FMV_PLAY ) {
+			shownFrame ^= 1;
+			shownQuad++;
+			decodedAhead = false;
+			QueueDecodeAhead();
+			return FrameData( frames[shownFrame] );
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> decode( cinDecodeLock );
+		cinData = DecodeForTime( thisTime );
+	}
+
+	shownFrame = -1;
+	decodedAhead = false;
+	if ( cinData.image == NULL || status != FMV_PLAY ) {
+		return cinData;
+	}
+
+	// the decoder overwrites buf when it goes on, so show a copy
+	if ( !frames[0] ) {
+		frames[0] = (byte *)Mem_Alloc( screenDelta * 2 );
+		frames[1] = frames[0] + screenDelta;
+	}
+	memcpy( frames[0], buf, screenDelta );
+	shownFrame = 0;
+	shownQuad = numQuads;
+	QueueDecodeAhead();
+
+	return FrameData( frames[0] );
+}
+
+/*
+==============
+idCinematicLocal::FrameData
+==============
+*/
+cinData_t idCinematicLocal::FrameData( const byte *frame ) const {
+	cinData_t	cinData;
+
+	cinData.imageWidth = CIN_WIDTH;
+	cinData.imageHeight = CIN_HEIGHT;
+	cinData.status = FMV_PLAY;
+	cinData.image = frame;
+
+	return cinData;
+}
+
+/*
+==============
+idCinematicLocal::QueueDecodeAhead
+==============
+*/
+void idCinematicLocal::QueueDecodeAhead( void ) {
+	std::lock_guard<std::mutex> lock( cinQueueLock );
+
+	if ( !cinThread ) {
+		cinThread = new std::thread( DecodeAheadThread );
+	}
+
+	decodeQueued = true;
+	nextQueued = NULL;
+	if ( cinQueueTail ) {
+		cinQueueTail->nextQueued = this;
+	} else {
+		cinQueue = this;
+	}
+	cinQueueTail = this;
+
+	cinQueueWake.notify_one();
+}
+
+/*
+==============
+idCinematicLocal::WaitForDecodeAhead
+==============
+*/
+void idCinematicLocal::WaitForDecodeAhead( void ) {
+	std::unique_lock<std::mutex> lock( cinQueueLock );
+	while ( decodeQueued ) {
+		cinQueueDone.wait( lock );
+	}
+}
+
+/*
+==============
+idCinematicLocal::DecodeAhead
+
+called on the decode thread, the decoder stops at the end of the file and
+leaves looping or closing to the next ImageForTime
+==============
+*/
+void idCinematicLocal::DecodeAhead( void ) {
+	std::lock_guard<std::mutex> decode( cinDecodeLock );
+
+	const long quad = numQuads;
+	while ( numQuads == quad && status == FMV_PLAY ) {
+		RoQInterrupt();
+	}
+
+	if ( numQuads == quad + 1 && status == FMV_PLAY && buf != NULL ) {
+		memcpy( frames[shownFrame ^ 1], buf, screenDelta );
+		decodedAhead = true;
+	}
+}
+
+/*
+==============
+idCinematicLocal::DecodeAheadThread
+==============
+*/
+void idCinematicLocal::DecodeAheadThread( void ) {
+	std::unique_lock<std::mutex> lock( cinQueueLock );
+
+	while ( 1 ) {
+		while ( !cinQueue && !cinThreadQuit ) {
+			cinQueueWake.wait( lock );
+		}
+		if ( !cinQueue ) {
+			// quit, the queue is finished first so nobody waits for a decode forever
+			break;
+		}
+
+		idCinematicLocal *cin = cinQueue;
+		cinQueue = cin->nextQueued;
+		if ( !cinQueue ) {
+			cinQueueTail = NULL;
+		}
+
+		lock.unlock();
+		cin->DecodeAhead();
+		lock.lock();
+
+		cin->decodeQueued = false;
+		cinQueueDone.notify_all();
+	}
+}
+
+/*
+==============
+idCinematicLocal::DecodeForTime
+
+decodes up to the frame of thisTime, the caller holds cinDecodeLock
+==============
+*/
+cinData_t idCinematicLocal::DecodeForTime( int thisTime ) {
+	cinData_t	cinData;
+
 	memset( &cinData, 0, sizeof(cinData) );
 
 	if ( r_skipROQ.GetBool() ) {
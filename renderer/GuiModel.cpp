@@ -24,6 +24,8 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 #include "tr_local.h"
 
+// how many surfaces back a new surface looks for a batch to join
+static const int GUI_BATCH_LOOKBACK = 64;
 
 /*
 ================
@@ -33,6 +35,8 @@ idGuiModel::idGuiModel
 idGuiModel::idGuiModel() {
 	indexes.SetGranularity( 1000 );
 	verts.SetGranularity( 1000 );
+	surf = NULL;
+	clearCount = 0;
 }
 
 /*
@@ -46,6 +50,7 @@ void idGuiModel::Clear() {
 	surfaces.SetNum( 0, false );
 	indexes.SetNum( 0, false );
 	verts.SetNum( 0, false );
+	clearCount++;
 	AdvanceSurf();
 }
 
@@ -143,34 +148,60 @@ void idGuiModel::ReadFromDemo( idDemoFile *demo ) {
 		demo->ReadInt( surf->firstIndex );
 		demo->ReadInt( surf->numIndexes );
 		surf->material = declManager->FindMaterial( demo->ReadHashString() );
+
+		// the surfaces are written in the order they were drawn, which is always safe
+		surf->batch = j;
+		surf->nextPiece = -1;
+		surf->lastPiece = j;
+		surf->bounds.Clear();
 	}
 }
 
 /*
 ================
 EmitSurface
+
+Emits the surface together with all the surfaces batched with it
 ================
 */
 void idGuiModel::EmitSurface( guiModelSurface_t *surf, float modelMatrix[16], float modelViewMatrix[16], bool depthHack ) {
 	srfTriangles_t	*tri;
+	const guiModelSurface_t *piece;
+	int numVerts = 0;
+	int numIndexes = 0;
 
-	if ( surf->numVerts == 0 ) {
+	for ( piece = surf; piece; piece = ( piece->nextPiece >= 0 ) ? &surfaces[piece->nextPiece] : NULL ) {
+		numVerts += piece->numVerts;
+		numIndexes += piece->numIndexes;
+	}
+
+	if ( numVerts == 0 ) {
 		return;		// nothing in the surface
 	}
 
 	// copy verts and indexes
 	tri = (srfTriangles_t *)R_ClearedFrameAlloc( sizeof( *tri ) );
 
-	tri->numIndexes = surf->numIndexes;
-	tri->numVerts = surf->numVerts;
+	tri->numIndexes = numIndexes;
+	tri->numVerts = numVerts;
 	tri->indexes = (glIndex_t *)R_FrameAlloc( tri->numIndexes * sizeof( tri->indexes[0] ) );
-	memcpy( tri->indexes, &indexes[surf->firstIndex], tri->numIndexes * sizeof( tri->indexes[0] ) );
 
 	// we might be able to avoid copying these and just let them reference the list vars
 	// but some things, like deforms and recursive
 	// guis, need to access the verts in cpu space, not just through the vertex range
 	tri->verts = (idDrawVert *)R_FrameAlloc( tri->numVerts * sizeof( tri->verts[0] ) );
-	memcpy( tri->verts, &verts[surf->firstVert], tri->numVerts * sizeof( tri->verts[0] ) );
+
+	numVerts = 0;
+	numIndexes = 0;
+	for ( piece = surf; piece; piece = ( piece->nextPiece >= 0 ) ? &surfaces[piece->nextPiece] : NULL ) {
+		// the indexes of each piece start at its first vertex
+		for ( int i = 0; i < piece->numIndexes; i++ ) {
+			tri->indexes[numIndexes + i] = indexes[piece->firstIndex + i] + numVerts;
+		}
+		memcpy( tri->verts + numVerts, &verts[piece->firstVert], piece->numVerts * sizeof( tri->verts[0] ) );
+		numVerts += piece->numVerts;
+		numIndexes += piece->numIndexes;
+	}
 
 	// move the verts to the vertex cache
 	tri->ambientCache = vertexCache.AllocFrameTemp( tri->verts, tri->numVerts * sizeof( tri->verts[0] ) );
@@ -205,6 +236,10 @@ void idGuiModel::EmitToCurrentView( float modelMatrix[16], bool depthHack ) {
 			modelViewMatrix );
 
 	for ( int i = 0 ; i < surfaces.Num() ; i++ ) {
+		// batched surfaces are emitted with their batch
+		if ( surfaces[i].batch != i ) {
+			continue;
+		}
 		EmitSurface( &surfaces[i], modelMatrix, modelViewMatrix, depthHack );
 	}
 }
@@ -285,6 +320,10 @@ void idGuiModel::EmitFullScreen( void ) {
 
 	// add the surfaces to this view
 	for ( int i = 0 ; i < surfaces.Num() ; i++ ) {
+		// batched surfaces are emitted with their batch
+		if ( surfaces[i].batch != i ) {
+			continue;
+		}
 		EmitSurface( &surfaces[i], viewDef->worldSpace.modelMatrix, viewDef->worldSpace.modelViewMatrix, false );
 	}
 
@@ -319,11 +358,93 @@ void idGuiModel::AdvanceSurf() {
 	s.firstIndex = indexes.Num();
 	s.numVerts = 0;
 	s.firstVert = verts.Num();
+	s.batch = surfaces.Num();
+	s.nextPiece = -1;
+	s.lastPiece = s.batch;
+	s.bounds.Clear();
 
 	surfaces.Append( s );
 	surf = &surfaces[ surfaces.Num() - 1 ];
 }
 
+/*
+=============
+FindBatch
+
+Returns the earlier surface with the material and color of the current one,
+if nothing that is drawn after it overlaps the bounds, otherwise -1
+=============
+*/
+int idGuiModel::FindBatch( const idBounds &bounds ) const {
+	const int current = surfaces.Num() - 1;
+	const int first = Max( 0, current - GUI_BATCH_LOOKBACK );
+
+	for ( int i = current - 1; i >= first; i-- ) {
+		const guiModelSurface_t &s = surfaces[i];
+
+		// the bounds of batched surfaces are kept by their batch
+		if ( s.batch != i ) {
+			continue;
+		}
+		if ( s.material == surf->material && s.color[0] == surf->color[0] && s.color[1] == surf->color[1]
+			&& s.color[2] == surf->color[2] && s.color[3] == surf->color[3] ) {
+			return i;
+		}
+		// can't move in front of anything it is drawn over
+		if ( s.bounds.IntersectsBounds( bounds ) ) {
+			return -1;
+		}
+	}
+
+	return -1;
+}
+
+/*
+=============
+BatchOverlapped
+
+True if the bounds overlap anything drawn after the batch
+=============
+*/
+bool idGuiModel::BatchOverlapped( int batch, const idBounds &bounds ) const {
+	for ( int i = batch + 1; i < surfaces.Num(); i++ ) {
+		if ( surfaces[i].batch == i && surfaces[i].bounds.IntersectsBounds( bounds ) ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+=============
+BatchSurf
+
+Called before anything within the bounds is added to the current surface.
+A new surface joins an earlier batch of the same material and color when it
+can be drawn together with it without changing the result, which keeps the
+surface count down when guis switch back and forth between text and images.
+=============
+*/
+void idGuiModel::BatchSurf( const idBounds &bounds ) {
+	const int current = surfaces.Num() - 1;
+
+	if ( surf->numVerts == 0 ) {
+		if ( surf->batch == current && r_useGuiBatching.GetBool() ) {
+			const int batch = FindBatch( bounds );
+			if ( batch >= 0 ) {
+				surf->batch = batch;
+				surfaces[surfaces[batch].lastPiece].nextPiece = current;
+				surfaces[batch].lastPiece = current;
+			}
+		}
+	} else if ( surf->batch != current && BatchOverlapped( surf->batch, bounds ) ) {
+		// it has grown over something drawn after its batch, so continue in a new surface
+		AdvanceSurf();
+	}
+
+	surfaces[surf->batch].bounds.AddBounds( bounds );
+}
+
 /*
 =============
 SetColor
@@ -338,7 +459,8 @@ void idGuiModel::SetColor( float r, float g, float b, float a ) {
 		return;	// no change
 	}
 
-	if ( surf->numVerts ) {
+	// a surface that joined a batch keeps its color, even if nothing ended up in it
+	if ( surf->numVerts || surf->batch != surfaces.Num() - 1 ) {
 		AdvanceSurf();
 	}
 
@@ -365,7 +487,7 @@ void idGuiModel::DrawStretchPic( const idDrawVert *dverts, const glIndex_t *dind
 
 	// break the current surface if we are changing to a new material
 	if ( hShader != surf->material ) {
-		if ( surf->numVerts ) {
+		if ( surf->numVerts || surf->batch != surfaces.Num() - 1 ) {
 			AdvanceSurf();
 		}
 		const_cast<idMaterial *>(hShader)->EnsureNotPurged();	// in case it was a gui item started before a level change
@@ -373,6 +495,18 @@ void idGuiModel::DrawStretchPic( const idDrawVert *dverts, const glIndex_t *dind
 	}
 
 	// add the verts and indexes to the current surface
+	idBounds bounds;
+	bounds.Clear();
+	for ( int i = 0; i < vertCount; i++ ) {
+		bounds.AddPoint( dverts[i].xyz );
+	}
+	if ( clip ) {
+		bounds[0].x = Max( bounds[0].x, min_x );
+		bounds[0].y = Max( bounds[0].y, min_y );
+		bounds[1].x = Min( bounds[1].x, max_x );
+		bounds[1].y = Min( bounds[1].y, max_y );
+	}
+	BatchSurf( bounds );
 
 	if ( clip ) {
 		int i, j;
@@ -624,13 +758,19 @@ void idGuiModel::DrawStretchTri( idVec2 p1, idVec2 p2, idVec2 p3, idVec2 t1, idV
 
 	// break the current surface if we are changing to a new material
 	if ( material != surf->material ) {
-		if ( surf->numVerts ) {
+		if ( surf->numVerts || surf->batch != surfaces.Num() - 1 ) {
 			AdvanceSurf();
 		}
 		const_cast<idMaterial *>(material)->EnsureNotPurged();	// in case it was a gui item started before a level change
 		surf->material = material;
 	}
 
+	idBounds bounds;
+	bounds.Clear();
+	for ( int i = 0; i < vertCount; i++ ) {
+		bounds.AddPoint( tempVerts[i].xyz );
+	}
+	BatchSurf( bounds );
 
 	int numVerts = verts.Num();
 	int numIndexes = indexes.Num();
@@ -648,3 +788,86 @@ void idGuiModel::DrawStretchTri( idVec2 p1, idVec2 p2, idVec2 p3, idVec2 t1, idV
 	memcpy( &verts[numVerts], tempVerts, vertCount * sizeof( verts[0] ) );
 }
 
+/*
+=============
+BeginCapture
+
+Remembers where the drawing of the capture starts
+=============
+*/
+void idGuiModel::BeginCapture( guiCapture_t &capture ) const {
+	capture.surfaces.SetNum( 0, false );
+	capture.verts.SetNum( 0, false );
+	capture.indexes.SetNum( 0, false );
+	capture.startSurface = surfaces.Num() - 1;
+	capture.startVert = verts.Num();
+	capture.startIndex = indexes.Num();
+	capture.startClearCount = clearCount;
+}
+
+/*
+=============
+EndCapture
+
+Copies everything drawn since BeginCapture, surface by surface. The
+first surface may have been started before the capture, only its new
+verts and indexes are taken.
+=============
+*/
+bool idGuiModel::EndCapture( guiCapture_t &capture ) const {
+	if ( capture.startClearCount != clearCount || capture.startSurface < 0 ) {
+		return false;
+	}
+
+	for ( int i = capture.startSurface; i < surfaces.Num(); i++ ) {
+		const guiModelSurface_t &s = surfaces[i];
+		const int skipVerts = ( i == capture.startSurface ) ? capture.startVert - s.firstVert : 0;
+		const int skipIndexes = ( i == capture.startSurface ) ? capture.startIndex - s.firstIndex : 0;
+		const int numVerts = s.numVerts - skipVerts;
+		const int numIndexes = s.numIndexes - skipIndexes;
+
+		if ( numIndexes <= 0 ) {
+			continue;
+		}
+
+		guiCaptureSurface_t &c = capture.surfaces.Alloc();
+		c.material = s.material;
+		c.color[0] = s.color[0];
+		c.color[1] = s.color[1];
+		c.color[2] = s.color[2];
+		c.color[3] = s.color[3];
+		c.numVerts = numVerts;
+		c.numIndexes = numIndexes;
+
+		const int firstVert = capture.verts.Num();
+		capture.verts.SetNum( firstVert + numVerts, false );
+		memcpy( &capture.verts[firstVert], &verts[s.firstVert + skipVerts], numVerts * sizeof( verts[0] ) );
+
+		const int firstIndex = capture.indexes.Num();
+		capture.indexes.SetNum( firstIndex + numIndexes, false );
+		for ( int j = 0; j < numIndexes; j++ ) {
+			capture.indexes[firstIndex + j] = indexes[s.firstIndex + skipIndexes + j] - skipVerts;
+		}
+	}
+	return true;
+}
+
+/*
+=============
+DrawCapture
+=============
+*/
+void idGuiModel::DrawCapture( const guiCapture_t &capture ) {
+	int firstVert = 0;
+	int firstIndex = 0;
+
+	for ( int i = 0; i < capture.surfaces.Num(); i++ ) {
+		const guiCaptureSurface_t &s = capture.surfaces[i];
+
+		SetColor( s.color[0], s.color[1], s.color[2], s.color[3] );
+		DrawStretchPic( capture.verts.Ptr() + firstVert, capture.indexes.Ptr() + firstIndex, s.numVerts, s.numIndexes, s.material, false );
+
+		firstVert += s.numVerts;
+		firstIndex += s.numIndexes;
+	}
+}
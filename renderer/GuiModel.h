@@ -25,6 +25,13 @@ typedef struct {
 	int					numVerts;
 	int					firstIndex;
 	int					numIndexes;
+
+	// with r_useGuiBatching later surfaces with the same material and color are
+	// drawn together with an earlier one if nothing drawn in between overlaps them
+	int					batch;				// surface this one is drawn with, its own index if none
+	int					nextPiece;			// next surface drawn with this one, -1 at the end
+	int					lastPiece;			// last surface drawn with this one, only kept by the batch
+	idBounds			bounds;				// of all surfaces drawn with this one, only kept by the batch
 } guiModelSurface_t;
 
 class idGuiModel {
@@ -47,12 +54,20 @@ public:
 									float s1, float t1, float s2, float t2, const idMaterial *hShader);
 	void	DrawStretchTri ( idVec2 p1, idVec2 p2, idVec2 p3, idVec2 t1, idVec2 t2, idVec2 t3, const idMaterial *material );
 
+	void	BeginCapture( guiCapture_t &capture ) const;
+	bool	EndCapture( guiCapture_t &capture ) const;
+	void	DrawCapture( const guiCapture_t &capture );
+
 	//---------------------------
 private:
 	void	AdvanceSurf();
+	void	BatchSurf( const idBounds &bounds );
+	int		FindBatch( const idBounds &bounds ) const;
+	bool	BatchOverlapped( int batch, const idBounds &bounds ) const;
 	void	EmitSurface( guiModelSurface_t *surf, float modelMatrix[16], float modelViewMatrix[16], bool depthHack );
 
 	guiModelSurface_t		*surf;
+	int						clearCount;		// so captures can tell if the model was cleared under them
 
 	idList<guiModelSurface_t>	surfaces;
 	idList<glIndex_t>		indexes;
@@ -138,6 +138,9 @@ typedef enum {
 } cubeFiles_t;
 
 #define	MAX_IMAGE_NAME	256
+
+// the processed images of idImage::UsesTextureCache, written to fs_savepath
+#define	TEXTURE_CACHE_DIR	"texcache"
 #define MIN_IMAGE_NAME  4
 
 class idImage {
@@ -198,10 +201,21 @@ public:
 	void		SetImageFilterAndRepeat() const;
 	bool		ShouldImageBePartialCached();
 	void		WritePrecompressedImage();
+	void		WriteDDS( const char *filename, bool offLineCompression, bool verbose );
+	bool		UsesTextureCache() const;
+	unsigned int TextureCacheChecksum( const byte *data, int len ) const;
+	void		TextureCacheFileName( unsigned int checksum, idStr &cacheName ) const;
+	bool		LoadCachedImage( const char *cacheName );
+	void		WriteCachedImage( const char *cacheName );
+	bool		CheckCachedImage( idStr &cacheName );
 	bool		CheckPrecompressedImage( bool fullLoad );
 	void		UploadPrecompressedImage( byte *data, int len );
 	void		ActuallyLoadImage( bool checkForPrecompressed, bool fromBackEnd );
+	void		FinishLoadImage( byte *pic, int width, int height, const char *cacheName );
 	void		StartBackgroundImageLoad();
+	bool		StartBackgroundRead();
+	bool		StartStreamedImageLoad( int size );
+	int			StreamedImageSize() const;
 	int			BitsForInternalFormat( int internalFormat ) const;
 	void		UploadCompressedNormalMap( int width, int height, const byte *rgba, int mipLevel );
 	GLenum		SelectInternalFormat( const byte **dataPtrs, int numDataPtrs, int width, int height,
@@ -223,6 +237,14 @@ public:
 	backgroundDownload_t	bgl;
 	idImage *			bglNext;				// linked from tr.backgroundImageLoads
 
+	// mip level streaming, see idImageManager::UpdateStreamedImages
+	bool				streamed;				// true if the large mip levels are only uploaded when the image covers enough of the screen
+	int					streamSize;				// the larger dimension of the uploaded top mip level
+	int					streamFullSize;			// the larger dimension of the top mip level in the file, after downsizing
+	int					streamLoadSize;			// limits the top mip level of the next upload
+	int					streamWantedSize;		// screen pixels covered by the surfaces using it in streamFrame
+	int					streamFrame;			// the last tr.frameCount it was drawn in
+
 	// parameters that define this image
 	idStr				imgName;				// game path, including extension (except for cube maps), may be an image program
 	void				(*generatorFunction)( idImage *image );	// NULL for files
@@ -234,6 +256,7 @@ public:
 
 	bool				referencedOutsideLevelLoad;
 	bool				levelLoadReferenced;	// for determining if it needs to be purged
+	int					residencyLevel;			// the last level load that referenced it, see idLevelResidency
 	bool				precompressedFile;		// true when it was loaded from a .d3t file
 	bool				defaulted;				// true if the default image was generated because a file couldn't be loaded
 	bool				isMonochrome;			// so the NV20 path can use a reduced pass count
@@ -265,6 +288,10 @@ ID_INLINE idImage::idImage() {
 	bgl.opcode = DLTYPE_FILE;
 	bgl.f = NULL;
 	bglNext = NULL;
+	streamed = false;
+	streamSize = streamFullSize = streamLoadSize = 0;
+	streamWantedSize = 0;
+	streamFrame = 0;
 	imgName[0] = '\0';
 	generatorFunction = NULL;
 	allowDownSize = false;
@@ -274,6 +301,7 @@ ID_INLINE idImage::idImage() {
 	cubeFiles = CF_2D;
 	referencedOutsideLevelLoad = false;
 	levelLoadReferenced = false;
+	residencyLevel = 0;
 	precompressedFile = false;
 	defaulted = false;
 	timestamp = 0;
@@ -294,6 +322,25 @@ void	R_WritePalTGA( const char *filename, const byte *data, const byte *palette,
 // data is in top-to-bottom raster order unless flipVertical is set
 
 
+// an image of the level load pipeline, see idImageManager::LoadLevelImages
+typedef struct imageLoadJob_s {
+	idImage *			image;
+	idStr				fileName;
+	asyncRead_t *		read;
+	byte *				buffer;
+	int					fileSize;
+	ID_TIME_T			timestamp;
+	bool				isJPG;
+	bool				useCache;
+	unsigned int		cacheChecksum;
+	idStr				cacheName;			// empty if the image doesn't use the texture cache
+	bool				cached;				// uploaded from the texture cache, not decoded
+	byte *				pic;
+	int					width;
+	int					height;
+	int					components;
+} imageLoadJob_t;
+
 class idImageManager {
 public:
 	void				Init();
@@ -321,6 +368,10 @@ public:
 	// to turn into textures.
 	void				CompleteBackgroundImageLoads();
 
+	// called by the front end once a frame while the back end is idle to upload the
+	// streamed mip levels that have been read, and start the reads the views need
+	void				UpdateStreamedImages();
+
 	// returns the number of bytes of image data bound in the previous frame
 	int					SumOfUsedImages();
 
@@ -370,7 +421,7 @@ public:
 	static idCVar		image_writeNormalTGA;		// debug tool to write out .tgas of the final normal maps
 	static idCVar		image_writeNormalTGAPalletized;		// debug tool to write out palletized versions of the final normal maps
 	static idCVar		image_writeTGA;				// debug tool to write out .tgas of the non normal maps
-	static idCVar		image_useNormalCompression;	// 1 = use 256 color compression for normal maps if available, 2 = use rxgb compression
+	static idCVar		image_useNormalCompression;	// 1 = use 256 color compression for normal maps if available, 2 = use rxgb compression, 3 = use bc5 compression
 	static idCVar		image_useOffLineCompression; // will write a batch file with commands for the offline compression
 	static idCVar		image_preload;				// if 0, dynamically load all images
 	static idCVar		image_cacheMinK;			// maximum K of precompressed files to read at specification time,
@@ -387,6 +438,12 @@ public:
 	static idCVar		image_downSizeLimit;		// downsize diffuse limit
 	static idCVar		image_blockChecksum;		// duplicate check 
 	static idCVar		image_mipmapMode;			// 0 - software, 1 = gl 1.4, 2 = gl 3.0
+	static idCVar		image_parallelLoad;			// decode level load images on worker threads
+	static idCVar		image_useTextureCache;		// keep the processed tga and jpg images compressed in TEXTURE_CACHE_DIR
+	static idCVar		image_streaming;			// stream the large mip levels of precompressed images by screen coverage
+	static idCVar		image_streamingMinSize;		// the top mip level size of streamed images at level load
+	static idCVar		image_streamingMegs;		// texture memory budget of the streamed images
+	static idCVar		image_residencyMegs;		// texture memory kept for images of earlier levels
 
 	// built-in images
 	idImage *			defaultImage;
@@ -418,18 +475,23 @@ public:
 	idImage *			currentStencilFbo;
 	idImage *			bloomCookedMath;
 	idImage *			bloomImage;
+	idImage *			shadowMapImage;				// light distance packed into RGBA, projected lights
+	idImage *			shadowCubeMapImage;			// light distance packed into RGBA, point lights
 
 	//--------------------------------------------------------
 	
 	idImage *			AllocImage( const char *name );
 	void				SetNormalPalette();
 	void				ChangeTextureFilter();
+	void				LoadLevelImages( int &loadCount );
+	int					StartLevelImageBatch( int first, idList<imageLoadJob_t> &jobs, int &loadCount );
 
 	idList<idImage*>	images;
 	idStrList			ddsList;
 	idHashIndex			ddsHash;
 
 	bool				insideLevelLoad;			// don't actually load images now
+	idLevelResidency	residency;					// keeps images of earlier levels within image_residencyMegs
 
 	byte				originalToCompressed[256];	// maps normal maps to 8 bit textures
 	byte				compressedPalette[768];		// the palette that normal maps use
@@ -448,6 +510,10 @@ public:
 
 	int	numActiveBackgroundImageLoads;
 	const static int MAX_BACKGROUND_IMAGE_LOADS = 8;
+
+	idList<idImage*>	streamedImages;
+	idImage *			streamedImageLoads;			// chain of streamed images that have background file loads active
+	int					numActiveStreamedImageLoads;
 };
 
 extern idImageManager	*globalImages;		// pointer to global list for the rest of the system
@@ -469,6 +535,7 @@ byte *R_ResampleTexture( const byte *in, int inwidth, int inheight,
 							int outwidth, int outheight );
 byte *R_MipMapWithAlphaSpecularity( const byte *in, int width, int height );
 byte *R_MipMap( const byte *in, int width, int height, bool preserveBorder );
+byte *R_MipMapNormalMap( const byte *in, int width, int height );
 byte *R_MipMap3D( const byte *in, int width, int height, int depth, bool preserveBorder );
 
 // these operate in-place on the provided pixels
@@ -488,6 +555,11 @@ IMAGEFILES
 */
 
 void R_LoadImage( const char *name, byte **pic, int *width, int *height, ID_TIME_T *timestamp, bool makePowerOf2 );
+void R_ResampleToPowerOfTwo( byte **pic, int *width, int *height );
+// decode a file read into memory without using the file system, so they can run on
+// worker threads while tr.lockStaticAlloc is set
+bool R_DecodeTGA( const byte *buffer, int fileSize, byte **pic, int *width, int *height, char *error, int errorSize );
+bool R_DecodeJPG( const byte *buffer, int fileSize, byte **pic, int *width, int *height, int *components );
 // pic is in top to bottom raster format
 bool R_LoadCubeImages( const char *cname, cubeFiles_t extensions, byte *pic[6], int *size, ID_TIME_T *timestamp );
 
@@ -501,5 +573,7 @@ IMAGEPROGRAM
 
 void R_LoadImageProgram( const char *name, byte **pic, int *width, int *height, ID_TIME_T *timestamp, textureDepth_t *depth = NULL );
 const char *R_ParsePastImageProgram( idLexer &src );
+// true if the image program is a plain image file without modifiers
+bool R_ImageProgramIsFile( const char *name, idStr &fileName );
 
 #endif /* !__R_IMAGE_H__ */
\ No newline at end of file
@@ -543,32 +543,23 @@ TARGA LOADING
 
 /*
 =============
-LoadTGA
+R_DecodeTGA
+
+Decodes a TGA file read into memory. Doesn't use the file system or print,
+so the image load threads can call it, on failure it returns false with
+the reason in error.
 =============
 */
-static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_TIME_T *timestamp ) {
-	int		columns, rows, numPixels, fileSize, numBytes;
+bool R_DecodeTGA( const byte *buffer, int fileSize, byte **pic, int *width, int *height, char *error, int errorSize ) {
+	int		columns, rows, numPixels, numBytes;
 	byte	*pixbuf;
 	int		row, column;
-	byte	*buf_p;
-	byte	*buffer;
+	const byte	*buf_p;
 	TargaHeader	targa_header;
 	byte		*targa_rgba;
 
-	if ( !pic ) {
-		fileSystem->ReadFile( name, NULL, timestamp );
-		return;	// just getting timestamp
-	}
-
 	*pic = NULL;
-
-	//
-	// load the file
-	//
-	fileSize = fileSystem->ReadFile( name, (void **)&buffer, timestamp );
-	if ( !buffer ) {
-		return;
-	}
+	error[0] = '\0';
 
 	buf_p = buffer;
 
@@ -593,21 +584,25 @@ static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_T
 	targa_header.attributes = *buf_p++;
 
 	if ( targa_header.image_type != 2 && targa_header.image_type != 10 && targa_header.image_type != 3 ) {
-		common->Error( "LoadTGA( %s ): Only type 2 (RGB), 3 (gray), and 10 (RGB) TGA images supported\n", name );
+		idStr::snPrintf( error, errorSize, "Only type 2 (RGB), 3 (gray), and 10 (RGB) TGA images supported" );
+		return false;
 	}
 
 	if ( targa_header.colormap_type != 0 ) {
-		common->Error( "LoadTGA( %s ): colormaps not supported\n", name );
+		idStr::snPrintf( error, errorSize, "colormaps not supported" );
+		return false;
 	}
 
 	if ( ( targa_header.pixel_size != 32 && targa_header.pixel_size != 24 ) && targa_header.image_type != 3 ) {
-		common->Error( "LoadTGA( %s ): Only 32 or 24 bit images supported (no colormaps)\n", name );
+		idStr::snPrintf( error, errorSize, "Only 32 or 24 bit images supported (no colormaps)" );
+		return false;
 	}
 
 	if ( targa_header.image_type == 2 || targa_header.image_type == 3 ) {
 		numBytes = targa_header.width * targa_header.height * ( targa_header.pixel_size >> 3 );
 		if ( numBytes > fileSize - 18 - targa_header.id_length ) {
-			common->Error( "LoadTGA( %s ): incomplete file\n", name );
+			idStr::snPrintf( error, errorSize, "incomplete file" );
+			return false;
 		}
 	}
 
@@ -671,8 +666,10 @@ static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_T
 					*pixbuf++ = alphabyte;
 					break;
 				default:
-					common->Error( "LoadTGA( %s ): illegal pixel_size '%d'\n", name, targa_header.pixel_size );
-					break;
+					idStr::snPrintf( error, errorSize, "illegal pixel_size '%d'", targa_header.pixel_size );
+					R_StaticFree( targa_rgba );
+					*pic = NULL;
+					return false;
 				}
 			}
 		}
@@ -705,8 +702,10 @@ static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_T
 								alphabyte = *buf_p++;
 								break;
 						default:
-							common->Error( "LoadTGA( %s ): illegal pixel_size '%d'\n", name, targa_header.pixel_size );
-							break;
+							idStr::snPrintf( error, errorSize, "illegal pixel_size '%d'", targa_header.pixel_size );
+							R_StaticFree( targa_rgba );
+							*pic = NULL;
+							return false;
 					}
 	
 					for( j = 0; j < packetSize; j++ ) {
@@ -750,8 +749,10 @@ static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_T
 									*pixbuf++ = alphabyte;
 									break;
 							default:
-								common->Error( "LoadTGA( %s ): illegal pixel_size '%d'\n", name, targa_header.pixel_size );
-								break;
+								idStr::snPrintf( error, errorSize, "illegal pixel_size '%d'", targa_header.pixel_size );
+								R_StaticFree( targa_rgba );
+								*pic = NULL;
+								return false;
 						}
 						column++;
 						if ( column == columns ) { // pixel packet run spans across rows
@@ -772,7 +773,40 @@ static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_T
 	}
 
 	if ( (targa_header.attributes & (1<<5)) ) {			// image flp bit
-		R_VerticalFlip( *pic, *width, *height );
+		R_VerticalFlip( *pic, columns, rows );
+	}
+
+	return true;
+}
+
+/*
+=============
+LoadTGA
+=============
+*/
+static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_TIME_T *timestamp ) {
+	byte	*buffer;
+	int		fileSize;
+	char	error[MAX_STRING_CHARS];
+
+	if ( !pic ) {
+		fileSystem->ReadFile( name, NULL, timestamp );
+		return;	// just getting timestamp
+	}
+
+	*pic = NULL;
+
+	//
+	// load the file
+	//
+	fileSize = fileSystem->ReadFile( name, (void **)&buffer, timestamp );
+	if ( !buffer ) {
+		return;
+	}
+
+	if ( !R_DecodeTGA( buffer, fileSize, pic, width, height, error, sizeof( error ) ) ) {
+		fileSystem->FreeFile( buffer );
+		common->Error( "LoadTGA( %s ): %s\n", name, error );
 	}
 
 	fileSystem->FreeFile( buffer );
@@ -795,7 +829,12 @@ Interfaces with the huge libjpeg
 static void init_source (j_decompress_ptr cinfo) {}
 static boolean fill_input_buffer (j_decompress_ptr cinfo)
 {
-    //ERREXIT(cinfo, JERR_INPUT_EMPTY);
+	// insert a fake EOI marker like the jpeglib8 memory source, so a truncated
+	// file never reads past the end of the buffer
+	static const JOCTET fakeEOI[2] = { (JOCTET)0xFF, (JOCTET)JPEG_EOI };
+
+	cinfo->src->next_input_byte = fakeEOI;
+	cinfo->src->bytes_in_buffer = 2;
 	return TRUE;
 }
 static void skip_input_data (j_decompress_ptr cinfo, long num_bytes)
@@ -833,10 +872,13 @@ static void jpeg_mem_src (j_decompress_ptr cinfo, void* buffer, long nbytes)
 
 /*
 =============
-LoadJPG
+R_DecodeJPG
+
+Decodes a JPG file read into memory. Like R_DecodeTGA it doesn't use the
+file system or print, components returns the color components of the file.
 =============
 */
-static void LoadJPG( const char *filename, unsigned char **pic, int *width, int *height, ID_TIME_T *timestamp ) {
+bool R_DecodeJPG( const byte *fbuffer, int len, byte **pic, int *width, int *height, int *components ) {
   /* This struct contains the JPEG decompression parameters and pointers to
    * working space (which is allocated as needed by the JPEG library).
    */
@@ -857,47 +899,10 @@ static void LoadJPG( const char *filename, unsigned char **pic, int *width, int
   /* More stuff */
   JSAMPARRAY buffer;		/* Output row buffer */
   int row_stride;		/* physical row width in output buffer */
-  int		len;		/* Buffer length */
   unsigned char *out;
-  byte	*fbuffer;
   byte  *bbuf;
 
-  /* In this example we want to open the input file before doing anything else,
-   * so that the setjmp() error recovery below can assume the file is open.
-   * VERY IMPORTANT: use "b" option to fopen() if you are on a machine that
-   * requires it in order to read binary files.
-   */
-
-	// JDC: because fill_input_buffer() blindly copies INPUT_BUF_SIZE bytes,
-	// we need to make sure the file buffer is padded or it may crash
-  if ( pic ) {
-	*pic = NULL;		// until proven otherwise
-  }
-  {
-		idFile *f;
-
-		f = fileSystem->OpenFileRead( filename );
-		if ( !f ) {
-			return;
-		}
-		len = f->Length();
-		if ( timestamp ) {
-			*timestamp = f->Timestamp();
-		}
-		if ( !pic ) {
-			fileSystem->CloseFile( f );
-			return;	// just getting timestamp
-		}
-	  	if ( len == 0 ) {
-			fileSystem->CloseFile( f );
-			return;	// angua: image file is empty, just getting timestamp
-		}
-
-		fbuffer = (byte *)Mem_ClearedAlloc( len + 4096 );
-		f->Read( fbuffer, len );
-		fileSystem->CloseFile( f );
-  }
-
+  *pic = NULL;		// until proven otherwise
 
   /* Step 1: allocate and initialize JPEG decompression object */
 
@@ -913,7 +918,7 @@ static void LoadJPG( const char *filename, unsigned char **pic, int *width, int
 
   /* Step 2: specify data source (eg, a file) */
 
-  jpeg_mem_src(&cinfo, fbuffer, len);
+  jpeg_mem_src(&cinfo, (unsigned char *)fbuffer, len);
 
   /* Step 3: read file parameters with jpeg_read_header() */
 
@@ -946,10 +951,7 @@ static void LoadJPG( const char *filename, unsigned char **pic, int *width, int
   /* JSAMPLEs per row in output buffer */
   row_stride = cinfo.output_width * cinfo.output_components;
 
-  if (cinfo.output_components!=4) {
-		common->DWarning( "JPG %s is unsupported color depth (%d)", 
-			filename, cinfo.output_components);
-  }
+  *components = cinfo.output_components;
   out = (byte *)R_StaticAlloc(cinfo.output_width*cinfo.output_height*4);
 
   *pic = out;
@@ -997,20 +999,62 @@ static void LoadJPG( const char *filename, unsigned char **pic, int *width, int
   /* This is an important step since it will release a good deal of memory. */
   jpeg_destroy_decompress(&cinfo);
 
-  /* After finish_decompress, we can close the input file.
-   * Here we postpone it until after no more JPEG errors are possible,
-   * so as to simplify the setjmp error logic above.  (Actually, I don't
-   * think that jpeg_destroy can do an error exit, but why assume anything...)
-   */
-  Mem_Free( fbuffer );
-
   /* At this point you may want to check to see whether any corrupt-data
    * warnings occurred (test whether jerr.pub.num_warnings is nonzero).
    */
 
   /* And we're done! */
+  return true;
 }
 
+/*
+=============
+LoadJPG
+=============
+*/
+static void LoadJPG( const char *filename, unsigned char **pic, int *width, int *height, ID_TIME_T *timestamp ) {
+	idFile	*f;
+	int		len;
+	int		components;
+	byte	*fbuffer;
+
+	if ( pic ) {
+		*pic = NULL;		// until proven otherwise
+	}
+
+	f = fileSystem->OpenFileRead( filename );
+	if ( !f ) {
+		return;
+	}
+	len = f->Length();
+	if ( timestamp ) {
+		*timestamp = f->Timestamp();
+	}
+	if ( !pic ) {
+		fileSystem->CloseFile( f );
+		return;	// just getting timestamp
+	}
+	if ( len == 0 ) {
+		fileSystem->CloseFile( f );
+		return;	// angua: image file is empty, just getting timestamp
+	}
+
+	// JDC: because fill_input_buffer() blindly copies INPUT_BUF_SIZE bytes,
+	// we need to make sure the file buffer is padded or it may crash
+	fbuffer = (byte *)Mem_ClearedAlloc( len + 4096 );
+	f->Read( fbuffer, len );
+	fileSystem->CloseFile( f );
+
+	R_DecodeJPG( fbuffer, len, pic, width, height, &components );
+
+	if ( components != 4 ) {
+		common->DWarning( "JPG %s is unsupported color depth (%d)", filename, components );
+	}
+
+	Mem_Free( fbuffer );
+}
+
+
 //===================================================================
 
 /*
@@ -1089,32 +1133,43 @@ void R_LoadImage( const char *cname, byte **pic, int *width, int *height, ID_TIM
 	// convert to exact power of 2 sizes
 	//
 	if ( pic && *pic && makePowerOf2 ) {
-		int		w, h;
-		int		scaled_width, scaled_height;
-		byte	*resampledBuffer;
-
-		w = *width;
-		h = *height;
-
-		for (scaled_width = 1 ; scaled_width < w ; scaled_width<<=1)
-			;
-		for (scaled_height = 1 ; scaled_height < h ; scaled_height<<=1)
-			;
+		R_ResampleToPowerOfTwo( pic, width, height );
+	}
+}
 
-		if ( scaled_width != w || scaled_height != h ) {
-			if ( globalImages->image_roundDown.GetBool() && scaled_width > w ) {
-				scaled_width >>= 1;
-			}
-			if ( globalImages->image_roundDown.GetBool() && scaled_height > h ) {
-				scaled_height >>= 1;
-			}
+/*
+=================
+R_ResampleToPowerOfTwo
 
-			resampledBuffer = R_ResampleTexture( *pic, w, h, scaled_width, scaled_height );
-			R_StaticFree( *pic );
-			*pic = resampledBuffer;
-			*width = scaled_width;
-			*height = scaled_height;
+Resamples a loaded image to power of 2 sizes, replacing *pic
+=================
+*/
+void R_ResampleToPowerOfTwo( byte **pic, int *width, int *height ) {
+	int		w, h;
+	int		scaled_width, scaled_height;
+	byte	*resampledBuffer;
+
+	w = *width;
+	h = *height;
+
+	for (scaled_width = 1 ; scaled_width < w ; scaled_width<<=1)
+		;
+	for (scaled_height = 1 ; scaled_height < h ; scaled_height<<=1)
+		;
+
+	if ( scaled_width != w || scaled_height != h ) {
+		if ( globalImages->image_roundDown.GetBool() && scaled_width > w ) {
+			scaled_width >>= 1;
+		}
+		if ( globalImages->image_roundDown.GetBool() && scaled_height > h ) {
+			scaled_height >>= 1;
 		}
+
+		resampledBuffer = R_ResampleTexture( *pic, w, h, scaled_width, scaled_height );
+		R_StaticFree( *pic );
+		*pic = resampledBuffer;
+		*width = scaled_width;
+		*height = scaled_height;
 	}
 }
 
@@ -55,7 +55,7 @@ idCVar idImageManager::image_colorMipLevels( "image_colorMipLevels", "0", CVAR_R
 idCVar idImageManager::image_preload( "image_preload", "1", CVAR_RENDERER | CVAR_BOOL | CVAR_ARCHIVE, "if 0, dynamically load all images" );
 idCVar idImageManager::image_useCompression( "image_useCompression", "1", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_BOOL, "1 = load compressed (DDS) images, 0 = force everything to high quality. 0 does not work for TDM as all our textures are DDS." );
 idCVar idImageManager::image_useAllFormats( "image_useAllFormats", "1", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_BOOL, "allow alpha/intensity/luminance/luminance+alpha" );
-idCVar idImageManager::image_useNormalCompression( "image_useNormalCompression", "2", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_INTEGER, "2 = use rxgb compression for normal maps, 1 = use 256 color compression for normal maps if available" );
+idCVar idImageManager::image_useNormalCompression( "image_useNormalCompression", "2", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_INTEGER, "3 = use bc5 (latc2) compression for normal maps if available, the interaction programs reconstruct z, 2 = use rxgb compression for normal maps, 1 = use 256 color compression for normal maps if available" );
 idCVar idImageManager::image_usePrecompressedTextures( "image_usePrecompressedTextures", "1", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_BOOL, "Use .dds files if present." );
 idCVar idImageManager::image_writePrecompressedTextures( "image_writePrecompressedTextures", "0", CVAR_RENDERER | CVAR_BOOL, "write .dds files if necessary" );
 idCVar idImageManager::image_writeNormalTGA( "image_writeNormalTGA", "0", CVAR_RENDERER | CVAR_BOOL, "write .tgas of the final normal maps for debugging" );
@@ -74,6 +74,12 @@ idCVar idImageManager::image_ignoreHighQuality( "image_ignoreHighQuality", "0",
 idCVar idImageManager::image_downSizeLimit( "image_downSizeLimit", "256", CVAR_RENDERER | CVAR_ARCHIVE, "controls diffuse map downsample limit" ); 
 idCVar idImageManager::image_blockChecksum("image_blockChecksum", "0", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_BOOL, "Perform MD4 block checksum calculation for later duplicates check"); 
 idCVar idImageManager::image_mipmapMode("image_mipmapMode", "2", CVAR_RENDERER | CVAR_ARCHIVE, "Mipmap generation mode: 0 - software, 1 - GL 1.4, 2 - GL 3.0"); 
+idCVar idImageManager::image_useTextureCache( "image_useTextureCache", "1", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_BOOL, "keep the compressed mip levels of processed tga and jpg images in " TEXTURE_CACHE_DIR "/, keyed by the file content, to skip the processing on later loads" );
+idCVar idImageManager::image_streaming( "image_streaming", "0", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_BOOL, "upload only the small mip levels of large precompressed images at level load, and stream the larger ones in by screen coverage" );
+idCVar idImageManager::image_streamingMinSize( "image_streamingMinSize", "128", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_INTEGER, "the largest mip level of streamed images uploaded at level load", 1, 4096 );
+idCVar idImageManager::image_streamingMegs( "image_streamingMegs", "256", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_FLOAT, "MB of texture memory the streamed images may use before the ones not seen for a while drop their large mip levels" );
+idCVar idImageManager::image_residencyMegs( "image_residencyMegs", "256", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_FLOAT, "MB of texture memory the images of earlier levels may keep after a level load, the least recently used ones are purged first" );
+idCVar idImageManager::image_parallelLoad("image_parallelLoad", "1", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_BOOL, "at level load, read the tga and jpg images in the background and decode them on worker threads");
 // do this with a pointer, in case we want to make the actual manager
 // a private virtual subclass
 idImageManager	imageManager;
@@ -424,6 +430,36 @@ static void R_FlatNormalImage( idImage *image ) {
 		TF_DEFAULT, true, TR_REPEAT, TD_HIGH_QUALITY );
 }
 
+/*
+================
+R_ShadowMapImage
+
+Placeholders, the back end resizes them to r_shadowMapSize before rendering the
+shadow maps, see RB_ARB2_ShadowMapPass. Packed light distances must not be filtered.
+================
+*/
+static void R_ShadowMapImage( idImage *image ) {
+	byte	data[DEFAULT_SIZE][DEFAULT_SIZE][4];
+
+	// white is as far from the light as it gets
+	memset( data, 255, sizeof( data ) );
+
+	image->GenerateImage( (byte *)data, DEFAULT_SIZE, DEFAULT_SIZE, 
+		TF_NEAREST, false, TR_CLAMP, TD_HIGH_QUALITY );
+}
+
+static void R_ShadowCubeMapImage( idImage *image ) {
+	byte	data[DEFAULT_SIZE][DEFAULT_SIZE][4];
+	const byte	*pics[6];
+
+	memset( data, 255, sizeof( data ) );
+	for ( int i = 0 ; i < 6 ; i++ ) {
+		pics[i] = data[0][0];
+	}
+
+	image->GenerateCubeImage( pics, DEFAULT_SIZE, TF_NEAREST, false, TD_HIGH_QUALITY );
+}
+
 static void R_AmbientNormalImage( idImage *image ) {
 	byte	data[DEFAULT_SIZE][DEFAULT_SIZE][4];
 
@@ -1787,28 +1823,12 @@ void idImage::StartBackgroundImageLoad() {
 		return;
 	}
 
-	bglNext = globalImages->backgroundImageLoads;
-	globalImages->backgroundImageLoads = this;
-
-	char filename[MAX_IMAGE_NAME];
-	ImageProgramStringToCompressedFileName( imgName, filename );
-
-	bgl.completed = false;
-	bgl.f = fileSystem->OpenFileRead( filename );
-	if ( !bgl.f ) {
-		common->Warning( "idImageManager::StartBackgroundImageLoad: Couldn't load %s", imgName.c_str() );
-		return;
-	}
-	bgl.file.position = 0;
-	bgl.file.length = bgl.f->Length();
-	if ( bgl.file.length < sizeof( ddsFileHeader_t ) ) {
-		common->Warning( "idImageManager::StartBackgroundImageLoad: %s had a bad file length", imgName.c_str() );
+	if ( !StartBackgroundRead() ) {
 		return;
 	}
 
-	bgl.file.buffer = R_StaticAlloc( bgl.file.length );
-
-	fileSystem->BackgroundDownload( &bgl );
+	bglNext = globalImages->backgroundImageLoads;
+	globalImages->backgroundImageLoads = this;
 
 	imageManager.numActiveBackgroundImageLoads++;
 
@@ -1838,6 +1858,207 @@ void idImage::StartBackgroundImageLoad() {
 	}
 }
 
+/*
+==================
+idImage::StartBackgroundRead
+
+Opens the precompressed file and starts reading all of it on the file system's background thread
+==================
+*/
+bool idImage::StartBackgroundRead() {
+	char filename[MAX_IMAGE_NAME];
+	ImageProgramStringToCompressedFileName( imgName, filename );
+
+	bgl.completed = false;
+	bgl.f = fileSystem->OpenFileRead( filename );
+	if ( !bgl.f ) {
+		common->Warning( "idImageManager::StartBackgroundImageLoad: Couldn't load %s", imgName.c_str() );
+		return false;
+	}
+	bgl.file.position = 0;
+	bgl.file.length = bgl.f->Length();
+	if ( bgl.file.length < sizeof( ddsFileHeader_t ) ) {
+		common->Warning( "idImageManager::StartBackgroundImageLoad: %s had a bad file length", imgName.c_str() );
+		fileSystem->CloseFile( bgl.f );
+		bgl.f = NULL;
+		return false;
+	}
+
+	bgl.file.buffer = R_StaticAlloc( bgl.file.length );
+
+	fileSystem->BackgroundDownload( &bgl );
+
+	return true;
+}
+
+// streamed images not drawn for this many frames may drop their large mip levels
+#define STREAMED_IMAGE_KEEP_FRAMES	300
+
+/*
+==================
+idImage::StreamedImageSize
+
+The top mip level size the views need of a streamed image
+==================
+*/
+int idImage::StreamedImageSize() const {
+	const int minSize = Min( globalImages->image_streamingMinSize.GetInteger(), streamFullSize );
+
+	if ( !globalImages->image_streaming.GetBool() ) {
+		return streamFullSize;
+	}
+	if ( tr.frameCount - streamFrame > STREAMED_IMAGE_KEEP_FRAMES ) {
+		return minSize;
+	}
+
+	// the texture maps about once across the surface, so a texel per covered pixel
+	int size = idMath::CeilPowerOfTwo( Max( streamWantedSize, 1 ) );
+	if ( size < minSize ) {
+		size = minSize;
+	}
+	if ( size > streamFullSize ) {
+		size = streamFullSize;
+	}
+	return size;
+}
+
+/*
+==================
+idImage::StartStreamedImageLoad
+
+Starts reading the file to upload it with the given top mip level size,
+returns false if all the streaming reads are busy
+==================
+*/
+bool idImage::StartStreamedImageLoad( int size ) {
+	if ( globalImages->numActiveStreamedImageLoads >= idImageManager::MAX_BACKGROUND_IMAGE_LOADS ) {
+		return false;
+	}
+	if ( globalImages->image_showBackgroundLoads.GetBool() ) {
+		common->Printf( "idImage::StartStreamedImageLoad: %s at %i\n", imgName.c_str(), size );
+	}
+
+	// a failed read is not retried, the image keeps the mip levels it has
+	backgroundLoadInProgress = true;
+	if ( !StartBackgroundRead() ) {
+		return true;
+	}
+	streamLoadSize = size;
+
+	bglNext = globalImages->streamedImageLoads;
+	globalImages->streamedImageLoads = this;
+	globalImages->numActiveStreamedImageLoads++;
+
+	return true;
+}
+
+/*
+==================
+R_SortStreamedImagesByFrame
+
+Least recently drawn first
+==================
+*/
+static int R_SortStreamedImagesByFrame( idImage * const *a, idImage * const *b ) {
+	return (*a)->streamFrame - (*b)->streamFrame;
+}
+
+/*
+==================
+idImageManager::UpdateStreamedImages
+
+Images which cover more of the screen than their uploaded top mip level get
+the larger levels read in the background, as long as the streamed images fit
+into image_streamingMegs. When they don't fit, the images nobody has looked
+at for STREAMED_IMAGE_KEEP_FRAMES drop back to image_streamingMinSize.
+
+Runs in the front end while the back end is idle, so the uploads don't need
+to sync with the render thread.
+==================
+*/
+void idImageManager::UpdateStreamedImages() {
+	int i;
+
+	if ( streamedImages.Num() == 0 ) {
+		return;
+	}
+
+	// upload the reads that have completed
+	idImage	*remainingList = NULL;
+	idImage	*next;
+
+	for ( idImage *image = streamedImageLoads ; image ; image = next ) {
+		next = image->bglNext;
+		if ( image->bgl.completed ) {
+			numActiveStreamedImageLoads--;
+			fileSystem->CloseFile( image->bgl.f );
+			image->bgl.f = NULL;
+			// images purged in the meantime are reloaded with this size when they are used again
+			if ( image->texnum != idImage::TEXTURE_NOT_LOADED ) {
+				image->PurgeImage();
+				image->UploadPrecompressedImage( (byte *)image->bgl.file.buffer, image->bgl.file.length );
+			}
+			R_StaticFree( image->bgl.file.buffer );
+			image->backgroundLoadInProgress = false;
+		} else {
+			image->bglNext = remainingList;
+			remainingList = image;
+		}
+	}
+	streamedImageLoads = remainingList;
+
+	// the streamed images keep their uploads while streaming is turned off, but get all their levels back
+	const bool budgeted = image_streaming.GetBool();
+	const int budget = image_streamingMegs.GetFloat() * 1024 * 1024;
+
+	int totalSize = 0;
+	for ( i = 0; i < streamedImages.Num(); i++ ) {
+		totalSize += streamedImages[i]->StorageSize();
+	}
+
+	idList<idImage *> unused;
+	for ( i = 0; i < streamedImages.Num(); i++ ) {
+		idImage *image = streamedImages[i];
+		if ( image->texnum == idImage::TEXTURE_NOT_LOADED || image->backgroundLoadInProgress ) {
+			continue;
+		}
+
+		const int size = image->StreamedImageSize();
+		if ( size < image->streamSize ) {
+			unused.Append( image );
+			continue;
+		}
+		if ( size == image->streamSize ) {
+			continue;
+		}
+
+		// the storage grows with the square of the size
+		const float scale = (float)size / image->streamSize;
+		const int needed = image->StorageSize() * ( scale * scale - 1.0f );
+		if ( budgeted && totalSize + needed > budget ) {
+			continue;
+		}
+		if ( !image->StartStreamedImageLoad( size ) ) {
+			break;
+		}
+		totalSize += needed;
+	}
+
+	if ( budgeted && totalSize > budget ) {
+		unused.Sort( R_SortStreamedImagesByFrame );
+		for ( i = 0; i < unused.Num() && totalSize > budget; i++ ) {
+			idImage *image = unused[i];
+			const int size = image->StreamedImageSize();
+			const float scale = (float)size / image->streamSize;
+			const int freed = image->StorageSize() * ( 1.0f - scale * scale );
+			if ( !image->StartStreamedImageLoad( size ) ) {
+				break;
+			}
+			totalSize -= freed;
+		}
+	}
+}
+
 /*
 ==================
 R_CompleteBackgroundImageLoads
@@ -1949,6 +2170,9 @@ void idImageManager::Init() {
 	cacheLRU.cacheUsageNext = &cacheLRU;
 	cacheLRU.cacheUsagePrev = &cacheLRU;
 
+	streamedImageLoads = NULL;
+	numActiveStreamedImageLoads = 0;
+
 	// set default texture filter modes
 	ChangeTextureFilter();
 
@@ -1986,6 +2210,9 @@ void idImageManager::Init() {
 	bloomCookedMath = ImageFromFunction( "_cookedMath", R_RGBA8Image );
 	bloomImage = ImageFromFunction( "_bloomImage", R_RGBA8Image );
 
+	shadowMapImage = ImageFromFunction( "_shadowMap", R_ShadowMapImage );
+	shadowCubeMapImage = ImageFromFunction( "_shadowCubeMap", R_ShadowCubeMapImage );
+
 	cmdSystem->AddCommand( "reloadImages", R_ReloadImages_f, CMD_FL_RENDERER, "reloads images" );
 	cmdSystem->AddCommand( "listImages", R_ListImages_f, CMD_FL_RENDERER, "lists images" );
 	cmdSystem->AddCommand( "combineCubeImages", R_CombineCubeImages_f, CMD_FL_RENDERER, "combines six images for roq compression" );
@@ -1999,6 +2226,7 @@ Shutdown
 ===============
 */
 void idImageManager::Shutdown() {
+	streamedImages.Clear();
 	images.DeleteContents( true );
 }
 
@@ -2016,6 +2244,8 @@ void idImageManager::BeginLevelLoad() {
 	insideLevelLoad = true;
 	idImage	*image;
 
+	residency.BeginLevelLoad();
+
 	for ( int i = 0 ; i < images.Num() ; i++ ) {
 		image = images[ i ];
 
@@ -2029,6 +2259,304 @@ void idImageManager::BeginLevelLoad() {
 	}
 }
 
+/*
+====================
+R_IsPipelinedImage
+
+True if the image is a plain tga or jpg file, which the level
+load pipeline can decode without the image program parser
+====================
+*/
+static bool R_IsPipelinedImage( const idImage *image, idStr &fileName )
+{
+	if ( image->generatorFunction || image->isPartialImage || image->cubeFiles != CF_2D )
+	{
+		return false;
+	}
+	if ( !R_ImageProgramIsFile( image->imgName, fileName ) )
+	{
+		return false;
+	}
+
+	// like R_LoadImage
+	fileName.DefaultFileExtension( ".tga" );
+	if ( fileName.Length() < 5 )
+	{
+		return false;
+	}
+	fileName.ToLower();
+
+	idStr ext;
+	fileName.ExtractFileExtension( ext );
+	return ext == "tga" || ext == "jpg";
+}
+
+/*
+====================
+R_FinishLevelImageRead
+
+Waits for the file of a job, a missing tga falls back to the jpg like R_LoadImage
+====================
+*/
+static void R_FinishLevelImageRead( imageLoadJob_t &job )
+{
+	job.fileSize = fileSystem->FinishReadFileAsync( job.read, (void **)&job.buffer, &job.timestamp );
+	job.read = NULL;
+
+	if ( job.fileSize < 0 && !job.isJPG )
+	{
+		job.fileName.StripFileExtension();
+		job.fileName.DefaultFileExtension( ".jpg" );
+		job.isJPG = true;
+		job.fileSize = fileSystem->ReadFile( job.fileName, (void **)&job.buffer, &job.timestamp );
+	}
+}
+
+/*
+====================
+R_ChecksumLevelImage
+
+Runs on the worker threads, keys the file content for the texture cache
+====================
+*/
+static void R_ChecksumLevelImage( imageLoadJob_t &job )
+{
+	if ( job.fileSize > 0 && job.useCache )
+	{
+		job.cacheChecksum = job.image->TextureCacheChecksum( job.buffer, job.fileSize );
+	}
+}
+
+/*
+====================
+R_FindCachedLevelImage
+
+Looks for the image in the texture cache, a cached image is not decoded
+====================
+*/
+static void R_FindCachedLevelImage( imageLoadJob_t &job )
+{
+	if ( job.fileSize <= 0 || !job.useCache )
+	{
+		return;
+	}
+
+	job.image->TextureCacheFileName( job.cacheChecksum, job.cacheName );
+	job.cached = fileSystem->ReadFile( job.cacheName, NULL, NULL ) > 0;
+}
+
+/*
+====================
+R_DecodeLevelImage
+
+Runs on the worker threads, job.pic stays NULL if the
+image has to be loaded through ActuallyLoadImage instead
+====================
+*/
+static void R_DecodeLevelImage( imageLoadJob_t &job )
+{
+	if ( job.fileSize <= 0 || job.cached )
+	{
+		return;
+	}
+
+	if ( job.isJPG )
+	{
+		R_DecodeJPG( job.buffer, job.fileSize, &job.pic, &job.width, &job.height, &job.components );
+	}
+	else
+	{
+		char error[MAX_STRING_CHARS];
+		R_DecodeTGA( job.buffer, job.fileSize, &job.pic, &job.width, &job.height, error, sizeof( error ) );
+	}
+
+	if ( !job.pic )
+	{
+		return;
+	}
+	if ( job.width < 1 || job.height < 1 )
+	{
+		R_StaticFree( job.pic );
+		job.pic = NULL;
+		return;
+	}
+
+	R_ResampleToPowerOfTwo( &job.pic, &job.width, &job.height );
+
+	if ( globalImages->image_blockChecksum.GetBool() )
+	{
+		job.image->imageHash = MD4_BlockChecksum( job.pic, job.width * job.height * 4 );
+	}
+}
+
+/*
+====================
+StartLevelImageBatch
+
+Starts the reads of the next batch of images for LoadLevelImages, loading
+the images which can't be pipelined and the precompressed ones on the way.
+Returns the index of the next image to look at.
+====================
+*/
+int idImageManager::StartLevelImageBatch( int first, idList<imageLoadJob_t> &jobs, int &loadCount )
+{
+	const int IMAGE_LOAD_BATCH = 16;
+	int i;
+
+	jobs.SetNum( 0, false );
+
+	for ( i = first ; i < images.Num() && jobs.Num() < IMAGE_LOAD_BATCH ; i++ )
+	{
+		idImage	*image = images[ i ];
+
+		// grayman #3763 - update the loading bar every LOAD_KEY_IMAGE_GRANULARITY images
+		if ( (i % LOAD_KEY_IMAGE_GRANULARITY) == 0)
+		{
+			common->PacifierUpdate(LOAD_KEY_IMAGES_INTERIM,i);
+		}
+
+		if ( image->generatorFunction || !image->levelLoadReferenced || (image->texnum != idImage::TEXTURE_NOT_LOADED) || image->partialImage )
+		{
+			continue;
+		}
+		loadCount++;
+
+		idStr fileName;
+		if ( !R_IsPipelinedImage( image, fileName ) )
+		{
+			image->ActuallyLoadImage( true, false );
+			continue;
+		}
+
+		// see if we have a pre-generated image file that is
+		// already image processed and compressed
+		if ( image_usePrecompressedTextures.GetBool() )
+		{
+			idLoadProfileScope profile( "image", image->imgName.c_str() );
+
+			R_SyncRenderThread();
+			if ( image->CheckPrecompressedImage( true ) )
+			{
+				continue;
+			}
+		}
+
+		imageLoadJob_t &job = jobs.Alloc();
+		job.image = image;
+		job.fileName = fileName;
+		job.read = fileSystem->ReadFileAsync( fileName );
+		job.buffer = NULL;
+		job.fileSize = -1;
+		job.timestamp = FILE_NOT_FOUND_TIMESTAMP;
+		job.isJPG = fileName.Right( 3 ) == "jpg";
+		job.useCache = image->UsesTextureCache();
+		job.cacheChecksum = 0;
+		job.cacheName.Empty();
+		job.cached = false;
+		job.pic = NULL;
+		job.width = 0;
+		job.height = 0;
+		job.components = 4;
+	}
+
+	return i;
+}
+
+/*
+====================
+LoadLevelImages
+
+Loads the images of EndLevelLoad in batches. The next batch is read by the
+async read thread while the current one is decoded and resampled on worker
+threads, the uploads stay on the main thread with the GL context. Anything
+but plain tga and jpg files, and every image failing on the way, goes
+through ActuallyLoadImage, which prints the errors.
+====================
+*/
+void idImageManager::LoadLevelImages( int &loadCount )
+{
+	idList<imageLoadJob_t> jobs, nextJobs;
+	int i;
+
+	int next = StartLevelImageBatch( 0, jobs, loadCount );
+
+	while ( jobs.Num() > 0 )
+	{
+		for ( i = 0 ; i < jobs.Num() ; i++ )
+		{
+			R_FinishLevelImageRead( jobs[ i ] );
+		}
+
+		// read the next batch while this one is decoded
+		next = StartLevelImageBatch( next, nextJobs, loadCount );
+
+		const int numJobs = jobs.Num();
+		imageLoadJob_t *jobList = jobs.Ptr();
+
+#pragma omp parallel for schedule( dynamic )
+		for ( i = 0 ; i < numJobs ; i++ )
+		{
+			R_ChecksumLevelImage( jobList[ i ] );
+		}
+
+		for ( i = 0 ; i < numJobs ; i++ )
+		{
+			R_FindCachedLevelImage( jobList[ i ] );
+		}
+
+		tr.lockStaticAlloc = true;
+
+#pragma omp parallel for schedule( dynamic )
+		for ( i = 0 ; i < numJobs ; i++ )
+		{
+			R_DecodeLevelImage( jobList[ i ] );
+		}
+
+		tr.lockStaticAlloc = false;
+
+		R_SyncRenderThread();
+
+		for ( i = 0 ; i < numJobs ; i++ )
+		{
+			imageLoadJob_t &job = jobList[ i ];
+
+			if ( job.buffer )
+			{
+				fileSystem->FreeFile( job.buffer );
+			}
+
+			if ( job.cached )
+			{
+				idLoadProfileScope profile( "image", job.image->imgName.c_str() );
+
+				job.image->timestamp = job.timestamp;
+				if ( job.image->LoadCachedImage( job.cacheName ) )
+				{
+					continue;
+				}
+			}
+
+			if ( !job.pic )
+			{
+				job.image->ActuallyLoadImage( false, false );
+				continue;
+			}
+
+			if ( job.isJPG && job.components != 4 )
+			{
+				common->DWarning( "JPG %s is unsupported color depth (%d)", job.fileName.c_str(), job.components );
+			}
+
+			idLoadProfileScope profile( "image", job.image->imgName.c_str() );
+
+			job.image->timestamp = job.timestamp;
+			job.image->FinishLoadImage( job.pic, job.width, job.height, job.cacheName.Length() ? job.cacheName.c_str() : NULL );
+		}
+
+		jobs.Swap( nextJobs );
+	}
+}
+
 /*
 ====================
 EndLevelLoad
@@ -2059,7 +2587,7 @@ void idImageManager::EndLevelLoad()
 	int	keepCount = 0;
 	int	loadCount = 0;
 
-	// purge the ones we don't need
+	// purge the ones we don't need, the loaded ones of earlier levels go to the residency
 	for ( int i = 0 ; i < images.Num() ; i++ )
 	{
 		idImage	*image = images[ i ];
@@ -2069,6 +2597,11 @@ void idImageManager::EndLevelLoad()
 		}
 		else if ( !image->levelLoadReferenced && !image->referencedOutsideLevelLoad )
 		{
+			if ( image->texnum != idImage::TEXTURE_NOT_LOADED && !com_purgeAll.GetBool() )
+			{
+				residency.AddCandidate( i, image->StorageSize(), image->residencyLevel );
+				continue;
+			}
 			//common->Printf( "Purging %s\n", image->imgName.c_str() );
 			purgeCount++;
 			image->PurgeImage();
@@ -2078,12 +2611,33 @@ void idImageManager::EndLevelLoad()
 			//common->Printf( "Keeping %s\n", image->imgName.c_str() );
 			keepCount++;
 		}
+
+		if ( image->levelLoadReferenced )
+		{
+			if ( image->texnum != idImage::TEXTURE_NOT_LOADED )
+			{
+				residency.AddHit( image->residencyLevel );
+			}
+			image->residencyLevel = residency.GetLevel();
+		}
+	}
+
+	idList<int> evictions;
+	residency.SelectEvictions( image_residencyMegs.GetFloat(), evictions );
+	for ( int i = 0 ; i < evictions.Num() ; i++ )
+	{
+		purgeCount++;
+		images[ evictions[ i ] ]->PurgeImage();
 	}
 
 	common->PacifierUpdate(LOAD_KEY_IMAGES_START,images.Num()/LOAD_KEY_IMAGE_GRANULARITY); // grayman #3763
 
 	// load the ones we do need, if we are preloading
-	for ( int i = 0 ; i < images.Num() ; i++ )
+	if ( image_parallelLoad.GetBool() )
+	{
+		LoadLevelImages( loadCount );
+	}
+	else for ( int i = 0 ; i < images.Num() ; i++ )
 	{
 		idImage	*image = images[ i ];
 		if ( image->generatorFunction )
@@ -2113,10 +2667,13 @@ void idImageManager::EndLevelLoad()
 
 	}
 
+	residency.AddLoads( loadCount );
+
 	const int end = Sys_Milliseconds();
 	common->Printf( "%5i purged from previous\n", purgeCount );
 	common->Printf( "%5i kept from previous\n", keepCount );
 	common->Printf( "%5i new loaded\n", loadCount );
+	residency.Print( "images" );
 	common->Printf( "all images loaded in %5.1f seconds\n", ( end - start ) * 0.001f );
 	common->PacifierUpdate(LOAD_KEY_DONE,0); // grayman #3763
 	common->Printf( "----------------------------------------\n" );
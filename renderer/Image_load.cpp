@@ -255,7 +255,11 @@ GLenum idImage::SelectInternalFormat( const byte **dataPtrs, int numDataPtrs, in
 		if ( globalImages->image_useCompression.GetBool() && globalImages->image_useNormalCompression.GetInteger() == 1) {
 			// image_useNormalCompression should only be set to 1 on nv_10 and nv_20 paths
 			return GL_COLOR_INDEX8_EXT;
-		} else if ( globalImages->image_useCompression.GetBool() && globalImages->image_useNormalCompression.GetInteger() == 2 && glConfig.textureCompressionAvailable ) {
+		} else if ( globalImages->image_useCompression.GetBool() && globalImages->image_useNormalCompression.GetInteger() == 3 && glConfig.textureCompressionLATCAvailable ) {
+			// image_useNormalCompression == 3 keeps only x and y in two bc5 blocks of the same size as one dxt5 block,
+			// without the dxt5 color block that shares its endpoints between y and z
+			return GL_COMPRESSED_LUMINANCE_ALPHA_LATC2_EXT;
+		} else if ( globalImages->image_useCompression.GetBool() && globalImages->image_useNormalCompression.GetInteger() >= 2 && glConfig.textureCompressionAvailable ) {
 			// image_useNormalCompression == 2 uses rxgb format which produces really good quality for medium settings
 			return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
 		} else {
@@ -558,7 +562,9 @@ void idImage::GenerateImage( const byte *pic, int width, int height,
 	else {
 		// resample down as needed (FIXME: this doesn't seem like it resamples anymore!)
 		// scaledBuffer = R_ResampleTexture( pic, width, height, width >>= 1, height >>= 1 );
-		scaledBuffer = R_MipMap( pic, width, height, preserveBorder );
+		// the normals of bump maps are renormalized after averaging
+		const bool normalMipMap = ( depth == TD_BUMP && !preserveBorder );
+		scaledBuffer = normalMipMap ? R_MipMapNormalMap( pic, width, height ) : R_MipMap( pic, width, height, preserveBorder );
 		width >>= 1;
 		height >>= 1;
 		if ( width < 1 ) {
@@ -569,7 +575,7 @@ void idImage::GenerateImage( const byte *pic, int width, int height,
 		}
 
 		while ( width > scaled_width || height > scaled_height ) {
-			shrunk = R_MipMap( scaledBuffer, width, height, preserveBorder );
+			shrunk = normalMipMap ? R_MipMapNormalMap( scaledBuffer, width, height ) : R_MipMap( scaledBuffer, width, height, preserveBorder );
 			R_StaticFree( scaledBuffer );
 			scaledBuffer = shrunk;
 
@@ -645,9 +651,11 @@ void idImage::GenerateImage( const byte *pic, int width, int height,
 	// if the image is precompressed ( either in palletized mode or true rxgb mode )
 	// then it is loaded above and the swap never happens here
 	if ( depth == TD_BUMP && globalImages->image_useNormalCompression.GetInteger() != 1 ) {
+		// latc2 takes its luminance from red, so y goes there as well and z is dropped
+		const bool latc = ( internalFormat == GL_COMPRESSED_LUMINANCE_ALPHA_LATC2_EXT );
 		for ( int i = 0; i < scaled_width * scaled_height * 4; i += 4 ) {
 			scaledBuffer[ i + 3 ] = scaledBuffer[ i ];
-			scaledBuffer[ i ] = 0;
+			scaledBuffer[ i ] = latc ? scaledBuffer[ i + 1 ] : 0;
 		}
 	}
 	// upload the main image level
@@ -1056,14 +1064,23 @@ void idImage::WritePrecompressedImage() {
 		}
 	}
 
-	if ( !glConfig.isInitialized ) {
-		return;
-	}
-
 	char filename[MAX_IMAGE_NAME];
 	ImageProgramStringToCompressedFileName( imgName, filename );
 
+	WriteDDS( filename, globalImages->image_useOffLineCompression.GetBool(), true );
+}
+
+/*
+================
+WriteDDS
 
+Reads back the uploaded levels of the image and writes them as a .dds file
+================
+*/
+void idImage::WriteDDS( const char *filename, bool offLineCompression, bool verbose ) {
+	if ( !glConfig.isInitialized ) {
+		return;
+	}
 
 	int numLevels = NumLevelsForImageSize( uploadWidth, uploadHeight );
 	if ( numLevels > MAX_TEXTURE_LEVELS ) {
@@ -1109,13 +1126,15 @@ void idImage::WritePrecompressedImage() {
 			}
 	}
 
-	if ( globalImages->image_useOffLineCompression.GetBool() && FormatIsDXT( altInternalFormat ) ) {
+	if ( offLineCompression && FormatIsDXT( altInternalFormat ) ) {
 		idStr outFile = fileSystem->RelativePathToOSPath( filename, "fs_basepath" );
 		idStr inFile = outFile;
 		inFile.StripFileExtension();
 		inFile.SetFileExtension( "tga" );
 		idStr format;
-		if ( depth == TD_BUMP ) {
+		if ( depth == TD_BUMP && altInternalFormat == GL_COMPRESSED_LUMINANCE_ALPHA_LATC2_EXT ) {
+			format = "ATI2N";
+		} else if ( depth == TD_BUMP ) {
 			format = "RXGB +red 0.0 +green 0.5 +blue 0.5";
 		} else {
 			switch ( altInternalFormat ) {
@@ -1187,6 +1206,9 @@ void idImage::WritePrecompressedImage() {
 		case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
 			header.ddspf.dwFourCC = DDS_MAKEFOURCC('D','X','T','5');
 			break;
+		case GL_COMPRESSED_LUMINANCE_ALPHA_LATC2_EXT:
+			header.ddspf.dwFourCC = DDS_MAKEFOURCC('A','T','I','2');
+			break;
 		}
 	} else {
 		header.ddspf.dwFlags = ( internalFormat == GL_COLOR_INDEX8_EXT ) ? DDSF_RGB | DDSF_ID_INDEXCOLOR : DDSF_RGB;
@@ -1219,7 +1241,9 @@ void idImage::WritePrecompressedImage() {
 		common->Warning( "Could not open %s trying to write precompressed image", filename );
 		return;
 	}
-	common->Printf( "Writing precompressed image: %s\n", filename );
+	if ( verbose ) {
+		common->Printf( "Writing precompressed image: %s\n", filename );
+	}
 
 	f->Write( "DDS ", 4 );
 	f->Write( &header, sizeof(header) );
@@ -1274,6 +1298,158 @@ void idImage::WritePrecompressedImage() {
 	fileSystem->CloseFile( f );
 }
 
+/*
+================
+UsesTextureCache
+
+The processed tga and jpg images are kept compressed in TEXTURE_CACHE_DIR,
+which ends up in fs_savepath. Only plain image files are cached, image
+programs would need the content of all their files for the key.
+================
+*/
+bool idImage::UsesTextureCache() const {
+	if ( !globalImages->image_useTextureCache.GetBool() || !glConfig.isInitialized || !glConfig.textureCompressionAvailable ) {
+		return false;
+	}
+	if ( generatorFunction || isPartialImage || cubeFiles != CF_2D ) {
+		return false;
+	}
+	// the debug colors must not end up in the cache
+	if ( globalImages->image_colorMipLevels.GetBool() ) {
+		return false;
+	}
+	idStr fileName;
+	return R_ImageProgramIsFile( imgName, fileName );
+}
+
+/*
+================
+TextureCacheChecksum
+
+Keys the cached image by the content of the source file and everything the
+processing depends on, so changing a file or the image cvars misses the cache.
+Doesn't touch any engine state, so it can run on the worker threads.
+================
+*/
+unsigned int idImage::TextureCacheChecksum( const byte *data, int len ) const {
+	int key[16];
+
+	key[0] = MD4_BlockChecksum( data, len );
+	key[1] = len;
+	key[2] = filter;
+	key[3] = depth;
+	key[4] = allowDownSize;
+	key[5] = globalImages->image_useCompression.GetInteger();
+	key[6] = globalImages->image_useNormalCompression.GetInteger();
+	key[7] = globalImages->image_useAllFormats.GetInteger();
+	key[8] = globalImages->image_roundDown.GetInteger();
+	key[9] = globalImages->image_mipmapMode.GetInteger();
+	key[10] = globalImages->image_forceDownSize.GetInteger() | ( globalImages->image_downSize.GetInteger() << 1 );
+	key[11] = globalImages->image_downSizeLimit.GetInteger();
+	key[12] = globalImages->image_downSizeSpecular.GetInteger() | ( globalImages->image_downSizeBump.GetInteger() << 1 );
+	key[13] = globalImages->image_downSizeSpecularLimit.GetInteger();
+	key[14] = globalImages->image_downSizeBumpLimit.GetInteger();
+	key[15] = glConfig.maxTextureSize;
+
+	return MD4_BlockChecksum( key, sizeof( key ) );
+}
+
+/*
+================
+TextureCacheFileName
+================
+*/
+void idImage::TextureCacheFileName( unsigned int checksum, idStr &cacheName ) const {
+	char filename[MAX_IMAGE_NAME];
+	ImageProgramStringToCompressedFileName( imgName, filename );
+
+	// replace the dds/ directory and keep the name readable
+	idStr name = filename + 4;
+	name.StripFileExtension();
+	sprintf( cacheName, "%s/%s_%08x.dds", TEXTURE_CACHE_DIR, name.c_str(), checksum );
+}
+
+/*
+================
+LoadCachedImage
+
+Uploads the image from the texture cache, returns false if it isn't there
+================
+*/
+bool idImage::LoadCachedImage( const char *cacheName ) {
+	byte *data;
+	ID_TIME_T cacheTimestamp;
+
+	const int len = fileSystem->ReadFile( cacheName, (void **)&data, &cacheTimestamp );
+	if ( len < 0 ) {
+		return false;
+	}
+	if ( len < (int)( sizeof( ddsFileHeader_t ) + 4 ) || LittleLong( *(unsigned long *)data ) != DDS_MAKEFOURCC( 'D', 'D', 'S', ' ' ) ) {
+		common->Warning( "Bad texture cache file %s", cacheName );
+		fileSystem->FreeFile( data );
+		return false;
+	}
+
+	UploadPrecompressedImage( data, len );
+	fileSystem->FreeFile( data );
+
+	return true;
+}
+
+/*
+================
+WriteCachedImage
+
+Called after uploading a processed image, only compressed images are worth caching
+================
+*/
+void idImage::WriteCachedImage( const char *cacheName ) {
+	if ( type != TT_2D || !FormatIsDXT( internalFormat ) ) {
+		return;
+	}
+	WriteDDS( cacheName, false, false );
+}
+
+/*
+================
+CheckCachedImage
+
+Reads the source file of the image to look it up in the texture cache. Returns
+true if the cached image was uploaded, otherwise cacheName is set to the file
+the processed image should be written to, or emptied if it isn't cached.
+================
+*/
+bool idImage::CheckCachedImage( idStr &cacheName ) {
+	cacheName.Empty();
+
+	if ( !UsesTextureCache() ) {
+		return false;
+	}
+
+	// like R_LoadImage
+	idStr fileName;
+	R_ImageProgramIsFile( imgName, fileName );
+	fileName.DefaultFileExtension( ".tga" );
+
+	byte *data;
+	int len = fileSystem->ReadFile( fileName, (void **)&data, &timestamp );
+	if ( len < 0 && fileName.Length() > 4 && fileName.Right( 4 ).Icmp( ".tga" ) == 0 ) {
+		fileName.StripFileExtension();
+		fileName.DefaultFileExtension( ".jpg" );
+		len = fileSystem->ReadFile( fileName, (void **)&data, &timestamp );
+	}
+	if ( len < 0 ) {
+		return false;
+	}
+
+	const unsigned int checksum = TextureCacheChecksum( data, len );
+	fileSystem->FreeFile( data );
+
+	TextureCacheFileName( checksum, cacheName );
+
+	return LoadCachedImage( cacheName );
+}
+
 /*
 ================
 ShouldImageBePartialCached
@@ -1534,6 +1710,30 @@ void idImage::UploadPrecompressedImage( byte *data, int len ) {
 	int skipMip = 0;
 	GetDownsize( uploadWidth, uploadHeight );
 
+	// large mip mapped images only get their small mip levels at first,
+	// the larger ones are streamed in when the views need them
+	if ( !streamed && !isPartialImage && globalImages->image_streaming.GetBool()
+		&& allowDownSize && filter == TF_DEFAULT && numMipmaps > 1 ) {
+		const int minSize = Max( globalImages->image_streamingMinSize.GetInteger(), 1 );
+		if ( uploadWidth > minSize || uploadHeight > minSize ) {
+			streamed = true;
+			streamLoadSize = minSize;
+			globalImages->streamedImages.Append( this );
+		}
+	}
+	if ( streamed ) {
+		streamFullSize = Max( uploadWidth, uploadHeight );
+
+		// never skip past the smallest mip level in the file
+		const int smallest = Max( (int)header->dwWidth, (int)header->dwHeight ) >> ( numMipmaps - 1 );
+		const int limit = Max( streamLoadSize, smallest );
+		while ( uploadWidth > limit || uploadHeight > limit ) {
+			uploadWidth = Max( uploadWidth >> 1, 1 );
+			uploadHeight = Max( uploadHeight >> 1, 1 );
+		}
+		streamSize = Max( uploadWidth, uploadHeight );
+	}
+
 	byte *imagedata = data + sizeof(ddsFileHeader_t) + 4;
 
 	for ( int i = 0 ; i < numMipmaps; i++ ) {
@@ -1581,6 +1781,15 @@ void	idImage::ActuallyLoadImage( bool checkForPrecompressed, bool fromBackEnd )
 	int		width, height;
 	byte	*pic;
 
+	// back end loads may run in the smp render thread
+	idLoadProfileScope profile( "image", fromBackEnd ? NULL : imgName.c_str() );
+	idScopedMemTag memTag( MEMTAG_IMAGES );
+
+	// front end loads go through the texture binding state the back end tracks
+	if ( !fromBackEnd ) {
+		R_SyncRenderThread();
+	}
+
 	// this is the ONLY place generatorFunction will ever be called
 	if ( generatorFunction ) {
 		generatorFunction( this );
@@ -1633,6 +1842,12 @@ void	idImage::ActuallyLoadImage( bool checkForPrecompressed, bool fromBackEnd )
 			// fall through to load the normal image
 		}
 
+		// the processed image may be in the texture cache from an earlier load
+		idStr cacheName;
+		if ( checkForPrecompressed && CheckCachedImage( cacheName ) ) {
+			return;
+		}
+
 		R_LoadImageProgram( imgName, &pic, &width, &height, &timestamp, &depth );
 
 		if ( pic == NULL ) {
@@ -1659,14 +1874,29 @@ void	idImage::ActuallyLoadImage( bool checkForPrecompressed, bool fromBackEnd )
 		if (globalImages->image_blockChecksum.GetBool()) // duzenko #4400
 			imageHash = MD4_BlockChecksum( pic, width * height * 4 );
 
-		GenerateImage( pic, width, height, filter, allowDownSize, repeat, depth );
-		timestamp = timestamp;
-		precompressedFile = false;
+		FinishLoadImage( pic, width, height, cacheName.Length() ? cacheName.c_str() : NULL );
+	}
+}
+
+/*
+===============
+FinishLoadImage
+
+Uploads a loaded 2D image and frees pic, the image hash must already be set.
+A cacheName writes the processed image to the texture cache.
+===============
+*/
+void idImage::FinishLoadImage( byte *pic, int width, int height, const char *cacheName ) {
+	GenerateImage( pic, width, height, filter, allowDownSize, repeat, depth );
+	precompressedFile = false;
+
+	R_StaticFree( pic );
 
-		R_StaticFree( pic );
+	// write out the precompressed version of this file if needed
+	WritePrecompressedImage();
 
-		// write out the precompressed version of this file if needed
-		WritePrecompressedImage();
+	if ( cacheName ) {
+		WriteCachedImage( cacheName );
 	}
 }
 
@@ -1773,16 +2003,19 @@ void idImage::Bind() {
 	if ( type == TT_2D ) {
 		if ( tmu->current2DMap != texnum ) {
 			tmu->current2DMap = texnum;
+			backEnd.pc.c_textureBinds++;
 			qglBindTexture( GL_TEXTURE_2D, texnum );
 		}
 	} else if ( type == TT_CUBIC ) {
 		if ( tmu->currentCubeMap != texnum ) {
 			tmu->currentCubeMap = texnum;
+			backEnd.pc.c_textureBinds++;
 			qglBindTexture( GL_TEXTURE_CUBE_MAP_EXT, texnum );
 		}
 	} else if ( type == TT_3D ) {
 		if ( tmu->current3DMap != texnum ) {
 			tmu->current3DMap = texnum;
+			backEnd.pc.c_textureBinds++;
 			qglBindTexture( GL_TEXTURE_3D, texnum );
 		}
 	}
@@ -43,7 +43,6 @@ byte *R_ResampleTexture( const byte *in, int inwidth, int inheight,
 	const byte	*inrow, *inrow2;
 	unsigned int	frac, fracstep;
 	unsigned int	p1[MAX_DIMENSION], p2[MAX_DIMENSION];
-	const byte		*pix1, *pix2, *pix3, *pix4;
 	byte		*out, *out_p;
 
 	if ( outwidth > MAX_DIMENSION ) {
@@ -72,17 +71,7 @@ byte *R_ResampleTexture( const byte *in, int inwidth, int inheight,
 	for (i=0 ; i<outheight ; i++, out_p += outwidth*4 ) {
 		inrow = in + 4 * inwidth * (int)( ( i + 0.25f ) * inheight / outheight );
 		inrow2 = in + 4 * inwidth * (int)( ( i + 0.75f ) * inheight / outheight );
-		frac = fracstep >> 1;
-		for (j=0 ; j<outwidth ; j++) {
-			pix1 = inrow + p1[j];
-			pix2 = inrow + p2[j];
-			pix3 = inrow2 + p1[j];
-			pix4 = inrow2 + p2[j];
-			out_p[j*4+0] = (pix1[0] + pix2[0] + pix3[0] + pix4[0])>>2;
-			out_p[j*4+1] = (pix1[1] + pix2[1] + pix3[1] + pix4[1])>>2;
-			out_p[j*4+2] = (pix1[2] + pix2[2] + pix3[2] + pix4[2])>>2;
-			out_p[j*4+3] = (pix1[3] + pix2[3] + pix3[3] + pix4[3])>>2;
-		}
+		SIMDProcessor->ResampleRGBARow( out_p, inrow, inrow2, p1, p2, outwidth );
 	}
 
 	return out;
@@ -98,27 +87,22 @@ Normal maps and such should not be bilerped.
 */
 byte *R_Dropsample( const byte *in, int inwidth, int inheight,  
 							int outwidth, int outheight ) {
-	int		i, j, k;
-	const byte	*inrow;
-	const byte	*pix1;
-	byte		*out, *out_p;
+	int		i, j;
+	const int	*inrow;
+	int		*out, *out_p;
 
-	out = (byte *)R_StaticAlloc( outwidth * outheight * 4 );
+	// copy whole texels
+	out = (int *)R_StaticAlloc( outwidth * outheight * 4 );
 	out_p = out;
 
-	for (i=0 ; i<outheight ; i++, out_p += outwidth*4 ) {
-		inrow = in + 4*inwidth*(int)((i+0.25)*inheight/outheight);
+	for (i=0 ; i<outheight ; i++, out_p += outwidth ) {
+		inrow = (const int *)in + inwidth*(int)((i+0.25)*inheight/outheight);
 		for (j=0 ; j<outwidth ; j++) {
-			k = j * inwidth / outwidth;
-			pix1 = inrow + k * 4;
-			out_p[j*4+0] = pix1[0];
-			out_p[j*4+1] = pix1[1];
-			out_p[j*4+2] = pix1[2];
-			out_p[j*4+3] = pix1[3];
+			out_p[j] = inrow[j * inwidth / outwidth];
 		}
 	}
 
-	return out;
+	return (byte *)out;
 }
 
 
@@ -387,10 +371,9 @@ smeared clamps...
 ================
 */
 byte *R_MipMap( const byte *in, int width, int height, bool preserveBorder ) {
-	int		i, j;
+	int		i;
 	const byte	*in_p;
 	byte	*out, *out_p;
-	int		row;
 	byte	border[4];
 	int		newWidth, newHeight;
 
@@ -403,8 +386,6 @@ byte *R_MipMap( const byte *in, int width, int height, bool preserveBorder ) {
 	border[2] = in[2];
 	border[3] = in[3];
 
-	row = width * 4;
-
 	newWidth = width >> 1;
 	newHeight = height >> 1;
 	if ( !newWidth ) {
@@ -441,14 +422,7 @@ byte *R_MipMap( const byte *in, int width, int height, bool preserveBorder ) {
 		return out;
 	}
 
-	for (i=0 ; i<height ; i++, in_p+=row) {
-		for (j=0 ; j<width ; j++, out_p+=4, in_p+=8) {
-			out_p[0] = (in_p[0] + in_p[4] + in_p[row+0] + in_p[row+4])>>2;
-			out_p[1] = (in_p[1] + in_p[5] + in_p[row+1] + in_p[row+5])>>2;
-			out_p[2] = (in_p[2] + in_p[6] + in_p[row+2] + in_p[row+6])>>2;
-			out_p[3] = (in_p[3] + in_p[7] + in_p[row+3] + in_p[row+7])>>2;
-		}
-	}
+	SIMDProcessor->MipMapRGBA( out, in, width << 1, height << 1 );
 
 	// copy the old border texel back around if desired
 	if ( preserveBorder ) {
@@ -458,6 +432,26 @@ byte *R_MipMap( const byte *in, int width, int height, bool preserveBorder ) {
 	return out;
 }
 
+/*
+================
+R_MipMapNormalMap
+
+Like R_MipMap, but renormalizes the averaged normals, the alpha is averaged
+================
+*/
+byte *R_MipMapNormalMap( const byte *in, int width, int height ) {
+	byte	*out;
+
+	if ( width < 2 || height < 2 ) {
+		return R_MipMap( in, width, height, false );
+	}
+
+	out = (byte *)R_StaticAlloc( ( width >> 1 ) * ( height >> 1 ) * 4 );
+	SIMDProcessor->MipMapNormalRGBA( out, in, width, height );
+
+	return out;
+}
+
 /*
 ================
 R_MipMap3D
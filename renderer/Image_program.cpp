@@ -635,3 +635,27 @@ const char *R_ParsePastImageProgram( idLexer &src ) {
 	return parseBuffer;
 }
 
+
+/*
+===================
+R_ImageProgramIsFile
+
+If the image program is a single image file without any modifiers, returns
+true with the file name, so the file can be loaded without the parser.
+===================
+*/
+bool R_ImageProgramIsFile( const char *name, idStr &fileName ) {
+	idLexer src;
+	idToken	token;
+
+	src.LoadMemory( name, strlen(name), name );
+	src.SetFlags( LEXFL_NOFATALERRORS | LEXFL_NOSTRINGCONCAT | LEXFL_NOSTRINGESCAPECHARS | LEXFL_ALLOWPATHNAMES );
+
+	if ( !src.ReadToken( &token ) ) {
+		return false;
+	}
+	fileName = token;
+
+	// anything following the name makes it a program, a modifier takes a "("
+	return !src.ReadToken( &token );
+}
@@ -536,10 +536,177 @@ idInteraction::idInteraction( void ) {
 	entityNext				= NULL;
 	entityPrev				= NULL;
 	dynamicModelFrameCount	= 0;
+	shadowMapped			= false;
 	frustumState			= FRUSTUM_UNINITIALIZED;
 	frustumAreas			= NULL;
 }
 
+/*
+===========================================================================
+
+idInteractionTable
+
+===========================================================================
+*/
+
+/*
+===============
+idInteractionTable::idInteractionTable
+===============
+*/
+idInteractionTable::idInteractionTable( void ) {
+	entries = NULL;
+	size = 0;
+	num = 0;
+}
+
+/*
+===============
+idInteractionTable::~idInteractionTable
+===============
+*/
+idInteractionTable::~idInteractionTable( void ) {
+	Clear();
+}
+
+/*
+===============
+idInteractionTable::Clear
+===============
+*/
+void idInteractionTable::Clear( void ) {
+	if ( entries ) {
+		R_StaticFree( entries );
+	}
+	entries = NULL;
+	size = 0;
+	num = 0;
+}
+
+/*
+===============
+idInteractionTable::Slot
+===============
+*/
+ID_INLINE int idInteractionTable::Slot( int lightNum, int entityNum ) const {
+	unsigned int hash = (unsigned int)lightNum * 0x9e3779b1u ^ (unsigned int)entityNum * 0x85ebca6bu;
+	hash ^= hash >> 16;
+	return hash & ( size - 1 );
+}
+
+/*
+===============
+idInteractionTable::Resize
+===============
+*/
+void idInteractionTable::Resize( int newSize ) {
+	entry_t *oldEntries = entries;
+	const int oldSize = size;
+
+	entries = (entry_t *)R_ClearedStaticAlloc( newSize * sizeof( entry_t ) );
+	size = newSize;
+
+	for ( int i = 0 ; i < oldSize ; i++ ) {
+		if ( !oldEntries[i].interaction ) {
+			continue;
+		}
+		int slot = Slot( oldEntries[i].lightNum, oldEntries[i].entityNum );
+		while ( entries[slot].interaction ) {
+			slot = ( slot + 1 ) & ( size - 1 );
+		}
+		entries[slot] = oldEntries[i];
+	}
+
+	if ( oldEntries ) {
+		R_StaticFree( oldEntries );
+	}
+}
+
+/*
+===============
+idInteractionTable::Find
+===============
+*/
+idInteraction *idInteractionTable::Find( int lightNum, int entityNum ) const {
+	if ( !num ) {
+		return NULL;
+	}
+	for ( int slot = Slot( lightNum, entityNum ) ; entries[slot].interaction ; slot = ( slot + 1 ) & ( size - 1 ) ) {
+		if ( entries[slot].lightNum == lightNum && entries[slot].entityNum == entityNum ) {
+			return entries[slot].interaction;
+		}
+	}
+	return NULL;
+}
+
+/*
+===============
+idInteractionTable::Add
+===============
+*/
+void idInteractionTable::Add( idInteraction *interaction ) {
+	if ( ( num + 1 ) * 2 > size ) {
+		Resize( size ? size * 2 : 1024 );
+	}
+
+	const int lightNum = interaction->lightDef->index;
+	const int entityNum = interaction->entityDef->index;
+
+	int slot = Slot( lightNum, entityNum );
+	while ( entries[slot].interaction ) {
+		if ( entries[slot].lightNum == lightNum && entries[slot].entityNum == entityNum ) {
+			common->Error( "idInteractionTable::Add: pair already in the table" );
+		}
+		slot = ( slot + 1 ) & ( size - 1 );
+	}
+
+	entries[slot].lightNum = lightNum;
+	entries[slot].entityNum = entityNum;
+	entries[slot].interaction = interaction;
+	num++;
+}
+
+/*
+===============
+idInteractionTable::Remove
+
+Shifts the following entries of the probe run back, so no tombstones are needed
+===============
+*/
+void idInteractionTable::Remove( idInteraction *interaction ) {
+	const int lightNum = interaction->lightDef->index;
+	const int entityNum = interaction->entityDef->index;
+	const int mask = size - 1;
+
+	int slot = num ? Slot( lightNum, entityNum ) : 0;
+	while ( true ) {
+		if ( !num || !entries[slot].interaction ) {
+			common->Error( "idInteractionTable::Remove: interaction isn't in the table" );
+		}
+		if ( entries[slot].lightNum == lightNum && entries[slot].entityNum == entityNum ) {
+			break;
+		}
+		slot = ( slot + 1 ) & mask;
+	}
+	if ( entries[slot].interaction != interaction ) {
+		common->Error( "idInteractionTable::Remove: table holds a different interaction" );
+	}
+
+	entries[slot].interaction = NULL;
+	num--;
+
+	for ( int next = ( slot + 1 ) & mask ; entries[next].interaction ; next = ( next + 1 ) & mask ) {
+		// the entry can stay if its home slot is cyclically in ( slot, next ]
+		const int home = Slot( entries[next].lightNum, entries[next].entityNum );
+		if ( slot <= next ? ( slot < home && home <= next ) : ( slot < home || home <= next ) ) {
+			continue;
+		}
+		entries[slot] = entries[next];
+		entries[next].interaction = NULL;
+		slot = next;
+	}
+}
+
 /*
 ===============
 idInteraction::AllocAndLink
@@ -556,6 +723,7 @@ idInteraction *idInteraction::AllocAndLink( idRenderEntityLocal *edef, idRenderL
 
 	// link and initialize
 	interaction->dynamicModelFrameCount = 0;
+	interaction->shadowMapped = false;
 
 	interaction->lightDef = ldef;
 	interaction->entityDef = edef;
@@ -587,13 +755,7 @@ idInteraction *idInteraction::AllocAndLink( idRenderEntityLocal *edef, idRenderL
 	}
 
 	// update the interaction table
-	if ( renderWorld->interactionTable ) {
-		int index = ldef->index * renderWorld->interactionTableWidth + edef->index;
-		if ( renderWorld->interactionTable[index] != NULL ) {
-			common->Error( "idInteraction::AllocAndLink: non NULL table entry" );
-		}
-		renderWorld->interactionTable[ index ] = interaction;
-	}
+	renderWorld->interactionTable.Add( interaction );
 
 	return interaction;
 }
@@ -677,15 +839,9 @@ Removes links and puts it back on the free list.
 */
 void idInteraction::UnlinkAndFree( void ) {
 
-	// clear the table pointer
+	// clear the table entry
 	idRenderWorldLocal *renderWorld = this->lightDef->world;
-	if ( renderWorld->interactionTable ) {
-		int index = this->lightDef->index * renderWorld->interactionTableWidth + this->entityDef->index;
-		if ( renderWorld->interactionTable[index] != this ) {
-			common->Error( "idInteraction::UnlinkAndFree: interactionTable wasn't set" );
-		}
-		renderWorld->interactionTable[index] = NULL;
-	}
+	renderWorld->interactionTable.Remove( this );
 
 	Unlink();
 
@@ -901,6 +1057,23 @@ ID_INLINE bool R_CullModelBoundsToLight(const idRenderLightLocal * light, const
 	return idRenderMatrix::CullBoundsToMVP(modelLightProject, localBounds, true);
 }
 
+/*
+====================
+R_InteractionShadowGen
+
+really large models, like outside terrain meshes, should use
+the more exactly culled static shadow path instead of the turbo shadow path.
+FIXME: this is a HACK, we should probably have a material flag.
+====================
+*/
+static shadowGen_t R_InteractionShadowGen( const idBounds &bounds ) {
+	if ( bounds[1][0] - bounds[0][0] > 3000 ) {
+		return SG_STATIC;
+	}
+	// use the turbo shadow path
+	return SG_DYNAMIC;
+}
+
 /*
 ====================
 idInteraction::CreateInteraction
@@ -913,9 +1086,13 @@ References tr.viewCount so lighting surfaces will only be created if the ambient
 otherwise it will be marked as deferred.
 
 The results of this are cached and valid until the light or entity change.
+
+Returns false if the interaction should be made empty. MakeEmpty() relinks the
+entity and light interaction lists, so it is left to the caller to keep this
+safe to run on several threads.
 ====================
 */
-void idInteraction::CreateInteraction( const idRenderModel *model ) {
+bool idInteraction::CreateInteraction( const idRenderModel *model ) {
 	const idMaterial *	lightShader = lightDef->lightShader;
 	const idMaterial*	shader;
 	bool				interactionGenerated;
@@ -928,27 +1105,20 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 	if (r_useAnonreclaimer.GetBool()) {
 		// if it doesn't contact the light frustum, none of the surfaces will
 		if (R_CullModelBoundsToLight(lightDef, bounds, entityDef->modelRenderMatrix)) {
-			MakeEmpty();
-			return;
+			return false;
 		}
 	}
 	else {
 		// if it doesn't contact the light frustum, none of the surfaces will
 		if (R_CullLocalBox(bounds, entityDef->modelMatrix, 6, lightDef->frustum)) {
-			MakeEmpty();
-			return;
+			return false;
 		}
 	}
 
-	// use the turbo shadow path
-	shadowGen_t shadowGen = SG_DYNAMIC;
+	const shadowGen_t shadowGen = R_InteractionShadowGen( bounds );
 
-	// really large models, like outside terrain meshes, should use
-	// the more exactly culled static shadow path instead of the turbo shadow path.
-	// FIXME: this is a HACK, we should probably have a material flag.
-	if ( bounds[1][0] - bounds[0][0] > 3000 ) {
-		shadowGen = SG_STATIC;
-	}
+	// shadow mapped lights don't need any shadow volumes
+	shadowMapped = lightDef->viewLight->shadowMap;
 
 	//
 	// create slots for each of the model's surfaces
@@ -958,6 +1128,18 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 
 	interactionGenerated = false;
 
+	// box test all surfaces against the light frustum at once
+	byte *surfaceCulled = NULL;
+	if ( !r_useAnonreclaimer.GetBool() ) {
+		const idBounds **surfaceBounds = (const idBounds **)_alloca( numSurfaces * sizeof( surfaceBounds[0] ) );
+		for ( int c = 0; c < numSurfaces; c++ ) {
+			const srfTriangles_t *tri = model->Surface( c )->geometry;
+			surfaceBounds[c] = tri ? &tri->bounds : NULL;
+		}
+		surfaceCulled = (byte *)_alloca( numSurfaces );
+		R_CullLocalBoxes( surfaceCulled, surfaceBounds, numSurfaces, entityDef->modelMatrix, 6, lightDef->frustum );
+	}
+
 	// check each surface in the model
 	for (int c = 0; c < model->NumSurfaces(); c++) {
 		const modelSurface_t	*surf;
@@ -986,7 +1168,7 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 		}
 		else {
 			// try to cull each surface
-			if (R_CullLocalBox(tri->bounds, entityDef->modelMatrix, 6, lightDef->frustum)) {
+			if (surfaceCulled[c]) {
 				continue;
 			}
 		}
@@ -1021,8 +1203,13 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 			interactionGenerated = true;
 		}
 
+		// the ambient surface itself is drawn into the shadow map
+		if ( shadowMapped ) {
+			if ( HasShadows() && shader->SurfaceCastsShadow() ) {
+				interactionGenerated = true;
+			}
 		// if the interaction has shadows and this surface casts a shadow
-		if ( HasShadows() && shader->SurfaceCastsShadow() && tri->silEdges != NULL ) {
+		} else if ( HasShadows() && shader->SurfaceCastsShadow() && tri->silEdges != NULL ) {
 
 			// if the light has an optimized shadow volume, don't create shadows for any models that are part of the base areas
 			if ( lightDef->parms.prelightModel == NULL || !model->IsStaticWorldModel() || !r_useOptimizedShadows.GetBool() ) {
@@ -1049,9 +1236,7 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 	}
 
 	// if none of the surfaces generated anything, don't even bother checking?
-	if ( !interactionGenerated ) {
-		MakeEmpty();
-	}
+	return interactionGenerated;
 }
 
 /*
@@ -1139,20 +1324,36 @@ instantiate the dynamic model to find out
 ==================
 */
 void idInteraction::AddActiveInteraction( void ) {
-	viewLight_t *	vLight;
-	viewEntity_t *	vEntity;
 	idScreenRect	shadowScissor;
-	idScreenRect	lightScissor;
-	idVec3			localLightOrigin;
-	idVec3			localViewOrigin;
 
-	vLight = lightDef->viewLight;
-	vEntity = entityDef->viewEntity;
-	
+	const idRenderModel *model = PrepareActiveInteraction( shadowScissor );
+	if ( model == NULL ) {
+		return;
+	}
+
+	// actually create the interaction if needed, building light and shadow surfaces as needed
+	if ( !CreateActiveSurfaces( model ) ) {
+		MakeEmpty();
+		return;
+	}
+
+	LinkActiveInteraction( shadowScissor );
+}
+
+/*
+==================
+idInteraction::PrepareActiveInteraction
+
+The serial part of AddActiveInteraction, it may instantiate the dynamic model
+==================
+*/
+idRenderModel *idInteraction::PrepareActiveInteraction( idScreenRect &shadowScissor ) {
+	const viewLight_t *		vLight = lightDef->viewLight;
+	const viewEntity_t *	vEntity = entityDef->viewEntity;
 
 	// nbohr1more: #4379 lightgem culling
 	if ((!HasShadows() ) && ( !entityDef->parms.islightgem ) && (tr.viewDef->renderView.viewID == RENDERTOOLS_SKIP_ID )) {
-		    return;
+		    return NULL;
 			} 
 	
 	// do not waste time culling the interaction frustum if there will be no shadows
@@ -1173,7 +1374,7 @@ void idInteraction::AddActiveInteraction( void ) {
 		// this will also cull the case where the light origin is inside the
 		// view frustum and the entity bounds are outside the view frustum
 		if ( CullInteractionByViewFrustum( tr.viewDef->viewFrustum ) ) {
-			return;
+			return NULL;
 		}
 
 		// calculate the shadow scissor rectangle
@@ -1182,7 +1383,7 @@ void idInteraction::AddActiveInteraction( void ) {
 
 	// get out before making the dynamic model if the shadow scissor rectangle is empty
 	if ( shadowScissor.IsEmpty() ) {
-		return;
+		return NULL;
 	}
 
 	// We will need the dynamic surface created to make interactions, even if the
@@ -1190,20 +1391,166 @@ void idInteraction::AddActiveInteraction( void ) {
 	// has been generated once in the view.
 	idRenderModel *model = R_EntityDefDynamicModel( entityDef );
 	if ( model == NULL || model->NumSurfaces() <= 0 ) {
-		return;
+		return NULL;
 	}
 
 	// the dynamic model may have changed since we built the surface list
 	if ( !IsDeferred() && entityDef->dynamicModelFrameCount != dynamicModelFrameCount ) {
 		FreeSurfaces();
 	}
+	// or the light may have switched between shadow volumes and a shadow map
+	if ( !IsDeferred() && shadowMapped != vLight->shadowMap ) {
+		FreeSurfaces();
+	}
 	dynamicModelFrameCount = entityDef->dynamicModelFrameCount;
 
-	// actually create the interaction if needed, building light and shadow surfaces as needed
+	return model;
+}
+
+/*
+==================
+idInteraction::PrepareParallelSurfaces
+
+R_CalcInteractionFacing derives the face planes of the ambient surfaces on
+first use, but those surfaces are shared by every light touching the entity
+(and by every entity using a static model), so do it before the threads start
+==================
+*/
+bool idInteraction::PrepareParallelSurfaces( const idRenderModel *model ) {
+	if ( IsDeferred() ) {
+		// the static shadow path works out of global buffers
+		if ( HasShadows() && ( !r_useTurboShadow.GetBool() || R_InteractionShadowGen( model->Bounds( &entityDef->parms ) ) != SG_DYNAMIC ) ) {
+			return false;
+		}
+	} else {
+		// only deferred light triangles are left to create
+		int i;
+		for ( i = 0; i < numSurfaces; i++ ) {
+			if ( surfaces[i].lightTris == LIGHT_TRIS_DEFERRED ) {
+				break;
+			}
+		}
+		if ( i == numSurfaces ) {
+			return true;
+		}
+	}
+
+	if ( !r_useAnonreclaimer.GetBool() ) {
+		for ( int i = 0; i < model->NumSurfaces(); i++ ) {
+			srfTriangles_t *tri = model->Surface( i )->geometry;
+			if ( tri && tri->numIndexes > 0 && ( !tri->facePlanes || !tri->facePlanesCalculated ) ) {
+				R_DeriveFacePlanes( tri );
+			}
+		}
+	}
+
+	return true;
+}
+
+/*
+==================
+idInteraction::CreateActiveSurfaces
+
+Only touches this interaction and the allocators, which R_LockStaticAlloc
+serializes, so it can run for many interactions at once
+==================
+*/
+bool idInteraction::CreateActiveSurfaces( const idRenderModel *model ) {
+	const viewLight_t *		vLight = lightDef->viewLight;
+	const viewEntity_t *	vEntity = entityDef->viewEntity;
+
 	if ( IsDeferred() ) {
-		CreateInteraction( model );
+		if ( !CreateInteraction( model ) ) {
+			return false;
+		}
+	}
+
+	// the light triangles are only needed if the base surface is visible
+	idScreenRect lightScissor = vLight->scissorRect;
+	lightScissor.Intersect( vEntity->scissorRect );
+	if ( lightScissor.IsEmpty() ) {
+		return true;
+	}
+
+	for ( int i = 0; i < numSurfaces; i++ ) {
+		surfaceInteraction_t *sint = &surfaces[i];
+
+		// make sure we have created this interaction, which may have been deferred
+		// on a previous use that only needed the shadow
+		if ( sint->lightTris == LIGHT_TRIS_DEFERRED && sint->ambientTris && sint->ambientTris->ambientViewCount == tr.viewCount ) {
+			sint->lightTris = R_CreateLightTris( vEntity->entityDef, sint->ambientTris, vLight->lightDef, sint->shader, sint->cullInfo );
+			R_FreeInteractionCullInfo( sint->cullInfo );
+		}
+	}
+
+	return true;
+}
+
+/*
+==================
+idInteraction::LinkShadowMapCaster
+
+Shadow mapped lights don't have any shadowTris, the casting surface is drawn
+into the map as it is, so this only needs the ambient cache
+==================
+*/
+void idInteraction::LinkShadowMapCaster( surfaceInteraction_t *sint, const idScreenRect &shadowScissor ) {
+	srfTriangles_t *tri = sint->ambientTris;
+
+	if ( !tri || !sint->shader || !sint->shader->SurfaceCastsShadow() ) {
+		return;
+	}
+
+	// "invisible ink" lights and shaders
+	if ( sint->shader->Spectrum() != lightDef->lightShader->Spectrum() ) {
+		return;
 	}
 
+	// check for view specific shadow suppression (player shadows, etc)
+	if ( !r_skipSuppress.GetBool() ) {
+		if ( entityDef->parms.suppressShadowInViewID &&
+			entityDef->parms.suppressShadowInViewID == tr.viewDef->renderView.viewID ) {
+			return;
+		}
+		if ( entityDef->parms.suppressShadowInLightID &&
+			entityDef->parms.suppressShadowInLightID == lightDef->parms.lightId ) {
+			return;
+		}
+	}
+
+	if ( !tri->ambientCache ) {
+		if ( !R_CreateAmbientCache( tri, sint->shader->ReceivesLighting() ) ) {
+			// skip if we were out of vertex memory
+			return;
+		}
+	}
+	vertexCache.Touch( tri->ambientCache );
+
+	if ( !tri->indexCache && r_useIndexBuffers.GetBool() ) {
+		vertexCache.Alloc( tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ), &tri->indexCache, true );
+	}
+	if ( tri->indexCache ) {
+		vertexCache.Touch( tri->indexCache );
+	}
+
+	R_LinkLightSurf( &lightDef->viewLight->shadowMapCasters, tri, entityDef->viewEntity, lightDef, NULL, shadowScissor, false );
+}
+
+/*
+==================
+idInteraction::LinkActiveInteraction
+==================
+*/
+void idInteraction::LinkActiveInteraction( const idScreenRect &shadowScissor ) {
+	viewLight_t *	vLight;
+	viewEntity_t *	vEntity;
+	idScreenRect	lightScissor;
+	idVec3			localLightOrigin;
+	idVec3			localViewOrigin;
+
+	vLight = lightDef->viewLight;
+	vEntity = entityDef->viewEntity;
+
 	R_GlobalPointToLocal( vEntity->modelMatrix, lightDef->globalLightOrigin, localLightOrigin );
 	R_GlobalPointToLocal( vEntity->modelMatrix, tr.viewDef->renderView.vieworg, localViewOrigin );
 
@@ -1214,6 +1561,27 @@ void idInteraction::AddActiveInteraction( void ) {
 
 	bool lightScissorsEmpty = lightScissor.IsEmpty();
 
+	if ( numSurfaces <= 0 ) {
+		return;
+	}
+
+	// box test the visible light surfaces and the bounded shadows against the view frustum
+	// all at once, the light surfaces first
+	const idBounds **cullBounds = (const idBounds **)_alloca( numSurfaces * 2 * sizeof( cullBounds[0] ) );
+	byte *culled = (byte *)_alloca( numSurfaces * 2 );
+	for ( int i = 0; i < numSurfaces; i++ ) {
+		const surfaceInteraction_t *sint = &surfaces[i];
+		cullBounds[i] = NULL;
+		cullBounds[numSurfaces + i] = NULL;
+		if ( !lightScissorsEmpty && sint->ambientTris && sint->ambientTris->ambientViewCount == tr.viewCount && sint->lightTris ) {
+			cullBounds[i] = &sint->lightTris->bounds;
+		}
+		if ( !shadowMapped && sint->shadowTris && r_useShadowCulling.GetBool() && !sint->shadowTris->bounds.IsCleared() ) {
+			cullBounds[numSurfaces + i] = &sint->shadowTris->bounds;
+		}
+	}
+	R_CullLocalBoxes( culled, cullBounds, numSurfaces * 2, vEntity->modelMatrix, 5, tr.viewDef->frustum );
+
 	// for each surface of this entity / light interaction
 	for ( int i = 0; i < numSurfaces; i++ ) {
 		surfaceInteraction_t *sint = &surfaces[i];
@@ -1221,13 +1589,7 @@ void idInteraction::AddActiveInteraction( void ) {
 		// see if the base surface is visible, we may still need to add shadows even if empty
 		if ( !lightScissorsEmpty && sint->ambientTris && sint->ambientTris->ambientViewCount == tr.viewCount ) {
 
-			// make sure we have created this interaction, which may have been deferred
-			// on a previous use that only needed the shadow
-			if ( sint->lightTris == LIGHT_TRIS_DEFERRED ) {
-				sint->lightTris = R_CreateLightTris( vEntity->entityDef, sint->ambientTris, vLight->lightDef, sint->shader, sint->cullInfo );
-				R_FreeInteractionCullInfo( sint->cullInfo );
-			}
-
+			// CreateActiveSurfaces() has created any deferred light triangles by now
 			srfTriangles_t *lightTris = sint->lightTris;
 
 			if ( lightTris ) {
@@ -1235,7 +1597,7 @@ void idInteraction::AddActiveInteraction( void ) {
 				// try to cull before adding
 				// FIXME: this may not be worthwhile. We have already done culling on the ambient,
 				// but individual surfaces may still be cropped somewhat more
-				if ( !R_CullLocalBox( lightTris->bounds, vEntity->modelMatrix, 5, tr.viewDef->frustum ) ) {
+				if ( !culled[i] ) {
 
 					// make sure the original surface has its ambient cache created
 					srfTriangles_t *tri = sint->ambientTris;
@@ -1293,6 +1655,13 @@ void idInteraction::AddActiveInteraction( void ) {
 			}
 		}
 
+		if ( shadowMapped ) {
+			if ( HasShadows() ) {
+				LinkShadowMapCaster( sint, shadowScissor );
+			}
+			continue;
+		}
+
 		srfTriangles_t *shadowTris = sint->shadowTris;
 
 		// the shadows will always have to be added, unless we can tell they
@@ -1314,10 +1683,8 @@ void idInteraction::AddActiveInteraction( void ) {
 			// cull static shadows that have a non-empty bounds
 			// dynamic shadows that use the turboshadow code will not have valid
 			// bounds, because the perspective projection extends them to infinity
-			if ( r_useShadowCulling.GetBool() && !shadowTris->bounds.IsCleared() ) {
-				if ( R_CullLocalBox( shadowTris->bounds, vEntity->modelMatrix, 5, tr.viewDef->frustum ) ) {
-					continue;
-				}
+			if ( culled[numSurfaces + i] ) {
+				continue;
 			}
 
 			// copy the shadow vertexes to the vertex cache if they have been purged
@@ -1428,4 +1795,9 @@ void R_ShowInteractionMemory_f( const idCmdArgs &args ) {
 	common->Printf( "%i deferred interactions, %i empty interactions\n", deferredInteractions, emptyInteractions );
 	common->Printf( "%5i indexes %5i verts in %5i light tris\n", lightTriIndexes, lightTriVerts, lightTris );
 	common->Printf( "%5i indexes %5i verts in %5i shadow tris\n", shadowTriIndexes, shadowTriVerts, shadowTris );
+
+	const idInteractionTable &table = tr.primaryWorld->interactionTable;
+	const double fullTable = (double)tr.primaryWorld->entityDefs.Num() * tr.primaryWorld->lightDefs.Num() * sizeof( idInteraction * );
+	common->Printf( "interaction table: %i entries in %ik, a full entityDefs * lightDefs table would take %ik\n",
+		table.Num(), table.Allocated() / 1024, (int)( fullTable / 1024 ) );
 }
@@ -137,6 +137,24 @@ public:
 	// calls R_LinkLightSurf() for each one
 	void					AddActiveInteraction( void );
 
+	// the stages of AddActiveInteraction(), so R_AddModelSurfaces can create the
+	// surfaces of many interactions in parallel (r_useParallelInteractions)
+
+	// culls the interaction and instantiates the dynamic model,
+	// returns NULL if there is nothing to add
+	idRenderModel *			PrepareActiveInteraction( idScreenRect &shadowScissor );
+
+	// derives the shared data the worker threads would otherwise create lazily,
+	// returns false if the surfaces can only be created on the main thread
+	bool					PrepareParallelSurfaces( const idRenderModel *model );
+
+	// creates any missing light and shadow surfaces, safe to run on several threads
+	// for different interactions, returns false if the interaction should be made empty
+	bool					CreateActiveSurfaces( const idRenderModel *model );
+
+	// adds the light and shadow surfaces to the vLight lists
+	void					LinkActiveInteraction( const idScreenRect &shadowScissor );
+
 private:
 	enum {
 		FRUSTUM_UNINITIALIZED,
@@ -149,9 +167,14 @@ private:
 
 	int						dynamicModelFrameCount;	// so we can tell if a callback model animated
 
+	bool					shadowMapped;			// created for a shadow mapped light, so there are no shadowTris
+
 private:
-	// actually create the interaction
-	void					CreateInteraction( const idRenderModel *model );
+	// actually create the interaction, returns false if the interaction should be made empty
+	bool					CreateInteraction( const idRenderModel *model );
+
+	// adds the ambient surface to the shadow map casters of the vLight
+	void					LinkShadowMapCaster( surfaceInteraction_t *sint, const idScreenRect &shadowScissor );
 
 	// unlink from entity and light lists
 	void					Unlink( void );
@@ -165,6 +188,50 @@ private:
 	idScreenRect			CalcInteractionScissorRectangle( const idFrustum &viewFrustum );
 };
 
+/*
+===============================================================================
+
+	All the interactions of a world by light / entity pair, so one can be
+	found without crawling the linked lists.  Only the pairs that have an
+	interaction take any space, kept in an open addressed hash with linear
+	probing that is never more than half full.
+
+===============================================================================
+*/
+
+class idInteractionTable {
+public:
+							idInteractionTable( void );
+							~idInteractionTable( void );
+
+	// frees all the memory, the interactions themselves are not touched
+	void					Clear( void );
+
+	idInteraction *			Find( int lightNum, int entityNum ) const;
+
+	// the pair must not be in the table yet
+	void					Add( idInteraction *interaction );
+
+	// the interaction must be in the table
+	void					Remove( idInteraction *interaction );
+
+	int						Num( void ) const { return num; }
+	int						Allocated( void ) const { return size * sizeof( entry_t ); }
+
+private:
+	typedef struct {
+		int					lightNum;
+		int					entityNum;
+		idInteraction *		interaction;		// NULL for an unused slot
+	} entry_t;
+
+	entry_t *				entries;
+	int						size;				// power of two
+	int						num;
+
+	int						Slot( int lightNum, int entityNum ) const;
+	void					Resize( int newSize );
+};
 
 void R_CalcInteractionFacing( const idRenderEntityLocal *ent, const srfTriangles_t *tri, const idRenderLightLocal *light, srfCullInfo_t &cullInfo );
 void R_CalcInteractionCullBits( const idRenderEntityLocal *ent, const srfTriangles_t *tri, const idRenderLightLocal *light, srfCullInfo_t &cullInfo );
@@ -82,6 +82,8 @@ void idMaterial::CommonInit() {
 	numRegisters = 0;
 	expressionRegisters = NULL;
 	constantRegisters = NULL;
+	registerDependencies = 0;
+	registerParmMask = 0;
 	numStages = 0;
 	numAmbientStages = 0;
 	stages = NULL;
@@ -96,6 +98,7 @@ void idMaterial::CommonInit() {
 	cubicLight = false;  //nbohr1more #3881: cubemap based lighting
 	noFog = false;
 	hasSubview = false;
+	usesCurrentDepth = false;
 	allowOverlays = true;
 	islightgemsurf = false; //nbohr1more: #4379 lightgem culling
 	unsmoothedTangents = false;
@@ -156,6 +159,7 @@ void idMaterial::FreeData() {
 				stages[i].texture.cinematic = NULL;
 			}
 			if ( stages[i].newStage != NULL ) {
+				delete stages[i].newStage->megaTexture;
 				Mem_Free( stages[i].newStage );
 				stages[i].newStage = NULL;
 			}
@@ -514,86 +518,119 @@ int idMaterial::ParseTerm( idLexer &src ) {
 
 	else if ( !token.Icmp( "time" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_TIME;
 		return EXP_REG_TIME;
 	}
 	else if ( !token.Icmp( "parm0" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_ENTITY_PARMS;
+		registerParmMask |= BIT( 0 );
 		return EXP_REG_PARM0;
 	}
 	else if ( !token.Icmp( "parm1" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_ENTITY_PARMS;
+		registerParmMask |= BIT( 1 );
 		return EXP_REG_PARM1;
 	}
 	else if ( !token.Icmp( "parm2" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_ENTITY_PARMS;
+		registerParmMask |= BIT( 2 );
 		return EXP_REG_PARM2;
 	}
 	else if ( !token.Icmp( "parm3" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_ENTITY_PARMS;
+		registerParmMask |= BIT( 3 );
 		return EXP_REG_PARM3;
 	}
 	else if ( !token.Icmp( "parm4" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_ENTITY_PARMS;
+		registerParmMask |= BIT( 4 );
 		return EXP_REG_PARM4;
 	}
 	else if ( !token.Icmp( "parm5" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_ENTITY_PARMS;
+		registerParmMask |= BIT( 5 );
 		return EXP_REG_PARM5;
 	}
 	else if ( !token.Icmp( "parm6" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_ENTITY_PARMS;
+		registerParmMask |= BIT( 6 );
 		return EXP_REG_PARM6;
 	}
 	else if ( !token.Icmp( "parm7" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_ENTITY_PARMS;
+		registerParmMask |= BIT( 7 );
 		return EXP_REG_PARM7;
 	}
 	else if ( !token.Icmp( "parm8" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_ENTITY_PARMS;
+		registerParmMask |= BIT( 8 );
 		return EXP_REG_PARM8;
 	}
 	else if ( !token.Icmp( "parm9" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_ENTITY_PARMS;
+		registerParmMask |= BIT( 9 );
 		return EXP_REG_PARM9;
 	}
 	else if ( !token.Icmp( "parm10" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_ENTITY_PARMS;
+		registerParmMask |= BIT( 10 );
 		return EXP_REG_PARM10;
 	}
 	else if ( !token.Icmp( "parm11" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_ENTITY_PARMS;
+		registerParmMask |= BIT( 11 );
 		return EXP_REG_PARM11;
 	}
 	else if ( !token.Icmp( "global0" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_GLOBAL_PARMS;
 		return EXP_REG_GLOBAL0;
 	}
 	else if ( !token.Icmp( "global1" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_GLOBAL_PARMS;
 		return EXP_REG_GLOBAL1;
 	}
 	else if ( !token.Icmp( "global2" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_GLOBAL_PARMS;
 		return EXP_REG_GLOBAL2;
 	}
 	else if ( !token.Icmp( "global3" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_GLOBAL_PARMS;
 		return EXP_REG_GLOBAL3;
 	}
 	else if ( !token.Icmp( "global4" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_GLOBAL_PARMS;
 		return EXP_REG_GLOBAL4;
 	}
 	else if ( !token.Icmp( "global5" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_GLOBAL_PARMS;
 		return EXP_REG_GLOBAL5;
 	}
 	else if ( !token.Icmp( "global6" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_GLOBAL_PARMS;
 		return EXP_REG_GLOBAL6;
 	}
 	else if ( !token.Icmp( "global7" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_GLOBAL_PARMS;
 		return EXP_REG_GLOBAL7;
 	}
 	else if ( !token.Icmp( "fragmentPrograms" ) ) {
@@ -602,6 +639,7 @@ int idMaterial::ParseTerm( idLexer &src ) {
 
 	else if ( !token.Icmp( "sound" ) ) {
 		pd->registersAreConstant = false;
+		registerDependencies |= REGDEP_SOUND;
 		return EmitOp( 0, 0, OP_TYPE_SOUND );
 	}
 
@@ -1438,6 +1476,8 @@ void idMaterial::ParseStage( idLexer &src, const textureRepeat_t trpDefault ) {
 			ss->color.registers[2] = EXP_REG_PARM2;
 			ss->color.registers[3] = EXP_REG_PARM3;
 			pd->registersAreConstant = false;
+			registerDependencies |= REGDEP_ENTITY_PARMS;
+			registerParmMask |= BIT( 0 ) | BIT( 1 ) | BIT( 2 ) | BIT( 3 );
 			continue;
 		}
 		else if ( !token.Icmp( "color" ) ) {
@@ -1505,6 +1545,7 @@ void idMaterial::ParseStage( idLexer &src, const textureRepeat_t trpDefault ) {
 				newStage.megaTexture = new idMegaTexture;
 				if ( !newStage.megaTexture->InitFromMegaFile( token.c_str() ) ) {
 					delete newStage.megaTexture;
+					newStage.megaTexture = NULL;
 					SetMaterialFlag( MF_DEFAULTED );
 					continue;
 				}
@@ -2187,6 +2228,21 @@ bool idMaterial::Parse( const char *text, const int textLength ) {
 		}
 	}
 
+	// see if the depth capture is needed for this material
+	usesCurrentDepth = false;
+	for ( i = 0 ; i < numStages && !usesCurrentDepth ; i++ ) {
+		const shaderStage_t *pStage = &pd->parseStages[i];
+		if ( pStage->texture.image == globalImages->currentDepthImage ) {
+			usesCurrentDepth = true;
+		} else if ( pStage->newStage ) {
+			for ( int j = 0 ; j < pStage->newStage->numFragmentProgramImages ; j++ ) {
+				if ( pStage->newStage->fragmentProgramImages[j] == globalImages->currentDepthImage ) {
+					usesCurrentDepth = true;
+				}
+			}
+		}
+	}
+
 	// automatically determine coverage if not explicitly set
 	if ( coverage == MC_BAD ) {
 		// automatically set MC_TRANSLUCENT if we don't have any interaction stages and 
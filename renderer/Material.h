@@ -127,6 +127,14 @@ typedef enum {
 	EXP_REG_NUM_PREDEFINED
 } expRegister_t;
 
+// what the registers of a material depend on besides its constants, found while parsing
+typedef enum {
+	REGDEP_TIME				= BIT(0),	// the view time
+	REGDEP_ENTITY_PARMS		= BIT(1),	// the shader parms of the entity or light, see GetRegisterParmMask()
+	REGDEP_GLOBAL_PARMS		= BIT(2),	// the shader parms of the view
+	REGDEP_SOUND			= BIT(3)	// the amplitude of the entity's sound emitter
+} registerDependency_t;
+
 typedef struct {
 	expOpType_t		opType;	
 	int				a, b, c;
@@ -158,6 +166,7 @@ typedef struct {
 	dynamicidImage_t	dynamic;
 	int					width, height;
 	int					dynamicFrameCount;
+	int					dynamicTime;		// view time of the last remote render, for r_remoteRenderInterval
 } textureStage_t;
 
 // the order BUMP / DIFFUSE / SPECULAR is necessary for interactions to draw correctly on low end cards
@@ -385,6 +394,9 @@ public:
 						// a mirror or dynamic rendered image
 	bool				HasSubview( void ) const { return hasSubview; }
 
+						// returns true if a stage samples _currentDepth, #3877
+	bool				UsesCurrentDepth( void ) const { return usesCurrentDepth; }
+
 						// returns true if the material will generate shadows, not making a
 						// distinction between global and no-self shadows
 	bool				SurfaceCastsShadow( void ) const { return TestMaterialFlag( MF_FORCESHADOWS ) || !TestMaterialFlag( MF_NOSHADOWS ); }
@@ -592,6 +604,12 @@ public:
 						// to be called.  If NULL is returned, EvaluateRegisters must be used.
 	const float *		ConstantRegisters() const;
 
+						// the REGDEP_* flags of what EvaluateRegisters reads, 0 for constant registers
+	int					GetRegisterDependencies() const { return registerDependencies; }
+
+						// the entity shader parms EvaluateRegisters reads, bit n for parm n
+	int					GetRegisterParmMask() const { return registerParmMask; }
+
 	bool				SuppressInSubview() const				{ return suppressInSubview; };
 	bool				IsPortalSky() const						{ return portalSky; };
 	void				AddReference();
@@ -666,6 +684,7 @@ private:
 	bool				cubicLight;          // nbohr1more #3881: cubemap based lighting
 	bool				unsmoothedTangents;
 	bool				hasSubview;			// mirror, remote render, etc
+	bool				usesCurrentDepth;
 	bool				allowOverlays;
 	bool				islightgemsurf;            // nbohr1more: #4379 lightgem culling
 
@@ -676,6 +695,8 @@ private:
 	float *				expressionRegisters;
 
 	float *				constantRegisters;	// NULL if ops ever reference globalParms or entityParms
+	int					registerDependencies;	// REGDEP_* flags
+	int					registerParmMask;	// the entity parms the ops reference
 
 	int					numStages;
 	int					numAmbientStages;
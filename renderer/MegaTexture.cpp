@@ -28,6 +28,8 @@ idCVar idMegaTexture::r_showMegaTexture( "r_showMegaTexture", "0", CVAR_RENDERER
 idCVar idMegaTexture::r_showMegaTextureLabels( "r_showMegaTextureLabels", "0", CVAR_RENDERER | CVAR_BOOL, "draw colored blocks in each tile" );
 idCVar idMegaTexture::r_skipMegaTexture( "r_skipMegaTexture", "0", CVAR_RENDERER | CVAR_INTEGER, "only use the lowest level image" );
 idCVar idMegaTexture::r_terrainScale( "r_terrainScale", "3", CVAR_RENDERER | CVAR_INTEGER, "vertically scale USGS data" );
+idCVar idMegaTexture::r_megaTextureTileCache( "r_megaTextureTileCache", "256", CVAR_RENDERER | CVAR_INTEGER, "number of tiles each megaTexture keeps in memory", 1, 4096 );
+idCVar idMegaTexture::r_megaTexturePrefetch( "r_megaTexturePrefetch", "1", CVAR_RENDERER | CVAR_BOOL, "read the tiles around the visible ones of each level in the background" );
 
 /*
 
@@ -65,6 +67,41 @@ static void R_EmptyLevelImage( idImage *image ) {
 }
 
 
+/*
+====================
+idMegaTexture::idMegaTexture
+====================
+*/
+idMegaTexture::idMegaTexture() {
+	fileHandle = NULL;
+	currentTriMapping = NULL;
+	numLevels = 0;
+	tileCacheUseCount = 0;
+	prefetchRead = NULL;
+	prefetchTile = -1;
+	prefetchTileNum = -1;
+}
+
+/*
+====================
+idMegaTexture::~idMegaTexture
+====================
+*/
+idMegaTexture::~idMegaTexture() {
+	FinishPrefetch();
+
+	for ( int i = 0 ; i < tileCache.Num() ; i++ ) {
+		Mem_Free( tileCache[i].data );
+	}
+	tileCache.Clear();
+	tileCacheHash.Free();
+
+	if ( fileHandle ) {
+		fileSystem->CloseFile( fileHandle );
+		fileHandle = NULL;
+	}
+}
+
 /*
 ====================
 InitFromMegaFile
@@ -208,6 +245,7 @@ BindForViewOrigin
 void idMegaTexture::BindForViewOrigin( const idVec3 viewOrigin ) {
 
 	SetViewOrigin( viewOrigin );
+	UpdatePrefetch();
 
 	// borderClamp image goes in texture 0
 	GL_SelectTexture( 0 );
@@ -303,11 +341,168 @@ void idMegaTexture::SetViewOrigin( const idVec3 viewOrigin ) {
 			localViewToTextureCenter[i][3];
 	}
 
+	// the tiles around the old center aren't needed anymore
+	prefetchTiles.Clear();
+
 	for ( int i = 0 ; i < numLevels ; i++ ) {
 		levels[i].UpdateForCenter( texCenter );
 	}
 }
 
+/*
+====================
+AllocTile
+
+Returns a tileCache index for a new tile, replacing the least recently used one
+====================
+*/
+int idMegaTexture::AllocTile() {
+	int		best = -1;
+
+	if ( tileCache.Num() < r_megaTextureTileCache.GetInteger() ) {
+		megaTile_t	tile;
+
+		tile.tileNum = -1;
+		tile.lastUsed = 0;
+		tile.data = (byte *)Mem_Alloc( TILE_BYTES );
+		return tileCache.Append( tile );
+	}
+
+	for ( int i = 0 ; i < tileCache.Num() ; i++ ) {
+		if ( i == prefetchTile ) {
+			continue;
+		}
+		if ( best == -1 || tileCache[i].lastUsed < tileCache[best].lastUsed ) {
+			best = i;
+		}
+	}
+	if ( best == -1 ) {
+		// only the tile being read, so the cache was shrunk to one
+		FinishPrefetch();
+		best = 0;
+	}
+
+	if ( tileCache[best].tileNum != -1 ) {
+		tileCacheHash.Remove( tileCache[best].tileNum, best );
+		tileCache[best].tileNum = -1;
+	}
+	return best;
+}
+
+/*
+====================
+ReadTile
+====================
+*/
+const byte *idMegaTexture::ReadTile( int tileNum ) {
+	for ( int i = tileCacheHash.First( tileNum ) ; i != -1 ; i = tileCacheHash.Next( i ) ) {
+		if ( tileCache[i].tileNum == tileNum ) {
+			tileCache[i].lastUsed = ++tileCacheUseCount;
+			return tileCache[i].data;
+		}
+	}
+
+	// the file can't be used while a tile is read in the background
+	if ( prefetchRead ) {
+		const bool wasPrefetched = ( prefetchTileNum == tileNum );
+		FinishPrefetch();
+		if ( wasPrefetched ) {
+			return ReadTile( tileNum );
+		}
+	}
+
+	megaTile_t &tile = tileCache[ AllocTile() ];
+
+	fileHandle->Seek( tileNum * TILE_BYTES, FS_SEEK_SET );
+	memset( tile.data, 128, TILE_BYTES );
+	fileHandle->Read( tile.data, TILE_BYTES );
+
+	tile.tileNum = tileNum;
+	tile.lastUsed = ++tileCacheUseCount;
+	tileCacheHash.Add( tileNum, &tile - tileCache.Ptr() );
+
+	return tile.data;
+}
+
+/*
+====================
+PrefetchTile
+====================
+*/
+void idMegaTexture::PrefetchTile( int tileNum ) {
+	if ( tileNum == prefetchTileNum || prefetchTiles.FindIndex( tileNum ) != -1 ) {
+		return;
+	}
+	for ( int i = tileCacheHash.First( tileNum ) ; i != -1 ; i = tileCacheHash.Next( i ) ) {
+		if ( tileCache[i].tileNum == tileNum ) {
+			return;
+		}
+	}
+	prefetchTiles.Append( tileNum );
+}
+
+/*
+====================
+UpdatePrefetch
+====================
+*/
+void idMegaTexture::UpdatePrefetch() {
+	if ( prefetchRead ) {
+		if ( !fileSystem->IsReadFileAsyncDone( prefetchRead ) ) {
+			return;
+		}
+		FinishPrefetch();
+	}
+
+	while ( prefetchTiles.Num() ) {
+		const int tileNum = prefetchTiles[0];
+		prefetchTiles.RemoveIndex( 0 );
+
+		bool cached = false;
+		for ( int i = tileCacheHash.First( tileNum ) ; i != -1 ; i = tileCacheHash.Next( i ) ) {
+			if ( tileCache[i].tileNum == tileNum ) {
+				cached = true;
+				break;
+			}
+		}
+		if ( cached ) {
+			continue;
+		}
+
+		prefetchTile = AllocTile();
+		prefetchTileNum = tileNum;
+		fileHandle->Seek( tileNum * TILE_BYTES, FS_SEEK_SET );
+		prefetchRead = fileSystem->ReadAsync( fileHandle, tileCache[prefetchTile].data, TILE_BYTES );
+		break;
+	}
+}
+
+/*
+====================
+FinishPrefetch
+
+Waits for the tile being read, a short read leaves it out of the cache
+====================
+*/
+void idMegaTexture::FinishPrefetch() {
+	if ( !prefetchRead ) {
+		return;
+	}
+
+	const int length = fileSystem->FinishReadFileAsync( prefetchRead, NULL );
+	prefetchRead = NULL;
+
+	if ( length == TILE_BYTES ) {
+		megaTile_t &tile = tileCache[prefetchTile];
+		tile.tileNum = prefetchTileNum;
+		tile.lastUsed = ++tileCacheUseCount;
+		tileCacheHash.Add( prefetchTileNum, prefetchTile );
+	}
+
+	prefetchTile = -1;
+	prefetchTileNum = -1;
+}
+
 
 /*
 ====================
@@ -335,14 +530,10 @@ void idTextureLevel::UpdateTile( int localX, int localY, int globalX, int global
 		// off the map
 		memset( data, 0, sizeof( data ) );
 	} else {
-		// extract the data from the full image (FIXME: background load from disk)
+		// extract the data from the full image, usually read in the background already
 		int		tileNum = tileOffset + tile->y * tilesWide + tile->x;
 
-		int		tileSize = TILE_SIZE * TILE_SIZE * 4;
-
-		mega->fileHandle->Seek( tileNum * tileSize, FS_SEEK_SET );
-		memset( data, 128, sizeof( data ) );
-		mega->fileHandle->Read( data, tileSize );
+		memcpy( data, mega->ReadTile( tileNum ), sizeof( data ) );
 	}
 
 	if ( idMegaTexture::r_showMegaTextureLabels.GetBool() ) {
@@ -434,6 +625,25 @@ void idTextureLevel::UpdateForCenter( float center[2] ) {
 			UpdateTile( x, y, globalTile[0], globalTile[1] );
 		}
 	}
+
+	if ( !idMegaTexture::r_megaTexturePrefetch.GetBool() || ( tilesWide <= TILE_PER_LEVEL && tilesHigh <= TILE_PER_LEVEL ) ) {
+		return;
+	}
+
+	// read the ring of tiles around the window, one of its sides comes
+	// into view when the center moves on to the next tile
+	for ( int x = -1 ; x <= TILE_PER_LEVEL ; x++ ) {
+		for ( int y = -1 ; y <= TILE_PER_LEVEL ; y++ ) {
+			if ( x >= 0 && x < TILE_PER_LEVEL && y >= 0 && y < TILE_PER_LEVEL ) {
+				continue;
+			}
+			int globalX = globalTileCorner[0] + x;
+			int globalY = globalTileCorner[1] + y;
+			if ( globalX >= 0 && globalX < tilesWide && globalY >= 0 && globalY < tilesHigh ) {
+				mega->PrefetchTile( tileOffset + globalY * tilesWide + globalX );
+			}
+		}
+	}
 }
 
 /*
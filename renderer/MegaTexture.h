@@ -27,6 +27,7 @@ static const int MAX_MEGA_CHANNELS = 3;		// normal, diffuse, specular
 static const int MAX_LEVELS = 12;
 static const int MAX_LEVEL_WIDTH = 512;
 static const int TILE_SIZE = MAX_LEVEL_WIDTH / TILE_PER_LEVEL;
+static const int TILE_BYTES = TILE_SIZE * TILE_SIZE * 4;
 
 class	idMegaTexture;
 
@@ -54,9 +55,19 @@ typedef struct {
 	int		tilesHigh;
 } megaTextureHeader_t;
 
+// a tile of the .mega file kept in memory, so it can be uploaded without waiting for the disk
+typedef struct {
+	int		tileNum;		// -1 if unused or still being read
+	int		lastUsed;		// the least recently used tile is replaced first
+	byte	*data;
+} megaTile_t;
+
 
 class idMegaTexture {
 public:
+			idMegaTexture();
+			~idMegaTexture();
+
 	bool	InitFromMegaFile( const char *fileBase );
 	void	SetMappingForSurface( const srfTriangles_t *tri );	// analyzes xyz and st to create a mapping
 	void	BindForViewOrigin( const idVec3 origin );	// binds images and sets program parameters
@@ -69,6 +80,12 @@ friend class idTextureLevel;
 	static void	GenerateMegaMipMaps( megaTextureHeader_t *header, idFile *file );
 	static void	GenerateMegaPreview( const char *fileName );
 
+	const byte *ReadTile( int tileNum );			// from the tile cache, or right from the file if it wasn't prefetched
+	void	PrefetchTile( int tileNum );
+	void	UpdatePrefetch();						// starts the next async tile read when the last one is done
+	void	FinishPrefetch();
+	int		AllocTile();
+
 	idFile			*fileHandle;
 
 	const srfTriangles_t *currentTriMapping;
@@ -81,10 +98,20 @@ friend class idTextureLevel;
 	idTextureLevel	levels[MAX_LEVELS];				// 0 is the highest resolution
 	megaTextureHeader_t	header;
 
+	idList<megaTile_t>	tileCache;
+	idHashIndex		tileCacheHash;
+	int				tileCacheUseCount;
+	idList<int>		prefetchTiles;					// tile numbers waiting for the async read, finest level first
+	asyncRead_t		*prefetchRead;
+	int				prefetchTile;					// tileCache index of the tile being read
+	int				prefetchTileNum;
+
 	static idCVar	r_megaTextureLevel;
 	static idCVar	r_showMegaTexture;
 	static idCVar	r_showMegaTextureLabels;
 	static idCVar	r_skipMegaTexture;
 	static idCVar	r_terrainScale;
+	static idCVar	r_megaTextureTileCache;
+	static idCVar	r_megaTexturePrefetch;
 };
 
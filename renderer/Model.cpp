@@ -32,6 +32,11 @@ idCVar idRenderModelStatic::r_mergeModelSurfaces( "r_mergeModelSurfaces", "1", C
 idCVar idRenderModelStatic::r_slopVertex( "r_slopVertex", "0.01", CVAR_RENDERER, "merge xyz coordinates this far apart" );
 idCVar idRenderModelStatic::r_slopTexCoord( "r_slopTexCoord", "0.001", CVAR_RENDERER, "merge texture coordinates this far apart" );
 idCVar idRenderModelStatic::r_slopNormal( "r_slopNormal", "0.02", CVAR_RENDERER, "merge normals that dot less than this" );
+idCVar idRenderModelStatic::r_useModelCache( "r_useModelCache", "1", CVAR_BOOL|CVAR_RENDERER|CVAR_ARCHIVE, "keep the cleaned up surfaces of ase, lwo and ma models in " MODEL_CACHE_DIR "/, keyed by the source file and the materials, to skip parsing and cleanup on later loads" );
+
+#define MODEL_CACHE_ID			( ( 'B' << 24 ) | ( 'M' << 16 ) | ( 'D' << 8 ) | 'L' )
+#define MODEL_CACHE_VERSION		1
+#define MODEL_CACHE_EXT			"bmodel"
 
 /*
 ================
@@ -275,6 +280,23 @@ void idRenderModelStatic::InitFromFile( const char *fileName ) {
 	// FIXME: load new .proc map format
 	name.ExtractFileExtension( extension );
 
+	// the cleaned up surfaces may be in the model cache from an earlier load
+	idStr cacheName;
+	ID_TIME_T sourceTimestamp = FILE_NOT_FOUND_TIMESTAMP;
+	int sourceLength = -1;
+	if ( UsesModelCache( extension ) ) {
+		sourceLength = fileSystem->ReadFile( name, NULL, &sourceTimestamp );
+		if ( sourceLength > 0 ) {
+			ModelCacheFileName( cacheName );
+			if ( LoadCachedModel( cacheName, sourceTimestamp, sourceLength ) ) {
+				reloadable = true;
+				purged = false;
+				FinishCleanedSurfaces();
+				return;
+			}
+		}
+	}
+
 	if ( extension.Icmp( "ase" ) == 0 ) {
 		loaded		= LoadASE( name );
 		// Tels: #3111 try to load LWO as a fallback
@@ -319,6 +341,169 @@ void idRenderModelStatic::InitFromFile( const char *fileName ) {
 
 	// create the bounds for culling and dynamic surface creation
 	FinishSurfaces();
+
+	// a model loaded from the fallback file doesn't match the key
+	if ( sourceLength > 0 && fallback.IsEmpty() ) {
+		WriteCachedModel( cacheName, sourceTimestamp, sourceLength );
+	}
+}
+
+/*
+================
+idRenderModelStatic::UsesModelCache
+
+Only the text formats are worth caching, models for renderbump
+are not cleaned up
+================
+*/
+bool idRenderModelStatic::UsesModelCache( const char *extension ) const {
+	if ( !r_useModelCache.GetBool() || fastLoad ) {
+		return false;
+	}
+	return idStr::Icmp( extension, "ase" ) == 0 || idStr::Icmp( extension, "lwo" ) == 0 || idStr::Icmp( extension, "ma" ) == 0;
+}
+
+/*
+================
+idRenderModelStatic::ModelCacheFileName
+================
+*/
+void idRenderModelStatic::ModelCacheFileName( idStr &cacheName ) const {
+	sprintf( cacheName, "%s/%s." MODEL_CACHE_EXT, MODEL_CACHE_DIR, name.c_str() );
+}
+
+/*
+================
+idRenderModelStatic::ModelCacheMaterialFlags
+
+The material settings the conversion and cleanup depend on, a
+cached model is thrown away when one of its materials changes them
+================
+*/
+int idRenderModelStatic::ModelCacheMaterialFlags( const idMaterial *material ) {
+	const char *rb = material->GetRenderBump();
+
+	return ( material->IsDiscrete() ? 1 : 0 )
+		| ( material->ShouldCreateBackSides() ? 2 : 0 )
+		| ( material->UseUnsmoothedTangents() ? 4 : 0 )
+		| ( ( rb && rb[0] ) ? 8 : 0 );
+}
+
+/*
+================
+idRenderModelStatic::WriteModelCacheHeader
+
+Everything the cached surfaces depend on besides the materials
+================
+*/
+void idRenderModelStatic::WriteModelCacheHeader( idFile *f, ID_TIME_T sourceTimestamp, int sourceLength ) {
+	f->WriteInt( MODEL_CACHE_ID );
+	f->WriteInt( MODEL_CACHE_VERSION );
+	f->WriteInt( sizeof( idDrawVert ) | ( sizeof( glIndex_t ) << 8 ) );
+	f->WriteUnsignedInt( (unsigned int)sourceTimestamp );
+	f->WriteInt( sourceLength );
+	f->WriteBool( r_mergeModelSurfaces.GetBool() );
+	f->WriteFloat( r_slopVertex.GetFloat() );
+	f->WriteFloat( r_slopTexCoord.GetFloat() );
+	f->WriteFloat( r_slopNormal.GetFloat() );
+	f->WriteBool( r_useSilRemap.GetBool() );
+}
+
+/*
+================
+idRenderModelStatic::LoadCachedModel
+
+Restores the cleaned up surfaces from the model cache, returns false
+if the cache file is missing, out of date or damaged
+================
+*/
+bool idRenderModelStatic::LoadCachedModel( const char *cacheName, ID_TIME_T sourceTimestamp, int sourceLength ) {
+	idFile *f = fileSystem->OpenFileRead( cacheName );
+	if ( !f ) {
+		return false;
+	}
+
+	// compare the header with a fresh one
+	idFile_Memory expected;
+	WriteModelCacheHeader( &expected, sourceTimestamp, sourceLength );
+
+	byte *header = (byte *)_alloca( expected.Length() );
+	if ( f->Read( header, expected.Length() ) != expected.Length() || memcmp( header, expected.GetDataPtr(), expected.Length() ) != 0 ) {
+		fileSystem->CloseFile( f );
+		return false;
+	}
+
+	int numSurfaces = -1;
+	f->ReadInt( numSurfaces );
+
+	bool ok = ( numSurfaces > 0 );
+	for ( int i = 0 ; ok && i < numSurfaces ; i++ ) {
+		modelSurface_t	surf;
+		idStr			materialName;
+		int				materialFlags = -1;
+
+		f->ReadInt( surf.id );
+		f->ReadString( materialName );
+		f->ReadInt( materialFlags );
+
+		surf.shader = materialName.Length() ? declManager->FindMaterial( materialName ) : tr.defaultMaterial;
+		if ( ModelCacheMaterialFlags( surf.shader ) != materialFlags ) {
+			ok = false;
+			break;
+		}
+
+		surf.geometry = R_ReadCleanedTriSurf( f );
+		if ( !surf.geometry ) {
+			common->Warning( "Bad model cache file %s", cacheName );
+			ok = false;
+			break;
+		}
+
+		AddSurface( surf );
+	}
+
+	fileSystem->CloseFile( f );
+
+	if ( !ok ) {
+		PurgeModel();
+		return false;
+	}
+
+	timeStamp = sourceTimestamp;
+
+	return true;
+}
+
+/*
+================
+idRenderModelStatic::WriteCachedModel
+
+Called after FinishSurfaces cleaned up the surfaces of a loaded model
+================
+*/
+void idRenderModelStatic::WriteCachedModel( const char *cacheName, ID_TIME_T sourceTimestamp, int sourceLength ) {
+	if ( defaulted || surfaces.Num() == 0 ) {
+		return;
+	}
+
+	idFile *f = fileSystem->OpenFileWrite( cacheName );
+	if ( !f ) {
+		return;
+	}
+
+	WriteModelCacheHeader( f, sourceTimestamp, sourceLength );
+
+	f->WriteInt( surfaces.Num() );
+	for ( int i = 0 ; i < surfaces.Num() ; i++ ) {
+		const modelSurface_t *surf = &surfaces[i];
+
+		f->WriteInt( surf->id );
+		f->WriteString( surf->shader == tr.defaultMaterial ? "" : surf->shader->GetName() );
+		f->WriteInt( ModelCacheMaterialFlags( surf->shader ) );
+		R_WriteCleanedTriSurf( f, surf->geometry );
+	}
+
+	fileSystem->CloseFile( f );
 }
 
 /*
@@ -654,17 +839,51 @@ void idRenderModelStatic::FinishSurfaces() {
 		}
 	}
 
-	// clean the surfaces
-	for ( i = 0 ; i < surfaces.Num() ; i++ ) {
-		const modelSurface_t	*surf = &surfaces[i];
+	// clean the surfaces, every surface only touches its own triangles and
+	// the tri surf allocators, so they are cleaned up on several threads
+	const int numSurfaces = surfaces.Num();
+	modelSurface_t *surfList = surfaces.Ptr();
+
+	// errors can't leave the parallel loop
+	for ( i = 0 ; i < numSurfaces ; i++ ) {
+		R_RangeCheckIndexes( surfList[i].geometry );
+	}
+
+	const bool oldLockStaticAlloc = tr.lockStaticAlloc;
+	tr.lockStaticAlloc = true;
+
+#pragma omp parallel for if ( numSurfaces > 1 ) schedule( dynamic )
+	for ( i = 0 ; i < numSurfaces ; i++ ) {
+		const modelSurface_t	*surf = &surfList[i];
 
 		R_CleanupTriangles( surf->geometry, surf->geometry->generateNormals, true, surf->shader->UseUnsmoothedTangents() );
+	}
+
+	tr.lockStaticAlloc = oldLockStaticAlloc;
+
+	for ( i = 0 ; i < numSurfaces ; i++ ) {
+		const modelSurface_t	*surf = &surfList[i];
+
 		if ( surf->shader->SurfaceCastsShadow() ) {
 			totalVerts += surf->geometry->numVerts;
 			totalIndexes += surf->geometry->numIndexes;
 		}
 	}
 
+	FinishCleanedSurfaces();
+}
+
+/*
+================
+idRenderModelStatic::FinishCleanedSurfaces
+
+Adds up the surface area and the bounds of surfaces that went through
+R_CleanupTriangles, also used for the surfaces from the model cache
+================
+*/
+void idRenderModelStatic::FinishCleanedSurfaces() {
+	int			i;
+
 	// add up the total surface area for development information
 	for ( i = 0 ; i < surfaces.Num() ; i++ ) {
 		const modelSurface_t	*surf = &surfaces[i];
@@ -2172,7 +2391,8 @@ void idRenderModelStatic::PurgeModel() {
 ==============
 idRenderModelStatic::FreeVertexCache
 
-We are about to restart the vertex cache, so dump everything
+We are about to restart the vertex cache, or the surfaces are about
+to be rewritten in place, so dump everything
 ==============
 */
 void idRenderModelStatic::FreeVertexCache( void ) {
@@ -2190,6 +2410,12 @@ void idRenderModelStatic::FreeVertexCache( void ) {
 			vertexCache.Free( tri->shadowCache );
 			tri->shadowCache = NULL;
 		}
+		// the index count may change with the vertexes, as in the smoke particle snapshot
+		if ( tri->indexCache ) {
+			vertexCache.Free( tri->indexCache );
+			tri->indexCache = NULL;
+		}
+		R_FreeDeformCache( tri );
 	}
 }
 
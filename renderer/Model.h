@@ -35,6 +35,12 @@
 #define MD5_CAMERA_EXT			"md5camera"
 #define MD5_VERSION				10
 
+// binary versions of the md5mesh and md5anim files, written next to them as md5meshb and md5animb
+#define MD5_BINARY_SUFFIX		"b"
+#define MD5_MESH_BINARY_ID		"MD5M"
+#define MD5_ANIM_BINARY_ID		"MD5A"
+#define MD5_BINARY_VERSION		1
+
 // using shorts for triangle indexes can save a significant amount of traffic, but
 // to support the large models that renderBump loads, they need to be 32 bits
 #if 1
@@ -85,6 +91,7 @@ typedef struct srfTriangles_s {
 	bool						perfectHull;			// true if there aren't any dangling edges
 	bool						deformedSurface;		// if true, indexes, silIndexes, mirrorVerts, and silEdges are
 														// pointers into the original surface, and should not be freed
+	byte						region;					// tri surf allocator region the data comes from
 
 	int							numVerts;				// number of vertices
 	idDrawVert *				verts;					// vertices, allocated with special allocator
@@ -123,6 +130,8 @@ typedef struct srfTriangles_s {
 
 	struct srfTriangles_s *		nextDeferredFree;		// chain of tris to free next frame
 
+	struct deformCache_s *		deformCache;			// last result of a view independent deform, see tr_deform.cpp
+
 	// data in vertex object space, not directly readable by the CPU
 	struct vertCache_s *		indexCache;				// int
 	struct vertCache_s *		ambientCache;			// idDrawVert
@@ -208,7 +217,8 @@ public:
 	// are kept loaded
 	virtual void				TouchData() = 0;
 
-	// dump any ambient caches on the model surfaces
+	// dump any vertex and index caches on the model surfaces,
+	// must be called before changing the surfaces in place
 	virtual void				FreeVertexCache() = 0;
 
 	// returns the name of the model
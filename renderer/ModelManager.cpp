@@ -50,12 +50,14 @@ public:
 
 private:
 	idList<idRenderModel*>	models;
+	idList<int>				residencyLevels;		// the last level load that referenced each model
 	idHashIndex				hash;
 	idRenderModel *			defaultModel;
 	idRenderModel *			beamModel;
 	idRenderModel *			spriteModel;
 	idRenderModel *			trailModel;
 	bool					insideLevelLoad;		// don't actually load now
+	idLevelResidency		residency;				// keeps models of earlier levels within r_modelResidencyMegs
 
 	idRenderModel *			GetModel( const char *modelName, bool createIfNotFound );
 
@@ -235,6 +237,7 @@ idRenderModelManagerLocal::Shutdown
 */
 void idRenderModelManagerLocal::Shutdown() {
 	models.DeleteContents( true );
+	residencyLevels.Clear();
 	hash.Free();
 }
 
@@ -251,6 +254,9 @@ idRenderModel *idRenderModelManagerLocal::GetModel( const char *modelName, bool
 		return NULL;
 	}
 
+	idLoadProfileScope profile( "model", modelName );
+	idScopedMemTag memTag( MEMTAG_MODELS );
+
 	canonical = modelName;
 	canonical.ToLower();
 
@@ -260,6 +266,14 @@ idRenderModel *idRenderModelManagerLocal::GetModel( const char *modelName, bool
 		idRenderModel *model = models[i];
 
 		if ( canonical.Icmp( model->Name() ) == 0 ) {
+			if ( insideLevelLoad && !model->IsLevelLoadReferenced() ) {
+				if ( model->IsLoaded() ) {
+					residency.AddHit( residencyLevels[i] );
+				} else {
+					residency.AddLoads( 1 );
+				}
+				residencyLevels[i] = residency.GetLevel();
+			}
 			if ( !model->IsLoaded() ) {
 				// reload it if it was purged
 				model->LoadModel();
@@ -326,6 +340,10 @@ idRenderModel *idRenderModelManagerLocal::GetModel( const char *modelName, bool
 		return NULL;
 	}
 
+	if ( insideLevelLoad ) {
+		residency.AddLoads( 1 );
+	}
+
 	AddModel( model );
 
 	return model;
@@ -405,6 +423,7 @@ idRenderModelManagerLocal::AddModel
 */
 void idRenderModelManagerLocal::AddModel( idRenderModel *model ) {
 	hash.Add( hash.GenerateKey( model->Name(), false ), models.Append( model ) );
+	residencyLevels.Append( residency.GetLevel() );
 }
 
 /*
@@ -416,6 +435,7 @@ void idRenderModelManagerLocal::RemoveModel( idRenderModel *model ) {
 	int index = models.FindIndex( model );
 	hash.RemoveIndex( hash.GenerateKey( model->Name(), false ), index );
 	models.RemoveIndex( index );
+	residencyLevels.RemoveIndex( index );
 }
 
 /*
@@ -481,6 +501,11 @@ idRenderModelManagerLocal::BeginLevelLoad
 void idRenderModelManagerLocal::BeginLevelLoad() {
 	insideLevelLoad = true;
 
+	residency.BeginLevelLoad();
+
+	// the surfaces of this level are allocated apart from the previous one
+	R_BeginLevelTriSurfRegion();
+
 	for ( int i = 0 ; i < models.Num() ; i++ ) {
 		idRenderModel *model = models[i];
 
@@ -511,12 +536,17 @@ void idRenderModelManagerLocal::EndLevelLoad() {
 	int	keepCount = 0;
 	int	loadCount = 0;
 
-	// purge any models not touched
+	// purge any models not touched, the ones of earlier levels go to the residency
 	for ( int i = 0 ; i < models.Num() ; i++ ) {
 		idRenderModel *model = models[i];
 
 		if ( !model->IsLevelLoadReferenced() && model->IsLoaded() && model->IsReloadable() ) {
 
+			if ( !com_purgeAll.GetBool() ) {
+				residency.AddCandidate( i, model->Memory(), residencyLevels[i] );
+				continue;
+			}
+
 //			common->Printf( "purging %s\n", model->Name() );
 
 			purgeCount++;
@@ -533,9 +563,24 @@ void idRenderModelManagerLocal::EndLevelLoad() {
 		}
 	}
 
+	idList<int> evictions;
+	residency.SelectEvictions( r_modelResidencyMegs.GetFloat(), evictions );
+	for ( int i = 0 ; i < evictions.Num() ; i++ ) {
+		idRenderModel *model = models[evictions[i]];
+
+		purgeCount++;
+
+		R_CheckForEntityDefsUsingModel( model );
+
+		model->PurgeModel();
+	}
+
 	// purge unused triangle surface memory
 	R_PurgeTriSurfData( frameData );
 
+	// release the previous level's allocators if nothing in them was kept
+	R_EndLevelTriSurfRegion();
+
 	// load any new ones
 	for ( int i = 0 ; i < models.Num() ; i++ ) {
 		idRenderModel *model = models[i];
@@ -560,6 +605,7 @@ void idRenderModelManagerLocal::EndLevelLoad() {
 	if ( loadCount ) {
 		common->Printf( "%5i new models loaded in %5.1f seconds\n", loadCount, (end-start) * 0.001 );
 	}
+	residency.Print( "models" );
 	common->Printf( "---------------------------------------------------\n" );
 }
 
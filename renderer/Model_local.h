@@ -20,6 +20,9 @@
 #ifndef __MODEL_LOCAL_H__
 #define __MODEL_LOCAL_H__
 
+// the cleaned up surfaces of static models, written to fs_savepath
+#define	MODEL_CACHE_DIR		"modelcache"
+
 /*
 ===============================================================================
 
@@ -93,6 +96,16 @@ public:
 	void						DeleteSurfacesWithNegativeId( void );
 	bool						FindSurfaceWithId( int id, int &surfaceNum );
 
+	void						FinishCleanedSurfaces();
+
+	// the cleaned up surfaces of loaded models are kept in MODEL_CACHE_DIR
+	bool						UsesModelCache( const char *extension ) const;
+	void						ModelCacheFileName( idStr &cacheName ) const;
+	bool						LoadCachedModel( const char *cacheName, ID_TIME_T sourceTimestamp, int sourceLength );
+	void						WriteCachedModel( const char *cacheName, ID_TIME_T sourceTimestamp, int sourceLength );
+	static int					ModelCacheMaterialFlags( const idMaterial *material );
+	static void					WriteModelCacheHeader( idFile *f, ID_TIME_T sourceTimestamp, int sourceLength );
+
 public:
 	idList<modelSurface_t>		surfaces;
 	idBounds					bounds;
@@ -116,6 +129,7 @@ protected:
 	static idCVar				r_slopVertex;			// merge xyz coordinates this far apart
 	static idCVar				r_slopTexCoord;			// merge texture coordinates this far apart
 	static idCVar				r_slopNormal;			// merge normals that dot less than this
+	static idCVar				r_useModelCache;		// keep the cleaned up surfaces in MODEL_CACHE_DIR
 };
 
 /*
@@ -133,8 +147,14 @@ public:
 								idMD5Mesh();
 								~idMD5Mesh();
 
- 	void						ParseMesh( idLexer &parser, int numJoints, const idJointMat *joints );
-	void						UpdateSurface( const struct renderEntity_s *ent, const idJointMat *joints, modelSurface_t *surf );
+ 	void						ParseMesh( idLexer &parser, int numJoints, idList<int> &tris );
+								// the binary md5meshb version of ParseMesh
+	bool						ReadBinaryMesh( idFile *f, int numJoints, idList<int> &tris );
+	void						WriteBinaryMesh( idFile *f, const idList<int> &tris ) const;
+								// builds the deform info from the parsed mesh in the default pose
+	void						FinishMesh( const idList<int> &tris, const idJointMat *joints );
+	void						PrepareSurface( modelSurface_t *surf );
+	void						DeformSurface( const struct renderEntity_s *ent, const idJointMat *joints, modelSurface_t *surf );
 	idBounds					CalcBounds( const idJointMat *joints );
 	int							NearestJoint( int a, int b, int c ) const;
 	int							NumVerts( void ) const;
@@ -174,6 +194,11 @@ public:
 	virtual const idJointQuat *	GetDefaultPose( void ) const;
 	virtual int					NearestJoint( int surfaceNum, int a, int b, int c ) const;
 
+	// InstantiateDynamicModel in two steps, so the models of many entities can be skinned
+	// on several threads, see R_InstantiateViewDynamicModels
+	idRenderModelStatic *		PrepareDynamicModel( const struct renderEntity_s *ent, const struct viewDef_s *view, idRenderModel *cachedModel );
+	void						DeformDynamicModel( const struct renderEntity_s *ent, idRenderModelStatic *staticModel );
+
 private:
 	idList<idMD5Joint>			joints;
 	idList<idJointQuat>			defaultPose;
@@ -183,6 +208,8 @@ private:
 	void						GetFrameBounds( const renderEntity_t *ent, idBounds &bounds ) const;
 	void						DrawJoints( const renderEntity_t *ent, const struct viewDef_s *view ) const;
 	void						ParseJoint( idLexer &parser, idMD5Joint *joint, idJointQuat *defaultPose );
+	bool						LoadBinaryModel( const char *fileName, int textLength );
+	void						WriteBinaryModel( const char *fileName, int textLength, const idJointMat *poseMat3, const idList< idList<int> > &meshTris ) const;
 };
 
 /*
@@ -220,6 +247,19 @@ private:
 ===============================================================================
 */
 
+// the cells of a liquid height field that are not at rest
+typedef struct liquidRect_s {
+	int		x1, y1, x2, y2;			// inclusive
+
+	void	Clear( void ) { x1 = y1 = 0; x2 = y2 = -1; }
+	bool	IsEmpty( void ) const { return x1 > x2 || y1 > y2; }
+	void	AddPoint( int x, int y ) {
+				if ( IsEmpty() ) { x1 = x2 = x; y1 = y2 = y; return; }
+				x1 = Min( x1, x ); y1 = Min( y1, y ); x2 = Max( x2, x ); y2 = Max( y2, y );
+			}
+	void	AddRect( const struct liquidRect_s &r ) { if ( !r.IsEmpty() ) { AddPoint( r.x1, r.y1 ); AddPoint( r.x2, r.y2 ); } }
+} liquidRect_t;
+
 class idRenderModelLiquid : public idRenderModelStatic {
 public:
 								idRenderModelLiquid();
@@ -234,7 +274,7 @@ public:
 
 private:
 	modelSurface_t				GenerateSurface( float lerp );
-	void						WaterDrop( int x, int y, float *page );
+	void						WaterDrop( int x, int y, float *page, liquidRect_t &rect );
 	void						Update( void );
 						
 	int							verts_x;
@@ -260,8 +300,11 @@ private:
 	idList<float>				pages;
 	float *						page1;
 	float *						page2;
+	liquidRect_t				rect1;			// cells of page1 that aren't zero
+	liquidRect_t				rect2;			// cells of page2 that aren't zero
 
 	idList<idDrawVert>			verts;
+	liquidRect_t				vertRect;		// verts that aren't at zero height
 
 	int							nextDropTime;
 
@@ -289,6 +332,11 @@ public:
 	
 public:																	
 	float						SofteningRadius( const int stage ) const;	// #3878 soft particles
+
+	// InstantiateDynamicModel in two steps, so the particles of many entities can be
+	// generated on several threads, see R_InstantiateViewDynamicModels
+	idRenderModelStatic *		PrepareDynamicModel( const struct renderEntity_s *ent, const struct viewDef_s *view, idRenderModel *cachedModel );
+	void						GenerateDynamicModel( const struct renderEntity_s *ent, const struct viewDef_s *view, idRenderModelStatic *staticModel );
 private:
 	virtual void				SetSofteningRadii();
 
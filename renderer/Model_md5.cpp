@@ -78,7 +78,7 @@ idMD5Mesh::~idMD5Mesh() {
 idMD5Mesh::ParseMesh
 ====================
 */
-void idMD5Mesh::ParseMesh( idLexer &parser, int numJoints, const idJointMat *joints ) {
+void idMD5Mesh::ParseMesh( idLexer &parser, int numJoints, idList<int> &tris ) {
 	idToken		token;
 	idToken		name;
 	int			num;
@@ -86,7 +86,6 @@ void idMD5Mesh::ParseMesh( idLexer &parser, int numJoints, const idJointMat *joi
 	int			jointnum;
 	idStr		shaderName;
 	int			i, j;
-	idList<int>	tris;
 	idList<int>	firstWeightForVertex;
 	idList<int>	numWeightsForVertex;
 	int			maxweight;
@@ -216,6 +215,87 @@ void idMD5Mesh::ParseMesh( idLexer &parser, int numJoints, const idJointMat *joi
 	firstWeightForVertex.Clear();
 
 	parser.ExpectTokenString( "}" );
+}
+
+/*
+====================
+idMD5Mesh::WriteBinaryMesh
+====================
+*/
+void idMD5Mesh::WriteBinaryMesh( idFile *f, const idList<int> &tris ) const {
+	f->WriteString( shader->GetName() );
+	f->WriteInt( texCoords.Num() );
+	f->Write( texCoords.Ptr(), texCoords.Num() * sizeof( texCoords[0] ) );
+	f->WriteInt( tris.Num() );
+	f->Write( tris.Ptr(), tris.Num() * sizeof( tris[0] ) );
+	f->WriteInt( numWeights );
+	f->Write( scaledWeights, numWeights * sizeof( scaledWeights[0] ) );
+	f->Write( weightIndex, numWeights * 2 * sizeof( weightIndex[0] ) );
+}
+
+/*
+====================
+idMD5Mesh::ReadBinaryMesh
+
+Returns false if the data is damaged.
+====================
+*/
+bool idMD5Mesh::ReadBinaryMesh( idFile *f, int numJoints, idList<int> &tris ) {
+	idStr	shaderName;
+	int		length, num, i;
+
+	f->ReadInt( length );
+	if ( length < 0 || length > f->Length() - f->Tell() ) {
+		return false;
+	}
+	shaderName.Fill( ' ', length );
+	f->Read( &shaderName[0], length );
+	shader = declManager->FindMaterial( shaderName );
+
+	f->ReadInt( num );
+	if ( num < 0 || (long long)num * sizeof( texCoords[0] ) > f->Length() - f->Tell() ) {
+		return false;
+	}
+	texCoords.SetNum( num );
+	f->Read( texCoords.Ptr(), num * sizeof( texCoords[0] ) );
+
+	f->ReadInt( num );
+	if ( num < 0 || num % 3 || (long long)num * sizeof( tris[0] ) > f->Length() - f->Tell() ) {
+		return false;
+	}
+	tris.SetNum( num );
+	f->Read( tris.Ptr(), num * sizeof( tris[0] ) );
+	numTris = num / 3;
+	for ( i = 0; i < num; i++ ) {
+		if ( tris[i] < 0 || tris[i] >= texCoords.Num() ) {
+			return false;
+		}
+	}
+
+	f->ReadInt( numWeights );
+	if ( numWeights < 0 || (long long)numWeights * ( sizeof( scaledWeights[0] ) + 2 * sizeof( weightIndex[0] ) ) > f->Length() - f->Tell() ) {
+		numWeights = 0;
+		return false;
+	}
+	scaledWeights = (idVec4 *) Mem_Alloc16( numWeights * sizeof( scaledWeights[0] ) );
+	weightIndex = (int *) Mem_Alloc16( numWeights * 2 * sizeof( weightIndex[0] ) );
+	f->Read( scaledWeights, numWeights * sizeof( scaledWeights[0] ) );
+	f->Read( weightIndex, numWeights * 2 * sizeof( weightIndex[0] ) );
+	for ( i = 0; i < numWeights; i++ ) {
+		if ( weightIndex[i * 2] < 0 || weightIndex[i * 2] >= numJoints * (int)sizeof( idJointMat ) ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+====================
+idMD5Mesh::FinishMesh
+====================
+*/
+void idMD5Mesh::FinishMesh( const idList<int> &tris, const idJointMat *joints ) {
+	int i;
 
 	// update counters
 	c_numVerts += texCoords.Num();
@@ -262,24 +342,30 @@ void idMD5Mesh::TransformScaledVerts( idDrawVert *verts, const idJointMat *entJo
 
 /*
 ====================
-idMD5Mesh::UpdateSurface
+idMD5Mesh::PrepareSurface
+
+Allocates the triangle surface and sets up the references to the deform info,
+the vertexes are transformed by DeformSurface
 ====================
 */
-void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMat *entJoints, modelSurface_t *surf ) {
-	int i, base;
+void idMD5Mesh::PrepareSurface( modelSurface_t *surf ) {
+	int i;
 	srfTriangles_t *tri;
 
-	tr.pc.c_deformedSurfaces++;
-	tr.pc.c_deformedVerts += deformInfo->numOutputVerts;
-	tr.pc.c_deformedIndexes += deformInfo->numIndexes;
-
 	surf->shader = shader;
 
 	if ( surf->geometry ) {
 		// if the number of verts and indexes are the same we can re-use the triangle surface
 		// the number of indexes must be the same to assure the correct amount of memory is allocated for the facePlanes
 		if ( surf->geometry->numVerts == deformInfo->numOutputVerts && surf->geometry->numIndexes == deformInfo->numIndexes ) {
+			// the indexes come straight from the deform info, so the index cache stays valid
+			vertCache_t *indexCache = NULL;
+			if ( surf->geometry->indexes == deformInfo->indexes ) {
+				indexCache = surf->geometry->indexCache;
+				surf->geometry->indexCache = NULL;
+			}
 			R_FreeStaticTriSurfVertexCaches( surf->geometry );
+			surf->geometry->indexCache = indexCache;
 		} else {
 			R_FreeStaticTriSurf( surf->geometry );
 			surf->geometry = R_AllocStaticTriSurf();
@@ -314,6 +400,24 @@ void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMa
 			tri->verts[i].st = texCoords[i];
 		}
 	}
+}
+
+/*
+====================
+idMD5Mesh::DeformSurface
+
+Transforms the vertexes of a surface set up by PrepareSurface. Doesn't touch
+anything but the surface, so the surfaces of different entities can be deformed
+on several threads while tr.lockStaticAlloc is set.
+====================
+*/
+void idMD5Mesh::DeformSurface( const struct renderEntity_s *ent, const idJointMat *entJoints, modelSurface_t *surf ) {
+	int i, base;
+	srfTriangles_t *tri = surf->geometry;
+
+	tr.pc.c_deformedSurfaces++;
+	tr.pc.c_deformedVerts += deformInfo->numOutputVerts;
+	tr.pc.c_deformedIndexes += deformInfo->numIndexes;
 
 	if ( ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ] != 0.0f ) {
 		TransformScaledVerts( tri->verts, entJoints, ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ] );
@@ -491,12 +595,21 @@ void idRenderModelMD5::LoadModel() {
 	idJointQuat	*pose;
 	idMD5Joint	*joint;
 	idJointMat *poseMat3;
+	idList< idList<int> > meshTris;
 
 	if ( !purged ) {
 		PurgeModel();
 	}
 	purged = false;
 
+	// set the timestamp for reloadmodels, the binary version is valid as long as
+	// the text file keeps its length and timestamp
+	int textLength = fileSystem->ReadFile( name, NULL, &timeStamp );
+	idStr binaryName = name + MD5_BINARY_SUFFIX;
+	if ( textLength >= 0 && r_useBinaryMD5.GetBool() && LoadBinaryModel( binaryName, textLength ) ) {
+		return;
+	}
+
 	if ( !parser.LoadFile( name ) ) {
 		MakeDefaultModel();
 		return;
@@ -552,9 +665,11 @@ void idRenderModelMD5::LoadModel() {
 	}
 	parser.ExpectTokenString( "}" );
 
+	meshTris.SetNum( meshes.Num() );
 	for( i = 0; i < meshes.Num(); i++ ) {
 		parser.ExpectTokenString( "mesh" );
-		meshes[ i ].ParseMesh( parser, defaultPose.Num(), poseMat3 );
+		meshes[ i ].ParseMesh( parser, defaultPose.Num(), meshTris[ i ] );
+		meshes[ i ].FinishMesh( meshTris[ i ], poseMat3 );
 	}
 
 	//
@@ -562,8 +677,144 @@ void idRenderModelMD5::LoadModel() {
 	//
 	CalculateBounds( poseMat3 );
 
-	// set the timestamp for reloadmodels
-	fileSystem->ReadFile( name, NULL, &timeStamp );
+	if ( r_useBinaryMD5.GetBool() ) {
+		WriteBinaryModel( binaryName, textLength, poseMat3, meshTris );
+	}
+}
+
+/*
+====================
+idRenderModelMD5::WriteBinaryModel
+
+Stores the joints, the default pose both relative to the parents and in model
+space, and the meshes with their pre-scaled weights, so loading only has to
+build the deform infos.
+====================
+*/
+void idRenderModelMD5::WriteBinaryModel( const char *fileName, int textLength, const idJointMat *poseMat3, const idList< idList<int> > &meshTris ) const {
+	int i;
+	idFile_Memory f( fileName );
+
+	f.SetGranularity( 256 * 1024 );
+
+	// header, all native so a build with a different layout rejects it
+	f.Write( MD5_MESH_BINARY_ID, 4 );
+	f.WriteInt( MD5_BINARY_VERSION );
+	f.WriteInt( MD5_VERSION );
+	f.WriteInt( sizeof( idJointQuat ) );
+	f.WriteInt( sizeof( idJointMat ) );
+	f.WriteInt( textLength );
+	f.Write( &timeStamp, sizeof( timeStamp ) );
+
+	f.WriteInt( joints.Num() );
+	f.WriteInt( meshes.Num() );
+	for ( i = 0; i < joints.Num(); i++ ) {
+		f.WriteString( joints[i].name );
+		f.WriteInt( joints[i].parent ? joints[i].parent - joints.Ptr() : -1 );
+	}
+	f.Write( defaultPose.Ptr(), defaultPose.Num() * sizeof( defaultPose[0] ) );
+	f.Write( poseMat3, joints.Num() * sizeof( poseMat3[0] ) );
+
+	for ( i = 0; i < meshes.Num(); i++ ) {
+		meshes[i].WriteBinaryMesh( &f, meshTris[i] );
+	}
+
+	fileSystem->WriteFile( fileName, f.GetDataPtr(), f.Length() );
+}
+
+/*
+====================
+idRenderModelMD5::LoadBinaryModel
+
+Returns false if the binary file is missing, out of date or damaged, the model
+must be loaded from the text file then.
+====================
+*/
+bool idRenderModelMD5::LoadBinaryModel( const char *fileName, int textLength ) {
+	const char	*buffer;
+	int			i, length, version, md5Version, jointQuatSize, jointMatSize, fileTextLength, numJoints, numMeshes, parentNum;
+	ID_TIME_T	fileTimeStamp;
+	char		id[4];
+	idJointMat	*poseMat3;
+	idList<int>	tris;
+
+	length = fileSystem->ReadFileMapped( fileName, (const void **)&buffer, NULL );
+	if ( length < 0 || !buffer ) {
+		return false;
+	}
+
+	idFile_Memory f( fileName, buffer, length );
+
+	f.Read( id, sizeof( id ) );
+	f.ReadInt( version );
+	f.ReadInt( md5Version );
+	f.ReadInt( jointQuatSize );
+	f.ReadInt( jointMatSize );
+	f.ReadInt( fileTextLength );
+	f.Read( &fileTimeStamp, sizeof( fileTimeStamp ) );
+	if ( memcmp( id, MD5_MESH_BINARY_ID, sizeof( id ) ) || version != MD5_BINARY_VERSION || md5Version != MD5_VERSION ||
+		jointQuatSize != sizeof( idJointQuat ) || jointMatSize != sizeof( idJointMat ) ||
+		fileTextLength != textLength || fileTimeStamp != timeStamp ) {
+		fileSystem->FreeFile( (void *)buffer );
+		return false;
+	}
+
+	f.ReadInt( numJoints );
+	f.ReadInt( numMeshes );
+	bool ok = ( numJoints > 0 && numMeshes >= 0 &&
+				(long long)numJoints * ( sizeof( idJointQuat ) + sizeof( idJointMat ) ) <= f.Length() - f.Tell() );
+
+	if ( ok ) {
+		joints.SetGranularity( 1 );
+		joints.SetNum( numJoints );
+		for ( i = 0; i < numJoints && ok; i++ ) {
+			f.ReadInt( length );
+			if ( length < 0 || length > f.Length() - f.Tell() ) {
+				ok = false;
+				break;
+			}
+			joints[i].name.Fill( ' ', length );
+			f.Read( &joints[i].name[0], length );
+			f.ReadInt( parentNum );
+			if ( parentNum >= i ) {
+				ok = false;
+				break;
+			}
+			joints[i].parent = ( parentNum < 0 ) ? NULL : &joints[ parentNum ];
+		}
+	}
+
+	if ( ok && (long long)numJoints * ( sizeof( idJointQuat ) + sizeof( idJointMat ) ) <= f.Length() - f.Tell() ) {
+		defaultPose.SetGranularity( 1 );
+		defaultPose.SetNum( numJoints );
+		f.Read( defaultPose.Ptr(), numJoints * sizeof( defaultPose[0] ) );
+		poseMat3 = ( idJointMat * )_alloca16( numJoints * sizeof( *poseMat3 ) );
+		f.Read( poseMat3, numJoints * sizeof( poseMat3[0] ) );
+
+		meshes.SetGranularity( 1 );
+		meshes.SetNum( numMeshes );
+		for ( i = 0; i < numMeshes && ok; i++ ) {
+			ok = meshes[i].ReadBinaryMesh( &f, numJoints, tris );
+			if ( ok ) {
+				meshes[i].FinishMesh( tris, poseMat3 );
+			}
+		}
+		if ( ok ) {
+			CalculateBounds( poseMat3 );
+		}
+	} else {
+		ok = false;
+	}
+
+	fileSystem->FreeFile( (void *)buffer );
+
+	if ( !ok ) {
+		common->Warning( "%s is damaged, loading the text model", fileName );
+		PurgeModel();
+		purged = false;
+		return false;
+	}
+	return true;
 }
 
 /*
@@ -713,6 +964,24 @@ idRenderModelMD5::InstantiateDynamicModel
 ====================
 */
 idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEntity_s *ent, const struct viewDef_s *view, idRenderModel *cachedModel ) {
+	idRenderModelStatic *staticModel = PrepareDynamicModel( ent, view, cachedModel );
+
+	if ( staticModel != NULL ) {
+		DeformDynamicModel( ent, staticModel );
+	}
+
+	return staticModel;
+}
+
+/*
+====================
+idRenderModelMD5::PrepareDynamicModel
+
+The allocating part of InstantiateDynamicModel, which has to run on the main thread.
+Returns the snapshot with a prepared surface for each drawn mesh.
+====================
+*/
+idRenderModelStatic *idRenderModelMD5::PrepareDynamicModel( const struct renderEntity_s *ent, const struct viewDef_s *view, idRenderModel *cachedModel ) {
 	int					i, surfaceNum;
 	idMD5Mesh			*mesh;
 	idRenderModelStatic	*staticModel;
@@ -748,8 +1017,6 @@ idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 		staticModel->InitEmpty( MD5_SnapshotName );
 	}
 
-	staticModel->bounds.Clear();
-
 	if ( r_showSkel.GetInteger() ) {
 		if ( ( view != NULL ) && ( !r_skipSuppress.GetBool() || !ent->suppressSurfaceInViewID || ( ent->suppressSurfaceInViewID != view->renderView.viewID ) ) ) {
 			// only draw the skeleton
@@ -794,13 +1061,38 @@ idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 			surf->id = i;
 		}
 
-		mesh->UpdateSurface( ent, ent->joints, surf );
+		mesh->PrepareSurface( surf );
+	}
+
+	return staticModel;
+}
+
+/*
+====================
+idRenderModelMD5::DeformDynamicModel
+
+Skins the surfaces of a snapshot returned by PrepareDynamicModel. The surfaces
+are looked up by id, since the surfaceNum of the shared meshes belongs to the
+last prepared snapshot, which makes this safe to run on a worker thread.
+====================
+*/
+void idRenderModelMD5::DeformDynamicModel( const struct renderEntity_s *ent, idRenderModelStatic *staticModel ) {
+	int			i, surfaceNum;
+	idMD5Mesh	*mesh;
+
+	staticModel->bounds.Clear();
+
+	for( mesh = meshes.Ptr(), i = 0; i < meshes.Num(); i++, mesh++ ) {
+		if ( !staticModel->FindSurfaceWithId( i, surfaceNum ) ) {
+			continue;
+		}
+		modelSurface_t *surf = &staticModel->surfaces[surfaceNum];
+
+		mesh->DeformSurface( ent, ent->joints, surf );
 
 		staticModel->bounds.AddPoint( surf->geometry->bounds[0] );
 		staticModel->bounds.AddPoint( surf->geometry->bounds[1] );
 	}
-
-	return staticModel;
 }
 
 /*
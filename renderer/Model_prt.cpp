@@ -64,6 +64,25 @@ idRenderModelPrt::InstantiateDynamicModel
 ====================
 */
 idRenderModel *idRenderModelPrt::InstantiateDynamicModel( const struct renderEntity_s *renderEntity, const struct viewDef_s *viewDef, idRenderModel *cachedModel ) {
+	idRenderModelStatic *staticModel = PrepareDynamicModel( renderEntity, viewDef, cachedModel );
+
+	if ( staticModel != NULL ) {
+		GenerateDynamicModel( renderEntity, viewDef, staticModel );
+	}
+
+	return staticModel;
+}
+
+/*
+====================
+idRenderModelPrt::PrepareDynamicModel
+
+The allocating part of InstantiateDynamicModel, which has to run on the main thread.
+Returns the snapshot with a surface for each drawn stage, big enough for all of its
+particles. The quad indexes never change, so they are only built with the surface.
+====================
+*/
+idRenderModelStatic *idRenderModelPrt::PrepareDynamicModel( const struct renderEntity_s *renderEntity, const struct viewDef_s *viewDef, idRenderModel *cachedModel ) {
 	idRenderModelStatic	*staticModel;
 
 	if ( cachedModel && !r_useCachedDynamicModels.GetBool() ) {
@@ -100,13 +119,6 @@ idRenderModel *idRenderModelPrt::InstantiateDynamicModel( const struct renderEnt
 		staticModel->InitEmpty( parametricParticle_SnapshotName );
 	}
 
-	particleGen_t g;
-
-	g.renderEnt = renderEntity;
-	g.renderView = &viewDef->renderView;
-	g.origin.Zero();
-	g.axis.Identity();
-
 	for ( int stageNum = 0; stageNum < particleSystem->stages.Num(); stageNum++ ) {
 		idParticleStage *stage = particleSystem->stages[stageNum];
 
@@ -118,9 +130,6 @@ idRenderModel *idRenderModelPrt::InstantiateDynamicModel( const struct renderEnt
 			continue;
 		}
 
-		const int stageAge = g.renderView->time + (renderEntity->shaderParms[SHADERPARM_TIMEOFFSET] - stage->timeOffset) * 1000;
-		const int stageCycle = stageAge / stage->cycleMsec;
-
 		const int	count = stage->totalParticles * stage->NumQuadsPerParticle();
 
 		int surfaceNum = 0;
@@ -137,7 +146,57 @@ idRenderModel *idRenderModelPrt::InstantiateDynamicModel( const struct renderEnt
 			R_AllocStaticTriSurfVerts( surf->geometry, 4 * count );
 			R_AllocStaticTriSurfIndexes( surf->geometry, 6 * count );
 			R_AllocStaticTriSurfPlanes( surf->geometry, 6 * count );
+
+			// build the indexes, the drawn particles use the first ones
+			glIndex_t *indexes = surf->geometry->indexes;
+			for ( int i = 0; i < 4 * count; i += 4 ) {
+				indexes[0] = i;
+				indexes[1] = i+2;
+				indexes[2] = i+3;
+				indexes[3] = i;
+				indexes[4] = i+3;
+				indexes[5] = i+1;
+				indexes += 6;
+			}
 		}
+	}
+
+	return staticModel;
+}
+
+/*
+====================
+idRenderModelPrt::GenerateDynamicModel
+
+Creates the particle quads in the surfaces set up by PrepareDynamicModel. It only
+writes the vertexes of the snapshot, so the particles of different entities can be
+generated on several threads.
+====================
+*/
+void idRenderModelPrt::GenerateDynamicModel( const struct renderEntity_s *renderEntity, const struct viewDef_s *viewDef, idRenderModelStatic *staticModel ) {
+	particleGen_t g;
+
+	g.renderEnt = renderEntity;
+	g.renderView = &viewDef->renderView;
+	g.origin.Zero();
+	g.axis.Identity();
+
+	for ( int stageNum = 0; stageNum < particleSystem->stages.Num(); stageNum++ ) {
+		idParticleStage *stage = particleSystem->stages[stageNum];
+
+		if ( !stage->material || !stage->cycleMsec || stage->hidden ) {
+			continue;
+		}
+
+		int surfaceNum;
+		if ( !staticModel->FindSurfaceWithId( stageNum, surfaceNum ) ) {
+			continue;
+		}
+		modelSurface_t *surf = &staticModel->surfaces[surfaceNum];
+
+		const int stageAge = g.renderView->time + (renderEntity->shaderParms[SHADERPARM_TIMEOFFSET] - stage->timeOffset) * 1000;
+
+		const int	count = stage->totalParticles * stage->NumQuadsPerParticle();
 
 		int numVerts = 0;
 		idDrawVert *verts = surf->geometry->verts;
@@ -196,27 +255,12 @@ idRenderModel *idRenderModelPrt::InstantiateDynamicModel( const struct renderEnt
 		// numVerts must be a multiple of 4
 		assert( ( numVerts & 3 ) == 0 && numVerts <= 4 * count );
 
-		// build the indexes
-		int	numIndexes = 0;
-		glIndex_t *indexes = surf->geometry->indexes;
-		for ( int i = 0; i < numVerts; i += 4 ) {
-			indexes[numIndexes+0] = i;
-			indexes[numIndexes+1] = i+2;
-			indexes[numIndexes+2] = i+3;
-			indexes[numIndexes+3] = i;
-			indexes[numIndexes+4] = i+3;
-			indexes[numIndexes+5] = i+1;
-			numIndexes += 6;
-		}
-
 		surf->geometry->tangentsCalculated = false;
 		surf->geometry->facePlanesCalculated = false;
 		surf->geometry->numVerts = numVerts;
-		surf->geometry->numIndexes = numIndexes;
+		surf->geometry->numIndexes = numVerts / 4 * 6;
 		surf->geometry->bounds = stage->bounds;		// just always draw the particles
 	}
-
-	return staticModel;
 }
 
 /*
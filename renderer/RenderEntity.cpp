@@ -35,6 +35,8 @@ idRenderEntityLocal::idRenderEntityLocal() {
 	dynamicModel			= NULL;
 	dynamicModelFrameCount	= 0;
 	cachedDynamicModel		= NULL;
+	dynamicModelJointsCrc	= 0;
+	checkDynamicModelJoints	= false;
 	referenceBounds			= bounds_zero;
 	globalReferenceBounds	= bounds_zero; //anon
 	viewCount = 0;
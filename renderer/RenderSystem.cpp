@@ -52,9 +52,17 @@ static void R_PerformanceCounters( void ) {
 				backEnd.pc.c_shadowVertexes,
 				megaBytes
 				);
+			common->Printf( "state changes - textures:%i glState:%i buffers:%i spaces:%i\n",
+				backEnd.pc.c_textureBinds,
+				backEnd.pc.c_glStateChanges,
+				backEnd.pc.c_bufferBinds,
+				backEnd.pc.c_spaceChanges
+				);
 		} else {
-			common->Printf( "views:%i draws:%i tris:%i (shdw:%i) (vbo:%i) image:%5.1f MB\n",
+			common->Printf( "views:%i (remote:%i kept:%i) draws:%i tris:%i (shdw:%i) (vbo:%i) image:%5.1f MB\n",
 				tr.pc.c_numViews,
+				tr.pc.c_remoteRenders,
+				tr.pc.c_remoteRendersReused,
 				backEnd.pc.c_drawElements + backEnd.pc.c_shadowElements,
 				( backEnd.pc.c_drawIndexes + backEnd.pc.c_shadowIndexes ) / 3,
 				backEnd.pc.c_shadowIndexes / 3,
@@ -110,6 +118,33 @@ static void R_PerformanceCounters( void ) {
 	memset( &backEnd.pc, 0, sizeof( backEnd.pc ) );
 }
 
+/*
+=====================
+R_DrawGpuTimes
+
+Lists the GPU msecs of the back end stages in the top right corner
+=====================
+*/
+static void R_DrawGpuTimes( void ) {
+	const idMaterial *charSet = declManager->FindMaterial( "textures/bigchars" );
+	const int x = SCREEN_WIDTH - 22 * SMALLCHAR_WIDTH;
+	int y = 40;
+
+	if ( !glConfig.timerQueryAvailable ) {
+		tr.DrawSmallStringExt( x, y, "no GL_ARB_timer_query", colorWhite, true, charSet );
+		return;
+	}
+
+	// copy, the back end may write a new frame meanwhile
+	const gpuTimes_t times = gpuTimes;
+	tr.DrawSmallStringExt( x, y, va( "gpu %13.2f ms", times.totalMsec ), colorWhite, true, charSet );
+	y += SMALLCHAR_HEIGHT;
+	for ( int i = 0 ; i < NUM_GPU_TIMES ; i++ ) {
+		tr.DrawSmallStringExt( x, y, va( "%-13s %6.2f ms", gpuTimeNames[i], times.msec[i] ), colorWhite, true, charSet );
+		y += SMALLCHAR_HEIGHT;
+	}
+}
+
 
 
 /*
@@ -117,9 +152,15 @@ static void R_PerformanceCounters( void ) {
 R_IssueRenderCommands
 
 Called by R_EndFrame each frame
+
+With a render thread running, the commands are handed over to it
+and this returns right away, unless synchronous is set because the
+caller is going to read back the results.  In that case the commands
+are executed here in the back end context, which stays current
+until the next asynchronous issue.
 ====================
 */
-static void R_IssueRenderCommands( void ) {
+static void R_IssueRenderCommands( bool synchronous = false ) {
 	if ( frameData->cmdHead->commandId == RC_NOP
 		&& !frameData->cmdHead->next ) {
 		// nothing to issue
@@ -134,7 +175,39 @@ static void R_IssueRenderCommands( void ) {
 
 	// r_skipRender is usually more usefull, because it will still
 	// draw 2D graphics
-	if ( !r_skipBackEnd.GetBool() ) {
+	if ( glConfig.smpActive ) {
+		// the back end must be done with the previous commands
+		GLimp_FrontEndSleep();
+	}
+
+	// with the back end idle the streamed images can be uploaded from here
+	globalImages->UpdateStreamedImages();
+
+	// the back end can't draw from the frame temp buffer while it's mapped
+	vertexCache.UnmapFrameTemp();
+
+	if ( glConfig.smpActive ) {
+		if ( synchronous ) {
+			GLimp_ActivateBackEndContext();
+			if ( !r_skipBackEnd.GetBool() ) {
+				RB_ExecuteBackEndCommands( frameData->cmdHead );
+			}
+		} else {
+			GLimp_DeactivateBackEndContext();
+
+			// make the front end uploads visible to the back end context
+			qglFlush();
+
+			if ( !r_skipBackEnd.GetBool() ) {
+				GLimp_WakeBackEnd( (void *)frameData->cmdHead );
+			}
+
+			// r_lockSurfaces keeps reusing the same frame data
+			if ( r_lockSurfaces.GetBool() ) {
+				R_SyncRenderThread();
+			}
+		}
+	} else if ( !r_skipBackEnd.GetBool() ) {
 		RB_ExecuteBackEndCommands( frameData->cmdHead );
 	}
 
@@ -295,8 +368,8 @@ idRenderSystemLocal::~idRenderSystemLocal
 
 idRenderSystemLocal::~idRenderSystemLocal( void ) {
 	// #4395: Duzenko lightem pixel pack buffer optimization
-	/*if (pbo && qglDeleteBuffersARB) // crashes on linux, never called on windows, needs to be moved to a better place or removed at all
-		qglDeleteBuffersARB(1, &pbo);*/
+	/*if (pbo[0] && qglDeleteBuffersARB) // crashes on linux, never called on windows, needs to be moved to a better place or removed at all
+		qglDeleteBuffersARB(MAX_CAPTURE_SLOTS, pbo);*/
 }
 
 /*
@@ -354,6 +427,33 @@ void idRenderSystemLocal::DrawStretchTri( idVec2 p1, idVec2 p2, idVec2 p3, idVec
 	tr.guiModel->DrawStretchTri( p1, p2, p3, t1, t2, t3, material );
 }
 
+/*
+=============
+BeginGuiCapture
+=============
+*/
+void idRenderSystemLocal::BeginGuiCapture( guiCapture_t &capture ) {
+	guiModel->BeginCapture( capture );
+}
+
+/*
+=============
+EndGuiCapture
+=============
+*/
+bool idRenderSystemLocal::EndGuiCapture( guiCapture_t &capture ) {
+	return guiModel->EndCapture( capture );
+}
+
+/*
+=============
+DrawGuiCapture
+=============
+*/
+void idRenderSystemLocal::DrawGuiCapture( const guiCapture_t &capture ) {
+	guiModel->DrawCapture( capture );
+}
+
 /*
 =============
 GlobalToNormalizedDeviceCoordinates
@@ -715,6 +815,10 @@ void idRenderSystemLocal::EndFrame( int *frontEndMsec, int *backEndMsec ) {
 		return;
 	}
 
+	if ( r_showGpuTimes.GetBool() ) {
+		R_DrawGpuTimes();
+	}
+
 	// close any gui drawing
 	guiModel->EmitFullScreen();
 	guiModel->Clear();
@@ -976,7 +1080,7 @@ void idRenderSystemLocal::CaptureRenderToFile( const char *fileName, bool fixAlp
 
 	guiModel->EmitFullScreen();
 	guiModel->Clear();
-	R_IssueRenderCommands();
+	R_IssueRenderCommands( true );
 
 	if (!r_useFbo.GetBool()) // duzenko #4425: not applicable, raises gl errors
 		qglReadBuffer(GL_BACK);
@@ -1013,48 +1117,65 @@ void idRenderSystemLocal::CaptureRenderToFile( const char *fileName, bool fixAlp
 	R_StaticFree( data2 );
 }
 
-void idRenderSystemLocal::CaptureRenderToBuffer(unsigned char* buffer)
+bool idRenderSystemLocal::CaptureRenderToBuffer(unsigned char* buffer, int slot)
 {
 	if ( !glConfig.isInitialized ) {
-		return;
+		return false;
 	}
 
 	renderCrop_t *rc = &renderCrops[currentRenderCrop];
 
 	guiModel->EmitFullScreen();
 	guiModel->Clear();
-	R_IssueRenderCommands();
+	R_IssueRenderCommands( true );
 
 	int backEndStartTime = Sys_Milliseconds();
 	if (!r_useFbo.GetBool()) // duzenko #4425: not applicable, raises gl errors
 		qglReadBuffer(GL_BACK);
 
+	bool written = false;
+
 // #4395 Duzenko lightem pixel pack buffer optimization
-	if (glConfig.pixelBufferAvailable) {
-		static int nbytes = 64 * 64 * 3;
-		if (!pbo) {
-			qglGenBuffersARB(1, &pbo);
-			qglBindBufferARB(GL_PIXEL_PACK_BUFFER, pbo);
+	if ( glConfig.pixelBufferAvailable && slot >= 0 && slot < MAX_CAPTURE_SLOTS ) {
+		const int nbytes = rc->width * rc->height * 3;
+		if (!pbo[slot]) {
+			qglGenBuffersARB(1, &pbo[slot]);
+			qglBindBufferARB(GL_PIXEL_PACK_BUFFER, pbo[slot]);
 			qglBufferDataARB(GL_PIXEL_PACK_BUFFER, nbytes, NULL, GL_STREAM_READ);
 			qglBindBufferARB(GL_PIXEL_PACK_BUFFER, 0);
+			pboQueued[slot] = false;
 		}
-		qglBindBufferARB(GL_PIXEL_PACK_BUFFER, pbo);
-		unsigned char* ptr = (unsigned char*)qglMapBufferARB(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-		if (ptr) {
-			memcpy(buffer, ptr, nbytes);
-			qglUnmapBufferARB(GL_PIXEL_PACK_BUFFER);
+		qglBindBufferARB(GL_PIXEL_PACK_BUFFER, pbo[slot]);
+		// the read back queued on the previous call for this slot, a frame or more
+		// ago, so the GPU should be done with it by now and mapping won't stall
+		if ( pboQueued[slot] ) {
+			unsigned char* ptr = (unsigned char*)qglMapBufferARB(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+			if (ptr) {
+				memcpy(buffer, ptr, nbytes);
+				qglUnmapBufferARB(GL_PIXEL_PACK_BUFFER);
+				written = true;
+			}
+			else {
+				// #4395 vid_restart ?
+				pbo[slot] = 0;
+			}
 		}
-		else {
-			// #4395 vid_restart ?
-            pbo = 0;
+		if ( pbo[slot] ) {
+			// the crop size may have changed since the buffer was created
+			qglBufferDataARB(GL_PIXEL_PACK_BUFFER, nbytes, NULL, GL_STREAM_READ);
+			qglReadPixels(rc->x, rc->y, rc->width, rc->height, GL_RGB, GL_UNSIGNED_BYTE, 0);
+			//qglReadPixels(rc->x, rc->y, rc->width, rc->height, GL_RGB, r_fboColorBits.GetInteger() == 15 ? GL_UNSIGNED_SHORT_5_5_5_1 : GL_UNSIGNED_BYTE, 0);
 		}
-		qglReadPixels(rc->x, rc->y, rc->width, rc->height, GL_RGB, GL_UNSIGNED_BYTE, 0);
-		//qglReadPixels(rc->x, rc->y, rc->width, rc->height, GL_RGB, r_fboColorBits.GetInteger() == 15 ? GL_UNSIGNED_SHORT_5_5_5_1 : GL_UNSIGNED_BYTE, 0);
+		pboQueued[slot] = pbo[slot] != 0;
 		qglBindBufferARB(GL_PIXEL_PACK_BUFFER, 0);
-	} else
+	} else {
 		qglReadPixels(rc->x, rc->y, rc->width, rc->height, GL_RGB, GL_UNSIGNED_BYTE, buffer);
+		written = true;
+	}
 	int backEndFinishTime = Sys_Milliseconds();
 	backEnd.pc.msec += backEndFinishTime - backEndStartTime;
+
+	return written;
 }
 
 /*
@@ -1075,6 +1196,8 @@ FreeRenderWorld
 ==============
 */
 void idRenderSystemLocal::FreeRenderWorld( idRenderWorld *rw ) {
+	R_SyncRenderThread();
+
 	if ( primaryWorld == rw ) {
 		primaryWorld = NULL;
 	}
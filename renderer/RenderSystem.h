@@ -52,6 +52,7 @@ typedef struct glconfig_s {
 
 	bool				multitextureAvailable;
 	bool				textureCompressionAvailable;
+	bool				textureCompressionLATCAvailable;	// bc5 normal maps, see image_useNormalCompression
 	bool				anisotropicAvailable;
 	bool				textureLODBiasAvailable;
 	bool				textureEnvAddAvailable;
@@ -69,6 +70,11 @@ typedef struct glconfig_s {
 	bool				depthBoundsTestAvailable;
 	bool				atiFragmentShaderAvailable; // ati r200 extensions
 	bool				pixelBufferAvailable;
+	bool				framebufferObjectAvailable;
+	bool				occlusionQueryAvailable;
+	bool				timerQueryAvailable;
+
+	bool				smpActive;				// back end runs on its own thread (r_useSMP)
 
 	int					vidWidth, vidHeight;	// passed to R_BeginFrame
 	int					displayFrequency;
@@ -137,6 +143,25 @@ typedef struct {
 	char				name[64];
 } fontInfoEx_t;
 
+// 2D drawing recorded by the render system, so a gui window that didn't
+// change can add the same surfaces again without generating them
+typedef struct {
+	const idMaterial *	material;
+	float				color[4];
+	int					numVerts;
+	int					numIndexes;
+} guiCaptureSurface_t;
+
+typedef struct {
+	idList<guiCaptureSurface_t>	surfaces;
+	idList<idDrawVert>	verts;
+	idList<glIndex_t>	indexes;				// relative to the first vert of their surface
+	int					startSurface;			// gui model state at BeginGuiCapture
+	int					startVert;
+	int					startIndex;
+	int					startClearCount;
+} guiCapture_t;
+
 class idRenderWorld;
 
 
@@ -183,6 +208,14 @@ public:
 	virtual void			DrawStretchPic( float x, float y, float w, float h, float s1, float t1, float s2, float t2, const idMaterial *material ) = 0;
 
 	virtual void			DrawStretchTri ( idVec2 p1, idVec2 p2, idVec2 p3, idVec2 t1, idVec2 t2, idVec2 t3, const idMaterial *material ) = 0;
+
+	// everything drawn between BeginGuiCapture and EndGuiCapture is copied to the capture,
+	// EndGuiCapture returns false if it couldn't be, because the 2D drawing was flushed
+	// in between. DrawGuiCapture draws it again.
+	virtual void			BeginGuiCapture( guiCapture_t &capture ) = 0;
+	virtual bool			EndGuiCapture( guiCapture_t &capture ) = 0;
+	virtual void			DrawGuiCapture( const guiCapture_t &capture ) = 0;
+
 	virtual void			GlobalToNormalizedDeviceCoordinates( const idVec3 &global, idVec3 &ndc ) = 0;
 	virtual void			GetGLSettings( int& width, int& height ) = 0;
 	virtual void			PrintMemInfo( MemInfo_t *mi ) = 0;
@@ -244,8 +277,12 @@ public:
 	 * The buffer is managed by the calling code and needs to provide space for the current rendercrop's 
 	 * size using 3 bytes per pixel (stored in order RGB). Use CropRenderSize(), then GetCurrentRenderCropSize() 
 	 * to receive the necessary size.
+	 *
+	 * With a slot >= 0 the read back is asynchronous if pixel buffers are available: it is queued
+	 * into the slot's pixel buffer, and the buffer receives what was queued into the same slot
+	 * on the previous call instead. Returns false if nothing was written to the buffer.
 	 */
-	virtual void			CaptureRenderToBuffer(unsigned char* buffer) = 0;
+	virtual bool			CaptureRenderToBuffer(unsigned char* buffer, int slot = -1) = 0;
 
 	virtual void			UnCrop() = 0;
 	virtual void			GetCardCaps( bool &oldCard, bool &nv10or20 ) = 0;
@@ -49,22 +49,31 @@ idCVar r_checkBounds( "r_checkBounds", "0", CVAR_RENDERER | CVAR_BOOL, "compare
 
 idCVar r_useNV20MonoLights( "r_useNV20MonoLights", "1", CVAR_RENDERER | CVAR_INTEGER, "use pass optimization for mono lights" );
 idCVar r_useConstantMaterials( "r_useConstantMaterials", "1", CVAR_RENDERER | CVAR_BOOL, "use pre-calculated material registers if possible" );
+idCVar r_useMaterialRegisterCache( "r_useMaterialRegisterCache", "1", CVAR_RENDERER | CVAR_BOOL, "evaluate the registers of a material once per view for all surfaces with the same time and shader parms" );
 idCVar r_useTripleTextureARB( "r_useTripleTextureARB", "1", CVAR_RENDERER | CVAR_BOOL, "cards with 3+ texture units do a two pass instead of three pass" );
 idCVar r_useSilRemap( "r_useSilRemap", "1", CVAR_RENDERER | CVAR_BOOL, "consider verts with the same XYZ, but different ST the same for shadows" );
 idCVar r_useNodeCommonChildren( "r_useNodeCommonChildren", "1", CVAR_RENDERER | CVAR_BOOL, "stop pushing reference bounds early when possible" );
 idCVar r_useShadowProjectedCull( "r_useShadowProjectedCull", "1", CVAR_RENDERER | CVAR_BOOL, "discard triangles outside light volume before shadowing" );
 idCVar r_useShadowVertexProgram( "r_useShadowVertexProgram", "1", CVAR_RENDERER | CVAR_BOOL, "do the shadow projection in the vertex program on capable cards" );
 idCVar r_useShadowSurfaceScissor( "r_useShadowSurfaceScissor", "1", CVAR_RENDERER | CVAR_BOOL, "scissor shadows by the scissor rect of the interaction surfaces" );
-idCVar r_useInteractionTable( "r_useInteractionTable", "1", CVAR_RENDERER | CVAR_BOOL, "create a full entityDefs * lightDefs table to make finding interactions faster" );
+idCVar r_useInteractionTable( "r_useInteractionTable", "1", CVAR_RENDERER | CVAR_BOOL, "use a hash of all light / entity interactions to make finding interactions faster" );
 idCVar r_useTurboShadow( "r_useTurboShadow", "1", CVAR_RENDERER | CVAR_BOOL, "use the infinite projection with W technique for dynamic shadows" );
+idCVar r_useParallelInteractions( "r_useParallelInteractions", "1", CVAR_RENDERER | CVAR_BOOL, "create the light and shadow surfaces of new interactions on several threads, needs an OpenMP build and r_useTurboShadow" );
+idCVar r_useParallelSkinning( "r_useParallelSkinning", "1", CVAR_RENDERER | CVAR_BOOL, "skin the md5 models of the view entities on several threads before their surfaces are added, needs an OpenMP build" );
+idCVar r_useParallelParticles( "r_useParallelParticles", "1", CVAR_RENDERER | CVAR_BOOL, "generate the particle quads of the view entities on several threads before their surfaces are added, needs an OpenMP build" );
+idCVar r_useParallelDecals( "r_useParallelDecals", "1", CVAR_RENDERER | CVAR_BOOL, "clip the queued decal projections of the view entities on several threads before their surfaces are added, needs an OpenMP build" );
+idCVar r_cinematicDecodeAhead( "r_cinematicDecodeAhead", "1", CVAR_RENDERER | CVAR_BOOL, "decode the next frame of a playing cinematic on a worker thread while the current one is drawn" );
+idCVar r_cinematicPauseHidden( "r_cinematicPauseHidden", "1", CVAR_RENDERER | CVAR_BOOL, "pause cinematics that weren't drawn for a while, instead of decoding all the frames they missed when they come back into view" );
 idCVar r_useTwoSidedStencil( "r_useTwoSidedStencil", "1", CVAR_RENDERER | CVAR_BOOL, "do stencil shadows in one pass with different ops on each side" );
 idCVar r_useDeferredTangents( "r_useDeferredTangents", "1", CVAR_RENDERER | CVAR_BOOL, "defer tangents calculations after deform" );
 idCVar r_useCachedDynamicModels( "r_useCachedDynamicModels", "1", CVAR_RENDERER | CVAR_BOOL, "cache snapshots of dynamic models" );
+idCVar r_useDeformCache( "r_useDeformCache", "1", CVAR_RENDERER | CVAR_BOOL, "keep the results of expand, move and turbulent deforms on static surfaces while their parameters don't change" );
 
 idCVar r_useVertexBuffers( "r_useVertexBuffers", "1", CVAR_RENDERER | CVAR_INTEGER, "use ARB_vertex_buffer_object for vertexes", 0, 1, idCmdSystem::ArgCompletion_Integer<0,1>  );
 // Serp - Enabled IndexBuffers by default, increases performance - however untested on a wide range of hardware.
-idCVar r_useIndexBuffers( "r_useIndexBuffers", "0", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_INTEGER, "use ARB_vertex_buffer_object for indexes", 0, 1, idCmdSystem::ArgCompletion_Integer<0,1>  );
+idCVar r_useIndexBuffers( "r_useIndexBuffers", "1", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_INTEGER, "use ARB_vertex_buffer_object for indexes", 0, 1, idCmdSystem::ArgCompletion_Integer<0,1>  );
 
+idCVar r_useSMP( "r_useSMP", "0", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_BOOL, "run the back end on its own thread, requires vid_restart" );
 idCVar r_useStateCaching( "r_useStateCaching", "1", CVAR_RENDERER | CVAR_BOOL, "avoid redundant state changes in GL_*() calls" );
 idCVar r_useInfiniteFarZ( "r_useInfiniteFarZ", "1", CVAR_RENDERER | CVAR_BOOL, "use the no-far-clip-plane trick" );
 
@@ -103,6 +112,7 @@ idCVar r_skipSpecular( "r_skipSpecular", "0", CVAR_RENDERER | CVAR_BOOL | CVAR_C
 idCVar r_skipBump( "r_skipBump", "0", CVAR_RENDERER | CVAR_BOOL | CVAR_ARCHIVE, "uses a flat surface instead of the bump map" );
 idCVar r_skipDiffuse( "r_skipDiffuse", "0", CVAR_RENDERER | CVAR_BOOL, "use black for diffuse" );
 idCVar r_skipROQ( "r_skipROQ", "0", CVAR_RENDERER | CVAR_BOOL, "skip ROQ decoding" );
+idCVar r_skipUnusedDepthCapture( "r_skipUnusedDepthCapture", "1", CVAR_RENDERER | CVAR_BOOL, "only capture the depth buffer for views with soft particles or materials that sample _currentDepth" );
 idCVar r_skipDepthCapture( "r_skipDepthCapture", "0", CVAR_RENDERER | CVAR_BOOL | CVAR_ARCHIVE, "skip depth capture" ); // #3877 #4418
 idCVar r_useSoftParticles( "r_useSoftParticles", "1", CVAR_RENDERER | CVAR_BOOL | CVAR_ARCHIVE, "soften particle transitions when player walks through them or they cross solid geometry" ); // #3878 #4418
 
@@ -118,6 +128,9 @@ idCVar r_useEntityPortalCulling("r_useEntityPortalCulling", "1", CVAR_RENDERER |
 //anon end
 idCVar r_useClippedLightScissors("r_useClippedLightScissors", "1", CVAR_RENDERER | CVAR_INTEGER, "0 = full screen when near clipped, 1 = exact when near clipped, 2 = exact always", 0, 2, idCmdSystem::ArgCompletion_Integer<0, 2>);
 idCVar r_useEntityCulling( "r_useEntityCulling", "1", CVAR_RENDERER | CVAR_BOOL, "0 = none, 1 = box" );
+idCVar r_useBatchPortalCulling( "r_useBatchPortalCulling", "1", CVAR_RENDERER | CVAR_BOOL, "box test all entities and lights of an area against the portal planes at once before the exact culling" );
+idCVar r_useBatchBoxCulling( "r_useBatchBoxCulling", "1", CVAR_RENDERER | CVAR_BOOL, "box test all surfaces of an interaction against the light or view frustum at once in model space" );
+idCVar r_modelResidencyMegs( "r_modelResidencyMegs", "64", CVAR_RENDERER | CVAR_ARCHIVE | CVAR_FLOAT, "MB the models of earlier levels may keep after a level load, the least recently used ones are purged first" );
 idCVar r_useEntityScissors( "r_useEntityScissors", "0", CVAR_RENDERER | CVAR_BOOL, "1 = use custom scissor rectangle for each entity" );
 idCVar r_useInteractionCulling( "r_useInteractionCulling", "1", CVAR_RENDERER | CVAR_BOOL, "1 = cull interactions" );
 idCVar r_useInteractionScissors( "r_useInteractionScissors", "2", CVAR_RENDERER | CVAR_INTEGER, "1 = use a custom scissor rectangle for each shadow interaction, 2 = also crop using portal scissors", -2, 2, idCmdSystem::ArgCompletion_Integer<-2,2> );
@@ -131,6 +144,9 @@ idCVar r_shadowPolygonOffset( "r_shadowPolygonOffset", "-1", CVAR_RENDERER | CVA
 idCVar r_shadowPolygonFactor( "r_shadowPolygonFactor", "0", CVAR_RENDERER | CVAR_FLOAT, "scale value for stencil shadow drawing" );
 idCVar r_frontBuffer( "r_frontBuffer", "0", CVAR_RENDERER | CVAR_BOOL, "draw to front buffer for debugging" );
 idCVar r_skipSubviews( "r_skipSubviews", "0", CVAR_RENDERER | CVAR_INTEGER, "1 = don't render any gui elements on surfaces" );
+idCVar r_remoteRenderInterval( "r_remoteRenderInterval", "0", CVAR_RENDERER | CVAR_INTEGER | CVAR_ARCHIVE, "msec a remote camera view is shown before it is rendered again, 0 = every frame" );
+idCVar r_remoteRenderScale( "r_remoteRenderScale", "1", CVAR_RENDERER | CVAR_FLOAT | CVAR_ARCHIVE, "resolution scale of remote camera views", 0.125f, 1.0f );
+idCVar r_useGuiBatching( "r_useGuiBatching", "1", CVAR_RENDERER | CVAR_BOOL, "draw gui surfaces with the same material and color together when nothing drawn between them overlaps" );
 idCVar r_skipGuiShaders( "r_skipGuiShaders", "0", CVAR_RENDERER | CVAR_INTEGER, "1 = skip all gui elements on surfaces, 2 = skip drawing but still handle events, 3 = draw but skip events", 0, 3, idCmdSystem::ArgCompletion_Integer<0,3> );
 idCVar r_skipParticles( "r_skipParticles", "0", CVAR_RENDERER | CVAR_INTEGER, "1 = skip all particle systems", 0, 1, idCmdSystem::ArgCompletion_Integer<0,1> );
 idCVar r_subviewOnly( "r_subviewOnly", "0", CVAR_RENDERER | CVAR_BOOL, "1 = don't render main view, allowing subviews to be debugged" );
@@ -147,7 +163,11 @@ idCVar r_useExternalShadows( "r_useExternalShadows", "1", CVAR_RENDERER | CVAR_I
 idCVar r_useOptimizedShadows( "r_useOptimizedShadows", "1", CVAR_RENDERER | CVAR_BOOL, "use the dmap generated static shadow volumes" );
 idCVar r_useScissor( "r_useScissor", "1", CVAR_RENDERER | CVAR_BOOL, "scissor clip as portals and lights are processed" );
 idCVar r_useCombinerDisplayLists( "r_useCombinerDisplayLists", "1", CVAR_RENDERER | CVAR_BOOL | CVAR_NOCHEAT, "put all nvidia register combiner programming in display lists" );
+idCVar r_useOcclusionQueries( "r_useOcclusionQueries", "1", CVAR_RENDERER | CVAR_BOOL, "skip lights whose volume an occlusion query found hidden behind the depth buffer of a recent frame" );
 idCVar r_useDepthBoundsTest( "r_useDepthBoundsTest", "1", CVAR_RENDERER | CVAR_BOOL, "use depth bounds test to reduce shadow fill" );
+idCVar r_useShadowMaps( "r_useShadowMaps", "1", CVAR_RENDERER | CVAR_INTEGER | CVAR_ARCHIVE, "0 = stencil shadow volumes only, 1 = shadow maps for lights with the shadowmap spawnarg, 2 = shadow maps for all lights", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
+idCVar r_shadowMapSize( "r_shadowMapSize", "1024", CVAR_RENDERER | CVAR_INTEGER | CVAR_ARCHIVE, "size of the shadow map, and of each face of the point light shadow cube maps", 64, 4096 );
+idCVar r_shadowMapBias( "r_shadowMapBias", "0.005", CVAR_RENDERER | CVAR_FLOAT, "shadow map depth bias, as a fraction of the light range" );
 
 idCVar r_screenFraction( "r_screenFraction", "100", CVAR_RENDERER | CVAR_INTEGER, "for testing fill rate, the resolution of the entire screen can be changed" );
 idCVar r_demonstrateBug( "r_demonstrateBug", "0", CVAR_RENDERER | CVAR_BOOL, "used during development to show IHV's their problems" );
@@ -191,7 +211,8 @@ idCVar r_showCull( "r_showCull", "0", CVAR_RENDERER | CVAR_BOOL, "report sphere
 idCVar r_showInteractions( "r_showInteractions", "0", CVAR_RENDERER | CVAR_BOOL, "report interaction generation activity" );
 idCVar r_showDepth( "r_showDepth", "0", CVAR_RENDERER | CVAR_BOOL, "display the contents of the depth buffer and the depth range" );
 idCVar r_showSurfaces( "r_showSurfaces", "0", CVAR_RENDERER | CVAR_BOOL, "report surface/light/shadow counts" );
-idCVar r_showPrimitives( "r_showPrimitives", "0", CVAR_RENDERER | CVAR_INTEGER, "report drawsurf/index/vertex counts" );
+idCVar r_showGpuTimes( "r_showGpuTimes", "0", CVAR_RENDERER | CVAR_BOOL, "time the back end stages with GL timestamp queries and show the GPU msecs of each, they trail the frame by a few frames" );
+idCVar r_showPrimitives( "r_showPrimitives", "0", CVAR_RENDERER | CVAR_INTEGER, "report drawsurf/index/vertex counts, 2 = also detailed counts and back end state changes" );
 idCVar r_showEdges( "r_showEdges", "0", CVAR_RENDERER | CVAR_BOOL, "draw the sil edges" );
 idCVar r_showTexturePolarity( "r_showTexturePolarity", "0", CVAR_RENDERER | CVAR_BOOL, "shade triangles by texture area polarity" );
 idCVar r_showTangentSpace( "r_showTangentSpace", "0", CVAR_RENDERER | CVAR_INTEGER, "shade triangles by tangent space, 1 = use 1st tangent vector, 2 = use 2nd tangent vector, 3 = use normal vector", 0, 3, idCmdSystem::ArgCompletion_Integer<0,3> );
@@ -201,6 +222,7 @@ idCVar r_showTextureVectors( "r_showTextureVectors", "0", CVAR_RENDERER | CVAR_F
 idCVar r_showOverDraw( "r_showOverDraw", "0", CVAR_RENDERER | CVAR_INTEGER, "1 = geometry overdraw, 2 = light interaction overdraw, 3 = geometry and light interaction overdraw", 0, 3, idCmdSystem::ArgCompletion_Integer<0,3> );
 
 idCVar r_lockSurfaces( "r_lockSurfaces", "0", CVAR_RENDERER | CVAR_BOOL, "allow moving the view point without changing the composition of the scene, including culling" );
+idCVar r_useJointsCrc( "r_useJointsCrc", "1", CVAR_RENDERER | CVAR_BOOL, "keep the dynamic model, interactions and shadow volumes of an animated model while its joints don't move" );
 idCVar r_useEntityCallbacks( "r_useEntityCallbacks", "1", CVAR_RENDERER | CVAR_BOOL, "if 0, issue the callback immediately at update time, rather than defering" );
 
 idCVar r_showSkel( "r_showSkel", "0", CVAR_RENDERER | CVAR_INTEGER, "draw the skeleton when model animates, 1 = draw model with skeleton, 2 = draw skeleton only", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
@@ -242,6 +264,8 @@ idCVar r_postprocess_bloomKernelSize( "r_postprocess_bloomKernelSize", "2", CVAR
 
 // late 2016 additions by duzenko
 idCVar r_useAnonreclaimer( "r_useAnonreclaimer", "0", CVAR_RENDERER | CVAR_BOOL, "test anonreclaimer patch" );
+idCVar r_useBinaryProc( "r_useBinaryProc", "1", CVAR_RENDERER | CVAR_BOOL, "load the world from the binary .procb next to the .proc and write it if it is missing or out of date" );
+idCVar r_useBinaryMD5( "r_useBinaryMD5", "1", CVAR_RENDERER | CVAR_BOOL, "load md5 meshes from the binary .md5meshb next to the .md5mesh and write it if it is missing or out of date" );
 idCVar r_useFbo("r_useFbo", "0", CVAR_RENDERER | CVAR_BOOL | CVAR_ARCHIVE, "Use framebuffer objects");
 idCVar r_fboDebug("r_fboDebug", "0", CVAR_RENDERER | CVAR_INTEGER, "0-3 individual fbo attachments");
 idCVar r_fboColorBits("r_fboColorBits", "32", CVAR_RENDERER | CVAR_INTEGER | CVAR_ARCHIVE, "15, 32");
@@ -320,6 +344,7 @@ PFNGLGETBUFFERPARAMETERIVARBPROC		qglGetBufferParameterivARB;
 PFNGLGETBUFFERPOINTERVARBPROC			qglGetBufferPointervARB;
 PFNGLMAPBUFFERRANGEPROC					glMapBufferRange;
 PFNGLUNMAPBUFFERPROC					glUnmapBuffer;
+PFNGLFLUSHMAPPEDBUFFERRANGEPROC			glFlushMappedBufferRange;
 PFNGLBUFFERSUBDATAPROC					glBufferSubData;
 
 // ARB_vertex_program / ARB_fragment_program
@@ -335,6 +360,17 @@ PFNGLPROGRAMLOCALPARAMETER4FVARBPROC	qglProgramLocalParameter4fvARB;
 // GL_EXT_depth_bounds_test
 PFNGLDEPTHBOUNDSEXTPROC                 qglDepthBoundsEXT;
 
+// ARB_occlusion_query
+PFNGLGENQUERIESARBPROC                  qglGenQueriesARB;
+PFNGLDELETEQUERIESARBPROC               qglDeleteQueriesARB;
+PFNGLBEGINQUERYARBPROC                  qglBeginQueryARB;
+PFNGLENDQUERYARBPROC                    qglEndQueryARB;
+PFNGLGETQUERYOBJECTUIVARBPROC           qglGetQueryObjectuivARB;
+
+// ARB_timer_query
+PFNGLQUERYCOUNTERPROC                   qglQueryCounter;
+PFNGLGETQUERYOBJECTUI64VPROC            qglGetQueryObjectui64v;
+
 // mipmaps
 PFNGLGENERATEMIPMAPPROC					glGenerateMipmap;
 
@@ -420,6 +456,9 @@ static void R_CheckPortableExtensions( void ) {
 		glConfig.textureCompressionAvailable = false;
 	}
 
+	// GL_EXT_texture_compression_latc, the same blocks as bc5 with the first channel read as luminance
+	glConfig.textureCompressionLATCAvailable = glConfig.textureCompressionAvailable && R_CheckExtension( "GL_EXT_texture_compression_latc" );
+
 	// GL_EXT_texture_filter_anisotropic
 	glConfig.anisotropicAvailable = R_CheckExtension( "GL_EXT_texture_filter_anisotropic" );
 	if ( glConfig.anisotropicAvailable ) {
@@ -529,6 +568,7 @@ static void R_CheckPortableExtensions( void ) {
 		qglGetBufferPointervARB = (PFNGLGETBUFFERPOINTERVARBPROC)GLimp_ExtensionPointer( "glGetBufferPointervARB");
 		glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)GLimp_ExtensionPointer( "glMapBufferRange" );
 		glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)GLimp_ExtensionPointer( "glUnmapBuffer" );
+		glFlushMappedBufferRange = (PFNGLFLUSHMAPPEDBUFFERRANGEPROC)GLimp_ExtensionPointer( "glFlushMappedBufferRange" );
 		glBufferSubData = (PFNGLBUFFERSUBDATAPROC)GLimp_ExtensionPointer("glBufferSubData");
 	}
 
@@ -571,6 +611,23 @@ static void R_CheckPortableExtensions( void ) {
  		qglDepthBoundsEXT = (PFNGLDEPTHBOUNDSEXTPROC)GLimp_ExtensionPointer( "glDepthBoundsEXT" );
  	}
 
+	// ARB_occlusion_query
+	glConfig.occlusionQueryAvailable = R_CheckExtension( "GL_ARB_occlusion_query" );
+	if ( glConfig.occlusionQueryAvailable ) {
+		qglGenQueriesARB = (PFNGLGENQUERIESARBPROC)GLimp_ExtensionPointer( "glGenQueriesARB" );
+		qglDeleteQueriesARB = (PFNGLDELETEQUERIESARBPROC)GLimp_ExtensionPointer( "glDeleteQueriesARB" );
+		qglBeginQueryARB = (PFNGLBEGINQUERYARBPROC)GLimp_ExtensionPointer( "glBeginQueryARB" );
+		qglEndQueryARB = (PFNGLENDQUERYARBPROC)GLimp_ExtensionPointer( "glEndQueryARB" );
+		qglGetQueryObjectuivARB = (PFNGLGETQUERYOBJECTUIVARBPROC)GLimp_ExtensionPointer( "glGetQueryObjectuivARB" );
+	}
+
+	// ARB_timer_query, the timestamps use the occlusion query objects
+	glConfig.timerQueryAvailable = glConfig.occlusionQueryAvailable && R_CheckExtension( "GL_ARB_timer_query" );
+	if ( glConfig.timerQueryAvailable ) {
+		qglQueryCounter = (PFNGLQUERYCOUNTERPROC)GLimp_ExtensionPointer( "glQueryCounter" );
+		qglGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)GLimp_ExtensionPointer( "glGetQueryObjectui64v" );
+	}
+
 	glConfig.pixelBufferAvailable = R_CheckExtension("ARB_pixel_buffer_object");
 
 	glGenerateMipmap = (PFNGLGENERATEMIPMAPPROC)GLimp_ExtensionPointer("glGenerateMipmap");
@@ -585,6 +642,9 @@ static void R_CheckPortableExtensions( void ) {
 	glFramebufferRenderbuffer= (PFNGLFRAMEBUFFERRENDERBUFFEREXTPROC)GLimp_ExtensionPointer("glFramebufferRenderbuffer");
 	glBlitFramebuffer= (PFNGLBLITFRAMEBUFFEREXTPROC)GLimp_ExtensionPointer("glBlitFramebuffer");
 	glDrawBuffers = (PFNGLDRAWBUFFERSPROC)GLimp_ExtensionPointer("glDrawBuffers");
+
+	glConfig.framebufferObjectAvailable = glGenFramebuffers && glBindFramebuffer && glFramebufferTexture2D && glCheckFramebufferStatus
+		&& glGenRenderbuffers && glBindRenderbuffer && glRenderbufferStorage && glFramebufferRenderbuffer;
 }
 
 
@@ -748,6 +808,10 @@ void R_InitOpenGL( void ) {
 	// allocate the vertex array range or vertex objects
 	vertexCache.Init();
 
+	// the queries of an old context are gone
+	RB_ResetOcclusionQueries();
+	RB_ResetGpuTimes();
+
 	// select which renderSystem we are going to use
 	r_renderer.SetModified();
 	tr.SetBackEndRenderer();
@@ -755,6 +819,15 @@ void R_InitOpenGL( void ) {
 	// allocate the frame data, which may be more if smp is enabled
 	R_InitFrameData();
 
+	// start the back end thread, the front end keeps using the original context
+	glConfig.smpActive = false;
+	if ( r_useSMP.GetBool() ) {
+		glConfig.smpActive = GLimp_SpawnRenderThread( RB_RenderThread );
+		if ( !glConfig.smpActive ) {
+			common->Printf( "WARNING: couldn't start the render thread, r_useSMP ignored\n" );
+		}
+	}
+
 	// Reset our gamma
 	R_SetColorMappings();
 
@@ -2022,6 +2095,9 @@ void R_VidRestart_f( const idCmdArgs &args ) {
 	// this could take a while, so give them the cursor back ASAP
 	Sys_GrabMouseCursor( false );
 
+	// the back end may still be drawing the previous frame
+	R_SyncRenderThread();
+
 	// dump ambient caches
 	renderModelManager->FreeModelVertexCaches();
 
@@ -2045,6 +2121,7 @@ void R_VidRestart_f( const idCmdArgs &args ) {
 		// free the context and close the window
 		GLimp_Shutdown();
 		glConfig.isInitialized = false;
+		glConfig.smpActive = false;
 
 		// create the new context and vertex cache
 		bool latch = cvarSystem->GetCVarBool( "r_fullscreen" );
@@ -2212,6 +2289,7 @@ void idRenderSystemLocal::Clear( void ) {
 	frameCount = 0;
 	viewCount = 0;
 	staticAllocCount = 0;
+	lockStaticAlloc = false;
 	frameShaderTime = 0.0f;
 	viewportOffset[0] = 0;
 	viewportOffset[1] = 0;
@@ -2237,6 +2315,8 @@ void idRenderSystemLocal::Clear( void ) {
 	stencilIncr = 0;
 	stencilDecr = 0;
 	memset( renderCrops, 0, sizeof( renderCrops ) );
+	memset( pbo, 0, sizeof( pbo ) );
+	memset( pboQueued, 0, sizeof( pboQueued ) );
 	currentRenderCrop = 0;
 	guiRecursionLevel = 0;
 	guiModel = NULL;
@@ -2353,6 +2433,7 @@ idRenderSystemLocal::BeginLevelLoad
 ========================
 */
 void idRenderSystemLocal::BeginLevelLoad( void ) {
+	R_SyncRenderThread();
 	renderModelManager->BeginLevelLoad();
 	globalImages->BeginLevelLoad();
 }
@@ -2402,6 +2483,7 @@ void idRenderSystemLocal::ShutdownOpenGL( void ) {
 	R_ShutdownFrameData();
 	GLimp_Shutdown();
 	glConfig.isInitialized = false;
+	glConfig.smpActive = false;
 }
 
 /*
@@ -131,10 +131,9 @@ idRenderWorldLocal::idRenderWorldLocal() {
 
 	doublePortals = NULL;
 	numInterAreaPortals = 0;
+	portalStateCount = 0;
 
-	interactionTable = 0;
-	interactionTableWidth = 0;
-	interactionTableHeight = 0;
+	staleAreaRefs = NULL;
 }
 
 /*
@@ -152,20 +151,6 @@ idRenderWorldLocal::~idRenderWorldLocal() {
 	RB_ClearDebugText( 0 );
 }
 
-/*
-===================
-ResizeInteractionTable
-===================
-*/
-void idRenderWorldLocal::ResizeInteractionTable() {
-	// we overflowed the interaction table, so dump it
-	// we may want to resize this in the future if it turns out to be common
-	common->Warning( "Overflowed interactionTableWidth - table removed and disabled" );
-	R_StaticFree( interactionTable );
-	interactionTable = NULL;
-	r_useInteractionTable.SetBool( 0 );
-}
-
 /*
 ===================
 AddEntityDef
@@ -176,9 +161,6 @@ qhandle_t idRenderWorldLocal::AddEntityDef( const renderEntity_t *re ){
 	int entityHandle = entityDefs.FindNull();
 	if ( entityHandle == -1 ) {
 		entityHandle = entityDefs.Append( NULL );
-		if ( interactionTable && entityDefs.Num() > interactionTableWidth ) {
-			ResizeInteractionTable();
-		}
 	}
 
 	UpdateEntityDef( entityHandle, re );
@@ -186,6 +168,26 @@ qhandle_t idRenderWorldLocal::AddEntityDef( const renderEntity_t *re ){
 	return entityHandle;
 }
 
+/*
+==============
+R_OnlyEntityParmsChanged
+
+True if the update only changes values that are evaluated when the entity
+is drawn, so the area references and the light and shadow surfaces
+created for a static model stay valid
+==============
+*/
+static bool R_OnlyEntityParmsChanged( const renderEntity_t *re, const renderEntity_t *parms ) {
+	renderEntity_t	masked;
+
+	memcpy( &masked, re, sizeof( masked ) );
+	memcpy( masked.shaderParms, parms->shaderParms, sizeof( masked.shaderParms ) );
+	memcpy( masked.gui, parms->gui, sizeof( masked.gui ) );
+	masked.referenceSound = parms->referenceSound;
+
+	return !memcmp( &masked, parms, sizeof( masked ) );
+}
+
 /*
 ==============
 UpdateEntityDef
@@ -195,6 +197,7 @@ visible entities
 ==============
 */
 int c_callbackUpdate;
+int c_parmUpdate;
 
 void idRenderWorldLocal::UpdateEntityDef( qhandle_t entityHandle, const renderEntity_t *re ) {
 	if ( r_skipUpdates.GetBool() ) {
@@ -226,7 +229,19 @@ void idRenderWorldLocal::UpdateEntityDef( qhandle_t entityHandle, const renderEn
 			}
 
 			// if the only thing that changed was shaderparms, we can just leave things as they are
-			// after updating parms
+			// after updating parms, instead of regenerating every interaction of the entity
+			// (frob highlights and similar effects change them on otherwise static models)
+			// demo playback allocates new guis that the full path frees
+			if ( !session->readDemo && !re->joints && !re->callback && !def->dynamicModel
+				&& re->hModel && re->hModel->IsDynamicModel() == DM_STATIC && R_OnlyEntityParmsChanged( re, &def->parms ) ) {
+				c_parmUpdate++;
+				def->parms = *re;
+				if ( session->writeDemo && def->archived ) {
+					WriteFreeEntity( entityHandle );
+					def->archived = false;
+				}
+				return;
+			}
 
 			// if we have a callback function and the bounds, origin, axis and model match,
 			// then we can leave the references as they are
@@ -240,7 +255,13 @@ void idRenderWorldLocal::UpdateEntityDef( qhandle_t entityHandle, const renderEn
 				if ( boundsMatch && originMatch && axisMatch && modelMatch ) {
 					// only clear the dynamic model and interaction surfaces if they exist
 					c_callbackUpdate++;
-					R_ClearEntityDefDynamicModel( def );
+					// an animated model that may not have moved keeps its snapshot, and the
+					// shadow volumes built from it, until the callback has made the frame
+					if ( r_useJointsCrc.GetBool() && re->joints && def->dynamicModel && R_OnlyEntityParmsChanged( re, &def->parms ) ) {
+						def->checkDynamicModelJoints = true;
+					} else {
+						R_ClearEntityDefDynamicModel( def );
+					}
 					def->parms = *re;
 					return;
 				}
@@ -248,10 +269,11 @@ void idRenderWorldLocal::UpdateEntityDef( qhandle_t entityHandle, const renderEn
 		}
 
 		// save any decals if the model is the same, allowing marks to move with entities
+		// the area references are kept for R_CreateEntityRefs to reuse
 		if ( def->parms.hModel == re->hModel ) {
-			R_FreeEntityDefDerivedData( def, true, true );
+			R_FreeEntityDefDerivedData( def, true, true, true );
 		} else {
-			R_FreeEntityDefDerivedData( def, false, false );
+			R_FreeEntityDefDerivedData( def, false, false, true );
 		}
 	} else {
 		// creating a new one
@@ -355,9 +377,6 @@ qhandle_t idRenderWorldLocal::AddLightDef( const renderLight_t *rlight ) {
 
 	if ( lightHandle == -1 ) {
 		lightHandle = lightDefs.Append( NULL );
-		if ( interactionTable && lightDefs.Num() > interactionTableHeight ) {
-			ResizeInteractionTable();
-		}
 	}
 	UpdateLightDef( lightHandle, rlight );
 
@@ -404,8 +423,9 @@ void idRenderWorldLocal::UpdateLightDef( qhandle_t lightHandle, const renderLigh
 			justUpdate = true;
 		} else {
 			// if we are updating shadows, the prelight model is no longer valid
+			// the area references are kept for R_CreateLightRefs to reuse
 			light->lightHasMoved = true;
-			R_FreeLightDefDerivedData( light );
+			R_FreeLightDefDerivedData( light, true );
 		}
 	} else {
 		// create a new one
@@ -458,6 +478,11 @@ void idRenderWorldLocal::FreeLightDef( qhandle_t lightHandle ) {
 
 	R_FreeLightDefDerivedData( light );
 
+	// a new light reusing the handle mustn't inherit the occlusion result
+	if ( lightHandle < MAX_OCCLUSION_LIGHTS ) {
+		occlusionResults[lightHandle].occluded = false;
+	}
+
 	if ( session->writeDemo && light->archived ) {
 		WriteFreeLight( lightHandle );
 	}
@@ -539,10 +564,7 @@ void idRenderWorldLocal::ProjectDecalOntoWorld( const idFixedWinding &winding, c
 			idRenderModelDecal::GlobalProjectionInfoToLocal( localInfo, info, def->parms.origin, def->parms.axis );
 			localInfo.force = ( def->parms.customShader != NULL );
 
-			if ( !def->decals ) {
-				def->decals = idRenderModelDecal::Alloc();
-			}
-			def->decals->CreateDecal( model, localInfo );
+			R_QueueEntityDefDecal( def, localInfo );
 		}
 	}
 }
@@ -587,10 +609,7 @@ void idRenderWorldLocal::ProjectDecal( qhandle_t entityHandle, const idFixedWind
 	idRenderModelDecal::GlobalProjectionInfoToLocal( localInfo, info, def->parms.origin, def->parms.axis );
 	localInfo.force = ( def->parms.customShader != NULL );
 
-	if ( def->decals == NULL ) {
-		def->decals = idRenderModelDecal::Alloc();
-	}
-	def->decals->CreateDecal( model, localInfo );
+	R_QueueEntityDefDecal( def, localInfo );
 }
 
 /*
@@ -669,6 +688,7 @@ to handle mirrors,
 */
 void idRenderWorldLocal::RenderScene( const renderView_t *renderView ) {
 #ifndef	ID_DEDICATED
+	idScopedMemTag	memTag( MEMTAG_RENDERER );
 	renderView_t	copy;
 
 	if ( !glConfig.isInitialized ) {
@@ -861,7 +881,10 @@ void idRenderWorldLocal::SetPortalPlayerLoss( qhandle_t portal, float loss ) //
 	{
 		common->Error( "SetPortalPlayerLoss: bad portal number %i", portal );
 	}
-	doublePortals[portal-1].lossPlayer = loss; // grayman #3042
+	if ( doublePortals[portal-1].lossPlayer != loss ) {
+		doublePortals[portal-1].lossPlayer = loss; // grayman #3042
+		portalStateCount++;
+	}
 
 	if ( session->writeDemo )
 	{
@@ -872,6 +895,15 @@ void idRenderWorldLocal::SetPortalPlayerLoss( qhandle_t portal, float loss ) //
 	}
 }
 
+/*
+==============
+GetPortalStateCount
+==============
+*/
+int idRenderWorldLocal::GetPortalStateCount( void ) const {
+	return portalStateCount;
+}
+
 /*
 ===============
 PointInAreaNum
@@ -1406,6 +1438,14 @@ void idRenderWorldLocal::AddEntityRefToArea( idRenderEntityLocal *def, portalAre
 		common->Error( "idRenderWorldLocal::AddEntityRefToArea: NULL def" );
 	} 
 	else {
+		// a moving entity that stays in the area keeps its old reference
+		ref = ReuseAreaRef( area );
+		if ( ref ) {
+			ref->ownerNext = def->entityRefs;
+			def->entityRefs = ref;
+			return;
+		}
+
 		ref = areaReferenceAllocator.Alloc();
 
 		tr.pc.c_entityReferences++;
@@ -1434,6 +1474,14 @@ AddLightRefToArea
 void idRenderWorldLocal::AddLightRefToArea( idRenderLightLocal *light, portalArea_t *area ) {
 	areaReference_t	*lref;
 
+	// a moving light that still touches the area keeps its old reference
+	lref = ReuseAreaRef( area );
+	if ( lref ) {
+		lref->ownerNext = light->references;
+		light->references = lref;
+		return;
+	}
+
 	// add a lightref to this area
 	lref = areaReferenceAllocator.Alloc();
 	lref->light = light;
@@ -1449,6 +1497,77 @@ void idRenderWorldLocal::AddLightRefToArea( idRenderLightLocal *light, portalAre
 	area->lightRefs.areaNext = lref;
 }
 
+/*
+===================
+ReuseAreaRef
+
+Takes the reference to the area out of the stale list set up by
+BeginAreaRefUpdate, leaving it linked into the area.
+===================
+*/
+areaReference_t *idRenderWorldLocal::ReuseAreaRef( portalArea_t *area ) {
+	areaReference_t	**prev = &staleAreaRefs;
+
+	// moving defs usually only touch a handful of areas
+	for ( areaReference_t *ref = staleAreaRefs; ref; ref = ref->ownerNext ) {
+		if ( ref->area == area ) {
+			*prev = ref->ownerNext;
+			return ref;
+		}
+		prev = &ref->ownerNext;
+	}
+	return NULL;
+}
+
+/*
+===================
+BeginAreaRefUpdate
+
+Moves an entity or light reference chain aside before the def is pushed
+into the tree again, so the areas that are still touched don't have to
+be unlinked and relinked on every update.
+===================
+*/
+void idRenderWorldLocal::BeginAreaRefUpdate( areaReference_t **refs ) {
+	assert( staleAreaRefs == NULL );
+	staleAreaRefs = *refs;
+	*refs = NULL;
+}
+
+/*
+===================
+EndAreaRefUpdate
+
+Frees the references to the areas the def has left.
+===================
+*/
+void idRenderWorldLocal::EndAreaRefUpdate() {
+	FreeAreaRefs( staleAreaRefs );
+	staleAreaRefs = NULL;
+}
+
+/*
+===================
+FreeAreaRefs
+
+Unlinks a reference chain from the areas and frees it
+===================
+*/
+void idRenderWorldLocal::FreeAreaRefs( areaReference_t *refs ) {
+	areaReference_t	*ref = refs;
+
+	while ( ref ) {
+		// unlink from the area
+		ref->areaNext->areaPrev = ref->areaPrev;
+		ref->areaPrev->areaNext = ref->areaNext;
+
+		// put it back on the free list for reuse
+		areaReferenceAllocator.Free( ref );
+
+		ref = ref->ownerNext;
+	}
+}
+
 /*
 ===================
 GenerateAllInteractions
@@ -1458,7 +1577,7 @@ If this isn't called, they will all be dynamically generated
 
 This really isn't all that helpful anymore, because the calculation of shadows
 and light interactions is deferred from idRenderWorldLocal::CreateLightDefInteractions(), but we
-use it as an oportunity to size the interactionTable
+use it as an oportunity to report the size of the interactionTable
 ===================
 */
 void idRenderWorldLocal::GenerateAllInteractions() {
@@ -1494,45 +1613,11 @@ void idRenderWorldLocal::GenerateAllInteractions() {
 	common->Printf( "idRenderWorld::GenerateAllInteractions, msec = %i, staticAllocCount = %i.\n", msec, tr.staticAllocCount );
 #endif
 
-	// build the interaction table
-	if ( r_useInteractionTable.GetBool() ) {
-		// FIXME: Serp
-		// This is temp, and should be changed to better represent the map ent/light count,
-		// Note : Should allocate a nice PoT of 67108864 - try to preserve a PoT in fixed version.
-		const int BUFFER = 4096;
-		interactionTableWidth = 2*BUFFER; // this->entityDefs.Num() + padding // grayman #3192 - double this dimension
-		interactionTableHeight = BUFFER; // this->lightDefs.Num() + padding
-		const int size = (interactionTableWidth * interactionTableHeight) * sizeof( interactionTable ); 
-		interactionTable = (idInteraction **)R_ClearedStaticAlloc( size );
-
-		//common->Printf( "entityDefs.Num(): %i\n", this->entityDefs.Num() );
-		//common->Printf( "lightDefs.Num(): %i\n", this->lightDefs.Num() );
-		//common->Printf( "sizeof( interactionTable ): %i\n", sizeof( interactionTable ) );
-		//common->Printf( "whole size: %i bytes\n", size );
-
-		int index;
-		int	count = 0;
-		idRenderLightLocal *ldef;
-		idRenderEntityLocal	*edef;
-		idInteraction *inter;
-		for ( int i = 0 ; i < this->lightDefs.Num() ; i++ ) {
-			ldef = this->lightDefs[i];
-			if ( !ldef ) {
-				continue;
-			}
-			for ( inter = ldef->firstInteraction; inter != NULL; inter = inter->lightNext ) {
-				edef = inter->entityDef;
-				index = ldef->index * interactionTableWidth + edef->index;
-
-				interactionTable[ index ] = inter;
-				count++;
-			}
-		}
-		common->Printf( "interactionTable generated of size: %i bytes\n", size );
+	// the interaction table is kept up to date as the interactions are created
+	common->Printf( "interactionTable holds %i interactions in %i bytes\n", interactionTable.Num(), interactionTable.Allocated() );
 #ifdef _DEBUG
-		common->Printf( "%i interactions take %i bytes\n", count, count * sizeof( idInteraction ) );
+	common->Printf( "%i interactions take %i bytes\n", interactionTable.Num(), interactionTable.Num() * sizeof( idInteraction ) );
 #endif
-	}
 
 	// entities flagged as noDynamicInteractions will no longer make any
 	generateAllInteractionsCalled = true;
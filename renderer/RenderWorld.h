@@ -31,6 +31,11 @@
 #define PROC_FILE_EXT				"proc"
 #define	PROC_FILE_ID				"mapProcFile003"
 
+// the compiled version of the .proc, written when the .proc is loaded
+#define PROC_BINARY_FILE_EXT		"procb"
+#define PROC_BINARY_FILE_ID			"PRCB"
+#define PROC_BINARY_FILE_VERSION	1
+
 // portals
 #define NUM_PORTAL_ATTRIBUTES		4 // grayman #3042 - was 3, but I added PS_BLOCK_SOUND
 
@@ -197,6 +202,8 @@ typedef struct renderLight_s {
 
 	bool					noFogBoundary;		// Stops fogs drawing and fogging their bounding boxes -- SteveL #3664
 
+	bool					shadowMap;			// shadow with a shadow map instead of shadow volumes when r_useShadowMaps is 1
+
 } renderLight_t;
 
 
@@ -339,6 +346,10 @@ public:
 	// grayman #3042 - set portal sound loss (in dB)
 	virtual void			SetPortalPlayerLoss( qhandle_t portal, float loss ) = 0;
 
+	// incremented whenever the blocking bits or the sound loss of a portal change,
+	// so the sound system can tell when its cached portal chains are out of date
+	virtual int				GetPortalStateCount( void ) const = 0;
+
 	// returns true only if a chain of portals without the given connection bits set
 	// exists between the two areas (a door doesn't separate them, etc)
 	virtual	bool			AreasAreConnected( int areaNum1, int areaNum2, portalConnection_t connection ) = 0;
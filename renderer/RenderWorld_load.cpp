@@ -24,6 +24,15 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 #include "tr_local.h"
 
+// the sections of the binary .procb
+enum {
+	PROCB_END = -1,
+	PROCB_MODEL,
+	PROCB_SHADOWMODEL,
+	PROCB_INTERAREAPORTALS,
+	PROCB_NODES
+};
+
 
 /*
 ================
@@ -108,7 +117,7 @@ void idRenderWorldLocal::TouchWorldModels( void ) {
 idRenderWorldLocal::ParseModel
 ================
 */
-idRenderModel *idRenderWorldLocal::ParseModel( idLexer *src ) {
+idRenderModel *idRenderWorldLocal::ParseModel( idLexer *src, idFile *binaryFile ) {
 	idRenderModel	*model;
 	idToken			token;
 	int				i, j;
@@ -171,6 +180,11 @@ idRenderModel *idRenderWorldLocal::ParseModel( idLexer *src ) {
 
 	src->ExpectTokenString( "}" );
 
+	// the binary version stores the surfaces as parsed
+	if ( binaryFile ) {
+		WriteBinaryModel( binaryFile, model );
+	}
+
 	model->FinishSurfaces();
 
 	return model;
@@ -181,7 +195,7 @@ idRenderModel *idRenderWorldLocal::ParseModel( idLexer *src ) {
 idRenderWorldLocal::ParseShadowModel
 ================
 */
-idRenderModel *idRenderWorldLocal::ParseShadowModel( idLexer *src ) {
+idRenderModel *idRenderWorldLocal::ParseShadowModel( idLexer *src, idFile *binaryFile ) {
 	idRenderModel	*model;
 	idToken			token;
 	int				j;
@@ -231,6 +245,10 @@ idRenderModel *idRenderWorldLocal::ParseShadowModel( idLexer *src ) {
 
 	src->ExpectTokenString( "}" );
 
+	if ( binaryFile ) {
+		WriteBinaryShadowModel( binaryFile, model );
+	}
+
 	// we do NOT do a model->FinishSurfaceces, because we don't need sil edges, planes, tangents, etc.
 //	model->FinishSurfaces();
 
@@ -257,12 +275,49 @@ void idRenderWorldLocal::SetupAreaRefs() {
 	}
 }
 
+/*
+================
+idRenderWorldLocal::AddInterAreaPortal
+
+Links the portal into both areas, takes ownership of the winding
+================
+*/
+void idRenderWorldLocal::AddInterAreaPortal( int portalNum, int a1, int a2, idWinding *w ) {
+	portal_t	*p;
+
+	// add the portal to a1
+	p = (portal_t *)R_ClearedStaticAlloc( sizeof( *p ) );
+	p->intoArea = a2;
+	p->doublePortal = &doublePortals[portalNum];
+	p->w = w;
+	p->w->GetPlane( p->plane );
+	p->w->GetBounds( p->bounds );
+
+	p->next = portalAreas[a1].portals;
+	portalAreas[a1].portals = p;
+
+	doublePortals[portalNum].portals[0] = p;
+
+	// reverse it for a2
+	p = (portal_t *)R_ClearedStaticAlloc( sizeof( *p ) );
+	p->intoArea = a1;
+	p->doublePortal = &doublePortals[portalNum];
+	p->w = w->Reverse();
+	p->w->GetPlane( p->plane );
+	p->w->GetBounds( p->bounds );
+
+	p->next = portalAreas[a2].portals;
+	portalAreas[a2].portals = p;
+
+	doublePortals[portalNum].portals[1] = p;
+}
+
 /*
 ================
 idRenderWorldLocal::ParseInterAreaPortals
 ================
 */
-void idRenderWorldLocal::ParseInterAreaPortals( idLexer *src ) {
+void idRenderWorldLocal::ParseInterAreaPortals( idLexer *src, idFile *binaryFile ) {
 	int i, j;
 
 	src->ExpectTokenString( "{" );
@@ -290,7 +345,6 @@ void idRenderWorldLocal::ParseInterAreaPortals( idLexer *src ) {
 	for ( i = 0 ; i < numInterAreaPortals ; i++ ) {
 		int		numPoints, a1, a2;
 		idWinding	*w;
-		portal_t	*p;
 
 		numPoints = src->ParseInt();
 		a1 = src->ParseInt();
@@ -305,32 +359,14 @@ void idRenderWorldLocal::ParseInterAreaPortals( idLexer *src ) {
 			(*w)[j][4] = 0;
 		}
 
-		// add the portal to a1
-		p = (portal_t *)R_ClearedStaticAlloc( sizeof( *p ) );
-		p->intoArea = a2;
-		p->doublePortal = &doublePortals[i];
-		p->w = w;
-		p->w->GetPlane( p->plane );
-
-		p->next = portalAreas[a1].portals;
-		portalAreas[a1].portals = p;
-
-		doublePortals[i].portals[0] = p;
-
-		// reverse it for a2
-		p = (portal_t *)R_ClearedStaticAlloc( sizeof( *p ) );
-		p->intoArea = a1;
-		p->doublePortal = &doublePortals[i];
-		p->w = w->Reverse();
-		p->w->GetPlane( p->plane );
-
-		p->next = portalAreas[a2].portals;
-		portalAreas[a2].portals = p;
-
-		doublePortals[i].portals[1] = p;
+		AddInterAreaPortal( i, a1, a2, w );
 	}
 
 	src->ExpectTokenString( "}" );
+
+	if ( binaryFile ) {
+		WriteBinaryInterAreaPortals( binaryFile );
+	}
 }
 
 /*
@@ -338,7 +374,7 @@ void idRenderWorldLocal::ParseInterAreaPortals( idLexer *src ) {
 idRenderWorldLocal::ParseNodes
 ================
 */
-void idRenderWorldLocal::ParseNodes( idLexer *src ) {
+void idRenderWorldLocal::ParseNodes( idLexer *src, idFile *binaryFile ) {
 	int			i;
 
 	src->ExpectTokenString( "{" );
@@ -360,6 +396,480 @@ void idRenderWorldLocal::ParseNodes( idLexer *src ) {
 	}
 
 	src->ExpectTokenString( "}" );
+
+	if ( binaryFile ) {
+		WriteBinaryNodes( binaryFile );
+	}
+}
+
+/*
+================
+idRenderWorldLocal::AddLocalModel
+================
+*/
+void idRenderWorldLocal::AddLocalModel( idRenderModel *model ) {
+	// add it to the model manager list
+	renderModelManager->AddModel( model );
+
+	// save it in the list to free when clearing this map
+	localModels.Append( model );
+}
+
+/*
+================
+idRenderWorldLocal::ParseProc
+
+Parses the text .proc, writing its binary version to binaryFile if not NULL
+================
+*/
+bool idRenderWorldLocal::ParseProc( const char *filename, const char *buffer, int length, idFile *binaryFile ) {
+	idLexer			src( buffer, length, filename, LEXFL_NOSTRINGCONCAT | LEXFL_NODOLLARPRECOMPILE );
+	idToken			token;
+
+	if ( !src.ReadToken( &token ) || token.Icmp( PROC_FILE_ID ) ) {
+		common->Printf( "idRenderWorldLocal::InitFromMap: bad id '%s' instead of '%s'\n", token.c_str(), PROC_FILE_ID );
+		return false;
+	}
+
+	// parse the file
+	while ( 1 ) {
+		if ( !src.ReadToken( &token ) ) {
+			break;
+		}
+
+		if ( token == "model" ) {
+			AddLocalModel( ParseModel( &src, binaryFile ) );
+			continue;
+		}
+
+		if ( token == "shadowModel" ) {
+			AddLocalModel( ParseShadowModel( &src, binaryFile ) );
+			continue;
+		}
+
+		if ( token == "interAreaPortals" ) {
+			ParseInterAreaPortals( &src, binaryFile );
+			continue;
+		}
+
+		if ( token == "nodes" ) {
+			ParseNodes( &src, binaryFile );
+			continue;
+		}
+
+		src.Error( "idRenderWorldLocal::InitFromMap: bad token \"%s\"", token.c_str() );
+	}
+
+	return true;
+}
+
+/*
+===============================================================================
+
+	Binary .procb
+
+	The sections of the .proc in the same order, with the vertexes and indexes
+	stored as native blobs that are read straight into the triangle surfaces.
+	The header holds the checksum and length of the .proc it was written from,
+	and the sizes of the blob types, so a stale file or one written by a build
+	with a different vertex layout is ignored and rewritten.
+
+===============================================================================
+*/
+
+/*
+================
+R_BinaryProcCountFits
+
+True if count elements of the given size can still be read from the file
+================
+*/
+static bool R_BinaryProcCountFits( idFile *f, int count, int elementSize ) {
+	return count >= 0 && (long long)count * elementSize <= (long long)( f->Length() - f->Tell() );
+}
+
+/*
+================
+idRenderWorldLocal::WriteBinaryModel
+================
+*/
+void idRenderWorldLocal::WriteBinaryModel( idFile *f, const idRenderModel *model ) const {
+	f->WriteInt( PROCB_MODEL );
+	f->WriteString( model->Name() );
+	f->WriteInt( model->NumSurfaces() );
+
+	for ( int i = 0 ; i < model->NumSurfaces() ; i++ ) {
+		const modelSurface_t	*surf = model->Surface( i );
+		const srfTriangles_t	*tri = surf->geometry;
+
+		f->WriteString( surf->shader->GetName() );
+		f->WriteInt( tri->numVerts );
+		f->WriteInt( tri->numIndexes );
+
+		// only the parsed components, the rest is derived by FinishSurfaces
+		for ( int j = 0 ; j < tri->numVerts ; j++ ) {
+			idDrawVert	v;
+
+			v.Clear();
+			v.xyz = tri->verts[j].xyz;
+			v.st = tri->verts[j].st;
+			v.normal = tri->verts[j].normal;
+			f->Write( &v, sizeof( v ) );
+		}
+
+		f->Write( tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ) );
+	}
+}
+
+/*
+================
+idRenderWorldLocal::WriteBinaryShadowModel
+================
+*/
+void idRenderWorldLocal::WriteBinaryShadowModel( idFile *f, const idRenderModel *model ) const {
+	const srfTriangles_t	*tri = model->Surface( 0 )->geometry;
+
+	f->WriteInt( PROCB_SHADOWMODEL );
+	f->WriteString( model->Name() );
+	f->WriteInt( tri->numVerts );
+	f->WriteInt( tri->numShadowIndexesNoCaps );
+	f->WriteInt( tri->numShadowIndexesNoFrontCaps );
+	f->WriteInt( tri->numIndexes );
+	f->WriteInt( tri->shadowCapPlaneBits );
+	f->Write( tri->shadowVertexes, tri->numVerts * sizeof( tri->shadowVertexes[0] ) );
+	f->Write( tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ) );
+}
+
+/*
+================
+idRenderWorldLocal::WriteBinaryInterAreaPortals
+================
+*/
+void idRenderWorldLocal::WriteBinaryInterAreaPortals( idFile *f ) const {
+	f->WriteInt( PROCB_INTERAREAPORTALS );
+	f->WriteInt( numPortalAreas );
+	f->WriteInt( numInterAreaPortals );
+
+	for ( int i = 0 ; i < numInterAreaPortals ; i++ ) {
+		const idWinding	*w = doublePortals[i].portals[0]->w;
+
+		f->WriteInt( w->GetNumPoints() );
+		f->WriteInt( doublePortals[i].portals[1]->intoArea );
+		f->WriteInt( doublePortals[i].portals[0]->intoArea );
+		for ( int j = 0 ; j < w->GetNumPoints() ; j++ ) {
+			f->WriteVec3( (*w)[j].ToVec3() );
+		}
+	}
+}
+
+/*
+================
+idRenderWorldLocal::WriteBinaryNodes
+================
+*/
+void idRenderWorldLocal::WriteBinaryNodes( idFile *f ) const {
+	f->WriteInt( PROCB_NODES );
+	f->WriteInt( numAreaNodes );
+
+	for ( int i = 0 ; i < numAreaNodes ; i++ ) {
+		f->WriteVec4( areaNodes[i].plane.ToVec4() );
+		f->WriteInt( areaNodes[i].children[0] );
+		f->WriteInt( areaNodes[i].children[1] );
+	}
+}
+
+/*
+================
+idRenderWorldLocal::ReadBinaryModel
+================
+*/
+idRenderModel *idRenderWorldLocal::ReadBinaryModel( idFile *f ) {
+	idRenderModel	*model;
+	idStr			name;
+	int				i, numSurfaces;
+	srfTriangles_t	*tri;
+	modelSurface_t	surf;
+
+	f->ReadString( name );
+
+	model = renderModelManager->AllocModel();
+	model->InitEmpty( name );
+
+	f->ReadInt( numSurfaces );
+	if ( !R_BinaryProcCountFits( f, numSurfaces, 2 * sizeof( int ) ) ) {
+		delete model;
+		return NULL;
+	}
+
+	for ( i = 0 ; i < numSurfaces ; i++ ) {
+		f->ReadString( name );
+
+		surf.shader = declManager->FindMaterial( name );
+
+		((idMaterial*)surf.shader)->AddReference();
+
+		tri = R_AllocStaticTriSurf();
+		surf.geometry = tri;
+
+		f->ReadInt( tri->numVerts );
+		f->ReadInt( tri->numIndexes );
+
+		if ( !R_BinaryProcCountFits( f, tri->numVerts, sizeof( tri->verts[0] ) ) ) {
+			R_FreeStaticTriSurf( tri );
+			delete model;
+			return NULL;
+		}
+		R_AllocStaticTriSurfVerts( tri, tri->numVerts );
+		f->Read( tri->verts, tri->numVerts * sizeof( tri->verts[0] ) );
+
+		if ( !R_BinaryProcCountFits( f, tri->numIndexes, sizeof( tri->indexes[0] ) ) ) {
+			R_FreeStaticTriSurf( tri );
+			delete model;
+			return NULL;
+		}
+		R_AllocStaticTriSurfIndexes( tri, tri->numIndexes );
+		f->Read( tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ) );
+
+		// add the completed surface to the model
+		model->AddSurface( surf );
+	}
+
+	model->FinishSurfaces();
+
+	return model;
+}
+
+/*
+================
+idRenderWorldLocal::ReadBinaryShadowModel
+================
+*/
+idRenderModel *idRenderWorldLocal::ReadBinaryShadowModel( idFile *f ) {
+	idRenderModel	*model;
+	idStr			name;
+	int				j;
+	srfTriangles_t	*tri;
+	modelSurface_t	surf;
+
+	f->ReadString( name );
+
+	model = renderModelManager->AllocModel();
+	model->InitEmpty( name );
+
+	surf.shader = tr.defaultMaterial;
+
+	tri = R_AllocStaticTriSurf();
+	surf.geometry = tri;
+
+	f->ReadInt( tri->numVerts );
+	f->ReadInt( tri->numShadowIndexesNoCaps );
+	f->ReadInt( tri->numShadowIndexesNoFrontCaps );
+	f->ReadInt( tri->numIndexes );
+	f->ReadInt( tri->shadowCapPlaneBits );
+
+	if ( !R_BinaryProcCountFits( f, tri->numVerts, sizeof( tri->shadowVertexes[0] ) ) ) {
+		R_FreeStaticTriSurf( tri );
+		delete model;
+		return NULL;
+	}
+	R_AllocStaticTriSurfShadowVerts( tri, tri->numVerts );
+	f->Read( tri->shadowVertexes, tri->numVerts * sizeof( tri->shadowVertexes[0] ) );
+
+	tri->bounds.Clear();
+	for ( j = 0 ; j < tri->numVerts ; j++ ) {
+		tri->bounds.AddPoint( tri->shadowVertexes[j].xyz.ToVec3() );
+	}
+
+	if ( !R_BinaryProcCountFits( f, tri->numIndexes, sizeof( tri->indexes[0] ) ) ) {
+		R_FreeStaticTriSurf( tri );
+		delete model;
+		return NULL;
+	}
+	R_AllocStaticTriSurfIndexes( tri, tri->numIndexes );
+	f->Read( tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ) );
+
+	// add the completed surface to the model
+	model->AddSurface( surf );
+
+	return model;
+}
+
+/*
+================
+idRenderWorldLocal::ReadBinaryInterAreaPortals
+================
+*/
+bool idRenderWorldLocal::ReadBinaryInterAreaPortals( idFile *f ) {
+	int i, j;
+
+	if ( portalAreas ) {
+		return false;
+	}
+
+	f->ReadInt( numPortalAreas );
+	if ( numPortalAreas < 0 ) {
+		numPortalAreas = 0;
+		return false;
+	}
+	portalAreas = (portalArea_t *)R_ClearedStaticAlloc( numPortalAreas * sizeof( portalAreas[0] ) );
+	areaScreenRect = (idScreenRect *) R_ClearedStaticAlloc( numPortalAreas * sizeof( idScreenRect ) );
+
+	// set the doubly linked lists
+	SetupAreaRefs();
+
+	f->ReadInt( numInterAreaPortals );
+	if ( !R_BinaryProcCountFits( f, numInterAreaPortals, 3 * sizeof( int ) ) ) {
+		numInterAreaPortals = 0;
+		return false;
+	}
+
+	doublePortals = (doublePortal_t *)R_ClearedStaticAlloc( numInterAreaPortals * 
+		sizeof( doublePortals [0] ) );
+
+	for ( i = 0 ; i < numInterAreaPortals ; i++ ) {
+		int		numPoints, a1, a2;
+		idWinding	*w;
+
+		f->ReadInt( numPoints );
+		f->ReadInt( a1 );
+		f->ReadInt( a2 );
+
+		if ( !R_BinaryProcCountFits( f, numPoints, sizeof( idVec3 ) ) ||
+			a1 < 0 || a1 >= numPortalAreas || a2 < 0 || a2 >= numPortalAreas ) {
+			return false;
+		}
+
+		w = new idWinding( numPoints );
+		w->SetNumPoints( numPoints );
+		for ( j = 0 ; j < numPoints ; j++ ) {
+			f->ReadVec3( (*w)[j].ToVec3() );
+			// no texture coordinates
+			(*w)[j][3] = 0;
+			(*w)[j][4] = 0;
+		}
+
+		AddInterAreaPortal( i, a1, a2, w );
+	}
+
+	return true;
+}
+
+/*
+================
+idRenderWorldLocal::ReadBinaryNodes
+================
+*/
+bool idRenderWorldLocal::ReadBinaryNodes( idFile *f ) {
+	int			i;
+
+	if ( areaNodes ) {
+		return false;
+	}
+
+	f->ReadInt( numAreaNodes );
+	if ( !R_BinaryProcCountFits( f, numAreaNodes, sizeof( idVec4 ) + 2 * sizeof( int ) ) ) {
+		numAreaNodes = 0;
+		return false;
+	}
+	areaNodes = (areaNode_t *)R_ClearedStaticAlloc( numAreaNodes * sizeof( areaNodes[0] ) );
+
+	for ( i = 0 ; i < numAreaNodes ; i++ ) {
+		areaNode_t	*node;
+
+		node = &areaNodes[i];
+
+		f->ReadVec4( node->plane.ToVec4() );
+		f->ReadInt( node->children[0] );
+		f->ReadInt( node->children[1] );
+	}
+
+	return true;
+}
+
+/*
+================
+idRenderWorldLocal::LoadBinaryProc
+
+Loads the world from the binary version of the .proc if it was written from
+the current one, returns false with the world freed otherwise
+================
+*/
+bool idRenderWorldLocal::LoadBinaryProc( const char *filename, unsigned int procCRC, int procLength ) {
+	const char		*buffer;
+	int				length;
+	char			id[4];
+	int				version, vertSize, indexSize, fileProcLength;
+	unsigned int	fileProcCRC;
+	int				section;
+	bool			ok;
+
+	length = fileSystem->ReadFileMapped( filename, (const void **)&buffer, NULL );
+	if ( length < 0 || !buffer ) {
+		return false;
+	}
+
+	idFile_Memory f( filename, (const char *)buffer, length );
+
+	f.Read( id, sizeof( id ) );
+	f.ReadInt( version );
+	f.ReadInt( vertSize );
+	f.ReadInt( indexSize );
+	f.ReadUnsignedInt( fileProcCRC );
+	f.ReadInt( fileProcLength );
+
+	if ( memcmp( id, PROC_BINARY_FILE_ID, sizeof( id ) ) || version != PROC_BINARY_FILE_VERSION ||
+		vertSize != sizeof( idDrawVert ) || indexSize != sizeof( glIndex_t ) ||
+		fileProcCRC != procCRC || fileProcLength != procLength ) {
+		common->Printf( "idRenderWorldLocal::InitFromMap: %s is out of date\n", filename );
+		fileSystem->FreeFile( (void *)buffer );
+		return false;
+	}
+
+	ok = false;
+	while ( f.Tell() < f.Length() ) {
+		idRenderModel	*model = NULL;
+
+		f.ReadInt( section );
+
+		if ( section == PROCB_END ) {
+			ok = ( f.Tell() == f.Length() );
+			break;
+		}
+
+		if ( section == PROCB_MODEL ) {
+			model = ReadBinaryModel( &f );
+		} else if ( section == PROCB_SHADOWMODEL ) {
+			model = ReadBinaryShadowModel( &f );
+		} else if ( section == PROCB_INTERAREAPORTALS ) {
+			if ( !ReadBinaryInterAreaPortals( &f ) ) {
+				break;
+			}
+			continue;
+		} else if ( section == PROCB_NODES ) {
+			if ( !ReadBinaryNodes( &f ) ) {
+				break;
+			}
+			continue;
+		}
+
+		if ( !model ) {
+			break;
+		}
+
+		AddLocalModel( model );
+	}
+
+	fileSystem->FreeFile( (void *)buffer );
+
+	if ( !ok ) {
+		common->Printf( "idRenderWorldLocal::InitFromMap: %s is damaged\n", filename );
+		idStr procMapName = mapName;
+		FreeWorld();
+		mapName = procMapName;
+		return false;
+	}
+
+	return true;
 }
 
 /*
@@ -433,11 +943,6 @@ void idRenderWorldLocal::FreeDefs() {
 
 	generateAllInteractionsCalled = false;
 
-	if ( interactionTable ) {
-		R_StaticFree( interactionTable );
-		interactionTable = NULL;
-	}
-
 	// free all lightDefs
 	for ( i = 0 ; i < lightDefs.Num() ; i++ ) {
 		idRenderLightLocal	*light;
@@ -459,6 +964,9 @@ void idRenderWorldLocal::FreeDefs() {
 			entityDefs[i] = NULL;
 		}
 	}
+
+	// all the interactions are gone, so this only releases the memory
+	interactionTable.Clear();
 }
 
 /*
@@ -470,10 +978,8 @@ is still useful for displaying a bare model
 =================
 */
 bool idRenderWorldLocal::InitFromMap( const char *name ) {
-	idLexer *		src;
-	idToken			token;
+	idScopedMemTag	memTag( MEMTAG_RENDERER );
 	idStr			filename;
-	idRenderModel *	lastModel;
 
 	// if this is an empty world, initialize manually
 	if ( !name || !name[0] ) {
@@ -507,13 +1013,16 @@ bool idRenderWorldLocal::InitFromMap( const char *name ) {
 
 	FreeWorld();
 
-	src = new idLexer( filename, LEXFL_NOSTRINGCONCAT | LEXFL_NODOLLARPRECOMPILE );
-	if ( !src->IsLoaded() ) {
+	// read the .proc in one go, its checksum validates the binary version
+	char *procBuffer = NULL;
+	int procLength = fileSystem->ReadFile( filename, (void **)&procBuffer, NULL );
+	if ( procLength < 0 || !procBuffer ) {
 		common->Printf( "idRenderWorldLocal::InitFromMap: %s not found\n", filename.c_str() );
 		ClearWorld();
 		return false;
 	}
 
+	unsigned int procCRC = CRC32_BlockChecksum( procBuffer, procLength );
 
 	mapName = name;
 	mapTimeStamp = currentTimeStamp;
@@ -523,54 +1032,34 @@ bool idRenderWorldLocal::InitFromMap( const char *name ) {
 		WriteLoadMap();
 	}
 
-	if ( !src->ReadToken( &token ) || token.Icmp( PROC_FILE_ID ) ) {
-		common->Printf( "idRenderWorldLocal::InitFromMap: bad id '%s' instead of '%s'\n", token.c_str(), PROC_FILE_ID );
-		delete src;
-		return false;
-	}
+	idStr binaryFilename = filename;
+	binaryFilename.SetFileExtension( PROC_BINARY_FILE_EXT );
 
-	// parse the file
-	while ( 1 ) {
-		if ( !src->ReadToken( &token ) ) {
-			break;
-		}
-
-		if ( token == "model" ) {
-			lastModel = ParseModel( src );
-
-			// add it to the model manager list
-			renderModelManager->AddModel( lastModel );
+	if ( !r_useBinaryProc.GetBool() || !LoadBinaryProc( binaryFilename, procCRC, procLength ) ) {
+		idFile_Memory binaryFile( binaryFilename );
 
-			// save it in the list to free when clearing this map
-			localModels.Append( lastModel );
-			continue;
+		if ( r_useBinaryProc.GetBool() ) {
+			binaryFile.SetGranularity( 1024 * 1024 );
+			binaryFile.Write( PROC_BINARY_FILE_ID, 4 );
+			binaryFile.WriteInt( PROC_BINARY_FILE_VERSION );
+			binaryFile.WriteInt( sizeof( idDrawVert ) );
+			binaryFile.WriteInt( sizeof( glIndex_t ) );
+			binaryFile.WriteUnsignedInt( procCRC );
+			binaryFile.WriteInt( procLength );
 		}
 
-		if ( token == "shadowModel" ) {
-			lastModel = ParseShadowModel( src );
-
-			// add it to the model manager list
-			renderModelManager->AddModel( lastModel );
-
-			// save it in the list to free when clearing this map
-			localModels.Append( lastModel );
-			continue;
+		if ( !ParseProc( filename, procBuffer, procLength, r_useBinaryProc.GetBool() ? &binaryFile : NULL ) ) {
+			fileSystem->FreeFile( procBuffer );
+			return false;
 		}
 
-		if ( token == "interAreaPortals" ) {
-			ParseInterAreaPortals( src );
-			continue;
+		if ( r_useBinaryProc.GetBool() ) {
+			binaryFile.WriteInt( PROCB_END );
+			fileSystem->WriteFile( binaryFilename, binaryFile.GetDataPtr(), binaryFile.Length() );
 		}
-
-		if ( token == "nodes" ) {
-			ParseNodes( src );
-			continue;
-		}
-
-		src->Error( "idRenderWorldLocal::InitFromMap: bad token \"%s\"", token.c_str() );
 	}
 
-	delete src;
+	fileSystem->FreeFile( procBuffer );
 
 	// if it was a trivial map without any areas, create a single area
 	if ( !numPortalAreas ) {
@@ -599,6 +1088,7 @@ void idRenderWorldLocal::ClearPortalStates() {
 	for ( i = 0 ; i < numInterAreaPortals ; i++ ) {
 		doublePortals[i].blockingBits = PS_BLOCK_NONE;
 	}
+	portalStateCount++;
 
 	// flood fill all area connections
 	for ( i = 0 ; i < numPortalAreas ; i++ ) {
@@ -28,6 +28,7 @@ typedef struct portal_s {
 	int						intoArea;		// area this portal leads to
 	idWinding *				w;				// winding points have counter clockwise ordering seen this area
 	idPlane					plane;			// view must be on the positive side of the plane to cross
+	idBounds				bounds;			// winding bounds, for quick accepts and rejects before clipping
 	struct portal_s *		next;			// next portal of the area
 	struct doublePortal_s *	doublePortal;
 } portal_t;
@@ -104,6 +105,7 @@ public:
 	virtual	int				NumPortalsInArea( int areaNum );
 	// grayman #3042 - set portal sound loss (in dB)
 	virtual void			SetPortalPlayerLoss( qhandle_t portal, float loss );
+	virtual int				GetPortalStateCount( void ) const;
 
 	virtual exitPortal_t	GetPortal( int areaNum, int portalNum );
 
@@ -141,6 +143,7 @@ public:
 	portalArea_t *			portalAreas;
 	int						numPortalAreas;
 	int						connectedAreaNum;		// incremented every time a door portal state changes
+	int						portalStateCount;		// incremented every time the blocking bits or sound loss of a portal change
 
 	idScreenRect *			areaScreenRect;
 
@@ -156,26 +159,46 @@ public:
 	idBlockAlloc<idInteraction, 256>	interactionAllocator;
 	idBlockAlloc<areaNumRef_t, 1024>	areaNumRefAllocator;
 
+	// references of the def currently being pushed into the tree, reused
+	// by AddEntityRefToArea() / AddLightRefToArea() for areas it still touches
+	areaReference_t *		staleAreaRefs;
+
 	// all light / entity interactions are referenced here for fast lookup without
-	// having to crawl the doubly linked lists.  EnntityDefs are sequential for better
-	// cache access, because the table is accessed by light in idRenderWorldLocal::CreateLightDefInteractions()
-	// Growing this table is time consuming, so we add a pad value to the number
-	// of entityDefs and lightDefs
-	idInteraction **		interactionTable;
-	int						interactionTableWidth;		// entityDefs
-	int						interactionTableHeight;		// lightDefs
+	// having to crawl the doubly linked lists, updated by idInteraction::AllocAndLink()
+	// and idInteraction::UnlinkAndFree()
+	idInteractionTable		interactionTable;
 
 
 	bool					generateAllInteractionsCalled;
 
+	// world space bounds of the refs of an area in SoA layout for CullBoundsByPortals()
+	idList<const idBounds *>	cullBounds;
+	idList<float>			cullCenters;
+	idList<float>			cullExtents;
+	idList<byte>			cullResults;
+
 	//-----------------------
 	// RenderWorld_load.cpp
 
-	idRenderModel *			ParseModel( idLexer *src );
-	idRenderModel *			ParseShadowModel( idLexer *src );
+	idRenderModel *			ParseModel( idLexer *src, idFile *binaryFile );
+	idRenderModel *			ParseShadowModel( idLexer *src, idFile *binaryFile );
 	void					SetupAreaRefs();
-	void					ParseInterAreaPortals( idLexer *src );
-	void					ParseNodes( idLexer *src );
+	void					AddInterAreaPortal( int portalNum, int a1, int a2, idWinding *w );
+	void					ParseInterAreaPortals( idLexer *src, idFile *binaryFile );
+	void					ParseNodes( idLexer *src, idFile *binaryFile );
+	bool					ParseProc( const char *filename, const char *buffer, int length, idFile *binaryFile );
+	void					AddLocalModel( idRenderModel *model );
+
+	// the binary .procb versions of the above
+	void					WriteBinaryModel( idFile *f, const idRenderModel *model ) const;
+	void					WriteBinaryShadowModel( idFile *f, const idRenderModel *model ) const;
+	void					WriteBinaryInterAreaPortals( idFile *f ) const;
+	void					WriteBinaryNodes( idFile *f ) const;
+	idRenderModel *			ReadBinaryModel( idFile *f );
+	idRenderModel *			ReadBinaryShadowModel( idFile *f );
+	bool					ReadBinaryInterAreaPortals( idFile *f );
+	bool					ReadBinaryNodes( idFile *f );
+	bool					LoadBinaryProc( const char *filename, unsigned int procCRC, int procLength );
 	int						CommonChildrenArea_r( areaNode_t *node );
 	void					FreeWorld();
 	void					ClearWorld();
@@ -201,6 +224,7 @@ public:
 	bool					CullLightByPortals( const idRenderLightLocal *light, const struct portalStack_s *ps );
 	void					AddAreaLightRefs( int areaNum, const struct portalStack_s *ps );
 	void					AddAreaRefs( int areaNum, const struct portalStack_s *ps );
+	const byte *			CullBoundsByPortals( const struct portalStack_s *ps, const int numPlanes );
 	void					BuildConnectedAreas_r( int areaNum );
 	void					BuildConnectedAreas( void );
 	void					FindViewLightsAndEntities( void );
@@ -236,10 +260,13 @@ public:
 	//--------------------------
 	// RenderWorld.cpp
 
-	void					ResizeInteractionTable();
 
 	void					AddEntityRefToArea( idRenderEntityLocal *def, portalArea_t *area );
 	void					AddLightRefToArea( idRenderLightLocal *light, portalArea_t *area );
+	areaReference_t *		ReuseAreaRef( portalArea_t *area );
+	void					BeginAreaRefUpdate( areaReference_t **refs );
+	void					EndAreaRefUpdate();
+	void					FreeAreaRefs( areaReference_t *refs );
 
 	void					RecurseProcBSP_r( modelTrace_t *results, int parentNodeNum, int nodeNum, float p1f, float p2f, const idVec3 &p1, const idVec3 &p2 ) const;
 
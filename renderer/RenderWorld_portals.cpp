@@ -141,6 +141,39 @@ bool idRenderWorldLocal::PortalIsFoggedOut( const portal_t *p ) {
 	return true;
 }
 
+/*
+===================
+R_ClipPortalToPlanes
+
+Clips the portal winding to the inside of the stack planes, returns false
+if nothing is left. The portal bounds are classified first, planes that
+can't cut the portal cost no winding work and a portal that is outside
+one of them isn't copied at all. w gets a copy of the portal winding
+the first time a plane really has to clip it.
+===================
+*/
+static const float PORTAL_BOUNDS_EPSILON = 0.1f;
+
+static bool R_ClipPortalToPlanes( const portal_t *p, const idPlane *planes, int numPlanes, idFixedWinding &w, bool &copied ) {
+	for ( int j = 0; j < numPlanes; j++ ) {
+		const int side = p->bounds.PlaneSide( planes[j], PORTAL_BOUNDS_EPSILON );
+		if ( side == PLANESIDE_FRONT ) {
+			return false;	// completely clipped away
+		}
+		if ( side == PLANESIDE_BACK ) {
+			continue;		// completely inside, clipping would keep it as is
+		}
+		if ( !copied ) {
+			w = *p->w;
+			copied = true;
+		}
+		if ( !w.ClipInPlace( -planes[j], 0 ) ) {
+			return false;
+		}
+	}
+	return true;
+}
+
 /*
 ===================
 FloodViewThroughArea_r
@@ -157,6 +190,7 @@ void idRenderWorldLocal::FloodViewThroughArea_r( const idVec3 origin, int areaNu
 	idVec3			v1, v2;
 	int				addPlanes;
 	idFixedWinding	w;		// we won't overflow because MAX_PORTAL_PLANES = 20
+	bool			copied;
 
 	area = &portalAreas[ areaNum ];
 
@@ -197,8 +231,7 @@ void idRenderWorldLocal::FloodViewThroughArea_r( const idVec3 origin, int areaNu
 		// it, which tends to give epsilon problems that make the area vanish
 		if ( d < 1.0f ) {
 			// SteveL #3815: check the view origin is really in front of the portal
-			idBounds pBounds; // uninitialized
-			p->w->GetBounds( pBounds );
+			idBounds pBounds = p->bounds;
 			pBounds.ExpandSelf( 1.0f );
 			if ( pBounds.ContainsPoint(origin) )
 			{
@@ -214,15 +247,13 @@ void idRenderWorldLocal::FloodViewThroughArea_r( const idVec3 origin, int areaNu
 		}
 
 		// clip the portal winding to all of the planes
-		w = *p->w;
-		for ( j = 0; j < ps->numPortalPlanes; j++ ) {
-			if ( !w.ClipInPlace( -ps->portalPlanes[j], 0 ) ) {
-				break;
-			}
-		}
-		if ( !w.GetNumPoints() ) {
+		copied = false;
+		if ( !R_ClipPortalToPlanes( p, ps->portalPlanes, ps->numPortalPlanes, w, copied ) ) {
 			continue;	// portal not visible
 		}
+		if ( !copied ) {
+			w = *p->w;
+		}
 
 		// see if it is fogged out
 		if ( PortalIsFoggedOut( p ) ) {
@@ -343,6 +374,7 @@ void idRenderWorldLocal::FloodLightThroughArea_r( idRenderLightLocal *light, int
 	idVec3			v1, v2;
 	int				addPlanes;
 	idFixedWinding	w;		// we won't overflow because MAX_PORTAL_PLANES = 20
+	bool			copied;
 
 	area = &portalAreas[ areaNum ];
 
@@ -381,25 +413,18 @@ void idRenderWorldLocal::FloodLightThroughArea_r( idRenderLightLocal *light, int
 		}
 
 		// clip the portal winding to all of the planes
-		w = *p->w;
-		for ( j = 0; j < ps->numPortalPlanes; j++ ) {
-			if ( !w.ClipInPlace( -ps->portalPlanes[j], 0 ) ) {
-				break;
-			}
-		}
-		if ( !w.GetNumPoints() ) {
+		copied = false;
+		if ( !R_ClipPortalToPlanes( p, ps->portalPlanes, ps->numPortalPlanes, w, copied ) ) {
 			continue;	// portal not visible
 		}
 		// also always clip to the original light planes, because they aren't
 		// necessarily extending to infinitiy like a view frustum
-		for ( j = 0; j < firstPortalStack->numPortalPlanes; j++ ) {
-			if ( !w.ClipInPlace( -firstPortalStack->portalPlanes[j], 0 ) ) {
-				break;
-			}
-		}
-		if ( !w.GetNumPoints() ) {
+		if ( !R_ClipPortalToPlanes( p, firstPortalStack->portalPlanes, firstPortalStack->numPortalPlanes, w, copied ) ) {
 			continue;	// portal not visible
 		}
+		if ( !copied ) {
+			w = *p->w;
+		}
 
 		// go through this portal
 		newStack.p = p;
@@ -686,6 +711,35 @@ bool idRenderWorldLocal::CullEntityByPortals( const idRenderEntityLocal *entity,
 	return false;
 }
 
+/*
+===================
+CullBoundsByPortals
+
+Box tests the bounds gathered in cullBounds against the first numPlanes
+planes of the portal stack with one SIMD call. Returns a byte per bounds
+that is set if the bounds are completely outside one of the planes.
+===================
+*/
+const byte *idRenderWorldLocal::CullBoundsByPortals( const portalStack_t *ps, const int numPlanes ) {
+	const int num = cullBounds.Num();
+
+	cullCenters.SetNum( num * 3, false );
+	cullExtents.SetNum( num * 3, false );
+	cullResults.SetNum( num, false );
+
+	for ( int i = 0; i < num; i++ ) {
+		const idBounds &b = *cullBounds[i];
+		for ( int j = 0; j < 3; j++ ) {
+			cullCenters[j * num + i] = ( b[0][j] + b[1][j] ) * 0.5f;
+			cullExtents[j * num + i] = ( b[1][j] - b[0][j] ) * 0.5f;
+		}
+	}
+
+	SIMDProcessor->CullBoxes( cullResults.Ptr(), cullCenters.Ptr(), cullExtents.Ptr(), num, ps->portalPlanes, numPlanes );
+
+	return cullResults.Ptr();
+}
+
 /*
 ===================
 AddAreaEntityRefs
@@ -700,10 +754,23 @@ void idRenderWorldLocal::AddAreaEntityRefs( int areaNum, const portalStack_t *ps
 	portalArea_t		*area;
 	viewEntity_t		*vEnt;
 	idBounds			b;
+	const byte			*culled;
+	int					i;
 
 	area = &portalAreas[ areaNum ];
+
+	// throw out the entities whose world bounds are outside the portal
+	// planes all at once, the rest still goes through CullEntityByPortals
+	culled = NULL;
+	if ( r_useBatchPortalCulling.GetBool() && ( r_useAnonreclaimer.GetBool() ? r_useEntityPortalCulling.GetInteger() != 0 : r_useEntityCulling.GetBool() ) ) {
+		cullBounds.SetNum( 0, false );
+		for ( ref = area->entityRefs.areaNext ; ref != &area->entityRefs ; ref = ref->areaNext ) {
+			cullBounds.Append( &ref->entity->globalReferenceBounds );
+		}
+		culled = CullBoundsByPortals( ps, ps->numPortalPlanes );
+	}
 	
-	for ( ref = area->entityRefs.areaNext ; ref != &area->entityRefs ; ref = ref->areaNext ) {
+	for ( ref = area->entityRefs.areaNext, i = 0 ; ref != &area->entityRefs ; ref = ref->areaNext, i++ ) {
 		entity = ref->entity;
 		
 		// debug tool to allow viewing of only one entity at a time
@@ -733,7 +800,7 @@ void idRenderWorldLocal::AddAreaEntityRefs( int areaNum, const portalStack_t *ps
 		}
 
 		// cull reference bounds
-		if ( CullEntityByPortals( entity, ps ) ) {
+		if ( ( culled && culled[i] ) || CullEntityByPortals( entity, ps ) ) {
 			// we are culled out through this portal chain, but it might
 			// still be visible through others
 			continue;
@@ -921,10 +988,23 @@ void idRenderWorldLocal::AddAreaLightRefs( int areaNum, const portalStack_t *ps
 	portalArea_t		*area;
 	idRenderLightLocal			*light;
 	viewLight_t			*vLight;
+	const byte			*culled;
+	int					i;
 
 	area = &portalAreas[ areaNum ];
 
-	for ( lref = area->lightRefs.areaNext ; lref != &area->lightRefs ; lref = lref->areaNext ) {
+	// same for the light frustum bounds, without the last plane
+	// because lights are not near clipped
+	culled = NULL;
+	if ( r_useBatchPortalCulling.GetBool() && ( r_useAnonreclaimer.GetBool() ? r_useLightPortalCulling.GetInteger() != 0 : r_useLightCulling.GetInteger() != 0 ) ) {
+		cullBounds.SetNum( 0, false );
+		for ( lref = area->lightRefs.areaNext ; lref != &area->lightRefs ; lref = lref->areaNext ) {
+			cullBounds.Append( &lref->light->frustumTris->bounds );
+		}
+		culled = CullBoundsByPortals( ps, ps->numPortalPlanes - 1 );
+	}
+
+	for ( lref = area->lightRefs.areaNext, i = 0 ; lref != &area->lightRefs ; lref = lref->areaNext, i++ ) {
 		light = lref->light;
 		
 
@@ -951,7 +1031,7 @@ void idRenderWorldLocal::AddAreaLightRefs( int areaNum, const portalStack_t *ps
 		}
 
 		// cull frustum
-		if ( CullLightByPortals( light, ps ) ) {
+		if ( ( culled && culled[i] ) || CullLightByPortals( light, ps ) ) {
 			// we are culled out through this portal chain, but it might
 			// still be visible through others
 			continue;
@@ -1201,6 +1281,7 @@ void		idRenderWorldLocal::SetPortalState( qhandle_t portal, int blockTypes ) {
 		return;
 	}
 	doublePortals[portal-1].blockingBits = blockTypes;
+	portalStateCount++;
 
 	// leave the connectedAreaGroup the same on one side,
 	// then flood fill from the other side with a new number for each changed attribute
@@ -27,6 +27,7 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 idCVar idVertexCache::r_showVertexCache( "r_showVertexCache", "0", CVAR_INTEGER|CVAR_RENDERER, "" );
 idCVar idVertexCache::r_vertexBufferMegs( "r_vertexBufferMegs", "32", CVAR_INTEGER|CVAR_RENDERER, "" );
+idCVar idVertexCache::r_mapVertexCache( "r_mapVertexCache", "1", CVAR_BOOL|CVAR_RENDERER, "write frame temp vertexes through an unsynchronized buffer mapping instead of glBufferSubData" );
 
 idVertexCache		vertexCache;
 
@@ -61,7 +62,9 @@ void idVertexCache::ActuallyFree( vertCache_t *block ) {
 		staticAllocTotal -= block->size;
 		staticCountTotal--;
 
-		if ( block->vbo ) {
+		if ( block->chunk ) {
+			FreeChunkSpace( block );
+		} else if ( block->vbo ) {
 #if 0		// this isn't really necessary, it will be reused soon enough
 			// filling with zero length data is the equivalent of freeing
 			qglBindBufferARB(GL_ARRAY_BUFFER_ARB, block->vbo);
@@ -92,6 +95,125 @@ void idVertexCache::ActuallyFree( vertCache_t *block ) {
 	block->prev->next = block;
 }
 
+/*
+==============
+idVertexCache::AllocChunkSpace
+
+Static blocks are packed into a few large buffer objects, so the driver
+doesn't have to track and switch between thousands of tiny ones
+==============
+*/
+void idVertexCache::AllocChunkSpace( vertCache_t *block, int size, bool indexBuffer ) {
+	const int alignedSize = ( size + STATIC_ALIGNMENT - 1 ) & ~( STATIC_ALIGNMENT - 1 );
+
+	// first fit in the existing buffers
+	for ( int i = 0 ; i < chunks.Num() ; i++ ) {
+		vertChunk_t *chunk = chunks[i];
+		if ( chunk->indexBuffer != indexBuffer ) {
+			continue;
+		}
+		for ( int j = 0 ; j < chunk->freeSpans.Num() ; j++ ) {
+			vertSpan_t &span = chunk->freeSpans[j];
+			if ( span.size < alignedSize ) {
+				continue;
+			}
+			block->chunk = chunk;
+			block->vbo = chunk->vbo;
+			block->offset = span.offset;
+			span.offset += alignedSize;
+			span.size -= alignedSize;
+			if ( span.size == 0 ) {
+				chunk->freeSpans.RemoveIndex( j );
+			}
+			return;
+		}
+	}
+
+	// start a new buffer, oversized blocks get one to themselves
+	const GLenum target = indexBuffer ? GL_ELEMENT_ARRAY_BUFFER_ARB : GL_ARRAY_BUFFER_ARB;
+	vertChunk_t *chunk = new vertChunk_t;
+	chunk->indexBuffer = indexBuffer;
+	chunk->size = alignedSize > STATIC_CHUNK_BYTES ? alignedSize : STATIC_CHUNK_BYTES;
+	qglGenBuffersARB( 1, &chunk->vbo );
+	qglBindBufferARB( target, chunk->vbo );
+	qglBufferDataARB( target, (GLsizeiptrARB)chunk->size, NULL, GL_STATIC_DRAW_ARB );
+	chunks.Append( chunk );
+
+	if ( chunk->size > alignedSize ) {
+		vertSpan_t &span = chunk->freeSpans.Alloc();
+		span.offset = alignedSize;
+		span.size = chunk->size - alignedSize;
+	}
+
+	block->chunk = chunk;
+	block->vbo = chunk->vbo;
+	block->offset = 0;
+}
+
+/*
+==============
+idVertexCache::FreeChunkSpace
+
+Gives the block's range back to its buffer, merging it with the free
+neighbours so the buffer doesn't fragment into unusable slivers
+==============
+*/
+void idVertexCache::FreeChunkSpace( vertCache_t *block ) {
+	idList<vertSpan_t> &spans = block->chunk->freeSpans;
+	const int offset = block->offset;
+	const int size = ( block->size + STATIC_ALIGNMENT - 1 ) & ~( STATIC_ALIGNMENT - 1 );
+
+	// find the first free span behind the block
+	int lo = 0;
+	int hi = spans.Num();
+	while ( lo < hi ) {
+		const int mid = ( lo + hi ) >> 1;
+		if ( spans[mid].offset < offset ) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	const bool mergePrev = lo > 0 && spans[lo-1].offset + spans[lo-1].size == offset;
+	const bool mergeNext = lo < spans.Num() && offset + size == spans[lo].offset;
+
+	if ( mergePrev && mergeNext ) {
+		spans[lo-1].size += size + spans[lo].size;
+		spans.RemoveIndex( lo );
+	} else if ( mergePrev ) {
+		spans[lo-1].size += size;
+	} else if ( mergeNext ) {
+		spans[lo].offset = offset;
+		spans[lo].size += size;
+	} else {
+		vertSpan_t span;
+		span.offset = offset;
+		span.size = size;
+		spans.Insert( span, lo );
+	}
+
+	block->chunk = NULL;
+	block->vbo = 0;
+}
+
+/*
+==============
+idVertexCache::FreeChunks
+
+The buffer objects are already gone when the context was destroyed
+==============
+*/
+void idVertexCache::FreeChunks( bool deleteBuffers ) {
+	for ( int i = 0 ; i < chunks.Num() ; i++ ) {
+		if ( deleteBuffers ) {
+			qglDeleteBuffersARB( 1, &chunks[i]->vbo );
+		}
+		delete chunks[i];
+	}
+	chunks.Clear();
+}
+
 /*
 ==============
 idVertexCache::Position
@@ -111,12 +233,9 @@ void *idVertexCache::Position( vertCache_t *buffer ) {
 	// the ARB vertex object just uses an offset
 	else if ( buffer->vbo ) {
 		if ( r_showVertexCache.GetInteger() == 2 ) {
-			if ( buffer->tag == TAG_TEMP ) {
-				common->Printf( "GL_ARRAY_BUFFER_ARB = %i + %i (%i bytes)\n", buffer->vbo, buffer->offset, buffer->size ); 
-			} else {
-				common->Printf( "GL_ARRAY_BUFFER_ARB = %i (%i bytes)\n", buffer->vbo, buffer->size ); 
-			}
+			common->Printf( "GL_ARRAY_BUFFER_ARB = %i + %i (%i bytes)\n", buffer->vbo, buffer->offset, buffer->size ); 
 		}
+		backEnd.pc.c_bufferBinds++;
 		if ( buffer->indexBuffer ) {
 			qglBindBufferARB( GL_ELEMENT_ARRAY_BUFFER_ARB, buffer->vbo );
 		} else {
@@ -149,6 +268,11 @@ void idVertexCache::Init() {
 	}
 
 	virtualMemory = false;
+	tempMapped = NULL;
+	tempMapStart = 0;
+
+	// a new context doesn't have the old buffers any more
+	FreeChunks( false );
 
 	// use ARB_vertex_buffer_object unless explicitly disabled
 	if( r_useVertexBuffers.GetInteger() && glConfig.ARBVertexBufferObjectAvailable ) {
@@ -205,6 +329,10 @@ idVertexCache::Shutdown
 void idVertexCache::Shutdown() {
 //	PurgeAll();	// !@#: also purge the temp buffers
 
+	if ( !virtualMemory ) {
+		UnmapFrameTemp();
+		FreeChunks( true );
+	}
 	headerAllocator.Shutdown();
 }
 
@@ -231,10 +359,6 @@ void idVertexCache::Alloc( void *data, int size, vertCache_t **buffer, bool inde
 			block->prev = &freeStaticHeaders;
 			block->next->prev = block;
 			block->prev->next = block;
-
-			if( !virtualMemory ) {
-				qglGenBuffersARB( 1, & block->vbo );
-			}
 		}
 	}
 
@@ -267,21 +391,22 @@ void idVertexCache::Alloc( void *data, int size, vertCache_t **buffer, bool inde
 	block->frameUsed = currentFrame - NUM_VERTEX_FRAMES;
 
 	block->indexBuffer = indexBuffer;
+	block->chunk = NULL;
+	block->virtMem = NULL;
 
 	// copy the data
-	if ( block->vbo ) {
-		if ( indexBuffer ) {
-			qglBindBufferARB( GL_ELEMENT_ARRAY_BUFFER_ARB, block->vbo );
-			qglBufferDataARB( GL_ELEMENT_ARRAY_BUFFER_ARB, (GLsizeiptrARB)size, data, GL_STATIC_DRAW_ARB );
-		} else {
-			qglBindBufferARB( GL_ARRAY_BUFFER_ARB, block->vbo );
-			if ( allocatingTempBuffer ) {
-				qglBufferDataARB( GL_ARRAY_BUFFER_ARB, (GLsizeiptrARB)size, data, GL_STREAM_DRAW_ARB );
-			} else {
-				qglBufferDataARB( GL_ARRAY_BUFFER_ARB, (GLsizeiptrARB)size, data, GL_STATIC_DRAW_ARB );
-			}
-		}
+	if ( allocatingTempBuffer && !virtualMemory ) {
+		// the frame temp buffers get their own buffer object, so they can be mapped
+		qglGenBuffersARB( 1, &block->vbo );
+		qglBindBufferARB( GL_ARRAY_BUFFER_ARB, block->vbo );
+		qglBufferDataARB( GL_ARRAY_BUFFER_ARB, (GLsizeiptrARB)size, data, GL_STREAM_DRAW_ARB );
+	} else if ( !virtualMemory ) {
+		AllocChunkSpace( block, size, indexBuffer );
+		const GLenum target = indexBuffer ? GL_ELEMENT_ARRAY_BUFFER_ARB : GL_ARRAY_BUFFER_ARB;
+		qglBindBufferARB( target, block->vbo );
+		qglBufferSubDataARB( target, block->offset, (GLsizeiptrARB)size, data );
 	} else {
+		block->vbo = 0;
 		block->virtMem = Mem_Alloc( size );
 		SIMDProcessor->Memcpy( block->virtMem, data, size );
 	}
@@ -337,6 +462,7 @@ void idVertexCache::Free( vertCache_t *block ) {
 	// this block still can't be purged until the frame count has expired,
 	// but it won't need to clear a user pointer when it is
 	block->user = NULL;
+	block->frameUsed = currentFrame;
 
 	block->next->prev = block->prev;
 	block->prev->next = block->next;
@@ -398,6 +524,7 @@ vertCache_t	*idVertexCache::AllocFrameTemp( void *data, int size ) {
 	block->size = size;
 	block->tag = TAG_TEMP;
 	block->indexBuffer = false;
+	block->chunk = NULL;
 	block->offset = dynamicAllocThisFrame;
 	dynamicAllocThisFrame += block->size;
 	dynamicCountThisFrame++;
@@ -409,8 +536,13 @@ vertCache_t	*idVertexCache::AllocFrameTemp( void *data, int size ) {
 	block->vbo = tempBuffers[listNum]->vbo;
 
 	if ( block->vbo ) {
-		qglBindBufferARB( GL_ARRAY_BUFFER_ARB, block->vbo );
-		qglBufferSubDataARB( GL_ARRAY_BUFFER_ARB, block->offset, (GLsizeiptrARB)size, data );
+		byte *mapped = MapFrameTemp();
+		if ( mapped ) {
+			SIMDProcessor->Memcpy( mapped + block->offset - tempMapStart, data, size );
+		} else {
+			qglBindBufferARB( GL_ARRAY_BUFFER_ARB, block->vbo );
+			qglBufferSubDataARB( GL_ARRAY_BUFFER_ARB, block->offset, (GLsizeiptrARB)size, data );
+		}
 	} else {
 		SIMDProcessor->Memcpy( (byte *)block->virtMem + block->offset, data, size );
 	}
@@ -418,6 +550,58 @@ vertCache_t	*idVertexCache::AllocFrameTemp( void *data, int size ) {
 	return block;
 }
 
+/*
+===========
+idVertexCache::MapFrameTemp
+
+The temp buffer of the frame is mapped unsynchronized, so every
+AllocFrameTemp is a plain memcpy instead of a driver call.  The first
+map of a frame orphans the storage, which the GPU may still be reading
+from NUM_VERTEX_FRAMES ago.  A map after commands were already issued
+this frame only invalidates the part that nothing refers to yet.
+===========
+*/
+byte *idVertexCache::MapFrameTemp() {
+	if ( tempMapped ) {
+		return tempMapped;
+	}
+	if ( !r_mapVertexCache.GetBool() || !glMapBufferRange || !glFlushMappedBufferRange || !glUnmapBuffer ) {
+		return NULL;
+	}
+
+	GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+	if ( dynamicAllocThisFrame == 0 ) {
+		access |= GL_MAP_INVALIDATE_BUFFER_BIT;
+	} else {
+		access |= GL_MAP_INVALIDATE_RANGE_BIT;
+	}
+
+	tempMapStart = dynamicAllocThisFrame;
+	qglBindBufferARB( GL_ARRAY_BUFFER_ARB, tempBuffers[listNum]->vbo );
+	tempMapped = (byte *)glMapBufferRange( GL_ARRAY_BUFFER_ARB, tempMapStart, FRAME_MEMORY_BYTES - tempMapStart, access );
+	return tempMapped;
+}
+
+/*
+===========
+idVertexCache::UnmapFrameTemp
+===========
+*/
+void idVertexCache::UnmapFrameTemp() {
+	if ( !tempMapped ) {
+		return;
+	}
+
+	// only the part written to has to reach the GPU
+	qglBindBufferARB( GL_ARRAY_BUFFER_ARB, tempBuffers[listNum]->vbo );
+	if ( dynamicAllocThisFrame > tempMapStart ) {
+		glFlushMappedBufferRange( GL_ARRAY_BUFFER_ARB, 0, dynamicAllocThisFrame - tempMapStart );
+	}
+	glUnmapBuffer( GL_ARRAY_BUFFER_ARB );
+	qglBindBufferARB( GL_ARRAY_BUFFER_ARB, 0 );
+	tempMapped = NULL;
+}
+
 /*
 ===========
 idVertexCache::EndFrame
@@ -454,6 +638,8 @@ void idVertexCache::EndFrame() {
 #endif
 
 	if( !virtualMemory ) {
+		UnmapFrameTemp();
+
 		// unbind vertex buffers so normal virtual memory will be used in case
 		// r_useVertexBuffers / r_useIndexBuffers
 		qglBindBufferARB( GL_ARRAY_BUFFER_ARB, 0 );
@@ -469,9 +655,14 @@ void idVertexCache::EndFrame() {
 	dynamicCountThisFrame = 0;
 	tempOverflow = false;
 
-	// free all the deferred free headers
-	while( deferredFreeList.next != &deferredFreeList ) {
-		ActuallyFree( deferredFreeList.next );
+	// free all the deferred free headers, oldest first
+	// with a render thread the back end may still be drawing the frame
+	// that freed them, so those have to wait for one more frame
+	while( deferredFreeList.prev != &deferredFreeList ) {
+		if ( glConfig.smpActive && deferredFreeList.prev->frameUsed >= currentFrame - 1 ) {
+			break;
+		}
+		ActuallyFree( deferredFreeList.prev );
 	}
 
 	// free all the frame temp headers
@@ -522,8 +713,21 @@ void idVertexCache::List( void ) {
 	common->Printf( "%5i free static headers\n", numFreeStaticHeaders );
 	common->Printf( "%5i free dynamic headers\n", numFreeDynamicHeaders );
 
+	int chunkBytes = 0;
+	int chunkFreeBytes = 0;
+	for ( int i = 0 ; i < chunks.Num() ; i++ ) {
+		chunkBytes += chunks[i]->size;
+		for ( int j = 0 ; j < chunks[i]->freeSpans.Num() ; j++ ) {
+			chunkFreeBytes += chunks[i]->freeSpans[j].size;
+		}
+	}
+	common->Printf( "%5i static buffers of %ik total, %ik free\n", chunks.Num(), chunkBytes / 1024, chunkFreeBytes / 1024 );
+
 	if ( !virtualMemory  ) {
 		common->Printf( "Vertex cache is in ARB_vertex_buffer_object memory (FAST).\n");
+		if ( r_mapVertexCache.GetBool() && glMapBufferRange ) {
+			common->Printf( "Frame temp data is written through mapped buffers.\n" );
+		}
 	} else {
 		common->Printf( "Vertex cache is in virtual memory (SLOW)\n" );
 	}
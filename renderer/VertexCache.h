@@ -22,6 +22,8 @@
 #define NUM_VERTEX_FRAMES			2
 #define FRAME_MEMORY_BYTES			0x200000 // frame size
 #define EXPAND_HEADERS				1024
+#define STATIC_CHUNK_BYTES			0x400000 // static blocks are packed into buffer objects of this size
+#define STATIC_ALIGNMENT			16
 
 typedef enum {
 	TAG_FREE,
@@ -30,8 +32,22 @@ typedef enum {
 	TAG_TEMP		// in frame temp area, not static area
 } vertBlockTag_t;
 
+// a buffer object that many static blocks are carved out of
+typedef struct {
+	int				offset;
+	int				size;
+} vertSpan_t;
+
+typedef struct vertChunk_s {
+	GLuint			vbo;
+	bool			indexBuffer;		// index and vertex data are never mixed in one buffer
+	int				size;
+	idList<vertSpan_t>	freeSpans;		// sorted by offset, adjacent spans are always merged
+} vertChunk_t;
+
 typedef struct vertCache_s {
 	GLuint			vbo;
+	vertChunk_t		*chunk;				// the shared buffer a static block lives in, if any
 	void			*virtMem;			// only one of vbo / virtMem will be set
 	bool			indexBuffer;		// holds indexes instead of vertexes
 
@@ -88,6 +104,10 @@ public:
 	// is still referencing it
 	void			Free( vertCache_t *buffer );	
 
+	// the frame temp buffer is written through a mapping, which has to be
+	// released before the back end can draw from it
+	void			UnmapFrameTemp();
+
 	// updates the counter for determining which temp space to use
 	// and which blocks can be purged
 	// Also prints debugging info when enabled
@@ -102,8 +122,14 @@ private:
 	void			InitMemoryBlocks( int size );
 	void			ActuallyFree( vertCache_t *block );
 
+	void			AllocChunkSpace( vertCache_t *block, int size, bool indexBuffer );
+	void			FreeChunkSpace( vertCache_t *block );
+	void			FreeChunks( bool deleteBuffers );
+	byte *			MapFrameTemp();
+
 	static idCVar	r_showVertexCache;
 	static idCVar	r_vertexBufferMegs;
+	static idCVar	r_mapVertexCache;
 
 	int				staticCountTotal;
 	int				staticAllocTotal;		// for end of frame purging
@@ -121,6 +147,11 @@ private:
 	vertCache_t		*tempBuffers[NUM_VERTEX_FRAMES];		// allocated at startup
 	bool			tempOverflow;			// had to alloc a temp in static memory
 
+	byte *			tempMapped;				// tempBuffers[listNum] mapped from tempMapStart on, or NULL
+	int				tempMapStart;
+
+	idList<vertChunk_t *>	chunks;			// shared buffers for the static blocks
+
 	idBlockAlloc<vertCache_t,1024>	headerAllocator;
 
 	vertCache_t		freeStaticHeaders;		// head of doubly linked list
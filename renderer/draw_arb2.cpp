@@ -382,6 +382,346 @@ void RB_ARB2_CreateDrawInteractions_simple( const drawSurf_t *surf ) {
 }
 
 
+/*
+=========================================================================================
+
+SHADOW MAPS
+
+Shadow mapped lights (r_useShadowMaps) don't get any shadow volumes, instead
+the ambient geometry of the casters is drawn into a map that stores the light
+distance packed into RGBA8, so no float or depth texture support is needed.
+Projected lights use a single map that stores the falloff coordinate, point
+lights a cube map that stores the distance to the light origin.
+
+The lit surfaces are then drawn once more with a program that compares against
+the map and sets the stencil of the shadowed pixels, after which the interactions
+are drawn with the same stencil test as for shadow volumes.
+
+=========================================================================================
+*/
+
+static GLuint	shadowMapFbo;
+static GLuint	shadowMapDepth;
+static int		shadowMapSize;
+
+extern bool		fboUsed;
+extern GLuint	fboId;
+
+/*
+==================
+RB_ARB2_AllocShadowMaps
+
+(re)sizes the shadow map images to r_shadowMapSize
+==================
+*/
+static bool RB_ARB2_AllocShadowMaps( void ) {
+	const int size = r_shadowMapSize.GetInteger();
+
+	if ( shadowMapFbo && size == shadowMapSize
+		&& globalImages->shadowMapImage->uploadWidth == size && globalImages->shadowCubeMapImage->uploadWidth == size ) {
+		return true;
+	}
+
+	globalImages->shadowMapImage->Bind();
+	qglTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL );
+	globalImages->shadowMapImage->uploadWidth = size;
+	globalImages->shadowMapImage->uploadHeight = size;
+
+	globalImages->shadowCubeMapImage->Bind();
+	for ( int i = 0 ; i < 6 ; i++ ) {
+		qglTexImage2D( GL_TEXTURE_CUBE_MAP_POSITIVE_X_EXT + i, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL );
+	}
+	globalImages->shadowCubeMapImage->uploadWidth = size;
+	globalImages->shadowCubeMapImage->uploadHeight = size;
+	globalImages->BindNull();
+
+	if ( !shadowMapFbo ) {
+		glGenFramebuffers( 1, &shadowMapFbo );
+		glGenRenderbuffers( 1, &shadowMapDepth );
+	}
+	glBindRenderbuffer( GL_RENDERBUFFER, shadowMapDepth );
+	glRenderbufferStorage( GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size );
+
+	glBindFramebuffer( GL_FRAMEBUFFER, shadowMapFbo );
+	glFramebufferRenderbuffer( GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, shadowMapDepth );
+	glFramebufferTexture2D( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, globalImages->shadowMapImage->texnum, 0 );
+	int status = glCheckFramebufferStatus( GL_FRAMEBUFFER );
+	glBindFramebuffer( GL_FRAMEBUFFER, fboUsed ? fboId : 0 );
+
+	if ( status != GL_FRAMEBUFFER_COMPLETE ) {
+		// go back to shadow volumes for good
+		common->Printf( "RB_ARB2_AllocShadowMaps: glCheckFramebufferStatus %d, r_useShadowMaps disabled\n", status );
+		r_useShadowMaps.SetInteger( 0 );
+		return false;
+	}
+
+	shadowMapSize = size;
+	return true;
+}
+
+/*
+==================
+RB_ARB2_ShadowMapFaceMatrix
+
+the clip space rows for rendering one face of the point light cube map,
+laid out to match the cube map lookup with the light to surface vector
+==================
+*/
+static void RB_ARB2_ShadowMapFaceMatrix( int face, const idVec4 lightRows[3], float range, idVec4 clipRows[4] ) {
+	static const float faceAxis[6][3][3] = {
+		{ {  0,  0, -1 }, { 0, -1,  0 }, {  1,  0,  0 } },	// +X
+		{ {  0,  0,  1 }, { 0, -1,  0 }, { -1,  0,  0 } },	// -X
+		{ {  1,  0,  0 }, { 0,  0,  1 }, {  0,  1,  0 } },	// +Y
+		{ {  1,  0,  0 }, { 0,  0, -1 }, {  0, -1,  0 } },	// -Y
+		{ {  1,  0,  0 }, { 0, -1,  0 }, {  0,  0,  1 } },	// +Z
+		{ { -1,  0,  0 }, { 0, -1,  0 }, {  0,  0, -1 } },	// -Z
+	};
+	idVec4	faceRows[3];
+
+	for ( int i = 0 ; i < 3 ; i++ ) {
+		faceRows[i] = faceAxis[face][i][0] * lightRows[0] + faceAxis[face][i][1] * lightRows[1] + faceAxis[face][i][2] * lightRows[2];
+	}
+
+	// 90 degree perspective projection looking down the face axis
+	const float zNear = 1.0f;
+	const float zFar = Max( range, zNear * 2.0f );
+
+	clipRows[0] = faceRows[0];
+	clipRows[1] = faceRows[1];
+	clipRows[2] = ( ( zFar + zNear ) / ( zFar - zNear ) ) * faceRows[2];
+	clipRows[2].w -= 2.0f * zFar * zNear / ( zFar - zNear );
+	clipRows[3] = faceRows[2];
+}
+
+/*
+==================
+RB_ARB2_ShadowMapLightRows
+
+the rows that take a surface's local coordinates to the world aligned
+vector from the light origin
+==================
+*/
+static void RB_ARB2_ShadowMapLightRows( const viewEntity_t *space, const idVec3 &lightOrigin, idVec4 lightRows[3] ) {
+	const float *m = space->modelMatrix;
+
+	for ( int i = 0 ; i < 3 ; i++ ) {
+		lightRows[i].Set( m[0+i], m[4+i], m[8+i], m[12+i] - lightOrigin[i] );
+	}
+}
+
+/*
+==================
+RB_ARB2_DrawShadowMapCasters
+==================
+*/
+static void RB_ARB2_DrawShadowMapCasters( const viewLight_t *vLight, int face ) {
+	const viewEntity_t *space = NULL;
+
+	for ( const drawSurf_t *surf = vLight->shadowMapCasters; surf; surf = surf->nextOnLight ) {
+		const srfTriangles_t *tri = surf->geo;
+
+		if ( !tri->ambientCache ) {
+			continue;
+		}
+
+		if ( surf->space != space ) {
+			space = surf->space;
+
+			if ( face >= 0 ) {
+				idVec4	lightRows[3];
+				idVec4	clipRows[4];
+
+				RB_ARB2_ShadowMapLightRows( space, vLight->globalLightOrigin, lightRows );
+				RB_ARB2_ShadowMapFaceMatrix( face, lightRows, vLight->shadowMapRange, clipRows );
+				for ( int i = 0 ; i < 4 ; i++ ) {
+					qglProgramEnvParameter4fvARB( GL_VERTEX_PROGRAM_ARB, PP_SHADOW_MAP_0 + i, clipRows[i].ToFloatPtr() );
+				}
+				for ( int i = 0 ; i < 3 ; i++ ) {
+					qglProgramEnvParameter4fvARB( GL_VERTEX_PROGRAM_ARB, PP_SHADOW_MAP_LIGHT_X + i, lightRows[i].ToFloatPtr() );
+				}
+			} else {
+				for ( int i = 0 ; i < 4 ; i++ ) {
+					idPlane	localProject;
+					R_GlobalPlaneToLocal( space->modelMatrix, vLight->lightProject[i], localProject );
+					qglProgramEnvParameter4fvARB( GL_VERTEX_PROGRAM_ARB, PP_SHADOW_MAP_0 + i, localProject.ToFloatPtr() );
+				}
+			}
+		}
+
+		idDrawVert *ac = (idDrawVert *)vertexCache.Position( tri->ambientCache );
+		qglVertexPointer( 3, GL_FLOAT, sizeof( idDrawVert ), ac->xyz.ToFloatPtr() );
+		RB_DrawElementsWithCounters( tri );
+	}
+}
+
+/*
+==================
+RB_ARB2_RenderShadowMap
+
+draws the casters from the light into the shadow map or the six cube map faces
+==================
+*/
+static void RB_ARB2_RenderShadowMap( const viewLight_t *vLight, bool pointLight ) {
+	glBindFramebuffer( GL_FRAMEBUFFER, shadowMapFbo );
+	qglViewport( 0, 0, shadowMapSize, shadowMapSize );
+	qglScissor( 0, 0, shadowMapSize, shadowMapSize );
+	qglClearColor( 1.0f, 1.0f, 1.0f, 1.0f );
+
+	GL_State( GLS_DEPTHFUNC_LESS );
+	// both sides, closed models can't leak any light through back faces
+	GL_Cull( CT_TWO_SIDED );
+
+	if ( pointLight ) {
+		qglBindProgramARB( GL_VERTEX_PROGRAM_ARB, VPROG_SHADOW_MAP_POINT );
+		qglBindProgramARB( GL_FRAGMENT_PROGRAM_ARB, FPROG_SHADOW_MAP_POINT );
+	} else {
+		qglBindProgramARB( GL_VERTEX_PROGRAM_ARB, VPROG_SHADOW_MAP_PROJ );
+		qglBindProgramARB( GL_FRAGMENT_PROGRAM_ARB, FPROG_SHADOW_MAP_PROJ );
+	}
+	qglEnable( GL_VERTEX_PROGRAM_ARB );
+	qglEnable( GL_FRAGMENT_PROGRAM_ARB );
+
+	const idVec4 parms( 1.0f / Max( vLight->shadowMapRange, 1.0f ), r_shadowMapBias.GetFloat(), 0.0f, 0.0f );
+	qglProgramEnvParameter4fvARB( GL_FRAGMENT_PROGRAM_ARB, PP_SHADOW_MAP_PARMS, parms.ToFloatPtr() );
+
+	if ( pointLight ) {
+		for ( int face = 0 ; face < 6 ; face++ ) {
+			glFramebufferTexture2D( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X_EXT + face,
+				globalImages->shadowCubeMapImage->texnum, 0 );
+			qglClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+			RB_ARB2_DrawShadowMapCasters( vLight, face );
+		}
+	} else {
+		glFramebufferTexture2D( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+			globalImages->shadowMapImage->texnum, 0 );
+		qglClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+		RB_ARB2_DrawShadowMapCasters( vLight, -1 );
+	}
+
+	qglDisable( GL_VERTEX_PROGRAM_ARB );
+	qglDisable( GL_FRAGMENT_PROGRAM_ARB );
+
+	// back to the view
+	glBindFramebuffer( GL_FRAMEBUFFER, fboUsed ? fboId : 0 );
+	qglViewport( tr.viewportOffset[0] + backEnd.viewDef->viewport.x1, 
+		tr.viewportOffset[1] + backEnd.viewDef->viewport.y1, 
+		backEnd.viewDef->viewport.x2 + 1 - backEnd.viewDef->viewport.x1,
+		backEnd.viewDef->viewport.y2 + 1 - backEnd.viewDef->viewport.y1 );
+	qglClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
+	GL_Cull( CT_FRONT_SIDED );
+}
+
+/*
+==================
+RB_T_ShadowMapTest
+
+the local to light transforms for the surface being tested against the map
+==================
+*/
+static void RB_T_ShadowMapTest( const drawSurf_t *surf ) {
+	const srfTriangles_t *tri = surf->geo;
+
+	if ( !tri->ambientCache ) {
+		return;
+	}
+
+	if ( surf->space != backEnd.currentSpace ) {
+		const viewLight_t *vLight = backEnd.vLight;
+
+		if ( vLight->lightDef->parms.pointLight ) {
+			idVec4	lightRows[3];
+
+			RB_ARB2_ShadowMapLightRows( surf->space, vLight->globalLightOrigin, lightRows );
+			for ( int i = 0 ; i < 3 ; i++ ) {
+				qglProgramEnvParameter4fvARB( GL_VERTEX_PROGRAM_ARB, PP_SHADOW_MAP_LIGHT_X + i, lightRows[i].ToFloatPtr() );
+			}
+		} else {
+			for ( int i = 0 ; i < 4 ; i++ ) {
+				idPlane	localProject;
+				R_GlobalPlaneToLocal( surf->space->modelMatrix, vLight->lightProject[i], localProject );
+				qglProgramEnvParameter4fvARB( GL_VERTEX_PROGRAM_ARB, PP_SHADOW_MAP_0 + i, localProject.ToFloatPtr() );
+			}
+		}
+	}
+
+	idDrawVert *ac = (idDrawVert *)vertexCache.Position( tri->ambientCache );
+	qglVertexPointer( 3, GL_FLOAT, sizeof( idDrawVert ), ac->xyz.ToFloatPtr() );
+	RB_DrawElementsWithCounters( tri );
+}
+
+/*
+==================
+RB_ARB2_ShadowMapPass
+
+Renders the shadow map of the light and marks the shadowed pixels of the lit
+surfaces in the stencil buffer, the stencil must have been cleared already.
+Leaves the stencil test set up for the interactions like RB_StencilShadowPass.
+==================
+*/
+static void RB_ARB2_ShadowMapPass( const viewLight_t *vLight ) {
+	if ( !r_shadows.GetBool() || !vLight->shadowMapCasters ) {
+		return;
+	}
+	if ( !vLight->localInteractions && !vLight->globalInteractions ) {
+		return;
+	}
+	if ( !RB_ARB2_AllocShadowMaps() ) {
+		return;
+	}
+
+	RB_LogComment( "---------- RB_ARB2_ShadowMapPass ----------\n" );
+
+	const bool pointLight = vLight->lightDef->parms.pointLight;
+
+	if ( glConfig.depthBoundsTestAvailable && r_useDepthBoundsTest.GetBool() ) {
+		qglDisable( GL_DEPTH_BOUNDS_TEST_EXT );
+	}
+
+	globalImages->BindNull();
+
+	RB_ARB2_RenderShadowMap( vLight, pointLight );
+
+	if ( glConfig.depthBoundsTestAvailable && r_useDepthBoundsTest.GetBool() ) {
+		qglEnable( GL_DEPTH_BOUNDS_TEST_EXT );
+	}
+
+	// the scissor was changed for the map
+	backEnd.currentScissor = vLight->scissorRect;
+	if ( r_useScissor.GetBool() ) {
+		qglScissor( backEnd.viewDef->viewport.x1 + backEnd.currentScissor.x1, 
+			backEnd.viewDef->viewport.y1 + backEnd.currentScissor.y1,
+			backEnd.currentScissor.x2 + 1 - backEnd.currentScissor.x1,
+			backEnd.currentScissor.y2 + 1 - backEnd.currentScissor.y1 );
+	}
+
+	// mark the shadowed pixels, the test program kills the lit fragments
+	GL_State( GLS_DEPTHMASK | GLS_COLORMASK | GLS_ALPHAMASK | GLS_DEPTHFUNC_EQUAL );
+	qglStencilFunc( GL_ALWAYS, 255, 255 );
+	qglStencilOp( GL_KEEP, GL_KEEP, GL_REPLACE );
+
+	if ( pointLight ) {
+		qglBindProgramARB( GL_VERTEX_PROGRAM_ARB, VPROG_SHADOW_MAP_TEST_POINT );
+		qglBindProgramARB( GL_FRAGMENT_PROGRAM_ARB, FPROG_SHADOW_MAP_TEST_POINT );
+		globalImages->shadowCubeMapImage->Bind();
+	} else {
+		qglBindProgramARB( GL_VERTEX_PROGRAM_ARB, VPROG_SHADOW_MAP_TEST_PROJ );
+		qglBindProgramARB( GL_FRAGMENT_PROGRAM_ARB, FPROG_SHADOW_MAP_TEST_PROJ );
+		globalImages->shadowMapImage->Bind();
+	}
+	qglEnable( GL_VERTEX_PROGRAM_ARB );
+	qglEnable( GL_FRAGMENT_PROGRAM_ARB );
+
+	RB_RenderDrawSurfChainWithFunction( vLight->localInteractions, RB_T_ShadowMapTest );
+	RB_RenderDrawSurfChainWithFunction( vLight->globalInteractions, RB_T_ShadowMapTest );
+
+	qglDisable( GL_VERTEX_PROGRAM_ARB );
+	qglDisable( GL_FRAGMENT_PROGRAM_ARB );
+	globalImages->BindNull();
+
+	qglStencilFunc( GL_GEQUAL, 128, 255 );
+	qglStencilOp( GL_KEEP, GL_KEEP, GL_KEEP );
+}
+
 /*
 ==================
 RB_ARB2_DrawInteractions
@@ -426,7 +766,7 @@ void RB_ARB2_DrawInteractions( void ) {
 		//anon end
 
 		// clear the stencil buffer if needed
-		if ( vLight->globalShadows || vLight->localShadows ) {
+		if ( vLight->globalShadows || vLight->localShadows || vLight->shadowMapCasters ) {
 			backEnd.currentScissor = vLight->scissorRect;
 			if ( r_useScissor.GetBool() ) {
 				qglScissor( backEnd.viewDef->viewport.x1 + backEnd.currentScissor.x1, 
@@ -435,6 +775,13 @@ void RB_ARB2_DrawInteractions( void ) {
 					backEnd.currentScissor.y2 + 1 - backEnd.currentScissor.y1 );
 			}
 			qglClear( GL_STENCIL_BUFFER_BIT );
+
+			// shadow mapped lights mark their shadows here, they have no volumes
+			if ( vLight->shadowMap ) {
+				const gpuTime_t stage = RB_SetGpuTime( GPU_TIME_SHADOWS );
+				RB_ARB2_ShadowMapPass( vLight );
+				RB_SetGpuTime( stage );
+			}
 		} else {
 			// no shadows, so no need to read or write the stencil buffer
 			// we might in theory want to use GL_ALWAYS instead of disabling
@@ -567,6 +914,16 @@ static progDef_t	progs[MAX_GLPROGS] = {
 	{ GL_VERTEX_PROGRAM_ARB, VPROG_AMBIENT_CUBE_LIGHT, "ambient_cubic_light.vfp" },
 	{ GL_FRAGMENT_PROGRAM_ARB, FPROG_AMBIENT_CUBE_LIGHT, "ambient_cubic_light.vfp" },
 
+	// shadow maps as an alternative to stencil shadow volumes
+	{ GL_VERTEX_PROGRAM_ARB, VPROG_SHADOW_MAP_POINT, "shadowmap_point.vfp" },
+	{ GL_FRAGMENT_PROGRAM_ARB, FPROG_SHADOW_MAP_POINT, "shadowmap_point.vfp" },
+	{ GL_VERTEX_PROGRAM_ARB, VPROG_SHADOW_MAP_PROJ, "shadowmap_proj.vfp" },
+	{ GL_FRAGMENT_PROGRAM_ARB, FPROG_SHADOW_MAP_PROJ, "shadowmap_proj.vfp" },
+	{ GL_VERTEX_PROGRAM_ARB, VPROG_SHADOW_MAP_TEST_POINT, "shadowmap_test_point.vfp" },
+	{ GL_FRAGMENT_PROGRAM_ARB, FPROG_SHADOW_MAP_TEST_POINT, "shadowmap_test_point.vfp" },
+	{ GL_VERTEX_PROGRAM_ARB, VPROG_SHADOW_MAP_TEST_PROJ, "shadowmap_test_proj.vfp" },
+	{ GL_FRAGMENT_PROGRAM_ARB, FPROG_SHADOW_MAP_TEST_PROJ, "shadowmap_test_proj.vfp" },
+
 	// duzenko: backend bloom
 	{ GL_VERTEX_PROGRAM_ARB, VPROG_BLOOM_COOK_MATH1, "cookMath_pass1.vfp" },
 	{ GL_FRAGMENT_PROGRAM_ARB, FPROG_BLOOM_COOK_MATH1, "cookMath_pass1.vfp" },
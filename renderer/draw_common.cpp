@@ -417,9 +417,17 @@ void RB_T_FillDepthBuffer( const drawSurf_t *surf ) {
 		color[3] = 1;
 	}
 
-	idDrawVert *ac = (idDrawVert *)vertexCache.Position( tri->ambientCache );
-	qglVertexPointer( 3, GL_FLOAT, sizeof( idDrawVert ), ac->xyz.ToFloatPtr() );
-	qglTexCoordPointer( 2, GL_FLOAT, sizeof( idDrawVert ), reinterpret_cast<void *>(&ac->st) );
+	// copies of the same model are sorted next to each other, keep the
+	// vertex pointers and only change the matrix between them
+	idDrawVert *ac;
+	if ( tri->ambientCache->vbo && tri->ambientCache == backEnd.currentAmbientCache ) {
+		ac = (idDrawVert *)tri->ambientCache->offset;
+	} else {
+		ac = (idDrawVert *)vertexCache.Position( tri->ambientCache );
+		qglVertexPointer( 3, GL_FLOAT, sizeof( idDrawVert ), ac->xyz.ToFloatPtr() );
+		qglTexCoordPointer( 2, GL_FLOAT, sizeof( idDrawVert ), reinterpret_cast<void *>(&ac->st) );
+		backEnd.currentAmbientCache = tri->ambientCache;
+	}
 
 	bool drawSolid = false;
 
@@ -476,6 +484,9 @@ void RB_T_FillDepthBuffer( const drawSurf_t *surf ) {
 		qglDisable( GL_ALPHA_TEST );
 		if ( !didDraw ) {
 			drawSolid = true;
+		} else {
+			// stage texturing may have moved the texcoord pointer to other buffers
+			backEnd.currentAmbientCache = NULL;
 		}
 	}
 
@@ -503,6 +514,18 @@ void RB_T_FillDepthBuffer( const drawSurf_t *surf ) {
 
 void RB_SetProgramEnvironment(); // Defined in the shader passes section next, now re-used for depth capture in #3877
 
+/*
+=====================
+RB_NeedsDepthCapture
+
+The front end flags the views that have soft particles or materials
+reading _currentDepth, the others can skip the depth copy
+=====================
+*/
+static bool RB_NeedsDepthCapture( void ) {
+	return backEnd.viewDef->needsCurrentDepth || !r_skipUnusedDepthCapture.GetBool();
+}
+
 /*
 =====================
 RB_STD_FillDepthBuffer
@@ -549,7 +572,8 @@ void RB_STD_FillDepthBuffer( drawSurf_t **drawSurfs, int numDrawSurfs ) {
 	if ( backEnd.viewDef->renderView.viewID >= TR_SCREEN_VIEW_ID  // Suppress for lightgem rendering passes
 		 && !r_skipDepthCapture.GetBool() )
 	{
-		if (!r_useFbo.GetBool()) // duzenko #4425 - depth texture will be available later in RB_STD_DrawShaderPasses
+		// views without soft particles or materials that sample _currentDepth don't need the copy
+		if (!r_useFbo.GetBool() && RB_NeedsDepthCapture()) // duzenko #4425 - depth texture will be available later in RB_STD_DrawShaderPasses
 			globalImages->currentDepthImage->CopyDepthbuffer( backEnd.viewDef->viewport.x1,
 														  backEnd.viewDef->viewport.y1,
 														  backEnd.viewDef->viewport.x2 - backEnd.viewDef->viewport.x1 + 1,
@@ -569,6 +593,129 @@ void RB_STD_FillDepthBuffer( drawSurf_t **drawSurfs, int numDrawSurfs ) {
 /*
 =============================================================================================
 
+OCCLUSION QUERIES
+
+=============================================================================================
+*/
+
+occlusionResult_t	occlusionResults[MAX_OCCLUSION_LIGHTS];
+
+static GLuint		occlusionQueries[MAX_OCCLUSION_LIGHTS];
+static int			occlusionQueryFrames[MAX_OCCLUSION_LIGHTS];		// of the test in flight
+static bool			occlusionQueryPending[MAX_OCCLUSION_LIGHTS];
+static idList<int>	occlusionPendingLights;
+
+/*
+==================
+RB_ResetOcclusionQueries
+
+The query objects belong to the context, so a new one starts from scratch
+==================
+*/
+void RB_ResetOcclusionQueries( void ) {
+	memset( occlusionResults, 0, sizeof( occlusionResults ) );
+	memset( occlusionQueries, 0, sizeof( occlusionQueries ) );
+	memset( occlusionQueryPending, 0, sizeof( occlusionQueryPending ) );
+	occlusionPendingLights.Clear();
+}
+
+/*
+==================
+RB_DrawOcclusionBounds
+==================
+*/
+static void RB_DrawOcclusionBounds( const idBounds &bounds ) {
+	const idVec3 &b0 = bounds[0];
+	const idVec3 &b1 = bounds[1];
+
+	qglBegin( GL_QUADS );
+	qglVertex3f( b0[0], b0[1], b0[2] ); qglVertex3f( b0[0], b1[1], b0[2] ); qglVertex3f( b1[0], b1[1], b0[2] ); qglVertex3f( b1[0], b0[1], b0[2] );
+	qglVertex3f( b0[0], b0[1], b1[2] ); qglVertex3f( b1[0], b0[1], b1[2] ); qglVertex3f( b1[0], b1[1], b1[2] ); qglVertex3f( b0[0], b1[1], b1[2] );
+	qglVertex3f( b0[0], b0[1], b0[2] ); qglVertex3f( b1[0], b0[1], b0[2] ); qglVertex3f( b1[0], b0[1], b1[2] ); qglVertex3f( b0[0], b0[1], b1[2] );
+	qglVertex3f( b0[0], b1[1], b0[2] ); qglVertex3f( b0[0], b1[1], b1[2] ); qglVertex3f( b1[0], b1[1], b1[2] ); qglVertex3f( b1[0], b1[1], b0[2] );
+	qglVertex3f( b0[0], b0[1], b0[2] ); qglVertex3f( b0[0], b0[1], b1[2] ); qglVertex3f( b0[0], b1[1], b1[2] ); qglVertex3f( b0[0], b1[1], b0[2] );
+	qglVertex3f( b1[0], b0[1], b0[2] ); qglVertex3f( b1[0], b1[1], b0[2] ); qglVertex3f( b1[0], b1[1], b1[2] ); qglVertex3f( b1[0], b0[1], b1[2] );
+	qglEnd();
+}
+
+/*
+==================
+RB_STD_OcclusionQueries
+
+Collects the results of earlier light volume queries that have come back,
+then tests the light volumes queued by the front end against the depth
+buffer that was just filled.  Nothing waits on the GPU, a light with a
+query still in flight simply isn't tested again until its result is in.
+==================
+*/
+void RB_STD_OcclusionQueries( void ) {
+	if ( !glConfig.occlusionQueryAvailable ) {
+		return;
+	}
+
+	for ( int i = 0 ; i < occlusionPendingLights.Num() ; i++ ) {
+		const int lightNum = occlusionPendingLights[i];
+		GLuint available = 0;
+		qglGetQueryObjectuivARB( occlusionQueries[lightNum], GL_QUERY_RESULT_AVAILABLE_ARB, &available );
+		if ( !available ) {
+			continue;
+		}
+		GLuint samples = 0;
+		qglGetQueryObjectuivARB( occlusionQueries[lightNum], GL_QUERY_RESULT_ARB, &samples );
+		occlusionResults[lightNum].occluded = ( samples == 0 );
+		occlusionResults[lightNum].frameCount = occlusionQueryFrames[lightNum];
+		occlusionQueryPending[lightNum] = false;
+		occlusionPendingLights.RemoveIndex( i, false );
+		i--;
+	}
+
+	if ( !backEnd.viewDef->occlusionTests ) {
+		return;
+	}
+
+	RB_LogComment( "---------- RB_STD_OcclusionQueries ----------\n" );
+
+	// depth test only, nothing is written
+	GL_SelectTexture( 0 );
+	globalImages->BindNull();
+	GL_State( GLS_COLORMASK | GLS_ALPHAMASK | GLS_DEPTHMASK | GLS_DEPTHFUNC_LESS );
+	GL_Cull( CT_TWO_SIDED );
+
+	qglLoadMatrixf( backEnd.viewDef->worldSpace.modelViewMatrix );
+	backEnd.currentSpace = &backEnd.viewDef->worldSpace;
+
+	if ( r_useScissor.GetBool() ) {
+		qglScissor( backEnd.viewDef->viewport.x1 + backEnd.viewDef->scissor.x1, 
+			backEnd.viewDef->viewport.y1 + backEnd.viewDef->scissor.y1, 
+			backEnd.viewDef->scissor.x2 - backEnd.viewDef->scissor.x1 + 1,
+			backEnd.viewDef->scissor.y2 - backEnd.viewDef->scissor.y1 + 1 );
+		backEnd.currentScissor = backEnd.viewDef->scissor;
+	}
+
+	for ( const occlusionTest_t *test = backEnd.viewDef->occlusionTests ; test ; test = test->next ) {
+		const int lightNum = test->lightNum;
+		if ( occlusionQueryPending[lightNum] ) {
+			continue;
+		}
+		if ( !occlusionQueries[lightNum] ) {
+			qglGenQueriesARB( 1, &occlusionQueries[lightNum] );
+		}
+
+		qglBeginQueryARB( GL_SAMPLES_PASSED_ARB, occlusionQueries[lightNum] );
+		RB_DrawOcclusionBounds( test->bounds );
+		qglEndQueryARB( GL_SAMPLES_PASSED_ARB );
+
+		occlusionQueryPending[lightNum] = true;
+		occlusionQueryFrames[lightNum] = test->frameCount;
+		occlusionPendingLights.Append( lightNum );
+	}
+
+	GL_Cull( CT_FRONT_SIDED );
+}
+
+/*
+=============================================================================================
+
 SHADER PASSES
 
 =============================================================================================
@@ -1133,7 +1280,7 @@ int RB_STD_DrawShaderPasses( drawSurf_t **drawSurfs, int numDrawSurfs ) {
 		}
 		extern void RB_FboAccessColorDepth(bool DepthToo); // duzenko #4425 FIXME ugly magic extern
 		if (r_useFbo.GetBool())
-			RB_FboAccessColorDepth(true);
+			RB_FboAccessColorDepth(RB_NeedsDepthCapture());
 		backEnd.currentRenderCopied = true;
 	}
 
@@ -1432,6 +1579,8 @@ void RB_StencilShadowPass( const drawSurf_t *drawSurfs ) {
 
 	RB_LogComment( "---------- RB_StencilShadowPass ----------\n" );
 
+	const gpuTime_t stage = RB_SetGpuTime( GPU_TIME_SHADOWS );
+
 	globalImages->BindNull();
 	qglDisableClientState( GL_TEXTURE_COORD_ARRAY );
 
@@ -1476,6 +1625,8 @@ void RB_StencilShadowPass( const drawSurf_t *drawSurfs ) {
 
 	qglStencilFunc( GL_GEQUAL, 128, 255 );
 	qglStencilOp( GL_KEEP, GL_KEEP, GL_KEEP );
+
+	RB_SetGpuTime( stage );
 }
 
 
@@ -1934,9 +2085,15 @@ void	RB_STD_DrawView( void ) {
 
 	// fill the depth buffer and clear color buffer to black except on
 	// subviews
+	RB_SetGpuTime( GPU_TIME_DEPTH );
 	RB_STD_FillDepthBuffer( drawSurfs, numDrawSurfs );
 
+	// test the light volumes against the new depth buffer for the coming frames
+	RB_SetGpuTime( GPU_TIME_OCCLUSION );
+	RB_STD_OcclusionQueries();
+
 	// main light renderer
+	RB_SetGpuTime( GPU_TIME_INTERACTIONS );
 	switch( tr.backEndRenderer ) {
 	case BE_ARB:
 		RB_ARB_DrawInteractions();
@@ -1959,19 +2116,23 @@ void	RB_STD_DrawView( void ) {
 	qglStencilFunc( GL_ALWAYS, 128, 255 );
 
 	// uplight the entire screen to crutch up not having better blending range
+	RB_SetGpuTime( GPU_TIME_SHADER_PASSES );
 	RB_STD_LightScale();
 
 	// now draw any non-light dependent shading passes
 	processed = RB_STD_DrawShaderPasses( drawSurfs, numDrawSurfs );
 
 	// fog and blend lights
+	RB_SetGpuTime( GPU_TIME_FOG );
 	RB_STD_FogAllLights();
 
 	// now draw any post-processing effects using _currentRender
 	if ( processed < numDrawSurfs ) {
+		RB_SetGpuTime( GPU_TIME_POST_PROCESS );
 		RB_STD_DrawShaderPasses( drawSurfs+processed, numDrawSurfs-processed );
 	}
 
+	RB_SetGpuTime( GPU_TIME_OTHER );
 	RB_RenderDebugTools(drawSurfs, numDrawSurfs);
 }
 
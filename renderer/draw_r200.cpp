@@ -371,7 +371,7 @@ static void R_BuildSurfaceFragmentProgram( int programNum ) {
 	qglSampleMapATI( GL_REG_5_ATI, GL_TEXTURE5_ARB, GL_SWIZZLE_STR_ATI );
 
 	// move the alpha component to the red channel to support rxgb normal map compression
-	if ( globalImages->image_useNormalCompression.GetInteger() == 2 ) {
+	if ( globalImages->image_useNormalCompression.GetInteger() >= 2 ) {
 		qglColorFragmentOp1ATI( GL_MOV_ATI, GL_REG_4_ATI, GL_RED_BIT_ATI, GL_NONE,
 			GL_REG_4_ATI, GL_ALPHA, GL_NONE );
 	}
@@ -89,6 +89,7 @@ extern PFNGLGETBUFFERPARAMETERIVARBPROC qglGetBufferParameterivARB;
 extern PFNGLGETBUFFERPOINTERVARBPROC qglGetBufferPointervARB;
 extern PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
 extern PFNGLUNMAPBUFFERPROC glUnmapBuffer;
+extern PFNGLFLUSHMAPPEDBUFFERRANGEPROC glFlushMappedBufferRange;
 extern PFNGLBUFFERSUBDATAPROC glBufferSubData;
 
 // NV_register_combiners
@@ -142,6 +143,17 @@ extern PFNGLPROGRAMLOCALPARAMETER4FVARBPROC	qglProgramLocalParameter4fvARB;
 // GL_EXT_depth_bounds_test
 extern PFNGLDEPTHBOUNDSEXTPROC              qglDepthBoundsEXT;
 
+// ARB_occlusion_query
+extern PFNGLGENQUERIESARBPROC               qglGenQueriesARB;
+extern PFNGLDELETEQUERIESARBPROC            qglDeleteQueriesARB;
+extern PFNGLBEGINQUERYARBPROC               qglBeginQueryARB;
+extern PFNGLENDQUERYARBPROC                 qglEndQueryARB;
+extern PFNGLGETQUERYOBJECTUIVARBPROC        qglGetQueryObjectuivARB;
+
+// ARB_timer_query
+extern PFNGLQUERYCOUNTERPROC                qglQueryCounter;
+extern PFNGLGETQUERYOBJECTUI64VPROC         qglGetQueryObjectui64v;
+
 // mipmaps
 extern PFNGLGENERATEMIPMAPPROC              glGenerateMipmap;
 
@@ -25,6 +25,8 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 
 frameData_t		*frameData;
+frameData_t		*smpFrameData[NUM_FRAME_DATA];
+int				smpFrame;
 backEndState_t	backEnd;
 
 
@@ -248,6 +250,8 @@ void GL_State( const int stateBits ) {
 	}
 #endif
 
+	backEnd.pc.c_glStateChanges++;
+
 	// check depthFunc bits
 	if ( diff & ( GLS_DEPTHFUNC_EQUAL | GLS_DEPTHFUNC_LESS | GLS_DEPTHFUNC_ALWAYS ) ) {
 		if ( stateBits & GLS_DEPTHFUNC_EQUAL ) {
@@ -611,7 +615,9 @@ const void RB_CopyRender( const void *data ) {
 
 	if (cmd->image) {
 		if (cmd->image == globalImages->bloomImage) { // duzenko: hack? better to extend renderCommand_t? not necessary at all because of r_postprocess?
+			const gpuTime_t stage = RB_SetGpuTime( GPU_TIME_POST_PROCESS );
 			RB_Bloom();
+			RB_SetGpuTime( stage );
 		} else
 			cmd->image->CopyFramebuffer( cmd->x, cmd->y, cmd->imageWidth, cmd->imageHeight, false );
 	}
@@ -780,6 +786,155 @@ void RB_FboLeave( viewDef_t* viewDef ) {
 	GL_CheckErrors();
 }
 
+/*
+=============================================================================================
+
+GPU TIMES
+
+=============================================================================================
+*/
+
+const char *gpuTimeNames[NUM_GPU_TIMES] = {
+	"other", "depth", "occlusion", "interactions", "shadows", "shader passes", "fog", "post process"
+};
+
+gpuTimes_t			gpuTimes;
+bool				gpuTimesRequested;
+
+typedef struct {
+	GLuint			queries[MAX_GPU_TIME_QUERIES];
+	byte			stages[MAX_GPU_TIME_QUERIES];	// the query starts this stage, NUM_GPU_TIMES ends the frame
+	int				numQueries;						// 0 when nothing is in flight
+	int				frameCount;
+} gpuTimeFrame_t;
+
+static gpuTimeFrame_t	gpuTimeFrames[GPU_TIME_FRAMES];
+static gpuTimeFrame_t *	gpuTimeFrame;				// being recorded, NULL when not timing
+static int				gpuTimeFrameCount;
+static gpuTime_t		gpuTimeStage;
+
+/*
+==================
+RB_ResetGpuTimes
+
+The query objects belong to the context, so a new one starts from scratch
+==================
+*/
+void RB_ResetGpuTimes( void ) {
+	memset( gpuTimeFrames, 0, sizeof( gpuTimeFrames ) );
+	memset( &gpuTimes, 0, sizeof( gpuTimes ) );
+	gpuTimeFrame = NULL;
+	gpuTimeStage = GPU_TIME_OTHER;
+}
+
+/*
+==================
+RB_GpuTimestamp
+==================
+*/
+static void RB_GpuTimestamp( int stage ) {
+	gpuTimeFrame_t *frame = gpuTimeFrame;
+	// keep the last query for the end of the frame
+	if ( frame->numQueries >= MAX_GPU_TIME_QUERIES - ( stage != NUM_GPU_TIMES ) ) {
+		return;
+	}
+	GLuint &query = frame->queries[frame->numQueries];
+	if ( !query ) {
+		qglGenQueriesARB( 1, &query );
+	}
+	qglQueryCounter( query, GL_TIMESTAMP );
+	frame->stages[frame->numQueries++] = stage;
+}
+
+/*
+==================
+RB_ReadGpuTimes
+
+Adds up the stages of a frame if its queries have come back, a frame
+that isn't done yet is dropped rather than waited for
+==================
+*/
+static void RB_ReadGpuTimes( gpuTimeFrame_t *frame ) {
+	if ( frame->numQueries < 2 ) {
+		frame->numQueries = 0;
+		return;
+	}
+
+	GLuint available = 0;
+	qglGetQueryObjectuivARB( frame->queries[frame->numQueries - 1], GL_QUERY_RESULT_AVAILABLE_ARB, &available );
+	if ( available ) {
+		gpuTimes_t times;
+		memset( &times, 0, sizeof( times ) );
+
+		GLuint64 last = 0;
+		qglGetQueryObjectui64v( frame->queries[0], GL_QUERY_RESULT_ARB, &last );
+		for ( int i = 1 ; i < frame->numQueries ; i++ ) {
+			GLuint64 time = 0;
+			qglGetQueryObjectui64v( frame->queries[i], GL_QUERY_RESULT_ARB, &time );
+			const float msec = ( time - last ) * 0.000001f;
+			times.msec[frame->stages[i - 1]] += msec;
+			times.totalMsec += msec;
+			last = time;
+		}
+		times.frameCount = frame->frameCount;
+		gpuTimes = times;
+	}
+	frame->numQueries = 0;
+}
+
+/*
+==================
+RB_BeginGpuTimes
+
+Called at the start of each command chain, the frame stays open until RB_EndGpuTimes at the swap
+==================
+*/
+void RB_BeginGpuTimes( void ) {
+	if ( gpuTimeFrame ) {
+		return;
+	}
+	if ( !glConfig.timerQueryAvailable || !( r_showGpuTimes.GetBool() || gpuTimesRequested ) ) {
+		return;
+	}
+	gpuTimeFrameCount++;
+	gpuTimeFrame = &gpuTimeFrames[gpuTimeFrameCount % GPU_TIME_FRAMES];
+
+	// the frame recorded GPU_TIME_FRAMES ago
+	RB_ReadGpuTimes( gpuTimeFrame );
+
+	gpuTimeFrame->frameCount = gpuTimeFrameCount;
+	gpuTimeStage = GPU_TIME_OTHER;
+	RB_GpuTimestamp( gpuTimeStage );
+}
+
+/*
+==================
+RB_EndGpuTimes
+==================
+*/
+void RB_EndGpuTimes( void ) {
+	if ( !gpuTimeFrame ) {
+		return;
+	}
+	RB_GpuTimestamp( NUM_GPU_TIMES );
+	gpuTimeFrame = NULL;
+	gpuTimeStage = GPU_TIME_OTHER;
+}
+
+/*
+==================
+RB_SetGpuTime
+==================
+*/
+gpuTime_t RB_SetGpuTime( gpuTime_t stage ) {
+	const gpuTime_t previous = gpuTimeStage;
+	if ( gpuTimeFrame && stage != previous ) {
+		RB_GpuTimestamp( stage );
+	}
+	gpuTimeStage = stage;
+	return previous;
+}
+
 /*
 ====================
 RB_ExecuteBackEndCommands
@@ -803,6 +958,8 @@ void RB_ExecuteBackEndCommands( const emptyCommand_t *cmds ) {
 	// needed for editor rendering
 	RB_SetDefaultGLState();
 
+	RB_BeginGpuTimes();
+
 	// upload any image loads that have completed
 	globalImages->CompleteBackgroundImageLoads();
 	bool v3d = false; // needs to be declared outside of switch case
@@ -838,6 +995,7 @@ void RB_ExecuteBackEndCommands( const emptyCommand_t *cmds ) {
 		case RC_SWAP_BUFFERS:
 			// duzenko #4425: display the fbo content 
 			RB_FboLeave(NULL);
+			RB_EndGpuTimes();
 			RB_SwapBuffers(cmds);
 			c_swapBuffers++;
 			break;
@@ -862,3 +1020,22 @@ void RB_ExecuteBackEndCommands( const emptyCommand_t *cmds ) {
 		backEnd.c_copyFrameBuffer = 0;
 	}
 }
+
+/*
+====================
+RB_RenderThread
+
+With r_useSMP the back end runs here, consuming the command
+chains handed over by R_IssueRenderCommands.  A NULL chain
+means the render thread is being shut down.
+====================
+*/
+void RB_RenderThread( void ) {
+	while ( 1 ) {
+		const emptyCommand_t *cmds = (const emptyCommand_t *)GLimp_BackEndSleep();
+		if ( !cmds ) {
+			break;
+		}
+		RB_ExecuteBackEndCommands( cmds );
+	}
+}
@@ -25,6 +25,26 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #include "tr_local.h"
 
 
+/*
+=================
+R_DeformTangents
+
+Generate current normals, tangents, and bitangents.
+We might want to support the possibility of deform functions generating
+explicit normals, and we might also want to allow the cached deformInfo
+optimization for these.
+FIXME: this doesn't work, because the deformed surface is just the
+ambient one, and there isn't an opportunity to generate light interactions
+=================
+*/
+static void R_DeformTangents( const drawSurf_t *drawSurf, srfTriangles_t *newTri, idDrawVert *ac ) {
+	if ( drawSurf->material->ReceivesLighting() ) {
+		newTri->verts = ac;
+		R_DeriveTangents( newTri, false );
+		newTri->verts = NULL;
+	}
+}
+
 /*
 =================
 R_FinishDeform
@@ -38,17 +58,7 @@ static void R_FinishDeform( drawSurf_t *drawSurf, srfTriangles_t *newTri, idDraw
 		return;
 	}
 
-	// generate current normals, tangents, and bitangents
-	// We might want to support the possibility of deform functions generating
-	// explicit normals, and we might also want to allow the cached deformInfo
-	// optimization for these.
-	// FIXME: this doesn't work, because the deformed surface is just the
-	// ambient one, and there isn't an opportunity to generate light interactions
-	if ( drawSurf->material->ReceivesLighting() ) {
-		newTri->verts = ac;
-		R_DeriveTangents( newTri, false );
-		newTri->verts = NULL;
-	}
+	R_DeformTangents( drawSurf, newTri, ac );
 
 	newTri->ambientCache = vertexCache.AllocFrameTemp( ac, newTri->numVerts * sizeof( idDrawVert ) );
 	// if we are out of vertex cache, leave it the way it is
@@ -57,6 +67,123 @@ static void R_FinishDeform( drawSurf_t *drawSurf, srfTriangles_t *newTri, idDraw
 	}
 }
 
+/*
+=================
+R_CachedDeform
+
+Expand, move and turbulent deforms don't depend on the view, only on the
+shader registers that drive them. The result is kept with the surface and
+reused by the other views of the frame (subviews, the light gem), and once
+the registers held for a second frame it is moved to the static vertex cache
+and reused until they change. Deforms of the same surface with different
+registers every frame only keep the frame temp result.
+=================
+*/
+#define	MAX_DEFORM_CACHE_PARMS	3
+
+typedef void (*deformVerts_t)( const drawSurf_t *surf, idDrawVert *ac );
+
+typedef struct deformCache_s {
+	const idMaterial *	material;
+	float				parms[MAX_DEFORM_CACHE_PARMS];
+	int					frameCount;		// frame the parms were first seen
+	vertCache_t *		frameCache;		// frame temp result of that frame
+	vertCache_t *		staticCache;	// set to NULL by the vertex cache when purged
+} deformCache_t;
+
+static void R_CachedDeform( drawSurf_t *surf, int numParms, deformVerts_t deformVerts ) {
+	const srfTriangles_t	*tri;
+	srfTriangles_t			*newTri;
+	float					parms[MAX_DEFORM_CACHE_PARMS];
+
+	tri = surf->geo;
+
+	// this srfTriangles_t is in frame memory, and will be automatically disposed of
+	newTri = (srfTriangles_t *)R_ClearedFrameAlloc( sizeof( *newTri ) );
+	newTri->numVerts = tri->numVerts;
+	newTri->numIndexes = tri->numIndexes;
+	newTri->indexes = tri->indexes;
+	newTri->indexCache = tri->indexCache;	// same indexes, so the static index buffer can be shared
+
+	// surfaces that are rebuilt every frame don't have a static ambient cache
+	if ( !r_useDeformCache.GetBool() || tri->ambientCache == NULL || tri->ambientCache->tag == TAG_TEMP ) {
+		idDrawVert *ac = (idDrawVert *)_alloca16( newTri->numVerts * sizeof( idDrawVert ) );
+		deformVerts( surf, ac );
+		R_FinishDeform( surf, newTri, ac );
+		return;
+	}
+
+	for ( int i = 0 ; i < numParms ; i++ ) {
+		parms[i] = surf->shaderRegisters[ surf->material->GetDeformRegister( i ) ];
+	}
+
+	// the surface data is shared, but only the front end touches it
+	deformCache_t *cache = tri->deformCache;
+	if ( cache == NULL ) {
+		cache = (deformCache_t *)Mem_ClearedAlloc( sizeof( *cache ) );
+		cache->frameCount = -1;
+		const_cast<srfTriangles_t *>( tri )->deformCache = cache;
+	}
+
+	const bool match = cache->material == surf->material && memcmp( cache->parms, parms, numParms * sizeof( parms[0] ) ) == 0;
+
+	if ( match ) {
+		if ( cache->staticCache ) {
+			vertexCache.Touch( cache->staticCache );
+			newTri->ambientCache = cache->staticCache;
+			surf->geo = newTri;
+			return;
+		}
+		if ( cache->frameCount == tr.frameCount && cache->frameCache ) {
+			newTri->ambientCache = cache->frameCache;
+			surf->geo = newTri;
+			return;
+		}
+	} else {
+		vertexCache.Free( cache->staticCache );
+		cache->staticCache = NULL;
+		cache->material = surf->material;
+		memcpy( cache->parms, parms, numParms * sizeof( parms[0] ) );
+	}
+
+	idDrawVert *ac = (idDrawVert *)_alloca16( newTri->numVerts * sizeof( idDrawVert ) );
+	deformVerts( surf, ac );
+	R_DeformTangents( surf, newTri, ac );
+
+	// the parms held since an earlier frame
+	if ( match ) {
+		vertexCache.Alloc( ac, newTri->numVerts * sizeof( idDrawVert ), &cache->staticCache );
+		if ( cache->staticCache ) {
+			vertexCache.Touch( cache->staticCache );
+			newTri->ambientCache = cache->staticCache;
+			surf->geo = newTri;
+			return;
+		}
+	}
+
+	cache->frameCache = vertexCache.AllocFrameTemp( ac, newTri->numVerts * sizeof( idDrawVert ) );
+	cache->frameCount = tr.frameCount;
+	// if we are out of vertex cache, leave it the way it is
+	if ( cache->frameCache ) {
+		newTri->ambientCache = cache->frameCache;
+		surf->geo = newTri;
+	}
+}
+
+/*
+=================
+R_FreeDeformCache
+=================
+*/
+void R_FreeDeformCache( srfTriangles_t *tri ) {
+	if ( tri->deformCache == NULL ) {
+		return;
+	}
+	vertexCache.Free( tri->deformCache->staticCache );
+	Mem_Free( tri->deformCache );
+	tri->deformCache = NULL;
+}
+
 /*
 =====================
 R_AutospriteDeform
@@ -691,29 +818,18 @@ R_ExpandDeform
 Expands the surface along it's normals by a shader amount
 =====================
 */
-static void R_ExpandDeform( drawSurf_t *surf ) {
-	int		i;
-	const srfTriangles_t	*tri;
-	srfTriangles_t	*newTri;
-
-	tri = surf->geo;
-
-	// this srfTriangles_t and all its indexes and caches are in frame
-	// memory, and will be automatically disposed of
-	newTri = (srfTriangles_t *)R_ClearedFrameAlloc( sizeof( *newTri ) );
-	newTri->numVerts = tri->numVerts;
-	newTri->numIndexes = tri->numIndexes;
-	newTri->indexes = tri->indexes;
-
-	idDrawVert *ac = (idDrawVert *)_alloca16( newTri->numVerts * sizeof( idDrawVert ) );
+static void R_ExpandDeformVerts( const drawSurf_t *surf, idDrawVert *ac ) {
+	const srfTriangles_t *tri = surf->geo;
 
 	float dist = surf->shaderRegisters[ surf->material->GetDeformRegister(0) ];
-	for ( i = 0 ; i < tri->numVerts ; i++ ) {
-		ac[i] = *(idDrawVert *)&tri->verts[i];
+	for ( int i = 0 ; i < tri->numVerts ; i++ ) {
+		ac[i] = tri->verts[i];
 		ac[i].xyz = tri->verts[i].xyz + tri->verts[i].normal * dist;
 	}
+}
 
-	R_FinishDeform( surf, newTri, ac );
+static void R_ExpandDeform( drawSurf_t *surf ) {
+	R_CachedDeform( surf, 1, R_ExpandDeformVerts );
 }
 
 /*
@@ -723,29 +839,18 @@ R_MoveDeform
 Moves the surface along the X axis, mostly just for demoing the deforms
 =====================
 */
-static void  R_MoveDeform( drawSurf_t *surf ) {
-	int		i;
-	const srfTriangles_t	*tri;
-	srfTriangles_t	*newTri;
-
-	tri = surf->geo;
-
-	// this srfTriangles_t and all its indexes and caches are in frame
-	// memory, and will be automatically disposed of
-	newTri = (srfTriangles_t *)R_ClearedFrameAlloc( sizeof( *newTri ) );
-	newTri->numVerts = tri->numVerts;
-	newTri->numIndexes = tri->numIndexes;
-	newTri->indexes = tri->indexes;
-
-	idDrawVert *ac = (idDrawVert *)_alloca16( newTri->numVerts * sizeof( idDrawVert ) );
+static void R_MoveDeformVerts( const drawSurf_t *surf, idDrawVert *ac ) {
+	const srfTriangles_t *tri = surf->geo;
 
 	float dist = surf->shaderRegisters[ surf->material->GetDeformRegister(0) ];
-	for ( i = 0 ; i < tri->numVerts ; i++ ) {
-		ac[i] = *(idDrawVert *)&tri->verts[i];
+	for ( int i = 0 ; i < tri->numVerts ; i++ ) {
+		ac[i] = tri->verts[i];
 		ac[i].xyz[0] += dist;
 	}
+}
 
-	R_FinishDeform( surf, newTri, ac );
+static void R_MoveDeform( drawSurf_t *surf ) {
+	R_CachedDeform( surf, 1, R_MoveDeformVerts );
 }
 
 //=====================================================================================
@@ -757,21 +862,8 @@ R_TurbulentDeform
 Turbulently deforms the XYZ, S, and T values
 =====================
 */
-static void  R_TurbulentDeform( drawSurf_t *surf ) {
-	int		i;
-	const srfTriangles_t	*tri;
-	srfTriangles_t	*newTri;
-
-	tri = surf->geo;
-
-	// this srfTriangles_t and all its indexes and caches are in frame
-	// memory, and will be automatically disposed of
-	newTri = (srfTriangles_t *)R_ClearedFrameAlloc( sizeof( *newTri ) );
-	newTri->numVerts = tri->numVerts;
-	newTri->numIndexes = tri->numIndexes;
-	newTri->indexes = tri->indexes;
-
-	idDrawVert *ac = (idDrawVert *)_alloca16( newTri->numVerts * sizeof( idDrawVert ) );
+static void R_TurbulentDeformVerts( const drawSurf_t *surf, idDrawVert *ac ) {
+	const srfTriangles_t *tri = surf->geo;
 
 	idDeclTable	*table = (idDeclTable *)surf->material->GetDeformDecl();
 	float range = surf->shaderRegisters[ surf->material->GetDeformRegister(0) ];
@@ -779,19 +871,21 @@ static void  R_TurbulentDeform( drawSurf_t *surf ) {
 	float domain = surf->shaderRegisters[ surf->material->GetDeformRegister(2) ];
 	float tOfs = 0.5;
 
-	for ( i = 0 ; i < tri->numVerts ; i++ ) {
+	for ( int i = 0 ; i < tri->numVerts ; i++ ) {
 		float	f = tri->verts[i].xyz[0] * 0.003 + tri->verts[i].xyz[1] * 0.007 + tri->verts[i].xyz[2] * 0.011;
 
 		f = timeOfs + domain * f;
 		f += timeOfs;
 
-		ac[i] = *(idDrawVert *)&tri->verts[i];
+		ac[i] = tri->verts[i];
 
 		ac[i].st[0] += range * table->TableLookup( f );
 		ac[i].st[1] += range * table->TableLookup( f + tOfs );
 	}
+}
 
-	R_FinishDeform( surf, newTri, ac );
+static void R_TurbulentDeform( drawSurf_t *surf ) {
+	R_CachedDeform( surf, 3, R_TurbulentDeformVerts );
 }
 
 //=====================================================================================
@@ -439,6 +439,30 @@ static bool R_PointInFrustum( idVec3 &p, idPlane *planes, int numPlanes ) {
 	return true;
 }
 
+/*
+=============
+R_LightUsesShadowMap
+
+Parallel lights keep the shadow volumes, their projection doesn't fit a map
+=============
+*/
+bool R_LightUsesShadowMap( const idRenderLightLocal *light ) {
+	if ( tr.backEndRenderer != BE_ARB2 || !glConfig.framebufferObjectAvailable ) {
+		return false;
+	}
+	if ( light->parms.parallel ) {
+		return false;
+	}
+	switch ( r_useShadowMaps.GetInteger() ) {
+		case 1:
+			return light->parms.shadowMap;
+		case 2:
+			return true;
+		default:
+			return false;
+	}
+}
+
 /*
 =============
 R_SetLightDefViewLight
@@ -508,6 +532,8 @@ viewLight_t *R_SetLightDefViewLight( idRenderLightLocal *light ) {
 	vLight->lightShader = light->lightShader;
 	vLight->shaderRegisters = NULL;		// allocated and evaluated in R_AddLightSurfaces
 	vLight->noFogBoundary = light->parms.noFogBoundary; // #3664
+	vLight->shadowMap = R_LightUsesShadowMap( light );
+	vLight->shadowMapRange = light->parms.lightRadius.Length() + light->parms.lightCenter.Length();
 
 	// link the view light
 	vLight->next = tr.viewDef->viewLights;
@@ -591,11 +617,10 @@ void idRenderWorldLocal::CreateLightDefInteractions( idRenderLightLocal *ldef )
 			// if any of the edef's interaction match this light, we don't
 			// need to consider it. 
 			idInteraction *inter;
-			if ( r_useInteractionTable.GetBool() && this->interactionTable ) {
-				// allocating these tables may take several megs on big maps, but it saves 3% to 5% of
-				// the CPU time.  The table is updated at interaction::AllocAndLink() and interaction::UnlinkAndFree()
-				//int index = ldef->index * this->interactionTableWidth + edef->index;
-				inter = this->interactionTable[ (ldef->index * this->interactionTableWidth + edef->index) ];
+			if ( r_useInteractionTable.GetBool() ) {
+				// the table saves 3% to 5% of the CPU time.  It is updated at
+				// interaction::AllocAndLink() and interaction::UnlinkAndFree()
+				inter = this->interactionTable.Find( ldef->index, edef->index );
 				if ( inter ) {
 					// if this entity wasn't in view already, the scissor rect will be empty,
 					// so it will only be used for shadow casting
@@ -653,6 +678,78 @@ void idRenderWorldLocal::CreateLightDefInteractions( idRenderLightLocal *ldef )
 
 //===============================================================================================================
 
+/*
+=================
+R_EvaluateShaderRegisters
+
+Evaluates the registers of a material for a surface of the current view.
+Flickering and animated materials read little more than the time and a few
+entity parms, so the surfaces of a view that share the material, the time
+and the values of the parms it reads share one evaluation. Registers that
+read a sound amplitude are evaluated for every surface.
+=================
+*/
+typedef struct {
+	const idMaterial *	shader;
+	float				time;
+	float				parms[MAX_ENTITY_SHADER_PARMS];	// the ones the material doesn't read are 0
+	const float *		registers;
+} cachedRegisters_t;
+
+static idList<cachedRegisters_t>	cachedRegisters;
+static idHashIndex					cachedRegistersHash;
+static const viewDef_t *			cachedRegistersView;
+static int							cachedRegistersFrame = -1;
+
+static const float *R_EvaluateShaderRegisters( const idMaterial *shader, const float shaderParms[MAX_ENTITY_SHADER_PARMS], idSoundEmitter *soundEmitter ) {
+	const int dependencies = shader->GetRegisterDependencies();
+
+	if ( !r_useMaterialRegisterCache.GetBool() || ( dependencies & REGDEP_SOUND ) ) {
+		float *regs = (float *)R_FrameAlloc( shader->GetNumRegisters() * sizeof( float ) );
+		shader->EvaluateRegisters( regs, shaderParms, tr.viewDef, soundEmitter );
+		return regs;
+	}
+
+	// the global parms and the time belong to the view, the frame memory of the registers to the frame
+	if ( cachedRegistersView != tr.viewDef || cachedRegistersFrame != tr.frameCount ) {
+		cachedRegisters.SetNum( 0, false );
+		cachedRegistersHash.Clear();
+		cachedRegistersView = tr.viewDef;
+		cachedRegistersFrame = tr.frameCount;
+	}
+
+	// time groups give the surfaces of some entities their own time
+	const float time = ( dependencies & REGDEP_TIME ) ? tr.viewDef->floatTime : 0.0f;
+	const int parmMask = shader->GetRegisterParmMask();
+
+	float parms[MAX_ENTITY_SHADER_PARMS];
+	int hash = (int)( (intptr_t)shader >> 4 ) ^ *(const int *)&time;
+	for ( int i = 0; i < MAX_ENTITY_SHADER_PARMS; i++ ) {
+		parms[i] = ( parmMask & BIT( i ) ) ? shaderParms[i] : 0.0f;
+		hash = hash * 31 + *(const int *)&parms[i];
+	}
+	const int key = cachedRegistersHash.GenerateKey( hash, hash >> 16 );
+
+	for ( int i = cachedRegistersHash.First( key ); i != -1; i = cachedRegistersHash.Next( i ) ) {
+		const cachedRegisters_t &cached = cachedRegisters[i];
+		if ( cached.shader == shader && cached.time == time && !memcmp( cached.parms, parms, sizeof( parms ) ) ) {
+			return cached.registers;
+		}
+	}
+
+	float *regs = (float *)R_FrameAlloc( shader->GetNumRegisters() * sizeof( float ) );
+	shader->EvaluateRegisters( regs, shaderParms, tr.viewDef, soundEmitter );
+
+	cachedRegisters_t &cached = cachedRegisters.Alloc();
+	cached.shader = shader;
+	cached.time = time;
+	memcpy( cached.parms, parms, sizeof( parms ) );
+	cached.registers = regs;
+	cachedRegistersHash.Add( key, cachedRegisters.Num() - 1 );
+
+	return regs;
+}
+
 /*
 =================
 R_LinkLightSurf
@@ -689,10 +786,7 @@ void R_LinkLightSurf( const drawSurf_t **link, const srfTriangles_t *tri, const
 			// this shader has only constants for parameters
 			drawSurf->shaderRegisters = constRegs;
 		} else {
-			// FIXME: share with the ambient surface?
-			float *regs = (float *)R_FrameAlloc( shader->GetNumRegisters() * sizeof( float ) );
-			drawSurf->shaderRegisters = regs;
-			shader->EvaluateRegisters( regs, space->entityDef->parms.shaderParms, tr.viewDef, space->entityDef->parms.referenceSound );
+			drawSurf->shaderRegisters = R_EvaluateShaderRegisters( shader, space->entityDef->parms.shaderParms, space->entityDef->parms.referenceSound );
 		}
 
 		// calculate the specular coordinates if we aren't using vertex programs
@@ -856,6 +950,46 @@ idScreenRect R_CalcLightScissorRectangle( viewLight_t *vLight ) {
 	return r;
 }
 
+/*
+=================
+R_CullLightByOcclusion
+
+Queues an occlusion query of the light volume for the back end, and returns
+true if the latest result that came back found the volume completely hidden.
+A culled light is still queried, so it comes back once it turns visible.
+=================
+*/
+static bool R_CullLightByOcclusion( const viewLight_t *vLight ) {
+	const idRenderLightLocal *light = vLight->lightDef;
+
+	if ( !r_useOcclusionQueries.GetBool() || !glConfig.occlusionQueryAvailable ) {
+		return false;
+	}
+
+	// the results are kept per lightDef, so only the main view can use them
+	if ( tr.viewDef->isSubview || tr.viewDef->renderView.viewID < TR_SCREEN_VIEW_ID
+		|| tr.viewDef->renderWorld != tr.primaryWorld || light->index >= MAX_OCCLUSION_LIGHTS ) {
+		return false;
+	}
+
+	// a volume reaching the near plane gets clipped, and could pass no samples
+	// even though the view is inside it
+	idBounds nearBounds = light->globalLightBounds.Expand( r_znear.GetFloat() * 4.0f );
+	if ( nearBounds.ContainsPoint( tr.viewDef->renderView.vieworg ) ) {
+		return false;
+	}
+
+	occlusionTest_t *test = (occlusionTest_t *)R_FrameAlloc( sizeof( *test ) );
+	test->lightNum = light->index;
+	test->frameCount = tr.frameCount;
+	test->bounds = light->globalLightBounds;
+	test->next = tr.viewDef->occlusionTests;
+	tr.viewDef->occlusionTests = test;
+
+	const occlusionResult_t &result = occlusionResults[light->index];
+	return result.occluded && result.frameCount >= tr.frameCount - OCCLUSION_RESULT_FRAMES;
+}
+
 /*
 =================
 R_AddLightSurfaces
@@ -957,6 +1091,13 @@ void R_AddLightSurfaces( void ) {
 			}
 		}
 
+		// skip the interactions and shadows of lights that are completely hidden
+		if ( R_CullLightByOcclusion( vLight ) ) {
+			*ptr = vLight->next;
+			light->viewCount = -1;
+			continue;
+		}
+
 		if ( r_useLightScissors.GetBool() ) {
 			// calculate the screen area covered by the light frustum
 			// which will be used to crop the stencil cull
@@ -997,7 +1138,8 @@ void R_AddLightSurfaces( void ) {
 		}
 
 		// add the prelight shadows for the static world geometry
-		if ( light->parms.prelightModel && r_useOptimizedShadows.GetBool() ) {
+		// shadow mapped lights draw the world surfaces into the map instead
+		if ( light->parms.prelightModel && r_useOptimizedShadows.GetBool() && !vLight->shadowMap ) {
 			srfTriangles_t	*tri = light->parms.prelightModel->Surface( 0 )->geometry;
 
 			// these shadows will all have valid bounds, and can be culled normally
@@ -1079,6 +1221,54 @@ bool R_IssueEntityDefCallback( idRenderEntityLocal *def ) {
 	return update;
 }
 
+/*
+===================
+R_EntityDefJointsCrc
+===================
+*/
+static unsigned int R_EntityDefJointsCrc( const idRenderEntityLocal *def ) {
+	if ( !def->parms.joints || def->parms.numJoints <= 0 ) {
+		return 0;
+	}
+	return CRC32_BlockChecksum( def->parms.joints, def->parms.numJoints * sizeof( def->parms.joints[0] ) );
+}
+
+/*
+===================
+R_SetEntityDefDynamicModel
+
+Makes the freshly instantiated cached snapshot the dynamic model of the entity
+===================
+*/
+static void R_SetEntityDefDynamicModel( idRenderEntityLocal *def ) {
+	if ( def->cachedDynamicModel ) {
+
+		// add any overlays to the snapshot of the dynamic model
+		if ( def->overlay && !r_skipOverlays.GetBool() ) {
+			def->overlay->AddOverlaySurfacesToModel( def->cachedDynamicModel );
+		} else {
+			idRenderModelOverlay::RemoveOverlaySurfacesFromModel( def->cachedDynamicModel );
+		}
+
+		if ( r_checkBounds.GetBool() ) {
+			idBounds b = def->cachedDynamicModel->Bounds();
+			if (	b[0][0] < def->referenceBounds[0][0] - CHECK_BOUNDS_EPSILON ||
+					b[0][1] < def->referenceBounds[0][1] - CHECK_BOUNDS_EPSILON ||
+					b[0][2] < def->referenceBounds[0][2] - CHECK_BOUNDS_EPSILON ||
+					b[1][0] > def->referenceBounds[1][0] + CHECK_BOUNDS_EPSILON ||
+					b[1][1] > def->referenceBounds[1][1] + CHECK_BOUNDS_EPSILON ||
+					b[1][2] > def->referenceBounds[1][2] + CHECK_BOUNDS_EPSILON ) {
+				common->Printf( "entity %i dynamic model exceeded reference bounds\n", def->index );
+			}
+		}
+	}
+
+	def->dynamicModel = def->cachedDynamicModel;
+	def->dynamicModelFrameCount = tr.frameCount;
+	def->dynamicModelJointsCrc = R_EntityDefJointsCrc( def );
+	def->checkDynamicModelJoints = false;
+}
+
 /*
 ===================
 R_EntityDefDynamicModel
@@ -1096,6 +1286,14 @@ idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def ) {
 	// allow deferred entities to construct themselves
 	if ( def->parms.callback ) {
 		callbackUpdate = R_IssueEntityDefCallback( def );
+
+		// a new frame of joints that didn't move, like a paused animation or an idle
+		// actor standing still, leaves the snapshot and the interactions of the
+		// stationary lights with their shadow volumes as they are
+		if ( ( ( callbackUpdate && r_useJointsCrc.GetBool() ) || def->checkDynamicModelJoints ) && def->dynamicModel && def->parms.joints ) {
+			callbackUpdate = ( R_EntityDefJointsCrc( def ) != def->dynamicModelJointsCrc );
+		}
+		def->checkDynamicModelJoints = false;
 	}
 
 	idRenderModel *model = def->parms.hModel;
@@ -1122,30 +1320,7 @@ idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def ) {
 		// instantiate the snapshot of the dynamic model, possibly reusing memory from the cached snapshot
 		def->cachedDynamicModel = model->InstantiateDynamicModel( &def->parms, tr.viewDef, def->cachedDynamicModel );
 
-		if ( def->cachedDynamicModel ) {
-
-			// add any overlays to the snapshot of the dynamic model
-			if ( def->overlay && !r_skipOverlays.GetBool() ) {
-				def->overlay->AddOverlaySurfacesToModel( def->cachedDynamicModel );
-			} else {
-				idRenderModelOverlay::RemoveOverlaySurfacesFromModel( def->cachedDynamicModel );
-			}
-
-			if ( r_checkBounds.GetBool() ) {
-				idBounds b = def->cachedDynamicModel->Bounds();
-				if (	b[0][0] < def->referenceBounds[0][0] - CHECK_BOUNDS_EPSILON ||
-						b[0][1] < def->referenceBounds[0][1] - CHECK_BOUNDS_EPSILON ||
-						b[0][2] < def->referenceBounds[0][2] - CHECK_BOUNDS_EPSILON ||
-						b[1][0] > def->referenceBounds[1][0] + CHECK_BOUNDS_EPSILON ||
-						b[1][1] > def->referenceBounds[1][1] + CHECK_BOUNDS_EPSILON ||
-						b[1][2] > def->referenceBounds[1][2] + CHECK_BOUNDS_EPSILON ) {
-					common->Printf( "entity %i dynamic model exceeded reference bounds\n", def->index );
-				}
-			}
-		}
-
-		def->dynamicModel = def->cachedDynamicModel;
-		def->dynamicModelFrameCount = tr.frameCount;
+		R_SetEntityDefDynamicModel( def );
 	}
 
 	// set model depth hack value
@@ -1163,6 +1338,93 @@ idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def ) {
 	return def->dynamicModel;
 }
 
+/*
+=================
+R_SetStreamedImageSizes
+
+Estimates the screen pixels the surface covers from its bounds, for the streamed
+images of the material to know how many of their mip levels are needed
+=================
+*/
+static void R_SetStreamedImageSizes( const srfTriangles_t *tri, const viewEntity_t *space, const idMaterial *shader ) {
+	// the invisible views like the lightgem don't need any detail
+	if ( tr.viewDef->renderView.viewID < TR_SCREEN_VIEW_ID ) {
+		return;
+	}
+
+	idVec3 center;
+	R_LocalPointToGlobal( space->modelMatrix, tri->bounds.GetCenter(), center );
+
+	const float radius = ( tri->bounds[1] - tri->bounds[0] ).Length() * 0.5f;
+	const float distance = ( center - tr.viewDef->renderView.vieworg ).Length();
+
+	int size;
+	if ( distance <= radius ) {
+		size = glConfig.maxTextureSize;
+	} else {
+		const float viewWidth = tr.viewDef->viewport.x2 - tr.viewDef->viewport.x1 + 1;
+		const float tanHalfFov = idMath::Tan( DEG2RAD( tr.viewDef->renderView.fov_x * 0.5f ) );
+		size = idMath::FtoiFast( Min( radius * viewWidth / ( distance * tanHalfFov ), (float)glConfig.maxTextureSize ) );
+	}
+
+	for ( int i = 0; i < shader->GetNumStages(); i++ ) {
+		const shaderStage_t *stage = shader->GetStage( i );
+		idImage *images[MAX_FRAGMENT_IMAGES + 1];
+		int numImages = 0;
+
+		images[numImages++] = stage->texture.image;
+		if ( stage->newStage ) {
+			for ( int j = 0; j < stage->newStage->numFragmentProgramImages; j++ ) {
+				images[numImages++] = stage->newStage->fragmentProgramImages[j];
+			}
+		}
+
+		for ( int j = 0; j < numImages; j++ ) {
+			idImage *image = images[j];
+			if ( !image || !image->streamed ) {
+				continue;
+			}
+			if ( image->streamFrame != tr.frameCount ) {
+				image->streamFrame = tr.frameCount;
+				image->streamWantedSize = size;
+			} else if ( size > image->streamWantedSize ) {
+				image->streamWantedSize = size;
+			}
+		}
+	}
+}
+
+/*
+=================
+R_DrawSurfSortKey
+
+The material sort decides the order first.  Opaque surfaces can be drawn
+in any order inside it, so they are grouped by material, vertex buffer and
+geometry to cut down the state changes between consecutive draws.  Copies
+of a static model share their geometry, so they end up next to each other
+and the depth fill draws them with only a matrix change in between.
+Everything else keeps the order it was added in.
+=================
+*/
+static uint64_t R_DrawSurfSortKey( const srfTriangles_t *tri, const viewEntity_t *space, const idMaterial *shader, int addIndex ) {
+	// flip the float bits so they compare as unsigned ints in the same order
+	const float sort = shader->GetSort();
+	const unsigned int sortBits = *reinterpret_cast<const unsigned int *>( &sort );
+	const unsigned int high = ( sortBits & 0x80000000 ) ? ~sortBits : ( sortBits | 0x80000000 );
+
+	unsigned int low;
+	if ( sort == SS_OPAQUE && shader->Coverage() != MC_TRANSLUCENT ) {
+		// collisions in the truncated fields only cost some batching
+		const int vbo = tri->ambientCache ? tri->ambientCache->vbo : 0;
+		const unsigned int geometry = (unsigned int)( (uintptr_t)tri >> 4 ) * 2654435761u;
+		low = ( ( shader->Index() & 0x3fff ) << 17 ) | ( ( vbo & 0x1f ) << 12 ) | ( geometry >> 20 );
+	} else {
+		low = 0x80000000 | addIndex;
+	}
+
+	return ( (uint64_t)high << 32 ) | low;
+}
+
 /*
 =================
 R_AddDrawSurf
@@ -1182,6 +1444,7 @@ void R_AddDrawSurf( const srfTriangles_t *tri, const viewEntity_t *space, const
 	drawSurf->material = shader;
 	drawSurf->scissorRect = scissor;
 	drawSurf->sort = shader->GetSort() + tr.sortOffset;
+	drawSurf->sortKey = R_DrawSurfSortKey( tri, space, shader, tr.viewDef->numDrawSurfs );
 	
 	if ( soft_particle_radius != -1.0f )	// #3878
 	{
@@ -1194,6 +1457,11 @@ void R_AddDrawSurf( const srfTriangles_t *tri, const viewEntity_t *space, const
 		drawSurf->particle_radius = 0.0f;
 	}
 
+	// the back end only captures the depth buffer for views that read it
+	if ( drawSurf->particle_radius > 0.0f || shader->UsesCurrentDepth() ) {
+		tr.viewDef->needsCurrentDepth = true;
+	}
+
 	// bumping this offset each time causes surfaces with equal sort orders to still
 	// deterministically draw in the order they are added
 	tr.sortOffset += 0.000001f;
@@ -1216,15 +1484,16 @@ void R_AddDrawSurf( const srfTriangles_t *tri, const viewEntity_t *space, const
 	tr.viewDef->drawSurfs[tr.viewDef->numDrawSurfs] = drawSurf;
 	tr.viewDef->numDrawSurfs++;
 
+	if ( globalImages->image_streaming.GetBool() ) {
+		R_SetStreamedImageSizes( tri, space, shader );
+	}
+
 	// process the shader expressions for conditionals / color / texcoords
 	const float	*constRegs = shader->ConstantRegisters();
 	if ( constRegs ) {
 		// shader only uses constant values
 		drawSurf->shaderRegisters = constRegs;
 	} else {
-		float *regs = (float *)R_FrameAlloc( shader->GetNumRegisters() * sizeof( float ) );
-		drawSurf->shaderRegisters = regs;
-
 		// a reference shader will take the calculated stage color value from another shader
 		// and use that for the parm0-parm3 of the current shader, which allows a stage of
 		// a light model and light flares to pick up different flashing tables from
@@ -1254,12 +1523,12 @@ void R_AddDrawSurf( const srfTriangles_t *tri, const viewEntity_t *space, const
 			tr.viewDef->floatTime = game->GetTimeGroupTime( space->entityDef->parms.timeGroup ) * 0.001f;
 			tr.viewDef->renderView.time = game->GetTimeGroupTime( space->entityDef->parms.timeGroup );
 
-			shader->EvaluateRegisters( regs, shaderParms, tr.viewDef, renderEntity->referenceSound );
+			drawSurf->shaderRegisters = R_EvaluateShaderRegisters( shader, shaderParms, renderEntity->referenceSound );
 
 			tr.viewDef->floatTime = oldFloatTime;
 			tr.viewDef->renderView.time = oldTime;
 		} else {
-			shader->EvaluateRegisters( regs, shaderParms, tr.viewDef, renderEntity->referenceSound );
+			drawSurf->shaderRegisters = R_EvaluateShaderRegisters( shader, shaderParms, renderEntity->referenceSound );
 		}
 	}
 
@@ -1462,6 +1731,227 @@ idScreenRect R_CalcEntityScissorRectangle( viewEntity_t *vEntity ) {
 	return R_ScreenRectFromViewFrustumBounds( bounds );
 }
 
+/*
+===================
+R_AddActiveInteraction
+
+With r_useParallelInteractions R_AddModelSurfaces only does the serial part of
+AddActiveInteraction() while it walks the entities. The surfaces of all the
+collected interactions are then created on several threads, and linked in the
+order they were collected, so the vLight lists come out as in the serial path.
+===================
+*/
+typedef struct {
+	idInteraction *		inter;
+	idRenderModel *		model;
+	idScreenRect		shadowScissor;
+	float				floatTime;		// time group of the entity, for R_LinkLightSurf
+	int					time;
+	bool				mainThread;		// surfaces can't be created on the worker threads
+	bool				empty;
+} activeInteraction_t;
+
+static idList<activeInteraction_t>	activeInteractions;
+static bool							deferActiveInteractions;
+
+static void R_AddActiveInteraction( idInteraction *inter ) {
+	if ( !deferActiveInteractions ) {
+		inter->AddActiveInteraction();
+		return;
+	}
+
+	activeInteraction_t	active;
+
+	active.model = inter->PrepareActiveInteraction( active.shadowScissor );
+	if ( active.model == NULL ) {
+		return;
+	}
+	active.inter = inter;
+	active.floatTime = tr.viewDef->floatTime;
+	active.time = tr.viewDef->renderView.time;
+	active.mainThread = !inter->PrepareParallelSurfaces( active.model );
+	active.empty = false;
+
+	activeInteractions.Append( active );
+}
+
+/*
+===================
+R_LinkActiveInteractions
+
+Creates and links the interactions collected by R_AddActiveInteraction
+===================
+*/
+static void R_LinkActiveInteractions( void ) {
+	const int numActive = activeInteractions.Num();
+	if ( numActive == 0 ) {
+		return;
+	}
+	activeInteraction_t *active = activeInteractions.Ptr();
+
+	tr.lockStaticAlloc = true;
+
+#pragma omp parallel for schedule( dynamic )
+	for ( int i = 0; i < numActive; i++ ) {
+		if ( !active[i].mainThread ) {
+			active[i].empty = !active[i].inter->CreateActiveSurfaces( active[i].model );
+		}
+	}
+
+	tr.lockStaticAlloc = false;
+
+	const float oldFloatTime = tr.viewDef->floatTime;
+	const int oldTime = tr.viewDef->renderView.time;
+
+	for ( int i = 0; i < numActive; i++ ) {
+		if ( active[i].mainThread ) {
+			active[i].empty = !active[i].inter->CreateActiveSurfaces( active[i].model );
+		}
+		if ( active[i].empty ) {
+			active[i].inter->MakeEmpty();
+			continue;
+		}
+		tr.viewDef->floatTime = active[i].floatTime;
+		tr.viewDef->renderView.time = active[i].time;
+		active[i].inter->LinkActiveInteraction( active[i].shadowScissor );
+	}
+
+	tr.viewDef->floatTime = oldFloatTime;
+	tr.viewDef->renderView.time = oldTime;
+
+	activeInteractions.SetNum( 0, false );
+}
+
+/*
+===================
+R_InstantiateViewDynamicModels
+
+With r_useParallelSkinning the md5 models, and with r_useParallelParticles the
+particle systems of the view entities that need a new snapshot are instantiated
+before R_AddModelSurfaces walks the entities. The snapshots and their surfaces
+are allocated on the main thread, then the md5 vertexes are transformed, bounded
+and given tangents and the particle quads are built on several threads. Entities
+with a callback are left to R_EntityDefDynamicModel, as the callback runs game code.
+===================
+*/
+typedef struct {
+	idRenderEntityLocal *	def;
+	idRenderModelMD5 *		md5;
+	idRenderModelPrt *		prt;
+	idRenderModelStatic *	snapshot;
+} viewDynamicModel_t;
+
+static idList<viewDynamicModel_t>	viewDynamicModels;
+
+static void R_InstantiateViewDynamicModels( void ) {
+	viewEntity_t *vEntity;
+
+	const bool skinning = r_useParallelSkinning.GetBool() && !r_showSkel.GetInteger();
+	const bool particles = r_useParallelParticles.GetBool();
+
+	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+		idRenderEntityLocal *def = vEntity->entityDef;
+
+		if ( def->parms.callback ) {
+			continue;
+		}
+		// particle systems get a new snapshot every frame, see R_EntityDefDynamicModel
+		if ( def->dynamicModel && ( def->parms.hModel->IsDynamicModel() != DM_CONTINUOUS || def->dynamicModelFrameCount == tr.frameCount ) ) {
+			continue;
+		}
+		if ( tr.viewDef->isXraySubview ? def->parms.xrayIndex == 1 : def->parms.xrayIndex == 2 ) {
+			continue;
+		}
+		// the same entities R_AddModelSurfaces will ask for their dynamic model
+		if ( vEntity->scissorRect.IsEmpty() && ( def->firstInteraction == NULL || def->firstInteraction->IsEmpty() ) ) {
+			continue;
+		}
+		idRenderModelMD5 *md5 = skinning ? dynamic_cast<idRenderModelMD5 *>( def->parms.hModel ) : NULL;
+		idRenderModelPrt *prt = particles ? dynamic_cast<idRenderModelPrt *>( def->parms.hModel ) : NULL;
+		if ( md5 == NULL && prt == NULL ) {
+			continue;
+		}
+
+		viewDynamicModel_t &instance = viewDynamicModels.Alloc();
+		instance.def = def;
+		instance.md5 = md5;
+		instance.prt = prt;
+		if ( md5 != NULL ) {
+			instance.snapshot = md5->PrepareDynamicModel( &def->parms, tr.viewDef, def->cachedDynamicModel );
+		} else {
+			R_ClearEntityDefDynamicModel( def );
+			instance.snapshot = prt->PrepareDynamicModel( &def->parms, tr.viewDef, def->cachedDynamicModel );
+		}
+		def->cachedDynamicModel = instance.snapshot;
+	}
+
+	const int numInstances = viewDynamicModels.Num();
+	viewDynamicModel_t *instances = viewDynamicModels.Ptr();
+
+	tr.lockStaticAlloc = true;
+
+#pragma omp parallel for schedule( dynamic )
+	for ( int i = 0; i < numInstances; i++ ) {
+		if ( instances[i].snapshot == NULL ) {
+			continue;
+		}
+		if ( instances[i].md5 != NULL ) {
+			instances[i].md5->DeformDynamicModel( &instances[i].def->parms, instances[i].snapshot );
+		} else {
+			instances[i].prt->GenerateDynamicModel( &instances[i].def->parms, tr.viewDef, instances[i].snapshot );
+		}
+	}
+
+	tr.lockStaticAlloc = false;
+
+	for ( int i = 0; i < numInstances; i++ ) {
+		R_SetEntityDefDynamicModel( instances[i].def );
+	}
+
+	viewDynamicModels.SetNum( 0, false );
+}
+
+/*
+===================
+R_CreateViewPendingDecals
+
+Clips the decal projections the game queued on the view entities since they
+were last in a view, on several threads with r_useParallelDecals. Each entity
+only touches its own decal chain.
+===================
+*/
+static idList<idRenderEntityLocal *>	pendingDecalEntities;
+
+static void R_CreateViewPendingDecals( void ) {
+	viewEntity_t *vEntity;
+
+	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+		if ( vEntity->entityDef->pendingDecals.Num() != 0 ) {
+			pendingDecalEntities.Append( vEntity->entityDef );
+		}
+	}
+
+	const int numEntities = pendingDecalEntities.Num();
+	if ( numEntities == 0 ) {
+		return;
+	}
+	idRenderEntityLocal **entities = pendingDecalEntities.Ptr();
+	const int time = tr.viewDef->renderView.time;
+
+#ifdef _OPENMP
+	const bool parallel = r_useParallelDecals.GetBool() && numEntities > 1;
+#else
+	const bool parallel = false;
+#endif
+
+#pragma omp parallel for if ( parallel ) schedule( dynamic )
+	for ( int i = 0; i < numEntities; i++ ) {
+		R_CreateEntityDefPendingDecals( entities[i], time );
+	}
+
+	pendingDecalEntities.SetNum( 0, false );
+}
+
 /*
 ===================
 R_AddModelSurfaces
@@ -1481,8 +1971,24 @@ void R_AddModelSurfaces( void ) {
 	// clear the ambient surface list
 	tr.viewDef->numDrawSurfs = 0;
 	tr.viewDef->maxDrawSurfs = 0;	// will be set to INITIAL_DRAWSURFS on R_AddDrawSurf
+	tr.viewDef->needsCurrentDepth = false;
 	g_enablePortalSky = cvarSystem->GetCVarInteger("g_enablePortalSky"); // duzenko #4414: cache the game cvar
 
+	// without OpenMP there is nothing to gain from collecting the interactions first
+#ifdef _OPENMP
+	deferActiveInteractions = r_useParallelInteractions.GetBool();
+#else
+	deferActiveInteractions = false;
+#endif
+
+#ifdef _OPENMP
+	if ( r_useParallelSkinning.GetBool() || r_useParallelParticles.GetBool() ) {
+		R_InstantiateViewDynamicModels();
+	}
+#endif
+
+	R_CreateViewPendingDecals();
+
 	// go through each entity that is either visible to the view, or to
 	// any light that intersects the view (for shadows)
 	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
@@ -1560,7 +2066,7 @@ void R_AddModelSurfaces( void ) {
 					if ( inter->lightDef->viewCount != tr.viewCount ) {
 						continue;
 					}
-					inter->AddActiveInteraction();
+					R_AddActiveInteraction( inter );
 				}
 			}
 		} else {
@@ -1575,7 +2081,7 @@ void R_AddModelSurfaces( void ) {
 				if ( inter->lightDef->viewCount != tr.viewCount ) {
 					continue;
 				}
-				inter->AddActiveInteraction();
+				R_AddActiveInteraction( inter );
 			}
 		}
 
@@ -1585,6 +2091,8 @@ void R_AddModelSurfaces( void ) {
 		}
 
 	}
+
+	R_LinkActiveInteractions();
 }
 
 /*
@@ -1605,6 +2113,7 @@ void R_RemoveUnecessaryViewLights( void ) {
 		if ( !vLight->localInteractions && !vLight->globalInteractions && !vLight->translucentInteractions ) {
 			vLight->localShadows = NULL;
 			vLight->globalShadows = NULL;
+			vLight->shadowMapCasters = NULL;
 		}
 	}
 
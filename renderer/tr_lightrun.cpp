@@ -170,11 +170,21 @@ R_CreateEntityRefs
 
 Creates all needed model references in portal areas,
 chaining them to both the area and the entityDef.
+References left from the last update are reused for
+the areas the entity still touches.
 
 Bumps tr.viewCount.
 ===============
 */
+static void R_PushEntityRefs( idRenderEntityLocal *def );
+
 void R_CreateEntityRefs( idRenderEntityLocal *def ) {
+	def->world->BeginAreaRefUpdate( &def->entityRefs );
+	R_PushEntityRefs( def );
+	def->world->EndAreaRefUpdate();
+}
+
+static void R_PushEntityRefs( idRenderEntityLocal *def ) {
 	idVec3		transformed[8], v;
 
 	if ( !def->parms.hModel ) {
@@ -219,6 +229,9 @@ void R_CreateEntityRefs( idRenderEntityLocal *def ) {
 			R_LocalPointToGlobal(def->modelMatrix, v, transformed[i]);
 		}
 
+		// for the batched portal culling
+		def->globalReferenceBounds.FromPoints(transformed, 8);
+
 		// bump the view count so we can tell if an area already has a reference
 		tr.viewCount++;
 
@@ -692,7 +705,16 @@ R_CreateLightRefs
 =================
 */
 #define	MAX_LIGHT_VERTS	40
+static void R_PushLightRefs( idRenderLightLocal *light );
+
 void R_CreateLightRefs( idRenderLightLocal *light ) {
+	// references left from the last update are reused for the areas the light still touches
+	light->world->BeginAreaRefUpdate( &light->references );
+	R_PushLightRefs( light );
+	light->world->EndAreaRefUpdate();
+}
+
+static void R_PushLightRefs( idRenderLightLocal *light ) {
 	if (r_useAnonreclaimer.GetBool()) {
 		// determine the areaNum for the light origin, which may let us
 		// cull the light if it is behind a closed door
@@ -875,11 +897,10 @@ void R_CreateLightDefFogPortals( idRenderLightLocal *ldef ) {
 R_FreeLightDefDerivedData
 
 Frees all references and lit surfaces from the light
+keepAreaRefs leaves the area references for R_CreateLightRefs
 ====================
 */
-void R_FreeLightDefDerivedData( idRenderLightLocal *ldef ) {
-	areaReference_t	*lref;
-
+void R_FreeLightDefDerivedData( idRenderLightLocal *ldef, bool keepAreaRefs ) {
 	// remove any portal fog references
 	doublePortal_t *dp = ldef->foggedPortals;
 	while ( dp ) {
@@ -893,19 +914,12 @@ void R_FreeLightDefDerivedData( idRenderLightLocal *ldef ) {
 	}
 
 	// free all the references to the light
-	lref = ldef->references;
-	while ( lref ) {
-		// unlink from the area
-		lref->areaNext->areaPrev = lref->areaPrev;
-		lref->areaPrev->areaNext = lref->areaNext;
-
-		// put it back on the free list for reuse
-		ldef->world->areaReferenceAllocator.Free( lref );
-
-		lref = lref->ownerNext;
+	// dmap lights have no world and no references
+	if ( !keepAreaRefs && ldef->references ) {
+		ldef->world->FreeAreaRefs( ldef->references );
+		ldef->references = NULL;
 	}
 
-	ldef->references = NULL;
 	R_FreeLightDefFrustum( ldef );
 }
 
@@ -915,11 +929,10 @@ R_FreeEntityDefDerivedData
 
 Used by both RE_FreeEntityDef and RE_UpdateEntityDef
 Does not actually free the entityDef.
+keepAreaRefs leaves the area references for R_CreateEntityRefs
 ===================
 */
-void R_FreeEntityDefDerivedData( idRenderEntityLocal *def, bool keepDecals, bool keepCachedDynamicModel ) {
-	areaReference_t	*ref;
-
+void R_FreeEntityDefDerivedData( idRenderEntityLocal *def, bool keepDecals, bool keepCachedDynamicModel, bool keepAreaRefs ) {
 	// demo playback needs to free the joints, while normal play
 	// leaves them in the control of the game
 	if ( session->readDemo ) {
@@ -960,19 +973,10 @@ void R_FreeEntityDefDerivedData( idRenderEntityLocal *def, bool keepDecals, bool
 	}
 
 	// free the entityRefs from the areas
-	ref = def->entityRefs;
-	while (ref) {
-		// unlink from the area
-		ref->areaNext->areaPrev = ref->areaPrev;
-		ref->areaPrev->areaNext = ref->areaNext;
-
-		// put it back on the free list for reuse
-		def->world->areaReferenceAllocator.Free( ref );
-
-		ref = ref->ownerNext;
+	if ( !keepAreaRefs ) {
+		def->world->FreeAreaRefs( def->entityRefs );
+		def->entityRefs = NULL;
 	}
-
-	def->entityRefs = NULL;
 }
 
 /*
@@ -1010,6 +1014,64 @@ void R_FreeEntityDefDecals( idRenderEntityLocal *def ) {
 		idRenderModelDecal::Free( def->decals );
 		def->decals = next;
 	}
+	def->pendingDecals.Clear();
+}
+
+static const int MAX_PENDING_DECALS = 64;
+
+/*
+===================
+R_QueueEntityDefDecal
+
+Decals projected by the game are only clipped to the model when the entity
+is next added to a view, so marks on entities that are never seen cost nothing.
+Projections that have faded away while waiting are dropped.
+===================
+*/
+void R_QueueEntityDefDecal( idRenderEntityLocal *def, const decalProjectionInfo_t &localInfo ) {
+	for ( int i = 0; i < def->pendingDecals.Num(); i++ ) {
+		const decalInfo_t decalInfo = def->pendingDecals[i].material->GetDecalInfo();
+		if ( def->pendingDecals[i].startTime + decalInfo.stayTime + decalInfo.fadeTime < localInfo.startTime ) {
+			def->pendingDecals.RemoveIndex( i-- );
+		}
+	}
+
+	// don't let an entity that is shot a lot while out of view pile up projections
+	if ( def->pendingDecals.Num() >= MAX_PENDING_DECALS ) {
+		R_CreateEntityDefPendingDecals( def, localInfo.startTime );
+	}
+
+	def->pendingDecals.Append( localInfo );
+}
+
+/*
+===================
+R_CreateEntityDefPendingDecals
+
+Clips the queued decal projections to the model. Only touches the decals
+of this entity, so it can run for several entities at once.
+===================
+*/
+void R_CreateEntityDefPendingDecals( idRenderEntityLocal *def, int time ) {
+	if ( def->pendingDecals.Num() == 0 ) {
+		return;
+	}
+
+	for ( int i = 0; i < def->pendingDecals.Num(); i++ ) {
+		const decalProjectionInfo_t &localInfo = def->pendingDecals[i];
+		const decalInfo_t decalInfo = localInfo.material->GetDecalInfo();
+
+		// already faded away
+		if ( localInfo.startTime + decalInfo.stayTime + decalInfo.fadeTime < time ) {
+			continue;
+		}
+		if ( def->decals == NULL ) {
+			def->decals = idRenderModelDecal::Alloc();
+		}
+		def->decals->CreateDecal( def->parms.hModel, localInfo );
+	}
+
+	def->pendingDecals.Clear();
 }
 
 /*
@@ -1047,6 +1109,9 @@ void R_FreeDerivedData( void ) {
 	idRenderEntityLocal *def;
 	idRenderLightLocal *light;
 
+	// the back end may still be referencing the interaction surfaces
+	R_SyncRenderThread();
+
 	for ( int j = 0; j < tr.worlds.Num(); j++ ) {
 		rw = tr.worlds[j];
 
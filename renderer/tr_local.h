@@ -118,6 +118,7 @@ typedef struct drawSurf_s {
 	const struct viewEntity_s *space;
 	const idMaterial		*material;	// may be NULL for shadow volumes
 	float					sort;		// material->sort, modified by gui / entity sort offsets
+	uint64_t				sortKey;	// material sort, then state grouping or add order, see R_AddDrawSurf
 	const float				*shaderRegisters;	// evaluated and adjusted for referenceShaders
 	const struct drawSurf_s	*nextOnLight;	// viewLight chains
 	idScreenRect			scissorRect;	// for scissor clipping, local inside renderView viewport
@@ -279,6 +280,9 @@ public:
 	int						dynamicModelFrameCount;	// continuously animating dynamic models will recreate
 													// dynamicModel if this doesn't == tr.viewCount
 	idRenderModel *			cachedDynamicModel;
+	unsigned int			dynamicModelJointsCrc;	// checksum of the joints the dynamic model was skinned with
+	bool					checkDynamicModelJoints;// updated without clearing the dynamic model, the next
+													// callback decides if the joints moved
 
 	idBounds				referenceBounds;		// the local bounds used to place entityRefs, either from parms or a model
 	// axis aligned bounding box in world space, derived from refernceBounds and
@@ -298,6 +302,7 @@ public:
 	// to portal passing
 
 	idRenderModelDecal *	decals;					// chain of decals that have been projected on this model
+	idList<decalProjectionInfo_t> pendingDecals;	// projected by the game, clipped to the model when next in a view
 	idRenderModelOverlay *	overlay;				// blood overlays on animated models
 
 	areaReference_t *		entityRefs;				// chain of all references
@@ -352,6 +357,12 @@ typedef struct viewLight_s {
 	const struct drawSurf_s	*localShadows;				// don't shadow local Surfaces
 	const struct drawSurf_s	*globalInteractions;		// get shadows from everything
 	const struct drawSurf_s	*translucentInteractions;	// get shadows from everything
+
+	// shadow mapped lights (r_useShadowMaps) draw the ambient geometry of the
+	// casters into the map instead of using globalShadows / localShadows
+	bool					shadowMap;
+	float					shadowMapRange;				// distance from globalLightOrigin covered by a point light map
+	const struct drawSurf_s	*shadowMapCasters;
 } viewLight_t;
 
 
@@ -449,9 +460,69 @@ typedef struct viewDef_s {
 	// crossing a closed door.  This is used to avoid drawing interactions
 	// when the light is behind a closed door.
 
+	struct occlusionTest_s *occlusionTests;		// light volumes the back end queries after the depth fill
+
+	bool				needsCurrentDepth;		// a soft particle or a material in view samples _currentDepth
+
 } viewDef_t;
 
 
+// light volumes are tested against the depth buffer with hardware occlusion
+// queries, and the front end skips lights that were completely hidden in a
+// recent frame.  The results are read back without waiting on the GPU, so
+// they trail the view by a frame or two.
+#define MAX_OCCLUSION_LIGHTS		4096	// lightDefs with a higher index are never tested
+#define OCCLUSION_RESULT_FRAMES		4		// older results aren't trusted
+
+typedef struct occlusionTest_s {
+	struct occlusionTest_s *next;
+	int					lightNum;
+	int					frameCount;			// tr.frameCount the test was queued in
+	idBounds			bounds;				// global space
+} occlusionTest_t;
+
+typedef struct {
+	int					frameCount;			// of the test the result belongs to
+	bool				occluded;			// no samples passed the depth test
+} occlusionResult_t;
+
+// written by the back end, read by the front end
+extern occlusionResult_t	occlusionResults[MAX_OCCLUSION_LIGHTS];
+
+
+// the stages of the back end are timed with GL timestamp queries while
+// r_showGpuTimes is set or gpuTimesRequested.  A timestamp is written when the
+// back end switches to another stage, the time up to the next one is added to
+// the stage.  Like the occlusion queries, the results are read back without
+// waiting on the GPU and trail the back end by GPU_TIME_FRAMES frames.
+#define GPU_TIME_FRAMES				4
+#define MAX_GPU_TIME_QUERIES		1024	// per frame, the stages after the last one are added to it
+
+typedef enum {
+	GPU_TIME_OTHER,				// guis, copies and everything outside the stages below
+	GPU_TIME_DEPTH,
+	GPU_TIME_OCCLUSION,
+	GPU_TIME_INTERACTIONS,
+	GPU_TIME_SHADOWS,			// stencil shadow volumes and shadow maps
+	GPU_TIME_SHADER_PASSES,
+	GPU_TIME_FOG,
+	GPU_TIME_POST_PROCESS,
+	NUM_GPU_TIMES
+} gpuTime_t;
+
+typedef struct {
+	int					frameCount;			// of the back end frame that was timed, 0 for none yet
+	float				msec[NUM_GPU_TIMES];
+	float				totalMsec;
+} gpuTimes_t;
+
+extern const char *		gpuTimeNames[NUM_GPU_TIMES];
+
+// written by the back end, read by the front end
+extern gpuTimes_t		gpuTimes;
+extern bool				gpuTimesRequested;	// times without r_showGpuTimes, for the benchmarks
+
+
 // complex light / surface interactions are broken up into multiple passes of a
 // simple interaction shader
 typedef struct {
@@ -546,7 +617,7 @@ typedef struct frameMemoryBlock_s {
 // all of the information needed by the back end must be
 // contained in a frameData_t.  This entire structure is
 // duplicated so the front and back end can run in parallel
-// on an SMP machine (OBSOLETE: this capability has been removed)
+// on an SMP machine (r_useSMP)
 typedef struct {
 	// one or more blocks of memory for all frame
 	// temporary allocations
@@ -566,7 +637,11 @@ typedef struct {
 	emptyCommand_t	*cmdHead, *cmdTail;		// may be of other command type based on commandId
 } frameData_t;
 
+#define NUM_FRAME_DATA	2
+
 extern	frameData_t	*frameData;
+extern	frameData_t	*smpFrameData[NUM_FRAME_DATA];
+extern	int			smpFrame;
 
 //=======================================================================
 
@@ -611,6 +686,7 @@ typedef struct {
 	int		c_tangentIndexes;	// R_DeriveTangents()
 	int		c_entityUpdates, c_lightUpdates, c_entityReferences, c_lightReferences;
 	int		c_guiSurfs;
+	int		c_remoteRenders, c_remoteRendersReused;	// remote render subviews drawn or kept from an earlier frame
 	int		frontEndMsec;		// sum of time in all RE_RenderScene's in a frame
 	int		frontEndMsecLast;		// time in last RE_RenderScene
 } performanceCounters_t;
@@ -655,6 +731,11 @@ typedef struct {
 	int		c_vboIndexes;
 	float	c_overDraw;	
 
+	int		c_textureBinds;		// state changes that actually reached GL
+	int		c_glStateChanges;
+	int		c_bufferBinds;
+	int		c_spaceChanges;
+
 	float	maxLightValue;	// for light scale
 	int		msec;			// total msec for backend run
 	int		msecLast;			// last msec for backend run
@@ -668,6 +749,7 @@ typedef struct {
 	backEndCounters_t	pc;
 
 	const viewEntity_t *currentSpace;		// for detecting when a matrix must change
+	const struct vertCache_s *currentAmbientCache;	// vertex pointers set up by the depth fill, NULL if unknown
 	idScreenRect		currentScissor;
 	// for scissor clipping, local inside renderView viewport
 
@@ -715,10 +797,13 @@ static const int	MAX_RENDER_CROPS = 8;
 ** but may read fields that aren't dynamically modified
 ** by the frontend.
 */
+static const int	MAX_CAPTURE_SLOTS = 4;
+
 // #4395 Duzenko lightem pixel pack buffer optimization
 class idRenderSystemLocal : public idRenderSystem {
 private:
-	GLuint pbo;
+	GLuint pbo[MAX_CAPTURE_SLOTS];
+	bool pboQueued[MAX_CAPTURE_SLOTS];	// a read back is waiting in the slot's pixel buffer
 
 public:
 	// external functions
@@ -741,6 +826,9 @@ public:
 	virtual void			DrawStretchPic ( float x, float y, float w, float h, float s1, float t1, float s2, float t2, const idMaterial *material );
 
 	virtual void			DrawStretchTri ( idVec2 p1, idVec2 p2, idVec2 p3, idVec2 t1, idVec2 t2, idVec2 t3, const idMaterial *material );
+	virtual void			BeginGuiCapture( guiCapture_t &capture );
+	virtual bool			EndGuiCapture( guiCapture_t &capture );
+	virtual void			DrawGuiCapture( const guiCapture_t &capture );
 	virtual void			GlobalToNormalizedDeviceCoordinates( const idVec3 &global, idVec3 &ndc );
 	virtual void			GetGLSettings( int& width, int& height );
 	virtual void			PrintMemInfo( MemInfo_t *mi );
@@ -758,7 +846,7 @@ public:
 	virtual void			GetCurrentRenderCropSize(int& width, int& height);
 	virtual void			CaptureRenderToImage( const char *imageName );
 	virtual void			CaptureRenderToFile( const char *fileName, bool fixAlpha );
-	virtual void			CaptureRenderToBuffer(unsigned char* buffer);
+	virtual bool			CaptureRenderToBuffer(unsigned char* buffer, int slot = -1);
 	virtual void			UnCrop();
 	virtual void			GetCardCaps( bool &oldCard, bool &nv10or20 );
 	virtual bool			UploadImage( const char *imageName, const byte *data, int width, int height );
@@ -783,6 +871,7 @@ public:
 											// and every R_MarkFragments call
 
 	int						staticAllocCount;	// running total of bytes allocated
+	bool					lockStaticAlloc;	// interactions are being created on several threads
 
 	float					frameShaderTime;	// shader time for all non-world 2D rendering
 
@@ -887,7 +976,8 @@ extern idCVar r_useLightPortalFlow;		// 1 = do a more precise area reference det
 extern idCVar r_useTripleTextureARB;	// 1 = cards with 3+ texture units do a two pass instead of three pass
 extern idCVar r_useShadowSurfaceScissor;// 1 = scissor shadows by the scissor rect of the interaction surfaces
 extern idCVar r_useConstantMaterials;	// 1 = use pre-calculated material registers if possible
-extern idCVar r_useInteractionTable;	// create a full entityDefs * lightDefs table to make finding interactions faster
+extern idCVar r_useMaterialRegisterCache;	// 1 = share the material registers of the surfaces of a view with the same parms
+extern idCVar r_useInteractionTable;	// use a hash of all light / entity interactions to make finding them faster
 extern idCVar r_useNodeCommonChildren;	// stop pushing reference bounds early when possible
 extern idCVar r_useSilRemap;			// 1 = consider verts with the same XYZ, but different ST the same for shadows
 extern idCVar r_useCulling;				// 0 = none, 1 = sphere, 2 = sphere + box
@@ -897,6 +987,9 @@ extern idCVar r_useLightCulling;		// 0 = none, 1 = box, 2 = exact clip of polyhe
 extern idCVar r_useLightScissors;		// 1 = use custom scissor rectangle for each light
 extern idCVar r_useClippedLightScissors;// 0 = full screen when near clipped, 1 = exact when near clipped, 2 = exact always
 extern idCVar r_useEntityCulling;		// 0 = none, 1 = box
+extern idCVar r_useBatchPortalCulling;	// box test all refs of an area against the portal planes in one SIMD call
+extern idCVar r_useBatchBoxCulling;		// box test all surfaces of an interaction against a frustum in one SIMD call
+extern idCVar r_modelResidencyMegs;		// memory kept for models of earlier levels
 extern idCVar r_useEntityScissors;		// 1 = use custom scissor rectangle for each entity
 extern idCVar r_useInteractionCulling;	// 1 = cull interactions
 extern idCVar r_useInteractionScissors;	// 1 = use a custom scissor rectangle for each interaction
@@ -904,23 +997,36 @@ extern idCVar r_useFrustumFarDistance;	// if != 0 force the view frustum far dis
 extern idCVar r_useShadowCulling;		// try to cull shadows from partially visible lights
 extern idCVar r_usePreciseTriangleInteractions;	// 1 = do winding clipping to determine if each ambiguous tri should be lit
 extern idCVar r_useTurboShadow;			// 1 = use the infinite projection with W technique for dynamic shadows
+extern idCVar r_useParallelInteractions;	// 1 = create interaction surfaces on several threads
+extern idCVar r_useParallelSkinning;		// 1 = skin the md5 models of the view entities on several threads
+extern idCVar r_useParallelParticles;		// 1 = generate the particle quads of the view entities on several threads
+extern idCVar r_useParallelDecals;		// 1 = clip the queued decals of the view entities on several threads
+extern idCVar r_cinematicDecodeAhead;	// 1 = decode the next cinematic frame on a worker thread
+extern idCVar r_cinematicPauseHidden;	// 1 = cinematics that aren't drawn don't advance
 extern idCVar r_useExternalShadows;		// 1 = skip drawing caps when outside the light volume
 extern idCVar r_useOptimizedShadows;	// 1 = use the dmap generated static shadow volumes
 extern idCVar r_useShadowVertexProgram;	// 1 = do the shadow projection in the vertex program on capable cards
 extern idCVar r_useShadowProjectedCull;	// 1 = discard triangles outside light volume before shadowing
 extern idCVar r_useDeferredTangents;	// 1 = don't always calc tangents after deform
 extern idCVar r_useCachedDynamicModels;	// 1 = cache snapshots of dynamic models
+extern idCVar r_useDeformCache;			// 1 = keep the results of view independent deforms on static surfaces
 extern idCVar r_useTwoSidedStencil;		// 1 = do stencil shadows in one pass with different ops on each side
 extern idCVar r_useInfiniteFarZ;		// 1 = use the no-far-clip-plane trick
 extern idCVar r_useScissor;				// 1 = scissor clip as portals and lights are processed
 extern idCVar r_usePortals;				// 1 = use portals to perform area culling, otherwise draw everything
 extern idCVar r_useStateCaching;		// avoid redundant state changes in GL_*() calls
+extern idCVar r_useSMP;					// run the back end on its own thread
 extern idCVar r_useCombinerDisplayLists;// if 1, put all nvidia register combiner programming in display lists
 extern idCVar r_useVertexBuffers;		// if 0, don't use ARB_vertex_buffer_object for vertexes
 extern idCVar r_useIndexBuffers;		// if 0, don't use ARB_vertex_buffer_object for indexes
+extern idCVar r_useJointsCrc;			// keep the dynamic model and shadows of animated models while their joints don't move
 extern idCVar r_useEntityCallbacks;		// if 0, issue the callback immediately at update time, rather than defering
 extern idCVar r_lightAllBackFaces;		// light all the back faces, even when they would be shadowed
+extern idCVar r_useOcclusionQueries;	// skip lights whose volume was hidden in a recent frame
 extern idCVar r_useDepthBoundsTest;     // use depth bounds test to reduce shadow fill
+extern idCVar r_useShadowMaps;			// 1 = shadow map lights with the shadowmap spawnarg, 2 = all lights
+extern idCVar r_shadowMapSize;			// resolution of the shadow map and of each shadow cube map face
+extern idCVar r_shadowMapBias;			// shadow map depth bias, as a fraction of the light range
 
 extern idCVar r_skipPostProcess;		// skip all post-process renderings
 extern idCVar r_skipSuppress;			// ignore the per-view suppressions
@@ -936,6 +1042,9 @@ extern idCVar r_skipNewAmbient;			// bypasses all vertex/fragment program ambien
 extern idCVar r_skipBlendLights;		// skip all blend lights
 extern idCVar r_skipFogLights;			// skip all fog lights
 extern idCVar r_skipSubviews;			// 1 = don't render any mirrors / cameras / etc
+extern idCVar r_remoteRenderInterval;	// msec a remote render view is kept before it is rendered again
+extern idCVar r_remoteRenderScale;		// resolution scale of remote render views
+extern idCVar r_useGuiBatching;			// 1 = draw non overlapping gui surfaces with the same material and color together
 extern idCVar r_skipGuiShaders;			// 1 = don't render any gui elements on surfaces
 extern idCVar r_skipParticles;			// 1 = don't render any particles
 extern idCVar r_skipUpdates;			// 1 = don't accept any entity or light updates, making everything static
@@ -948,6 +1057,7 @@ extern idCVar r_skipDiffuse;			// use black for diffuse
 extern idCVar r_skipOverlays;			// skip overlay surfaces
 extern idCVar r_skipROQ;
 extern idCVar r_skipDepthCapture;		// skip capture of early depth pass. revelator + SteveL #3877
+extern idCVar r_skipUnusedDepthCapture;	// only capture the depth buffer for views with soft particles or materials sampling _currentDepth
 extern idCVar r_useSoftParticles;		// SteveL #3878
 
 extern idCVar r_ignoreGLErrors;
@@ -991,6 +1101,7 @@ extern idCVar r_showCull;				// report sphere and box culling stats
 extern idCVar r_showInteractions;		// report interaction generation activity
 extern idCVar r_showSurfaces;			// report surface/light/shadow counts
 extern idCVar r_showPrimitives;			// report vertex/index/draw counts
+extern idCVar r_showGpuTimes;			// show the GPU time of each back end stage
 extern idCVar r_showPortals;			// draw portal outlines in color based on passed / not passed
 extern idCVar r_showAlloc;				// report alloc/free counts
 extern idCVar r_showSkel;				// draw the skeleton when model animates
@@ -1031,6 +1142,8 @@ extern idCVar r_stencilShadowMode;
 
 // duzenko: late 2016 additions
 extern idCVar r_useAnonreclaimer;
+extern idCVar r_useBinaryProc;
+extern idCVar r_useBinaryMD5;
 extern idCVar r_useFbo;
 extern idCVar r_fboDebug;
 extern idCVar r_fboColorBits;
@@ -1187,6 +1300,14 @@ void		GLimp_DeactivateContext( void );
 // being immediate returns, which lets us guage how much time is
 // being spent inside OpenGL.
 
+void		GLimp_ActivateBackEndContext( void );
+void		GLimp_DeactivateBackEndContext( void );
+// With a render thread running, the front end can borrow the back end
+// context while the back end is idle (after GLimp_FrontEndSleep), so
+// synchronous renders and pixel readbacks see the same framebuffer
+// objects the back end draws into.  Deactivate restores the front end
+// context, and must happen before the back end is woken again.
+
 void		GLimp_EnableLogging( bool enable );
 
 
@@ -1204,6 +1325,7 @@ void R_RenderView( viewDef_t *parms );
 bool R_CullLocalBox( const idBounds &bounds, const float modelMatrix[16], int numPlanes, const idPlane *planes );
 bool R_RadiusCullLocalBox( const idBounds &bounds, const float modelMatrix[16], int numPlanes, const idPlane *planes );
 bool R_CornerCullLocalBox( const idBounds &bounds, const float modelMatrix[16], int numPlanes, const idPlane *planes );
+void R_CullLocalBoxes( byte *culled, const idBounds *const *bounds, int numBounds, const float modelMatrix[16], int numPlanes, const idPlane *planes );
 
 void R_AxisToModelMatrix( const idMat3 &axis, const idVec3 &origin, float modelMatrix[16] );
 
@@ -1274,6 +1396,7 @@ void R_SetLightProject( idPlane lightProject[4], const idVec3 origin, const idVe
 void R_AddLightSurfaces( void );
 void R_AddModelSurfaces( void );
 void R_RemoveUnecessaryViewLights( void );
+bool R_LightUsesShadowMap( const idRenderLightLocal *light );
 
 void R_FreeDerivedData( void );
 void R_ReCreateWorldReferences( void );
@@ -1285,15 +1408,17 @@ void R_CreateEntityRefs( idRenderEntityLocal *def );
 void R_CreateLightRefs( idRenderLightLocal *light );
 
 void R_DeriveLightData( idRenderLightLocal *light );
-void R_FreeLightDefDerivedData( idRenderLightLocal *light );
+void R_FreeLightDefDerivedData( idRenderLightLocal *light, bool keepAreaRefs = false );
 void R_CheckForEntityDefsUsingModel( idRenderModel *model );
 
 void R_ClearEntityDefDynamicModel( idRenderEntityLocal *def );
-void R_FreeEntityDefDerivedData( idRenderEntityLocal *def, bool keepDecals, bool keepCachedDynamicModel );
+void R_FreeEntityDefDerivedData( idRenderEntityLocal *def, bool keepDecals, bool keepCachedDynamicModel, bool keepAreaRefs = false );
 void R_FreeEntityDefCachedDynamicModel( idRenderEntityLocal *def );
 void R_FreeEntityDefDecals( idRenderEntityLocal *def );
 void R_FreeEntityDefOverlay( idRenderEntityLocal *def );
 void R_FreeEntityDefFadedDecals( idRenderEntityLocal *def, int time );
+void R_QueueEntityDefDecal( idRenderEntityLocal *def, const decalProjectionInfo_t &localInfo );
+void R_CreateEntityDefPendingDecals( idRenderEntityLocal *def, int time );
 
 void R_CreateLightDefFogPortals( idRenderLightLocal *ldef );
 
@@ -1349,6 +1474,12 @@ DRAW_STANDARD
 void RB_DrawElementsWithCounters( const srfTriangles_t *tri );
 void RB_DrawShadowElementsWithCounters( const srfTriangles_t *tri, int numIndexes );
 void RB_STD_FillDepthBuffer( drawSurf_t **drawSurfs, int numDrawSurfs );
+void RB_STD_OcclusionQueries( void );
+void RB_ResetOcclusionQueries( void );
+void RB_ResetGpuTimes( void );
+void RB_BeginGpuTimes( void );
+void RB_EndGpuTimes( void );
+gpuTime_t RB_SetGpuTime( gpuTime_t stage );		// returns the stage to go back to
 void RB_BindVariableStageImage( const textureStage_t *texture, const float *shaderRegisters );
 void RB_BindStageTexture( const float *shaderRegisters, const textureStage_t *texture, const drawSurf_t *surf );
 void RB_FinishStageTexture( const textureStage_t *texture, const drawSurf_t *surf );
@@ -1440,6 +1571,15 @@ typedef enum {
 	FPROG_BLOOM_GAUSS_BLRY,
 	VPROG_BLOOM_FINAL_PASS,
 	FPROG_BLOOM_FINAL_PASS,
+	// shadow maps
+	VPROG_SHADOW_MAP_POINT,
+	FPROG_SHADOW_MAP_POINT,
+	VPROG_SHADOW_MAP_PROJ,
+	FPROG_SHADOW_MAP_PROJ,
+	VPROG_SHADOW_MAP_TEST_POINT,
+	FPROG_SHADOW_MAP_TEST_POINT,
+	VPROG_SHADOW_MAP_TEST_PROJ,
+	FPROG_SHADOW_MAP_TEST_PROJ,
 	// 
 	PROG_USER
 } program_t;
@@ -1491,7 +1631,16 @@ typedef enum {
 	PP_COLOR_ADD,
 
 	PP_LIGHT_FALLOFF_TQ = 20,	// only for NV programs
-	PP_MISC_0 // rebb: env vec4 slot for misc data, currently only used for world-up in object-space
+	PP_MISC_0, // rebb: env vec4 slot for misc data, currently only used for world-up in object-space
+
+	PP_SHADOW_MAP_0 = 22,	// shadow map passes: clip rows for point lights, light planes for projected lights
+	PP_SHADOW_MAP_1,
+	PP_SHADOW_MAP_2,
+	PP_SHADOW_MAP_3,
+	PP_SHADOW_MAP_LIGHT_X,	// shadow map passes: local to light space rows for point lights
+	PP_SHADOW_MAP_LIGHT_Y,
+	PP_SHADOW_MAP_LIGHT_Z,
+	PP_SHADOW_MAP_PARMS		// 1 / shadowMapRange, r_shadowMapBias
 } programParameter_t;
 
 
@@ -1577,9 +1726,20 @@ TRISURF
 
 #define USE_TRI_DATA_ALLOCATOR
 
+// the allocators of surfaces made during a level load are kept apart
+// from the static ones, so they can be released at the next level load
+enum {
+	TRI_REGION_STATIC,
+	TRI_REGION_LEVEL1,
+	TRI_REGION_LEVEL2,
+	TRI_REGION_COUNT
+};
+
 void				R_InitTriSurfData( void );
 void				R_ShutdownTriSurfData( void );
 void				R_PurgeTriSurfData( frameData_t *frame );
+void				R_BeginLevelTriSurfRegion( void );
+void				R_EndLevelTriSurfRegion( void );
 void				R_ShowTriSurfMemory_f( const idCmdArgs &args );
 
 srfTriangles_t *	R_AllocStaticTriSurf( void );
@@ -1611,6 +1771,10 @@ void				R_DeriveFacePlanes( srfTriangles_t *tri );		// also called by renderbump
 void				R_CleanupTriangles( srfTriangles_t *tri, bool createNormals, bool identifySilEdges, bool useUnsmoothedTangents );
 void				R_ReverseTriangles( srfTriangles_t *tri );
 
+// the cleaned up surfaces of the model cache
+void				R_WriteCleanedTriSurf( idFile *f, const srfTriangles_t *tri );
+srfTriangles_t *	R_ReadCleanedTriSurf( idFile *f );
+
 // Only deals with vertexes and indexes, not silhouettes, planes, etc.
 // Does NOT perform a cleanup triangles, so there may be duplicated verts in the result.
 srfTriangles_t *	R_MergeSurfaceList( const srfTriangles_t **surfaces, int numSurfaces );
@@ -1645,6 +1809,8 @@ typedef struct deformInfo_s {
 	silEdge_t *		silEdges;
 
 	dominantTri_t *	dominantTris;
+
+	int				region;			// tri surf allocator region of the arrays
 } deformInfo_t;
 
 
@@ -1675,6 +1841,7 @@ void R_InitFrameData( void );
 void R_ShutdownFrameData( void );
 int R_CountFrameData( void );
 void R_ToggleSmpFrame( void );
+void R_SyncRenderThread( void );
 void *R_FrameAlloc( int bytes );
 void *R_ClearedFrameAlloc( int bytes );
 void R_FrameFree( void *data );
@@ -1682,6 +1849,8 @@ void R_FrameFree( void *data );
 void *R_StaticAlloc( int bytes );		// just malloc with error checking
 void *R_ClearedStaticAlloc( int bytes );	// with memset
 void R_StaticFree( void *data );
+void R_LockStaticAlloc( void );			// only locks while tr.lockStaticAlloc is set
+void R_UnlockStaticAlloc( void );
 
 
 /*
@@ -1726,6 +1895,7 @@ void RB_LogComment( const char *comment, ... ) id_attribute((format(printf,1,2))
 void RB_ShowImages( void );
 
 void RB_ExecuteBackEndCommands( const emptyCommand_t *cmds );
+void RB_RenderThread( void );
 
 
 /*
@@ -1758,6 +1928,7 @@ TR_DEFORM
 */
 
 void R_DeformDrawSurf( drawSurf_t *drawSurf );
+void R_FreeDeformCache( srfTriangles_t *tri );
 
 /*
 =============================================================
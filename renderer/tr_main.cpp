@@ -178,6 +178,14 @@ void R_ToggleSmpFrame( void ) {
 	if ( r_lockSurfaces.GetBool() ) {
 		return;
 	}
+
+	// with a render thread the back end is still drawing from the
+	// current frame, so switch to the one it finished with last
+	if ( glConfig.smpActive ) {
+		smpFrame++;
+		frameData = smpFrameData[smpFrame % NUM_FRAME_DATA];
+	}
+
 	R_FreeDeferredTriSurfs( frameData );
 
 	// clear frame-temporary data
@@ -200,6 +208,21 @@ void R_ToggleSmpFrame( void ) {
 	R_ClearCommandChain();
 }
 
+/*
+====================
+R_SyncRenderThread
+
+Waits until the back end has finished everything it was given, so the
+front end can safely free or modify data the back end may reference.
+====================
+*/
+void R_SyncRenderThread( void ) {
+	if ( !glConfig.smpActive ) {
+		return;
+	}
+	GLimp_FrontEndSleep();
+}
+
 
 //=====================================================
 
@@ -214,20 +237,25 @@ void R_ShutdownFrameData( void ) {
 	frameData_t *frame;
 	frameMemoryBlock_t *block;
 
-	// free any current data
-	frame = frameData;
-	if ( !frame ) {
-		return;
-	}
+	R_SyncRenderThread();
+
+	for ( int i = 0 ; i < NUM_FRAME_DATA ; i++ ) {
+		// free any current data
+		frame = smpFrameData[i];
+		if ( !frame ) {
+			continue;
+		}
 
-	R_FreeDeferredTriSurfs( frame );
+		R_FreeDeferredTriSurfs( frame );
 
-	frameMemoryBlock_t *nextBlock;
-	for ( block = frame->memory ; block ; block = nextBlock ) {
-		nextBlock = block->next;
-		Mem_Free( block );
+		frameMemoryBlock_t *nextBlock;
+		for ( block = frame->memory ; block ; block = nextBlock ) {
+			nextBlock = block->next;
+			Mem_Free( block );
+		}
+		Mem_Free( frame );
+		smpFrameData[i] = NULL;
 	}
-	Mem_Free( frame );
 	frameData = NULL;
 }
 
@@ -243,18 +271,25 @@ void R_InitFrameData( void ) {
 
 	R_ShutdownFrameData();
 
-	frameData = (frameData_t *)Mem_ClearedAlloc( sizeof( *frameData ));
-	frame = frameData;
-	size = MEMORY_BLOCK_SIZE;
-	block = (frameMemoryBlock_t *)Mem_Alloc( size + sizeof( *block ) );
-	if ( !block ) {
-		common->FatalError( "R_InitFrameData: Mem_Alloc() failed" );
+	// both frames are always allocated, the second is only used with r_useSMP
+	for ( int i = 0 ; i < NUM_FRAME_DATA ; i++ ) {
+		smpFrameData[i] = (frameData_t *)Mem_ClearedAlloc( sizeof( *frameData ));
+		frame = smpFrameData[i];
+		size = MEMORY_BLOCK_SIZE;
+		block = (frameMemoryBlock_t *)Mem_Alloc( size + sizeof( *block ) );
+		if ( !block ) {
+			common->FatalError( "R_InitFrameData: Mem_Alloc() failed" );
+		}
+		block->size = size;
+		block->used = 0;
+		block->next = NULL;
+		frame->memory = block;
+		frame->alloc = block;
+		frame->memoryHighwater = 0;
 	}
-	block->size = size;
-	block->used = 0;
-	block->next = NULL;
-	frame->memory = block;
-	frame->memoryHighwater = 0;
+
+	smpFrame = 0;
+	frameData = smpFrameData[0];
 
 	R_ToggleSmpFrame();
 }
@@ -296,10 +331,14 @@ void *R_StaticAlloc( int bytes ) {
 
 	tr.pc.c_alloc++;
 
+	R_LockStaticAlloc();
+
 	tr.staticAllocCount += bytes;
 
     buf = Mem_Alloc( bytes );
 
+	R_UnlockStaticAlloc();
+
 	// don't exit on failure on zero length allocations since the old code didn't
 	if ( !buf && ( bytes != 0 ) ) {
 		common->FatalError( "R_StaticAlloc failed on %i bytes", bytes );
@@ -327,7 +366,35 @@ R_StaticFree
 */
 void R_StaticFree( void *data ) {
 	tr.pc.c_free++;
+	R_LockStaticAlloc();
     Mem_Free( data );
+	R_UnlockStaticAlloc();
+}
+
+/*
+=================
+R_LockStaticAlloc
+
+Neither the heap nor the tri surf allocators are thread safe, so while
+R_AddModelSurfaces creates interactions on several threads
+(tr.lockStaticAlloc) every static allocation goes through this lock
+=================
+*/
+void R_LockStaticAlloc( void ) {
+	if ( tr.lockStaticAlloc ) {
+		Sys_EnterCriticalSection( CRITICAL_SECTION_THREE );
+	}
+}
+
+/*
+=================
+R_UnlockStaticAlloc
+=================
+*/
+void R_UnlockStaticAlloc( void ) {
+	if ( tr.lockStaticAlloc ) {
+		Sys_LeaveCriticalSection( CRITICAL_SECTION_THREE );
+	}
 }
 
 /*
@@ -672,6 +739,54 @@ bool R_CullLocalBox( const idBounds &bounds, const float modelMatrix[16], int nu
 	return R_CornerCullLocalBox( bounds, modelMatrix, numPlanes, planes );
 }
 
+/*
+=================
+R_CullLocalBoxes
+
+R_CullLocalBox for many bounds in the space of one model matrix. The planes
+are moved into model space once and all bounds are box tested against them
+with one SIMD call, instead of moving the eight corners of every bounds into
+world space. Sets culled[i] if bounds[i] is outside one of the planes, NULL
+bounds are never culled. Only uses the stack, so it may run on any thread.
+=================
+*/
+void R_CullLocalBoxes( byte *culled, const idBounds *const *bounds, int numBounds, const float modelMatrix[16], int numPlanes, const idPlane *planes ) {
+	const int	BATCH = 64;
+	float		centers[BATCH * 3];
+	float		extents[BATCH * 3];
+	idPlane		localPlanes[6];
+	int			i, j, k, num;
+
+	// the box test is the corner test, the radius test only matters without it
+	if ( r_useCulling.GetInteger() < 2 || !r_useBatchBoxCulling.GetBool() || numPlanes > 6 ) {
+		for ( i = 0 ; i < numBounds ; i++ ) {
+			culled[i] = bounds[i] && R_CullLocalBox( *bounds[i], modelMatrix, numPlanes, planes );
+		}
+		return;
+	}
+
+	for ( i = 0 ; i < numPlanes ; i++ ) {
+		R_GlobalPlaneToLocal( modelMatrix, planes[i], localPlanes[i] );
+	}
+
+	for ( i = 0 ; i < numBounds ; i += BATCH ) {
+		num = Min( BATCH, numBounds - i );
+		for ( j = 0 ; j < num ; j++ ) {
+			const idBounds *b = bounds[i + j];
+			for ( k = 0 ; k < 3 ; k++ ) {
+				if ( b ) {
+					centers[k * num + j] = ( (*b)[0][k] + (*b)[1][k] ) * 0.5f;
+					extents[k * num + j] = ( (*b)[1][k] - (*b)[0][k] ) * 0.5f;
+				} else {
+					centers[k * num + j] = 0.0f;
+					extents[k * num + j] = idMath::INFINITY;
+				}
+			}
+		}
+		SIMDProcessor->CullBoxes( culled + i, centers, extents, num, localPlanes, numPlanes );
+	}
+}
+
 /*
 ==========================
 R_TransformModelToClip
@@ -1045,10 +1160,10 @@ static int R_QsortSurfaces( const void *a, const void *b ) {
 	ea = *(drawSurf_t **)a;
 	eb = *(drawSurf_t **)b;
 
-	if ( ea->sort < eb->sort ) {
+	if ( ea->sortKey < eb->sortKey ) {
 		return -1;
 	}
-	if ( ea->sort > eb->sort ) {
+	if ( ea->sortKey > eb->sortKey ) {
 		return 1;
 	}
 	return 0;
@@ -1061,7 +1176,8 @@ R_SortDrawSurfs
 =================
 */
 static void R_SortDrawSurfs( void ) {
-	// sort the drawsurfs by sort type, then orientation, then shader
+	// sort the drawsurfs by sort type, then shader, entity and vertex buffer
+	// for opaque surfaces, or the order they were added in for everything else
 	qsort( tr.viewDef->drawSurfs, tr.viewDef->numDrawSurfs, sizeof( tr.viewDef->drawSurfs[0] ),
 		R_QsortSurfaces );
 }
@@ -1086,6 +1202,7 @@ Parms will typically be allocated with R_FrameAlloc
 ================
 */
 void R_RenderView( viewDef_t *parms ) {
+	PROFILE_SCOPE( "R_RenderView" );
 	viewDef_t		*oldView;
 
 	if ( parms->renderView.width <= 0 || parms->renderView.height <= 0 ) {
@@ -1101,6 +1218,9 @@ void R_RenderView( viewDef_t *parms ) {
 
 	tr.sortOffset = 0;
 
+	// subviews start out as a copy of the main view
+	tr.viewDef->occlusionTests = NULL;
+
 	// set the matrix for world space to eye space
 	R_SetViewMatrix( tr.viewDef );
 
@@ -229,6 +229,7 @@ void RB_RenderDrawSurfListWithFunction( drawSurf_t **drawSurfs, int numDrawSurfs
 											  void (*triFunc_)( const drawSurf_t *) ) {
 	const drawSurf_t		*drawSurf;
 	backEnd.currentSpace = NULL;
+	backEnd.currentAmbientCache = NULL;
 
 	for ( int i = 0  ; i < numDrawSurfs ; i++ ) {
 		drawSurf = drawSurfs[i];
@@ -243,6 +244,9 @@ void RB_RenderDrawSurfListWithFunction( drawSurf_t **drawSurfs, int numDrawSurfs
 		} else {
 			return;
 		}
+		if ( drawSurf->space != backEnd.currentSpace ) {
+			backEnd.pc.c_spaceChanges++;
+		}
 
 		if ( drawSurf->space->weaponDepthHack ) {
 			RB_EnterWeaponDepthHack();
@@ -291,6 +295,9 @@ void RB_RenderDrawSurfChainWithFunction( const drawSurf_t *drawSurfs,
 		} else {
 			return;
 		}
+		if ( drawSurf->space != backEnd.currentSpace ) {
+			backEnd.pc.c_spaceChanges++;
+		}
 
 		if ( drawSurf->space->weaponDepthHack ) {
 			RB_EnterWeaponDepthHack();
@@ -935,6 +942,7 @@ RB_DrawView
 =============
 */
 void RB_DrawView( const void *data ) {
+	PROFILE_SCOPE( "RB_DrawView" );
 	const drawSurfsCommand_t	*cmd;
 
 	cmd = (const drawSurfsCommand_t *)data;
@@ -959,7 +967,9 @@ void RB_DrawView( const void *data ) {
 	// skip render context sets the wgl context to NULL,
 	// which should factor out the API cost, under the assumption
 	// that all gl calls just return if the context isn't valid
-	else if ( backEnd.viewDef->viewEntitys && r_skipRenderContext.GetBool() ) {
+	// (not with a render thread, the context belongs to the front end)
+	const bool skipContext = r_skipRenderContext.GetBool() && !glConfig.smpActive;
+	if ( backEnd.viewDef->viewEntitys && skipContext ) {
 		GLimp_DeactivateContext();
 	}
 
@@ -971,7 +981,7 @@ void RB_DrawView( const void *data ) {
 	RB_STD_DrawView();
 
 	// restore the context for 2D drawing if we were stubbing it out
-	if ( r_skipRenderContext.GetBool() && backEnd.viewDef->viewEntitys ) {
+	if ( skipContext && backEnd.viewDef->viewEntitys ) {
 		GLimp_ActivateContext();
 		RB_SetDefaultGLState();
 	}
@@ -275,6 +275,22 @@ static viewDef_t *R_XrayViewBySurface( drawSurf_t *drawSurf ) {
 	return parms;
 }
 
+/*
+===============
+R_RemoteRenderImage
+
+Contents don't matter, the remote view is copied over it
+===============
+*/
+static void R_RemoteRenderImage( idImage *image ) {
+	byte	data[16][16][4];
+
+	memset( data, 0, sizeof( data ) );
+
+	image->GenerateImage( (byte *)data, 16, 16, 
+		TF_DEFAULT, false, TR_REPEAT, TD_HIGH_QUALITY );
+}
+
 /*
 ===============
 R_RemoteRender
@@ -293,6 +309,21 @@ static void R_RemoteRender( drawSurf_t *surf, textureStage_t *stage ) {
 		return;
 	}
 
+	// A view that is only rendered every few frames needs an image of its own, the scratch
+	// image is overwritten by mirrors and other remote views in between
+	const int interval = r_remoteRenderInterval.GetInteger();
+	const int time = tr.viewDef->renderView.time;
+	if ( interval > 0 ) {
+		if ( !stage->image || stage->image == globalImages->scratchImage ) {
+			static int numRemoteRenderImages = 0;
+			stage->image = globalImages->ImageFromFunction( va( "_remoteRender%i", numRemoteRenderImages++ ), R_RemoteRenderImage );
+		} else if ( time >= stage->dynamicTime && time - stage->dynamicTime < interval ) {
+			stage->dynamicFrameCount = tr.frameCount;
+			tr.pc.c_remoteRendersReused++;
+			return;
+		}
+	}
+
 	// copy the viewport size from the original
 	parms = (viewDef_t *)R_FrameAlloc( sizeof( *parms ) );
 	*parms = *tr.viewDef;
@@ -304,7 +335,8 @@ static void R_RemoteRender( drawSurf_t *surf, textureStage_t *stage ) {
 	parms->renderView.viewID = 0;	// clear to allow player bodies to show up, and suppress view weapons
 	parms->initialViewAreaOrigin = parms->renderView.vieworg;
 
-	tr.CropRenderSize( stage->width, stage->height, true );
+	const float scale = r_remoteRenderScale.GetFloat();
+	tr.CropRenderSize( Max( 1, idMath::FtoiFast( stage->width * scale ) ), Max( 1, idMath::FtoiFast( stage->height * scale ) ), true );
 
 	parms->renderView.x = 0;
 	parms->renderView.y = 0;
@@ -323,9 +355,11 @@ static void R_RemoteRender( drawSurf_t *surf, textureStage_t *stage ) {
 
 	// generate render commands for it
 	R_RenderView(parms);
+	tr.pc.c_remoteRenders++;
 
 	// copy this rendering to the image
 	stage->dynamicFrameCount = tr.frameCount;
+	stage->dynamicTime = time;
 	if (!stage->image) {
 		stage->image = globalImages->scratchImage;
 	}
@@ -112,35 +112,143 @@ is highly uneven.
 const int MAX_SIL_EDGES			= 0x10000;
 const int SILEDGE_HASH_SIZE		= 1024;
 
-static int			numSilEdges;
-static silEdge_t *	silEdges;
-static idHashIndex	silEdgeHash( SILEDGE_HASH_SIZE, MAX_SIL_EDGES );
-static int			numPlanes;
+// R_IdentifySilEdges scratch, kept per call so surfaces can be cleaned up on several threads
+typedef struct {
+	int				numSilEdges;
+	silEdge_t *		silEdges;
+	idHashIndex *	silEdgeHash;
+	int				numPlanes;
+	int				c_duplicatedEdges;
+	int				c_tripledEdges;
+} silEdgeWork_t;
 
 static idBlockAlloc<srfTriangles_t, 1<<8>				srfTrianglesAllocator;
 
+// The data of every surface comes from the allocators of its region. Level
+// geometry is kept apart from the models loaded at startup, and the two level
+// regions take turns, so the leftovers of a level don't share base blocks with
+// the next one and an empty region is released in one piece.
+typedef struct {
 #ifdef USE_TRI_DATA_ALLOCATOR
-static idDynamicBlockAlloc<idDrawVert, 1<<20, 1<<10>	triVertexAllocator;
-static idDynamicBlockAlloc<glIndex_t, 1<<18, 1<<10>		triIndexAllocator;
-static idDynamicBlockAlloc<shadowCache_t, 1<<18, 1<<10>	triShadowVertexAllocator;
-static idDynamicBlockAlloc<idPlane, 1<<17, 1<<10>		triPlaneAllocator;
-static idDynamicBlockAlloc<glIndex_t, 1<<17, 1<<10>		triSilIndexAllocator;
-static idDynamicBlockAlloc<silEdge_t, 1<<17, 1<<10>		triSilEdgeAllocator;
-static idDynamicBlockAlloc<dominantTri_t, 1<<16, 1<<10>	triDominantTrisAllocator;
-static idDynamicBlockAlloc<int, 1<<16, 1<<10>			triMirroredVertAllocator;
-static idDynamicBlockAlloc<int, 1<<16, 1<<10>			triDupVertAllocator;
+	idDynamicBlockAlloc<idDrawVert, 1<<20, 1<<10>	triVertexAllocator;
+	idDynamicBlockAlloc<glIndex_t, 1<<18, 1<<10>	triIndexAllocator;
+	idDynamicBlockAlloc<shadowCache_t, 1<<18, 1<<10>	triShadowVertexAllocator;
+	idDynamicBlockAlloc<idPlane, 1<<17, 1<<10>		triPlaneAllocator;
+	idDynamicBlockAlloc<glIndex_t, 1<<17, 1<<10>	triSilIndexAllocator;
+	idDynamicBlockAlloc<silEdge_t, 1<<17, 1<<10>	triSilEdgeAllocator;
+	idDynamicBlockAlloc<dominantTri_t, 1<<16, 1<<10>	triDominantTrisAllocator;
+	idDynamicBlockAlloc<int, 1<<16, 1<<10>			triMirroredVertAllocator;
+	idDynamicBlockAlloc<int, 1<<16, 1<<10>			triDupVertAllocator;
 #else
-static idDynamicAlloc<idDrawVert, 1<<20, 1<<10>			triVertexAllocator;
-static idDynamicAlloc<glIndex_t, 1<<18, 1<<10>			triIndexAllocator;
-static idDynamicAlloc<shadowCache_t, 1<<18, 1<<10>		triShadowVertexAllocator;
-static idDynamicAlloc<idPlane, 1<<17, 1<<10>			triPlaneAllocator;
-static idDynamicAlloc<glIndex_t, 1<<17, 1<<10>			triSilIndexAllocator;
-static idDynamicAlloc<silEdge_t, 1<<17, 1<<10>			triSilEdgeAllocator;
-static idDynamicAlloc<dominantTri_t, 1<<16, 1<<10>		triDominantTrisAllocator;
-static idDynamicAlloc<int, 1<<16, 1<<10>				triMirroredVertAllocator;
-static idDynamicAlloc<int, 1<<16, 1<<10>				triDupVertAllocator;
+	idDynamicAlloc<idDrawVert, 1<<20, 1<<10>		triVertexAllocator;
+	idDynamicAlloc<glIndex_t, 1<<18, 1<<10>			triIndexAllocator;
+	idDynamicAlloc<shadowCache_t, 1<<18, 1<<10>		triShadowVertexAllocator;
+	idDynamicAlloc<idPlane, 1<<17, 1<<10>			triPlaneAllocator;
+	idDynamicAlloc<glIndex_t, 1<<17, 1<<10>			triSilIndexAllocator;
+	idDynamicAlloc<silEdge_t, 1<<17, 1<<10>			triSilEdgeAllocator;
+	idDynamicAlloc<dominantTri_t, 1<<16, 1<<10>		triDominantTrisAllocator;
+	idDynamicAlloc<int, 1<<16, 1<<10>				triMirroredVertAllocator;
+	idDynamicAlloc<int, 1<<16, 1<<10>				triDupVertAllocator;
 #endif
+} triSurfRegion_t;
+
+static triSurfRegion_t		triSurfRegions[TRI_REGION_COUNT];
+static int					currentTriSurfRegion = TRI_REGION_STATIC;
+static int					oldLevelTriSurfRegion = -1;		// region of the previous level until EndLevelLoad
+
+static const char *			triSurfRegionNames[TRI_REGION_COUNT] = { "static", "level 1", "level 2" };
+
+
+/*
+===============
+R_InitTriSurfRegion
+===============
+*/
+static void R_InitTriSurfRegion( triSurfRegion_t &region ) {
+	region.triVertexAllocator.Init();
+	region.triIndexAllocator.Init();
+	region.triShadowVertexAllocator.Init();
+	region.triPlaneAllocator.Init();
+	region.triSilIndexAllocator.Init();
+	region.triSilEdgeAllocator.Init();
+	region.triDominantTrisAllocator.Init();
+	region.triMirroredVertAllocator.Init();
+	region.triDupVertAllocator.Init();
 
+	// never swap out triangle surfaces
+	region.triVertexAllocator.SetLockMemory( true );
+	region.triIndexAllocator.SetLockMemory( true );
+	region.triShadowVertexAllocator.SetLockMemory( true );
+	region.triPlaneAllocator.SetLockMemory( true );
+	region.triSilIndexAllocator.SetLockMemory( true );
+	region.triSilEdgeAllocator.SetLockMemory( true );
+	region.triDominantTrisAllocator.SetLockMemory( true );
+	region.triMirroredVertAllocator.SetLockMemory( true );
+	region.triDupVertAllocator.SetLockMemory( true );
+}
+
+/*
+===============
+R_ShutdownTriSurfRegion
+===============
+*/
+static void R_ShutdownTriSurfRegion( triSurfRegion_t &region ) {
+	region.triVertexAllocator.Shutdown();
+	region.triIndexAllocator.Shutdown();
+	region.triShadowVertexAllocator.Shutdown();
+	region.triPlaneAllocator.Shutdown();
+	region.triSilIndexAllocator.Shutdown();
+	region.triSilEdgeAllocator.Shutdown();
+	region.triDominantTrisAllocator.Shutdown();
+	region.triMirroredVertAllocator.Shutdown();
+	region.triDupVertAllocator.Shutdown();
+}
+
+/*
+===============
+R_TriSurfRegionMemory
+
+Returns the base block memory of a region, and the part of it in use
+===============
+*/
+static int R_TriSurfRegionMemory( const triSurfRegion_t &region, int &usedMemory ) {
+	usedMemory = region.triVertexAllocator.GetUsedBlockMemory() +
+		region.triIndexAllocator.GetUsedBlockMemory() +
+		region.triShadowVertexAllocator.GetUsedBlockMemory() +
+		region.triPlaneAllocator.GetUsedBlockMemory() +
+		region.triSilIndexAllocator.GetUsedBlockMemory() +
+		region.triSilEdgeAllocator.GetUsedBlockMemory() +
+		region.triDominantTrisAllocator.GetUsedBlockMemory() +
+		region.triMirroredVertAllocator.GetUsedBlockMemory() +
+		region.triDupVertAllocator.GetUsedBlockMemory();
+
+	return region.triVertexAllocator.GetBaseBlockMemory() +
+		region.triIndexAllocator.GetBaseBlockMemory() +
+		region.triShadowVertexAllocator.GetBaseBlockMemory() +
+		region.triPlaneAllocator.GetBaseBlockMemory() +
+		region.triSilIndexAllocator.GetBaseBlockMemory() +
+		region.triSilEdgeAllocator.GetBaseBlockMemory() +
+		region.triDominantTrisAllocator.GetBaseBlockMemory() +
+		region.triMirroredVertAllocator.GetBaseBlockMemory() +
+		region.triDupVertAllocator.GetBaseBlockMemory();
+}
+
+/*
+===============
+R_TriSurfRegionIsEmpty
+===============
+*/
+static bool R_TriSurfRegionIsEmpty( const triSurfRegion_t &region ) {
+	return region.triVertexAllocator.GetNumUsedBlocks() == 0 &&
+		region.triIndexAllocator.GetNumUsedBlocks() == 0 &&
+		region.triShadowVertexAllocator.GetNumUsedBlocks() == 0 &&
+		region.triPlaneAllocator.GetNumUsedBlocks() == 0 &&
+		region.triSilIndexAllocator.GetNumUsedBlocks() == 0 &&
+		region.triSilEdgeAllocator.GetNumUsedBlocks() == 0 &&
+		region.triDominantTrisAllocator.GetNumUsedBlocks() == 0 &&
+		region.triMirroredVertAllocator.GetNumUsedBlocks() == 0 &&
+		region.triDupVertAllocator.GetNumUsedBlocks() == 0;
+}
 
 /*
 ===============
@@ -148,29 +256,12 @@ R_InitTriSurfData
 ===============
 */
 void R_InitTriSurfData( void ) {
-	silEdges = (silEdge_t *)R_StaticAlloc( MAX_SIL_EDGES * sizeof( silEdges[0] ) );
-
 	// initialize allocators for triangle surfaces
-	triVertexAllocator.Init();
-	triIndexAllocator.Init();
-	triShadowVertexAllocator.Init();
-	triPlaneAllocator.Init();
-	triSilIndexAllocator.Init();
-	triSilEdgeAllocator.Init();
-	triDominantTrisAllocator.Init();
-	triMirroredVertAllocator.Init();
-	triDupVertAllocator.Init();
-
-	// never swap out triangle surfaces
-	triVertexAllocator.SetLockMemory( true );
-	triIndexAllocator.SetLockMemory( true );
-	triShadowVertexAllocator.SetLockMemory( true );
-	triPlaneAllocator.SetLockMemory( true );
-	triSilIndexAllocator.SetLockMemory( true );
-	triSilEdgeAllocator.SetLockMemory( true );
-	triDominantTrisAllocator.SetLockMemory( true );
-	triMirroredVertAllocator.SetLockMemory( true );
-	triDupVertAllocator.SetLockMemory( true );
+	for ( int i = 0 ; i < TRI_REGION_COUNT ; i++ ) {
+		R_InitTriSurfRegion( triSurfRegions[i] );
+	}
+	currentTriSurfRegion = TRI_REGION_STATIC;
+	oldLevelTriSurfRegion = -1;
 }
 
 /*
@@ -179,18 +270,10 @@ R_ShutdownTriSurfData
 ===============
 */
 void R_ShutdownTriSurfData( void ) {
-	R_StaticFree( silEdges );
-	silEdgeHash.Free();
 	srfTrianglesAllocator.Shutdown();
-	triVertexAllocator.Shutdown();
-	triIndexAllocator.Shutdown();
-	triShadowVertexAllocator.Shutdown();
-	triPlaneAllocator.Shutdown();
-	triSilIndexAllocator.Shutdown();
-	triSilEdgeAllocator.Shutdown();
-	triDominantTrisAllocator.Shutdown();
-	triMirroredVertAllocator.Shutdown();
-	triDupVertAllocator.Shutdown();
+	for ( int i = 0 ; i < TRI_REGION_COUNT ; i++ ) {
+		R_ShutdownTriSurfRegion( triSurfRegions[i] );
+	}
 }
 
 /*
@@ -203,15 +286,63 @@ void R_PurgeTriSurfData( frameData_t *frame ) {
 	R_FreeDeferredTriSurfs( frame );
 
 	// free empty base blocks
-	triVertexAllocator.FreeEmptyBaseBlocks();
-	triIndexAllocator.FreeEmptyBaseBlocks();
-	triShadowVertexAllocator.FreeEmptyBaseBlocks();
-	triPlaneAllocator.FreeEmptyBaseBlocks();
-	triSilIndexAllocator.FreeEmptyBaseBlocks();
-	triSilEdgeAllocator.FreeEmptyBaseBlocks();
-	triDominantTrisAllocator.FreeEmptyBaseBlocks();
-	triMirroredVertAllocator.FreeEmptyBaseBlocks();
-	triDupVertAllocator.FreeEmptyBaseBlocks();
+	for ( int i = 0 ; i < TRI_REGION_COUNT ; i++ ) {
+		triSurfRegion_t &region = triSurfRegions[i];
+
+		region.triVertexAllocator.FreeEmptyBaseBlocks();
+		region.triIndexAllocator.FreeEmptyBaseBlocks();
+		region.triShadowVertexAllocator.FreeEmptyBaseBlocks();
+		region.triPlaneAllocator.FreeEmptyBaseBlocks();
+		region.triSilIndexAllocator.FreeEmptyBaseBlocks();
+		region.triSilEdgeAllocator.FreeEmptyBaseBlocks();
+		region.triDominantTrisAllocator.FreeEmptyBaseBlocks();
+		region.triMirroredVertAllocator.FreeEmptyBaseBlocks();
+		region.triDupVertAllocator.FreeEmptyBaseBlocks();
+	}
+}
+
+/*
+===============
+R_BeginLevelTriSurfRegion
+
+Called when a level load starts, the surfaces allocated from now on
+go to the level region the previous level didn't use
+===============
+*/
+void R_BeginLevelTriSurfRegion( void ) {
+	if ( currentTriSurfRegion == TRI_REGION_STATIC ) {
+		oldLevelTriSurfRegion = -1;
+		currentTriSurfRegion = TRI_REGION_LEVEL1;
+	} else {
+		oldLevelTriSurfRegion = currentTriSurfRegion;
+		currentTriSurfRegion = ( currentTriSurfRegion == TRI_REGION_LEVEL1 ) ? TRI_REGION_LEVEL2 : TRI_REGION_LEVEL1;
+	}
+}
+
+/*
+===============
+R_EndLevelTriSurfRegion
+
+Called after the models of the previous level were purged. The previous
+level region is released in one piece if nothing in it survived, models
+kept for this level still hold their blocks until they are purged.
+===============
+*/
+void R_EndLevelTriSurfRegion( void ) {
+	if ( oldLevelTriSurfRegion == -1 ) {
+		return;
+	}
+	triSurfRegion_t &region = triSurfRegions[oldLevelTriSurfRegion];
+
+	if ( R_TriSurfRegionIsEmpty( region ) ) {
+		R_ShutdownTriSurfRegion( region );
+		R_InitTriSurfRegion( region );
+	} else {
+		int usedMemory;
+		R_TriSurfRegionMemory( region, usedMemory );
+		common->Printf( "%6d kB of triangle memory kept from the previous level\n", usedMemory >> 10 );
+	}
+	oldLevelTriSurfRegion = -1;
 }
 
 /*
@@ -220,57 +351,64 @@ R_ShowTriMemory_f
 ===============
 */
 void R_ShowTriSurfMemory_f( const idCmdArgs &args ) {
+	int i, totalMemory, usedMemory;
+
 	common->Printf( "%6d kB in %d triangle surfaces\n",
 		( srfTrianglesAllocator.GetAllocCount() * sizeof( srfTriangles_t ) ) >> 10,
 			srfTrianglesAllocator.GetAllocCount() );
 
-	common->Printf( "%6d kB vertex memory (%d kB free in %d blocks, %d empty base blocks)\n",
-		triVertexAllocator.GetBaseBlockMemory() >> 10, triVertexAllocator.GetFreeBlockMemory() >> 10,
-			triVertexAllocator.GetNumFreeBlocks(), triVertexAllocator.GetNumEmptyBaseBlocks() );
-
-	common->Printf( "%6d kB index memory (%d kB free in %d blocks, %d empty base blocks)\n",
-		triIndexAllocator.GetBaseBlockMemory() >> 10, triIndexAllocator.GetFreeBlockMemory() >> 10,
-			triIndexAllocator.GetNumFreeBlocks(), triIndexAllocator.GetNumEmptyBaseBlocks() );
-
-	common->Printf( "%6d kB shadow vert memory (%d kB free in %d blocks, %d empty base blocks)\n",
-		triShadowVertexAllocator.GetBaseBlockMemory() >> 10, triShadowVertexAllocator.GetFreeBlockMemory() >> 10,
-			triShadowVertexAllocator.GetNumFreeBlocks(), triShadowVertexAllocator.GetNumEmptyBaseBlocks() );
-
-	common->Printf( "%6d kB tri plane memory (%d kB free in %d blocks, %d empty base blocks)\n",
-		triPlaneAllocator.GetBaseBlockMemory() >> 10, triPlaneAllocator.GetFreeBlockMemory() >> 10,
-			triPlaneAllocator.GetNumFreeBlocks(), triPlaneAllocator.GetNumEmptyBaseBlocks() );
-
-	common->Printf( "%6d kB sil index memory (%d kB free in %d blocks, %d empty base blocks)\n",
-		triSilIndexAllocator.GetBaseBlockMemory() >> 10, triSilIndexAllocator.GetFreeBlockMemory() >> 10,
-			triSilIndexAllocator.GetNumFreeBlocks(), triSilIndexAllocator.GetNumEmptyBaseBlocks() );
-
-	common->Printf( "%6d kB sil edge memory (%d kB free in %d blocks, %d empty base blocks)\n",
-		triSilEdgeAllocator.GetBaseBlockMemory() >> 10, triSilEdgeAllocator.GetFreeBlockMemory() >> 10,
-			triSilEdgeAllocator.GetNumFreeBlocks(), triSilEdgeAllocator.GetNumEmptyBaseBlocks() );
-
-	common->Printf( "%6d kB dominant tri memory (%d kB free in %d blocks, %d empty base blocks)\n",
-		triDominantTrisAllocator.GetBaseBlockMemory() >> 10, triDominantTrisAllocator.GetFreeBlockMemory() >> 10,
-			triDominantTrisAllocator.GetNumFreeBlocks(), triDominantTrisAllocator.GetNumEmptyBaseBlocks() );
-
-	common->Printf( "%6d kB mirror vert memory (%d kB free in %d blocks, %d empty base blocks)\n",
-		triMirroredVertAllocator.GetBaseBlockMemory() >> 10, triMirroredVertAllocator.GetFreeBlockMemory() >> 10,
-			triMirroredVertAllocator.GetNumFreeBlocks(), triMirroredVertAllocator.GetNumEmptyBaseBlocks() );
-
-	common->Printf( "%6d kB dup vert memory (%d kB free in %d blocks, %d empty base blocks)\n",
-		triDupVertAllocator.GetBaseBlockMemory() >> 10, triDupVertAllocator.GetFreeBlockMemory() >> 10,
-			triDupVertAllocator.GetNumFreeBlocks(), triDupVertAllocator.GetNumEmptyBaseBlocks() );
-
-	common->Printf( "%6d kB total triangle memory\n",
-		( srfTrianglesAllocator.GetAllocCount() * sizeof( srfTriangles_t ) +
-			triVertexAllocator.GetBaseBlockMemory() +
-			triIndexAllocator.GetBaseBlockMemory() +
-			triShadowVertexAllocator.GetBaseBlockMemory() +
-			triPlaneAllocator.GetBaseBlockMemory() +
-			triSilIndexAllocator.GetBaseBlockMemory() +
-			triSilEdgeAllocator.GetBaseBlockMemory() +
-			triDominantTrisAllocator.GetBaseBlockMemory() +
-			triMirroredVertAllocator.GetBaseBlockMemory() +
-			triDupVertAllocator.GetBaseBlockMemory() ) >> 10 );
+	totalMemory = srfTrianglesAllocator.GetAllocCount() * sizeof( srfTriangles_t );
+
+	for ( i = 0 ; i < TRI_REGION_COUNT ; i++ ) {
+		const triSurfRegion_t &region = triSurfRegions[i];
+
+		const int regionMemory = R_TriSurfRegionMemory( region, usedMemory );
+		totalMemory += regionMemory;
+
+		common->Printf( "---- %s region: %d kB, %d kB used%s ----\n", triSurfRegionNames[i], regionMemory >> 10, usedMemory >> 10,
+			( i == currentTriSurfRegion ) ? ", current" : "" );
+		if ( regionMemory == 0 ) {
+			continue;
+		}
+
+		common->Printf( "%6d kB vertex memory (%d kB free in %d blocks, %d empty base blocks)\n",
+			region.triVertexAllocator.GetBaseBlockMemory() >> 10, region.triVertexAllocator.GetFreeBlockMemory() >> 10,
+				region.triVertexAllocator.GetNumFreeBlocks(), region.triVertexAllocator.GetNumEmptyBaseBlocks() );
+
+		common->Printf( "%6d kB index memory (%d kB free in %d blocks, %d empty base blocks)\n",
+			region.triIndexAllocator.GetBaseBlockMemory() >> 10, region.triIndexAllocator.GetFreeBlockMemory() >> 10,
+				region.triIndexAllocator.GetNumFreeBlocks(), region.triIndexAllocator.GetNumEmptyBaseBlocks() );
+
+		common->Printf( "%6d kB shadow vert memory (%d kB free in %d blocks, %d empty base blocks)\n",
+			region.triShadowVertexAllocator.GetBaseBlockMemory() >> 10, region.triShadowVertexAllocator.GetFreeBlockMemory() >> 10,
+				region.triShadowVertexAllocator.GetNumFreeBlocks(), region.triShadowVertexAllocator.GetNumEmptyBaseBlocks() );
+
+		common->Printf( "%6d kB tri plane memory (%d kB free in %d blocks, %d empty base blocks)\n",
+			region.triPlaneAllocator.GetBaseBlockMemory() >> 10, region.triPlaneAllocator.GetFreeBlockMemory() >> 10,
+				region.triPlaneAllocator.GetNumFreeBlocks(), region.triPlaneAllocator.GetNumEmptyBaseBlocks() );
+
+		common->Printf( "%6d kB sil index memory (%d kB free in %d blocks, %d empty base blocks)\n",
+			region.triSilIndexAllocator.GetBaseBlockMemory() >> 10, region.triSilIndexAllocator.GetFreeBlockMemory() >> 10,
+				region.triSilIndexAllocator.GetNumFreeBlocks(), region.triSilIndexAllocator.GetNumEmptyBaseBlocks() );
+
+		common->Printf( "%6d kB sil edge memory (%d kB free in %d blocks, %d empty base blocks)\n",
+			region.triSilEdgeAllocator.GetBaseBlockMemory() >> 10, region.triSilEdgeAllocator.GetFreeBlockMemory() >> 10,
+				region.triSilEdgeAllocator.GetNumFreeBlocks(), region.triSilEdgeAllocator.GetNumEmptyBaseBlocks() );
+
+		common->Printf( "%6d kB dominant tri memory (%d kB free in %d blocks, %d empty base blocks)\n",
+			region.triDominantTrisAllocator.GetBaseBlockMemory() >> 10, region.triDominantTrisAllocator.GetFreeBlockMemory() >> 10,
+				region.triDominantTrisAllocator.GetNumFreeBlocks(), region.triDominantTrisAllocator.GetNumEmptyBaseBlocks() );
+
+		common->Printf( "%6d kB mirror vert memory (%d kB free in %d blocks, %d empty base blocks)\n",
+			region.triMirroredVertAllocator.GetBaseBlockMemory() >> 10, region.triMirroredVertAllocator.GetFreeBlockMemory() >> 10,
+				region.triMirroredVertAllocator.GetNumFreeBlocks(), region.triMirroredVertAllocator.GetNumEmptyBaseBlocks() );
+
+		common->Printf( "%6d kB dup vert memory (%d kB free in %d blocks, %d empty base blocks)\n",
+			region.triDupVertAllocator.GetBaseBlockMemory() >> 10, region.triDupVertAllocator.GetFreeBlockMemory() >> 10,
+				region.triDupVertAllocator.GetNumFreeBlocks(), region.triDupVertAllocator.GetNumEmptyBaseBlocks() );
+	}
+
+	common->Printf( "%6d kB total triangle memory\n", totalMemory >> 10 );
 }
 
 /*
@@ -334,6 +472,8 @@ R_FreeStaticTriSurfVertexCaches
 ==============
 */
 void R_FreeStaticTriSurfVertexCaches( srfTriangles_t *tri ) {
+	R_FreeDeformCache( tri );
+
 	if ( tri->ambientSurface == NULL ) {
 		// this is a real model surface
 		vertexCache.Free( tri->ambientCache );
@@ -369,12 +509,14 @@ void R_ReallyFreeStaticTriSurf( srfTriangles_t *tri ) {
 		return;
 	}
 
+	R_LockStaticAlloc();
+
 	R_FreeStaticTriSurfVertexCaches( tri );
 
 	if ( tri->verts != NULL ) {
 		// R_CreateLightTris points tri->verts at the verts of the ambient surface
 		if ( tri->ambientSurface == NULL || tri->verts != tri->ambientSurface->verts ) {
-			triVertexAllocator.Free( tri->verts );
+			triSurfRegions[tri->region].triVertexAllocator.Free( tri->verts );
 		}
 	}
 
@@ -382,32 +524,32 @@ void R_ReallyFreeStaticTriSurf( srfTriangles_t *tri ) {
 		if ( tri->indexes != NULL ) {
 			// if a surface is completely inside a light volume R_CreateLightTris points tri->indexes at the indexes of the ambient surface
 			if ( tri->ambientSurface == NULL || tri->indexes != tri->ambientSurface->indexes ) {
-				triIndexAllocator.Free( tri->indexes );
+				triSurfRegions[tri->region].triIndexAllocator.Free( tri->indexes );
 			}
 		}
 		if ( tri->silIndexes != NULL ) {
-			triSilIndexAllocator.Free( tri->silIndexes );
+			triSurfRegions[tri->region].triSilIndexAllocator.Free( tri->silIndexes );
 		}
 		if ( tri->silEdges != NULL ) {
-			triSilEdgeAllocator.Free( tri->silEdges );
+			triSurfRegions[tri->region].triSilEdgeAllocator.Free( tri->silEdges );
 		}
 		if ( tri->dominantTris != NULL ) {
-			triDominantTrisAllocator.Free( tri->dominantTris );
+			triSurfRegions[tri->region].triDominantTrisAllocator.Free( tri->dominantTris );
 		}
 		if ( tri->mirroredVerts != NULL ) {
-			triMirroredVertAllocator.Free( tri->mirroredVerts );
+			triSurfRegions[tri->region].triMirroredVertAllocator.Free( tri->mirroredVerts );
 		}
 		if ( tri->dupVerts != NULL ) {
-			triDupVertAllocator.Free( tri->dupVerts );
+			triSurfRegions[tri->region].triDupVertAllocator.Free( tri->dupVerts );
 		}
 	}
 
 	if ( tri->facePlanes != NULL ) {
-		triPlaneAllocator.Free( tri->facePlanes );
+		triSurfRegions[tri->region].triPlaneAllocator.Free( tri->facePlanes );
 	}
 
 	if ( tri->shadowVertexes != NULL ) {
-		triShadowVertexAllocator.Free( tri->shadowVertexes );
+		triSurfRegions[tri->region].triShadowVertexAllocator.Free( tri->shadowVertexes );
 	}
 
 #ifdef _DEBUG
@@ -415,6 +557,8 @@ void R_ReallyFreeStaticTriSurf( srfTriangles_t *tri ) {
 #endif
 
 	srfTrianglesAllocator.Free( tri );
+
+	R_UnlockStaticAlloc();
 }
 
 /*
@@ -430,7 +574,7 @@ void R_CheckStaticTriSurfMemory( const srfTriangles_t *tri ) {
 	if ( tri->verts != NULL ) {
 		// R_CreateLightTris points tri->verts at the verts of the ambient surface
 		if ( tri->ambientSurface == NULL || tri->verts != tri->ambientSurface->verts ) {
-			const char *error = triVertexAllocator.CheckMemory( tri->verts );
+			const char *error = triSurfRegions[tri->region].triVertexAllocator.CheckMemory( tri->verts );
 			assert( error == NULL );
 		}
 	}
@@ -439,14 +583,14 @@ void R_CheckStaticTriSurfMemory( const srfTriangles_t *tri ) {
 		if ( tri->indexes != NULL ) {
 			// if a surface is completely inside a light volume R_CreateLightTris points tri->indexes at the indexes of the ambient surface
 			if ( tri->ambientSurface == NULL || tri->indexes != tri->ambientSurface->indexes ) {
-				const char *error = triIndexAllocator.CheckMemory( tri->indexes );
+				const char *error = triSurfRegions[tri->region].triIndexAllocator.CheckMemory( tri->indexes );
 				assert( error == NULL );
 			}
 		}
 	}
 
 	if ( tri->shadowVertexes != NULL ) {
-		const char *error = triShadowVertexAllocator.CheckMemory( tri->shadowVertexes );
+		const char *error = triSurfRegions[tri->region].triShadowVertexAllocator.CheckMemory( tri->shadowVertexes );
 		assert( error == NULL );
 	}
 }
@@ -514,8 +658,11 @@ R_AllocStaticTriSurf
 ==============
 */
 srfTriangles_t *R_AllocStaticTriSurf( void ) {
+	R_LockStaticAlloc();
 	srfTriangles_t *tris = srfTrianglesAllocator.Alloc();
+	R_UnlockStaticAlloc();
 	memset( tris, 0, sizeof( srfTriangles_t ) );
+	tris->region = currentTriSurfRegion;
 	return tris;
 }
 
@@ -547,7 +694,9 @@ R_AllocStaticTriSurfVerts
 */
 void R_AllocStaticTriSurfVerts( srfTriangles_t *tri, int numVerts ) {
 	assert( tri->verts == NULL );
-	tri->verts = triVertexAllocator.Alloc( numVerts );
+	R_LockStaticAlloc();
+	tri->verts = triSurfRegions[tri->region].triVertexAllocator.Alloc( numVerts );
+	R_UnlockStaticAlloc();
 }
 
 /*
@@ -557,7 +706,9 @@ R_AllocStaticTriSurfIndexes
 */
 void R_AllocStaticTriSurfIndexes( srfTriangles_t *tri, int numIndexes ) {
 	assert( tri->indexes == NULL );
-	tri->indexes = triIndexAllocator.Alloc( numIndexes );
+	R_LockStaticAlloc();
+	tri->indexes = triSurfRegions[tri->region].triIndexAllocator.Alloc( numIndexes );
+	R_UnlockStaticAlloc();
 }
 
 /*
@@ -567,7 +718,9 @@ R_AllocStaticTriSurfShadowVerts
 */
 void R_AllocStaticTriSurfShadowVerts( srfTriangles_t *tri, int numVerts ) {
 	assert( tri->shadowVertexes == NULL );
-	tri->shadowVertexes = triShadowVertexAllocator.Alloc( numVerts );
+	R_LockStaticAlloc();
+	tri->shadowVertexes = triSurfRegions[tri->region].triShadowVertexAllocator.Alloc( numVerts );
+	R_UnlockStaticAlloc();
 }
 
 /*
@@ -576,10 +729,12 @@ R_AllocStaticTriSurfPlanes
 =================
 */
 void R_AllocStaticTriSurfPlanes( srfTriangles_t *tri, int numIndexes ) {
+	R_LockStaticAlloc();
 	if ( tri->facePlanes ) {
-		triPlaneAllocator.Free( tri->facePlanes );
+		triSurfRegions[tri->region].triPlaneAllocator.Free( tri->facePlanes );
 	}
-	tri->facePlanes = triPlaneAllocator.Alloc( numIndexes / 3 );
+	tri->facePlanes = triSurfRegions[tri->region].triPlaneAllocator.Alloc( numIndexes / 3 );
+	R_UnlockStaticAlloc();
 }
 
 /*
@@ -589,7 +744,9 @@ R_ResizeStaticTriSurfVerts
 */
 void R_ResizeStaticTriSurfVerts( srfTriangles_t *tri, int numVerts ) {
 #ifdef USE_TRI_DATA_ALLOCATOR
-	tri->verts = triVertexAllocator.Resize( tri->verts, numVerts );
+	R_LockStaticAlloc();
+	tri->verts = triSurfRegions[tri->region].triVertexAllocator.Resize( tri->verts, numVerts );
+	R_UnlockStaticAlloc();
 #else
 	assert( false );
 #endif
@@ -602,7 +759,9 @@ R_ResizeStaticTriSurfIndexes
 */
 void R_ResizeStaticTriSurfIndexes( srfTriangles_t *tri, int numIndexes ) {
 #ifdef USE_TRI_DATA_ALLOCATOR
-	tri->indexes = triIndexAllocator.Resize( tri->indexes, numIndexes );
+	R_LockStaticAlloc();
+	tri->indexes = triSurfRegions[tri->region].triIndexAllocator.Resize( tri->indexes, numIndexes );
+	R_UnlockStaticAlloc();
 #else
 	assert( false );
 #endif
@@ -615,7 +774,9 @@ R_ResizeStaticTriSurfShadowVerts
 */
 void R_ResizeStaticTriSurfShadowVerts( srfTriangles_t *tri, int numVerts ) {
 #ifdef USE_TRI_DATA_ALLOCATOR
-	tri->shadowVertexes = triShadowVertexAllocator.Resize( tri->shadowVertexes, numVerts );
+	R_LockStaticAlloc();
+	tri->shadowVertexes = triSurfRegions[tri->region].triShadowVertexAllocator.Resize( tri->shadowVertexes, numVerts );
+	R_UnlockStaticAlloc();
 #else
 	assert( false );
 #endif
@@ -645,7 +806,9 @@ R_FreeStaticTriSurfSilIndexes
 =================
 */
 void R_FreeStaticTriSurfSilIndexes( srfTriangles_t *tri ) {
-	triSilIndexAllocator.Free( tri->silIndexes );
+	R_LockStaticAlloc();
+	triSurfRegions[tri->region].triSilIndexAllocator.Free( tri->silIndexes );
+	R_UnlockStaticAlloc();
 	tri->silIndexes = NULL;
 }
 
@@ -718,7 +881,8 @@ static int *R_CreateSilRemap( const srfTriangles_t *tri ) {
 		return remap;
 	}
 
-	idHashIndex		hash( 1024, tri->numVerts );
+	// a fixed 1024 bucket hash degenerates into long chains on detailed models
+	idHashIndex		hash( idMath::ClampInt( 1024, 1 << 16, idMath::CeilPowerOfTwo( tri->numVerts ) ), tri->numVerts );
 
 	c_removed = 0;
 	c_unique = 0;
@@ -760,14 +924,15 @@ void R_CreateSilIndexes( srfTriangles_t *tri ) {
 	int		*remap;
 
 	if ( tri->silIndexes ) {
-		triSilIndexAllocator.Free( tri->silIndexes );
-		tri->silIndexes = NULL;
+		R_FreeStaticTriSurfSilIndexes( tri );
 	}
 
 	remap = R_CreateSilRemap( tri );
 
 	// remap indexes to the first one
-	tri->silIndexes = triSilIndexAllocator.Alloc( tri->numIndexes );
+	R_LockStaticAlloc();
+	tri->silIndexes = triSurfRegions[tri->region].triSilIndexAllocator.Alloc( tri->numIndexes );
+	R_UnlockStaticAlloc();
 	for ( i = 0; i < tri->numIndexes; i++ ) {
 		tri->silIndexes[i] = remap[tri->indexes[i]];
 	}
@@ -806,7 +971,9 @@ void R_CreateDupVerts( srfTriangles_t *tri ) {
 		}
 	}
 
-	tri->dupVerts = triDupVertAllocator.Alloc( tri->numDupVerts * 2 );
+	R_LockStaticAlloc();
+	tri->dupVerts = triSurfRegions[tri->region].triDupVertAllocator.Alloc( tri->numDupVerts * 2 );
+	R_UnlockStaticAlloc();
 	memcpy( tri->dupVerts, tempDupVerts, tri->numDupVerts * 2 * sizeof( tri->dupVerts[0] ) );
 }
 
@@ -915,26 +1082,25 @@ void R_CreateVertexNormals( srfTriangles_t *tri ) {
 R_DefineEdge
 ===============
 */
-static int c_duplicatedEdges, c_tripledEdges;
-
-static void R_DefineEdge( int v1, int v2, int planeNum ) {
-	int		i, hashKey;
+static void R_DefineEdge( silEdgeWork_t &work, int v1, int v2, int planeNum ) {
+	silEdge_t *	silEdges = work.silEdges;
+	int			i, hashKey;
 
 	// check for degenerate edge
 	if ( v1 == v2 ) {
 		return;
 	}
-	hashKey = silEdgeHash.GenerateKey( v1, v2 );
+	hashKey = work.silEdgeHash->GenerateKey( v1, v2 );
 	// search for a matching other side
-	for ( i = silEdgeHash.First( hashKey ); i >= 0 && i < MAX_SIL_EDGES; i = silEdgeHash.Next( i ) ) {
+	for ( i = work.silEdgeHash->First( hashKey ); i >= 0 && i < MAX_SIL_EDGES; i = work.silEdgeHash->Next( i ) ) {
 		if ( silEdges[i].v1 == v1 && silEdges[i].v2 == v2 ) {
-			c_duplicatedEdges++;
+			work.c_duplicatedEdges++;
 			// allow it to still create a new edge
 			continue;
 		}
 		if ( silEdges[i].v2 == v1 && silEdges[i].v1 == v2 ) {
-			if ( silEdges[i].p2 != numPlanes )  {
-				c_tripledEdges++;
+			if ( silEdges[i].p2 != work.numPlanes )  {
+				work.c_tripledEdges++;
 				// allow it to still create a new edge
 				continue;
 			}
@@ -946,19 +1112,19 @@ static void R_DefineEdge( int v1, int v2, int planeNum ) {
 	}
 
 	// define the new edge
-	if ( numSilEdges == MAX_SIL_EDGES ) {
+	if ( work.numSilEdges == MAX_SIL_EDGES ) {
 		common->DWarning( "MAX_SIL_EDGES" );
 		return;
 	}
 	
-	silEdgeHash.Add( hashKey, numSilEdges );
+	work.silEdgeHash->Add( hashKey, work.numSilEdges );
 
-	silEdges[numSilEdges].p1 = planeNum;
-	silEdges[numSilEdges].p2 = numPlanes;
-	silEdges[numSilEdges].v1 = v1;
-	silEdges[numSilEdges].v2 = v2;
+	silEdges[work.numSilEdges].p1 = planeNum;
+	silEdges[work.numSilEdges].p2 = work.numPlanes;
+	silEdges[work.numSilEdges].v1 = v1;
+	silEdges[work.numSilEdges].v2 = v2;
 
-	numSilEdges++;
+	work.numSilEdges++;
 }
 
 /*
@@ -994,20 +1160,27 @@ int	c_coplanarSilEdges;
 int	c_totalSilEdges;
 
 void R_IdentifySilEdges( srfTriangles_t *tri, bool omitCoplanarEdges ) {
-	int		i;
-	int		numTris;
-	int		shared, single;
+	int				i;
+	int				numTris;
+	int				shared, single;
+	silEdgeWork_t	work;
 
 	omitCoplanarEdges = false;	// optimization doesn't work for some reason
 
 	numTris = tri->numIndexes / 3;
 
-	numSilEdges = 0;
-	silEdgeHash.Clear();
-	numPlanes = numTris;
+	// every triangle defines at most three edges
+	const int maxSilEdges = Min( Max( tri->numIndexes, 1 ), MAX_SIL_EDGES );
+
+	idHashIndex silEdgeHash( idMath::ClampInt( SILEDGE_HASH_SIZE, 1 << 16, idMath::CeilPowerOfTwo( maxSilEdges ) ), maxSilEdges );
+
+	work.numSilEdges = 0;
+	work.silEdges = (silEdge_t *)R_StaticAlloc( maxSilEdges * sizeof( work.silEdges[0] ) );
+	work.silEdgeHash = &silEdgeHash;
+	work.numPlanes = numTris;
 
-	c_duplicatedEdges = 0;
-	c_tripledEdges = 0;
+	work.c_duplicatedEdges = 0;
+	work.c_tripledEdges = 0;
 
 	for ( i = 0 ; i < numTris ; i++ ) {
 		int		i1, i2, i3;
@@ -1017,15 +1190,19 @@ void R_IdentifySilEdges( srfTriangles_t *tri, bool omitCoplanarEdges ) {
 		i3 = tri->silIndexes[ i*3 + 2 ];
 
 		// create the edges
-		R_DefineEdge( i1, i2, i );
-		R_DefineEdge( i2, i3, i );
-		R_DefineEdge( i3, i1, i );
+		R_DefineEdge( work, i1, i2, i );
+		R_DefineEdge( work, i2, i3, i );
+		R_DefineEdge( work, i3, i1, i );
 	}
 
-	if ( c_duplicatedEdges || c_tripledEdges ) {
-		common->DWarning( "%i duplicated edge directions, %i tripled edges", c_duplicatedEdges, c_tripledEdges );
+	if ( work.c_duplicatedEdges || work.c_tripledEdges ) {
+		common->DWarning( "%i duplicated edge directions, %i tripled edges", work.c_duplicatedEdges, work.c_tripledEdges );
 	}
 
+	silEdge_t *	silEdges = work.silEdges;
+	int			numSilEdges = work.numSilEdges;
+	const int	numPlanes = work.numPlanes;
+
 	// if we know that the vertexes aren't going
 	// to deform, we can remove interior triangulation edges
 	// on otherwise planar polygons.
@@ -1074,12 +1251,13 @@ void R_IdentifySilEdges( srfTriangles_t *tri, bool omitCoplanarEdges ) {
 			}
 		}
 		if ( c_coplanarCulled ) {
+			R_LockStaticAlloc();
 			c_coplanarSilEdges += c_coplanarCulled;
+			R_UnlockStaticAlloc();
 //			common->Printf( "%i of %i sil edges coplanar culled\n", c_coplanarCulled,
 //				c_coplanarCulled + numSilEdges );
 		}
 	}
-	c_totalSilEdges += numSilEdges;
 
 	// sort the sil edges based on plane number
 	qsort( silEdges, numSilEdges, sizeof( silEdges[0] ), SilEdgeSort );
@@ -1105,8 +1283,13 @@ void R_IdentifySilEdges( srfTriangles_t *tri, bool omitCoplanarEdges ) {
 	}
 
 	tri->numSilEdges = numSilEdges;
-	tri->silEdges = triSilEdgeAllocator.Alloc( numSilEdges );
+	R_LockStaticAlloc();
+	c_totalSilEdges += numSilEdges;
+	tri->silEdges = triSurfRegions[tri->region].triSilEdgeAllocator.Alloc( numSilEdges );
+	R_UnlockStaticAlloc();
 	memcpy( tri->silEdges, silEdges, numSilEdges * sizeof( tri->silEdges[0] ) );
+
+	R_StaticFree( silEdges );
 }
 
 /*
@@ -1297,15 +1480,19 @@ static void	R_DuplicateMirroredVertexes( srfTriangles_t *tri ) {
 		return;
 	}
 
-	tri->mirroredVerts = triMirroredVertAllocator.Alloc( tri->numMirroredVerts );
+	R_LockStaticAlloc();
+	tri->mirroredVerts = triSurfRegions[tri->region].triMirroredVertAllocator.Alloc( tri->numMirroredVerts );
+	R_UnlockStaticAlloc();
 
 #ifdef USE_TRI_DATA_ALLOCATOR
-	tri->verts = triVertexAllocator.Resize( tri->verts, totalVerts );
+	R_ResizeStaticTriSurfVerts( tri, totalVerts );
 #else
 	idDrawVert *oldVerts = tri->verts;
 	R_AllocStaticTriSurfVerts( tri, totalVerts );
 	memcpy( tri->verts, oldVerts, tri->numVerts * sizeof( tri->verts[0] ) );
-	triVertexAllocator.Free( oldVerts );
+	R_LockStaticAlloc();
+	triSurfRegions[tri->region].triVertexAllocator.Free( oldVerts );
+	R_UnlockStaticAlloc();
 #endif
 
 	// create the duplicates
@@ -1471,7 +1658,9 @@ void R_BuildDominantTris( srfTriangles_t *tri ) {
 	}
 	qsort( ind, tri->numIndexes, sizeof( *ind ), IndexSort );
 
-	tri->dominantTris = dt = triDominantTrisAllocator.Alloc( tri->numVerts );
+	R_LockStaticAlloc();
+	tri->dominantTris = dt = triSurfRegions[tri->region].triDominantTrisAllocator.Alloc( tri->numVerts );
+	R_UnlockStaticAlloc();
 	memset( dt, 0, tri->numVerts * sizeof( dt[0] ) );
 
 	for ( i = 0; i < tri->numIndexes; i += j ) {
@@ -2124,6 +2313,174 @@ void R_CleanupTriangles( srfTriangles_t *tri, bool createNormals, bool identifyS
 	}
 }
 
+/*
+=================
+R_WriteCleanedTriSurf
+
+Writes a surface after R_CleanupTriangles with everything it derived,
+so the model cache can restore it without cleaning it up again.
+The bounds are not written, models expand them for deforms.
+=================
+*/
+void R_WriteCleanedTriSurf( idFile *f, const srfTriangles_t *tri ) {
+	f->WriteBool( tri->generateNormals );
+	f->WriteBool( tri->tangentsCalculated );
+	f->WriteBool( tri->facePlanesCalculated );
+	f->WriteBool( tri->perfectHull );
+
+	f->WriteInt( tri->numVerts );
+	f->Write( tri->verts, tri->numVerts * sizeof( tri->verts[0] ) );
+
+	f->WriteInt( tri->numIndexes );
+	f->Write( tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ) );
+
+	f->WriteBool( tri->silIndexes != NULL );
+	if ( tri->silIndexes ) {
+		f->Write( tri->silIndexes, tri->numIndexes * sizeof( tri->silIndexes[0] ) );
+	}
+
+	f->WriteInt( tri->mirroredVerts ? tri->numMirroredVerts : 0 );
+	if ( tri->mirroredVerts ) {
+		f->Write( tri->mirroredVerts, tri->numMirroredVerts * sizeof( tri->mirroredVerts[0] ) );
+	}
+
+	f->WriteInt( tri->dupVerts ? tri->numDupVerts : 0 );
+	if ( tri->dupVerts ) {
+		f->Write( tri->dupVerts, tri->numDupVerts * 2 * sizeof( tri->dupVerts[0] ) );
+	}
+
+	f->WriteInt( tri->silEdges ? tri->numSilEdges : 0 );
+	if ( tri->silEdges ) {
+		f->Write( tri->silEdges, tri->numSilEdges * sizeof( tri->silEdges[0] ) );
+	}
+
+	f->WriteBool( tri->facePlanes != NULL );
+	if ( tri->facePlanes ) {
+		f->Write( tri->facePlanes, tri->numIndexes / 3 * sizeof( tri->facePlanes[0] ) );
+	}
+
+	f->WriteBool( tri->dominantTris != NULL );
+	if ( tri->dominantTris ) {
+		f->Write( tri->dominantTris, tri->numVerts * sizeof( tri->dominantTris[0] ) );
+	}
+}
+
+/*
+=================
+R_ReadCleanedTriSurf
+
+Reads a surface written by R_WriteCleanedTriSurf, returns NULL if the file is damaged
+=================
+*/
+srfTriangles_t *R_ReadCleanedTriSurf( idFile *f ) {
+	srfTriangles_t *tri = R_AllocStaticTriSurf();
+	bool	hasData;
+	int		count;
+	bool	ok = true;
+
+	f->ReadBool( tri->generateNormals );
+	f->ReadBool( tri->tangentsCalculated );
+	f->ReadBool( tri->facePlanesCalculated );
+	f->ReadBool( tri->perfectHull );
+
+	// every read below is checked against the count, a damaged
+	// file must not leave the arrays partially allocated
+	if ( f->ReadInt( count ) != sizeof( count ) || count < 0 || count > ( 1 << 24 ) ) {
+		R_FreeStaticTriSurf( tri );
+		return NULL;
+	}
+	tri->numVerts = count;
+	R_AllocStaticTriSurfVerts( tri, tri->numVerts );
+	ok &= f->Read( tri->verts, tri->numVerts * sizeof( tri->verts[0] ) ) == (int)( tri->numVerts * sizeof( tri->verts[0] ) );
+
+	if ( !ok || f->ReadInt( count ) != sizeof( count ) || count < 0 || count > ( 1 << 24 ) || count % 3 != 0 ) {
+		R_FreeStaticTriSurf( tri );
+		return NULL;
+	}
+	tri->numIndexes = count;
+	R_AllocStaticTriSurfIndexes( tri, tri->numIndexes );
+	ok &= f->Read( tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ) ) == (int)( tri->numIndexes * sizeof( tri->indexes[0] ) );
+
+	hasData = false;
+	f->ReadBool( hasData );
+	if ( ok && hasData ) {
+		R_LockStaticAlloc();
+		tri->silIndexes = triSurfRegions[tri->region].triSilIndexAllocator.Alloc( tri->numIndexes );
+		R_UnlockStaticAlloc();
+		ok &= f->Read( tri->silIndexes, tri->numIndexes * sizeof( tri->silIndexes[0] ) ) == (int)( tri->numIndexes * sizeof( tri->silIndexes[0] ) );
+	}
+
+	count = -1;
+	f->ReadInt( count );
+	if ( ok && count > 0 && count <= tri->numVerts ) {
+		tri->numMirroredVerts = count;
+		R_LockStaticAlloc();
+		tri->mirroredVerts = triSurfRegions[tri->region].triMirroredVertAllocator.Alloc( tri->numMirroredVerts );
+		R_UnlockStaticAlloc();
+		ok &= f->Read( tri->mirroredVerts, tri->numMirroredVerts * sizeof( tri->mirroredVerts[0] ) ) == (int)( tri->numMirroredVerts * sizeof( tri->mirroredVerts[0] ) );
+	} else {
+		ok &= ( count == 0 );
+	}
+
+	count = -1;
+	f->ReadInt( count );
+	if ( ok && count >= 0 && count <= tri->numVerts ) {
+		// allocated even when empty, like R_CreateDupVerts
+		tri->numDupVerts = count;
+		R_LockStaticAlloc();
+		tri->dupVerts = triSurfRegions[tri->region].triDupVertAllocator.Alloc( tri->numDupVerts * 2 );
+		R_UnlockStaticAlloc();
+		ok &= f->Read( tri->dupVerts, tri->numDupVerts * 2 * sizeof( tri->dupVerts[0] ) ) == (int)( tri->numDupVerts * 2 * sizeof( tri->dupVerts[0] ) );
+	} else {
+		ok = false;
+	}
+
+	count = -1;
+	f->ReadInt( count );
+	if ( ok && count >= 0 && count <= tri->numIndexes ) {
+		tri->numSilEdges = count;
+		R_LockStaticAlloc();
+		tri->silEdges = triSurfRegions[tri->region].triSilEdgeAllocator.Alloc( tri->numSilEdges );
+		R_UnlockStaticAlloc();
+		ok &= f->Read( tri->silEdges, tri->numSilEdges * sizeof( tri->silEdges[0] ) ) == (int)( tri->numSilEdges * sizeof( tri->silEdges[0] ) );
+	} else {
+		ok = false;
+	}
+
+	hasData = false;
+	f->ReadBool( hasData );
+	if ( ok && hasData ) {
+		R_AllocStaticTriSurfPlanes( tri, tri->numIndexes );
+		ok &= f->Read( tri->facePlanes, tri->numIndexes / 3 * sizeof( tri->facePlanes[0] ) ) == (int)( tri->numIndexes / 3 * sizeof( tri->facePlanes[0] ) );
+	}
+
+	hasData = false;
+	f->ReadBool( hasData );
+	if ( ok && hasData ) {
+		R_LockStaticAlloc();
+		tri->dominantTris = triSurfRegions[tri->region].triDominantTrisAllocator.Alloc( tri->numVerts );
+		R_UnlockStaticAlloc();
+		ok &= f->Read( tri->dominantTris, tri->numVerts * sizeof( tri->dominantTris[0] ) ) == (int)( tri->numVerts * sizeof( tri->dominantTris[0] ) );
+	}
+
+	if ( !ok ) {
+		R_FreeStaticTriSurf( tri );
+		return NULL;
+	}
+
+	// the indexes are used without any further checks
+	for ( int i = 0 ; i < tri->numIndexes ; i++ ) {
+		if ( tri->indexes[i] < 0 || tri->indexes[i] >= tri->numVerts ) {
+			R_FreeStaticTriSurf( tri );
+			return NULL;
+		}
+	}
+
+	R_BoundTriSurf( tri );
+
+	return tri;
+}
+
 /*
 ===================================================================================
 
@@ -2143,6 +2500,7 @@ deformInfo_t *R_BuildDeformInfo( int numVerts, const idDrawVert *verts, int numI
 	int				i;
 
 	memset( &tri, 0, sizeof( tri ) );
+	tri.region = currentTriSurfRegion;
 
 	tri.numVerts = numVerts;
 	R_AllocStaticTriSurfVerts( &tri, tri.numVerts );
@@ -2177,6 +2535,8 @@ deformInfo_t *R_BuildDeformInfo( int numVerts, const idDrawVert *verts, int numI
 
 	deform = (deformInfo_t *)R_ClearedStaticAlloc( sizeof( *deform ) );
 
+	deform->region = tri.region;
+
 	deform->numSourceVerts = numVerts;
 	deform->numOutputVerts = tri.numVerts;
 
@@ -2197,11 +2557,11 @@ deformInfo_t *R_BuildDeformInfo( int numVerts, const idDrawVert *verts, int numI
 	deform->dupVerts = tri.dupVerts;
 
 	if ( tri.verts ) {
-		triVertexAllocator.Free( tri.verts );
+		triSurfRegions[tri.region].triVertexAllocator.Free( tri.verts );
 	}
 
 	if ( tri.facePlanes ) {
-		triPlaneAllocator.Free( tri.facePlanes );
+		triSurfRegions[tri.region].triPlaneAllocator.Free( tri.facePlanes );
 	}
 
 	return deform;
@@ -2214,22 +2574,22 @@ R_FreeDeformInfo
 */
 void R_FreeDeformInfo( deformInfo_t *deformInfo ) {
 	if ( deformInfo->indexes != NULL ) {
-		triIndexAllocator.Free( deformInfo->indexes );
+		triSurfRegions[deformInfo->region].triIndexAllocator.Free( deformInfo->indexes );
 	}
 	if ( deformInfo->silIndexes != NULL ) {
-		triSilIndexAllocator.Free( deformInfo->silIndexes );
+		triSurfRegions[deformInfo->region].triSilIndexAllocator.Free( deformInfo->silIndexes );
 	}
 	if ( deformInfo->silEdges != NULL ) {
-		triSilEdgeAllocator.Free( deformInfo->silEdges );
+		triSurfRegions[deformInfo->region].triSilEdgeAllocator.Free( deformInfo->silEdges );
 	}
 	if ( deformInfo->dominantTris != NULL ) {
-		triDominantTrisAllocator.Free( deformInfo->dominantTris );
+		triSurfRegions[deformInfo->region].triDominantTrisAllocator.Free( deformInfo->dominantTris );
 	}
 	if ( deformInfo->mirroredVerts != NULL ) {
-		triMirroredVertAllocator.Free( deformInfo->mirroredVerts );
+		triSurfRegions[deformInfo->region].triMirroredVertAllocator.Free( deformInfo->mirroredVerts );
 	}
 	if ( deformInfo->dupVerts != NULL ) {
-		triDupVertAllocator.Free( deformInfo->dupVerts );
+		triSurfRegions[deformInfo->region].triDupVertAllocator.Free( deformInfo->dupVerts );
 	}
 	R_StaticFree( deformInfo );
 }
@@ -83,15 +83,25 @@ idSoundSample *idSoundCache::FindSound( const idStr& filename, bool loadOnDemand
 	fname.BackSlashesToSlashes();
 	fname.ToLower();
 
+	idLoadProfileScope profile( "sound", fname.c_str() );
+
 	declManager->MediaPrint( "%s\n", fname.c_str() );
 
 	// check to see if object is already in cache
 	for( int i = 0; i < listCache.Num(); i++ ) {
 		idSoundSample *def = listCache[i];
 		if ( def && def->name == fname ) {
+			if ( insideLevelLoad && !def->levelLoadReferenced ) {
+				if ( !def->purged ) {
+					residency.AddHit( def->residencyLevel );
+				} else if ( !loadOnDemandOnly ) {
+					residency.AddLoads( 1 );
+				}
+				def->residencyLevel = residency.GetLevel();
+			}
 			def->levelLoadReferenced = true;
 			if ( def->purged && !loadOnDemandOnly ) {
-				def->Load();
+				def->Load( insideLevelLoad && idSoundSystemLocal::s_parallelDecode.GetBool() );
 			}
 			return def;
 		}
@@ -109,12 +119,17 @@ idSoundSample *idSoundCache::FindSound( const idStr& filename, bool loadOnDemand
 
 	def->name = fname;
 	def->levelLoadReferenced = true;
+	def->residencyLevel = residency.GetLevel();
 	def->onDemand = loadOnDemandOnly;
 	def->purged = true;
 
+	if ( insideLevelLoad && !loadOnDemandOnly ) {
+		residency.AddLoads( 1 );
+	}
+
 	if ( !loadOnDemandOnly ) {
 		// this may make it a default sound if it can't be loaded
-		def->Load();
+		def->Load( insideLevelLoad && idSoundSystemLocal::s_parallelDecode.GetBool() );
 	}
 
 	return def;
@@ -151,6 +166,8 @@ loading the actual data.
 void idSoundCache::BeginLevelLoad() {
 	insideLevelLoad = true;
 
+	residency.BeginLevelLoad();
+
 	for ( int i = 0 ; i < listCache.Num() ; i++ ) {
 		idSoundSample *sample = listCache[ i ];
 		if ( !sample ) {
@@ -180,7 +197,7 @@ void idSoundCache::EndLevelLoad() {
 
 	insideLevelLoad = false;
 
-	// purge the ones we don't need
+	// purge the ones we don't need, the ones of earlier levels go to the residency
 	useCount = 0;
 	purgeCount = 0;
 	for ( int i = 0 ; i < listCache.Num() ; i++ ) {
@@ -192,6 +209,10 @@ void idSoundCache::EndLevelLoad() {
 			continue;
 		}
 		if ( !sample->levelLoadReferenced ) {
+			if ( !com_purgeAll.GetBool() ) {
+				residency.AddCandidate( i, sample->objectMemSize, sample->residencyLevel );
+				continue;
+			}
 //			common->Printf( "Purging %s\n", sample->name.c_str() );
 			purgeCount += sample->objectMemSize;
 			sample->PurgeSoundSample();
@@ -200,13 +221,96 @@ void idSoundCache::EndLevelLoad() {
 		}
 	}
 
+	idList<int> evictions;
+	residency.SelectEvictions( idSoundSystemLocal::s_residencyMegs.GetFloat(), evictions );
+	for ( int i = 0 ; i < evictions.Num() ; i++ ) {
+		idSoundSample *sample = listCache[ evictions[ i ] ];
+		purgeCount += sample->objectMemSize;
+		sample->PurgeSoundSample();
+	}
+
+	DecodePendingSamples();
+
 	soundCacheAllocator.FreeEmptyBaseBlocks();
 
 	common->Printf( "%5ik referenced\n", useCount / 1024 );
 	common->Printf( "%5ik purged\n", purgeCount / 1024 );
+	residency.Print( "sounds" );
 	common->Printf( "----------------------------------------\n" );
 }
 
+/*
+====================
+idSoundCache::DecodePendingSamples
+
+Decompresses the OGGs loaded into hardware buffers during the level load on
+worker threads, as many at once as the decoder memory allows
+====================
+*/
+void idSoundCache::DecodePendingSamples() {
+	idList<idSoundSample *> samples;
+	idList<idSampleDecoder *> decoders;
+	idList<float *> destData;
+
+	for ( int i = 0; i < listCache.Num(); i++ ) {
+		idSoundSample *sample = listCache[i];
+		if ( sample && sample->decodePending ) {
+			samples.Append( sample );
+		}
+	}
+
+	if ( samples.Num() == 0 ) {
+		return;
+	}
+
+	int first = 0;
+	while ( first < samples.Num() ) {
+		int numBatch = Min( Max( idSampleDecoder::GetNumFreeOggDecoders(), 1 ), samples.Num() - first );
+
+		decoders.SetNum( numBatch, false );
+		destData.SetNum( numBatch, false );
+		for ( int i = 0; i < numBatch; i++ ) {
+			decoders[i] = idSampleDecoder::Alloc();
+			destData[i] = (float *)soundCacheAllocator.Alloc( ( samples[first + i]->LengthIn44kHzSamples() + 1 ) * sizeof( float ) );
+		}
+
+		idSampleDecoder::BeginParallelDecode();
+
+		#pragma omp parallel for schedule( dynamic )
+		for ( int i = 0; i < numBatch; i++ ) {
+			idSoundSample *sample = samples[first + i];
+
+			// Decoder *always* outputs 44 kHz data
+			decoders[i]->DecodeLocked( sample, 0, sample->LengthIn44kHzSamples(), destData[i] );
+
+			// close the OGG right away, so the memory is free for the next one
+			decoders[i]->ClearDecoderLocked();
+		}
+
+		idSampleDecoder::EndParallelDecode();
+
+		for ( int i = 0; i < numBatch; i++ ) {
+			idSoundSample *sample = samples[first + i];
+
+			sample->decodePending = false;
+			sample->LoadDecodedOGG( destData[i] );
+
+			// Free memory if sample was loaded into hardware
+			if ( sample->hardwareBuffer ) {
+				soundCacheAllocator.Free( sample->nonCacheData );
+				sample->nonCacheData = NULL;
+			}
+
+			soundCacheAllocator.Free( (byte *)destData[i] );
+			idSampleDecoder::Free( decoders[i] );
+		}
+
+		first += numBatch;
+	}
+
+	common->Printf( "%5i sounds decompressed\n", samples.Num() );
+}
+
 /*
 ===================
 idSoundCache::PrintMemInfo
@@ -292,6 +396,9 @@ idSoundSample::idSoundSample() {
 	onDemand = false;
 	purged = false;
 	levelLoadReferenced = false;
+	residencyLevel = 0;
+	decodePending = false;
+	streamed = false;
 }
 
 /*
@@ -424,12 +531,19 @@ ID_TIME_T idSoundSample::GetNewTimeStamp( void ) const {
 idSoundSample::Load
 
 Loads based on name, possibly doing a MakeDefault if necessary
+
+With deferDecode, an OGG decompressed at load time is left to
+idSoundCache::DecodePendingSamples
 ===================
 */
-void idSoundSample::Load( void ) {	
+void idSoundSample::Load( bool deferDecode ) {	
+	idScopedMemTag memTag( MEMTAG_SOUND );
+
 	defaultSound = false;
 	purged = false;
 	hardwareBuffer = false;
+	decodePending = false;
+	streamed = false;
 
 	timestamp = GetNewTimeStamp();
 
@@ -474,6 +588,16 @@ void idSoundSample::Load( void ) {
 	objectSize = fh.GetOutputSize();
 	objectMemSize = fh.GetMemorySize();
 
+	// long OGGs, which are never decompressed at load time, are read from the file by the decoders playing them
+	int streamingLimit = idSoundSystemLocal::s_streamingLimit.GetInteger();
+	if ( objectInfo.wFormatTag == WAVE_FORMAT_TAG_OGG && streamingLimit > 0 &&
+		objectSize >= (int)objectInfo.nSamplesPerSec * Max( streamingLimit, idSoundSystemLocal::s_decompressionLimit.GetInteger() ) ) {
+		streamed = true;
+		objectMemSize = 0;
+		fh.Close();
+		return;
+	}
+
 	nonCacheData = (byte *)soundCacheAllocator.Alloc( objectMemSize );
 	fh.Read( nonCacheData, objectMemSize, NULL );
 
@@ -529,77 +653,17 @@ void idSoundSample::Load( void ) {
 #else
 			if ( ( alIsExtensionPresent( ID_ALCHAR "EAX-RAM" ) == AL_TRUE ) && ( objectSize < ( ( int ) objectInfo.nSamplesPerSec * idSoundSystemLocal::s_decompressionLimit.GetInteger() ) ) ) {
 #endif
-				alGetError();
-				alGenBuffers( 1, &openalBuffer );
-				if ( alGetError() != AL_NO_ERROR )
-					common->Error( "idSoundCache: error generating OpenAL hardware buffer" );
-				if ( alIsBuffer( openalBuffer ) ) {
+				if ( deferDecode ) {
+					// decompressed together with the others at the end of the level load
+					decodePending = true;
+				} else {
 					idSampleDecoder *decoder = idSampleDecoder::Alloc();
 					float *destData = (float *)soundCacheAllocator.Alloc( ( LengthIn44kHzSamples() + 1 ) * sizeof( float ) );
-					
+
 					// Decoder *always* outputs 44 kHz data
 					decoder->Decode( this, 0, LengthIn44kHzSamples(), destData );
 
-					// Downsample back to original frequency (save memory)
-					if ( objectInfo.nSamplesPerSec == 11025 ) {
-						for ( int i = 0; i < objectSize; i++ ) {
-							if ( destData[i*4] < -32768.0f )
-								((short *)destData)[i] = -32768;
-							else if ( destData[i*4] > 32767.0f )
-								((short *)destData)[i] = 32767;
-							else
-								((short *)destData)[i] = idMath::FtoiFast( destData[i*4] );
-						}
-					} else if ( objectInfo.nSamplesPerSec == 22050 ) {
-						for ( int i = 0; i < objectSize; i++ ) {
-							if ( destData[i*2] < -32768.0f )
-								((short *)destData)[i] = -32768;
-							else if ( destData[i*2] > 32767.0f )
-								((short *)destData)[i] = 32767;
-							else
-								((short *)destData)[i] = idMath::FtoiFast( destData[i*2] );
-						}
-					} else {
-						for ( int i = 0; i < objectSize; i++ ) {
-							if ( destData[i] < -32768.0f )
-								((short *)destData)[i] = -32768;
-							else if ( destData[i] > 32767.0f )
-								((short *)destData)[i] = 32767;
-							else
-								((short *)destData)[i] = idMath::FtoiFast( destData[i] );
-						}
-					}
-
-					alGetError();
-					alBufferData( openalBuffer, objectInfo.nChannels==1?AL_FORMAT_MONO16:AL_FORMAT_STEREO16, destData, objectSize * sizeof( short ), objectInfo.nSamplesPerSec );
-					int alError = alGetError();
-					if ( alError != AL_NO_ERROR )
-						common->Error( "idSoundCache Load OGG: error %i loading data into OpenAL hardware buffer", alError );
-					else {
-						// Compute amplitude block size
-						int blockSize = 512 * objectInfo.nSamplesPerSec / 44100 ;
-
-						// Allocate amplitude data array
-						amplitudeData = (byte *)soundCacheAllocator.Alloc( ( objectSize / blockSize + 1 ) * 2 * sizeof( short ) );
-
-						// Creating array of min/max amplitude pairs per blockSize samples
-						int i;
-						for ( i = 0; i < objectSize; i+=blockSize ) {
-							short min = 32767;
-							short max = -32768;
-							
-							int j;
-							for ( j = 0; j < Min( objectSize - i, blockSize ); j++ ) {
-								min = ((short *)destData)[ i + j ] < min ? ((short *)destData)[ i + j ] : min;
-								max = ((short *)destData)[ i + j ] > max ? ((short *)destData)[ i + j ] : max;
-							}
-
-							((short *)amplitudeData)[ ( i / blockSize ) * 2     ] = min;
-							((short *)amplitudeData)[ ( i / blockSize ) * 2 + 1 ] = max;
-						}
-						
-						hardwareBuffer = true;
-					}
+					LoadDecodedOGG( destData );
 
 					soundCacheAllocator.Free( (byte *)destData );
 					idSampleDecoder::Free( decoder );
@@ -617,6 +681,84 @@ void idSoundSample::Load( void ) {
 	fh.Close();
 }
 
+/*
+===================
+idSoundSample::LoadDecodedOGG
+
+Creates the hardware buffer of an OGG decompressed at load time from its 44kHz samples
+===================
+*/
+void idSoundSample::LoadDecodedOGG( float *destData ) {
+	alGetError();
+	alGenBuffers( 1, &openalBuffer );
+	if ( alGetError() != AL_NO_ERROR )
+		common->Error( "idSoundCache: error generating OpenAL hardware buffer" );
+	if ( !alIsBuffer( openalBuffer ) ) {
+		return;
+	}
+
+	// Downsample back to original frequency (save memory)
+	if ( objectInfo.nSamplesPerSec == 11025 ) {
+		for ( int i = 0; i < objectSize; i++ ) {
+			if ( destData[i*4] < -32768.0f )
+				((short *)destData)[i] = -32768;
+			else if ( destData[i*4] > 32767.0f )
+				((short *)destData)[i] = 32767;
+			else
+				((short *)destData)[i] = idMath::FtoiFast( destData[i*4] );
+		}
+	} else if ( objectInfo.nSamplesPerSec == 22050 ) {
+		for ( int i = 0; i < objectSize; i++ ) {
+			if ( destData[i*2] < -32768.0f )
+				((short *)destData)[i] = -32768;
+			else if ( destData[i*2] > 32767.0f )
+				((short *)destData)[i] = 32767;
+			else
+				((short *)destData)[i] = idMath::FtoiFast( destData[i*2] );
+		}
+	} else {
+		for ( int i = 0; i < objectSize; i++ ) {
+			if ( destData[i] < -32768.0f )
+				((short *)destData)[i] = -32768;
+			else if ( destData[i] > 32767.0f )
+				((short *)destData)[i] = 32767;
+			else
+				((short *)destData)[i] = idMath::FtoiFast( destData[i] );
+		}
+	}
+
+	alGetError();
+	alBufferData( openalBuffer, objectInfo.nChannels==1?AL_FORMAT_MONO16:AL_FORMAT_STEREO16, destData, objectSize * sizeof( short ), objectInfo.nSamplesPerSec );
+	int alError = alGetError();
+	if ( alError != AL_NO_ERROR )
+		common->Error( "idSoundCache Load OGG: error %i loading data into OpenAL hardware buffer", alError );
+	else {
+		// Compute amplitude block size
+		int blockSize = 512 * objectInfo.nSamplesPerSec / 44100 ;
+
+		// Allocate amplitude data array
+		amplitudeData = (byte *)soundCacheAllocator.Alloc( ( objectSize / blockSize + 1 ) * 2 * sizeof( short ) );
+
+		// Creating array of min/max amplitude pairs per blockSize samples
+		int i;
+		for ( i = 0; i < objectSize; i+=blockSize ) {
+			short min = 32767;
+			short max = -32768;
+			
+			int j;
+			for ( j = 0; j < Min( objectSize - i, blockSize ); j++ ) {
+				min = ((short *)destData)[ i + j ] < min ? ((short *)destData)[ i + j ] : min;
+				max = ((short *)destData)[ i + j ] > max ? ((short *)destData)[ i + j ] : max;
+			}
+
+			((short *)amplitudeData)[ ( i / blockSize ) * 2     ] = min;
+			((short *)amplitudeData)[ ( i / blockSize ) * 2 + 1 ] = max;
+		}
+		
+		hardwareBuffer = true;
+	}
+}
+
 /*
 ===================
 idSoundSample::PurgeSoundSample
@@ -624,6 +766,7 @@ idSoundSample::PurgeSoundSample
 */
 void idSoundSample::PurgeSoundSample() {
 	purged = true;
+	decodePending = false;
 
 	if ( hardwareBuffer && idSoundSystemLocal::useOpenAL ) {
 		alGetError();
@@ -41,6 +41,32 @@ idDynamicBlockAlloc<byte, 1<<20, 128>		decoderMemoryAllocator;
 
 const int MIN_OGGVORBIS_MEMORY				= 768 * 1024;
 
+// set while several threads decode, see idSampleDecoder::BeginParallelDecode
+static bool decoderMemoryShared				= false;
+
+/*
+====================
+Decoder memory
+
+Usually only touched with CRITICAL_SECTION_ONE held. While decoding in parallel
+the decoder lock is held by the thread which started it, so the allocations of
+the workers take CRITICAL_SECTION_THREE, like the renderer's static allocations
+in the same situation. Neither lock holder takes any other lock, so the two
+can share it.
+====================
+*/
+static ID_INLINE void LockDecoderMemory( void ) {
+	if ( decoderMemoryShared ) {
+		Sys_EnterCriticalSection( CRITICAL_SECTION_THREE );
+	}
+}
+
+static ID_INLINE void UnlockDecoderMemory( void ) {
+	if ( decoderMemoryShared ) {
+		Sys_LeaveCriticalSection( CRITICAL_SECTION_THREE );
+	}
+}
+
 extern "C" {
 	void *_decoder_malloc( size_t size );
 	void *_decoder_calloc( size_t num, size_t size );
@@ -49,26 +75,34 @@ extern "C" {
 }
 
 void *_decoder_malloc( size_t size ) {
+	LockDecoderMemory();
 	void *ptr = decoderMemoryAllocator.Alloc( size );
+	UnlockDecoderMemory();
 	assert( size == 0 || ptr != NULL );
 	return ptr;
 }
 
 void *_decoder_calloc( size_t num, size_t size ) {
+	LockDecoderMemory();
 	void *ptr = decoderMemoryAllocator.Alloc( num * size );
+	UnlockDecoderMemory();
 	assert( ( num * size ) == 0 || ptr != NULL );
 	memset( ptr, 0, num * size );
 	return ptr;
 }
 
 void *_decoder_realloc( void *memblock, size_t size ) {
+	LockDecoderMemory();
 	void *ptr = decoderMemoryAllocator.Resize( (byte *)memblock, size );
+	UnlockDecoderMemory();
 	assert( size == 0 || ptr != NULL );
 	return ptr;
 }
 
 void _decoder_free( void *memblock ) {
+	LockDecoderMemory();
 	decoderMemoryAllocator.Free( (byte *)memblock );
+	UnlockDecoderMemory();
 }
 
 
@@ -147,6 +181,53 @@ int ov_openFile( idFile *f, OggVorbis_File *vf ) {
 	return ov_open_callbacks((void *)f, vf, NULL, -1, callbacks);
 }
 
+/*
+====================
+FS_ReadStreamOGG
+====================
+*/
+size_t FS_ReadStreamOGG( void *dest, size_t size1, size_t size2, void *fh ) {
+	idSoundStream *stream = reinterpret_cast<idSoundStream *>(fh);
+	return stream->Read( dest, size1 * size2 );
+}
+
+/*
+====================
+FS_SeekStreamOGG
+
+makes vorbisfile decode the stream in order, without looking for its end
+====================
+*/
+int FS_SeekStreamOGG( void *fh, ogg_int64_t to, int type ) {
+	return -1;
+}
+
+/*
+====================
+FS_TellStreamOGG
+====================
+*/
+long FS_TellStreamOGG( void *fh ) {
+	return -1;
+}
+
+/*
+====================
+ov_openStream
+====================
+*/
+int ov_openStream( idSoundStream *stream, OggVorbis_File *vf ) {
+	ov_callbacks callbacks;
+
+	memset( vf, 0, sizeof( OggVorbis_File ) );
+
+	callbacks.read_func = FS_ReadStreamOGG;
+	callbacks.seek_func = FS_SeekStreamOGG;
+	callbacks.close_func = FS_CloseOGG;
+	callbacks.tell_func = FS_TellStreamOGG;
+	return ov_open_callbacks((void *)stream, vf, NULL, -1, callbacks);
+}
+
 /*
 ====================
 idWaveFile::OpenOGG
@@ -276,12 +357,19 @@ class idSampleDecoderLocal : public idSampleDecoder {
 public:
 	virtual void			Decode( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
 	virtual void			ClearDecoder( void );
+	virtual void			DecodeLocked( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
+	virtual void			ClearDecoderLocked( void );
 	virtual idSoundSample *	GetSample( void ) const;
 	virtual int				GetLastDecodeTime( void ) const;
+	virtual float			GetLastDecodeMsec( void ) const;
+	virtual bool			GetLastDecodeStarved( void ) const;
 
 	void					Clear( void );
 	int						DecodePCM( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
 	int						DecodeOGG( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
+	bool					OpenStream( idSoundSample *sample );
+	bool					SeekStream( idSoundSample *sample, int sampleOffset );
+	bool					StreamHasData( void ) const;
 
 private:
 	bool					failed;				// set if decoding failed
@@ -289,7 +377,11 @@ private:
 	idSoundSample *			lastSample;			// last sample being decoded
 	int						lastSampleOffset;	// last offset into the decoded sample
 	int						lastDecodeTime;		// last time decoding sound
+	float					lastDecodeMsec;		// msecs spent decoding at the last time
+	bool					lastDecodeStarved;	// the stream ran out of data at the last time
 	idFile_Memory			file;				// encoded file in memory
+	idSoundStream *			stream;				// encoded file read from the file system, for streamed samples
+	bool					streamOpened;		// the OggVorbis file of the stream is open
 
 	OggVorbis_File			ogg;				// OggVorbis file
 };
@@ -313,6 +405,7 @@ idSampleDecoder::Shutdown
 ====================
 */
 void idSampleDecoder::Shutdown( void ) {
+	idSoundStream::Shutdown();
 	decoderMemoryAllocator.Shutdown();
 	sampleDecoderAllocator.Shutdown();
 }
@@ -339,6 +432,37 @@ void idSampleDecoder::Free( idSampleDecoder *decoder ) {
 	sampleDecoderAllocator.Free( localDecoder );
 }
 
+/*
+====================
+idSampleDecoder::BeginParallelDecode
+
+Keeps the other threads from decoding until EndParallelDecode
+====================
+*/
+void idSampleDecoder::BeginParallelDecode( void ) {
+	Sys_EnterCriticalSection( CRITICAL_SECTION_ONE );
+	decoderMemoryShared = true;
+}
+
+/*
+====================
+idSampleDecoder::EndParallelDecode
+====================
+*/
+void idSampleDecoder::EndParallelDecode( void ) {
+	decoderMemoryShared = false;
+	Sys_LeaveCriticalSection( CRITICAL_SECTION_ONE );
+}
+
+/*
+====================
+idSampleDecoder::GetNumFreeOggDecoders
+====================
+*/
+int idSampleDecoder::GetNumFreeOggDecoders( void ) {
+	return decoderMemoryAllocator.GetFreeBlockMemory() / MIN_OGGVORBIS_MEMORY;
+}
+
 /*
 ====================
 idSampleDecoder::GetNumUsedBlocks
@@ -368,6 +492,10 @@ void idSampleDecoderLocal::Clear( void ) {
 	lastSample = NULL;
 	lastSampleOffset = 0;
 	lastDecodeTime = 0;
+	lastDecodeMsec = 0.0f;
+	lastDecodeStarved = false;
+	stream = NULL;
+	streamOpened = false;
 }
 
 /*
@@ -377,21 +505,33 @@ idSampleDecoderLocal::ClearDecoder
 */
 void idSampleDecoderLocal::ClearDecoder( void ) {
 	Sys_EnterCriticalSection( CRITICAL_SECTION_ONE );
+	ClearDecoderLocked();
+	Sys_LeaveCriticalSection( CRITICAL_SECTION_ONE );
+}
 
+/*
+====================
+idSampleDecoderLocal::ClearDecoderLocked
+====================
+*/
+void idSampleDecoderLocal::ClearDecoderLocked( void ) {
 	switch( lastFormat ) {
 		case WAVE_FORMAT_TAG_PCM: {
 			break;
 		}
 		case WAVE_FORMAT_TAG_OGG: {
-			ov_clear( &ogg );
+			if ( stream == NULL || streamOpened ) {
+				ov_clear( &ogg );
+			}
 			memset( &ogg, 0, sizeof( ogg ) );
+			if ( stream != NULL ) {
+				stream->Release();
+			}
 			break;
 		}
 	}
 
 	Clear();
-
-	Sys_LeaveCriticalSection( CRITICAL_SECTION_ONE );
 }
 
 /*
@@ -412,18 +552,53 @@ int idSampleDecoderLocal::GetLastDecodeTime( void ) const {
 	return lastDecodeTime;
 }
 
+/*
+====================
+idSampleDecoderLocal::GetLastDecodeMsec
+====================
+*/
+float idSampleDecoderLocal::GetLastDecodeMsec( void ) const {
+	return lastDecodeMsec;
+}
+
+/*
+====================
+idSampleDecoderLocal::GetLastDecodeStarved
+====================
+*/
+bool idSampleDecoderLocal::GetLastDecodeStarved( void ) const {
+	return lastDecodeStarved;
+}
+
 /*
 ====================
 idSampleDecoderLocal::Decode
 ====================
 */
 void idSampleDecoderLocal::Decode( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest ) {
+	// samples can be decoded both from the sound thread and the main thread for shakes
+	Sys_EnterCriticalSection( CRITICAL_SECTION_ONE );
+	DecodeLocked( sample, sampleOffset44k, sampleCount44k, dest );
+	Sys_LeaveCriticalSection( CRITICAL_SECTION_ONE );
+}
+
+/*
+====================
+idSampleDecoderLocal::DecodeLocked
+====================
+*/
+void idSampleDecoderLocal::DecodeLocked( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest ) {
 	int readSamples44k;
 
 	if ( sample->objectInfo.wFormatTag != lastFormat || sample != lastSample ) {
-		ClearDecoder();
+		ClearDecoderLocked();
 	}
 
+	// a channel can be decoded several times for the same mix
+	if ( lastDecodeTime != soundSystemLocal.CurrentSoundTime ) {
+		lastDecodeMsec = 0.0f;
+		lastDecodeStarved = false;
+	}
 	lastDecodeTime = soundSystemLocal.CurrentSoundTime;
 
 	if ( failed ) {
@@ -431,8 +606,8 @@ void idSampleDecoderLocal::Decode( idSoundSample *sample, int sampleOffset44k, i
 		return;
 	}
 
-	// samples can be decoded both from the sound thread and the main thread for shakes
-	Sys_EnterCriticalSection( CRITICAL_SECTION_ONE );
+	idTimer decodeTimer;
+	decodeTimer.Start();
 
 	switch( sample->objectInfo.wFormatTag ) {
 		case WAVE_FORMAT_TAG_PCM: {
@@ -449,11 +624,16 @@ void idSampleDecoderLocal::Decode( idSoundSample *sample, int sampleOffset44k, i
 		}
 	}
 
-	Sys_LeaveCriticalSection( CRITICAL_SECTION_ONE );
-
 	if ( readSamples44k < sampleCount44k ) {
 		memset( dest + readSamples44k, 0, ( sampleCount44k - readSamples44k ) * sizeof( dest[0] ) );
+
+		if ( stream != NULL && !failed && !stream->AtEnd() ) {
+			lastDecodeStarved = true;
+		}
 	}
+
+	decodeTimer.Stop();
+	lastDecodeMsec += decodeTimer.Milliseconds();
 }
 
 /*
@@ -508,9 +688,16 @@ int idSampleDecoderLocal::DecodeOGG( idSoundSample *sample, int sampleOffset44k,
 	int sampleCount = sampleCount44k >> shift;
 
 	// open OGG file if not yet opened
-	if ( lastSample == NULL ) {
+	if ( sample->streamed ) {
+		if ( !OpenStream( sample ) ) {
+			return 0;
+		}
+	} else if ( lastSample == NULL ) {
 		// make sure there is enough space for another decoder
-		if ( decoderMemoryAllocator.GetFreeBlockMemory() < MIN_OGGVORBIS_MEMORY ) {
+		LockDecoderMemory();
+		int freeMemory = decoderMemoryAllocator.GetFreeBlockMemory();
+		UnlockDecoderMemory();
+		if ( freeMemory < MIN_OGGVORBIS_MEMORY ) {
 			return 0;
 		}
 		if ( sample->nonCacheData == NULL ) {
@@ -528,7 +715,11 @@ int idSampleDecoderLocal::DecodeOGG( idSoundSample *sample, int sampleOffset44k,
 	}
 
 	// seek to the right offset if necessary
-	if ( sampleOffset != lastSampleOffset ) {
+	if ( sample->streamed ) {
+		if ( !SeekStream( sample, sampleOffset ) ) {
+			return 0;
+		}
+	} else if ( sampleOffset != lastSampleOffset ) {
 		if ( ov_pcm_seek( &ogg, sampleOffset / sample->objectInfo.nChannels ) != 0 ) {
 			failed = true;
 			return 0;
@@ -541,6 +732,10 @@ int idSampleDecoderLocal::DecodeOGG( idSoundSample *sample, int sampleOffset44k,
 	totalSamples = sampleCount;
 	readSamples = 0;
 	do {
+		// the end of the data which has arrived isn't the end of the file
+		if ( stream != NULL && !StreamHasData() ) {
+			break;
+		}
 		float **samples;
 		int ret = ov_read_float( &ogg, &samples, totalSamples / sample->objectInfo.nChannels, &ogg.stream );
 		if ( ret == 0 ) {
@@ -563,3 +758,363 @@ int idSampleDecoderLocal::DecodeOGG( idSoundSample *sample, int sampleOffset44k,
 
 	return ( readSamples << shift );
 }
+
+/*
+====================
+idSampleDecoderLocal::OpenStream
+
+Returns false until enough of the streamed sample has arrived to decode it
+====================
+*/
+bool idSampleDecoderLocal::OpenStream( idSoundSample *sample ) {
+	if ( stream == NULL ) {
+		stream = idSoundStream::Acquire( sample );
+		if ( stream == NULL ) {
+			// all streams are in use, try again later
+			return false;
+		}
+		memset( &ogg, 0, sizeof( ogg ) );
+		streamOpened = false;
+		lastFormat = WAVE_FORMAT_TAG_OGG;
+		lastSample = sample;
+	}
+
+	if ( !streamOpened ) {
+		// make sure there is enough space for another decoder
+		LockDecoderMemory();
+		int freeMemory = decoderMemoryAllocator.GetFreeBlockMemory();
+		UnlockDecoderMemory();
+		if ( freeMemory < MIN_OGGVORBIS_MEMORY || !StreamHasData() ) {
+			return false;
+		}
+		if ( ov_openStream( stream, &ogg ) < 0 ) {
+			failed = true;
+			return false;
+		}
+		streamOpened = true;
+		lastSampleOffset = 0;
+	}
+
+	return true;
+}
+
+/*
+====================
+idSampleDecoderLocal::SeekStream
+
+A stream can't seek, it's decoded up to the offset, or started over to go back
+====================
+*/
+bool idSampleDecoderLocal::SeekStream( idSoundSample *sample, int sampleOffset ) {
+	if ( sampleOffset < lastSampleOffset ) {
+		ov_clear( &ogg );
+		memset( &ogg, 0, sizeof( ogg ) );
+		streamOpened = false;
+		stream->Rewind();
+		return false;
+	}
+
+	// catches up after the stream ran dry or a sound started in the middle
+	int numChannels = sample->objectInfo.nChannels;
+	while ( sampleOffset - lastSampleOffset >= numChannels ) {
+		if ( !StreamHasData() ) {
+			return false;
+		}
+		float **samples;
+		int ret = ov_read_float( &ogg, &samples, ( sampleOffset - lastSampleOffset ) / numChannels, &ogg.stream );
+		if ( ret <= 0 ) {
+			failed = true;
+			return false;
+		}
+		lastSampleOffset += ret * numChannels;
+	}
+
+	return true;
+}
+
+/*
+====================
+idSampleDecoderLocal::StreamHasData
+
+vorbisfile takes a short read for the end of the file, so it's only
+given the last bytes of the stream once the rest of the file has arrived
+====================
+*/
+bool idSampleDecoderLocal::StreamHasData( void ) const {
+	return stream->Available() >= SOUND_STREAM_MIN_DATA || stream->AtEnd();
+}
+
+/*
+===================================================================================
+
+  idSoundStream
+
+===================================================================================
+*/
+
+idSoundStream idSoundStream::streams[MAX_SOUND_STREAMS];
+
+/*
+====================
+idSoundStream::Acquire
+====================
+*/
+idSoundStream *idSoundStream::Acquire( const idSoundSample *sample ) {
+	idSoundStream *stream = NULL;
+
+	LockDecoderMemory();
+	for ( int i = 0; i < MAX_SOUND_STREAMS; i++ ) {
+		if ( streams[i].state == STREAM_FREE ) {
+			stream = &streams[i];
+			stream->sample = sample;
+			stream->state = STREAM_REQUESTED;
+			break;
+		}
+	}
+	UnlockDecoderMemory();
+
+	return stream;
+}
+
+/*
+====================
+idSoundStream::Release
+====================
+*/
+void idSoundStream::Release( void ) {
+	LockDecoderMemory();
+	state = ( state == STREAM_REQUESTED ) ? STREAM_FREE : STREAM_RELEASED;
+	UnlockDecoderMemory();
+}
+
+/*
+====================
+idSoundStream::Read
+====================
+*/
+int idSoundStream::Read( void *dest, int size ) {
+	int length = Min( size, Available() );
+	int offset = readPos % SOUND_STREAM_BUFFER_SIZE;
+	int first = Min( length, SOUND_STREAM_BUFFER_SIZE - offset );
+
+	memcpy( dest, buffer + offset, first );
+	memcpy( (byte *)dest + first, buffer, length - first );
+	readPos += length;
+
+	return length;
+}
+
+/*
+====================
+idSoundStream::Available
+====================
+*/
+int idSoundStream::Available( void ) const {
+	if ( state != STREAM_ACTIVE || rewindRequested ) {
+		return 0;
+	}
+	return Min( writePos, readLapEnd ) - readPos;
+}
+
+/*
+====================
+idSoundStream::AtEnd
+====================
+*/
+bool idSoundStream::AtEnd( void ) const {
+	if ( state != STREAM_ACTIVE || rewindRequested ) {
+		return false;
+	}
+	return writePos >= readLapEnd || readFailed;
+}
+
+/*
+====================
+idSoundStream::Rewind
+
+The beginning of the file is usually in the buffer already when
+a looping sound starts over, otherwise the main thread starts over
+====================
+*/
+void idSoundStream::Rewind( void ) {
+	if ( state == STREAM_ACTIVE && writePos >= readLapEnd && !readFailed ) {
+		readPos = readLapEnd;
+		readLapEnd += fileLength;
+	} else {
+		rewindRequested = true;
+	}
+}
+
+/*
+====================
+idSoundStream::UpdateStreams
+====================
+*/
+void idSoundStream::UpdateStreams( void ) {
+	for ( int i = 0; i < MAX_SOUND_STREAMS; i++ ) {
+		streams[i].Update();
+	}
+}
+
+/*
+====================
+idSoundStream::Update
+
+The file system is only used outside the lock, the mixer would wait for it otherwise
+====================
+*/
+void idSoundStream::Update( void ) {
+	Sys_EnterCriticalSection();
+	soundStreamState_t current = state;
+	if ( current == STREAM_REQUESTED ) {
+		state = STREAM_OPENING;
+	}
+	Sys_LeaveCriticalSection();
+
+	if ( current == STREAM_FREE || current == STREAM_OPENING ) {
+		return;
+	}
+
+	if ( current == STREAM_RELEASED ) {
+		Close();
+		Sys_EnterCriticalSection();
+		state = STREAM_FREE;
+		Sys_LeaveCriticalSection();
+		return;
+	}
+
+	if ( current == STREAM_REQUESTED ) {
+		idStr fileName = sample->name;
+		fileName.SetFileExtension( ".ogg" );
+		idFile *f = fileSystem->OpenFileRead( fileName );
+		byte *b = (byte *)Mem_Alloc( SOUND_STREAM_BUFFER_SIZE );
+
+		Sys_EnterCriticalSection();
+		file = f;
+		buffer = b;
+		pendingRead = NULL;
+		fileLength = f ? f->Length() : 0;
+		fileOffset = 0;
+		readFailed = ( f == NULL );
+		readPos = 0;
+		writePos = 0;
+		readLapEnd = fileLength;
+		rewindRequested = false;
+		// it may have been released already, then it's closed by the next update
+		if ( state == STREAM_OPENING ) {
+			state = STREAM_ACTIVE;
+		}
+		current = state;
+		Sys_LeaveCriticalSection();
+
+		if ( current != STREAM_ACTIVE ) {
+			return;
+		}
+	}
+
+	if ( pendingRead ) {
+		if ( !fileSystem->IsReadFileAsyncDone( pendingRead ) ) {
+			return;
+		}
+		int numRead = fileSystem->FinishReadFileAsync( pendingRead, NULL );
+		pendingRead = NULL;
+
+		Sys_EnterCriticalSection();
+		if ( numRead > 0 ) {
+			writePos += numRead;
+			fileOffset += numRead;
+		} else {
+			readFailed = true;
+		}
+		// keep the positions small, the buffer index doesn't change
+		if ( readPos >= ( 1 << 30 ) ) {
+			int shift = readPos - readPos % SOUND_STREAM_BUFFER_SIZE;
+			readPos -= shift;
+			writePos -= shift;
+			readLapEnd -= shift;
+		}
+		Sys_LeaveCriticalSection();
+	}
+
+	if ( readFailed ) {
+		return;
+	}
+
+	if ( rewindRequested ) {
+		file->Seek( 0, FS_SEEK_SET );
+
+		Sys_EnterCriticalSection();
+		fileOffset = 0;
+		readPos = 0;
+		writePos = 0;
+		readLapEnd = fileLength;
+		rewindRequested = false;
+		Sys_LeaveCriticalSection();
+	}
+
+	if ( fileOffset >= fileLength ) {
+		// read on with the beginning, for a looping sound
+		file->Seek( 0, FS_SEEK_SET );
+		fileOffset = 0;
+	}
+
+	// the decoder only moves the read position forward, so this can only be too small
+	int freeSpace = SOUND_STREAM_BUFFER_SIZE - ( writePos - readPos );
+	int remaining = fileLength - fileOffset;
+	if ( freeSpace < SOUND_STREAM_READ_SIZE && freeSpace < remaining ) {
+		return;
+	}
+
+	int offset = writePos % SOUND_STREAM_BUFFER_SIZE;
+	int length = Min( Min( freeSpace, remaining ), Min( SOUND_STREAM_READ_SIZE, SOUND_STREAM_BUFFER_SIZE - offset ) );
+	if ( length > 0 ) {
+		pendingRead = fileSystem->ReadAsync( file, buffer + offset, length );
+	}
+}
+
+/*
+====================
+idSoundStream::Close
+====================
+*/
+void idSoundStream::Close( void ) {
+	if ( pendingRead ) {
+		fileSystem->FinishReadFileAsync( pendingRead, NULL );
+		pendingRead = NULL;
+	}
+	if ( file ) {
+		fileSystem->CloseFile( file );
+		file = NULL;
+	}
+	Mem_Free( buffer );
+	buffer = NULL;
+}
+
+/*
+====================
+idSoundStream::Shutdown
+====================
+*/
+void idSoundStream::Shutdown( void ) {
+	for ( int i = 0; i < MAX_SOUND_STREAMS; i++ ) {
+		if ( streams[i].state != STREAM_FREE ) {
+			streams[i].Close();
+			streams[i].state = STREAM_FREE;
+		}
+	}
+}
+
+/*
+====================
+idSoundStream::GetNumActiveStreams
+====================
+*/
+int idSoundStream::GetNumActiveStreams( void ) {
+	int num = 0;
+	for ( int i = 0; i < MAX_SOUND_STREAMS; i++ ) {
+		if ( streams[i].state != STREAM_FREE ) {
+			num++;
+		}
+	}
+	return num;
+}
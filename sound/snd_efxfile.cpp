@@ -28,7 +28,9 @@ static bool versioned = RegisterVersionedFile("$Id$");
 idEFXFile::idEFXFile
 ===============
 */
-idEFXFile::idEFXFile( void ) { }
+idEFXFile::idEFXFile( void ) {
+	defaultEffect = -1;
+}
 
 /*
 ===============
@@ -37,6 +39,9 @@ idEFXFile::Clear
 */
 void idEFXFile::Clear( void ) {
 	effects.DeleteContents( true );
+	areaEffects.Clear();
+	effectHash.Free();
+	defaultEffect = -1;
 }
 
 /*
@@ -66,6 +71,74 @@ bool idEFXFile::FindEffect( idStr &name, idSoundEffect **effect, int *index ) {
 	return false;
 }
 
+/*
+===============
+idEFXFile::FindEffectIndex
+===============
+*/
+int idEFXFile::FindEffectIndex( const char *name ) const {
+	for ( int i = effectHash.First( idStr::Hash( name ) ); i != -1; i = effectHash.Next( i ) ) {
+		if ( effects[i]->name.Cmp( name ) == 0 ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+===============
+idEFXFile::FindListenerEffect
+
+Looked up by the mixer for every block, so it only does table and hash lookups
+===============
+*/
+int idEFXFile::FindListenerEffect( int area, const char *areaName ) const {
+	if ( area >= 0 && area < areaEffects.Num() && areaEffects[area] != -1 ) {
+		return areaEffects[area];
+	}
+	const int index = FindEffectIndex( areaName );
+	if ( index != -1 ) {
+		return index;
+	}
+	return defaultEffect;
+}
+
+/*
+===============
+idEFXFile::BuildLookups
+===============
+*/
+void idEFXFile::BuildLookups( void ) {
+	int i;
+
+	areaEffects.Clear();
+	effectHash.Free();
+	effectHash.ResizeIndex( effects.Num() );
+
+	// added back to front, so the first effect with a name heads its hash chain
+	for ( i = effects.Num() - 1; i >= 0; i-- ) {
+		effectHash.Add( idStr::Hash( effects[i]->name ), i );
+	}
+
+	for ( i = 0; i < effects.Num(); i++ ) {
+		const idStr &name = effects[i]->name;
+
+		// only names the listener area number prints as
+		if ( name.IsEmpty() || !name.IsNumeric() || name[0] == '-' || name[0] == '+' || ( name[0] == '0' && name.Length() > 1 ) || name.Length() > 9 ) {
+			continue;
+		}
+		const int area = atoi( name );
+		while ( areaEffects.Num() <= area ) {
+			areaEffects.Append( -1 );
+		}
+		if ( areaEffects[area] == -1 ) {
+			areaEffects[area] = i;
+		}
+	}
+
+	defaultEffect = FindEffectIndex( "default" );
+}
+
 /*
 ===============
 idEFXFile::ReadEffect
@@ -211,6 +284,8 @@ bool idEFXFile::LoadFile( const char *filename, bool OSPath ) {
 		}
 	};
 
+	BuildLookups();
+
 	return true;
 }
 
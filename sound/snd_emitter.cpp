@@ -182,6 +182,8 @@ void idSoundChannel::Clear( void ) {
 	openalStreamingOffset = 0;
 	openalStreamingBuffer[0] = openalStreamingBuffer[1] = openalStreamingBuffer[2] = 0;
 	lastopenalStreamingBuffer[0] = lastopenalStreamingBuffer[1] = lastopenalStreamingBuffer[2] = 0;
+	decodeAheadIndex = -1;
+	virtualChannel = false;
 }
 
 /*
@@ -248,9 +250,12 @@ idSoundChannel::GatherChannelSamples
 Will always return 44kHz samples for the given range, even if it deeply looped or
 out of the range of the unlooped samples.  Handles looping between multiple different
 samples and leadins
+
+With parallel set, the caller is between idSampleDecoder::BeginParallelDecode and
+EndParallelDecode, and channels with different decoders may gather at the same time
 ===================
 */
-void idSoundChannel::GatherChannelSamples( int sampleOffset44k, int sampleCount44k, float *dest ) const {
+void idSoundChannel::GatherChannelSamples( int sampleOffset44k, int sampleCount44k, float *dest, bool parallel ) const {
 	float	*dest_p = dest;
 	int		len;
 
@@ -269,8 +274,9 @@ void idSoundChannel::GatherChannelSamples( int sampleOffset44k, int sampleCount4
 	}
 	
 	// grab part of the leadin sample
+	// samples waiting for their decompression at the end of the level load are silent
 	idSoundSample *leadin = leadinSample;
-	if ( !leadin || sampleOffset44k < 0 || sampleCount44k <= 0 ) {
+	if ( !leadin || leadin->decodePending || sampleOffset44k < 0 || sampleCount44k <= 0 ) {
 		memset( dest_p, 0, sampleCount44k * sizeof( dest_p[0] ) );
 		return;
 	}
@@ -282,7 +288,11 @@ void idSoundChannel::GatherChannelSamples( int sampleOffset44k, int sampleCount4
 		}
 
 		// decode the sample
-		decoder->Decode( leadin, sampleOffset44k, len, dest_p );
+		if ( parallel ) {
+			decoder->DecodeLocked( leadin, sampleOffset44k, len, dest_p );
+		} else {
+			decoder->Decode( leadin, sampleOffset44k, len, dest_p );
+		}
 
 		dest_p += len;
 		sampleCount44k -= len;
@@ -298,7 +308,7 @@ void idSoundChannel::GatherChannelSamples( int sampleOffset44k, int sampleCount4
 	// fill the remainder with looped samples
 	idSoundSample *loop = soundShader->entries[0];
 
-	if ( !loop ) {
+	if ( !loop || loop->decodePending ) {
 		memset( dest_p, 0, sampleCount44k * sizeof( dest_p[0] ) );
 		return;
 	}
@@ -316,7 +326,11 @@ void idSoundChannel::GatherChannelSamples( int sampleOffset44k, int sampleCount4
 		}
 
 		// decode the sample
-		decoder->Decode( loop, sampleOffset44k, len, dest_p );
+		if ( parallel ) {
+			decoder->DecodeLocked( loop, sampleOffset44k, len, dest_p );
+		} else {
+			decoder->Decode( loop, sampleOffset44k, len, dest_p );
+		}
 
 		dest_p += len;
 		sampleCount44k -= len;
@@ -364,6 +378,7 @@ void idSoundEmitterLocal::Clear( void ) {
 	distance = 0.0f;
 
 	lastValidPortalArea = -1;
+	occlusionCached = false;
 
 	playing = false;
 	hasShakes = false;
@@ -546,6 +561,15 @@ void idSoundEmitterLocal::Spatialize( idVec3 listenerPos, int listenerArea, idRe
 		return;
 	}
 
+	// the occlusion can only make it quieter, so skip the portal traces of the virtual ones
+	if ( MaxChannelVolume( realDistance, soundSystemLocal.GetCurrent44kHzTime() ) < soundSystemLocal.GetAudibleVolume() )
+	{
+		distance = maxDistance;
+		spatializedOrigin = origin;
+		volumeLoss = 0;
+		return;
+	}
+
 	//
 	// work out virtual origin and distance, which may be from a portal instead of the actual origin
 	//
@@ -581,8 +605,36 @@ void idSoundEmitterLocal::Spatialize( idVec3 listenerPos, int listenerArea, idRe
 
 		volumeLoss = 0; // grayman #3042 - accumulates volume loss via ResolveOrigin() processing
 
+		// the portal chains only have to be searched again when the search could find other ones
+		bool searched = !idSoundSystemLocal::s_cacheOcclusion.GetBool() || !occlusionCached
+			|| occlusionSoundArea != soundInArea || occlusionListenerArea != listenerArea
+			|| occlusionPortalState != rw->GetPortalStateCount() || occlusionOrigin != origin
+			|| occlusionVolume != parms.volume || occlusionMinDistance != minDistance || occlusionMaxDistance != maxDistance;
+
 		SoundChainResults results;
-		if ( soundWorld->ResolveOrigin( 0, NULL, soundInArea, 0.0f, 0.0f, origin, origin, this, &results ) ) // grayman #3042
+		bool resolved;
+		if ( searched )
+		{
+			occlusionPaths.SetNum( 0, false );
+			resolved = soundWorld->ResolveOrigin( 0, NULL, soundInArea, 0.0f, 0.0f, origin, origin, this, &results ); // grayman #3042
+
+			occlusionCached = true;
+			occlusionSoundArea = soundInArea;
+			occlusionListenerArea = listenerArea;
+			occlusionPortalState = rw->GetPortalStateCount();
+			occlusionOrigin = origin;
+			occlusionVolume = parms.volume;
+			occlusionMinDistance = minDistance;
+			occlusionMaxDistance = maxDistance;
+			soundSystemLocal.perfPending.occlusionSearches++;
+		}
+		else
+		{
+			resolved = soundWorld->ResolveCachedOrigin( this, &results );
+			soundSystemLocal.perfPending.occlusionWalks++;
+		}
+
+		if ( resolved )
 		{
 			// get results
 			spatializedOrigin = results.spatializedOrigin;
@@ -601,6 +653,57 @@ void idSoundEmitterLocal::Spatialize( idVec3 listenerPos, int listenerArea, idRe
 	}
 }
 
+/*
+===================
+idSoundEmitterLocal::MaxChannelVolume
+
+The loudest volume any playing channel can be mixed with at the given distance in meters,
+like idSoundWorldLocal::AddChannelContribution computes it without the portal occlusion
+===================
+*/
+float idSoundEmitterLocal::MaxChannelVolume( float dist, int current44kHz ) {
+	float maxVolume = 0.0f;
+
+	for ( int i = 0; i < SOUND_MAX_CHANNELS; i++ ) {
+		idSoundChannel *chan = &channels[i];
+
+		if ( !chan->triggerState || !chan->soundShader ) {
+			continue;
+		}
+
+		const soundShaderParms_t *parms = &chan->parms;
+
+		float volumeDB = parms->volume;
+		if ( chan->soundShader->leadinVolume && chan->soundShader->leadinVolume > volumeDB ) {
+			volumeDB = chan->soundShader->leadinVolume;
+		}
+
+		float volume = soundSystemLocal.dB2Scale( volumeDB );
+		volume *= soundSystemLocal.dB2Scale( idSoundSystemLocal::s_volume.GetFloat() );
+		volume *= soundSystemLocal.dB2Scale( chan->channelFade.FadeDbAt44kHz( current44kHz ) );
+		volume *= soundSystemLocal.dB2Scale( soundWorld->soundClassFade[parms->soundClass].FadeDbAt44kHz( current44kHz ) );
+
+		bool global = ( parms->soundShaderFlags & SSF_GLOBAL ) || listenerId == soundWorld->listenerPrivateId;
+		if ( !global ) {
+			if ( dist >= parms->maxDistance ) {
+				volume = 0.0f;
+			} else if ( dist > parms->minDistance ) {
+				float frac = idMath::ClampFloat( 0.0f, 1.0f, 1.0f - ( ( dist - parms->minDistance ) / ( parms->maxDistance - parms->minDistance ) ) );
+				if ( idSoundSystemLocal::s_quadraticFalloff.GetBool() ) {
+					frac *= frac;
+				}
+				volume *= frac;
+			}
+		}
+
+		if ( volume > maxVolume ) {
+			maxVolume = volume;
+		}
+	}
+
+	return maxVolume;
+}
+
 /*
 ===========================================================================================
 
@@ -858,6 +961,7 @@ int idSoundEmitterLocal::StartSound( const idSoundShader *shader, const s_channe
 
 	// the sound will start mixing in the next async mix block
 	chan->triggered = true;
+	chan->virtualChannel = false;
 	chan->openalStreamingOffset = 0;
 	chan->trigger44kHzTime = start44kHz;
 	chan->parms = chanParms;
@@ -1209,20 +1313,16 @@ void idSlowChannel::GenerateSlowChannel( FracTime& playPos, int sampleCount44k,
 		playPos.Increment( slowmoSpeed );
 	}
 
-	// lowpass filter
-	float *in_p = in + 2, *out_p = out + 2;
+	// lowpass filter, which keeps its continuity samples
 	int numSamples = sampleCount44k >> 1;
 
-	lowpass.GetContinuitySamples( in_p[-1], in_p[-2], out_p[-1], out_p[-2] );
 	lowpass.SetParms( slowmoSpeed * 15000, 1.2f );
+	lowpass.ProcessSamples( src, numSamples );
 
-	for ( int i = 0, count = 0; i < numSamples; i++, count += 2 ) {
-		lowpass.ProcessSample( in_p + i, out_p + i );
-		finalBuffer[count] = finalBuffer[count+1] = out[i];
+	for ( i = 0, count = 0; i < numSamples; i++, count += 2 ) {
+		finalBuffer[count] = finalBuffer[count+1] = src[i];
 	}
 
-	lowpass.SetContinuitySamples( in_p[numSamples-2], in_p[numSamples-3], out_p[numSamples-2], out_p[numSamples-3] );
-
 	playPos.time += zeroedPos;
 }
 
@@ -38,6 +38,11 @@
 #endif
 #include "../openal/include/efxlib.h"
 
+// OpenAL 1.1, older implementations ignore it
+#ifndef AL_SAMPLE_OFFSET
+#define AL_SAMPLE_OFFSET					0x1025
+#endif
+
 // demo sound commands
 typedef enum {
 	SCMD_STATE,				// followed by a load game state
@@ -310,6 +315,7 @@ public:
 
 	virtual void		Initialize()									{ };
 	virtual void		ProcessSample( float* in, float* out ) = 0;
+	virtual void		ProcessSamples( float* samples, const int numSamples ) = 0;	// in place, keeps the continuity between the calls
 
 	void				SetChannel( int chan )							{ channel = chan; };
 	int					GetChannel()									{ return channel; };
@@ -323,6 +329,10 @@ public:
 class SoundFX_Lowpass : public SoundFX {
 public:
 	virtual void		ProcessSample( float* in, float* out );
+	virtual void		ProcessSamples( float* samples, const int numSamples );
+
+private:
+	void				GetCoefs( float coefs[5] ) const;
 };
 
 class SoundFX_LowpassFast : public SoundFX {
@@ -333,6 +343,7 @@ class SoundFX_LowpassFast : public SoundFX {
 
 public:
 	virtual void		ProcessSample( float* in, float* out );
+	virtual void		ProcessSamples( float* samples, const int numSamples );
 	void				SetParms( float p1 = 0, float p2 = 0, float p3 = 0 );
 };
 
@@ -342,6 +353,7 @@ class SoundFX_Comb : public SoundFX {
 public:
 	virtual void		Initialize();
 	virtual void		ProcessSample( float* in, float* out );
+	virtual void		ProcessSamples( float* samples, const int numSamples );
 };
 
 class FracTime {
@@ -399,7 +411,7 @@ public:
 	void				Clear( void );
 	void				Start( void );
 	void				Stop( void );
-	void				GatherChannelSamples( int sampleOffset44k, int sampleCount44k, float *dest ) const;
+	void				GatherChannelSamples( int sampleOffset44k, int sampleCount44k, float *dest, bool parallel = false ) const;
 	void				ALStop( void );			// free OpenAL resources if any
 
 	bool				triggerState;
@@ -422,8 +434,21 @@ public:
 
 	bool				disallowSlow;
 
+	int					decodeAheadIndex;		// into idSoundWorldLocal::decodeAhead while MixLoop runs, -1 if not decoded ahead
+
+	bool				virtualChannel;			// too quiet to be heard, neither decoded nor mixed, restarts at its current position
 };
 
+static const int MAX_PORTAL_TRACE_DEPTH = 10;
+
+// the portals a chain found by idSoundWorldLocal::ResolveOrigin passes
+// through, from the area of the emitter to the area of the listener
+typedef struct soundPortalPath_s {
+	int					numPortals;
+	const idWinding *	windings[MAX_PORTAL_TRACE_DEPTH];
+	float				losses[MAX_PORTAL_TRACE_DEPTH];	// sound loss of each portal (in dB)
+} soundPortalPath_t;
+
 class SoundChainResults // grayman #3042
 {
 public:
@@ -432,6 +457,7 @@ public:
 	idVec3				spatializedOrigin; // where the sound seems to come from
 	float				distance; // path distance back to the sound emitter
 	float				spatialDistance; // distance back to the spacializedOrigin
+	soundPortalPath_t	path; // the portals of the loudest chain
 };
 
 class idSoundEmitterLocal : public idSoundEmitter {
@@ -475,6 +501,7 @@ public:
 	void				OverrideParms( const soundShaderParms_t *base, const soundShaderParms_t *over, soundShaderParms_t *out );
 	void				CheckForCompletion( int current44kHzTime );
 	void				Spatialize( idVec3 listenerPos, int listenerArea, idRenderWorld *rw );
+	float				MaxChannelVolume( float dist, int current44kHz );
 
 	idSoundWorldLocal *	soundWorld;				// the world that holds this emitter
 
@@ -500,6 +527,19 @@ public:
 													// it may go through a chain of portals.  If there
 													// is not an open-portal path, distance will be > maxDistance
 
+	// the portal chains ResolveOrigin found from the emitter to the listener area, they only
+	// have to be searched again when one of the things the search depends on changes,
+	// otherwise the virtual origin is moved along them with the listener
+	bool				occlusionCached;
+	int					occlusionSoundArea;
+	int					occlusionListenerArea;
+	int					occlusionPortalState;		// idRenderWorld::GetPortalStateCount
+	idVec3				occlusionOrigin;
+	float				occlusionVolume;
+	float				occlusionMinDistance;
+	float				occlusionMaxDistance;
+	idList<soundPortalPath_t> occlusionPaths;		// one per audible chain, empty if none is
+
 	// a single soundEmitter can have many channels playing from the same point
 	idSoundChannel		channels[SOUND_MAX_CHANNELS];
 
@@ -544,6 +584,19 @@ public:
 	int		activeSounds;
 };
 
+// the mixer cost, recorded for each mix
+static const int SOUND_PERF_MIXES = 64;
+
+typedef struct soundPerfMix_s {
+	float	mixTime;
+	float	decodeTime;
+	int		activeChannels;
+	int		virtualChannels;
+	int		occlusionSearches;
+	int		occlusionWalks;
+	int		streamUnderruns;
+} soundPerfMix_t;
+
 typedef struct soundPortalTrace_s {
 	int		portalArea;
 	const struct soundPortalTrace_s	*prevStack;
@@ -623,9 +676,14 @@ public:
 	void					AddChannelContribution( idSoundEmitterLocal *sound, idSoundChannel *chan,
 												int current44kHz, int numSpeakers, float *finalMixBuffer );
 	void					MixLoop( int current44kHz, int numSpeakers, float *finalMixBuffer );
+	void					RecordPerfMix( float mixTime );
+	void					DecodeAhead( int current44kHz );
+	void					GatherDecodedSamples( idSoundChannel *chan, int sampleOffset44k, int sampleCount44k, float *dest );
 	void					AVIUpdate( void );
 	float					GetDiffractionLoss(const idVec3 p1, const idVec3 p2, const idVec3 p3); // grayman #4219
 	bool					ResolveOrigin( const int stackDepth, const soundPortalTrace_t *prevStack, const int soundArea, const float dist, const float loss, const idVec3& soundOrigin, const idVec3& prevSoundOrigin, idSoundEmitterLocal *def , SoundChainResults *results); // grayman #3042 // grayman #4219
+	bool					ResolveCachedOrigin( idSoundEmitterLocal *def, SoundChainResults *results );
+	void					CombineChainResults( const int stackDepth, const idList<SoundChainResults *> &chainResults, const idSoundEmitterLocal *def, SoundChainResults *results );
 	float					FindAmplitude( idSoundEmitterLocal *sound, const int localTime, const idVec3 *listenerPosition, const s_channelType channel, bool shakesOnly );
 
 	//============================================
@@ -660,6 +718,17 @@ public:
 	bool					slowmoActive;
 	float					slowmoSpeed;
 	bool					enviroSuitActive;
+
+	// the samples of the compressed channels MixLoop is going to mix, decoded on worker threads
+	static const int		MAX_DECODE_AHEAD_CHANNELS = 64;
+	typedef struct decodeAheadChannel_s {
+		idSoundChannel *	chan;
+		int					sampleOffset44k;
+		int					sampleCount44k;
+		float				samples[MIXBUFFER_SAMPLES*2];
+	} decodeAheadChannel_t;
+	decodeAheadChannel_t	decodeAhead[MAX_DECODE_AHEAD_CHANNELS];
+	int						numDecodeAhead;
 };
 
 /*
@@ -700,6 +769,7 @@ public:
 	virtual int				AsyncUpdate( int time );
 	// async loop, when the sound driver uses a write strategy
 	virtual int				AsyncUpdateWrite( int time );
+	virtual void			UpdateStreams( void );
 	// direct mixing called from the sound driver thread for OSes that support it
 	virtual int				AsyncMix( int soundTime, float *mixBuffer );
 
@@ -708,6 +778,7 @@ public:
 	virtual cinData_t		ImageForTime( const int milliseconds, const bool waveform );
 
 	int						GetSoundDecoderInfo( int index, soundDecoderInfo_t &decoderInfo );
+	virtual void			GetSoundPerfInfo( soundPerfInfo_t &perfInfo );
 
 	// if rw == NULL, no portal occlusion or rendered debugging is available
 	virtual idSoundWorld	*AllocSoundWorld( idRenderWorld *rw );
@@ -730,6 +801,7 @@ public:
 
 	int						GetCurrent44kHzTime( void ) const;
 	float					dB2Scale( const float val ) const;
+	float					GetAudibleVolume( void ) const;		// channels mixed quieter than this are virtual
 	int						SamplesToMilliseconds( int samples ) const;
 	int						MillisecondsToSamples( int ms ) const;
 
@@ -758,6 +830,11 @@ public:
 
 	s_stats					soundStats;				// NOTE: updated throughout the code, not displayed anywhere
 
+	soundPerfMix_t			perfMixes[SOUND_PERF_MIXES];	// the last mixes, s_showPerf and soundPerf
+	int						numPerfMixes;			// recorded since the sound system started
+	soundPerfMix_t			perfPending;			// counted by the main thread for the next mix
+	int						perfStreamUnderruns;
+
 	int						meterTops[256];
 	int						meterTopsTime[256];
 
@@ -802,6 +879,8 @@ public:
 	static idCVar			s_constantAmplitude;
 	static idCVar			s_playDefaultSound;
 	static idCVar			s_useOcclusion;
+	static idCVar			s_cacheOcclusion;
+	static idCVar			s_showPerf;
 	static idCVar			s_subFraction;
 	static idCVar			s_globalFraction;
 	static idCVar			s_doorDistanceAdd;
@@ -815,6 +894,10 @@ public:
 	static idCVar			s_useEAXReverb;
 	static idCVar			s_muteEAXReverb;
 	static idCVar			s_decompressionLimit;
+	static idCVar			s_streamingLimit;
+	static idCVar			s_parallelDecode;
+	static idCVar			s_residencyMegs;
+	static idCVar			s_virtualChannelVolume;
 
 	static idCVar			s_slowAttenuate;
 
@@ -861,11 +944,15 @@ public:
 	bool					onDemand;
 	bool					purged;
 	bool					levelLoadReferenced;		// so we can tell which samples aren't needed any more
+	int						residencyLevel;				// the last level load that referenced it, see idLevelResidency
+	bool					decodePending;				// the OGG is decompressed into its hardware buffer by idSoundCache::EndLevelLoad
+	bool					streamed;					// the OGG isn't kept in memory, the decoders read it with an idSoundStream
 
 	int						LengthIn44kHzSamples() const;
 	ID_TIME_T		 			GetNewTimeStamp( void ) const;
 	void					MakeDefault();				// turns it into a beep
-	void					Load();						// loads the current sound based on name
+	void					Load( bool deferDecode = false );	// loads the current sound based on name
+	void					LoadDecodedOGG( float *destData );	// creates the hardware buffer from the decompressed OGG
 	void					Reload( bool force );		// reloads if timestamp has changed, or always if force
 	void					PurgeSoundSample();			// frees all data
 	void					CheckForDownSample();		// down sample if required
@@ -893,8 +980,84 @@ public:
 	virtual					~idSampleDecoder( void ) {}
 	virtual void			Decode( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest ) = 0;
 	virtual void			ClearDecoder( void ) = 0;
+
+	// several decoders may decode on different threads between BeginParallelDecode and EndParallelDecode,
+	// with the Locked versions, as the calling thread already holds the decoder lock
+	static void				BeginParallelDecode( void );
+	static void				EndParallelDecode( void );
+	static int				GetNumFreeOggDecoders( void );	// the OGG streams which can be opened with the free decoder memory
+	virtual void			DecodeLocked( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest ) = 0;
+	virtual void			ClearDecoderLocked( void ) = 0;
 	virtual idSoundSample *	GetSample( void ) const = 0;
 	virtual int				GetLastDecodeTime( void ) const = 0;
+	virtual float			GetLastDecodeMsec( void ) const = 0;		// the time spent decoding at the last decode time
+	virtual bool			GetLastDecodeStarved( void ) const = 0;		// the stream of the sample ran out of data at the last decode time
+};
+
+
+/*
+===================================================================================
+
+  Sound stream.
+
+  The compressed data of a streamed sample for the decoder playing it. The main
+  thread reads the file ahead into a ring buffer with the async reads of the file
+  system, the decoder only takes what has arrived. The streams can't seek, a decoder
+  skips forward by decoding and starts over from the beginning to go back. The file
+  is read on from its beginning after the end, so a looping sound starts over without
+  waiting for the main thread.
+
+===================================================================================
+*/
+
+const int SOUND_STREAM_BUFFER_SIZE			= 128 * 1024;
+const int SOUND_STREAM_READ_SIZE			= 32 * 1024;
+const int SOUND_STREAM_MIN_DATA				= 32 * 1024;	// the decoder waits for this much, more than an OGG page
+const int MAX_SOUND_STREAMS					= 32;
+
+typedef enum {
+	STREAM_FREE,
+	STREAM_REQUESTED,			// waiting for the main thread to open the file
+	STREAM_OPENING,
+	STREAM_ACTIVE,
+	STREAM_RELEASED				// waiting for the main thread to close the file
+} soundStreamState_t;
+
+class idSoundStream {
+public:
+	// called by the decoders, holding the decoder lock
+	static idSoundStream *	Acquire( const idSoundSample *sample );	// NULL if all streams are in use
+	void					Release( void );
+	int						Read( void *dest, int size );
+	int						Available( void ) const;		// the bytes which have arrived and weren't read yet
+	bool					AtEnd( void ) const;			// the rest of the file has arrived
+	void					Rewind( void );					// nothing is available until the main thread started over
+
+	// called by the main thread
+	static void				UpdateStreams( void );
+	static void				Shutdown( void );
+	static int				GetNumActiveStreams( void );
+
+private:
+	void					Update( void );
+	void					Close( void );
+
+	volatile soundStreamState_t	state;
+	const idSoundSample *	sample;
+	idFile *				file;
+	asyncRead_t *			pendingRead;
+	byte *					buffer;					// SOUND_STREAM_BUFFER_SIZE bytes
+	int						fileLength;
+	int						fileOffset;				// of the next read, the file continues with its beginning after the end
+	bool					readFailed;
+
+	// positions in the stream of the file repeated, the buffer index is the position modulo the buffer size
+	int						readPos;				// of the next byte the decoder reads
+	int						writePos;				// of the end of the data which has arrived
+	int						readLapEnd;				// of the end of the file the decoder reads, a rewind skips here
+	volatile bool			rewindRequested;
+
+	static idSoundStream	streams[MAX_SOUND_STREAMS];
 };
 
 
@@ -924,8 +1087,11 @@ public:
 	void					PrintMemInfo( MemInfo_t *mi );
 
 private:
+	void					DecodePendingSamples();
+
 	bool					insideLevelLoad;
 	idList<idSoundSample*>	listCache;
+	idLevelResidency		residency;					// keeps samples of earlier levels within s_residencyMegs
 };
 
 #endif /* !__SND_LOCAL_H__ */
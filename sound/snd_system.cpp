@@ -34,6 +34,8 @@ idCVar idSoundSystemLocal::s_quadraticFalloff( "s_quadraticFalloff", "1", CVAR_S
 idCVar idSoundSystemLocal::s_drawSounds( "s_drawSounds", "0", CVAR_SOUND | CVAR_INTEGER, "1 = draw audible sounds (within max distance), 2 = draw all", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
 idCVar idSoundSystemLocal::s_showStartSound( "s_showStartSound", "0", CVAR_SOUND | CVAR_BOOL, "" );
 idCVar idSoundSystemLocal::s_useOcclusion( "s_useOcclusion", "1", CVAR_SOUND | CVAR_BOOL, "" );
+idCVar idSoundSystemLocal::s_showPerf( "s_showPerf", "0", CVAR_SOUND | CVAR_BOOL, "show the mix and decode time, the channels, portal searches and underruns of the last mixes" );
+idCVar idSoundSystemLocal::s_cacheOcclusion( "s_cacheOcclusion", "1", CVAR_SOUND | CVAR_BOOL, "only search the portals between an emitter and the listener again when the emitter moves, the listener changes area or a portal changes, otherwise follow the chains found before" );
 idCVar idSoundSystemLocal::s_maxSoundsPerShader( "s_maxSoundsPerShader", "0", CVAR_SOUND | CVAR_ARCHIVE, "", 0, 10, idCmdSystem::ArgCompletion_Integer<0,10> );
 idCVar idSoundSystemLocal::s_showLevelMeter( "s_showLevelMeter", "0", CVAR_SOUND | CVAR_BOOL, "" );
 idCVar idSoundSystemLocal::s_constantAmplitude( "s_constantAmplitude", "-1", CVAR_SOUND | CVAR_FLOAT, "" );
@@ -62,6 +64,10 @@ idCVar idSoundSystemLocal::s_reverbTime( "s_reverbTime", "1000", CVAR_SOUND | CV
 idCVar idSoundSystemLocal::s_reverbFeedback( "s_reverbFeedback", "0.333", CVAR_SOUND | CVAR_FLOAT, "" );
 idCVar idSoundSystemLocal::s_enviroSuitVolumeScale( "s_enviroSuitVolumeScale", "0.9", CVAR_SOUND | CVAR_FLOAT, "" );
 idCVar idSoundSystemLocal::s_skipHelltimeFX( "s_skipHelltimeFX", "0", CVAR_SOUND | CVAR_BOOL, "" );
+idCVar idSoundSystemLocal::s_virtualChannelVolume( "s_virtualChannelVolume", "-60", CVAR_SOUND | CVAR_FLOAT, "channels quieter than this, in dB, are virtual: they skip the portal occlusion, decoding and mixing and free their OpenAL source until they get louder", -60.0f, 0.0f );
+idCVar idSoundSystemLocal::s_streamingLimit( "s_streamingLimit", "30", CVAR_SOUND | CVAR_INTEGER | CVAR_ARCHIVE, "OGGs longer than this many seconds aren't kept in memory but streamed from the file system while they play, 0 keeps all of them in memory", 0, 3600 );
+idCVar idSoundSystemLocal::s_residencyMegs( "s_residencyMegs", "64", CVAR_SOUND | CVAR_ARCHIVE | CVAR_FLOAT, "MB the sound samples of earlier levels may keep after a level load, the least recently used ones are purged first" );
+idCVar idSoundSystemLocal::s_parallelDecode( "s_parallelDecode", "1", CVAR_SOUND | CVAR_BOOL, "decode the compressed sounds of several channels, and the ones decompressed at level load, on worker threads" );
 
 #if ID_OPENAL
 // off by default. OpenAL DLL gets loaded on-demand
@@ -139,7 +145,7 @@ void ListSounds_f( const idCmdArgs &args ) {
 
 		const char *stereo = ( info.nChannels == 2 ? "ST" : "  " );
 		const char *format = ( info.wFormatTag == WAVE_FORMAT_TAG_OGG ) ? "OGG" : "WAV";
-		const char *defaulted = ( sample->defaultSound ? "(DEFAULTED)" : sample->purged ? "(PURGED)" : "" );
+		const char *defaulted = ( sample->defaultSound ? "(DEFAULTED)" : sample->purged ? "(PURGED)" : sample->streamed ? "(STREAMED)" : "" );
 
 		common->Printf( "%s %dkHz %6dms %5dkB %4s %s%s\n", stereo, sample->objectInfo.nSamplesPerSec / 1000,
 					soundSystemLocal.SamplesToMilliseconds( sample->LengthIn44kHzSamples() ),
@@ -159,6 +165,65 @@ void ListSounds_f( const idCmdArgs &args ) {
 	common->Printf( "%8d kB total system memory used\n", totalMemory >> 10 );
 }
 
+/*
+===============
+SoundPerf_f
+
+prints the mixer cost of the last mixes and the decoders of the last one,
+writes the recorded mixes to the given file for a spreadsheet
+===============
+*/
+void SoundPerf_f( const idCmdArgs &args ) {
+	soundPerfInfo_t perfInfo;
+	soundDecoderInfo_t decoderInfo;
+	int index = -1;
+
+	soundSystemLocal.GetSoundPerfInfo( perfInfo );
+
+	common->Printf( "over the last %d mixes of %d msec:\n", perfInfo.numMixes, soundSystemLocal.SamplesToMilliseconds( MIXBUFFER_SAMPLES ) );
+	common->Printf( "%6.2f msec mix time, %.2f peak\n", perfInfo.mixTime, perfInfo.peakMixTime );
+	common->Printf( "%6.2f msec decode time, %.2f peak\n", perfInfo.decodeTime, perfInfo.peakDecodeTime );
+	common->Printf( "%6.1f portal searches, %.1f cached portal chain walks per mix\n", perfInfo.occlusionSearches, perfInfo.occlusionWalks );
+	common->Printf( "%d active channels, %d virtual channels, %d streams\n", perfInfo.activeChannels, perfInfo.virtualChannels, perfInfo.activeStreams );
+	common->Printf( "%d missed mixes, %d stream underruns since the sound system started\n", perfInfo.underruns, perfInfo.streamUnderruns );
+
+	while( ( index = soundSystemLocal.GetSoundDecoderInfo( index, decoderInfo ) ) != -1 ) {
+		common->Printf( "%6.3f msec %s: %s\n", decoderInfo.decodeTime, decoderInfo.format.c_str(), decoderInfo.name.c_str() );
+	}
+
+	if ( args.Argc() < 2 ) {
+		return;
+	}
+
+	idStr fileName = args.Argv( 1 );
+	fileName.DefaultFileExtension( ".tsv" );
+
+	idFile *f = fileSystem->OpenFileWrite( fileName );
+	if ( !f ) {
+		common->Warning( "Couldn't write %s", fileName.c_str() );
+		return;
+	}
+
+	Sys_EnterCriticalSection();
+	int numMixes = Min( soundSystemLocal.numPerfMixes, SOUND_PERF_MIXES );
+	int firstMix = soundSystemLocal.numPerfMixes - numMixes;
+	soundPerfMix_t mixes[SOUND_PERF_MIXES];
+	for ( int i = 0; i < numMixes; i++ ) {
+		mixes[i] = soundSystemLocal.perfMixes[( firstMix + i ) % SOUND_PERF_MIXES];
+	}
+	Sys_LeaveCriticalSection();
+
+	f->Printf( "mix\tmix msec\tdecode msec\tactive channels\tvirtual channels\tportal searches\tportal walks\tstream underruns\n" );
+	for ( int i = 0; i < numMixes; i++ ) {
+		const soundPerfMix_t &mix = mixes[i];
+		f->Printf( "%d\t%.3f\t%.3f\t%d\t%d\t%d\t%d\t%d\n", firstMix + i, mix.mixTime, mix.decodeTime, mix.activeChannels,
+			mix.virtualChannels, mix.occlusionSearches, mix.occlusionWalks, mix.streamUnderruns );
+	}
+
+	fileSystem->CloseFile( f );
+	common->Printf( "wrote %s\n", fileName.c_str() );
+}
+
 /*
 ===============
 ListSoundDecoders_f
@@ -244,6 +309,7 @@ void ListSoundDecoders_f( const idCmdArgs &args ) {
 	common->Printf( "%d waiting decoders\n", numWaitingDecoders );
 	common->Printf( "%d active decoders\n", numActiveDecoders );
 	common->Printf( "%d kB decoder memory in %d blocks\n", idSampleDecoder::GetUsedBlockMemory() >> 10, idSampleDecoder::GetNumUsedBlocks() );
+	common->Printf( "%d of %d streams in use, %d kB buffers\n", idSoundStream::GetNumActiveStreams(), MAX_SOUND_STREAMS, ( idSoundStream::GetNumActiveStreams() * SOUND_STREAM_BUFFER_SIZE ) >> 10 );
 }
 
 /*
@@ -306,6 +372,11 @@ void idSoundSystemLocal::Init() {
 	memset( meterTops, 0, sizeof( meterTops ) );
 	memset( meterTopsTime, 0, sizeof( meterTopsTime ) );
 
+	memset( perfMixes, 0, sizeof( perfMixes ) );
+	memset( &perfPending, 0, sizeof( perfPending ) );
+	numPerfMixes = 0;
+	perfStreamUnderruns = 0;
+
 	for( int i = -600; i < 600; i++ ) {
 		float pt = i * 0.1f;
 		volumesDB[i+600] = pow( 2.0f,( pt * ( 1.0f / 6.0f ) ) );
@@ -411,6 +482,7 @@ void idSoundSystemLocal::Init() {
 
 	cmdSystem->AddCommand( "listSounds", ListSounds_f, CMD_FL_SOUND, "lists all sounds" );
 	cmdSystem->AddCommand( "listSoundDecoders", ListSoundDecoders_f, CMD_FL_SOUND, "list active sound decoders" );
+	cmdSystem->AddCommand( "soundPerf", SoundPerf_f, CMD_FL_SOUND, "prints the mixer cost of the last mixes, writes them to the given file" );
 	cmdSystem->AddCommand( "reloadSounds", SoundReloadSounds_f, CMD_FL_SOUND|CMD_FL_CHEAT, "reloads all sounds" );
 	cmdSystem->AddCommand( "testSound", TestSound_f, CMD_FL_SOUND | CMD_FL_CHEAT, "tests a sound", idCmdSystem::ArgCompletion_SoundName );
 	cmdSystem->AddCommand( "s_restart", SoundSystemRestart_f, CMD_FL_SOUND, "restarts the sound system" );
@@ -758,6 +830,7 @@ int idSoundSystemLocal::AsyncUpdateWrite( int inTime ) {
 
 	if ( nextWriteBlock != dwCurrentBlock ) {
 		Sys_Printf( "missed %d sound updates\n", dwCurrentBlock - nextWriteBlock );
+		soundStats.missedUpdateWindow += dwCurrentBlock - nextWriteBlock;
 	}
 
 	int sampleTime = dwCurrentBlock * MIXBUFFER_SAMPLES;	
@@ -820,6 +893,30 @@ float idSoundSystemLocal::dB2Scale( const float val ) const {
 	return volumesDB[ival];
 }
 
+/*
+===================
+idSoundSystemLocal::GetAudibleVolume
+===================
+*/
+float idSoundSystemLocal::GetAudibleVolume( void ) const {
+	return Max( SND_EPSILON, dB2Scale( s_virtualChannelVolume.GetFloat() ) );
+}
+
+/*
+===================
+idSoundSystemLocal::UpdateStreams
+
+  this is called from the main thread
+===================
+*/
+void idSoundSystemLocal::UpdateStreams( void ) {
+	if ( !isInitialized ) {
+		return;
+	}
+
+	idSoundStream::UpdateStreams();
+}
+
 /*
 ===================
 idSoundSystemLocal::ImageForTime
@@ -1026,6 +1123,7 @@ int idSoundSystemLocal::GetSoundDecoderInfo( int index, soundDecoderInfo_t &deco
 			decoderInfo.lastVolume = chan->lastVolume;
 			decoderInfo.start44kHzTime = chan->trigger44kHzTime;
 			decoderInfo.current44kHzTime = soundSystemLocal.GetCurrent44kHzTime();
+			decoderInfo.decodeTime = ( chan->decoder->GetLastDecodeTime() == soundSystemLocal.CurrentSoundTime ) ? chan->decoder->GetLastDecodeMsec() : 0.0f;
 
 			return ( i * SOUND_MAX_CHANNELS + j );
 		}
@@ -1035,6 +1133,45 @@ int idSoundSystemLocal::GetSoundDecoderInfo( int index, soundDecoderInfo_t &deco
 	return -1;
 }
 
+/*
+===================
+idSoundSystemLocal::GetSoundPerfInfo
+===================
+*/
+void idSoundSystemLocal::GetSoundPerfInfo( soundPerfInfo_t &perfInfo ) {
+	memset( &perfInfo, 0, sizeof( perfInfo ) );
+
+	// the mixer thread may be recording a mix
+	Sys_EnterCriticalSection();
+
+	perfInfo.numMixes = Min( numPerfMixes, SOUND_PERF_MIXES );
+	for ( int i = 0; i < perfInfo.numMixes; i++ ) {
+		const soundPerfMix_t &mix = perfMixes[i];
+
+		perfInfo.mixTime += mix.mixTime;
+		perfInfo.peakMixTime = Max( perfInfo.peakMixTime, mix.mixTime );
+		perfInfo.decodeTime += mix.decodeTime;
+		perfInfo.peakDecodeTime = Max( perfInfo.peakDecodeTime, mix.decodeTime );
+		perfInfo.occlusionSearches += mix.occlusionSearches;
+		perfInfo.occlusionWalks += mix.occlusionWalks;
+	}
+	if ( perfInfo.numMixes > 0 ) {
+		const soundPerfMix_t &last = perfMixes[( numPerfMixes - 1 ) % SOUND_PERF_MIXES];
+
+		perfInfo.mixTime /= perfInfo.numMixes;
+		perfInfo.decodeTime /= perfInfo.numMixes;
+		perfInfo.occlusionSearches /= perfInfo.numMixes;
+		perfInfo.occlusionWalks /= perfInfo.numMixes;
+		perfInfo.activeChannels = last.activeChannels;
+		perfInfo.virtualChannels = last.virtualChannels;
+	}
+	perfInfo.activeStreams = idSoundStream::GetNumActiveStreams();
+	perfInfo.underruns = soundStats.missedWindow + soundStats.missedUpdateWindow;
+	perfInfo.streamUnderruns = perfStreamUnderruns;
+
+	Sys_LeaveCriticalSection();
+}
+
 /*
 ===================
 idSoundSystemLocal::AllocSoundWorld
@@ -1203,7 +1340,9 @@ ALuint idSoundSystemLocal::AllocOpenALSource( idSoundChannel *chan, bool looping
 			if ( !openalSources[index].looping ) {
 				openalSources[index].chan->Stop();
 			} else {
+				// resumes at its current position when it gets a source again
 				openalSources[index].chan->triggered = true;
+				openalSources[index].chan->virtualChannel = true;
 			}
 
 			// Free hardware resources
@@ -1263,24 +1402,38 @@ SoundFX and misc effects
 idSoundSystemLocal::ProcessSample
 ===================
 */
-void SoundFX_Lowpass::ProcessSample( float* in, float* out ) {
-	float c, a1, a2, a3, b1, b2;
+void SoundFX_Lowpass::GetCoefs( float coefs[5] ) const {
+	float c;
 	float resonance = idSoundSystemLocal::s_enviroSuitCutoffQ.GetFloat();
 	float cutoffFrequency = idSoundSystemLocal::s_enviroSuitCutoffFreq.GetFloat();
 
-	Initialize();
-
 	c = 1.0 / idMath::Tan16( idMath::PI * cutoffFrequency / 44100 );
 
 	// compute coefs
-	a1 = 1.0 / ( 1.0 + resonance * c + c * c );
-	a2 = 2* a1;
-	a3 = a1;
-	b1 = 2.0 * ( 1.0 - c * c) * a1;
-	b2 = ( 1.0 - resonance * c + c * c ) * a1;
+	coefs[0] = 1.0 / ( 1.0 + resonance * c + c * c );
+	coefs[1] = 2 * coefs[0];
+	coefs[2] = coefs[0];
+	coefs[3] = 2.0 * ( 1.0 - c * c) * coefs[0];
+	coefs[4] = ( 1.0 - resonance * c + c * c ) * coefs[0];
+}
+
+void SoundFX_Lowpass::ProcessSample( float* in, float* out ) {
+	float coefs[5];
+
+	Initialize();
+	GetCoefs( coefs );
 
 	// compute output value
-	out[0] = a1 * in[0] + a2 * in[-1] + a3 * in[-2] - b1 * out[-1] - b2 * out[-2];
+	out[0] = coefs[0] * in[0] + coefs[1] * in[-1] + coefs[2] * in[-2] - coefs[3] * out[-1] - coefs[4] * out[-2];
+}
+
+void SoundFX_Lowpass::ProcessSamples( float* samples, const int numSamples ) {
+	float coefs[5];
+
+	Initialize();
+	GetCoefs( coefs );
+
+	SIMDProcessor->SoundBiquadFilter( samples, numSamples, 1, coefs, continuitySamples );
 }
 
 void SoundFX_LowpassFast::ProcessSample( float* in, float* out ) {
@@ -1288,6 +1441,12 @@ void SoundFX_LowpassFast::ProcessSample( float* in, float* out ) {
 	out[0] = a1 * in[0] + a2 * in[-1] + a3 * in[-2] - b1 * out[-1] - b2 * out[-2];
 }
 
+void SoundFX_LowpassFast::ProcessSamples( float* samples, const int numSamples ) {
+	const float coefs[5] = { a1, a2, a3, b1, b2 };
+
+	SIMDProcessor->SoundBiquadFilter( samples, numSamples, 1, coefs, continuitySamples );
+}
+
 void SoundFX_LowpassFast::SetParms( float p1, float p2, float p3 ) {
 	float c;
 
@@ -1333,14 +1492,44 @@ void SoundFX_Comb::ProcessSample( float* in, float* out ) {
 		currentTime -= len;
 }
 
+void SoundFX_Comb::ProcessSamples( float* samples, const int numSamples ) {
+	float gain = idSoundSystemLocal::s_reverbFeedback.GetFloat();
+	int len = idMath::ClampInt( 1, 50000, idSoundSystemLocal::s_reverbTime.GetFloat() + param );
+
+	Initialize();
+
+	if ( currentTime >= len ) {
+		currentTime %= len;
+	}
+
+	float *feedback = (float *)_alloca16( numSamples * sizeof( float ) );
+
+	// each sample of the delay line is used at most once until it wraps around
+	for ( int i = 0; i < numSamples; ) {
+		int count = Min( numSamples - i, len - currentTime );
+		float *delay = buffer + currentTime;
+
+		// output the delayed samples and feed the input back into the delay line
+		SIMDProcessor->Mul( feedback, gain, delay, count );
+		SIMDProcessor->Add( feedback, feedback, samples + i, count );
+		SIMDProcessor->Memcpy( samples + i, delay, count * sizeof( float ) );
+		SIMDProcessor->Memcpy( delay, feedback, count * sizeof( float ) );
+
+		i += count;
+		currentTime += count;
+		if ( currentTime >= len ) {
+			currentTime -= len;
+		}
+	}
+}
+
 /*
 ===================
 idSoundSystemLocal::DoEnviroSuit
 ===================
 */
 void idSoundSystemLocal::DoEnviroSuit( float* samples, int numSamples, int numSpeakers ) {
-	float out[10000], *out_p = out + 2;
-	float in[10000], *in_p = in + 2;
+	float *speakerSamples = (float *)_alloca16( numSamples * sizeof( float ) );
 
 	assert( !idSoundSystemLocal::useOpenAL );
 
@@ -1367,14 +1556,16 @@ void idSoundSystemLocal::DoEnviroSuit( float* samples, int numSamples, int numSp
 		}
 	}
 
+	const float volumeScale = s_enviroSuitVolumeScale.GetFloat();
+
 	for ( int i = 0; i < numSpeakers; i++ ) {
 		int j;
 
-		// restore previous samples
-		memset( in, 0, 10000 * sizeof( float ) );
-		memset( out, 0, 10000 * sizeof( float ) );
+		for ( j = 0; j < numSamples; j++ ) {
+			speakerSamples[j] = samples[j * numSpeakers + i];
+		}
 
-		// fx loop
+		// fx loop, the fx keep their continuity samples
 		for ( int k = 0; k < fxList.Num(); k++ ) {
 			SoundFX* fx = fxList[k];
 
@@ -1382,23 +1573,12 @@ void idSoundSystemLocal::DoEnviroSuit( float* samples, int numSamples, int numSp
 			if ( fx->GetChannel() != i )
 				continue;
 
-			// get samples and continuity
-			fx->GetContinuitySamples( in_p[-1], in_p[-2], out_p[-1], out_p[-2] );
-			for ( j = 0; j < numSamples; j++ ) {
-				in_p[j] = samples[j * numSpeakers + i] * s_enviroSuitVolumeScale.GetFloat();
-			}
-
-			// process fx loop
-			for ( j = 0; j < numSamples; j++ ) {
-				fx->ProcessSample( in_p + j, out_p + j );
-			}
-
-			// store samples and continuity
-			fx->SetContinuitySamples( in_p[numSamples-2], in_p[numSamples-3], out_p[numSamples-2], out_p[numSamples-3] );
+			SIMDProcessor->Mul( speakerSamples, volumeScale, speakerSamples, numSamples );
+			fx->ProcessSamples( speakerSamples, numSamples );
+		}
 
-			for ( j = 0; j < numSamples; j++ ) {
-				samples[j * numSpeakers + i] = out_p[j];
-			}
+		for ( j = 0; j < numSamples; j++ ) {
+			samples[j * numSpeakers + i] = speakerSamples[j];
 		}
 	}
 }
@@ -64,6 +64,8 @@ void idSoundWorldLocal::Init( idRenderWorld *renderWorld ) {
 	slowmoActive		= false;
 	slowmoSpeed			= 0;
 	enviroSuitActive	= false;
+
+	numDecodeAhead		= 0;
 }
 
 /*
@@ -411,6 +413,7 @@ for AVIdemo writing
 ===================
 */
 void idSoundWorldLocal::MixLoop( int current44kHz, int numSpeakers, float *finalMixBuffer ) {
+	PROFILE_SCOPE( "MixLoop" );
 	int i, j;
 	idSoundEmitterLocal *sound;
 
@@ -446,16 +449,8 @@ void idSoundWorldLocal::MixLoop( int current44kHz, int numSpeakers, float *final
 #if ID_OPENAL
 		if ( soundSystemLocal.s_useEAXReverb.GetBool() ) {
 			if ( soundSystemLocal.efxloaded ) {
-				idSoundEffect *effect = NULL;
-				int EnvironmentID = -1;
-				idStr defaultStr( "default" );
-				idStr listenerAreaStr( listenerArea );
-				
-				soundSystemLocal.EFXDatabase.FindEffect( listenerAreaStr, &effect, &EnvironmentID );
-				if (!effect)
-					soundSystemLocal.EFXDatabase.FindEffect( listenerAreaName, &effect, &EnvironmentID );
-				if (!effect)
-					soundSystemLocal.EFXDatabase.FindEffect( defaultStr, &effect, &EnvironmentID );
+				int EnvironmentID = soundSystemLocal.EFXDatabase.FindListenerEffect( listenerArea, listenerAreaName );
+				idSoundEffect *effect = ( EnvironmentID != -1 ) ? soundSystemLocal.EFXDatabase.effects[EnvironmentID] : NULL;
 				
 				// only update if change in settings 
 				if ( soundSystemLocal.s_muteEAXReverb.GetBool() || ( listenerEnvironmentID != EnvironmentID ) ) {
@@ -499,6 +494,13 @@ void idSoundWorldLocal::MixLoop( int current44kHz, int numSpeakers, float *final
 		return;
 	}
 
+	idTimer mixTimer;
+	mixTimer.Start();
+
+	if ( idSoundSystemLocal::s_parallelDecode.GetBool() ) {
+		DecodeAhead( current44kHz );
+	}
+
 	for ( i = 1; i < emitters.Num(); i++ ) {
 		sound = emitters[i];
 
@@ -523,9 +525,72 @@ void idSoundWorldLocal::MixLoop( int current44kHz, int numSpeakers, float *final
 		}
 	}
 
+	// the samples of channels which weren't mixed after all are dropped
+	for ( i = 0; i < numDecodeAhead; i++ ) {
+		decodeAhead[i].chan->decodeAheadIndex = -1;
+	}
+	numDecodeAhead = 0;
+
 	if ( !idSoundSystemLocal::useOpenAL && enviroSuitActive ) {
 		soundSystemLocal.DoEnviroSuit( finalMixBuffer, MIXBUFFER_SAMPLES, numSpeakers );
 	}
+
+	mixTimer.Stop();
+	RecordPerfMix( mixTimer.Milliseconds() );
+}
+
+/*
+===================
+idSoundWorldLocal::RecordPerfMix
+
+Adds the cost of the mix to the last mixes of the sound system, along with the
+channels mixed and the portal searches of the main thread since the last mix.
+===================
+*/
+void idSoundWorldLocal::RecordPerfMix( float mixTime ) {
+	soundPerfMix_t &mix = soundSystemLocal.perfMixes[soundSystemLocal.numPerfMixes % SOUND_PERF_MIXES];
+
+	mix.mixTime = mixTime;
+	mix.decodeTime = 0.0f;
+	mix.activeChannels = 0;
+	mix.virtualChannels = 0;
+	mix.streamUnderruns = 0;
+
+	// the decoders of the mix are the ones which decoded at this sound time
+	for ( int i = 1; i < emitters.Num(); i++ ) {
+		idSoundEmitterLocal *sound = emitters[i];
+
+		if ( !sound || !sound->playing ) {
+			continue;
+		}
+		for ( int j = 0; j < SOUND_MAX_CHANNELS; j++ ) {
+			const idSoundChannel *chan = &sound->channels[j];
+
+			if ( !chan->triggerState ) {
+				continue;
+			}
+			if ( chan->virtualChannel ) {
+				mix.virtualChannels++;
+				continue;
+			}
+			mix.activeChannels++;
+
+			if ( chan->decoder != NULL && chan->decoder->GetLastDecodeTime() == soundSystemLocal.CurrentSoundTime ) {
+				mix.decodeTime += chan->decoder->GetLastDecodeMsec();
+				if ( chan->decoder->GetLastDecodeStarved() ) {
+					mix.streamUnderruns++;
+				}
+			}
+		}
+	}
+
+	mix.occlusionSearches = soundSystemLocal.perfPending.occlusionSearches;
+	mix.occlusionWalks = soundSystemLocal.perfPending.occlusionWalks;
+	soundSystemLocal.perfPending.occlusionSearches = 0;
+	soundSystemLocal.perfPending.occlusionWalks = 0;
+
+	soundSystemLocal.perfStreamUnderruns += mix.streamUnderruns;
+	soundSystemLocal.numPerfMixes++;
 }
 
 //==============================================================================
@@ -719,6 +784,107 @@ float idSoundWorldLocal::GetDiffractionLoss(const idVec3 p1, const idVec3 p2, co
 	return (idSoundSystemLocal::s_diffractionMax.GetFloat()*(angle / 180.0f));
 }
 
+/*
+===================
+PortalSoundOrigin
+
+The point on a portal a sound coming from soundOrigin seems to come from for the listener
+===================
+*/
+static idVec3 PortalSoundOrigin( const idWinding *w, const idVec3 &soundOrigin, const idVec3 &listener ) {
+#if 1
+	idVec3 source;
+
+	idPlane	pl;
+	w->GetPlane( pl );
+
+	float  scale;
+	idVec3 dir = listener - soundOrigin;
+	if ( !pl.RayIntersection( soundOrigin, dir, scale ) )
+	{
+		source = w->GetCenter();
+	}
+	else
+	{
+		source = soundOrigin + scale * dir;
+
+		// if this point isn't inside the portal edges, slide it in
+		for ( int i = 0 ; i < w->GetNumPoints() ; i++ )
+		{
+			int j = ( i + 1 ) % w->GetNumPoints();
+			idVec3	edgeDir = (*w)[j].ToVec3() - (*w)[i].ToVec3();
+			idVec3	edgeNormal;
+
+			edgeNormal.Cross( pl.Normal(), edgeDir );
+
+			idVec3 fromVert = source - (*w)[j].ToVec3();
+
+			float d = edgeNormal * fromVert;
+			if ( d > 0 )
+			{
+				// move it in
+				float div = edgeNormal.Normalize();
+				d /= div;
+				source -= d * edgeNormal;
+			}
+		}
+	}
+#else
+	// clip the ray from the listener to the center of the portal by
+	// all the portal edge planes, then project that point (or the original if not clipped)
+	// onto the portal plane to get the spatialized origin
+
+	idVec3	start = listener;
+	idVec3	mid = w->GetCenter();
+	bool	wasClipped = false;
+
+	for ( int i = 0 ; i < w->GetNumPoints() ; i++ ) {
+		int j = ( i + 1 ) % w->GetNumPoints();
+		idVec3	v1 = (*w)[j].ToVec3() - soundOrigin;
+		idVec3	v2 = (*w)[i].ToVec3() - soundOrigin;
+
+		v1.Normalize();
+		v2.Normalize();
+
+		idVec3	edgeNormal;
+
+		edgeNormal.Cross( v1, v2 );
+
+		idVec3	fromVert = start - soundOrigin;
+		float	d1 = edgeNormal * fromVert;
+
+		if ( d1 > 0.0f ) {
+			fromVert = mid - (*w)[j].ToVec3();
+			float d2 = edgeNormal * fromVert;
+
+			// move it in
+			float	f = d1 / ( d1 - d2 );
+
+			idVec3	clipped = start * ( 1.0f - f ) + mid * f;
+			start = clipped;
+			wasClipped = true;
+		}
+	}
+
+	idVec3	source;
+	if ( wasClipped ) {
+		// now project it onto the portal plane
+		idPlane	pl;
+		w->GetPlane( pl );
+
+		float	f1 = pl.Distance( start );
+		float	f2 = pl.Distance( soundOrigin );
+
+		float	f = f1 / ( f1 - f2 );
+		source = start * ( 1.0f - f ) + soundOrigin * f;
+	} else {
+		source = soundOrigin;
+	}
+#endif
+
+	return source;
+}
+
 /*
 ===================
 idSoundWorldLocal::ResolveOrigin
@@ -734,8 +900,6 @@ If there is no path through open portals from the sound to the listener, def->di
 set at maxDistance
 ===================
 */
-static const int MAX_PORTAL_TRACE_DEPTH = 10;
-
 bool idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTrace_t *prevStack, const int soundArea, const float dist, const float loss, const idVec3& soundOrigin, const idVec3& prevSoundOrigin, idSoundEmitterLocal *def , SoundChainResults *results) // grayman #3042 // grayman #4219
 {
 	if ( dist >= def->distance )
@@ -783,6 +947,7 @@ bool idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTr
 		results->spatializedOrigin = soundOrigin;
 		results->loss = loss + angularLoss; // grayman #3042 - total accumulated volume loss across portals
 		results->spatialDistance = distToListener;
+		results->path.numPortals = 0;
 		return true;
 	}
 
@@ -836,95 +1001,7 @@ bool idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTr
 		}
 
 		// pick a point on the portal to serve as our virtual sound origin
-#if 1
-		idVec3 source;
-
-		idPlane	pl;
-		re.w->GetPlane( pl );
-
-		float  scale;
-		idVec3 dir = listenerQU - soundOrigin;
-		if ( !pl.RayIntersection( soundOrigin, dir, scale ) )
-		{
-			source = re.w->GetCenter();
-		}
-		else
-		{
-			source = soundOrigin + scale * dir;
-
-			// if this point isn't inside the portal edges, slide it in
-			for ( int i = 0 ; i < re.w->GetNumPoints() ; i++ )
-			{
-				int j = ( i + 1 ) % re.w->GetNumPoints();
-				idVec3	edgeDir = (*(re.w))[j].ToVec3() - (*(re.w))[i].ToVec3();
-				idVec3	edgeNormal;
-
-				edgeNormal.Cross( pl.Normal(), edgeDir );
-
-				idVec3 fromVert = source - (*(re.w))[j].ToVec3();
-
-				float d = edgeNormal * fromVert;
-				if ( d > 0 )
-				{
-					// move it in
-					float div = edgeNormal.Normalize();
-					d /= div;
-					source -= d * edgeNormal;
-				}
-			}
-		}
-#else
-		// clip the ray from the listener to the center of the portal by
-		// all the portal edge planes, then project that point (or the original if not clipped)
-		// onto the portal plane to get the spatialized origin
-
-		idVec3	start = listenerQU;
-		idVec3	mid = re.w->GetCenter();
-		bool	wasClipped = false;
-
-		for ( int i = 0 ; i < re.w->GetNumPoints() ; i++ ) {
-			int j = ( i + 1 ) % re.w->GetNumPoints();
-			idVec3	v1 = (*(re.w))[j].ToVec3() - soundOrigin;
-			idVec3	v2 = (*(re.w))[i].ToVec3() - soundOrigin;
-
-			v1.Normalize();
-			v2.Normalize();
-
-			idVec3	edgeNormal;
-
-			edgeNormal.Cross( v1, v2 );
-
-			idVec3	fromVert = start - soundOrigin;
-			float	d1 = edgeNormal * fromVert;
-
-			if ( d1 > 0.0f ) {
-				fromVert = mid - (*(re.w))[j].ToVec3();
-				float d2 = edgeNormal * fromVert;
-
-				// move it in
-				float	f = d1 / ( d1 - d2 );
-
-				idVec3	clipped = start * ( 1.0f - f ) + mid * f;
-				start = clipped;
-				wasClipped = true;
-			}
-		}
-
-		idVec3	source;
-		if ( wasClipped ) {
-			// now project it onto the portal plane
-			idPlane	pl;
-			re.w->GetPlane( pl );
-
-			float	f1 = pl.Distance( start );
-			float	f2 = pl.Distance( soundOrigin );
-
-			float	f = f1 / ( f1 - f2 );
-			source = start * ( 1.0f - f ) + soundOrigin * f;
-		} else {
-			source = soundOrigin;
-		}
-#endif
+		idVec3 source = PortalSoundOrigin( re.w, soundOrigin, listenerQU );
 
 		idVec3 tlen = source - soundOrigin;
 		float tlenLength = tlen.LengthFast();
@@ -943,6 +1020,17 @@ bool idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTr
 
 		if ( ResolveOrigin( stackDepth+1, &newStack, otherArea, dist+tlenLength, loss + re.lossPlayer + angularLoss/* + waterLoss*/, source, trailingSoundOrigin, def, res ) ) // grayman #3042
 		{
+			// put this portal in front of the chain found from the other area
+			soundPortalPath_t &path = res->path;
+			for ( int i = path.numPortals ; i > 0 ; i-- )
+			{
+				path.windings[i] = path.windings[i-1];
+				path.losses[i] = path.losses[i-1];
+			}
+			path.windings[0] = re.w;
+			path.losses[0] = re.lossPlayer;
+			path.numPortals++;
+
 			chainResults.Append(res);
 		} 
         else 
@@ -953,103 +1041,200 @@ bool idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTr
 
 	if ( chainResults.Num() > 0 ) // were there any usable results?
 	{
-		// get results from each chain and average
+		if ( stackDepth == 0 )
+		{
+			// remember the chains, so the next updates can follow them without a search
+			def->occlusionPaths.SetNum( chainResults.Num(), false );
+			for ( int i = 0 ; i < chainResults.Num() ; i++ )
+			{
+				def->occlusionPaths[i] = chainResults[i]->path;
+			}
+		}
 
-		int numChains = chainResults.Num();
+		CombineChainResults( stackDepth, chainResults, def, results );
 
-		float aveLoss = 0;
-		float aveDist = 0;
-		idVec3 aveSpatialOrigin(0,0,0);
+        // we're done with the SoundChainResults, so remove them from the heap
+        chainResults.DeleteContents(true);
 
-		// special case of only 1 chain
+		return true;
+	}
 
-		if ( numChains == 1 )
-		{
-			aveSpatialOrigin = chainResults[0]->spatializedOrigin;
-			aveDist = chainResults[0]->distance;
-			aveLoss = chainResults[0]->loss;
-		}
+	return false;
+}
+
+/*
+===================
+idSoundWorldLocal::CombineChainResults
+
+The results of the loudest of the chains found through the portals of an area,
+with the origin of all of them weighted by their volume at the top of the stack
+===================
+*/
+void idSoundWorldLocal::CombineChainResults( const int stackDepth, const idList<SoundChainResults *> &chainResults, const idSoundEmitterLocal *def, SoundChainResults *results )
+{
+	// get results from each chain and average
+
+	int numChains = chainResults.Num();
+
+	float aveLoss = 0;
+	float aveDist = 0;
+	idVec3 aveSpatialOrigin(0,0,0);
+	int pickMe = 0;
 
-		else // 2 or more chains
-		// grayman #3042 use the highest volume in this chain
-		// determine effective volume at the spatialized origin
+	// special case of only 1 chain
+
+	if ( numChains == 1 )
+	{
+		aveSpatialOrigin = chainResults[0]->spatializedOrigin;
+		aveDist = chainResults[0]->distance;
+		aveLoss = chainResults[0]->loss;
+	}
+
+	else // 2 or more chains
+	// grayman #3042 use the highest volume in this chain
+	// determine effective volume at the spatialized origin
+	{
+		float maxVol = -100000.0f;
+		float mind = def->minDistance * METERS_TO_DOOM;
+		float maxd = def->maxDistance * METERS_TO_DOOM;
+		bool quadratic = idSoundSystemLocal::s_quadraticFalloff.GetBool();
+		idList<float> volList; // list of effective chain volumes
+		volList.Clear();
+
+		for ( int i = 0 ; i < numChains ; i++ )
 		{
-			float maxVol = -100000.0f;
-			int pickMe = 0;
-			float mind = def->minDistance * METERS_TO_DOOM;
-			float maxd = def->maxDistance * METERS_TO_DOOM;
-			bool quadratic = idSoundSystemLocal::s_quadraticFalloff.GetBool();
-			idList<float> volList; // list of effective chain volumes
-			volList.Clear();
-	
-			for ( int i = 0 ; i < numChains ; i++ )
-			{
-				SoundChainResults *scr = chainResults[i];
-				float dlen = scr->distance;
-				float vol = soundSystemLocal.dB2Scale(def->parms.volume - scr->loss);
+			SoundChainResults *scr = chainResults[i];
+			float dlen = scr->distance;
+			float vol = soundSystemLocal.dB2Scale(def->parms.volume - scr->loss);
 
-				// reduce effective volume based on distance
-				if ( dlen >= maxd )
-				{
-					vol = 0.0f;
-				}
-				else if ( dlen > mind )
+			// reduce effective volume based on distance
+			if ( dlen >= maxd )
+			{
+				vol = 0.0f;
+			}
+			else if ( dlen > mind )
+			{
+				float frac = idMath::ClampFloat( 0.0f, 1.0f, 1.0f - ((dlen - mind) / (maxd - mind)));
+				if (quadratic)
 				{
-					float frac = idMath::ClampFloat( 0.0f, 1.0f, 1.0f - ((dlen - mind) / (maxd - mind)));
-					if (quadratic)
-					{
-						frac *= frac;
-					}
-					vol *= frac;
+					frac *= frac;
 				}
+				vol *= frac;
+			}
 
-				volList.Append(vol); // add to list of effective chain volumes
-			
-				if ( vol > maxVol )
-				{
-					pickMe = i;
-					maxVol = vol;
-				}
+			volList.Append(vol); // add to list of effective chain volumes
+		
+			if ( vol > maxVol )
+			{
+				pickMe = i;
+				maxVol = vol;
 			}
+		}
 
-			SoundChainResults *scr = chainResults[pickMe];
-			aveLoss = scr->loss;
-			aveDist = scr->distance;
+		SoundChainResults *scr = chainResults[pickMe];
+		aveLoss = scr->loss;
+		aveDist = scr->distance;
 
-			// if stackDepth is 0, determine a spatial origin derived from all effective chain volumes.
-			if ( stackDepth == 0 )
+		// if stackDepth is 0, determine a spatial origin derived from all effective chain volumes.
+		if ( stackDepth == 0 )
+		{
+			float totalEffectiveVolume = 0;
+			for ( int i = 0 ; i < volList.Num() ; i++ )
 			{
-				float totalEffectiveVolume = 0;
-				for ( int i = 0 ; i < volList.Num() ; i++ )
-				{
-					totalEffectiveVolume += volList[i];
-				}
+				totalEffectiveVolume += volList[i];
+			}
 
-				for ( int i = 0 ; i < volList.Num() ; i++ )
-				{
-					SoundChainResults *scr1 = chainResults[i];
-					float factor = volList[i]/totalEffectiveVolume;
-					aveSpatialOrigin += (scr1->spatializedOrigin)*factor;
-				}
+			for ( int i = 0 ; i < volList.Num() ; i++ )
+			{
+				SoundChainResults *scr1 = chainResults[i];
+				float factor = volList[i]/totalEffectiveVolume;
+				aveSpatialOrigin += (scr1->spatializedOrigin)*factor;
 			}
-			else
+		}
+		else
+		{
+			aveSpatialOrigin = scr->spatializedOrigin; // use the spatial origin for this chain path
+		}
+	}
+
+	results->spatializedOrigin = aveSpatialOrigin;
+	results->distance = aveDist;
+	results->loss = aveLoss;
+	results->spatialDistance = (aveSpatialOrigin - listenerQU).LengthFast();
+	results->path = chainResults[pickMe]->path;
+}
+
+/*
+===================
+idSoundWorldLocal::ResolveCachedOrigin
+
+Follows the portal chains the last ResolveOrigin of the emitter found, from the current
+listener position. The virtual origin slides over the portals like it would in a new
+search, but a chain the search skipped when the listener was farther away stays unused
+until the next search.
+===================
+*/
+bool idSoundWorldLocal::ResolveCachedOrigin( idSoundEmitterLocal *def, SoundChainResults *results )
+{
+	int numPaths = def->occlusionPaths.Num();
+	if ( numPaths == 0 )
+	{
+		return false;
+	}
+
+	idList<SoundChainResults> chains;
+	idList<SoundChainResults *> chainResults;
+	chains.SetNum( numPaths );
+	chainResults.SetGranularity( numPaths );
+
+	for ( int i = 0 ; i < numPaths ; i++ )
+	{
+		const soundPortalPath_t &path = def->occlusionPaths[i];
+		idVec3 soundOrigin = def->origin;
+		idVec3 prevSoundOrigin = def->origin;
+		float dist = 0.0f;
+		float loss = 0.0f;
+
+		for ( int j = 0 ; j < path.numPortals ; j++ )
+		{
+			idVec3 source = PortalSoundOrigin( path.windings[j], soundOrigin, listenerQU );
+
+			if ( !soundOrigin.Compare(prevSoundOrigin,VECTOR_EPSILON) )
 			{
-				aveSpatialOrigin = scr->spatializedOrigin; // use the spatial origin for this chain path
+				loss += GetDiffractionLoss(prevSoundOrigin, soundOrigin, source);
 			}
+			dist += (source - soundOrigin).LengthFast();
+			loss += path.losses[j];
+
+			prevSoundOrigin = soundOrigin;
+			soundOrigin = source;
 		}
 
-        // we're done with the SoundChainResults, so remove them from the heap
-        chainResults.DeleteContents(true);
+		float distToListener = (soundOrigin - listenerQU).LengthFast();
+		loss += GetDiffractionLoss(prevSoundOrigin, soundOrigin, listenerQU);
 
-		results->spatializedOrigin = aveSpatialOrigin;
-		results->distance = aveDist;
-		results->loss = aveLoss;
-		results->spatialDistance = (aveSpatialOrigin - listenerQU).LengthFast();
+		// the same limits the search applies
+		if ( ( dist + distToListener ) >= def->distance || soundSystemLocal.dB2Scale(def->parms.volume - loss) < SND_EPSILON )
+		{
+			continue;
+		}
 
-		return true;
+		SoundChainResults &chain = chains[i];
+		chain.distance = dist + distToListener;
+		chain.spatializedOrigin = soundOrigin;
+		chain.loss = loss;
+		chain.spatialDistance = distToListener;
+		chain.path = path;
+		chainResults.Append( &chain );
 	}
 
-	return false;
+	if ( chainResults.Num() == 0 )
+	{
+		return false;
+	}
+
+	CombineChainResults( 0, chainResults, def, results );
+	return true;
 }
 
 
@@ -1728,6 +1913,129 @@ void idSoundWorldLocal::CalcEars( int numSpeakers, idVec3 spatializedOrigin, idV
 	}
 }
 
+/*
+===============
+idSoundWorldLocal::DecodeAhead
+
+Decodes the compressed samples AddChannelContribution is going to fetch in this mix
+for all audible channels at once, in parallel. Only the first OpenAL streaming
+buffer of a channel is decoded ahead, as the number of processed buffers can
+still grow until the channel is mixed.
+this is called from the async thread
+===============
+*/
+void idSoundWorldLocal::DecodeAhead( int current44kHz ) {
+	const float audibleVolume = soundSystemLocal.GetAudibleVolume();
+
+	numDecodeAhead = 0;
+
+	for ( int i = 1; i < emitters.Num() && numDecodeAhead < MAX_DECODE_AHEAD_CHANNELS; i++ ) {
+		idSoundEmitterLocal *sound = emitters[i];
+
+		if ( !sound || !sound->playing ) {
+			continue;
+		}
+
+		for ( int j = 0; j < SOUND_MAX_CHANNELS && numDecodeAhead < MAX_DECODE_AHEAD_CHANNELS; j++ ) {
+			idSoundChannel *chan = &sound->channels[j];
+
+			chan->decodeAheadIndex = -1;
+
+			// the channels silent in the last mix usually stay silent
+			if ( !chan->triggerState || chan->lastVolume < audibleVolume || chan->decoder == NULL ) {
+				continue;
+			}
+
+			idSoundSample *sample = chan->leadinSample;
+			const idSoundShader *shader = chan->soundShader;
+			if ( sample == NULL || shader == NULL || ( sample->defaultSound && !idSoundSystemLocal::s_playDefaultSound.GetBool() ) ) {
+				continue;
+			}
+
+			bool looping = ( chan->parms.soundShaderFlags & SSF_LOOPING ) != 0;
+			idSoundSample *loop = looping ? shader->entries[0] : NULL;
+			if ( sample->objectInfo.wFormatTag != WAVE_FORMAT_TAG_OGG && ( loop == NULL || loop->objectInfo.wFormatTag != WAVE_FORMAT_TAG_OGG ) ) {
+				continue;
+			}
+
+			int numChannels = sample->objectInfo.nChannels;
+			int sampleOffset44k, sampleCount44k;
+
+			// the same paths as AddChannelContribution
+			if ( idSoundSystemLocal::useOpenAL && sound->removeStatus < REMOVE_STATUS_SAMPLEFINISHED ) {
+				if ( ( !looping && sample->hardwareBuffer ) || ( looping && loop != NULL && loop->hardwareBuffer ) ) {
+					continue;
+				}
+				if ( !alIsSource( chan->openalSource ) ) {
+					continue;
+				}
+				if ( !chan->triggered ) {
+					ALint finishedbuffers;
+					alGetSourcei( chan->openalSource, AL_BUFFERS_PROCESSED, &finishedbuffers );
+					if ( finishedbuffers == 0 ) {
+						continue;
+					}
+				}
+				sampleOffset44k = chan->openalStreamingOffset * numChannels;
+				sampleCount44k = MIXBUFFER_SAMPLES * numChannels;
+			} else {
+				if ( slowmoActive && !chan->disallowSlow ) {
+					continue;
+				}
+				sampleOffset44k = ( current44kHz - chan->trigger44kHzTime ) * numChannels;
+				sampleCount44k = MIXBUFFER_SAMPLES * numChannels;
+			}
+
+			decodeAheadChannel_t &ahead = decodeAhead[numDecodeAhead];
+			ahead.chan = chan;
+			ahead.sampleOffset44k = sampleOffset44k;
+			ahead.sampleCount44k = sampleCount44k;
+			chan->decodeAheadIndex = numDecodeAhead++;
+		}
+	}
+
+	// a single channel is decoded the usual way
+	if ( numDecodeAhead < 2 ) {
+		if ( numDecodeAhead == 1 ) {
+			decodeAhead[0].chan->decodeAheadIndex = -1;
+		}
+		numDecodeAhead = 0;
+		return;
+	}
+
+	idSampleDecoder::BeginParallelDecode();
+
+	#pragma omp parallel for schedule( dynamic )
+	for ( int i = 0; i < numDecodeAhead; i++ ) {
+		decodeAheadChannel_t &ahead = decodeAhead[i];
+		ahead.chan->GatherChannelSamples( ahead.sampleOffset44k, ahead.sampleCount44k, ahead.samples, true );
+	}
+
+	idSampleDecoder::EndParallelDecode();
+}
+
+/*
+===============
+idSoundWorldLocal::GatherDecodedSamples
+
+Fetches the samples of a channel decoded by DecodeAhead, or decodes them if the
+channel wasn't decoded ahead for this range
+===============
+*/
+void idSoundWorldLocal::GatherDecodedSamples( idSoundChannel *chan, int sampleOffset44k, int sampleCount44k, float *dest ) {
+	if ( chan->decodeAheadIndex >= 0 && chan->decodeAheadIndex < numDecodeAhead ) {
+		const decodeAheadChannel_t &ahead = decodeAhead[chan->decodeAheadIndex];
+		chan->decodeAheadIndex = -1;
+
+		if ( ahead.chan == chan && ahead.sampleOffset44k == sampleOffset44k && ahead.sampleCount44k == sampleCount44k ) {
+			memcpy( dest, ahead.samples, sampleCount44k * sizeof( dest[0] ) );
+			return;
+		}
+	}
+
+	chan->GatherChannelSamples( sampleOffset44k, sampleCount44k, dest );
+}
+
 /*
 ===============
 idSoundWorldLocal::AddChannelContribution
@@ -1904,7 +2212,13 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 	//
 	// do we have anything to add?
 	//
-	if ( volume < SND_EPSILON && chan->lastVolume < SND_EPSILON ) {
+	const float audibleVolume = soundSystemLocal.GetAudibleVolume();
+	if ( volume < audibleVolume && chan->lastVolume < audibleVolume ) {
+		// virtual channel, only its trigger time keeps running
+		if ( idSoundSystemLocal::useOpenAL && alIsSource( chan->openalSource ) ) {
+			chan->ALStop();
+		}
+		chan->virtualChannel = true;
 		return;
 	}
 	chan->lastVolume = volume;
@@ -1926,7 +2240,12 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 		}
 
 		if ( alIsSource( chan->openalSource ) ) {
-			
+
+			// a virtual channel restarts at its current position
+			if ( chan->virtualChannel ) {
+				chan->triggered = true;
+			}
+
 			// stop source if needed..
 			if ( chan->triggered ) {
 				alSourceStop( chan->openalSource );
@@ -1957,7 +2276,19 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 			if ( ( !looping && chan->leadinSample->hardwareBuffer ) || ( looping && chan->soundShader->entries[0]->hardwareBuffer ) ) {
 				// handle uncompressed (non streaming) single shot and looping sounds
 				if ( chan->triggered ) {
-					alSourcei( chan->openalSource, AL_BUFFER, looping ? chan->soundShader->entries[0]->openalBuffer : chan->leadinSample->openalBuffer );
+					idSoundSample *played = looping ? chan->soundShader->entries[0] : chan->leadinSample;
+					alSourcei( chan->openalSource, AL_BUFFER, played->openalBuffer );
+
+					if ( chan->virtualChannel ) {
+						int offset44k = current44kHz - chan->trigger44kHzTime;
+						int length44k = played->LengthIn44kHzSamples() / played->objectInfo.nChannels;
+						if ( looping && length44k > 0 ) {
+							offset44k %= length44k;
+						}
+						if ( offset44k > 0 && offset44k < length44k ) {
+							alSourcei( chan->openalSource, AL_SAMPLE_OFFSET, offset44k / ( 44100 / played->objectInfo.nSamplesPerSec ) );
+						}
+					}
 				}
 			} else {
 				ALint finishedbuffers;
@@ -1965,6 +2296,9 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 
 				// handle streaming sounds (decode on the fly) both single shot AND looping
 				if ( chan->triggered ) {
+					if ( chan->virtualChannel ) {
+						chan->openalStreamingOffset = Max( 0, current44kHz - chan->trigger44kHzTime );
+					}
 					alSourcei( chan->openalSource, AL_BUFFER, NULL );
 					alDeleteBuffers( 3, &chan->lastopenalStreamingBuffer[0] );
 					chan->lastopenalStreamingBuffer[0] = chan->openalStreamingBuffer[0];
@@ -1987,7 +2321,7 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 				}
 
 				for ( j = 0; j < finishedbuffers; j++ ) {
-					chan->GatherChannelSamples( chan->openalStreamingOffset * sample->objectInfo.nChannels, MIXBUFFER_SAMPLES * sample->objectInfo.nChannels, alignedInputSamples );
+					GatherDecodedSamples( chan, chan->openalStreamingOffset * sample->objectInfo.nChannels, MIXBUFFER_SAMPLES * sample->objectInfo.nChannels, alignedInputSamples );
 					for ( int i = 0; i < ( MIXBUFFER_SAMPLES * sample->objectInfo.nChannels ); i++ ) {
 						if ( alignedInputSamples[i] < -32768.0f )
 							((short *)alignedInputSamples)[i] = -32768;
@@ -2010,10 +2344,13 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 				alSourcePlay( chan->openalSource );
 				chan->triggered = false;
 			}
+			chan->virtualChannel = false;
 		}
 	}
 	else
 	{
+		chan->virtualChannel = false;
+
 		if ( slowmoActive && !chan->disallowSlow )
 		{
 			idSlowChannel slow = sound->GetSlowChannel( chan );
@@ -2036,9 +2373,9 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 			// if we are getting a stereo sample adjust accordingly
 			if ( sample->objectInfo.nChannels == 2 ) {
 				// we should probably check to make sure any looping is also to a stereo sample...
-				chan->GatherChannelSamples( offset*2, MIXBUFFER_SAMPLES*2, alignedInputSamples );
+				GatherDecodedSamples( chan, offset*2, MIXBUFFER_SAMPLES*2, alignedInputSamples );
 			} else {
-				chan->GatherChannelSamples( offset, MIXBUFFER_SAMPLES, alignedInputSamples );
+				GatherDecodedSamples( chan, offset, MIXBUFFER_SAMPLES, alignedInputSamples );
 			}
 		}
 
@@ -2228,6 +2565,9 @@ float idSoundWorldLocal::FindAmplitude( idSoundEmitterLocal *sound, const int lo
 			for ( j = 0 ; j < (AMPLITUDE_SAMPLES); j++ ) {
 				sourceBuffer[j] = j & 1 ? 32767.0f : -32767.0f;
 			}
+		} else if ( ( looping ? chan->soundShader->entries[0] : chan->leadinSample )->streamed ) {
+			// a streamed sample can only be decoded in order, by the mixer
+			continue;
 		} else {
 			int offset = (localTime - localTriggerTimes);	// offset in samples
 			int size = ( looping ? chan->soundShader->entries[0]->LengthIn44kHzSamples() : chan->leadinSample->LengthIn44kHzSamples() );
@@ -268,8 +268,24 @@ typedef struct {
 	float					lastVolume;
 	int						start44kHzTime;
 	int						current44kHzTime;
+	float					decodeTime;			// msecs spent decoding in the last mix
 } soundDecoderInfo_t;
 
+typedef struct {
+	int						numMixes;			// the mixes the averages and peaks are taken over
+	float					mixTime;			// average msecs per mix, including the decoding
+	float					peakMixTime;
+	float					decodeTime;			// average msecs per mix spent decoding
+	float					peakDecodeTime;
+	int						activeChannels;		// in the last mix
+	int						virtualChannels;
+	int						activeStreams;
+	float					occlusionSearches;	// full portal searches per mix
+	float					occlusionWalks;		// walks of portal chains cached by an earlier search per mix
+	int						underruns;			// mixes which missed their window, since the sound system started
+	int						streamUnderruns;	// times a streamed channel ran out of data
+} soundPerfInfo_t;
+
 
 class idSoundSystem {
 public:
@@ -296,6 +312,9 @@ public:
 	// async loop, when the sound driver uses a write strategy
 	virtual int				AsyncUpdateWrite( int time ) = 0;
 
+	// reads ahead the sounds which are streamed from the file system, called from the main thread every frame
+	virtual void			UpdateStreams( void ) = 0;
+
 	// it is a good idea to mute everything when starting a new level,
 	// because sounds may be started before a valid listener origin
 	// is specified
@@ -307,6 +326,9 @@ public:
 	// get sound decoder info
 	virtual int				GetSoundDecoderInfo( int index, soundDecoderInfo_t &decoderInfo ) = 0;
 
+	// get the mixer cost over the last mixes
+	virtual void			GetSoundPerfInfo( soundPerfInfo_t &perfInfo ) = 0;
+
 	// if rw == NULL, no portal occlusion or rendered debugging is available
 	virtual idSoundWorld *	AllocSoundWorld( idRenderWorld *rw ) = 0;
 
@@ -79,5 +79,9 @@ void GLimp_DeactivateContext( void ) { }
 
 void GLimp_ActivateContext( void ) { }
 
+void GLimp_ActivateBackEndContext( void ) { }
+
+void GLimp_DeactivateBackEndContext( void ) { }
+
 bool GLimp_SetScreenParms( glimpParms_t parms ) { return true; }
 
@@ -24,6 +24,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <pthread.h>
 
 extern "C" {
 #	include "libXNVCtrl/NVCtrlLib.h"
@@ -51,10 +52,6 @@ static bool vidmode_active = false;
 static int save_rampsize = 0;
 static unsigned short *save_red, *save_green, *save_blue;
 
-void GLimp_WakeBackEnd(void *a) {
-	common->DPrintf("GLimp_WakeBackEnd stub\n");
-}
-
 #ifdef ID_GL_HARDLINK
 void GLimp_EnableLogging(bool log) {
 	static bool logging;
@@ -66,18 +63,230 @@ void GLimp_EnableLogging(bool log) {
 }
 #endif
 
-void GLimp_FrontEndSleep() {
-	common->DPrintf("GLimp_FrontEndSleep stub\n");
+/*
+===========================================================
+
+SMP acceleration
+
+the back end runs on its own thread with a second context that shares
+objects with the front end one, so vertex cache and texture uploads
+issued by the front end are visible to the back end.
+the semantics of the sleep/wake calls match the win32 implementation
+===========================================================
+*/
+
+static GLXContext		smpCtx = NULL;
+static pthread_t		smpThread;
+static bool				smpThreadActive = false;
+static void				(*glimpRenderThread)( void ) = NULL;
+
+static pthread_mutex_t	smpMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t	smpCommandsCond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t	smpCompletedCond = PTHREAD_COND_INITIALIZER;
+static bool				smpCommandsPending = false;
+static bool				smpBackEndIdle = false;
+static void *			smpData = NULL;
+
+// true while the front end is using smpCtx for a synchronous render
+static bool				smpCtxBorrowed = false;
+
+/*
+===================
+GLimp_RenderThreadWrapper
+===================
+*/
+static void *GLimp_RenderThreadWrapper( void *arg ) {
+	glimpRenderThread();
+
+	// unbind the context before we die
+	qglXMakeCurrent( dpy, None, NULL );
+	return NULL;
 }
 
-void *GLimp_BackEndSleep() {
-	common->DPrintf("GLimp_BackEndSleep stub\n");
-	return 0;
+/*
+=======================
+GLimp_SpawnRenderThread
+
+Returns false if the system only has a single processor
+=======================
+*/
+bool GLimp_SpawnRenderThread( void (*function)( void ) ) {
+	assert( dpy );
+	assert( ctx );
+
+	if ( smpThreadActive ) {
+		common->Printf( "GLimp_SpawnRenderThread: render thread already running\n" );
+		return true;
+	}
+
+	if ( sysconf( _SC_NPROCESSORS_ONLN ) < 2 ) {
+		common->Printf( "GLimp_SpawnRenderThread: single processor, not starting render thread\n" );
+		return false;
+	}
+
+	// the back end context shares all textures, buffers and programs with the front end one
+	XWindowAttributes attr;
+	XVisualInfo visTemplate;
+	int numVisuals;
+	XGetWindowAttributes( dpy, win, &attr );
+	visTemplate.visualid = XVisualIDFromVisual( attr.visual );
+	visTemplate.screen = scrnum;
+	XVisualInfo *visinfo = XGetVisualInfo( dpy, VisualIDMask | VisualScreenMask, &visTemplate, &numVisuals );
+	if ( !visinfo ) {
+		common->Printf( "GLimp_SpawnRenderThread: couldn't get the window visual\n" );
+		return false;
+	}
+	smpCtx = qglXCreateContext( dpy, visinfo, ctx, True );
+	XFree( visinfo );
+	if ( !smpCtx ) {
+		common->Printf( "GLimp_SpawnRenderThread: couldn't create the back end context\n" );
+		return false;
+	}
+
+	glimpRenderThread = function;
+	smpCommandsPending = false;
+	smpBackEndIdle = false;
+	smpData = NULL;
+	smpCtxBorrowed = false;
+
+	if ( pthread_create( &smpThread, NULL, GLimp_RenderThreadWrapper, NULL ) != 0 ) {
+		common->Printf( "GLimp_SpawnRenderThread: pthread_create failed\n" );
+		qglXDestroyContext( dpy, smpCtx );
+		smpCtx = NULL;
+		return false;
+	}
+	smpThreadActive = true;
+
+	common->Printf( "render thread started\n" );
+	return true;
+}
+
+/*
+===================
+GLimp_ShutdownRenderThread
+
+wakes the back end with no commands so it falls out of its loop
+===================
+*/
+static void GLimp_ShutdownRenderThread( void ) {
+	if ( !smpThreadActive ) {
+		return;
+	}
+
+	GLimp_DeactivateBackEndContext();
+	GLimp_FrontEndSleep();
+	GLimp_WakeBackEnd( NULL );
+	pthread_join( smpThread, NULL );
+	smpThreadActive = false;
+
+	qglXDestroyContext( dpy, smpCtx );
+	smpCtx = NULL;
+
+	common->Printf( "render thread stopped\n" );
+}
+
+/*
+===================
+GLimp_BackEndSleep
+===================
+*/
+void *GLimp_BackEndSleep( void ) {
+	void	*data;
+
+	// release the context so the front end can borrow it while we are idle
+	qglXMakeCurrent( dpy, None, NULL );
+
+	pthread_mutex_lock( &smpMutex );
+
+	// after this, the front end can exit GLimp_FrontEndSleep
+	smpBackEndIdle = true;
+	pthread_cond_signal( &smpCompletedCond );
+
+	while ( !smpCommandsPending ) {
+		pthread_cond_wait( &smpCommandsCond, &smpMutex );
+	}
+	smpCommandsPending = false;
+	data = smpData;
+
+	pthread_mutex_unlock( &smpMutex );
+
+	if ( data ) {
+		qglXMakeCurrent( dpy, win, smpCtx );
+	}
+
+	return data;
 }
 
-bool GLimp_SpawnRenderThread(void (*a) ()) {
-	common->DPrintf("GLimp_SpawnRenderThread stub\n");
-	return false;
+/*
+===================
+GLimp_FrontEndSleep
+===================
+*/
+void GLimp_FrontEndSleep( void ) {
+	if ( !smpThreadActive ) {
+		return;
+	}
+
+	pthread_mutex_lock( &smpMutex );
+	while ( !smpBackEndIdle ) {
+		pthread_cond_wait( &smpCompletedCond, &smpMutex );
+	}
+	pthread_mutex_unlock( &smpMutex );
+}
+
+/*
+===================
+GLimp_WakeBackEnd
+===================
+*/
+void GLimp_WakeBackEnd( void *data ) {
+	pthread_mutex_lock( &smpMutex );
+
+	if ( !smpBackEndIdle || smpCommandsPending ) {
+		pthread_mutex_unlock( &smpMutex );
+		common->FatalError( "GLimp_WakeBackEnd: already active" );
+	}
+
+	smpData = data;
+	smpBackEndIdle = false;
+	smpCommandsPending = true;
+
+	// after this, the renderer can continue through GLimp_BackEndSleep
+	pthread_cond_signal( &smpCommandsCond );
+
+	pthread_mutex_unlock( &smpMutex );
+}
+
+/*
+===================
+GLimp_ActivateBackEndContext
+
+The back end must be idle. Makes the back end context current on the
+calling thread, so synchronous renders and readbacks see the same
+framebuffer objects the back end draws into.
+===================
+*/
+void GLimp_ActivateBackEndContext( void ) {
+	if ( !smpThreadActive || smpCtxBorrowed ) {
+		return;
+	}
+	qglXMakeCurrent( dpy, win, smpCtx );
+	smpCtxBorrowed = true;
+}
+
+/*
+===================
+GLimp_DeactivateBackEndContext
+
+gives the back end context back and restores the front end one
+===================
+*/
+void GLimp_DeactivateBackEndContext( void ) {
+	if ( !smpCtxBorrowed ) {
+		return;
+	}
+	qglXMakeCurrent( dpy, win, ctx );
+	smpCtxBorrowed = false;
 }
 
 void GLimp_ActivateContext() {
@@ -173,6 +382,8 @@ void GLimp_SetGamma(unsigned short red[256], unsigned short green[256], unsigned
 void GLimp_Shutdown() {
 	if ( dpy ) {
 		
+		GLimp_ShutdownRenderThread();
+
 		Sys_XUninstallGrabs();
 	
 		GLimp_RestoreGamma();
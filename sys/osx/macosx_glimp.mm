@@ -1452,6 +1452,10 @@ void *GLimp_BackEndSleep( void ) {
 void GLimp_WakeBackEnd( void *data ) {
 }
 
+void GLimp_ActivateBackEndContext( void ) { }
+
+void GLimp_DeactivateBackEndContext( void ) { }
+
 // enable / disable context is just for the r_skipRenderContext debug option
 void GLimp_DeactivateContext( void ) {
 	[NSOpenGLContext clearCurrentContext];
@@ -411,6 +411,49 @@ long Sys_FileTimeStamp(FILE * fp) {
 	return st.st_mtime;
 }
 
+/*
+=================
+Sys_MapFileRegion
+
+the mapping stays valid after the file is closed
+=================
+*/
+const void *Sys_MapFileRegion( FILE *fp, int offset, int length, sysFileMapping_t &mapping ) {
+	mapping.base = NULL;
+	mapping.length = 0;
+	mapping.handle = NULL;
+
+	if ( length <= 0 ) {
+		return NULL;
+	}
+
+	// the offset of a mapping must be page aligned
+	int pageSize = sysconf( _SC_PAGESIZE );
+	int pageOffset = offset - offset % pageSize;
+
+	void *base = mmap( NULL, length + ( offset - pageOffset ), PROT_READ, MAP_PRIVATE, fileno( fp ), pageOffset );
+	if ( base == MAP_FAILED ) {
+		return NULL;
+	}
+
+	mapping.base = base;
+	mapping.length = length + ( offset - pageOffset );
+	return (const byte *)base + ( offset - pageOffset );
+}
+
+/*
+=================
+Sys_UnmapFileRegion
+=================
+*/
+void Sys_UnmapFileRegion( sysFileMapping_t &mapping ) {
+	if ( mapping.base ) {
+		munmap( mapping.base, mapping.length );
+	}
+	mapping.base = NULL;
+	mapping.length = 0;
+}
+
 /*
 =================
 Sys_DosToUnixTime
@@ -0,0 +1,516 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+#include "precompiled_engine.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+idCVar sys_jobThreads( "sys_jobThreads", "0", CVAR_SYSTEM | CVAR_INTEGER | CVAR_INIT, "number of job worker threads, 0 = one per core but the main one", 0, 64 );
+
+class idJobListLocal;
+class idJobSystemLocal;
+
+typedef struct {
+	jobRun_t				function;
+	void *					data;
+	idJobListLocal *		list;
+} job_t;
+
+// the containers are std ones, lists are filled and jobs queued by worker threads too,
+// which can't use the engine heap
+typedef struct {
+	std::mutex				lock;
+	std::deque<job_t>		jobs;			// the owner takes from the back, thieves from the front
+} jobQueue_t;
+
+/*
+===============================================================================
+
+	idJobListLocal
+
+===============================================================================
+*/
+
+class idJobListLocal : public idJobList {
+public:
+							idJobListLocal( const char *name, idJobSystemLocal *system );
+
+	virtual void			AddJob( jobRun_t function, void *data );
+	virtual void			AddDependency( idJobList *list );
+	virtual void			Submit( void );
+	virtual void			Wait( void );
+	virtual bool			IsDone( void ) const;
+
+	const char *			GetName( void ) const { return name; }
+
+							// called by the thread that ran one of the jobs
+	void					JobDone( void );
+
+private:
+	const char *			name;
+	idJobSystemLocal *		system;
+
+	std::vector<job_t>		jobs;
+	std::vector<idJobListLocal *> dependencies;
+
+	std::atomic<int>		pendingJobs;	// queued and running jobs
+	std::atomic<int>		waitingOn;		// unfinished dependencies, plus one while Submit runs
+	std::atomic<bool>		done;			// set last, the owner may free the list right after
+
+	std::mutex				lock;			// guards finished and dependents
+	bool					finished;
+	std::vector<idJobListLocal *> dependents;	// submitted lists waiting for this one
+
+	bool					AddDependent( idJobListLocal *list );
+	void					DependencyDone( void );
+	void					QueueJobs( void );
+	void					Finish( void );
+};
+
+/*
+===============================================================================
+
+	idJobSystemLocal
+
+===============================================================================
+*/
+
+class idJobSystemLocal : public idJobSystem {
+public:
+							idJobSystemLocal( void );
+
+	virtual void			Init( void );
+	virtual void			Shutdown( void );
+
+	virtual idJobList *		AllocJobList( const char *name );
+	virtual void			FreeJobList( idJobList *list );
+
+	virtual int				GetNumWorkers( void ) const { return numWorkers; }
+
+	void					QueueJobs( const job_t *jobs, int numJobs );
+							// runs one job of any queue, returns false if there was none
+	bool					RunJob( void );
+
+private:
+	int						numWorkers;
+	std::thread *			workers;
+	int						numQueues;		// one per worker, at least one for the waiting threads
+	jobQueue_t *			queues;
+	std::atomic<int>		nextQueue;		// spreads the jobs of the other threads
+
+	std::atomic<int>		queuedJobs;
+	std::mutex				wakeLock;
+	std::condition_variable	wake;
+	bool					shutdown;
+
+	bool					TakeJob( job_t &job );
+	void					WorkerLoop( int index );
+
+	static void				WorkerThread( idJobSystemLocal *system, int index );
+};
+
+static idJobSystemLocal		jobSystemLocal;
+idJobSystem *				jobSystem = &jobSystemLocal;
+
+// queue of the worker thread, -1 on the other threads
+static ID_THREAD_LOCAL int	currentWorker = -1;
+
+/*
+================
+idJobListLocal::idJobListLocal
+================
+*/
+idJobListLocal::idJobListLocal( const char *name, idJobSystemLocal *system ) :
+	name( name ),
+	system( system ),
+	pendingJobs( 0 ),
+	waitingOn( 0 ),
+	done( true ),
+	finished( true ) {
+}
+
+/*
+================
+idJobListLocal::AddJob
+================
+*/
+void idJobListLocal::AddJob( jobRun_t function, void *data ) {
+	assert( done );
+
+	job_t job;
+	job.function = function;
+	job.data = data;
+	job.list = this;
+	jobs.push_back( job );
+}
+
+/*
+================
+idJobListLocal::AddDependency
+================
+*/
+void idJobListLocal::AddDependency( idJobList *list ) {
+	assert( done && list != this );
+
+	dependencies.push_back( static_cast<idJobListLocal *>( list ) );
+}
+
+/*
+================
+idJobListLocal::Submit
+================
+*/
+void idJobListLocal::Submit( void ) {
+	assert( done );
+
+	{
+		std::lock_guard<std::mutex> guard( lock );
+		finished = false;
+	}
+	done = false;
+	pendingJobs = (int)jobs.size();
+
+	// hold the list back while the dependencies are registered, one of
+	// them could finish meanwhile
+	waitingOn = 1;
+	for ( size_t i = 0; i < dependencies.size(); i++ ) {
+		if ( dependencies[i]->AddDependent( this ) ) {
+			waitingOn++;
+		}
+	}
+	DependencyDone();
+}
+
+/*
+================
+idJobListLocal::Wait
+================
+*/
+void idJobListLocal::Wait( void ) {
+	while ( !done.load( std::memory_order_acquire ) ) {
+		if ( !system->RunJob() ) {
+			std::this_thread::yield();
+		}
+	}
+
+	jobs.clear();
+	dependencies.clear();
+}
+
+/*
+================
+idJobListLocal::IsDone
+================
+*/
+bool idJobListLocal::IsDone( void ) const {
+	return done.load( std::memory_order_acquire );
+}
+
+/*
+================
+idJobListLocal::AddDependent
+
+Returns false if the list is done already
+================
+*/
+bool idJobListLocal::AddDependent( idJobListLocal *list ) {
+	std::lock_guard<std::mutex> guard( lock );
+	if ( finished ) {
+		return false;
+	}
+	dependents.push_back( list );
+	return true;
+}
+
+/*
+================
+idJobListLocal::DependencyDone
+================
+*/
+void idJobListLocal::DependencyDone( void ) {
+	if ( waitingOn.fetch_sub( 1 ) == 1 ) {
+		QueueJobs();
+	}
+}
+
+/*
+================
+idJobListLocal::QueueJobs
+================
+*/
+void idJobListLocal::QueueJobs( void ) {
+	if ( jobs.empty() ) {
+		Finish();
+		return;
+	}
+	system->QueueJobs( &jobs[0], (int)jobs.size() );
+}
+
+/*
+================
+idJobListLocal::JobDone
+================
+*/
+void idJobListLocal::JobDone( void ) {
+	if ( pendingJobs.fetch_sub( 1 ) == 1 ) {
+		Finish();
+	}
+}
+
+/*
+================
+idJobListLocal::Finish
+
+Starts the lists waiting for this one
+================
+*/
+void idJobListLocal::Finish( void ) {
+	std::vector<idJobListLocal *> waiting;
+	{
+		std::lock_guard<std::mutex> guard( lock );
+		finished = true;
+		waiting.swap( dependents );
+	}
+
+	for ( size_t i = 0; i < waiting.size(); i++ ) {
+		waiting[i]->DependencyDone();
+	}
+
+	done.store( true, std::memory_order_release );
+}
+
+/*
+================
+idJobSystemLocal::idJobSystemLocal
+================
+*/
+idJobSystemLocal::idJobSystemLocal( void ) :
+	numWorkers( 0 ),
+	workers( NULL ),
+	numQueues( 0 ),
+	queues( NULL ),
+	nextQueue( 0 ),
+	queuedJobs( 0 ),
+	shutdown( false ) {
+}
+
+/*
+================
+idJobSystemLocal::Init
+================
+*/
+void idJobSystemLocal::Init( void ) {
+	numWorkers = sys_jobThreads.GetInteger();
+	if ( numWorkers == 0 ) {
+		numWorkers = Max( (int)std::thread::hardware_concurrency() - 1, 0 );
+	}
+
+	numQueues = Max( numWorkers, 1 );
+	queues = new jobQueue_t[numQueues];
+	queuedJobs = 0;
+	shutdown = false;
+
+	workers = new std::thread[numWorkers];
+	for ( int i = 0; i < numWorkers; i++ ) {
+		workers[i] = std::thread( WorkerThread, this, i );
+	}
+
+	common->Printf( "%d job worker threads\n", numWorkers );
+}
+
+/*
+================
+idJobSystemLocal::Shutdown
+================
+*/
+void idJobSystemLocal::Shutdown( void ) {
+	assert( queuedJobs == 0 );
+
+	{
+		std::lock_guard<std::mutex> guard( wakeLock );
+		shutdown = true;
+	}
+	wake.notify_all();
+
+	for ( int i = 0; i < numWorkers; i++ ) {
+		workers[i].join();
+	}
+
+	delete[] workers;
+	workers = NULL;
+	delete[] queues;
+	queues = NULL;
+	numWorkers = 0;
+	numQueues = 0;
+}
+
+/*
+================
+idJobSystemLocal::AllocJobList
+================
+*/
+idJobList *idJobSystemLocal::AllocJobList( const char *name ) {
+	return new idJobListLocal( name, this );
+}
+
+/*
+================
+idJobSystemLocal::FreeJobList
+================
+*/
+void idJobSystemLocal::FreeJobList( idJobList *list ) {
+	if ( list ) {
+		assert( list->IsDone() );
+		delete static_cast<idJobListLocal *>( list );
+	}
+}
+
+/*
+================
+idJobSystemLocal::QueueJobs
+
+A worker queues the jobs of its lists on its own queue, the other threads
+spread them over all queues
+================
+*/
+void idJobSystemLocal::QueueJobs( const job_t *jobs, int numJobs ) {
+	queuedJobs += numJobs;
+
+	if ( currentWorker >= 0 ) {
+		jobQueue_t &queue = queues[currentWorker];
+		std::lock_guard<std::mutex> guard( queue.lock );
+		queue.jobs.insert( queue.jobs.end(), jobs, jobs + numJobs );
+	} else {
+		const int first = nextQueue.fetch_add( 1 );
+		for ( int i = 0; i < numQueues && i < numJobs; i++ ) {
+			jobQueue_t &queue = queues[( first + i ) % numQueues];
+			std::lock_guard<std::mutex> guard( queue.lock );
+			for ( int j = i; j < numJobs; j += numQueues ) {
+				queue.jobs.push_back( jobs[j] );
+			}
+		}
+	}
+
+	// a worker that found no jobs is either waiting already or sees the new count
+	{
+		std::lock_guard<std::mutex> guard( wakeLock );
+	}
+	wake.notify_all();
+}
+
+/*
+================
+idJobSystemLocal::TakeJob
+================
+*/
+bool idJobSystemLocal::TakeJob( job_t &job ) {
+	if ( queuedJobs.load( std::memory_order_relaxed ) <= 0 ) {
+		return false;
+	}
+
+	// the newest job of the own queue, its data is likely still in the cache
+	if ( currentWorker >= 0 ) {
+		jobQueue_t &queue = queues[currentWorker];
+		std::lock_guard<std::mutex> guard( queue.lock );
+		if ( !queue.jobs.empty() ) {
+			job = queue.jobs.back();
+			queue.jobs.pop_back();
+			queuedJobs--;
+			return true;
+		}
+	}
+
+	// steal the oldest job of another queue
+	const int first = currentWorker >= 0 ? currentWorker + 1 : 0;
+	for ( int i = 0; i < numQueues; i++ ) {
+		jobQueue_t &queue = queues[( first + i ) % numQueues];
+		std::lock_guard<std::mutex> guard( queue.lock );
+		if ( !queue.jobs.empty() ) {
+			job = queue.jobs.front();
+			queue.jobs.pop_front();
+			queuedJobs--;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+================
+idJobSystemLocal::RunJob
+================
+*/
+bool idJobSystemLocal::RunJob( void ) {
+	job_t job;
+
+	if ( !TakeJob( job ) ) {
+		return false;
+	}
+
+	{
+		PROFILE_SCOPE( job.list->GetName() );
+		job.function( job.data );
+	}
+	job.list->JobDone();
+
+	return true;
+}
+
+/*
+================
+idJobSystemLocal::WorkerLoop
+================
+*/
+void idJobSystemLocal::WorkerLoop( int index ) {
+	currentWorker = index;
+
+	while ( 1 ) {
+		if ( RunJob() ) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> guard( wakeLock );
+		while ( !shutdown && queuedJobs.load() <= 0 ) {
+			wake.wait( guard );
+		}
+		if ( shutdown ) {
+			break;
+		}
+	}
+
+	currentWorker = -1;
+}
+
+/*
+================
+idJobSystemLocal::WorkerThread
+================
+*/
+void idJobSystemLocal::WorkerThread( idJobSystemLocal *system, int index ) {
+	system->WorkerLoop( index );
+}
@@ -41,6 +41,8 @@
 #define ALIGNTYPE16						__declspec(align(16)) // anon
 #define PACKED
 
+#define ID_THREAD_LOCAL					__declspec(thread)
+
 #define _alloca16( x )					((void *)((((int)_alloca( (x)+15 )) + 15) & ~15))
 
 #define PATHSEPERATOR_STR				"\\"
@@ -75,6 +77,8 @@
 #define ALIGN16( x )					x __attribute__ ((aligned (16)))
 #define ALIGNTYPE16						__attribute__ ((aligned (16))) // anon
 
+#define ID_THREAD_LOCAL					__thread
+
 #ifdef __MWERKS__
 #define PACKED
 #include <alloca.h>
@@ -121,6 +125,8 @@
 #define ALIGNTYPE16						 // anon
 #define PACKED							__attribute__((packed))
 
+#define ID_THREAD_LOCAL					__thread
+
 #define PATHSEPERATOR_STR				"/"
 #define PATHSEPERATOR_CHAR				'/'
 
@@ -155,7 +161,10 @@ typedef enum {
 	CPUID_HTT							= 0x01000,	// Hyper-Threading Technology
 	CPUID_CMOV							= 0x02000,	// Conditional Move (CMOV) and fast floating point comparison (FCOMI) instructions
 	CPUID_FTZ							= 0x04000,	// Flush-To-Zero mode (denormal results are flushed to zero)
-	CPUID_DAZ							= 0x08000	// Denormals-Are-Zero mode (denormal source operands are set to zero)
+	CPUID_DAZ							= 0x08000,	// Denormals-Are-Zero mode (denormal source operands are set to zero)
+	CPUID_AVX							= 0x10000,	// Advanced Vector Extensions (with OS support for the YMM state)
+	CPUID_AVX2							= 0x20000,	// Advanced Vector Extensions 2
+	CPUID_FMA							= 0x40000	// Fused Multiply Add (FMA3)
 } cpuid_t;
 
 typedef enum {
@@ -223,7 +232,8 @@ typedef struct sysEvent_s {
 
 typedef unsigned long address_t;
 
-template<class type> class idList;		// for Sys_ListFiles
+template<class type> class idListNewAllocator;
+template<class type, class storage = idListNewAllocator<type> > class idList;		// for Sys_ListFiles
 
 
 void			Sys_Init( void );
@@ -355,6 +365,17 @@ void			Sys_ShowConsole( int visLevel, bool quitOnClose );
 
 void			Sys_Mkdir( const char *path );
 ID_TIME_T		Sys_FileTimeStamp( FILE *fp );
+
+// a read-only memory mapped region of a file
+typedef struct sysFileMapping_s {
+	void *			base;		// of the mapped view, NULL if nothing is mapped
+	int				length;		// of the mapped view
+	void *			handle;		// file mapping object on win32
+} sysFileMapping_t;
+
+// maps length bytes at offset of the open file, returns a pointer to the byte at offset or NULL
+const void *	Sys_MapFileRegion( FILE *fp, int offset, int length, sysFileMapping_t &mapping );
+void			Sys_UnmapFileRegion( sysFileMapping_t &mapping );
 ID_TIME_T       Sys_DosToUnixTime( unsigned long dostime );
 // NOTE: do we need to guarantee the same output on all platforms?
 const char *	Sys_TimeStampToStr( ID_TIME_T timeStamp );
@@ -514,6 +535,56 @@ enum {
 void				Sys_WaitForEvent( int index = TRIGGER_EVENT_ZERO );
 void				Sys_TriggerEvent( int index = TRIGGER_EVENT_ZERO );
 
+/*
+==============================================================
+
+	Job system
+
+	Worker threads, one per core but the main one's, run the jobs of job
+	lists. Every worker has its own queue: it runs its newest job first and
+	steals the oldest jobs of the other queues when its own runs dry. A thread
+	that waits for a list runs jobs too instead of sleeping, so lists can be
+	waited on from inside jobs.
+
+	A list may depend on other lists, its jobs don't start before theirs are
+	done. Submit the lists it depends on first, a list that wasn't submitted
+	counts as done. The jobs of a list show up under its name in the frame
+	profiler captures, the name must be a string literal.
+
+==============================================================
+*/
+
+typedef void (*jobRun_t)( void *data );
+
+class idJobList {
+public:
+	virtual					~idJobList( void ) {}
+
+	virtual void			AddJob( jobRun_t function, void *data ) = 0;
+	virtual void			AddDependency( idJobList *list ) = 0;
+
+							// starts the jobs, no jobs can be added until Wait returned
+	virtual void			Submit( void ) = 0;
+							// runs jobs until the list is done, then it can be filled again
+	virtual void			Wait( void ) = 0;
+	virtual bool			IsDone( void ) const = 0;
+};
+
+class idJobSystem {
+public:
+	virtual					~idJobSystem( void ) {}
+
+	virtual void			Init( void ) = 0;
+	virtual void			Shutdown( void ) = 0;
+
+	virtual idJobList *		AllocJobList( const char *name ) = 0;
+	virtual void			FreeJobList( idJobList *list ) = 0;
+
+	virtual int				GetNumWorkers( void ) const = 0;
+};
+
+extern idJobSystem *		jobSystem;
+
 /*
 ==============================================================
 
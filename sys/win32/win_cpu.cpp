@@ -169,6 +169,7 @@ static void CPUID( int func, unsigned regs[4] ) {
 
 	__asm pusha
 	__asm mov eax, func
+	__asm xor ecx, ecx					// sub-leaf 0 for the functions that have sub-leaves
 	__asm __emit 00fh
 	__asm __emit 0a2h
 	__asm mov regEAX, eax
@@ -328,6 +329,76 @@ static bool HasSSE3( void ) {
 	return false;
 }
 
+/*
+================
+HasAVX
+================
+*/
+static bool HasAVX( void ) {
+	unsigned regs[4];
+	unsigned xcr0;
+
+	// get CPU feature bits
+	CPUID( 1, regs );
+
+	// bit 28 of ECX denotes AVX existence, bit 27 denotes that the OS uses XSAVE
+	if ( ( regs[_REG_ECX] & ( 1 << 28 ) ) == 0 || ( regs[_REG_ECX] & ( 1 << 27 ) ) == 0 ) {
+		return false;
+	}
+
+	// the OS must also save the upper halves of the YMM registers on a context switch
+	__asm xor ecx, ecx
+	__asm __emit 00fh					// xgetbv
+	__asm __emit 001h
+	__asm __emit 0d0h
+	__asm mov xcr0, eax
+
+	if ( ( xcr0 & 6 ) != 6 ) {
+		return false;
+	}
+	return true;
+}
+
+/*
+================
+HasAVX2
+================
+*/
+static bool HasAVX2( void ) {
+	unsigned regs[4];
+
+	// the structured extended feature flags are only available from function 7 on
+	CPUID( 0, regs );
+	if ( regs[_REG_EAX] < 7 ) {
+		return false;
+	}
+
+	// bit 5 of EBX denotes AVX2 existence
+	CPUID( 7, regs );
+	if ( regs[_REG_EBX] & ( 1 << 5 ) ) {
+		return true;
+	}
+	return false;
+}
+
+/*
+================
+HasFMA
+================
+*/
+static bool HasFMA( void ) {
+	unsigned regs[4];
+
+	// get CPU feature bits
+	CPUID( 1, regs );
+
+	// bit 12 of ECX denotes FMA3 existence
+	if ( regs[_REG_ECX] & ( 1 << 12 ) ) {
+		return true;
+	}
+	return false;
+}
+
 /*
 ================
 LogicalProcPerPhysicalProc
@@ -564,6 +635,21 @@ cpuid_t Sys_GetCPUId( void ) {
 		flags |= CPUID_SSE3;
 	}
 
+	// check for Advanced Vector Extensions, the YMM state must be enabled by the OS
+	if ( HasAVX() ) {
+		flags |= CPUID_AVX;
+
+		// check for Advanced Vector Extensions 2
+		if ( HasAVX2() ) {
+			flags |= CPUID_AVX2;
+		}
+
+		// check for Fused Multiply Add
+		if ( HasFMA() ) {
+			flags |= CPUID_FMA;
+		}
+	}
+
 	// check for Hyper-Threading Technology
 	if ( HasHTT() ) {
 		flags |= CPUID_HTT;
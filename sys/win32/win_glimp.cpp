@@ -896,12 +896,28 @@ void GLimp_Shutdown( void ) {
 
 	common->Printf( "Shutting down OpenGL subsystem\n" );
 
+	// let the render thread fall out of its loop
+	if ( win32.renderThreadHandle ) {
+		common->Printf( "...stopping smp thread\n" );
+		GLimp_DeactivateBackEndContext();
+		GLimp_FrontEndSleep();
+		GLimp_WakeBackEnd( NULL );
+		WaitForSingleObject( win32.renderThreadHandle, INFINITE );
+	}
+
 	// set current context to NULL
 	if ( qwglMakeCurrent ) {
 		retVal = qwglMakeCurrent( NULL, NULL ) != 0;
 		common->Printf( "...wglMakeCurrent( NULL, NULL ): %s\n", success[retVal] );
 	}
 
+	// delete the back end HGLRC
+	if ( win32.hGLRCSmp ) {
+		retVal = qwglDeleteContext( win32.hGLRCSmp ) != 0;
+		common->Printf( "...deleting smp GL context: %s\n", success[retVal] );
+		win32.hGLRCSmp = NULL;
+	}
+
 	// delete HGLRC
 	if ( win32.hGLRC ) {
 		retVal = qwglDeleteContext( win32.hGLRC ) != 0;
@@ -1041,6 +1057,20 @@ bool GLimp_SpawnRenderThread( void (*function)( void ) ) {
 	if ( info.dwNumberOfProcessors < 2 ) {
 		return false;
 	}
+
+	// the back end gets its own context that shares all objects with the front end one
+	win32.hGLRCSmp = qwglCreateContext( win32.hDC );
+	if ( !win32.hGLRCSmp ) {
+		common->Printf( "GLimp_SpawnRenderThread: wglCreateContext failed\n" );
+		return false;
+	}
+	if ( !qwglShareLists( win32.hGLRC, win32.hGLRCSmp ) ) {
+		common->Printf( "GLimp_SpawnRenderThread: wglShareLists failed\n" );
+		qwglDeleteContext( win32.hGLRCSmp );
+		win32.hGLRCSmp = NULL;
+		return false;
+	}
+	win32.smpContextBorrowed = false;
 	
 	// create the IPC elements
 	win32.renderCommandsEvent = CreateEvent( NULL, TRUE, FALSE, NULL );
@@ -1086,6 +1116,9 @@ void *GLimp_BackEndSleep( void ) {
 #ifdef DEBUG_PRINTS
 	OutputDebugString( "-->GLimp_BackEndSleep\n" );
 #endif
+	// release the context so the front end can borrow it while we are idle
+	qwglMakeCurrent( win32.hDC, NULL );
+
 	ResetEvent( win32.renderActiveEvent );
 
 	// after this, the front end can exit GLimp_FrontEndSleep
@@ -1098,6 +1131,10 @@ void *GLimp_BackEndSleep( void ) {
 
 	data = win32.smpData;
 
+	if ( data ) {
+		qwglMakeCurrent( win32.hDC, win32.hGLRCSmp );
+	}
+
 	// after this, the main thread can exit GLimp_WakeRenderer
 	SetEvent( win32.renderActiveEvent );
 
@@ -1115,6 +1152,9 @@ GLimp_FrontEndSleep
 ===================
 */
 void GLimp_FrontEndSleep( void ) {
+	if ( !win32.renderThreadHandle ) {
+		return;
+	}
 #ifdef DEBUG_PRINTS
 	OutputDebugString( "-->GLimp_FrontEndSleep\n" );
 #endif
@@ -1169,6 +1209,39 @@ void GLimp_WakeBackEnd( void *data ) {
 #endif
 }
 
+/*
+===================
+GLimp_ActivateBackEndContext
+
+The back end must be idle, see GLimp_FrontEndSleep
+===================
+*/
+void GLimp_ActivateBackEndContext( void ) {
+	if ( !win32.hGLRCSmp || win32.smpContextBorrowed ) {
+		return;
+	}
+	if ( !qwglMakeCurrent( win32.hDC, win32.hGLRCSmp ) ) {
+		win32.wglErrors++;
+	}
+	win32.smpContextBorrowed = true;
+}
+
+/*
+===================
+GLimp_DeactivateBackEndContext
+
+===================
+*/
+void GLimp_DeactivateBackEndContext( void ) {
+	if ( !win32.smpContextBorrowed ) {
+		return;
+	}
+	if ( !qwglMakeCurrent( win32.hDC, win32.hGLRC ) ) {
+		win32.wglErrors++;
+	}
+	win32.smpContextBorrowed = false;
+}
+
 //===================================================================
 
 /*
@@ -137,7 +137,7 @@ typedef struct {
 	static idCVar	win_allowMultipleInstances;
 
 	CRITICAL_SECTION criticalSections[MAX_CRITICAL_SECTIONS];
-	HANDLE			backgroundDownloadSemaphore;
+	HANDLE			triggerEvents[MAX_TRIGGER_EVENTS];
 
 	HINSTANCE		hInstDI;			// direct input
 
@@ -152,6 +152,8 @@ typedef struct {
 	unsigned long	renderThreadId;
 	void			(*glimpRenderThread)( void );
 	void			*smpData;
+	HGLRC			hGLRCSmp;			// back end context, shares lists with hGLRC
+	bool			smpContextBorrowed;	// front end is using hGLRCSmp for a synchronous render
 	int				wglErrors;
 	// SMP acceleration vars
 
@@ -168,12 +168,9 @@ Sys_WaitForEvent
 ==================
 */
 void Sys_WaitForEvent( int index ) {
-	assert( index == 0 );
-	if ( !win32.backgroundDownloadSemaphore ) {
-		win32.backgroundDownloadSemaphore = CreateEvent( NULL, TRUE, FALSE, NULL );
-	}
-	WaitForSingleObject( win32.backgroundDownloadSemaphore, INFINITE );
-	ResetEvent( win32.backgroundDownloadSemaphore );
+	assert( index >= 0 && index < MAX_TRIGGER_EVENTS );
+	// auto reset, a signal raised while no one is waiting stays raised until the next wait
+	WaitForSingleObject( win32.triggerEvents[index], INFINITE );
 }
 
 /*
@@ -182,8 +179,8 @@ Sys_TriggerEvent
 ==================
 */
 void Sys_TriggerEvent( int index ) {
-	assert( index == 0 );
-	SetEvent( win32.backgroundDownloadSemaphore );
+	assert( index >= 0 && index < MAX_TRIGGER_EVENTS );
+	SetEvent( win32.triggerEvents[index] );
 }
 
 
@@ -468,6 +465,66 @@ ID_TIME_T Sys_FileTimeStamp( FILE *fp ) {
 	return (long) st.st_mtime;
 }
 
+/*
+=================
+Sys_MapFileRegion
+
+the mapping stays valid after the file is closed
+=================
+*/
+const void *Sys_MapFileRegion( FILE *fp, int offset, int length, sysFileMapping_t &mapping ) {
+	mapping.base = NULL;
+	mapping.length = 0;
+	mapping.handle = NULL;
+
+	if ( length <= 0 ) {
+		return NULL;
+	}
+
+	HANDLE file = (HANDLE)_get_osfhandle( _fileno( fp ) );
+	if ( file == INVALID_HANDLE_VALUE ) {
+		return NULL;
+	}
+
+	HANDLE fileMapping = CreateFileMapping( file, NULL, PAGE_READONLY, 0, 0, NULL );
+	if ( fileMapping == NULL ) {
+		return NULL;
+	}
+
+	// the offset of a view must be a multiple of the allocation granularity
+	SYSTEM_INFO info;
+	GetSystemInfo( &info );
+	int viewOffset = offset - offset % (int)info.dwAllocationGranularity;
+
+	void *base = MapViewOfFile( fileMapping, FILE_MAP_READ, 0, viewOffset, length + ( offset - viewOffset ) );
+	if ( base == NULL ) {
+		CloseHandle( fileMapping );
+		return NULL;
+	}
+
+	mapping.base = base;
+	mapping.length = length + ( offset - viewOffset );
+	mapping.handle = fileMapping;
+	return (const byte *)base + ( offset - viewOffset );
+}
+
+/*
+=================
+Sys_UnmapFileRegion
+=================
+*/
+void Sys_UnmapFileRegion( sysFileMapping_t &mapping ) {
+	if ( mapping.base ) {
+		UnmapViewOfFile( mapping.base );
+	}
+	if ( mapping.handle ) {
+		CloseHandle( (HANDLE)mapping.handle );
+	}
+	mapping.base = NULL;
+	mapping.length = 0;
+	mapping.handle = NULL;
+}
+
 /*
 =================
 Sys_DosToUnixTime
@@ -1428,6 +1485,10 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLin
 		InitializeCriticalSection( &win32.criticalSections[i] );
 	}
 
+	for ( int i = 0; i < MAX_TRIGGER_EVENTS; i++ ) {
+		win32.triggerEvents[i] = CreateEvent( NULL, FALSE, FALSE, NULL );
+	}
+
 	// get the initial time base
 	Sys_Milliseconds();
 
@@ -74,29 +74,33 @@ public:
 	/**
 	 * greebo: Returns the CRC for the given file. ZIP-archives (PK4s too) will 
 	 * be opened and a cumulative CRC over the archive members will be returned.
+	 * Pass silent = true to keep this off the TraceLog, which is not thread-safe.
 	 *
 	 * @throws: std::runtime_error if something goes wrong.
 	 */
-	static boost::uint32_t GetCrcForFile(const fs::path& file)
+	static boost::uint32_t GetCrcForFile(const fs::path& file, bool silent = false)
 	{
 		try
 		{
 			if (File::IsArchive(file))
 			{
-				return GetCrcForZip(file);
+				return GetCrcForZip(file, silent);
 			}
 			else
 			{
 #ifdef TDM_USE_OLD_CRC
-				return GetCrcForNonZipFileOld(file);
+				return GetCrcForNonZipFileOld(file, silent);
 #else
-				return GetCrcForNonZipFile(file);
+				return GetCrcForNonZipFile(file, silent);
 #endif
 			}
 		}
 		catch (std::runtime_error& ex)
 		{
-			TraceLog::Write(LOG_ERROR, ex.what());
+			if (!silent)
+			{
+				TraceLog::Write(LOG_ERROR, ex.what());
+			}
 			throw ex;
 		}
 	}
@@ -105,7 +109,7 @@ public:
 	// It fails to produce the same CRC as the one found in the ZIP archives
 	// See http://modetwo.net/darkmod/index.php?/topic/11473-problem-with-crcs-and-the-updater/
 
-	static boost::uint32_t GetCrcForNonZipFileOld(const fs::path& file)
+	static boost::uint32_t GetCrcForNonZipFileOld(const fs::path& file, bool silent = false)
 	{
 		// Open the file for reading
 		FILE* fh = fopen(file.string().c_str(), "rb");
@@ -134,14 +138,17 @@ public:
 			break;
 		}
 
-		TraceLog::WriteLine(LOG_VERBOSE, "CRC calculated for file " + file.string() + " = " + (boost::format("%x") % crc).str());
+		if (!silent)
+		{
+			TraceLog::WriteLine(LOG_VERBOSE, "CRC calculated for file " + file.string() + " = " + (boost::format("%x") % crc).str());
+		}
 
 		fclose(fh);
 
 		return crc;
 	}
 	
-	static boost::uint32_t GetCrcForNonZipFile(const fs::path& file)
+	static boost::uint32_t GetCrcForNonZipFile(const fs::path& file, bool silent = false)
 	{
 		// Open the file for reading
 		FILE* fh = fopen(file.string().c_str(), "rb");
@@ -169,14 +176,17 @@ public:
 
 		crc = processor.checksum();
 
-		TraceLog::WriteLine(LOG_VERBOSE, "CRC calculated for file " + file.string() + " = " + (boost::format("%x") % crc).str());
+		if (!silent)
+		{
+			TraceLog::WriteLine(LOG_VERBOSE, "CRC calculated for file " + file.string() + " = " + (boost::format("%x") % crc).str());
+		}
 
 		fclose(fh);
 
 		return crc;
 	}
 
-	static boost::uint32_t GetCrcForZip(const fs::path& file)
+	static boost::uint32_t GetCrcForZip(const fs::path& file, bool silent = false)
 	{
 		// Open the file for reading
 		ZipFileReadPtr zipFile = Zip::OpenFileRead(file);
@@ -185,7 +195,10 @@ public:
 
 		boost::uint32_t crc = zipFile->GetCumulativeCrc();
 
-		TraceLog::WriteLine(LOG_VERBOSE, "CRC calculated for zip file " + file.string() + " = " + (boost::format("%x") % crc).str());
+		if (!silent)
+		{
+			TraceLog::WriteLine(LOG_VERBOSE, "CRC calculated for zip file " + file.string() + " = " + (boost::format("%x") % crc).str());
+		}
 
 		return crc;
 	}
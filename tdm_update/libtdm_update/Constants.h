@@ -50,6 +50,9 @@ const char* const TDM_UDPATE_INFO_FILE = "tdm_update_info.txt";
 // The file containing the version information of all released packages since 1.02
 const char* const TDM_VERSION_INFO_FILE = "tdm_version_info.txt";
 
+// The CRCs of the local files from the previous run, see CrcCache
+const char* const TDM_CRC_CACHE_FILE = "tdm_update_crc_cache.txt";
+
 #ifdef WIN32
 const char* const TDM_UPDATE_UPDATER_BATCH_FILE = "tdm_update_updater.cmd";
 #else
@@ -0,0 +1,267 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod Updater (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+#include "CrcCache.h"
+
+#include <fstream>
+#include <sstream>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/format.hpp>
+#include "CRC.h"
+#include "TraceLog.h"
+
+namespace tdm
+{
+
+CrcCache::CrcCache() :
+	_loaded(false),
+	_queue(NULL),
+	_nextFile(0),
+	_numDone(0),
+	_cancelled(false)
+{}
+
+void CrcCache::Load(const fs::path& cacheFile)
+{
+	if (_loaded && cacheFile == _cacheFile)
+	{
+		return;
+	}
+
+	_entries.clear();
+	_cacheFile = cacheFile;
+	_loaded = true;
+
+	std::ifstream stream(cacheFile.string().c_str());
+
+	if (!stream)
+	{
+		return;
+	}
+
+	// One file per line: crc size mtime path
+	std::string line;
+
+	while (std::getline(stream, line))
+	{
+		std::istringstream lineStream(line);
+
+		Entry entry;
+		std::string path;
+
+		lineStream >> std::hex >> entry.crc >> std::dec >> entry.filesize >> entry.modified;
+		lineStream.ignore(1);
+		std::getline(lineStream, path);
+
+		if (lineStream.fail() || path.empty())
+		{
+			continue;
+		}
+
+		_entries[path] = entry;
+	}
+
+	TraceLog::WriteLine(LOG_VERBOSE, (boost::format("Loaded %d cached CRCs from %s") % _entries.size() % cacheFile.string()).str());
+}
+
+void CrcCache::Save()
+{
+	if (!_loaded)
+	{
+		return;
+	}
+
+	std::ofstream stream(_cacheFile.string().c_str());
+
+	if (!stream)
+	{
+		TraceLog::WriteLine(LOG_VERBOSE, "Could not write CRC cache to " + _cacheFile.string());
+		return;
+	}
+
+	for (Entries::const_iterator i = _entries.begin(); i != _entries.end(); ++i)
+	{
+		if (!fs::exists(i->first))
+		{
+			continue;
+		}
+
+		stream << std::hex << i->second.crc << std::dec << " " << i->second.filesize << " " << i->second.modified << " " << i->first << "\n";
+	}
+}
+
+bool CrcCache::Lookup(const fs::path& file, boost::uintmax_t filesize, std::time_t modified, boost::uint32_t& crc)
+{
+	boost::mutex::scoped_lock lock(_mutex);
+
+	Entries::const_iterator found = _entries.find(file.string());
+
+	if (found == _entries.end() || found->second.filesize != filesize || found->second.modified != modified)
+	{
+		return false;
+	}
+
+	crc = found->second.crc;
+	return true;
+}
+
+void CrcCache::Insert(const fs::path& file, boost::uintmax_t filesize, std::time_t modified, boost::uint32_t crc)
+{
+	boost::mutex::scoped_lock lock(_mutex);
+
+	Entry& entry = _entries[file.string()];
+
+	entry.filesize = filesize;
+	entry.modified = modified;
+	entry.crc = crc;
+}
+
+boost::uint32_t CrcCache::GetCrcForFile(const fs::path& file)
+{
+	return GetCrc(file, false);
+}
+
+boost::uint32_t CrcCache::GetCrc(const fs::path& file, bool silent)
+{
+	boost::uintmax_t filesize = fs::file_size(file);
+	std::time_t modified = fs::last_write_time(file);
+
+	boost::uint32_t crc;
+
+	if (Lookup(file, filesize, modified, crc))
+	{
+		return crc;
+	}
+
+	crc = CRC::GetCrcForFile(file, silent);
+
+	Insert(file, filesize, modified, crc);
+
+	return crc;
+}
+
+std::size_t CrcCache::GetDefaultNumThreads()
+{
+	// More readers than this only make the heads of spinning disks jump around
+	std::size_t numThreads = boost::thread::hardware_concurrency();
+
+	return numThreads < 1 ? 1 : (numThreads > 4 ? 4 : numThreads);
+}
+
+void CrcCache::Calculate(const std::vector<fs::path>& files, std::size_t numThreads, const ProgressFunction& progress)
+{
+	if (files.empty())
+	{
+		return;
+	}
+
+	_queue = &files;
+	_nextFile = 0;
+	_numDone = 0;
+	_cancelled = false;
+
+	std::vector<boost::shared_ptr<boost::thread> > threads;
+
+	for (std::size_t i = 0; i < numThreads && i < files.size(); ++i)
+	{
+		threads.push_back(boost::shared_ptr<boost::thread>(new boost::thread(boost::bind(&CrcCache::WorkerThread, this))));
+	}
+
+	try
+	{
+		boost::mutex::scoped_lock lock(_mutex);
+
+		while (_numDone < files.size())
+		{
+			// This is an interruption point, the user might cancel the check
+			_fileDone.wait(lock);
+
+			if (progress)
+			{
+				fs::path lastDone = _lastDone;
+				double fraction = static_cast<double>(_numDone) / files.size();
+
+				lock.unlock();
+				progress(lastDone, fraction);
+				lock.lock();
+			}
+		}
+	}
+	catch (boost::thread_interrupted&)
+	{
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+			_cancelled = true;
+		}
+
+		for (std::size_t i = 0; i < threads.size(); ++i)
+		{
+			threads[i]->join();
+		}
+
+		_queue = NULL;
+		throw;
+	}
+
+	for (std::size_t i = 0; i < threads.size(); ++i)
+	{
+		threads[i]->join();
+	}
+
+	_queue = NULL;
+}
+
+void CrcCache::WorkerThread()
+{
+	while (true)
+	{
+		fs::path file;
+
+		{
+			boost::mutex::scoped_lock lock(_mutex);
+
+			if (_cancelled || _nextFile >= _queue->size())
+			{
+				return;
+			}
+
+			file = (*_queue)[_nextFile++];
+		}
+
+		try
+		{
+			// The TraceLog writers are not thread-safe, keep quiet here
+			GetCrc(file, true);
+		}
+		catch (std::exception&)
+		{
+			// Leave it to the sequential check to report this file
+		}
+
+		boost::mutex::scoped_lock lock(_mutex);
+
+		_numDone++;
+		_lastDone = file;
+		_fileDone.notify_one();
+	}
+}
+
+} // namespace
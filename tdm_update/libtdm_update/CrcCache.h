@@ -0,0 +1,109 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod Updater (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <vector>
+#include <string>
+#include <ctime>
+#include <boost/cstdint.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/filesystem.hpp>
+
+namespace fs = boost::filesystem;
+
+namespace tdm
+{
+
+/**
+ * Remembers the CRCs of the local files, keyed by path, size and modification
+ * time, so that a file which didn't change since the last run doesn't need
+ * to be read again. The entries are stored in a text file between runs.
+ *
+ * Calculate() hashes a list of files concurrently, GetCrcForFile() afterwards
+ * just looks up the result.
+ */
+class CrcCache
+{
+public:
+	// Invoked on the calling thread with the file just done and the fraction of the whole list
+	typedef boost::function<void(const fs::path&, double)> ProgressFunction;
+
+private:
+	struct Entry
+	{
+		boost::uintmax_t filesize;
+		std::time_t modified;
+		boost::uint32_t crc;
+	};
+
+	typedef std::map<std::string, Entry> Entries;
+	Entries _entries;
+
+	fs::path _cacheFile;
+	bool _loaded;
+
+	// Protects _entries and the work queue while Calculate() is running
+	boost::mutex _mutex;
+	boost::condition_variable _fileDone;
+
+	// The work queue of Calculate()
+	const std::vector<fs::path>* _queue;
+	std::size_t _nextFile;
+	std::size_t _numDone;
+	fs::path _lastDone;
+	bool _cancelled;
+
+public:
+	CrcCache();
+
+	// Sets the file the cache is loaded from and saved to, loads it on first call
+	void Load(const fs::path& cacheFile);
+
+	// Writes the entries of the files that still exist back to the cache file
+	void Save();
+
+	/**
+	 * Calculates the CRCs of all the given files which are not cached yet, using
+	 * up to numThreads threads. Files which can't be read are skipped, the error
+	 * surfaces when GetCrcForFile() is called for them.
+	 */
+	void Calculate(const std::vector<fs::path>& files, std::size_t numThreads, const ProgressFunction& progress);
+
+	// Returns the CRC of the file, from the cache if size and time still match, see CRC::GetCrcForFile
+	boost::uint32_t GetCrcForFile(const fs::path& file);
+
+	// The default number of hashing threads
+	static std::size_t GetDefaultNumThreads();
+
+private:
+	// Returns true and fills crc if the cache holds an up-to-date entry for this file
+	bool Lookup(const fs::path& file, boost::uintmax_t filesize, std::time_t modified, boost::uint32_t& crc);
+
+	void Insert(const fs::path& file, boost::uintmax_t filesize, std::time_t modified, boost::uint32_t crc);
+
+	boost::uint32_t GetCrc(const fs::path& file, bool silent);
+
+	void WorkerThread();
+};
+
+} // namespace
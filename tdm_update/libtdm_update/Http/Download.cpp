@@ -173,15 +173,35 @@ void Download::SetRequiredFilesize(std::size_t requiredSize)
 
 void Download::Perform()
 {
+	// True if the partial temporary file of a failed attempt should be continued
+	bool resume = false;
+
 	while (_curUrl < _urls.size())
 	{
-		// Remove any previous temporary file
-		File::Remove(_tempFilename);
+		std::size_t resumeFrom = 0;
+
+		if (resume && fs::exists(_tempFilename))
+		{
+			resumeFrom = static_cast<std::size_t>(fs::file_size(_tempFilename));
+		}
+
+		if (resumeFrom == 0)
+		{
+			// Remove any previous temporary file
+			File::Remove(_tempFilename);
+		}
 
 		const std::string& url = _urls[_curUrl];
 
 		// Create a new request
 		_request = _conn->CreateRequest(url, _tempFilename.string());
+
+		if (resumeFrom > 0)
+		{
+			// The size and CRC checks below catch mirrors serving different contents
+			TraceLog::WriteLine(LOG_VERBOSE, (boost::format("Resuming download at byte %d") % resumeFrom).str());
+			_request->SetResumeFrom(resumeFrom);
+		}
 	
 		// Start the download, blocks until finished or aborted
 		_request->Perform();
@@ -193,6 +213,7 @@ void Download::Perform()
 
 			if (!valid)
 			{
+				resume = false;
 				_curUrl++;
 				continue;
 			}
@@ -225,12 +246,20 @@ void Download::Perform()
 			{
 				TraceLog::WriteLine(LOG_VERBOSE, "Download aborted.");
 			}
+			else if (_request->RangeRejected())
+			{
+				// Mirror can't continue the partial file, fetch it from the start
+				TraceLog::WriteLine(LOG_VERBOSE, "Server doesn't support resuming, restarting download.");
+				resume = false;
+				continue;
+			}
 			else
 			{
 				TraceLog::WriteLine(LOG_VERBOSE, "Connection Error.");
 			}
 
-			// Proceed to the next URL
+			// Proceed to the next URL, continuing where this one stopped
+			resume = _request->GetStatus() == HttpRequest::FAILED;
 			_curUrl++;
 		}
 	} // while
@@ -43,7 +43,9 @@ HttpRequest::HttpRequest(HttpConnection& conn, const std::string& url) :
 	_status(NOT_PERFORMED_YET),
 	_cancelFlag(false),
 	_progress(0),
-	_downloadedBytes(0)
+	_downloadedBytes(0),
+	_resumeFrom(0),
+	_rangeRejected(false)
 {}
 
 HttpRequest::HttpRequest(HttpConnection& conn, const std::string& url, const std::string& destFilename) :
@@ -54,7 +56,9 @@ HttpRequest::HttpRequest(HttpConnection& conn, const std::string& url, const std
 	_destFilename(destFilename),
 	_cancelFlag(false),
 	_progress(0),
-	_downloadedBytes(0)
+	_downloadedBytes(0),
+	_resumeFrom(0),
+	_rangeRejected(false)
 {}
 
 void HttpRequest::InitRequest()
@@ -78,6 +82,11 @@ void HttpRequest::InitRequest()
 	// We pass ourselves as user data pointer to the callback function
 	curl_easy_setopt(_handle, CURLOPT_WRITEDATA, this);
 
+	if (_resumeFrom > 0)
+	{
+		curl_easy_setopt(_handle, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(_resumeFrom));
+	}
+
 	// Set agent
 	std::string agent = (boost::format("The Dark Mod Updater / libtdm_update v%s/%s") % 
 		LIBTDM_UPDATE_VERSION % LIBTDM_UPDATE_PLATFORM).str();
@@ -120,7 +129,14 @@ void HttpRequest::Perform()
 	// Check target file
 	if (!_destFilename.empty())
 	{
-		_destStream.open(_destFilename.c_str(), std::ofstream::out|std::ofstream::binary);
+		std::ios_base::openmode mode = std::ofstream::out|std::ofstream::binary;
+
+		if (_resumeFrom > 0)
+		{
+			mode |= std::ofstream::app;
+		}
+
+		_destStream.open(_destFilename.c_str(), mode);
 	}
 
 	CURLcode result = curl_easy_perform(_handle);
@@ -144,6 +160,9 @@ void HttpRequest::Perform()
 			_progress = 1.0;
 			TraceLog::WriteLine(LOG_VERBOSE, "Download successful: " + _url);
 			break;
+		case CURLE_RANGE_ERROR:
+			_rangeRejected = true;
+			// fall through
 		default:
 			_status = FAILED;
 			_errorMessage = curl_easy_strerror(result);
@@ -162,6 +181,16 @@ void HttpRequest::Cancel()
 	_cancelFlag = true;
 }
 
+void HttpRequest::SetResumeFrom(std::size_t offset)
+{
+	_resumeFrom = offset;
+}
+
+bool HttpRequest::RangeRejected()
+{
+	return _rangeRejected;
+}
+
 HttpRequest::RequestStatus HttpRequest::GetStatus()
 {
 	return _status;
@@ -76,6 +76,12 @@ private:
 
 	std::size_t _downloadedBytes;
 
+	// Byte offset to continue a partial download from (0 = from the start)
+	std::size_t _resumeFrom;
+
+	// True if the server refused the range request
+	bool _rangeRejected;
+
 	std::string _errorMessage;
 
 public:
@@ -94,6 +100,13 @@ public:
 
 	void Cancel();
 
+	// Ask the server to skip the first <offset> bytes, the rest is appended
+	// to the existing destination file. Must be called before Perform().
+	void SetResumeFrom(std::size_t offset);
+
+	// True if a resumed request failed because the server doesn't do ranges
+	bool RangeRejected();
+
 	// Between 0.0 and 1.0
 	double GetProgressFraction();
 
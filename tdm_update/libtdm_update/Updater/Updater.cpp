@@ -29,6 +29,7 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
+#include <boost/bind.hpp>
 
 #ifndef WIN32
 #include <limits.h>
@@ -230,6 +231,27 @@ void Updater::DetermineLocalVersion()
 		totalItems += v->second.size();
 	}
 
+	// Most files are listed in several versions, hash each of them once and up front
+	std::set<fs::path> candidateSet;
+
+	for (ReleaseVersions::const_iterator v = _releaseVersions.begin(); v != _releaseVersions.end(); ++v)
+	{
+		for (ReleaseFileSet::const_iterator f = v->second.begin(); f != v->second.end(); ++f)
+		{
+			fs::path candidate = GetTargetPath() / f->second.file;
+
+			if (f->second.localChangesAllowed || !fs::exists(candidate) || 
+				static_cast<std::size_t>(fs::file_size(candidate)) != f->second.filesize)
+			{
+				continue;
+			}
+
+			candidateSet.insert(candidate);
+		}
+	}
+
+	CalculateLocalCrcs(std::vector<fs::path>(candidateSet.begin(), candidateSet.end()));
+
 	std::size_t curItem = 0;
 
 	for (ReleaseVersions::const_iterator v = _releaseVersions.begin(); v != _releaseVersions.end(); ++v)
@@ -279,7 +301,7 @@ void Updater::DetermineLocalVersion()
 			}
 
 			// Calculate the CRC of this file
-			boost::uint32_t crc = CRC::GetCrcForFile(candidate);
+			boost::uint32_t crc = _crcCache.GetCrcForFile(candidate);
 
 			if (crc != f->second.crc)
 			{
@@ -316,6 +338,8 @@ void Updater::DetermineLocalVersion()
 
 	TraceLog::WriteLine(LOG_VERBOSE, (boost::format("The local files are matching %d different versions.") % _localVersions.size()).str());
 
+	_crcCache.Save();
+
 	if (_fileProgressCallback != NULL)
 	{
 		_fileProgressCallback->OnFileOperationFinish();
@@ -965,6 +989,26 @@ void Updater::CheckLocalFiles()
 		}
 	}
 
+	// Hash the files in parallel first, the checks below then just compare the results
+	std::vector<fs::path> candidates;
+
+	for (ReleaseFileSet::const_iterator i = _latestRelease.begin(); i != _latestRelease.end(); ++i)
+	{
+		if (i->second.isArchive && !i->second.members.empty())
+		{
+			for (std::set<ReleaseFile>::const_iterator m = i->second.members.begin(); m != i->second.members.end(); ++m)
+			{
+				AddLocalCrcCandidate(candidates, targetPath, *m);
+			}
+		}
+		else
+		{
+			AddLocalCrcCandidate(candidates, targetPath, i->second);
+		}
+	}
+
+	CalculateLocalCrcs(candidates);
+
 	std::size_t count = 0;
 
 	for (ReleaseFileSet::const_iterator i = _latestRelease.begin(); i != _latestRelease.end(); ++i)
@@ -1008,6 +1052,8 @@ void Updater::CheckLocalFiles()
 		count++;
 	}
 
+	_crcCache.Save();
+
 	if (_fileProgressCallback != NULL)
 	{
 		_fileProgressCallback->OnFileOperationFinish();
@@ -1047,7 +1093,7 @@ bool Updater::CheckLocalFile(const fs::path& installPath, const ReleaseFile& rel
 		}
 
 		// Size is matching, check CRC
-		boost::uint32_t existingCrc = CRC::GetCrcForFile(localFile);
+		boost::uint32_t existingCrc = _crcCache.GetCrcForFile(localFile);
 
 		if (existingCrc == releaseFile.crc)
 		{
@@ -1067,6 +1113,32 @@ bool Updater::CheckLocalFile(const fs::path& installPath, const ReleaseFile& rel
 	}
 }
 
+void Updater::AddLocalCrcCandidate(std::vector<fs::path>& candidates, const fs::path& installPath, const ReleaseFile& releaseFile)
+{
+	fs::path localFile = installPath / releaseFile.file;
+
+	if (!fs::exists(localFile) || 
+		_ignoreList.find(boost::algorithm::to_lower_copy(releaseFile.file.string())) != _ignoreList.end() ||
+		static_cast<std::size_t>(fs::file_size(localFile)) != releaseFile.filesize)
+	{
+		return; // CheckLocalFile won't look at the CRC
+	}
+
+	candidates.push_back(localFile);
+}
+
+void Updater::CalculateLocalCrcs(const std::vector<fs::path>& candidates)
+{
+	_crcCache.Load(GetTargetPath() / TDM_CRC_CACHE_FILE);
+
+	std::size_t numThreads = CrcCache::GetDefaultNumThreads();
+
+	TraceLog::WriteLine(LOG_VERBOSE, (boost::format("Calculating CRCs of %d local files using %d threads...") % candidates.size() % numThreads).str());
+
+	_crcCache.Calculate(candidates, numThreads, 
+		boost::bind(&Updater::NotifyFileProgress, this, _1, CurFileInfo::Check, _2));
+}
+
 bool Updater::LocalFilesNeedUpdate()
 {
 	return !_downloadQueue.empty();
@@ -27,6 +27,7 @@
 #include "../ReleaseFileset.h"
 #include "../ReleaseVersions.h"
 #include "../UpdatePackageInfo.h"
+#include "../CrcCache.h"
 #include "DifferentialUpdateInfo.h"
 
 /**
@@ -164,6 +165,9 @@ private:
 	// Some files like DoomConfig.cfg or dmargs.txt are ignored.
 	std::set<std::string> _ignoreList;
 
+	// The CRCs of the local files, kept between runs
+	CrcCache _crcCache;
+
 	DownloadProgressPtr _downloadProgressCallback;
 
 	FileOperationProgressPtr _fileProgressCallback;
@@ -322,6 +326,12 @@ private:
 	// Returns false if the local files is missing or needs an update
 	bool CheckLocalFile(const fs::path& installPath, const ReleaseFile& releaseFile);
 
+	// Adds the local file to the list if CheckLocalFile() is going to need its CRC
+	void AddLocalCrcCandidate(std::vector<fs::path>& candidates, const fs::path& installPath, const ReleaseFile& releaseFile);
+
+	// Hashes the given local files concurrently, the results end up in _crcCache
+	void CalculateLocalCrcs(const std::vector<fs::path>& candidates);
+
 	// Get the target path (defaults to current path)
 	fs::path GetTargetPath();
 
@@ -866,28 +866,18 @@ int ParseOptions( const idCmdArgs &args, idAASSettings &settings ) {
 
 /*
 ============
-RunAAS_f
+RunAAS
+
+Compiles the AAS files without touching the warning list,
+so dmap can report its own warnings together with these
 ============
 */
-void RunAAS_f( const idCmdArgs &args ) {
+void RunAAS( const idCmdArgs &args ) {
 	int i;
 	idAASBuild aas;
 	idAASSettings settings;
 	idStr mapName;
 
-	if ( args.Argc() <= 1 ) {
-		common->Printf( "runAAS [options] <mapfile>\n"
-					"options:\n"
-					"  -usePatches        = use bezier patches for collision detection.\n"
-					"  -writeBrushMap     = write a brush map with the AAS geometry.\n"
-					"  -playerFlood       = use player spawn points as valid AAS positions.\n" );
-		return;
-	}
-
-	common->ClearWarnings( "compiling AAS" );
-
-	common->SetRefreshOnPrint( true );
-
 	// get the aas settings definitions
 	const idDict *dict = gameEdit->FindEntityDefDict( "aas_types", false );
 	if ( !dict ) {
@@ -926,7 +916,29 @@ void RunAAS_f( const idCmdArgs &args ) {
 			common->Printf( "=======================================================\n" );
 		}
 	}
+}
+
+/*
+============
+RunAAS_f
+============
+*/
+void RunAAS_f( const idCmdArgs &args ) {
+	if ( args.Argc() <= 1 ) {
+		common->Printf( "runAAS [options] <mapfile>\n"
+					"options:\n"
+					"  -usePatches        = use bezier patches for collision detection.\n"
+					"  -writeBrushMap     = write a brush map with the AAS geometry.\n"
+					"  -playerFlood       = use player spawn points as valid AAS positions.\n" );
+		return;
+	}
+
+	common->ClearWarnings( "compiling AAS" );
+
+	common->SetRefreshOnPrint( true );
+	RunAAS( args );
 	common->SetRefreshOnPrint( false );
+
 	common->PrintWarnings();
 }
 
@@ -1084,6 +1084,325 @@ void idAASFileLocal::FinishAreas( void ) {
 	}
 }
 
+/*
+===============================================================================
+
+	Binary AAS file
+
+	Written next to the text file the first time it is loaded and used instead of
+	it as long as the text file keeps its timestamp. All tables are stored as
+	native arrays, the areas with their derived center and bounds, and the
+	reachabilities of all areas in one array in area order, so loading is a
+	couple of block reads.
+
+===============================================================================
+*/
+
+idCVar aas_binaryFiles( "aas_binaryFiles", "1", CVAR_SYSTEM | CVAR_BOOL, "load the AAS from the binary version next to the text file, and write it when it is missing or out of date" );
+
+typedef struct aasBinaryReach_s {
+	int							travelType;
+	int							toAreaNum;
+	idVec3						start;
+	idVec3						end;
+	int							edgeNum;
+	int							travelTime;
+} aasBinaryReach_t;
+
+/*
+================
+AAS_BinaryFileName
+================
+*/
+static idStr AAS_BinaryFileName( const idStr &fileName ) {
+	return fileName + AAS_BINARY_FILE_SUFFIX;
+}
+
+/*
+================
+AAS_WriteBinaryList
+================
+*/
+template< class type >
+static void AAS_WriteBinaryList( idFile *fp, const idList<type> &list ) {
+	int num = list.Num();
+	fp->Write( &num, sizeof( num ) );
+	fp->Write( list.Ptr(), num * sizeof( type ) );
+}
+
+/*
+================
+AAS_ReadBinaryList
+================
+*/
+template< class type >
+static bool AAS_ReadBinaryList( idFile *fp, idList<type> &list ) {
+	int num;
+	if ( fp->Read( &num, sizeof( num ) ) != sizeof( num ) || num < 0 || (long long)num * sizeof( type ) > fp->Length() - fp->Tell() ) {
+		return false;
+	}
+	list.SetNum( num );
+	fp->Read( list.Ptr(), num * sizeof( type ) );
+	return true;
+}
+
+/*
+================
+AAS_WriteBinaryString
+================
+*/
+static void AAS_WriteBinaryString( idFile *fp, const char *string ) {
+	int length = idStr::Length( string );
+	fp->Write( &length, sizeof( length ) );
+	fp->Write( string, length );
+}
+
+/*
+================
+AAS_ReadBinaryString
+================
+*/
+static bool AAS_ReadBinaryString( idFile *fp, idStr &string ) {
+	int length;
+	if ( fp->Read( &length, sizeof( length ) ) != sizeof( length ) || length < 0 || length > fp->Length() - fp->Tell() ) {
+		return false;
+	}
+	string.Fill( ' ', length );
+	fp->Read( &string[0], length );
+	return true;
+}
+
+/*
+================
+idAASFileLocal::WriteBinary
+================
+*/
+bool idAASFileLocal::WriteBinary( const idStr &fileName, const unsigned int mapFileCRC, ID_TIME_T textTimeStamp ) const {
+	int i, num;
+	idReachability *reach;
+	idList<int> numAreaReach;
+	idList<aasBinaryReach_t> reaches;
+	idFile_Memory settingsFile;
+
+	idFile_Memory fp( fileName );
+	fp.SetGranularity( 1024 * 1024 );
+
+	// header, all native so other byte orders are rejected
+	num = AAS_BINARY_FILEVERSION;
+	fp.Write( AAS_BINARY_FILEID, 4 );
+	fp.Write( &num, sizeof( num ) );
+	AAS_WriteBinaryString( &fp, AAS_FILEVERSION );
+	fp.Write( &mapFileCRC, sizeof( mapFileCRC ) );
+	fp.Write( &textTimeStamp, sizeof( textTimeStamp ) );
+
+	// the settings in their text form
+	settings.WriteToFile( &settingsFile );
+	num = settingsFile.Length();
+	fp.Write( &num, sizeof( num ) );
+	fp.Write( settingsFile.GetDataPtr(), num );
+
+	AAS_WriteBinaryList( &fp, planeList );
+	AAS_WriteBinaryList( &fp, vertices );
+	AAS_WriteBinaryList( &fp, edges );
+	AAS_WriteBinaryList( &fp, edgeIndex );
+	AAS_WriteBinaryList( &fp, faces );
+	AAS_WriteBinaryList( &fp, faceIndex );
+	AAS_WriteBinaryList( &fp, areas );		// the pointers are rebuilt on load
+	AAS_WriteBinaryList( &fp, nodes );
+	AAS_WriteBinaryList( &fp, portals );
+	AAS_WriteBinaryList( &fp, portalIndex );
+	AAS_WriteBinaryList( &fp, clusters );
+
+	// the reachabilities of all areas in list order
+	numAreaReach.SetNum( areas.Num() );
+	for ( i = 0; i < areas.Num(); i++ ) {
+		numAreaReach[i] = 0;
+		for ( reach = areas[i].reach; reach; reach = reach->next ) {
+			aasBinaryReach_t &r = reaches.Alloc();
+			r.travelType = reach->travelType;
+			r.toAreaNum = reach->toAreaNum;
+			r.start = reach->start;
+			r.end = reach->end;
+			r.edgeNum = reach->edgeNum;
+			r.travelTime = reach->travelTime;
+			numAreaReach[i]++;
+		}
+	}
+	AAS_WriteBinaryList( &fp, numAreaReach );
+	AAS_WriteBinaryList( &fp, reaches );
+
+	// followed by the key/values of the special reachabilities in the same order
+	for ( i = 0; i < areas.Num(); i++ ) {
+		for ( reach = areas[i].reach; reach; reach = reach->next ) {
+			if ( reach->travelType != TFL_SPECIAL ) {
+				continue;
+			}
+			const idDict &dict = static_cast<idReachability_Special *>(reach)->dict;
+			num = dict.GetNumKeyVals();
+			fp.Write( &num, sizeof( num ) );
+			for ( int j = 0; j < num; j++ ) {
+				AAS_WriteBinaryString( &fp, dict.GetKeyVal( j )->GetKey() );
+				AAS_WriteBinaryString( &fp, dict.GetKeyVal( j )->GetValue() );
+			}
+		}
+	}
+
+	common->Printf( "writing %s\n", fileName.c_str() );
+	return fileSystem->WriteFile( fileName, fp.GetDataPtr(), fp.Length() ) >= 0;
+}
+
+/*
+================
+idAASFileLocal::LoadBinary
+================
+*/
+bool idAASFileLocal::LoadBinary( const idStr &fileName, const unsigned int mapFileCRC, ID_TIME_T textTimeStamp ) {
+	const char *buffer;
+	int i, j, num, length, version;
+	char id[4];
+	idStr fileVersion;
+	unsigned int fileCRC;
+	ID_TIME_T fileTimeStamp;
+	idList<int> numAreaReach;
+	idList<aasBinaryReach_t> reaches;
+
+	length = fileSystem->ReadFileMapped( fileName, (const void **)&buffer, NULL );
+	if ( length < 0 || !buffer ) {
+		return false;
+	}
+
+	idFile_Memory fp( fileName, (const char *)buffer, length );
+
+	fp.Read( id, sizeof( id ) );
+	fp.Read( &version, sizeof( version ) );
+	if ( memcmp( id, AAS_BINARY_FILEID, sizeof( id ) ) || version != AAS_BINARY_FILEVERSION ||
+		!AAS_ReadBinaryString( &fp, fileVersion ) || fileVersion != AAS_FILEVERSION ) {
+		common->Printf( "%s has a different version\n", fileName.c_str() );
+		fileSystem->FreeFile( (void *)buffer );
+		return false;
+	}
+
+	fp.Read( &fileCRC, sizeof( fileCRC ) );
+	fp.Read( &fileTimeStamp, sizeof( fileTimeStamp ) );
+	if ( ( mapFileCRC && fileCRC != mapFileCRC ) || fileTimeStamp != textTimeStamp ) {
+		common->Printf( "%s is out of date\n", fileName.c_str() );
+		fileSystem->FreeFile( (void *)buffer );
+		return false;
+	}
+
+	// clear the file in memory
+	Clear();
+
+	bool ok = false;
+	do {
+		idStr settingsText;
+		idLexer src( LEXFL_NOFATALERRORS | LEXFL_NOSTRINGESCAPECHARS | LEXFL_NOSTRINGCONCAT | LEXFL_ALLOWPATHNAMES );
+
+		if ( !AAS_ReadBinaryString( &fp, settingsText ) || !src.LoadMemory( settingsText, settingsText.Length(), fileName ) ||
+			!settings.FromParser( src ) ) {
+			break;
+		}
+
+		if ( !AAS_ReadBinaryList( &fp, planeList ) || !AAS_ReadBinaryList( &fp, vertices ) ||
+			!AAS_ReadBinaryList( &fp, edges ) || !AAS_ReadBinaryList( &fp, edgeIndex ) ||
+			!AAS_ReadBinaryList( &fp, faces ) || !AAS_ReadBinaryList( &fp, faceIndex ) ) {
+			break;
+		}
+
+		if ( !AAS_ReadBinaryList( &fp, areas ) ) {
+			break;
+		}
+
+		// the stored pointers are meaningless
+		for ( i = 0; i < areas.Num(); i++ ) {
+			areas[i].reach = NULL;
+			areas[i].rev_reach = NULL;
+		}
+
+		if ( !AAS_ReadBinaryList( &fp, nodes ) ||
+			!AAS_ReadBinaryList( &fp, portals ) || !AAS_ReadBinaryList( &fp, portalIndex ) ||
+			!AAS_ReadBinaryList( &fp, clusters ) ||
+			!AAS_ReadBinaryList( &fp, numAreaReach ) || !AAS_ReadBinaryList( &fp, reaches ) ||
+			numAreaReach.Num() != areas.Num() ) {
+			break;
+		}
+
+		// rebuild the reachability lists in the stored order
+		ok = true;
+		for ( i = 0, num = 0; i < areas.Num() && ok; i++ ) {
+			idReachability **tail = &areas[i].reach;
+
+			for ( j = 0; j < numAreaReach[i]; j++, num++ ) {
+				idReachability *newReach;
+
+				if ( num >= reaches.Num() || reaches[num].toAreaNum < 0 || reaches[num].toAreaNum >= areas.Num() ) {
+					ok = false;
+					break;
+				}
+
+				const aasBinaryReach_t &r = reaches[num];
+				if ( r.travelType == TFL_SPECIAL ) {
+					newReach = new idReachability_Special();
+				} else {
+					newReach = new idReachability();
+				}
+				newReach->travelType = r.travelType;
+				newReach->toAreaNum = r.toAreaNum;
+				newReach->start = r.start;
+				newReach->end = r.end;
+				newReach->edgeNum = r.edgeNum;
+				newReach->travelTime = r.travelTime;
+				newReach->fromAreaNum = i;
+				newReach->next = NULL;
+				*tail = newReach;
+				tail = &newReach->next;
+			}
+		}
+
+		if ( !ok || num != reaches.Num() ) {
+			ok = false;
+			break;
+		}
+
+		// the key/values of the special reachabilities
+		for ( i = 0; i < areas.Num() && ok; i++ ) {
+			for ( idReachability *reach = areas[i].reach; reach && ok; reach = reach->next ) {
+				if ( reach->travelType != TFL_SPECIAL ) {
+					continue;
+				}
+				idDict &dict = static_cast<idReachability_Special *>(reach)->dict;
+				if ( fp.Read( &num, sizeof( num ) ) != sizeof( num ) || num < 0 ) {
+					ok = false;
+					break;
+				}
+				for ( j = 0; j < num; j++ ) {
+					idStr key, value;
+					if ( !AAS_ReadBinaryString( &fp, key ) || !AAS_ReadBinaryString( &fp, value ) ) {
+						ok = false;
+						break;
+					}
+					dict.Set( key, value );
+				}
+			}
+		}
+
+		ok = ok && fp.Tell() == fp.Length();
+	} while ( 0 );
+
+	fileSystem->FreeFile( (void *)buffer );
+
+	if ( !ok ) {
+		common->Warning( "AAS file '%s' is damaged", fileName.c_str() );
+		DeleteReachabilities();
+		Clear();
+		return false;
+	}
+
+	LinkReversedReachability();
+
+	return true;
+}
+
 /*
 ================
 idAASFileLocal::Load
@@ -1101,6 +1420,16 @@ bool idAASFileLocal::Load( const idStr &fileName, const unsigned int mapFileCRC
 	common->Printf( "[Load AAS]\n" );
 	common->Printf( "loading %s\n", name.c_str() );
 
+	// the binary version is valid as long as the text file keeps its timestamp
+	ID_TIME_T timeStamp;
+	fileSystem->ReadFile( name, NULL, &timeStamp );
+
+	if ( aas_binaryFiles.GetBool() && timeStamp != FILE_NOT_FOUND_TIMESTAMP &&
+		LoadBinary( AAS_BinaryFileName( name ), mapFileCRC, timeStamp ) ) {
+		common->Printf( "done.\n" );
+		return true;
+	}
+
 	if ( !src.LoadFile( name ) ) {
 		return false;
 	}
@@ -1184,6 +1513,10 @@ bool idAASFileLocal::Load( const idStr &fileName, const unsigned int mapFileCRC
 		src.Error( "idAASFileLocal::Load: tree depth = %d", depth );
 	}
 
+	if ( aas_binaryFiles.GetBool() && timeStamp != FILE_NOT_FOUND_TIMESTAMP ) {
+		WriteBinary( AAS_BinaryFileName( name ), c, timeStamp );
+	}
+
 	common->Printf( "done.\n" );
 
 	return true;
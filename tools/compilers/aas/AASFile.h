@@ -31,6 +31,11 @@
 #define AAS_FILEID					"DewmAAS"
 #define AAS_FILEVERSION				"1.07"
 
+// the binary version written next to the text file when it is loaded
+#define AAS_BINARY_FILE_SUFFIX		"b"
+#define AAS_BINARY_FILEID			"AASB"
+#define AAS_BINARY_FILEVERSION		1
+
 // travel flags
 #define TFL_INVALID					BIT(0)		// not valid
 #define TFL_WALK					BIT(1)		// walking
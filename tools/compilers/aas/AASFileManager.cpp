@@ -51,6 +51,7 @@ idAASFileManagerLocal::LoadAAS
 ================
 */
 idAASFile *idAASFileManagerLocal::LoadAAS( const char *fileName, const unsigned int mapFileCRC ) {
+	idScopedMemTag memTag( MEMTAG_AAS );
 	idAASFileLocal *file = new idAASFileLocal();
 	if ( !file->Load( fileName, mapFileCRC ) ) {
 		delete file;
@@ -55,6 +55,8 @@ public:
 public:
 	bool						Load( const idStr &fileName, const unsigned int mapFileCRC );
 	bool						Write( const idStr &fileName, const unsigned int mapFileCRC );
+	bool						LoadBinary( const idStr &fileName, const unsigned int mapFileCRC, ID_TIME_T textTimeStamp );
+	bool						WriteBinary( const idStr &fileName, const unsigned int mapFileCRC, ID_TIME_T textTimeStamp ) const;
 
 	int							MemorySize( void ) const;
 	void						ReportRoutingEfficiency( void ) const;
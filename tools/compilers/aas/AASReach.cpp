@@ -22,6 +22,8 @@
 
 static bool versioned = RegisterVersionedFile("$Id$");
 
+idCVar aas_parallelReach( "aas_parallelReach", "1", CVAR_SYSTEM | CVAR_BOOL, "calculate the walk, jump and ledge reachabilities of several areas at once" );
+
 #include "AASFile.h"
 #include "AASFile_local.h"
 #include "AASReach.h"
@@ -90,6 +92,7 @@ void idAASReach::AddReachabilityToArea( idReachability *reach, int areaNum ) {
 	area = &file->areas[areaNum];
 	reach->next = area->reach;
 	area->reach = reach;
+	#pragma omp atomic
 	numReachabilities++;
 }
 
@@ -891,33 +894,45 @@ bool idAASReach::Build( const idMapFile *mapFile, idAASFileLocal *file ) {
 		Reachability_EqualFloorHeight( i );
 	}
 
+	// every area only gets reachabilities leaving it, so areas can be handled
+	// by different threads. The areas are done in slices with the progress
+	// printed in between, printing can refresh the screen which can only be
+	// done from the main thread.
+	const bool parallel = aas_parallelReach.GetBool() && Mem_ThreadSafe();
+	const int sliceSize = parallel ? Max( 1, file->areas.Num() / 100 ) : 1;
+
 	lastPercent = -1;
-	for ( i = 1; i < file->areas.Num(); i++ ) {
+	for ( int first = 1; first < file->areas.Num(); first += sliceSize ) {
+		const int last = Min( first + sliceSize, file->areas.Num() );
 
-		if ( !( file->areas[i].flags & AREA_REACHABLE_WALK ) ) {
-			continue;
-		}
+		#pragma omp parallel for if ( parallel ) private( j ) schedule( dynamic )
+		for ( i = first; i < last; i++ ) {
 
-		for ( j = 0; j < file->areas.Num(); j++ ) {
-			if ( i == j ) {
+			if ( !( file->areas[i].flags & AREA_REACHABLE_WALK ) ) {
 				continue;
 			}
 
-			if ( !( file->areas[j].flags & AREA_REACHABLE_WALK ) ) {
-				continue;
-			}
+			for ( j = 0; j < file->areas.Num(); j++ ) {
+				if ( i == j ) {
+					continue;
+				}
 
-			if ( ReachabilityExists( i, j ) ) {
-				continue;
-			}
-			if ( Reachability_Step_Barrier_WaterJump_WalkOffLedge( i, j ) ) {
-				continue;
+				if ( !( file->areas[j].flags & AREA_REACHABLE_WALK ) ) {
+					continue;
+				}
+
+				if ( ReachabilityExists( i, j ) ) {
+					continue;
+				}
+				if ( Reachability_Step_Barrier_WaterJump_WalkOffLedge( i, j ) ) {
+					continue;
+				}
 			}
-		}
 
-		//Reachability_WalkOffLedge( i );
+			//Reachability_WalkOffLedge( i );
+		}
 
-		percent = 100 * i / file->areas.Num();
+		percent = 100 * ( last - 1 ) / file->areas.Num();
 		if ( percent > lastPercent ) {
 			common->Printf( "\r%6d%%", percent );
 			lastPercent = percent;
@@ -696,10 +696,6 @@ int idBrushBSP::FindSplitter( idBrushBSPNode *node, const idPlaneSet &planeList,
 
 			testedPlanes[planeNum] = testedPlanes[planeNum^1] = true;
 
-			if ( node->volume->Split( planeList[planeNum], planeNum, NULL, NULL ) != PLANESIDE_CROSS ) {
-				continue;
-			}
-
 			memset( &stats, 0, sizeof( stats ) );
 
 			f = 15 + 5 * (brush->GetSide(i)->GetPlane().Type() < PLANETYPE_TRUEAXIAL);
@@ -719,7 +715,7 @@ int idBrushBSP::FindSplitter( idBrushBSPNode *node, const idPlaneSet &planeList,
 				// best value we can get using this plane as a splitter
 				value = f * (stats.numFacing + numBrushSides) - 10 * stats.numSplits - stats.epsilonBrushes * 1000;
 				// if the best value for this plane can't get any better than the best value we have
-				if ( value < bestValue ) {
+				if ( value <= bestValue ) {
 					break;
 				}
 			}
@@ -730,14 +726,22 @@ int idBrushBSP::FindSplitter( idBrushBSPNode *node, const idPlaneSet &planeList,
 
 			value = f * stats.numFacing - 10 * stats.numSplits - abs(stats.numFront - stats.numBack) - stats.epsilonBrushes * 1000;
 
-			if ( value > bestValue ) {
-				bestValue = value;
-				bestSplitter = planeNum;
-				bestStats = stats;
+			if ( value <= bestValue ) {
+				continue;
+			}
 
-				for ( b = node->brushList.Head(); b; b = b->Next() ) {
-					b->SavePlaneSide();
-				}
+			// the plane must cut the node volume, this is tested last because clipping
+			// the volume is far more expensive than the brush statistics with the early-out
+			if ( node->volume->Split( planeList[planeNum], planeNum, NULL, NULL ) != PLANESIDE_CROSS ) {
+				continue;
+			}
+
+			bestValue = value;
+			bestSplitter = planeNum;
+			bestStats = stats;
+
+			for ( b = node->brushList.Head(); b; b = b->Next() ) {
+				b->SavePlaneSide();
 			}
 		}
 	}
@@ -958,9 +962,11 @@ void idBrushBSP::Build( idBrushList brushList, int skipContents,
 								bool (*ChopAllowed)( idBrush *b1, idBrush *b2 ),
 								bool (*MergeAllowed)( idBrush *b1, idBrush *b2 ) ) {
 
-	int i;
+	int i, startTime;
 	idList<idBrushBSPNode *> gridCells;
 
+	startTime = Sys_Milliseconds();
+
 	common->Printf( "[Brush BSP]\n" );
 	common->Printf( "%6d brushes\n", brushList.Num() );
 
@@ -993,6 +999,7 @@ void idBrushBSP::Build( idBrushList brushList, int skipContents,
 #endif
 
 	common->Printf( "\r%6d splits\n", numSplits );
+	common->Printf( "%6.2f seconds for the brush BSP\n", ( Sys_Milliseconds() - startTime ) / 1000.0f );
 
 	if ( brushMap ) {
 		delete brushMap;
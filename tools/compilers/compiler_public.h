@@ -30,12 +30,14 @@
 
 // map processing (also see SuperOptimizeOccluders in tr_local.h)
 void Dmap_f( const idCmdArgs &args );
+void DmapBatch_f( const idCmdArgs &args );
 
 // bump map generation
 void RenderBump_f( const idCmdArgs &args );
 void RenderBumpFlat_f( const idCmdArgs &args );
 
 // AAS file compiler
+void RunAAS( const idCmdArgs &args );
 void RunAAS_f( const idCmdArgs &args );
 void RunAASDir_f( const idCmdArgs &args );
 void RunReach_f( const idCmdArgs &args );
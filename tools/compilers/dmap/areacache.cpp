@@ -0,0 +1,358 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+#include "precompiled_engine.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "dmap.h"
+
+/*
+
+  dmap -incremental keeps the optimized triangles of every area in
+  <map>.areacache, keyed by a checksum of the area's optimize groups
+  as they go into OptimizeEntity. The checksum covers the planes,
+  materials and every vertex of the input triangles, so an area whose
+  brushes, patches and clipping didn't change is restored from the
+  cache instead of being optimized again. Area numbers are not part of
+  the key, a room keeps its cache entry when other rooms are edited.
+
+  Only the entries used or created by a run are written back, so the
+  file doesn't grow with every edit.
+
+*/
+
+#define	AREA_CACHE_EXT		"areacache"
+#define	AREA_CACHE_ID		( ( 'A' << 24 ) | ( 'C' << 16 ) | ( 'H' << 8 ) | 'E' )
+#define	AREA_CACHE_VERSION	1
+
+typedef struct {
+	areaCacheKey_t		key;
+	int					numGroups;
+	idList<int>			numTris;		// per group
+	idList<idDrawVert>	verts;			// three per triangle, all groups in order
+} areaCacheEntry_t;
+
+static idList<areaCacheEntry_t *>	oldEntries;		// loaded from the file
+static idHashIndex					oldEntryHash;
+static idList<areaCacheEntry_t *>	newEntries;		// written back at the end
+static int							c_reusedAreas;
+static int							c_optimizedAreas;
+
+/*
+====================
+AreaCacheFlags
+
+Options that change the optimizer output, a cache written
+with different ones is thrown away
+====================
+*/
+static int AreaCacheFlags( void ) {
+	return ( dmapGlobals.noTJunc ? 1 : 0 ) | ( dmapGlobals.noOptimize ? 2 : 0 );
+}
+
+/*
+====================
+AreaCacheFileName
+====================
+*/
+static idStr AreaCacheFileName( void ) {
+	return va( "%s." AREA_CACHE_EXT, dmapGlobals.mapFileBase );
+}
+
+/*
+====================
+FreeAreaCache
+====================
+*/
+void FreeAreaCache( void ) {
+	int i;
+
+	// entries can be in both lists
+	for ( i = 0 ; i < oldEntries.Num() ; i++ ) {
+		if ( newEntries.FindIndex( oldEntries[i] ) == -1 ) {
+			delete oldEntries[i];
+		}
+	}
+	newEntries.DeleteContents( true );
+	oldEntries.Clear();
+	oldEntryHash.Free();
+	c_reusedAreas = 0;
+	c_optimizedAreas = 0;
+}
+
+/*
+====================
+LoadAreaCache
+====================
+*/
+void LoadAreaCache( void ) {
+	idFile	*f;
+	int		id, version, flags, numEntries;
+	int		i, j, totalTris;
+
+	FreeAreaCache();
+
+	f = fileSystem->OpenFileRead( AreaCacheFileName() );
+	if ( !f ) {
+		PrintIfVerbosityAtLeast( VL_CONCISE, "no area cache, all areas will be optimized\n" );
+		return;
+	}
+
+	f->ReadInt( id );
+	f->ReadInt( version );
+	f->ReadInt( flags );
+	f->ReadInt( numEntries );
+
+	if ( id != AREA_CACHE_ID || version != AREA_CACHE_VERSION || flags != AreaCacheFlags() || numEntries < 0 ) {
+		PrintIfVerbosityAtLeast( VL_CONCISE, "area cache %s is out of date, ignoring it\n", f->GetName() );
+		fileSystem->CloseFile( f );
+		return;
+	}
+
+	for ( i = 0 ; i < numEntries ; i++ ) {
+		areaCacheEntry_t *entry = new areaCacheEntry_t;
+
+		f->ReadUnsignedInt( entry->key.crc );
+		f->ReadUnsignedInt( entry->key.md5 );
+		f->ReadInt( entry->key.length );
+		f->ReadInt( entry->numGroups );
+
+		if ( entry->numGroups < 0 ) {
+			delete entry;
+			break;
+		}
+
+		entry->numTris.SetNum( entry->numGroups );
+		totalTris = 0;
+		for ( j = 0 ; j < entry->numGroups ; j++ ) {
+			f->ReadInt( entry->numTris[j] );
+			totalTris += entry->numTris[j];
+		}
+
+		entry->verts.SetNum( totalTris * 3 );
+		if ( totalTris < 0 || f->Read( entry->verts.Ptr(), entry->verts.MemoryUsed() ) != entry->verts.MemoryUsed() ) {
+			common->Warning( "area cache %s is truncated", f->GetName() );
+			delete entry;
+			break;
+		}
+
+		oldEntryHash.Add( entry->key.crc, oldEntries.Append( entry ) );
+	}
+
+	PrintIfVerbosityAtLeast( VL_CONCISE, "%i areas in the area cache\n", oldEntries.Num() );
+
+	fileSystem->CloseFile( f );
+}
+
+/*
+====================
+WriteAreaCache
+====================
+*/
+void WriteAreaCache( void ) {
+	idFile	*f;
+	int		i, j;
+
+	PrintIfVerbosityAtLeast( VL_CONCISE, "%i areas reused from the area cache, %i optimized\n", c_reusedAreas, c_optimizedAreas );
+
+	f = fileSystem->OpenFileWrite( AreaCacheFileName(), "fs_devpath", "" );
+	if ( !f ) {
+		common->Warning( "Couldn't write %s", AreaCacheFileName().c_str() );
+		return;
+	}
+
+	f->WriteInt( AREA_CACHE_ID );
+	f->WriteInt( AREA_CACHE_VERSION );
+	f->WriteInt( AreaCacheFlags() );
+	f->WriteInt( newEntries.Num() );
+
+	for ( i = 0 ; i < newEntries.Num() ; i++ ) {
+		const areaCacheEntry_t *entry = newEntries[i];
+
+		f->WriteUnsignedInt( entry->key.crc );
+		f->WriteUnsignedInt( entry->key.md5 );
+		f->WriteInt( entry->key.length );
+		f->WriteInt( entry->numGroups );
+		for ( j = 0 ; j < entry->numGroups ; j++ ) {
+			f->WriteInt( entry->numTris[j] );
+		}
+		f->Write( entry->verts.Ptr(), entry->verts.MemoryUsed() );
+	}
+
+	fileSystem->CloseFile( f );
+}
+
+/*
+====================
+AreaCacheKey
+
+Checksums everything the optimizer reads from an area's groups
+====================
+*/
+areaCacheKey_t AreaCacheKey( const optimizeGroup_t *groupList ) {
+	const optimizeGroup_t	*group;
+	const mapTri_t			*tri;
+	areaCacheKey_t			key;
+	int						length;
+
+	// per group the plane, flags, material name and a separator, so
+	// triangles can't move between groups unnoticed, then the vertexes
+	length = 0;
+	for ( group = groupList ; group ; group = group->nextGroup ) {
+		length += sizeof( idPlane ) + sizeof( int ) + strlen( group->material ? group->material->GetName() : "" ) + 2;
+		length += CountTriList( group->triList ) * sizeof( tri->v );
+	}
+
+	byte *data = (byte *)Mem_Alloc( Max( length, 1 ) );
+	byte *out = data;
+
+	for ( group = groupList ; group ; group = group->nextGroup ) {
+		const idPlane &plane = dmapGlobals.mapPlanes[group->planeNum];
+		const char *material = group->material ? group->material->GetName() : "";
+		const int flags = ( group->smoothed ? 1 : 0 ) | ( group->mergeGroup ? 2 : 0 ) | ( ( group->material && group->material->IsDiscrete() ) ? 4 : 0 );
+
+		memcpy( out, &plane, sizeof( plane ) );
+		out += sizeof( plane );
+		memcpy( out, &flags, sizeof( flags ) );
+		out += sizeof( flags );
+		memcpy( out, material, strlen( material ) + 1 );
+		out += strlen( material ) + 1;
+
+		for ( tri = group->triList ; tri ; tri = tri->next ) {
+			memcpy( out, tri->v, sizeof( tri->v ) );
+			out += sizeof( tri->v );
+		}
+
+		*out++ = 0xff;
+	}
+	assert( out - data == length );
+
+	key.crc = CRC32_BlockChecksum( data, length );
+	key.md5 = MD5_BlockChecksum( data, length );
+	key.length = length;
+
+	Mem_Free( data );
+
+	return key;
+}
+
+/*
+====================
+RestoreCachedArea
+
+Replaces the triangles of the groups with the cached optimizer
+output, returns false if the area isn't in the cache
+====================
+*/
+bool RestoreCachedArea( optimizeGroup_t *groupList, const areaCacheKey_t &key ) {
+	const areaCacheEntry_t	*entry = NULL;
+	optimizeGroup_t			*group;
+	int						i, numGroups;
+
+	for ( i = oldEntryHash.First( key.crc ) ; i != -1 ; i = oldEntryHash.Next( i ) ) {
+		if ( oldEntries[i]->key.md5 == key.md5 && oldEntries[i]->key.length == key.length ) {
+			entry = oldEntries[i];
+			break;
+		}
+	}
+	if ( !entry ) {
+		return false;
+	}
+
+	numGroups = 0;
+	for ( group = groupList ; group ; group = group->nextGroup ) {
+		numGroups++;
+	}
+	if ( numGroups != entry->numGroups ) {
+		return false;
+	}
+
+	const idDrawVert *v = entry->verts.Ptr();
+	for ( group = groupList, i = 0 ; group ; group = group->nextGroup, i++ ) {
+		mapTri_t *triList = NULL;
+
+		for ( int j = 0 ; j < entry->numTris[i] ; j++, v += 3 ) {
+			mapTri_t *tri = AllocTri();
+			tri->material = group->material;
+			tri->mergeGroup = group->mergeGroup;
+			tri->planeNum = group->planeNum;
+			tri->v[0] = v[0];
+			tri->v[1] = v[1];
+			tri->v[2] = v[2];
+			tri->next = triList;
+			triList = tri;
+		}
+
+		FreeTriList( group->triList );
+		group->triList = triList;
+	}
+
+	#pragma omp critical( areaCache )
+	{
+		if ( newEntries.FindIndex( const_cast<areaCacheEntry_t *>( entry ) ) == -1 ) {
+			newEntries.Append( const_cast<areaCacheEntry_t *>( entry ) );
+		}
+		c_reusedAreas++;
+	}
+
+	return true;
+}
+
+/*
+====================
+StoreCachedArea
+
+Remembers the optimizer output of an area for the next run
+====================
+*/
+void StoreCachedArea( const optimizeGroup_t *groupList, const areaCacheKey_t &key ) {
+	areaCacheEntry_t		*entry = new areaCacheEntry_t;
+	const optimizeGroup_t	*group;
+	const mapTri_t			*tri;
+	int						i, j;
+
+	entry->key = key;
+	entry->numGroups = 0;
+	for ( group = groupList ; group ; group = group->nextGroup ) {
+		entry->numTris.Append( CountTriList( group->triList ) );
+		entry->numGroups++;
+	}
+
+	entry->verts.SetNum( CountGroupListTris( groupList ) * 3 );
+
+	// triangle lists are built by prepending, so store them back to
+	// front and RestoreCachedArea ends up with the original order
+	int first = 0;
+	for ( group = groupList, i = 0 ; group ; group = group->nextGroup, i++ ) {
+		for ( tri = group->triList, j = entry->numTris[i] - 1 ; tri ; tri = tri->next, j-- ) {
+			entry->verts[first + j * 3 + 0] = tri->v[0];
+			entry->verts[first + j * 3 + 1] = tri->v[1];
+			entry->verts[first + j * 3 + 2] = tri->v[2];
+		}
+		first += entry->numTris[i] * 3;
+	}
+
+	#pragma omp critical( areaCache )
+	{
+		newEntries.Append( entry );
+		c_optimizedAreas++;
+	}
+}
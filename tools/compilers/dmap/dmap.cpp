@@ -198,7 +198,9 @@ void DmapHelp( void ) {
 	"noAAS             = don't create AAS files\n"
 	"v                 = verbose mode (default pre TDM 2.04)"
 	"v2                = very verbose mode"
-	"verboseentities   = very verbose + submodel detail for entities. Requires v2"
+	"verboseentities   = very verbose + submodel detail for entities. Requires v2\n"
+	"noParallel        = optimize one area at a time\n"
+	"incremental       = reuse the optimized areas of the previous run that didn't change\n"
 	);
 }
 
@@ -228,11 +230,17 @@ void ResetDmapGlobals( void ) {
 	dmapGlobals.noClipSides = false;
 	dmapGlobals.noLightCarve = false;
 	dmapGlobals.noShadow = false;
+	dmapGlobals.noParallel = false;
+	dmapGlobals.incremental = false;
 	dmapGlobals.shadowOptLevel = SO_NONE;
 	dmapGlobals.drawBounds.Clear();
 	dmapGlobals.drawflag = false;
 	dmapGlobals.totalShadowTriangles = 0;
 	dmapGlobals.totalShadowVerts = 0;
+	dmapGlobals.leaked = false;
+	dmapGlobals.dmapTime = 0;
+	dmapGlobals.collisionTime = 0;
+	dmapGlobals.aasTime = 0;
 }
 
 /*
@@ -325,6 +333,12 @@ void Dmap( const idCmdArgs &args ) {
 			dmapGlobals.noTJunc = true;
 			dmapGlobals.noOptimize = true;
 			common->Printf ("forcing noOptimize = true\n" );
+		} else if ( !idStr::Icmp( s, "incremental" ) ) {
+			common->Printf( "incremental = true\n" );
+			dmapGlobals.incremental = true;
+		} else if ( !idStr::Icmp( s, "noParallel" ) ) {
+			common->Printf( "noParallel = true\n" );
+			dmapGlobals.noParallel = true;
 		} else if ( !idStr::Icmp( s, "noCM" ) ) {
 			noCM = true;
 			common->Printf( "noCM = true\n" );
@@ -390,13 +404,21 @@ void Dmap( const idCmdArgs &args ) {
 		return;
 	}
 
+	if ( dmapGlobals.incremental ) {
+		LoadAreaCache();
+	}
+
 	if ( ProcessModels() ) {
 		WriteOutputFile();
+		if ( dmapGlobals.incremental ) {
+			WriteAreaCache();
+		}
 		PrintIfVerbosityAtLeast( VL_CONCISE, "Dmap complete, moving on to collision world and AAS...\n");
 	} else {
 		leaked = true;
 	}
 
+	FreeAreaCache();
 	FreeDMapFile();
 
 	PrintIfVerbosityAtLeast( VL_CONCISE, "%i total shadow triangles\n", dmapGlobals.totalShadowTriangles );
@@ -406,6 +428,9 @@ void Dmap( const idCmdArgs &args ) {
 	PrintIfVerbosityAtLeast( VL_CONCISE, "-----------------------\n" );
 	PrintIfVerbosityAtLeast( VL_CONCISE, "%5.0f seconds for dmap\n", ( end - start ) * 0.001f );
 
+	dmapGlobals.leaked = leaked;
+	dmapGlobals.dmapTime = end - start;
+
 	if ( !leaked ) {
 
 		if ( !noCM ) {
@@ -425,11 +450,14 @@ void Dmap( const idCmdArgs &args ) {
 			end = Sys_Milliseconds();
 			PrintIfVerbosityAtLeast( VL_CONCISE, "-------------------------------------\n" );
 			PrintIfVerbosityAtLeast( VL_CONCISE, "%5.0f seconds to create collision map\n", ( end - start ) * 0.001f );
+			dmapGlobals.collisionTime = end - start;
 		}
 
 		if ( !noAAS && !region ) {
-			// create AAS files
-			RunAAS_f( args );
+			// create AAS files, keeping the dmap warnings
+			start = Sys_Milliseconds();
+			RunAAS( args );
+			dmapGlobals.aasTime = Sys_Milliseconds() - start;
 		}
 	}
 
@@ -464,3 +492,141 @@ void Dmap_f( const idCmdArgs &args ) {
 
 	common->PrintWarnings();
 }
+
+/*
+============
+DmapBatchText
+
+Makes a message fit in one field of the report
+============
+*/
+static idStr DmapBatchText( const char *text ) {
+	idStr str = text;
+
+	str.RemoveColors();
+	str.Replace( '\t', ' ' );
+	str.Replace( '\r', ' ' );
+	str.Replace( '\n', ' ' );
+	str.StripWhitespace();
+
+	return str;
+}
+
+/*
+============
+DmapBatch_f
+
+Compiles every map of a list file with the same options in one
+session, so the decls, materials and models are only loaded once.
+Writes a tab separated report next to the list with one "map" line
+per map and its "warning" and "error" lines, for build machines.
+============
+*/
+void DmapBatch_f( const idCmdArgs &args ) {
+	idStrList	maps;
+	idStr		listName, reportName, line;
+	char		*buffer;
+	idFile		*report;
+	int			i, j, start, total;
+	int			numOk, numLeaked, numFailed;
+
+	if ( args.Argc() < 2 ) {
+		common->Printf( "Usage: dmapBatch [dmap options] mapListFile\n"
+			"The list has one map per line, empty lines and lines starting with // are skipped.\n"
+			"The report is written to the list name with a .report extension.\n" );
+		return;
+	}
+
+	listName = args.Argv( args.Argc() - 1 );
+	if ( fileSystem->ReadFile( listName, (void **)&buffer ) < 0 ) {
+		common->Warning( "dmapBatch: couldn't read %s", listName.c_str() );
+		return;
+	}
+
+	for ( const char *s = buffer ; *s ; s++ ) {
+		if ( *s != '\n' ) {
+			line += *s;
+			if ( s[1] != '\0' ) {
+				continue;
+			}
+		}
+		line.StripWhitespace();
+		if ( line.Length() && line.Cmpn( "//", 2 ) ) {
+			maps.Append( line );
+		}
+		line.Empty();
+	}
+	fileSystem->FreeFile( buffer );
+
+	reportName = listName;
+	reportName.SetFileExtension( "report" );
+	report = fileSystem->OpenFileWrite( reportName, "fs_devpath", "" );
+	if ( !report ) {
+		common->Warning( "dmapBatch: couldn't write %s", reportName.c_str() );
+		return;
+	}
+	report->Printf( "# map\tname\tresult\twarnings\tdmap seconds\tcollision seconds\taas seconds\ttotal seconds\n" );
+	report->Printf( "# warning\tname\tmessage\n" );
+	report->Printf( "# error\tname\tmessage\n" );
+
+	numOk = numLeaked = numFailed = 0;
+
+	common->SetRefreshOnPrint( true );
+
+	for ( i = 0 ; i < maps.Num() ; i++ ) {
+		idCmdArgs	dmapArgs;
+		const char	*result;
+		idStr		error;
+
+		dmapArgs.AppendArg( "dmap" );
+		for ( j = 1 ; j < args.Argc() - 1 ; j++ ) {
+			dmapArgs.AppendArg( args.Argv( j ) );
+		}
+		dmapArgs.AppendArg( maps[i] );
+
+		common->Printf( "==== dmapBatch %d of %d: %s ====\n", i + 1, maps.Num(), maps[i].c_str() );
+		common->ClearWarnings( va( "running dmap on %s", maps[i].c_str() ) );
+
+		start = Sys_Milliseconds();
+
+		// an error only ends this map, the others are still compiled
+		try {
+			Dmap( dmapArgs );
+			if ( dmapGlobals.leaked ) {
+				result = "leaked";
+				numLeaked++;
+			} else {
+				result = "ok";
+				numOk++;
+			}
+		}
+		catch( idException &ex ) {
+			result = "error";
+			error = ex.error;
+			numFailed++;
+		}
+
+		total = Sys_Milliseconds() - start;
+
+		common->PrintWarnings();
+
+		const idStrList &warnings = common->GetWarnings();
+
+		report->Printf( "map\t%s\t%s\t%d\t%.3f\t%.3f\t%.3f\t%.3f\n", maps[i].c_str(), result, warnings.Num(),
+			dmapGlobals.dmapTime * 0.001f, dmapGlobals.collisionTime * 0.001f, dmapGlobals.aasTime * 0.001f, total * 0.001f );
+		for ( j = 0 ; j < warnings.Num() ; j++ ) {
+			report->Printf( "warning\t%s\t%s\n", maps[i].c_str(), DmapBatchText( warnings[j] ).c_str() );
+		}
+		if ( error.Length() ) {
+			report->Printf( "error\t%s\t%s\n", maps[i].c_str(), DmapBatchText( error ).c_str() );
+		}
+		report->Flush();
+	}
+
+	common->SetRefreshOnPrint( false );
+
+	fileSystem->CloseFile( report );
+
+	common->Printf( "dmapBatch: %d maps compiled, %d leaked, %d failed, report written to %s\n",
+		numOk, numLeaked, numFailed, reportName.c_str() );
+}
@@ -258,12 +258,20 @@ typedef struct {
 	bool	noLightCarve;		// extra triangle subdivision by light frustums
 	shadowOptLevel_t	shadowOptLevel;
 	bool	noShadow;			// don't create optimized shadow volumes
+	bool	noParallel;			// optimize areas one at a time
+	bool	incremental;		// reuse unchanged areas from the area cache
 
 	idBounds	drawBounds;
 	bool	drawflag;
 
 	int		totalShadowTriangles;
 	int		totalShadowVerts;
+
+	// results of the last dmap, reported by dmapBatch
+	bool	leaked;
+	int		dmapTime;			// milliseconds
+	int		collisionTime;
+	int		aasTime;
 } dmapGlobals_t;
 
 extern dmapGlobals_t dmapGlobals;
@@ -400,6 +408,8 @@ int		CountGroupListTris( const optimizeGroup_t *groupList );
 void	FixEntityTjunctions( uEntity_t *e );
 void	FixAreaGroupsTjunctions( optimizeGroup_t *groupList );
 void	FixGlobalTjunctions( uEntity_t *e );
+void	BeginThreadTJunctionHash( void );	// gives the calling thread its own hash
+void	EndThreadTJunctionHash( void );
 
 //=============================================================================
 
@@ -442,6 +452,64 @@ typedef struct {
 	optTri_t	*tris;
 } optIsland_t;
 
+typedef struct {
+	optVertex_t	*v1, *v2;
+} originalEdges_t;
+
+#define	MAX_OPT_VERTEXES	0x10000
+#define	MAX_OPT_EDGES		0x40000
+#define	OPT_HASH_SIZE		0x4000		// bins for the vertex and original edge lookups
+
+// timed steps of the optimizer, printed by OptimizeEntity
+typedef enum {
+	OPT_PHASE_TJUNCTIONS,
+	OPT_PHASE_ORIGINAL_EDGES,
+	OPT_PHASE_CROSSINGS,
+	OPT_PHASE_ISLANDS,
+	OPT_NUM_PHASES
+} optPhase_t;
+
+// working set of the optimizer, areas are optimized in parallel
+// so every worker thread gets its own
+typedef struct {
+	idBounds		optBounds;
+
+	int				numOptVerts;
+	optVertex_t		optVerts[MAX_OPT_VERTEXES];
+	int				optVertHash[OPT_HASH_SIZE];		// first vertex of each bin, -1 if empty
+	int				optVertHashNext[MAX_OPT_VERTEXES];
+
+	int				numOptEdges;
+	optEdge_t		optEdges[MAX_OPT_EDGES];
+
+	originalEdges_t	*originalEdges;
+	int				numOriginalEdges;
+	int				originalEdgeHash[OPT_HASH_SIZE];
+	int				*originalEdgeHashNext;
+
+	double			phaseTicks[OPT_NUM_PHASES];
+} optimizeState_t;
+
+extern ID_THREAD_LOCAL optimizeState_t *optState;
+
+int		OptVertexHash( float x, float y );
+
+//=============================================================================
+
+// areacache.cpp -- reuses the optimized triangles of unchanged areas (dmap -incremental)
+
+typedef struct {
+	unsigned int	crc;
+	unsigned int	md5;
+	int				length;
+} areaCacheKey_t;
+
+void			LoadAreaCache( void );
+void			WriteAreaCache( void );
+void			FreeAreaCache( void );
+areaCacheKey_t	AreaCacheKey( const optimizeGroup_t *groupList );
+bool			RestoreCachedArea( optimizeGroup_t *groupList, const areaCacheKey_t &key );
+void			StoreCachedArea( const optimizeGroup_t *groupList, const areaCacheKey_t &key );
 
 void	OptimizeEntity( uEntity_t *e );
 void	OptimizeGroupList( optimizeGroup_t *groupList );
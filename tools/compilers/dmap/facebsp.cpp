@@ -182,6 +182,7 @@ int SelectSplitPlaneNum( node_t *node, bspface_t *list ) {
 	bspface_t	*check;
 	bspface_t	*bestSplit;
 	int			splits, facing, front, back;
+	int			numFaces, remaining, axialValue;
 	int			side;
 	idPlane		*mapPlane;
 	int			value, bestValue;
@@ -219,11 +220,13 @@ int SelectSplitPlaneNum( node_t *node, bspface_t *list ) {
 	bestSplit = list;
 
 	havePortals = false;
+	numFaces = 0;
 	for ( split = list ; split ; split = split->next ) {
 		split->checked = false;
 		if ( split->portal ) {
 			havePortals = true;
 		}
+		numFaces++;
 	}
 
 	for ( split = list ; split ; split = split->next ) {
@@ -234,11 +237,22 @@ int SelectSplitPlaneNum( node_t *node, bspface_t *list ) {
 			continue;
 		}
 		mapPlane = &dmapGlobals.mapPlanes[ split->planenum ];
+		axialValue = ( mapPlane->Type() < PLANETYPE_TRUEAXIAL ) ? 5 : 0;
 		splits = 0;
 		facing = 0;
 		front = 0;
 		back = 0;
+		remaining = numFaces;
 		for ( check = list ; check ; check = check->next ) {
+			// stop as soon as the plane can't beat the best one even if all
+			// the remaining faces are on it. Faces on the plane that are
+			// not reached aren't marked checked, they will get the same
+			// value when tried and can't win either.
+			if ( 5*(facing + remaining) - 5*splits + axialValue <= bestValue ) {
+				break;
+			}
+			remaining--;
+
 			if ( check->planenum == split->planenum ) {
 				facing++;
 				check->checked = true;	// won't need to test this plane again
@@ -253,10 +267,11 @@ int SelectSplitPlaneNum( node_t *node, bspface_t *list ) {
 				back++;
 			}
 		}
-		value =  5*facing - 5*splits; // - abs(front-back);
-		if ( mapPlane->Type() < PLANETYPE_TRUEAXIAL ) {
-			value+=5;		// axial is better
+		if ( check ) {
+			continue;
 		}
+		value =  5*facing - 5*splits; // - abs(front-back);
+		value += axialValue;		// axial is better
 
 		if ( value > bestValue ) {
 			bestValue = value;
@@ -40,15 +40,9 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 */
 
-idBounds	optBounds;
-
-#define	MAX_OPT_VERTEXES	0x10000
-int			numOptVerts;
-optVertex_t optVerts[MAX_OPT_VERTEXES];
-
-#define	MAX_OPT_EDGES		0x40000
-static	int		numOptEdges;
-static	optEdge_t	optEdges[MAX_OPT_EDGES];
+// used by the main thread, workers allocate their own in OptimizeEntity
+static optimizeState_t	mainOptState;
+ID_THREAD_LOCAL optimizeState_t	*optState = &mainOptState;
 
 static bool IsTriangleValid( const optVertex_t *v1, const optVertex_t *v2, const optVertex_t *v3 );
 static bool IsTriangleDegenerate( const optVertex_t *v1, const optVertex_t *v2, const optVertex_t *v3 );
@@ -93,11 +87,11 @@ AllocEdge
 static optEdge_t	*AllocEdge( void ) {
 	optEdge_t	*e;
 
-	if ( numOptEdges == MAX_OPT_EDGES ) {
+	if ( optState->numOptEdges == MAX_OPT_EDGES ) {
 		common->Error( "MAX_OPT_EDGES" );
 	}
-	e = &optEdges[ numOptEdges ];
-	numOptEdges++;
+	e = &optState->optEdges[ optState->numOptEdges ];
+	optState->numOptEdges++;
 	memset( e, 0, sizeof( *e ) );
 
 	return e;
@@ -174,6 +168,25 @@ static	void LinkEdge( optEdge_t *e ) {
 	e->v2->edges = e;
 }
 
+/*
+================
+OptVertexHash
+
+Vertexes are only shared when they project to exactly
+the same 2D point, so the bits of the coordinates are hashed
+================
+*/
+int OptVertexHash( float x, float y ) {
+	// -0 and 0 compare equal, so they have to land in the same bin
+	x = ( x == 0.0f ) ? 0.0f : x;
+	y = ( y == 0.0f ) ? 0.0f : y;
+
+	const unsigned int ix = *reinterpret_cast<unsigned int *>( &x );
+	const unsigned int iy = *reinterpret_cast<unsigned int *>( &y );
+
+	return ( ( ix * 73856093u ) ^ ( iy * 19349663u ) ) & ( OPT_HASH_SIZE - 1 );
+}
+
 #ifdef __linux__
 
 optVertex_t *FindOptVertex( idDrawVert *v, optimizeGroup_t *opt );
@@ -186,7 +199,7 @@ FindOptVertex
 ================
 */
 static optVertex_t *FindOptVertex( idDrawVert *v, optimizeGroup_t *opt ) {
-	int		i;
+	int		i, hash;
 	float	x, y;
 	optVertex_t	*vert;
 
@@ -195,27 +208,30 @@ static optVertex_t *FindOptVertex( idDrawVert *v, optimizeGroup_t *opt ) {
 	y = v->xyz * opt->axis[1];
 
 	// should we match based on the t-junction fixing hash verts?
-	for ( i = 0 ; i < numOptVerts ; i++ ) {
-		if ( optVerts[i].pv[0] == x && optVerts[i].pv[1] == y ) {
-			return &optVerts[i];
+	hash = OptVertexHash( x, y );
+	for ( i = optState->optVertHash[hash] ; i != -1 ; i = optState->optVertHashNext[i] ) {
+		if ( optState->optVerts[i].pv[0] == x && optState->optVerts[i].pv[1] == y ) {
+			return &optState->optVerts[i];
 		}
 	}
 
-	if ( numOptVerts >= MAX_OPT_VERTEXES ) {
+	if ( optState->numOptVerts >= MAX_OPT_VERTEXES ) {
 		common->Error( "MAX_OPT_VERTEXES" );
 		return NULL;
 	}
 	
-	numOptVerts++;
+	i = optState->numOptVerts++;
+	optState->optVertHashNext[i] = optState->optVertHash[hash];
+	optState->optVertHash[hash] = i;
 
-	vert = &optVerts[i];
+	vert = &optState->optVerts[i];
 	memset( vert, 0, sizeof( *vert ) );
 	vert->v = *v;
 	vert->pv[0] = x;
 	vert->pv[1] = y;
 	vert->pv[2] = 0;
 
-	optBounds.AddPoint( vert->pv );
+	optState->optBounds.AddPoint( vert->pv );
 
 	return vert;
 }
@@ -237,14 +253,14 @@ static	void DrawAllEdges( void ) {
 	Draw_ClearWindow();
 
 	qglBegin( GL_LINES );
-	for ( i = 0 ; i < numOptEdges ; i++ ) {
-		if ( optEdges[i].v1 == NULL ) {
+	for ( i = 0 ; i < optState->numOptEdges ; i++ ) {
+		if ( optState->optEdges[i].v1 == NULL ) {
 			continue;
 		}
 		qglColor3f( 1, 0, 0 );
-		qglVertex3fv( optEdges[i].v1->pv.ToFloatPtr() );
+		qglVertex3fv( optState->optEdges[i].v1->pv.ToFloatPtr() );
 		qglColor3f( 0, 0, 0 );
-		qglVertex3fv( optEdges[i].v2->pv.ToFloatPtr() );
+		qglVertex3fv( optState->optEdges[i].v2->pv.ToFloatPtr() );
 	}
 	qglEnd();
 	qglFlush();
@@ -1292,10 +1308,6 @@ static	void RemoveInteriorEdges( optIsland_t *island ) {
 
 //==================================================================================
 
-typedef struct {
-	optVertex_t	*v1, *v2;
-} originalEdges_t;
-
 /*
 =================
 AddEdgeIfNotAlready
@@ -1361,9 +1373,6 @@ typedef struct edgeCrossing_s {
 	optVertex_t		*ov;
 } edgeCrossing_t;
 
-static	originalEdges_t	*originalEdges;
-static	int				numOriginalEdges;
-
 /*
 =================
 AddOriginalTriangle
@@ -1389,21 +1398,24 @@ static void AddOriginalTriangle( optVertex_t *v[3] ) {
 			continue;
 		}
 		int j;
-		// see if there is an existing one
-		for ( j = 0 ; j < numOriginalEdges ; j++ ) {
-			if ( originalEdges[j].v1 == v1 && originalEdges[j].v2 == v2 ) {
+		// see if there is an existing one, the hash doesn't care about the direction
+		int hash = ( ( v1 - optState->optVerts ) ^ ( v2 - optState->optVerts ) ) & ( OPT_HASH_SIZE - 1 );
+		for ( j = optState->originalEdgeHash[hash] ; j != -1 ; j = optState->originalEdgeHashNext[j] ) {
+			if ( optState->originalEdges[j].v1 == v1 && optState->originalEdges[j].v2 == v2 ) {
 				break;
 			}
-			if ( originalEdges[j].v2 == v1 && originalEdges[j].v1 == v2 ) {
+			if ( optState->originalEdges[j].v2 == v1 && optState->originalEdges[j].v1 == v2 ) {
 				break;
 			}
 		}
 
-		if ( j == numOriginalEdges ) {
+		if ( j == -1 ) {
 			// add it
-			originalEdges[j].v1 = v1;
-			originalEdges[j].v2 = v2;
-			numOriginalEdges++;
+			j = optState->numOriginalEdges++;
+			optState->originalEdges[j].v1 = v1;
+			optState->originalEdges[j].v2 = v2;
+			optState->originalEdgeHashNext[j] = optState->originalEdgeHash[hash];
+			optState->originalEdgeHash[hash] = j;
 		}
 	}
 }
@@ -1421,16 +1433,19 @@ static	void AddOriginalEdges( optimizeGroup_t *opt ) {
 	PrintIfVerbosityAtLeast( VL_VERBOSE, "----\n" );
 	PrintIfVerbosityAtLeast( VL_VERBOSE, "%6i original tris\n", CountTriList( opt->triList ) );
 
-	optBounds.Clear();
+	optState->optBounds.Clear();
 
 	// allocate space for max possible edges
 	numTris = CountTriList( opt->triList );
-	originalEdges = (originalEdges_t *)Mem_Alloc( numTris * 3 * sizeof( *originalEdges ) );
-	numOriginalEdges = 0;
+	optState->originalEdges = (originalEdges_t *)Mem_Alloc( numTris * 3 * sizeof( *optState->originalEdges ) );
+	optState->originalEdgeHashNext = (int *)Mem_Alloc( numTris * 3 * sizeof( *optState->originalEdgeHashNext ) );
+	optState->numOriginalEdges = 0;
+	memset( optState->originalEdgeHash, -1, sizeof( optState->originalEdgeHash ) );
 
 	// add all unique triangle edges
-	numOptVerts = 0;
-	numOptEdges = 0;
+	optState->numOptVerts = 0;
+	optState->numOptEdges = 0;
+	memset( optState->optVertHash, -1, sizeof( optState->optVertHash ) );
 	for ( tri = opt->triList ; tri ; tri = tri->next ) {
 		v[0] = tri->optVert[0] = FindOptVertex( &tri->v[0], opt );
 		v[1] = tri->optVert[1] = FindOptVertex( &tri->v[1], opt );
@@ -1440,6 +1455,153 @@ static	void AddOriginalEdges( optimizeGroup_t *opt ) {
 	}
 }
 
+/*
+=====================
+Edge grid
+
+A uniform 2D grid over the original edges of a group, so the
+crossing search only tests edges that are near each other instead
+of every pair. Large coplanar floors and terrain have thousands of
+edges, which made the all pairs test the slowest step of dmap.
+=====================
+*/
+
+#define	EDGE_GRID_MAX_CELLS		256		// per axis
+#define	EDGE_GRID_SLOP			1.0f	// edges this close share cells
+
+typedef struct {
+	int			size;					// cells per axis
+	float		mins[2];
+	float		scale[2];				// cells per unit
+	int			*cellStart;				// size*size+1 offsets into cellEdges
+	int			*cellEdges;
+	int			*edgeCells;				// inclusive cell rect of each edge, 4 ints per edge
+	int			*mark;					// last edge that collected each edge as a candidate
+} edgeGrid_t;
+
+/*
+=====================
+EdgeGridRect
+=====================
+*/
+static void EdgeGridRect( const edgeGrid_t &grid, const originalEdges_t *edge, int rect[4] ) {
+	for ( int axis = 0 ; axis < 2 ; axis++ ) {
+		float lo = Min( edge->v1->pv[axis], edge->v2->pv[axis] ) - EDGE_GRID_SLOP;
+		float hi = Max( edge->v1->pv[axis], edge->v2->pv[axis] ) + EDGE_GRID_SLOP;
+
+		rect[axis] = idMath::ClampInt( 0, grid.size - 1, (int)( ( lo - grid.mins[axis] ) * grid.scale[axis] ) );
+		rect[2+axis] = idMath::ClampInt( 0, grid.size - 1, (int)( ( hi - grid.mins[axis] ) * grid.scale[axis] ) );
+	}
+}
+
+/*
+=====================
+BuildEdgeGrid
+=====================
+*/
+static void BuildEdgeGrid( edgeGrid_t &grid ) {
+	const int numEdges = optState->numOriginalEdges;
+	int i, x, y;
+
+	// aim for a few edges per cell
+	grid.size = idMath::ClampInt( 1, EDGE_GRID_MAX_CELLS, (int)idMath::Sqrt( (float)numEdges * 0.5f ) );
+
+	for ( i = 0 ; i < 2 ; i++ ) {
+		float extent = optState->optBounds[1][i] - optState->optBounds[0][i];
+		grid.mins[i] = optState->optBounds[0][i];
+		grid.scale[i] = ( extent > 0.0f ) ? grid.size / extent : 0.0f;
+	}
+
+	const int numCells = grid.size * grid.size;
+	grid.cellStart = (int *)Mem_ClearedAlloc( ( numCells + 1 ) * sizeof( *grid.cellStart ) );
+	grid.edgeCells = (int *)Mem_Alloc( Max( numEdges, 1 ) * 4 * sizeof( *grid.edgeCells ) );
+	grid.mark = (int *)Mem_Alloc( Max( numEdges, 1 ) * sizeof( *grid.mark ) );
+
+	// count the edges of each cell
+	for ( i = 0 ; i < numEdges ; i++ ) {
+		int *rect = grid.edgeCells + i * 4;
+		EdgeGridRect( grid, &optState->originalEdges[i], rect );
+		for ( y = rect[1] ; y <= rect[3] ; y++ ) {
+			for ( x = rect[0] ; x <= rect[2] ; x++ ) {
+				grid.cellStart[y * grid.size + x + 1]++;
+			}
+		}
+		grid.mark[i] = -1;
+	}
+
+	for ( i = 0 ; i < numCells ; i++ ) {
+		grid.cellStart[i+1] += grid.cellStart[i];
+	}
+
+	// fill the cells, every cell lists its edges in ascending order
+	int *fill = (int *)Mem_Alloc( numCells * sizeof( *fill ) );
+	memcpy( fill, grid.cellStart, numCells * sizeof( *fill ) );
+	grid.cellEdges = (int *)Mem_Alloc( Max( grid.cellStart[numCells], 1 ) * sizeof( *grid.cellEdges ) );
+
+	for ( i = 0 ; i < numEdges ; i++ ) {
+		const int *rect = grid.edgeCells + i * 4;
+		for ( y = rect[1] ; y <= rect[3] ; y++ ) {
+			for ( x = rect[0] ; x <= rect[2] ; x++ ) {
+				grid.cellEdges[fill[y * grid.size + x]++] = i;
+			}
+		}
+	}
+
+	Mem_Free( fill );
+}
+
+/*
+=====================
+FreeEdgeGrid
+=====================
+*/
+static void FreeEdgeGrid( edgeGrid_t &grid ) {
+	Mem_Free( grid.cellStart );
+	Mem_Free( grid.cellEdges );
+	Mem_Free( grid.edgeCells );
+	Mem_Free( grid.mark );
+}
+
+/*
+=====================
+IntSort
+=====================
+*/
+static int IntSort( const void *a, const void *b ) {
+	return *(const int *)a - *(const int *)b;
+}
+
+/*
+=====================
+EdgeGridCandidates
+
+Collects the edges after <edgeNum> that share a cell with it,
+sorted by edge number. Returns the number of candidates.
+=====================
+*/
+static int EdgeGridCandidates( edgeGrid_t &grid, int edgeNum, int *candidates ) {
+	const int *rect = grid.edgeCells + edgeNum * 4;
+	int numCandidates = 0;
+
+	for ( int y = rect[1] ; y <= rect[3] ; y++ ) {
+		for ( int x = rect[0] ; x <= rect[2] ; x++ ) {
+			const int cell = y * grid.size + x;
+			for ( int i = grid.cellStart[cell] ; i < grid.cellStart[cell+1] ; i++ ) {
+				const int other = grid.cellEdges[i];
+				if ( other <= edgeNum || grid.mark[other] == edgeNum ) {
+					continue;
+				}
+				grid.mark[other] = edgeNum;
+				candidates[numCandidates++] = other;
+			}
+		}
+	}
+
+	qsort( candidates, numCandidates, sizeof( *candidates ), IntSort );
+
+	return numCandidates;
+}
+
 /*
 =====================
 SplitOriginalEdgesAtCrossings
@@ -1450,41 +1612,55 @@ void SplitOriginalEdgesAtCrossings( optimizeGroup_t *opt ) {
 	int				numOriginalVerts;
 	edgeCrossing_t	**crossings;
 
-	numOriginalVerts = numOptVerts;
+	numOriginalVerts = optState->numOptVerts;
 	// now split any crossing edges and create optEdges
 	// linked to the vertexes
 
 	// debug drawing bounds
-	dmapGlobals.drawBounds = optBounds;
+	if ( dmapGlobals.drawflag ) {
+		dmapGlobals.drawBounds = optState->optBounds;
 
-	dmapGlobals.drawBounds[0][0] -= 2;
-	dmapGlobals.drawBounds[0][1] -= 2;
-	dmapGlobals.drawBounds[1][0] += 2;
-	dmapGlobals.drawBounds[1][1] += 2;
+		dmapGlobals.drawBounds[0][0] -= 2;
+		dmapGlobals.drawBounds[0][1] -= 2;
+		dmapGlobals.drawBounds[1][0] += 2;
+		dmapGlobals.drawBounds[1][1] += 2;
+	}
 
 	// generate crossing points between all the original edges
-	crossings = (edgeCrossing_t **)Mem_ClearedAlloc( numOriginalEdges * sizeof( *crossings ) );
+	crossings = (edgeCrossing_t **)Mem_ClearedAlloc( optState->numOriginalEdges * sizeof( *crossings ) );
 
-	for ( i = 0 ; i < numOriginalEdges ; i++ ) {
+	edgeGrid_t	grid;
+	int			*candidates = (int *)Mem_Alloc( Max( optState->numOriginalEdges, 1 ) * sizeof( *candidates ) );
+	int			numCandidates;
+
+	BuildEdgeGrid( grid );
+
+	for ( i = 0 ; i < optState->numOriginalEdges ; i++ ) {
 		if ( dmapGlobals.drawflag ) {
-			DrawOriginalEdges( numOriginalEdges, originalEdges );
+			DrawOriginalEdges( optState->numOriginalEdges, optState->originalEdges );
 			qglBegin( GL_LINES );
 			qglColor3f( 0, 1, 0 );
-			qglVertex3fv( originalEdges[i].v1->pv.ToFloatPtr() );
+			qglVertex3fv( optState->originalEdges[i].v1->pv.ToFloatPtr() );
 			qglColor3f( 0, 0, 1 );
-			qglVertex3fv( originalEdges[i].v2->pv.ToFloatPtr() );
+			qglVertex3fv( optState->originalEdges[i].v2->pv.ToFloatPtr() );
 			qglEnd();
 			qglFlush();
 		}
-		for ( j = i+1 ; j < numOriginalEdges ; j++ ) {
+		// only the edges sharing a grid cell with this one can cross it,
+		// they are still visited in index order, as testing all of them did
+		numCandidates = EdgeGridCandidates( grid, i, candidates );
+
+		for ( k = 0 ; k < numCandidates ; k++ ) {
 			optVertex_t	*v1, *v2, *v3, *v4;
 			optVertex_t	*newVert;
 			edgeCrossing_t	*cross;
 
-			v1 = originalEdges[i].v1;
-			v2 = originalEdges[i].v2;
-			v3 = originalEdges[j].v1;
-			v4 = originalEdges[j].v2;
+			j = candidates[k];
+
+			v1 = optState->originalEdges[i].v1;
+			v2 = optState->originalEdges[i].v2;
+			v3 = optState->originalEdges[j].v1;
+			v4 = optState->originalEdges[j].v2;
 
 			if ( !EdgesCross( v1, v2, v3, v4 ) ) {
 				continue;
@@ -1497,8 +1673,8 @@ void SplitOriginalEdgesAtCrossings( optimizeGroup_t *opt ) {
 			newVert = EdgeIntersection( v1, v2, v3, v4, opt );
 
 			if ( !newVert ) {
-//common->Printf( "lines %i (%i to %i) and %i (%i to %i) are colinear\n", i, v1 - optVerts, v2 - optVerts, 
-//		   j, v3 - optVerts, v4 - optVerts );	// !@#
+//common->Printf( "lines %i (%i to %i) and %i (%i to %i) are colinear\n", i, v1 - optState->optVerts, v2 - optState->optVerts, 
+//		   j, v3 - optState->optVerts, v4 - optState->optVerts );	// !@#
 				// colinear, so add both verts of each edge to opposite
 				if ( VertexBetween( v3, v1, v2 ) ) {
 					cross = (edgeCrossing_t *)Mem_ClearedAlloc( sizeof( *cross ) );
@@ -1532,11 +1708,11 @@ void SplitOriginalEdgesAtCrossings( optimizeGroup_t *opt ) {
 			}
 #if 0
 if ( newVert && newVert != v1 && newVert != v2 && newVert != v3 && newVert != v4 ) {
-common->Printf( "lines %i (%i to %i) and %i (%i to %i) cross at new point %i\n", i, v1 - optVerts, v2 - optVerts, 
-		   j, v3 - optVerts, v4 - optVerts, newVert - optVerts );
+common->Printf( "lines %i (%i to %i) and %i (%i to %i) cross at new point %i\n", i, v1 - optState->optVerts, v2 - optState->optVerts, 
+		   j, v3 - optState->optVerts, v4 - optState->optVerts, newVert - optState->optVerts );
 } else if ( newVert ) {
-common->Printf( "lines %i (%i to %i) and %i (%i to %i) intersect at old point %i\n", i, v1 - optVerts, v2 - optVerts, 
-		  j, v3 - optVerts, v4 - optVerts, newVert - optVerts );
+common->Printf( "lines %i (%i to %i) and %i (%i to %i) intersect at old point %i\n", i, v1 - optState->optVerts, v2 - optState->optVerts, 
+		  j, v3 - optState->optVerts, v4 - optState->optVerts, newVert - optState->optVerts );
 }
 #endif
 			if ( newVert != v1 && newVert != v2 ) {
@@ -1556,10 +1732,12 @@ common->Printf( "lines %i (%i to %i) and %i (%i to %i) intersect at old point %i
 		}
 	}
 
+	FreeEdgeGrid( grid );
+	Mem_Free( candidates );
 
 	// now split each edge by its crossing points
 	// colinear edges will have duplicated edges added, but it won't hurt anything
-	for ( i = 0 ; i < numOriginalEdges ; i++ ) {
+	for ( i = 0 ; i < optState->numOriginalEdges ; i++ ) {
 		edgeCrossing_t	*cross, *nextCross;
 		int				numCross;
 		optVertex_t		**sorted;
@@ -1570,8 +1748,8 @@ common->Printf( "lines %i (%i to %i) and %i (%i to %i) intersect at old point %i
 		}
 		numCross += 2;	// account for originals
 		sorted = (optVertex_t **)Mem_Alloc( numCross * sizeof( *sorted ) );
-		sorted[0] = originalEdges[i].v1;
-		sorted[1] = originalEdges[i].v2;
+		sorted[0] = optState->originalEdges[i].v1;
+		sorted[1] = optState->originalEdges[i].v2;
 		j = 2;
 		for ( cross = crossings[i] ; cross ; cross = nextCross ) {
 			nextCross = cross->next;
@@ -1596,7 +1774,7 @@ common->Printf( "lines %i (%i to %i) and %i (%i to %i) intersect at old point %i
 					}
 				}
 				if ( l == numCross ) {
-//common->Printf( "line %i fragment from point %i to %i\n", i, sorted[j] - optVerts, sorted[k] - optVerts );
+//common->Printf( "line %i fragment from point %i to %i\n", i, sorted[j] - optState->optVerts, sorted[k] - optState->optVerts );
 					AddEdgeIfNotAlready( sorted[j], sorted[k] );
 				}
 			}
@@ -1607,22 +1785,29 @@ common->Printf( "lines %i (%i to %i) and %i (%i to %i) intersect at old point %i
 
 
 	Mem_Free( crossings );
-	Mem_Free( originalEdges );
+	Mem_Free( optState->originalEdges );
+	Mem_Free( optState->originalEdgeHashNext );
+
+	// check for duplicated edges, a duplicate shares v1 so
+	// only the edges linked to that vertex need to be looked at
+	for ( i = 0 ; i < optState->numOptEdges ; i++ ) {
+		const optEdge_t	*e1 = &optState->optEdges[i];
+		const optVertex_t *v1 = e1->v1;
 
-	// check for duplicated edges
-	for ( i = 0 ; i < numOptEdges ; i++ ) {
-		for ( j = i+1 ; j < numOptEdges ; j++ ) {
-			if ( ( optEdges[i].v1 == optEdges[j].v1 && optEdges[i].v2 == optEdges[j].v2 ) 
-				|| ( optEdges[i].v1 == optEdges[j].v2 && optEdges[i].v2 == optEdges[j].v1 ) ) {
+		for ( const optEdge_t *e2 = v1->edges ; e2 ; e2 = ( e2->v1 == v1 ) ? e2->v1link : e2->v2link ) {
+			if ( e2 <= e1 ) {
+				continue;
+			}
+			if ( ( e1->v1 == e2->v1 && e1->v2 == e2->v2 ) || ( e1->v1 == e2->v2 && e1->v2 == e2->v1 ) ) {
 				PrintIfVerbosityAtLeast( VL_ORIGDEFAULT, "duplicated optEdge\n" );
 			}
 		}
 	}
 
-	PrintIfVerbosityAtLeast( VL_VERBOSE, "%6i original edges\n", numOriginalEdges );
-	PrintIfVerbosityAtLeast( VL_VERBOSE, "%6i edges after splits\n", numOptEdges );
+	PrintIfVerbosityAtLeast( VL_VERBOSE, "%6i original edges\n", optState->numOriginalEdges );
+	PrintIfVerbosityAtLeast( VL_VERBOSE, "%6i edges after splits\n", optState->numOptEdges );
 	PrintIfVerbosityAtLeast( VL_VERBOSE, "%6i original vertexes\n", numOriginalVerts );
-	PrintIfVerbosityAtLeast( VL_VERBOSE, "%6i vertexes after splits\n", numOptVerts );
+	PrintIfVerbosityAtLeast( VL_VERBOSE, "%6i vertexes after splits\n", optState->numOptVerts );
 }
 
 //=================================================================
@@ -1783,14 +1968,14 @@ static void SeparateIslands( optimizeGroup_t *opt ) {
 	DrawAllEdges();
 
 	numIslands = 0;
-	for ( i = 0 ; i < numOptVerts ; i++ ) {
-		if ( optVerts[i].addedToIsland ) {
+	for ( i = 0 ; i < optState->numOptVerts ; i++ ) {
+		if ( optState->optVerts[i].addedToIsland ) {
 			continue;
 		}
 		numIslands++;
 		memset( &island, 0, sizeof( island ) );
 		island.group = opt;
-		AddVertexToIsland_r( &optVerts[i], &island );
+		AddVertexToIsland_r( &optState->optVerts[i], &island );
 		OptimizeIsland( &island );
 	}
 	if ( dmapGlobals.verbose ) {
@@ -1808,14 +1993,14 @@ static void DontSeparateIslands( optimizeGroup_t *opt ) {
 	island.group = opt;
 
 	// link everything together
-	for ( i = 0 ; i < numOptVerts ; i++ ) {
-		optVerts[i].islandLink = island.verts;
-		island.verts = &optVerts[i];
+	for ( i = 0 ; i < optState->numOptVerts ; i++ ) {
+		optState->optVerts[i].islandLink = island.verts;
+		island.verts = &optState->optVerts[i];
 	}
 
-	for ( i = 0 ; i < numOptEdges ; i++ ) {
-		optEdges[i].islandLink = island.edges;
-		island.edges = &optEdges[i];
+	for ( i = 0 ; i < optState->numOptEdges ; i++ ) {
+		optState->optEdges[i].islandLink = island.edges;
+		island.edges = &optState->optEdges[i];
 	}
 
 	OptimizeIsland( &island );
@@ -1854,6 +2039,19 @@ static bool PointInSourceTris( float x, float y, float z, optimizeGroup_t *opt )
 	return false;
 }
 
+/*
+====================
+AddPhaseTime
+
+Adds the time since <start> to a phase, returns the current time
+====================
+*/
+static double AddPhaseTime( optPhase_t phase, double start ) {
+	double now = Sys_GetClockTicks();
+	optState->phaseTicks[phase] += now - start;
+	return now;
+}
+
 /*
 ====================
 OptimizeOptList
@@ -1865,16 +2063,20 @@ static	void OptimizeOptList( optimizeGroup_t *opt ) {
 	// fix the t junctions among this single list
 	// so we can match edges
 	// can we avoid doing this if colinear vertexes break edges?
+	double start = Sys_GetClockTicks();
 	oldNext = opt->nextGroup;
 	opt->nextGroup = NULL;
 	FixAreaGroupsTjunctions( opt );
 	opt->nextGroup = oldNext;
+	start = AddPhaseTime( OPT_PHASE_TJUNCTIONS, start );
 
 	// create the 2D vectors
 	dmapGlobals.mapPlanes[opt->planeNum].Normal().NormalVectors( opt->axis[0], opt->axis[1] );
 
 	AddOriginalEdges( opt );
+	start = AddPhaseTime( OPT_PHASE_ORIGINAL_EDGES, start );
 	SplitOriginalEdgesAtCrossings( opt );
+	start = AddPhaseTime( OPT_PHASE_CROSSINGS, start );
 
 #if 0
 	// seperate any discontinuous areas for individual optimization
@@ -1883,6 +2085,7 @@ static	void OptimizeOptList( optimizeGroup_t *opt ) {
 #else
 	DontSeparateIslands( opt );
 #endif
+	AddPhaseTime( OPT_PHASE_ISLANDS, start );
 
 	// now free the hash verts
 	FreeTJunctionHash();
@@ -1915,53 +2118,177 @@ void SetGroupTriPlaneNums( optimizeGroup_t *groups ) {
 
 /*
 ===================
-OptimizeGroupList
-
-This will also fix tjunctions
+OptimizeGroupListCounts
 
+Does the work of OptimizeGroupList, the triangle counts
+are returned instead of printed so areas can be done
+by worker threads and reported in order afterwards
 ===================
 */
-void	OptimizeGroupList( optimizeGroup_t *groupList ) {
-	int			c_in, c_edge, c_tjunc2;
+static void OptimizeGroupListCounts( optimizeGroup_t *groupList, int counts[3] ) {
 	optimizeGroup_t	*group;
 
-	if ( !groupList ) {
-		return;
-	}
-
-	c_in = CountGroupListTris( groupList );
+	counts[0] = CountGroupListTris( groupList );
 
 	// optimize and remove colinear edges, which will
 	// re-introduce some t junctions
 	for ( group = groupList ; group ; group = group->nextGroup ) {
 		OptimizeOptList( group );
 	}
-	c_edge = CountGroupListTris( groupList );
+	counts[1] = CountGroupListTris( groupList );
 
 	// fix t junctions again
+	double start = Sys_GetClockTicks();
 	FixAreaGroupsTjunctions( groupList );
 	FreeTJunctionHash();
-	c_tjunc2 = CountGroupListTris( groupList );
+	AddPhaseTime( OPT_PHASE_TJUNCTIONS, start );
+	counts[2] = CountGroupListTris( groupList );
 
 	SetGroupTriPlaneNums( groupList );
+}
 
+/*
+===================
+PrintOptimizeResults
+===================
+*/
+static void PrintOptimizeResults( const int counts[3] ) {
 	PrintIfVerbosityAtLeast( VL_ORIGDEFAULT, "----- OptimizeAreaGroups Results -----\n" );
-	PrintIfVerbosityAtLeast( VL_ORIGDEFAULT, "%6i tris in\n", c_in );
-	PrintIfVerbosityAtLeast( VL_ORIGDEFAULT, "%6i tris after edge removal optimization\n", c_edge );
-	PrintIfVerbosityAtLeast( VL_ORIGDEFAULT, "%6i tris after final t junction fixing\n", c_tjunc2 );
+	PrintIfVerbosityAtLeast( VL_ORIGDEFAULT, "%6i tris in\n", counts[0] );
+	PrintIfVerbosityAtLeast( VL_ORIGDEFAULT, "%6i tris after edge removal optimization\n", counts[1] );
+	PrintIfVerbosityAtLeast( VL_ORIGDEFAULT, "%6i tris after final t junction fixing\n", counts[2] );
+}
+
+/*
+===================
+OptimizeGroupList
+
+This will also fix tjunctions
+
+===================
+*/
+void	OptimizeGroupList( optimizeGroup_t *groupList ) {
+	int			counts[3];
+
+	if ( !groupList ) {
+		return;
+	}
+
+	OptimizeGroupListCounts( groupList, counts );
+	PrintOptimizeResults( counts );
 }
 
 
+/*
+===================
+OptimizeArea
+
+Optimizes the groups of one area, with -incremental
+they are restored from the area cache if possible
+===================
+*/
+static void OptimizeArea( optimizeGroup_t *groupList, int counts[3] ) {
+	if ( !dmapGlobals.incremental ) {
+		OptimizeGroupListCounts( groupList, counts );
+		return;
+	}
+
+	const areaCacheKey_t key = AreaCacheKey( groupList );
+
+	if ( RestoreCachedArea( groupList, key ) ) {
+		counts[0] = counts[1] = counts[2] = CountGroupListTris( groupList );
+		return;
+	}
+
+	OptimizeGroupListCounts( groupList, counts );
+	StoreCachedArea( groupList, key );
+}
+
+/*
+==================
+PrintPhaseTimes
+==================
+*/
+static void PrintPhaseTimes( const double phaseTicks[OPT_NUM_PHASES] ) {
+	static const char *phaseNames[OPT_NUM_PHASES] = {
+		"t junction fixing",
+		"original edges",
+		"edge crossings",
+		"island optimization"
+	};
+	const double msecPerTick = 1000.0 / Sys_ClockTicksPerSecond();
+
+	for ( int i = 0 ; i < OPT_NUM_PHASES ; i++ ) {
+		PrintIfVerbosityAtLeast( VL_ORIGDEFAULT, "%6.0f msec %s\n", phaseTicks[i] * msecPerTick, phaseNames[i] );
+	}
+}
+
 /*
 ==================
 OptimizeEntity
+
+Every area has its own optimize groups and only reads the shared
+map planes, so the areas are spread over threads. Each thread works
+in its own optimizeState_t and t junction hash, and the output is
+the same as optimizing the areas one after another.
 ==================
 */
 void	OptimizeEntity( uEntity_t *e ) {
 	int		i;
 
 	PrintIfVerbosityAtLeast( VL_ORIGDEFAULT, "----- OptimizeEntity -----\n" );
+
+	memset( optState->phaseTicks, 0, sizeof( optState->phaseTicks ) );
+
+	// debug drawing and the very verbose output want one area at a time
+	if ( dmapGlobals.noParallel || dmapGlobals.drawflag || dmapGlobals.verbose >= VL_VERBOSE
+		|| e->numAreas < 2 || !Mem_ThreadSafe() ) {
+		for ( i = 0 ; i < e->numAreas ; i++ ) {
+			int counts[3];
+
+			if ( e->areas[i].groups ) {
+				OptimizeArea( e->areas[i].groups, counts );
+				PrintOptimizeResults( counts );
+			}
+		}
+		PrintPhaseTimes( optState->phaseTicks );
+		return;
+	}
+
+	int (*counts)[3] = (int (*)[3])Mem_ClearedAlloc( e->numAreas * sizeof( *counts ) );
+	double phaseTicks[OPT_NUM_PHASES] = { 0 };
+
+	#pragma omp parallel
+	{
+		optimizeState_t *mainState = optState;
+		optState = (optimizeState_t *)Mem_Alloc( sizeof( *optState ) );
+		memset( optState->phaseTicks, 0, sizeof( optState->phaseTicks ) );
+		BeginThreadTJunctionHash();
+
+		#pragma omp for schedule( dynamic )
+		for ( int j = 0 ; j < e->numAreas ; j++ ) {
+			if ( e->areas[j].groups ) {
+				OptimizeArea( e->areas[j].groups, counts[j] );
+			}
+		}
+
+		// the phase times are summed over all threads
+		#pragma omp critical
+		for ( int j = 0 ; j < OPT_NUM_PHASES ; j++ ) {
+			phaseTicks[j] += optState->phaseTicks[j];
+		}
+
+		EndThreadTJunctionHash();
+		Mem_Free( optState );
+		optState = mainState;
+	}
+
 	for ( i = 0 ; i < e->numAreas ; i++ ) {
-		OptimizeGroupList( e->areas[i].groups );
+		if ( e->areas[i].groups ) {
+			PrintOptimizeResults( counts[i] );
+		}
 	}
+	PrintPhaseTimes( phaseTicks );
+
+	Mem_Free( counts );
 }
@@ -30,19 +30,13 @@ static bool versioned = RegisterVersionedFile("$Id$");
 
 #include "dmap.h"
 
-extern idBounds optBounds;
-
-#define MAX_OPT_VERTEXES 0x10000
-extern int numOptVerts;
-extern optVertex_t optVerts[MAX_OPT_VERTEXES];
-
 /*
 ================
 FindOptVertex
 ================
 */
 optVertex_t *FindOptVertex( idDrawVert *v, optimizeGroup_t *opt ) {
-	int		i;
+	int		i, hash;
 	float	x, y;
 	optVertex_t	*vert;
 
@@ -51,27 +45,30 @@ optVertex_t *FindOptVertex( idDrawVert *v, optimizeGroup_t *opt ) {
 	y = v->xyz * opt->axis[1];
 
 	// should we match based on the t-junction fixing hash verts?
-	for ( i = 0 ; i < numOptVerts ; i++ ) {
-		if ( optVerts[i].pv[0] == x && optVerts[i].pv[1] == y ) {
-			return &optVerts[i];
+	hash = OptVertexHash( x, y );
+	for ( i = optState->optVertHash[hash] ; i != -1 ; i = optState->optVertHashNext[i] ) {
+		if ( optState->optVerts[i].pv[0] == x && optState->optVerts[i].pv[1] == y ) {
+			return &optState->optVerts[i];
 		}
 	}
 
-	if ( numOptVerts >= MAX_OPT_VERTEXES ) {
+	if ( optState->numOptVerts >= MAX_OPT_VERTEXES ) {
 		common->Error( "MAX_OPT_VERTEXES" );
 		return NULL;
 	}
 	
-	numOptVerts++;
+	i = optState->numOptVerts++;
+	optState->optVertHashNext[i] = optState->optVertHash[hash];
+	optState->optVertHash[hash] = i;
 
-	vert = &optVerts[i];
+	vert = &optState->optVerts[i];
 	memset( vert, 0, sizeof( *vert ) );
 	vert->v = *v;
 	vert->pv[0] = x;
 	vert->pv[1] = y;
 	vert->pv[2] = 0;
 
-	optBounds.AddPoint( vert->pv );
+	optState->optBounds.AddPoint( vert->pv );
 
 	return vert;
 }
@@ -86,11 +86,17 @@ typedef struct hashVert_s {
 	int					iv[3];
 } hashVert_t;
 
-static idBounds	hashBounds;
-static idVec3	hashScale;
-static hashVert_t	*hashVerts[HASH_BINS][HASH_BINS][HASH_BINS];
-static int		numHashVerts, numTotalVerts;
-static int		hashIntMins[3], hashIntScale[3];
+typedef struct {
+	idBounds	hashBounds;
+	idVec3		hashScale;
+	hashVert_t	*hashVerts[HASH_BINS][HASH_BINS][HASH_BINS];
+	int			numHashVerts, numTotalVerts;
+	int			hashIntMins[3], hashIntScale[3];
+} tjunctionHash_t;
+
+// threads optimizing areas in parallel switch to their own hash
+static tjunctionHash_t	mainTJunctionHash;
+static ID_THREAD_LOCAL tjunctionHash_t	*tjHash = &mainTJunctionHash;
 
 /*
 ===============
@@ -105,12 +111,12 @@ struct hashVert_s	*GetHashVert( idVec3 &v ) {
 	int		i;
 	hashVert_t	*hv;
 
-	numTotalVerts++;
+	tjHash->numTotalVerts++;
 
 	// snap the vert to integral values
 	for ( i = 0 ; i < 3 ; i++ ) {
 		iv[i] = floor( ( v[i] + 0.5/SNAP_FRACTIONS ) * SNAP_FRACTIONS );
-		block[i] = ( iv[i] - hashIntMins[i] ) / hashIntScale[i];
+		block[i] = ( iv[i] - tjHash->hashIntMins[i] ) / tjHash->hashIntScale[i];
 		if ( block[i] < 0 ) {
 			block[i] = 0;
 		} else if ( block[i] >= HASH_BINS ) {
@@ -120,7 +126,7 @@ struct hashVert_s	*GetHashVert( idVec3 &v ) {
 
 	// see if a vertex near enough already exists
 	// this could still fail to find a near neighbor right at the hash block boundary
-	for ( hv = hashVerts[block[0]][block[1]][block[2]] ; hv ; hv = hv->next ) {
+	for ( hv = tjHash->hashVerts[block[0]][block[1]][block[2]] ; hv ; hv = hv->next ) {
 #if 0
 		if ( hv->iv[0] == iv[0] && hv->iv[1] == iv[1] && hv->iv[2] == iv[2] ) {
 			VectorCopy( hv->v, v );
@@ -144,8 +150,8 @@ struct hashVert_s	*GetHashVert( idVec3 &v ) {
 	// create a new one 
 	hv = (hashVert_t *)Mem_Alloc( sizeof( *hv ) );
 
-	hv->next = hashVerts[block[0]][block[1]][block[2]];
-	hashVerts[block[0]][block[1]][block[2]] = hv;
+	hv->next = tjHash->hashVerts[block[0]][block[1]][block[2]];
+	tjHash->hashVerts[block[0]][block[1]][block[2]] = hv;
 
 	hv->iv[0] = iv[0];
 	hv->iv[1] = iv[1];
@@ -157,7 +163,7 @@ struct hashVert_s	*GetHashVert( idVec3 &v ) {
 
 	VectorCopy( hv->v, v );
 
-	numHashVerts++;
+	tjHash->numHashVerts++;
 
 	return hv;
 }
@@ -182,14 +188,14 @@ static void HashBlocksForTri( const mapTri_t *tri, int blocks[2][3] ) {
 
 	// add a 1.0 slop margin on each side
 	for ( i = 0 ; i < 3 ; i++ ) {
-		blocks[0][i] = ( bounds[0][i] - 1.0 - hashBounds[0][i] ) / hashScale[i];
+		blocks[0][i] = ( bounds[0][i] - 1.0 - tjHash->hashBounds[0][i] ) / tjHash->hashScale[i];
 		if ( blocks[0][i] < 0 ) {
 			blocks[0][i] = 0;
 		} else if ( blocks[0][i] >= HASH_BINS ) {
 			blocks[0][i] = HASH_BINS - 1;
 		}
 
-		blocks[1][i] = ( bounds[1][i] + 1.0 - hashBounds[0][i] ) / hashScale[i];
+		blocks[1][i] = ( bounds[1][i] + 1.0 - tjHash->hashBounds[0][i] ) / tjHash->hashScale[i];
 		if ( blocks[1][i] < 0 ) {
 			blocks[1][i] = 0;
 		} else if ( blocks[1][i] >= HASH_BINS ) {
@@ -213,31 +219,31 @@ void HashTriangles( optimizeGroup_t *groupList ) {
 	optimizeGroup_t	*group;
 
 	// clear the hash tables
-	memset( hashVerts, 0, sizeof( hashVerts ) );
+	memset( tjHash->hashVerts, 0, sizeof( tjHash->hashVerts ) );
 
-	numHashVerts = 0;
-	numTotalVerts = 0;
+	tjHash->numHashVerts = 0;
+	tjHash->numTotalVerts = 0;
 
 	// bound all the triangles to determine the bucket size
-	hashBounds.Clear();
+	tjHash->hashBounds.Clear();
 	for ( group = groupList ; group ; group = group->nextGroup ) {
 		for ( a = group->triList ; a ; a = a->next ) {
-			hashBounds.AddPoint( a->v[0].xyz );
-			hashBounds.AddPoint( a->v[1].xyz );
-			hashBounds.AddPoint( a->v[2].xyz );
+			tjHash->hashBounds.AddPoint( a->v[0].xyz );
+			tjHash->hashBounds.AddPoint( a->v[1].xyz );
+			tjHash->hashBounds.AddPoint( a->v[2].xyz );
 		}
 	}
 
 	// spread the bounds so it will never have a zero size
 	for ( i = 0 ; i < 3 ; i++ ) {
-		hashBounds[0][i] = floor( hashBounds[0][i] - 1 );
-		hashBounds[1][i] = ceil( hashBounds[1][i] + 1 );
-		hashIntMins[i] = hashBounds[0][i] * SNAP_FRACTIONS;
-
-		hashScale[i] = ( hashBounds[1][i] - hashBounds[0][i] ) / HASH_BINS;
-		hashIntScale[i] = hashScale[i] * SNAP_FRACTIONS;
-		if ( hashIntScale[i] < 1 ) {
-			hashIntScale[i] = 1;
+		tjHash->hashBounds[0][i] = floor( tjHash->hashBounds[0][i] - 1 );
+		tjHash->hashBounds[1][i] = ceil( tjHash->hashBounds[1][i] + 1 );
+		tjHash->hashIntMins[i] = tjHash->hashBounds[0][i] * SNAP_FRACTIONS;
+
+		tjHash->hashScale[i] = ( tjHash->hashBounds[1][i] - tjHash->hashBounds[0][i] ) / HASH_BINS;
+		tjHash->hashIntScale[i] = tjHash->hashScale[i] * SNAP_FRACTIONS;
+		if ( tjHash->hashIntScale[i] < 1 ) {
+			tjHash->hashIntScale[i] = 1;
 		}
 	}
 
@@ -270,14 +276,14 @@ void FreeTJunctionHash( void ) {
 	for ( i = 0 ; i < HASH_BINS ; i++ ) {
 		for ( j = 0 ; j < HASH_BINS ; j++ ) {
 			for ( k = 0 ; k < HASH_BINS ; k++ ) {
-				for ( hv = hashVerts[i][j][k] ; hv ; hv = next ) {
+				for ( hv = tjHash->hashVerts[i][j][k] ; hv ; hv = next ) {
 					next = hv->next;
 					Mem_Free( hv );
 				}
 			}
 		}
 	}
-	memset( hashVerts, 0, sizeof( hashVerts ) );
+	memset( tjHash->hashVerts, 0, sizeof( tjHash->hashVerts ) );
 }
 
 
@@ -409,7 +415,7 @@ static mapTri_t	*FixTriangleAgainstHash( const mapTri_t *tri ) {
 	for ( i = blocks[0][0] ; i <= blocks[1][0] ; i++ ) {
 		for ( j = blocks[0][1] ; j <= blocks[1][1] ; j++ ) {
 			for ( k = blocks[0][2] ; k <= blocks[1][2] ; k++ ) {
-				for ( hv = hashVerts[i][j][k] ; hv ; hv = hv->next ) {
+				for ( hv = tjHash->hashVerts[i][j][k] ; hv ; hv = hv->next ) {
 					// fix all triangles in the list against this point
 					test = fixed;
 					fixed = NULL;
@@ -498,6 +504,29 @@ void	FixAreaGroupsTjunctions( optimizeGroup_t *groupList ) {
 }
 
 
+/*
+==================
+BeginThreadTJunctionHash
+
+Gives the calling thread a hash of its own, so areas
+can be fixed by several threads at once
+==================
+*/
+void BeginThreadTJunctionHash( void ) {
+	tjHash = (tjunctionHash_t *)Mem_ClearedAlloc( sizeof( *tjHash ) );
+}
+
+/*
+==================
+EndThreadTJunctionHash
+==================
+*/
+void EndThreadTJunctionHash( void ) {
+	FreeTJunctionHash();
+	Mem_Free( tjHash );
+	tjHash = &mainTJunctionHash;
+}
+
 /*
 ==================
 FixEntityTjunctions
@@ -506,9 +535,26 @@ FixEntityTjunctions
 void	FixEntityTjunctions( uEntity_t *e ) {
 	int		i;
 
-	for ( i = 0 ; i < e->numAreas ; i++ ) {
-		FixAreaGroupsTjunctions( e->areas[i].groups );
-		FreeTJunctionHash();
+	if ( dmapGlobals.noParallel || dmapGlobals.verbose >= VL_VERBOSE || e->numAreas < 2 || !Mem_ThreadSafe() ) {
+		for ( i = 0 ; i < e->numAreas ; i++ ) {
+			FixAreaGroupsTjunctions( e->areas[i].groups );
+			FreeTJunctionHash();
+		}
+		return;
+	}
+
+	// the areas don't share any triangles, see OptimizeEntity
+	#pragma omp parallel
+	{
+		BeginThreadTJunctionHash();
+
+		#pragma omp for schedule( dynamic )
+		for ( int j = 0 ; j < e->numAreas ; j++ ) {
+			FixAreaGroupsTjunctions( e->areas[j].groups );
+			FreeTJunctionHash();
+		}
+
+		EndThreadTJunctionHash();
 	}
 }
 
@@ -527,33 +573,33 @@ void	FixGlobalTjunctions( uEntity_t *e ) {
 	PrintIfVerbosityAtLeast( VL_ORIGDEFAULT, "----- FixGlobalTjunctions -----\n" );
 
 	// clear the hash tables
-	memset( hashVerts, 0, sizeof( hashVerts ) );
+	memset( tjHash->hashVerts, 0, sizeof( tjHash->hashVerts ) );
 
-	numHashVerts = 0;
-	numTotalVerts = 0;
+	tjHash->numHashVerts = 0;
+	tjHash->numTotalVerts = 0;
 
 	// bound all the triangles to determine the bucket size
-	hashBounds.Clear();
+	tjHash->hashBounds.Clear();
 	for ( areaNum = 0 ; areaNum < e->numAreas ; areaNum++ ) {
 		for ( group = e->areas[areaNum].groups ; group ; group = group->nextGroup ) {
 			for ( a = group->triList ; a ; a = a->next ) {
-				hashBounds.AddPoint( a->v[0].xyz );
-				hashBounds.AddPoint( a->v[1].xyz );
-				hashBounds.AddPoint( a->v[2].xyz );
+				tjHash->hashBounds.AddPoint( a->v[0].xyz );
+				tjHash->hashBounds.AddPoint( a->v[1].xyz );
+				tjHash->hashBounds.AddPoint( a->v[2].xyz );
 			}
 		}
 	}
 
 	// spread the bounds so it will never have a zero size
 	for ( i = 0 ; i < 3 ; i++ ) {
-		hashBounds[0][i] = floor( hashBounds[0][i] - 1 );
-		hashBounds[1][i] = ceil( hashBounds[1][i] + 1 );
-		hashIntMins[i] = hashBounds[0][i] * SNAP_FRACTIONS;
-
-		hashScale[i] = ( hashBounds[1][i] - hashBounds[0][i] ) / HASH_BINS;
-		hashIntScale[i] = hashScale[i] * SNAP_FRACTIONS;
-		if ( hashIntScale[i] < 1 ) {
-			hashIntScale[i] = 1;
+		tjHash->hashBounds[0][i] = floor( tjHash->hashBounds[0][i] - 1 );
+		tjHash->hashBounds[1][i] = ceil( tjHash->hashBounds[1][i] + 1 );
+		tjHash->hashIntMins[i] = tjHash->hashBounds[0][i] * SNAP_FRACTIONS;
+
+		tjHash->hashScale[i] = ( tjHash->hashBounds[1][i] - tjHash->hashBounds[0][i] ) / HASH_BINS;
+		tjHash->hashIntScale[i] = tjHash->hashScale[i] * SNAP_FRACTIONS;
+		if ( tjHash->hashIntScale[i] < 1 ) {
+			tjHash->hashIntScale[i] = 1;
 		}
 	}
 
@@ -63,7 +63,6 @@ typedef struct {
 
 typedef struct {
 	int		triLink;
-	int		rayNumber;		// don't need to test again if still on same ray
 } binLink_t;
 
 #define	MAX_LINKS_PER_BLOCK		0x100000
@@ -95,7 +94,12 @@ typedef struct {
 	triHash_t	*hash;	
 } renderBump_t;
 
-static int rayNumber;		// for avoiding retests of bins and faces
+// the texels are traced in bands of rows that are spread over the threads,
+// the window is updated after every BAND_UPDATE_ROWS rows
+#define	BAND_ROWS			16
+#define	BAND_UPDATE_ROWS	512
+
+idCVar r_parallelRenderBump( "r_parallelRenderBump", "1", CVAR_RENDERER | CVAR_BOOL, "trace the renderbump texels on all cores" );
 
 static int oldWidth, oldHeight;
 
@@ -508,11 +512,11 @@ static bool SampleHighMesh( const renderBump_t *rb,
 							const idVec3 &point, const idVec3 &direction, idVec3 &sampledNormal, 
 							byte sampledColor[4] ) {
 	idVec3	p;
-	binLink_t	*bl;
+	const binLink_t	*bl;
 	int			linkNum;
 	int		faceNum;
 	float	dist, bestDist;
-	int		block[3];
+	int		block[3], lastBlock[3];
 	float	maxDist;
 	int		c_hits;
 	int		i;
@@ -522,9 +526,6 @@ static bool SampleHighMesh( const renderBump_t *rb,
 	normal = direction;
 	normal.Normalize();
 
-	// increment our uniqueness counter (FIXME: make thread safe?)
-	rayNumber++;
-
 	// the max distance will be the traceFrac times the longest axis of the high poly model
 	bestDist = -rb->traceDist;
 	maxDist = rb->traceDist;
@@ -533,6 +534,8 @@ static bool SampleHighMesh( const renderBump_t *rb,
 
 	c_hits = 0;
 
+	lastBlock[0] = lastBlock[1] = lastBlock[2] = -1;
+
 	// this is a pretty damn lazy way to walk through a 3D grid, and has a (very slight)
 	// chance of missing a triangle in a corner crossing case
 #define	RAY_STEPS	100
@@ -553,12 +556,16 @@ static bool SampleHighMesh( const renderBump_t *rb,
 			continue;
 		}
 
-		// FIXME: casting away const
-		bl = (binLink_t *)&rb->hash->binLinks[block[0]][block[1]][block[2]];
-		if ( bl->rayNumber == rayNumber ) {
+		// the steps move monotonically along each axis, so a block
+		// can't come back once the ray has left it
+		if ( block[0] == lastBlock[0] && block[1] == lastBlock[1] && block[2] == lastBlock[2] ) {
 			continue;		// already tested this block
 		}
-		bl->rayNumber = rayNumber;
+		lastBlock[0] = block[0];
+		lastBlock[1] = block[1];
+		lastBlock[2] = block[2];
+
+		bl = &rb->hash->binLinks[block[0]][block[1]][block[2]];
 		linkNum = bl->triLink;
 		triLink_t	*link;
 		for ( ; linkNum != -1 ; linkNum = link->nextLink ) {
@@ -616,10 +623,14 @@ RasterizeTriangle
 
 It is ok for the texcoords to wrap around, the rasterization
 will deal with it properly.
+
+Only the texels in rows firstRow to lastRow - 1 are written, so
+several threads can rasterize the same triangle into different
+rows of the image.
 ================
 */
 static void RasterizeTriangle( const srfTriangles_t *lowMesh, const idVec3 *lowMeshNormals, int lowFaceNum,
-							 renderBump_t *rb ) {
+							 renderBump_t *rb, int firstRow, int lastRow ) {
 	int		i, j, k;
 	float	bounds[2][2];
 	float	ibounds[2][2];
@@ -689,10 +700,14 @@ static void RasterizeTriangle( const srfTriangles_t *lowMesh, const idVec3 *lowM
 
 	// itterate over the bounding box, testing against edge vectors
 	for ( i = ibounds[0][1] ; i < ibounds[1][1] ; i++ ) {
+		const int row = i & (rb->height-1);
+		if ( row < firstRow || row >= lastRow ) {
+			continue;
+		}
 		for ( j = ibounds[0][0] ; j < ibounds[1][0] ; j++ ) {
 			float	dists[3];
 
-			k =  ( ( i & (rb->height-1) ) * rb->width + ( j & (rb->width-1) ) ) * 4;
+			k =  ( row * rb->width + ( j & (rb->width-1) ) ) * 4;
 			colorDest = &rb->colorPic[k];
 			localDest = &rb->localPic[k];
 			globalDest = &rb->globalPic[k];
@@ -960,12 +975,22 @@ static void RenderBumpTriangles( srfTriangles_t *lowMesh, renderBump_t *rb ) {
 	}
 
 
-	// rasterize each low poly face
-	for ( j = 0 ; j < lowMesh->numIndexes ; j+=3 ) {
+	// rasterize each low poly face into a band of rows at a time. Every band
+	// gets the faces in the same order, so the texels that several faces
+	// cover end up exactly as if the whole image was done in one pass.
+	const bool parallel = r_parallelRenderBump.GetBool();
+	for ( int updateRow = 0 ; updateRow < rb->height ; updateRow += BAND_UPDATE_ROWS ) {
+		const int updateEnd = Min( updateRow + BAND_UPDATE_ROWS, rb->height );
+
 		// pump the event loop so the window can be dragged around
 		Sys_GenerateEvents();
 
-		RasterizeTriangle( lowMesh, lowMeshNormals, j/3, rb );
+		#pragma omp parallel for if ( parallel ) private( j ) schedule( dynamic )
+		for ( i = updateRow ; i < updateEnd ; i += BAND_ROWS ) {
+			for ( j = 0 ; j < lowMesh->numIndexes ; j+=3 ) {
+				RasterizeTriangle( lowMesh, lowMeshNormals, j/3, rb, i, Min( i + BAND_ROWS, updateEnd ) );
+			}
+		}
 
 		qglClearColor(1,0,0,1);
 		qglClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
@@ -151,6 +151,33 @@ void idDeviceContext::GetTransformInfo(idVec3& org, idMat3& m )
 }
 // 
 
+void idDeviceContext::GetDrawState( drawState_t &state ) const {
+	state.mat = mat;
+	state.origin = origin;
+	state.xScale = xScale;
+	state.yScale = yScale;
+	state.enableClipping = enableClipping;
+	state.clipRects = clipRects;
+}
+
+bool idDeviceContext::DrawStateChanged( const drawState_t &state ) const {
+	if ( state.xScale != xScale || state.yScale != yScale || state.enableClipping != enableClipping ) {
+		return true;
+	}
+	if ( !state.origin.Compare( origin ) || !state.mat.Compare( mat ) ) {
+		return true;
+	}
+	if ( state.clipRects.Num() != clipRects.Num() ) {
+		return true;
+	}
+	for ( int i = 0; i < clipRects.Num(); i++ ) {
+		if ( !( state.clipRects[i] == clipRects[i] ) ) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void idDeviceContext::PopClipRect() {
 	if (clipRects.Num()) {
 		clipRects.RemoveIndex(clipRects.Num()-1);
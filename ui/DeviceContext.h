@@ -79,6 +79,19 @@ public:
 	void				EnableClipping(bool b) { enableClipping = b; };
 	void				SetFont( int num );
 
+	// the state that drawing depends on besides its arguments, so what was drawn can be reused
+	typedef struct {
+		idMat3				mat;
+		idVec3				origin;
+		float				xScale;
+		float				yScale;
+		bool				enableClipping;
+		idList<idRectangle>	clipRects;
+	} drawState_t;
+
+	void				GetDrawState( drawState_t &state ) const;
+	bool				DrawStateChanged( const drawState_t &state ) const;
+
 	void				SetOverStrike(bool b) { overStrikeMode = b; }
 
 	bool				GetOverStrike() { return overStrikeMode; }
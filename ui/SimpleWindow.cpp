@@ -27,6 +27,8 @@ static bool versioned = RegisterVersionedFile("$Id$");
 #include "UserInterfaceLocal.h"
 #include "SimpleWindow.h"
 
+idCVar gui_useDrawCache( "gui_useDrawCache", "1", CVAR_GUI | CVAR_BOOL, "draw simple windows that didn't change since the last frame from the surfaces they generated then" );
+
 
 idSimpleWindow::idSimpleWindow(idWindow *win) {
 	gui = win->GetGui();
@@ -72,6 +74,8 @@ idSimpleWindow::idSimpleWindow(idWindow *win) {
 
 	hideCursor = win->hideCursor;
 
+	drawCacheValid = false;
+
 	idWindow *parent = win->GetParent();
 	if (parent) {
 		if (text.NeedsUpdate()) {
@@ -210,6 +214,42 @@ void idSimpleWindow::CalcClientRect(float xofs, float yofs) {
 }
 
 
+// true if drawing now would come out different from what is in the draw cache
+bool idSimpleWindow::DrawCacheChanged() const {
+	if ( !drawCacheValid ) {
+		return true;
+	}
+	if ( !( drawCacheRect == drawRect ) || drawCacheBackground != background ) {
+		return true;
+	}
+	if ( drawCacheTextScale != textScale || drawCacheRotate != rotate || !drawCacheShear.Compare( shear ) ) {
+		return true;
+	}
+	if ( !drawCacheColors[0].Compare( backColor ) || !drawCacheColors[1].Compare( matColor )
+		|| !drawCacheColors[2].Compare( foreColor ) || !drawCacheColors[3].Compare( borderColor ) ) {
+		return true;
+	}
+	if ( drawCacheText.Cmp( text.c_str() ) != 0 ) {
+		return true;
+	}
+	return dc->DrawStateChanged( drawCacheDCState );
+}
+
+// remembers what the drawing is about to be made from, before the transforms are set up
+void idSimpleWindow::UpdateDrawCache() {
+	drawCacheRect = drawRect;
+	drawCacheBackground = background;
+	drawCacheTextScale = textScale;
+	drawCacheRotate = rotate;
+	drawCacheShear = shear;
+	drawCacheColors[0] = backColor;
+	drawCacheColors[1] = matColor;
+	drawCacheColors[2] = foreColor;
+	drawCacheColors[3] = borderColor;
+	drawCacheText = text.c_str();
+	dc->GetDrawState( drawCacheDCState );
+}
+
 void idSimpleWindow::Redraw(float x, float y) {
 	
 	if (!visible) {
@@ -221,6 +261,23 @@ void idSimpleWindow::Redraw(float x, float y) {
 	drawRect.Offset(x, y);
 	clientRect.Offset(x, y);
 	textRect.Offset(x, y);
+
+	// most simple windows are static text and panels, which are
+	// expensive to generate again every frame
+	const bool useDrawCache = gui_useDrawCache.GetBool();
+	if ( useDrawCache && !DrawCacheChanged() ) {
+		renderSystem->DrawGuiCapture( drawCache );
+		dc->SetTransformInfo(vec3_origin, mat3_identity);
+		drawRect.Offset(-x, -y);
+		clientRect.Offset(-x, -y);
+		textRect.Offset(-x, -y);
+		return;
+	}
+	if ( useDrawCache ) {
+		UpdateDrawCache();
+		renderSystem->BeginGuiCapture( drawCache );
+	}
+
 	SetupTransforms(x, y);
 	if ( flags & WIN_NOCLIP ) {
 		dc->EnableClipping( false );
@@ -242,6 +299,11 @@ void idSimpleWindow::Redraw(float x, float y) {
 	if ( flags & WIN_NOCLIP ) {
 		dc->EnableClipping( true );
 	}
+
+	if ( useDrawCache ) {
+		drawCacheValid = renderSystem->EndGuiCapture( drawCache );
+	}
+
 	drawRect.Offset(-x, -y);
 	clientRect.Offset(-x, -y);
 	textRect.Offset(-x, -y);
@@ -416,6 +478,7 @@ void idSimpleWindow::ReadFromSaveGame( idFile *savefile ) {
 		background = NULL;
 	}
 
+	drawCacheValid = false;
 }
 
 
@@ -428,5 +491,7 @@ size_t idSimpleWindow::Size() {
 	sz += name.Size();
 	sz += text.Size();
 	sz += backGroundName.Size();
+	sz += drawCache.surfaces.Allocated() + drawCache.verts.Allocated() + drawCache.indexes.Allocated();
+	sz += drawCacheText.Size();
 	return sz;
 }
@@ -53,6 +53,8 @@ protected:
 	void 			SetupTransforms(float x, float y);
 	void 			DrawBackground(const idRectangle &drawRect);
 	void 			DrawBorderAndCaption(const idRectangle &drawRect);
+	bool			DrawCacheChanged() const;
+	void			UpdateDrawCache();
 
 	idUserInterfaceLocal *gui;
 	idDeviceContext *dc;
@@ -87,6 +89,18 @@ protected:
 	idWindow *		mParent;
 
 	idWinBool	hideCursor;
+
+	// with gui_useDrawCache what Redraw drew last, and what it was drawn from
+	guiCapture_t	drawCache;
+	bool			drawCacheValid;
+	idRectangle		drawCacheRect;
+	idVec4			drawCacheColors[4];
+	float			drawCacheTextScale;
+	float			drawCacheRotate;
+	idVec2			drawCacheShear;
+	const idMaterial *drawCacheBackground;
+	idStr			drawCacheText;
+	idDeviceContext::drawState_t drawCacheDCState;
 };
 
 #endif /* !__SIMPLEWIN_H__ */
@@ -32,6 +32,208 @@ extern idCVar r_skipGuiShaders;		// 1 = don't render any gui elements on surface
 idUserInterfaceManagerLocal	uiManagerLocal;
 idUserInterfaceManager *	uiManager = &uiManagerLocal;
 
+#define GUI_CACHE_DIR			"guicache"
+#define GUI_CACHE_ID			( ( 'B' << 24 ) | ( 'G' << 16 ) | ( 'U' << 8 ) | 'I' )
+#define GUI_CACHE_VERSION		1
+#define GUI_CACHE_EXT			"bgui"
+#define GUI_PARSER_FLAGS		( LEXFL_NOFATALERRORS | LEXFL_NOSTRINGCONCAT | LEXFL_ALLOWMULTICHARLITERALS | LEXFL_ALLOWBACKSLASHSTRINGCONCAT )
+
+idCVar gui_useParseCache( "gui_useParseCache", "1", CVAR_GUI | CVAR_BOOL | CVAR_ARCHIVE, "keep the preprocessed tokens of gui files in " GUI_CACHE_DIR "/, so their includes and defines don't have to be expanded again on every load" );
+
+/*
+===============================================================================
+
+	GUI parse cache
+
+	Most of the time spent loading a gui goes into the preprocessor, which
+	reads the included files and expands the defines on every load of a
+	main menu or readable gui. The cache keeps the expanded token stream as
+	plain text, keyed by the timestamps and lengths of the gui and all the
+	files it included, and the window parser reads that instead.
+
+===============================================================================
+*/
+
+/*
+================
+GuiCacheFileName
+================
+*/
+static void GuiCacheFileName( const char *qpath, idStr &cacheName ) {
+	sprintf( cacheName, "%s/%s." GUI_CACHE_EXT, GUI_CACHE_DIR, qpath );
+}
+
+/*
+================
+GuiCacheAppendToken
+
+Writes the token so the lexer reads it back unchanged
+================
+*/
+static void GuiCacheAppendToken( idStr &text, const idToken &token ) {
+	if ( token.type != TT_STRING && token.type != TT_LITERAL ) {
+		text += token;
+		return;
+	}
+
+	const char quote = ( token.type == TT_STRING ) ? '"' : '\'';
+	text += quote;
+	for ( int i = 0 ; i < token.Length() ; i++ ) {
+		const char c = token[i];
+		if ( c == '\\' || c == quote ) {
+			text += '\\';
+			text += c;
+		} else if ( c == '\n' ) {
+			text += "\\n";
+		} else if ( c == '\r' ) {
+			text += "\\r";
+		} else if ( c == '\t' ) {
+			text += "\\t";
+		} else {
+			text += c;
+		}
+	}
+	text += quote;
+}
+
+/*
+================
+ExpandGuiSource
+
+Reads the whole source through the preprocessor into text, returns false
+if a token would be taken for a directive when the text is parsed again
+================
+*/
+static bool ExpandGuiSource( idParser &src, idStr &text ) {
+	idToken	token;
+	int		line = -1;
+
+	text.Clear();
+	while ( src.ReadToken( &token ) ) {
+		if ( token.type == TT_PUNCTUATION && ( token == "#" || token == "$" || token == "\\" ) ) {
+			return false;
+		}
+		// keep lines apart, so parse warnings still point somewhere near
+		text += ( token.line != line ) ? '\n' : ' ';
+		line = token.line;
+		GuiCacheAppendToken( text, token );
+	}
+	return true;
+}
+
+/*
+================
+WriteGuiCacheFiles
+================
+*/
+static void WriteGuiCacheFiles( idFile *f, const char *qpath, const idList<idStr> &includes ) {
+	ID_TIME_T	timeStamp;
+
+	f->WriteInt( includes.Num() + 1 );
+	for ( int i = -1 ; i < includes.Num() ; i++ ) {
+		const char *name = ( i < 0 ) ? qpath : includes[i].c_str();
+		const int length = fileSystem->ReadFile( name, NULL, &timeStamp );
+		f->WriteString( name );
+		f->WriteUnsignedInt( (unsigned int)timeStamp );
+		f->WriteInt( length );
+	}
+}
+
+/*
+================
+LoadGuiCache
+
+Returns false if the cache file is missing, or the gui or one of the
+files it included changed since it was written
+================
+*/
+static bool LoadGuiCache( const char *qpath, idStr &text ) {
+	idStr		cacheName;
+	int			id, version, flags, numFiles, length;
+
+	GuiCacheFileName( qpath, cacheName );
+	idFile *f = fileSystem->OpenFileRead( cacheName );
+	if ( !f ) {
+		return false;
+	}
+
+	f->ReadInt( id );
+	f->ReadInt( version );
+	f->ReadInt( flags );
+	f->ReadInt( numFiles );
+
+	bool ok = ( id == GUI_CACHE_ID && version == GUI_CACHE_VERSION && flags == GUI_PARSER_FLAGS && numFiles > 0 );
+	for ( int i = 0 ; ok && i < numFiles ; i++ ) {
+		idStr			name;
+		unsigned int	cachedTimeStamp;
+		int				cachedLength;
+		ID_TIME_T		timeStamp;
+
+		f->ReadString( name );
+		f->ReadUnsignedInt( cachedTimeStamp );
+		f->ReadInt( cachedLength );
+
+		length = fileSystem->ReadFile( name, NULL, &timeStamp );
+		ok = ( length >= 0 && length == cachedLength && (unsigned int)timeStamp == cachedTimeStamp );
+		if ( i == 0 && idStr::Icmp( name, qpath ) != 0 ) {
+			ok = false;
+		}
+	}
+
+	if ( ok ) {
+		f->ReadInt( length );
+		ok = ( length >= 0 && length <= f->Length() - f->Tell() );
+		if ( ok ) {
+			text.Fill( ' ', length );
+			ok = ( f->Read( &text[0], length ) == length );
+		}
+	}
+
+	fileSystem->CloseFile( f );
+
+	if ( !ok ) {
+		text.Clear();
+	}
+	return ok;
+}
+
+/*
+================
+LoadGuiSource
+
+Loads the expanded tokens of the gui into the parser, from the cache if
+it is up to date. The parser reads from text, so it has to outlive it.
+Returns false if the gui has to be parsed from the file instead.
+================
+*/
+static bool LoadGuiSource( idParser &src, const char *qpath, idStr &text ) {
+	if ( !LoadGuiCache( qpath, text ) ) {
+		if ( !src.LoadFile( qpath ) ) {
+			return false;
+		}
+		if ( !ExpandGuiSource( src, text ) ) {
+			src.FreeSource();
+			return false;
+		}
+
+		idStr cacheName;
+		GuiCacheFileName( qpath, cacheName );
+		idFile *f = fileSystem->OpenFileWrite( cacheName );
+		if ( f ) {
+			f->WriteInt( GUI_CACHE_ID );
+			f->WriteInt( GUI_CACHE_VERSION );
+			f->WriteInt( GUI_PARSER_FLAGS );
+			WriteGuiCacheFiles( f, qpath, src.GetIncludedFiles() );
+			f->WriteString( text );
+			fileSystem->CloseFile( f );
+		}
+
+		src.FreeSource();
+	}
+
+	return src.LoadMemory( text, text.Length(), qpath ) != 0;
+}
+
 /*
 ===============================================================================
 
@@ -261,6 +463,7 @@ bool idUserInterfaceLocal::IsInteractive() const {
 }
 
 bool idUserInterfaceLocal::InitFromFile( const char *qpath, bool rebuild, bool cache ) { 
+	idScopedMemTag memTag( MEMTAG_GUI );
 
 	if ( !( qpath && *qpath ) ) { 
 		// FIXME: Memory leak!!
@@ -281,12 +484,15 @@ bool idUserInterfaceLocal::InitFromFile( const char *qpath, bool rebuild, bool c
 	source = qpath;
 	state.Set( "text", "Test Text!" );
 
-	idParser src( LEXFL_NOFATALERRORS | LEXFL_NOSTRINGCONCAT | LEXFL_ALLOWMULTICHARLITERALS | LEXFL_ALLOWBACKSLASHSTRINGCONCAT );
+	idParser src( GUI_PARSER_FLAGS );
+	idStr expanded;
 
 	//Load the timestamp so reload guis will work correctly
 	fileSystem->ReadFile(qpath, NULL, &timeStamp);
 
-	src.LoadFile( qpath );
+	if ( !gui_useParseCache.GetBool() || !LoadGuiSource( src, qpath, expanded ) ) {
+		src.LoadFile( qpath );
+	}
 
 	if ( src.IsLoaded() ) {
 		idToken token;
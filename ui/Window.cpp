@@ -134,6 +134,9 @@ void idWindow::CommonInit() {
 	parent = NULL;
 	saveOps = NULL;
 	saveRegs = NULL;
+	regsUseTime = false;
+	regInputs.Clear();
+	lastRegs.Clear();
 	timeLine = -1;
 	textShadow = 0;
 	hover = false;
@@ -1077,7 +1080,15 @@ float idWindow::EvalRegs(int test, bool force) {
 
 	if (expressionRegisters.Num()) {
 		regList.SetToRegs(regs);
-		EvaluateRegisters(regs);
+		// the ops only depend on the time and the vars they read, so the
+		// registers of the last evaluation are still good if those didn't change
+		if (RegInputsChanged() || force) {
+			EvaluateRegisters(regs);
+			lastRegs.SetNum(expressionRegisters.Num(), false);
+			memcpy(lastRegs.Ptr(), regs, lastRegs.MemoryUsed());
+		} else {
+			memcpy(regs, lastRegs.Ptr(), lastRegs.MemoryUsed());
+		}
 		regList.GetFromRegs(regs);
 	}
 
@@ -2796,6 +2807,7 @@ int idWindow::ParseTerm( idParser *src,	idWinVar *var, int component ) {
 	}
 
 	if ( !token.Icmp( "time" ) ) {
+		regsUseTime = true;
 		return WEXP_REG_TIME;
 	}
 
@@ -3108,6 +3120,74 @@ void idWindow::EvaluateRegisters(float *registers) {
 
 }
 
+/*
+================
+RegInput
+================
+*/
+static ID_INLINE void RegInput(idList<float> &inputs, int &num, float value, bool &changed) {
+	if (num == inputs.Num()) {
+		inputs.Append(value);
+		changed = true;
+	} else if (inputs[num] != value) {
+		inputs[num] = value;
+		changed = true;
+	}
+	num++;
+}
+
+/*
+===============
+idWindow::RegInputsChanged
+
+Collects the time and the values of the vars the ops read, and returns
+true if they differ from the ones of the last evaluation
+===============
+*/
+bool idWindow::RegInputsChanged() {
+	int		num = 0;
+	bool	changed = (lastRegs.Num() != expressionRegisters.Num());
+
+	const float time = gui->GetTime();
+	if (regsUseTime) {
+		RegInput(regInputs, num, time, changed);
+	}
+
+	int oc = ops.Num();
+	for (int i = 0; i < oc; i++) {
+		const wexpOp_t *op = &ops[i];
+		if (op->b == -2 || !op->a) {
+			continue;
+		}
+		switch (op->opType) {
+		case WOP_TYPE_VAR:
+			// a component index from another expression, or the time register
+			// close to zero, take the vector component path of EvaluateRegisters
+			if (op->b > WEXP_REG_TIME || (op->b == WEXP_REG_TIME && time >= 0 && time < 4)) {
+				return true;
+			}
+			RegInput(regInputs, num, ((idWinVar*)(op->a))->x(), changed);
+			break;
+		case WOP_TYPE_VARS:
+			RegInput(regInputs, num, atof(((idWinStr*)(op->a))->c_str()), changed);
+			break;
+		case WOP_TYPE_VARF:
+			RegInput(regInputs, num, *(idWinFloat*)(op->a), changed);
+			break;
+		case WOP_TYPE_VARI:
+			RegInput(regInputs, num, *(idWinInt*)(op->a), changed);
+			break;
+		case WOP_TYPE_VARB:
+			RegInput(regInputs, num, *(idWinBool*)(op->a), changed);
+			break;
+		default:
+			break;
+		}
+	}
+
+	return changed;
+}
+
 /*
 ================
 idWindow::ReadFromDemoFile
@@ -4157,6 +4237,9 @@ bool idWindow::UpdateFromDictionary ( idDict& dict ) {
 	regList.Reset ( );
 	expressionRegisters.Clear ( );
 	ops.Clear ( );
+	regsUseTime = false;
+	regInputs.Clear ( );
+	lastRegs.Clear ( );
 	
 	for ( i = 0; i < dict.GetNumKeyVals(); i ++ ) {
 		kv = dict.GetKeyVal ( i );
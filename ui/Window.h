@@ -346,6 +346,7 @@ protected:
 	int ParseTerm( idParser *src, idWinVar *var = NULL, int component = 0 );
 	int ParseExpressionPriority( idParser *src, int priority, idWinVar *var = NULL, int component = 0 );
 	void EvaluateRegisters(float *registers);
+	bool RegInputsChanged();
 	void SaveExpressionParseState();
 	void RestoreExpressionParseState();
 	void ParseBracedExpression(idParser *src);
@@ -430,6 +431,9 @@ protected:
 
 	idList<wexpOp_t> ops;			   	// evaluate to make expressionRegisters
 	idList<float> expressionRegisters;
+	bool regsUseTime;					// an expression reads the gui time
+	idList<float> regInputs;			// time and var values the registers were last evaluated with
+	idList<float> lastRegs;				// the registers of that evaluation
 	idList<wexpOp_t> *saveOps;			   	// evaluate to make expressionRegisters
 	idList<rvNamedEvent*>		namedEvents;		//  added named events
 	idList<float> *saveRegs;